@@ -24,6 +24,7 @@ extern "C"
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "rcutils/macros.h"
 #include "rcutils/types/rcutils_ret.h"
@@ -43,6 +44,9 @@ extern "C"
  * rcutils_*_init() where it is stored within another object and used later.
  * Developers should note that, while the fields of a const-qualified allocator
  * struct cannot be modified, the state of the allocator can be modified.
+ *
+ * Custom allocators should be initialized from rcutils_get_zero_initialized_allocator(),
+ * so that the optional fields, which later versions may add to, are `NULL`.
  */
 typedef struct rcutils_allocator_s
 {
@@ -74,6 +78,20 @@ typedef struct rcutils_allocator_s
    * allocator objects.
    */
   void * state;
+  /// Optionally, allocate memory aligned to the given alignment, which is a power of two.
+  /**
+   * Also takes the `state` pointer.
+   * An error should be indicated by returning `NULL`.
+   * This must be `NULL` if `aligned_deallocate` is, and should only be called through
+   * rcutils_aligned_allocate(), which supports allocators which leave this `NULL` too.
+   */
+  void * (*aligned_allocate)(size_t alignment, size_t size, void * state);
+  /// Optionally, deallocate memory allocated with `aligned_allocate`.
+  /**
+   * Also takes the `state` pointer.
+   * This should only be called through rcutils_aligned_deallocate().
+   */
+  void (* aligned_deallocate)(void * pointer, void * state);
 } rcutils_allocator_t;
 
 /// Return a zero initialized allocator.
@@ -94,6 +112,13 @@ rcutils_get_zero_initialized_allocator(void);
  * - reallocate = wraps realloc()
  * - zero_allocate = wraps calloc()
  * - state = `NULL`
+ * - aligned_allocate = `NULL`
+ * - aligned_deallocate = `NULL`
+ *
+ * rcutils_aligned_allocate() still allocates aligned memory from the C library for the default
+ * allocator, but the aligned functions are left `NULL`, so that an allocator made by replacing
+ * the other functions of the default allocator doesn't allocate aligned memory from the C
+ * library instead of its own functions.
  *
  * <hr>
  * Attribute          | Adherence
@@ -144,6 +169,844 @@ RCUTILS_WARN_UNUSED
 void *
 rcutils_reallocf(void * pointer, size_t size, rcutils_allocator_t * allocator);
 
+/// Allocate memory aligned to the given alignment with the given allocator.
+/**
+ * This uses the `aligned_allocate` function of the allocator if it has one.
+ * Otherwise, for the default allocator, this uses aligned_alloc(), or _aligned_malloc() on
+ * Windows, and for other allocators, this allocates enough more memory with `allocate` to align
+ * it, so that any allocator can allocate aligned memory, e.g. slots aligned to cache lines for
+ * lock-free queues, or buffers aligned for SIMD instructions.
+ *
+ * The memory must be deallocated with rcutils_aligned_deallocate() and the same allocator.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] alignment the alignment of the memory, in bytes, which must be a power of two
+ * \param[in] size the size of the memory, in bytes
+ * \param[in] allocator the allocator to allocate the memory with
+ * \return the allocated memory, or
+ * \return `NULL` if the alignment is not a power of two, the allocator is invalid, or the
+ *   allocation failed.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+void *
+rcutils_aligned_allocate(size_t alignment, size_t size, const rcutils_allocator_t * allocator);
+
+/// Deallocate memory allocated with rcutils_aligned_allocate().
+/**
+ * Deallocating `NULL` does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] pointer the memory to deallocate
+ * \param[in] allocator the allocator the memory was allocated with
+ */
+RCUTILS_PUBLIC
+void
+rcutils_aligned_deallocate(void * pointer, const rcutils_allocator_t * allocator);
+
+/// The default size of the blocks of an arena, in bytes.
+#define RCUTILS_ARENA_DEFAULT_BLOCK_SIZE 4096
+
+struct rcutils_arena_impl_s;
+
+/// An arena, or bump allocator, for many short-lived allocations which are freed together.
+/**
+ * An arena takes memory in large blocks from another allocator, and hands it out by bumping
+ * a pointer within the current block, so that allocating is a few instructions and deallocating
+ * does nothing.
+ * Instead, all of its allocations are freed at once by rcutils_arena_reset(), which keeps a
+ * block for the next ones, or by rcutils_arena_fini().
+ *
+ * rcutils_arena_get_allocator() returns an rcutils_allocator_t allocating from the arena,
+ * which can be given to any function taking an allocator, e.g. to split a string or build a
+ * string map during a phase whose results are all dropped afterwards.
+ * Allocations are aligned like those of malloc().
+ * Reallocating the last allocation grows or shrinks it in place when the block has room, and
+ * deallocating the last allocation gives its memory back to the arena, any other deallocation
+ * being a no-op.
+ *
+ * An arena must not be used from many threads at once, including through its allocator.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_arena_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_arena_impl_s * impl;
+} rcutils_arena_t;
+
+/// Return an empty arena struct.
+/**
+ * This function returns an empty and zero initialized arena struct,
+ * which must be initialized with rcutils_arena_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_arena_t
+rcutils_get_zero_initialized_arena(void);
+
+/// Initialize an arena.
+/**
+ * No block is allocated until the first allocation from the arena.
+ * Allocations larger than the block size get a block of their own.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] arena zero initialized arena to be initialized
+ * \param[in] block_size the size of the blocks taken from the allocator, in bytes, or `0`
+ *   for #RCUTILS_ARENA_DEFAULT_BLOCK_SIZE
+ * \param[in] allocator the allocator to use for the arena and its blocks
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_arena_init(
+  rcutils_arena_t * arena,
+  size_t block_size,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize an arena, deallocating all of its memory.
+/**
+ * All memory allocated from the arena is freed, and its allocators must not be used anymore.
+ * Finalizing a zero initialized arena does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] arena the arena to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_arena_fini(rcutils_arena_t * arena);
+
+/// Free all memory allocated from an arena at once, keeping a block for the next allocations.
+/**
+ * The block which was the current one is kept and reused from its start, and the other blocks
+ * are deallocated, so that an arena which is reset after every phase of work stops allocating
+ * once its block is large enough for a phase.
+ * The allocators of the arena stay valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] arena the arena to be reset
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the arena is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_arena_reset(rcutils_arena_t * arena);
+
+/// Return an allocator allocating from the given arena.
+/**
+ * The allocator holds a pointer to the implementation of the arena, so it stays valid when the
+ * arena struct is copied or moved, until the arena is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] arena the initialized arena to allocate from
+ * \return an allocator allocating from the arena, or
+ * \return a zero initialized allocator if the arena is `NULL` or not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_allocator_t
+rcutils_arena_get_allocator(const rcutils_arena_t * arena);
+
+/// The largest allocation served from the blocks of a block pool, in bytes.
+#define RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE 256
+
+struct rcutils_block_pool_impl_s;
+
+/// A pool of fixed-size blocks, for the many small objects of containers.
+/**
+ * A block pool serves the allocations of up to #RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE bytes from
+ * blocks of a size class, a multiple of 16 bytes, which are carved out of large chunks taken
+ * from another allocator and kept in a free list per size class once deallocated.
+ * Allocating and deallocating a block is then a free list pop or push, so that containers
+ * allocating a node per element, e.g. a hash map or an array list, have fast allocations of
+ * predictable latency once the pool holds enough blocks.
+ * Larger allocations are forwarded to the other allocator.
+ *
+ * rcutils_block_pool_get_allocator() returns an rcutils_allocator_t allocating from the pool,
+ * which can be given to any function taking an allocator.
+ * Allocations are aligned to 16 bytes, and each takes 16 more bytes for its size.
+ * The chunks are only given back to the other allocator when the pool is finalized.
+ *
+ * A pool initialized as thread-safe may be used from many threads at once.
+ * Each thread then allocates from and deallocates to a cache of free blocks of its own, without
+ * locking, and only locks the pool to move blocks in batches between its cache and the shared
+ * free lists, which happens once every few allocations or deallocations.
+ * The blocks cached by a thread are given back to the pool when the thread exits.
+ * Otherwise the pool must only be used from one thread at a time.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_block_pool_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_block_pool_impl_s * impl;
+} rcutils_block_pool_t;
+
+/// Return an empty block pool struct.
+/**
+ * This function returns an empty and zero initialized block pool struct,
+ * which must be initialized with rcutils_block_pool_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_block_pool_t
+rcutils_get_zero_initialized_block_pool(void);
+
+/// Initialize a block pool.
+/**
+ * No chunk is allocated until the first allocation from the pool.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] pool zero initialized block pool to be initialized
+ * \param[in] thread_safe whether the pool may be used from many threads at once
+ * \param[in] allocator the allocator to use for the pool, its chunks and the large allocations
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_block_pool_init(
+  rcutils_block_pool_t * pool,
+  bool thread_safe,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a block pool, deallocating its chunks.
+/**
+ * All blocks allocated from the pool are freed, whether they were deallocated or not, and its
+ * allocators must not be used anymore, from any thread.
+ * Allocations larger than #RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE must have been deallocated
+ * before, as they are not tracked by the pool.
+ * Finalizing a zero initialized block pool does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] pool the block pool to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_block_pool_fini(rcutils_block_pool_t * pool);
+
+/// Return an allocator allocating from the given block pool.
+/**
+ * The allocator holds a pointer to the implementation of the pool, so it stays valid when the
+ * pool struct is copied or moved, until the pool is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] pool the initialized block pool to allocate from
+ * \return an allocator allocating from the pool, or
+ * \return a zero initialized allocator if the pool is `NULL` or not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_allocator_t
+rcutils_block_pool_get_allocator(const rcutils_block_pool_t * pool);
+
+/// The default largest allocation cached by a caching allocator, in bytes.
+#define RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_BLOCK_SIZE 1024
+
+/// The default number of blocks of each size class a thread caches in a caching allocator.
+#define RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_CACHED_BLOCKS 64
+
+struct rcutils_caching_allocator_impl_s;
+
+/// A front-end to another allocator, which caches the freed blocks in each thread.
+/**
+ * A caching allocator allocates blocks whose size is a power of two from another allocator, and
+ * keeps the blocks freed in a thread in a cache of that thread, with a free list per size class,
+ * instead of deallocating them.
+ * Allocations in that thread take a block of their size class from its cache first, so that
+ * allocating and deallocating blocks of the same sizes in a thread, e.g. a message per cycle of
+ * a real-time loop, doesn't touch any state shared with other threads, such as the locks of
+ * malloc, once the cache holds enough blocks.
+ *
+ * rcutils_caching_allocator_get_allocator() returns an rcutils_allocator_t allocating from the
+ * caching allocator, which may be used from many threads at once, if the other allocator may.
+ * Blocks may be deallocated in another thread than the one which allocated them.
+ * Allocations are rounded up to a power of two of at least 16 bytes, are aligned to 16 bytes,
+ * and each takes 16 more bytes for its size.
+ * Allocations larger than the largest cached block size are forwarded to the other allocator.
+ *
+ * When a thread exits, the blocks it cached are deallocated to the other allocator.
+ * A thread may also do so earlier, e.g. after a burst of allocations, with
+ * rcutils_caching_allocator_drain_thread_cache().
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_caching_allocator_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_caching_allocator_impl_s * impl;
+} rcutils_caching_allocator_t;
+
+/// Return an empty caching allocator struct.
+/**
+ * This function returns an empty and zero initialized caching allocator struct,
+ * which must be initialized with rcutils_caching_allocator_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_caching_allocator_t
+rcutils_get_zero_initialized_caching_allocator(void);
+
+/// Initialize a caching allocator.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] caching_allocator zero initialized caching allocator to be initialized
+ * \param[in] max_block_size the largest allocation which is cached, rounded up to a power of
+ *   two, e.g. #RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_BLOCK_SIZE
+ * \param[in] max_cached_blocks the most blocks of each size class a thread caches, beyond
+ *   which the freed blocks are deallocated, e.g.
+ *   #RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_CACHED_BLOCKS
+ * \param[in] allocator the allocator to cache the blocks of, which is also used for the caches
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_caching_allocator_init(
+  rcutils_caching_allocator_t * caching_allocator,
+  size_t max_block_size,
+  size_t max_cached_blocks,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a caching allocator, deallocating the blocks cached by all threads.
+/**
+ * The blocks allocated from the caching allocator should all have been deallocated before, as
+ * the others are not tracked and can't be deallocated afterwards.
+ * Its allocators must not be used anymore, from any thread.
+ * Finalizing a zero initialized caching allocator does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] caching_allocator the caching allocator to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_caching_allocator_fini(rcutils_caching_allocator_t * caching_allocator);
+
+/// Deallocate the blocks cached by the calling thread to the other allocator.
+/**
+ * This is done when the thread exits anyway, so it is only needed to give the memory back
+ * earlier.
+ * The thread keeps using its cache afterwards.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] caching_allocator the caching allocator whose cache is drained
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the caching allocator is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_caching_allocator_drain_thread_cache(rcutils_caching_allocator_t * caching_allocator);
+
+/// Return an allocator allocating from the given caching allocator.
+/**
+ * The allocator holds a pointer to the implementation of the caching allocator, so it stays
+ * valid when the caching allocator struct is copied or moved, until it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] caching_allocator the initialized caching allocator to allocate from
+ * \return an allocator allocating from the caching allocator, or
+ * \return a zero initialized allocator if the caching allocator is `NULL` or not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_allocator_t
+rcutils_caching_allocator_get_allocator(const rcutils_caching_allocator_t * caching_allocator);
+
+/// The most call sites whose allocations a tracking allocator counts separately.
+#define RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES 256
+
+/// The counters of a tracking allocator.
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_tracking_allocator_statistics_s
+{
+  /// The number of allocations, including zero allocations.
+  uint64_t allocations;
+  /// The number of reallocations of allocated memory.
+  uint64_t reallocations;
+  /// The number of deallocations of allocated memory.
+  uint64_t deallocations;
+  /// The sum of the sizes of all allocations and reallocations, in bytes.
+  uint64_t total_bytes;
+  /// The size of the memory which is currently allocated, in bytes.
+  uint64_t current_bytes;
+  /// The largest size of the memory which was allocated at once, in bytes.
+  uint64_t peak_bytes;
+} rcutils_tracking_allocator_statistics_t;
+
+/// The counters of the allocations made from a call site of a tracking allocator.
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_tracking_allocator_call_site_s
+{
+  /// The address of the code which called the allocator, or `NULL` for the allocations of the
+  /// call sites beyond #RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES, or if it is unknown.
+  const void * address;
+  /// The number of allocations and reallocations from the call site.
+  uint64_t allocations;
+  /// The sum of the sizes of the allocations and reallocations from the call site, in bytes.
+  uint64_t bytes;
+} rcutils_tracking_allocator_call_site_t;
+
+struct rcutils_tracking_allocator_impl_s;
+
+/// A front-end to another allocator, which counts the allocations made through it.
+/**
+ * A tracking allocator forwards allocations to another allocator, and counts the allocations,
+ * reallocations and deallocations, as well as the bytes currently allocated, the most bytes
+ * allocated at once and the bytes allocated in total.
+ * Passing rcutils_tracking_allocator_get_allocator() to functions instead of another allocator
+ * shows whether, and how much, they allocate, e.g. in the cycles of a control loop.
+ *
+ * Each thread counts in counters of its own, which only it writes to, without atomic
+ * read-modify-write operations, and which are summed up by
+ * rcutils_tracking_allocator_get_statistics().
+ * Only the bytes currently allocated, and their peak, are counted in a counter shared by all
+ * threads, as the peak must be checked against the total.
+ *
+ * A tracking allocator may also count the allocations of each call site, i.e. the code which
+ * called the allocate, reallocate or zero allocate function of the allocator, which is
+ * identified by its address, to be resolved with a debugger or e.g. `addr2line` or `dladdr()`.
+ * This takes a lock for every allocation, so it should only be used for debugging, and is only
+ * supported with GCC, Clang and MSVC.
+ *
+ * Each allocation takes 16 more bytes, for its size.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_tracking_allocator_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_tracking_allocator_impl_s * impl;
+} rcutils_tracking_allocator_t;
+
+/// Return an empty tracking allocator struct.
+/**
+ * This function returns an empty and zero initialized tracking allocator struct,
+ * which must be initialized with rcutils_tracking_allocator_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_tracking_allocator_t
+rcutils_get_zero_initialized_tracking_allocator(void);
+
+/// Initialize a tracking allocator.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tracking_allocator zero initialized tracking allocator to be initialized
+ * \param[in] track_call_sites whether the allocations of each call site are counted
+ * \param[in] allocator the allocator to forward the allocations to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_tracking_allocator_init(
+  rcutils_tracking_allocator_t * tracking_allocator,
+  bool track_call_sites,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a tracking allocator.
+/**
+ * The memory allocated from the tracking allocator should have been deallocated before, as
+ * its allocators must not be used anymore.
+ * Finalizing a zero initialized tracking allocator does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tracking_allocator the tracking allocator to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_tracking_allocator_fini(rcutils_tracking_allocator_t * tracking_allocator);
+
+/// Return an allocator allocating through the given tracking allocator.
+/**
+ * The allocator may be used from many threads at once, if the other allocator may.
+ * It holds a pointer to the implementation of the tracking allocator, so it stays valid when
+ * the tracking allocator struct is copied or moved, until it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] tracking_allocator the initialized tracking allocator to allocate through
+ * \return an allocator allocating through the tracking allocator, or
+ * \return a zero initialized allocator if the tracking allocator is `NULL` or not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_allocator_t
+rcutils_tracking_allocator_get_allocator(const rcutils_tracking_allocator_t * tracking_allocator);
+
+/// Get the counters of a tracking allocator.
+/**
+ * The counters are summed up from the slots of all threads, while other threads may still
+ * allocate, so they are only exact when no thread allocates at the same time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] tracking_allocator the tracking allocator to get the counters of
+ * \param[out] statistics the counters
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the tracking allocator is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_tracking_allocator_get_statistics(
+  const rcutils_tracking_allocator_t * tracking_allocator,
+  rcutils_tracking_allocator_statistics_t * statistics);
+
+/// Get the counters of the call sites of a tracking allocator, the most allocating first.
+/**
+ * At most `capacity` call sites are copied, and `count` is set to the number of call sites
+ * which allocated, which may be larger, or to zero if the tracking allocator doesn't track
+ * call sites.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] tracking_allocator the tracking allocator to get the call sites of
+ * \param[out] call_sites the array the call sites are copied to, which may be `NULL` if
+ *   `capacity` is zero
+ * \param[in] capacity the number of elements of `call_sites`
+ * \param[out] count the number of call sites which allocated
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the tracking allocator is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_tracking_allocator_get_call_sites(
+  const rcutils_tracking_allocator_t * tracking_allocator,
+  rcutils_tracking_allocator_call_site_t * call_sites,
+  size_t capacity,
+  size_t * count);
+
+/// Reset the counters of a tracking allocator, e.g. before the code to measure.
+/**
+ * All counters are reset to zero, but the bytes currently allocated, which are still counted
+ * when deallocated, and their peak, which is reset to the bytes currently allocated.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] tracking_allocator the tracking allocator to reset
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the tracking allocator is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_tracking_allocator_reset(rcutils_tracking_allocator_t * tracking_allocator);
+
+/// The NUMA node of a page allocator which maps memory on any node, as the system does.
+#define RCUTILS_PAGE_ALLOCATOR_ANY_NODE (-1)
+
+/// The NUMA node of a page allocator which maps memory on the node of the allocating thread.
+#define RCUTILS_PAGE_ALLOCATOR_LOCAL_NODE (-2)
+
+/// The default smallest allocation which a page allocator maps, in bytes.
+#define RCUTILS_PAGE_ALLOCATOR_DEFAULT_MIN_SIZE (64 * 1024)
+
+/// Whether a page allocator backs its mappings with huge pages.
+typedef enum rcutils_page_allocator_huge_pages_e
+{
+  /// Use pages of the base size only.
+  RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE = 0,
+  /// Advise the kernel to back the mappings with transparent huge pages.
+  RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_TRANSPARENT = 1,
+  /// Map huge pages reserved by the system, e.g. in `/proc/sys/vm/nr_hugepages`, falling back
+  /// to transparent huge pages once there are none left.
+  RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_EXPLICIT = 2,
+} rcutils_page_allocator_huge_pages_t;
+
+/// The options of a page allocator.
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_page_allocator_options_s
+{
+  /// The NUMA node the mappings are bound to, #RCUTILS_PAGE_ALLOCATOR_ANY_NODE or
+  /// #RCUTILS_PAGE_ALLOCATOR_LOCAL_NODE.
+  int numa_node;
+  /// Whether the mappings are backed with huge pages.
+  rcutils_page_allocator_huge_pages_t huge_pages;
+  /// The smallest allocation which is mapped, smaller ones being forwarded to the other
+  /// allocator.
+  size_t min_size;
+} rcutils_page_allocator_options_t;
+
+struct rcutils_page_allocator_impl_s;
+
+/// A front-end to another allocator, which maps large allocations with pages of its own.
+/**
+ * A page allocator maps each allocation of at least `min_size` bytes directly from the
+ * operating system, which lets it choose where the pages of large buffers, e.g. the ones of
+ * rcutils_uint8_array_t holding point clouds or images, come from:
+ *
+ * - the mappings may be bound to a NUMA node, before the pages are touched, so that the
+ *   buffers are on the node of the threads which process them, or to the node of the CPU the
+ *   allocating thread runs on, with #RCUTILS_PAGE_ALLOCATOR_LOCAL_NODE, which is only
+ *   preferred, as the thread may migrate,
+ * - the mappings may be backed with huge pages, so that a buffer of several MiB takes a few
+ *   entries of the TLB instead of hundreds.
+ *   Transparent huge pages only back the parts of a mapping which are aligned to the huge page
+ *   size, so the mappings of at least that size are aligned to it, and the kernel only backs
+ *   them with huge pages if they are enabled, in `/sys/kernel/mm/transparent_hugepage/enabled`.
+ *   Explicit huge pages are taken from the pool the system reserved, and the mappings are
+ *   rounded up to the huge page size.
+ *
+ * Smaller allocations are forwarded to the other allocator, as mapping takes system calls.
+ * The memory is returned to the system as soon as it is deallocated, and the mappings are
+ * already zeroed, which makes zero allocating them free.
+ * Allocations are aligned to 16 bytes and each takes 16 more bytes for its size.
+ *
+ * Binding to NUMA nodes and huge pages are best effort, i.e. the memory is still allocated if
+ * the kernel doesn't support them, and are only supported on Linux.
+ * On other platforms, all allocations are forwarded to the other allocator.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_page_allocator_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_page_allocator_impl_s * impl;
+} rcutils_page_allocator_t;
+
+/// Return the default options of a page allocator.
+/**
+ * The defaults map the allocations of at least #RCUTILS_PAGE_ALLOCATOR_DEFAULT_MIN_SIZE bytes
+ * on any NUMA node, without huge pages.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_page_allocator_options_t
+rcutils_page_allocator_get_default_options(void);
+
+/// Return an empty page allocator struct.
+/**
+ * This function returns an empty and zero initialized page allocator struct,
+ * which must be initialized with rcutils_page_allocator_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_page_allocator_t
+rcutils_get_zero_initialized_page_allocator(void);
+
+/// Initialize a page allocator.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] page_allocator zero initialized page allocator to be initialized
+ * \param[in] options the options of the page allocator
+ * \param[in] allocator the allocator to forward the small allocations to, which is also used
+ *   for the page allocator itself
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, e.g. a NUMA node which doesn't
+ *   exist, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if NUMA nodes or huge pages are not supported on this platform.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_page_allocator_init(
+  rcutils_page_allocator_t * page_allocator,
+  const rcutils_page_allocator_options_t * options,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a page allocator.
+/**
+ * The memory allocated from the page allocator should have been deallocated before, as its
+ * allocators must not be used anymore.
+ * Finalizing a zero initialized page allocator does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] page_allocator the page allocator to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_page_allocator_fini(rcutils_page_allocator_t * page_allocator);
+
+/// Return an allocator allocating from the given page allocator.
+/**
+ * The allocator may be used from many threads at once, if the other allocator may.
+ * It holds a pointer to the implementation of the page allocator, so it stays valid when the
+ * page allocator struct is copied or moved, until it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] page_allocator the initialized page allocator to allocate from
+ * \return an allocator allocating from the page allocator, or
+ * \return a zero initialized allocator if the page allocator is `NULL` or not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_allocator_t
+rcutils_page_allocator_get_allocator(const rcutils_page_allocator_t * page_allocator);
+
 #ifdef __cplusplus
 }
 #endif
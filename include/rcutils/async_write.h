@@ -0,0 +1,228 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__ASYNC_WRITE_H_
+#define RCUTILS__ASYNC_WRITE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/process.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// How an asynchronous writer performs the writes.
+typedef enum rcutils_async_write_backend_e
+{
+  /// io_uring where the kernel supports it, and a thread pool otherwise.
+  RCUTILS_ASYNC_WRITE_BACKEND_AUTO = 0,
+  /// An io_uring instance, only available on Linux 5.6 or newer.
+  RCUTILS_ASYNC_WRITE_BACKEND_IO_URING = 1,
+  /// A pool of threads making blocking writes.
+  RCUTILS_ASYNC_WRITE_BACKEND_THREADS = 2,
+} rcutils_async_write_backend_t;
+
+/// The options of an asynchronous writer.
+typedef struct rcutils_async_writer_options_s
+{
+  /// The backend to use.
+  rcutils_async_write_backend_t backend;
+  /// The most writes the io_uring backend has in flight at once.
+  uint32_t queue_depth;
+  /// The number of threads of the thread pool backend.
+  size_t thread_count;
+  /// The CPUs and scheduling of the threads of the writer.
+  rcutils_thread_attributes_t thread_attributes;
+} rcutils_async_writer_options_t;
+
+/// The function called once an asynchronous write is done.
+/**
+ * It is called on a thread of the writer, with #RCUTILS_RET_OK if all the data was written,
+ * or #RCUTILS_RET_ERROR otherwise, along with the number of bytes written before the error.
+ * It may submit more writes, but must not flush nor finalize the writer.
+ */
+typedef void (* rcutils_async_write_callback_t)(rcutils_ret_t ret, size_t written, void * context);
+
+struct rcutils_async_writer_impl_s;
+
+/// A writer submitting writes to files without waiting for them to complete.
+/**
+ * On Linux, writes are submitted in batches to an io_uring instance by a background thread,
+ * which reaps their completions and calls their callbacks, so that submitting a write only
+ * queues it.
+ * Elsewhere, or where io_uring is unavailable, e.g. with older kernels or when it is
+ * forbidden by a seccomp filter, a pool of threads makes blocking writes instead.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_async_writer_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_async_writer_impl_s * impl;
+} rcutils_async_writer_t;
+
+/// Return the default options of an asynchronous writer.
+/**
+ * The defaults are the automatic backend, with up to 64 writes in flight with io_uring,
+ * or 2 threads otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_async_writer_options_t
+rcutils_async_writer_get_default_options(void);
+
+/// Return an empty asynchronous writer struct.
+/**
+ * This function returns an empty and zero initialized asynchronous writer struct,
+ * which must be initialized with rcutils_async_writer_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_async_writer_t
+rcutils_get_zero_initialized_async_writer(void);
+
+/// Initialize an asynchronous writer and start its threads.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] writer zero initialized writer to be initialized
+ * \param[in] options the options of the writer, or NULL for the defaults
+ * \param[in] allocator the allocator to use for the writer and its requests
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if io_uring was requested and is unavailable, or if an unknown
+ *   error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_writer_init(
+  rcutils_async_writer_t * writer,
+  const rcutils_async_writer_options_t * options,
+  const rcutils_allocator_t * allocator);
+
+/// Wait for the submitted writes to complete and finalize the writer.
+/**
+ * No other thread may use the writer while, nor after, it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] writer the writer to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_writer_fini(rcutils_async_writer_t * writer);
+
+/// Return the backend the writer uses, which is never #RCUTILS_ASYNC_WRITE_BACKEND_AUTO.
+/**
+ * \param[in] writer the initialized writer
+ * \return the backend of the writer, or #RCUTILS_ASYNC_WRITE_BACKEND_AUTO if it is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_async_write_backend_t
+rcutils_async_writer_get_backend(const rcutils_async_writer_t * writer);
+
+/// Submit a write of data to a file at the given offset, like `pwrite()`.
+/**
+ * The write is queued and this returns without waiting for it; the data must stay valid and
+ * unchanged until the callback is called.
+ * Short writes are continued until all the data is written or an error occurs.
+ * Writes may complete in any order, so writes to overlapping ranges of a file must wait for
+ * each other, and the file must not be opened with `O_APPEND`, which makes Linux ignore
+ * the offset.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, until enough requests were recycled
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] writer the initialized writer
+ * \param[in] fd the file descriptor of a file opened for writing
+ * \param[in] data the data to write
+ * \param[in] length the number of bytes to write
+ * \param[in] offset the offset in the file to write at, which must not be negative
+ * \param[in] callback the function called once the write is done, or NULL
+ * \param[in] context the context given to the callback
+ * \return #RCUTILS_RET_OK if the write was submitted, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the writer is invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_write(
+  rcutils_async_writer_t * writer,
+  int fd,
+  const void * data,
+  size_t length,
+  int64_t offset,
+  rcutils_async_write_callback_t callback,
+  void * context);
+
+/// Wait until all submitted writes completed and their callbacks returned.
+/**
+ * Writes other threads submit while waiting are waited for as well.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] writer the initialized writer
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the writer is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_writer_flush(rcutils_async_writer_t * writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__ASYNC_WRITE_H_
@@ -23,7 +23,11 @@ extern "C"
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
 #include "rcutils/visibility_control.h"
 
 /// Return `true` if the option is defined in the command line arguments or `false` otherwise.
@@ -50,6 +54,145 @@ RCUTILS_PUBLIC
 char *
 rcutils_cli_get_option(char ** begin, char ** end, const char * option);
 
+struct rcutils_cli_index_impl_s;
+
+/// An index of command line arguments, built once, to look options up without scanning them.
+/**
+ * Each distinct argument is hashed into a table, along with the positions where it occurs,
+ * so that looking an option up takes constant time however many arguments there are, and
+ * that the values of an option given many times, like `-r` or `-p` after `--ros-args`, can
+ * be iterated over in order.
+ *
+ * Unlike rcutils_cli_get_option(), options are matched against whole arguments only.
+ * The arguments are not copied, so they must outlive the index and not be modified.
+ * Once initialized, the index may be queried from many threads at once.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_cli_index_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_cli_index_impl_s * impl;
+} rcutils_cli_index_t;
+
+/// Return an empty command line index struct.
+/**
+ * This function returns an empty and zero initialized command line index struct,
+ * which must be initialized with rcutils_cli_index_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_cli_index_t
+rcutils_get_zero_initialized_cli_index(void);
+
+/// Initialize a rcutils_cli_index_t over the command line arguments.
+/**
+ * Null arguments are skipped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] index rcutils_cli_index_t to be initialized
+ * \param[in] begin first element of the array of arguments
+ * \param[in] end one past the last element of the array of arguments
+ * \param[in] allocator the allocator to use through out the lifetime of the index
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_cli_index_init(
+  rcutils_cli_index_t * index,
+  char ** begin,
+  char ** end,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized command line index struct.
+/**
+ * \param[inout] index rcutils_cli_index_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_cli_index_fini(rcutils_cli_index_t * index);
+
+/// Return the number of times an option occurs in the indexed arguments.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] index rcutils_cli_index_t to be queried
+ * \param[in] option the argument to look up
+ * \return the number of arguments equal to the option, or
+ * \return `0` if the index or the option is `NULL`, or the index isn't initialized.
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_cli_index_get_option_count(const rcutils_cli_index_t * index, const char * option);
+
+/// Return `true` if the option occurs in the indexed arguments or `false` otherwise.
+/**
+ * This is the indexed version of rcutils_cli_option_exist().
+ *
+ * \param[in] index rcutils_cli_index_t to be queried
+ * \param[in] option the argument to look up
+ * \return `true` if the option exists, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_cli_index_option_exist(const rcutils_cli_index_t * index, const char * option);
+
+/// Return the argument following an occurrence of an option in the indexed arguments.
+/**
+ * Occurrences are numbered from zero in the order of the arguments, so iterating up to
+ * rcutils_cli_index_get_option_count() visits all the values given to a repeated option.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] index rcutils_cli_index_t to be queried
+ * \param[in] option the argument to look up
+ * \param[in] occurrence the number of the occurrence of the option
+ * \return the argument following that occurrence of the option, or
+ * \return `NULL` if there aren't that many occurrences, or the last one is the last argument.
+ */
+RCUTILS_PUBLIC
+char *
+rcutils_cli_index_get_option_at(
+  const rcutils_cli_index_t * index, const char * option, size_t occurrence);
+
+/// Return the argument following the first occurrence of an option in the indexed arguments.
+/**
+ * This is the indexed version of rcutils_cli_get_option(), except that the option must be
+ * equal to a whole argument.
+ *
+ * \param[in] index rcutils_cli_index_t to be queried
+ * \param[in] option the argument to look up
+ * \return the argument following the option, or
+ * \return `NULL` if the option doesn't exist, or is the last argument.
+ */
+RCUTILS_PUBLIC
+char *
+rcutils_cli_index_get_option(const rcutils_cli_index_t * index, const char * option);
+
 #ifdef __cplusplus
 }
 #endif
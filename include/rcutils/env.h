@@ -23,6 +23,7 @@ extern "C"
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "rcutils/macros.h"
 #include "rcutils/visibility_control.h"
@@ -92,6 +93,78 @@ RCUTILS_WARN_UNUSED
 const char *
 rcutils_get_env(const char * env_name, const char ** env_value);
 
+/// Retrieve the value of an environment variable from a snapshot of the environment.
+/**
+ * This behaves like rcutils_get_env(), but looks the variable up in a hash table built
+ * from the whole environment by the first call, instead of scanning the environment each
+ * time, so that querying the same variables repeatedly is cheap.
+ *
+ * The snapshot is discarded by rcutils_set_env() and rcutils_env_cache_invalidate(), and
+ * taken again by the next lookup.
+ * Changes made to the environment otherwise, e.g. with `setenv()`, aren't seen until then.
+ *
+ * The value is owned by the snapshot, and is only valid until the snapshot is discarded.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, on the first call after the snapshot is discarded
+ * Thread-Safe        | Yes, but not together with rcutils_set_env()
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] env_name the name of the environment variable
+ * \param[out] env_value pointer to the value cstring, or "" if unset
+ * \return NULL on success (success can be returning an empty string), or
+ * \return an error string on failure.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const char *
+rcutils_get_env_cached(const char * env_name, const char ** env_value);
+
+/// Retrieve the values of several environment variables from a snapshot of the environment.
+/**
+ * This looks each variable up like rcutils_get_env_cached(), all in the same snapshot.
+ *
+ * ```c
+ * const char * names[] = {"ROS_DOMAIN_ID", "ROS_LOCALHOST_ONLY"};
+ * const char * values[2];
+ * const char * error_str = rcutils_get_env_many(names, 2, values);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, on the first call after the snapshot is discarded
+ * Thread-Safe        | Yes, but not together with rcutils_set_env()
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] env_names the names of the environment variables
+ * \param[in] count the number of environment variables
+ * \param[out] env_values array of count values, each set to the value cstring, or "" if unset
+ * \return NULL on success, or
+ * \return an error string on failure.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const char *
+rcutils_get_env_many(const char * const * env_names, size_t count, const char ** env_values);
+
+/// Discard the snapshot of the environment used by rcutils_get_env_cached().
+/**
+ * This should be called after changing the environment other than with rcutils_set_env(),
+ * which calls it.
+ * The values returned from the snapshot are invalid afterwards.
+ *
+ * This function cannot be concurrently called together with rcutils_get_env_cached() nor
+ * rcutils_get_env_many() on different threads.
+ */
+RCUTILS_PUBLIC
+void
+rcutils_env_cache_invalidate(void);
+
 /// Retrieve the full path to the home directory.
 /**
  * The c-string which is returned is only valid until the next time this
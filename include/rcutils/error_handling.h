@@ -132,12 +132,35 @@ static_assert(
   "Maximum length calculations incorrect");
 #endif
 
+/// The maximum number of frames which can be pushed onto an error, see RCUTILS_PUSH_ERROR_FRAME().
+#define RCUTILS_ERROR_FRAMES_MAX_COUNT 8
+
+/// Struct which encapsulates a frame pushed onto the error with RCUTILS_PUSH_ERROR_FRAME().
+typedef struct rcutils_error_frame_s
+{
+  /// The code returned by the function which pushed the frame.
+  rcutils_ret_t code;
+  /// The message of the frame, with static storage duration.
+  const char * message;
+  /// The path to the file in which the frame was pushed, with static storage duration.
+  const char * file;
+  /// The line number on which the frame was pushed.
+  uint64_t line_number;
+} rcutils_error_frame_t;
+
 /// Forces initialization of thread-local storage if called in a newly created thread.
 /**
  * If this function is not called beforehand, then the first time the error
  * state is set or the first time the error message is retrieved, the default
  * allocator will be used to allocate thread-local storage.
  *
+ * If this library was built with `RCUTILS_COMPACT_ERROR_STATE`, the
+ * thread-local storage only holds pointers to the current error, and the
+ * rcutils_error_state_t which copies of error messages are kept in is
+ * allocated by this function with the given allocator, or else with the
+ * default allocator the first time it is needed, and deallocated when the
+ * thread exits.
+ *
  * This function may or may not allocate memory.
  * The system's thread-local storage implementation may need to allocate
  * memory, since it usually has no way of knowing how much storage is needed
@@ -193,6 +216,34 @@ RCUTILS_PUBLIC
 void
 rcutils_set_error_state(const char * error_string, const char * file, size_t line_number);
 
+/// Set the error message, file and line without copying the strings.
+/**
+ * This behaves like rcutils_set_error_state(), except that only the pointers
+ * to the message and file are kept, so they must have static storage
+ * duration, e.g. be string literals and `__FILE__`.
+ * Those of a shared library are gone once it is unloaded, e.g. with
+ * `dlclose()`, so a library which may be unloaded before its errors are read
+ * must not call this, see #RCUTILS_SET_ERROR_MSG_STATIC_LITERALS.
+ * The error state and error string are only formatted from them when
+ * rcutils_get_error_state() or rcutils_get_error_string() are called, which
+ * makes setting the error a few stores.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] error_string The error message to set, with static storage duration.
+ * \param[in] file The path to the file in which the error occurred, with static storage duration.
+ * \param[in] line_number The line number on which the error occurred.
+ */
+RCUTILS_PUBLIC
+void
+rcutils_set_error_state_static(const char * error_string, const char * file, size_t line_number);
+
 /// Check an argument for a null value.
 /**
  * If the argument's value is `NULL`, set the error message saying so and
@@ -223,6 +274,24 @@ rcutils_set_error_state(const char * error_string, const char * file, size_t lin
     } \
   } while (0)
 
+#ifndef RCUTILS_SET_ERROR_MSG_STATIC_LITERALS
+/// Whether RCUTILS_SET_ERROR_MSG() keeps pointers to string literals instead of copying them.
+/**
+ * The pointers to the string literals of a shared library dangle once it is
+ * unloaded, e.g. with `dlclose()`, while the error it set may still be read.
+ * So this is only enabled by default for rcutils itself, which holds the
+ * error state and therefore can't be unloaded before it.
+ * Code which is never unloaded before its errors are read, e.g. which is
+ * linked into an executable, may define it to `1` before including this
+ * header to set errors without copying their messages.
+ */
+# ifdef RCUTILS_BUILDING_DLL
+#  define RCUTILS_SET_ERROR_MSG_STATIC_LITERALS 1
+# else
+#  define RCUTILS_SET_ERROR_MSG_STATIC_LITERALS 0
+# endif
+#endif
+
 /// Set the error message, as well as append the current file and line number.
 /**
  * If an error message was previously set, and rcutils_reset_error() was not called
@@ -231,10 +300,28 @@ rcutils_set_error_state(const char * error_string, const char * file, size_t lin
  * Error state storage is thread local and so all error related functions are
  * also thread local.
  *
+ * If #RCUTILS_SET_ERROR_MSG_STATIC_LITERALS is enabled, with compilers which
+ * can tell string literals apart at compile time, i.e. GCC and Clang, a string
+ * literal message is set with rcutils_set_error_state_static(), which only
+ * keeps pointers to it and `__FILE__`.
+ * Any other message is copied with rcutils_set_error_state().
+ *
  * \param[in] msg The error message to be set.
  */
+#if (defined(__GNUC__) || defined(__clang__)) && RCUTILS_SET_ERROR_MSG_STATIC_LITERALS
+// __builtin_constant_p() doesn't evaluate msg, and is only true for string literals among strings.
+#define RCUTILS_SET_ERROR_MSG(msg) \
+  do { \
+    if (__builtin_constant_p(msg)) { \
+      rcutils_set_error_state_static(msg, __FILE__, __LINE__); \
+    } else { \
+      rcutils_set_error_state(msg, __FILE__, __LINE__); \
+    } \
+  } while (0)
+#else
 #define RCUTILS_SET_ERROR_MSG(msg) \
   do {rcutils_set_error_state(msg, __FILE__, __LINE__);} while (0)
+#endif
 
 /// Set the error message using a format string and format arguments.
 /**
@@ -274,6 +361,84 @@ rcutils_set_error_state(const char * error_string, const char * file, size_t lin
     return error_return_value; \
   })
 
+/// Push a frame of context onto the current error.
+/**
+ * This is not meant to be used directly, but instead via the
+ * RCUTILS_PUSH_ERROR_FRAME(code, msg) macro.
+ *
+ * Only the pointers to the message and file are kept, so they must have
+ * static storage duration and must not belong to a shared library which may
+ * be unloaded before the error is read.
+ * The frames are only formatted into the error
+ * string when rcutils_get_error_string() is called, as if each had been set
+ * with RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR(), e.g.
+ * `outer: inner: error, at error.c:1, at inner.c:2, at outer.c:3`.
+ * The frames are not part of the error state returned by
+ * rcutils_get_error_state(), but can be inspected with
+ * rcutils_get_error_frame().
+ *
+ * If no error is set, the message is set as the error instead, like with
+ * rcutils_set_error_state_static().
+ * Setting or resetting the error removes its frames, and once
+ * #RCUTILS_ERROR_FRAMES_MAX_COUNT frames have been pushed, further ones are ignored.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when built with `RCUTILS_COMPACT_ERROR_STATE`, the first time in a thread</i>
+ *
+ * \param[in] code The code returned by the function pushing the frame.
+ * \param[in] message The message of the frame, with static storage duration.
+ * \param[in] file The path to the file, with static storage duration.
+ * \param[in] line_number The line number on which the frame is pushed.
+ */
+RCUTILS_PUBLIC
+void
+rcutils_push_error_frame(
+  rcutils_ret_t code, const char * message, const char * file, size_t line_number);
+
+/// Push a frame of context onto the current error, with the current file and line number.
+/**
+ * This is the cheap alternative to RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR(),
+ * which formats and copies the previous error string for every layer adding
+ * context, see rcutils_push_error_frame().
+ *
+ * ```c
+ * rcutils_ret_t ret = rcutils_do_something();
+ * if (RCUTILS_RET_OK != ret) {
+ *   RCUTILS_PUSH_ERROR_FRAME(ret, "failed to do something");
+ *   return ret;
+ * }
+ * ```
+ *
+ * \param[in] code The code returned by the function pushing the frame.
+ * \param[in] msg The message of the frame, which must be a string literal.
+ */
+#define RCUTILS_PUSH_ERROR_FRAME(code, msg) \
+  do {rcutils_push_error_frame(code, "" msg, __FILE__, __LINE__);} while (0)
+
+/// Return the number of frames pushed onto the current error.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t
+rcutils_get_error_frame_count(void);
+
+/// Return a frame pushed onto the current error, the first pushed having the index 0.
+/**
+ * The returned pointer is valid until the error is set or reset in the same thread.
+ *
+ * \param[in] index The index of the frame.
+ * \return A pointer to the frame, or `NULL` if the index is out of range.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const rcutils_error_frame_t *
+rcutils_get_error_frame(size_t index);
+
 /// Return `true` if the error is set, otherwise `false`.
 RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
@@ -282,7 +447,8 @@ rcutils_error_is_set(void);
 
 /// Return an rcutils_error_state_t which was set with rcutils_set_error_state().
 /**
- * The returned pointer will be NULL if no error has been set in this thread.
+ * The returned error state is empty if no error has been set in this thread.
+ * It is filled in from the current error the first time it is asked for.
  *
  * The returned pointer is valid until RCUTILS_SET_ERROR_MSG, rcutils_set_error_state,
  * or rcutils_reset_error are called in the same thread.
@@ -28,6 +28,10 @@ extern "C"
 
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
+#include "rcutils/time.h"
+#include "rcutils/types/char_array.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/uint8_array.h"
 #include "rcutils/visibility_control.h"
 
 /// Return current working directory.
@@ -109,6 +113,211 @@ RCUTILS_PUBLIC
 bool
 rcutils_is_readable_and_writable(const char * abs_path);
 
+/// The default time for which the metadata cached by a rcutils_stat_cache_t is valid.
+#define RCUTILS_STAT_CACHE_DEFAULT_TTL RCUTILS_S_TO_NS(1)
+/// The default number of paths a rcutils_stat_cache_t holds before it is cleared.
+#define RCUTILS_STAT_CACHE_DEFAULT_MAX_ENTRIES 4096
+
+/// The options of a rcutils_stat_cache_t.
+typedef struct rcutils_stat_cache_options_s
+{
+  /// The time in nanoseconds for which the metadata of a path is valid, or 0 for no expiry.
+  rcutils_duration_value_t ttl;
+  /// Whether to discard the metadata of paths when their parent directory changes.
+  /**
+   * The parent directories are watched with inotify on Linux, and this is ignored elsewhere.
+   */
+  bool watch_changes;
+  /// The number of paths held, beyond which the cache is cleared.
+  size_t max_entries;
+} rcutils_stat_cache_options_t;
+
+/// Return the default options of a rcutils_stat_cache_t.
+/**
+ * The metadata expires after #RCUTILS_STAT_CACHE_DEFAULT_TTL, changes are watched and at
+ * most #RCUTILS_STAT_CACHE_DEFAULT_MAX_ENTRIES paths are held.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_stat_cache_options_t
+rcutils_stat_cache_get_default_options(void);
+
+struct rcutils_stat_cache_impl_s;
+
+/// A cache of the metadata of paths, answering rcutils_exists() and alike from memory.
+/**
+ * Resolving plugins and resources checks the same paths many times, each check costing a
+ * `stat()`.
+ * Checking them through a stat cache instead only calls `stat()` for the first check of a
+ * path, and again once its metadata is stale:
+ * - when it is older than the time to live of the cache, if any, or
+ * - on Linux, when an entry is created, deleted or renamed in its parent directory, or the
+ *   parent directory itself is deleted or renamed, as watched with inotify.
+ *
+ * The changes are read by a thread of the stat cache as they happen, so that checking a
+ * path whose metadata is cached costs no system call, and are seen by the checks shortly
+ * after, typically within microseconds.
+ * The metadata may be discarded at once with rcutils_stat_cache_clear(), e.g. right after
+ * changing files.
+ * The changes made to the ancestors of the parent directory, e.g. renaming the grandparent
+ * directory, nor to the targets of symbolic links, are not watched, and are only seen once
+ * the metadata expires.
+ * The paths whose parent directory can't be watched, e.g. as it doesn't exist, aren't
+ * cached unless the metadata expires.
+ *
+ * A stat cache may be used from many threads at once.
+ */
+typedef struct rcutils_stat_cache_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_stat_cache_impl_s * impl;
+} rcutils_stat_cache_t;
+
+/// Return a zero initialized stat cache struct.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_stat_cache_t
+rcutils_get_zero_initialized_stat_cache(void);
+
+/// Initialize a stat cache.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] stat_cache A zero initialized stat cache.
+ * \param[in] options The options of the cache, or NULL for the default ones.
+ * \param[in] allocator The allocator to use for the cache.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_stat_cache_init(
+  rcutils_stat_cache_t * stat_cache,
+  const rcutils_stat_cache_options_t * options,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a stat cache.
+/**
+ * Finalizing a zero initialized stat cache does nothing.
+ * No other thread may use the stat cache while, nor after, it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] stat_cache The stat cache to finalize.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_stat_cache_fini(rcutils_stat_cache_t * stat_cache);
+
+/// Discard all the metadata held by a stat cache, e.g. after changing files.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] stat_cache An initialized stat cache.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the stat cache isn't initialized, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_stat_cache_clear(rcutils_stat_cache_t * stat_cache);
+
+/// Check if the provided path points to a directory, through a stat cache.
+/**
+ * This is the same as rcutils_is_directory(), unless the metadata of the path is cached.
+ * If the stat cache is invalid or fails to cache the metadata, the path is checked anyway.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] stat_cache An initialized stat cache.
+ * \param[in] abs_path Absolute path to check.
+ * \return `true` if provided path is a directory, or
+ * \return `false` if abs_path is NULL, or
+ * \return `false` on failure.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_stat_cache_is_directory(rcutils_stat_cache_t * stat_cache, const char * abs_path);
+
+/// Check if the provided path points to a file, through a stat cache.
+/**
+ * This is the same as rcutils_is_file(), unless the metadata of the path is cached.
+ * If the stat cache is invalid or fails to cache the metadata, the path is checked anyway.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] stat_cache An initialized stat cache.
+ * \param[in] abs_path Absolute path to check.
+ * \return `true` if provided path is a file, or
+ * \return `false` if abs_path is NULL, or
+ * \return `false` on failure.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_stat_cache_is_file(rcutils_stat_cache_t * stat_cache, const char * abs_path);
+
+/// Check if the provided path points to an existing file/folder, through a stat cache.
+/**
+ * This is the same as rcutils_exists(), unless the metadata of the path is cached.
+ * If the stat cache is invalid or fails to cache the metadata, the path is checked anyway.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] stat_cache An initialized stat cache.
+ * \param[in] abs_path Absolute path to check.
+ * \return `true` if the path exists, or
+ * \return `false` if abs_path is NULL, or
+ * \return `false` on failure.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_stat_cache_exists(rcutils_stat_cache_t * stat_cache, const char * abs_path);
+
 /// Return newly allocated string with arguments separated by correct delimiter for the platform.
 /**
  * This function allocates memory and returns it to the caller.
@@ -147,6 +356,147 @@ rcutils_to_native_path(
   const char * path,
   rcutils_allocator_t allocator);
 
+/// A path built by appending and removing components in place, without allocating per component.
+/**
+ * Unlike rcutils_join_path() and rcutils_to_native_path(), which allocate a new string for
+ * every call, a path builder keeps a single buffer, which only grows when a path longer than
+ * any before is built, so that walking a directory tree costs no allocation per entry:
+ * ```c
+ * rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+ * if (RCUTILS_RET_OK == rcutils_path_builder_init(&builder, root, &allocator)) {
+ *   // for each entry of the directory
+ *   if (RCUTILS_RET_OK == rcutils_path_builder_push(&builder, entry_name)) {
+ *     use(builder.path);
+ *     (void)rcutils_path_builder_pop(&builder);
+ *   }
+ *   (void)rcutils_path_builder_fini(&builder);
+ * }
+ * ```
+ * The "/" in the components are replaced by the platform specific separator, as with
+ * rcutils_to_native_path().
+ * The fields may be read, but must only be modified through the functions of the builder.
+ */
+typedef struct rcutils_path_builder_s
+{
+  /// The path built so far, which is always null terminated.
+  char * path;
+  /// The length of the path, excluding the terminating null character.
+  size_t length;
+  /// The size of the buffer of the path, including the terminating null character.
+  size_t capacity;
+  /// The lengths of the path before each component pushed and not popped yet.
+  size_t * lengths;
+  /// The number of components pushed and not popped yet.
+  size_t depth;
+  /// The number of lengths the buffer of lengths can hold.
+  size_t lengths_capacity;
+  /// The allocator used for the buffers.
+  rcutils_allocator_t allocator;
+} rcutils_path_builder_t;
+
+/// Return a zero initialized path builder struct.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_path_builder_t
+rcutils_get_zero_initialized_path_builder(void);
+
+/// Initialize a path builder with a base path.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] builder A zero initialized path builder.
+ * \param[in] base_path The path the components are pushed onto, which may be empty.
+ * \param[in] allocator The allocator to use for the buffers of the builder.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_init(
+  rcutils_path_builder_t * builder,
+  const char * base_path,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a path builder, deallocating its buffers.
+/**
+ * Finalizing a zero initialized path builder does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] builder The path builder to finalize, which is zero initialized afterwards.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_fini(rcutils_path_builder_t * builder);
+
+/// Append a component to the path of a path builder.
+/**
+ * The component is separated from the path by the platform specific separator, unless the
+ * path is empty or already ends with a separator.
+ * The component may itself hold many components separated by "/", which are all removed
+ * by a single rcutils_path_builder_pop().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, only if the path or the depth is larger than any before
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] builder An initialized path builder.
+ * \param[in] component The component to append.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the path builder isn't initialized, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, in which case the path is
+ *   unchanged.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_push(rcutils_path_builder_t * builder, const char * component);
+
+/// Remove the last component appended to the path of a path builder.
+/**
+ * The path is restored to what it was before the matching rcutils_path_builder_push().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] builder An initialized path builder.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the path builder isn't initialized, or
+ * \return #RCUTILS_RET_ERROR if no component is left to remove.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_pop(rcutils_path_builder_t * builder);
+
 /// Expand user directory in path.
 /**
  * This function expands an initial '~' to the current user's home directory.
@@ -236,6 +586,41 @@ rcutils_calculate_directory_size_with_recursion(
   uint64_t * size,
   rcutils_allocator_t allocator);
 
+/// Calculate the size of the specified directory with recursion, in several threads.
+/**
+ * This is rcutils_calculate_directory_size_with_recursion(), which iterates the
+ * subdirectories in up to `thread_count` threads, including the calling one, e.g. for
+ * directories with many subdirectories on storage serving many requests at once.
+ * The other threads are those of an rcutils_thread_pool_t, only started if the directory has
+ * subdirectories.
+ *
+ * On POSIX systems, the subdirectories are opened, and the files are inspected, relative to
+ * the file descriptor of their directory, with `openat()` and `fstatat()`, instead of by
+ * their full path, and the type of the entries reported by `readdir()` is used to only
+ * inspect the files whose size is needed.
+ * On Windows, the directories are iterated in the calling thread only.
+ *
+ * \note This API does not follow symlinks to files or directories.
+ * \param[in] directory_path The directory path to calculate the size of.
+ * \param[in] max_depth The maximum depth of subdirectory. 0 means no limitation.
+ * \param[in] thread_count The most threads to iterate the subdirectories with, including the
+ *   calling thread, or 0 for the number of processors.
+ * \param[out] size The size of the directory in bytes on success.
+ * \param[in] allocator Allocator being used for internal state.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails
+ * \return #RCUTILS_RET_ERROR if other error occurs
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_calculate_directory_size_parallel(
+  const char * directory_path,
+  const size_t max_depth,
+  size_t thread_count,
+  uint64_t * size,
+  rcutils_allocator_t allocator);
+
 /// Calculate the size of the specifed file.
 /**
  * \param[in] file_path The path of the file to obtain its size of.
@@ -245,6 +630,171 @@ RCUTILS_PUBLIC
 size_t
 rcutils_get_file_size(const char * file_path);
 
+/// How a memory mapped file is expected to be accessed, for the operating system to read ahead.
+typedef enum rcutils_mmap_access_e
+{
+  /// No particular access pattern.
+  RCUTILS_MMAP_ACCESS_NORMAL = 0,
+  /// The file is read from start to end, e.g. a configuration file to parse.
+  RCUTILS_MMAP_ACCESS_SEQUENTIAL = 1,
+  /// The file is read at random offsets, e.g. an index to look records up in.
+  RCUTILS_MMAP_ACCESS_RANDOM = 2,
+} rcutils_mmap_access_t;
+
+/// A read-only view of the contents of a file, mapped into memory by rcutils_mmap_file().
+typedef struct rcutils_mapped_file_s
+{
+  /// The contents of the file, or NULL if it is empty.
+  const uint8_t * data;
+  /// The size of the file in bytes.
+  size_t size;
+} rcutils_mapped_file_t;
+
+/// Return a zero initialized mapped file struct.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_mapped_file_t
+rcutils_get_zero_initialized_mapped_file(void);
+
+/// Map the contents of a file into memory, read-only.
+/**
+ * The contents of the file are available without copying them, as the pages of the mapping
+ * are the ones of the file cache of the operating system, which are read when first accessed.
+ * This makes reading a file, e.g. a configuration file or the index of a bag, as simple as
+ * ```c
+ * rcutils_mapped_file_t mapped_file = rcutils_get_zero_initialized_mapped_file();
+ * if (RCUTILS_RET_OK == rcutils_mmap_file(path, RCUTILS_MMAP_ACCESS_SEQUENTIAL, &mapped_file)) {
+ *   parse(mapped_file.data, mapped_file.size);
+ *   (void)rcutils_munmap_file(&mapped_file);
+ * }
+ * ```
+ * The file is mapped with `mmap()`, and the access pattern given to `posix_madvise()`, on
+ * POSIX systems, and with `MapViewOfFile()`, the access pattern given as a flag to
+ * `CreateFile()`, on Windows.
+ * The file isn't kept open, but the mapping must be unmapped with rcutils_munmap_file().
+ * If the file is truncated while it is mapped, accessing the pages beyond its end may crash
+ * the process, as for any memory mapped file.
+ * Empty files are not mapped, and their data is NULL.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] file_path The path of the file to map.
+ * \param[in] access How the file is expected to be accessed.
+ * \param[out] mapped_file A zero initialized mapped file to be set to the view of the file.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the file can't be opened or mapped, or isn't a regular file.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mmap_file(
+  const char * file_path,
+  rcutils_mmap_access_t access,
+  rcutils_mapped_file_t * mapped_file);
+
+/// Unmap a file mapped with rcutils_mmap_file().
+/**
+ * Its data must not be accessed anymore, and the mapped file is zero initialized afterwards.
+ * Unmapping a zero initialized mapped file does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] mapped_file The mapped file to unmap.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the file can't be unmapped.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_munmap_file(rcutils_mapped_file_t * mapped_file);
+
+/// Read the whole contents of a file into a uint8 array.
+/**
+ * The file is opened once and its size taken from the open file, so that the buffer of the
+ * uint8 array is resized at most once, to exactly the size of the file, before the file is read
+ * with as few `read()` calls as possible.
+ * The buffer is only resized if it is too small, so that a uint8 array can be reused to read
+ * many files without reallocating.
+ * Files whose size isn't known in advance, e.g. the ones of `/proc` or pipes, are read too,
+ * growing the buffer as needed.
+ *
+ * With `direct_io`, the file is read bypassing the file cache of the operating system where
+ * it is supported, i.e. with `O_DIRECT` through an aligned intermediate buffer on Linux and
+ * with `F_NOCACHE` on macOS, which avoids evicting the cache of other processes when reading
+ * large files once.
+ * It falls back to ordinary reads if the file system doesn't support it, and is ignored on
+ * other systems.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] file_path The path of the file to read.
+ * \param[in] direct_io Whether to bypass the file cache of the operating system.
+ * \param[inout] uint8_array An initialized uint8 array, whose `buffer_length` is set to the
+ *   size of the file if successful, and whose contents are unspecified otherwise.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if the file can't be opened or read, or is a directory.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_read_file(
+  const char * file_path,
+  bool direct_io,
+  rcutils_uint8_array_t * uint8_array);
+
+/// Read the whole contents of a file into a char array, e.g. to parse it as text.
+/**
+ * This is the same as rcutils_read_file(), except that the contents of the file are followed
+ * by a terminating null character, which `buffer_length` includes, as for the other functions
+ * of char arrays.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] file_path The path of the file to read.
+ * \param[in] direct_io Whether to bypass the file cache of the operating system.
+ * \param[inout] char_array An initialized char array, whose `buffer_length` is set to the
+ *   size of the file plus one if successful, and whose contents are unspecified otherwise.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if the file can't be opened or read, or is a directory.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_read_file_to_char_array(
+  const char * file_path,
+  bool direct_io,
+  rcutils_char_array_t * char_array);
+
 /// An iterator used for enumerating directory contents
 typedef struct rcutils_dir_iter_s
 {
@@ -293,6 +843,109 @@ RCUTILS_PUBLIC
 void
 rcutils_dir_iter_end(rcutils_dir_iter_t * iter);
 
+/// The type of a directory entry.
+typedef enum rcutils_dir_entry_type_e
+{
+  /// The type couldn't be determined, e.g. because the entry was removed meanwhile.
+  RCUTILS_DIR_ENTRY_TYPE_UNKNOWN = 0,
+  /// A regular file.
+  RCUTILS_DIR_ENTRY_TYPE_FILE = 1,
+  /// A directory.
+  RCUTILS_DIR_ENTRY_TYPE_DIRECTORY = 2,
+  /// A symbolic link, or a reparse point on Windows, which is not followed.
+  RCUTILS_DIR_ENTRY_TYPE_SYMLINK = 3,
+  /// Any other type, e.g. a device, a FIFO or a socket.
+  RCUTILS_DIR_ENTRY_TYPE_OTHER = 4,
+} rcutils_dir_entry_type_t;
+
+/// A directory entry returned by rcutils_dir_batch_iter_next().
+typedef struct rcutils_dir_entry_s
+{
+  /// The name of the entry, which is valid until the next batch is read.
+  const char * name;
+  /// The type of the entry.
+  rcutils_dir_entry_type_t type;
+  /// The size of the entry in bytes, if it is a regular file and sizes were requested, else 0.
+  uint64_t size;
+} rcutils_dir_entry_t;
+
+/// An iterator reading the entries of a directory in batches.
+typedef struct rcutils_dir_batch_iter_s rcutils_dir_batch_iter_t;
+
+/// Begin iterating over the contents of the specified directory in batches.
+/**
+ * Unlike ::rcutils_dir_iter_start, this iterator returns many entries at once, with their
+ * type, and optionally their size, so that callers don't have to join their path and stat
+ * them again.
+ * On Linux, the entries are read with the `getdents64` system call, in batches of as many
+ * entries as fit in a buffer of 32 KiB, and elsewhere with `readdir()` or `FindNextFile()`.
+ * The type of the entries is the one reported by the file system, and they are only
+ * inspected with `fstatat()` if it doesn't report it, or for the size of regular files.
+ * The "." and ".." entries are skipped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] directory_path The directory path to iterate over the contents of.
+ * \param[in] with_size Whether the size of the regular files is returned.
+ * \param[in] allocator Allocator used for the iterator and its buffers.
+ * \return An iterator to be finished with ::rcutils_dir_batch_iter_end, or
+ * \return NULL if an error occurred
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_dir_batch_iter_t *
+rcutils_dir_batch_iter_start(
+  const char * directory_path,
+  bool with_size,
+  rcutils_allocator_t allocator);
+
+/// Read the next batch of entries of a directory.
+/**
+ * At most `capacity` entries are read, and fewer may be, e.g. as many as the system returned
+ * at once, so the iteration is only finished once no entry is read.
+ * The names of the entries are owned by the iterator, and are valid until the next batch is
+ * read or the iteration is finished.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] iter An iterator created by ::rcutils_dir_batch_iter_start.
+ * \param[out] entries The array the entries are read into.
+ * \param[in] capacity The number of elements of `entries`.
+ * \param[out] count The number of entries read, which is 0 at the end of the directory.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if the directory can't be read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_dir_batch_iter_next(
+  rcutils_dir_batch_iter_t * iter,
+  rcutils_dir_entry_t * entries,
+  size_t capacity,
+  size_t * count);
+
+/// Finish iterating over the contents of a directory in batches.
+/**
+ * \param[in] iter An iterator created by ::rcutils_dir_batch_iter_start, or NULL.
+ */
+RCUTILS_PUBLIC
+void
+rcutils_dir_batch_iter_end(rcutils_dir_batch_iter_t * iter);
+
 #ifdef __cplusplus
 }
 #endif
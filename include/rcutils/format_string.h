@@ -20,6 +20,8 @@ extern "C"
 {
 #endif
 
+#include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
@@ -37,12 +39,15 @@ extern "C"
 
 /// Return a newly allocated string, created with a format string up to a limit.
 /**
- * This function uses snprintf_s to determine the length of the resulting
- * string and allocates storage for the resulting string, formats it, and
- * then returns the result.
+ * This function formats the string into a buffer on the stack, allocates
+ * storage for the resulting string and copies it there, and then returns the
+ * result.
+ * Only results which don't fit the stack buffer are formatted twice, once to
+ * determine their length and once into the allocated storage.
  *
  * This function can fail and therefore return null if the format_string is
- * null or if memory allocation fails or if snprintf_s fails.
+ * null, if the limit is zero, or if memory allocation fails or if snprintf_s
+ * fails.
  * An error message is not set in any case.
  *
  * Output strings that would be longer than the given limit are truncated.
@@ -56,6 +61,7 @@ extern "C"
  * it is no longer needed.
  *
  * \see rcutils_snprintf()
+ * \see rcutils_format_string_buffer() to format into a caller supplied buffer
  *
  * \param[in] allocator the allocator to use for allocation
  * \param[in] limit maximum length of the output string
@@ -76,6 +82,102 @@ RCUTILS_ATTRIBUTE_PRINTF_FORMAT(3, 4)
 /// @endcond
 ;
 
+/// Format a string into the given buffer, or into a newly allocated string if it doesn't fit.
+/**
+ * This function is like rcutils_format_string_limit(), except that the output is written to
+ * the given buffer when it fits, including the null terminator, and is only allocated
+ * otherwise, so that short strings can be formatted into a buffer on the stack without
+ * allocating.
+ * The arguments are only formatted twice if the output doesn't fit the buffer.
+ *
+ * If the returned pointer is not the given buffer, it is a newly allocated string which must
+ * be deallocated using the same allocator given once it is no longer needed.
+ * When allocating, the buffer is left with the output truncated to its size instead.
+ * Example:
+ *
+ * ```c
+ * char buffer[256];
+ * char * path = rcutils_format_string_buffer(
+ *   buffer, sizeof(buffer), allocator, SIZE_MAX, NULL, "%s/%s", directory, name);
+ * if (NULL != path) {
+ *   // use path...
+ *   if (buffer != path) {
+ *     allocator.deallocate(path, allocator.state);
+ *   }
+ * }
+ * ```
+ *
+ * This function can fail and therefore return null if the format_string is null, if the
+ * buffer is null but its size is not zero, if the limit is zero, if memory allocation fails
+ * or if snprintf_s fails.
+ * An error message is not set in any case.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, if the output doesn't fit the buffer
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \see rcutils_format_string_limit()
+ *
+ * \param[out] buffer the buffer to format the string into, may be null if buffer_size is zero
+ * \param[in] buffer_size the size of the buffer in bytes
+ * \param[in] allocator the allocator to use for allocation if the output doesn't fit
+ * \param[in] limit maximum size of the output string, including the null terminator
+ * \param[out] length the length of the output string, without the null terminator,
+ *   may be null
+ * \param[in] format_string format of the output, must be null terminated
+ * \return The buffer or a newly allocated string holding the output, or
+ * \return `NULL` if there was an error.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+char *
+rcutils_format_string_buffer(
+  char * buffer,
+  size_t buffer_size,
+  rcutils_allocator_t allocator,
+  size_t limit,
+  size_t * length,
+  const char * format_string,
+  ...)
+/// @cond Doxygen_Suppress
+RCUTILS_ATTRIBUTE_PRINTF_FORMAT(6, 7)
+/// @endcond
+;
+
+/// Format a string into the given buffer, or into a newly allocated string, from a va_list.
+/**
+ * This function is identical to rcutils_format_string_buffer() except it takes the arguments
+ * of the format string as a `va_list`, which is left in an unspecified state.
+ *
+ * \see rcutils_format_string_buffer()
+ *
+ * \param[out] buffer the buffer to format the string into, may be null if buffer_size is zero
+ * \param[in] buffer_size the size of the buffer in bytes
+ * \param[in] allocator the allocator to use for allocation if the output doesn't fit
+ * \param[in] limit maximum size of the output string, including the null terminator
+ * \param[out] length the length of the output string, without the null terminator,
+ *   may be null
+ * \param[in] format_string format of the output, must be null terminated
+ * \param[in] args the arguments of the format string
+ * \return The buffer or a newly allocated string holding the output, or
+ * \return `NULL` if there was an error.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+char *
+rcutils_vformat_string_buffer(
+  char * buffer,
+  size_t buffer_size,
+  rcutils_allocator_t allocator,
+  size_t limit,
+  size_t * length,
+  const char * format_string,
+  va_list args);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,328 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__LOCK_H_
+#define RCUTILS__LOCK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+/// The number of times a lock is tried by default before the thread goes to sleep.
+#define RCUTILS_LOCK_DEFAULT_SPIN_COUNT 100u
+
+/// A lock which busy-waits until it is available.
+/**
+ * It is a single word, which must be zero initialized, e.g. with
+ * #RCUTILS_SPINLOCK_INITIALIZER, and needs no finalization.
+ *
+ * Waiting threads never sleep, so it should only protect a few instructions, and only be
+ * taken by threads which aren't preempted by the threads waiting for it.
+ * Use rcutils_adaptive_mutex_t otherwise.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_spinlock_s
+{
+  /// The state of the lock, only accessed atomically by the lock functions.
+  uint32_t state;
+} rcutils_spinlock_t;
+
+/// Initializer of an unlocked rcutils_spinlock_t.
+#define RCUTILS_SPINLOCK_INITIALIZER {0u}
+
+/// A mutex which spins for a while, then sleeps until it is unlocked.
+/**
+ * The mutex is a few words without any resources, which may be statically initialized with
+ * #RCUTILS_ADAPTIVE_MUTEX_INITIALIZER, or initialized with rcutils_adaptive_mutex_init(),
+ * and needs no finalization.
+ * It is not recursive.
+ *
+ * Locking and unlocking an uncontended mutex is a single atomic operation each.
+ * A contended lock is tried spin_count times before the thread sleeps on the lock word with
+ * `futex(2)` on Linux, or `WaitOnAddress()` on Windows, and an unlock only makes a system call
+ * if a thread sleeps.
+ * On macOS the mutex is an `os_unfair_lock`, which is tried spin_count times before it is
+ * waited for.
+ * Elsewhere the waiting threads yield the processor until the mutex is unlocked.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_adaptive_mutex_s
+{
+  /// The state of the mutex, only accessed atomically by the lock functions.
+  uint32_t state;
+  /// The number of times the mutex is tried before the thread sleeps.
+  uint32_t spin_count;
+  /// Whether the owner inherits the priority of the threads waiting for the mutex.
+  bool priority_inheritance;
+} rcutils_adaptive_mutex_t;
+
+/// Initializer of an unlocked rcutils_adaptive_mutex_t with the default options.
+#define RCUTILS_ADAPTIVE_MUTEX_INITIALIZER {0u, RCUTILS_LOCK_DEFAULT_SPIN_COUNT, false}
+
+/// The options of an rcutils_adaptive_mutex_t.
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_adaptive_mutex_options_s
+{
+  /// The number of times a contended lock is tried before the thread sleeps.
+  /**
+   * Zero makes the thread sleep right away, which suits mutexes held for long, or by
+   * threads which may be preempted while they hold it.
+   */
+  uint32_t spin_count;
+  /// Whether the owner inherits the priority of the threads waiting for the mutex.
+  /**
+   * This bounds the priority inversion of real-time threads waiting for a mutex held by a
+   * lower priority thread.
+   * On Linux the mutex is then a `FUTEX_LOCK_PI` futex holding the id of its owner, and on
+   * macOS `os_unfair_lock` always inherits priorities.
+   * It is not supported elsewhere.
+   */
+  bool priority_inheritance;
+} rcutils_adaptive_mutex_options_t;
+
+/// A reader-writer lock which spins for a while, then sleeps until it is available.
+/**
+ * The lock is held either by any number of readers, or by a single writer.
+ * Writers are preferred: once a writer waits, new readers wait for it, so that a steady
+ * stream of readers doesn't starve writers, which means that a reader must not take the lock
+ * again while it holds it.
+ *
+ * The lock may be statically initialized with #RCUTILS_ADAPTIVE_RWLOCK_INITIALIZER, or
+ * initialized with rcutils_adaptive_rwlock_init(), and needs no finalization.
+ * Waiting threads sleep like those of rcutils_adaptive_mutex_t, without priority
+ * inheritance, which no platform supports for reader-writer locks.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_adaptive_rwlock_s
+{
+  /// The state of the lock, only accessed atomically by the lock functions.
+  uint32_t state;
+  /// The number of times the lock is tried before the thread sleeps.
+  uint32_t spin_count;
+} rcutils_adaptive_rwlock_t;
+
+/// Initializer of an unlocked rcutils_adaptive_rwlock_t with the default spin count.
+#define RCUTILS_ADAPTIVE_RWLOCK_INITIALIZER {0u, RCUTILS_LOCK_DEFAULT_SPIN_COUNT}
+
+/// Acquire the spinlock, busy-waiting until it is available.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] lock the spinlock, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_spinlock_lock(rcutils_spinlock_t * lock);
+
+/// Acquire the spinlock if it is available.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] lock the spinlock, which must not be NULL
+ * \return `true` if the spinlock was acquired, or
+ * \return `false` if it is held.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_spinlock_try_lock(rcutils_spinlock_t * lock);
+
+/// Release the spinlock, which the calling thread holds.
+/**
+ * \param[inout] lock the spinlock, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_spinlock_unlock(rcutils_spinlock_t * lock);
+
+/// Return the default options of an rcutils_adaptive_mutex_t.
+/**
+ * The mutex spins #RCUTILS_LOCK_DEFAULT_SPIN_COUNT times, without priority inheritance.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_adaptive_mutex_options_t
+rcutils_get_default_adaptive_mutex_options(void);
+
+/// Initialize an unlocked mutex with the given options.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] mutex the mutex to initialize
+ * \param[in] options the options of the mutex
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if priority inheritance isn't supported on this platform.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_adaptive_mutex_init(
+  rcutils_adaptive_mutex_t * mutex,
+  const rcutils_adaptive_mutex_options_t * options);
+
+/// Acquire the mutex, waiting until it is available.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] mutex the mutex, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_adaptive_mutex_lock(rcutils_adaptive_mutex_t * mutex);
+
+/// Acquire the mutex if it is available.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] mutex the mutex, which must not be NULL
+ * \return `true` if the mutex was acquired, or
+ * \return `false` if it is held.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_adaptive_mutex_try_lock(rcutils_adaptive_mutex_t * mutex);
+
+/// Release the mutex, which the calling thread holds, waking a waiting thread if any.
+/**
+ * \param[inout] mutex the mutex, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_adaptive_mutex_unlock(rcutils_adaptive_mutex_t * mutex);
+
+/// Initialize an unlocked reader-writer lock.
+/**
+ * \param[out] lock the lock to initialize
+ * \param[in] spin_count the number of times a contended lock is tried before the thread sleeps
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_adaptive_rwlock_init(rcutils_adaptive_rwlock_t * lock, uint32_t spin_count);
+
+/// Acquire the lock for reading, waiting while a writer holds it or waits for it.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] lock the lock, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_adaptive_rwlock_read_lock(rcutils_adaptive_rwlock_t * lock);
+
+/// Acquire the lock for reading, unless a writer holds it or waits for it.
+/**
+ * \param[inout] lock the lock, which must not be NULL
+ * \return `true` if the lock was acquired, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_adaptive_rwlock_try_read_lock(rcutils_adaptive_rwlock_t * lock);
+
+/// Release the lock, which the calling thread holds for reading.
+/**
+ * \param[inout] lock the lock, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_adaptive_rwlock_read_unlock(rcutils_adaptive_rwlock_t * lock);
+
+/// Acquire the lock for writing, waiting until no reader nor writer holds it.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] lock the lock, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_adaptive_rwlock_write_lock(rcutils_adaptive_rwlock_t * lock);
+
+/// Acquire the lock for writing, unless a reader or a writer holds it.
+/**
+ * \param[inout] lock the lock, which must not be NULL
+ * \return `true` if the lock was acquired, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_adaptive_rwlock_try_write_lock(rcutils_adaptive_rwlock_t * lock);
+
+/// Release the lock, which the calling thread holds for writing.
+/**
+ * \param[inout] lock the lock, which must not be NULL
+ */
+RCUTILS_PUBLIC
+void
+rcutils_adaptive_rwlock_write_unlock(rcutils_adaptive_rwlock_t * lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__LOCK_H_
@@ -19,12 +19,20 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_ARM64) || defined(_M_ARM64EC))
+# include <intrin.h>
+#endif
+
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
 #include "rcutils/macros.h"
+#include "rcutils/process.h"
 #include "rcutils/time.h"
+#include "rcutils/types/char_array.h"
 #include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
 
@@ -46,6 +54,22 @@ extern "C"
 RCUTILS_PUBLIC
 extern bool g_rcutils_logging_initialized;
 
+/// The value of #g_rcutils_logging_initialization_state before initialization.
+#define RCUTILS_LOGGING_UNINITIALIZED (0u)
+/// The value of #g_rcutils_logging_initialization_state while a thread initializes.
+#define RCUTILS_LOGGING_INITIALIZING (1u)
+/// The value of #g_rcutils_logging_initialization_state once initialized.
+#define RCUTILS_LOGGING_INITIALIZED (2u)
+
+/// Whether the logging system has been initialized, checked by RCUTILS_LOGGING_AUTOINIT.
+/**
+ * It must only be read with RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(), so
+ * that a thread seeing #RCUTILS_LOGGING_INITIALIZED also sees everything the
+ * initialization set up.
+ */
+RCUTILS_PUBLIC
+extern uint32_t g_rcutils_logging_initialization_state;
+
 /// Initialize the logging system using the specified allocator.
 /**
  * Initialize the logging system only if it was not in an initialized state.
@@ -57,6 +81,10 @@ extern bool g_rcutils_logging_initialized;
  * To re-attempt initialization, call rcutils_logging_shutdown() before
  * re-calling this function.
  *
+ * When several threads call this function at the same time, e.g. through the
+ * logging macros when they log first, one of them initializes the logging
+ * system while the others wait for it and return #RCUTILS_RET_OK.
+ *
  * If multiple errors occur, the error code of the last error will be returned.
  *
  * The `RCUTILS_CONSOLE_OUTPUT_FORMAT` environment variable can be used to set
@@ -77,19 +105,72 @@ extern bool g_rcutils_logging_initialized;
  *  - `0`: Don't use colours.
  * If it is unset, colours are used depending if the target stream is a terminal or not.
  * See `isatty` documentation.
+ * This is decided once here, rather than for every message.
+ * Colours are written along with each message, so every message takes a single write,
+ * except on Windows consoles not supporting virtual terminal sequences, whose colours
+ * are set directly.
  *
  * The format string can use these tokens by referencing them in curly brackets,
  * e.g. `"[{severity}] [{name}]: {message} ({function_name}() at {file_name}:{line_number})"`.
  * Any number of tokens can be used.
  * The limit of the format string is 2048 characters.
  *
+ * The `RCUTILS_CONSOLE_OUTPUT_STRUCTURE` environment variable replaces the
+ * output format with a structured one, for consumption by log indexers.
+ * Available values are:
+ *  - `text`: Use the output format, which is the default if it is unset.
+ *  - `json`: One JSON object per message, e.g.
+ *    `{"time_as_nanoseconds":1500000000,"severity":"INFO","name":"node",
+ *    "message":"Hello","function_name":"main","file_name":"main.c","line_number":42}`,
+ *    where `line_number` is `null` if the location is unknown.
+ *  - `key_value`: One line of key-value pairs per message, e.g.
+ *    `time_as_nanoseconds=1500000000 severity=INFO name="node" message="Hello"
+ *    function_name="main" file_name="main.c" line_number=42`.
+ * String values are escaped like JSON strings in both structures, in place in
+ * the output buffer, and colors are never used.
+ * The `RCUTILS_CONSOLE_OUTPUT_SANITIZE_UTF8` environment variable can be set to
+ * `1` to also replace invalid UTF-8 in the string values with U+FFFD, see
+ * rcutils_utf8_sanitize(), so that indexers which require valid UTF-8 accept
+ * every message.
+ * Valid strings, by far the most common, are only validated, which costs a
+ * fraction of a nanosecond per byte.
+ *
+ * The `RCUTILS_LOGGING_ASYNC` environment variable can be set to `1` to have
+ * the console output written by a background thread, see
+ * rcutils_logging_enable_async() for details.
+ *
+ * The `RCUTILS_LOGGING_STATISTICS` environment variable can be set to `1` to
+ * collect statistics about what logging costs, see
+ * rcutils_logging_enable_statistics().
+ *
+ * The `RCUTILS_LOGGING_TIMESTAMP_SOURCE` environment variable chooses the clock
+ * used to timestamp messages, see rcutils_logging_set_timestamp_source().
+ *
+ * The `RCUTILS_LOGGING_REPEAT_INTERVAL_MS` environment variable can be set to
+ * a positive number of milliseconds to suppress repeated messages, see
+ * rcutils_logging_enable_repeat_suppression().
+ *
+ * The `RCUTILS_LOGGING_BUFFERED_STREAM` environment variable can be set to `0`
+ * for the output stream to be unbuffered, or to `1` for it to be line buffered,
+ * and it keeps the default buffering of the stream otherwise.
+ * Alternatively, the `RCUTILS_LOGGING_STREAM_BUFFER_SIZE` environment variable
+ * can be set to a number of bytes, at least 2, for the output stream to be
+ * fully buffered with a buffer of that size, which takes precedence.
+ * Messages then only reach the stream when the buffer is full or flushed,
+ * according to the flush policy, which is the default one of
+ * rcutils_logging_get_default_flush_policy() in that case.
+ * Its fields can be set with the `RCUTILS_LOGGING_FLUSH_INTERVAL_MS`,
+ * `RCUTILS_LOGGING_FLUSH_MESSAGE_COUNT` and `RCUTILS_LOGGING_FLUSH_SEVERITY`
+ * (a severity name, e.g. `WARN`) environment variables, where `0` disables the
+ * first two, see rcutils_logging_set_flush_policy().
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
- * Lock-Free          | Yes
+ * Thread-Safe        | Yes, except with rcutils_logging_shutdown()
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
  *
  * \param[in] allocator rcutils_allocator_t to be used.
  * \return #RCUTILS_RET_OK if successful, or
@@ -115,9 +196,9 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
- * Lock-Free          | Yes
+ * Thread-Safe        | Yes, except with rcutils_logging_shutdown()
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
  *
  * \return #RCUTILS_RET_OK if successful, or
  * \return #RCUTILS_RET_INVALID_ARGUMENT if an error occurs reading the output
@@ -152,6 +233,301 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t rcutils_logging_shutdown(void);
 
+/// What to do when a record is logged while the asynchronous queue is full.
+typedef enum rcutils_logging_async_overflow_policy_e
+{
+  /// Discard the new record and count it as dropped.
+  RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP = 0,
+  /// Make the logging thread wait until the consumer thread frees up a slot.
+  RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK = 1,
+  /// Discard the oldest queued record (counting it as dropped) to make room for the new one.
+  RCUTILS_LOGGING_ASYNC_OVERFLOW_OVERWRITE_OLDEST = 2,
+} rcutils_logging_async_overflow_policy_t;
+
+/// The options for the asynchronous console output mode.
+typedef struct rcutils_logging_async_options_s
+{
+  /// The number of records the queue can hold, rounded up to the next power of two.
+  size_t queue_size;
+  /// The size in bytes of the storage preallocated for each record.
+  /**
+   * Records which don't fit are copied to memory obtained from the logging allocator.
+   */
+  size_t record_size;
+  /// The behavior when the queue is full.
+  rcutils_logging_async_overflow_policy_t overflow_policy;
+  /// The CPUs and scheduling of the consumer thread, e.g. to keep it off real-time CPUs.
+  rcutils_thread_attributes_t consumer_thread_attributes;
+} rcutils_logging_async_options_t;
+
+/// Return the default options for the asynchronous console output mode.
+/**
+ * The defaults are a queue of 1024 records of 512 bytes each, dropping new
+ * records when the queue is full, and a consumer thread with the default
+ * thread attributes.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_async_options_t rcutils_logging_get_default_async_options(void);
+
+/// Switch the console output handler to asynchronous output.
+/**
+ * In asynchronous mode, rcutils_logging_console_output_handler() still formats
+ * the message on the calling thread, but instead of writing it to the output
+ * stream, it pushes the formatted record into a bounded lock-free
+ * multi-producer queue.
+ * A dedicated consumer thread drains the queue and writes the records to the
+ * output stream, flushing it whenever the queue runs empty.
+ *
+ * This is called automatically by rcutils_logging_initialize_with_allocator()
+ * when the `RCUTILS_LOGGING_ASYNC` environment variable is set to `1`.
+ * In that case the options are read from the environment:
+ *  - `RCUTILS_LOGGING_ASYNC_QUEUE_SIZE`, the number of records in the queue
+ *  - `RCUTILS_LOGGING_ASYNC_OVERFLOW_POLICY`, one of `drop`, `block` or
+ *    `overwrite`
+ *
+ * On Windows, colorized output is disabled in asynchronous mode since colors
+ * are set on the console rather than embedded in the stream.
+ *
+ * If asynchronous mode is already enabled, it is first disabled, flushing all
+ * pending records.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] options The options for the asynchronous mode, or NULL for the defaults.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating the queue failed, or
+ * \return #RCUTILS_RET_ERROR if the consumer thread could not be started.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_enable_async(const rcutils_logging_async_options_t * options);
+
+/// Switch the console output handler back to synchronous output.
+/**
+ * All the records queued so far are written to the output stream and the
+ * stream is flushed before this function returns.
+ * This is called automatically by rcutils_logging_shutdown().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \return #RCUTILS_RET_OK if successful, or if asynchronous mode was not enabled, or
+ * \return #RCUTILS_RET_ERROR if the consumer thread could not be joined.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_disable_async(void);
+
+/// Return whether the console output handler is in asynchronous mode.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_is_async(void);
+
+/// Return the number of records dropped by the asynchronous mode since it was enabled.
+/**
+ * Records are dropped when the queue is full and the overflow policy is
+ * #RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP or
+ * #RCUTILS_LOGGING_ASYNC_OVERFLOW_OVERWRITE_OLDEST.
+ *
+ * \return The number of dropped records, or 0 if asynchronous mode is not enabled.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_get_async_dropped_count(void);
+
+/// Where the timestamps of log messages come from.
+typedef enum rcutils_logging_timestamp_source_e
+{
+  /// Read the system clock with rcutils_system_time_now() for every message.
+  RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE = 0,
+  /// Read the coarse system clock with rcutils_system_time_now_coarse() for every message.
+  RCUTILS_LOGGING_TIMESTAMP_SOURCE_COARSE = 1,
+  /// Use the system time cached by the asynchronous consumer thread.
+  RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED = 2,
+} rcutils_logging_timestamp_source_t;
+
+/// Choose where the timestamps of log messages come from.
+/**
+ * The timestamp is taken once per message, after the severity of the message
+ * was checked against the logger level, and when the output handler is
+ * rcutils_logging_sink_output_handler(), against the registered sinks, so
+ * that messages nobody outputs don't read the clock.
+ *
+ * With #RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED, the consumer thread of the
+ * asynchronous mode refreshes a cached time every millisecond and before
+ * writing each record, and messages are stamped with that time without reading
+ * any clock.
+ * Timestamps are then up to a millisecond late, and messages logged in the
+ * same millisecond share their timestamp.
+ * While asynchronous mode is disabled, the coarse clock is read instead.
+ *
+ * This is called automatically by rcutils_logging_initialize_with_allocator()
+ * if the `RCUTILS_LOGGING_TIMESTAMP_SOURCE` environment variable is set to
+ * one of `precise`, `coarse` or `cached`.
+ * The default is #RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] source The timestamp source
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the source is unknown.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_set_timestamp_source(rcutils_logging_timestamp_source_t source);
+
+/// Return where the timestamps of log messages come from.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_timestamp_source_t rcutils_logging_get_timestamp_source(void);
+
+/// Start suppressing bursts of repeated messages, summarizing them periodically.
+/**
+ * A message is suppressed if it was logged from the same callsite as the last
+ * message of that callsite, i.e. with the same #rcutils_log_location_t
+ * pointer, with the same formatted text, and less than `interval` after that
+ * message was last output.
+ * The first message logged once the interval elapsed, or the next different
+ * message of the callsite, is output after a summary line
+ * `Last message repeated N times`, with the same severity, logger and
+ * location, so a burst of the same message becomes two lines per interval.
+ * Messages logged without a location are never suppressed.
+ * Suppression happens before the output handler is called, so it applies to
+ * any output handler.
+ *
+ * The last message of each callsite is remembered by a hash of its text in a
+ * fixed table, which is only updated with atomic operations, so no lock is
+ * taken, but the message is formatted once more to be hashed, and only its
+ * first 1023 characters are compared along with its length.
+ * Callsites sharing a slot of the table suppress less, and the number of
+ * repeats is approximate when several threads log from the same callsite at
+ * the same time.
+ * The repeats suppressed since the last summary are only reported with the
+ * next message of the callsite, so those of a burst ending the log are lost.
+ *
+ * This is called automatically by rcutils_logging_initialize_with_allocator()
+ * if the `RCUTILS_LOGGING_REPEAT_INTERVAL_MS` environment variable is set to
+ * a positive number of milliseconds, and suppression stops when the logging
+ * system is shut down.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] interval The interval between summaries of the same message,
+ *   in nanoseconds
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the interval isn't positive.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_enable_repeat_suppression(rcutils_duration_value_t interval);
+
+/// Stop suppressing repeated messages.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_disable_repeat_suppression(void);
+
+/// When the console output stream is flushed, see rcutils_logging_set_flush_policy().
+typedef struct rcutils_logging_flush_policy_s
+{
+  /// Flush when a message is written at least this long after the last flush, in nanoseconds,
+  /// or 0 not to flush depending on time.
+  rcutils_duration_value_t interval;
+  /// Flush when this many messages were written since the last flush, or 0 not to.
+  uint32_t message_count;
+  /// Flush right after writing a message of at least this severity, or
+  /// #RCUTILS_LOG_SEVERITY_UNSET not to.
+  int severity;
+} rcutils_logging_flush_policy_t;
+
+/// Return the flush policy used with a fully buffered output stream by default.
+/**
+ * The stream is flushed at most every 20 milliseconds, and right after any
+ * message with a severity of `WARN` or above.
+ *
+ * \return The default flush policy.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_flush_policy_t rcutils_logging_get_default_flush_policy(void);
+
+/// Set when the console output handler flushes the output stream.
+/**
+ * After writing a message to the output stream, the console output handler
+ * flushes it if any of the conditions of the policy is met.
+ * This is meant for a fully buffered stream, see the
+ * `RCUTILS_LOGGING_STREAM_BUFFER_SIZE` environment variable of
+ * rcutils_logging_initialize_with_allocator(): each write of a line buffered
+ * stream is a system call, while a fully buffered one is written in batches,
+ * which delays messages by up to the interval of the policy as long as
+ * messages keep coming.
+ * As the policy is only applied when a message is written, the last messages
+ * before the logging stops stay buffered until the next message, until the
+ * logging system is shut down, or until the process exits, unless one of
+ * them meets the severity of the policy.
+ * In asynchronous mode, see rcutils_logging_enable_async(), the consumer
+ * thread flushes the stream whenever it drained the queue instead, so the
+ * policy isn't used.
+ *
+ * The policy is reset when the logging system is shut down, so that the
+ * stream is never flushed other than by its buffering.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] policy The flush policy, whose fields are all zero to never flush
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the policy is NULL, or its interval is negative.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_set_flush_policy(const rcutils_logging_flush_policy_t * policy);
+
+/// Get the current flush policy, see rcutils_logging_set_flush_policy().
+/**
+ * \return The current flush policy.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_flush_policy_t rcutils_logging_get_flush_policy(void);
+
 /// The structure identifying the caller location in the source code.
 typedef struct rcutils_log_location_s
 {
@@ -205,6 +581,137 @@ rcutils_ret_t
 rcutils_logging_severity_level_from_string(
   const char * severity_string, rcutils_allocator_t allocator, int * severity);
 
+/// The number of severities counted separately in #rcutils_logging_statistics_t.
+#define RCUTILS_LOGGING_STATISTICS_SEVERITIES (RCUTILS_LOG_SEVERITY_FATAL / 10 + 1)
+
+/// The number of buckets of the output handler duration histogram.
+#define RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS (32)
+
+/// What logging cost since the statistics were last reset.
+/**
+ * Statistics are only collected while enabled, see rcutils_logging_enable_statistics().
+ */
+typedef struct rcutils_logging_statistics_s
+{
+  /// The messages passed to the output handler, indexed by `severity / 10`.
+  /**
+   * For example `messages[RCUTILS_LOG_SEVERITY_WARN / 10]` counts the warnings.
+   * Messages with a severity beyond FATAL are counted as FATAL.
+   */
+  uint64_t messages[RCUTILS_LOGGING_STATISTICS_SEVERITIES];
+  /// The messages not logged because the logger isn't enabled for their severity.
+  uint64_t filtered_messages;
+  /// The messages suppressed as repeats, see rcutils_logging_enable_repeat_suppression().
+  uint64_t suppressed_messages;
+  /// The bytes written or queued by the console output handler.
+  uint64_t bytes_written;
+  /// The messages for which the console output handler allocated memory.
+  /**
+   * The console output handler formats into a buffer of 1024 bytes, which is
+   * reused by each thread, so this counts the longer messages for which the
+   * buffer had to grow.
+   */
+  uint64_t large_message_allocations;
+  /// The records dropped by the asynchronous mode, see rcutils_logging_get_async_dropped_count().
+  uint64_t async_dropped_messages;
+  /// The time spent in the output handler per message, on a logarithmic scale.
+  /**
+   * Bucket `i` counts the messages handled in `[2^i, 2^(i+1))` nanoseconds,
+   * except bucket 0, which also counts those handled in less than a
+   * nanosecond, and the last bucket, which also counts all longer ones.
+   */
+  uint64_t output_handler_duration_histogram[RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS];
+} rcutils_logging_statistics_t;
+
+/// Whether logging statistics are collected, non-zero if they are.
+/**
+ * It must only be read with RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32().
+ */
+RCUTILS_PUBLIC
+extern uint32_t g_rcutils_logging_statistics_enabled;
+
+/// Start collecting logging statistics.
+/**
+ * Statistics aren't collected by default, unless the `RCUTILS_LOGGING_STATISTICS`
+ * environment variable is set to 1 when the logging system is initialized,
+ * so that they cost nothing when nobody looks at them.
+ * While they are collected, each logged message costs two reads of the
+ * steady clock to measure the time spent in the output handler, and a few
+ * atomic increments of counters which are striped per thread, so that
+ * logging threads don't contend on them.
+ * Each filtered message costs one atomic increment.
+ *
+ * Collecting stops when the logging system is shut down, while the gathered
+ * statistics are kept until they are reset.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_enable_statistics(void);
+
+/// Stop collecting logging statistics, keeping those gathered so far.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_disable_statistics(void);
+
+/// Get the logging statistics gathered since they were last reset.
+/**
+ * The counters are summed up across all threads without stopping them, so
+ * the statistics of a message logged concurrently may be partially included.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] statistics The statistics.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if `statistics` is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_get_statistics(rcutils_logging_statistics_t * statistics);
+
+/// Reset the logging statistics to zero.
+/**
+ * The number of records dropped by the asynchronous mode is not reset; it
+ * is only reset when the asynchronous mode is enabled again.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_reset_statistics(void);
+
+/// Count a message filtered out by a logging macro, while statistics are collected.
+/**
+ * This is an internal function used by the logging macros.
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_count_filtered_message(void);
+
 /// The function signature to log messages.
 /**
  * \param[in] location The location information about where the log came from
@@ -283,6 +790,38 @@ rcutils_ret_t rcutils_logging_format_message(
   int severity, const char * name, rcutils_time_point_value_t timestamp,
   const char * msg, rcutils_char_array_t * logging_output);
 
+/// Replace the output format of the console output handler.
+/**
+ * This replaces the format given by the `RCUTILS_CONSOLE_OUTPUT_FORMAT` environment
+ * variable, with the same tokens, see rcutils_logging_initialize().
+ * An empty format is the default one.
+ *
+ * The format is compiled into a sequence of its literal text, where adjacent literals are
+ * merged, and of its tokens, which is then swapped in atomically.
+ * So threads logging meanwhile format each message with either the former or the new format,
+ * and never wait for each other.
+ * The former format is only deallocated when the logging system is shut down, since a thread
+ * might still be formatting a message with it, so this isn't meant to be called repeatedly.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] output_format The new output format, of at most 2047 characters.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the format is NULL or too long, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if `RCUTILS_CONSOLE_OUTPUT_STRUCTURE` selected a structured output,
+ *   which replaces the output format.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_set_output_format(const char * output_format);
+
 /// Get the default level for loggers.
 /**
  * <hr>
@@ -353,7 +892,7 @@ int rcutils_logging_get_logger_level(const char * name);
  * ------------------ | -------------
  * Allocates Memory   | No, provided logging system is already initialized
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] name The name of the logger
@@ -372,13 +911,18 @@ int rcutils_logging_get_logger_leveln(const char * name, size_t name_length);
 /**
  * If an empty string is specified as the name, the default logger level will be set.
  *
+ * Threads resolving logger levels concurrently never wait for this function:
+ * they keep using the previous levels until the new ones are published, and
+ * this function waits until no thread uses the previous levels anymore before
+ * freeing them.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
- * Lock-Free          | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
  *
  * \param[in] name The name of the logger, must be null terminated c string.
  * \param[in] level The level to be used.
@@ -391,6 +935,76 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level);
 
+/// Set the severity levels of many loggers at once.
+/**
+ * This is rcutils_logging_set_logger_level() for each pair of a name and a
+ * level, in order, e.g. to apply a configuration file, except that the new
+ * levels are published once, as a whole, rather than after each of them.
+ * Threads resolving logger levels meanwhile see either none or all of them.
+ * If a name appears more than once, the last level is used, and an empty
+ * name sets the default logger level.
+ *
+ * All the names and levels are validated before any level is set.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] names The names of the loggers, must be null terminated c strings.
+ * \param[in] levels The levels to be used, one per name.
+ * \param[in] count The number of names and levels.
+ * \return `RCUTILS_RET_OK` if successful, or
+ * \return `RCUTILS_RET_INVALID_ARGUMENT` on invalid arguments, or
+ * \return `RCUTILS_RET_LOGGING_SEVERITY_MAP_INVALID` if severity map invalid, or
+ * \return `RCUTILS_RET_ERROR` if an unspecified error occured, in which case
+ *   the levels set before the error are published.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_set_logger_levels(
+  const char * const * names, const int * levels, size_t count);
+
+/// Set the severity level for all loggers matching a pattern.
+/**
+ * A pattern is a logger name with at least one `*` wildcard, which matches
+ * any characters within a segment of a name, i.e. up to the next separator.
+ * For example `planner.*.debug_viz` matches `planner.global.debug_viz`, and
+ * `*.costmap` matches `local.costmap`, but neither matches `a.b.costmap`.
+ *
+ * Like levels set with rcutils_logging_set_logger_level(), the level also
+ * applies to the descendants of the matching loggers which have no level
+ * of their own.
+ * When a pattern and a name with a level match a logger at the same depth,
+ * the name takes precedence, and among patterns the one set last does.
+ * Setting the level #RCUTILS_LOG_SEVERITY_UNSET removes the pattern.
+ *
+ * The patterns are published along with the levels of the loggers, see
+ * rcutils_logging_set_logger_level(), and resolving the level of a logger
+ * then matches its name against all patterns at once.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] pattern The pattern, must be null terminated c string.
+ * \param[in] level The level to be used.
+ * \return `RCUTILS_RET_OK` if successful, or
+ * \return `RCUTILS_RET_INVALID_ARGUMENT` on invalid arguments, or
+ * \return `RCUTILS_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCUTILS_RET_LOGGING_SEVERITY_MAP_INVALID` if severity map invalid
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_set_logger_level_pattern(const char * pattern, int level);
+
 /// Determine if a logger is enabled for a severity level.
 /**
  * <hr>
@@ -411,23 +1025,397 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 bool rcutils_logging_logger_is_enabled_for(const char * name, int severity);
 
-/// Determine the effective level for a logger.
 /**
- * The effective level is determined as the severity level of
- * the logger if it is set, otherwise it is the first specified severity
- * level of the logger's ancestors, starting with its closest ancestor.
- * The ancestor hierarchy is signified by logger names being separated by dots:
- * a logger named `x` is an ancestor of `x.y`, and both `x` and `x.y` are
- * ancestors of `x.y.z`, etc.
- * If the level has not been set for the logger nor any of its
- * ancestors, the default level is used.
- *
- * <hr>
- * Attribute          | Adherence
+ * \def RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32
+ * \brief Load a `uint32_t` with acquire semantics, usable from both C and C++.
+ * Used by the logging macros, which can't rely on `<stdatomic.h>` in C++.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+# if defined(_M_ARM64) || defined(_M_ARM64EC)
+#  define RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(ptr) \
+  __ldar32((volatile unsigned __int32 *)(ptr))
+# else
+// On x86 and x64 volatile accesses have acquire/release semantics (/volatile:ms).
+#  define RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(ptr) (*(volatile const uint32_t *)(ptr))
+# endif
+#else
+# define RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif
+
+/// The generation of the logger levels.
+/**
+ * This is advanced every time the level of any logger or the default logger
+ * level changes, and every time the logging system is (re)initialized.
+ * The lowest 8 bits are always zero and the value is never zero once the
+ * logging system has been initialized.
+ * It must only be read with RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32().
+ */
+RCUTILS_PUBLIC
+extern uint32_t g_rcutils_logging_level_generation;
+
+/// The level of all the loggers while none has a level of its own, or zero otherwise.
+/**
+ * As long as no logger but the default one has a level set, nor is any level
+ * pattern set, every logger has the default logger level, which this holds.
+ * Then whether a logging statement is disabled takes a single load and
+ * compare, see rcutils_logging_is_below_uniform_level(), which the logging
+ * macros check before anything else.
+ *
+ * Otherwise, and while the logging system isn't initialized or logging
+ * statistics are enabled, as they count the filtered messages, this is
+ * #RCUTILS_LOG_SEVERITY_UNSET, which no severity is below.
+ * It must only be read with RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32().
+ */
+RCUTILS_PUBLIC
+extern uint32_t g_rcutils_logging_uniform_level;
+
+/// Return `true` if all the loggers are known to be disabled for a severity level.
+/**
+ * This is a check of #g_rcutils_logging_uniform_level, which can return
+ * `false` for disabled severities, but never `true` for enabled ones.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] severity The severity level.
+ * \return `true` if no logger is enabled for the severity level, or
+ * \return `false` if some may be.
+ */
+static inline bool
+rcutils_logging_is_below_uniform_level(int severity)
+{
+  const uint32_t uniform_level =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_uniform_level);
+#ifdef __cplusplus
+  return severity < static_cast<int>(uniform_level);
+#else
+  return severity < (int)uniform_level;
+#endif
+}
+
+/// The cached enabled decision of a single logging callsite.
+/**
+ * The logging macros keep one of these in static storage per callsite, so
+ * that checking whether a statement is enabled doesn't need to resolve the
+ * effective level of the logger again until some logger level changes.
+ *
+ * The cache is claimed by the first logger name it is used with, which is
+ * compared by address afterwards: calls from the same callsite with another
+ * logger name are correct but always take the slow path.
+ * The contents of a logger name must not change while its storage is used
+ * from a callsite, which holds for string literals and the names owned by
+ * logger objects.
+ *
+ * All members are private, initialize it with
+ * #RCUTILS_LOG_CALLSITE_CACHE_INITIALIZER.
+ */
+typedef struct rcutils_log_callsite_cache_s
+{
+  /// The generation, a valid bit and the effective level, or a special value.
+  uint32_t state;
+  /// The logger name this callsite cache was claimed by.
+  const char * name;
+} rcutils_log_callsite_cache_t;
+
+/// Static initializer of an unclaimed rcutils_log_callsite_cache_t.
+#define RCUTILS_LOG_CALLSITE_CACHE_INITIALIZER {0u, NULL}
+
+/// Mask of the bits of rcutils_log_callsite_cache_t::state holding the level generation.
+#define RCUTILS_LOG_CALLSITE_CACHE_GENERATION_MASK 0xFFFFFF00u
+/// Bit of rcutils_log_callsite_cache_t::state set if it holds a valid effective level.
+#define RCUTILS_LOG_CALLSITE_CACHE_VALID 0x80u
+/// Mask of the bits of rcutils_log_callsite_cache_t::state holding the effective level.
+#define RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK 0x7Fu
+
+/// Determine if a logger is enabled for a severity level and update a callsite cache.
+/**
+ * This is the slow path of rcutils_logging_callsite_is_enabled_for(), which
+ * should be used instead.
+ * It resolves the effective level like rcutils_logging_logger_is_enabled_for()
+ * and stores it in the callsite cache, unless the cache was claimed by a
+ * different logger name.
+ *
+ * <hr>
+ * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No, provided logging system is already initialized
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache The callsite cache to update, may be NULL.
+ * \param[in] name The name of the logger, must be null terminated c string or NULL.
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_update_callsite_cache(
+  rcutils_log_callsite_cache_t * cache, const char * name, int severity);
+
+/// Like rcutils_logging_update_callsite_cache(), with the hash of the name already known.
+/**
+ * This is the slow path of rcutils_logging_callsite_is_enabled_for_hash(),
+ * which should be used instead.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache The callsite cache to update, may be NULL.
+ * \param[in] name The name of the logger, must be a null terminated c string.
+ * \param[in] name_length The length of the name.
+ * \param[in] hash The djb2 hash of the name, as computed by
+ *   rcutils_hash_map_string_hash_func() or rcutils_logging_constexpr_name_hash().
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_update_callsite_cache_with_hash(
+  rcutils_log_callsite_cache_t * cache, const char * name, size_t name_length, size_t hash,
+  int severity);
+
+/// Determine if a logger is enabled for a severity level using a callsite cache.
+/**
+ * Equivalent to rcutils_logging_logger_is_enabled_for(), but as long as no
+ * logger level changed since the cache was last updated for this logger name
+ * the decision costs two atomic loads and a compare, without a function call
+ * or looking up the logger name.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache The callsite cache, must not be NULL.
+ * \param[in] name The name of the logger, must be null terminated c string or NULL.
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+static inline bool
+rcutils_logging_callsite_is_enabled_for(
+  rcutils_log_callsite_cache_t * cache, const char * name, int severity)
+{
+  const uint32_t state = RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&cache->state);
+  const uint32_t generation =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_level_generation);
+  if (RCUTILS_LIKELY(
+      (state & ~RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK) ==
+      (generation | RCUTILS_LOG_CALLSITE_CACHE_VALID) && cache->name == name))
+  {
+#ifdef __cplusplus
+    const int level = static_cast<int>(state & RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK);
+#else
+    const int level = (int)(state & RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK);
+#endif
+    if (RCUTILS_LIKELY(severity >= level)) {
+      return true;
+    }
+    if (RCUTILS_UNLIKELY(
+        0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_statistics_enabled)))
+    {
+      rcutils_logging_count_filtered_message();
+    }
+    return false;
+  }
+  return rcutils_logging_update_callsite_cache(cache, name, severity);
+}
+
+/// Like rcutils_logging_callsite_is_enabled_for(), with the hash of the name already known.
+/**
+ * Saves hashing the name when the callsite cache has to be updated, which
+ * the C++ logging macros use for logger names which are string literals,
+ * whose hash is computed at compile time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache The callsite cache, must not be NULL.
+ * \param[in] name The name of the logger, must be a null terminated c string.
+ * \param[in] name_length The length of the name.
+ * \param[in] hash The djb2 hash of the name, as computed by
+ *   rcutils_hash_map_string_hash_func() or rcutils_logging_constexpr_name_hash().
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+static inline bool
+rcutils_logging_callsite_is_enabled_for_hash(
+  rcutils_log_callsite_cache_t * cache, const char * name, size_t name_length, size_t hash,
+  int severity)
+{
+  const uint32_t state = RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&cache->state);
+  const uint32_t generation =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_level_generation);
+  if (RCUTILS_LIKELY(
+      (state & ~RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK) ==
+      (generation | RCUTILS_LOG_CALLSITE_CACHE_VALID) && cache->name == name))
+  {
+#ifdef __cplusplus
+    const int level = static_cast<int>(state & RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK);
+#else
+    const int level = (int)(state & RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK);
+#endif
+    if (RCUTILS_LIKELY(severity >= level)) {
+      return true;
+    }
+    if (RCUTILS_UNLIKELY(
+        0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_statistics_enabled)))
+    {
+      rcutils_logging_count_filtered_message();
+    }
+    return false;
+  }
+  return rcutils_logging_update_callsite_cache_with_hash(
+    cache, name, name_length, hash, severity);
+}
+
+/// Claim the first evaluation of a logging condition.
+/**
+ * This is used by the `ONCE` and `SKIPFIRST` conditions of the logging macros,
+ * which keep the flag in static storage per callsite: exactly one of any
+ * number of concurrent calls with the same flag returns `true`.
+ * The flag must be zero initialized, and is non-zero afterwards, so that
+ * callers can skip the call once RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32()
+ * returns a non-zero value.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] flag The flag of the condition, must not be NULL.
+ * \return `true` if this is the first evaluation, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_claim_first_evaluation(uint32_t * flag);
+
+/// Claim the throttle window starting at `now` for a logging condition.
+/**
+ * This is used by the `THROTTLE` condition of the logging macros, which keeps
+ * the time point of the last logged message in static storage per callsite.
+ * If at least `duration` passed since `*last_logged`, it is atomically
+ * replaced by `now`, so that exactly one of the concurrent calls during a
+ * window returns `true`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] last_logged The time point of the last logged message, must not be NULL.
+ * \param[in] now The current time point.
+ * \param[in] duration The duration of the throttle window in nanoseconds.
+ * \return `true` if the message should be logged, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_claim_throttle_window(
+  rcutils_time_point_value_t * last_logged, rcutils_time_point_value_t now,
+  rcutils_duration_value_t duration);
+
+/// Count a call of a logging condition which processes one in `n` calls.
+/**
+ * This is used by the `SAMPLED` condition of the logging macros, which keeps
+ * the counter in static storage per callsite.
+ * The counter is incremented atomically, so that concurrent calls are counted
+ * exactly once each, and the first call as well as every `n`-th after it
+ * returns `true`.
+ * Unless `n` is a power of two, the period is irregular once the counter
+ * wraps around after 2^32 calls.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] counter The zero initialized counter of the condition, must not be NULL.
+ * \param[in] n Return `true` for one in this many calls, for all calls if it is 0 or 1.
+ * \return `true` if the message should be logged, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_sample_every(uint32_t * counter, uint32_t n);
+
+/// Decide at random whether a logging condition which samples with a probability passes.
+/**
+ * This is used by the `SAMPLED_PROB` condition of the logging macros.
+ * The random numbers come from a small generator per thread, without any
+ * shared state, clock or system call, and are not suitable for anything but
+ * sampling.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes, once per thread
+ * Lock-Free          | Yes
+ *
+ * \param[in] probability The probability to return `true`, which is never
+ *   returned for 0 or less, and always for 1 or more.
+ * \return `true` if the message should be logged, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_sample_probability(double probability);
+
+/// Determine the effective level for a logger.
+/**
+ * The effective level is determined as the severity level of
+ * the logger if it is set, otherwise it is the first specified severity
+ * level of the logger's ancestors, starting with its closest ancestor.
+ * The ancestor hierarchy is signified by logger names being separated by dots:
+ * a logger named `x` is an ancestor of `x.y`, and both `x` and `x.y` are
+ * ancestors of `x.y.z`, etc.
+ * If the level has not been set for the logger nor any of its
+ * ancestors, the default level is used.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] name The name of the logger, must be null terminated c string.
@@ -440,6 +1428,133 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 int rcutils_logging_get_logger_effective_level(const char * name);
 
+/// A pre-resolved logger, see rcutils_logging_get_logger_handle().
+/**
+ * A handle holds a copy of the logger name owned by the logging system, the
+ * hash and length of that name, and a cache of the effective level of the
+ * logger, so that logging through it neither hashes nor compares the name
+ * until some logger level changes.
+ *
+ * All members are private.
+ */
+typedef struct rcutils_logger_handle_s
+{
+  /// The cached effective level, claimed by #name from the start.
+  rcutils_log_callsite_cache_t cache;
+  /// The length of the logger name.
+  size_t name_length;
+  /// The hash of the logger name.
+  size_t hash;
+} rcutils_logger_handle_t;
+
+/// Get the handle of a logger.
+/**
+ * The handle is created the first time a logger name is requested, and the
+ * same handle is returned for the same name afterwards.
+ * It stays valid until rcutils_logging_shutdown() is called.
+ *
+ * Long-lived components which log a lot should get the handle of their logger
+ * once and log through it with rcutils_log_with_handle() or the
+ * `RCUTILS_LOG_*_HANDLE` macros.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, the first time a name is requested
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] name The name of the logger, must be null terminated c string.
+ * \return The handle of the logger, or
+ * \return `NULL` if the name is `NULL` or memory allocation failed.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logger_handle_t * rcutils_logging_get_logger_handle(const char * name);
+
+/// Return the name of the logger of a handle.
+/**
+ * \param[in] handle The logger handle, must not be NULL.
+ * \return The name of the logger, owned by the logging system.
+ */
+static inline const char *
+rcutils_logging_get_logger_handle_name(const rcutils_logger_handle_t * handle)
+{
+  return handle->cache.name;
+}
+
+/// Determine if the logger of a handle is enabled for a severity level and update its cache.
+/**
+ * This is the slow path of rcutils_logging_logger_handle_is_enabled_for(),
+ * which should be used instead.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] handle The logger handle, must not be NULL.
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_update_logger_handle(rcutils_logger_handle_t * handle, int severity);
+
+/// Determine if the logger of a handle is enabled for a severity level.
+/**
+ * Equivalent to rcutils_logging_logger_is_enabled_for() with the name of the
+ * logger, but as long as no logger level changed since the handle was last
+ * updated the decision costs two atomic loads and a compare.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] handle The logger handle, must not be NULL.
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+static inline bool
+rcutils_logging_logger_handle_is_enabled_for(rcutils_logger_handle_t * handle, int severity)
+{
+  const uint32_t state = RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&handle->cache.state);
+  const uint32_t generation =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_level_generation);
+  if (RCUTILS_LIKELY(
+      (state & ~RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK) ==
+      (generation | RCUTILS_LOG_CALLSITE_CACHE_VALID)))
+  {
+#ifdef __cplusplus
+    const int level = static_cast<int>(state & RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK);
+#else
+    const int level = (int)(state & RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK);
+#endif
+    if (RCUTILS_LIKELY(severity >= level)) {
+      return true;
+    }
+    if (RCUTILS_UNLIKELY(
+        0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_statistics_enabled)))
+    {
+      rcutils_logging_count_filtered_message();
+    }
+    return false;
+  }
+  return rcutils_logging_update_logger_handle(handle, severity);
+}
+
 /// Internal call to log a message.
 /**
  * Unconditionally log a message.
@@ -518,6 +1633,105 @@ void rcutils_log(
 RCUTILS_ATTRIBUTE_PRINTF_FORMAT(4, 5)
 /// @endcond
 ;
+/// Log a message through a logger handle.
+/**
+ * Equivalent to rcutils_log() with the name of the logger of the handle, but
+ * see rcutils_logging_logger_handle_is_enabled_for().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, for formatted outputs <= 1023 characters
+ *                    | Yes, for formatted outputs >= 1024 characters
+ * Thread-Safe        | Yes, with itself [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] should be thread-safe with itself but not with other logging functions</i>
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[inout] handle The logger handle, must not be NULL
+ * \param[in] severity The severity level
+ * \param[in] format The format string
+ * \param[in] ... The variable arguments
+ */
+RCUTILS_PUBLIC
+void rcutils_log_with_handle(
+  const rcutils_log_location_t * location,
+  rcutils_logger_handle_t * handle,
+  int severity,
+  const char * format,
+  ...)
+/// @cond Doxygen_Suppress
+RCUTILS_ATTRIBUTE_PRINTF_FORMAT(4, 5)
+/// @endcond
+;
+
+/// Log an already formatted message.
+/**
+ * Equivalent to rcutils_log() with a `"%.*s"` format, but the message is never
+ * parsed as a format: the console output handler and the sink output handler
+ * copy it straight into their output, as with
+ * rcutils_logging_console_string_output_handler().
+ * Other output handlers are still passed the message through a `"%.*s"`
+ * format, as they only take a format.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, for formatted outputs <= 1023 characters
+ *                    | Yes, for formatted outputs >= 1024 characters
+ * Thread-Safe        | Yes, with itself [1]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] should be thread-safe with itself but not with other logging functions</i>
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string or NULL
+ * \param[in] msg The message, which needn't be null terminated, or NULL for an empty one
+ * \param[in] length The length of the message, without any terminating null character
+ */
+RCUTILS_PUBLIC
+void rcutils_log_string(
+  const rcutils_log_location_t * location,
+  int severity,
+  const char * name,
+  const char * msg,
+  size_t length);
+
+/// Internal call to log an already formatted message.
+/**
+ * Unconditionally log a message, like rcutils_log_string() once it checked that
+ * the logger is enabled.
+ * This is an internal function, and assumes that the caller has already called
+ * rcutils_logging_logger_is_enabled_for().
+ * End-user software should never call this, and instead should call
+ * rcutils_log_string() or one of the `RCUTILS_LOG_*_FMT` macros.
+ *
+ * The attributes of this function are influenced by the currently set output handler.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, for formatted outputs <= 1023 characters
+ *                    | Yes, for formatted outputs >= 1024 characters
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string or NULL
+ * \param[in] msg The message, which needn't be null terminated, or NULL for an empty one
+ * \param[in] length The length of the message, without any terminating null character
+ */
+RCUTILS_PUBLIC
+void rcutils_log_string_internal(
+  const rcutils_log_location_t * location,
+  int severity,
+  const char * name,
+  const char * msg,
+  size_t length);
 
 /// The default output handler outputs log messages to the standard streams.
 /**
@@ -551,6 +1765,300 @@ void rcutils_logging_console_output_handler(
   int severity, const char * name, rcutils_time_point_value_t timestamp,
   const char * format, va_list * args);
 
+/// The variant of rcutils_logging_console_output_handler() for already formatted messages.
+/**
+ * The output is the same as that of rcutils_logging_console_output_handler()
+ * with a `"%.*s"` format, but the message is copied into the output as is,
+ * without parsing a format.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, if the underlying *printf functions are
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] msg The message, which needn't be null terminated
+ * \param[in] length The length of the message
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_console_string_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, size_t length);
+
+/// Switch to binary deferred-format logging.
+/**
+ * In binary mode, messages aren't formatted by the logging thread: instead,
+ * rcutils_logging_binary_output_handler() captures the location pointer, the
+ * severity, the logger name, the timestamp, the format string pointer and the
+ * raw arguments into a binary record, which is pushed into a bounded lock-free
+ * multi-producer queue.
+ * String arguments are copied into the record, but the format string and the
+ * location are only referenced, and therefore must have static storage
+ * duration, as is the case for all the logging macros.
+ *
+ * A dedicated consumer thread drains the queue, and either:
+ *  - formats the records with the console output format and writes them to
+ *    the output stream of the console output handler, if `record_stream` is
+ *    NULL, or
+ *  - writes the records with copies of all strings to `record_stream`, to be
+ *    formatted offline with rcutils_logging_binary_format_record().
+ *
+ * Format strings with conversions which can't be captured (wide characters
+ * and strings, positional arguments or non standard conversions) are
+ * formatted by the logging thread instead, and are otherwise handled the
+ * same.
+ * Colorized output isn't supported in binary mode.
+ *
+ * This installs rcutils_logging_binary_output_handler() as the output handler.
+ * If binary mode is already enabled, it is first disabled, flushing all
+ * pending records.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] options The options for the queue, or NULL for the defaults.
+ * \param[in] record_stream The stream to write binary records to, or NULL to
+ *   write formatted messages to the console output stream.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating the queue failed, or
+ * \return #RCUTILS_RET_ERROR if the consumer thread could not be started.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_enable_binary(
+  const rcutils_logging_async_options_t * options, FILE * record_stream);
+
+/// Switch back from binary deferred-format logging.
+/**
+ * All the records queued so far are written out and the stream is flushed
+ * before this function returns.
+ * If the output handler is still rcutils_logging_binary_output_handler(), the
+ * output handler which was set before binary mode was enabled is restored.
+ * This is called automatically by rcutils_logging_shutdown().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \return #RCUTILS_RET_OK if successful, or if binary mode was not enabled, or
+ * \return #RCUTILS_RET_ERROR if the consumer thread could not be joined.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_disable_binary(void);
+
+/// Return the number of records dropped by the binary mode since it was enabled.
+/**
+ * \return The number of dropped records, or 0 if binary mode is not enabled.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_get_binary_dropped_count(void);
+
+/// The output handler queueing binary records, see rcutils_logging_enable_binary().
+/**
+ * If binary mode is not enabled, this forwards to
+ * rcutils_logging_console_output_handler().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, unless the record doesn't fit on the stack
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes, unless the queue overflow policy is to block
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] format The format string, with static storage duration
+ * \param[in] args The `va_list` used by the logger
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_binary_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args);
+
+/// Format a binary record written to the record stream of the binary mode.
+/**
+ * The record is formatted with the console output format, without a trailing
+ * newline.
+ * Records are written to the stream back to back, so a whole stream can be
+ * decoded by calling this repeatedly, advancing by `record_size` each time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, if the output needs to grow
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] data The data starting with the record
+ * \param[in] size The size of the data, which may contain further records
+ * \param[out] record_size The size of the record, to find the next one
+ * \param[out] output The char array the formatted record replaces the contents of
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if the output could not be grown, or
+ * \return #RCUTILS_RET_ERROR if the data doesn't start with a valid record.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_binary_format_record(
+  const char * data, size_t size, size_t * record_size, rcutils_char_array_t * output);
+
+/// The maximum number of sinks which can be registered at the same time.
+#define RCUTILS_LOGGING_MAX_SINKS (16)
+
+/// The function signature of a logging sink.
+/**
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] message The formatted message, shared by all sinks
+ * \param[in] context The context the sink was registered with
+ */
+typedef void (* rcutils_logging_sink_t)(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context);
+
+/// Register a sink with the sink dispatcher.
+/**
+ * Messages handled by rcutils_logging_sink_output_handler() are passed to
+ * every registered sink whose minimum severity they meet, in registration
+ * order.
+ * A sink is identified by the pair of its function and context, so the same
+ * function can be registered several times with different contexts.
+ *
+ * Registering a sink doesn't change the output handler: to dispatch to the
+ * sinks, rcutils_logging_sink_output_handler() must be set as the output
+ * handler with rcutils_logging_set_output_handler().
+ * All sinks are removed by rcutils_logging_shutdown().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] sink The sink function
+ * \param[in] context The context to pass to the sink, may be NULL
+ * \param[in] severity The minimum severity of the messages passed to the sink,
+ *   #RCUTILS_LOG_SEVERITY_UNSET to pass all messages
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the sink is NULL or already registered, or
+ * \return #RCUTILS_RET_NOT_ENOUGH_SPACE if #RCUTILS_LOGGING_MAX_SINKS sinks are
+ *   already registered.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_add_sink(rcutils_logging_sink_t sink, void * context, int severity);
+
+/// Unregister a sink registered with rcutils_logging_add_sink().
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] sink The sink function
+ * \param[in] context The context the sink was registered with
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_NOT_FOUND if the sink isn't registered.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_remove_sink(rcutils_logging_sink_t sink, void * context);
+
+/// Change the minimum severity of a sink registered with rcutils_logging_add_sink().
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] sink The sink function
+ * \param[in] context The context the sink was registered with
+ * \param[in] severity The new minimum severity of the messages passed to the sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_NOT_FOUND if the sink isn't registered.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_set_sink_severity(
+  rcutils_logging_sink_t sink, void * context, int severity);
+
+/// The output handler dispatching messages to the registered sinks.
+/**
+ * The message is formatted at most once, and only if at least one sink wants
+ * its severity; it is then passed to each of those sinks.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, unless the message doesn't fit on the stack
+ * Thread-Safe        | Yes, if the sinks are and the sinks aren't changed concurrently
+ * Uses Atomics       | No
+ * Lock-Free          | Yes, if the sinks are
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] format The format string
+ * \param[in] args The `va_list` used by the logger
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_sink_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args);
+
+/// A sink writing messages to the console, like rcutils_logging_console_output_handler().
+/**
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] message The formatted message
+ * \param[in] context Unused
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_console_sink(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context);
+
 /**
  * \def RCUTILS_LOGGING_AUTOINIT
  * \brief Initialize the rcl logging library.
@@ -565,10 +2073,14 @@ void rcutils_logging_console_output_handler(
  * \brief Initialize the rcl logging library with allocator.
  * Usually it is unnecessary to call the macro directly.
  * All logging macros ensure that this has been called once.
+ * Once the logging system is initialized, this costs a single acquire load.
  */
 #define RCUTILS_LOGGING_AUTOINIT_WITH_ALLOCATOR(alloc) \
   do { \
-    if (RCUTILS_UNLIKELY(!g_rcutils_logging_initialized)) { \
+    if (RCUTILS_UNLIKELY( \
+        RCUTILS_LOGGING_INITIALIZED != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32( \
+          &g_rcutils_logging_initialization_state))) \
+    { \
       if (rcutils_logging_initialize_with_allocator(alloc) != RCUTILS_RET_OK) { \
         RCUTILS_SAFE_FWRITE_TO_STDERR( \
           "[rcutils|" __FILE__ ":" RCUTILS_STRINGIFY(__LINE__) \
@@ -582,6 +2094,151 @@ void rcutils_logging_console_output_handler(
 
 #ifdef __cplusplus
 }
+
+// C++ linkage, even when this header is included by one which declares C linkage.
+extern "C++"
+{
+/// Return the length of a logger name stored in a character array of `size` characters.
+constexpr size_t rcutils_logging_constexpr_name_length(const char * name, size_t size)
+{
+  size_t length = 0u;
+  while (length < size && '\0' != name[length]) {
+    ++length;
+  }
+  return length;
+}
+
+/// Return the djb2 hash of a logger name, as rcutils_hash_map_string_hash_func() does.
+/**
+ * This is the hash the logging system computes at runtime for the names of
+ * loggers, to look them up in its caches and level tables.
+ * Logger names keep this hash, rather than the faster one of
+ * rcutils_hash_map_string_fast_hashn(), because it can be computed at compile
+ * time and extended incrementally along the ancestors of a logger name.
+ */
+constexpr size_t rcutils_logging_constexpr_name_hash(const char * name, size_t length)
+{
+  size_t hash = 5381u;
+  for (size_t i = 0u; i < length; ++i) {
+    hash = ((hash << 5) + hash) + static_cast<size_t>(name[i]);
+  }
+  return hash;
+}
+
+/// A logger name prefix and the minimum severity of the logging statements compiled for it.
+/**
+ * See RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS.
+ */
+struct rcutils_logging_logger_min_severity_t
+{
+  /// The name of a logger, which also applies to its descendants.
+  const char * prefix;
+  /// One of the RCUTILS_LOG_MIN_SEVERITY_* values.
+  int min_severity;
+};
+
+/// Return the length of a prefix when a logger name is it or one of its descendants, or -1.
+/**
+ * The empty prefix is the one of all logger names.
+ */
+constexpr ptrdiff_t rcutils_logging_constexpr_match_prefix(
+  const char * name, size_t length, const char * prefix)
+{
+  size_t i = 0u;
+  while ('\0' != prefix[i]) {
+    if (i >= length || name[i] != prefix[i]) {
+      return -1;
+    }
+    ++i;
+  }
+  return (0u == i || i == length || '.' == name[i]) ? static_cast<ptrdiff_t>(i) : -1;
+}
+
+/// Return whether a logging statement is compiled out by a list of logger minimum severities.
+/**
+ * Like the levels of loggers at runtime, the longest prefix of the logger name applies.
+ */
+template<size_t N>
+constexpr bool rcutils_logging_constexpr_is_compiled_out(
+  const char * name, size_t length, int severity,
+  const rcutils_logging_logger_min_severity_t (& min_severities)[N])
+{
+  ptrdiff_t longest = -1;
+  int min_severity = 0;
+  for (size_t i = 0u; i < N; ++i) {
+    const ptrdiff_t prefix_length =
+      rcutils_logging_constexpr_match_prefix(name, length, min_severities[i].prefix);
+    if (prefix_length > longest) {
+      longest = prefix_length;
+      min_severity = min_severities[i].min_severity;
+    }
+  }
+  // The severities are the multiples of RCUTILS_LOG_SEVERITY_DEBUG, in the order of the
+  // RCUTILS_LOG_MIN_SEVERITY_* values, which start from 0.
+  return severity < (min_severity + 1) * RCUTILS_LOG_SEVERITY_DEBUG;
+}
+
+/// Check whether a logging statement of a logger name of the given type is compiled out.
+/**
+ * Only string literal logger names are known at compile time, others never are.
+ */
+template<typename NameT>
+struct rcutils_logging_compile_time_filter
+{
+  template<size_t N>
+  static constexpr bool is_compiled_out(
+    const char *, int, const rcutils_logging_logger_min_severity_t (&)[N])
+  {
+    return false;
+  }
+};
+
+/// Check whether a logging statement of a string literal logger name is compiled out.
+template<size_t N>
+struct rcutils_logging_compile_time_filter<const char (&)[N]>
+{
+  template<size_t M>
+  static constexpr bool is_compiled_out(
+    const char (& name)[N], int severity,
+    const rcutils_logging_logger_min_severity_t (& min_severities)[M])
+  {
+    // A constant expression for string literals, which compilers fold when optimizing.
+    return rcutils_logging_constexpr_is_compiled_out(
+      name, rcutils_logging_constexpr_name_length(name, N - 1u), severity, min_severities);
+  }
+};
+
+/// Check a callsite cache for a logger name of the given type, see the logging macros.
+/**
+ * Logger names which aren't string literals are checked with
+ * rcutils_logging_callsite_is_enabled_for().
+ */
+template<typename NameT>
+struct rcutils_logging_callsite_checker
+{
+  static bool is_enabled_for(
+    rcutils_log_callsite_cache_t * cache, const char * name, int severity)
+  {
+    return rcutils_logging_callsite_is_enabled_for(cache, name, severity);
+  }
+};
+
+/// Check a callsite cache for a string literal logger name, with the hash computed at compile time.
+template<size_t N>
+struct rcutils_logging_callsite_checker<const char (&)[N]>
+{
+  static bool is_enabled_for(
+    rcutils_log_callsite_cache_t * cache, const char (& name)[N], int severity)
+  {
+    // Both are constant expressions for string literals, which compilers fold when optimizing.
+    return rcutils_logging_callsite_is_enabled_for_hash(
+      cache, name, rcutils_logging_constexpr_name_length(name, N - 1u),
+      rcutils_logging_constexpr_name_hash(
+        name, rcutils_logging_constexpr_name_length(name, N - 1u)),
+      severity);
+  }
+};
+}
 #endif
 
 #endif  // RCUTILS__LOGGING_H_
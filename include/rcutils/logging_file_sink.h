@@ -0,0 +1,236 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__LOGGING_FILE_SINK_H_
+#define RCUTILS__LOGGING_FILE_SINK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/async_write.h"
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// When the file sink makes sure written data reached the storage device.
+typedef enum rcutils_logging_file_sink_fsync_policy_e
+{
+  /// Leave it to the operating system.
+  RCUTILS_LOGGING_FILE_SINK_FSYNC_NEVER = 0,
+  /// Before a file is closed, i.e. when rotating and when finalizing the sink.
+  RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_CLOSE = 1,
+  /// After every batch of buffers written to the file.
+  RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_WRITE = 2,
+} rcutils_logging_file_sink_fsync_policy_t;
+
+/// How the file sink compresses the log file.
+typedef enum rcutils_logging_file_sink_compression_e
+{
+  /// Write the messages as they are.
+  RCUTILS_LOGGING_FILE_SINK_COMPRESSION_NONE = 0,
+  /// Write each buffer as a frame of the LZ4 frame format, see rcutils_logging_file_sink_init().
+  RCUTILS_LOGGING_FILE_SINK_COMPRESSION_LZ4 = 1,
+} rcutils_logging_file_sink_compression_t;
+
+/// The options of a file sink.
+typedef struct rcutils_logging_file_sink_options_s
+{
+  /// The path of the log file, which is appended to if it exists.
+  const char * path;
+  /// The size in bytes of each buffer, rounded up to a multiple of the page size.
+  size_t buffer_size;
+  /// The number of buffers, at least 2: one being filled while the others are written.
+  size_t buffer_count;
+  /// Rotate the file before it grows beyond this size in bytes, or never if 0.
+  size_t max_file_size;
+  /// Rotate the file when its first message is older than this, or never if 0.
+  rcutils_duration_value_t max_file_age;
+  /// The number of rotated files to keep, as `path.1` (newest) to `path.N` (oldest).
+  size_t max_files;
+  /// The longest time in milliseconds messages stay buffered before being written.
+  uint32_t flush_interval_ms;
+  /// When to sync the written data to the storage device.
+  rcutils_logging_file_sink_fsync_policy_t fsync_policy;
+  /// How to compress the log file.
+  rcutils_logging_file_sink_compression_t compression;
+  /// The writer to submit uncompressed buffers to, or NULL to write them with blocking writes.
+  rcutils_async_writer_t * async_writer;
+  /// The CPUs and scheduling of the thread writing to the file.
+  rcutils_thread_attributes_t thread_attributes;
+} rcutils_logging_file_sink_options_t;
+
+/// A file sink, created with rcutils_logging_file_sink_init().
+typedef struct rcutils_logging_file_sink_s rcutils_logging_file_sink_t;
+
+/// Return the default options of a file sink.
+/**
+ * The defaults are 4 buffers of 256 KiB, flushed at least every second,
+ * without rotation, fsync, compression nor async writer, keeping 5 rotated files.
+ * The path is NULL and must be set.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_file_sink_options_t rcutils_logging_file_sink_get_default_options(void);
+
+/// Open the log file and start the thread writing to it.
+/**
+ * Messages are formatted with rcutils_logging_format_message() on the logging
+ * thread and copied into large page-aligned buffers.
+ * Full buffers, and partially filled ones every `flush_interval_ms`, are
+ * handed to a dedicated thread which writes them to the file in batches and
+ * performs the rotation, so logging threads never wait for the file, unless
+ * all buffers are waiting to be written.
+ *
+ * Rotation is decided when a message is added, so that rotated files only
+ * contain whole lines: if the message would grow the file beyond
+ * `max_file_size`, or if the first message of the file is older than
+ * `max_file_age` according to the message timestamps, `path` is renamed to
+ * `path.1`, `path.1` to `path.2`, and so on, dropping the oldest file beyond
+ * `max_files`, and a new file is started.
+ *
+ * With #RCUTILS_LOGGING_FILE_SINK_COMPRESSION_LZ4, the writer thread
+ * compresses each buffer into a complete frame of the LZ4 frame format before
+ * writing it, so the file is a sequence of independent frames which
+ * `lz4 -d` decompresses, and a crash loses at most the buffers not written
+ * yet, i.e. the messages of the last `flush_interval_ms` when they don't fill
+ * a buffer.
+ * Shorter flush intervals make smaller frames, which compress less.
+ * The compressor is built in, favoring speed over ratio, and `max_file_size`
+ * is compared with the size of the messages before compression.
+ *
+ * With an `async_writer`, which must outlive the sink, the writer thread submits
+ * uncompressed buffers to it instead of writing them, so that on Linux several
+ * buffers are written at once through io_uring while the next ones are being
+ * filled, and a buffer is only reused once its write completed.
+ * The log file is then written at explicit offsets rather than appended to, so
+ * it must not be written by anyone else.
+ *
+ * To receive messages, the sink has to be registered with the sink dispatcher:
+ *
+ * ```c
+ * rcutils_logging_file_sink_t * sink = NULL;
+ * rcutils_logging_file_sink_options_t options = rcutils_logging_file_sink_get_default_options();
+ * options.path = "/tmp/node.log";
+ * ret = rcutils_logging_file_sink_init(&sink, &options, rcutils_get_default_allocator());
+ * ret = rcutils_logging_add_sink(
+ *   rcutils_logging_file_sink_output, sink, RCUTILS_LOG_SEVERITY_INFO);
+ * rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[out] sink The new sink
+ * \param[in] options The options of the sink
+ * \param[in] allocator The allocator used for the sink and its buffers
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the file could not be opened or the thread
+ *   could not be started.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_file_sink_init(
+  rcutils_logging_file_sink_t ** sink,
+  const rcutils_logging_file_sink_options_t * options,
+  rcutils_allocator_t allocator);
+
+/// Write all buffered messages to the file, and wait until they are written.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] sink The sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the sink is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_file_sink_flush(rcutils_logging_file_sink_t * sink);
+
+/// Return the number of bytes of messages which could not be written to the file so far.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_file_sink_get_lost_bytes(rcutils_logging_file_sink_t * sink);
+
+/// Write out all buffered messages, stop the thread, close the file and free the sink.
+/**
+ * The sink must not be used anymore, so it must be removed from the sink
+ * dispatcher first.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] sink The sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the sink is NULL, or
+ * \return #RCUTILS_RET_ERROR if the thread could not be joined.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_file_sink_fini(rcutils_logging_file_sink_t * sink);
+
+/// The #rcutils_logging_sink_t writing to the file sink passed as the context.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, unless the line doesn't fit on the stack
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] message The formatted message
+ * \param[in] context The rcutils_logging_file_sink_t to write to
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_file_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__LOGGING_FILE_SINK_H_
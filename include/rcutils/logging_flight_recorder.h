@@ -0,0 +1,193 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__LOGGING_FLIGHT_RECORDER_H_
+#define RCUTILS__LOGGING_FLIGHT_RECORDER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// The options of a flight recorder.
+typedef struct rcutils_logging_flight_recorder_options_s
+{
+  /// The number of most recent records kept for each thread.
+  size_t record_count;
+  /// The bytes of the logger name and the message kept for each record, the rest is cut off.
+  size_t record_size;
+  /// The number of threads which get a ring, the records of further threads are dropped.
+  size_t max_threads;
+} rcutils_logging_flight_recorder_options_t;
+
+/// A flight recorder, created with rcutils_logging_flight_recorder_init().
+typedef struct rcutils_logging_flight_recorder_s rcutils_logging_flight_recorder_t;
+
+/// Return the default options of a flight recorder.
+/**
+ * The defaults keep the last 256 records of up to 16 threads, with up to
+ * 256 bytes of logger name and message each.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_flight_recorder_options_t
+rcutils_logging_flight_recorder_get_default_options(void);
+
+/// Allocate the rings of a flight recorder.
+/**
+ * The flight recorder keeps the last `record_count` messages of each thread
+ * in memory, to be written out with rcutils_logging_flight_recorder_dump()
+ * when something went wrong, typically from a fatal signal handler.
+ *
+ * All memory is allocated here: each of the first `max_threads` threads which
+ * log claims one ring for the lifetime of the recorder, so the records of a
+ * thread are kept after it exits.
+ * Records are stored unformatted, as the timestamp, the severity, the logger
+ * name and the message, so recording a message only copies it into the ring
+ * of the calling thread, without locks, allocations nor system calls.
+ *
+ * To receive messages, the recorder has to be registered with the sink
+ * dispatcher:
+ *
+ * ```c
+ * rcutils_logging_flight_recorder_t * recorder = NULL;
+ * rcutils_logging_flight_recorder_options_t options =
+ *   rcutils_logging_flight_recorder_get_default_options();
+ * ret = rcutils_logging_flight_recorder_init(
+ *   &recorder, &options, rcutils_get_default_allocator());
+ * ret = rcutils_logging_add_sink(
+ *   rcutils_logging_flight_recorder_output, recorder, RCUTILS_LOG_SEVERITY_DEBUG);
+ * rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] recorder The new flight recorder
+ * \param[in] options The options of the flight recorder
+ * \param[in] allocator The allocator used for the flight recorder and its rings
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the thread specific key could not be created.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_flight_recorder_init(
+  rcutils_logging_flight_recorder_t ** recorder,
+  const rcutils_logging_flight_recorder_options_t * options,
+  rcutils_allocator_t allocator);
+
+/// Write the recorded messages to a file descriptor, oldest first.
+/**
+ * The records of all threads are merged by timestamp and written as lines
+ * formatted like `[SEVERITY] [seconds.nanoseconds] [name]: message`,
+ * regardless of the console output format.
+ *
+ * Only async-signal-safe functions are used, so this can be called from a
+ * signal handler, e.g. for `SIGSEGV` with `STDERR_FILENO`.
+ * For the same reason no error message is set on failure.
+ * Threads may keep logging meanwhile: records overwritten while they are
+ * written out are skipped.
+ * Only one dump runs at a time, other calls fail until it is done.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] recorder The flight recorder
+ * \param[in] fd The file descriptor to write to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the recorder is NULL, or
+ * \return #RCUTILS_RET_ERROR if writing failed or another dump is running.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_flight_recorder_dump(
+  rcutils_logging_flight_recorder_t * recorder, int fd);
+
+/// Return the number of messages not recorded because their thread got no ring.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_flight_recorder_get_dropped_records(
+  rcutils_logging_flight_recorder_t * recorder);
+
+/// Free the flight recorder and its rings.
+/**
+ * The recorder must not be used anymore, so it must be removed from the sink
+ * dispatcher first.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] recorder The flight recorder
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the recorder is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_flight_recorder_fini(rcutils_logging_flight_recorder_t * recorder);
+
+/// The #rcutils_logging_sink_t recording to the flight recorder passed as the context.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] message The formatted message
+ * \param[in] context The rcutils_logging_flight_recorder_t to record to
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_flight_recorder_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__LOGGING_FLIGHT_RECORDER_H_
@@ -0,0 +1,431 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/**
+ * A C++ front-end for the logging macros, formatting `{}` placeholders.
+ *
+ * The `RCUTILS_LOG_<SEVERITY>_FMT*` variants of the logging macros take a format string
+ * literal, in which each `{}` is replaced by the next argument and `{{` and `}}` stand for
+ * `{` and `}`:
+ *
+ * ```cpp
+ * RCUTILS_LOG_INFO_FMT_NAMED("my_node", "received {} messages from {}", count, topic_name);
+ * ```
+ *
+ * That the format string is well formed and has a `{}` per argument is checked at compile
+ * time, and the type of each argument selects how it is formatted, see
+ * rcutils::logging_format::formatter.
+ * The message is formatted straight into a buffer of the calling thread, which is reused by
+ * its next messages, and passed as is to the output handler, see rcutils_log_string().
+ * Unlike streaming into a `std::stringstream` and logging that with a `"%s"` format, this
+ * neither allocates per message once the buffer is large enough, nor formats twice.
+ */
+
+#ifndef RCUTILS__LOGGING_FORMAT_HPP_
+#define RCUTILS__LOGGING_FORMAT_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "rcutils/logging.h"
+#include "rcutils/logging_macros.h"
+
+namespace rcutils
+{
+namespace logging_format
+{
+
+/// The placeholder count of a format string which isn't well formed.
+constexpr size_t invalid_format = std::numeric_limits<size_t>::max();
+
+/// Count the `{}` placeholders of a format string.
+/**
+ * \param[in] format the null terminated format string
+ * \return the number of placeholders, or
+ * \return #invalid_format if a `{` or a `}` isn't part of a `{}`, `{{` or `}}`.
+ */
+constexpr size_t count_placeholders(const char * format)
+{
+  size_t count = 0u;
+  for (size_t i = 0u; '\0' != format[i]; ++i) {
+    if ('{' == format[i]) {
+      if ('}' == format[i + 1u]) {
+        ++count;
+      } else if ('{' != format[i + 1u]) {
+        return invalid_format;
+      }
+      ++i;
+    } else if ('}' == format[i]) {
+      if ('}' != format[i + 1u]) {
+        return invalid_format;
+      }
+      ++i;
+    }
+  }
+  return count;
+}
+
+/// Format the values of type `T` for the `{}` placeholders.
+/**
+ * It is specialized for the arithmetic types, enumerations, pointers, C strings,
+ * `std::string` and `std::string_view`.
+ * Other types can be logged by specializing it too, with a function appending the value:
+ *
+ * ```cpp
+ * template<>
+ * struct rcutils::logging_format::formatter<Point>
+ * {
+ *   static void format(std::string & out, const Point & point)
+ *   {
+ *     formatter<double>::format(out, point.x);
+ *     out += ", ";
+ *     formatter<double>::format(out, point.y);
+ *   }
+ * };
+ * ```
+ *
+ * Arrays and functions are formatted as the pointers they decay to, so that string literals
+ * and character arrays are formatted as C strings.
+ */
+template<typename T, typename Enable = void>
+struct formatter
+{
+  static_assert(
+    !std::is_same<T, T>::value,
+    "there is no rcutils::logging_format::formatter for the type of this argument");
+};
+
+/// @cond Doxygen_Suppress
+template<typename T>
+struct formatter<
+  T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+  !std::is_same<T, char>::value>>
+{
+  static void format(std::string & out, T value)
+  {
+    // Widened, so that character types other than char are formatted as numbers too.
+    using wide_type = std::conditional_t<std::is_signed<T>::value, long long, unsigned long long>;
+    char buffer[std::numeric_limits<wide_type>::digits10 + 3];
+    const std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), static_cast<wide_type>(value));
+    out.append(buffer, result.ptr);
+  }
+};
+
+template<>
+struct formatter<bool>
+{
+  static void format(std::string & out, bool value)
+  {
+    out += value ? "true" : "false";
+  }
+};
+
+template<>
+struct formatter<char>
+{
+  static void format(std::string & out, char value)
+  {
+    out += value;
+  }
+};
+
+template<typename T>
+struct formatter<T, std::enable_if_t<std::is_floating_point<T>::value>>
+{
+  static void format(std::string & out, T value)
+  {
+    char buffer[64];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // The shortest representation which reads back as the same value.
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+#else
+    const int length = std::snprintf(
+      buffer, sizeof(buffer), "%.*Lg", std::numeric_limits<T>::max_digits10,
+      static_cast<long double>(value));
+    if (length > 0) {
+      out.append(buffer, static_cast<size_t>(length) < sizeof(buffer) ?
+        static_cast<size_t>(length) : sizeof(buffer) - 1u);
+    }
+#endif
+  }
+};
+
+template<typename T>
+struct formatter<T, std::enable_if_t<std::is_enum<T>::value>>
+{
+  static void format(std::string & out, T value)
+  {
+    using underlying_type = std::underlying_type_t<T>;
+    formatter<underlying_type>::format(out, static_cast<underlying_type>(value));
+  }
+};
+
+template<typename T>
+struct formatter<
+  T, std::enable_if_t<std::is_pointer<T>::value &&
+  !std::is_same<std::remove_cv_t<std::remove_pointer_t<T>>, char>::value>>
+{
+  static void format(std::string & out, T value)
+  {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(value);
+    char buffer[2 * sizeof(uintptr_t) + 2];
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    const std::to_chars_result result =
+      std::to_chars(buffer + 2, buffer + sizeof(buffer), address, 16);
+    out.append(buffer, result.ptr);
+  }
+};
+
+template<>
+struct formatter<std::nullptr_t>
+{
+  static void format(std::string & out, std::nullptr_t)
+  {
+    out += "0x0";
+  }
+};
+
+template<>
+struct formatter<const char *>
+{
+  static void format(std::string & out, const char * value)
+  {
+    out += nullptr != value ? value : "(null)";
+  }
+};
+
+template<>
+struct formatter<char *>: formatter<const char *> {};
+
+template<>
+struct formatter<std::string_view>
+{
+  static void format(std::string & out, std::string_view value)
+  {
+    out.append(value.data(), value.size());
+  }
+};
+
+template<>
+struct formatter<std::string>: formatter<std::string_view> {};
+/// @endcond
+
+namespace detail
+{
+
+/// An argument of a message, with the function formatting it.
+struct argument
+{
+  const void * value;
+  void (* format)(std::string & out, const void * value);
+};
+
+template<typename T>
+void format_argument(std::string & out, const void * value)
+{
+  formatter<std::decay_t<T>>::format(out, *static_cast<const T *>(value));
+}
+
+/// Append the format to `out`, with its placeholders replaced by the arguments.
+inline void format_to(
+  std::string & out, const char * format, const argument * arguments, size_t argument_count)
+{
+  size_t next_argument = 0u;
+  const char * literal = format;
+  const char * c = format;
+  for (; '\0' != *c; ++c) {
+    if ('{' != *c && '}' != *c) {
+      continue;
+    }
+    out.append(literal, c);
+    if ('{' == c[0] && '}' == c[1]) {
+      if (next_argument < argument_count) {
+        arguments[next_argument].format(out, arguments[next_argument].value);
+      }
+      ++next_argument;
+      ++c;
+    } else {
+      out += *c;
+      if (c[0] == c[1]) {
+        ++c;
+      }
+    }
+    literal = c + 1;
+  }
+  out.append(literal, c);
+}
+
+/// The buffer messages are formatted into, one per thread.
+struct thread_buffer
+{
+  std::string message;
+  bool in_use = false;
+};
+
+inline thread_buffer & get_thread_buffer()
+{
+  thread_local thread_buffer buffer;
+  return buffer;
+}
+
+/// Format a message into the buffer of the thread, and log it.
+inline void log_arguments(
+  const rcutils_log_location_t * location, int severity, const char * name,
+  const char * format, const argument * arguments, size_t argument_count)
+{
+  thread_buffer & buffer = get_thread_buffer();
+  if (buffer.in_use) {
+    // An output handler or a formatter logging while the buffer holds a message.
+    std::string message;
+    format_to(message, format, arguments, argument_count);
+    rcutils_log_string_internal(location, severity, name, message.data(), message.size());
+    return;
+  }
+  struct release_buffer
+  {
+    thread_buffer & buffer;
+    ~release_buffer()
+    {
+      buffer.in_use = false;
+    }
+  } release{buffer};
+  buffer.in_use = true;
+  buffer.message.clear();
+  format_to(buffer.message, format, arguments, argument_count);
+  rcutils_log_string_internal(
+    location, severity, name, buffer.message.data(), buffer.message.size());
+}
+
+}  // namespace detail
+
+/// Format and log a message, assuming the logger is enabled, for the `_FMT` logging macros.
+/**
+ * \tparam PlaceholderCount the number of placeholders of the format, see count_placeholders()
+ * \param[in] location the pointer to the location struct or NULL
+ * \param[in] severity the severity level
+ * \param[in] name the name of the logger, must be null terminated c string or NULL
+ * \param[in] format the format string
+ * \param[in] args an argument for each placeholder of the format
+ */
+template<size_t PlaceholderCount, typename ... Args>
+void log(
+  const rcutils_log_location_t * location, int severity, const char * name,
+  const char * format, const Args & ... args)
+{
+  static_assert(
+    invalid_format != PlaceholderCount,
+    "the logging format string has a { or a } which isn't part of a {}, a {{ or a }}");
+  static_assert(
+    sizeof...(Args) == PlaceholderCount,
+    "the logging format string must have as many {} as there are arguments");
+  // With an extra element, as arrays can't be empty.
+  const detail::argument arguments[] = {
+    {&args, &detail::format_argument<Args>}..., {nullptr, nullptr}};
+  detail::log_arguments(location, severity, name, format, arguments, sizeof...(Args));
+}
+
+}  // namespace logging_format
+}  // namespace rcutils
+
+/// @cond Doxygen_Suppress
+#define RCUTILS_LOGGING_FORMAT_EXPAND(x) x
+#define RCUTILS_LOGGING_FORMAT_FIRST(first, ...) first
+/// @endcond
+
+/**
+ * \def RCUTILS_LOGGING_FORMAT_STRING
+ * The format string of the arguments of a `_FMT` logging macro, which comes first.
+ */
+#define RCUTILS_LOGGING_FORMAT_STRING(...) \
+  RCUTILS_LOGGING_FORMAT_EXPAND(RCUTILS_LOGGING_FORMAT_FIRST(__VA_ARGS__, unused))
+
+/**
+ * \def RCUTILS_LOGGING_FORMAT_LOG
+ * Format and log a message, with its format string checked at compile time.
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger
+ * \param[in] ... The format string literal, followed by an argument for each `{}` in it
+ */
+#define RCUTILS_LOGGING_FORMAT_LOG(location, severity, name, ...) \
+  ::rcutils::logging_format::log< \
+    ::rcutils::logging_format::count_placeholders(RCUTILS_LOGGING_FORMAT_STRING(__VA_ARGS__))>( \
+    location, severity, name, __VA_ARGS__)
+
+/**
+ * \def RCUTILS_LOG_COND_NAMED_FMT
+ * The variant of RCUTILS_LOG_COND_NAMED which formats `{}` placeholders.
+ *
+ * \param[in] severity The severity level
+ * \param[in] condition_before The condition macro(s) inserted before the log call
+ * \param[in] condition_after The condition macro(s) inserted after the log call
+ * \param[in] name The name of the logger
+ * \param[in] ... The format string literal, followed by an argument for each `{}` in it
+ */
+#define RCUTILS_LOG_COND_NAMED_FMT(severity, condition_before, condition_after, name, ...) \
+  do { \
+    if (RCUTILS_LOGGING_IS_COMPILED_OUT(name, severity)) { \
+      break; \
+    } \
+    RCUTILS_LOGGING_AUTOINIT; \
+    static rcutils_log_location_t __rcutils_logging_location = {__func__, __FILE__, __LINE__}; \
+    static rcutils_log_callsite_cache_t __rcutils_logging_callsite_cache = \
+      RCUTILS_LOG_CALLSITE_CACHE_INITIALIZER; \
+    if (!rcutils_logging_is_below_uniform_level(severity) && \
+      RCUTILS_LOGGING_CALLSITE_IS_ENABLED_FOR( \
+        &__rcutils_logging_callsite_cache, name, severity)) \
+    { \
+      condition_before \
+      RCUTILS_LOGGING_FORMAT_LOG(&__rcutils_logging_location, severity, name, __VA_ARGS__); \
+      condition_after \
+    } \
+  } while (0)
+
+/**
+ * \def RCUTILS_LOG_COND_HANDLE_FMT
+ * The variant of RCUTILS_LOG_COND_HANDLE which formats `{}` placeholders.
+ *
+ * \param[in] severity The severity level
+ * \param[in] condition_before The condition macro(s) inserted before the log call
+ * \param[in] condition_after The condition macro(s) inserted after the log call
+ * \param[in] handle The logger handle, see rcutils_logging_get_logger_handle()
+ * \param[in] ... The format string literal, followed by an argument for each `{}` in it
+ */
+#define RCUTILS_LOG_COND_HANDLE_FMT(severity, condition_before, condition_after, handle, ...) \
+  do { \
+    static rcutils_log_location_t __rcutils_logging_location = {__func__, __FILE__, __LINE__}; \
+    rcutils_logger_handle_t * const __rcutils_logging_handle = (handle); \
+    if (!rcutils_logging_is_below_uniform_level(severity) && \
+      rcutils_logging_logger_handle_is_enabled_for(__rcutils_logging_handle, severity)) \
+    { \
+      condition_before \
+      RCUTILS_LOGGING_FORMAT_LOG( \
+        &__rcutils_logging_location, severity, \
+        rcutils_logging_get_logger_handle_name(__rcutils_logging_handle), __VA_ARGS__); \
+      condition_after \
+    } \
+  } while (0)
+
+#endif  // RCUTILS__LOGGING_FORMAT_HPP_
@@ -0,0 +1,178 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__LOGGING_JOURNAL_SINK_H_
+#define RCUTILS__LOGGING_JOURNAL_SINK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// The protocol a journal sink speaks to the system logger.
+typedef enum rcutils_logging_journal_sink_protocol_e
+{
+  /// The native protocol of systemd-journald, keeping every field of a message.
+  RCUTILS_LOGGING_JOURNAL_SINK_JOURNALD = 0,
+  /// The BSD syslog protocol, understood by any syslog daemon.
+  RCUTILS_LOGGING_JOURNAL_SINK_SYSLOG = 1,
+} rcutils_logging_journal_sink_protocol_t;
+
+/// The options of a journal sink.
+typedef struct rcutils_logging_journal_sink_options_s
+{
+  /// The protocol to use.
+  rcutils_logging_journal_sink_protocol_t protocol;
+  /// The datagram socket of the system logger, or NULL for the default of the protocol.
+  /**
+   * The defaults are `/run/systemd/journal/socket` for journald and `/dev/log` for syslog.
+   */
+  const char * socket_path;
+  /// The identifier of the process in the system log, e.g. its name, or NULL for none.
+  const char * identifier;
+} rcutils_logging_journal_sink_options_t;
+
+/// A journal sink, created with rcutils_logging_journal_sink_init().
+typedef struct rcutils_logging_journal_sink_s rcutils_logging_journal_sink_t;
+
+/// Return the default options of a journal sink.
+/**
+ * The defaults use the journald protocol on its default socket, without an
+ * identifier.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_journal_sink_options_t rcutils_logging_journal_sink_get_default_options(void);
+
+/// Connect a sink to the socket of the system logger.
+/**
+ * Each message is sent as a single datagram, gathered with `sendmsg()` from
+ * the logger name, the message and the location fields where they are, so
+ * nothing is copied nor formatted but the line number, and the severity is
+ * mapped to a syslog priority: `DEBUG` to 7 (debug), `INFO` to 6 (info),
+ * `WARN` to 4 (warning), `ERROR` to 3 (err) and `FATAL` to 2 (crit).
+ *
+ * With the journald protocol, the fields are sent as `MESSAGE`, `PRIORITY`,
+ * `SYSLOG_IDENTIFIER`, `CODE_FILE`, `CODE_LINE`, `CODE_FUNC` and
+ * `RCUTILS_LOGGER_NAME`, so they can be queried, e.g. with
+ * `journalctl RCUTILS_LOGGER_NAME=node`.
+ * With the syslog protocol, a message is sent as
+ * `<priority>identifier: [name] message`, without the location.
+ *
+ * Messages are sent without blocking: those which the system logger can't
+ * take right away, or which are too large for a datagram, are dropped and
+ * counted, see rcutils_logging_journal_sink_get_dropped_count().
+ * This is only supported on POSIX systems.
+ *
+ * To receive messages, the sink has to be registered with the sink dispatcher:
+ *
+ * ```c
+ * rcutils_logging_journal_sink_t * sink = NULL;
+ * rcutils_logging_journal_sink_options_t options =
+ *   rcutils_logging_journal_sink_get_default_options();
+ * options.identifier = "my_node";
+ * ret = rcutils_logging_journal_sink_init(&sink, &options, rcutils_get_default_allocator());
+ * ret = rcutils_logging_add_sink(
+ *   rcutils_logging_journal_sink_output, sink, RCUTILS_LOG_SEVERITY_INFO);
+ * rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] sink The new sink
+ * \param[in] options The options of the sink
+ * \param[in] allocator The allocator used for the sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the socket could not be connected, or on
+ *   platforms without Unix domain sockets.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_journal_sink_init(
+  rcutils_logging_journal_sink_t ** sink,
+  const rcutils_logging_journal_sink_options_t * options,
+  rcutils_allocator_t allocator);
+
+/// Return the number of messages which could not be sent so far.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_journal_sink_get_dropped_count(rcutils_logging_journal_sink_t * sink);
+
+/// Close the socket and free the sink.
+/**
+ * The sink must not be used anymore, so it must be removed from the sink
+ * dispatcher first.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] sink The sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the sink is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_journal_sink_fini(rcutils_logging_journal_sink_t * sink);
+
+/// The #rcutils_logging_sink_t sending to the journal sink passed as the context.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] message The formatted message
+ * \param[in] context The rcutils_logging_journal_sink_t to send to
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_journal_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__LOGGING_JOURNAL_SINK_H_
@@ -0,0 +1,292 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__LOGGING_SHM_SINK_H_
+#define RCUTILS__LOGGING_SHM_SINK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// The options of a shared memory sink.
+typedef struct rcutils_logging_shm_sink_options_s
+{
+  /// The name of the shared memory object, or NULL for `/rcutils_log.<pid>`.
+  /**
+   * As for `shm_open()`, it starts with a slash and contains no other one.
+   */
+  const char * name;
+  /// The size in bytes of the ring of records, a power of two of 4 KiB to 1 GiB.
+  size_t capacity;
+} rcutils_logging_shm_sink_options_t;
+
+/// A shared memory sink, created with rcutils_logging_shm_sink_init().
+typedef struct rcutils_logging_shm_sink_s rcutils_logging_shm_sink_t;
+
+/// A reader of the records of a shared memory sink, see rcutils_logging_shm_reader_open().
+typedef struct rcutils_logging_shm_reader_s rcutils_logging_shm_reader_t;
+
+/// A record read from a shared memory sink.
+/**
+ * The strings are null terminated and point into the shared memory, so they
+ * are only valid until the callback they are passed to returns.
+ */
+typedef struct rcutils_logging_shm_record_s
+{
+  /// The timestamp of the message.
+  rcutils_time_point_value_t timestamp;
+  /// The severity of the message.
+  int severity;
+  /// The name of the logger.
+  const char * name;
+  /// The formatted message.
+  const char * message;
+  /// The file name of the location of the message, or NULL without a location.
+  const char * file_name;
+  /// The function name of the location of the message, or NULL without a location.
+  const char * function_name;
+  /// The line number of the location of the message, or 0 without a location.
+  size_t line_number;
+} rcutils_logging_shm_record_t;
+
+/// The function a reader passes each record to, along with its context.
+typedef void (* rcutils_logging_shm_record_callback_t)(
+  const rcutils_logging_shm_record_t * record, void * context);
+
+/// Return the default options of a shared memory sink.
+/**
+ * The defaults name the shared memory object after the process id, with a
+ * ring of 1 MiB.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_logging_shm_sink_options_t rcutils_logging_shm_sink_get_default_options(void);
+
+/// Create a sink writing records into a ring in shared memory.
+/**
+ * This lets a separate collector process take the messages of many processes
+ * and persist them, see rcutils_logging_shm_reader_open(), so the processes
+ * logging don't write to pipes nor files.
+ * Writing a message reserves room in the ring with an atomic compare and swap,
+ * then copies the logger name, the message and the location into it, and
+ * publishes the record with a release store.
+ * Messages for which the ring has no room left, since the collector doesn't
+ * keep up, are dropped and counted, see
+ * rcutils_logging_shm_sink_get_dropped_count(), so logging never waits.
+ *
+ * The shared memory object is created, or replaced if it exists, readable and
+ * writable by the user only, and the pages of the ring are touched here, so
+ * that writing the first records doesn't fault them in.
+ * This is only supported on POSIX systems.
+ *
+ * To receive messages, the sink has to be registered with the sink dispatcher:
+ *
+ * ```c
+ * rcutils_logging_shm_sink_t * sink = NULL;
+ * rcutils_logging_shm_sink_options_t options = rcutils_logging_shm_sink_get_default_options();
+ * ret = rcutils_logging_shm_sink_init(&sink, &options, rcutils_get_default_allocator());
+ * ret = rcutils_logging_add_sink(rcutils_logging_shm_sink_output, sink, RCUTILS_LOG_SEVERITY_INFO);
+ * rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] sink The new sink
+ * \param[in] options The options of the sink
+ * \param[in] allocator The allocator used for the sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the shared memory could not be created, or on
+ *   platforms without POSIX shared memory.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_shm_sink_init(
+  rcutils_logging_shm_sink_t ** sink,
+  const rcutils_logging_shm_sink_options_t * options,
+  rcutils_allocator_t allocator);
+
+/// Return the name of the shared memory object of the sink.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const char * rcutils_logging_shm_sink_get_name(const rcutils_logging_shm_sink_t * sink);
+
+/// Return the number of messages dropped so far, as the ring had no room left for them.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_shm_sink_get_dropped_count(const rcutils_logging_shm_sink_t * sink);
+
+/// Mark the ring as closed, remove the shared memory object and free the sink.
+/**
+ * A reader which opened the ring before keeps reading the records left in it,
+ * after which rcutils_logging_shm_reader_is_closed() tells it is done.
+ * The sink must not be used anymore, so it must be removed from the sink
+ * dispatcher first.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] sink The sink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the sink is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_shm_sink_fini(rcutils_logging_shm_sink_t * sink);
+
+/// The #rcutils_logging_sink_t writing to the shared memory sink passed as the context.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] location The pointer to the location struct or NULL
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \param[in] timestamp The timestamp for when the log message was made
+ * \param[in] message The formatted message
+ * \param[in] context The rcutils_logging_shm_sink_t to write to
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_shm_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context);
+
+/// Open the ring of a shared memory sink, to take its records.
+/**
+ * A collector opens the ring of each process, e.g. those in `/dev/shm` on
+ * Linux, and takes their records in turns, merging them by timestamp.
+ * Only one reader may read a ring at a time.
+ * A process which crashed leaves its shared memory object behind, which the
+ * collector may remove with `shm_unlink()` once it drained the ring and
+ * rcutils_logging_shm_reader_get_pid() is no longer running.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] reader The new reader
+ * \param[in] name The name of the shared memory object of the sink
+ * \param[in] allocator The allocator used for the reader
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the shared memory could not be opened, isn't
+ *   the ring of a sink, or on platforms without POSIX shared memory.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_shm_reader_open(
+  rcutils_logging_shm_reader_t ** reader,
+  const char * name,
+  rcutils_allocator_t allocator);
+
+/// Take the records published so far, oldest first, passing each to the callback.
+/**
+ * The room of each record is given back to the sink once the callback
+ * returns, so the callback should be quick, e.g. copy the record into a
+ * batch to write.
+ * A record whose writer is still writing it stops the taking, along with the
+ * records after it, until a next call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] reader The reader
+ * \param[in] callback The function called with each record
+ * \param[in] context The context passed to the callback
+ * \param[in] max_count The largest number of records to take
+ * \param[out] count The number of records taken
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the ring is corrupted, in which case it can't be read anymore.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_shm_reader_take(
+  rcutils_logging_shm_reader_t * reader,
+  rcutils_logging_shm_record_callback_t callback,
+  void * context,
+  size_t max_count,
+  size_t * count);
+
+/// Return whether the sink was finalized and all its records were taken.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_shm_reader_is_closed(const rcutils_logging_shm_reader_t * reader);
+
+/// Return the id of the process of the sink.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+int64_t rcutils_logging_shm_reader_get_pid(const rcutils_logging_shm_reader_t * reader);
+
+/// Return the number of messages the sink dropped so far.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t rcutils_logging_shm_reader_get_dropped_count(const rcutils_logging_shm_reader_t * reader);
+
+/// Unmap the ring and free the reader.
+/**
+ * \param[in] reader The reader
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the reader is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_shm_reader_close(rcutils_logging_shm_reader_t * reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__LOGGING_SHM_SINK_H_
@@ -22,8 +22,13 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
 
 /// Retrieve the current process ID.
@@ -54,6 +59,161 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 char * rcutils_get_executable_name(rcutils_allocator_t allocator);
 
+/// The identity of the current process, see rcutils_get_process_identity().
+typedef struct rcutils_process_identity_s
+{
+  /// The process ID, as returned by rcutils_get_pid().
+  int pid;
+  /// The executable name, like rcutils_get_executable_name() returns, or "" if unknown.
+  /**
+   * Names longer than 255 characters are truncated.
+   */
+  const char * executable_name;
+} rcutils_process_identity_t;
+
+/// Retrieve the identity of the current process, without allocating nor calling the OS.
+/**
+ * The identity is derived by the first call, and only read by the following ones, so that
+ * it may be queried for each log message, e.g. to tag it, at no cost.
+ * The process ID is updated in the child process after a `fork()`, and the executable name is
+ * the one the program had at the first call.
+ *
+ * The identity is owned by rcutils and must not be modified nor freed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes, once the identity was derived
+ *
+ * \return The identity of the current process.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const rcutils_process_identity_t * rcutils_get_process_identity(void);
+
+/// The number of CPUs a rcutils_cpu_set_t can hold, with indices from 0.
+#define RCUTILS_CPU_SET_SIZE 1024
+
+/// A set of CPUs, by their index, e.g. the CPUs a thread may run on.
+typedef struct rcutils_cpu_set_s
+{
+  /// One bit per CPU, CPU `i` being the bit `i % 64` of `bits[i / 64]`.
+  uint64_t bits[RCUTILS_CPU_SET_SIZE / 64];
+} rcutils_cpu_set_t;
+
+/// Return an empty CPU set.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_cpu_set_t
+rcutils_get_zero_initialized_cpu_set(void);
+
+/// Add a CPU to a CPU set.
+/**
+ * \param[inout] cpu_set the CPU set
+ * \param[in] cpu the index of the CPU, less than #RCUTILS_CPU_SET_SIZE
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_cpu_set_add(rcutils_cpu_set_t * cpu_set, size_t cpu);
+
+/// Return whether a CPU set holds a CPU, which is false for invalid arguments.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_cpu_set_contains(const rcutils_cpu_set_t * cpu_set, size_t cpu);
+
+/// Return the number of CPUs a CPU set holds, which is 0 for invalid arguments.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t
+rcutils_cpu_set_count(const rcutils_cpu_set_t * cpu_set);
+
+/// The scheduling policy of a thread, see rcutils_thread_attributes_t.
+typedef enum rcutils_thread_scheduling_policy_e
+{
+  /// Keep the policy and priority the thread has, or inherits from the one creating it.
+  RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT = 0,
+  /// The default time sharing policy, `SCHED_OTHER` on POSIX systems.
+  RCUTILS_THREAD_SCHEDULING_POLICY_OTHER = 1,
+  /// The first in, first out real-time policy, `SCHED_FIFO` on POSIX systems.
+  RCUTILS_THREAD_SCHEDULING_POLICY_FIFO = 2,
+  /// The round-robin real-time policy, `SCHED_RR` on POSIX systems.
+  RCUTILS_THREAD_SCHEDULING_POLICY_RR = 3,
+} rcutils_thread_scheduling_policy_t;
+
+/// Where a thread runs and how it is scheduled.
+/**
+ * On POSIX systems, the priority is the `sched_priority` of the policy, which is 1 to 99
+ * on Linux for the real-time policies, and must be 0 for #RCUTILS_THREAD_SCHEDULING_POLICY_OTHER.
+ * Real-time policies usually require privileges, e.g. `CAP_SYS_NICE` on Linux.
+ *
+ * Windows has no scheduling policies: with #RCUTILS_THREAD_SCHEDULING_POLICY_OTHER, the
+ * priority is passed to `SetThreadPriority()`, e.g. `THREAD_PRIORITY_LOWEST` (-2) to
+ * `THREAD_PRIORITY_HIGHEST` (2), while real-time policies give the thread
+ * `THREAD_PRIORITY_TIME_CRITICAL`.
+ *
+ * The CPUs can be set on Linux with glibc, and on Windows, where only the first 64 CPUs may be
+ * used, while setting them fails elsewhere.
+ */
+typedef struct rcutils_thread_attributes_s
+{
+  /// The CPUs the thread may run on, or an empty set to keep the ones it has or inherits.
+  rcutils_cpu_set_t cpu_set;
+  /// The scheduling policy.
+  rcutils_thread_scheduling_policy_t scheduling_policy;
+  /// The priority, ignored with #RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT.
+  int priority;
+} rcutils_thread_attributes_t;
+
+/// Return the default thread attributes, which keep everything a thread inherits.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_thread_attributes_t
+rcutils_get_default_thread_attributes(void);
+
+/// Set the CPUs, scheduling policy and priority of the calling thread.
+/**
+ * The threads rcutils starts, like the consumer thread of the asynchronous logging mode, take
+ * their attributes from their options instead, e.g. to keep them off the CPUs reserved for
+ * real-time threads.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] attributes the attributes to set
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, e.g. an out of range priority, or
+ * \return #RCUTILS_RET_ERROR if the OS refused them, e.g. for lack of privileges, or
+ *   can't set the CPUs of a thread.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_set_current_attributes(const rcutils_thread_attributes_t * attributes);
+
+/// Get the CPUs the calling thread may run on.
+/**
+ * \param[out] cpu_set the CPUs
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if they can't be retrieved, which is always the case beyond Linux.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_get_current_cpu_set(rcutils_cpu_set_t * cpu_set);
+
 #ifdef __cplusplus
 }
 #endif
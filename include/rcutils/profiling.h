@@ -0,0 +1,283 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__PROFILING_H_
+#define RCUTILS__PROFILING_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "rcutils/macros.h"
+#include "rcutils/time.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// The number of bits of the durations kept by a latency histogram, after their leading one.
+#define RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKET_BITS (4)
+
+/// The number of buckets each power of two is split into by a latency histogram.
+#define RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS (1 << RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+
+/// The number of buckets of a latency histogram, enough for any non-negative duration.
+#define RCUTILS_LATENCY_HISTOGRAM_BUCKETS \
+  ((64 - RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKET_BITS) * RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS)
+
+/// A histogram of durations, in nanoseconds, with log-linear buckets, like HDR histograms.
+/**
+ * Durations below #RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS nanoseconds have a bucket each,
+ * and each larger power of two is split into #RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS buckets,
+ * so that the durations of a bucket are within 1 / #RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS,
+ * i.e. 6.25%, of each other.
+ *
+ * Durations are recorded with atomic additions, without locks nor allocations, so that a
+ * histogram can be shared by many threads, and it needs no initialization besides being
+ * zeroed, so that it may be a global variable.
+ * The members should only be read from a copy made with rcutils_latency_histogram_snapshot().
+ */
+typedef struct rcutils_latency_histogram_s
+{
+  /// The number of durations recorded in each bucket.
+  uint64_t counts[RCUTILS_LATENCY_HISTOGRAM_BUCKETS];
+  /// The number of durations recorded.
+  uint64_t total_count;
+  /// The sum of the durations recorded, in nanoseconds.
+  uint64_t total_duration;
+  /// The bitwise complement of the smallest duration recorded, so that zero means none.
+  uint64_t min_duration_complement;
+  /// The largest duration recorded.
+  uint64_t max_duration;
+} rcutils_latency_histogram_t;
+
+/// Record a duration in a histogram.
+/**
+ * Negative durations are recorded as zero.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] histogram the histogram
+ * \param[in] duration the duration, in nanoseconds
+ */
+RCUTILS_PUBLIC
+void
+rcutils_latency_histogram_record(
+  rcutils_latency_histogram_t * histogram, rcutils_duration_value_t duration);
+
+/// Copy a histogram which other threads may be recording in.
+/**
+ * Each counter is read atomically, but durations recorded meanwhile may only be
+ * partially copied, e.g. counted in their bucket but not yet in the total count.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] histogram the histogram to copy
+ * \param[out] snapshot the copy
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_latency_histogram_snapshot(
+  const rcutils_latency_histogram_t * histogram, rcutils_latency_histogram_t * snapshot);
+
+/// Add the durations of a histogram to another, e.g. to combine histograms of several threads.
+/**
+ * Both histograms may be recorded in by other threads meanwhile.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] histogram the histogram to add to
+ * \param[in] other the histogram to add, which must be a different one
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_latency_histogram_merge(
+  rcutils_latency_histogram_t * histogram, const rcutils_latency_histogram_t * other);
+
+/// Forget the durations recorded in a histogram.
+/**
+ * Durations recorded by other threads meanwhile may be partially forgotten.
+ *
+ * \param[inout] histogram the histogram
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_latency_histogram_reset(rcutils_latency_histogram_t * histogram);
+
+/// Return the duration below or at which a percentage of the recorded durations are.
+/**
+ * The duration is the largest of its bucket, i.e. at most 6.25% more than the exact one,
+ * but never more than the largest duration recorded.
+ * The histogram should be a snapshot if other threads record in it.
+ *
+ * \param[in] histogram the histogram
+ * \param[in] percentile the percentage of durations, from 0 to 100
+ * \param[out] duration the duration, or 0 if no durations were recorded
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_latency_histogram_get_percentile(
+  const rcutils_latency_histogram_t * histogram,
+  double percentile,
+  rcutils_duration_value_t * duration);
+
+/// Return the smallest duration recorded in a histogram, or 0 if none were.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_duration_value_t
+rcutils_latency_histogram_get_min(const rcutils_latency_histogram_t * histogram);
+
+/// Return the largest duration recorded in a histogram, or 0 if none were.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_duration_value_t
+rcutils_latency_histogram_get_max(const rcutils_latency_histogram_t * histogram);
+
+/// A stopwatch measuring durations with the fast steady clock.
+/**
+ * The time is read with rcutils_steady_time_now_fast(), which reads the CPU counter once
+ * rcutils_steady_time_fast_init() was called, and calls rcutils_steady_time_now() otherwise.
+ */
+typedef struct rcutils_stopwatch_s
+{
+  /// When the stopwatch was started.
+  rcutils_time_point_value_t start;
+} rcutils_stopwatch_t;
+
+/// Start, or restart, a stopwatch.
+/**
+ * \param[out] stopwatch the stopwatch
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the clock couldn't be read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_stopwatch_start(rcutils_stopwatch_t * stopwatch);
+
+/// Return the time elapsed since a stopwatch was started.
+/**
+ * \param[in] stopwatch the started stopwatch
+ * \param[out] elapsed the time elapsed, in nanoseconds
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the clock couldn't be read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_stopwatch_elapsed(
+  const rcutils_stopwatch_t * stopwatch, rcutils_duration_value_t * elapsed);
+
+/// Record the time elapsed since a stopwatch was started in a histogram, and restart it.
+/**
+ * The stopwatch restarts from the same time point which ends the recorded duration, so that
+ * consecutive durations, e.g. of the stages of a loop, add up to the total time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, with different stopwatches
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] stopwatch the started stopwatch
+ * \param[inout] histogram the histogram to record the duration in
+ * \param[out] elapsed the time elapsed, in nanoseconds, or NULL
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the clock couldn't be read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_stopwatch_record(
+  rcutils_stopwatch_t * stopwatch,
+  rcutils_latency_histogram_t * histogram,
+  rcutils_duration_value_t * elapsed);
+
+#ifdef __cplusplus
+}
+
+// C++ linkage, even when this header is included by one which declares C linkage.
+extern "C++"
+{
+/// Record the time a scope takes in a histogram, from its construction to its destruction.
+class rcutils_scoped_stopwatch
+{
+public:
+  explicit rcutils_scoped_stopwatch(rcutils_latency_histogram_t & histogram)
+  : histogram_(histogram), started_(RCUTILS_RET_OK == rcutils_stopwatch_start(&stopwatch_))
+  {
+  }
+
+  ~rcutils_scoped_stopwatch()
+  {
+    if (started_) {
+      rcutils_ret_t ret = rcutils_stopwatch_record(&stopwatch_, &histogram_, nullptr);
+      (void)ret;
+    }
+  }
+
+  rcutils_scoped_stopwatch(const rcutils_scoped_stopwatch &) = delete;
+  rcutils_scoped_stopwatch & operator=(const rcutils_scoped_stopwatch &) = delete;
+
+private:
+  rcutils_latency_histogram_t & histogram_;
+  rcutils_stopwatch_t stopwatch_;
+  bool started_;
+};
+}
+
+/// Record the time the rest of the enclosing scope takes in a histogram.
+#define RCUTILS_PROFILE_SCOPE(histogram) \
+  rcutils_scoped_stopwatch RCUTILS_JOIN(rcutils_scoped_stopwatch_, __LINE__)(histogram)
+#endif
+
+#endif  // RCUTILS__PROFILING_H_
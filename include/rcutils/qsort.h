@@ -22,6 +22,9 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
 #include "rcutils/macros.h"
 #include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
@@ -46,6 +49,57 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_qsort(void * ptr, size_t count, size_t size, int (* comp)(const void *, const void *));
 
+/// The fewest elements rcutils_qsort_parallel() sorts in each thread.
+#define RCUTILS_QSORT_PARALLEL_MIN_COUNT 32768
+
+/// Sort an array like rcutils_qsort(), splitting the work between several threads.
+/**
+ * The array is split into as many pieces as there are threads, each of at least
+ * #RCUTILS_QSORT_PARALLEL_MIN_COUNT elements, which are sorted at once by different threads
+ * with rcutils_qsort(), and then merged by pairs, also at once, into a buffer as large as the
+ * array.
+ * Arrays too small to be split into two such pieces are sorted with rcutils_qsort() in the
+ * calling thread, without allocating.
+ *
+ * The comparison function is called from several threads at once.
+ * The threads are those of an rcutils_thread_pool_t, started once for both the sorting and
+ * the merging, and the calling thread takes part.
+ * If the threads can't be started, or a piece can't be queued, the calling thread does that
+ * work instead.
+ * Like rcutils_qsort(), the sort is not stable.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] ptr object whose elements should be sorted.
+ * \param[in] count number of elements present in the object.
+ * \param[in] size size of each element, in bytes.
+ * \param[in] comp function used to compare two elements, which must be thread-safe.
+ * \param[in] thread_count the most threads to sort with, including the calling thread, or 0
+ *   for the number of processors.
+ * \param[in] allocator the allocator used for the merge buffer and the thread pool, which
+ *   must be thread-safe.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_qsort_parallel(
+  void * ptr,
+  size_t count,
+  size_t size,
+  int (* comp)(const void *, const void *),
+  size_t thread_count,
+  const rcutils_allocator_t * allocator);
+
 #ifdef __cplusplus
 }
 #endif
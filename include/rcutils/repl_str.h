@@ -35,6 +35,8 @@ extern "C"
 
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
+#include "rcutils/types/char_array.h"
+#include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
 
 /// Replace all the occurrences of one string for another in the given string.
@@ -49,8 +51,7 @@ extern "C"
  * with the destination string `to`.
  * The lengths of the strings `from` and `to` may differ.
  * The string `to` may be of any length, but the string `from` must be of
- * non-zero length - the penalty for providing an empty string for the `from`
- * parameter is an infinite loop.
+ * non-zero length.
  * In addition, none of the three parameters may be NULL.
  *
  * **Returns:**
@@ -61,62 +62,16 @@ extern "C"
  * The memory for the returned post-replacement string may be deallocated with
  * given allocator's deallocate function when it is no longer required.
  *
- * **Performance:**
- *
- * In case you are curious enough to want to compare this implementation with
- * alternative implementations, you are welcome to compile and run the code in
- * the benchmarking file,
- * [replacebench.c](http://creativeandcritical.net/downloads/replacebench.c).
- * In that file, the above function is included as `replace_cache`, and the
- * functions originally published on this page as `replace_str2` and
- * `replace_str` are included as `replace_opt2` and `replace_opt`.
- * Code/functions are included from the comp.lang.c thread,
- * [how to replace a substring in a string using C?]
- * (https://groups.google.com/forum/#!msg/comp.lang.c/sgydS2lDgxc/v2MRxRrAQncJ),
- * from answers to the stackoverflow question,
- * [What is the function to replace string in C?]
- * (http://stackoverflow.com/questions/779875/what-is-the-function-to-replace-string-in-c),
- * and also from private correspondence.
- * See the comments top of file for instructions on compiling and running it.
- *
- * In most scenarios, the fastest replacement function, by around 10-20%,
- * is Albert Chan's `replace_smart`, followed by the above function:
- * `repl_str` aka `replace_cache`.
- * There are some scenarios, though, where `repl_str` is faster than
- * `replace_smart`, sometimes by up to 200%.
- * These scenarios involve long strings with few matches.
- * Why, if Albert's function is generally slightly faster than the above
- * `repl_str` function, is it not the focus of this page?
- * Because it generally uses much more memory than `repl_str`.
- *
- * The third fastest implementation is typically `replace_str2` aka
- * `replace_opt2`.
- * For longer strings in the case in which the lengths of the "from" and "to"
- * strings differ, `repl_str` aka `replace_cache` beats it by margins of up to
- * about 80%.
- * For smaller strings, and in the case where the lengths of the "from" and
- * "to" strings are identical, `replace_str2` aka `replace_opt2` is faster,
- * by a maximum margin of about 35%, sometimes in those scenarios beating
- * `replace_smart` too.
- * Some of the other functions are also faster for smaller strings.
- * The even-match point between `replace_str2` and `repl_str`
- * (assuming "from" and "to" string lengths differ) depends on how far into
- * the string the final match occurs, how many matches there are, and the
- * comparative lengths of the old and "to" strings, but roughly it occurs for
- * strings of 700-800 bytes in length.
- *
- * This analysis is based on compiling with [GCC](https://gcc.gnu.org/) and
- * testing on a 64-bit Intel platform running Linux, however brief testing with
- * [Microsoft Visual C++ 2010 Express]
- * (https://www.visualstudio.com/en-US/products/visual-studio-express-vs)
- * (scroll down to "Additional information" at that link) on Windows 7 seemed
- * to produce similar results.
- *
  * ----
  *
  * Here continues additional documentation added by OSRF.
  *
  * The allocator must not be NULL.
+ * NULL is also returned if `from` is empty, or if any argument is NULL.
+ *
+ * The string is scanned once, searching for each match from the end of the
+ * previous one, and the result is written as the matches are found, see
+ * rcutils_repl_str_append().
  *
  * \param[in] str string to have substrings found and replaced within
  * \param[in] from string to match for replacement
@@ -133,7 +88,42 @@ rcutils_repl_str(
   const char * to,
   const rcutils_allocator_t * allocator);
 
-// Implementation copied from above mentioned source continues in repl_str.c.
+/// Append a string, with all the occurrences of one string replaced for another, to a char array.
+/**
+ * This function replaces the occurrences of `from` like rcutils_repl_str(), but appends the
+ * result to the given char array, e.g. to build a larger string from several templates,
+ * instead of allocating a new string.
+ * The char array grows as needed, with its own allocator.
+ *
+ * The matches are found with strstr, which the C libraries implement with fast substring
+ * searches, e.g. glibc with vectorized code and the Two-Way algorithm, so finding them takes
+ * linear time, whatever the length of `from`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] str string to have substrings found and replaced within
+ * \param[in] from string to match for replacement, which must not be empty
+ * \param[in] to string to replace matched strings with
+ * \param[inout] char_array the char array to append the result to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_repl_str_append(
+  const char * str,
+  const char * from,
+  const char * to,
+  rcutils_char_array_t * char_array);
 
 #ifdef __cplusplus
 }
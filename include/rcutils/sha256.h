@@ -37,6 +37,9 @@ extern "C"
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
 
 #define RCUTILS_SHA256_BLOCK_SIZE 32
@@ -93,6 +96,82 @@ void rcutils_sha256_final(
   uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE]);
 #endif
 
+/// Add data to many sha256 contexts at once
+/**
+ * This is equivalent to calling rcutils_sha256_update() on each context with its data,
+ * but hashes the blocks of several contexts at once with SIMD instructions where the CPU
+ * has them and has no faster instructions for a single context, e.g. with AVX2 but not the
+ * SHA extensions on x86.
+ * This is faster when hashing many small messages, such as files or type descriptions,
+ * whose contexts are then finalized with rcutils_sha256_final_many().
+ *
+ * \param[inout] ctxs Array of initialized sha256 context structs
+ * \param[in] data Array of the data to add to the message hashed by each context
+ * \param[in] data_lens Array of the sizes of the data added to each context
+ * \param[in] count Number of contexts
+ * \return void
+ */
+RCUTILS_PUBLIC
+void rcutils_sha256_update_many(
+  rcutils_sha256_ctx_t * ctxs, const uint8_t * const * data, const size_t * data_lens,
+  size_t count);
+
+/// Finalize many sha256 contexts at once and output their hashes.
+/**
+ * This is equivalent to calling rcutils_sha256_final() on each context, but hashes the last
+ * blocks of several contexts at once like rcutils_sha256_update_many().
+ *
+ * \param[inout] ctxs Array of initialized sha256 context structs
+ * \param[in] count Number of contexts
+ * \param[out] output_hashes Array of the calculated sha256 message digests to be filled
+ * \return void
+ */
+RCUTILS_PUBLIC
+void rcutils_sha256_final_many(
+  rcutils_sha256_ctx_t * ctxs, size_t count,
+  uint8_t (* output_hashes)[RCUTILS_SHA256_BLOCK_SIZE]);
+
+/// Compute the sha256 hash of the contents of a file.
+/**
+ * This replaces reading the file into a buffer to give to rcutils_sha256_update() a part at a
+ * time, and reads the file ahead of the hashing, so that reading and hashing overlap.
+ * Regular files are mapped into memory with rcutils_mmap_file(), and the system is asked to
+ * read each part of the file while the previous one is hashed.
+ * Other files, e.g. pipes or the ones of `/proc`, are read by a thread into one of two buffers
+ * of 1 MiB while the other one is hashed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, for files which can't be mapped
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] file_path The path of the file to hash.
+ * \param[out] output_hash Calculated sha256 message digest to be filled
+ * \param[in] allocator Allocator used for the buffers of files which can't be mapped.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if the file can't be opened or read.
+ */
+#ifdef DOXYGEN_ONLY
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_sha256_file(
+  const char * file_path,
+  uint8_t * output_hash,
+  rcutils_allocator_t allocator);
+#else
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_sha256_file(
+  const char * file_path,
+  uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE],
+  rcutils_allocator_t allocator);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,13 +22,18 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
 #include "rcutils/types/rcutils_ret.h"
 #include "rcutils/macros.h"
 #include "rcutils/visibility_control.h"
 
+struct rcutils_shared_library_symbol_cache_s;
+
 /// Handle to a loaded shared library.
 typedef struct RCUTILS_PUBLIC_TYPE rcutils_shared_library_s
 {
@@ -38,6 +43,8 @@ typedef struct RCUTILS_PUBLIC_TYPE rcutils_shared_library_s
   char * library_path;
   /// allocator
   rcutils_allocator_t allocator;
+  /// The entry of the library in the registry of loaded libraries, or NULL
+  struct rcutils_shared_library_symbol_cache_s * symbol_cache;
 } rcutils_shared_library_t;
 
 /// Return an empty shared library struct.
@@ -74,6 +81,13 @@ rcutils_get_zero_initialized_shared_library(void);
 
 /// Return shared library pointer.
 /**
+ * Loaded libraries are kept in a process-wide registry, keyed by the handle of the library,
+ * which is the same for all the loads of a library in the process, and reference counted by
+ * them.
+ * Only the first load of a library resolves its full path, and later ones copy it, so loading
+ * a library which is already loaded costs little more than `dlopen()` or `LoadLibrary()`.
+ * The symbols looked up are shared by all the loads of the library as well.
+ *
  * \param[inout] lib struct with the shared library pointer and shared library path name
  * \param[in] library_path string with the path of the library
  * \param[in] allocator to be used to allocate and deallocate memory
@@ -90,8 +104,65 @@ rcutils_load_shared_library(
   const char * library_path,
   rcutils_allocator_t allocator);
 
+/// Load a library the way rcutils_load_shared_library() does.
+#define RCUTILS_SHARED_LIBRARY_DEFAULT_FLAGS (0u)
+/// Bind all the symbols the library uses when loading it, with `RTLD_NOW`.
+/**
+ * Otherwise, with `RTLD_LAZY`, functions are bound the first time they are called, which
+ * moves that cost from loading the library to e.g. the first iteration of a control loop.
+ * On Windows, `LoadLibrary()` always binds the imports of the library.
+ */
+#define RCUTILS_SHARED_LIBRARY_BIND_NOW (1u << 0)
+/// Make the symbols of the library available to the libraries loaded after it, with
+/// `RTLD_GLOBAL`, rather than `RTLD_LOCAL`.
+/**
+ * This has no effect on Windows.
+ */
+#define RCUTILS_SHARED_LIBRARY_GLOBAL (1u << 1)
+/// Read the pages of the library into memory when loading it.
+/**
+ * Otherwise, the pages are read when first touched, which costs a page fault each, and a read
+ * of the file if it isn't cached.
+ * On Linux, the loadable segments of the library are advised with `MADV_WILLNEED` and then
+ * populated, with `MADV_POPULATE_READ` where supported or else by reading a byte per page.
+ * On Windows, the image of the library is prefetched with `PrefetchVirtualMemory()`.
+ * Elsewhere this has no effect, and failing to read the pages doesn't fail loading the library.
+ */
+#define RCUTILS_SHARED_LIBRARY_PREFAULT (1u << 2)
+
+/// Return shared library pointer, loading the library with flags.
+/**
+ * This is rcutils_load_shared_library(), which uses #RCUTILS_SHARED_LIBRARY_DEFAULT_FLAGS,
+ * with a combination of the `RCUTILS_SHARED_LIBRARY_` flags, e.g. to move the cost of binding
+ * the symbols of a plugin and reading its pages to startup.
+ * A library which is already loaded is bound, or made global, as `dlopen()` does it for the
+ * flags given.
+ *
+ * \param[inout] lib struct with the shared library pointer and shared library path name
+ * \param[in] library_path string with the path of the library
+ * \param[in] flags the `RCUTILS_SHARED_LIBRARY_` flags to load the library with
+ * \param[in] allocator to be used to allocate and deallocate memory
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, including unknown flags.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_load_shared_library_with_flags(
+  rcutils_shared_library_t * lib,
+  const char * library_path,
+  uint32_t flags,
+  rcutils_allocator_t allocator);
+
 /// Return shared library symbol pointer.
 /**
+ * Symbols are only looked up in the library the first time, and then remembered by the
+ * library handle along with the missing ones, so that rcutils_has_symbol() followed by
+ * rcutils_get_symbol() looks the symbol up once.
+ * Symbols may be looked up from several threads at once.
+ *
  * \param[in] lib struct with the shared library pointer and shared library path name
  * \param[in] symbol_name name of the symbol inside the shared library
  * \return shared library symbol pointer, or
@@ -104,6 +175,8 @@ rcutils_get_symbol(const rcutils_shared_library_t * lib, const char * symbol_nam
 
 /// Return true if the shared library contains a specific symbol name otherwise returns false.
 /**
+ * The result is remembered like with rcutils_get_symbol().
+ *
  * \param[in] lib struct with the shared library pointer and shared library path name
  * \param[in] symbol_name name of the symbol inside the shared library
  * \return `true` if the symbol exists, or
@@ -114,6 +187,38 @@ RCUTILS_WARN_UNUSED
 bool
 rcutils_has_symbol(const rcutils_shared_library_t * lib, const char * symbol_name);
 
+/// Return the pointers to several symbols of a shared library.
+/**
+ * This is equivalent to calling rcutils_get_symbol() for each name, but only takes the lock
+ * of the symbol cache twice per 32 symbols, and looks up the symbols not found in the cache
+ * outside of it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] lib the loaded shared library
+ * \param[in] symbol_names the names of the symbols
+ * \param[in] count the number of symbols
+ * \param[out] symbols the pointers to the symbols, in the order of their names, or `NULL` for
+ *   those which don't exist
+ * \return #RCUTILS_RET_OK if all the symbols exist, or
+ * \return #RCUTILS_RET_NOT_FOUND if some don't, naming the first in the error message, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_get_symbols(
+  const rcutils_shared_library_t * lib,
+  const char * const * symbol_names,
+  size_t count,
+  void ** symbols);
+
 /// Unload the shared library.
 /**
  * \param[in] lib rcutils_shared_library_t to be finalized
@@ -126,6 +231,70 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_unload_shared_library(rcutils_shared_library_t * lib);
 
+/// A shared library to load with rcutils_load_shared_libraries().
+typedef struct rcutils_shared_library_load_s
+{
+  /// The path of the library, as given to rcutils_load_shared_library()
+  const char * library_path;
+  /// The indices of the libraries which must be loaded before this one, or NULL
+  const size_t * dependencies;
+  /// The number of dependencies
+  size_t dependency_count;
+  /// The library, which must be zero initialized, and is only loaded if ret is #RCUTILS_RET_OK
+  rcutils_shared_library_t library;
+  /// The result of loading the library
+  rcutils_ret_t ret;
+  /// The error message, if the library failed to load
+  rcutils_error_string_t error;
+  /// The flags to load the library with, see rcutils_load_shared_library_with_flags()
+  uint32_t flags;
+} rcutils_shared_library_load_t;
+
+/// Load several shared libraries at once, from several threads.
+/**
+ * Each library is loaded with rcutils_load_shared_library_with_flags() and its flags once the
+ * libraries it depends on are loaded, so that libraries which don't depend on each other are
+ * loaded concurrently, including their constructors.
+ * If a library fails to load, the libraries depending on it, even indirectly, are not loaded
+ * either, and their error messages name the dependency.
+ * The result and the error message of each library are stored along with it, and the loaded
+ * libraries must be unloaded with rcutils_unload_shared_library().
+ *
+ * The other threads are those of an rcutils_thread_pool_t, and the calling thread takes part
+ * in loading the libraries.
+ * Note that dynamic loaders may serialize parts of the loading, such as the constructors with
+ * glibc, which limits how much is gained by loading concurrently.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] loads the libraries to load
+ * \param[in] count the number of libraries
+ * \param[in] thread_count the most threads loading libraries at once, including the calling one,
+ *   or 0 for the number of processors
+ * \param[in] allocator the allocator used to load the libraries, and by this function
+ * \return #RCUTILS_RET_OK if all the libraries were loaded, or
+ * \return #RCUTILS_RET_ERROR if some failed to load, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, including dependencies out of
+ *   range or in a cycle, and libraries which are not zero initialized, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ *   No library is loaded when returning #RCUTILS_RET_INVALID_ARGUMENT or
+ *   #RCUTILS_RET_BAD_ALLOC.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_load_shared_libraries(
+  rcutils_shared_library_load_t * loads,
+  size_t count,
+  size_t thread_count,
+  rcutils_allocator_t allocator);
+
 /// Check if the library is loaded.
 /**
  * This function only determines if "unload" has been called on the current shared library handle.
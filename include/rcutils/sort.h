@@ -0,0 +1,301 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__SORT_H_
+#define RCUTILS__SORT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Define a function sorting an array of elements of the given type, with an inlined comparison.
+/**
+ * This defines
+ * ```c
+ * static inline void name(type * array, size_t count, const void * context);
+ * ```
+ * which sorts the array in ascending order in place, without allocating, with pattern-defeating
+ * quicksort: a quicksort which takes O(n) comparisons for sorted, reverse sorted or equal
+ * elements, and falls back to heapsort to take O(n log n) comparisons in the worst case.
+ * The sort is not stable.
+ *
+ * Unlike rcutils_qsort(), the comparison is expanded in the sort itself instead of being called
+ * through a function pointer, which makes sorting small elements several times faster.
+ * `less(lhs, rhs, context)` is used as an expression which is true if the element pointed to by
+ * `lhs` is ordered before the one pointed to by `rhs`, where both are `const type *`, and
+ * `context` is the one given to the sort.
+ * Example:
+ * ```c
+ * #define INT_LESS(lhs, rhs, context) (*(lhs) < *(rhs))
+ * RCUTILS_DEFINE_SORT(sort_ints, int, INT_LESS)
+ *
+ * int values[] = {3, 1, 2};
+ * sort_ints(values, 3, NULL);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] name the name of the sort function to define
+ * \param[in] type the type of the elements of the arrays to sort
+ * \param[in] less the comparison of two elements, e.g. the name of a function-like macro
+ */
+#define RCUTILS_DEFINE_SORT(name, type, less) \
+  static inline void name ## _swap(type * a, type * b) \
+  { \
+    type tmp = *a; \
+    *a = *b; \
+    *b = tmp; \
+  } \
+ \
+  static inline void name ## _sort2(type * a, type * b, const void * context) \
+  { \
+    (void)context; \
+    if (less(b, a, context)) { \
+      name ## _swap(a, b); \
+    } \
+  } \
+ \
+  static inline void name ## _sort3(type * a, type * b, type * c, const void * context) \
+  { \
+    name ## _sort2(a, b, context); \
+    name ## _sort2(b, c, context); \
+    name ## _sort2(a, b, context); \
+  } \
+ \
+  /* Sort with insertion sort, which is fastest for few elements. */ \
+  /* Unless guarded, the element before begin must not be ordered after any in the range. */ \
+  static inline void name ## _insertion_sort( \
+    type * begin, type * end, bool guarded, const void * context) \
+  { \
+    (void)context; \
+    if (begin == end) { \
+      return; \
+    } \
+    for (type * cur = begin + 1; cur != end; ++cur) { \
+      type * sift = cur; \
+      type * sift_1 = cur - 1; \
+      if (less(sift, sift_1, context)) { \
+        type tmp = *sift; \
+        do { \
+          *sift-- = *sift_1; \
+        } while ((!guarded || sift != begin) && (--sift_1, less(&tmp, sift_1, context))); \
+        *sift = tmp; \
+      } \
+    } \
+  } \
+ \
+  /* Insertion sort which gives up, returning false, once it moved too many elements. */ \
+  static inline bool name ## _partial_insertion_sort( \
+    type * begin, type * end, const void * context) \
+  { \
+    (void)context; \
+    if (begin == end) { \
+      return true; \
+    } \
+    size_t moves = 0; \
+    for (type * cur = begin + 1; cur != end; ++cur) { \
+      type * sift = cur; \
+      type * sift_1 = cur - 1; \
+      if (less(sift, sift_1, context)) { \
+        type tmp = *sift; \
+        do { \
+          *sift-- = *sift_1; \
+        } while (sift != begin && (--sift_1, less(&tmp, sift_1, context))); \
+        *sift = tmp; \
+        moves += (size_t)(cur - sift); \
+      } \
+      if (moves > 8) { \
+        return false; \
+      } \
+    } \
+    return true; \
+  } \
+ \
+  static inline void name ## _sift_down( \
+    type * heap, size_t size, size_t root, const void * context) \
+  { \
+    (void)context; \
+    for (;;) { \
+      size_t child = 2 * root + 1; \
+      if (child >= size) { \
+        return; \
+      } \
+      if (child + 1 < size && less(&heap[child], &heap[child + 1], context)) { \
+        ++child; \
+      } \
+      if (!less(&heap[root], &heap[child], context)) { \
+        return; \
+      } \
+      name ## _swap(&heap[root], &heap[child]); \
+      root = child; \
+    } \
+  } \
+ \
+  static inline void name ## _heap_sort(type * begin, type * end, const void * context) \
+  { \
+    size_t size = (size_t)(end - begin); \
+    for (size_t i = size / 2; i > 0; --i) { \
+      name ## _sift_down(begin, size, i - 1, context); \
+    } \
+    for (size_t i = size; i > 1; --i) { \
+      name ## _swap(&begin[0], &begin[i - 1]); \
+      name ## _sift_down(begin, i - 1, 0, context); \
+    } \
+  } \
+ \
+  /* Partition around the pivot at begin, putting the elements equal to it on its right. */ \
+  static inline type * name ## _partition_right( \
+    type * begin, type * end, bool * already_partitioned, const void * context) \
+  { \
+    (void)context; \
+    type pivot = *begin; \
+    type * first = begin; \
+    type * last = end; \
+    while ((++first, less(first, &pivot, context))) { \
+    } \
+    if (first - 1 == begin) { \
+      while (first < last && !(--last, less(last, &pivot, context))) { \
+      } \
+    } else { \
+      while (!(--last, less(last, &pivot, context))) { \
+      } \
+    } \
+    *already_partitioned = first >= last; \
+    while (first < last) { \
+      name ## _swap(first, last); \
+      while ((++first, less(first, &pivot, context))) { \
+      } \
+      while (!(--last, less(last, &pivot, context))) { \
+      } \
+    } \
+    type * pivot_position = first - 1; \
+    *begin = *pivot_position; \
+    *pivot_position = pivot; \
+    return pivot_position; \
+  } \
+ \
+  /* Partition around the pivot at begin, putting the elements equal to it on its left. */ \
+  static inline type * name ## _partition_left(type * begin, type * end, const void * context) \
+  { \
+    (void)context; \
+    type pivot = *begin; \
+    type * first = begin; \
+    type * last = end; \
+    while ((--last, less(&pivot, last, context))) { \
+    } \
+    if (last + 1 == end) { \
+      while (first < last && !(++first, less(&pivot, first, context))) { \
+      } \
+    } else { \
+      while (!(++first, less(&pivot, first, context))) { \
+      } \
+    } \
+    while (first < last) { \
+      name ## _swap(first, last); \
+      while ((--last, less(&pivot, last, context))) { \
+      } \
+      while (!(++first, less(&pivot, first, context))) { \
+      } \
+    } \
+    *begin = *last; \
+    *last = pivot; \
+    return last; \
+  } \
+ \
+  /* Break patterns which caused an unbalanced partition by swapping elements around. */ \
+  static inline void name ## _shuffle(type * begin, type * end, size_t size) \
+  { \
+    if (size >= 24) { \
+      name ## _swap(begin, begin + size / 4); \
+      name ## _swap(end - 1, end - size / 4); \
+      if (size > 128) { \
+        name ## _swap(begin + 1, begin + (size / 4 + 1)); \
+        name ## _swap(begin + 2, begin + (size / 4 + 2)); \
+        name ## _swap(end - 2, end - (size / 4 + 1)); \
+        name ## _swap(end - 3, end - (size / 4 + 2)); \
+      } \
+    } \
+  } \
+ \
+  static inline void name ## _loop( \
+    type * begin, type * end, int bad_allowed, bool leftmost, const void * context) \
+  { \
+    for (;;) { \
+      size_t size = (size_t)(end - begin); \
+      if (size < 24) { \
+        name ## _insertion_sort(begin, end, leftmost, context); \
+        return; \
+      } \
+ \
+      size_t half = size / 2; \
+      if (size > 128) { \
+        name ## _sort3(begin, begin + half, end - 1, context); \
+        name ## _sort3(begin + 1, begin + (half - 1), end - 2, context); \
+        name ## _sort3(begin + 2, begin + (half + 1), end - 3, context); \
+        name ## _sort3(begin + (half - 1), begin + half, begin + (half + 1), context); \
+        name ## _swap(begin, begin + half); \
+      } else { \
+        name ## _sort3(begin + half, begin, end - 1, context); \
+      } \
+ \
+      /* Elements equal to the pivot of the left partition need no more sorting. */ \
+      if (!leftmost && !less(begin - 1, begin, context)) { \
+        begin = name ## _partition_left(begin, end, context) + 1; \
+        continue; \
+      } \
+ \
+      bool already_partitioned = false; \
+      type * pivot = name ## _partition_right(begin, end, &already_partitioned, context); \
+      size_t left_size = (size_t)(pivot - begin); \
+      size_t right_size = (size_t)(end - (pivot + 1)); \
+      if (left_size < size / 8 || right_size < size / 8) { \
+        if (--bad_allowed == 0) { \
+          name ## _heap_sort(begin, end, context); \
+          return; \
+        } \
+        name ## _shuffle(begin, pivot, left_size); \
+        name ## _shuffle(pivot + 1, end, right_size); \
+      } else if (already_partitioned && \
+        name ## _partial_insertion_sort(begin, pivot, context) && \
+        name ## _partial_insertion_sort(pivot + 1, end, context)) \
+      { \
+        return; \
+      } \
+ \
+      name ## _loop(begin, pivot, bad_allowed, leftmost, context); \
+      begin = pivot + 1; \
+      leftmost = false; \
+    } \
+  } \
+ \
+  static inline void name(type * array, size_t count, const void * context) \
+  { \
+    if (count < 2) { \
+      return; \
+    } \
+    int log2_count = 0; \
+    for (size_t n = count; n > 1; n >>= 1) { \
+      ++log2_count; \
+    } \
+    name ## _loop(array, array + count, log2_count, true, context); \
+  }
+
+#endif  // RCUTILS__SORT_H_
@@ -22,7 +22,11 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "rcutils/allocator.h"
+#include "rcutils/macros.h"
 #include "rcutils/types.h"
 #include "rcutils/visibility_control.h"
 
@@ -45,6 +49,30 @@ rcutils_split(
   rcutils_allocator_t allocator,
   rcutils_string_array_t * string_array);
 
+/// Split a given string with the specified delimiter into a packed string array
+/**
+ * This function splits the string like rcutils_split(), but the tokens are stored back to
+ * back in the arena of a packed string array, see rcutils_string_array_init_packed(), so
+ * splitting a string takes two allocations, whatever the number of tokens.
+ * The tokens must not be deallocated one by one, but only by finalizing the string array.
+ *
+ * \param[in] str string to split
+ * \param[in] delimiter on where to split
+ * \param[in] allocator for allocating new memory for the output array
+ * \param[out] string_array with the split tokens
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_split_packed(
+  const char * str,
+  char delimiter,
+  rcutils_allocator_t allocator,
+  rcutils_string_array_t * string_array);
+
 /// Split a given string on the last occurrence of the specified delimiter
 /**
  * \param[in] str string to split
@@ -62,6 +90,105 @@ rcutils_split_last(
   rcutils_allocator_t allocator,
   rcutils_string_array_t * string_array);
 
+/// A token of a split string, which is a view into the string rather than a copy of it.
+/**
+ * The token is not null terminated, and is only valid as long as the string it is a part of.
+ * Tokens can be copied into a string array with rcutils_string_array_init_from_views().
+ */
+typedef rcutils_string_view_t rcutils_split_token_t;
+
+/// An iterator over the tokens of a string split with a delimiter, without allocating.
+/**
+ * It yields the same tokens as rcutils_split(), as views into the string.
+ * Example:
+ * ```c
+ * rcutils_split_iterator_t iterator = rcutils_get_split_iterator("/ns/node", '/');
+ * rcutils_split_token_t token;
+ * while (rcutils_split_iterator_next(&iterator, &token)) {
+ *   printf("%.*s\n", (int)token.length, token.data);
+ * }
+ * ```
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_split_iterator_s
+{
+  /// The rest of the string to split, or NULL once there are no more tokens.
+  const char * rest;
+
+  /// The delimiter to split the string on.
+  char delimiter;
+} rcutils_split_iterator_t;
+
+/// Return an iterator over the tokens of the given string.
+/**
+ * The string must outlive the iterator and the tokens it yields.
+ *
+ * \param[in] str string to split, or NULL for no tokens
+ * \param[in] delimiter on where to split
+ * \return the iterator, positioned before the first token.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_split_iterator_t
+rcutils_get_split_iterator(const char * str, char delimiter);
+
+/// Get the next token of a split string.
+/**
+ * Like rcutils_split(), empty tokens, between consecutive delimiters or at either end of
+ * the string, are skipped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] iterator the iterator over the tokens of the string
+ * \param[out] token the next token, if there is one
+ * \return `true` if there was a token, or
+ * \return `false` if there are no more tokens or if any argument is NULL.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_split_iterator_next(rcutils_split_iterator_t * iterator, rcutils_split_token_t * token);
+
+/// Split a given string with the specified delimiter into tokens provided by the caller
+/**
+ * This function splits the string like rcutils_split(), but stores views into the string
+ * in the given array instead of copies of the tokens, without allocating.
+ * If the array is too small, it is filled with the first tokens, and the number of tokens
+ * of the string is returned anyway, so that the array can be sized from a first call with a
+ * capacity of 0.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] str string to split, or NULL for no tokens
+ * \param[in] delimiter on where to split
+ * \param[out] tokens array of at least `capacity` tokens, which may be NULL if it is 0
+ * \param[in] capacity the number of tokens the array can hold
+ * \param[out] count the number of tokens of the string
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_ENOUGH_SPACE if the string has more than `capacity` tokens.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_split_tokens(
+  const char * str,
+  char delimiter,
+  rcutils_split_token_t * tokens,
+  size_t capacity,
+  size_t * count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -66,6 +66,37 @@
 
 #define rcutils_atomic_fetch_add(object, out, arg) (out) = atomic_fetch_add(object, arg)
 
+#define rcutils_atomic_fetch_sub(object, out, arg) (out) = atomic_fetch_sub(object, arg)
+
+#define rcutils_atomic_fetch_or(object, out, arg) (out) = atomic_fetch_or(object, arg)
+
+#define rcutils_atomic_fetch_and(object, out, arg) (out) = atomic_fetch_and(object, arg)
+
+#define rcutils_atomic_load_explicit(object, out, order) \
+  (out) = atomic_load_explicit(object, order)
+
+#define rcutils_atomic_compare_exchange_strong_explicit( \
+    object, out, expected, desired, success, failure) \
+  (out) = atomic_compare_exchange_strong_explicit(object, expected, desired, success, failure)
+
+#define rcutils_atomic_exchange_explicit(object, out, desired, order) \
+  (out) = atomic_exchange_explicit(object, desired, order)
+
+#define rcutils_atomic_store_explicit(object, desired, order) \
+  atomic_store_explicit(object, desired, order)
+
+#define rcutils_atomic_fetch_add_explicit(object, out, arg, order) \
+  (out) = atomic_fetch_add_explicit(object, arg, order)
+
+#define rcutils_atomic_fetch_sub_explicit(object, out, arg, order) \
+  (out) = atomic_fetch_sub_explicit(object, arg, order)
+
+#define rcutils_atomic_fetch_or_explicit(object, out, arg, order) \
+  (out) = atomic_fetch_or_explicit(object, arg, order)
+
+#define rcutils_atomic_fetch_and_explicit(object, out, arg, order) \
+  (out) = atomic_fetch_and_explicit(object, arg, order)
+
 #else  // !defined(_WIN32)
 
 #include "./stdatomic_helper/win32/stdatomic.h"
@@ -82,6 +113,38 @@
 
 #define rcutils_atomic_fetch_add(object, out, arg) rcutils_win32_atomic_fetch_add(object, out, arg)
 
+#define rcutils_atomic_fetch_sub(object, out, arg) rcutils_win32_atomic_fetch_sub(object, out, arg)
+
+#define rcutils_atomic_fetch_or(object, out, arg) rcutils_win32_atomic_fetch_or(object, out, arg)
+
+#define rcutils_atomic_fetch_and(object, out, arg) rcutils_win32_atomic_fetch_and(object, out, arg)
+
+#define rcutils_atomic_load_explicit(object, out, order) \
+  rcutils_win32_atomic_load_explicit(object, out, order)
+
+#define rcutils_atomic_compare_exchange_strong_explicit( \
+    object, out, expected, desired, success, failure) \
+  rcutils_win32_atomic_compare_exchange_strong_explicit( \
+    object, out, expected, desired, success, failure)
+
+#define rcutils_atomic_exchange_explicit(object, out, desired, order) \
+  rcutils_win32_atomic_exchange_explicit(object, out, desired, order)
+
+#define rcutils_atomic_store_explicit(object, desired, order) \
+  rcutils_win32_atomic_store_explicit(object, desired, order)
+
+#define rcutils_atomic_fetch_add_explicit(object, out, arg, order) \
+  rcutils_win32_atomic_fetch_add_explicit(object, out, arg, order)
+
+#define rcutils_atomic_fetch_sub_explicit(object, out, arg, order) \
+  rcutils_win32_atomic_fetch_sub_explicit(object, out, arg, order)
+
+#define rcutils_atomic_fetch_or_explicit(object, out, arg, order) \
+  rcutils_win32_atomic_fetch_or_explicit(object, out, arg, order)
+
+#define rcutils_atomic_fetch_and_explicit(object, out, arg, order) \
+  rcutils_win32_atomic_fetch_and_explicit(object, out, arg, order)
+
 #endif  // !defined(_WIN32)
 
 static inline bool
@@ -173,6 +236,159 @@ rcutils_atomic_fetch_add_uint64_t(atomic_uint_least64_t * a_uint64_t, uint64_t a
   return result;
 }
 
+static inline uint64_t
+rcutils_atomic_fetch_sub_uint64_t(atomic_uint_least64_t * a_uint64_t, uint64_t arg)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_sub(a_uint64_t, result, arg);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_fetch_or_uint64_t(atomic_uint_least64_t * a_uint64_t, uint64_t arg)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_or(a_uint64_t, result, arg);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_fetch_and_uint64_t(atomic_uint_least64_t * a_uint64_t, uint64_t arg)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_and(a_uint64_t, result, arg);
+  return result;
+}
+
+// The _explicit variants take the memory order the operation needs, like their C11
+// counterparts, so that e.g. statistics counters can be relaxed and queues can publish
+// with release and consume with acquire, instead of paying for full barriers on weakly
+// ordered architectures such as ARM.
+// The orders are only hints where the backend has nothing weaker than sequential
+// consistency, e.g. for read-modify-write operations on x86 and x64.
+
+static inline bool
+rcutils_atomic_load_bool_explicit(atomic_bool * a_bool, memory_order order)
+{
+  bool result = false;
+  rcutils_atomic_load_explicit(a_bool, result, order);
+  return result;
+}
+
+static inline int64_t
+rcutils_atomic_load_int64_t_explicit(atomic_int_least64_t * a_int64_t, memory_order order)
+{
+  int64_t result = 0;
+  rcutils_atomic_load_explicit(a_int64_t, result, order);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_load_uint64_t_explicit(atomic_uint_least64_t * a_uint64_t, memory_order order)
+{
+  uint64_t result = 0;
+  rcutils_atomic_load_explicit(a_uint64_t, result, order);
+  return result;
+}
+
+static inline uintptr_t
+rcutils_atomic_load_uintptr_t_explicit(atomic_uintptr_t * a_uintptr_t, memory_order order)
+{
+  uintptr_t result = 0;
+  rcutils_atomic_load_explicit(a_uintptr_t, result, order);
+  return result;
+}
+
+static inline bool
+rcutils_atomic_compare_exchange_strong_uint_least64_t_explicit(
+  atomic_uint_least64_t * a_uint_least64_t, uint64_t * expected, uint64_t desired,
+  memory_order success, memory_order failure)
+{
+  bool result;
+#if defined(__clang__)
+# pragma clang diagnostic push
+  // we know it's a gnu feature, but clang supports it, so suppress pedantic warning
+# pragma clang diagnostic ignored "-Wgnu-statement-expression"
+#endif
+  rcutils_atomic_compare_exchange_strong_explicit(
+    a_uint_least64_t, result, expected, desired, success, failure);
+#if defined(__clang__)
+# pragma clang diagnostic pop
+#endif
+  return result;
+}
+
+static inline bool
+rcutils_atomic_exchange_bool_explicit(atomic_bool * a_bool, bool desired, memory_order order)
+{
+  bool result;
+  rcutils_atomic_exchange_explicit(a_bool, result, desired, order);
+  return result;
+}
+
+static inline int64_t
+rcutils_atomic_exchange_int64_t_explicit(
+  atomic_int_least64_t * a_int64_t, int64_t desired, memory_order order)
+{
+  int64_t result;
+  rcutils_atomic_exchange_explicit(a_int64_t, result, desired, order);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_exchange_uint64_t_explicit(
+  atomic_uint_least64_t * a_uint64_t, uint64_t desired, memory_order order)
+{
+  uint64_t result;
+  rcutils_atomic_exchange_explicit(a_uint64_t, result, desired, order);
+  return result;
+}
+
+static inline uintptr_t
+rcutils_atomic_exchange_uintptr_t_explicit(
+  atomic_uintptr_t * a_uintptr_t, uintptr_t desired, memory_order order)
+{
+  uintptr_t result;
+  rcutils_atomic_exchange_explicit(a_uintptr_t, result, desired, order);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_fetch_add_uint64_t_explicit(
+  atomic_uint_least64_t * a_uint64_t, uint64_t arg, memory_order order)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_add_explicit(a_uint64_t, result, arg, order);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_fetch_sub_uint64_t_explicit(
+  atomic_uint_least64_t * a_uint64_t, uint64_t arg, memory_order order)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_sub_explicit(a_uint64_t, result, arg, order);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_fetch_or_uint64_t_explicit(
+  atomic_uint_least64_t * a_uint64_t, uint64_t arg, memory_order order)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_or_explicit(a_uint64_t, result, arg, order);
+  return result;
+}
+
+static inline uint64_t
+rcutils_atomic_fetch_and_uint64_t_explicit(
+  atomic_uint_least64_t * a_uint64_t, uint64_t arg, memory_order order)
+{
+  uint64_t result;
+  rcutils_atomic_fetch_and_explicit(a_uint64_t, result, arg, order);
+  return result;
+}
+
 #if !defined(_WIN32)
 # pragma GCC diagnostic pop
 #endif
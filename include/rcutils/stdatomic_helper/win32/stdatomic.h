@@ -414,6 +414,222 @@ typedef _Atomic (uintmax_t) atomic_uintmax_t;
   } while (0); \
   __pragma(warning(pop))
 
+/*
+ * Operations with explicit memory orders.
+ *
+ * The locked instructions of x86 and x64 are full barriers, so their read-modify-write
+ * operations are the sequentially consistent ones above, whatever the order.
+ * ARM has intrinsics without barriers (_nf), with acquire (_acq) and with release (_rel)
+ * semantics, which are picked from the order.
+ * Loads and stores which aren't sequentially consistent are plain accesses, with a barrier
+ * after acquiring loads and before releasing stores, which only needs to be a compiler
+ * barrier on x86 and x64.
+ */
+
+#if defined(_M_ARM) || defined(_M_ARM64)
+
+#if defined(_M_ARM64)
+#define RCUTILS_WIN32_ATOMIC_MEMORY_BARRIER() __dmb(_ARM64_BARRIER_ISH)
+#else
+#define RCUTILS_WIN32_ATOMIC_MEMORY_BARRIER() __dmb(_ARM_BARRIER_ISH)
+#endif
+
+#define RCUTILS_WIN32_ATOMIC_ORDERED(intrinsic, order, ...) \
+  ((order) == memory_order_relaxed ? intrinsic ## _nf(__VA_ARGS__) : \
+  ((order) == memory_order_consume || (order) == memory_order_acquire) ? \
+  intrinsic ## _acq(__VA_ARGS__) : \
+  (order) == memory_order_release ? intrinsic ## _rel(__VA_ARGS__) : intrinsic(__VA_ARGS__))
+
+#define RCUTILS_WIN32_ATOMIC_ORDERED_OPERATION(intrinsic, object, out, operand, order) \
+  __pragma(warning(push)) \
+  __pragma(warning(disable: 4244)) \
+  __pragma(warning(disable: 4047)) \
+  __pragma(warning(disable: 4024)) \
+  do { \
+    switch (sizeof(out)) { \
+      case sizeof(uint64_t): \
+        out = RCUTILS_WIN32_ATOMIC_ORDERED(intrinsic ## 64, order, (LONGLONG *) object, operand); \
+        break; \
+      case sizeof(uint32_t): \
+        out = RCUTILS_WIN32_ATOMIC_ORDERED(intrinsic, order, (LONG *) object, operand); \
+        break; \
+      case sizeof(uint16_t): \
+        out = RCUTILS_WIN32_ATOMIC_ORDERED(intrinsic ## 16, order, (SHORT *) object, operand); \
+        break; \
+      case sizeof(uint8_t): \
+        out = RCUTILS_WIN32_ATOMIC_ORDERED(intrinsic ## 8, order, (char *) object, operand); \
+        break; \
+      default: \
+        RCUTILS_LOG_ERROR_NAMED( \
+          _RCUTILS_PACKAGE_NAME, "Unsupported integer type in " #intrinsic); \
+        exit(-1); \
+        break; \
+    } \
+  } while (0); \
+  __pragma(warning(pop))
+
+#define rcutils_win32_atomic_exchange_explicit(object, out, desired, order) \
+  RCUTILS_WIN32_ATOMIC_ORDERED_OPERATION(_InterlockedExchange, object, out, desired, order)
+
+#define rcutils_win32_atomic_fetch_add_explicit(object, out, operand, order) \
+  RCUTILS_WIN32_ATOMIC_ORDERED_OPERATION(_InterlockedExchangeAdd, object, out, operand, order)
+
+#define rcutils_win32_atomic_fetch_and_explicit(object, out, operand, order) \
+  RCUTILS_WIN32_ATOMIC_ORDERED_OPERATION(_InterlockedAnd, object, out, operand, order)
+
+#define rcutils_win32_atomic_fetch_or_explicit(object, out, operand, order) \
+  RCUTILS_WIN32_ATOMIC_ORDERED_OPERATION(_InterlockedOr, object, out, operand, order)
+
+#else  // defined(_M_ARM) || defined(_M_ARM64)
+
+#define RCUTILS_WIN32_ATOMIC_MEMORY_BARRIER() _ReadWriteBarrier()
+
+#define RCUTILS_WIN32_ATOMIC_ORDERED(intrinsic, order, ...) ((void)(order), intrinsic(__VA_ARGS__))
+
+#define rcutils_win32_atomic_exchange_explicit(object, out, desired, order) \
+  rcutils_win32_atomic_exchange(object, out, desired)
+
+#define rcutils_win32_atomic_fetch_add_explicit(object, out, operand, order) \
+  rcutils_win32_atomic_fetch_add(object, out, operand)
+
+#define rcutils_win32_atomic_fetch_and_explicit(object, out, operand, order) \
+  rcutils_win32_atomic_fetch_and(object, out, operand)
+
+#define rcutils_win32_atomic_fetch_or_explicit(object, out, operand, order) \
+  rcutils_win32_atomic_fetch_or(object, out, operand)
+
+#endif  // defined(_M_ARM) || defined(_M_ARM64)
+
+#define rcutils_win32_atomic_fetch_sub_explicit(object, out, operand, order) \
+  rcutils_win32_atomic_fetch_add_explicit(object, out, -(operand), order)
+
+// Unlike rcutils_win32_atomic_compare_exchange_strong(), out is whether the exchange was
+// made, and expected is updated to the current value otherwise, as in C11.
+#define rcutils_win32_atomic_compare_exchange_strong_explicit( \
+    object, out, expected, desired, success, failure) \
+  __pragma(warning(push)) \
+  __pragma(warning(disable: 4244)) \
+  __pragma(warning(disable: 4047)) \
+  __pragma(warning(disable: 4024)) \
+  __pragma(warning(disable: 4302)) \
+  __pragma(warning(disable: 4311)) \
+  do { \
+    (void)(failure); \
+    switch (sizeof(*(expected))) { \
+      case sizeof(uint64_t): { \
+          LONGLONG previous = RCUTILS_WIN32_ATOMIC_ORDERED( \
+            _InterlockedCompareExchange64, success, \
+            (LONGLONG *) object, (LONGLONG) (desired), (LONGLONG) *(expected)); \
+          out = previous == (LONGLONG) *(expected); \
+          *(expected) = previous; \
+        } \
+        break; \
+      case sizeof(uint32_t): { \
+          LONG previous = RCUTILS_WIN32_ATOMIC_ORDERED( \
+            _InterlockedCompareExchange, success, \
+            (LONG *) object, (LONG) (desired), (LONG) *(expected)); \
+          out = previous == (LONG) *(expected); \
+          *(expected) = previous; \
+        } \
+        break; \
+      case sizeof(uint16_t): { \
+          SHORT previous = RCUTILS_WIN32_ATOMIC_ORDERED( \
+            _InterlockedCompareExchange16, success, \
+            (SHORT *) object, (SHORT) (desired), (SHORT) *(expected)); \
+          out = previous == (SHORT) *(expected); \
+          *(expected) = previous; \
+        } \
+        break; \
+      case sizeof(uint8_t): { \
+          char previous = RCUTILS_WIN32_ATOMIC_ORDERED( \
+            _InterlockedCompareExchange8, success, \
+            (char *) object, (char) (desired), (char) *(expected)); \
+          out = previous == (char) *(expected); \
+          *(expected) = previous; \
+        } \
+        break; \
+      default: \
+        RCUTILS_LOG_ERROR_NAMED( \
+          _RCUTILS_PACKAGE_NAME, \
+          "Unsupported integer type in atomic_compare_exchange_strong_explicit"); \
+        exit(-1); \
+        break; \
+    } \
+  } while (0); \
+  __pragma(warning(pop))
+
+#define rcutils_win32_atomic_load_explicit(object, out, order) \
+  __pragma(warning(push)) \
+  __pragma(warning(disable: 4244)) \
+  __pragma(warning(disable: 4047)) \
+  __pragma(warning(disable: 4024)) \
+  do { \
+    if (memory_order_seq_cst == (order)) { \
+      rcutils_win32_atomic_load(object, out); \
+      break; \
+    } \
+    switch (sizeof(out)) { \
+      case sizeof(uint64_t): \
+        out = __iso_volatile_load64((const volatile __int64 *) object); \
+        break; \
+      case sizeof(uint32_t): \
+        out = __iso_volatile_load32((const volatile __int32 *) object); \
+        break; \
+      case sizeof(uint16_t): \
+        out = __iso_volatile_load16((const volatile __int16 *) object); \
+        break; \
+      case sizeof(uint8_t): \
+        out = __iso_volatile_load8((const volatile __int8 *) object); \
+        break; \
+      default: \
+        RCUTILS_LOG_ERROR_NAMED( \
+          _RCUTILS_PACKAGE_NAME, "Unsupported integer type in atomic_load_explicit"); \
+        exit(-1); \
+        break; \
+    } \
+    if (memory_order_relaxed != (order)) { \
+      RCUTILS_WIN32_ATOMIC_MEMORY_BARRIER(); \
+    } \
+  } while (0); \
+  __pragma(warning(pop))
+
+#define rcutils_win32_atomic_store_explicit(object, desired, order) \
+  __pragma(warning(push)) \
+  __pragma(warning(disable: 4244)) \
+  __pragma(warning(disable: 4047)) \
+  __pragma(warning(disable: 4024)) \
+  __pragma(warning(disable: 4302)) \
+  __pragma(warning(disable: 4311)) \
+  do { \
+    if (memory_order_seq_cst == (order)) { \
+      rcutils_win32_atomic_store(object, desired); \
+      break; \
+    } \
+    if (memory_order_relaxed != (order)) { \
+      RCUTILS_WIN32_ATOMIC_MEMORY_BARRIER(); \
+    } \
+    switch (sizeof((object)->__val)) { \
+      case sizeof(uint64_t): \
+        __iso_volatile_store64((volatile __int64 *) object, (__int64) (desired)); \
+        break; \
+      case sizeof(uint32_t): \
+        __iso_volatile_store32((volatile __int32 *) object, (__int32) (desired)); \
+        break; \
+      case sizeof(uint16_t): \
+        __iso_volatile_store16((volatile __int16 *) object, (__int16) (desired)); \
+        break; \
+      case sizeof(uint8_t): \
+        __iso_volatile_store8((volatile __int8 *) object, (__int8) (desired)); \
+        break; \
+      default: \
+        RCUTILS_LOG_ERROR_NAMED( \
+          _RCUTILS_PACKAGE_NAME, "Unsupported integer type in atomic_store_explicit"); \
+        exit(-1); \
+        break; \
+    } \
+  } while (0); \
+  __pragma(warning(pop))
+
 // *INDENT-ON*
 
 #define rcutils_win32_atomic_store(object, desired) \
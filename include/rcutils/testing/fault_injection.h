@@ -35,6 +35,39 @@ RCUTILS_WARN_UNUSED
 bool
 rcutils_fault_injection_is_test_complete(void);
 
+/// Whether the fault injection counter was last set to a non-negative count.
+/**
+ * The fault injection macros check this flag before calling
+ * _rcutils_fault_injection_maybe_fail(), so that the hooks only cost a relaxed load and a
+ * predictable branch while fault injection isn't armed, e.g. in soak tests of builds with
+ * fault injection enabled.
+ * It is set by rcutils_fault_injection_set_count(), which must not be called by several
+ * threads at once for the flag to match the counter, and must only be read with
+ * RCUTILS_FAULT_INJECTION_ATOMIC_LOAD_RELAXED_UINT32().
+ */
+RCUTILS_PUBLIC
+extern uint32_t g_rcutils_fault_injection_armed;
+
+/**
+ * \def RCUTILS_FAULT_INJECTION_ATOMIC_LOAD_RELAXED_UINT32
+ * \brief Load a `uint32_t` atomically without ordering, usable from both C and C++.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+# define RCUTILS_FAULT_INJECTION_ATOMIC_LOAD_RELAXED_UINT32(ptr) \
+  (*(volatile const uint32_t *)(ptr))
+#else
+# define RCUTILS_FAULT_INJECTION_ATOMIC_LOAD_RELAXED_UINT32(ptr) \
+  __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#endif
+
+/**
+ * \def RCUTILS_FAULT_INJECTION_IS_ARMED
+ * \brief Whether fault injection may currently fail, i.e. #g_rcutils_fault_injection_armed.
+ */
+#define RCUTILS_FAULT_INJECTION_IS_ARMED() \
+  RCUTILS_UNLIKELY( \
+    0u != RCUTILS_FAULT_INJECTION_ATOMIC_LOAD_RELAXED_UINT32(&g_rcutils_fault_injection_armed))
+
 /**
  * \brief Atomically set the fault injection counter.
  *
@@ -97,14 +130,23 @@ _rcutils_fault_injection_maybe_fail(void);
  * This macro is thread-safe, and ensures that at most one invocation results in a failure for each
  * time the fault injection counter is set with `RCUTILS_FAULT_INJECTION_SET_COUNT`
  *
+ * While the counter is negative, this only loads #g_rcutils_fault_injection_armed.
+ * If `RCUTILS_DISABLE_FAULT_INJECTION` is defined, this expands to nothing.
+ *
  * \param return_value_on_error the value to return in the case of fault injected failure.
  */
-#define RCUTILS_FAULT_INJECTION_MAYBE_RETURN_ERROR(return_value_on_error) \
-  if (RCUTILS_FAULT_INJECTION_FAIL_NOW == _rcutils_fault_injection_maybe_fail()) { \
+#ifdef RCUTILS_DISABLE_FAULT_INJECTION
+# define RCUTILS_FAULT_INJECTION_MAYBE_RETURN_ERROR(return_value_on_error)
+#else
+# define RCUTILS_FAULT_INJECTION_MAYBE_RETURN_ERROR(return_value_on_error) \
+  if (RCUTILS_FAULT_INJECTION_IS_ARMED() && \
+    RCUTILS_FAULT_INJECTION_FAIL_NOW == _rcutils_fault_injection_maybe_fail()) \
+  { \
     printf( \
       "%s:%d Injecting fault and returning " #return_value_on_error "\n", __FILE__, __LINE__); \
     return return_value_on_error; \
   }
+#endif
 
 /**
  * \def RCUTILS_FAULT_INJECTION_MAYBE_FAIL
@@ -121,14 +163,23 @@ _rcutils_fault_injection_maybe_fail(void);
  * This macro is thread-safe, and ensures that at most one invocation results in a failure for each
  * time the fault injection counter is set with `RCUTILS_FAULT_INJECTION_SET_COUNT`
  *
+ * While the counter is negative, this only loads #g_rcutils_fault_injection_armed.
+ * If `RCUTILS_DISABLE_FAULT_INJECTION` is defined, this expands to nothing.
+ *
  * \param failure_code the code to execute in the case of fault injected failure.
  */
-#define RCUTILS_FAULT_INJECTION_MAYBE_FAIL(failure_code) \
-  if (RCUTILS_FAULT_INJECTION_FAIL_NOW == _rcutils_fault_injection_maybe_fail()) { \
+#ifdef RCUTILS_DISABLE_FAULT_INJECTION
+# define RCUTILS_FAULT_INJECTION_MAYBE_FAIL(failure_code)
+#else
+# define RCUTILS_FAULT_INJECTION_MAYBE_FAIL(failure_code) \
+  if (RCUTILS_FAULT_INJECTION_IS_ARMED() && \
+    RCUTILS_FAULT_INJECTION_FAIL_NOW == _rcutils_fault_injection_maybe_fail()) \
+  { \
     printf( \
       "%s:%d Injecting fault and executing " #failure_code "\n", __FILE__, __LINE__); \
     failure_code; \
   }
+#endif
 
 /**
  * \def RCUTILS_FAULT_INJECTION_TEST
@@ -0,0 +1,221 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__THREAD_POOL_H_
+#define RCUTILS__THREAD_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/process.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// The options of a thread pool.
+typedef struct rcutils_thread_pool_options_s
+{
+  /// The number of worker threads, or 0 for the number of processors.
+  size_t thread_count;
+  /// The CPUs and scheduling of the worker threads.
+  rcutils_thread_attributes_t thread_attributes;
+  /// Whether each worker thread is pinned to a single CPU of `thread_attributes.cpu_set`.
+  /**
+   * The workers are given the CPUs of the set in turn, in increasing order, and wrap around
+   * if there are more workers than CPUs.
+   * The set must not be empty then.
+   */
+  bool pin_threads;
+} rcutils_thread_pool_options_t;
+
+/// The signature of the functions run as tasks by a thread pool.
+typedef void (* rcutils_thread_pool_task_function_t)(void * arg);
+
+struct rcutils_thread_pool_impl_s;
+
+/// A pool of worker threads running tasks, for the work rcutils and its users split up.
+/**
+ * Each worker has a queue of tasks, which it runs the most recent task of first, and which
+ * the other workers steal the oldest tasks of once their own queue is empty.
+ * Tasks submitted by a task go to the queue of the worker running it, where they are likely
+ * to find the data of the task still in the cache of its CPU, and the other tasks are spread
+ * over the queues in turn.
+ * The queues are arrays allocated with the allocator of the pool, which only grow when more
+ * tasks are queued than ever before, so that submitting a task doesn't allocate otherwise.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_thread_pool_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_thread_pool_impl_s * impl;
+} rcutils_thread_pool_t;
+
+/// Return the default options of a thread pool.
+/**
+ * The defaults are one thread per processor, with the attributes threads inherit and without
+ * pinning them.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_thread_pool_options_t
+rcutils_thread_pool_get_default_options(void);
+
+/// Return an empty thread pool struct.
+/**
+ * This function returns an empty and zero initialized thread pool struct,
+ * which must be initialized with rcutils_thread_pool_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_thread_pool_t
+rcutils_get_zero_initialized_thread_pool(void);
+
+/// Initialize a thread pool and start its worker threads.
+/**
+ * If any of the threads can't be started, with its attributes or at all, those started so
+ * far are stopped and the pool isn't initialized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] thread_pool zero initialized thread pool to be initialized
+ * \param[in] options the options of the thread pool, or NULL for the defaults
+ * \param[in] allocator the allocator to use for the thread pool and its task queues, which
+ *   must be thread-safe
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if a thread can't be started, or an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_pool_init(
+  rcutils_thread_pool_t * thread_pool,
+  const rcutils_thread_pool_options_t * options,
+  const rcutils_allocator_t * allocator);
+
+/// Run the tasks left, stop the worker threads and finalize the thread pool.
+/**
+ * The tasks queued when this is called, and those they submit, are all run before the
+ * workers stop.
+ * No other thread may use the pool while, nor after, it is finalized, and it must not be
+ * finalized by one of its tasks.
+ * Finalizing a zero initialized thread pool does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] thread_pool the thread pool to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_pool_fini(rcutils_thread_pool_t * thread_pool);
+
+/// Submit a task, to be run as `function(arg)` by one of the worker threads.
+/**
+ * Tasks may be submitted by any thread, including by the tasks of the pool.
+ * They are run in no particular order, and `arg` must stay valid until the task ran.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, when a task queue grows
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] thread_pool the initialized thread pool
+ * \param[in] function the function to run
+ * \param[in] arg the argument of the function
+ * \return #RCUTILS_RET_OK if the task was submitted, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the thread pool is invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_pool_submit(
+  rcutils_thread_pool_t * thread_pool,
+  rcutils_thread_pool_task_function_t function,
+  void * arg);
+
+/// Wait until all the submitted tasks ran, running queued tasks in the calling thread meanwhile.
+/**
+ * The tasks submitted while waiting, e.g. by other tasks, are waited for too.
+ * Since the calling thread takes part, work split into tasks and waited for this way is done
+ * even by a pool whose workers are all busy with something else.
+ * This must not be called by one of the tasks of the pool, which would wait for itself, and
+ * fails if that is detected.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] thread_pool the initialized thread pool
+ * \return #RCUTILS_RET_OK once all the tasks ran, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the thread pool is invalid, or
+ * \return #RCUTILS_RET_ERROR if called by a task of the pool.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_pool_wait(rcutils_thread_pool_t * thread_pool);
+
+/// Get the number of worker threads of a thread pool.
+/**
+ * \param[in] thread_pool the initialized thread pool
+ * \param[out] thread_count the number of worker threads
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the thread pool is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_thread_pool_get_thread_count(
+  const rcutils_thread_pool_t * thread_pool, size_t * thread_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__THREAD_POOL_H_
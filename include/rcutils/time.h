@@ -22,6 +22,7 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "rcutils/macros.h"
@@ -43,6 +44,8 @@ extern "C"
 #define RCUTILS_NS_TO_US(nanoseconds) ((nanoseconds) / 1000LL)
 /// Convenience macro for rcutils_steady_time_now(rcutils_time_point_value_t *).
 #define RCUTILS_STEADY_TIME rcutils_steady_time_now
+/// Convenience macro for rcutils_steady_time_now_coarse(rcutils_time_point_value_t *).
+#define RCUTILS_STEADY_TIME_COARSE rcutils_steady_time_now_coarse
 
 /// A single point in time, measured in nanoseconds since the Unix epoch.
 typedef int64_t rcutils_time_point_value_t;
@@ -76,6 +79,33 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_system_time_now(rcutils_time_point_value_t * now);
 
+/// Retrieve the current time from a cheap, coarse system clock.
+/**
+ * Where the operating system provides one (`CLOCK_REALTIME_COARSE` on Linux,
+ * `CLOCK_REALTIME_FAST` on FreeBSD, `GetSystemTimeAsFileTime()` on Windows),
+ * this reads a system clock which is only updated every few milliseconds but
+ * costs much less to read than rcutils_system_time_now(), which makes it a
+ * good fit for timestamping frequent events, e.g. log messages.
+ * Elsewhere it is the same as rcutils_system_time_now().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] now a datafield in which the current time is stored
+ * \return #RCUTILS_RET_OK if the current time was successfully obtained, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCUTILS_RET_ERROR if an unspecified error occur.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_system_time_now_coarse(rcutils_time_point_value_t * now);
+
 /// Retrieve the current time as a rcutils_time_point_value_t object.
 /**
  * This function returns the time from a monotonically increasing clock.
@@ -83,6 +113,10 @@ rcutils_system_time_now(rcutils_time_point_value_t * now);
  *
  * The resolution (e.g. nanoseconds vs microseconds) is not guaranteed.
  *
+ * On Windows, this reads `QueryPerformanceCounter()`, whose frequency is only
+ * queried once, and converts it to nanoseconds with a multiplication and a
+ * shift instead of divisions.
+ *
  * The now argument must point to an allocated rcutils_time_point_value_t object,
  * as the result is copied into this variable.
  *
@@ -91,7 +125,7 @@ rcutils_system_time_now(rcutils_time_point_value_t * now);
  * ------------------ | -------------
  * Allocates Memory   | No
  * Thread-Safe        | Yes
- * Uses Atomics       | No
+ * Uses Atomics       | Yes, on Windows
  * Lock-Free          | Yes
  *
  * \param[out] now a struct in which the current time is stored
@@ -104,6 +138,171 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_steady_time_now(rcutils_time_point_value_t * now);
 
+/// Retrieve the current time from a cheap, coarse, monotonically increasing clock.
+/**
+ * Where the operating system provides one (`CLOCK_MONOTONIC_COARSE` on Linux,
+ * `CLOCK_MONOTONIC_RAW_APPROX` on macOS, `CLOCK_MONOTONIC_FAST` on FreeBSD,
+ * `GetTickCount64()` on Windows), this reads a clock which is only updated
+ * every few milliseconds but costs much less to read than
+ * rcutils_steady_time_now(), which makes it a good fit for throttling frequent
+ * events, e.g. with the `_THROTTLE` logging macros.
+ * Elsewhere it is the same as rcutils_steady_time_now().
+ *
+ * Time points of this clock are not guaranteed to be comparable with those of
+ * rcutils_steady_time_now().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] now a struct in which the current time is stored
+ * \return #RCUTILS_RET_OK if the current time was successfully obtained, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCUTILS_RET_ERROR if an unspecified error occur.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_steady_time_now_coarse(rcutils_time_point_value_t * now);
+
+/// Calibrate the fast steady clock read by rcutils_steady_time_now_fast().
+/**
+ * Where the CPU has a counter which ticks at a constant rate on all its cores, i.e. the
+ * invariant TSC on x86, or `CNTVCT_EL0` on 64-bit ARM, the rate of the counter is measured
+ * against rcutils_steady_time_now() for about 10 milliseconds, during which this function
+ * keeps the calling thread busy.
+ * Only the first call calibrates the clock, and other threads calling this function meanwhile
+ * wait for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \return #RCUTILS_RET_OK if the clock was calibrated, or couldn't be because the counter is
+ *   missing or unreliable, in which case the fast clock is the same as
+ *   rcutils_steady_time_now(), or
+ * \return #RCUTILS_RET_ERROR if the steady clock couldn't be read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_steady_time_fast_init(void);
+
+/// Return whether the fast steady clock reads a CPU counter which can be trusted.
+/**
+ * This is the case once rcutils_steady_time_fast_init() calibrated the counter, which requires
+ * on x86 that the CPU reports an invariant TSC, and on Linux that the kernel itself uses the
+ * TSC as its clock source, as it stops doing so when it finds the TSC unsynchronized between
+ * cores or sockets.
+ *
+ * \return `true` if rcutils_steady_time_now_fast() reads a CPU counter, or
+ * \return `false` if it calls rcutils_steady_time_now().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_steady_time_fast_is_reliable(void);
+
+/// Retrieve the current time from a steady clock reading a CPU counter.
+/**
+ * Once calibrated with rcutils_steady_time_fast_init(), this reads the counter and scales it
+ * to nanoseconds without entering the kernel nor the vDSO, which makes it cheaper than
+ * rcutils_steady_time_now(), e.g. to timestamp every message when tracing.
+ * Until then, or if the counter can't be trusted, it is the same as rcutils_steady_time_now().
+ *
+ * Time points of this clock start from rcutils_steady_time_now() at calibration, but the rate
+ * of the counter is only measured to a few parts per million, so they drift slowly from those
+ * of rcutils_steady_time_now(), and should only be compared with each other.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] now a struct in which the current time is stored
+ * \return #RCUTILS_RET_OK if the current time was successfully obtained, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCUTILS_RET_ERROR if an unspecified error occur.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_steady_time_now_fast(rcutils_time_point_value_t * now);
+
+/// The time before a deadline which rcutils_sleep_until() spins for rather than sleeps.
+/**
+ * Sleeping threads usually wake up 50 to 100 microseconds late on Linux.
+ */
+#define RCUTILS_SLEEP_DEFAULT_SPIN_THRESHOLD RCUTILS_US_TO_NS(200)
+
+/// Wait until the steady clock reaches a deadline, sleeping and then spinning.
+/**
+ * This is rcutils_sleep_until_with_spin_threshold() with a spin threshold of
+ * #RCUTILS_SLEEP_DEFAULT_SPIN_THRESHOLD.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] steady_deadline the time point of rcutils_steady_time_now() to wait for
+ * \return #RCUTILS_RET_OK if the deadline was reached, or
+ * \return #RCUTILS_RET_ERROR if the clock couldn't be read or the thread couldn't sleep.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_sleep_until(rcutils_time_point_value_t steady_deadline);
+
+/// Wait until the steady clock reaches a deadline, sleeping and then spinning.
+/**
+ * The calling thread sleeps until `spin_threshold` nanoseconds before the deadline, with
+ * `clock_nanosleep(TIMER_ABSTIME)` where it sleeps on the steady clock, or a high resolution
+ * waitable timer on Windows, and then keeps reading the clock until the deadline, so that it
+ * returns within a few hundred nanoseconds after it rather than when the scheduler wakes it
+ * up.
+ * The clock is read with rcutils_steady_time_now_fast() once it was calibrated with
+ * rcutils_steady_time_fast_init(), and with rcutils_steady_time_now() otherwise.
+ *
+ * The thread keeps its CPU busy while it spins, so the threshold trades CPU time for
+ * precision: it should cover how late the thread wakes up, which is more on a loaded system.
+ * A threshold of 0 only sleeps, and if the deadline is already past, this returns at once.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] steady_deadline the time point of rcutils_steady_time_now() to wait for
+ * \param[in] spin_threshold the time before the deadline to spin for, in nanoseconds
+ * \return #RCUTILS_RET_OK if the deadline was reached, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the spin threshold is negative, or
+ * \return #RCUTILS_RET_ERROR if the clock couldn't be read or the thread couldn't sleep.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_sleep_until_with_spin_threshold(
+  rcutils_time_point_value_t steady_deadline,
+  rcutils_duration_value_t spin_threshold);
+
 /// Return a time point as nanoseconds in a string.
 /**
  * The number is always fixed width, with left padding zeros up to the maximum
@@ -182,6 +381,79 @@ rcutils_time_point_value_as_seconds_string(
   char * str,
   size_t str_size);
 
+/// A string size which fits any time point formatted by rcutils_time_point_value_format_*().
+#define RCUTILS_TIME_POINT_VALUE_STRING_SIZE (32)
+
+/// Return a time point as nanoseconds in a string, without using `snprintf()`.
+/**
+ * The result is the same as the one of
+ * rcutils_time_point_value_as_nanoseconds_string(), but the digits are
+ * rendered directly and the digits of the seconds are cached per thread and
+ * reused while the second doesn't change, which makes this suitable for
+ * timestamping every line of high rate output.
+ *
+ * If the given string is not large enough, the result will be truncated.
+ * A string of #RCUTILS_TIME_POINT_VALUE_STRING_SIZE is always large enough.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] time_point the time to be made into a string
+ * \param[out] str the output string in which it is stored
+ * \param[in] str_size the size of the output string
+ * \param[out] length the length of the stored string, excluding the null
+ *   terminator, may be NULL
+ * \return #RCUTILS_RET_OK if successful (even if truncated), or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_time_point_value_format_nanoseconds(
+  const rcutils_time_point_value_t * time_point,
+  char * str,
+  size_t str_size,
+  size_t * length);
+
+/// Return a time point as floating point seconds in a string, without using `snprintf()`.
+/**
+ * The result is the same as the one of
+ * rcutils_time_point_value_as_seconds_string(), rendered like in
+ * rcutils_time_point_value_format_nanoseconds().
+ *
+ * If the given string is not large enough, the result will be truncated.
+ * A string of #RCUTILS_TIME_POINT_VALUE_STRING_SIZE is always large enough.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] time_point the time to be made into a string
+ * \param[out] str the output string in which it is stored
+ * \param[in] str_size the size of the output string
+ * \param[out] length the length of the stored string, excluding the null
+ *   terminator, may be NULL
+ * \return #RCUTILS_RET_OK if successful (even if truncated), or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_time_point_value_format_seconds(
+  const rcutils_time_point_value_t * time_point,
+  char * str,
+  size_t str_size,
+  size_t * length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,11 +22,18 @@ extern "C"
 
 #include "rcutils/types/array_list.h"
 #include "rcutils/types/char_array.h"
+#include "rcutils/types/concurrent_hash_map.h"
 #include "rcutils/types/hash_map.h"
+#include "rcutils/types/mpmc_queue.h"
+#include "rcutils/types/ring_buffer.h"
 #include "rcutils/types/string_array.h"
 #include "rcutils/types/string_map.h"
+#include "rcutils/types/string_pool.h"
+#include "rcutils/types/striped_counter.h"
 #include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/spsc_queue.h"
 #include "rcutils/types/uint8_array.h"
+#include "rcutils/types/uint8_array_pool.h"
 
 #ifdef __cplusplus
 }
@@ -129,6 +129,42 @@ rcutils_array_list_init(
   size_t data_size,
   const rcutils_allocator_t * allocator);
 
+/// Initialize an array list which stores its first entries inline.
+/**
+ * This function initializes a given, zero initialized, array_list like
+ * rcutils_array_list_init(), except that the space for the first
+ * inline_capacity entries is allocated along with the list itself, so that
+ * short lists take a single allocation and are stored contiguously.
+ * Once the list grows past the inline capacity, its entries are moved to an
+ * allocation of their own, as with rcutils_array_list_init(), and the inline
+ * space is left unused until the list is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] array_list object to be initialized
+ * \param[in] inline_capacity the number of entries stored inline, which is the initial capacity
+ * \param[in] data_size the size (in bytes) of the data object being stored in the list
+ * \param[in] allocator to be used to allocate and deallocate memory
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_init_with_inline_capacity(
+  rcutils_array_list_t * array_list,
+  size_t inline_capacity,
+  size_t data_size,
+  const rcutils_allocator_t * allocator);
+
 /// Finalize an array list, reclaiming all resources.
 /**
  * This function reclaims any memory owned by the array list.
@@ -180,6 +216,117 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_array_list_add(rcutils_array_list_t * array_list, const void * data);
 
+/// Adds several entries to the list
+/**
+ * This function adds copies of count consecutive entries to the end of the
+ * list, growing its capacity at most once.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to add the data to
+ * \param[in] data a pointer to the count entries to add to the list
+ * \param[in] count the number of entries to add
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_add_n(rcutils_array_list_t * array_list, const void * data, size_t count);
+
+/// Reserves space for entries in the list
+/**
+ * This function grows the capacity of the list to the given capacity, so
+ * that entries can then be added without allocating memory.
+ * The capacity of the list is never decreased.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to reserve space in
+ * \param[in] capacity the number of entries the list can hold afterwards
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_reserve(rcutils_array_list_t * array_list, size_t capacity);
+
+/// Reduces the capacity of the list to its size
+/**
+ * This function gives back the memory of the entries which were reserved but
+ * aren't used, e.g. after a burst of entries was removed again.
+ * The entries of a list initialized with
+ * rcutils_array_list_init_with_inline_capacity() are moved back inline if
+ * they fit there, otherwise, as for a list initialized with
+ * rcutils_array_list_init(), they are reallocated, keeping room for an entry
+ * at least.
+ * Pointers returned by rcutils_array_list_get_ptr() are invalidated.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to shrink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_shrink_to_fit(rcutils_array_list_t * array_list);
+
+/// Retrieves the number of bytes the list allocated
+/**
+ * This function adds up the sizes requested from the allocator of the list,
+ * for its implementation, including inline entries, and for its entries, so
+ * that the memory of a process can be attributed to the structures holding
+ * it.
+ * What the allocator spends on top of that for its bookkeeping isn't known,
+ * and memory pointed to by the entries isn't included.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list list to get the allocated size of
+ * \param[out] allocated_size the number of bytes allocated for the list
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_get_allocated_size(
+  const rcutils_array_list_t * array_list, size_t * allocated_size);
+
 /// Sets an entry in the list to the provided data
 /**
  * This function sets the provided data at the specified index in the list.
@@ -232,6 +379,33 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_array_list_remove(rcutils_array_list_t * array_list, size_t index);
 
+/// Removes an entry in the list at the provided index, replacing it with the last entry
+/**
+ * This function removes data from the list at the specified index in constant
+ * time, by moving the last entry of the list there instead of shifting all the
+ * entries after it, so the order of the entries is not preserved.
+ * The capacity of the list will never decrease when entries are removed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to remove the data from
+ * \param[in] index the index of the item to remove from the list
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if index out of bounds, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_swap_remove(rcutils_array_list_t * array_list, size_t index);
+
 /// Retrieves an entry in the list at the provided index
 /**
  * This function retrieves a copy of the data stored in the list at the provided index.
@@ -257,6 +431,36 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_array_list_get(const rcutils_array_list_t * array_list, size_t index, void * data);
 
+/// Retrieves a pointer to an entry in the list at the provided index
+/**
+ * This function retrieves a pointer to the data stored in the list at the
+ * provided index, instead of a copy of it.
+ * The entries are stored one after the other, so the following entries may be
+ * accessed through the pointer too, up to the size of the list.
+ * The pointer is valid until the list is modified by adding or removing
+ * entries, reserving space in it, or finalizing it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to get the data from
+ * \param[in] index the index at which to get the data
+ * \param[out] data a pointer to the data stored in the list
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if index out of bounds, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_get_ptr(const rcutils_array_list_t * array_list, size_t index, void ** data);
+
 /// Retrieves the size of the provided array_list
 /**
  * This function retrieves the number of items in the provided array list
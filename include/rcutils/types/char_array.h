@@ -23,6 +23,7 @@ extern "C"
 #endif
 
 #include <stdarg.h>
+#include <stdint.h>
 
 #include "rcutils/allocator.h"
 #include "rcutils/types/rcutils_ret.h"
@@ -146,6 +147,46 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_char_array_expand_as_needed(rcutils_char_array_t * char_array, size_t new_size);
 
+/// Reduce the capacity of the internal buffer of the char array to its length.
+/**
+ * The buffer of a char array only ever grows as it is written to, so after a
+ * long message, e.g. at startup, this function gives back the memory beyond
+ * the current length of the data, including its terminating null character.
+ * An empty buffer is deallocated altogether, as if the char array was
+ * initialized with a capacity of 0.
+ * If the array doesn't own its buffer, nothing is done.
+ * Be aware, that this reallocates the buffer and therefore invalidates any
+ * pointers to this storage.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being shrunk
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if the char_array argument is invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, in which case the
+ *   buffer is left as it was, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_shrink_to_fit(rcutils_char_array_t * char_array);
+
+/// Get the number of bytes the char array allocated.
+/**
+ * This is the capacity of the internal buffer if the array owns it, or 0
+ * otherwise, since a buffer which isn't owned is accounted for by its owner.
+ * The rcutils_char_array_t struct itself is provided by the caller.
+ *
+ * \param[in] char_array pointer to the instance of rcutils_char_array_t to query
+ * \param[out] allocated_size the number of bytes allocated for the buffer
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_get_allocated_size(
+  const rcutils_char_array_t * char_array, size_t * allocated_size);
+
 /// Produce output according to format and args.
 /**
  * This function is equivalent to `vsprintf(char_array->buffer, format, args)`
@@ -167,6 +208,29 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_char_array_vsprintf(rcutils_char_array_t * char_array, const char * format, va_list args);
 
+/// Append output produced according to format and args to the string in buffer.
+/**
+ * This function is equivalent to `rcutils_char_array_vsprintf` except that the output is
+ * appended to the string in buffer, like `rcutils_char_array_strcat` appends a string.
+ * The output is formatted straight into the end of the buffer, and only formatted a second
+ * time if the buffer has to grow for it, so a string can be built piece by piece without
+ * formatting every piece into a temporary first.
+ * The `va_list args` will be cloned before being used, so a user can safely
+ * use it again after calling this function.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being
+ * appended to
+ * \param[in] format the format string used by the underlying `vsnprintf`
+ * \param[in] args the `va_list` used by the underlying `vsnprintf`
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_vstrcatf(rcutils_char_array_t * char_array, const char * format, va_list args);
+
 /// Append a string (or part of it) to the string in buffer.
 /**
  * This function treats the internal buffer as a string and appends the src string to it.
@@ -205,6 +269,100 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_char_array_strcat(rcutils_char_array_t * char_array, const char * src);
 
+/// Append a character to the string in buffer.
+/**
+ * This function is equivalent to `rcutils_char_array_strncat(char_array, &c, 1)`.
+ * Like the other functions appending to the string in buffer, it relies on
+ * `char_array->buffer_length` instead of scanning the buffer for its end, and grows
+ * the buffer geometrically, so that building a string piece by piece takes
+ * amortized constant time per character.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being
+ * appended to
+ * \param[in] c the character to be appended, which must not be a null character
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_append_char(rcutils_char_array_t * char_array, char c);
+
+/// Append a character repeated count times to the string in buffer.
+/**
+ * This is useful for padding and indentation.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being
+ * appended to
+ * \param[in] c the character to be appended, which must not be a null character
+ * \param[in] count the number of times c is appended, which may be zero
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_append_repeated_char(
+  rcutils_char_array_t * char_array, char c, size_t count);
+
+/// Append the decimal representation of an unsigned integer to the string in buffer.
+/**
+ * This function is equivalent to appending the output of `printf("%" PRIu64, value)`,
+ * but doesn't parse a format string, nor format into a temporary buffer.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being
+ * appended to
+ * \param[in] value the integer to be appended
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_append_uint(rcutils_char_array_t * char_array, uint64_t value);
+
+/// Append the decimal representation of a signed integer to the string in buffer.
+/**
+ * This function is equivalent to appending the output of `printf("%" PRId64, value)`.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being
+ * appended to
+ * \param[in] value the integer to be appended
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_append_int(rcutils_char_array_t * char_array, int64_t value);
+
+/// Append a fixed-point number to the string in buffer.
+/**
+ * The number appended is `value` divided by 10 to the power of `decimals`, with exactly
+ * `decimals` digits after the decimal point, so that e.g. a time in nanoseconds can be
+ * appended in seconds with `decimals` set to 9.
+ * Unlike going through a `double`, this is exact for any value.
+ * If `decimals` is zero, no decimal point is appended.
+ *
+ * \param[inout] char_array pointer to the instance of rcutils_char_array_t which is being
+ * appended to
+ * \param[in] value the number to be appended, in units of 10 to the power of -decimals
+ * \param[in] decimals the number of digits after the decimal point, at most 19
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if decimals is larger than 19, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCUTILS_RET_ERROR if an unexpected error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_char_array_append_fixed_point(
+  rcutils_char_array_t * char_array, int64_t value, size_t decimals);
+
 /// Copy memory to buffer.
 /**
  * This function is equivalent to `memcpy(char_array->buffer, src, n)` except that the buffer
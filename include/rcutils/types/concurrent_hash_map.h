@@ -0,0 +1,250 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__CONCURRENT_HASH_MAP_H_
+#define RCUTILS__TYPES__CONCURRENT_HASH_MAP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+/// The number of shards used by default, enough for the cores of most machines.
+#define RCUTILS_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT 16
+
+struct rcutils_concurrent_hash_map_impl_s;
+
+/// A hash map which can be used from many threads at once.
+/**
+ * The keys are spread over shards by their hash, each shard being a
+ * rcutils_hash_map_t guarded by its own reader-writer lock, so that lookups
+ * only wait for writers to the same shard, and writers to different shards
+ * don't wait for each other at all.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_concurrent_hash_map_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_concurrent_hash_map_impl_s * impl;
+} rcutils_concurrent_hash_map_t;
+
+/// Return an empty concurrent hash map struct.
+/**
+ * This function returns an empty and zero initialized concurrent hash map
+ * struct, which must be initialized with rcutils_concurrent_hash_map_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_concurrent_hash_map_t
+rcutils_get_zero_initialized_concurrent_hash_map(void);
+
+/// Initialize a rcutils_concurrent_hash_map_t.
+/**
+ * The arguments are the ones of rcutils_hash_map_init_with_backend(), which is
+ * used to initialize each shard, with the number of shards added.
+ * The functions key_hashing_func and key_cmp_func may be called from many
+ * threads at once.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_concurrent_hash_map_t to be initialized
+ * \param[in] shard_count the number of shards, e.g.
+ *                        #RCUTILS_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT, which must be
+ *                        greater than zero and will be rounded up to the next power of 2
+ * \param[in] initial_capacity the initial capacity of each shard
+ * \param[in] key_size the size (in bytes) of the key used to index the data
+ * \param[in] data_size the size (in bytes) of the data being stored
+ * \param[in] key_hashing_func a function that returns a hashed value for a key
+ * \param[in] key_cmp_func a function used to compare keys
+ * \param[in] backend the implementation of the shards
+ * \param[in] allocator the allocator to use through out the lifetime of the hash_map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_concurrent_hash_map_init(
+  rcutils_concurrent_hash_map_t * hash_map,
+  size_t shard_count,
+  size_t initial_capacity,
+  size_t key_size,
+  size_t data_size,
+  rcutils_hash_map_key_hasher_t key_hashing_func,
+  rcutils_hash_map_key_cmp_t key_cmp_func,
+  rcutils_hash_map_backend_t backend,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized concurrent hash_map struct.
+/**
+ * No other thread may use the hash_map while, nor after, it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_concurrent_hash_map_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_concurrent_hash_map_fini(rcutils_concurrent_hash_map_t * hash_map);
+
+/// Get the number of entries in the hash_map.
+/**
+ * The entries of the shards are counted one shard after the other, so the
+ * result may not match any single moment while other threads modify the map.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] hash_map rcutils_concurrent_hash_map_t to be queried
+ * \param[out] size the number of entries in the hash_map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_concurrent_hash_map_get_size(
+  const rcutils_concurrent_hash_map_t * hash_map, size_t * size);
+
+/// Set a key value pair in the hash_map, as with rcutils_hash_map_set().
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] hash_map rcutils_concurrent_hash_map_t to be updated
+ * \param[in] key hash_map key
+ * \param[in] value value for given hash_map key
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_concurrent_hash_map_set(
+  rcutils_concurrent_hash_map_t * hash_map, const void * key, const void * value);
+
+/// Unset a key value pair in the hash_map, as with rcutils_hash_map_unset().
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] hash_map rcutils_concurrent_hash_map_t to be updated
+ * \param[in] key hash_map key to be removed
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_concurrent_hash_map_unset(rcutils_concurrent_hash_map_t * hash_map, const void * key);
+
+/// Check if a key exists in the hash_map, as with rcutils_hash_map_key_exists().
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] hash_map rcutils_concurrent_hash_map_t to be searched
+ * \param[in] key hash_map key to look for
+ * \return `true` if the key is in the hash_map, or
+ * \return `false` if it isn't, or for invalid arguments.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_concurrent_hash_map_key_exists(
+  const rcutils_concurrent_hash_map_t * hash_map, const void * key);
+
+/// Copy the data of a key in the hash_map, as with rcutils_hash_map_get().
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] hash_map rcutils_concurrent_hash_map_t to be searched
+ * \param[in] key hash_map key to look for
+ * \param[out] data the data of the key is copied there
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_NOT_FOUND if the key doesn't exist in the hash_map, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_concurrent_hash_map_get(
+  const rcutils_concurrent_hash_map_t * hash_map, const void * key, void * data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__CONCURRENT_HASH_MAP_H_
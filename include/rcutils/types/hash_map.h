@@ -38,6 +38,15 @@ typedef struct RCUTILS_PUBLIC_TYPE rcutils_hash_map_s
   struct rcutils_hash_map_impl_s * impl;
 } rcutils_hash_map_t;
 
+/// The position of an entry in a hash map, see rcutils_hash_map_iterator_begin().
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_hash_map_iterator_s
+{
+  /// The bucket, or the slot with the open addressing backend, holding the entry.
+  size_t position;
+  /// The index of the entry in its bucket, which is 0 with the open addressing backend.
+  size_t index;
+} rcutils_hash_map_iterator_t;
+
 /// The function signature for a key hashing function.
 /**
  * \param[in] key The key that needs to be hashed
@@ -60,6 +69,61 @@ typedef int (* rcutils_hash_map_key_cmp_t)(
   const void * val2
 );
 
+/// The function signature for a key view hashing function.
+/**
+ * A key view is a key given by the start of its contents and their length, e.g. a part of a
+ * longer string, which may not be stored as a key without being copied.
+ * The hash of a key view must be the one of the equal key, see
+ * rcutils_hash_map_set_key_view_funcs().
+ *
+ * \param[in] key_view The start of the key view
+ * \param[in] length The length of the key view
+ * \return A hash value for the provided key view
+ */
+typedef size_t (* rcutils_hash_map_key_view_hasher_t)(
+  const void * key_view,
+  size_t length
+);
+
+/// The function signature for a function comparing a key with a key view.
+/**
+ * \param[in] key The key, as stored in the hash map
+ * \param[in] key_view The start of the key view
+ * \param[in] length The length of the key view
+ * \return Zero if the key and the key view are equal, or
+ * \return A non-zero number otherwise.
+ */
+typedef int (* rcutils_hash_map_key_view_cmp_t)(
+  const void * key,
+  const void * key_view,
+  size_t length
+);
+
+/// The implementation of a hash map, selected with rcutils_hash_map_init_with_backend().
+typedef enum rcutils_hash_map_backend_e
+{
+  /// Each bucket is a list of entries, each allocated along with its key and value.
+  RCUTILS_HASH_MAP_BACKEND_CHAINING = 0,
+  /// The keys and values are stored inline in a flat array of slots, found with open addressing.
+  /**
+   * A control byte per slot holds 7 bits of the hash of its entry, and the
+   * control bytes of 8 slots are compared at once, so that a lookup usually
+   * compares a single key, and setting a new key only allocates when the map
+   * grows, which it does once 7/8 of the slots are used.
+   */
+  RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING = 1,
+  /// Like #RCUTILS_HASH_MAP_BACKEND_CHAINING, but the entries are moved incrementally on growth.
+  /**
+   * When the map grows, the buckets are only allocated, and the old buckets are
+   * kept until their entries are moved to the new ones, a few buckets at a time
+   * on each following call to rcutils_hash_map_set() or rcutils_hash_map_unset(),
+   * rather than all at once.
+   * This bounds the time taken by any single call, at the cost of looking up
+   * keys in both the new and the old buckets while entries are being moved.
+   */
+  RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL = 2,
+} rcutils_hash_map_backend_t;
+
 /**
  * Validates that an rcutils_hash_map_t* points to a valid hash map.
  * \param[in] map A pointer to an rcutils_hash_map_t
@@ -82,6 +146,34 @@ RCUTILS_PUBLIC
 size_t
 rcutils_hash_map_string_hash_func(const void * key_str);
 
+/// A faster hashing function for a null terminated c string.
+/**
+ * This can be used instead of rcutils_hash_map_string_hash_func(), with the
+ * same keys, and hashes the string with rcutils_hash_map_string_fast_hashn().
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_hash_map_string_fast_hash_func(const void * key_str);
+
+/// Hash the first `length` characters of a string, reading them a word at a time.
+/**
+ * This is a variant of wyhash, which mixes 16 characters at a time with 64-bit
+ * multiplications, and whose low bits are well distributed, so that the hash
+ * can be used modulo a power of two.
+ * The hash is the same on every platform for the same characters, with
+ * 64-bit size_t.
+ * It can be used by callers which already know the length of a string, to
+ * compute the hash that rcutils_hash_map_string_fast_hash_func() would
+ * without scanning for the null terminating character.
+ *
+ * \param[in] string The characters to hash, which don't need to be null terminated
+ * \param[in] length The number of characters to hash
+ * \return The hash of the characters
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_hash_map_string_fast_hashn(const char * string, size_t length);
+
 /// A comparison function for a null terminated c string.
 /**
  * A comparison function for a null terminated c string.
@@ -91,6 +183,47 @@ RCUTILS_PUBLIC
 int
 rcutils_hash_map_string_cmp_func(const void * val1, const void * val2);
 
+/// Hash the first `length` characters of a string like rcutils_hash_map_string_hash_func().
+/**
+ * This is the key view hashing function of maps whose keys are hashed with
+ * rcutils_hash_map_string_hash_func(), see rcutils_hash_map_set_key_view_funcs().
+ *
+ * \param[in] key_view The characters to hash, which don't need to be null terminated
+ * \param[in] length The number of characters to hash
+ * \return The hash of the characters
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_hash_map_string_hash_view_func(const void * key_view, size_t length);
+
+/// Hash the first `length` characters of a string like rcutils_hash_map_string_fast_hash_func().
+/**
+ * This is the key view hashing function of maps whose keys are hashed with
+ * rcutils_hash_map_string_fast_hash_func(), see rcutils_hash_map_set_key_view_funcs().
+ *
+ * \param[in] key_view The characters to hash, which don't need to be null terminated
+ * \param[in] length The number of characters to hash
+ * \return The hash of the characters
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_hash_map_string_fast_hash_view_func(const void * key_view, size_t length);
+
+/// Compare a c string key with the first `length` characters of a string.
+/**
+ * This is the key view comparison function of maps whose keys are pointers to c strings,
+ * compared with rcutils_hash_map_string_cmp_func(), see rcutils_hash_map_set_key_view_funcs().
+ *
+ * \param[in] key A pointer to the null terminated c string key
+ * \param[in] key_view The characters to compare, which don't need to be null terminated
+ * \param[in] length The number of characters to compare
+ * \return Zero if the key is made of exactly these characters, or
+ * \return A non-zero number otherwise.
+ */
+RCUTILS_PUBLIC
+int
+rcutils_hash_map_string_view_cmp_func(const void * key, const void * key_view, size_t length);
+
 /// Return an empty hash_map struct.
 /**
  * This function returns an empty and zero initialized hash_map struct.
@@ -181,6 +314,51 @@ rcutils_hash_map_init(
   rcutils_hash_map_key_cmp_t key_cmp_func,
   const rcutils_allocator_t * allocator);
 
+/// Initialize a rcutils_hash_map_t with the given backend.
+/**
+ * This behaves like rcutils_hash_map_init(), which uses
+ * #RCUTILS_HASH_MAP_BACKEND_CHAINING, except for the backend.
+ * With #RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING, the capacity is the number
+ * of slots, which is at least 8, and space for the keys and values of that
+ * many entries is allocated right away.
+ * The keys given to key_cmp_func are stored aligned for any type.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to be initialized
+ * \param[in] initial_capacity the amount of initial capacity for the hash_map - this must be
+ *                             greater than zero and will be automatically rounded up to the
+ *                             next power of 2
+ * \param[in] key_size the size (in bytes) of the key used to index the data
+ * \param[in] data_size the size (in bytes) of the data being stored
+ * \param[in] key_hashing_func a function that returns a hashed value for a key
+ * \param[in] key_cmp_func a function used to compare keys
+ * \param[in] backend the implementation of the hash_map
+ * \param[in] allocator the allocator to use through out the lifetime of the hash_map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_init_with_backend(
+  rcutils_hash_map_t * hash_map,
+  size_t initial_capacity,
+  size_t key_size,
+  size_t data_size,
+  rcutils_hash_map_key_hasher_t key_hashing_func,
+  rcutils_hash_map_key_cmp_t key_cmp_func,
+  rcutils_hash_map_backend_t backend,
+  const rcutils_allocator_t * allocator);
+
 /// Finalize the previously initialized hash_map struct.
 /**
  * This function will free any resources which were created when initializing
@@ -259,6 +437,72 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_hash_map_get_size(const rcutils_hash_map_t * hash_map, size_t * size);
 
+/// Get the number of bytes the hash_map allocated.
+/**
+ * This function adds up the sizes requested from the allocator of the
+ * hash_map, for its implementation, its buckets or slots and its entries, so
+ * that the memory of a process can be attributed to the structures holding
+ * it.
+ * What the allocator spends on top of that for its bookkeeping isn't known,
+ * and memory pointed to by the keys or the data, e.g. the strings of string
+ * keys, isn't included.
+ * With the chaining backends, the buckets are visited, so this takes time
+ * linear in the capacity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be queried
+ * \param[out] allocated_size the number of bytes allocated for the hash_map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_get_allocated_size(const rcutils_hash_map_t * hash_map, size_t * allocated_size);
+
+/// Reduce the memory the hash_map allocated to what its current entries need.
+/**
+ * The capacity of a hash_map only ever grows when setting key value pairs, so
+ * after a burst of entries which were unset again, e.g. at startup, most of
+ * its memory is unused.
+ * This function rehashes the entries into the smallest capacity which holds
+ * them without growing, if it is smaller than the current one.
+ * With the chaining backends, the buckets left empty are freed and the others
+ * shrunk, and with the incremental one the entries left in the buckets from
+ * before the hash_map last grew are moved first.
+ * With the open addressing backend, the slots of unset entries are reclaimed.
+ * Iterators are invalidated.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to be shrunk
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, in which case the
+ *   hash_map keeps all its entries, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_shrink_to_fit(rcutils_hash_map_t * hash_map);
+
 /// Set a key value pair in the hash_map, increasing capacity if necessary.
 /**
  * If the key already exists in the map then the value is updated to the new value
@@ -287,6 +531,70 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_hash_map_set(rcutils_hash_map_t * hash_map, const void * key, const void * value);
 
+/// Make room for a number of entries in the hash_map, so that it doesn't grow until it has more.
+/**
+ * The capacity is increased, and the entries moved into the new buckets or
+ * slots at once, if the given number of entries doesn't fit in the hash_map
+ * without growing it, and it is never decreased.
+ * With #RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING, the slots of unset entries
+ * are also reclaimed if there wouldn't be room for the entries otherwise.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to be updated
+ * \param[in] count the total number of entries the hash_map should hold
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_reserve(rcutils_hash_map_t * hash_map, size_t count);
+
+/// Set many key value pairs in the hash_map at once.
+/**
+ * This behaves like calling rcutils_hash_map_set() for each key and value in
+ * order, but room is made for all the keys first, as with
+ * rcutils_hash_map_reserve(), counting them all as new entries, and they are
+ * then set in the order of the buckets they go in.
+ * If setting a key fails, the keys set before it are kept.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to be updated
+ * \param[in] keys array of count keys, each key_size bytes long
+ * \param[in] values array of count values, each data_size bytes long
+ * \param[in] count the number of keys and values
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_set_many(
+  rcutils_hash_map_t * hash_map,
+  const void * keys,
+  const void * values,
+  size_t count);
+
 /// Unset a key value pair in the hash_map.
 /**
  * Unsets the key value pair in the hash_map and frees any internal resources allocated
@@ -366,6 +674,216 @@ RCUTILS_PUBLIC
 rcutils_ret_t
 rcutils_hash_map_get(const rcutils_hash_map_t * hash_map, const void * key, void * data);
 
+/// Set a key value pair in the hash_map, given the hash of the key.
+/**
+ * This behaves like rcutils_hash_map_set(), without calling the hashing
+ * function of the hash_map, for callers which already hold the hash of a key,
+ * e.g. when using the same key repeatedly.
+ * The hash must be the one the hashing function returns for the key, or the
+ * key will not be found by the other functions.
+ * The same applies to the other `_with_hash` functions.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to be updated
+ * \param[in] key hash_map key
+ * \param[in] key_hash the hash of the key, as returned by key_hashing_func
+ * \param[in] value value for given hash_map key
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_set_with_hash(
+  rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, const void * value);
+
+/// Unset a key value pair from the hash_map, given the hash of the key.
+/**
+ * This behaves like rcutils_hash_map_unset(), see
+ * rcutils_hash_map_set_with_hash() for the hash.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to be updated
+ * \param[in] key hash_map key to be removed
+ * \param[in] key_hash the hash of the key, as returned by key_hashing_func
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_unset_with_hash(rcutils_hash_map_t * hash_map, const void * key, size_t key_hash);
+
+/// Check whether a key is in the hash_map, given the hash of the key.
+/**
+ * This behaves like rcutils_hash_map_key_exists(), see
+ * rcutils_hash_map_set_with_hash() for the hash.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be searched
+ * \param[in] key hash_map key to look for
+ * \param[in] key_hash the hash of the key, as returned by key_hashing_func
+ * \return `true` if key is in the hash_map, or
+ * \return `false` if key is not in the hash_map, or
+ * \return `false` for invalid arguments, or
+ * \return `false` if the hash_map is invalid.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_hash_map_key_exists_with_hash(
+  const rcutils_hash_map_t * hash_map, const void * key, size_t key_hash);
+
+/// Get value given a key and its hash.
+/**
+ * This behaves like rcutils_hash_map_get(), see
+ * rcutils_hash_map_set_with_hash() for the hash.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be searched
+ * \param[in] key hash_map key to look up the data for
+ * \param[in] key_hash the hash of the key, as returned by key_hashing_func
+ * \param[out] data A copy of the data stored in the map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_NOT_FOUND if the key doesn't exist in the map, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_hash_map_get_with_hash(
+  const rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, void * data);
+
+/// Set the functions with which keys may be looked up by key views.
+/**
+ * Once set, rcutils_hash_map_key_view_exists() and rcutils_hash_map_get_with_key_view()
+ * look up keys given as a key view, e.g. a part of a longer string, without copying it into a
+ * key first.
+ * For each key equal to a key view, key_view_hashing_func must return the hash that
+ * key_hashing_func returns, and key_view_cmp_func must return zero.
+ *
+ * For example, for keys which are pointers to c strings:
+ * ```c
+ * rcutils_ret_t ret = rcutils_hash_map_set_key_view_funcs(
+ *   &hash_map, rcutils_hash_map_string_fast_hash_view_func,
+ *   rcutils_hash_map_string_view_cmp_func);
+ * // ...
+ * const char * path = "/a/b/c";
+ * int data = 0;
+ * // Looks up the key "/a/b".
+ * ret = rcutils_hash_map_get_with_key_view(&hash_map, path, 4, &data);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] hash_map rcutils_hash_map_t to set the functions of
+ * \param[in] key_view_hashing_func a function that returns the hash of a key view
+ * \param[in] key_view_cmp_func a function used to compare keys with key views
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_hash_map_set_key_view_funcs(
+  rcutils_hash_map_t * hash_map,
+  rcutils_hash_map_key_view_hasher_t key_view_hashing_func,
+  rcutils_hash_map_key_view_cmp_t key_view_cmp_func);
+
+/// Check whether a key equal to a key view is in the hash_map.
+/**
+ * This behaves like rcutils_hash_map_key_exists(), with a key given as a key view,
+ * see rcutils_hash_map_set_key_view_funcs().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be searched
+ * \param[in] key_view the start of the key view to look for
+ * \param[in] length the length of the key view
+ * \return `true` if a key equal to the key view is in the hash_map, or
+ * \return `false` if no key equal to the key view is in the hash_map, or
+ * \return `false` for invalid arguments, or
+ * \return `false` if the hash_map is invalid or has no key view functions.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_hash_map_key_view_exists(
+  const rcutils_hash_map_t * hash_map, const void * key_view, size_t length);
+
+/// Get the value of the key equal to a key view.
+/**
+ * This behaves like rcutils_hash_map_get(), with a key given as a key view,
+ * see rcutils_hash_map_set_key_view_funcs().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be searched
+ * \param[in] key_view the start of the key view to look up the data for
+ * \param[in] length the length of the key view
+ * \param[out] data A copy of the data stored in the map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_ERROR if the hash_map has no key view functions, or
+ * \return #RCUTILS_RET_NOT_FOUND if no key equal to the key view exists in the map.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_hash_map_get_with_key_view(
+  const rcutils_hash_map_t * hash_map, const void * key_view, size_t length, void * data);
+
 /// Get the next key in the hash_map, unless NULL is given, then get the first key.
 /**
  * This function allows you to iteratively get each key/value pair in the hash_map.
@@ -419,6 +937,87 @@ rcutils_hash_map_get_next_key_and_data(
   void * key,
   void * data);
 
+/// Get the first key and data in the hash_map, and an iterator to get the following ones.
+/**
+ * Unlike rcutils_hash_map_get_next_key_and_data(), which looks up the previous
+ * key before moving on to the next entry, the iterator holds the position of
+ * the entry, so that rcutils_hash_map_iterator_next() moves on to the next
+ * entry directly and iterating over the whole hash_map takes linear time.
+ * The entries are visited in the same arbitrary order with both.
+ *
+ * If the hash_map is modified, the iterator is invalidated and iteration
+ * should begin again.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * Example:
+ * ```c
+ * printf("entries in the hash_map:\n");
+ * rcutils_hash_map_iterator_t iterator;
+ * int key = 0, data = 0;
+ * rcutils_ret_t status = rcutils_hash_map_iterator_begin(&hash_map, &iterator, &key, &data);
+ * while (RCUTILS_RET_OK == status) {
+ *   printf("%i: %i\n", key, data);
+ *   status = rcutils_hash_map_iterator_next(&hash_map, &iterator, &key, &data);
+ * }
+ * ```
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be iterated over
+ * \param[out] iterator The position of the first entry
+ * \param[out] key A copy of the first key
+ * \param[out] data A copy of the first data
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES if the hash_map is empty, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_hash_map_iterator_begin(
+  const rcutils_hash_map_t * hash_map,
+  rcutils_hash_map_iterator_t * iterator,
+  void * key,
+  void * data);
+
+/// Move an iterator to the next entry of the hash_map and get its key and data.
+/**
+ * See rcutils_hash_map_iterator_begin().
+ * Once #RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES is returned, the iterator is
+ * past the end of the hash_map, and stays there.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be iterated over
+ * \param[inout] iterator The position of the current entry, moved to the next one
+ * \param[out] key A copy of the next key
+ * \param[out] data A copy of the next data
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES if there are no more entries, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_hash_map_iterator_next(
+  const rcutils_hash_map_t * hash_map,
+  rcutils_hash_map_iterator_t * iterator,
+  void * key,
+  void * data);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,256 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__MPMC_QUEUE_H_
+#define RCUTILS__TYPES__MPMC_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+struct rcutils_mpmc_queue_impl_s;
+
+/// A bounded lock-free queue of fixed size elements, for many producer and consumer threads.
+/**
+ * This is the queue described by Dmitry Vyukov: the elements are copied into a ring of slots
+ * whose number is a power of two, each slot carrying a sequence number which tells producers
+ * and consumers whether it is free for the lap they are on.
+ * Producers claim slots by advancing the tail index and consumers by advancing the head
+ * index, each on its own cache line, so that producers don't contend with consumers
+ * besides on the slots they hand over.
+ *
+ * Any number of threads may push and pop concurrently.
+ * Use rcutils_spsc_queue_t when there is a single producer and a single consumer.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_mpmc_queue_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_mpmc_queue_impl_s * impl;
+} rcutils_mpmc_queue_t;
+
+/// Return an empty queue struct.
+/**
+ * This function returns an empty and zero initialized queue struct, which must be
+ * initialized with rcutils_mpmc_queue_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_mpmc_queue_t
+rcutils_get_zero_initialized_mpmc_queue(void);
+
+/// Initialize a rcutils_mpmc_queue_t.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_mpmc_queue_t to be initialized
+ * \param[in] capacity the least number of elements the queue holds, which must be greater
+ *   than zero and will be rounded up to the next power of 2, and to at least 2
+ * \param[in] element_size the size of the elements, in bytes, which must be greater than zero
+ * \param[in] allocator the allocator to use for the queue and its slots
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_init(
+  rcutils_mpmc_queue_t * queue,
+  size_t capacity,
+  size_t element_size,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized queue struct.
+/**
+ * The elements still in the queue are discarded.
+ * No other thread may use the queue while, nor after, it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_mpmc_queue_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_fini(rcutils_mpmc_queue_t * queue);
+
+/// Copy an element into the queue, unless it is full.
+/**
+ * A full queue isn't an error, so no error message is set for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_mpmc_queue_t to push to
+ * \param[in] element the element_size bytes of the element
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized, or
+ * \return #RCUTILS_RET_NOT_ENOUGH_SPACE if the queue is full.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_push(rcutils_mpmc_queue_t * queue, const void * element);
+
+/// Copy as many elements as fit into the queue, claiming their slots at once.
+/**
+ * The elements are pushed in order, after the ones pushed before by the same thread, but
+ * may be interleaved with elements pushed by other threads when they are popped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_mpmc_queue_t to push to
+ * \param[in] elements the count contiguous elements, which may be NULL if count is zero
+ * \param[in] count the number of elements
+ * \param[out] pushed the number of elements pushed, the first ones, which is less than
+ *   count if the queue became full
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_push_many(
+  rcutils_mpmc_queue_t * queue,
+  const void * elements,
+  size_t count,
+  size_t * pushed);
+
+/// Copy the oldest element out of the queue, unless it is empty.
+/**
+ * An empty queue isn't an error, so no error message is set for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_mpmc_queue_t to pop from
+ * \param[out] element the element_size bytes to copy the element to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized, or
+ * \return #RCUTILS_RET_NOT_FOUND if the queue is empty.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_pop(rcutils_mpmc_queue_t * queue, void * element);
+
+/// Copy up to a number of the oldest elements out of the queue, claiming their slots at once.
+/**
+ * Fewer elements than are in the queue may be popped when other threads are pushing or
+ * popping meanwhile.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_mpmc_queue_t to pop from
+ * \param[out] elements room for max_count contiguous elements, which may be NULL if
+ *   max_count is zero
+ * \param[in] max_count the most elements to pop
+ * \param[out] popped the number of elements popped, which is zero if the queue was empty
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_pop_many(
+  rcutils_mpmc_queue_t * queue,
+  void * elements,
+  size_t max_count,
+  size_t * popped);
+
+/// Get the number of elements the queue holds when full.
+/**
+ * \param[in] queue rcutils_mpmc_queue_t to be queried
+ * \param[out] capacity the capacity, a power of 2
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_get_capacity(const rcutils_mpmc_queue_t * queue, size_t * capacity);
+
+/// Get the number of elements in the queue.
+/**
+ * The size may be out of date as soon as it is returned if producers or consumers use the
+ * queue meanwhile, and may include elements which are still being pushed or popped.
+ *
+ * \param[in] queue rcutils_mpmc_queue_t to be queried
+ * \param[out] size the number of elements
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mpmc_queue_get_size(const rcutils_mpmc_queue_t * queue, size_t * size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__MPMC_QUEUE_H_
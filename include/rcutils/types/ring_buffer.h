@@ -0,0 +1,200 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__RING_BUFFER_H_
+#define RCUTILS__TYPES__RING_BUFFER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+struct rcutils_ring_buffer_impl_s;
+
+/// A fixed capacity ring of fixed size elements, where each push overwrites the oldest one.
+/**
+ * This keeps the last elements pushed, like the last messages or errors, or a window of
+ * latency samples.
+ * Unlike a queue, the writer never waits for the readers: pushing is wait-free, and readers
+ * take snapshots of the elements, which skip the ones overwritten while they are copied.
+ * Each slot carries a sequence number which the writer makes odd while it writes the slot,
+ * so that a reader can tell whether its copy of the slot is consistent.
+ *
+ * One thread at a time may push, while any number of threads take snapshots.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_ring_buffer_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_ring_buffer_impl_s * impl;
+} rcutils_ring_buffer_t;
+
+/// Return an empty ring buffer struct.
+/**
+ * This function returns an empty and zero initialized ring buffer struct, which must be
+ * initialized with rcutils_ring_buffer_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ring_buffer_t
+rcutils_get_zero_initialized_ring_buffer(void);
+
+/// Initialize an empty rcutils_ring_buffer_t.
+/**
+ * All the slots are allocated at once, and nothing is allocated after.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] ring_buffer rcutils_ring_buffer_t to be initialized
+ * \param[in] capacity the number of elements kept, which must be greater than zero
+ * \param[in] element_size the size of the elements, in bytes, which must be greater than zero
+ * \param[in] allocator the allocator to use for the ring buffer and its slots
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_ring_buffer_init(
+  rcutils_ring_buffer_t * ring_buffer,
+  size_t capacity,
+  size_t element_size,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized ring buffer struct.
+/**
+ * No other thread may use the ring buffer while, nor after, it is finalized.
+ *
+ * \param[inout] ring_buffer rcutils_ring_buffer_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_ring_buffer_fini(rcutils_ring_buffer_t * ring_buffer);
+
+/// Copy an element into the ring buffer, overwriting the oldest one if it is full.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, from one writer thread at a time
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes, and wait-free
+ *
+ * \param[inout] ring_buffer rcutils_ring_buffer_t to push to
+ * \param[in] element the element_size bytes of the element
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the ring buffer is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_ring_buffer_push(rcutils_ring_buffer_t * ring_buffer, const void * element);
+
+/// Copy the most recent elements out of the ring buffer, oldest first.
+/**
+ * At most `max_count` elements are copied, those pushed last before the snapshot started.
+ * The elements which the writer overwrites while they are copied are left out, and as it
+ * overwrites them oldest first, the elements copied are still consecutive ones.
+ * So `count` may be less than the number of elements in the ring buffer when it is written
+ * to meanwhile, but the snapshot never waits for the writer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] ring_buffer rcutils_ring_buffer_t to take a snapshot of
+ * \param[out] elements room for `max_count` elements
+ * \param[in] max_count the largest number of elements to copy
+ * \param[out] count the number of elements copied
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the ring buffer is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_ring_buffer_snapshot(
+  const rcutils_ring_buffer_t * ring_buffer,
+  void * elements,
+  size_t max_count,
+  size_t * count);
+
+/// Get the number of elements the ring buffer keeps.
+/**
+ * \param[in] ring_buffer rcutils_ring_buffer_t to be queried
+ * \param[out] capacity the capacity of the ring buffer
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the ring buffer is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_ring_buffer_get_capacity(const rcutils_ring_buffer_t * ring_buffer, size_t * capacity);
+
+/// Get the number of elements pushed to the ring buffer since it was initialized.
+/**
+ * This includes the elements which were overwritten since, so the number of elements in the
+ * ring buffer is the least of this and its capacity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] ring_buffer rcutils_ring_buffer_t to be queried
+ * \param[out] pushed_count the number of elements pushed
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the ring buffer is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_ring_buffer_get_pushed_count(
+  const rcutils_ring_buffer_t * ring_buffer, uint64_t * pushed_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__RING_BUFFER_H_
@@ -0,0 +1,248 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__SPSC_QUEUE_H_
+#define RCUTILS__TYPES__SPSC_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+struct rcutils_spsc_queue_impl_s;
+
+/// A bounded lock-free queue of fixed size elements, for one producer and one consumer thread.
+/**
+ * The elements are copied into a ring of slots whose number is a power of two.
+ * The producer only writes the tail index and the consumer only writes the head index,
+ * each on its own cache line, and each side keeps the last index it read of the other, so
+ * that the cache line of the other side is only read when the queue looks full or empty.
+ *
+ * One thread at a time may push, and one thread at a time may pop, concurrently.
+ * Use rcutils_mpmc_queue_t when there are several producers or consumers.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_spsc_queue_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_spsc_queue_impl_s * impl;
+} rcutils_spsc_queue_t;
+
+/// Return an empty queue struct.
+/**
+ * This function returns an empty and zero initialized queue struct, which must be
+ * initialized with rcutils_spsc_queue_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_spsc_queue_t
+rcutils_get_zero_initialized_spsc_queue(void);
+
+/// Initialize a rcutils_spsc_queue_t.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_spsc_queue_t to be initialized
+ * \param[in] capacity the least number of elements the queue holds, which must be greater
+ *   than zero and will be rounded up to the next power of 2
+ * \param[in] element_size the size of the elements, in bytes, which must be greater than zero
+ * \param[in] allocator the allocator to use for the queue and its slots
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_init(
+  rcutils_spsc_queue_t * queue,
+  size_t capacity,
+  size_t element_size,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized queue struct.
+/**
+ * The elements still in the queue are discarded.
+ * No other thread may use the queue while, nor after, it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_spsc_queue_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_fini(rcutils_spsc_queue_t * queue);
+
+/// Copy an element into the queue, unless it is full.
+/**
+ * A full queue isn't an error, so no error message is set for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, from one producer thread at a time
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_spsc_queue_t to push to
+ * \param[in] element the element_size bytes of the element
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized, or
+ * \return #RCUTILS_RET_NOT_ENOUGH_SPACE if the queue is full.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_push(rcutils_spsc_queue_t * queue, const void * element);
+
+/// Copy as many elements as fit into the queue, publishing them at once.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, from one producer thread at a time
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_spsc_queue_t to push to
+ * \param[in] elements the count contiguous elements, which may be NULL if count is zero
+ * \param[in] count the number of elements
+ * \param[out] pushed the number of elements pushed, the first ones, which is less than
+ *   count if the queue became full
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_push_many(
+  rcutils_spsc_queue_t * queue,
+  const void * elements,
+  size_t count,
+  size_t * pushed);
+
+/// Copy the oldest element out of the queue, unless it is empty.
+/**
+ * An empty queue isn't an error, so no error message is set for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, from one consumer thread at a time
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_spsc_queue_t to pop from
+ * \param[out] element the element_size bytes to copy the element to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized, or
+ * \return #RCUTILS_RET_NOT_FOUND if the queue is empty.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_pop(rcutils_spsc_queue_t * queue, void * element);
+
+/// Copy up to a number of the oldest elements out of the queue, releasing their slots at once.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes, from one consumer thread at a time
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] queue rcutils_spsc_queue_t to pop from
+ * \param[out] elements room for max_count contiguous elements, which may be NULL if
+ *   max_count is zero
+ * \param[in] max_count the most elements to pop
+ * \param[out] popped the number of elements popped, which is zero if the queue was empty
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_pop_many(
+  rcutils_spsc_queue_t * queue,
+  void * elements,
+  size_t max_count,
+  size_t * popped);
+
+/// Get the number of elements the queue holds when full.
+/**
+ * \param[in] queue rcutils_spsc_queue_t to be queried
+ * \param[out] capacity the capacity, a power of 2
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_get_capacity(const rcutils_spsc_queue_t * queue, size_t * capacity);
+
+/// Get the number of elements in the queue.
+/**
+ * The size may be out of date as soon as it is returned if the producer or the consumer
+ * use the queue meanwhile.
+ *
+ * \param[in] queue rcutils_spsc_queue_t to be queried
+ * \param[out] size the number of elements
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the queue is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_spsc_queue_get_size(const rcutils_spsc_queue_t * queue, size_t * size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__SPSC_QUEUE_H_
@@ -22,6 +22,8 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
@@ -42,8 +44,33 @@ typedef struct RCUTILS_PUBLIC_TYPE rcutils_string_array_s
 
   /// The allocator used to allocate and free memory for the string array.
   rcutils_allocator_t allocator;
+
+  /// The storage of the strings of a packed string array, or NULL.
+  /**
+   * The strings of a string array initialized with rcutils_string_array_init_packed() are
+   * stored back to back in this single allocation, instead of being allocated one by one,
+   * and are deallocated all at once with it.
+   */
+  char * arena;
+
+  /// The number of bytes in the arena.
+  size_t arena_size;
 } rcutils_string_array_t;
 
+/// A view of a string given by its first character and its length, which is not a copy of it.
+/**
+ * The characters don't need to be null terminated, and are only valid as long as the string
+ * they are a part of.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_string_view_s
+{
+  /// The first character of the string.
+  const char * data;
+
+  /// The number of characters in the string.
+  size_t length;
+} rcutils_string_view_t;
+
 /// Return an empty string array struct.
 /**
  * This function returns an empty and zero initialized string array struct.
@@ -103,13 +130,131 @@ rcutils_string_array_init(
   size_t size,
   const rcutils_allocator_t * allocator);
 
+/// Initialize a packed string array, whose strings are stored in a single allocation.
+/**
+ * This function initializes a given, zero initialized, string array to a given size, like
+ * rcutils_string_array_init(), and allocates an arena of `arena_size` bytes for its strings.
+ * The caller then writes the strings back to back into `string_array->arena` and points the
+ * entries of `string_array->data` at them, so that the whole array takes two allocations,
+ * whatever its size, and its strings are next to each other in memory.
+ * Example:
+ * ```c
+ * rcutils_allocator_t allocator = rcutils_get_default_allocator();
+ * rcutils_string_array_t string_array = rcutils_get_zero_initialized_string_array();
+ * rcutils_ret_t ret = rcutils_string_array_init_packed(&string_array, 2, 12, &allocator);
+ * if (ret != RCUTILS_RET_OK) {
+ *   // ... error handling
+ * }
+ * memcpy(string_array.arena, "Hello\0World", 12);
+ * string_array.data[0] = string_array.arena;
+ * string_array.data[1] = string_array.arena + 6;
+ * ret = rcutils_string_array_fini(&string_array);
+ * ```
+ * The strings in the arena must not be deallocated one by one, but an entry may still be
+ * replaced by a string allocated on its own, which the string array then owns as usual.
+ * \param[inout] string_array object to be initialized
+ * \param[in] size the size the array should be
+ * \param[in] arena_size the number of bytes to allocate for the strings
+ * \param[in] allocator to be used to allocate and deallocate memory
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_init_packed(
+  rcutils_string_array_t * string_array,
+  size_t size,
+  size_t arena_size,
+  const rcutils_allocator_t * allocator);
+
+/// Initialize a packed string array with copies of the given string views.
+/**
+ * This function initializes a given, zero initialized, string array like
+ * rcutils_string_array_init_packed(), with an arena fitting all the strings, and copies each
+ * view into it followed by a null terminating character, instead of duplicating the strings
+ * one by one.
+ * The whole array takes two allocations, whatever the number of strings.
+ * Example:
+ * ```c
+ * rcutils_string_view_t views[] = {{"/ns/node", 3}, {"World", 5}};
+ * rcutils_allocator_t allocator = rcutils_get_default_allocator();
+ * rcutils_string_array_t string_array = rcutils_get_zero_initialized_string_array();
+ * rcutils_ret_t ret = rcutils_string_array_init_from_views(&string_array, views, 2, &allocator);
+ * // string_array.data is {"/ns", "World"}
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] string_array object to be initialized
+ * \param[in] views the strings to copy, which may be NULL if `count` is 0
+ * \param[in] count the number of strings, which is the size of the array
+ * \param[in] allocator to be used to allocate and deallocate memory
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_init_from_views(
+  rcutils_string_array_t * string_array,
+  const rcutils_string_view_t * views,
+  size_t count,
+  const rcutils_allocator_t * allocator);
+
+/// Append copies of the given string views to a string array.
+/**
+ * The array of strings is reallocated once to fit the new entries, and the strings are copied
+ * into the arena of the string array, which is reallocated once to fit them too, or allocated
+ * if the array had none, rather than duplicated one by one.
+ * The entries which pointed into the arena are moved along with it.
+ *
+ * \par Note:
+ * If this function fails, \p string_array keeps its entries and should still be reclaimed
+ * with ::rcutils_string_array_fini.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] string_array an initialized string array to append to
+ * \param[in] views the strings to copy, which may be NULL if `count` is 0
+ * \param[in] count the number of strings to append
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_append_views(
+  rcutils_string_array_t * string_array,
+  const rcutils_string_view_t * views,
+  size_t count);
+
 /// Finalize a string array, reclaiming all resources.
 /**
  * This function reclaims any memory owned by the string array, including the
  * strings it references.
  *
  * The allocator used to initialize the string array is used to deallocate each
- * string in the array and the array of strings itself.
+ * string in the array and the array of strings itself, or the arena holding the
+ * strings of a packed string array.
  *
  * \param[inout] string_array object to be finalized
  * \return #RCUTILS_RET_OK if successful, or
@@ -143,6 +288,66 @@ rcutils_string_array_cmp(
   const rcutils_string_array_t * rhs,
   int * res);
 
+/// Check whether two string arrays hold the same strings in the same order.
+/**
+ * Unlike rcutils_string_array_cmp(), which orders the arrays, this only tells whether they are
+ * equal, so arrays of different sizes are told apart at once, and entries pointing at the
+ * same string aren't read.
+ * Empty entries are only equal to empty entries.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] lhs The first string array.
+ * \param[in] rhs The second string array.
+ * \param[out] equal `true` if the arrays are equal, `false` otherwise
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any argument is `NULL`, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if `lhs->data` or `rhs->data` is `NULL` while the
+ *   array isn't empty.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_equal(
+  const rcutils_string_array_t * lhs,
+  const rcutils_string_array_t * rhs,
+  bool * equal);
+
+/// Hash the strings of a string array, in order.
+/**
+ * Equal string arrays, see rcutils_string_array_equal(), have the same hash, which mixes the
+ * size of the array with the length and rcutils_hash_map_string_fast_hashn() of each string,
+ * so that arrays whose hashes differ are known to differ without comparing their strings.
+ * Hashing reads all the strings, which takes longer than comparing them with
+ * rcutils_string_array_equal(), so this is for telling whether a list of strings changed, e.g.
+ * the names of topics, without keeping a copy of it, or for using it as a key.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] string_array The string array to hash.
+ * \param[out] hash The hash of the string array.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any argument is `NULL`, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if `string_array->data` is `NULL` while the array
+ *   isn't empty.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_hash(const rcutils_string_array_t * string_array, size_t * hash);
+
 /// Resize a string array, reclaiming removed resources.
 /**
  * This function changes the size of an existing string array.
@@ -172,6 +377,50 @@ rcutils_string_array_resize(
   rcutils_string_array_t * string_array,
   size_t new_size);
 
+/// Give back the memory of the arena of a packed string array which is no longer used.
+/**
+ * A string array has no capacity beyond its size, but the entries of a string
+ * array initialized with rcutils_string_array_init_packed() may have been
+ * replaced since, leaving strings in its arena which nothing points to.
+ * This function copies the strings still pointed to into an arena which fits
+ * them, or deallocates the arena if there are none, and points the entries at
+ * their copies.
+ * Nothing is done for a string array without an arena.
+ *
+ * \param[inout] string_array object to be shrunk.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, in which case the
+ *   string array is left unchanged, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_shrink_to_fit(rcutils_string_array_t * string_array);
+
+/// Get the number of bytes a string array allocated.
+/**
+ * This function adds up the size of the array of strings, of the arena of a
+ * packed string array, and of the strings allocated on their own, so that the
+ * memory of a process can be attributed to the structures holding it.
+ * The strings are measured by their length including the terminating null
+ * character, which is what rcutils_strdup() allocates for them, and so takes
+ * time linear in their total length.
+ * What the allocator spends on top of that for its bookkeeping isn't known.
+ *
+ * \param[in] string_array object to be queried.
+ * \param[out] allocated_size the number of bytes allocated for the string array.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_get_allocated_size(
+  const rcutils_string_array_t * string_array, size_t * allocated_size);
+
 /// Lexicographic comparer for pointers to string pointers.
 /**
  * This functions compares pointers to string pointers lexicographically
@@ -194,25 +443,18 @@ rcutils_string_array_sort_compare(const void * lhs, const void * rhs);
  * they are in lexicographically ascending order.
  * Empty entries are placed at the end of the array.
  *
+ * The strings are sorted with multikey quicksort, which compares each character of the
+ * prefixes shared by many strings once, instead of once per comparison of two strings.
+ *
  * \param[inout] string_array object whose elements should be sorted.
  * \return #RCUTILS_RET_OK if successful, or
  * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
  * \return #RCUTILS_RET_ERROR if an unknown error occurs.
  */
-inline
+RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t
-rcutils_string_array_sort(rcutils_string_array_t * string_array)
-{
-  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
-    string_array, "string_array is null", return RCUTILS_RET_INVALID_ARGUMENT);
-
-  return rcutils_qsort(
-    string_array->data,
-    string_array->size,
-    sizeof(string_array->data[0]),
-    rcutils_string_array_sort_compare);
-}
+rcutils_string_array_sort(rcutils_string_array_t * string_array);
 
 #ifdef __cplusplus
 }
@@ -26,6 +26,7 @@ extern "C"
 
 #include "rcutils/allocator.h"
 #include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/string_pool.h"
 #include "rcutils/macros.h"
 #include "rcutils/visibility_control.h"
 
@@ -102,6 +103,36 @@ rcutils_string_map_init(
   size_t initial_capacity,
   rcutils_allocator_t allocator);
 
+/// Initialize a rcutils_string_map_t whose keys are interned in a string pool.
+/**
+ * This function is like rcutils_string_map_init(), except that the keys are
+ * interned in the given string pool instead of being copied with the
+ * allocator, so that maps with the same keys share a single copy of each,
+ * and a key which is unset and set again is not copied again.
+ * The values are still copied with the allocator.
+ *
+ * The string pool must stay initialized as long as the map, or any map which
+ * shares its storage after rcutils_string_map_copy_shared(), is used.
+ *
+ * \param[inout] string_map rcutils_string_map_t to be initialized
+ * \param[in] initial_capacity the amount of initial capacity for the string map
+ * \param[in] allocator the allocator to use through out the lifetime of the map
+ * \param[in] string_pool the initialized string pool to intern the keys in
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_STRING_MAP_ALREADY_INIT if already initialized, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_map_init_with_string_pool(
+  rcutils_string_map_t * string_map,
+  size_t initial_capacity,
+  rcutils_allocator_t allocator,
+  rcutils_string_pool_t * string_pool);
+
 /// Finalize the previously initialized string map struct.
 /**
  * This function will free any resources which were created when initializing
@@ -185,6 +216,54 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_string_map_reserve(rcutils_string_map_t * string_map, size_t capacity);
 
+/// Reduce the capacity of the map to its size.
+/**
+ * Setting key value pairs only ever grows the capacity of the map, so after a
+ * burst of keys which were unset again, e.g. at startup, this function gives
+ * back the memory of the unused capacity and shrinks the index with it, as
+ * rcutils_string_map_reserve() does with the size of the map.
+ * The storage of a map which shares it after rcutils_string_map_copy_shared()
+ * is left as is, since it is already allocated to fit, and copying it would
+ * take more memory.
+ *
+ * \param[inout] string_map rcutils_string_map_t to be shrunk
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_STRING_MAP_INVALID if the string map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_map_shrink_to_fit(rcutils_string_map_t * string_map);
+
+/// Get the number of bytes the string map allocated.
+/**
+ * This function adds up the sizes requested from the allocator of the map,
+ * for its implementation, its key value pairs and their index, and the keys
+ * and values themselves, so that the memory of a process can be attributed to
+ * the structures holding it.
+ * Keys interned in a string pool belong to the pool and aren't included.
+ * Storage shared after rcutils_string_map_copy_shared() is included in the
+ * size of each map sharing it.
+ * What the allocator spends on top of that for its bookkeeping isn't known.
+ * The values are measured, so this takes time linear in the capacity and in
+ * the length of the values.
+ *
+ * \param[in] string_map rcutils_string_map_t to be queried
+ * \param[out] allocated_size the number of bytes allocated for the map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_STRING_MAP_INVALID if the string map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_map_get_allocated_size(
+  const rcutils_string_map_t * string_map, size_t * allocated_size);
+
 /// Remove all key value pairs from the map.
 /**
  * This function will remove all key value pairs from the map, and it will
@@ -436,6 +515,42 @@ rcutils_string_map_copy(
   const rcutils_string_map_t * src_string_map,
   rcutils_string_map_t * dst_string_map);
 
+/// Copy all the key value pairs from one map into another, sharing their storage if possible.
+/**
+ * If the destination string map is empty, then instead of copying the keys
+ * and values, the destination map shares them with the source map, which
+ * first moves them, along with its internal storage, into a single shared
+ * allocation.
+ * Either map copies the shared storage into storage of its own only when it
+ * is modified, so that making copies which are only read, or mostly read, is
+ * cheap.
+ * The shared storage is deallocated with the last map using it.
+ *
+ * Since the keys and values of the source map may be moved, the pointers
+ * previously returned by rcutils_string_map_get() and
+ * rcutils_string_map_get_next_key() for it become invalid, as if it had been
+ * modified.
+ * Maps which share storage may be used from different threads, though each
+ * map on its own is still not thread-safe.
+ *
+ * If the destination string map is not empty, then this behaves like
+ * rcutils_string_map_copy().
+ *
+ * \param[inout] src_string_map rcutils_string_map_t to be copied from
+ * \param[inout] dst_string_map rcutils_string_map_t to be copied to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_STRING_MAP_INVALID if the string map is invalid, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_map_copy_shared(
+  rcutils_string_map_t * src_string_map,
+  rcutils_string_map_t * dst_string_map);
+
 #ifdef __cplusplus
 }
 #endif
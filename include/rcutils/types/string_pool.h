@@ -0,0 +1,198 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__STRING_POOL_H_
+#define RCUTILS__TYPES__STRING_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+struct rcutils_string_pool_impl_s;
+
+/// A pool of interned strings, which holds a single copy of each distinct string.
+/**
+ * Interning a string returns the pointer to the copy of it in the pool, so
+ * that two strings interned in the same pool are equal if and only if the
+ * pointers are, along with the hash of the string, as computed by
+ * rcutils_hash_map_string_fast_hashn().
+ * That is the hash of rcutils_hash_map_string_fast_hash_func(), so it can be
+ * given to the `_with_hash` functions of a rcutils_hash_map_t using it.
+ *
+ * The interned strings are never moved nor deallocated before the pool is
+ * finalized.
+ * Strings may be interned from many threads at once.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_string_pool_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_string_pool_impl_s * impl;
+} rcutils_string_pool_t;
+
+/// Return an empty string pool struct.
+/**
+ * This function returns an empty and zero initialized string pool struct,
+ * which must be initialized with rcutils_string_pool_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_string_pool_t
+rcutils_get_zero_initialized_string_pool(void);
+
+/// Initialize a rcutils_string_pool_t.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] string_pool rcutils_string_pool_t to be initialized
+ * \param[in] allocator the allocator to use through out the lifetime of the string_pool
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_pool_init(
+  rcutils_string_pool_t * string_pool,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized string_pool struct.
+/**
+ * This deallocates all the interned strings, so none of them may be used
+ * afterwards, and no other thread may use the string_pool while, nor after,
+ * it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] string_pool rcutils_string_pool_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_pool_fini(rcutils_string_pool_t * string_pool);
+
+/// Get the number of distinct strings in the string_pool.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] string_pool rcutils_string_pool_t to be queried
+ * \param[out] size the number of strings in the string_pool
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the string_pool is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_pool_get_size(const rcutils_string_pool_t * string_pool, size_t * size);
+
+/// Intern a string, copying it into the string_pool unless an equal string already is.
+/**
+ * The string is looked up while holding a lock which is shared with other
+ * lookups, so only interning a new string waits for the other threads.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] string_pool rcutils_string_pool_t to intern the string in
+ * \param[in] string the null terminated string to be interned
+ * \param[out] interned_string the interned string, equal to string
+ * \param[out] hash the hash of the string, or NULL if it isn't needed
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the string_pool is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_pool_intern(
+  rcutils_string_pool_t * string_pool,
+  const char * string,
+  const char ** interned_string,
+  size_t * hash);
+
+/// Intern the first string_length characters of a string, as with rcutils_string_pool_intern().
+/**
+ * The string does not need to be null terminated, but the interned string is.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] string_pool rcutils_string_pool_t to intern the string in
+ * \param[in] string the characters to be interned, none of which may be a null character
+ * \param[in] string_length the number of characters to be interned
+ * \param[out] interned_string the interned string
+ * \param[out] hash the hash of the string, or NULL if it isn't needed
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the string_pool is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_pool_internn(
+  rcutils_string_pool_t * string_pool,
+  const char * string,
+  size_t string_length,
+  const char ** interned_string,
+  size_t * hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__STRING_POOL_H_
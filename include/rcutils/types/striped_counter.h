@@ -0,0 +1,215 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__STRIPED_COUNTER_H_
+#define RCUTILS__TYPES__STRIPED_COUNTER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+/// How the stripe a thread adds to is chosen.
+typedef enum rcutils_striped_counter_mode_e
+{
+  /// Each thread is assigned a stripe on its first addition, round robin.
+  /**
+   * Threads never move to another stripe, so with at least as many stripes as threads
+   * adding at once, each stripe is only written by one thread.
+   */
+  RCUTILS_STRIPED_COUNTER_PER_THREAD = 0,
+  /// Each addition goes to the stripe of the processor the thread is running on.
+  /**
+   * This suits many short-lived threads, or many more threads than processors.
+   * It reads the current processor with `sched_getcpu()` on Linux, or
+   * `GetCurrentProcessorNumber()` on Windows, and is the same as
+   * #RCUTILS_STRIPED_COUNTER_PER_THREAD elsewhere.
+   */
+  RCUTILS_STRIPED_COUNTER_PER_CPU = 1,
+} rcutils_striped_counter_mode_t;
+
+struct rcutils_striped_counter_impl_s;
+
+/// A set of 64 bit counters, which threads add to without sharing cache lines.
+/**
+ * Each counter is split into stripes, each on cache lines of its own, which a thread adds to
+ * with an uncontended atomic addition, and which are summed when the counter is read.
+ * This suits statistics bumped from many threads and read rarely, for which a single atomic
+ * counter would bounce its cache line between the processors.
+ *
+ * Counters wrap around, so adding the two's complement of a value subtracts it.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_striped_counter_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_striped_counter_impl_s * impl;
+} rcutils_striped_counter_t;
+
+/// Return an empty striped counter struct.
+/**
+ * This function returns an empty and zero initialized striped counter struct, which must be
+ * initialized with rcutils_striped_counter_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_striped_counter_t
+rcutils_get_zero_initialized_striped_counter(void);
+
+/// Initialize a rcutils_striped_counter_t with all its counters at zero.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] counter rcutils_striped_counter_t to be initialized
+ * \param[in] counter_count the number of counters, which must be greater than zero
+ * \param[in] stripe_count the least number of stripes, which is rounded up to the next power
+ *   of 2, or zero for the number of processors
+ * \param[in] mode how threads choose their stripe
+ * \param[in] allocator the allocator to use for the stripes
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_striped_counter_init(
+  rcutils_striped_counter_t * counter,
+  size_t counter_count,
+  size_t stripe_count,
+  rcutils_striped_counter_mode_t mode,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized striped counter struct.
+/**
+ * No other thread may use the counter while, nor after, it is finalized.
+ *
+ * \param[inout] counter rcutils_striped_counter_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_striped_counter_fini(rcutils_striped_counter_t * counter);
+
+/// Add a value to one of the counters, in the stripe of the calling thread.
+/**
+ * Nothing is checked, to keep this cheap: the counter must be initialized, and index must be
+ * less than its number of counters.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] counter rcutils_striped_counter_t to add to
+ * \param[in] index the index of the counter
+ * \param[in] value the value to add
+ */
+RCUTILS_PUBLIC
+void
+rcutils_striped_counter_add(rcutils_striped_counter_t * counter, size_t index, uint64_t value);
+
+/// Get the value of one of the counters, summing its stripes.
+/**
+ * Additions made meanwhile by other threads may or may not be included.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] counter rcutils_striped_counter_t to be queried
+ * \param[in] index the index of the counter
+ * \param[out] value the value of the counter
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the counter is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_striped_counter_get(
+  const rcutils_striped_counter_t * counter, size_t index, uint64_t * value);
+
+/// Get the values of all the counters, summing the stripes in a single pass.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] counter rcutils_striped_counter_t to be queried
+ * \param[out] values room for as many values as there are counters
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the counter is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_striped_counter_get_all(const rcutils_striped_counter_t * counter, uint64_t * values);
+
+/// Set all the counters back to zero.
+/**
+ * Each addition made meanwhile by other threads is either cleared or kept entirely.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] counter rcutils_striped_counter_t to be reset
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the counter is not initialized.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_striped_counter_reset(rcutils_striped_counter_t * counter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__STRIPED_COUNTER_H_
@@ -114,6 +114,65 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_uint8_array_resize(rcutils_uint8_array_t * uint8_array, size_t new_size);
 
+/// A non-owning view of a contiguous range of bytes, e.g. of a rcutils_uint8_array_t.
+/**
+ * A view doesn't allocate nor deallocate anything, so it can be passed around by value
+ * instead of copying the bytes, as long as the storage it refers to outlives it and is not
+ * reallocated, e.g. by rcutils_uint8_array_resize().
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_uint8_array_view_s
+{
+  /// The first byte of the view, which may be NULL if the view is empty.
+  const uint8_t * buffer;
+
+  /// The number of bytes in the view.
+  size_t buffer_length;
+} rcutils_uint8_array_view_t;
+
+/// Get a view of a range of the valid elements of a uint8 array.
+/**
+ * The range must be within the first `buffer_length` bytes of the uint8 array.
+ * No bytes are copied.
+ *
+ * \param[in] uint8_array the uint8 array to get a view of
+ * \param[in] offset the index of the first byte of the view
+ * \param[in] length the number of bytes in the view
+ * \param[out] view the view of the bytes
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid, or if the range
+ *   isn't within the valid elements of the uint8 array.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_uint8_array_get_view(
+  const rcutils_uint8_array_t * uint8_array,
+  size_t offset,
+  size_t length,
+  rcutils_uint8_array_view_t * view);
+
+/// Get a view of a range of the bytes of another view.
+/**
+ * The range must be within the bytes of the view, and the resulting view refers to the same
+ * storage as the view it was taken from.
+ *
+ * \param[in] view the view to get a part of
+ * \param[in] offset the index of the first byte of the slice, relative to the view
+ * \param[in] length the number of bytes in the slice
+ * \param[out] slice the view of the bytes, which may be the same as view
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if any arguments are invalid, or if the range
+ *   isn't within the view.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_uint8_array_view_slice(
+  const rcutils_uint8_array_view_t * view,
+  size_t offset,
+  size_t length,
+  rcutils_uint8_array_view_t * slice);
+
 #if __cplusplus
 }
 #endif
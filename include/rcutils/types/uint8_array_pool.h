@@ -0,0 +1,182 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__TYPES__UINT8_ARRAY_POOL_H_
+#define RCUTILS__TYPES__UINT8_ARRAY_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/uint8_array.h"
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+/// The smallest capacity of the buffers of the uint8 arrays acquired from a pool.
+#define RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY 64
+
+struct rcutils_uint8_array_pool_impl_s;
+
+/// A pool of buffers for rcutils_uint8_array_t, which are reused instead of reallocated.
+/**
+ * The buffers are grouped by size class, each class holding the buffers whose capacity is
+ * at least a power of two and less than the next one.
+ * Acquiring a uint8 array takes a buffer of the class of the requested capacity, rounded up
+ * to a power of two, from the pool, and releasing it gives it back, so that passing a
+ * message through a uint8 array doesn't allocate once the pool holds buffers of its size.
+ *
+ * The uint8 arrays acquired from a pool are ordinary uint8 arrays using the allocator of the
+ * pool, which may be resized or finalized as usual, even after the pool is finalized.
+ * Uint8 arrays may be acquired and released from many threads at once.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_uint8_array_pool_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_uint8_array_pool_impl_s * impl;
+} rcutils_uint8_array_pool_t;
+
+/// Return an empty uint8 array pool struct.
+/**
+ * This function returns an empty and zero initialized uint8 array pool struct,
+ * which must be initialized with rcutils_uint8_array_pool_init().
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_uint8_array_pool_t
+rcutils_get_zero_initialized_uint8_array_pool(void);
+
+/// Initialize a rcutils_uint8_array_pool_t.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] pool rcutils_uint8_array_pool_t to be initialized
+ * \param[in] max_buffers_per_class the most buffers kept in each size class, beyond which
+ *   released buffers are deallocated
+ * \param[in] allocator the allocator to use for the pool and the buffers of its uint8 arrays
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_uint8_array_pool_init(
+  rcutils_uint8_array_pool_t * pool,
+  size_t max_buffers_per_class,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize the previously initialized uint8 array pool struct.
+/**
+ * This deallocates the buffers held by the pool.
+ * The uint8 arrays acquired from the pool and not released stay valid, and must be
+ * finalized with rcutils_uint8_array_fini().
+ * No other thread may use the pool while, nor after, it is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] pool rcutils_uint8_array_pool_t to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_uint8_array_pool_fini(rcutils_uint8_array_pool_t * pool);
+
+/// Initialize a uint8 array with a buffer from the pool.
+/**
+ * The uint8 array gets a buffer of at least the given capacity, and at least
+ * #RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY, which is only allocated if the pool holds none
+ * of its size class.
+ * Its `buffer_length` is zero and the contents of the buffer are unspecified.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] pool rcutils_uint8_array_pool_t to acquire the buffer from
+ * \param[in] capacity the least capacity of the buffer
+ * \param[out] uint8_array zero initialized uint8 array to be initialized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the pool is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_uint8_array_pool_acquire(
+  rcutils_uint8_array_pool_t * pool,
+  size_t capacity,
+  rcutils_uint8_array_t * uint8_array);
+
+/// Finalize a uint8 array, giving its buffer back to the pool.
+/**
+ * The uint8 array doesn't have to come from the pool, but its buffer is only kept if it was
+ * allocated with the allocator of the pool, is at least
+ * #RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY bytes large, and the pool doesn't hold the most
+ * buffers of its size class yet.
+ * Otherwise, the uint8 array is finalized with rcutils_uint8_array_fini().
+ * Either way, the uint8 array is zero initialized afterwards.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] pool rcutils_uint8_array_pool_t to give the buffer back to
+ * \param[inout] uint8_array the uint8 array to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the pool is invalid.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_uint8_array_pool_release(
+  rcutils_uint8_array_pool_t * pool,
+  rcutils_uint8_array_t * uint8_array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TYPES__UINT8_ARRAY_POOL_H_
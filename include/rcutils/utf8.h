@@ -0,0 +1,100 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__UTF8_H_
+#define RCUTILS__UTF8_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/types/char_array.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// Return the index of the first byte of a string which isn't part of valid UTF-8.
+/**
+ * Valid UTF-8 is as defined by RFC 3629: overlong encodings, surrogates and
+ * code points above U+10FFFF are invalid, as is a sequence cut short by the
+ * end of the string.
+ * On x86 processors with AVX2, 32 bytes are validated at once with lookup
+ * tables of the first two bytes of each sequence, otherwise 8 bytes of ASCII
+ * are skipped at once and the other sequences decoded one after the other.
+ *
+ * The string doesn't need to be null terminated, and null characters within
+ * the given length are valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] str string to validate
+ * \param[in] length length of the string to validate, in bytes
+ * \return the index of the first byte of the first invalid sequence, or
+ * \return `0` if the string is `NULL` and the length is not zero, or
+ * \return `SIZE_MAX` if the string is valid UTF-8, including an empty string.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t
+rcutils_utf8_validate(const char * str, size_t length);
+
+/// Append a string to a char array, replacing its invalid UTF-8 with U+FFFD.
+/**
+ * Each maximal invalid subpart of the string, as defined by the Unicode
+ * standard, is replaced by the replacement character U+FFFD, i.e. the bytes
+ * `EF BF BD`, which is what most decoders do.
+ * For example, `"a\xF0\x9F\x98z"` becomes `"a\xEF\xBF\xBDz"`, while
+ * `"a\xC0\xAFz"` becomes `"a\xEF\xBF\xBD\xEF\xBF\xBDz"` since `C0` never
+ * starts a valid sequence.
+ * A valid string is appended with a single copy after it was validated with
+ * rcutils_utf8_validate().
+ *
+ * The string must not point into the char array, which may be reallocated.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] str string to sanitize, which needn't be null terminated, and may be `NULL` if
+ *   `length` is 0
+ * \param[in] length length of the string, in bytes
+ * \param[inout] output the char array to append the sanitized string to
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_utf8_sanitize(const char * str, size_t length, rcutils_char_array_t * output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__UTF8_H_
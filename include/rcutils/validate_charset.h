@@ -0,0 +1,85 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+
+#ifndef RCUTILS__VALIDATE_CHARSET_H_
+#define RCUTILS__VALIDATE_CHARSET_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/visibility_control.h"
+
+/// The characters '0' to '9'.
+#define RCUTILS_CHARSET_DIGIT (1u << 0)
+/// The characters 'A' to 'Z'.
+#define RCUTILS_CHARSET_UPPER (1u << 1)
+/// The characters 'a' to 'z'.
+#define RCUTILS_CHARSET_LOWER (1u << 2)
+/// The character '_'.
+#define RCUTILS_CHARSET_UNDERSCORE (1u << 3)
+/// The character '/'.
+#define RCUTILS_CHARSET_FORWARD_SLASH (1u << 4)
+/// The character '~'.
+#define RCUTILS_CHARSET_TILDE (1u << 5)
+/// The characters '{' and '}'.
+#define RCUTILS_CHARSET_CURLY_BRACES (1u << 6)
+/// The character '.'.
+#define RCUTILS_CHARSET_PERIOD (1u << 7)
+/// The characters accepted by rcutils_isalnum_no_locale().
+#define RCUTILS_CHARSET_ALNUM \
+  (RCUTILS_CHARSET_DIGIT | RCUTILS_CHARSET_UPPER | RCUTILS_CHARSET_LOWER)
+
+/// Return the index of the first character of a string which is in none of the given classes.
+/**
+ * This validates a whole name at once, e.g. a node name made of #RCUTILS_CHARSET_ALNUM and
+ * #RCUTILS_CHARSET_UNDERSCORE characters, instead of checking every character with
+ * rcutils_isalnum_no_locale() and the like.
+ * The classes are ASCII only and not affected by locale.
+ * Every character is checked with a single lookup in a table of the classes of all characters,
+ * whichever and however many classes are given.
+ *
+ * The string doesn't need to be null terminated, but a null character within the given length
+ * is in no class and therefore invalid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] str string to validate
+ * \param[in] string_length length of the string to validate
+ * \param[in] class_mask bitwise or of the `RCUTILS_CHARSET_*` classes of the valid characters
+ * \return the index of the first invalid character, or
+ * \return `0` if the string is `NULL` and the length is not zero, or
+ * \return `SIZE_MAX` if every character is valid, including for an empty string.
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_validate_charset(const char * str, size_t string_length, uint32_t class_mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__VALIDATE_CHARSET_H_
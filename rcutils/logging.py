@@ -27,6 +27,10 @@ name_params = OrderedDict((
 ))
 name_args = {'name': 'name'}
 name_doc_lines = []
+handle_params = OrderedDict((
+    ('handle', 'The logger handle, see rcutils_logging_get_logger_handle()'),
+))
+handle_args = {'name': 'handle'}
 once_args = {
     'condition_before': 'RCUTILS_LOG_CONDITION_ONCE_BEFORE',
     'condition_after': 'RCUTILS_LOG_CONDITION_ONCE_AFTER'}
@@ -64,6 +68,22 @@ throttle_args = {
 throttle_doc_lines = [
     'Log calls are being ignored if the last logged message is not longer ago than the specified '
     'duration.']
+sampled_params = OrderedDict((
+    ('n', 'Log one in this many calls, all of them if it is 0 or 1.'),
+))
+sampled_args = {
+    'condition_before': 'RCUTILS_LOG_CONDITION_SAMPLED_BEFORE(n)',
+    'condition_after': 'RCUTILS_LOG_CONDITION_SAMPLED_AFTER'}
+sampled_doc_lines = [
+    'Only the first and then every n-th log call is being processed.']
+sampled_prob_params = OrderedDict((
+    ('probability', 'The probability between 0 and 1 with which each call is being logged.'),
+))
+sampled_prob_args = {
+    'condition_before': 'RCUTILS_LOG_CONDITION_SAMPLED_PROB_BEFORE(probability)',
+    'condition_after': 'RCUTILS_LOG_CONDITION_SAMPLED_PROB_AFTER'}
+sampled_prob_doc_lines = [
+    'Log calls are being ignored at random, except with the given probability.']
 
 
 def get_suffix_from_features(features):
@@ -77,10 +97,16 @@ def get_suffix_from_features(features):
         suffix += '_SKIPFIRST'
     if 'throttle' in features:
         suffix += '_THROTTLE'
+    if 'sampled' in features:
+        suffix += '_SAMPLED'
+    if 'sampled_prob' in features:
+        suffix += '_SAMPLED_PROB'
     if 'once' in features:
         suffix += '_ONCE'
     if 'named' in features:
         suffix += '_NAMED'
+    if 'handle' in features:
+        suffix += '_HANDLE'
 
     return suffix
 
@@ -169,9 +195,51 @@ feature_combinations = OrderedDict((
             }, **name_args
         },
         doc_lines=skipfirst_doc_lines + throttle_doc_lines + name_doc_lines)),
+    (('sampled', ), Feature(
+        params=sampled_params,
+        args=sampled_args,
+        doc_lines=sampled_doc_lines)),
+    (('sampled', 'named'), Feature(
+        params=OrderedDict((*sampled_params.items(), *name_params.items())),
+        args={**sampled_args, **name_args},
+        doc_lines=sampled_doc_lines + name_doc_lines)),
+    (('sampled_prob', ), Feature(
+        params=sampled_prob_params,
+        args=sampled_prob_args,
+        doc_lines=sampled_prob_doc_lines)),
+    (('sampled_prob', 'named'), Feature(
+        params=OrderedDict((*sampled_prob_params.items(), *name_params.items())),
+        args={**sampled_prob_args, **name_args},
+        doc_lines=sampled_prob_doc_lines + name_doc_lines)),
 ))
 
 
+def _get_handle_feature(named_feature):
+    params = OrderedDict()
+    for k, v in named_feature.params.items():
+        if k == 'name':
+            params.update(handle_params)
+        else:
+            params[k] = v
+    return Feature(
+        params=params,
+        args={**named_feature.args, **handle_args},
+        doc_lines=named_feature.doc_lines)
+
+
+# Every named macro has a variant logging through a logger handle instead of a name.
+for features, feature in list(feature_combinations.items()):
+    if 'named' in features:
+        feature_combinations[tuple('handle' if f == 'named' else f for f in features)] = \
+            _get_handle_feature(feature)
+
+
+def get_base_macro(feature_combination):
+    if 'handle' in feature_combination:
+        return 'RCUTILS_LOG_COND_HANDLE'
+    return 'RCUTILS_LOG_COND_NAMED'
+
+
 def get_macro_parameters(feature_combination):
     return feature_combinations[feature_combination].params
 
@@ -31,6 +31,15 @@
   #define RCUTILS_CAST_DURATION(x) ((rcutils_duration_value_t)x)
 #endif
 
+// In C++ the hash of logger names which are string literals is computed at compile time.
+#ifdef __cplusplus
+  #define RCUTILS_LOGGING_CALLSITE_IS_ENABLED_FOR(cache, name, severity) \
+  (rcutils_logging_callsite_checker<decltype(name)>::is_enabled_for(cache, name, severity))
+#else
+  #define RCUTILS_LOGGING_CALLSITE_IS_ENABLED_FOR(cache, name, severity) \
+  rcutils_logging_callsite_is_enabled_for(cache, name, severity)
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -54,7 +63,29 @@ extern "C"
 #define RCUTILS_LOG_MIN_SEVERITY RCUTILS_LOG_MIN_SEVERITY_DEBUG
 #endif
 
-// TODO(dhood): optimise severity check via notifyLoggerLevelsChanged concept or similar.
+/**
+ * \def RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS
+ * Define RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS to a list of
+ * `{"logger name", RCUTILS_LOG_MIN_SEVERITY_[DEBUG|INFO|WARN|ERROR|FATAL|NONE]}`
+ * in your build options, or before including this header in a source file, to compile out the
+ * statements of these loggers and their descendants below those severities, e.g.
+ * `{"planner", RCUTILS_LOG_MIN_SEVERITY_NONE}, {"planner.safety", RCUTILS_LOG_MIN_SEVERITY_DEBUG}`
+ * removes all statements of the logger `planner` and its descendants but those of
+ * `planner.safety`, whose levels can still be set at runtime.
+ * Like the levels of loggers at runtime, the longest matching logger name applies.
+ *
+ * This only applies in C++, to the statements whose logger name is a string literal, and it
+ * comes on top of RCUTILS_LOG_MIN_SEVERITY.
+ * The statements compiled out are still parsed, but compilers remove them when optimizing.
+ */
+#if defined(__cplusplus) && defined(RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS)
+  #define RCUTILS_LOGGING_IS_COMPILED_OUT(name, severity) \
+  (rcutils_logging_compile_time_filter<decltype(name)>::is_compiled_out( \
+    name, severity, {RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS}))
+#else
+  #define RCUTILS_LOGGING_IS_COMPILED_OUT(name, severity) (false)
+#endif
+
 // The RCUTILS_LOG_COND_NAMED macro is surrounded by do { .. } while (0) to implement
 // the standard C macro idiom to make the macro safe in all contexts; see
 // http://c-faq.com/cpp/multistmt.html for more information.
@@ -64,6 +95,12 @@ extern "C"
  *
  * \note The condition will only be evaluated if this logging statement is enabled.
  *
+ * Severities below the level of all loggers are skipped with a single load and
+ * compare, see rcutils_logging_is_below_uniform_level().
+ * Otherwise whether the statement is enabled is cached per callsite until any
+ * logger level changes, see rcutils_logging_callsite_is_enabled_for().
+ * Statements compiled out by RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS are skipped entirely.
+ *
  * \param[in] severity The severity level
  * \param[in] condition_before The condition macro(s) inserted before the log call
  * \param[in] condition_after The condition macro(s) inserted after the log call
@@ -72,15 +109,55 @@ extern "C"
  */
 #define RCUTILS_LOG_COND_NAMED(severity, condition_before, condition_after, name, ...) \
   do { \
+    if (RCUTILS_LOGGING_IS_COMPILED_OUT(name, severity)) { \
+      break; \
+    } \
     RCUTILS_LOGGING_AUTOINIT; \
     static rcutils_log_location_t __rcutils_logging_location = {__func__, __FILE__, __LINE__}; \
-    if (rcutils_logging_logger_is_enabled_for(name, severity)) { \
+    static rcutils_log_callsite_cache_t __rcutils_logging_callsite_cache = \
+      RCUTILS_LOG_CALLSITE_CACHE_INITIALIZER; \
+    if (!rcutils_logging_is_below_uniform_level(severity) && \
+      RCUTILS_LOGGING_CALLSITE_IS_ENABLED_FOR( \
+        &__rcutils_logging_callsite_cache, name, severity)) \
+    { \
       condition_before \
       rcutils_log_internal(&__rcutils_logging_location, severity, name, __VA_ARGS__); \
       condition_after \
     } \
   } while (0)
 
+/**
+ * \def RCUTILS_LOG_COND_HANDLE
+ * The logging macro all logging macros using a logger handle call.
+ *
+ * \note The condition will only be evaluated if this logging statement is enabled.
+ *
+ * Severities below the level of all loggers are skipped with a single load and
+ * compare, see rcutils_logging_is_below_uniform_level().
+ * Otherwise whether the statement is enabled is cached in the handle until any
+ * logger level changes, see rcutils_logging_logger_handle_is_enabled_for().
+ *
+ * \param[in] severity The severity level
+ * \param[in] condition_before The condition macro(s) inserted before the log call
+ * \param[in] condition_after The condition macro(s) inserted after the log call
+ * \param[in] handle The logger handle, see rcutils_logging_get_logger_handle()
+ * \param[in] ... The format string, followed by the variable arguments for the format string
+ */
+#define RCUTILS_LOG_COND_HANDLE(severity, condition_before, condition_after, handle, ...) \
+  do { \
+    static rcutils_log_location_t __rcutils_logging_location = {__func__, __FILE__, __LINE__}; \
+    rcutils_logger_handle_t * const __rcutils_logging_handle = (handle); \
+    if (!rcutils_logging_is_below_uniform_level(severity) && \
+      rcutils_logging_logger_handle_is_enabled_for(__rcutils_logging_handle, severity)) \
+    { \
+      condition_before \
+      rcutils_log_internal( \
+        &__rcutils_logging_location, severity, \
+        rcutils_logging_get_logger_handle_name(__rcutils_logging_handle), __VA_ARGS__); \
+      condition_after \
+    } \
+  } while (0)
+
 ///@@{
 /**
  * \def RCUTILS_LOG_CONDITION_EMPTY
@@ -97,12 +174,16 @@ extern "C"
 /**
  * \def RCUTILS_LOG_CONDITION_ONCE_BEFORE
  * A macro initializing and checking the `once` condition.
+ *
+ * Exactly one evaluation logs, even if the first ones happen concurrently.
  */
 #define RCUTILS_LOG_CONDITION_ONCE_BEFORE \
   { \
-    static int __rcutils_logging_once = 0; \
-    if (RCUTILS_UNLIKELY(0 == __rcutils_logging_once)) { \
-      __rcutils_logging_once = 1;
+    static uint32_t __rcutils_logging_once = 0u; \
+    if (RCUTILS_UNLIKELY( \
+        0u == RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&__rcutils_logging_once)) && \
+      rcutils_logging_claim_first_evaluation(&__rcutils_logging_once)) \
+    {
 /**
  * \def RCUTILS_LOG_CONDITION_ONCE_AFTER
  * A macro finalizing the `once` condition.
@@ -157,13 +238,16 @@ typedef bool (* RclLogFilter)();
 /**
  * \def RCUTILS_LOG_CONDITION_SKIPFIRST_BEFORE
  * A macro initializing and checking the `skipfirst` condition.
+ *
+ * Exactly one evaluation is skipped, even if the first ones happen concurrently.
  */
 #define RCUTILS_LOG_CONDITION_SKIPFIRST_BEFORE \
   { \
-    static bool __rcutils_logging_first = true; \
-    if (RCUTILS_UNLIKELY(true == __rcutils_logging_first)) { \
-      __rcutils_logging_first = false; \
-    } else {
+    static uint32_t __rcutils_logging_first = 0u; \
+    if (RCUTILS_LIKELY( \
+        0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&__rcutils_logging_first)) || \
+      !rcutils_logging_claim_first_evaluation(&__rcutils_logging_first)) \
+    {
 /**
  * \def RCUTILS_LOG_CONDITION_SKIPFIRST_AFTER
  * A macro finalizing the `skipfirst` condition.
@@ -179,6 +263,12 @@ typedef bool (* RclLogFilter)();
 /**
  * \def RCUTILS_LOG_CONDITION_THROTTLE_BEFORE
  * A macro initializing and checking the `throttle` condition.
+ *
+ * Exactly one evaluation logs per throttle interval, even if they happen
+ * concurrently, see rcutils_logging_claim_throttle_window().
+ * The clock is read on every evaluation, RCUTILS_STEADY_TIME_COARSE is a
+ * cheaper clock than RCUTILS_STEADY_TIME for intervals of more than a few
+ * milliseconds.
  */
 #define RCUTILS_LOG_CONDITION_THROTTLE_BEFORE(get_time_point_value, duration) { \
     static rcutils_duration_value_t __rcutils_logging_duration = RCUTILS_MS_TO_NS(RCUTILS_CAST_DURATION(duration)); \
@@ -191,11 +281,11 @@ typedef bool (* RclLogFilter)();
         "%s() at %s:%d getting current steady time failed\n", \
         __func__, __FILE__, __LINE__); \
     } else { \
-      __rcutils_logging_condition = __rcutils_logging_now >= __rcutils_logging_last_logged + __rcutils_logging_duration; \
+      __rcutils_logging_condition = rcutils_logging_claim_throttle_window( \
+        &__rcutils_logging_last_logged, __rcutils_logging_now, __rcutils_logging_duration); \
     } \
  \
-    if (RCUTILS_LIKELY(__rcutils_logging_condition)) { \
-      __rcutils_logging_last_logged = __rcutils_logging_now;
+    if (RCUTILS_LIKELY(__rcutils_logging_condition)) {
 
 /**
  * \def RCUTILS_LOG_CONDITION_THROTTLE_AFTER
@@ -205,10 +295,52 @@ typedef bool (* RclLogFilter)();
 }
 ///@@}
 
+/** @@name Macros for the `sampled` condition which processes only the first
+ * and then every n-th log call.
+ */
+///@@{
+/**
+ * \def RCUTILS_LOG_CONDITION_SAMPLED_BEFORE
+ * A macro initializing and checking the `sampled` condition.
+ *
+ * The calls are counted atomically per callsite, see rcutils_logging_sample_every().
+ */
+#define RCUTILS_LOG_CONDITION_SAMPLED_BEFORE(n) \
+  { \
+    static uint32_t __rcutils_logging_sample_count = 0u; \
+    if (rcutils_logging_sample_every(&__rcutils_logging_sample_count, (uint32_t)(n))) {
+/**
+ * \def RCUTILS_LOG_CONDITION_SAMPLED_AFTER
+ * A macro finalizing the `sampled` condition.
+ */
+#define RCUTILS_LOG_CONDITION_SAMPLED_AFTER } \
+}
+///@@}
+
+/** @@name Macros for the `sampled_prob` condition which processes each log
+ * call with the given probability.
+ */
+///@@{
+/**
+ * \def RCUTILS_LOG_CONDITION_SAMPLED_PROB_BEFORE
+ * A macro checking the `sampled_prob` condition.
+ *
+ * The random numbers are drawn per thread, see rcutils_logging_sample_probability().
+ */
+#define RCUTILS_LOG_CONDITION_SAMPLED_PROB_BEFORE(probability) \
+  if (rcutils_logging_sample_probability((double)(probability))) {
+/**
+ * \def RCUTILS_LOG_CONDITION_SAMPLED_PROB_AFTER
+ * A macro finalizing the `sampled_prob` condition.
+ */
+#define RCUTILS_LOG_CONDITION_SAMPLED_PROB_AFTER }
+///@@}
+
 @{
 import sys
 sys.path.insert(0, rcutils_module_path)
 from rcutils.logging import feature_combinations
+from rcutils.logging import get_base_macro
 from rcutils.logging import get_macro_arguments
 from rcutils.logging import get_macro_parameters
 from rcutils.logging import get_suffix_from_features
@@ -225,6 +357,13 @@ from rcutils.logging import severities
 /// Empty logging macro due to the preprocessor definition of RCUTILS_LOG_MIN_SEVERITY.
 # define RCUTILS_LOG_@(severity)@(suffix)(@(''.join([p + ', ' for p in get_macro_parameters(feature_combination).keys()]))format, ...)
 @[ end for]@
+#ifdef __cplusplus
+@[ for feature_combination in feature_combinations]@
+@{suffix = get_suffix_from_features(feature_combination)}@
+/// Empty logging macro due to the preprocessor definition of RCUTILS_LOG_MIN_SEVERITY.
+# define RCUTILS_LOG_@(severity)_FMT@(suffix)(@(''.join([p + ', ' for p in get_macro_parameters(feature_combination).keys()]))format, ...)
+@[ end for]@
+#endif
 
 #else
 @[ for feature_combination in feature_combinations]@
@@ -249,12 +388,33 @@ from rcutils.logging import severities
  * \param[in] ... The format string, followed by the variable arguments for the format string
  */
 # define RCUTILS_LOG_@(severity)@(suffix)(@(''.join([p + ', ' for p in get_macro_parameters(feature_combination).keys()]))...) \
-  RCUTILS_LOG_COND_NAMED( \
+  @(get_base_macro(feature_combination))( \
+    RCUTILS_LOG_SEVERITY_@(severity), \
+    @(''.join([str(a) + ', ' for a in get_macro_arguments(feature_combination)]))\
+    __VA_ARGS__)
+@[ end for]@
+#ifdef __cplusplus
+@[ for feature_combination in feature_combinations]@
+@{suffix = get_suffix_from_features(feature_combination)}@
+/**
+ * \def RCUTILS_LOG_@(severity)_FMT@(suffix)
+ * The variant of RCUTILS_LOG_@(severity)@(suffix) formatting `{}` placeholders.
+ *
+ * Only available in C++, with rcutils/logging_format.hpp included.
+ *
+@[ for param_name, doc_line in feature_combinations[feature_combination].params.items()]@
+ * \param[in] @(param_name) @(doc_line)
+@[ end for]@
+ * \param[in] ... The format string literal, followed by an argument for each `{}` in it
+ */
+# define RCUTILS_LOG_@(severity)_FMT@(suffix)(@(''.join([p + ', ' for p in get_macro_parameters(feature_combination).keys()]))...) \
+  @(get_base_macro(feature_combination))_FMT( \
     RCUTILS_LOG_SEVERITY_@(severity), \
     @(''.join([str(a) + ', ' for a in get_macro_arguments(feature_combination)]))\
     __VA_ARGS__)
 @[ end for]@
 #endif
+#endif
 ///@@}
 
 @[end for]@
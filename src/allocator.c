@@ -12,8 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+# include <malloc.h>
+#endif
+#ifdef __linux__
+# include <linux/mempolicy.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+#include "./threads.h"
 
 #include "rcutils/allocator.h"
 
@@ -71,6 +85,8 @@ rcutils_get_zero_initialized_allocator(void)
     .reallocate = NULL,
     .zero_allocate = NULL,
     .state = NULL,
+    .aligned_allocate = NULL,
+    .aligned_deallocate = NULL,
   };
   return zero_allocator;
 }
@@ -84,6 +100,8 @@ rcutils_get_default_allocator()
     .reallocate = __default_reallocate,
     .zero_allocate = __default_zero_allocate,
     .state = NULL,
+    .aligned_allocate = NULL,
+    .aligned_deallocate = NULL,
   };
   return default_allocator;
 }
@@ -121,3 +139,1922 @@ rcutils_reallocf(void * pointer, size_t size, rcutils_allocator_t * allocator)
   }
   return new_pointer;
 }
+
+static bool
+is_default_allocator(const rcutils_allocator_t * allocator)
+{
+  return __default_allocate == allocator->allocate &&
+         __default_deallocate == allocator->deallocate;
+}
+
+void *
+rcutils_aligned_allocate(size_t alignment, size_t size, const rcutils_allocator_t * allocator)
+{
+  if (!rcutils_allocator_is_valid(allocator) || 0 == alignment ||
+    0 != (alignment & (alignment - 1)))
+  {
+    return NULL;
+  }
+  if (NULL != allocator->aligned_allocate && NULL != allocator->aligned_deallocate) {
+    return allocator->aligned_allocate(alignment, size, allocator->state);
+  }
+  // The pointer to the memory which was allocated is stored right before the aligned memory.
+  if (alignment < sizeof(void *)) {
+    alignment = sizeof(void *);
+  }
+  if (size > SIZE_MAX - alignment - sizeof(void *)) {
+    return NULL;
+  }
+  if (is_default_allocator(allocator)) {
+    RCUTILS_CAN_RETURN_WITH_ERROR_OF(NULL);
+
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc() requires the size to be a multiple of the alignment.
+    return aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+  }
+  char * memory = allocator->allocate(size + alignment - 1 + sizeof(void *), allocator->state);
+  if (NULL == memory) {
+    return NULL;
+  }
+  uintptr_t aligned = ((uintptr_t)(memory + sizeof(void *)) + (alignment - 1)) &
+    ~(uintptr_t)(alignment - 1);
+  ((void **)aligned)[-1] = memory;
+  return (void *)aligned;
+}
+
+void
+rcutils_aligned_deallocate(void * pointer, const rcutils_allocator_t * allocator)
+{
+  if (NULL == pointer || !rcutils_allocator_is_valid(allocator)) {
+    return;
+  }
+  if (NULL != allocator->aligned_allocate && NULL != allocator->aligned_deallocate) {
+    allocator->aligned_deallocate(pointer, allocator->state);
+  } else if (is_default_allocator(allocator)) {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    free(pointer);
+#endif
+  } else {
+    allocator->deallocate(((void **)pointer)[-1], allocator->state);
+  }
+}
+
+// The alignment of the allocations of an arena, which is at least that of malloc() on the
+// supported platforms.
+#define ARENA_ALIGNMENT ((size_t)16)
+#define ARENA_ALIGN_UP(size) (((size) + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1))
+
+// A block of an arena, whose memory follows this header.
+typedef struct arena_block_s
+{
+  struct arena_block_s * next;
+  size_t capacity;
+  size_t used;
+} arena_block_t;
+
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN_UP(sizeof(arena_block_t))
+#define ARENA_BLOCK_DATA(block) ((char *)(block) + ARENA_BLOCK_HEADER_SIZE)
+
+typedef struct rcutils_arena_impl_s
+{
+  // The current block first, then the older and the dedicated ones
+  arena_block_t * blocks;
+  // The last allocation from the current block, which may be resized in place, or NULL
+  char * last;
+  size_t block_size;
+  rcutils_allocator_t allocator;
+} rcutils_arena_impl_t;
+
+static arena_block_t *
+arena_allocate_block(rcutils_arena_impl_t * impl, size_t capacity)
+{
+  if (capacity > SIZE_MAX - ARENA_BLOCK_HEADER_SIZE) {
+    return NULL;
+  }
+  arena_block_t * block =
+    impl->allocator.allocate(ARENA_BLOCK_HEADER_SIZE + capacity, impl->allocator.state);
+  if (NULL == block) {
+    return NULL;
+  }
+  block->capacity = capacity;
+  block->used = 0;
+  return block;
+}
+
+static void *
+arena_allocate(size_t size, void * state)
+{
+  rcutils_arena_impl_t * impl = state;
+  if (size > SIZE_MAX - ARENA_ALIGNMENT) {
+    return NULL;
+  }
+  size_t aligned_size = ARENA_ALIGN_UP(size);
+  arena_block_t * block = impl->blocks;
+  if (NULL != block && aligned_size <= block->capacity - block->used) {
+    char * pointer = ARENA_BLOCK_DATA(block) + block->used;
+    block->used += aligned_size;
+    impl->last = pointer;
+    return pointer;
+  }
+
+  if (aligned_size > impl->block_size / 2 && NULL != block) {
+    // A large allocation gets a block of its own, behind the current block which may still
+    // have room for smaller ones.
+    arena_block_t * dedicated = arena_allocate_block(impl, aligned_size);
+    if (NULL == dedicated) {
+      return NULL;
+    }
+    dedicated->used = aligned_size;
+    dedicated->next = block->next;
+    block->next = dedicated;
+    return ARENA_BLOCK_DATA(dedicated);
+  }
+
+  size_t capacity = aligned_size > impl->block_size ? aligned_size : impl->block_size;
+  block = arena_allocate_block(impl, capacity);
+  if (NULL == block) {
+    return NULL;
+  }
+  block->used = aligned_size;
+  block->next = impl->blocks;
+  impl->blocks = block;
+  impl->last = ARENA_BLOCK_DATA(block);
+  return impl->last;
+}
+
+static void *
+arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0 != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = arena_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+static void *
+arena_reallocate(void * pointer, size_t size, void * state)
+{
+  rcutils_arena_impl_t * impl = state;
+  if (NULL == pointer) {
+    return arena_allocate(size, state);
+  }
+  arena_block_t * current = impl->blocks;
+  if (pointer == impl->last && size <= SIZE_MAX - ARENA_ALIGNMENT) {
+    size_t offset = (size_t)(impl->last - ARENA_BLOCK_DATA(current));
+    size_t aligned_size = ARENA_ALIGN_UP(size);
+    if (aligned_size <= current->capacity - offset) {
+      current->used = offset + aligned_size;
+      return pointer;
+    }
+  }
+
+  // The size of the old allocation isn't known, but it ends within the used part of its block,
+  // which can be copied instead.
+  size_t old_size = 0;
+  for (arena_block_t * block = impl->blocks; NULL != block; block = block->next) {
+    uintptr_t data = (uintptr_t)ARENA_BLOCK_DATA(block);
+    if ((uintptr_t)pointer >= data && (uintptr_t)pointer < data + block->used) {
+      old_size = data + block->used - (uintptr_t)pointer;
+      break;
+    }
+  }
+  void * new_pointer = arena_allocate(size, state);
+  if (NULL != new_pointer) {
+    memcpy(new_pointer, pointer, old_size < size ? old_size : size);
+  }
+  return new_pointer;
+}
+
+static void
+arena_deallocate(void * pointer, void * state)
+{
+  rcutils_arena_impl_t * impl = state;
+  if (NULL != pointer && pointer == impl->last) {
+    impl->blocks->used = (size_t)(impl->last - ARENA_BLOCK_DATA(impl->blocks));
+    impl->last = NULL;
+  }
+}
+
+rcutils_arena_t
+rcutils_get_zero_initialized_arena(void)
+{
+  static rcutils_arena_t zero_initialized_arena = {NULL};
+  return zero_initialized_arena;
+}
+
+rcutils_ret_t
+rcutils_arena_init(
+  rcutils_arena_t * arena,
+  size_t block_size,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(arena, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0 == block_size) {
+    block_size = RCUTILS_ARENA_DEFAULT_BLOCK_SIZE;
+  }
+  if (block_size > SIZE_MAX - ARENA_ALIGNMENT) {
+    RCUTILS_SET_ERROR_MSG("arena block size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_arena_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_arena_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for arena impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->blocks = NULL;
+  impl->last = NULL;
+  impl->block_size = ARENA_ALIGN_UP(block_size);
+  impl->allocator = *allocator;
+  arena->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_arena_fini(rcutils_arena_t * arena)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(arena, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_arena_impl_t * impl = arena->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  arena_block_t * block = impl->blocks;
+  while (NULL != block) {
+    arena_block_t * next = block->next;
+    allocator.deallocate(block, allocator.state);
+    block = next;
+  }
+  allocator.deallocate(impl, allocator.state);
+  arena->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_arena_reset(rcutils_arena_t * arena)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(arena, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_arena_impl_t * impl = arena->impl;
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("arena is not initialized");
+    return RCUTILS_RET_NOT_INITIALIZED;
+  }
+  arena_block_t * current = impl->blocks;
+  if (NULL != current) {
+    arena_block_t * block = current->next;
+    while (NULL != block) {
+      arena_block_t * next = block->next;
+      impl->allocator.deallocate(block, impl->allocator.state);
+      block = next;
+    }
+    current->next = NULL;
+    current->used = 0;
+  }
+  impl->last = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_allocator_t
+rcutils_arena_get_allocator(const rcutils_arena_t * arena)
+{
+  if (NULL == arena || NULL == arena->impl) {
+    return rcutils_get_zero_initialized_allocator();
+  }
+  rcutils_allocator_t allocator = {
+    .allocate = arena_allocate,
+    .deallocate = arena_deallocate,
+    .reallocate = arena_reallocate,
+    .zero_allocate = arena_zero_allocate,
+    .state = arena->impl,
+  };
+  return allocator;
+}
+
+// The size classes of a block pool, every 16 bytes up to the largest block size
+#define BLOCK_POOL_GRANULARITY ((size_t)16)
+#define BLOCK_POOL_CLASS_COUNT (RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE / BLOCK_POOL_GRANULARITY)
+// Every allocation is preceded by its size, padded to keep the allocation aligned.
+#define BLOCK_POOL_HEADER_SIZE ARENA_ALIGNMENT
+// The size of the chunks the blocks are carved out of
+#define BLOCK_POOL_CHUNK_SIZE ((size_t)16384)
+// The number of blocks moved at once between a thread cache and the pool
+#define BLOCK_POOL_CACHE_BATCH ((size_t)16)
+
+// A block in a free list, which is stored at the start of the block itself.
+typedef struct block_pool_free_block_s
+{
+  struct block_pool_free_block_s * next;
+} block_pool_free_block_t;
+
+// A chunk of blocks, which is stored at the start of the chunk itself.
+typedef struct block_pool_chunk_s
+{
+  struct block_pool_chunk_s * next;
+} block_pool_chunk_t;
+
+#define BLOCK_POOL_CHUNK_HEADER_SIZE ARENA_ALIGN_UP(sizeof(block_pool_chunk_t))
+
+typedef struct block_pool_free_list_s
+{
+  block_pool_free_block_t * head;
+  // The last block, so that a whole free list can be moved to another one at once
+  block_pool_free_block_t * tail;
+  size_t count;
+} block_pool_free_list_t;
+
+struct rcutils_block_pool_impl_s;
+
+// The free blocks a thread allocates from and deallocates to without locking the pool.
+typedef struct block_pool_cache_s
+{
+  struct rcutils_block_pool_impl_s * pool;
+  struct block_pool_cache_s * previous;
+  struct block_pool_cache_s * next;
+  block_pool_free_list_t free_lists[BLOCK_POOL_CLASS_COUNT];
+} block_pool_cache_t;
+
+typedef struct rcutils_block_pool_impl_s
+{
+  rcutils_mutex_t lock;
+  bool thread_safe;
+  // Whether the threads have caches, which is the case for thread-safe pools unless the key
+  // couldn't be created
+  bool has_caches;
+  rcutils_thread_specific_t cache_key;
+  // The caches of all threads, guarded by the lock
+  block_pool_cache_t * caches;
+  block_pool_free_list_t free_lists[BLOCK_POOL_CLASS_COUNT];
+  block_pool_chunk_t * chunks;
+  rcutils_allocator_t allocator;
+} rcutils_block_pool_impl_t;
+
+static void
+block_pool_push(block_pool_free_list_t * free_list, block_pool_free_block_t * block)
+{
+  if (NULL == free_list->head) {
+    free_list->tail = block;
+  }
+  block->next = free_list->head;
+  free_list->head = block;
+  ++free_list->count;
+}
+
+static block_pool_free_block_t *
+block_pool_pop(block_pool_free_list_t * free_list)
+{
+  block_pool_free_block_t * block = free_list->head;
+  free_list->head = block->next;
+  if (NULL == free_list->head) {
+    free_list->tail = NULL;
+  }
+  --free_list->count;
+  return block;
+}
+
+// Carve a new chunk into free blocks of the size class, with the pool locked if thread-safe.
+static bool
+block_pool_add_chunk(rcutils_block_pool_impl_t * impl, size_t size_class)
+{
+  block_pool_chunk_t * chunk =
+    impl->allocator.allocate(BLOCK_POOL_CHUNK_SIZE, impl->allocator.state);
+  if (NULL == chunk) {
+    return false;
+  }
+  chunk->next = impl->chunks;
+  impl->chunks = chunk;
+  size_t stride = BLOCK_POOL_HEADER_SIZE + (size_class + 1) * BLOCK_POOL_GRANULARITY;
+  size_t count = (BLOCK_POOL_CHUNK_SIZE - BLOCK_POOL_CHUNK_HEADER_SIZE) / stride;
+  char * blocks = (char *)chunk + BLOCK_POOL_CHUNK_HEADER_SIZE;
+  // Pushed in reverse, so that the blocks are handed out in address order.
+  for (size_t i = count; i > 0; --i) {
+    block_pool_push(
+      &impl->free_lists[size_class], (block_pool_free_block_t *)(blocks + (i - 1) * stride));
+  }
+  return true;
+}
+
+// Move up to count blocks from one free list to another.
+static void
+block_pool_move(block_pool_free_list_t * from, block_pool_free_list_t * to, size_t count)
+{
+  while (count-- > 0 && NULL != from->head) {
+    block_pool_push(to, block_pool_pop(from));
+  }
+}
+
+// Move all blocks from one free list to another, without going through them.
+static void
+block_pool_move_all(block_pool_free_list_t * from, block_pool_free_list_t * to)
+{
+  if (NULL == from->head) {
+    return;
+  }
+  from->tail->next = to->head;
+  if (NULL == to->head) {
+    to->tail = from->tail;
+  }
+  to->head = from->head;
+  to->count += from->count;
+  from->head = NULL;
+  from->tail = NULL;
+  from->count = 0;
+}
+
+// Return the blocks of a cache to its pool, which must be locked, and forget the cache.
+static void
+block_pool_remove_cache(block_pool_cache_t * cache)
+{
+  rcutils_block_pool_impl_t * impl = cache->pool;
+  for (size_t k = 0; k < BLOCK_POOL_CLASS_COUNT; ++k) {
+    block_pool_move_all(&cache->free_lists[k], &impl->free_lists[k]);
+  }
+  if (NULL != cache->previous) {
+    cache->previous->next = cache->next;
+  } else {
+    impl->caches = cache->next;
+  }
+  if (NULL != cache->next) {
+    cache->next->previous = cache->previous;
+  }
+}
+
+// Called when a thread which used the pool exits, or when the pool is finalized.
+static void RCUTILS_THREAD_SPECIFIC_CALLBACK
+block_pool_destroy_cache(void * value)
+{
+  block_pool_cache_t * cache = value;
+  rcutils_block_pool_impl_t * impl = cache->pool;
+  rcutils_mutex_lock(&impl->lock);
+  block_pool_remove_cache(cache);
+  rcutils_mutex_unlock(&impl->lock);
+  impl->allocator.deallocate(cache, impl->allocator.state);
+}
+
+// Get the cache of the calling thread, or NULL if it has none and one can't be created.
+static block_pool_cache_t *
+block_pool_get_cache(rcutils_block_pool_impl_t * impl)
+{
+  block_pool_cache_t * cache = rcutils_thread_specific_get(&impl->cache_key);
+  if (NULL != cache) {
+    return cache;
+  }
+  rcutils_mutex_lock(&impl->lock);
+  cache = impl->allocator.allocate(sizeof(block_pool_cache_t), impl->allocator.state);
+  if (NULL != cache) {
+    cache->pool = impl;
+    cache->previous = NULL;
+    cache->next = impl->caches;
+    for (size_t k = 0; k < BLOCK_POOL_CLASS_COUNT; ++k) {
+      cache->free_lists[k].head = NULL;
+      cache->free_lists[k].tail = NULL;
+      cache->free_lists[k].count = 0;
+    }
+    if (RCUTILS_RET_OK == rcutils_thread_specific_set(&impl->cache_key, cache)) {
+      if (NULL != impl->caches) {
+        impl->caches->previous = cache;
+      }
+      impl->caches = cache;
+    } else {
+      rcutils_reset_error();
+      impl->allocator.deallocate(cache, impl->allocator.state);
+      cache = NULL;
+    }
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  return cache;
+}
+
+static void *
+block_pool_allocate(size_t size, void * state)
+{
+  rcutils_block_pool_impl_t * impl = state;
+  char * block = NULL;
+  if (size > RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE) {
+    if (size > SIZE_MAX - BLOCK_POOL_HEADER_SIZE) {
+      return NULL;
+    }
+    block = impl->allocator.allocate(BLOCK_POOL_HEADER_SIZE + size, impl->allocator.state);
+    if (NULL == block) {
+      return NULL;
+    }
+    *(size_t *)block = size;
+    return block + BLOCK_POOL_HEADER_SIZE;
+  }
+
+  size_t size_class = 0 == size ? 0 : (size - 1) / BLOCK_POOL_GRANULARITY;
+  block_pool_cache_t * cache = impl->has_caches ? block_pool_get_cache(impl) : NULL;
+  if (NULL != cache && NULL != cache->free_lists[size_class].head) {
+    block = (char *)block_pool_pop(&cache->free_lists[size_class]);
+  } else {
+    if (impl->thread_safe) {
+      rcutils_mutex_lock(&impl->lock);
+    }
+    block_pool_free_list_t * free_list = &impl->free_lists[size_class];
+    if (NULL != free_list->head || block_pool_add_chunk(impl, size_class)) {
+      block = (char *)block_pool_pop(free_list);
+      if (NULL != cache) {
+        // Refill the cache, so that the next allocations don't lock the pool.
+        block_pool_move(free_list, &cache->free_lists[size_class], BLOCK_POOL_CACHE_BATCH);
+      }
+    }
+    if (impl->thread_safe) {
+      rcutils_mutex_unlock(&impl->lock);
+    }
+    if (NULL == block) {
+      return NULL;
+    }
+  }
+  *(size_t *)block = (size_class + 1) * BLOCK_POOL_GRANULARITY;
+  return block + BLOCK_POOL_HEADER_SIZE;
+}
+
+static void
+block_pool_deallocate(void * pointer, void * state)
+{
+  rcutils_block_pool_impl_t * impl = state;
+  if (NULL == pointer) {
+    return;
+  }
+  char * block = (char *)pointer - BLOCK_POOL_HEADER_SIZE;
+  size_t size = *(size_t *)block;
+  if (size > RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE) {
+    impl->allocator.deallocate(block, impl->allocator.state);
+    return;
+  }
+  size_t size_class = size / BLOCK_POOL_GRANULARITY - 1;
+  block_pool_cache_t * cache = impl->has_caches ? block_pool_get_cache(impl) : NULL;
+  if (NULL != cache) {
+    block_pool_free_list_t * free_list = &cache->free_lists[size_class];
+    block_pool_push(free_list, (block_pool_free_block_t *)block);
+    if (free_list->count >= 2 * BLOCK_POOL_CACHE_BATCH) {
+      // Give the blocks back, so that they can be allocated from other threads.
+      rcutils_mutex_lock(&impl->lock);
+      block_pool_move_all(free_list, &impl->free_lists[size_class]);
+      rcutils_mutex_unlock(&impl->lock);
+    }
+    return;
+  }
+  if (impl->thread_safe) {
+    rcutils_mutex_lock(&impl->lock);
+  }
+  block_pool_push(&impl->free_lists[size_class], (block_pool_free_block_t *)block);
+  if (impl->thread_safe) {
+    rcutils_mutex_unlock(&impl->lock);
+  }
+}
+
+static void *
+block_pool_reallocate(void * pointer, size_t size, void * state)
+{
+  rcutils_block_pool_impl_t * impl = state;
+  if (NULL == pointer) {
+    return block_pool_allocate(size, state);
+  }
+  char * block = (char *)pointer - BLOCK_POOL_HEADER_SIZE;
+  size_t old_size = *(size_t *)block;
+  if (old_size > RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE && size > RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE) {
+    if (size > SIZE_MAX - BLOCK_POOL_HEADER_SIZE) {
+      return NULL;
+    }
+    block = impl->allocator.reallocate(
+      block, BLOCK_POOL_HEADER_SIZE + size, impl->allocator.state);
+    if (NULL == block) {
+      return NULL;
+    }
+    *(size_t *)block = size;
+    return block + BLOCK_POOL_HEADER_SIZE;
+  }
+  // A block of the size class of the new size is kept.
+  if (old_size <= RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE && size <= old_size &&
+    size + BLOCK_POOL_GRANULARITY > old_size)
+  {
+    return pointer;
+  }
+  void * new_pointer = block_pool_allocate(size, state);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, old_size < size ? old_size : size);
+  block_pool_deallocate(pointer, state);
+  return new_pointer;
+}
+
+static void *
+block_pool_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0 != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = block_pool_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+rcutils_block_pool_t
+rcutils_get_zero_initialized_block_pool(void)
+{
+  static rcutils_block_pool_t zero_initialized_block_pool = {NULL};
+  return zero_initialized_block_pool;
+}
+
+rcutils_ret_t
+rcutils_block_pool_init(
+  rcutils_block_pool_t * pool,
+  bool thread_safe,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pool, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_block_pool_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_block_pool_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for block pool impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->thread_safe = thread_safe;
+  impl->has_caches = false;
+  if (thread_safe) {
+    if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->lock)) {
+      allocator->deallocate(impl, allocator->state);
+      RCUTILS_SET_ERROR_MSG("failed to initialize the lock of the block pool");
+      return RCUTILS_RET_ERROR;
+    }
+    // Without thread caches every allocation locks the pool instead, so this isn't fatal.
+    if (RCUTILS_RET_OK ==
+      rcutils_thread_specific_init(&impl->cache_key, block_pool_destroy_cache))
+    {
+      impl->has_caches = true;
+    } else {
+      rcutils_reset_error();
+    }
+  }
+  impl->caches = NULL;
+  for (size_t k = 0; k < BLOCK_POOL_CLASS_COUNT; ++k) {
+    impl->free_lists[k].head = NULL;
+    impl->free_lists[k].tail = NULL;
+    impl->free_lists[k].count = 0;
+  }
+  impl->chunks = NULL;
+  impl->allocator = *allocator;
+  pool->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_block_pool_fini(rcutils_block_pool_t * pool)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pool, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_block_pool_impl_t * impl = pool->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  if (impl->has_caches) {
+    // Deleting the key may destroy the caches of the threads, depending on the platform, and
+    // the others are destroyed here.
+    rcutils_thread_specific_fini(&impl->cache_key);
+    while (NULL != impl->caches) {
+      block_pool_cache_t * cache = impl->caches;
+      impl->caches = cache->next;
+      allocator.deallocate(cache, allocator.state);
+    }
+  }
+  block_pool_chunk_t * chunk = impl->chunks;
+  while (NULL != chunk) {
+    block_pool_chunk_t * next = chunk->next;
+    allocator.deallocate(chunk, allocator.state);
+    chunk = next;
+  }
+  if (impl->thread_safe) {
+    rcutils_mutex_fini(&impl->lock);
+  }
+  allocator.deallocate(impl, allocator.state);
+  pool->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_allocator_t
+rcutils_block_pool_get_allocator(const rcutils_block_pool_t * pool)
+{
+  if (NULL == pool || NULL == pool->impl) {
+    return rcutils_get_zero_initialized_allocator();
+  }
+  rcutils_allocator_t allocator = {
+    .allocate = block_pool_allocate,
+    .deallocate = block_pool_deallocate,
+    .reallocate = block_pool_reallocate,
+    .zero_allocate = block_pool_zero_allocate,
+    .state = pool->impl,
+  };
+  return allocator;
+}
+
+// The size classes of a caching allocator, whose blocks are 2^k bytes large for the class k
+#define CACHING_ALLOCATOR_MIN_CLASS ((size_t)4)
+#define CACHING_ALLOCATOR_CLASS_COUNT (sizeof(size_t) * CHAR_BIT)
+// The class of the allocations which are not cached
+#define CACHING_ALLOCATOR_UNCACHED_CLASS SIZE_MAX
+
+// Every allocation is preceded by this header, padded to keep the allocation aligned.
+typedef struct caching_allocator_header_s
+{
+  size_t size_class;
+  // The size of the block, or the requested size if it isn't cached
+  size_t size;
+} caching_allocator_header_t;
+
+#define CACHING_ALLOCATOR_HEADER_SIZE ARENA_ALIGN_UP(sizeof(caching_allocator_header_t))
+
+// A cached block, which is stored at the start of the block itself.
+typedef struct caching_allocator_free_block_s
+{
+  struct caching_allocator_free_block_s * next;
+} caching_allocator_free_block_t;
+
+struct rcutils_caching_allocator_impl_s;
+
+typedef struct caching_allocator_cache_s
+{
+  struct rcutils_caching_allocator_impl_s * impl;
+  struct caching_allocator_cache_s * previous;
+  struct caching_allocator_cache_s * next;
+  caching_allocator_free_block_t * free_blocks[CACHING_ALLOCATOR_CLASS_COUNT];
+  size_t counts[CACHING_ALLOCATOR_CLASS_COUNT];
+} caching_allocator_cache_t;
+
+typedef struct rcutils_caching_allocator_impl_s
+{
+  // Guards the list of caches, which is only changed when a thread creates or destroys its cache
+  rcutils_mutex_t lock;
+  rcutils_thread_specific_t cache_key;
+  caching_allocator_cache_t * caches;
+  size_t max_class;
+  size_t max_cached_blocks;
+  rcutils_allocator_t allocator;
+} rcutils_caching_allocator_impl_t;
+
+// The size class of an allocation, which must not be larger than the largest cached block.
+static size_t
+caching_allocator_class_of_size(size_t size)
+{
+  size_t k = CACHING_ALLOCATOR_MIN_CLASS;
+  while (((size_t)1 << k) < size) {
+    ++k;
+  }
+  return k;
+}
+
+static void
+caching_allocator_drain_cache(caching_allocator_cache_t * cache)
+{
+  rcutils_allocator_t * allocator = &cache->impl->allocator;
+  for (size_t k = 0; k < CACHING_ALLOCATOR_CLASS_COUNT; ++k) {
+    caching_allocator_free_block_t * block = cache->free_blocks[k];
+    while (NULL != block) {
+      caching_allocator_free_block_t * next = block->next;
+      allocator->deallocate(block, allocator->state);
+      block = next;
+    }
+    cache->free_blocks[k] = NULL;
+    cache->counts[k] = 0;
+  }
+}
+
+// Called when a thread which used the caching allocator exits.
+static void RCUTILS_THREAD_SPECIFIC_CALLBACK
+caching_allocator_destroy_cache(void * value)
+{
+  caching_allocator_cache_t * cache = value;
+  rcutils_caching_allocator_impl_t * impl = cache->impl;
+  caching_allocator_drain_cache(cache);
+  rcutils_mutex_lock(&impl->lock);
+  if (NULL != cache->previous) {
+    cache->previous->next = cache->next;
+  } else {
+    impl->caches = cache->next;
+  }
+  if (NULL != cache->next) {
+    cache->next->previous = cache->previous;
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  impl->allocator.deallocate(cache, impl->allocator.state);
+}
+
+// Get the cache of the calling thread, or NULL if it has none and one can't be created.
+static caching_allocator_cache_t *
+caching_allocator_get_cache(rcutils_caching_allocator_impl_t * impl)
+{
+  caching_allocator_cache_t * cache = rcutils_thread_specific_get(&impl->cache_key);
+  if (NULL != cache) {
+    return cache;
+  }
+  cache = impl->allocator.allocate(sizeof(caching_allocator_cache_t), impl->allocator.state);
+  if (NULL == cache) {
+    return NULL;
+  }
+  cache->impl = impl;
+  cache->previous = NULL;
+  for (size_t k = 0; k < CACHING_ALLOCATOR_CLASS_COUNT; ++k) {
+    cache->free_blocks[k] = NULL;
+    cache->counts[k] = 0;
+  }
+  if (RCUTILS_RET_OK != rcutils_thread_specific_set(&impl->cache_key, cache)) {
+    rcutils_reset_error();
+    impl->allocator.deallocate(cache, impl->allocator.state);
+    return NULL;
+  }
+  rcutils_mutex_lock(&impl->lock);
+  cache->next = impl->caches;
+  if (NULL != impl->caches) {
+    impl->caches->previous = cache;
+  }
+  impl->caches = cache;
+  rcutils_mutex_unlock(&impl->lock);
+  return cache;
+}
+
+static void *
+caching_allocator_allocate(size_t size, void * state)
+{
+  rcutils_caching_allocator_impl_t * impl = state;
+  caching_allocator_header_t * header = NULL;
+  if (size > ((size_t)1 << impl->max_class)) {
+    if (size > SIZE_MAX - CACHING_ALLOCATOR_HEADER_SIZE) {
+      return NULL;
+    }
+    header = impl->allocator.allocate(CACHING_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state);
+    if (NULL == header) {
+      return NULL;
+    }
+    header->size_class = CACHING_ALLOCATOR_UNCACHED_CLASS;
+    header->size = size;
+    return (char *)header + CACHING_ALLOCATOR_HEADER_SIZE;
+  }
+
+  size_t size_class = caching_allocator_class_of_size(size);
+  caching_allocator_cache_t * cache = caching_allocator_get_cache(impl);
+  if (NULL != cache && NULL != cache->free_blocks[size_class]) {
+    caching_allocator_free_block_t * block = cache->free_blocks[size_class];
+    cache->free_blocks[size_class] = block->next;
+    --cache->counts[size_class];
+    header = (caching_allocator_header_t *)block;
+  } else {
+    header = impl->allocator.allocate(
+      CACHING_ALLOCATOR_HEADER_SIZE + ((size_t)1 << size_class), impl->allocator.state);
+    if (NULL == header) {
+      return NULL;
+    }
+  }
+  header->size_class = size_class;
+  header->size = (size_t)1 << size_class;
+  return (char *)header + CACHING_ALLOCATOR_HEADER_SIZE;
+}
+
+static void
+caching_allocator_deallocate(void * pointer, void * state)
+{
+  rcutils_caching_allocator_impl_t * impl = state;
+  if (NULL == pointer) {
+    return;
+  }
+  caching_allocator_header_t * header =
+    (caching_allocator_header_t *)((char *)pointer - CACHING_ALLOCATOR_HEADER_SIZE);
+  size_t size_class = header->size_class;
+  if (CACHING_ALLOCATOR_UNCACHED_CLASS != size_class) {
+    caching_allocator_cache_t * cache = caching_allocator_get_cache(impl);
+    if (NULL != cache && cache->counts[size_class] < impl->max_cached_blocks) {
+      caching_allocator_free_block_t * block = (caching_allocator_free_block_t *)header;
+      block->next = cache->free_blocks[size_class];
+      cache->free_blocks[size_class] = block;
+      ++cache->counts[size_class];
+      return;
+    }
+  }
+  impl->allocator.deallocate(header, impl->allocator.state);
+}
+
+static void *
+caching_allocator_reallocate(void * pointer, size_t size, void * state)
+{
+  rcutils_caching_allocator_impl_t * impl = state;
+  if (NULL == pointer) {
+    return caching_allocator_allocate(size, state);
+  }
+  caching_allocator_header_t * header =
+    (caching_allocator_header_t *)((char *)pointer - CACHING_ALLOCATOR_HEADER_SIZE);
+  bool cached = size <= ((size_t)1 << impl->max_class);
+  if (CACHING_ALLOCATOR_UNCACHED_CLASS == header->size_class && !cached) {
+    if (size > SIZE_MAX - CACHING_ALLOCATOR_HEADER_SIZE) {
+      return NULL;
+    }
+    header = impl->allocator.reallocate(
+      header, CACHING_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state);
+    if (NULL == header) {
+      return NULL;
+    }
+    header->size = size;
+    return (char *)header + CACHING_ALLOCATOR_HEADER_SIZE;
+  }
+  // A block of the size class of the new size is kept.
+  if (cached && header->size_class == caching_allocator_class_of_size(size)) {
+    return pointer;
+  }
+  void * new_pointer = caching_allocator_allocate(size, state);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, header->size < size ? header->size : size);
+  caching_allocator_deallocate(pointer, state);
+  return new_pointer;
+}
+
+static void *
+caching_allocator_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0 != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = caching_allocator_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+rcutils_caching_allocator_t
+rcutils_get_zero_initialized_caching_allocator(void)
+{
+  static rcutils_caching_allocator_t zero_initialized_caching_allocator = {NULL};
+  return zero_initialized_caching_allocator;
+}
+
+rcutils_ret_t
+rcutils_caching_allocator_init(
+  rcutils_caching_allocator_t * caching_allocator,
+  size_t max_block_size,
+  size_t max_cached_blocks,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(caching_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (max_block_size > SIZE_MAX / 4) {
+    RCUTILS_SET_ERROR_MSG("max_block_size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_caching_allocator_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_caching_allocator_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for caching allocator impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->lock)) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the lock of the caching allocator");
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK !=
+    rcutils_thread_specific_init(&impl->cache_key, caching_allocator_destroy_cache))
+  {
+    rcutils_mutex_fini(&impl->lock);
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to create the thread caches of the caching allocator");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->caches = NULL;
+  impl->max_class = caching_allocator_class_of_size(max_block_size);
+  impl->max_cached_blocks = max_cached_blocks;
+  impl->allocator = *allocator;
+  caching_allocator->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_caching_allocator_fini(rcutils_caching_allocator_t * caching_allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(caching_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_caching_allocator_impl_t * impl = caching_allocator->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  // Deleting the key may destroy the caches of the threads, depending on the platform, and
+  // the others are destroyed here.
+  rcutils_thread_specific_fini(&impl->cache_key);
+  while (NULL != impl->caches) {
+    caching_allocator_cache_t * cache = impl->caches;
+    impl->caches = cache->next;
+    caching_allocator_drain_cache(cache);
+    allocator.deallocate(cache, allocator.state);
+  }
+  rcutils_mutex_fini(&impl->lock);
+  allocator.deallocate(impl, allocator.state);
+  caching_allocator->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_caching_allocator_drain_thread_cache(rcutils_caching_allocator_t * caching_allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(caching_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == caching_allocator->impl) {
+    RCUTILS_SET_ERROR_MSG("caching allocator is not initialized");
+    return RCUTILS_RET_NOT_INITIALIZED;
+  }
+  caching_allocator_cache_t * cache =
+    rcutils_thread_specific_get(&caching_allocator->impl->cache_key);
+  if (NULL != cache) {
+    caching_allocator_drain_cache(cache);
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_allocator_t
+rcutils_caching_allocator_get_allocator(const rcutils_caching_allocator_t * caching_allocator)
+{
+  if (NULL == caching_allocator || NULL == caching_allocator->impl) {
+    return rcutils_get_zero_initialized_allocator();
+  }
+  rcutils_allocator_t allocator = {
+    .allocate = caching_allocator_allocate,
+    .deallocate = caching_allocator_deallocate,
+    .reallocate = caching_allocator_reallocate,
+    .zero_allocate = caching_allocator_zero_allocate,
+    .state = caching_allocator->impl,
+  };
+  return allocator;
+}
+
+// Every allocation is preceded by its size, padded to keep the allocation aligned.
+#define TRACKING_ALLOCATOR_HEADER_SIZE ARENA_ALIGNMENT
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+# pragma intrinsic(_ReturnAddress)
+# define TRACKING_ALLOCATOR_CALL_SITE() ((const void *)_ReturnAddress())
+#elif defined(__GNUC__)
+# define TRACKING_ALLOCATOR_CALL_SITE() ((const void *)__builtin_return_address(0))
+#else
+# define TRACKING_ALLOCATOR_CALL_SITE() ((const void *)NULL)
+#endif
+
+typedef struct tracking_allocator_totals_s
+{
+  uint64_t allocations;
+  uint64_t reallocations;
+  uint64_t deallocations;
+  uint64_t total_bytes;
+} tracking_allocator_totals_t;
+
+struct rcutils_tracking_allocator_impl_s;
+
+// The counters of a thread, which are only written by that thread.
+typedef struct tracking_allocator_counters_s
+{
+  struct rcutils_tracking_allocator_impl_s * impl;
+  struct tracking_allocator_counters_s * previous;
+  struct tracking_allocator_counters_s * next;
+  tracking_allocator_totals_t totals;
+} tracking_allocator_counters_t;
+
+typedef struct rcutils_tracking_allocator_impl_s
+{
+  rcutils_thread_specific_t counters_key;
+  // Guards the list of counters, the retired and reset totals and the call sites
+  rcutils_mutex_t lock;
+  tracking_allocator_counters_t * counters;
+  // The totals of the threads which exited, and of those which have no counters of their own
+  tracking_allocator_totals_t retired;
+  // The totals when the tracking allocator was last reset
+  tracking_allocator_totals_t reset;
+  uint64_t current_bytes;
+  uint64_t peak_bytes;
+  // A hash table of the call sites, by address, followed by the call site counting the
+  // allocations of the call sites which don't fit, or NULL if call sites aren't tracked
+  rcutils_tracking_allocator_call_site_t * call_sites;
+  rcutils_allocator_t allocator;
+} rcutils_tracking_allocator_impl_t;
+
+static void tracking_allocator_add(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchangeAdd64((volatile LONG64 *)counter, (LONG64)value);
+#else
+  __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static uint64_t tracking_allocator_load(uint64_t * counter)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)counter, 0, 0);
+#else
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#endif
+}
+
+static void tracking_allocator_store(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)counter, (LONG64)value);
+#else
+  __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+// Add to a counter only written by the calling thread, which needs no atomic read-modify-write.
+static void tracking_allocator_add_owned(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  *(volatile uint64_t *)counter += value;
+#else
+  __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+#endif
+}
+
+static void
+tracking_allocator_add_totals(
+  tracking_allocator_totals_t * totals, tracking_allocator_totals_t * to)
+{
+  tracking_allocator_add(&to->allocations, tracking_allocator_load(&totals->allocations));
+  tracking_allocator_add(&to->reallocations, tracking_allocator_load(&totals->reallocations));
+  tracking_allocator_add(&to->deallocations, tracking_allocator_load(&totals->deallocations));
+  tracking_allocator_add(&to->total_bytes, tracking_allocator_load(&totals->total_bytes));
+}
+
+// Called when a thread which used the tracking allocator exits.
+static void RCUTILS_THREAD_SPECIFIC_CALLBACK
+tracking_allocator_destroy_counters(void * value)
+{
+  tracking_allocator_counters_t * counters = value;
+  rcutils_tracking_allocator_impl_t * impl = counters->impl;
+  rcutils_mutex_lock(&impl->lock);
+  tracking_allocator_add_totals(&counters->totals, &impl->retired);
+  if (NULL != counters->previous) {
+    counters->previous->next = counters->next;
+  } else {
+    impl->counters = counters->next;
+  }
+  if (NULL != counters->next) {
+    counters->next->previous = counters->previous;
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  impl->allocator.deallocate(counters, impl->allocator.state);
+}
+
+// Count an operation, and the bytes it allocated, in the counters of the calling thread, or else
+// atomically in the retired totals.
+static void
+tracking_allocator_count(rcutils_tracking_allocator_impl_t * impl, size_t offset, uint64_t bytes)
+{
+  tracking_allocator_counters_t * counters = rcutils_thread_specific_get(&impl->counters_key);
+  if (RCUTILS_UNLIKELY(NULL == counters)) {
+    counters = impl->allocator.zero_allocate(
+      1, sizeof(tracking_allocator_counters_t), impl->allocator.state);
+    if (NULL != counters &&
+      RCUTILS_RET_OK != rcutils_thread_specific_set(&impl->counters_key, counters))
+    {
+      rcutils_reset_error();
+      impl->allocator.deallocate(counters, impl->allocator.state);
+      counters = NULL;
+    }
+    if (NULL == counters) {
+      tracking_allocator_add((uint64_t *)((char *)&impl->retired + offset), 1u);
+      tracking_allocator_add(&impl->retired.total_bytes, bytes);
+      return;
+    }
+    counters->impl = impl;
+    rcutils_mutex_lock(&impl->lock);
+    counters->next = impl->counters;
+    if (NULL != impl->counters) {
+      impl->counters->previous = counters;
+    }
+    impl->counters = counters;
+    rcutils_mutex_unlock(&impl->lock);
+  }
+  tracking_allocator_add_owned((uint64_t *)((char *)&counters->totals + offset), 1u);
+  if (0u != bytes) {
+    tracking_allocator_add_owned(&counters->totals.total_bytes, bytes);
+  }
+}
+
+#define TRACKING_ALLOCATOR_COUNT(impl, operations, bytes) \
+  tracking_allocator_count(impl, offsetof(tracking_allocator_totals_t, operations), bytes)
+
+// Add to the bytes currently allocated, which may be a negative difference, and update the peak.
+static void
+tracking_allocator_add_current_bytes(rcutils_tracking_allocator_impl_t * impl, uint64_t bytes)
+{
+#ifdef _WIN32
+  uint64_t current =
+    (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)&impl->current_bytes, (LONG64)bytes) +
+    bytes;
+  uint64_t peak = tracking_allocator_load(&impl->peak_bytes);
+  while (current > peak) {
+    uint64_t previous = (uint64_t)InterlockedCompareExchange64(
+      (volatile LONG64 *)&impl->peak_bytes, (LONG64)current, (LONG64)peak);
+    if (previous == peak) {
+      break;
+    }
+    peak = previous;
+  }
+#else
+  uint64_t current = __atomic_add_fetch(&impl->current_bytes, bytes, __ATOMIC_RELAXED);
+  uint64_t peak = __atomic_load_n(&impl->peak_bytes, __ATOMIC_RELAXED);
+  while (current > peak &&
+    !__atomic_compare_exchange_n(
+      &impl->peak_bytes, &peak, current, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+  {
+  }
+#endif
+}
+
+static void
+tracking_allocator_add_call_site(
+  rcutils_tracking_allocator_impl_t * impl, const void * address, size_t size)
+{
+  rcutils_tracking_allocator_call_site_t * call_site =
+    &impl->call_sites[RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES];
+  rcutils_mutex_lock(&impl->lock);
+  if (NULL != address) {
+    // Probe linearly from the hash of the address, which drops the bits of the alignment.
+    size_t hash = (size_t)(((uintptr_t)address >> 2) * (uintptr_t)2654435761u);
+    for (size_t i = 0; i < RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES; ++i) {
+      rcutils_tracking_allocator_call_site_t * entry =
+        &impl->call_sites[(hash + i) % RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES];
+      if (entry->address == address || NULL == entry->address) {
+        entry->address = address;
+        call_site = entry;
+        break;
+      }
+    }
+  }
+  ++call_site->allocations;
+  call_site->bytes += size;
+  rcutils_mutex_unlock(&impl->lock);
+}
+
+static void *
+tracking_allocator_allocate_at(
+  rcutils_tracking_allocator_impl_t * impl, size_t size, bool zero, const void * call_site)
+{
+  if (size > SIZE_MAX - TRACKING_ALLOCATOR_HEADER_SIZE) {
+    return NULL;
+  }
+  size_t * header = zero ?
+    impl->allocator.zero_allocate(1, TRACKING_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state) :
+    impl->allocator.allocate(TRACKING_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state);
+  if (NULL == header) {
+    return NULL;
+  }
+  *header = size;
+  TRACKING_ALLOCATOR_COUNT(impl, allocations, (uint64_t)size);
+  tracking_allocator_add_current_bytes(impl, (uint64_t)size);
+  if (NULL != impl->call_sites) {
+    tracking_allocator_add_call_site(impl, call_site, size);
+  }
+  return (char *)header + TRACKING_ALLOCATOR_HEADER_SIZE;
+}
+
+static void *
+tracking_allocator_allocate(size_t size, void * state)
+{
+  return tracking_allocator_allocate_at(state, size, false, TRACKING_ALLOCATOR_CALL_SITE());
+}
+
+static void *
+tracking_allocator_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0 != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  return tracking_allocator_allocate_at(
+    state, number_of_elements * size_of_element, true, TRACKING_ALLOCATOR_CALL_SITE());
+}
+
+static void *
+tracking_allocator_reallocate(void * pointer, size_t size, void * state)
+{
+  rcutils_tracking_allocator_impl_t * impl = state;
+  const void * call_site = TRACKING_ALLOCATOR_CALL_SITE();
+  if (NULL == pointer) {
+    return tracking_allocator_allocate_at(impl, size, false, call_site);
+  }
+  if (size > SIZE_MAX - TRACKING_ALLOCATOR_HEADER_SIZE) {
+    return NULL;
+  }
+  size_t * header = (size_t *)((char *)pointer - TRACKING_ALLOCATOR_HEADER_SIZE);
+  size_t old_size = *header;
+  header = impl->allocator.reallocate(
+    header, TRACKING_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state);
+  if (NULL == header) {
+    return NULL;
+  }
+  *header = size;
+  TRACKING_ALLOCATOR_COUNT(impl, reallocations, (uint64_t)size);
+  tracking_allocator_add_current_bytes(impl, (uint64_t)size - (uint64_t)old_size);
+  if (NULL != impl->call_sites) {
+    tracking_allocator_add_call_site(impl, call_site, size);
+  }
+  return (char *)header + TRACKING_ALLOCATOR_HEADER_SIZE;
+}
+
+static void
+tracking_allocator_deallocate(void * pointer, void * state)
+{
+  rcutils_tracking_allocator_impl_t * impl = state;
+  if (NULL == pointer) {
+    return;
+  }
+  size_t * header = (size_t *)((char *)pointer - TRACKING_ALLOCATOR_HEADER_SIZE);
+  size_t size = *header;
+  impl->allocator.deallocate(header, impl->allocator.state);
+  TRACKING_ALLOCATOR_COUNT(impl, deallocations, 0u);
+  tracking_allocator_add_current_bytes(impl, (uint64_t)0 - (uint64_t)size);
+}
+
+rcutils_tracking_allocator_t
+rcutils_get_zero_initialized_tracking_allocator(void)
+{
+  static rcutils_tracking_allocator_t zero_initialized_tracking_allocator = {NULL};
+  return zero_initialized_tracking_allocator;
+}
+
+rcutils_ret_t
+rcutils_tracking_allocator_init(
+  rcutils_tracking_allocator_t * tracking_allocator,
+  bool track_call_sites,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(tracking_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_tracking_allocator_impl_t * impl =
+    allocator->zero_allocate(1, sizeof(rcutils_tracking_allocator_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for tracking allocator impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (track_call_sites) {
+    impl->call_sites = allocator->zero_allocate(
+      RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES + 1,
+      sizeof(rcutils_tracking_allocator_call_site_t), allocator->state);
+    if (NULL == impl->call_sites) {
+      allocator->deallocate(impl, allocator->state);
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for tracking allocator call sites");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->lock)) {
+    allocator->deallocate(impl->call_sites, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the lock of the tracking allocator");
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK !=
+    rcutils_thread_specific_init(&impl->counters_key, tracking_allocator_destroy_counters))
+  {
+    rcutils_mutex_fini(&impl->lock);
+    allocator->deallocate(impl->call_sites, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to create the thread counters of the tracking allocator");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->allocator = *allocator;
+  tracking_allocator->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_tracking_allocator_fini(rcutils_tracking_allocator_t * tracking_allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(tracking_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_tracking_allocator_impl_t * impl = tracking_allocator->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  // Deleting the key may destroy the counters of the threads, depending on the platform, and
+  // the others are destroyed here.
+  rcutils_thread_specific_fini(&impl->counters_key);
+  while (NULL != impl->counters) {
+    tracking_allocator_counters_t * counters = impl->counters;
+    impl->counters = counters->next;
+    allocator.deallocate(counters, allocator.state);
+  }
+  rcutils_mutex_fini(&impl->lock);
+  allocator.deallocate(impl->call_sites, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  tracking_allocator->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_allocator_t
+rcutils_tracking_allocator_get_allocator(const rcutils_tracking_allocator_t * tracking_allocator)
+{
+  if (NULL == tracking_allocator || NULL == tracking_allocator->impl) {
+    return rcutils_get_zero_initialized_allocator();
+  }
+  rcutils_allocator_t allocator = {
+    .allocate = tracking_allocator_allocate,
+    .deallocate = tracking_allocator_deallocate,
+    .reallocate = tracking_allocator_reallocate,
+    .zero_allocate = tracking_allocator_zero_allocate,
+    .state = tracking_allocator->impl,
+  };
+  return allocator;
+}
+
+// Sum up the totals of all threads, with the lock held.
+static tracking_allocator_totals_t
+tracking_allocator_sum(rcutils_tracking_allocator_impl_t * impl)
+{
+  tracking_allocator_totals_t totals = {0u, 0u, 0u, 0u};
+  tracking_allocator_add_totals(&impl->retired, &totals);
+  for (tracking_allocator_counters_t * counters = impl->counters; NULL != counters;
+    counters = counters->next)
+  {
+    tracking_allocator_add_totals(&counters->totals, &totals);
+  }
+  return totals;
+}
+
+#define TRACKING_ALLOCATOR_VALIDATE(tracking_allocator) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(tracking_allocator, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == tracking_allocator->impl) { \
+    RCUTILS_SET_ERROR_MSG("tracking allocator is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+rcutils_ret_t
+rcutils_tracking_allocator_get_statistics(
+  const rcutils_tracking_allocator_t * tracking_allocator,
+  rcutils_tracking_allocator_statistics_t * statistics)
+{
+  TRACKING_ALLOCATOR_VALIDATE(tracking_allocator);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(statistics, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_tracking_allocator_impl_t * impl = tracking_allocator->impl;
+
+  rcutils_mutex_lock(&impl->lock);
+  tracking_allocator_totals_t totals = tracking_allocator_sum(impl);
+  statistics->allocations = totals.allocations - impl->reset.allocations;
+  statistics->reallocations = totals.reallocations - impl->reset.reallocations;
+  statistics->deallocations = totals.deallocations - impl->reset.deallocations;
+  statistics->total_bytes = totals.total_bytes - impl->reset.total_bytes;
+  rcutils_mutex_unlock(&impl->lock);
+  statistics->current_bytes = tracking_allocator_load(&impl->current_bytes);
+  statistics->peak_bytes = tracking_allocator_load(&impl->peak_bytes);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_tracking_allocator_get_call_sites(
+  const rcutils_tracking_allocator_t * tracking_allocator,
+  rcutils_tracking_allocator_call_site_t * call_sites,
+  size_t capacity,
+  size_t * count)
+{
+  TRACKING_ALLOCATOR_VALIDATE(tracking_allocator);
+  if (capacity > 0) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(call_sites, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_tracking_allocator_impl_t * impl = tracking_allocator->impl;
+
+  *count = 0;
+  if (NULL == impl->call_sites) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_mutex_lock(&impl->lock);
+  for (size_t i = 0; i <= RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES; ++i) {
+    const rcutils_tracking_allocator_call_site_t * entry = &impl->call_sites[i];
+    if (0u == entry->allocations) {
+      continue;
+    }
+    // Insert the call site into the ones copied so far, which are kept sorted.
+    size_t copied = *count < capacity ? *count : capacity;
+    size_t position = copied;
+    while (position > 0 && call_sites[position - 1].allocations < entry->allocations) {
+      --position;
+    }
+    if (position < capacity) {
+      size_t last = copied < capacity ? copied : capacity - 1;
+      memmove(
+        &call_sites[position + 1], &call_sites[position],
+        (last - position) * sizeof(rcutils_tracking_allocator_call_site_t));
+      call_sites[position] = *entry;
+    }
+    ++*count;
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_tracking_allocator_reset(rcutils_tracking_allocator_t * tracking_allocator)
+{
+  TRACKING_ALLOCATOR_VALIDATE(tracking_allocator);
+  rcutils_tracking_allocator_impl_t * impl = tracking_allocator->impl;
+
+  // The counters of the threads are only written by their thread, so the totals at the reset
+  // are subtracted from them instead.
+  rcutils_mutex_lock(&impl->lock);
+  impl->reset = tracking_allocator_sum(impl);
+  tracking_allocator_store(&impl->peak_bytes, tracking_allocator_load(&impl->current_bytes));
+  if (NULL != impl->call_sites) {
+    memset(
+      impl->call_sites, 0,
+      (RCUTILS_TRACKING_ALLOCATOR_MAX_CALL_SITES + 1) * sizeof(*impl->call_sites));
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  return RCUTILS_RET_OK;
+}
+
+// Every allocation is preceded by this header, padded to keep the allocation aligned.
+typedef struct page_allocator_header_s
+{
+  // The length of the mapping starting at the header, or 0 if it was forwarded
+  size_t mapped_length;
+  size_t size;
+} page_allocator_header_t;
+
+#define PAGE_ALLOCATOR_HEADER_SIZE ARENA_ALIGN_UP(sizeof(page_allocator_header_t))
+// The most NUMA nodes a page allocator binds to
+#define PAGE_ALLOCATOR_MAX_NODES 1024
+#define PAGE_ALLOCATOR_MASK_BITS ((int)(sizeof(unsigned long) * CHAR_BIT))  // NOLINT
+// The huge page size if the system doesn't tell it
+#define PAGE_ALLOCATOR_DEFAULT_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+typedef struct rcutils_page_allocator_impl_s
+{
+  int numa_node;
+  rcutils_page_allocator_huge_pages_t huge_pages;
+  size_t min_size;
+  size_t page_size;
+  size_t huge_page_size;
+  rcutils_allocator_t allocator;
+} rcutils_page_allocator_impl_t;
+
+#ifdef __linux__
+static size_t
+page_allocator_read_huge_page_size(void)
+{
+  size_t huge_page_size = PAGE_ALLOCATOR_DEFAULT_HUGE_PAGE_SIZE;
+  FILE * meminfo = fopen("/proc/meminfo", "r");
+  if (NULL == meminfo) {
+    return huge_page_size;
+  }
+  char line[128];
+  while (NULL != fgets(line, sizeof(line), meminfo)) {
+    unsigned long kibibytes = 0;  // NOLINT(runtime/int)
+    if (1 == sscanf(line, "Hugepagesize: %lu kB", &kibibytes) && kibibytes > 0) {
+      huge_page_size = (size_t)kibibytes * 1024;
+      break;
+    }
+  }
+  fclose(meminfo);
+  return huge_page_size;
+}
+
+static bool
+page_allocator_node_exists(int node)
+{
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", node);
+  return 0 == access(path, F_OK);
+}
+
+// Bind the pages of a mapping to the NUMA node of the page allocator, before they are touched.
+static void
+page_allocator_bind(rcutils_page_allocator_impl_t * impl, void * mapping, size_t length)
+{
+  int mode = MPOL_BIND;
+  int node = impl->numa_node;
+  if (RCUTILS_PAGE_ALLOCATOR_LOCAL_NODE == node) {
+    // The thread may migrate to another node, so the memory may come from another one then.
+    unsigned int cpu = 0;
+    unsigned int local_node = 0;
+    if (0 != syscall(SYS_getcpu, &cpu, &local_node, NULL)) {
+      return;
+    }
+    mode = MPOL_PREFERRED;
+    node = (int)local_node;
+  }
+  if (node < 0 || node >= PAGE_ALLOCATOR_MAX_NODES) {
+    return;
+  }
+  unsigned long nodemask[PAGE_ALLOCATOR_MAX_NODES / PAGE_ALLOCATOR_MASK_BITS] = {0};  // NOLINT
+  nodemask[node / PAGE_ALLOCATOR_MASK_BITS] = 1ul << (node % PAGE_ALLOCATOR_MASK_BITS);
+  // The kernel ignores the last bit of the node mask, which is one more than the nodes.
+  // If it doesn't support NUMA, the pages are just allocated anywhere.
+  (void)syscall(SYS_mbind, mapping, length, mode, nodemask, PAGE_ALLOCATOR_MAX_NODES + 1, 0);
+}
+
+// Map at least the given length, aligned to the given alignment which is a multiple of the page
+// size, and return the mapping, or NULL.
+static void *
+page_allocator_map_aligned(size_t length, size_t alignment, size_t page_size)
+{
+  if (alignment <= page_size) {
+    void * mapping =
+      mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return MAP_FAILED == mapping ? NULL : mapping;
+  }
+  // Map more than needed and unmap what is before and after the aligned mapping.
+  if (length > SIZE_MAX - alignment) {
+    return NULL;
+  }
+  size_t padded_length = length + alignment - page_size;
+  char * mapping =
+    mmap(NULL, padded_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (MAP_FAILED == (void *)mapping) {
+    return NULL;
+  }
+  size_t head = (alignment - (uintptr_t)mapping % alignment) % alignment;
+  if (head > 0) {
+    munmap(mapping, head);
+  }
+  if (padded_length - head > length) {
+    munmap(mapping + head + length, padded_length - head - length);
+  }
+  return mapping + head;
+}
+
+// Map the memory of an allocation of the given size, and return its header, or NULL.
+static page_allocator_header_t *
+page_allocator_map(rcutils_page_allocator_impl_t * impl, size_t size)
+{
+  size_t granularity = impl->page_size;
+  if (RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_EXPLICIT == impl->huge_pages) {
+    granularity = impl->huge_page_size;
+  }
+  if (size > SIZE_MAX - PAGE_ALLOCATOR_HEADER_SIZE - granularity) {
+    return NULL;
+  }
+  size_t length = (PAGE_ALLOCATOR_HEADER_SIZE + size + granularity - 1) & ~(granularity - 1);
+
+  void * mapping = NULL;
+  if (RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_EXPLICIT == impl->huge_pages) {
+    mapping = mmap(
+      NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (MAP_FAILED == mapping) {
+      mapping = NULL;
+    }
+  }
+  if (NULL == mapping) {
+    bool transparent = RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE != impl->huge_pages;
+    // Only the parts of a mapping which are aligned to the huge page size get huge pages.
+    size_t alignment =
+      transparent && length >= impl->huge_page_size ? impl->huge_page_size : impl->page_size;
+    mapping = page_allocator_map_aligned(length, alignment, impl->page_size);
+    if (NULL == mapping) {
+      return NULL;
+    }
+    if (transparent) {
+      (void)madvise(mapping, length, MADV_HUGEPAGE);
+    }
+  }
+  if (RCUTILS_PAGE_ALLOCATOR_ANY_NODE != impl->numa_node) {
+    page_allocator_bind(impl, mapping, length);
+  }
+  page_allocator_header_t * header = mapping;
+  header->mapped_length = length;
+  return header;
+}
+#endif
+
+static void *
+page_allocator_allocate_forwarded(
+  rcutils_page_allocator_impl_t * impl, size_t size, bool zero)
+{
+  if (size > SIZE_MAX - PAGE_ALLOCATOR_HEADER_SIZE) {
+    return NULL;
+  }
+  page_allocator_header_t * header = zero ?
+    impl->allocator.zero_allocate(1, PAGE_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state) :
+    impl->allocator.allocate(PAGE_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state);
+  if (NULL == header) {
+    return NULL;
+  }
+  header->mapped_length = 0;
+  header->size = size;
+  return (char *)header + PAGE_ALLOCATOR_HEADER_SIZE;
+}
+
+static void *
+page_allocator_allocate_zeroed(rcutils_page_allocator_impl_t * impl, size_t size, bool zero)
+{
+#ifdef __linux__
+  if (size >= impl->min_size) {
+    // The mapping is zeroed by the kernel.
+    page_allocator_header_t * header = page_allocator_map(impl, size);
+    if (NULL == header) {
+      return NULL;
+    }
+    header->size = size;
+    return (char *)header + PAGE_ALLOCATOR_HEADER_SIZE;
+  }
+#endif
+  return page_allocator_allocate_forwarded(impl, size, zero);
+}
+
+static void *
+page_allocator_allocate(size_t size, void * state)
+{
+  return page_allocator_allocate_zeroed(state, size, false);
+}
+
+static void
+page_allocator_deallocate(void * pointer, void * state)
+{
+  rcutils_page_allocator_impl_t * impl = state;
+  if (NULL == pointer) {
+    return;
+  }
+  page_allocator_header_t * header =
+    (page_allocator_header_t *)((char *)pointer - PAGE_ALLOCATOR_HEADER_SIZE);
+#ifdef __linux__
+  if (0u != header->mapped_length) {
+    munmap(header, header->mapped_length);
+    return;
+  }
+#endif
+  impl->allocator.deallocate(header, impl->allocator.state);
+}
+
+static void *
+page_allocator_reallocate(void * pointer, size_t size, void * state)
+{
+  rcutils_page_allocator_impl_t * impl = state;
+  if (NULL == pointer) {
+    return page_allocator_allocate(size, state);
+  }
+  page_allocator_header_t * header =
+    (page_allocator_header_t *)((char *)pointer - PAGE_ALLOCATOR_HEADER_SIZE);
+  bool mapped = 0u != header->mapped_length;
+  if (!mapped && size < impl->min_size) {
+    if (size > SIZE_MAX - PAGE_ALLOCATOR_HEADER_SIZE) {
+      return NULL;
+    }
+    header = impl->allocator.reallocate(
+      header, PAGE_ALLOCATOR_HEADER_SIZE + size, impl->allocator.state);
+    if (NULL == header) {
+      return NULL;
+    }
+    header->size = size;
+    return (char *)header + PAGE_ALLOCATOR_HEADER_SIZE;
+  }
+  // A mapping which is large enough is kept, as long as the size is large enough to be mapped.
+  if (mapped && size >= impl->min_size &&
+    size <= header->mapped_length - PAGE_ALLOCATOR_HEADER_SIZE)
+  {
+    header->size = size;
+    return pointer;
+  }
+  void * new_pointer = page_allocator_allocate(size, state);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, header->size < size ? header->size : size);
+  page_allocator_deallocate(pointer, state);
+  return new_pointer;
+}
+
+static void *
+page_allocator_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0 != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  return page_allocator_allocate_zeroed(state, number_of_elements * size_of_element, true);
+}
+
+rcutils_page_allocator_options_t
+rcutils_page_allocator_get_default_options(void)
+{
+  rcutils_page_allocator_options_t options = {
+    .numa_node = RCUTILS_PAGE_ALLOCATOR_ANY_NODE,
+    .huge_pages = RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE,
+    .min_size = RCUTILS_PAGE_ALLOCATOR_DEFAULT_MIN_SIZE,
+  };
+  return options;
+}
+
+rcutils_page_allocator_t
+rcutils_get_zero_initialized_page_allocator(void)
+{
+  static rcutils_page_allocator_t zero_initialized_page_allocator = {NULL};
+  return zero_initialized_page_allocator;
+}
+
+rcutils_ret_t
+rcutils_page_allocator_init(
+  rcutils_page_allocator_t * page_allocator,
+  const rcutils_page_allocator_options_t * options,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(page_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (options->numa_node < RCUTILS_PAGE_ALLOCATOR_LOCAL_NODE) {
+    RCUTILS_SET_ERROR_MSG("numa_node is invalid");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (options->huge_pages < RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE ||
+    options->huge_pages > RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_EXPLICIT)
+  {
+    RCUTILS_SET_ERROR_MSG("huge_pages is invalid");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+#ifdef __linux__
+  if (options->numa_node >= 0 &&
+    (options->numa_node >= PAGE_ALLOCATOR_MAX_NODES ||
+    !page_allocator_node_exists(options->numa_node)))
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "NUMA node %d doesn't exist", options->numa_node);
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+#else
+  if (RCUTILS_PAGE_ALLOCATOR_ANY_NODE != options->numa_node ||
+    RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE != options->huge_pages)
+  {
+    RCUTILS_SET_ERROR_MSG("NUMA nodes and huge pages are only supported on Linux");
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+
+  rcutils_page_allocator_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_page_allocator_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for page allocator impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->numa_node = options->numa_node;
+  impl->huge_pages = options->huge_pages;
+  impl->min_size = options->min_size;
+  impl->page_size = 4096;
+  impl->huge_page_size = PAGE_ALLOCATOR_DEFAULT_HUGE_PAGE_SIZE;
+#ifdef __linux__
+  long page_size = sysconf(_SC_PAGESIZE);  // NOLINT(runtime/int)
+  if (page_size > 0) {
+    impl->page_size = (size_t)page_size;
+  }
+  if (RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE != impl->huge_pages) {
+    impl->huge_page_size = page_allocator_read_huge_page_size();
+  }
+#else
+  // Nothing is mapped.
+  impl->min_size = SIZE_MAX;
+#endif
+  impl->allocator = *allocator;
+  page_allocator->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_page_allocator_fini(rcutils_page_allocator_t * page_allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(page_allocator, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_page_allocator_impl_t * impl = page_allocator->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl, allocator.state);
+  page_allocator->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_allocator_t
+rcutils_page_allocator_get_allocator(const rcutils_page_allocator_t * page_allocator)
+{
+  if (NULL == page_allocator || NULL == page_allocator->impl) {
+    return rcutils_get_zero_initialized_allocator();
+  }
+  rcutils_allocator_t allocator = {
+    .allocate = page_allocator_allocate,
+    .deallocate = page_allocator_deallocate,
+    .reallocate = page_allocator_reallocate,
+    .zero_allocate = page_allocator_zero_allocate,
+    .state = page_allocator->impl,
+  };
+  return allocator;
+}
@@ -17,6 +17,9 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
@@ -38,9 +41,27 @@ typedef struct rcutils_array_list_impl_s
   size_t capacity;
   void * list;
   size_t data_size;
+  // The entries are stored inline, after the impl, rather than in an allocation of their own
+  bool is_inline;
+  // The number of entries which fit inline, even once they are moved out, or 0 for none
+  size_t inline_capacity;
   rcutils_allocator_t allocator;
 } rcutils_array_list_impl_t;
 
+// The entries of a list initialized with rcutils_array_list_init_with_inline_capacity() are first
+// stored inline, after the impl, aligned for any type they may be.
+typedef struct array_list_inline_layout_s
+{
+  rcutils_array_list_impl_t impl;
+  union
+  {
+    long double d;
+    uint64_t u;
+    void * p;
+  } inline_list;
+} array_list_inline_layout_t;
+#define ARRAY_LIST_INLINE_OFFSET (offsetof(array_list_inline_layout_t, inline_list))
+
 rcutils_array_list_t
 rcutils_get_zero_initialized_array_list(void)
 {
@@ -77,6 +98,8 @@ rcutils_array_list_init(
   array_list->impl->capacity = initial_capacity;
   array_list->impl->size = 0;
   array_list->impl->data_size = data_size;
+  array_list->impl->is_inline = false;
+  array_list->impl->inline_capacity = 0;
   array_list->impl->list = allocator->allocate(initial_capacity * data_size, allocator->state);
   if (NULL == array_list->impl->list) {
     allocator->deallocate(array_list->impl, allocator->state);
@@ -89,27 +112,87 @@ rcutils_array_list_init(
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_array_list_init_with_inline_capacity(
+  rcutils_array_list_t * array_list,
+  size_t inline_capacity,
+  size_t data_size,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(array_list, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != array_list->impl) {
+    RCUTILS_SET_ERROR_MSG("array_list is already initialized");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  } else if (1 > inline_capacity) {
+    RCUTILS_SET_ERROR_MSG("inline_capacity cannot be less than 1");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  } else if (1 > data_size) {
+    RCUTILS_SET_ERROR_MSG("data_size cannot be less than 1");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  } else if (inline_capacity > (SIZE_MAX - ARRAY_LIST_INLINE_OFFSET) / data_size) {
+    RCUTILS_SET_ERROR_MSG("inline_capacity is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  // The impl and the inline entries take a single allocation
+  array_list->impl = allocator->allocate(
+    ARRAY_LIST_INLINE_OFFSET + inline_capacity * data_size, allocator->state);
+  if (NULL == array_list->impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for array list impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  array_list->impl->capacity = inline_capacity;
+  array_list->impl->size = 0;
+  array_list->impl->data_size = data_size;
+  array_list->impl->list = (uint8_t *)array_list->impl + ARRAY_LIST_INLINE_OFFSET;
+  array_list->impl->is_inline = true;
+  array_list->impl->inline_capacity = inline_capacity;
+  array_list->impl->allocator = *allocator;
+
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_array_list_fini(rcutils_array_list_t * array_list)
 {
   ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
 
-  array_list->impl->allocator.deallocate(array_list->impl->list, array_list->impl->allocator.state);
+  if (!array_list->impl->is_inline) {
+    array_list->impl->allocator.deallocate(
+      array_list->impl->list, array_list->impl->allocator.state);
+  }
   array_list->impl->allocator.deallocate(array_list->impl, array_list->impl->allocator.state);
   array_list->impl = NULL;
 
   return RCUTILS_RET_OK;
 }
 
-static rcutils_ret_t rcutils_array_list_increase_capacity(rcutils_array_list_t * array_list)
+// Grows the capacity to at least min_capacity, doubling it at least, so that adding elements one
+// after the other takes amortized constant time.
+// Moves the entries into storage for new_capacity entries, out of the impl if they are inline.
+static rcutils_ret_t rcutils_array_list_set_capacity(
+  rcutils_array_list_t * array_list,
+  size_t new_capacity)
 {
-  size_t new_capacity = 2 * array_list->impl->capacity;
   size_t new_size = array_list->impl->data_size * new_capacity;
-  void * new_list = array_list->impl->allocator.reallocate(
-    array_list->impl->list,
-    new_size,
-    array_list->impl->allocator.state);
+  void * new_list = NULL;
+  if (array_list->impl->is_inline) {
+    new_list = array_list->impl->allocator.allocate(new_size, array_list->impl->allocator.state);
+    if (NULL != new_list) {
+      memcpy(
+        new_list, array_list->impl->list, array_list->impl->data_size * array_list->impl->size);
+      array_list->impl->is_inline = false;
+    }
+  } else {
+    new_list = array_list->impl->allocator.reallocate(
+      array_list->impl->list,
+      new_size,
+      array_list->impl->allocator.state);
+  }
   if (NULL == new_list) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for array list data");
     return RCUTILS_RET_BAD_ALLOC;
   }
   array_list->impl->list = new_list;
@@ -117,6 +200,23 @@ static rcutils_ret_t rcutils_array_list_increase_capacity(rcutils_array_list_t *
   return RCUTILS_RET_OK;
 }
 
+static rcutils_ret_t rcutils_array_list_increase_capacity(
+  rcutils_array_list_t * array_list,
+  size_t min_capacity)
+{
+  size_t max_capacity = SIZE_MAX / array_list->impl->data_size;
+  if (min_capacity > max_capacity) {
+    RCUTILS_SET_ERROR_MSG("requested capacity for array list too large");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  size_t new_capacity = array_list->impl->capacity > max_capacity / 2 ?
+    max_capacity : 2 * array_list->impl->capacity;
+  if (new_capacity < min_capacity) {
+    new_capacity = min_capacity;
+  }
+  return rcutils_array_list_set_capacity(array_list, new_capacity);
+}
+
 static uint8_t * rcutils_array_list_get_pointer_for_index(
   const rcutils_array_list_t * array_list,
   size_t index)
@@ -134,7 +234,7 @@ rcutils_array_list_add(rcutils_array_list_t * array_list, const void * data)
   rcutils_ret_t ret = RCUTILS_RET_OK;
 
   if (array_list->impl->size + 1 > array_list->impl->capacity) {
-    ret = rcutils_array_list_increase_capacity(array_list);
+    ret = rcutils_array_list_increase_capacity(array_list, array_list->impl->size + 1);
     if (RCUTILS_RET_OK != ret) {
       return ret;
     }
@@ -148,6 +248,91 @@ rcutils_array_list_add(rcutils_array_list_t * array_list, const void * data)
   return ret;
 }
 
+rcutils_ret_t
+rcutils_array_list_add_n(rcutils_array_list_t * array_list, const void * data, size_t count)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+
+  if (count > SIZE_MAX - array_list->impl->size) {
+    RCUTILS_SET_ERROR_MSG("count is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (array_list->impl->size + count > array_list->impl->capacity) {
+    ret = rcutils_array_list_increase_capacity(array_list, array_list->impl->size + count);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+
+  uint8_t * index_ptr =
+    rcutils_array_list_get_pointer_for_index(array_list, array_list->impl->size);
+  memcpy(index_ptr, data, array_list->impl->data_size * count);
+
+  array_list->impl->size += count;
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_array_list_reserve(rcutils_array_list_t * array_list, size_t capacity)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  if (capacity <= array_list->impl->capacity) {
+    return RCUTILS_RET_OK;
+  }
+  if (capacity > SIZE_MAX / array_list->impl->data_size) {
+    RCUTILS_SET_ERROR_MSG("requested capacity for array list too large");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  // Reserve exactly the requested capacity, the caller knows how many elements will be added
+  return rcutils_array_list_set_capacity(array_list, capacity);
+}
+
+rcutils_ret_t
+rcutils_array_list_shrink_to_fit(rcutils_array_list_t * array_list)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  rcutils_array_list_impl_t * impl = array_list->impl;
+  if (impl->is_inline) {
+    return RCUTILS_RET_OK;
+  }
+  if (impl->inline_capacity > 0 && impl->size <= impl->inline_capacity) {
+    // Move the entries back inline, where there is room for them anyway
+    void * inline_list = (uint8_t *)impl + ARRAY_LIST_INLINE_OFFSET;
+    memcpy(inline_list, impl->list, impl->data_size * impl->size);
+    impl->allocator.deallocate(impl->list, impl->allocator.state);
+    impl->list = inline_list;
+    impl->capacity = impl->inline_capacity;
+    impl->is_inline = true;
+    return RCUTILS_RET_OK;
+  }
+  // Keep room for an entry at least, as for rcutils_array_list_init()
+  const size_t new_capacity = impl->size > 0 ? impl->size : 1;
+  if (new_capacity == impl->capacity) {
+    return RCUTILS_RET_OK;
+  }
+  return rcutils_array_list_set_capacity(array_list, new_capacity);
+}
+
+rcutils_ret_t
+rcutils_array_list_get_allocated_size(
+  const rcutils_array_list_t * array_list, size_t * allocated_size)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocated_size, RCUTILS_RET_INVALID_ARGUMENT);
+  const rcutils_array_list_impl_t * impl = array_list->impl;
+  size_t size = sizeof(rcutils_array_list_impl_t);
+  if (impl->inline_capacity > 0) {
+    size = ARRAY_LIST_INLINE_OFFSET + impl->inline_capacity * impl->data_size;
+  }
+  if (!impl->is_inline) {
+    size += impl->capacity * impl->data_size;
+  }
+  *allocated_size = size;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_array_list_set(rcutils_array_list_t * array_list, size_t index, const void * data)
 {
@@ -172,7 +357,26 @@ rcutils_array_list_remove(rcutils_array_list_t * array_list, size_t index)
   if (copy_count > 0) {
     uint8_t * dst_ptr = rcutils_array_list_get_pointer_for_index(array_list, index);
     uint8_t * src_ptr = rcutils_array_list_get_pointer_for_index(array_list, index + 1);
-    memcpy(dst_ptr, src_ptr, array_list->impl->data_size * copy_count);
+    memmove(dst_ptr, src_ptr, array_list->impl->data_size * copy_count);
+  }
+
+  array_list->impl->size--;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_array_list_swap_remove(rcutils_array_list_t * array_list, size_t index)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  ARRAY_LIST_VALIDATE_INDEX_IN_BOUNDS(array_list, index);
+
+  // Move the last entry into the place of the removed one
+  size_t last_index = array_list->impl->size - 1;
+  if (index != last_index) {
+    memcpy(
+      rcutils_array_list_get_pointer_for_index(array_list, index),
+      rcutils_array_list_get_pointer_for_index(array_list, last_index),
+      array_list->impl->data_size);
   }
 
   array_list->impl->size--;
@@ -192,6 +396,18 @@ rcutils_array_list_get(const rcutils_array_list_t * array_list, size_t index, vo
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_array_list_get_ptr(const rcutils_array_list_t * array_list, size_t index, void ** data)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  ARRAY_LIST_VALIDATE_INDEX_IN_BOUNDS(array_list, index);
+
+  *data = rcutils_array_list_get_pointer_for_index(array_list, index);
+
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_array_list_get_size(const rcutils_array_list_t * array_list, size_t * size)
 {
@@ -0,0 +1,681 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+#ifdef __linux__
+# include <sys/syscall.h>
+#endif
+// There is no io_uring library to depend on, so the kernel interface is used directly.
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+# define ASYNC_WRITE_HAS_IO_URING
+# include <linux/io_uring.h>
+# include <sys/eventfd.h>
+# include <sys/mman.h>
+#endif
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/async_write.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/macros.h"
+
+#define ASYNC_WRITE_DEFAULT_QUEUE_DEPTH (64u)
+#define ASYNC_WRITE_DEFAULT_THREAD_COUNT (2u)
+// The most writes in flight with io_uring, far below the limit of the kernel.
+#define ASYNC_WRITE_MAX_QUEUE_DEPTH (4096u)
+// How long threads wait at a time for requests to be queued or completed.
+#define ASYNC_WRITE_WAIT_MS (100u)
+// The most bytes written at once, which fits the length of an io_uring write.
+#define ASYNC_WRITE_MAX_CHUNK ((size_t)1 << 30)
+
+typedef struct async_write_request_s
+{
+  struct async_write_request_s * next;
+  int fd;
+  const uint8_t * data;
+  size_t length;
+  int64_t offset;
+  // The number of bytes written so far.
+  size_t written;
+  rcutils_async_write_callback_t callback;
+  void * context;
+} async_write_request_t;
+
+#ifdef ASYNC_WRITE_HAS_IO_URING
+typedef struct async_write_ring_s
+{
+  int fd;
+  // The submission and completion queue rings, which share a single mapping.
+  void * rings;
+  size_t rings_size;
+  struct io_uring_sqe * sqes;
+  size_t sqes_size;
+  unsigned * sq_head;
+  unsigned * sq_tail;
+  unsigned * sq_array;
+  unsigned sq_mask;
+  unsigned * cq_head;
+  unsigned * cq_tail;
+  struct io_uring_cqe * cqes;
+  unsigned cq_mask;
+} async_write_ring_t;
+#endif
+
+typedef struct rcutils_async_writer_impl_s
+{
+  rcutils_allocator_t allocator;
+  rcutils_async_write_backend_t backend;
+
+  // Everything below up to the threads is protected by the mutex.
+  rcutils_mutex_t mutex;
+  // Notified when requests are queued for the thread pool, and when stopping.
+  rcutils_condition_variable_t work_cv;
+  // Notified when requests complete while a thread is flushing.
+  rcutils_condition_variable_t done_cv;
+  // The requests submitted and not taken by a thread yet, in submission order.
+  async_write_request_t * queue_head;
+  async_write_request_t * queue_tail;
+  // The completed requests, reused for new submissions.
+  async_write_request_t * free_requests;
+  uint64_t submitted_count;
+  uint64_t completed_count;
+  size_t flush_waiters;
+  bool stopping;
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  // The ring thread is waiting for completions, and has to be woken up for new requests.
+  bool ring_waiting;
+#endif
+
+  rcutils_thread_t * threads;
+  size_t thread_count;
+  bool mutex_initialized;
+  bool cv_initialized;
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  // Written to wake the ring thread up, which has a read of it in flight.
+  int wake_fd;
+  uint64_t wake_value;
+  uint32_t queue_depth;
+  bool ring_initialized;
+  async_write_ring_t ring;
+#endif
+} rcutils_async_writer_impl_t;
+
+#define ASYNC_WRITE_VALIDATE_WRITER(writer) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(writer, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == writer->impl) { \
+    RCUTILS_SET_ERROR_MSG("async writer is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+// Write the rest of the request with blocking writes, and return whether all of it was written.
+static bool write_request(async_write_request_t * request)
+{
+  while (request->written < request->length) {
+    size_t remaining = request->length - request->written;
+    size_t chunk = remaining < ASYNC_WRITE_MAX_CHUNK ? remaining : ASYNC_WRITE_MAX_CHUNK;
+    uint64_t offset = (uint64_t)request->offset + request->written;
+#ifdef _WIN32
+    HANDLE handle = (HANDLE)_get_osfhandle(request->fd);
+    if (INVALID_HANDLE_VALUE == handle) {
+      return false;
+    }
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD)(offset & 0xFFFFFFFFu);
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD result = 0;
+    if (!WriteFile(handle, request->data + request->written, (DWORD)chunk, &result, &overlapped)) {
+      return false;
+    }
+#else
+    ssize_t result = pwrite(request->fd, request->data + request->written, chunk, (off_t)offset);
+    if (result < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+#endif
+    if (0 == result) {
+      return false;
+    }
+    request->written += (size_t)result;
+  }
+  return true;
+}
+
+static void complete_request(
+  rcutils_async_writer_impl_t * impl, async_write_request_t * request, rcutils_ret_t ret)
+{
+  if (NULL != request->callback) {
+    request->callback(ret, request->written, request->context);
+  }
+  rcutils_mutex_lock(&impl->mutex);
+  request->next = impl->free_requests;
+  impl->free_requests = request;
+  ++impl->completed_count;
+  if (impl->flush_waiters > 0u) {
+    rcutils_condition_variable_notify_all(&impl->done_cv);
+  }
+  rcutils_mutex_unlock(&impl->mutex);
+}
+
+static void pool_thread(void * arg)
+{
+  rcutils_async_writer_impl_t * impl = (rcutils_async_writer_impl_t *)arg;
+  rcutils_mutex_lock(&impl->mutex);
+  for (;;) {
+    async_write_request_t * request = impl->queue_head;
+    if (NULL == request) {
+      if (impl->stopping) {
+        break;
+      }
+      rcutils_condition_variable_wait_for(&impl->work_cv, &impl->mutex, ASYNC_WRITE_WAIT_MS);
+      continue;
+    }
+    impl->queue_head = request->next;
+    if (NULL == impl->queue_head) {
+      impl->queue_tail = NULL;
+    }
+    rcutils_mutex_unlock(&impl->mutex);
+
+    bool written = write_request(request);
+    complete_request(impl, request, written ? RCUTILS_RET_OK : RCUTILS_RET_ERROR);
+
+    rcutils_mutex_lock(&impl->mutex);
+  }
+  rcutils_mutex_unlock(&impl->mutex);
+}
+
+#ifdef ASYNC_WRITE_HAS_IO_URING
+static bool ring_init(async_write_ring_t * ring, unsigned entries)
+{
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+  if (ring->fd < 0) {
+    return false;
+  }
+  // Writes to regular files came along with this feature, in Linux 5.6, which maps both rings
+  // at once since 5.4.
+  if (0u == (params.features & IORING_FEAT_RW_CUR_POS) ||
+    0u == (params.features & IORING_FEAT_SINGLE_MMAP))
+  {
+    (void)close(ring->fd);
+    return false;
+  }
+
+  size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  ring->rings_size = sq_size > cq_size ? sq_size : cq_size;
+  ring->rings = mmap(
+    NULL, ring->rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+    IORING_OFF_SQ_RING);
+  if (MAP_FAILED == ring->rings) {
+    (void)close(ring->fd);
+    return false;
+  }
+  ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = mmap(
+    NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+    IORING_OFF_SQES);
+  if (MAP_FAILED == ring->sqes) {
+    (void)munmap(ring->rings, ring->rings_size);
+    (void)close(ring->fd);
+    return false;
+  }
+
+  char * rings = (char *)ring->rings;
+  ring->sq_head = (unsigned *)(rings + params.sq_off.head);
+  ring->sq_tail = (unsigned *)(rings + params.sq_off.tail);
+  ring->sq_array = (unsigned *)(rings + params.sq_off.array);
+  ring->sq_mask = *(unsigned *)(rings + params.sq_off.ring_mask);
+  ring->cq_head = (unsigned *)(rings + params.cq_off.head);
+  ring->cq_tail = (unsigned *)(rings + params.cq_off.tail);
+  ring->cqes = (struct io_uring_cqe *)(rings + params.cq_off.cqes);
+  ring->cq_mask = *(unsigned *)(rings + params.cq_off.ring_mask);
+  return true;
+}
+
+static void ring_fini(async_write_ring_t * ring)
+{
+  (void)munmap(ring->sqes, ring->sqes_size);
+  (void)munmap(ring->rings, ring->rings_size);
+  (void)close(ring->fd);
+}
+
+// Fill the next submission queue entry, which is only submitted once the tail is published.
+static void ring_prepare(
+  async_write_ring_t * ring, unsigned * sq_tail, uint8_t opcode, int fd, const void * data,
+  size_t length, uint64_t offset, void * user_data)
+{
+  unsigned index = *sq_tail & ring->sq_mask;
+  struct io_uring_sqe * sqe = &ring->sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = (uint64_t)(uintptr_t)data;
+  sqe->len = (uint32_t)length;
+  sqe->off = offset;
+  sqe->user_data = (uint64_t)(uintptr_t)user_data;
+  ring->sq_array[index] = index;
+  ++*sq_tail;
+}
+
+static void ring_thread(void * arg)
+{
+  rcutils_async_writer_impl_t * impl = (rcutils_async_writer_impl_t *)arg;
+  async_write_ring_t * ring = &impl->ring;
+  // The requests taken from the queue which don't fit in the ring yet.
+  async_write_request_t * head = NULL;
+  async_write_request_t * tail = NULL;
+  // The writes in flight, besides the read of the wake up file descriptor.
+  uint32_t in_flight = 0u;
+  bool wake_armed = false;
+
+  for (;;) {
+    rcutils_mutex_lock(&impl->mutex);
+    if (NULL != impl->queue_head) {
+      if (NULL == tail) {
+        head = impl->queue_head;
+      } else {
+        tail->next = impl->queue_head;
+      }
+      tail = impl->queue_tail;
+      impl->queue_head = NULL;
+      impl->queue_tail = NULL;
+    }
+    bool stop = impl->stopping && NULL == head && 0u == in_flight;
+    impl->ring_waiting = !stop;
+    rcutils_mutex_unlock(&impl->mutex);
+    if (stop) {
+      break;
+    }
+
+    // Only this thread writes the tail, so it needs no synchronization with itself.
+    unsigned sq_tail = *ring->sq_tail;
+    if (!wake_armed) {
+      ring_prepare(
+        ring, &sq_tail, IORING_OP_READ, impl->wake_fd, &impl->wake_value,
+        sizeof(impl->wake_value), 0u, NULL);
+      wake_armed = true;
+    }
+    while (NULL != head && in_flight < impl->queue_depth) {
+      async_write_request_t * request = head;
+      head = request->next;
+      if (NULL == head) {
+        tail = NULL;
+      }
+      size_t remaining = request->length - request->written;
+      if (0u == remaining) {
+        complete_request(impl, request, RCUTILS_RET_OK);
+        continue;
+      }
+      ring_prepare(
+        ring, &sq_tail, IORING_OP_WRITE, request->fd, request->data + request->written,
+        remaining < ASYNC_WRITE_MAX_CHUNK ? remaining : ASYNC_WRITE_MAX_CHUNK,
+        (uint64_t)request->offset + request->written, request);
+      ++in_flight;
+    }
+    __atomic_store_n(ring->sq_tail, sq_tail, __ATOMIC_RELEASE);
+
+    // Submit the whole batch and wait for a completion with a single system call.
+    unsigned to_submit = sq_tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    (void)syscall(
+      __NR_io_uring_enter, ring->fd, to_submit, 1u, IORING_ENTER_GETEVENTS, NULL, (size_t)0);
+
+    unsigned cq_head = *ring->cq_head;
+    const unsigned cq_tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    while (cq_head != cq_tail) {
+      const struct io_uring_cqe * cqe = &ring->cqes[cq_head & ring->cq_mask];
+      async_write_request_t * request = (async_write_request_t *)(uintptr_t)cqe->user_data;
+      int32_t result = cqe->res;
+      ++cq_head;
+      if (NULL == request) {
+        wake_armed = false;
+        continue;
+      }
+      --in_flight;
+      if (result > 0) {
+        request->written += (size_t)result;
+      }
+      if (-EINTR == result || -EAGAIN == result ||
+        (result > 0 && request->written < request->length))
+      {
+        // Retry, or continue a short write, before the other requests.
+        request->next = head;
+        head = request;
+        if (NULL == tail) {
+          tail = request;
+        }
+      } else {
+        complete_request(impl, request, result > 0 ? RCUTILS_RET_OK : RCUTILS_RET_ERROR);
+      }
+    }
+    __atomic_store_n(ring->cq_head, cq_head, __ATOMIC_RELEASE);
+  }
+}
+#endif
+
+static void free_impl(rcutils_async_writer_impl_t * impl)
+{
+  rcutils_allocator_t allocator = impl->allocator;
+  while (NULL != impl->free_requests) {
+    async_write_request_t * next = impl->free_requests->next;
+    allocator.deallocate(impl->free_requests, allocator.state);
+    impl->free_requests = next;
+  }
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  if (impl->ring_initialized) {
+    ring_fini(&impl->ring);
+  }
+  if (impl->wake_fd >= 0) {
+    (void)close(impl->wake_fd);
+  }
+#endif
+  if (impl->cv_initialized) {
+    rcutils_condition_variable_fini(&impl->done_cv);
+    rcutils_condition_variable_fini(&impl->work_cv);
+  }
+  if (impl->mutex_initialized) {
+    rcutils_mutex_fini(&impl->mutex);
+  }
+  allocator.deallocate(impl->threads, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+}
+
+// Stop the threads once the queued requests are written, and join the given number of them.
+static rcutils_ret_t stop_threads(rcutils_async_writer_impl_t * impl, size_t thread_count)
+{
+  rcutils_mutex_lock(&impl->mutex);
+  impl->stopping = true;
+  rcutils_condition_variable_notify_all(&impl->work_cv);
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  bool wake = impl->ring_waiting;
+  impl->ring_waiting = false;
+#endif
+  rcutils_mutex_unlock(&impl->mutex);
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  if (wake) {
+    (void)eventfd_write(impl->wake_fd, 1u);
+  }
+#endif
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0; i < thread_count; ++i) {
+    if (RCUTILS_RET_OK != rcutils_thread_join(&impl->threads[i])) {
+      ret = RCUTILS_RET_ERROR;
+    }
+  }
+  return ret;
+}
+
+rcutils_async_writer_options_t
+rcutils_async_writer_get_default_options(void)
+{
+  rcutils_async_writer_options_t options = {
+    .backend = RCUTILS_ASYNC_WRITE_BACKEND_AUTO,
+    .queue_depth = ASYNC_WRITE_DEFAULT_QUEUE_DEPTH,
+    .thread_count = ASYNC_WRITE_DEFAULT_THREAD_COUNT,
+    .thread_attributes = rcutils_get_default_thread_attributes(),
+  };
+  return options;
+}
+
+rcutils_async_writer_t
+rcutils_get_zero_initialized_async_writer(void)
+{
+  static rcutils_async_writer_t zero_initialized_async_writer = {NULL};
+  return zero_initialized_async_writer;
+}
+
+rcutils_ret_t
+rcutils_async_writer_init(
+  rcutils_async_writer_t * writer,
+  const rcutils_async_writer_options_t * options,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(writer, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_async_writer_options_t default_options = rcutils_async_writer_get_default_options();
+  if (NULL == options) {
+    options = &default_options;
+  }
+  switch (options->backend) {
+    case RCUTILS_ASYNC_WRITE_BACKEND_AUTO:
+    case RCUTILS_ASYNC_WRITE_BACKEND_IO_URING:
+    case RCUTILS_ASYNC_WRITE_BACKEND_THREADS:
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("invalid async write backend");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == options->queue_depth || 0u == options->thread_count) {
+    RCUTILS_SET_ERROR_MSG("invalid async writer options");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_async_writer_impl_t * impl =
+    allocator->zero_allocate(1, sizeof(rcutils_async_writer_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for async writer impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->allocator = *allocator;
+  impl->backend = RCUTILS_ASYNC_WRITE_BACKEND_THREADS;
+  impl->thread_count = options->thread_count;
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  impl->wake_fd = -1;
+#endif
+
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->mutex)) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the mutex of the async writer");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->mutex_initialized = true;
+  if (RCUTILS_RET_OK != rcutils_condition_variable_init(&impl->work_cv)) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the condition variables of the async writer");
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK != rcutils_condition_variable_init(&impl->done_cv)) {
+    rcutils_condition_variable_fini(&impl->work_cv);
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the condition variables of the async writer");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->cv_initialized = true;
+
+  if (RCUTILS_ASYNC_WRITE_BACKEND_THREADS != options->backend) {
+#ifdef ASYNC_WRITE_HAS_IO_URING
+    impl->queue_depth = options->queue_depth < ASYNC_WRITE_MAX_QUEUE_DEPTH ?
+      options->queue_depth : ASYNC_WRITE_MAX_QUEUE_DEPTH;
+    impl->wake_fd = eventfd(0u, EFD_CLOEXEC);
+    // One more entry for the read of the wake up file descriptor.
+    if (impl->wake_fd >= 0 && ring_init(&impl->ring, impl->queue_depth + 1u)) {
+      impl->ring_initialized = true;
+      impl->backend = RCUTILS_ASYNC_WRITE_BACKEND_IO_URING;
+      impl->thread_count = 1u;
+    }
+#endif
+    if (RCUTILS_ASYNC_WRITE_BACKEND_IO_URING == options->backend &&
+      RCUTILS_ASYNC_WRITE_BACKEND_IO_URING != impl->backend)
+    {
+      free_impl(impl);
+      RCUTILS_SET_ERROR_MSG("io_uring is not available");
+      return RCUTILS_RET_ERROR;
+    }
+  }
+
+  if (impl->thread_count > SIZE_MAX / sizeof(rcutils_thread_t)) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("too many async writer threads");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  impl->threads =
+    allocator->allocate(impl->thread_count * sizeof(rcutils_thread_t), allocator->state);
+  if (NULL == impl->threads) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for async writer threads");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  rcutils_thread_function_t thread_function = pool_thread;
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  if (RCUTILS_ASYNC_WRITE_BACKEND_IO_URING == impl->backend) {
+    thread_function = ring_thread;
+  }
+#endif
+  for (size_t i = 0; i < impl->thread_count; ++i) {
+    rcutils_ret_t ret = rcutils_thread_create_with_attributes(
+      &impl->threads[i], thread_function, impl, &options->thread_attributes);
+    if (RCUTILS_RET_OK != ret) {
+      (void)stop_threads(impl, i);
+      free_impl(impl);
+      return ret;
+    }
+  }
+
+  writer->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_async_writer_fini(rcutils_async_writer_t * writer)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(writer, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_async_writer_impl_t * impl = writer->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  if (RCUTILS_RET_OK != stop_threads(impl, impl->thread_count)) {
+    RCUTILS_SET_ERROR_MSG("failed to join the async writer threads");
+    return RCUTILS_RET_ERROR;
+  }
+  free_impl(impl);
+  writer->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_async_write_backend_t
+rcutils_async_writer_get_backend(const rcutils_async_writer_t * writer)
+{
+  if (NULL == writer || NULL == writer->impl) {
+    return RCUTILS_ASYNC_WRITE_BACKEND_AUTO;
+  }
+  return writer->impl->backend;
+}
+
+rcutils_ret_t
+rcutils_async_write(
+  rcutils_async_writer_t * writer,
+  int fd,
+  const void * data,
+  size_t length,
+  int64_t offset,
+  rcutils_async_write_callback_t callback,
+  void * context)
+{
+  ASYNC_WRITE_VALIDATE_WRITER(writer);
+  if (length > 0u) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  if (fd < 0 || offset < 0 || length > (uint64_t)(INT64_MAX - offset)) {
+    RCUTILS_SET_ERROR_MSG("invalid file descriptor or offset");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  rcutils_async_writer_impl_t * impl = writer->impl;
+
+  rcutils_mutex_lock(&impl->mutex);
+  async_write_request_t * request = impl->free_requests;
+  if (NULL != request) {
+    impl->free_requests = request->next;
+  }
+  rcutils_mutex_unlock(&impl->mutex);
+  if (NULL == request) {
+    request = impl->allocator.allocate(sizeof(async_write_request_t), impl->allocator.state);
+    if (NULL == request) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for async write request");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  request->next = NULL;
+  request->fd = fd;
+  request->data = (const uint8_t *)data;
+  request->length = length;
+  request->offset = offset;
+  request->written = 0u;
+  request->callback = callback;
+  request->context = context;
+
+  rcutils_mutex_lock(&impl->mutex);
+  if (NULL == impl->queue_tail) {
+    impl->queue_head = request;
+  } else {
+    impl->queue_tail->next = request;
+  }
+  impl->queue_tail = request;
+  ++impl->submitted_count;
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  // Only wake the ring thread up once, it takes all the queued requests.
+  bool wake = impl->ring_waiting;
+  impl->ring_waiting = false;
+#endif
+  if (RCUTILS_ASYNC_WRITE_BACKEND_THREADS == impl->backend) {
+    rcutils_condition_variable_notify_all(&impl->work_cv);
+  }
+  rcutils_mutex_unlock(&impl->mutex);
+#ifdef ASYNC_WRITE_HAS_IO_URING
+  if (wake) {
+    (void)eventfd_write(impl->wake_fd, 1u);
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_async_writer_flush(rcutils_async_writer_t * writer)
+{
+  ASYNC_WRITE_VALIDATE_WRITER(writer);
+  rcutils_async_writer_impl_t * impl = writer->impl;
+  rcutils_mutex_lock(&impl->mutex);
+  ++impl->flush_waiters;
+  while (impl->completed_count < impl->submitted_count) {
+    rcutils_condition_variable_wait_for(&impl->done_cv, &impl->mutex, ASYNC_WRITE_WAIT_MS);
+  }
+  --impl->flush_waiters;
+  rcutils_mutex_unlock(&impl->mutex);
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
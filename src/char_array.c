@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
 #include "rcutils/error_handling.h"
 #include "rcutils/types/char_array.h"
 
@@ -148,55 +152,158 @@ rcutils_char_array_expand_as_needed(rcutils_char_array_t * char_array, size_t ne
   return rcutils_char_array_resize(char_array, new_size);
 }
 
-static int
-_rcutils_char_array_vsprintf(rcutils_char_array_t * char_array, const char * format, va_list args)
+rcutils_ret_t
+rcutils_char_array_shrink_to_fit(rcutils_char_array_t * char_array)
 {
-  va_list args_clone;
-  va_copy(args_clone, args);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_INVALID_ARGUMENT);
 
-  // when doing size calculation, remember the return value of vsnprintf excludes terminating null
-  // byte
-  int size = vsnprintf(char_array->buffer, char_array->buffer_capacity, format, args_clone);
+  if (!char_array->owns_buffer || char_array->buffer_length == char_array->buffer_capacity) {
+    // a buffer which isn't owned isn't ours to give back
+    return RCUTILS_RET_OK;
+  }
 
-  va_end(args_clone);
+  rcutils_allocator_t * allocator = &char_array->allocator;
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "char array has no valid allocator",
+    return RCUTILS_RET_ERROR);
+
+  if (0lu == char_array->buffer_length) {
+    allocator->deallocate(char_array->buffer, allocator->state);
+    char_array->buffer = NULL;
+    char_array->buffer_capacity = 0lu;
+    return RCUTILS_RET_OK;
+  }
 
-  return size;
+  // unlike rcutils_char_array_resize(), keep the buffer if reallocating it fails
+  char * new_buf = allocator->reallocate(
+    char_array->buffer, char_array->buffer_length * sizeof(char), allocator->state);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    new_buf,
+    "failed to reallocate memory for char array",
+    return RCUTILS_RET_BAD_ALLOC);
+  char_array->buffer = new_buf;
+  char_array->buffer_capacity = char_array->buffer_length;
+
+  return RCUTILS_RET_OK;
 }
 
 rcutils_ret_t
-rcutils_char_array_vsprintf(rcutils_char_array_t * char_array, const char * format, va_list args)
+rcutils_char_array_get_allocated_size(
+  const rcutils_char_array_t * char_array, size_t * allocated_size)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocated_size, RCUTILS_RET_INVALID_ARGUMENT);
+
+  *allocated_size = char_array->owns_buffer ? char_array->buffer_capacity : 0lu;
+  return RCUTILS_RET_OK;
+}
+
+// Grow the buffer of a char array to hold at least new_size bytes, keeping only its first
+// keep bytes, so that a buffer which is about to be overwritten isn't copied for nothing.
+static rcutils_ret_t
+_rcutils_char_array_expand_keeping(
+  rcutils_char_array_t * char_array, size_t new_size, size_t keep)
+{
+  if (0lu != keep || !char_array->owns_buffer || NULL == char_array->buffer) {
+    return rcutils_char_array_expand_as_needed(char_array, new_size);
+  }
+
+  rcutils_allocator_t * allocator = &char_array->allocator;
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "char array has no valid allocator",
+    return RCUTILS_RET_ERROR);
+
+  // Make sure we expand by at least 1.5x the old capacity, as rcutils_char_array_expand_as_needed
+  size_t minimum_size = char_array->buffer_capacity + (char_array->buffer_capacity >> 1);
+  if (new_size < minimum_size) {
+    new_size = minimum_size;
+  }
+
+  char * new_buf = (char *)allocator->allocate(new_size * sizeof(char), allocator->state);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    new_buf,
+    "failed to allocate memory for char array",
+    return RCUTILS_RET_BAD_ALLOC);
+  allocator->deallocate(char_array->buffer, allocator->state);
+  new_buf[0] = '\0';
+  char_array->buffer = new_buf;
+  char_array->buffer_capacity = new_size;
+  char_array->buffer_length = 0lu;
+
+  return RCUTILS_RET_OK;
+}
+
+// Format into the buffer of a char array from the given offset on, which is tried in the
+// current capacity first, and only formatted again if the output doesn't fit there.
+static rcutils_ret_t
+_rcutils_char_array_vsprintf_at(
+  rcutils_char_array_t * char_array, size_t offset, const char * format, va_list args)
 {
-  int size = _rcutils_char_array_vsprintf(char_array, format, args);
+  char * tail = NULL;
+  size_t available = 0lu;
+  if (char_array->buffer_capacity > offset) {
+    tail = char_array->buffer + offset;
+    available = char_array->buffer_capacity - offset;
+  }
+
+  va_list args_clone;
+  va_copy(args_clone, args);
+  // remember the return value of vsnprintf excludes the terminating null byte
+  int size = vsnprintf(tail, available, format, args_clone);
+  va_end(args_clone);
 
   if (size < 0) {
     RCUTILS_SET_ERROR_MSG("vsprintf on char array failed");
     return RCUTILS_RET_ERROR;
   }
 
-  size_t new_size = (size_t) size + 1;  // with the terminating null byte
+  size_t new_length = offset + (size_t) size + 1;  // with the terminating null byte
 
-  if (new_size > char_array->buffer_capacity) {
-    rcutils_ret_t ret = rcutils_char_array_expand_as_needed(char_array, new_size);
+  if (new_length > char_array->buffer_capacity) {
+    rcutils_ret_t ret = _rcutils_char_array_expand_keeping(char_array, new_length, offset);
     if (ret != RCUTILS_RET_OK) {
+      if (NULL != tail) {
+        // drop the part of the output which did fit
+        tail[0] = '\0';
+        char_array->buffer_length = offset + 1;
+      }
       RCUTILS_SET_ERROR_MSG("char array failed to expand");
       return ret;
     }
 
-    if (_rcutils_char_array_vsprintf(char_array, format, args) != size) {
-      if (rcutils_char_array_fini(char_array) == RCUTILS_RET_OK) {
-        RCUTILS_SET_ERROR_MSG("vsprintf on resized char array failed");
-      } else {
-        RCUTILS_SET_ERROR_MSG("vsprintf on resized char array failed; clean up failed too");
-      }
+    va_copy(args_clone, args);
+    int resized_size = vsnprintf(
+      char_array->buffer + offset, char_array->buffer_capacity - offset, format, args_clone);
+    va_end(args_clone);
+    if (resized_size != size) {
+      RCUTILS_SET_ERROR_MSG("vsprintf on resized char array failed");
       return RCUTILS_RET_ERROR;
     }
   }
 
-  char_array->buffer_length = new_size;
+  char_array->buffer_length = new_length;
 
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_char_array_vsprintf(rcutils_char_array_t * char_array, const char * format, va_list args)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_ERROR);
+
+  return _rcutils_char_array_vsprintf_at(char_array, 0lu, format, args);
+}
+
+rcutils_ret_t
+rcutils_char_array_vstrcatf(rcutils_char_array_t * char_array, const char * format, va_list args)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_ERROR);
+
+  // The buffer length always contains the trailing \0, so the strlen is one less than that.
+  size_t current_strlen = 0lu == char_array->buffer_length ? 0lu : char_array->buffer_length - 1;
+  return _rcutils_char_array_vsprintf_at(char_array, current_strlen, format, args);
+}
+
 rcutils_ret_t
 rcutils_char_array_memcpy(rcutils_char_array_t * char_array, const char * src, size_t n)
 {
@@ -245,3 +352,156 @@ rcutils_char_array_strcat(rcutils_char_array_t * char_array, const char * src)
 {
   return rcutils_char_array_strncat(char_array, src, strlen(src));
 }
+
+static const char g_two_digits[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+// The most decimal digits of a uint64_t.
+#define MAX_UINT64_DIGITS (20u)
+
+// Make room for n more characters after the string in the buffer, and return where they go.
+static rcutils_ret_t
+_rcutils_char_array_reserve_tail(rcutils_char_array_t * char_array, size_t n, char ** tail)
+{
+  // The buffer length always contains the trailing \0, so the strlen is one less than that.
+  size_t current_strlen = 0lu == char_array->buffer_length ? 0lu : char_array->buffer_length - 1;
+  if (n > SIZE_MAX - current_strlen - 1) {
+    RCUTILS_SET_ERROR_MSG("char array would be too long");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  size_t new_length = current_strlen + n + 1;
+  rcutils_ret_t ret = rcutils_char_array_expand_as_needed(char_array, new_length);
+  if (ret != RCUTILS_RET_OK) {
+    RCUTILS_SET_ERROR_MSG("char array failed to expand");
+    return ret;
+  }
+  char_array->buffer[new_length - 1] = '\0';
+  char_array->buffer_length = new_length;
+  *tail = char_array->buffer + current_strlen;
+  return RCUTILS_RET_OK;
+}
+
+// Render value into the end of digits, padded with zeros to at least min_digits digits, and
+// return the number of digits, which were written before digits + MAX_UINT64_DIGITS.
+static size_t
+_rcutils_render_digits(uint64_t value, size_t min_digits, char * digits)
+{
+  size_t i = MAX_UINT64_DIGITS;
+  while (value >= 100u) {
+    const size_t pair = (size_t)(value % 100u) * 2u;
+    value /= 100u;
+    digits[--i] = g_two_digits[pair + 1];
+    digits[--i] = g_two_digits[pair];
+  }
+  if (value >= 10u) {
+    digits[--i] = g_two_digits[value * 2u + 1];
+    digits[--i] = g_two_digits[value * 2u];
+  } else {
+    digits[--i] = (char)('0' + value);
+  }
+  while (MAX_UINT64_DIGITS - i < min_digits) {
+    digits[--i] = '0';
+  }
+  return MAX_UINT64_DIGITS - i;
+}
+
+// Append the digits of value, after a '-' if negative, and with a decimal point before the last
+// decimals digits, if any.
+static rcutils_ret_t
+_rcutils_char_array_append_number(
+  rcutils_char_array_t * char_array, uint64_t value, bool negative, size_t decimals)
+{
+  char digits[MAX_UINT64_DIGITS];
+  // A fixed-point number has at least one digit before the decimal point.
+  size_t count = _rcutils_render_digits(value, decimals + 1, digits);
+  const char * first_digit = digits + MAX_UINT64_DIGITS - count;
+
+  size_t length = count + (negative ? 1u : 0u) + (decimals > 0u ? 1u : 0u);
+  char * tail = NULL;
+  rcutils_ret_t ret = _rcutils_char_array_reserve_tail(char_array, length, &tail);
+  if (ret != RCUTILS_RET_OK) {
+    return ret;
+  }
+  if (negative) {
+    *tail++ = '-';
+  }
+  if (decimals > 0u) {
+    size_t integer_digits = count - decimals;
+    memcpy(tail, first_digit, integer_digits);
+    tail[integer_digits] = '.';
+    memcpy(tail + integer_digits + 1, first_digit + integer_digits, decimals);
+  } else {
+    memcpy(tail, first_digit, count);
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_char_array_append_char(rcutils_char_array_t * char_array, char c)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_ERROR);
+
+  char * tail = NULL;
+  rcutils_ret_t ret = _rcutils_char_array_reserve_tail(char_array, 1u, &tail);
+  if (ret != RCUTILS_RET_OK) {
+    return ret;
+  }
+  *tail = c;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_char_array_append_repeated_char(
+  rcutils_char_array_t * char_array, char c, size_t count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_ERROR);
+
+  char * tail = NULL;
+  rcutils_ret_t ret = _rcutils_char_array_reserve_tail(char_array, count, &tail);
+  if (ret != RCUTILS_RET_OK) {
+    return ret;
+  }
+  memset(tail, c, count);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_char_array_append_uint(rcutils_char_array_t * char_array, uint64_t value)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_ERROR);
+
+  return _rcutils_char_array_append_number(char_array, value, false, 0u);
+}
+
+rcutils_ret_t
+rcutils_char_array_append_int(rcutils_char_array_t * char_array, int64_t value)
+{
+  return rcutils_char_array_append_fixed_point(char_array, value, 0u);
+}
+
+rcutils_ret_t
+rcutils_char_array_append_fixed_point(
+  rcutils_char_array_t * char_array, int64_t value, size_t decimals)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_ERROR);
+  if (decimals >= MAX_UINT64_DIGITS) {
+    RCUTILS_SET_ERROR_MSG("too many decimals for a fixed-point number");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  // Negating in unsigned arithmetic also works for INT64_MIN.
+  uint64_t abs_value = (uint64_t)value;
+  if (value < 0) {
+    abs_value = 0u - abs_value;
+  }
+  return _rcutils_char_array_append_number(char_array, abs_value, value < 0, decimals);
+}
@@ -12,9 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "rcutils/allocator.h"
 #include "rcutils/cmdline_parser.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/rcutils_ret.h"
 
 bool rcutils_cli_option_exist(char ** begin, char ** end, const char * option)
 {
@@ -43,3 +49,208 @@ char * rcutils_cli_get_option(char ** begin, char ** end, const char * option)
 
   return NULL;
 }
+
+// A distinct argument, along with where it occurs
+typedef struct cli_index_entry_s
+{
+  size_t hash;
+  size_t length;
+  // The position of the first occurrence, in the arguments
+  size_t first;
+  // Where the positions of the occurrences start, in the occurrences of the index
+  size_t offset;
+  // The number of occurrences, which is zero for empty slots
+  size_t count;
+} cli_index_entry_t;
+
+typedef struct rcutils_cli_index_impl_s
+{
+  char ** arguments;
+  size_t argument_count;
+  // An open addressing table of the distinct arguments, with linear probing, at most half full
+  cli_index_entry_t * entries;
+  size_t capacity;
+  // The positions of all the arguments, grouped by entry, in order
+  size_t * occurrences;
+  rcutils_allocator_t allocator;
+} rcutils_cli_index_impl_t;
+
+// Return the slot of the table holding the string, or the empty slot where it would go.
+static size_t
+cli_index_find_slot(
+  const rcutils_cli_index_impl_t * impl, const char * string, size_t length, size_t hash)
+{
+  size_t mask = impl->capacity - 1;
+  size_t slot = hash & mask;
+  while (0u != impl->entries[slot].count) {
+    const cli_index_entry_t * entry = &impl->entries[slot];
+    if (entry->hash == hash && entry->length == length &&
+      memcmp(impl->arguments[entry->first], string, length) == 0)
+    {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+static const cli_index_entry_t *
+cli_index_find(const rcutils_cli_index_t * index, const char * option)
+{
+  if (NULL == index || NULL == index->impl || NULL == option) {
+    return NULL;
+  }
+  const rcutils_cli_index_impl_t * impl = index->impl;
+  size_t length = strlen(option);
+  size_t slot = cli_index_find_slot(
+    impl, option, length, rcutils_hash_map_string_fast_hashn(option, length));
+  return 0u != impl->entries[slot].count ? &impl->entries[slot] : NULL;
+}
+
+rcutils_cli_index_t
+rcutils_get_zero_initialized_cli_index(void)
+{
+  static rcutils_cli_index_t zero_initialized_cli_index = {NULL};
+  return zero_initialized_cli_index;
+}
+
+rcutils_ret_t
+rcutils_cli_index_init(
+  rcutils_cli_index_t * index,
+  char ** begin,
+  char ** end,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(index, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (begin != end) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(begin, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  if (end < begin) {
+    RCUTILS_SET_ERROR_MSG("end is before begin");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  size_t count = (size_t)(end - begin);
+  size_t capacity = 2;
+  while (capacity < count * 2) {
+    if (capacity > SIZE_MAX / 2 / sizeof(cli_index_entry_t)) {
+      RCUTILS_SET_ERROR_MSG("too many arguments to index");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    capacity *= 2;
+  }
+
+  rcutils_cli_index_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_cli_index_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for command line index impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->entries = allocator->zero_allocate(capacity, sizeof(cli_index_entry_t), allocator->state);
+  if (NULL == impl->entries) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for command line index entries");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->occurrences = NULL;
+  if (count > 0u) {
+    impl->occurrences = allocator->allocate(count * sizeof(size_t), allocator->state);
+    if (NULL == impl->occurrences) {
+      allocator->deallocate(impl->entries, allocator->state);
+      allocator->deallocate(impl, allocator->state);
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for command line index occurrences");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  impl->arguments = begin;
+  impl->argument_count = count;
+  impl->capacity = capacity;
+  impl->allocator = *allocator;
+
+  // Count the occurrences of each distinct argument.
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == begin[i]) {
+      continue;
+    }
+    size_t length = strlen(begin[i]);
+    size_t hash = rcutils_hash_map_string_fast_hashn(begin[i], length);
+    cli_index_entry_t * entry = &impl->entries[cli_index_find_slot(impl, begin[i], length, hash)];
+    if (0u == entry->count) {
+      entry->hash = hash;
+      entry->length = length;
+      entry->first = i;
+    }
+    ++entry->count;
+  }
+  // Point each entry past the end of its range of the occurrences, and fill them in backwards,
+  // which leaves them in order, and the entry pointing at the start of its range.
+  size_t offset = 0;
+  for (size_t slot = 0; slot < capacity; ++slot) {
+    offset += impl->entries[slot].count;
+    impl->entries[slot].offset = offset;
+  }
+  for (size_t i = count; i-- > 0u; ) {
+    if (NULL == begin[i]) {
+      continue;
+    }
+    size_t length = strlen(begin[i]);
+    size_t hash = rcutils_hash_map_string_fast_hashn(begin[i], length);
+    cli_index_entry_t * entry = &impl->entries[cli_index_find_slot(impl, begin[i], length, hash)];
+    impl->occurrences[--entry->offset] = i;
+  }
+  index->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_cli_index_fini(rcutils_cli_index_t * index)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(index, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_cli_index_impl_t * impl = index->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  if (NULL != impl->occurrences) {
+    allocator.deallocate(impl->occurrences, allocator.state);
+  }
+  allocator.deallocate(impl->entries, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  index->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+size_t
+rcutils_cli_index_get_option_count(const rcutils_cli_index_t * index, const char * option)
+{
+  const cli_index_entry_t * entry = cli_index_find(index, option);
+  return NULL != entry ? entry->count : 0u;
+}
+
+bool
+rcutils_cli_index_option_exist(const rcutils_cli_index_t * index, const char * option)
+{
+  return NULL != cli_index_find(index, option);
+}
+
+char *
+rcutils_cli_index_get_option_at(
+  const rcutils_cli_index_t * index, const char * option, size_t occurrence)
+{
+  const cli_index_entry_t * entry = cli_index_find(index, option);
+  if (NULL == entry || occurrence >= entry->count) {
+    return NULL;
+  }
+  const rcutils_cli_index_impl_t * impl = index->impl;
+  size_t position = impl->occurrences[entry->offset + occurrence] + 1;
+  if (position >= impl->argument_count) {
+    return NULL;
+  }
+  return impl->arguments[position];
+}
+
+char *
+rcutils_cli_index_get_option(const rcutils_cli_index_t * index, const char * option)
+{
+  return rcutils_cli_index_get_option_at(index, option, 0u);
+}
@@ -0,0 +1,259 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/concurrent_hash_map.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+
+typedef struct rcutils_concurrent_hash_map_shard_s
+{
+  rcutils_rwlock_t lock;
+  rcutils_hash_map_t map;
+} rcutils_concurrent_hash_map_shard_t;
+
+typedef struct rcutils_concurrent_hash_map_impl_s
+{
+  rcutils_concurrent_hash_map_shard_t * shards;
+  // The shard of a key is selected by the top shard_bits bits of its mixed hash
+  size_t shard_count;
+  unsigned int shard_bits;
+  rcutils_hash_map_key_hasher_t key_hashing_func;
+  rcutils_allocator_t allocator;
+} rcutils_concurrent_hash_map_impl_t;
+
+#define CONCURRENT_HASH_MAP_VALIDATE_HASH_MAP(map) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(map, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == map->impl) { \
+    RCUTILS_SET_ERROR_MSG("map is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+rcutils_concurrent_hash_map_t
+rcutils_get_zero_initialized_concurrent_hash_map(void)
+{
+  static rcutils_concurrent_hash_map_t zero_initialized_hash_map = {NULL};
+  return zero_initialized_hash_map;
+}
+
+// The shards use the low bits of the hash to select buckets, so the shard is selected by the
+// high bits of the hash multiplied by a large odd constant, which depend on all of its bits.
+// The same hash is then passed to the shard, so that keys are only hashed once.
+static rcutils_concurrent_hash_map_shard_t * concurrent_hash_map_get_shard(
+  const rcutils_concurrent_hash_map_impl_t * impl, size_t hash)
+{
+  if (0 == impl->shard_bits) {
+    return &impl->shards[0];
+  }
+  uint64_t mixed = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+  return &impl->shards[(size_t)(mixed >> (64 - impl->shard_bits))];
+}
+
+// Finalizes the first count shards and frees them
+static rcutils_ret_t concurrent_hash_map_fini_shards(
+  rcutils_concurrent_hash_map_impl_t * impl, size_t count)
+{
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0; i < count; ++i) {
+    rcutils_ret_t shard_ret = rcutils_hash_map_fini(&impl->shards[i].map);
+    if (RCUTILS_RET_OK != shard_ret) {
+      ret = shard_ret;
+    }
+    rcutils_rwlock_fini(&impl->shards[i].lock);
+  }
+  impl->allocator.deallocate(impl->shards, impl->allocator.state);
+  impl->shards = NULL;
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_concurrent_hash_map_init(
+  rcutils_concurrent_hash_map_t * hash_map,
+  size_t shard_count,
+  size_t initial_capacity,
+  size_t key_size,
+  size_t data_size,
+  rcutils_hash_map_key_hasher_t key_hashing_func,
+  rcutils_hash_map_key_cmp_t key_cmp_func,
+  rcutils_hash_map_backend_t backend,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(hash_map, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key_hashing_func, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (1 > shard_count) {
+    RCUTILS_SET_ERROR_MSG("shard_count cannot be less than 1");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  unsigned int shard_bits = 0;
+  while (((size_t)1 << shard_bits) < shard_count) {
+    if (shard_bits + 1 >= sizeof(size_t) * 8) {
+      RCUTILS_SET_ERROR_MSG("shard_count is too large");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    ++shard_bits;
+  }
+  shard_count = (size_t)1 << shard_bits;
+
+  rcutils_concurrent_hash_map_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_concurrent_hash_map_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for concurrent hash map impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->allocator = *allocator;
+  impl->shard_count = shard_count;
+  impl->shard_bits = shard_bits;
+  impl->key_hashing_func = key_hashing_func;
+  if (shard_count > SIZE_MAX / sizeof(rcutils_concurrent_hash_map_shard_t)) {
+    impl->shards = NULL;
+  } else {
+    impl->shards = allocator->allocate(
+      shard_count * sizeof(rcutils_concurrent_hash_map_shard_t), allocator->state);
+  }
+  if (NULL == impl->shards) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for concurrent hash map shards");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0; i < shard_count; ++i) {
+    impl->shards[i].map = rcutils_get_zero_initialized_hash_map();
+    ret = rcutils_rwlock_init(&impl->shards[i].lock);
+    if (RCUTILS_RET_OK == ret) {
+      ret = rcutils_hash_map_init_with_backend(
+        &impl->shards[i].map, initial_capacity, key_size, data_size, key_hashing_func,
+        key_cmp_func, backend, allocator);
+      if (RCUTILS_RET_OK != ret) {
+        rcutils_rwlock_fini(&impl->shards[i].lock);
+      }
+    }
+    if (RCUTILS_RET_OK != ret) {
+      // Keep the error of the shard, which tells the invalid argument
+      (void)concurrent_hash_map_fini_shards(impl, i);
+      allocator->deallocate(impl, allocator->state);
+      return ret;
+    }
+  }
+
+  hash_map->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_concurrent_hash_map_fini(rcutils_concurrent_hash_map_t * hash_map)
+{
+  CONCURRENT_HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  rcutils_concurrent_hash_map_impl_t * impl = hash_map->impl;
+  rcutils_ret_t ret = concurrent_hash_map_fini_shards(impl, impl->shard_count);
+  impl->allocator.deallocate(impl, impl->allocator.state);
+  hash_map->impl = NULL;
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_concurrent_hash_map_get_size(
+  const rcutils_concurrent_hash_map_t * hash_map, size_t * size)
+{
+  CONCURRENT_HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(size, RCUTILS_RET_INVALID_ARGUMENT);
+  *size = 0;
+  for (size_t i = 0; i < hash_map->impl->shard_count; ++i) {
+    rcutils_concurrent_hash_map_shard_t * shard = &hash_map->impl->shards[i];
+    size_t shard_size = 0;
+    rcutils_rwlock_read_lock(&shard->lock);
+    rcutils_ret_t ret = rcutils_hash_map_get_size(&shard->map, &shard_size);
+    rcutils_rwlock_read_unlock(&shard->lock);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+    *size += shard_size;
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_concurrent_hash_map_set(
+  rcutils_concurrent_hash_map_t * hash_map, const void * key, const void * value)
+{
+  CONCURRENT_HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t hash = hash_map->impl->key_hashing_func(key);
+  rcutils_concurrent_hash_map_shard_t * shard = concurrent_hash_map_get_shard(hash_map->impl, hash);
+  rcutils_rwlock_write_lock(&shard->lock);
+  rcutils_ret_t ret = rcutils_hash_map_set_with_hash(&shard->map, key, hash, value);
+  rcutils_rwlock_write_unlock(&shard->lock);
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_concurrent_hash_map_unset(rcutils_concurrent_hash_map_t * hash_map, const void * key)
+{
+  CONCURRENT_HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t hash = hash_map->impl->key_hashing_func(key);
+  rcutils_concurrent_hash_map_shard_t * shard = concurrent_hash_map_get_shard(hash_map->impl, hash);
+  rcutils_rwlock_write_lock(&shard->lock);
+  rcutils_ret_t ret = rcutils_hash_map_unset_with_hash(&shard->map, key, hash);
+  rcutils_rwlock_write_unlock(&shard->lock);
+  return ret;
+}
+
+bool
+rcutils_concurrent_hash_map_key_exists(
+  const rcutils_concurrent_hash_map_t * hash_map, const void * key)
+{
+  if (NULL == hash_map || NULL == hash_map->impl || NULL == key) {
+    return false;
+  }
+  size_t hash = hash_map->impl->key_hashing_func(key);
+  rcutils_concurrent_hash_map_shard_t * shard = concurrent_hash_map_get_shard(hash_map->impl, hash);
+  rcutils_rwlock_read_lock(&shard->lock);
+  bool exists = rcutils_hash_map_key_exists_with_hash(&shard->map, key, hash);
+  rcutils_rwlock_read_unlock(&shard->lock);
+  return exists;
+}
+
+rcutils_ret_t
+rcutils_concurrent_hash_map_get(
+  const rcutils_concurrent_hash_map_t * hash_map, const void * key, void * data)
+{
+  CONCURRENT_HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t hash = hash_map->impl->key_hashing_func(key);
+  rcutils_concurrent_hash_map_shard_t * shard = concurrent_hash_map_get_shard(hash_map->impl, hash);
+  rcutils_rwlock_read_lock(&shard->lock);
+  rcutils_ret_t ret = rcutils_hash_map_get_with_hash(&shard->map, key, hash, data);
+  rcutils_rwlock_read_unlock(&shard->lock);
+  return ret;
+}
+
+#ifdef __cplusplus
+}
+#endif
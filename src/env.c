@@ -18,12 +18,29 @@ extern "C"
 #endif
 
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#ifdef _WIN32
+// See logging.c for why warning C5105 is disabled.
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#elif defined(__APPLE__)
+# include <crt_externs.h>
+#endif
+
+#include "rcutils/allocator.h"
 #include "rcutils/env.h"
 #include "rcutils/error_handling.h"
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+extern char ** environ;
+#endif
+
 bool
 rcutils_set_env(const char * env_name, const char * env_value)
 {
@@ -54,6 +71,7 @@ rcutils_set_env(const char * env_name, const char * env_value)
   }
 #endif
 
+  rcutils_env_cache_invalidate();
   return true;
 }
 
@@ -83,10 +101,237 @@ rcutils_get_env(const char * env_name, const char ** env_value)
   return NULL;
 }
 
+// An environment variable of a snapshot.
+typedef struct env_entry_s
+{
+  size_t hash;
+  // The name, which isn't null terminated, or NULL for an empty slot.
+  const char * name;
+  size_t name_length;
+  const char * value;
+} env_entry_t;
+
+// A copy of the environment, with its variables in an open addressing hash table, allocated
+// together with the table and the strings it points to.
+typedef struct env_snapshot_s
+{
+  size_t mask;
+  env_entry_t * entries;
+} env_snapshot_t;
+
+static env_snapshot_t * g_env_snapshot = NULL;
+
+// Names are case insensitive on Windows, so they are hashed and compared as lower case there.
+static char env_fold_case(char c)
+{
+#ifdef _WIN32
+  return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+#else
+  return c;
+#endif
+}
+
+static size_t env_hash_name(const char * name, size_t length)
+{
+  // FNV-1a, as names are short.
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= (uint8_t)env_fold_case(name[i]);
+    hash *= 1099511628211ULL;
+  }
+  return (size_t)hash;
+}
+
+static bool env_names_equal(const char * name, const char * other, size_t length)
+{
+  for (size_t i = 0; i < length; ++i) {
+    if (env_fold_case(name[i]) != env_fold_case(other[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the slot of the variable with the given name, or the empty slot it would be in.
+static env_entry_t * env_snapshot_find(
+  env_snapshot_t * snapshot, size_t hash, const char * name, size_t name_length)
+{
+  size_t index = hash & snapshot->mask;
+  for (;; index = (index + 1) & snapshot->mask) {
+    env_entry_t * entry = &snapshot->entries[index];
+    if (NULL == entry->name ||
+      (entry->hash == hash && entry->name_length == name_length &&
+      env_names_equal(entry->name, name, name_length)))
+    {
+      return entry;
+    }
+  }
+}
+
+static env_snapshot_t * env_snapshot_create(void)
+{
+#ifdef _WIN32
+  char ** variables = _environ;
+#elif defined(__APPLE__)
+  char ** variables = *_NSGetEnviron();
+#else
+  char ** variables = environ;
+#endif
+  size_t count = 0;
+  size_t string_bytes = 0;
+  for (size_t i = 0; NULL != variables && NULL != variables[i]; ++i) {
+    ++count;
+    string_bytes += strlen(variables[i]) + 1;
+  }
+  // Keep the table at most half full, so that probes are short.
+  size_t capacity = 16;
+  while (capacity < 2 * count) {
+    capacity *= 2;
+  }
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const size_t table_bytes = sizeof(env_snapshot_t) + capacity * sizeof(env_entry_t);
+  env_snapshot_t * snapshot = allocator.zero_allocate(
+    1, table_bytes + string_bytes, allocator.state);
+  if (NULL == snapshot) {
+    return NULL;
+  }
+  snapshot->mask = capacity - 1;
+  snapshot->entries = (env_entry_t *)(snapshot + 1);
+
+  char * strings = (char *)snapshot + table_bytes;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t length = strlen(variables[i]);
+    memcpy(strings, variables[i], length + 1);
+    // Windows has variables like "=C:=C:\", whose name starts with '='.
+    const char * separator = length > 0 ? strchr(strings + 1, '=') : NULL;
+    if (NULL != separator) {
+      const size_t name_length = (size_t)(separator - strings);
+      const size_t hash = env_hash_name(strings, name_length);
+      env_entry_t * entry = env_snapshot_find(snapshot, hash, strings, name_length);
+      // Like getenv(), the first of duplicated variables wins.
+      if (NULL == entry->name) {
+        entry->hash = hash;
+        entry->name = strings;
+        entry->name_length = name_length;
+        entry->value = separator + 1;
+      }
+    }
+    strings += length + 1;
+  }
+  return snapshot;
+}
+
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
 
+static env_snapshot_t * env_snapshot_get(void)
+{
+#ifdef _WIN32
+  env_snapshot_t * snapshot =
+    (env_snapshot_t *)InterlockedCompareExchangePointer(
+    (PVOID volatile *)&g_env_snapshot, NULL, NULL);
+#else
+  env_snapshot_t * snapshot = __atomic_load_n(&g_env_snapshot, __ATOMIC_ACQUIRE);
+#endif
+  if (NULL != snapshot) {
+    return snapshot;
+  }
+  snapshot = env_snapshot_create();
+  if (NULL == snapshot) {
+    return NULL;
+  }
+  // Threads racing here take a snapshot each, and all but the first published are discarded.
+#ifdef _WIN32
+  env_snapshot_t * published = (env_snapshot_t *)InterlockedCompareExchangePointer(
+    (PVOID volatile *)&g_env_snapshot, snapshot, NULL);
+#else
+  env_snapshot_t * published = NULL;
+  (void)__atomic_compare_exchange_n(
+    &g_env_snapshot, &published, snapshot, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+  if (NULL != published) {
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    allocator.deallocate(snapshot, allocator.state);
+    return published;
+  }
+  return snapshot;
+}
+
+static const char * env_snapshot_get_value(env_snapshot_t * snapshot, const char * env_name)
+{
+  const size_t name_length = strlen(env_name);
+  const env_entry_t * entry = env_snapshot_find(
+    snapshot, env_hash_name(env_name, name_length), env_name, name_length);
+  return NULL == entry->name ? "" : entry->value;
+}
+
+const char *
+rcutils_get_env_cached(const char * env_name, const char ** env_value)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF("some string error");
+
+  if (NULL == env_name) {
+    return "argument env_name is null";
+  }
+  if (NULL == env_value) {
+    return "argument env_value is null";
+  }
+
+  env_snapshot_t * snapshot = env_snapshot_get();
+  if (NULL == snapshot) {
+    return "failed to allocate the environment snapshot";
+  }
+  *env_value = env_snapshot_get_value(snapshot, env_name);
+  return NULL;
+}
+
+const char *
+rcutils_get_env_many(const char * const * env_names, size_t count, const char ** env_values)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF("some string error");
+
+  if (count > 0 && NULL == env_names) {
+    return "argument env_names is null";
+  }
+  if (count > 0 && NULL == env_values) {
+    return "argument env_values is null";
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == env_names[i]) {
+      return "argument env_names contains a null name";
+    }
+  }
+  if (0 == count) {
+    return NULL;
+  }
+
+  env_snapshot_t * snapshot = env_snapshot_get();
+  if (NULL == snapshot) {
+    return "failed to allocate the environment snapshot";
+  }
+  for (size_t i = 0; i < count; ++i) {
+    env_values[i] = env_snapshot_get_value(snapshot, env_names[i]);
+  }
+  return NULL;
+}
+
+void
+rcutils_env_cache_invalidate(void)
+{
+#ifdef _WIN32
+  env_snapshot_t * snapshot =
+    (env_snapshot_t *)InterlockedExchangePointer((PVOID volatile *)&g_env_snapshot, NULL);
+#else
+  env_snapshot_t * snapshot = __atomic_exchange_n(&g_env_snapshot, NULL, __ATOMIC_ACQ_REL);
+#endif
+  if (NULL != snapshot) {
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    allocator.deallocate(snapshot, allocator.state);
+  }
+}
+
 const char *
 rcutils_get_home_dir(void)
 {
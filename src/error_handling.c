@@ -34,12 +34,183 @@ extern "C"
 // RCUTILS_REPORT_ERROR_HANDLING_ERRORS and RCUTILS_WARN_ON_TRUNCATION are set in the header below
 #include "./error_handling_helpers.h"
 
+#ifndef RCUTILS_COMPACT_ERROR_STATE
+// When set to 1, the error state and error string buffers are not kept in thread-local storage,
+// only pointers to the current error are, and the error state is allocated the first time a
+// thread needs it.
+# define RCUTILS_COMPACT_ERROR_STATE 0
+#endif
+
+#if RCUTILS_COMPACT_ERROR_STATE
+# include "./threads.h"
+#endif
+
+// The current error is kept as pointers to its message and file, which either have static
+// storage duration, when set with rcutils_set_error_state_static(), or are the copies in the
+// error state, and the error state is only filled in from them when it is asked for.
+
 // g_ is to global variable, as gtls_ is to global thread-local storage variable
 RCUTILS_THREAD_LOCAL bool gtls_rcutils_thread_local_initialized = false;
+RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_is_set = false;
+RCUTILS_THREAD_LOCAL const char * gtls_rcutils_error_message = NULL;
+RCUTILS_THREAD_LOCAL const char * gtls_rcutils_error_file = NULL;
+RCUTILS_THREAD_LOCAL uint64_t gtls_rcutils_error_line_number = 0;
+// Whether the error state holds the current error, or is empty if no error is set.
+RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_state_is_current = false;
+// The number of frames pushed onto the current error.
+RCUTILS_THREAD_LOCAL size_t gtls_rcutils_error_frame_count = 0;
+#if RCUTILS_COMPACT_ERROR_STATE
+typedef struct rcutils_error_storage_s
+{
+  rcutils_allocator_t allocator;
+  rcutils_error_state_t error_state;
+  rcutils_error_frame_t error_frames[RCUTILS_ERROR_FRAMES_MAX_COUNT];
+} rcutils_error_storage_t;
+
+RCUTILS_THREAD_LOCAL rcutils_error_storage_t * gtls_rcutils_error_storage = NULL;
+
+// Frees the error storage of exiting threads, created the first time one is allocated.
+static rcutils_thread_specific_t g_rcutils_error_storage_key;
+enum
+{
+  RCUTILS_ERROR_STORAGE_KEY_UNINITIALIZED = 0,
+  RCUTILS_ERROR_STORAGE_KEY_INITIALIZING = 1,
+  RCUTILS_ERROR_STORAGE_KEY_INITIALIZED = 2,
+  RCUTILS_ERROR_STORAGE_KEY_FAILED = 3,
+};
+static uint32_t g_rcutils_error_storage_key_state = RCUTILS_ERROR_STORAGE_KEY_UNINITIALIZED;
+
+// Returned by rcutils_get_error_state() when the error state can't be allocated.
+static const rcutils_error_state_t g_rcutils_empty_error_state = {
+  .message = {0}, .file = {0}, .line_number = 0
+};  // NOLINT(readability/braces)
+#else
 RCUTILS_THREAD_LOCAL rcutils_error_state_t gtls_rcutils_error_state;
 RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_string_is_formatted = false;
 RCUTILS_THREAD_LOCAL rcutils_error_string_t gtls_rcutils_error_string;
-RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_is_set = false;
+RCUTILS_THREAD_LOCAL rcutils_error_frame_t gtls_rcutils_error_frames[RCUTILS_ERROR_FRAMES_MAX_COUNT];
+#endif
+
+#if RCUTILS_COMPACT_ERROR_STATE
+static
+bool
+__compare_exchange_uint32(uint32_t * value, uint32_t expected, uint32_t desired)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange(
+    (volatile LONG *)value, (LONG)desired, (LONG)expected) == expected;
+#else
+  return __atomic_compare_exchange_n(
+    value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static
+void
+__store_release_uint32(uint32_t * value, uint32_t new_value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)value, (LONG)new_value);
+#else
+  __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+static
+void
+RCUTILS_THREAD_SPECIFIC_CALLBACK
+__free_error_storage(void * value)
+{
+  rcutils_error_storage_t * storage = (rcutils_error_storage_t *)value;
+  if (storage == gtls_rcutils_error_storage) {
+    gtls_rcutils_error_storage = NULL;
+    gtls_rcutils_error_is_set = false;
+    gtls_rcutils_error_state_is_current = false;
+    gtls_rcutils_error_frame_count = 0;
+  }
+  storage->allocator.deallocate(storage, storage->allocator.state);
+}
+
+static
+bool
+__initialize_error_storage_key(void)
+{
+  while (!__compare_exchange_uint32(
+      &g_rcutils_error_storage_key_state,
+      RCUTILS_ERROR_STORAGE_KEY_UNINITIALIZED, RCUTILS_ERROR_STORAGE_KEY_INITIALIZING))
+  {
+    uint32_t state = RCUTILS_ERROR_STORAGE_KEY_INITIALIZED;
+    if (__compare_exchange_uint32(&g_rcutils_error_storage_key_state, state, state)) {
+      return true;
+    }
+    state = RCUTILS_ERROR_STORAGE_KEY_FAILED;
+    if (__compare_exchange_uint32(&g_rcutils_error_storage_key_state, state, state)) {
+      return false;
+    }
+    rcutils_thread_yield();
+  }
+  // The key is never finalized, as threads may still exit after this library is unloaded.
+  bool initialized = RCUTILS_RET_OK == rcutils_thread_specific_init(
+    &g_rcutils_error_storage_key, __free_error_storage);
+  __store_release_uint32(
+    &g_rcutils_error_storage_key_state,
+    initialized ? RCUTILS_ERROR_STORAGE_KEY_INITIALIZED : RCUTILS_ERROR_STORAGE_KEY_FAILED);
+  return initialized;
+}
+#endif
+
+// Return the error state of this thread, allocating it with the given allocator, or the default
+// allocator if NULL, in compact mode, or NULL if that failed.
+static
+rcutils_error_state_t *
+__get_error_state_storage(const rcutils_allocator_t * allocator)
+{
+#if RCUTILS_COMPACT_ERROR_STATE
+  if (NULL != gtls_rcutils_error_storage) {
+    return &gtls_rcutils_error_storage->error_state;
+  }
+  if (!__initialize_error_storage_key()) {
+    return NULL;
+  }
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  if (NULL == allocator) {
+    allocator = &default_allocator;
+  }
+  rcutils_error_storage_t * storage =
+    (rcutils_error_storage_t *)allocator->allocate(sizeof(*storage), allocator->state);
+  if (NULL == storage) {
+    return NULL;
+  }
+  storage->allocator = *allocator;
+  storage->error_state.message[0] = '\0';
+  storage->error_state.file[0] = '\0';
+  storage->error_state.line_number = 0;
+  if (RCUTILS_RET_OK != rcutils_thread_specific_set(&g_rcutils_error_storage_key, storage)) {
+    allocator->deallocate(storage, allocator->state);
+    return NULL;
+  }
+  gtls_rcutils_error_storage = storage;
+  return &storage->error_state;
+#else
+  (void)allocator;
+  return &gtls_rcutils_error_state;
+#endif
+}
+
+// Return the error frames of this thread, allocating them in compact mode, or NULL if that failed.
+static
+rcutils_error_frame_t *
+__get_error_frames(void)
+{
+#if RCUTILS_COMPACT_ERROR_STATE
+  if (NULL == __get_error_state_storage(NULL)) {
+    return NULL;
+  }
+  return gtls_rcutils_error_storage->error_frames;
+#else
+  return gtls_rcutils_error_frames;
+#endif
+}
 
 rcutils_ret_t
 rcutils_initialize_error_handling_thread_local_storage(rcutils_allocator_t allocator)
@@ -57,10 +228,19 @@ rcutils_initialize_error_handling_thread_local_storage(rcutils_allocator_t alloc
 #endif
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
-  // right now the allocator is not used for anything
-  // but other future implementations may need to use it
+  // in compact mode the allocator is used for the error state of this thread, otherwise it is
+  // not used for anything, but other future implementations may need to use it
   // e.g. pthread which could only provide thread-local pointers would need to
   // allocate memory to which those pointers would point
+  if (NULL == __get_error_state_storage(&allocator)) {
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] rcutils_initialize_error_handling_thread_local_storage() failed to allocate "
+      "the error state\n");
+#endif
+    return RCUTILS_RET_BAD_ALLOC;
+  }
 
   // forcing the values back to their initial state should force the thread-local storage
   // to initialize and do any required memory allocation
@@ -69,6 +249,8 @@ rcutils_initialize_error_handling_thread_local_storage(rcutils_allocator_t alloc
   RCUTILS_SET_ERROR_MSG("no error - initializing thread-local storage");
   rcutils_error_string_t throw_away = rcutils_get_error_string();
   (void)throw_away;
+  const rcutils_error_state_t * error_state = rcutils_get_error_state();
+  (void)error_state;
   rcutils_reset_error();
 
   // at this point the thread-local allocator, error state, and error string are all initialized
@@ -89,12 +271,15 @@ void
 __format_overwriting_error_state_message(
   char * buffer,
   size_t buffer_size,
-  const rcutils_error_state_t * new_error_state)
+  const char * new_message,
+  const char * new_file,
+  uint64_t new_line_number)
 {
   assert(NULL != buffer);
   assert(0 != buffer_size);
   assert(SIZE_MAX > buffer_size);
-  assert(NULL != new_error_state);
+  assert(NULL != new_message);
+  assert(NULL != new_file);
 
   int64_t bytes_left = (int64_t)buffer_size;
   do {
@@ -136,7 +321,8 @@ __format_overwriting_error_state_message(
     rcutils_error_string_t new_error_string = {
       .str = "\0"
     };
-    __rcutils_format_error_string(&new_error_string, new_error_state);
+    __rcutils_format_error_string_from_parts(
+      &new_error_string, new_message, new_file, new_line_number);
     written = __rcutils_copy_string(offset, sizeof(new_error_string.str), new_error_string.str);
     offset += written;
     bytes_left -= (int64_t)written;
@@ -167,21 +353,19 @@ __format_overwriting_error_state_message(
 #endif
 }
 
-void
-rcutils_set_error_state(
-  const char * error_string,
-  const char * file,
-  size_t line_number)
+// Check the arguments of the functions setting the error state, and warn if the current error is
+// being overwritten by a different one.
+static
+bool
+__prepare_error_state(const char * error_string, const char * file, uint64_t line_number)
 {
-  rcutils_error_state_t error_state;
-
   if (NULL == error_string) {
 #if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
     RCUTILS_SAFE_FWRITE_TO_STDERR(
       "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
       "] rcutils_set_error_state() given null pointer for error_string, error was not set\n");
 #endif
-    return;
+    return false;
   }
 
   if (NULL == file) {
@@ -190,37 +374,140 @@ rcutils_set_error_state(
       "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
       "] rcutils_set_error_state() given null pointer for file string, error was not set\n");
 #endif
-    return;
+    return false;
   }
 
-  __rcutils_copy_string(error_state.message, sizeof(error_state.message), error_string);
-  __rcutils_copy_string(error_state.file, sizeof(error_state.file), file);
-  error_state.line_number = line_number;
 #if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
   // Only warn of overwritting if the new error is different from the old ones.
-  size_t characters_to_compare = strnlen(error_string, RCUTILS_ERROR_MESSAGE_MAX_LENGTH);
-  // assumption is that message length is <= max error string length
-  static_assert(
-    sizeof(gtls_rcutils_error_state.message) <= sizeof(gtls_rcutils_error_string.str),
-    "expected error state's max message length to be less than or equal to error string max");
-  if (
-    gtls_rcutils_error_is_set &&
-    !__same_string(error_string, gtls_rcutils_error_string.str, characters_to_compare) &&
-    !__same_string(error_string, gtls_rcutils_error_state.message, characters_to_compare))
-  {
-    char output_buffer[4096];
-    __format_overwriting_error_state_message(output_buffer, sizeof(output_buffer), &error_state);
-    RCUTILS_SAFE_FWRITE_TO_STDERR(output_buffer);
+  if (gtls_rcutils_error_is_set) {
+    size_t characters_to_compare = strnlen(error_string, RCUTILS_ERROR_MESSAGE_MAX_LENGTH);
+    if (
+      !__same_string(error_string, gtls_rcutils_error_message, characters_to_compare) &&
+      !__same_string(error_string, rcutils_get_error_string().str, characters_to_compare))
+    {
+      char output_buffer[4096];
+      __format_overwriting_error_state_message(
+        output_buffer, sizeof(output_buffer), error_string, file, line_number);
+      RCUTILS_SAFE_FWRITE_TO_STDERR(output_buffer);
+    }
   }
+#else
+  (void)line_number;
 #endif
-  gtls_rcutils_error_state = error_state;
+  return true;
+}
+
+void
+rcutils_set_error_state(
+  const char * error_string,
+  const char * file,
+  size_t line_number)
+{
+  if (!__prepare_error_state(error_string, file, line_number)) {
+    return;
+  }
+
+  rcutils_error_state_t * error_state = __get_error_state_storage(NULL);
+  if (NULL == error_state) {
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] rcutils_set_error_state() failed to allocate the error state, "
+      "the error message is lost\n");
+#endif
+    gtls_rcutils_error_message = "error message lost, the error state could not be allocated";
+    gtls_rcutils_error_file = __FILE__;
+    gtls_rcutils_error_line_number = __LINE__;
+    gtls_rcutils_error_state_is_current = false;
+  } else {
+    // the new error may be given the current one, which the copy handles
+    __rcutils_copy_string(error_state->message, sizeof(error_state->message), error_string);
+    __rcutils_copy_string(error_state->file, sizeof(error_state->file), file);
+    error_state->line_number = line_number;
+    gtls_rcutils_error_message = error_state->message;
+    gtls_rcutils_error_file = error_state->file;
+    gtls_rcutils_error_line_number = line_number;
+    gtls_rcutils_error_state_is_current = true;
+  }
+  gtls_rcutils_error_frame_count = 0;
+#if !RCUTILS_COMPACT_ERROR_STATE
   gtls_rcutils_error_string_is_formatted = false;
-  gtls_rcutils_error_string = (const rcutils_error_string_t) {
-    .str = "\0"
-  };
+#endif
   gtls_rcutils_error_is_set = true;
 }
 
+void
+rcutils_set_error_state_static(
+  const char * error_string,
+  const char * file,
+  size_t line_number)
+{
+  if (!__prepare_error_state(error_string, file, line_number)) {
+    return;
+  }
+
+  gtls_rcutils_error_message = error_string;
+  gtls_rcutils_error_file = file;
+  gtls_rcutils_error_line_number = line_number;
+  gtls_rcutils_error_state_is_current = false;
+  gtls_rcutils_error_frame_count = 0;
+#if !RCUTILS_COMPACT_ERROR_STATE
+  gtls_rcutils_error_string_is_formatted = false;
+#endif
+  gtls_rcutils_error_is_set = true;
+}
+
+void
+rcutils_push_error_frame(
+  rcutils_ret_t code,
+  const char * message,
+  const char * file,
+  size_t line_number)
+{
+  if (!gtls_rcutils_error_is_set) {
+    rcutils_set_error_state_static(message, file, line_number);
+    return;
+  }
+  if (NULL == message || NULL == file) {
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] rcutils_push_error_frame() given null pointer for message or file, "
+      "frame was not pushed\n");
+#endif
+    return;
+  }
+  if (RCUTILS_ERROR_FRAMES_MAX_COUNT == gtls_rcutils_error_frame_count) {
+    return;
+  }
+  rcutils_error_frame_t * frames = __get_error_frames();
+  if (NULL == frames) {
+    return;
+  }
+  frames[gtls_rcutils_error_frame_count] = (rcutils_error_frame_t) {
+    .code = code, .message = message, .file = file, .line_number = line_number
+  };  // NOLINT(readability/braces)
+  ++gtls_rcutils_error_frame_count;
+#if !RCUTILS_COMPACT_ERROR_STATE
+  gtls_rcutils_error_string_is_formatted = false;
+#endif
+}
+
+size_t
+rcutils_get_error_frame_count(void)
+{
+  return gtls_rcutils_error_frame_count;
+}
+
+const rcutils_error_frame_t *
+rcutils_get_error_frame(size_t index)
+{
+  if (index >= gtls_rcutils_error_frame_count) {
+    return NULL;
+  }
+  return &__get_error_frames()[index];
+}
+
 bool
 rcutils_error_is_set(void)
 {
@@ -230,7 +517,73 @@ rcutils_error_is_set(void)
 const rcutils_error_state_t *
 rcutils_get_error_state(void)
 {
-  return &gtls_rcutils_error_state;
+  rcutils_error_state_t * error_state = __get_error_state_storage(NULL);
+#if RCUTILS_COMPACT_ERROR_STATE
+  if (NULL == error_state) {
+    return &g_rcutils_empty_error_state;
+  }
+#endif
+  if (!gtls_rcutils_error_state_is_current) {
+    if (gtls_rcutils_error_is_set) {
+      __rcutils_copy_string(
+        error_state->message, sizeof(error_state->message), gtls_rcutils_error_message);
+      __rcutils_copy_string(error_state->file, sizeof(error_state->file), gtls_rcutils_error_file);
+      error_state->line_number = gtls_rcutils_error_line_number;
+      gtls_rcutils_error_message = error_state->message;
+      gtls_rcutils_error_file = error_state->file;
+    } else {
+      error_state->message[0] = '\0';
+      error_state->file[0] = '\0';
+      error_state->line_number = 0;
+    }
+    gtls_rcutils_error_state_is_current = true;
+  }
+  return error_state;
+}
+
+static
+void
+__append_string(char ** offset, size_t * bytes_left, const char * string)
+{
+  // once full, the truncation has already been reported
+  if (*bytes_left <= 1) {
+    return;
+  }
+  size_t written = __rcutils_copy_string(*offset, *bytes_left, string);
+  *offset += written;
+  *bytes_left -= written;
+}
+
+// Format the current error and its frames as if each frame had been set with
+// RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR(), truncating the result if it doesn't fit.
+static
+void
+__format_error_string(rcutils_error_string_t * error_string)
+{
+  __rcutils_format_error_string_from_parts(
+    error_string, gtls_rcutils_error_message, gtls_rcutils_error_file,
+    gtls_rcutils_error_line_number);
+  if (0 == gtls_rcutils_error_frame_count) {
+    return;
+  }
+  rcutils_error_string_t inner_error_string = *error_string;
+  const rcutils_error_frame_t * frames = __get_error_frames();
+  char * offset = error_string->str;
+  size_t bytes_left = sizeof(error_string->str);
+  for (size_t i = gtls_rcutils_error_frame_count; i > 0; --i) {
+    __append_string(&offset, &bytes_left, frames[i - 1].message);
+    __append_string(&offset, &bytes_left, ": ");
+  }
+  __append_string(&offset, &bytes_left, inner_error_string.str);
+  for (size_t i = 0; i < gtls_rcutils_error_frame_count; ++i) {
+    char line_number_buffer[21];
+    __rcutils_convert_uint64_t_into_c_str(
+      frames[i].line_number, line_number_buffer, sizeof(line_number_buffer));
+    __append_string(&offset, &bytes_left, ", at ");
+    __append_string(&offset, &bytes_left, frames[i].file);
+    __append_string(&offset, &bytes_left, ":");
+    __append_string(&offset, &bytes_left, line_number_buffer);
+  }
 }
 
 rcutils_error_string_t
@@ -239,24 +592,31 @@ rcutils_get_error_string(void)
   if (!gtls_rcutils_error_is_set) {
     return (rcutils_error_string_t) {"error not set"};  // NOLINT(readability/braces)
   }
+#if RCUTILS_COMPACT_ERROR_STATE
+  rcutils_error_string_t error_string;
+  __format_error_string(&error_string);
+  return error_string;
+#else
   if (!gtls_rcutils_error_string_is_formatted) {
-    __rcutils_format_error_string(&gtls_rcutils_error_string, &gtls_rcutils_error_state);
+    __format_error_string(&gtls_rcutils_error_string);
     gtls_rcutils_error_string_is_formatted = true;
   }
   return gtls_rcutils_error_string;
+#endif
 }
 
 void
 rcutils_reset_error(void)
 {
-  gtls_rcutils_error_state = (const rcutils_error_state_t) {
-    .message = {0}, .file = {0}, .line_number = 0
-  };  // NOLINT(readability/braces)
-  gtls_rcutils_error_string_is_formatted = false;
-  gtls_rcutils_error_string = (const rcutils_error_string_t) {
-    .str = "\0"
-  };
   gtls_rcutils_error_is_set = false;
+  gtls_rcutils_error_message = NULL;
+  gtls_rcutils_error_file = NULL;
+  gtls_rcutils_error_line_number = 0;
+  gtls_rcutils_error_state_is_current = false;
+  gtls_rcutils_error_frame_count = 0;
+#if !RCUTILS_COMPACT_ERROR_STATE
+  gtls_rcutils_error_string_is_formatted = false;
+#endif
 }
 
 #ifdef __cplusplus
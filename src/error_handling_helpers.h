@@ -134,42 +134,46 @@ __rcutils_convert_uint64_t_into_c_str(uint64_t number, char * buffer, size_t buf
 }
 
 // do not use externally, internal function which is only to be used by error_handling.c
+// The message and the file are truncated as if they were first copied into an error state.
 static
 void
-__rcutils_format_error_string(
+__rcutils_format_error_string_from_parts(
   rcutils_error_string_t * error_string,
-  const rcutils_error_state_t * error_state)
+  const char * message,
+  const char * file,
+  uint64_t line_number)
 {
   assert(error_string != NULL);
-  assert(error_state != NULL);
+  assert(message != NULL);
+  assert(file != NULL);
   static const char format_1[] = ", at ";
   static const char format_2[] = ":";
   char line_number_buffer[21];
   static_assert(
     sizeof(error_string->str) == (
-      sizeof(error_state->message) +
+      RCUTILS_ERROR_STATE_MESSAGE_MAX_LENGTH +
       sizeof(format_1) - 1 /* minus the null-term */ +
-      sizeof(error_state->file) +
+      RCUTILS_ERROR_STATE_FILE_MAX_LENGTH +
       sizeof(format_2) - 1 /* minus the null-term */ +
       sizeof(line_number_buffer) - 1 /* minus the null-term */ +
       1  // null terminator
     ), "math error in static string formatting");
   char * offset = error_string->str;
   size_t bytes_left = sizeof(error_string->str);
-  size_t written = __rcutils_copy_string(offset, bytes_left, error_state->message);
+  size_t written = __rcutils_copy_string(offset, RCUTILS_ERROR_STATE_MESSAGE_MAX_LENGTH, message);
   offset += written;
   bytes_left -= written;
   written = __rcutils_copy_string(offset, bytes_left, format_1);
   offset += written;
   bytes_left -= written;
-  written = __rcutils_copy_string(offset, bytes_left, error_state->file);
+  written = __rcutils_copy_string(offset, RCUTILS_ERROR_STATE_FILE_MAX_LENGTH, file);
   offset += written;
   bytes_left -= written;
   written = __rcutils_copy_string(offset, bytes_left, format_2);
   offset += written;
   bytes_left -= written;
   __rcutils_convert_uint64_t_into_c_str(
-    error_state->line_number, line_number_buffer, sizeof(line_number_buffer));
+    line_number, line_number_buffer, sizeof(line_number_buffer));
   written = __rcutils_copy_string(offset, bytes_left, line_number_buffer);
   offset += written;
   offset[0] = '\0';
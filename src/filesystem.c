@@ -19,13 +19,22 @@ extern "C"
 #include "rcutils/filesystem.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 #ifndef _WIN32
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/syscall.h>
+#endif
 #else
 // When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
 // there appears to be a problem with winbase.h (which is included by
@@ -47,6 +56,12 @@ extern "C"
 #include "rcutils/format_string.h"
 #include "rcutils/repl_str.h"
 #include "rcutils/strdup.h"
+#include "rcutils/thread_pool.h"
+#include "rcutils/time.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/string_pool.h"
+
+#include "./threads.h"
 
 #ifdef _WIN32
 # define RCUTILS_PATH_DELIMITER "\\"
@@ -173,6 +188,431 @@ rcutils_is_readable_and_writable(const char * abs_path)
   return true;
 }
 
+// The kinds of paths told apart by the stat cache
+#define STAT_CACHE_MISSING 0
+#define STAT_CACHE_FILE 1
+#define STAT_CACHE_DIRECTORY 2
+#define STAT_CACHE_OTHER 3
+
+// The metadata of a path held by a stat cache
+typedef struct stat_cache_entry_s
+{
+  // When the metadata expires, or INT64_MAX if it doesn't
+  rcutils_time_point_value_t expiry;
+  // The generation of the watch of the parent directory when the metadata was cached
+  uint64_t generation;
+  // The watch of the parent directory, or -1 if it isn't watched
+  int watch;
+  int kind;
+} stat_cache_entry_t;
+
+typedef struct rcutils_stat_cache_impl_s
+{
+  rcutils_mutex_t lock;
+  rcutils_stat_cache_options_t options;
+  // The paths, interned in the string pool, and their metadata
+  rcutils_hash_map_t entries;
+  rcutils_string_pool_t paths;
+  // The inotify instance watching the parent directories, or -1
+  int watch_fd;
+  // Signaled to stop the thread reading the changes from the inotify instance
+  int stop_fd;
+  rcutils_thread_t watcher;
+  // The generation of each watch, which is incremented when its directory changes
+  uint64_t * generations;
+  size_t generations_size;
+  rcutils_allocator_t allocator;
+} rcutils_stat_cache_impl_t;
+
+static int
+stat_cache_kind_of(const char * abs_path)
+{
+  struct stat buf;
+  if (stat(abs_path, &buf) < 0) {
+    return STAT_CACHE_MISSING;
+  }
+#ifdef _WIN32
+  if ((buf.st_mode & S_IFDIR) == S_IFDIR) {
+    return STAT_CACHE_DIRECTORY;
+  }
+  return (buf.st_mode & S_IFREG) == S_IFREG ? STAT_CACHE_FILE : STAT_CACHE_OTHER;
+#else
+  if (S_ISDIR(buf.st_mode)) {
+    return STAT_CACHE_DIRECTORY;
+  }
+  return S_ISREG(buf.st_mode) ? STAT_CACHE_FILE : STAT_CACHE_OTHER;
+#endif  // _WIN32
+}
+
+// Initialize the containers of a stat cache, which hold no path, or leave them zero initialized
+static rcutils_ret_t
+stat_cache_init_entries(rcutils_stat_cache_impl_t * impl)
+{
+  impl->entries = rcutils_get_zero_initialized_hash_map();
+  impl->paths = rcutils_get_zero_initialized_string_pool();
+  rcutils_ret_t ret = rcutils_hash_map_init(
+    &impl->entries, 64, sizeof(const char *), sizeof(stat_cache_entry_t),
+    rcutils_hash_map_string_fast_hash_func, rcutils_hash_map_string_cmp_func, &impl->allocator);
+  if (RCUTILS_RET_OK != ret) {
+    impl->entries = rcutils_get_zero_initialized_hash_map();
+    return ret;
+  }
+  ret = rcutils_string_pool_init(&impl->paths, &impl->allocator);
+  if (RCUTILS_RET_OK != ret) {
+    rcutils_ret_t fini_ret = rcutils_hash_map_fini(&impl->entries);
+    (void)fini_ret;
+    impl->entries = rcutils_get_zero_initialized_hash_map();
+    impl->paths = rcutils_get_zero_initialized_string_pool();
+    return ret;
+  }
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t
+stat_cache_fini_entries(rcutils_stat_cache_impl_t * impl)
+{
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (NULL != impl->entries.impl) {
+    ret = rcutils_hash_map_fini(&impl->entries);
+  }
+  rcutils_ret_t string_pool_ret = rcutils_string_pool_fini(&impl->paths);
+  if (RCUTILS_RET_OK == ret) {
+    ret = string_pool_ret;
+  }
+  return ret;
+}
+
+#ifdef __linux__
+// Increment the generation of the watches of the directories which changed
+static void
+stat_cache_read_changes(rcutils_stat_cache_impl_t * impl)
+{
+  char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  for (;;) {
+    ssize_t length = read(impl->watch_fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      return;
+    }
+    rcutils_mutex_lock(&impl->lock);
+    for (char * cur = buffer; cur < buffer + length; ) {
+      const struct inotify_event * event = (const struct inotify_event *)cur;
+      if (event->mask & IN_Q_OVERFLOW) {
+        // Events were lost, so any directory may have changed.
+        for (size_t i = 0; i < impl->generations_size; ++i) {
+          ++impl->generations[i];
+        }
+      } else if (event->wd >= 0 && (size_t)event->wd < impl->generations_size) {
+        ++impl->generations[event->wd];
+      }
+      cur += sizeof(struct inotify_event) + event->len;
+    }
+    rcutils_mutex_unlock(&impl->lock);
+  }
+}
+
+// Read the changes from the inotify instance as they happen, until the stat cache is finalized
+static void
+stat_cache_watch_changes(void * arg)
+{
+  rcutils_stat_cache_impl_t * impl = arg;
+  struct pollfd fds[2] = {
+    {.fd = impl->watch_fd, .events = POLLIN, .revents = 0},
+    {.fd = impl->stop_fd, .events = POLLIN, .revents = 0},
+  };
+  for (;;) {
+    if (poll(fds, 2, -1) < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return;
+    }
+    if (0 != fds[1].revents) {
+      return;
+    }
+    if (0 != fds[0].revents) {
+      stat_cache_read_changes(impl);
+    }
+  }
+}
+
+// Start watching changes, or leave the stat cache without watches if it fails
+static void
+stat_cache_start_watching(rcutils_stat_cache_impl_t * impl)
+{
+  impl->watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  impl->stop_fd = eventfd(0, EFD_CLOEXEC);
+  if (impl->watch_fd >= 0 && impl->stop_fd >= 0 &&
+    RCUTILS_RET_OK == rcutils_thread_create(&impl->watcher, stat_cache_watch_changes, impl))
+  {
+    return;
+  }
+  // Without inotify, the metadata is only discarded as it expires.
+  rcutils_reset_error();
+  if (impl->watch_fd >= 0) {
+    close(impl->watch_fd);
+  }
+  if (impl->stop_fd >= 0) {
+    close(impl->stop_fd);
+  }
+  impl->watch_fd = -1;
+  impl->stop_fd = -1;
+}
+
+static void
+stat_cache_stop_watching(rcutils_stat_cache_impl_t * impl)
+{
+  if (impl->watch_fd < 0) {
+    return;
+  }
+  uint64_t value = 1;
+  while (write(impl->stop_fd, &value, sizeof(value)) < 0 && EINTR == errno) {
+  }
+  (void)rcutils_thread_join(&impl->watcher);
+  close(impl->watch_fd);
+  close(impl->stop_fd);
+  impl->watch_fd = -1;
+  impl->stop_fd = -1;
+}
+
+// Watch the parent directory of a path, returning the watch or -1
+static int
+stat_cache_watch_parent(rcutils_stat_cache_impl_t * impl, const char * abs_path)
+{
+  if (impl->watch_fd < 0) {
+    return -1;
+  }
+  const char * separator = strrchr(abs_path, '/');
+  char parent[PATH_MAX];
+  if (NULL == separator) {
+    strcpy(parent, ".");  // NOLINT(runtime/printf)
+  } else {
+    size_t length = separator == abs_path ? 1 : (size_t)(separator - abs_path);
+    if (length >= sizeof(parent)) {
+      return -1;
+    }
+    memcpy(parent, abs_path, length);
+    parent[length] = '\0';
+  }
+  // Watching a directory again returns the same watch.
+  int watch = inotify_add_watch(
+    impl->watch_fd, parent,
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |
+    IN_ONLYDIR);
+  if (watch < 0) {
+    return -1;
+  }
+  if ((size_t)watch >= impl->generations_size) {
+    size_t size = 2 * impl->generations_size;
+    if (size <= (size_t)watch) {
+      size = (size_t)watch + 16;
+    }
+    uint64_t * generations = impl->allocator.reallocate(
+      impl->generations, size * sizeof(uint64_t), impl->allocator.state);
+    if (NULL == generations) {
+      (void)inotify_rm_watch(impl->watch_fd, watch);
+      return -1;
+    }
+    memset(
+      generations + impl->generations_size, 0,
+      (size - impl->generations_size) * sizeof(uint64_t));
+    impl->generations = generations;
+    impl->generations_size = size;
+  }
+  return watch;
+}
+#endif
+
+// The kind of a path, from the cache if its metadata is valid, or else from stat()
+static int
+stat_cache_lookup(rcutils_stat_cache_t * stat_cache, const char * abs_path)
+{
+  if (NULL == stat_cache || NULL == stat_cache->impl) {
+    return stat_cache_kind_of(abs_path);
+  }
+  rcutils_stat_cache_impl_t * impl = stat_cache->impl;
+  rcutils_time_point_value_t now = 0;
+  if (impl->options.ttl > 0 && RCUTILS_RET_OK != rcutils_steady_time_now_coarse(&now)) {
+    return stat_cache_kind_of(abs_path);
+  }
+
+  rcutils_mutex_lock(&impl->lock);
+  if (NULL == impl->entries.impl) {
+    // The containers failed to be initialized again when the cache was cleared.
+    rcutils_mutex_unlock(&impl->lock);
+    return stat_cache_kind_of(abs_path);
+  }
+  stat_cache_entry_t entry;
+  if (RCUTILS_RET_OK == rcutils_hash_map_get(&impl->entries, &abs_path, &entry) &&
+    now < entry.expiry &&
+    (entry.watch < 0 || entry.generation == impl->generations[entry.watch]))
+  {
+    rcutils_mutex_unlock(&impl->lock);
+    return entry.kind;
+  }
+
+  size_t size = 0;
+  if (RCUTILS_RET_OK == rcutils_hash_map_get_size(&impl->entries, &size) &&
+    size >= impl->options.max_entries)
+  {
+    if (RCUTILS_RET_OK != stat_cache_fini_entries(impl) ||
+      RCUTILS_RET_OK != stat_cache_init_entries(impl))
+    {
+      // The paths are still checked, even if they may not be cached anymore.
+      rcutils_reset_error();
+    }
+  }
+
+  // Watch the parent directory before checking the path, not to miss a change in between.
+  entry.watch = -1;
+  entry.generation = 0;
+#ifdef __linux__
+  entry.watch = stat_cache_watch_parent(impl, abs_path);
+  if (entry.watch >= 0) {
+    entry.generation = impl->generations[entry.watch];
+  }
+#endif
+  entry.kind = stat_cache_kind_of(abs_path);
+  entry.expiry = impl->options.ttl > 0 ? now + impl->options.ttl : INT64_MAX;
+  if (entry.watch < 0 && impl->options.ttl <= 0) {
+    rcutils_mutex_unlock(&impl->lock);
+    return entry.kind;
+  }
+
+  const char * path = NULL;
+  if (RCUTILS_RET_OK != rcutils_string_pool_intern(&impl->paths, abs_path, &path, NULL) ||
+    RCUTILS_RET_OK != rcutils_hash_map_set(&impl->entries, &path, &entry))
+  {
+    // The metadata is still right, only not cached.
+    rcutils_reset_error();
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  return entry.kind;
+}
+
+rcutils_stat_cache_options_t
+rcutils_stat_cache_get_default_options(void)
+{
+  rcutils_stat_cache_options_t options;
+  options.ttl = RCUTILS_STAT_CACHE_DEFAULT_TTL;
+  options.watch_changes = true;
+  options.max_entries = RCUTILS_STAT_CACHE_DEFAULT_MAX_ENTRIES;
+  return options;
+}
+
+rcutils_stat_cache_t
+rcutils_get_zero_initialized_stat_cache(void)
+{
+  static rcutils_stat_cache_t zero_initialized_stat_cache = {NULL};
+  return zero_initialized_stat_cache;
+}
+
+rcutils_ret_t
+rcutils_stat_cache_init(
+  rcutils_stat_cache_t * stat_cache,
+  const rcutils_stat_cache_options_t * options,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stat_cache, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_stat_cache_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_stat_cache_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for stat cache impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->options = NULL != options ? *options : rcutils_stat_cache_get_default_options();
+  impl->watch_fd = -1;
+  impl->stop_fd = -1;
+  impl->generations = NULL;
+  impl->generations_size = 0;
+  impl->allocator = *allocator;
+  rcutils_ret_t ret = stat_cache_init_entries(impl);
+  if (RCUTILS_RET_OK != ret) {
+    allocator->deallocate(impl, allocator->state);
+    return ret;
+  }
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->lock)) {
+    ret = stat_cache_fini_entries(impl);
+    (void)ret;
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the lock of the stat cache");
+    return RCUTILS_RET_ERROR;
+  }
+#ifdef __linux__
+  if (impl->options.watch_changes) {
+    stat_cache_start_watching(impl);
+  }
+#endif
+  stat_cache->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_stat_cache_fini(rcutils_stat_cache_t * stat_cache)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stat_cache, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_stat_cache_impl_t * impl = stat_cache->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+#ifdef __linux__
+  stat_cache_stop_watching(impl);
+#endif
+  rcutils_ret_t ret = stat_cache_fini_entries(impl);
+  rcutils_mutex_fini(&impl->lock);
+  impl->allocator.deallocate(impl->generations, impl->allocator.state);
+  impl->allocator.deallocate(impl, impl->allocator.state);
+  stat_cache->impl = NULL;
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_stat_cache_clear(rcutils_stat_cache_t * stat_cache)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stat_cache, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_stat_cache_impl_t * impl = stat_cache->impl;
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("stat cache is not initialized");
+    return RCUTILS_RET_NOT_INITIALIZED;
+  }
+  rcutils_mutex_lock(&impl->lock);
+  rcutils_ret_t ret = stat_cache_fini_entries(impl);
+  rcutils_ret_t init_ret = stat_cache_init_entries(impl);
+  if (RCUTILS_RET_OK == ret) {
+    ret = init_ret;
+  }
+  rcutils_mutex_unlock(&impl->lock);
+  return ret;
+}
+
+bool
+rcutils_stat_cache_is_directory(rcutils_stat_cache_t * stat_cache, const char * abs_path)
+{
+  if (NULL == abs_path) {
+    return false;
+  }
+  return STAT_CACHE_DIRECTORY == stat_cache_lookup(stat_cache, abs_path);
+}
+
+bool
+rcutils_stat_cache_is_file(rcutils_stat_cache_t * stat_cache, const char * abs_path)
+{
+  if (NULL == abs_path) {
+    return false;
+  }
+  return STAT_CACHE_FILE == stat_cache_lookup(stat_cache, abs_path);
+}
+
+bool
+rcutils_stat_cache_exists(rcutils_stat_cache_t * stat_cache, const char * abs_path)
+{
+  if (NULL == abs_path) {
+    return false;
+  }
+  return STAT_CACHE_MISSING != stat_cache_lookup(stat_cache, abs_path);
+}
+
 char *
 rcutils_join_path(
   const char * left_hand_path,
@@ -204,6 +644,172 @@ rcutils_to_native_path(
   return rcutils_repl_str(path, "/", RCUTILS_PATH_DELIMITER, &allocator);
 }
 
+// The initial capacity of the path of a path builder, enough for most paths
+#define PATH_BUILDER_INITIAL_CAPACITY ((size_t)256)
+// The initial number of components a path builder can hold
+#define PATH_BUILDER_INITIAL_DEPTH ((size_t)16)
+
+static bool
+path_builder_is_separator(char c)
+{
+#ifdef _WIN32
+  return '\\' == c || '/' == c;
+#else
+  return '/' == c;
+#endif
+}
+
+// Make the path of a path builder hold at least length characters and a null character
+static rcutils_ret_t
+path_builder_reserve(rcutils_path_builder_t * builder, size_t length)
+{
+  if (length < builder->capacity) {
+    return RCUTILS_RET_OK;
+  }
+  size_t capacity = builder->capacity + (builder->capacity >> 1);
+  if (capacity <= length) {
+    capacity = length + 1;
+  }
+  char * path = builder->allocator.reallocate(builder->path, capacity, builder->allocator.state);
+  if (NULL == path) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for path");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  builder->path = path;
+  builder->capacity = capacity;
+  return RCUTILS_RET_OK;
+}
+
+// Append characters to the path of a path builder, which has room for them
+static void
+path_builder_append(rcutils_path_builder_t * builder, const char * string, size_t length)
+{
+  char * end = builder->path + builder->length;
+  memcpy(end, string, length);
+#ifdef _WIN32
+  for (size_t i = 0; i < length; ++i) {
+    if ('/' == end[i]) {
+      end[i] = '\\';
+    }
+  }
+#endif
+  builder->length += length;
+  builder->path[builder->length] = '\0';
+}
+
+rcutils_path_builder_t
+rcutils_get_zero_initialized_path_builder(void)
+{
+  static rcutils_path_builder_t zero_initialized_path_builder = {
+    .path = NULL,
+    .length = 0u,
+    .capacity = 0u,
+    .lengths = NULL,
+    .depth = 0u,
+    .lengths_capacity = 0u,
+  };
+  zero_initialized_path_builder.allocator = rcutils_get_zero_initialized_allocator();
+  return zero_initialized_path_builder;
+}
+
+rcutils_ret_t
+rcutils_path_builder_init(
+  rcutils_path_builder_t * builder,
+  const char * base_path,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(base_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  *builder = rcutils_get_zero_initialized_path_builder();
+  builder->allocator = *allocator;
+  size_t length = strlen(base_path);
+  rcutils_ret_t ret = path_builder_reserve(
+    builder, length < PATH_BUILDER_INITIAL_CAPACITY ? PATH_BUILDER_INITIAL_CAPACITY : length);
+  if (RCUTILS_RET_OK != ret) {
+    *builder = rcutils_get_zero_initialized_path_builder();
+    return ret;
+  }
+  builder->lengths = allocator->allocate(
+    PATH_BUILDER_INITIAL_DEPTH * sizeof(size_t), allocator->state);
+  if (NULL == builder->lengths) {
+    allocator->deallocate(builder->path, allocator->state);
+    *builder = rcutils_get_zero_initialized_path_builder();
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for path builder");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  builder->lengths_capacity = PATH_BUILDER_INITIAL_DEPTH;
+  path_builder_append(builder, base_path, length);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_fini(rcutils_path_builder_t * builder)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != builder->path) {
+    builder->allocator.deallocate(builder->path, builder->allocator.state);
+    builder->allocator.deallocate(builder->lengths, builder->allocator.state);
+  }
+  *builder = rcutils_get_zero_initialized_path_builder();
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_push(rcutils_path_builder_t * builder, const char * component)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(component, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == builder->path) {
+    RCUTILS_SET_ERROR_MSG("path builder is not initialized");
+    return RCUTILS_RET_NOT_INITIALIZED;
+  }
+
+  if (builder->depth == builder->lengths_capacity) {
+    size_t lengths_capacity = 2 * builder->lengths_capacity;
+    size_t * lengths = builder->allocator.reallocate(
+      builder->lengths, lengths_capacity * sizeof(size_t), builder->allocator.state);
+    if (NULL == lengths) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for path builder");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    builder->lengths = lengths;
+    builder->lengths_capacity = lengths_capacity;
+  }
+
+  size_t length = strlen(component);
+  bool separator = builder->length > 0 &&
+    !path_builder_is_separator(builder->path[builder->length - 1]);
+  rcutils_ret_t ret = path_builder_reserve(builder, builder->length + separator + length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  builder->lengths[builder->depth++] = builder->length;
+  if (separator) {
+    path_builder_append(builder, RCUTILS_PATH_DELIMITER, 1);
+  }
+  path_builder_append(builder, component, length);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_pop(rcutils_path_builder_t * builder)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == builder->path) {
+    RCUTILS_SET_ERROR_MSG("path builder is not initialized");
+    return RCUTILS_RET_NOT_INITIALIZED;
+  }
+  if (0 == builder->depth) {
+    RCUTILS_SET_ERROR_MSG("path builder has no component to pop");
+    return RCUTILS_RET_ERROR;
+  }
+  builder->length = builder->lengths[--builder->depth];
+  builder->path[builder->length] = '\0';
+  return RCUTILS_RET_OK;
+}
+
 char *
 rcutils_expand_user(const char * path, rcutils_allocator_t allocator)
 {
@@ -268,6 +874,7 @@ rcutils_calculate_directory_size(
   return rcutils_calculate_directory_size_with_recursion(directory_path, 1, size, allocator);
 }
 
+#ifdef _WIN32
 typedef struct dir_list_t
 {
   char * path;
@@ -306,15 +913,27 @@ static rcutils_ret_t check_and_calculate_size(
     return RCUTILS_RET_OK;
   }
 
-  char * file_path = rcutils_join_path(dir_list->path, filename, allocator);
+  // Most paths are only needed here, so they are joined on the stack when they fit.
+  char path_buffer[256];
+  char * file_path = rcutils_format_string_buffer(
+    path_buffer, sizeof(path_buffer), allocator, 2048, NULL,
+    "%s%s%s", dir_list->path, RCUTILS_PATH_DELIMITER, filename);
   if (NULL == file_path) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("rcutils_join_path return NULL !\n");
+    RCUTILS_SAFE_FWRITE_TO_STDERR("rcutils_format_string_buffer return NULL !\n");
     return RCUTILS_RET_BAD_ALLOC;
   }
 
   if (rcutils_is_directory(file_path)) {
     if ((max_depth == 0) || ((dir_list->depth + 1) <= max_depth)) {
-      // Add new directory to dir_list
+      // Add new directory to dir_list, which keeps its path
+      if (path_buffer == file_path) {
+        file_path = rcutils_strdup(path_buffer, allocator);
+        if (NULL == file_path) {
+          RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+            "Failed to allocate memory for path %s !\n", path_buffer);
+          return RCUTILS_RET_BAD_ALLOC;
+        }
+      }
       dir_list_t * found_new_dir =
         allocator.allocate(sizeof(dir_list_t), allocator.state);
       if (NULL == found_new_dir) {
@@ -333,38 +952,27 @@ static rcutils_ret_t check_and_calculate_size(
     *dir_size += rcutils_get_file_size(file_path);
   }
 
-  allocator.deallocate(file_path, allocator.state);
+  if (path_buffer != file_path) {
+    allocator.deallocate(file_path, allocator.state);
+  }
 
   return RCUTILS_RET_OK;
 }
 
-rcutils_ret_t
-rcutils_calculate_directory_size_with_recursion(
+static rcutils_ret_t
+calculate_directory_size(
   const char * directory_path,
   const size_t max_depth,
+  size_t thread_count,
   uint64_t * size,
   rcutils_allocator_t allocator)
 {
+  // The directories are iterated in the calling thread only.
+  (void)thread_count;
   dir_list_t * dir_list = NULL;
   rcutils_ret_t ret = RCUTILS_RET_OK;
   rcutils_dir_iter_t * iter = NULL;
 
-  if (NULL == directory_path) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("directory_path is NULL !");
-    return RCUTILS_RET_INVALID_ARGUMENT;
-  }
-
-  if (NULL == size) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("size pointer is NULL !");
-    return RCUTILS_RET_INVALID_ARGUMENT;
-  }
-
-  if (!rcutils_is_directory(directory_path)) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-      "Path is not a directory: %s\n", directory_path);
-    return RCUTILS_RET_ERROR;
-  }
-
   dir_list = allocator.zero_allocate(1, sizeof(dir_list_t), allocator.state);
   if (NULL == dir_list) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to allocate memory !\n");
@@ -408,37 +1016,375 @@ fail:
   free_dir_list(dir_list, allocator);
   return ret;
 }
+#else
+// A directory whose subdirectories are opened relative to its file descriptor, which is kept
+// open while it is iterated and until its subdirectories are opened.
+typedef struct dir_size_node_s
+{
+  DIR * dir;
+  size_t depth;
+  // The iteration and the subdirectories not opened yet, guarded by the lock of the walk
+  size_t references;
+} dir_size_node_t;
 
-rcutils_dir_iter_t *
-rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t allocator)
+// A subdirectory to be iterated
+typedef struct dir_size_item_s
 {
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, NULL);
-  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
-    &allocator, "allocator is invalid", return NULL);
+  dir_size_node_t * parent;
+  char * name;
+} dir_size_item_t;
 
-  rcutils_dir_iter_t * iter = (rcutils_dir_iter_t *)allocator.zero_allocate(
-    1, sizeof(rcutils_dir_iter_t), allocator.state);
-  if (NULL == iter) {
-    return NULL;
+typedef struct dir_size_walk_s
+{
+  rcutils_mutex_t lock;
+  rcutils_condition_variable_t cv;
+  // A stack of the subdirectories to be iterated, so that the tree is walked depth first and
+  // few directories are kept open
+  dir_size_item_t * items;
+  size_t item_count;
+  size_t item_capacity;
+  // The threads iterating a directory, which may find more subdirectories
+  size_t busy_count;
+  size_t waiting_count;
+  size_t max_depth;
+  uint64_t size;
+  rcutils_ret_t ret;
+  char error_message[256];
+  rcutils_allocator_t allocator;
+} dir_size_walk_t;
+
+// Record the first error of the walk, which stops it, with the lock held.
+static void
+dir_size_walk_fail(dir_size_walk_t * walk, rcutils_ret_t ret, const char * message)
+{
+  if (RCUTILS_RET_OK == walk->ret) {
+    walk->ret = ret;
+    snprintf(walk->error_message, sizeof(walk->error_message), "%s", message);
+    rcutils_condition_variable_notify_all(&walk->cv);
   }
-  iter->allocator = allocator;
+}
 
-  rcutils_dir_iter_state_t * state = (rcutils_dir_iter_state_t *)allocator.zero_allocate(
-    1, sizeof(rcutils_dir_iter_state_t), allocator.state);
-  if (NULL == state) {
-    RCUTILS_SET_ERROR_MSG(
-      "Failed to allocate memory.\n");
-    goto rcutils_dir_iter_start_fail;
+static void
+dir_size_node_release(dir_size_walk_t * walk, dir_size_node_t * node)
+{
+  rcutils_mutex_lock(&walk->lock);
+  bool last = 0 == --node->references;
+  rcutils_mutex_unlock(&walk->lock);
+  if (last) {
+    closedir(node->dir);
+    walk->allocator.deallocate(node, walk->allocator.state);
   }
-  iter->state = (void *)state;
+}
 
-#ifdef _WIN32
-  char * search_path = rcutils_join_path(directory_path, "*", allocator);
-  if (NULL == search_path) {
-    goto rcutils_dir_iter_start_fail;
+// Add a subdirectory of the node to be iterated.
+static rcutils_ret_t
+dir_size_push(dir_size_walk_t * walk, dir_size_node_t * node, const char * name)
+{
+  char * name_copy = rcutils_strdup(name, walk->allocator);
+  if (NULL == name_copy) {
+    return RCUTILS_RET_BAD_ALLOC;
   }
-  state->handle = FindFirstFile(search_path, &state->data);
-  allocator.deallocate(search_path, allocator.state);
+  rcutils_mutex_lock(&walk->lock);
+  if (walk->item_count == walk->item_capacity) {
+    size_t capacity = 0 == walk->item_capacity ? 16 : 2 * walk->item_capacity;
+    dir_size_item_t * items = walk->allocator.reallocate(
+      walk->items, capacity * sizeof(dir_size_item_t), walk->allocator.state);
+    if (NULL == items) {
+      rcutils_mutex_unlock(&walk->lock);
+      walk->allocator.deallocate(name_copy, walk->allocator.state);
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    walk->items = items;
+    walk->item_capacity = capacity;
+  }
+  ++node->references;
+  walk->items[walk->item_count].parent = node;
+  walk->items[walk->item_count].name = name_copy;
+  ++walk->item_count;
+  if (walk->waiting_count > 0) {
+    rcutils_condition_variable_notify_all(&walk->cv);
+  }
+  rcutils_mutex_unlock(&walk->lock);
+  return RCUTILS_RET_OK;
+}
+
+// Add the sizes of the files of an opened directory, and the subdirectories to be iterated.
+static rcutils_ret_t
+dir_size_iterate(dir_size_walk_t * walk, dir_size_node_t * node, uint64_t * size)
+{
+  int fd = dirfd(node->dir);
+  for (;;) {
+    errno = 0;
+    struct dirent * entry = readdir(node->dir);
+    if (NULL == entry) {
+      return 0 == errno ? RCUTILS_RET_OK : RCUTILS_RET_ERROR;
+    }
+    const char * name = entry->d_name;
+    // Skip over local folder handle (`.`) and parent folder (`..`)
+    if ('.' == name[0] && ('\0' == name[1] || ('.' == name[1] && '\0' == name[2]))) {
+      continue;
+    }
+    bool is_directory = false;
+    bool is_file = false;
+    bool inspected = false;
+    struct stat stat_buffer;
+#ifdef DT_UNKNOWN
+    is_directory = DT_DIR == entry->d_type;
+    is_file = DT_REG == entry->d_type;
+    if (DT_UNKNOWN == entry->d_type)
+#endif
+    {
+      if (0 != fstatat(fd, name, &stat_buffer, AT_SYMLINK_NOFOLLOW)) {
+        continue;
+      }
+      is_directory = S_ISDIR(stat_buffer.st_mode);
+      is_file = S_ISREG(stat_buffer.st_mode);
+      inspected = true;
+    }
+    if (is_file) {
+      if (inspected || 0 == fstatat(fd, name, &stat_buffer, AT_SYMLINK_NOFOLLOW)) {
+        *size += (uint64_t)stat_buffer.st_size;
+      }
+    } else if (is_directory && (0 == walk->max_depth || node->depth + 1 <= walk->max_depth)) {
+      rcutils_ret_t ret = dir_size_push(walk, node, name);
+      if (RCUTILS_RET_OK != ret) {
+        return ret;
+      }
+    }
+  }
+}
+
+// Open a subdirectory, iterate it and release it.
+static rcutils_ret_t
+dir_size_open_and_iterate(dir_size_walk_t * walk, dir_size_item_t * item, uint64_t * size)
+{
+  rcutils_allocator_t allocator = walk->allocator;
+  int fd = openat(
+    dirfd(item->parent->dir), item->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+  int error = errno;
+  size_t depth = item->parent->depth + 1;
+  allocator.deallocate(item->name, allocator.state);
+  dir_size_node_release(walk, item->parent);
+  dir_size_node_t * node = NULL;
+  if (fd >= 0) {
+    node = allocator.allocate(sizeof(dir_size_node_t), allocator.state);
+    if (NULL == node) {
+      close(fd);
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    node->dir = fdopendir(fd);
+    error = errno;
+  }
+  if (fd < 0 || NULL == node->dir) {
+    if (fd >= 0) {
+      close(fd);
+      allocator.deallocate(node, allocator.state);
+    }
+    char message[64];
+    snprintf(message, sizeof(message), "Can't open directory. Error code: %d\n", error);
+    rcutils_mutex_lock(&walk->lock);
+    dir_size_walk_fail(walk, RCUTILS_RET_ERROR, message);
+    rcutils_mutex_unlock(&walk->lock);
+    return RCUTILS_RET_ERROR;
+  }
+  node->depth = depth;
+  node->references = 1;
+  rcutils_ret_t ret = dir_size_iterate(walk, node, size);
+  dir_size_node_release(walk, node);
+  return ret;
+}
+
+// Iterate the subdirectories to be iterated, until there are none left or the walk failed.
+static void
+dir_size_work(void * arg)
+{
+  dir_size_walk_t * walk = arg;
+  uint64_t size = 0;
+  rcutils_mutex_lock(&walk->lock);
+  for (;;) {
+    while (0 == walk->item_count && walk->busy_count > 0 && RCUTILS_RET_OK == walk->ret) {
+      ++walk->waiting_count;
+      rcutils_condition_variable_wait_for(&walk->cv, &walk->lock, 100);
+      --walk->waiting_count;
+    }
+    if (0 == walk->item_count || RCUTILS_RET_OK != walk->ret) {
+      break;
+    }
+    dir_size_item_t item = walk->items[--walk->item_count];
+    ++walk->busy_count;
+    rcutils_mutex_unlock(&walk->lock);
+    rcutils_ret_t ret = dir_size_open_and_iterate(walk, &item, &size);
+    rcutils_mutex_lock(&walk->lock);
+    --walk->busy_count;
+    if (RCUTILS_RET_OK != ret) {
+      dir_size_walk_fail(walk, ret, "Failed to iterate directory\n");
+    }
+    if (0 == walk->busy_count && 0 == walk->item_count) {
+      rcutils_condition_variable_notify_all(&walk->cv);
+    }
+  }
+  walk->size += size;
+  rcutils_mutex_unlock(&walk->lock);
+}
+
+static rcutils_ret_t
+calculate_directory_size(
+  const char * directory_path,
+  const size_t max_depth,
+  size_t thread_count,
+  uint64_t * size,
+  rcutils_allocator_t allocator)
+{
+  dir_size_walk_t walk;
+  walk.items = NULL;
+  walk.item_count = 0;
+  walk.item_capacity = 0;
+  walk.busy_count = 0;
+  walk.waiting_count = 0;
+  walk.max_depth = max_depth;
+  walk.size = 0;
+  walk.ret = RCUTILS_RET_OK;
+  walk.error_message[0] = '\0';
+  walk.allocator = allocator;
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&walk.lock)) {
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK != rcutils_condition_variable_init(&walk.cv)) {
+    rcutils_mutex_fini(&walk.lock);
+    return RCUTILS_RET_ERROR;
+  }
+
+  dir_size_node_t * root = allocator.allocate(sizeof(dir_size_node_t), allocator.state);
+  if (NULL == root) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to allocate memory !\n");
+    walk.ret = RCUTILS_RET_BAD_ALLOC;
+    goto finish;
+  }
+  root->dir = opendir(directory_path);
+  if (NULL == root->dir) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open directory %s. Error code: %d\n", directory_path, errno);
+    allocator.deallocate(root, allocator.state);
+    walk.ret = RCUTILS_RET_ERROR;
+    goto finish;
+  }
+  root->depth = 1;
+  root->references = 1;
+  walk.ret = dir_size_iterate(&walk, root, &walk.size);
+  dir_size_node_release(&walk, root);
+  if (RCUTILS_RET_OK != walk.ret) {
+    goto finish;
+  }
+
+  // Only start threads if there are subdirectories, and iterate them in the calling thread too.
+  if (0 == thread_count) {
+    thread_count = rcutils_thread_get_processor_count();
+  }
+  if (thread_count > 1 && walk.item_count > 0) {
+    rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+    options.thread_count = thread_count - 1;
+    if (RCUTILS_RET_OK == rcutils_thread_pool_init(&pool, &options, &allocator)) {
+      for (size_t i = 0; i + 1 < thread_count; ++i) {
+        if (RCUTILS_RET_OK != rcutils_thread_pool_submit(&pool, dir_size_work, &walk)) {
+          rcutils_reset_error();
+          break;
+        }
+      }
+    } else {
+      rcutils_reset_error();
+    }
+  }
+  dir_size_work(&walk);
+  if (NULL != pool.impl && RCUTILS_RET_OK != rcutils_thread_pool_fini(&pool)) {
+    rcutils_reset_error();
+  }
+
+finish:
+  // The subdirectories left after a failure are released.
+  while (walk.item_count > 0) {
+    dir_size_item_t * item = &walk.items[--walk.item_count];
+    allocator.deallocate(item->name, allocator.state);
+    dir_size_node_release(&walk, item->parent);
+  }
+  allocator.deallocate(walk.items, allocator.state);
+  rcutils_condition_variable_fini(&walk.cv);
+  rcutils_mutex_fini(&walk.lock);
+  if ('\0' != walk.error_message[0]) {
+    RCUTILS_SET_ERROR_MSG(walk.error_message);
+  }
+  *size = walk.size;
+  return walk.ret;
+}
+#endif  // _WIN32
+
+rcutils_ret_t
+rcutils_calculate_directory_size_with_recursion(
+  const char * directory_path,
+  const size_t max_depth,
+  uint64_t * size,
+  rcutils_allocator_t allocator)
+{
+  return rcutils_calculate_directory_size_parallel(directory_path, max_depth, 1, size, allocator);
+}
+
+rcutils_ret_t
+rcutils_calculate_directory_size_parallel(
+  const char * directory_path,
+  const size_t max_depth,
+  size_t thread_count,
+  uint64_t * size,
+  rcutils_allocator_t allocator)
+{
+  if (NULL == directory_path) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("directory_path is NULL !");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  if (NULL == size) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("size pointer is NULL !");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  if (!rcutils_is_directory(directory_path)) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Path is not a directory: %s\n", directory_path);
+    return RCUTILS_RET_ERROR;
+  }
+
+  return calculate_directory_size(directory_path, max_depth, thread_count, size, allocator);
+}
+
+rcutils_dir_iter_t *
+rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return NULL);
+
+  rcutils_dir_iter_t * iter = (rcutils_dir_iter_t *)allocator.zero_allocate(
+    1, sizeof(rcutils_dir_iter_t), allocator.state);
+  if (NULL == iter) {
+    return NULL;
+  }
+  iter->allocator = allocator;
+
+  rcutils_dir_iter_state_t * state = (rcutils_dir_iter_state_t *)allocator.zero_allocate(
+    1, sizeof(rcutils_dir_iter_state_t), allocator.state);
+  if (NULL == state) {
+    RCUTILS_SET_ERROR_MSG(
+      "Failed to allocate memory.\n");
+    goto rcutils_dir_iter_start_fail;
+  }
+  iter->state = (void *)state;
+
+#ifdef _WIN32
+  char * search_path = rcutils_join_path(directory_path, "*", allocator);
+  if (NULL == search_path) {
+    goto rcutils_dir_iter_start_fail;
+  }
+  state->handle = FindFirstFile(search_path, &state->data);
+  allocator.deallocate(search_path, allocator.state);
   if (INVALID_HANDLE_VALUE == state->handle) {
     DWORD error = GetLastError();
     if (ERROR_FILE_NOT_FOUND != error || !rcutils_is_directory(directory_path)) {
@@ -538,6 +1484,699 @@ rcutils_get_file_size(const char * file_path)
   return rc == 0 ? (size_t)(stat_buffer.st_size) : 0;
 }
 
+rcutils_mapped_file_t
+rcutils_get_zero_initialized_mapped_file(void)
+{
+  static rcutils_mapped_file_t zero_initialized_mapped_file = {NULL, 0u};
+  return zero_initialized_mapped_file;
+}
+
+rcutils_ret_t
+rcutils_mmap_file(
+  const char * file_path,
+  rcutils_mmap_access_t access,
+  rcutils_mapped_file_t * mapped_file)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(mapped_file, RCUTILS_RET_INVALID_ARGUMENT);
+
+#ifdef _WIN32
+  DWORD flags = FILE_ATTRIBUTE_NORMAL;
+  if (RCUTILS_MMAP_ACCESS_SEQUENTIAL == access) {
+    flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+  } else if (RCUTILS_MMAP_ACCESS_RANDOM == access) {
+    flags |= FILE_FLAG_RANDOM_ACCESS;
+  }
+  HANDLE file = CreateFileA(
+    file_path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+    OPEN_EXISTING, flags, NULL);
+  if (INVALID_HANDLE_VALUE == file) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open file %s. Error code: %lu\n", file_path, GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || GetFileType(file) != FILE_TYPE_DISK ||
+    (uint64_t)file_size.QuadPart > SIZE_MAX)
+  {
+    CloseHandle(file);
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Can't map file %s\n", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+  const uint8_t * data = NULL;
+  if (file_size.QuadPart > 0) {
+    // The view keeps the mapping, and the file, open until it is unmapped.
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL != mapping) {
+      data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+    }
+    if (NULL == data) {
+      CloseHandle(file);
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Can't map file %s. Error code: %lu\n", file_path, GetLastError());
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  CloseHandle(file);
+#else
+  int fd = open(file_path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open file %s. Error code: %d\n", file_path, errno);
+    return RCUTILS_RET_ERROR;
+  }
+  struct stat stat_buffer;
+  if (0 != fstat(fd, &stat_buffer) || !S_ISREG(stat_buffer.st_mode) ||
+    (uint64_t)stat_buffer.st_size > SIZE_MAX)
+  {
+    close(fd);
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Can't map file %s\n", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+  const uint8_t * data = NULL;
+  if (stat_buffer.st_size > 0) {
+    // The mapping keeps the file open until it is unmapped.
+    void * mapping = mmap(NULL, (size_t)stat_buffer.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == mapping) {
+      int error = errno;
+      close(fd);
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Can't map file %s. Error code: %d\n", file_path, error);
+      return RCUTILS_RET_ERROR;
+    }
+    if (RCUTILS_MMAP_ACCESS_SEQUENTIAL == access) {
+      (void)posix_madvise(mapping, (size_t)stat_buffer.st_size, POSIX_MADV_SEQUENTIAL);
+    } else if (RCUTILS_MMAP_ACCESS_RANDOM == access) {
+      (void)posix_madvise(mapping, (size_t)stat_buffer.st_size, POSIX_MADV_RANDOM);
+    }
+    data = mapping;
+  }
+  close(fd);
+#endif
+
+  mapped_file->data = data;
+#ifdef _WIN32
+  mapped_file->size = (size_t)file_size.QuadPart;
+#else
+  mapped_file->size = (size_t)stat_buffer.st_size;
+#endif
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_munmap_file(rcutils_mapped_file_t * mapped_file)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(mapped_file, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != mapped_file->data) {
+#ifdef _WIN32
+    if (!UnmapViewOfFile(mapped_file->data)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Can't unmap file. Error code: %lu\n", GetLastError());
+      return RCUTILS_RET_ERROR;
+    }
+#else
+    if (0 != munmap((void *)mapped_file->data, mapped_file->size)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Can't unmap file. Error code: %d\n", errno);
+      return RCUTILS_RET_ERROR;
+    }
+#endif
+  }
+  *mapped_file = rcutils_get_zero_initialized_mapped_file();
+  return RCUTILS_RET_OK;
+}
+
+// The most bytes asked for by a single read, which Windows limits to 32 bits
+#define READ_FILE_MAX_READ_SIZE ((size_t)1 << 30)
+// The size, and alignment, of the intermediate buffer of O_DIRECT reads
+#define READ_FILE_DIRECT_BUFFER_SIZE ((size_t)1 << 20)
+#define READ_FILE_DIRECT_ALIGNMENT ((size_t)4096)
+
+// Make an array hold at least capacity bytes of a file, returning its buffer
+typedef rcutils_ret_t (* read_file_reserve_t)(void * array, size_t capacity, uint8_t ** buffer);
+
+static rcutils_ret_t
+read_file_reserve_uint8_array(void * array, size_t capacity, uint8_t ** buffer)
+{
+  rcutils_uint8_array_t * uint8_array = array;
+  if (capacity > uint8_array->buffer_capacity) {
+    rcutils_ret_t ret = rcutils_uint8_array_resize(uint8_array, capacity);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+  *buffer = uint8_array->buffer;
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t
+read_file_reserve_char_array(void * array, size_t capacity, uint8_t ** buffer)
+{
+  rcutils_char_array_t * char_array = array;
+  // Leave room for the terminating null character
+  if (capacity >= char_array->buffer_capacity) {
+    if (SIZE_MAX == capacity) {
+      RCUTILS_SET_ERROR_MSG("file is too large");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    rcutils_ret_t ret = rcutils_char_array_resize(char_array, capacity + 1);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+  *buffer = (uint8_t *)char_array->buffer;
+  return RCUTILS_RET_OK;
+}
+
+// Read a whole file into an array, setting length to the number of bytes read
+static rcutils_ret_t
+read_file(
+  const char * file_path,
+  bool direct_io,
+  read_file_reserve_t reserve,
+  void * array,
+  const rcutils_allocator_t * allocator,
+  size_t * length)
+{
+  uint64_t file_size = 0;
+  // O_DIRECT reads must be aligned in memory, so they go through an aligned buffer.
+  uint8_t * direct_buffer = NULL;
+#ifdef _WIN32
+  (void)direct_io;
+  HANDLE file = CreateFileA(
+    file_path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (INVALID_HANDLE_VALUE == file) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open file %s. Error code: %lu\n", file_path, GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+  LARGE_INTEGER size;
+  if (GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &size)) {
+    file_size = (uint64_t)size.QuadPart;
+  }
+#else
+  int flags = O_RDONLY | O_CLOEXEC;
+#ifdef O_DIRECT
+  if (direct_io) {
+    flags |= O_DIRECT;
+  }
+#endif
+  int fd = open(file_path, flags);
+#ifdef O_DIRECT
+  if (fd < 0 && EINVAL == errno && direct_io) {
+    // The file system doesn't support O_DIRECT, e.g. tmpfs
+    flags &= ~O_DIRECT;
+    fd = open(file_path, flags);
+  }
+#endif
+  if (fd < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open file %s. Error code: %d\n", file_path, errno);
+    return RCUTILS_RET_ERROR;
+  }
+  struct stat stat_buffer;
+  if (0 != fstat(fd, &stat_buffer) || S_ISDIR(stat_buffer.st_mode)) {
+    close(fd);
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Can't read file %s\n", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+  if (S_ISREG(stat_buffer.st_mode)) {
+    file_size = (uint64_t)stat_buffer.st_size;
+  }
+#if defined(F_NOCACHE)
+  if (direct_io) {
+    (void)fcntl(fd, F_NOCACHE, 1);
+  }
+#elif defined(__linux__)
+  if (!(flags & O_DIRECT)) {
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+#endif
+#ifdef O_DIRECT
+  if (flags & O_DIRECT) {
+    direct_buffer = rcutils_aligned_allocate(
+      READ_FILE_DIRECT_ALIGNMENT, READ_FILE_DIRECT_BUFFER_SIZE, allocator);
+    if (NULL == direct_buffer) {
+      close(fd);
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for reading the file");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+#endif
+#endif
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  uint8_t * buffer = NULL;
+  size_t capacity = 0;
+  if (file_size > SIZE_MAX) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("File %s is too large\n", file_path);
+    ret = RCUTILS_RET_BAD_ALLOC;
+  } else {
+    capacity = (size_t)file_size;
+    ret = reserve(array, capacity, &buffer);
+  }
+
+  // Bytes beyond the expected size of the file are read into a small buffer first, so that
+  // the array only grows if the file is larger than it seemed.
+  uint8_t probe[256];
+  size_t read_length = 0;
+  while (RCUTILS_RET_OK == ret) {
+    uint8_t * target = probe;
+    size_t target_size = sizeof(probe);
+    bool in_place = false;
+    if (NULL != direct_buffer) {
+      target = direct_buffer;
+      target_size = READ_FILE_DIRECT_BUFFER_SIZE;
+    } else if (read_length < capacity) {
+      target = buffer + read_length;
+      target_size = capacity - read_length;
+      in_place = true;
+    }
+    if (target_size > READ_FILE_MAX_READ_SIZE) {
+      target_size = READ_FILE_MAX_READ_SIZE;
+    }
+
+    size_t count = 0;
+#ifdef _WIN32
+    DWORD read_count = 0;
+    if (!ReadFile(file, target, (DWORD)target_size, &read_count, NULL)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Can't read file %s. Error code: %lu\n", file_path, GetLastError());
+      ret = RCUTILS_RET_ERROR;
+      break;
+    }
+    count = read_count;
+#else
+    ssize_t read_count = read(fd, target, target_size);
+    if (read_count < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+#ifdef O_DIRECT
+      // Some file systems accept O_DIRECT when opening but not when reading.
+      if (EINVAL == errno && NULL != direct_buffer &&
+        0 == fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT))
+      {
+        rcutils_aligned_deallocate(direct_buffer, allocator);
+        direct_buffer = NULL;
+        continue;
+      }
+#endif
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Can't read file %s. Error code: %d\n", file_path, errno);
+      ret = RCUTILS_RET_ERROR;
+      break;
+    }
+    count = (size_t)read_count;
+#endif
+    if (0 == count) {
+      break;
+    }
+
+    if (!in_place) {
+      if (count > capacity - read_length) {
+        // Grow geometrically, as the size of the file isn't known anymore.
+        size_t new_capacity = capacity + (capacity >> 1);
+        if (new_capacity < read_length + count) {
+          new_capacity = read_length + count;
+        }
+        ret = reserve(array, new_capacity, &buffer);
+        if (RCUTILS_RET_OK != ret) {
+          break;
+        }
+        capacity = new_capacity;
+      }
+      memcpy(buffer + read_length, target, count);
+    }
+    read_length += count;
+  }
+
+  rcutils_aligned_deallocate(direct_buffer, allocator);
+#ifdef _WIN32
+  CloseHandle(file);
+#else
+  close(fd);
+#endif
+  *length = read_length;
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_read_file(
+  const char * file_path,
+  bool direct_io,
+  rcutils_uint8_array_t * uint8_array)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(uint8_array, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(&uint8_array->allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  size_t length = 0;
+  rcutils_ret_t ret = read_file(
+    file_path, direct_io, read_file_reserve_uint8_array, uint8_array, &uint8_array->allocator,
+    &length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  uint8_array->buffer_length = length;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_read_file_to_char_array(
+  const char * file_path,
+  bool direct_io,
+  rcutils_char_array_t * char_array)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(&char_array->allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  size_t length = 0;
+  rcutils_ret_t ret = read_file(
+    file_path, direct_io, read_file_reserve_char_array, char_array, &char_array->allocator,
+    &length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  // An empty file still needs room for the terminating null character.
+  uint8_t * buffer = NULL;
+  ret = read_file_reserve_char_array(char_array, length, &buffer);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  char_array->buffer[length] = '\0';
+  char_array->buffer_length = length + 1;
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __linux__
+// The record of an entry returned by getdents64, which glibc only declares as of 2.30
+typedef struct dir_batch_linux_dirent64_s
+{
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;  // NOLINT(runtime/int)
+  unsigned char d_type;
+  char d_name[];
+} dir_batch_linux_dirent64_t;
+
+#define DIR_BATCH_BUFFER_SIZE ((size_t)32 * 1024)
+#endif
+
+struct rcutils_dir_batch_iter_s
+{
+  rcutils_allocator_t allocator;
+  bool with_size;
+#if defined(__linux__)
+  int fd;
+  // The records read by the last getdents64 call, which hold the names of the last batch
+  char * buffer;
+  size_t buffer_length;
+  size_t buffer_offset;
+#else
+# ifdef _WIN32
+  // The iterator, whose current entry is the next one unless the iteration is finished
+  rcutils_dir_iter_t * iter;
+# else
+  DIR * dir;
+# endif
+  // The names of the last batch, which are copied as the iterator may overwrite them
+  char * names;
+  size_t names_capacity;
+#endif
+};
+
+#ifndef _WIN32
+// Set the type, and the size if needed, of an entry of the given type as reported by the file
+// system, stating it if that isn't enough, and return false if it was removed meanwhile.
+static bool
+dir_batch_inspect(
+  int fd, const char * name, int d_type, bool with_size, rcutils_dir_entry_t * entry)
+{
+  entry->type = RCUTILS_DIR_ENTRY_TYPE_UNKNOWN;
+  entry->size = 0;
+#ifdef DT_UNKNOWN
+  switch (d_type) {
+    case DT_REG:
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_FILE;
+      break;
+    case DT_DIR:
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_DIRECTORY;
+      return true;
+    case DT_LNK:
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_SYMLINK;
+      return true;
+    case DT_UNKNOWN:
+      break;
+    default:
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_OTHER;
+      return true;
+  }
+  if (RCUTILS_DIR_ENTRY_TYPE_FILE == entry->type && !with_size) {
+    return true;
+  }
+#else
+  (void)d_type;
+#endif
+  struct stat stat_buffer;
+  if (0 != fstatat(fd, name, &stat_buffer, AT_SYMLINK_NOFOLLOW)) {
+    return ENOENT != errno;
+  }
+  if (S_ISREG(stat_buffer.st_mode)) {
+    entry->type = RCUTILS_DIR_ENTRY_TYPE_FILE;
+    entry->size = with_size ? (uint64_t)stat_buffer.st_size : 0u;
+  } else if (S_ISDIR(stat_buffer.st_mode)) {
+    entry->type = RCUTILS_DIR_ENTRY_TYPE_DIRECTORY;
+  } else if (S_ISLNK(stat_buffer.st_mode)) {
+    entry->type = RCUTILS_DIR_ENTRY_TYPE_SYMLINK;
+  } else {
+    entry->type = RCUTILS_DIR_ENTRY_TYPE_OTHER;
+  }
+  return true;
+}
+#endif
+
+static bool
+dir_batch_is_dot_or_dot_dot(const char * name)
+{
+  return '.' == name[0] && ('\0' == name[1] || ('.' == name[1] && '\0' == name[2]));
+}
+
+#ifndef __linux__
+// Copy the name of an entry into the names of the batch, returning its offset in them, or
+// SIZE_MAX if memory allocation fails.
+static size_t
+dir_batch_copy_name(rcutils_dir_batch_iter_t * iter, size_t * names_length, const char * name)
+{
+  size_t length = strlen(name) + 1;
+  if (*names_length + length > iter->names_capacity) {
+    size_t capacity = 2 * iter->names_capacity;
+    if (capacity < *names_length + length) {
+      capacity = *names_length + length;
+    }
+    char * names = iter->allocator.reallocate(iter->names, capacity, iter->allocator.state);
+    if (NULL == names) {
+      return SIZE_MAX;
+    }
+    iter->names = names;
+    iter->names_capacity = capacity;
+  }
+  size_t offset = *names_length;
+  memcpy(iter->names + offset, name, length);
+  *names_length += length;
+  return offset;
+}
+#endif
+
+rcutils_dir_batch_iter_t *
+rcutils_dir_batch_iter_start(
+  const char * directory_path,
+  bool with_size,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return NULL);
+
+  rcutils_dir_batch_iter_t * iter = allocator.zero_allocate(
+    1, sizeof(rcutils_dir_batch_iter_t), allocator.state);
+  if (NULL == iter) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory.\n");
+    return NULL;
+  }
+  iter->allocator = allocator;
+  iter->with_size = with_size;
+
+#if defined(__linux__)
+  iter->buffer = allocator.allocate(DIR_BATCH_BUFFER_SIZE, allocator.state);
+  if (NULL == iter->buffer) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory.\n");
+    allocator.deallocate(iter, allocator.state);
+    return NULL;
+  }
+  iter->fd = open(directory_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (iter->fd < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open directory %s. Error code: %d\n", directory_path, errno);
+    allocator.deallocate(iter->buffer, allocator.state);
+    allocator.deallocate(iter, allocator.state);
+    return NULL;
+  }
+#elif defined(_WIN32)
+  iter->iter = rcutils_dir_iter_start(directory_path, allocator);
+  if (NULL == iter->iter) {
+    allocator.deallocate(iter, allocator.state);
+    return NULL;
+  }
+#else
+  iter->dir = opendir(directory_path);
+  if (NULL == iter->dir) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open directory %s. Error code: %d\n", directory_path, errno);
+    allocator.deallocate(iter, allocator.state);
+    return NULL;
+  }
+#endif
+  return iter;
+}
+
+rcutils_ret_t
+rcutils_dir_batch_iter_next(
+  rcutils_dir_batch_iter_t * iter,
+  rcutils_dir_entry_t * entries,
+  size_t capacity,
+  size_t * count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(iter, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(entries, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RCUTILS_RET_INVALID_ARGUMENT);
+  if (0 == capacity) {
+    RCUTILS_SET_ERROR_MSG("capacity must not be zero");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  *count = 0;
+
+#if defined(__linux__)
+  while (*count < capacity) {
+    if (iter->buffer_offset == iter->buffer_length) {
+      // The names of the entries read so far are in the buffer, so they are returned first.
+      if (*count > 0) {
+        break;
+      }
+      long length = syscall(  // NOLINT(runtime/int)
+        SYS_getdents64, iter->fd, iter->buffer, DIR_BATCH_BUFFER_SIZE);
+      if (length < 0) {
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Can't iterate directory. Error code: %d\n", errno);
+        return RCUTILS_RET_ERROR;
+      }
+      iter->buffer_length = (size_t)length;
+      iter->buffer_offset = 0;
+      if (0 == length) {
+        break;
+      }
+    }
+    dir_batch_linux_dirent64_t * record =
+      (dir_batch_linux_dirent64_t *)(iter->buffer + iter->buffer_offset);
+    iter->buffer_offset += record->d_reclen;
+    if (dir_batch_is_dot_or_dot_dot(record->d_name)) {
+      continue;
+    }
+    rcutils_dir_entry_t * entry = &entries[*count];
+    entry->name = record->d_name;
+    if (dir_batch_inspect(iter->fd, record->d_name, record->d_type, iter->with_size, entry)) {
+      ++*count;
+    }
+  }
+#else
+  size_t names_length = 0;
+  while (*count < capacity) {
+    const char * name = NULL;
+    rcutils_dir_entry_t * entry = &entries[*count];
+# ifdef _WIN32
+    if (NULL == iter->iter->entry_name) {
+      break;
+    }
+    name = iter->iter->entry_name;
+    const WIN32_FIND_DATA * data = &((rcutils_dir_iter_state_t *)iter->iter->state)->data;
+    entry->size = 0;
+    if (data->dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_SYMLINK;
+    } else if (data->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_DIRECTORY;
+    } else if (data->dwFileAttributes & FILE_ATTRIBUTE_DEVICE) {
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_OTHER;
+    } else {
+      entry->type = RCUTILS_DIR_ENTRY_TYPE_FILE;
+      if (iter->with_size) {
+        entry->size = ((uint64_t)data->nFileSizeHigh << 32) | data->nFileSizeLow;
+      }
+    }
+    bool found = !dir_batch_is_dot_or_dot_dot(name);
+# else
+    errno = 0;
+    struct dirent * dirent = readdir(iter->dir);
+    if (NULL == dirent) {
+      if (0 != errno) {
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Can't iterate directory. Error code: %d\n", errno);
+        return RCUTILS_RET_ERROR;
+      }
+      break;
+    }
+    name = dirent->d_name;
+    int d_type = 0;
+#  ifdef DT_UNKNOWN
+    d_type = dirent->d_type;
+#  endif
+    bool found = !dir_batch_is_dot_or_dot_dot(name) &&
+      dir_batch_inspect(dirfd(iter->dir), name, d_type, iter->with_size, entry);
+# endif
+    if (found) {
+      // The offset of the name is kept until all names are copied, as they may be moved.
+      size_t offset = dir_batch_copy_name(iter, &names_length, name);
+      if (SIZE_MAX == offset) {
+        RCUTILS_SET_ERROR_MSG("Failed to allocate memory.\n");
+        return RCUTILS_RET_BAD_ALLOC;
+      }
+      entry->name = (const char *)(uintptr_t)offset;
+      ++*count;
+    }
+# ifdef _WIN32
+    // At the end of the directory, the entry name is set to NULL.
+    (void)rcutils_dir_iter_next(iter->iter);
+# endif
+  }
+  for (size_t i = 0; i < *count; ++i) {
+    entries[i].name = iter->names + (uintptr_t)entries[i].name;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_dir_batch_iter_end(rcutils_dir_batch_iter_t * iter)
+{
+  if (NULL == iter) {
+    return;
+  }
+  rcutils_allocator_t allocator = iter->allocator;
+#if defined(__linux__)
+  close(iter->fd);
+  allocator.deallocate(iter->buffer, allocator.state);
+#else
+# ifdef _WIN32
+  rcutils_dir_iter_end(iter->iter);
+# else
+  closedir(iter->dir);
+# endif
+  allocator.deallocate(iter->names, allocator.state);
+#endif
+  allocator.deallocate(iter, allocator.state);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,10 +24,16 @@
 size_t
 rcutils_find(const char * str, char delimiter)
 {
-  if (NULL == str || 0 == strlen(str)) {
+  // The terminating null character is not a part of the string.
+  if (NULL == str || '\0' == delimiter) {
     return SIZE_MAX;
   }
-  return rcutils_findn(str, delimiter, strlen(str));
+  // strchr scans the string once, where strlen and then memchr would scan it twice.
+  const char * ptr = strchr(str, delimiter);
+  if (NULL == ptr) {
+    return SIZE_MAX;
+  }
+  return (size_t)(ptr - str);
 }
 
 size_t
@@ -36,23 +43,32 @@ rcutils_findn(const char * str, char delimiter, size_t string_length)
     return SIZE_MAX;
   }
 
-  for (size_t i = 0; i < string_length; ++i) {
-    if (str[i] == delimiter) {
-      return i;
-    }
+  const char * ptr = memchr(str, delimiter, string_length);
+  if (NULL == ptr) {
+    return SIZE_MAX;
   }
-  return SIZE_MAX;
+  return (size_t)(ptr - str);
 }
 
 size_t
 rcutils_find_last(const char * str, char delimiter)
 {
-  if (NULL == str || 0 == strlen(str)) {
+  if (NULL == str || '\0' == delimiter) {
+    return SIZE_MAX;
+  }
+  const char * ptr = strrchr(str, delimiter);
+  if (NULL == ptr) {
     return SIZE_MAX;
   }
-  return rcutils_find_lastn(str, delimiter, strlen(str));
+  return (size_t)(ptr - str);
 }
 
+#if !defined(_GNU_SOURCE)
+// Whether any byte of the word is zero.
+#define FIND_HAS_ZERO_BYTE(word) \
+  ((((word) - UINT64_C(0x0101010101010101)) & ~(word) & UINT64_C(0x8080808080808080)) != 0)
+#endif
+
 size_t
 rcutils_find_lastn(const char * str, char delimiter, size_t string_length)
 {
@@ -68,11 +84,56 @@ rcutils_find_lastn(const char * str, char delimiter, size_t string_length)
 
   return ptr - str;
 #else
-  for (size_t i = string_length - 1; i > 0; --i) {
+  // Without memrchr, look at eight bytes at a time from the end, and only look at the bytes
+  // of the words which hold the delimiter.
+  const uint64_t pattern = UINT64_C(0x0101010101010101) * (unsigned char)delimiter;
+  size_t i = string_length;
+  while (i >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, str + i - sizeof(uint64_t), sizeof(word));
+    if (FIND_HAS_ZERO_BYTE(word ^ pattern)) {
+      break;
+    }
+    i -= sizeof(uint64_t);
+  }
+  while (i > 0) {
+    --i;
     if (str[i] == delimiter) {
       return i;
     }
   }
-  return str[0] == delimiter ? 0 : SIZE_MAX;
+  return SIZE_MAX;
 #endif
 }
+
+size_t
+rcutils_find_any(const char * str, const char * delimiters)
+{
+  if (NULL == str || NULL == delimiters || '\0' == delimiters[0]) {
+    return SIZE_MAX;
+  }
+  size_t i = strcspn(str, delimiters);
+  return '\0' == str[i] ? SIZE_MAX : i;
+}
+
+size_t
+rcutils_find_anyn(const char * str, const char * delimiters, size_t string_length)
+{
+  if (NULL == str || NULL == delimiters || '\0' == delimiters[0] || 0 == string_length) {
+    return SIZE_MAX;
+  }
+  if ('\0' == delimiters[1]) {
+    return rcutils_findn(str, delimiters[0], string_length);
+  }
+
+  bool is_delimiter[256] = {false};
+  for (const char * d = delimiters; '\0' != *d; ++d) {
+    is_delimiter[(unsigned char)*d] = true;
+  }
+  for (size_t i = 0; i < string_length; ++i) {
+    if (is_delimiter[(unsigned char)str[i]]) {
+      return i;
+    }
+  }
+  return SIZE_MAX;
+}
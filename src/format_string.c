@@ -28,47 +28,99 @@ extern "C"
 
 #include "rcutils/snprintf.h"
 
+// The size of the stack buffer that rcutils_format_string_limit() formats into first, so that
+// short strings are formatted once instead of twice.
+#define FORMAT_STRING_STACK_BUFFER_SIZE 256
+
 char *
-rcutils_format_string_limit(
+rcutils_vformat_string_buffer(
+  char * buffer,
+  size_t buffer_size,
   rcutils_allocator_t allocator,
   size_t limit,
+  size_t * length,
   const char * format_string,
-  ...)
+  va_list args)
 {
-  if (NULL == format_string) {
+  if (NULL == format_string || 0 == limit || (NULL == buffer && 0 != buffer_size)) {
     return NULL;
   }
   RCUTILS_CHECK_ALLOCATOR(&allocator, return NULL);
-  // extract the variadic arguments twice, once for length calculatio and once for formatting.
-  va_list args1;
-  va_start(args1, format_string);
-  va_list args2;
-  va_copy(args2, args1);
-  // first calculate the output string
-  size_t bytes_to_be_written = (size_t)rcutils_vsnprintf(NULL, 0, format_string, args1);
-  va_end(args1);
-  if (bytes_to_be_written == (size_t)-1) {
-    va_end(args2);
+  // keep a copy of the arguments in case the output doesn't fit the buffer and is formatted again
+  va_list args_copy;
+  va_copy(args_copy, args);
+  int ret = rcutils_vsnprintf(buffer, buffer_size, format_string, args);
+  if (0 > ret) {
+    va_end(args_copy);
     return NULL;
   }
-  // allocate space for the return string
-  if (bytes_to_be_written + 1 > limit) {
-    bytes_to_be_written = limit - 1;
+  size_t output_length = (size_t)ret;
+  if (output_length > limit - 1) {
+    output_length = limit - 1;
   }
-  char * output_string = allocator.allocate(bytes_to_be_written + 1, allocator.state);
-  if (NULL == output_string) {
-    va_end(args2);
-    return NULL;
+  char * output_string = buffer;
+  if (output_length >= buffer_size) {
+    output_string = allocator.allocate(output_length + 1, allocator.state);
+    if (NULL == output_string) {
+      va_end(args_copy);
+      return NULL;
+    }
+    ret = rcutils_vsnprintf(output_string, output_length + 1, format_string, args_copy);
+    if (0 > ret) {
+      allocator.deallocate(output_string, allocator.state);
+      va_end(args_copy);
+      return NULL;
+    }
   }
-  // format the string
-  int ret = rcutils_vsnprintf(output_string, bytes_to_be_written + 1, format_string, args2);
-  if (0 > ret) {
-    allocator.deallocate(output_string, allocator.state);
-    va_end(args2);
+  va_end(args_copy);
+  output_string[output_length] = '\0';
+  if (NULL != length) {
+    *length = output_length;
+  }
+  return output_string;
+}
+
+char *
+rcutils_format_string_buffer(
+  char * buffer,
+  size_t buffer_size,
+  rcutils_allocator_t allocator,
+  size_t limit,
+  size_t * length,
+  const char * format_string,
+  ...)
+{
+  va_list args;
+  va_start(args, format_string);
+  char * output_string = rcutils_vformat_string_buffer(
+    buffer, buffer_size, allocator, limit, length, format_string, args);
+  va_end(args);
+  return output_string;
+}
+
+char *
+rcutils_format_string_limit(
+  rcutils_allocator_t allocator,
+  size_t limit,
+  const char * format_string,
+  ...)
+{
+  char buffer[FORMAT_STRING_STACK_BUFFER_SIZE];
+  size_t length = 0;
+  va_list args;
+  va_start(args, format_string);
+  char * output_string = rcutils_vformat_string_buffer(
+    buffer, sizeof(buffer), allocator, limit, &length, format_string, args);
+  va_end(args);
+  if (buffer != output_string) {
+    return output_string;
+  }
+  // the output fit the stack buffer, copy it into a string of the exact length
+  output_string = allocator.allocate(length + 1, allocator.state);
+  if (NULL == output_string) {
     return NULL;
   }
-  output_string[bytes_to_be_written] = '\0';
-  va_end(args2);
+  memcpy(output_string, buffer, length + 1);
   return output_string;
 }
 
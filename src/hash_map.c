@@ -17,6 +17,9 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -30,25 +33,72 @@ extern "C"
 #include "rcutils/visibility_control.h"
 
 #define LOAD_FACTOR         (0.75)
+// The entry pointers stored inline in a bucket, which most buckets never outgrow
 #define BUCKET_INITIAL_CAP  ((size_t)2)
-
+// The number of old buckets whose entries are moved on each call with the incremental backend.
+// Growing starts once the map holds LOAD_FACTOR * capacity entries, so all the old buckets are
+// moved long before the doubled map reaches its load factor again
+#define MIGRATED_BUCKETS    ((size_t)4)
+
+// The open addressing backend keeps a control byte per slot, which is either empty, deleted,
+// or holds the low 7 bits of the hash of the entry in the slot, and probes the control bytes of
+// GROUP_WIDTH slots at once, as bytes packed in an uint64_t.
+#define GROUP_WIDTH         ((size_t)8)
+#define GROUP_LSBS          ((uint64_t)0x0101010101010101ull)
+#define GROUP_MSBS          ((uint64_t)0x8080808080808080ull)
+#define CONTROL_EMPTY       ((uint8_t)0x80)
+#define CONTROL_DELETED     ((uint8_t)0xFE)
+
+// The keys and values stored inline in the slots are aligned for any type they may be.
+typedef struct slot_alignment_s
+{
+  char c;
+  union
+  {
+    long double d;
+    uint64_t u;
+    void * p;
+  } member;
+} slot_alignment_t;
+#define SLOT_ALIGNMENT      (offsetof(slot_alignment_t, member))
+
+// An entry of the chaining backends, which is allocated along with its key and data, at the same
+// offsets as in the slots of the open addressing backend.
 typedef struct rcutils_hash_map_entry_s
 {
   size_t hashed_key;
-  void * key;
-  void * value;
 } rcutils_hash_map_entry_t;
 
 typedef struct rcutils_hash_map_impl_s
 {
+  rcutils_hash_map_backend_t backend;
   // This is the array of buckets that will store the keypairs
   rcutils_array_list_t * map;
+  // With the incremental backend, the buckets from before the map last grew, of which the first
+  // migrated ones are already moved into the map, or NULL once they all are
+  rcutils_array_list_t * old_map;
+  size_t old_capacity;
+  size_t migrated;
+  // With the open addressing backend, instead of the buckets, there is a control byte per slot
+  // followed by copies of the first GROUP_WIDTH ones, so that a group can be loaded from any slot,
+  // and the slots, each holding the hash, the key at key_offset and the data at data_offset.
+  // With the chaining backends, each entry is allocated as a slot of slot_size bytes
+  uint8_t * control;
+  uint8_t * slots;
+  size_t slot_size;
+  size_t key_offset;
+  size_t data_offset;
+  // The number of deleted slots, which are only reused once the map is rehashed
+  size_t deleted;
   size_t capacity;
   size_t size;
   size_t key_size;
   size_t data_size;
   rcutils_hash_map_key_hasher_t key_hashing_func;
   rcutils_hash_map_key_cmp_t key_cmp_func;
+  // The functions to look up keys by key views, which are NULL unless they were set
+  rcutils_hash_map_key_view_hasher_t key_view_hashing_func;
+  rcutils_hash_map_key_view_cmp_t key_view_cmp_func;
   rcutils_allocator_t allocator;
 } rcutils_hash_map_impl_t;
 
@@ -67,6 +117,85 @@ size_t rcutils_hash_map_string_hash_func(const void * key_str)
   return hash;
 }
 
+// The following is a simplified wyhash, reading the string 8 or 16 bytes at a time.
+static const uint64_t g_wyhash_secret[4] = {
+  0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+// Multiply two 64-bit values into 128 bits, setting a to the low half and b to the high half.
+static void wyhash_multiply(uint64_t * a, uint64_t * b)
+{
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = (__uint128_t)*a * *b;
+  *a = (uint64_t)product;
+  *b = (uint64_t)(product >> 64);
+#else
+  uint64_t a_high = *a >> 32, a_low = (uint32_t)*a, b_high = *b >> 32, b_low = (uint32_t)*b;
+  uint64_t high = a_high * b_high, middle_0 = a_high * b_low;
+  uint64_t middle_1 = b_high * a_low, low = a_low * b_low;
+  uint64_t t = low + (middle_0 << 32);
+  uint64_t carry = t < low;
+  uint64_t result_low = t + (middle_1 << 32);
+  carry += result_low < t;
+  *a = result_low;
+  *b = high + (middle_0 >> 32) + (middle_1 >> 32) + carry;
+#endif
+}
+
+static uint64_t wyhash_mix(uint64_t a, uint64_t b)
+{
+  wyhash_multiply(&a, &b);
+  return a ^ b;
+}
+
+// Read bytes as little endian, so that the hash is the same on every platform.
+static uint64_t wyhash_read(const unsigned char * bytes, size_t count)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < count; ++i) {
+    value |= (uint64_t)bytes[i] << (8 * i);
+  }
+  return value;
+}
+
+size_t rcutils_hash_map_string_fast_hashn(const char * string, size_t length)
+{
+  const unsigned char * bytes = (const unsigned char *)string;
+  uint64_t seed = wyhash_mix(g_wyhash_secret[0], g_wyhash_secret[1]);
+  uint64_t a = 0, b = 0;
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t middle = (length >> 3) << 2;
+      a = (wyhash_read(bytes, 4) << 32) | wyhash_read(bytes + middle, 4);
+      b = (wyhash_read(bytes + length - 4, 4) << 32) | wyhash_read(bytes + length - 4 - middle, 4);
+    } else if (length > 0) {
+      a = ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[length >> 1] << 8) | bytes[length - 1];
+    }
+  } else {
+    size_t left = length;
+    while (left > 16) {
+      seed = wyhash_mix(
+        wyhash_read(bytes, 8) ^ g_wyhash_secret[1], wyhash_read(bytes + 8, 8) ^ seed);
+      bytes += 16;
+      left -= 16;
+    }
+    // the last 16 bytes, overlapping the ones already mixed if fewer are left
+    a = wyhash_read(bytes + left - 16, 8);
+    b = wyhash_read(bytes + left - 8, 8);
+  }
+  a ^= g_wyhash_secret[1];
+  b ^= seed;
+  wyhash_multiply(&a, &b);
+  uint64_t hash = wyhash_mix(a ^ g_wyhash_secret[0] ^ (uint64_t)length, b ^ g_wyhash_secret[1]);
+  return (size_t)(hash ^ (hash >> 32));
+}
+
+size_t rcutils_hash_map_string_fast_hash_func(const void * key_str)
+{
+  const char * string = *(const char **)key_str;
+  return rcutils_hash_map_string_fast_hashn(string, strlen(string));
+}
+
 int rcutils_hash_map_string_cmp_func(const void * val1, const void * val2)
 {
   const char ** cval1 = (const char **) val1;
@@ -74,6 +203,51 @@ int rcutils_hash_map_string_cmp_func(const void * val1, const void * val2)
   return strcmp(*cval1, *cval2);
 }
 
+size_t rcutils_hash_map_string_hash_view_func(const void * key_view, size_t length)
+{
+  const char * ckey_str = (const char *) key_view;
+  size_t hash = 5381;
+
+  for (size_t i = 0; i < length; ++i) {
+    hash = ((hash << 5) + hash) + (size_t)ckey_str[i]; /* hash * 33 + c */
+  }
+
+  return hash;
+}
+
+size_t rcutils_hash_map_string_fast_hash_view_func(const void * key_view, size_t length)
+{
+  return rcutils_hash_map_string_fast_hashn((const char *) key_view, length);
+}
+
+int rcutils_hash_map_string_view_cmp_func(const void * key, const void * key_view, size_t length)
+{
+  const char * ckey = *(const char **) key;
+  int cmp = strncmp(ckey, (const char *) key_view, length);
+  if (0 != cmp) {
+    return cmp;
+  }
+  // The characters of the view may contain a null character, which ends the key early, and
+  // otherwise the key may be longer than the view
+  if (NULL != memchr(key_view, '\0', length)) {
+    return 1;
+  }
+  return '\0' == ckey[length] ? 0 : 1;
+}
+
+// Returns true if a stored key is equal to a key, or to a key view if key_view_length isn't NULL
+static bool hash_map_key_matches(
+  const rcutils_hash_map_impl_t * impl,
+  const void * stored_key,
+  const void * key,
+  const size_t * key_view_length)
+{
+  if (NULL != key_view_length) {
+    return 0 == impl->key_view_cmp_func(stored_key, key, *key_view_length);
+  }
+  return 0 == impl->key_cmp_func(stored_key, key);
+}
+
 rcutils_hash_map_t
 rcutils_get_zero_initialized_hash_map()
 {
@@ -86,7 +260,7 @@ static rcutils_ret_t hash_map_allocate_new_map(
   rcutils_array_list_t ** map, size_t capacity,
   const rcutils_allocator_t * allocator)
 {
-  *map = allocator->allocate(capacity * sizeof(rcutils_hash_map_impl_t), allocator->state);
+  *map = allocator->allocate(capacity * sizeof(rcutils_array_list_t), allocator->state);
   if (NULL == *map) {
     return RCUTILS_RET_BAD_ALLOC;
   }
@@ -100,18 +274,46 @@ static rcutils_ret_t hash_map_allocate_new_map(
   return RCUTILS_RET_OK;
 }
 
-// Deallocates the memory for a map entry
+// Deallocates the memory for a map entry, which holds its key and data
 static void hash_map_deallocate_entry(
   rcutils_allocator_t * allocator,
   rcutils_hash_map_entry_t * entry)
 {
   if (NULL != entry) {
-    allocator->deallocate(entry->key, allocator->state);
-    allocator->deallocate(entry->value, allocator->state);
     allocator->deallocate(entry, allocator->state);
   }
 }
 
+static void * hash_map_entry_key(
+  const rcutils_hash_map_impl_t * impl, const rcutils_hash_map_entry_t * entry)
+{
+  return (uint8_t *)entry + impl->key_offset;
+}
+
+static void * hash_map_entry_data(
+  const rcutils_hash_map_impl_t * impl, const rcutils_hash_map_entry_t * entry)
+{
+  return (uint8_t *)entry + impl->data_offset;
+}
+
+// Returns the entries of a bucket, which may not be initialized, and sets their number, so that
+// they can be scanned without copying them out of the bucket one at a time
+static rcutils_hash_map_entry_t ** hash_map_get_bucket_entries(
+  const rcutils_array_list_t * bucket, size_t * bucket_size)
+{
+  void * entries = NULL;
+  *bucket_size = 0;
+  if (NULL == bucket->impl ||
+    RCUTILS_RET_OK != rcutils_array_list_get_size(bucket, bucket_size) ||
+    0 == *bucket_size ||
+    RCUTILS_RET_OK != rcutils_array_list_get_ptr(bucket, 0, &entries))
+  {
+    *bucket_size = 0;
+    return NULL;
+  }
+  return entries;
+}
+
 // Deallocates an existing hashmap
 static rcutils_ret_t hash_map_deallocate_map(
   rcutils_array_list_t * map, size_t capacity,
@@ -125,13 +327,9 @@ static rcutils_ret_t hash_map_deallocate_map(
       // if selected then deallocate the memory for the actual entries as well
       if (dealloc_map_entries) {
         size_t bucket_size = 0;
-        ret = rcutils_array_list_get_size(bucket, &bucket_size);
-        for (size_t b_i = 0; b_i < bucket_size && RCUTILS_RET_OK == ret; ++b_i) {
-          rcutils_hash_map_entry_t * entry;
-          ret = rcutils_array_list_get(bucket, b_i, &entry);
-          if (RCUTILS_RET_OK == ret) {
-            hash_map_deallocate_entry(allocator, entry);
-          }
+        rcutils_hash_map_entry_t ** entries = hash_map_get_bucket_entries(bucket, &bucket_size);
+        for (size_t b_i = 0; b_i < bucket_size; ++b_i) {
+          hash_map_deallocate_entry(allocator, entries[b_i]);
         }
       }
 
@@ -162,7 +360,7 @@ static rcutils_ret_t hash_map_insert_entry(
 
   // If we have initialized this bucket yet then do so
   if (NULL == bucket->impl) {
-    ret = rcutils_array_list_init(
+    ret = rcutils_array_list_init_with_inline_capacity(
       bucket, BUCKET_INITIAL_CAP, sizeof(rcutils_hash_map_entry_t *), allocator);
   }
 
@@ -173,6 +371,110 @@ static rcutils_ret_t hash_map_insert_entry(
   return ret;
 }
 
+// Returns the bucket at a position, which is either an index into the map or, past its
+// capacity, an index into the old map
+static rcutils_array_list_t * hash_map_get_bucket(
+  const rcutils_hash_map_impl_t * impl, size_t position)
+{
+  if (position < impl->capacity) {
+    return &(impl->map[position]);
+  }
+  return &(impl->old_map[position - impl->capacity]);
+}
+
+// Moves the entries of up to count old buckets into the map, and frees the old map once they
+// have all been moved
+static rcutils_ret_t hash_map_migrate_buckets(rcutils_hash_map_impl_t * impl, size_t count)
+{
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (; impl->migrated < impl->old_capacity && count > 0; ++impl->migrated, --count) {
+    rcutils_array_list_t * bucket = &(impl->old_map[impl->migrated]);
+    if (NULL == bucket->impl) {
+      continue;
+    }
+    size_t bucket_size = 0;
+    rcutils_hash_map_entry_t ** entries = hash_map_get_bucket_entries(bucket, &bucket_size);
+    // Move the entries from the back of the bucket, so that if inserting one fails it is still
+    // in exactly one of the maps, and moving can be resumed on the next call
+    for (; bucket_size > 0 && RCUTILS_RET_OK == ret; --bucket_size) {
+      rcutils_hash_map_entry_t * entry = entries[bucket_size - 1];
+      // See the comment in hash_map_find for why we do this.
+      size_t new_index = entry->hashed_key & (impl->capacity - 1);
+      ret = hash_map_insert_entry(impl->map, new_index, entry, &impl->allocator);
+      if (RCUTILS_RET_OK == ret) {
+        ret = rcutils_array_list_remove(bucket, bucket_size - 1);
+      }
+    }
+    if (RCUTILS_RET_OK == ret) {
+      ret = rcutils_array_list_fini(bucket);
+    }
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+
+  if (NULL != impl->old_map && impl->migrated == impl->old_capacity) {
+    impl->allocator.deallocate(impl->old_map, impl->allocator.state);
+    impl->old_map = NULL;
+    impl->old_capacity = 0;
+    impl->migrated = 0;
+  }
+
+  return ret;
+}
+
+// Moves all the entries into a new array of buckets
+static rcutils_ret_t hash_map_rehash(rcutils_hash_map_t * hash_map, size_t new_capacity)
+{
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  rcutils_array_list_t * new_map = NULL;
+
+  // Entries left in the old buckets of the incremental backend are moved there first
+  if (NULL != hash_map->impl->old_map) {
+    ret = hash_map_migrate_buckets(hash_map->impl, hash_map->impl->old_capacity);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+
+  ret = hash_map_allocate_new_map(&new_map, new_capacity, &hash_map->impl->allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  for (size_t map_index = 0;
+    map_index < hash_map->impl->capacity && RCUTILS_RET_OK == ret;
+    ++map_index)
+  {
+    size_t bucket_size = 0;
+    rcutils_hash_map_entry_t ** entries =
+      hash_map_get_bucket_entries(&(hash_map->impl->map[map_index]), &bucket_size);
+    for (size_t bucket_index = 0;
+      bucket_index < bucket_size && RCUTILS_RET_OK == ret;
+      ++bucket_index)
+    {
+      size_t new_index = entries[bucket_index]->hashed_key % new_capacity;
+      ret = hash_map_insert_entry(
+        new_map, new_index, entries[bucket_index], &hash_map->impl->allocator);
+    }
+  }
+
+  // Something went wrong above after we allocated the new map. Try to clean it up
+  if (RCUTILS_RET_OK != ret) {
+    hash_map_deallocate_map(new_map, new_capacity, &hash_map->impl->allocator, false);
+    return ret;
+  }
+
+  // Cleanup the old map and swap in the new one
+  ret = hash_map_deallocate_map(
+    hash_map->impl->map, hash_map->impl->capacity, &hash_map->impl->allocator, false);
+  // everything worked up to this point, so if we fail to dealloc the old map still set the new
+  hash_map->impl->map = new_map;
+  hash_map->impl->capacity = new_capacity;
+
+  return ret;
+}
+
 // Checks if map is already past its load factor and grows it if so
 static rcutils_ret_t hash_map_check_and_grow_map(rcutils_hash_map_t * hash_map)
 {
@@ -181,48 +483,26 @@ static rcutils_ret_t hash_map_check_and_grow_map(rcutils_hash_map_t * hash_map)
     size_t new_capacity = 2 * hash_map->impl->capacity;
     rcutils_array_list_t * new_map = NULL;
 
-    ret = hash_map_allocate_new_map(&new_map, new_capacity, &hash_map->impl->allocator);
-    if (RCUTILS_RET_OK != ret) {
-      return ret;
+    if (RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL != hash_map->impl->backend) {
+      return hash_map_rehash(hash_map, new_capacity);
     }
 
-    for (size_t map_index = 0;
-      map_index < hash_map->impl->capacity && RCUTILS_RET_OK == ret;
-      ++map_index)
-    {
-      rcutils_array_list_t * bucket = &(hash_map->impl->map[map_index]);
-      // Is this a valid bucket with entries
-      if (NULL != bucket->impl) {
-        size_t bucket_size = 0;
-        ret = rcutils_array_list_get_size(bucket, &bucket_size);
-        if (RCUTILS_RET_OK != ret) {
-          return ret;
-        }
-
-        for (size_t bucket_index = 0;
-          bucket_index < bucket_size && RCUTILS_RET_OK == ret;
-          ++bucket_index)
-        {
-          rcutils_hash_map_entry_t * entry = NULL;
-          ret = rcutils_array_list_get(bucket, bucket_index, &entry);
-          if (RCUTILS_RET_OK == ret) {
-            size_t new_index = entry->hashed_key % new_capacity;
-            ret = hash_map_insert_entry(new_map, new_index, entry, &hash_map->impl->allocator);
-          }
-        }
-      }
+    // There is only room for one old map, so finish moving the entries of the previous one,
+    // which is only left if moving them failed before
+    ret = hash_map_migrate_buckets(hash_map->impl, hash_map->impl->old_capacity);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
     }
 
-    // Something went wrong above after we allocated the new map. Try to clean it up
+    ret = hash_map_allocate_new_map(&new_map, new_capacity, &hash_map->impl->allocator);
     if (RCUTILS_RET_OK != ret) {
-      hash_map_deallocate_map(new_map, new_capacity, &hash_map->impl->allocator, false);
       return ret;
     }
 
-    // Cleanup the old map and swap in the new one
-    ret = hash_map_deallocate_map(
-      hash_map->impl->map, hash_map->impl->capacity, &hash_map->impl->allocator, false);
-    // everything worked up to this point, so if we fail to dealloc the old map still set the new
+    // Keep the old buckets until their entries are moved by the following calls
+    hash_map->impl->old_map = hash_map->impl->map;
+    hash_map->impl->old_capacity = hash_map->impl->capacity;
+    hash_map->impl->migrated = 0;
     hash_map->impl->map = new_map;
     hash_map->impl->capacity = new_capacity;
   }
@@ -243,6 +523,263 @@ static size_t next_power_of_two(size_t v)
   return v > 1 ? v : 1;
 }
 
+static size_t align_up(size_t size, size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// Spreads the bits of the hash, so that poor hashes, e.g. of consecutive integers, still use
+// both the bits selecting the first group to probe and those stored in the control bytes.
+static size_t open_addressing_mix_hash(size_t hash)
+{
+  uint64_t mixed = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+  return (size_t)(mixed ^ (mixed >> 32));
+}
+
+// Load the control bytes of a group, the first one in the lowest byte.
+static uint64_t open_addressing_load_group(const uint8_t * control)
+{
+  uint64_t group = 0;
+  for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+    group |= (uint64_t)control[i] << (8 * i);
+  }
+  return group;
+}
+
+// The following return a mask with the high bit set in the bytes of the group that match.
+// Matching the low bits of a hash may also set the bit of a byte next to a matching one, which
+// is harmless since the hash and key of the entry are compared afterwards.
+static uint64_t open_addressing_match_hash(uint64_t group, uint8_t hash_bits)
+{
+  uint64_t x = group ^ (GROUP_LSBS * hash_bits);
+  return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+}
+
+static uint64_t open_addressing_match_empty(uint64_t group)
+{
+  // of empty and deleted, only empty has the second lowest bit unset
+  return group & (~group << 6) & GROUP_MSBS;
+}
+
+static uint64_t open_addressing_match_empty_or_deleted(uint64_t group)
+{
+  return group & GROUP_MSBS;
+}
+
+// Return the index in the group of the lowest byte set in a match.
+static size_t open_addressing_lowest_match(uint64_t match)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (size_t)__builtin_ctzll(match) / 8;
+#else
+  size_t index = 0;
+  while (0 == (match & 0x80)) {
+    match >>= 8;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+// Empty and deleted slots have the high bit of their control byte set, full ones don't.
+static bool open_addressing_is_full(uint8_t control)
+{
+  return 0 == (control & 0x80);
+}
+
+static uint8_t * open_addressing_slot(const rcutils_hash_map_impl_t * impl, size_t index)
+{
+  return impl->slots + index * impl->slot_size;
+}
+
+static size_t open_addressing_slot_hash(const rcutils_hash_map_impl_t * impl, size_t index)
+{
+  size_t hash;
+  memcpy(&hash, open_addressing_slot(impl, index), sizeof(hash));
+  return hash;
+}
+
+static void open_addressing_set_control(
+  uint8_t * control, size_t capacity, size_t index, uint8_t value)
+{
+  control[index] = value;
+  if (index < GROUP_WIDTH) {
+    control[capacity + index] = value;
+  }
+}
+
+// The number of entries and deleted slots above which the map is rehashed, leaving an eighth of
+// the slots empty so that probing stays short and always ends on an empty slot.
+static size_t open_addressing_growth_limit(size_t capacity)
+{
+  return capacity - capacity / 8;
+}
+
+// Find the slot of a key, probing the groups in a triangular sequence which visits all of them.
+// The key is a key view of *key_view_length characters if key_view_length isn't NULL.
+static bool open_addressing_find(
+  const rcutils_hash_map_impl_t * impl,
+  const void * key,
+  const size_t * key_view_length,
+  size_t hash,
+  size_t * index)
+{
+  size_t mask = impl->capacity - 1;
+  uint8_t hash_bits = (uint8_t)(hash & 0x7F);
+  size_t position = (hash >> 7) & mask;
+  for (size_t stride = 0; stride <= impl->capacity; ) {
+    uint64_t group = open_addressing_load_group(&impl->control[position]);
+    for (uint64_t match = open_addressing_match_hash(group, hash_bits); 0 != match;
+      match &= match - 1)
+    {
+      size_t i = (position + open_addressing_lowest_match(match)) & mask;
+      if (open_addressing_slot_hash(impl, i) == hash &&
+        hash_map_key_matches(
+          impl, open_addressing_slot(impl, i) + impl->key_offset, key, key_view_length))
+      {
+        *index = i;
+        return true;
+      }
+    }
+    if (0 != open_addressing_match_empty(group)) {
+      return false;
+    }
+    stride += GROUP_WIDTH;
+    position = (position + stride) & mask;
+  }
+  return false;
+}
+
+// Find the first empty or deleted slot in the probe sequence of a hash.
+static size_t open_addressing_find_free_slot(
+  const uint8_t * control, size_t capacity, size_t hash)
+{
+  size_t mask = capacity - 1;
+  size_t position = (hash >> 7) & mask;
+  size_t stride = 0;
+  uint64_t match = open_addressing_match_empty_or_deleted(
+    open_addressing_load_group(&control[position]));
+  while (0 == match) {
+    stride += GROUP_WIDTH;
+    position = (position + stride) & mask;
+    match = open_addressing_match_empty_or_deleted(open_addressing_load_group(&control[position]));
+  }
+  return (position + open_addressing_lowest_match(match)) & mask;
+}
+
+static rcutils_ret_t open_addressing_allocate(
+  size_t capacity, size_t slot_size, uint8_t ** control, uint8_t ** slots,
+  rcutils_allocator_t * allocator)
+{
+  *control = allocator->allocate(capacity + GROUP_WIDTH, allocator->state);
+  *slots = allocator->allocate(capacity * slot_size, allocator->state);
+  if (NULL == *control || NULL == *slots) {
+    allocator->deallocate(*control, allocator->state);
+    allocator->deallocate(*slots, allocator->state);
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  memset(*control, CONTROL_EMPTY, capacity + GROUP_WIDTH);
+  return RCUTILS_RET_OK;
+}
+
+// Move the entries into new slots, which also drops the deleted slots.
+static rcutils_ret_t open_addressing_rehash(rcutils_hash_map_impl_t * impl, size_t new_capacity)
+{
+  uint8_t * new_control = NULL;
+  uint8_t * new_slots = NULL;
+  rcutils_ret_t ret = open_addressing_allocate(
+    new_capacity, impl->slot_size, &new_control, &new_slots, &impl->allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  for (size_t i = 0; i < impl->capacity; ++i) {
+    if (open_addressing_is_full(impl->control[i])) {
+      size_t new_index = open_addressing_find_free_slot(
+        new_control, new_capacity, open_addressing_slot_hash(impl, i));
+      open_addressing_set_control(new_control, new_capacity, new_index, impl->control[i]);
+      memcpy(
+        new_slots + new_index * impl->slot_size, open_addressing_slot(impl, i), impl->slot_size);
+    }
+  }
+  impl->allocator.deallocate(impl->control, impl->allocator.state);
+  impl->allocator.deallocate(impl->slots, impl->allocator.state);
+  impl->control = new_control;
+  impl->slots = new_slots;
+  impl->capacity = new_capacity;
+  impl->deleted = 0;
+  return RCUTILS_RET_OK;
+}
+
+// Set a key value pair, given the mixed hash of the key.
+static rcutils_ret_t open_addressing_set_hashed(
+  rcutils_hash_map_impl_t * impl, const void * key, size_t hash, const void * value)
+{
+  size_t index = 0;
+  if (open_addressing_find(impl, key, NULL, hash, &index)) {
+    memcpy(open_addressing_slot(impl, index) + impl->data_offset, value, impl->data_size);
+    return RCUTILS_RET_OK;
+  }
+
+  if (impl->size + impl->deleted >= open_addressing_growth_limit(impl->capacity)) {
+    // Grow the map if more than half of the slots are used, else getting rid of the deleted
+    // slots leaves room for at least 3/8 of the capacity in new entries before the next rehash
+    size_t new_capacity = impl->capacity;
+    if (impl->size > impl->capacity / 2) {
+      new_capacity *= 2;
+    }
+    rcutils_ret_t ret = open_addressing_rehash(impl, new_capacity);
+    // The map can continue to operate with degraded performance, as long as a slot stays empty
+    if (RCUTILS_RET_OK != ret) {
+      if (impl->capacity - impl->size - impl->deleted <= 1) {
+        RCUTILS_SET_ERROR_MSG("failed to grow the full hash map");
+        return ret;
+      }
+      RCUTILS_LOG_ERROR("Failed to grow hash_map. Reason: %d", ret);
+    }
+  }
+
+  index = open_addressing_find_free_slot(impl->control, impl->capacity, hash);
+  if (CONTROL_DELETED == impl->control[index]) {
+    impl->deleted--;
+  }
+  open_addressing_set_control(impl->control, impl->capacity, index, (uint8_t)(hash & 0x7F));
+  uint8_t * slot = open_addressing_slot(impl, index);
+  memcpy(slot, &hash, sizeof(hash));
+  memcpy(slot + impl->key_offset, key, impl->key_size);
+  memcpy(slot + impl->data_offset, value, impl->data_size);
+  impl->size++;
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t open_addressing_set(
+  rcutils_hash_map_impl_t * impl, const void * key, const void * value)
+{
+  return open_addressing_set_hashed(
+    impl, key, open_addressing_mix_hash(impl->key_hashing_func(key)), value);
+}
+
+// Unset a key, given its mixed hash.
+static void open_addressing_unset_hashed(
+  rcutils_hash_map_impl_t * impl, const void * key, size_t hash)
+{
+  size_t index = 0;
+  if (open_addressing_find(impl, key, NULL, hash, &index)) {
+    open_addressing_set_control(impl->control, impl->capacity, index, CONTROL_DELETED);
+    impl->deleted++;
+    impl->size--;
+  }
+}
+
+static rcutils_ret_t open_addressing_init(rcutils_hash_map_impl_t * impl)
+{
+  impl->deleted = 0;
+  if (impl->capacity < GROUP_WIDTH) {
+    impl->capacity = GROUP_WIDTH;
+  }
+  return open_addressing_allocate(
+    impl->capacity, impl->slot_size, &impl->control, &impl->slots, &impl->allocator);
+}
+
 rcutils_ret_t
 rcutils_hash_map_init(
   rcutils_hash_map_t * hash_map,
@@ -252,6 +789,22 @@ rcutils_hash_map_init(
   rcutils_hash_map_key_hasher_t key_hashing_func,
   rcutils_hash_map_key_cmp_t key_cmp_func,
   const rcutils_allocator_t * allocator)
+{
+  return rcutils_hash_map_init_with_backend(
+    hash_map, initial_capacity, key_size, data_size, key_hashing_func, key_cmp_func,
+    RCUTILS_HASH_MAP_BACKEND_CHAINING, allocator);
+}
+
+rcutils_ret_t
+rcutils_hash_map_init_with_backend(
+  rcutils_hash_map_t * hash_map,
+  size_t initial_capacity,
+  size_t key_size,
+  size_t data_size,
+  rcutils_hash_map_key_hasher_t key_hashing_func,
+  rcutils_hash_map_key_cmp_t key_cmp_func,
+  rcutils_hash_map_backend_t backend,
+  const rcutils_allocator_t * allocator)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(hash_map, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(key_hashing_func, RCUTILS_RET_INVALID_ARGUMENT);
@@ -266,6 +819,13 @@ rcutils_hash_map_init(
   } else if (1 > data_size) {
     RCUTILS_SET_ERROR_MSG("data_size cannot be less than 1");
     return RCUTILS_RET_INVALID_ARGUMENT;
+  } else if (
+    RCUTILS_HASH_MAP_BACKEND_CHAINING != backend &&
+    RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING != backend &&
+    RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL != backend)
+  {
+    RCUTILS_SET_ERROR_MSG("backend is not a valid hash map backend");
+    return RCUTILS_RET_INVALID_ARGUMENT;
   }
 
   // Due to an optimization we use during lookup, the capacity must be a power-of-two.
@@ -280,14 +840,35 @@ rcutils_hash_map_init(
     return RCUTILS_RET_BAD_ALLOC;
   }
 
+  hash_map->impl->backend = backend;
+  hash_map->impl->map = NULL;
+  hash_map->impl->old_map = NULL;
+  hash_map->impl->old_capacity = 0;
+  hash_map->impl->migrated = 0;
+  hash_map->impl->control = NULL;
+  hash_map->impl->slots = NULL;
   hash_map->impl->capacity = initial_capacity;
   hash_map->impl->size = 0;
   hash_map->impl->key_size = key_size;
   hash_map->impl->data_size = data_size;
   hash_map->impl->key_hashing_func = key_hashing_func;
   hash_map->impl->key_cmp_func = key_cmp_func;
+  hash_map->impl->key_view_hashing_func = NULL;
+  hash_map->impl->key_view_cmp_func = NULL;
+  // The slots of the open addressing backend and the entries of the chaining backends hold the
+  // hash followed by the key and the data, so that an entry takes a single allocation
+  hash_map->impl->key_offset = align_up(sizeof(rcutils_hash_map_entry_t), SLOT_ALIGNMENT);
+  hash_map->impl->data_offset = align_up(
+    hash_map->impl->key_offset + key_size, SLOT_ALIGNMENT);
+  hash_map->impl->slot_size = align_up(hash_map->impl->data_offset + data_size, SLOT_ALIGNMENT);
 
-  rcutils_ret_t ret = hash_map_allocate_new_map(&hash_map->impl->map, initial_capacity, allocator);
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == backend) {
+    hash_map->impl->allocator = *allocator;
+    ret = open_addressing_init(hash_map->impl);
+  } else {
+    ret = hash_map_allocate_new_map(&hash_map->impl->map, initial_capacity, allocator);
+  }
   if (RCUTILS_RET_OK != ret) {
     // Cleanup allocated memory before we return failure
     allocator->deallocate(hash_map->impl, allocator->state);
@@ -305,8 +886,19 @@ rcutils_ret_t
 rcutils_hash_map_fini(rcutils_hash_map_t * hash_map)
 {
   HASH_MAP_VALIDATE_HASH_MAP(hash_map);
-  rcutils_ret_t ret = hash_map_deallocate_map(
-    hash_map->impl->map, hash_map->impl->capacity, &hash_map->impl->allocator, true);
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+    hash_map->impl->allocator.deallocate(hash_map->impl->control, hash_map->impl->allocator.state);
+    hash_map->impl->allocator.deallocate(hash_map->impl->slots, hash_map->impl->allocator.state);
+  } else {
+    ret = hash_map_deallocate_map(
+      hash_map->impl->map, hash_map->impl->capacity, &hash_map->impl->allocator, true);
+    if (RCUTILS_RET_OK == ret && NULL != hash_map->impl->old_map) {
+      ret = hash_map_deallocate_map(
+        hash_map->impl->old_map, hash_map->impl->old_capacity, &hash_map->impl->allocator, true);
+      hash_map->impl->old_map = NULL;
+    }
+  }
 
   if (RCUTILS_RET_OK == ret) {
     hash_map->impl->allocator.deallocate(hash_map->impl, hash_map->impl->allocator.state);
@@ -334,44 +926,118 @@ rcutils_hash_map_get_size(const rcutils_hash_map_t * hash_map, size_t * size)
   return RCUTILS_RET_OK;
 }
 
-/// Returns true if found or false if it doesn't exist.
-/// key_hash and map_index will always be set correctly
-static bool hash_map_find(
-  const rcutils_hash_map_t * hash_map,   // [in] The hash_map to look up in
-  const void * key,   // [in] The key to lookup
-  size_t * key_hash,   // [out] The key's hashed value
-  size_t * map_index,   // [out] The index into the array of buckets
-  size_t * bucket_index,   // [out] The index of the entry in its bucket
-  rcutils_hash_map_entry_t ** entry)   // [out] Will be set to a pointer to the entry's data
+// Adds the sizes of the array of buckets, of the buckets and of their entries
+static rcutils_ret_t hash_map_add_allocated_size(
+  const rcutils_hash_map_impl_t * impl, const rcutils_array_list_t * map, size_t capacity,
+  size_t * allocated_size)
 {
-  size_t bucket_size = 0;
-  rcutils_hash_map_entry_t * bucket_entry = NULL;
+  *allocated_size += capacity * sizeof(rcutils_array_list_t);
+  for (size_t i = 0; i < capacity; ++i) {
+    if (NULL == map[i].impl) {
+      continue;
+    }
+    size_t bucket_allocated_size = 0;
+    size_t bucket_size = 0;
+    rcutils_ret_t ret = rcutils_array_list_get_allocated_size(&map[i], &bucket_allocated_size);
+    if (RCUTILS_RET_OK == ret) {
+      ret = rcutils_array_list_get_size(&map[i], &bucket_size);
+    }
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+    *allocated_size += bucket_allocated_size + bucket_size * impl->slot_size;
+  }
+  return RCUTILS_RET_OK;
+}
 
-  *key_hash = hash_map->impl->key_hashing_func(key);
-  // The below is equivalent to:
-  //
-  // *map_index = (*key_hash) % hash_map->impl->capacity;
-  //
-  // This implementation is significantly faster since it avoids a divide, but
-  // only works when the capacity is a power of two.  We enforce that in the
-  // rcutils_hash_map_init() function.
-  *map_index = (*key_hash) & (hash_map->impl->capacity - 1);
+rcutils_ret_t
+rcutils_hash_map_get_allocated_size(const rcutils_hash_map_t * hash_map, size_t * allocated_size)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocated_size, RCUTILS_RET_INVALID_ARGUMENT);
+  const rcutils_hash_map_impl_t * impl = hash_map->impl;
+  size_t size = sizeof(rcutils_hash_map_impl_t);
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == impl->backend) {
+    size += impl->capacity + GROUP_WIDTH + impl->capacity * impl->slot_size;
+  } else {
+    rcutils_ret_t ret = hash_map_add_allocated_size(impl, impl->map, impl->capacity, &size);
+    if (RCUTILS_RET_OK == ret && NULL != impl->old_map) {
+      ret = hash_map_add_allocated_size(impl, impl->old_map, impl->old_capacity, &size);
+    }
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+  *allocated_size = size;
+  return RCUTILS_RET_OK;
+}
 
-  // Find the bucket the entry should be in check that it's valid
-  rcutils_array_list_t * bucket = &(hash_map->impl->map[*map_index]);
-  if (NULL == bucket->impl) {
-    return false;
+rcutils_ret_t
+rcutils_hash_map_shrink_to_fit(rcutils_hash_map_t * hash_map)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  rcutils_hash_map_impl_t * impl = hash_map->impl;
+
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == impl->backend) {
+    // The smallest capacity holding the entries without growing, which also drops the deleted
+    // slots
+    size_t new_capacity = GROUP_WIDTH;
+    while (impl->size >= open_addressing_growth_limit(new_capacity)) {
+      new_capacity *= 2;
+    }
+    if (new_capacity >= impl->capacity && 0 == impl->deleted) {
+      return RCUTILS_RET_OK;
+    }
+    return open_addressing_rehash(impl, new_capacity);
   }
-  if (RCUTILS_RET_OK != rcutils_array_list_get_size(bucket, &bucket_size)) {
-    return false;
+
+  // The smallest capacity holding the entries without growing, where entries left in the old
+  // buckets of the incremental backend are moved along
+  size_t new_capacity = 1;
+  while (impl->size >= (size_t)(LOAD_FACTOR * (double)new_capacity)) {
+    new_capacity *= 2;
   }
-  for (size_t i = 0; i < bucket_size; ++i) {
-    if (RCUTILS_RET_OK != rcutils_array_list_get(bucket, i, &bucket_entry)) {
-      return false;
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (new_capacity < impl->capacity) {
+    ret = hash_map_rehash(hash_map, new_capacity);
+  } else if (NULL != impl->old_map) {
+    ret = hash_map_migrate_buckets(impl, impl->old_capacity);
+  }
+  // The buckets left empty by removed entries are freed, the others shrunk
+  for (size_t i = 0; i < impl->capacity && RCUTILS_RET_OK == ret; ++i) {
+    rcutils_array_list_t * bucket = &(impl->map[i]);
+    if (NULL == bucket->impl) {
+      continue;
     }
+    size_t bucket_size = 0;
+    ret = rcutils_array_list_get_size(bucket, &bucket_size);
+    if (RCUTILS_RET_OK == ret) {
+      ret = 0 == bucket_size ?
+        rcutils_array_list_fini(bucket) : rcutils_array_list_shrink_to_fit(bucket);
+    }
+  }
+  return ret;
+}
+
+/// Returns true if the entry is in the bucket, which may not be initialized, or false otherwise.
+static bool hash_map_find_in_bucket(
+  const rcutils_hash_map_t * hash_map,
+  const rcutils_array_list_t * bucket,
+  const void * key,
+  const size_t * key_view_length,
+  size_t key_hash,
+  size_t * bucket_index,
+  rcutils_hash_map_entry_t ** entry)
+{
+  size_t bucket_size = 0;
+  rcutils_hash_map_entry_t ** entries = hash_map_get_bucket_entries(bucket, &bucket_size);
+
+  for (size_t i = 0; i < bucket_size; ++i) {
+    rcutils_hash_map_entry_t * bucket_entry = entries[i];
     // Check that the hashes match first as that will be the quicker comparison to quick fail on
-    if (bucket_entry->hashed_key == *key_hash &&
-      (0 == hash_map->impl->key_cmp_func(bucket_entry->key, key)))
+    if (bucket_entry->hashed_key == key_hash &&
+      hash_map_key_matches(
+        hash_map->impl, hash_map_entry_key(hash_map->impl, bucket_entry), key, key_view_length))
     {
       *bucket_index = i;
       *entry = bucket_entry;
@@ -382,48 +1048,95 @@ static bool hash_map_find(
   return false;
 }
 
-rcutils_ret_t
-rcutils_hash_map_set(rcutils_hash_map_t * hash_map, const void * key, const void * value)
+/// Returns true if found or false if it doesn't exist, given the key's hashed value.
+/// map_index will always be set correctly
+static bool hash_map_find_hashed(
+  const rcutils_hash_map_t * hash_map,   // [in] The hash_map to look up in
+  const void * key,   // [in] The key to lookup
+  const size_t * key_view_length,   // [in] The length of the key if it is a key view, or NULL
+  size_t key_hash,   // [in] The key's hashed value
+  size_t * map_index,   // [out] The position of the bucket, see hash_map_get_bucket
+  size_t * bucket_index,   // [out] The index of the entry in its bucket
+  rcutils_hash_map_entry_t ** entry)   // [out] Will be set to a pointer to the entry's data
 {
-  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
+  // The below is equivalent to:
+  //
+  // *map_index = key_hash % hash_map->impl->capacity;
+  //
+  // This implementation is significantly faster since it avoids a divide, but
+  // only works when the capacity is a power of two.  We enforce that in the
+  // rcutils_hash_map_init() function.
+  *map_index = key_hash & (hash_map->impl->capacity - 1);
+
+  if (hash_map_find_in_bucket(
+      hash_map, &(hash_map->impl->map[*map_index]), key, key_view_length, key_hash,
+      bucket_index, entry))
+  {
+    return true;
+  }
+
+  // While the map grows incrementally, the entry may also still be in its old bucket
+  if (NULL != hash_map->impl->old_map) {
+    size_t old_index = key_hash & (hash_map->impl->old_capacity - 1);
+    if (hash_map_find_in_bucket(
+        hash_map, &(hash_map->impl->old_map[old_index]), key, key_view_length, key_hash,
+        bucket_index, entry))
+    {
+      *map_index = hash_map->impl->capacity + old_index;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/// Returns true if found or false if it doesn't exist.
+/// key_hash and map_index will always be set correctly
+static bool hash_map_find(
+  const rcutils_hash_map_t * hash_map,   // [in] The hash_map to look up in
+  const void * key,   // [in] The key to lookup
+  size_t * key_hash,   // [out] The key's hashed value
+  size_t * map_index,   // [out] The position of the bucket, see hash_map_get_bucket
+  size_t * bucket_index,   // [out] The index of the entry in its bucket
+  rcutils_hash_map_entry_t ** entry)   // [out] Will be set to a pointer to the entry's data
+{
+  *key_hash = hash_map->impl->key_hashing_func(key);
+  return hash_map_find_hashed(
+    hash_map, key, NULL, *key_hash, map_index, bucket_index, entry);
+}
 
-  size_t key_hash = 0, map_index = 0, bucket_index = 0;
+// Sets a key value pair with the chaining backends, given the key's hashed value
+static rcutils_ret_t hash_map_set_hashed(
+  rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, const void * value)
+{
+  size_t map_index = 0, bucket_index = 0;
   bool already_exists = false;
   rcutils_hash_map_entry_t * entry = NULL;
   rcutils_ret_t ret = RCUTILS_RET_OK;
 
-  already_exists = hash_map_find(hash_map, key, &key_hash, &map_index, &bucket_index, &entry);
-
+  already_exists = hash_map_find_hashed(
+    hash_map, key, NULL, key_hash, &map_index, &bucket_index, &entry);
   if (already_exists) {
     // Just update the existing value to match the new value
-    memcpy(entry->value, value, hash_map->impl->data_size);
+    memcpy(hash_map_entry_data(hash_map->impl, entry), value, hash_map->impl->data_size);
   } else {
     // We need to create a new entry in the map
     rcutils_allocator_t * allocator = &hash_map->impl->allocator;
 
-    // Start by trying to allocate the memory we need for the new entry
-    entry = allocator->allocate(sizeof(rcutils_hash_map_entry_t), allocator->state);
+    // Start by trying to allocate the memory we need for the new entry, its key and data
+    entry = allocator->allocate(hash_map->impl->slot_size, allocator->state);
     if (NULL == entry) {
       return RCUTILS_RET_BAD_ALLOC;
     }
-    entry->key = allocator->allocate(hash_map->impl->key_size, allocator->state);
-    entry->value = allocator->allocate(hash_map->impl->data_size, allocator->state);
-    if (NULL == entry->key || NULL == entry->value) {
-      ret = RCUTILS_RET_BAD_ALLOC;
-    }
 
     // Set the entry data and try to insert into the bucket
-    if (RCUTILS_RET_OK == ret) {
-      entry->hashed_key = key_hash;
-      memcpy(entry->value, value, hash_map->impl->data_size);
-      memcpy(entry->key, key, hash_map->impl->key_size);
+    entry->hashed_key = key_hash;
+    memcpy(hash_map_entry_data(hash_map->impl, entry), value, hash_map->impl->data_size);
+    memcpy(hash_map_entry_key(hash_map->impl, entry), key, hash_map->impl->key_size);
 
-      // See the comment in hash_map_find for why we do this.
-      bucket_index = key_hash & (hash_map->impl->capacity - 1);
-      ret = hash_map_insert_entry(hash_map->impl->map, bucket_index, entry, allocator);
-    }
+    // See the comment in hash_map_find for why we do this.
+    bucket_index = key_hash & (hash_map->impl->capacity - 1);
+    ret = hash_map_insert_entry(hash_map->impl->map, bucket_index, entry, allocator);
 
     if (RCUTILS_RET_OK != ret) {
       // If something went wrong somewhere then cleanup the memory we've allocated
@@ -433,6 +1146,13 @@ rcutils_hash_map_set(rcutils_hash_map_t * hash_map, const void * key, const void
     hash_map->impl->size++;
   }
 
+  if (NULL != hash_map->impl->old_map) {
+    ret = hash_map_migrate_buckets(hash_map->impl, MIGRATED_BUCKETS);
+    // The entries which could not be moved are still found in the old map
+    RCUTILS_LOG_ERROR_EXPRESSION(
+      RCUTILS_RET_OK != ret, "Failed to move hash_map entries. Reason: %d", ret);
+  }
+
   // Time to check if we've exceeded our Load Factor and grow the map if so
   ret = hash_map_check_and_grow_map(hash_map);
   // Just log on this failure because the map can continue to operate with degraded performance
@@ -442,37 +1162,266 @@ rcutils_hash_map_set(rcutils_hash_map_t * hash_map, const void * key, const void
 }
 
 rcutils_ret_t
-rcutils_hash_map_unset(rcutils_hash_map_t * hash_map, const void * key)
+rcutils_hash_map_set(rcutils_hash_map_t * hash_map, const void * key, const void * value)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+    return open_addressing_set(hash_map->impl, key, value);
+  }
+
+  return hash_map_set_hashed(hash_map, key, hash_map->impl->key_hashing_func(key), value);
+}
+
+rcutils_ret_t
+rcutils_hash_map_set_with_hash(
+  rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, const void * value)
 {
   HASH_MAP_VALIDATE_HASH_MAP(hash_map);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+    return open_addressing_set_hashed(
+      hash_map->impl, key, open_addressing_mix_hash(key_hash), value);
+  }
+
+  return hash_map_set_hashed(hash_map, key, key_hash, value);
+}
+
+// The smallest capacity holding a number of entries without growing, or 0 if there is none
+static size_t hash_map_capacity_for(rcutils_hash_map_backend_t backend, size_t count)
+{
+  size_t capacity = 1;
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == backend) {
+    capacity = GROUP_WIDTH;
+    while (open_addressing_growth_limit(capacity) < count && capacity <= SIZE_MAX / 2) {
+      capacity *= 2;
+    }
+    return open_addressing_growth_limit(capacity) < count ? 0 : capacity;
+  }
+  while ((size_t)(LOAD_FACTOR * (double)capacity) <= count && capacity <= SIZE_MAX / 2) {
+    capacity *= 2;
+  }
+  return (size_t)(LOAD_FACTOR * (double)capacity) <= count ? 0 : capacity;
+}
+
+rcutils_ret_t
+rcutils_hash_map_reserve(rcutils_hash_map_t * hash_map, size_t count)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  rcutils_hash_map_impl_t * impl = hash_map->impl;
+
+  size_t capacity = hash_map_capacity_for(impl->backend, count);
+  if (0 == capacity) {
+    RCUTILS_SET_ERROR_MSG("too many entries to reserve");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == impl->backend) {
+    // The deleted slots are only reused once the map is rehashed, so drop them as well
+    if (capacity > impl->capacity ||
+      impl->deleted + count > open_addressing_growth_limit(impl->capacity))
+    {
+      ret = open_addressing_rehash(impl, capacity > impl->capacity ? capacity : impl->capacity);
+    }
+  } else if (capacity > impl->capacity) {
+    ret = hash_map_rehash(hash_map, capacity);
+  }
+  if (RCUTILS_RET_OK != ret) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for the reserved entries");
+  }
+  return ret;
+}
 
-  size_t key_hash = 0, map_index = 0, bucket_index = 0;
+// A key to set with rcutils_hash_map_set_many(), with the position of its bucket or group
+typedef struct hash_map_bulk_entry_s
+{
+  size_t position;
+  size_t hash;
+  size_t index;
+} hash_map_bulk_entry_t;
+
+static int hash_map_bulk_entry_cmp(const void * val1, const void * val2)
+{
+  const hash_map_bulk_entry_t * entry1 = val1;
+  const hash_map_bulk_entry_t * entry2 = val2;
+  if (entry1->position != entry2->position) {
+    return entry1->position < entry2->position ? -1 : 1;
+  }
+  // Keep the order of the keys in a bucket, so that the last value of a repeated key is kept
+  return entry1->index < entry2->index ? -1 : (entry1->index > entry2->index ? 1 : 0);
+}
+
+rcutils_ret_t
+rcutils_hash_map_set_many(
+  rcutils_hash_map_t * hash_map,
+  const void * keys,
+  const void * values,
+  size_t count)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(keys, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(values, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_hash_map_impl_t * impl = hash_map->impl;
+  if (0 == count) {
+    return RCUTILS_RET_OK;
+  }
+  if (count > SIZE_MAX / sizeof(hash_map_bulk_entry_t) || count > SIZE_MAX - impl->size) {
+    RCUTILS_SET_ERROR_MSG("too many entries to set");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  // Make room for all the keys first, as the positions of their buckets depend on the capacity
+  rcutils_ret_t ret = rcutils_hash_map_reserve(hash_map, impl->size + count);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  hash_map_bulk_entry_t * entries =
+    impl->allocator.allocate(count * sizeof(hash_map_bulk_entry_t), impl->allocator.state);
+  if (NULL == entries) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for the entries to set");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  const uint8_t * key_bytes = keys;
+  const uint8_t * value_bytes = values;
+  bool open_addressing = RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == impl->backend;
+  for (size_t i = 0; i < count; ++i) {
+    size_t hash = impl->key_hashing_func(key_bytes + i * impl->key_size);
+    // See the comment in hash_map_find for why we do this.
+    if (open_addressing) {
+      hash = open_addressing_mix_hash(hash);
+      entries[i].position = (hash >> 7) & (impl->capacity - 1);
+    } else {
+      entries[i].position = hash & (impl->capacity - 1);
+    }
+    entries[i].hash = hash;
+    entries[i].index = i;
+  }
+
+  // Setting the keys in the order of their buckets walks through the map only once
+  qsort(entries, count, sizeof(hash_map_bulk_entry_t), hash_map_bulk_entry_cmp);
+
+  for (size_t i = 0; i < count && RCUTILS_RET_OK == ret; ++i) {
+    const void * key = key_bytes + entries[i].index * impl->key_size;
+    const void * value = value_bytes + entries[i].index * impl->data_size;
+    if (open_addressing) {
+      ret = open_addressing_set_hashed(impl, key, entries[i].hash, value);
+    } else {
+      ret = hash_map_set_hashed(hash_map, key, entries[i].hash, value);
+    }
+  }
+
+  impl->allocator.deallocate(entries, impl->allocator.state);
+  return ret;
+}
+
+// Unsets a key of a non empty hash_map, given the key's hashed value
+static void hash_map_unset_hashed(rcutils_hash_map_t * hash_map, const void * key, size_t key_hash)
+{
+  size_t map_index = 0, bucket_index = 0;
   bool already_exists = false;
   rcutils_hash_map_entry_t * entry = NULL;
 
-  // If there is nothing in the hash map, don't bother computing the key
-  if (hash_map->impl->size == 0) {
-    return RCUTILS_RET_OK;
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+    open_addressing_unset_hashed(hash_map->impl, key, open_addressing_mix_hash(key_hash));
+    return;
+  }
+
+  if (NULL != hash_map->impl->old_map) {
+    rcutils_ret_t ret = hash_map_migrate_buckets(hash_map->impl, MIGRATED_BUCKETS);
+    // The entries which could not be moved are still found in the old map
+    RCUTILS_LOG_ERROR_EXPRESSION(
+      RCUTILS_RET_OK != ret, "Failed to move hash_map entries. Reason: %d", ret);
   }
 
-  already_exists = hash_map_find(hash_map, key, &key_hash, &map_index, &bucket_index, &entry);
+  already_exists = hash_map_find_hashed(
+    hash_map, key, NULL, key_hash, &map_index, &bucket_index, &entry);
 
   if (!already_exists) {
     // The entry isn't in the map, so just exit
-    return RCUTILS_RET_OK;
+    return;
   }
 
   // Remove the entry from its bucket and deallocate it
-  rcutils_array_list_t * bucket = &(hash_map->impl->map[map_index]);
+  rcutils_array_list_t * bucket = hash_map_get_bucket(hash_map->impl, map_index);
   if (RCUTILS_RET_OK == rcutils_array_list_remove(bucket, bucket_index)) {
     hash_map->impl->size--;
     hash_map_deallocate_entry(&hash_map->impl->allocator, entry);
   }
+}
+
+rcutils_ret_t
+rcutils_hash_map_unset(rcutils_hash_map_t * hash_map, const void * key)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+
+  // If there is nothing in the hash map, don't bother computing the key
+  if (hash_map->impl->size == 0) {
+    return RCUTILS_RET_OK;
+  }
+
+  hash_map_unset_hashed(hash_map, key, hash_map->impl->key_hashing_func(key));
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_hash_map_unset_with_hash(rcutils_hash_map_t * hash_map, const void * key, size_t key_hash)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (hash_map->impl->size == 0) {
+    return RCUTILS_RET_OK;
+  }
 
+  hash_map_unset_hashed(hash_map, key, key_hash);
   return RCUTILS_RET_OK;
 }
 
+// Copies the data of a key of a non empty hash_map, given the key's hashed value, or only checks
+// that the key exists if data is NULL
+// The key is a key view of *key_view_length characters if key_view_length isn't NULL.
+static bool hash_map_get_hashed(
+  const rcutils_hash_map_t * hash_map,
+  const void * key,
+  const size_t * key_view_length,
+  size_t key_hash,
+  void * data)
+{
+  size_t map_index = 0, bucket_index = 0;
+  rcutils_hash_map_entry_t * entry = NULL;
+
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+    if (!open_addressing_find(
+        hash_map->impl, key, key_view_length, open_addressing_mix_hash(key_hash), &map_index))
+    {
+      return false;
+    }
+    if (NULL != data) {
+      memcpy(
+        data, open_addressing_slot(hash_map->impl, map_index) + hash_map->impl->data_offset,
+        hash_map->impl->data_size);
+    }
+    return true;
+  }
+
+  if (!hash_map_find_hashed(
+      hash_map, key, key_view_length, key_hash, &map_index, &bucket_index, &entry))
+  {
+    return false;
+  }
+  if (NULL != data) {
+    memcpy(data, hash_map_entry_data(hash_map->impl, entry), hash_map->impl->data_size);
+  }
+  return true;
+}
+
 bool
 rcutils_hash_map_key_exists(const rcutils_hash_map_t * hash_map, const void * key)
 {
@@ -485,18 +1434,27 @@ rcutils_hash_map_key_exists(const rcutils_hash_map_t * hash_map, const void * ke
     return false;
   }
 
-  size_t key_hash = 0, map_index = 0, bucket_index = 0;
-  bool already_exists = false;
-  rcutils_hash_map_entry_t * entry = NULL;
-
   // If there is nothing in the hash map, don't bother computing the key
   if (hash_map->impl->size == 0) {
-    return RCUTILS_RET_OK;
+    return false;
+  }
+
+  return hash_map_get_hashed(hash_map, key, NULL, hash_map->impl->key_hashing_func(key), NULL);
+}
+
+bool
+rcutils_hash_map_key_exists_with_hash(
+  const rcutils_hash_map_t * hash_map, const void * key, size_t key_hash)
+{
+  if (NULL == hash_map || NULL == hash_map->impl || NULL == key) {
+    return false;
   }
 
-  already_exists = hash_map_find(hash_map, key, &key_hash, &map_index, &bucket_index, &entry);
+  if (hash_map->impl->size == 0) {
+    return false;
+  }
 
-  return already_exists;
+  return hash_map_get_hashed(hash_map, key, NULL, key_hash, NULL);
 }
 
 rcutils_ret_t
@@ -506,25 +1464,131 @@ rcutils_hash_map_get(const rcutils_hash_map_t * hash_map, const void * key, void
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
 
-  size_t key_hash = 0, map_index = 0, bucket_index = 0;
-  bool already_exists = false;
-  rcutils_hash_map_entry_t * entry = NULL;
-
   // If there is nothing in the hash map, don't bother computing the key
   if (hash_map->impl->size == 0) {
     return RCUTILS_RET_NOT_FOUND;
   }
 
-  already_exists = hash_map_find(hash_map, key, &key_hash, &map_index, &bucket_index, &entry);
+  if (hash_map_get_hashed(hash_map, key, NULL, hash_map->impl->key_hashing_func(key), data)) {
+    return RCUTILS_RET_OK;
+  }
+  return RCUTILS_RET_NOT_FOUND;
+}
 
-  if (already_exists) {
-    memcpy(data, entry->value, hash_map->impl->data_size);
+rcutils_ret_t
+rcutils_hash_map_get_with_hash(
+  const rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, void * data)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (hash_map->impl->size == 0) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+
+  if (hash_map_get_hashed(hash_map, key, NULL, key_hash, data)) {
     return RCUTILS_RET_OK;
   }
+  return RCUTILS_RET_NOT_FOUND;
+}
+
+rcutils_ret_t
+rcutils_hash_map_set_key_view_funcs(
+  rcutils_hash_map_t * hash_map,
+  rcutils_hash_map_key_view_hasher_t key_view_hashing_func,
+  rcutils_hash_map_key_view_cmp_t key_view_cmp_func)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key_view_hashing_func, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key_view_cmp_func, RCUTILS_RET_INVALID_ARGUMENT);
+
+  hash_map->impl->key_view_hashing_func = key_view_hashing_func;
+  hash_map->impl->key_view_cmp_func = key_view_cmp_func;
+  return RCUTILS_RET_OK;
+}
+
+bool
+rcutils_hash_map_key_view_exists(
+  const rcutils_hash_map_t * hash_map, const void * key_view, size_t length)
+{
+  if (NULL == hash_map || NULL == hash_map->impl || NULL == key_view ||
+    NULL == hash_map->impl->key_view_hashing_func)
+  {
+    return false;
+  }
+
+  if (hash_map->impl->size == 0) {
+    return false;
+  }
+
+  return hash_map_get_hashed(
+    hash_map, key_view, &length, hash_map->impl->key_view_hashing_func(key_view, length), NULL);
+}
+
+rcutils_ret_t
+rcutils_hash_map_get_with_key_view(
+  const rcutils_hash_map_t * hash_map, const void * key_view, size_t length, void * data)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key_view, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == hash_map->impl->key_view_hashing_func) {
+    RCUTILS_SET_ERROR_MSG("hash map has no key view functions");
+    return RCUTILS_RET_ERROR;
+  }
+
+  if (hash_map->impl->size == 0) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
 
+  if (hash_map_get_hashed(
+      hash_map, key_view, &length, hash_map->impl->key_view_hashing_func(key_view, length), data))
+  {
+    return RCUTILS_RET_OK;
+  }
   return RCUTILS_RET_NOT_FOUND;
 }
 
+// Copies the key and data of the first entry at or after an iterator, and moves the iterator to it
+static rcutils_ret_t hash_map_copy_entry_from(
+  const rcutils_hash_map_impl_t * impl,
+  rcutils_hash_map_iterator_t * iterator,
+  void * key,
+  void * data)
+{
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == impl->backend) {
+    for (; iterator->position < impl->capacity; ++iterator->position) {
+      if (open_addressing_is_full(impl->control[iterator->position])) {
+        const uint8_t * slot = open_addressing_slot(impl, iterator->position);
+        memcpy(key, slot + impl->key_offset, impl->key_size);
+        memcpy(data, slot + impl->data_offset, impl->data_size);
+        return RCUTILS_RET_OK;
+      }
+    }
+    return RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES;
+  }
+
+  // The buckets of the old map, if any, come after the ones of the map
+  size_t bucket_count = impl->capacity + impl->old_capacity;
+  for (; iterator->position < bucket_count; ++iterator->position) {
+    size_t bucket_size = 0;
+    rcutils_hash_map_entry_t ** entries = hash_map_get_bucket_entries(
+      hash_map_get_bucket(impl, iterator->position), &bucket_size);
+
+    // Check if the next index in this bucket is valid and if so we've found the next item
+    if (iterator->index < bucket_size) {
+      memcpy(key, hash_map_entry_key(impl, entries[iterator->index]), impl->key_size);
+      memcpy(data, hash_map_entry_data(impl, entries[iterator->index]), impl->data_size);
+      return RCUTILS_RET_OK;
+    }
+    // After the first bucket the next entry must be at the start of the next bucket with entries
+    iterator->index = 0;
+  }
+
+  return RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES;
+}
+
 rcutils_ret_t
 rcutils_hash_map_get_next_key_and_data(
   const rcutils_hash_map_t * hash_map,
@@ -536,10 +1600,9 @@ rcutils_hash_map_get_next_key_and_data(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
 
-  size_t key_hash = 0, map_index = 0, bucket_index = 0;
-  bool already_exists = false;
+  size_t key_hash = 0;
   rcutils_hash_map_entry_t * entry = NULL;
-  rcutils_ret_t ret = RCUTILS_RET_OK;
+  rcutils_hash_map_iterator_t iterator = {0, 0};
 
   // If there is nothing in the hash map, don't bother computing the key
   if (hash_map->impl->size == 0) {
@@ -551,40 +1614,71 @@ rcutils_hash_map_get_next_key_and_data(
   }
 
   if (NULL != previous_key) {
-    already_exists = hash_map_find(
-      hash_map, previous_key, &key_hash, &map_index, &bucket_index, &entry);
-    if (!already_exists) {
-      return RCUTILS_RET_NOT_FOUND;
+    // We want to start our search from the entry after the previous key
+    if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+      if (!open_addressing_find(
+          hash_map->impl, previous_key, NULL,
+          open_addressing_mix_hash(hash_map->impl->key_hashing_func(previous_key)),
+          &iterator.position))
+      {
+        return RCUTILS_RET_NOT_FOUND;
+      }
+      iterator.position++;
+    } else {
+      if (!hash_map_find(
+          hash_map, previous_key, &key_hash, &iterator.position, &iterator.index, &entry))
+      {
+        return RCUTILS_RET_NOT_FOUND;
+      }
+      iterator.index++;
     }
-    bucket_index++;  // We want to start our search from the next object
   }
 
-  for (; map_index < hash_map->impl->capacity; ++map_index) {
-    rcutils_array_list_t * bucket = &(hash_map->impl->map[map_index]);
-    if (NULL != bucket->impl) {
-      size_t bucket_size = 0;
-      ret = rcutils_array_list_get_size(bucket, &bucket_size);
-      if (RCUTILS_RET_OK != ret) {
-        return ret;
-      }
+  return hash_map_copy_entry_from(hash_map->impl, &iterator, key, data);
+}
 
-      // Check if the next index in this bucket is valid and if so we've found the next item
-      if (bucket_index < bucket_size) {
-        rcutils_hash_map_entry_t * bucket_entry = NULL;
-        ret = rcutils_array_list_get(bucket, bucket_index, &bucket_entry);
-        if (RCUTILS_RET_OK == ret) {
-          memcpy(key, bucket_entry->key, hash_map->impl->key_size);
-          memcpy(data, bucket_entry->value, hash_map->impl->data_size);
-        }
+rcutils_ret_t
+rcutils_hash_map_iterator_begin(
+  const rcutils_hash_map_t * hash_map,
+  rcutils_hash_map_iterator_t * iterator,
+  void * key,
+  void * data)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(iterator, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
 
-        return ret;
-      }
-    }
-    // After the first bucket the next entry must be at the start of the next bucket with entries
-    bucket_index = 0;
+  iterator->position = 0;
+  iterator->index = 0;
+  if (hash_map->impl->size == 0) {
+    // Start past the end, so that the iterator stays there
+    iterator->position = hash_map->impl->capacity + hash_map->impl->old_capacity;
+    return RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES;
   }
+  return hash_map_copy_entry_from(hash_map->impl, iterator, key, data);
+}
 
-  return RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES;
+rcutils_ret_t
+rcutils_hash_map_iterator_next(
+  const rcutils_hash_map_t * hash_map,
+  rcutils_hash_map_iterator_t * iterator,
+  void * key,
+  void * data)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(iterator, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING == hash_map->impl->backend) {
+    if (iterator->position < hash_map->impl->capacity) {
+      iterator->position++;
+    }
+  } else if (iterator->position < hash_map->impl->capacity + hash_map->impl->old_capacity) {
+    iterator->index++;
+  }
+  return hash_map_copy_entry_from(hash_map->impl, iterator, key, data);
 }
 
 
@@ -0,0 +1,488 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+// When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
+// there appears to be a problem with winbase.h (which is included by
+// Windows.h).  In particular, warnings of the form:
+//
+// warning C5105: macro expansion producing 'defined' has undefined behavior
+//
+// See https://developercommunity.visualstudio.com/content/problem/695656/wdk-and-sdk-are-not-compatible-with-experimentalpr.html
+// for more information.  For now disable that warning when including windows.h
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#elif defined(__linux__)
+# include <errno.h>
+# include <linux/futex.h>
+# include <pthread.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define LOCK_HAVE_FUTEX
+#else
+# include <sched.h>
+# ifdef __APPLE__
+#  include <os/lock.h>
+# endif
+#endif
+
+#include "rcutils/error_handling.h"
+#include "rcutils/lock.h"
+#include "rcutils/macros.h"
+
+// The bits of the state of an rcutils_adaptive_rwlock_t.
+// A writer holds the lock.
+#define RWLOCK_WRITER 0x80000000u
+// A writer waits for the lock, so that readers don't take it meanwhile.
+#define RWLOCK_WRITER_PENDING 0x40000000u
+// Threads may sleep on the lock, so that it must be woken when it changes.
+#define RWLOCK_SLEEPERS 0x20000000u
+// The number of readers holding the lock.
+#define RWLOCK_READERS_MASK 0x1fffffffu
+
+// The states of an rcutils_adaptive_mutex_t without priority inheritance.
+#define MUTEX_UNLOCKED 0u
+#define MUTEX_LOCKED 1u
+// The mutex is held, and threads may sleep on it, so that it must be woken when unlocked.
+#define MUTEX_LOCKED_WITH_SLEEPERS 2u
+
+static uint32_t lock_load(uint32_t * object)
+{
+#ifdef _WIN32
+  return (uint32_t)*(volatile LONG *)object;
+#else
+  return __atomic_load_n(object, __ATOMIC_RELAXED);
+#endif
+}
+
+// Replaces *object by desired if it is *expected, or sets *expected to *object.
+static bool lock_compare_exchange(uint32_t * object, uint32_t * expected, uint32_t desired)
+{
+#ifdef _WIN32
+  uint32_t previous = (uint32_t)InterlockedCompareExchange(
+    (volatile LONG *)object, (LONG)desired, (LONG)*expected);
+  if (previous == *expected) {
+    return true;
+  }
+  *expected = previous;
+  return false;
+#else
+  return __atomic_compare_exchange_n(
+    object, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#endif
+}
+
+static uint32_t lock_exchange(uint32_t * object, uint32_t desired)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedExchange((volatile LONG *)object, (LONG)desired);
+#else
+  return __atomic_exchange_n(object, desired, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static void lock_store_release(uint32_t * object, uint32_t desired)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)object, (LONG)desired);
+#else
+  __atomic_store_n(object, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+// Tells the processor that the thread is spinning, which saves power and lets a sibling
+// hyper-thread run.
+static void lock_cpu_relax(void)
+{
+#if defined(_WIN32)
+  YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__ ("yield");
+#endif
+}
+
+// Sleeps until the object is woken, unless it isn't expected anymore.
+// Spurious wake-ups are possible, so callers must check the object again.
+static void lock_wait(uint32_t * object, uint32_t expected)
+{
+#if defined(_WIN32)
+  (void)WaitOnAddress((volatile VOID *)object, &expected, sizeof(expected), INFINITE);
+#elif defined(LOCK_HAVE_FUTEX)
+  (void)syscall(SYS_futex, object, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+#else
+  RCUTILS_UNUSED(object);
+  RCUTILS_UNUSED(expected);
+  (void)sched_yield();
+#endif
+}
+
+#ifndef __APPLE__
+static void lock_wake_one(uint32_t * object)
+{
+#if defined(_WIN32)
+  WakeByAddressSingle((PVOID)object);
+#elif defined(LOCK_HAVE_FUTEX)
+  (void)syscall(SYS_futex, object, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+  RCUTILS_UNUSED(object);
+#endif
+}
+#endif
+
+static void lock_wake_all(uint32_t * object)
+{
+#if defined(_WIN32)
+  WakeByAddressAll((PVOID)object);
+#elif defined(LOCK_HAVE_FUTEX)
+  (void)syscall(SYS_futex, object, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+#else
+  RCUTILS_UNUSED(object);
+#endif
+}
+
+#ifdef LOCK_HAVE_FUTEX
+// The kernel id of the calling thread, which priority inheritance futexes hold.
+static RCUTILS_THREAD_LOCAL uint32_t gtls_rcutils_lock_thread_id = 0u;
+static pthread_once_t g_rcutils_lock_atfork_once = PTHREAD_ONCE_INIT;
+
+// The thread forking is the only one of the child process, but with another id.
+static void lock_forget_thread_id(void)
+{
+  gtls_rcutils_lock_thread_id = 0u;
+}
+
+static void lock_register_atfork(void)
+{
+  (void)pthread_atfork(NULL, NULL, lock_forget_thread_id);
+}
+
+static uint32_t lock_current_thread_id(void)
+{
+  if (0u == gtls_rcutils_lock_thread_id) {
+    (void)pthread_once(&g_rcutils_lock_atfork_once, lock_register_atfork);
+    gtls_rcutils_lock_thread_id = (uint32_t)syscall(SYS_gettid);
+  }
+  return gtls_rcutils_lock_thread_id;
+}
+
+// The state is 0 when unlocked, or the id of the owner, which the kernel flags with
+// FUTEX_WAITERS when threads wait, so that only uncontended operations stay in user space.
+static void mutex_lock_priority_inheritance(rcutils_adaptive_mutex_t * mutex)
+{
+  const uint32_t thread_id = lock_current_thread_id();
+  uint32_t expected = 0u;
+  if (lock_compare_exchange(&mutex->state, &expected, thread_id)) {
+    return;
+  }
+  for (uint32_t i = 0u; i < mutex->spin_count; ++i) {
+    lock_cpu_relax();
+    expected = 0u;
+    if (0u == lock_load(&mutex->state) &&
+      lock_compare_exchange(&mutex->state, &expected, thread_id))
+    {
+      return;
+    }
+  }
+  // The kernel takes the mutex for the thread, boosting the owner meanwhile.
+  while (0 != syscall(SYS_futex, &mutex->state, FUTEX_LOCK_PI_PRIVATE, 0, NULL, NULL, 0)) {
+    if (EINTR != errno && EAGAIN != errno) {
+      return;
+    }
+  }
+  // The kernel hands the mutex over without an atomic operation of the previous owner, so
+  // synchronize with its release explicitly.
+  (void)__atomic_load_n(&mutex->state, __ATOMIC_ACQUIRE);
+}
+
+static void mutex_unlock_priority_inheritance(rcutils_adaptive_mutex_t * mutex)
+{
+  uint32_t expected = lock_current_thread_id();
+  if (!lock_compare_exchange(&mutex->state, &expected, 0u)) {
+    // Threads wait, so the kernel hands the mutex over to the highest priority one.
+    (void)__atomic_fetch_or(&mutex->state, 0u, __ATOMIC_RELEASE);
+    (void)syscall(SYS_futex, &mutex->state, FUTEX_UNLOCK_PI_PRIVATE, 0, NULL, NULL, 0);
+  }
+}
+#endif
+
+void
+rcutils_spinlock_lock(rcutils_spinlock_t * lock)
+{
+  // Spin on plain loads, which keep the cache line shared until the lock looks available.
+  while (0u != lock_exchange(&lock->state, 1u)) {
+    while (0u != lock_load(&lock->state)) {
+      lock_cpu_relax();
+    }
+  }
+}
+
+bool
+rcutils_spinlock_try_lock(rcutils_spinlock_t * lock)
+{
+  return 0u == lock_load(&lock->state) && 0u == lock_exchange(&lock->state, 1u);
+}
+
+void
+rcutils_spinlock_unlock(rcutils_spinlock_t * lock)
+{
+  lock_store_release(&lock->state, 0u);
+}
+
+rcutils_adaptive_mutex_options_t
+rcutils_get_default_adaptive_mutex_options(void)
+{
+  rcutils_adaptive_mutex_options_t options;
+  options.spin_count = RCUTILS_LOCK_DEFAULT_SPIN_COUNT;
+  options.priority_inheritance = false;
+  return options;
+}
+
+rcutils_ret_t
+rcutils_adaptive_mutex_init(
+  rcutils_adaptive_mutex_t * mutex,
+  const rcutils_adaptive_mutex_options_t * options)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(mutex, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+#if !defined(LOCK_HAVE_FUTEX) && !defined(__APPLE__)
+  if (options->priority_inheritance) {
+    RCUTILS_SET_ERROR_MSG("priority inheritance isn't supported on this platform");
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  mutex->state = 0u;
+  mutex->spin_count = options->spin_count;
+  mutex->priority_inheritance = options->priority_inheritance;
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_adaptive_mutex_lock(rcutils_adaptive_mutex_t * mutex)
+{
+#ifdef __APPLE__
+  os_unfair_lock_t native = (os_unfair_lock_t)&mutex->state;
+  for (uint32_t i = 0u; i <= mutex->spin_count; ++i) {
+    if (os_unfair_lock_trylock(native)) {
+      return;
+    }
+    lock_cpu_relax();
+  }
+  os_unfair_lock_lock(native);
+#else
+#ifdef LOCK_HAVE_FUTEX
+  if (mutex->priority_inheritance) {
+    mutex_lock_priority_inheritance(mutex);
+    return;
+  }
+#endif
+  uint32_t expected = MUTEX_UNLOCKED;
+  if (lock_compare_exchange(&mutex->state, &expected, MUTEX_LOCKED)) {
+    return;
+  }
+  for (uint32_t i = 0u; i < mutex->spin_count && MUTEX_LOCKED_WITH_SLEEPERS != expected; ++i) {
+    lock_cpu_relax();
+    expected = lock_load(&mutex->state);
+    if (MUTEX_UNLOCKED == expected &&
+      lock_compare_exchange(&mutex->state, &expected, MUTEX_LOCKED))
+    {
+      return;
+    }
+  }
+  // From now on the mutex is taken as if threads sleep on it, since this one may.
+  while (MUTEX_UNLOCKED != lock_exchange(&mutex->state, MUTEX_LOCKED_WITH_SLEEPERS)) {
+    lock_wait(&mutex->state, MUTEX_LOCKED_WITH_SLEEPERS);
+  }
+#endif
+}
+
+bool
+rcutils_adaptive_mutex_try_lock(rcutils_adaptive_mutex_t * mutex)
+{
+#ifdef __APPLE__
+  return os_unfair_lock_trylock((os_unfair_lock_t)&mutex->state);
+#else
+  uint32_t expected = MUTEX_UNLOCKED;
+#ifdef LOCK_HAVE_FUTEX
+  if (mutex->priority_inheritance) {
+    return lock_compare_exchange(&mutex->state, &expected, lock_current_thread_id());
+  }
+#endif
+  return lock_compare_exchange(&mutex->state, &expected, MUTEX_LOCKED);
+#endif
+}
+
+void
+rcutils_adaptive_mutex_unlock(rcutils_adaptive_mutex_t * mutex)
+{
+#ifdef __APPLE__
+  os_unfair_lock_unlock((os_unfair_lock_t)&mutex->state);
+#else
+#ifdef LOCK_HAVE_FUTEX
+  if (mutex->priority_inheritance) {
+    mutex_unlock_priority_inheritance(mutex);
+    return;
+  }
+#endif
+  if (MUTEX_LOCKED_WITH_SLEEPERS == lock_exchange(&mutex->state, MUTEX_UNLOCKED)) {
+    lock_wake_one(&mutex->state);
+  }
+#endif
+}
+
+rcutils_ret_t
+rcutils_adaptive_rwlock_init(rcutils_adaptive_rwlock_t * lock, uint32_t spin_count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(lock, RCUTILS_RET_INVALID_ARGUMENT);
+  lock->state = 0u;
+  lock->spin_count = spin_count;
+  return RCUTILS_RET_OK;
+}
+
+// Flags the state with sleepers, unless it changed meanwhile, and sleeps until it changes.
+static void rwlock_sleep(rcutils_adaptive_rwlock_t * lock, uint32_t state)
+{
+  if (0u != (state & RWLOCK_SLEEPERS) ||
+    lock_compare_exchange(&lock->state, &state, state | RWLOCK_SLEEPERS))
+  {
+    lock_wait(&lock->state, state | RWLOCK_SLEEPERS);
+  }
+}
+
+void
+rcutils_adaptive_rwlock_read_lock(rcutils_adaptive_rwlock_t * lock)
+{
+  uint32_t spins = 0u;
+  uint32_t state = lock_load(&lock->state);
+  for (;;) {
+    if (0u == (state & (RWLOCK_WRITER | RWLOCK_WRITER_PENDING))) {
+      if (lock_compare_exchange(&lock->state, &state, state + 1u)) {
+        return;
+      }
+      continue;
+    }
+    if (spins < lock->spin_count) {
+      ++spins;
+      lock_cpu_relax();
+    } else {
+      rwlock_sleep(lock, state);
+    }
+    state = lock_load(&lock->state);
+  }
+}
+
+bool
+rcutils_adaptive_rwlock_try_read_lock(rcutils_adaptive_rwlock_t * lock)
+{
+  uint32_t state = lock_load(&lock->state);
+  while (0u == (state & (RWLOCK_WRITER | RWLOCK_WRITER_PENDING))) {
+    if (lock_compare_exchange(&lock->state, &state, state + 1u)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+rcutils_adaptive_rwlock_read_unlock(rcutils_adaptive_rwlock_t * lock)
+{
+  uint32_t state = lock_load(&lock->state);
+  for (;;) {
+    uint32_t desired = state - 1u;
+    // The last reader wakes the sleepers, which wait for a writer to take the lock.
+    const bool wake = 0u == (desired & RWLOCK_READERS_MASK) && 0u != (desired & RWLOCK_SLEEPERS);
+    if (wake) {
+      desired &= ~RWLOCK_SLEEPERS;
+    }
+    if (lock_compare_exchange(&lock->state, &state, desired)) {
+      if (wake) {
+        lock_wake_all(&lock->state);
+      }
+      return;
+    }
+  }
+}
+
+void
+rcutils_adaptive_rwlock_write_lock(rcutils_adaptive_rwlock_t * lock)
+{
+  uint32_t spins = 0u;
+  uint32_t state = lock_load(&lock->state);
+  for (;;) {
+    if (0u == (state & (RWLOCK_WRITER | RWLOCK_READERS_MASK))) {
+      // Other pending writers flag the lock again when they next find it held.
+      if (lock_compare_exchange(
+          &lock->state, &state, (state | RWLOCK_WRITER) & ~RWLOCK_WRITER_PENDING))
+      {
+        return;
+      }
+      continue;
+    }
+    if (0u == (state & RWLOCK_WRITER_PENDING)) {
+      if (!lock_compare_exchange(&lock->state, &state, state | RWLOCK_WRITER_PENDING)) {
+        continue;
+      }
+      state |= RWLOCK_WRITER_PENDING;
+    }
+    if (spins < lock->spin_count) {
+      ++spins;
+      lock_cpu_relax();
+    } else {
+      rwlock_sleep(lock, state);
+    }
+    state = lock_load(&lock->state);
+  }
+}
+
+bool
+rcutils_adaptive_rwlock_try_write_lock(rcutils_adaptive_rwlock_t * lock)
+{
+  uint32_t state = lock_load(&lock->state);
+  while (0u == (state & (RWLOCK_WRITER | RWLOCK_READERS_MASK))) {
+    if (lock_compare_exchange(
+        &lock->state, &state, (state | RWLOCK_WRITER) & ~RWLOCK_WRITER_PENDING))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+rcutils_adaptive_rwlock_write_unlock(rcutils_adaptive_rwlock_t * lock)
+{
+  uint32_t state = lock_load(&lock->state);
+  while (!lock_compare_exchange(
+      &lock->state, &state, state & ~(RWLOCK_WRITER | RWLOCK_SLEEPERS)))
+  {
+  }
+  if (0u != (state & RWLOCK_SLEEPERS)) {
+    lock_wake_all(&lock->state);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,8 +15,10 @@
 #include <ctype.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef _WIN32
@@ -37,6 +39,14 @@
 # include <unistd.h>
 #endif
 
+#include "./logging_async.h"
+#include "./logging_binary.h"
+#include "./logging_dedup.h"
+#include "./logging_levels.h"
+#include "./logging_statistics.h"
+#include "./logging_tracepoints.h"
+#include "./threads.h"
+
 #include "rcutils/allocator.h"
 #include "rcutils/env.h"
 #include "rcutils/error_handling.h"
@@ -44,16 +54,20 @@
 #include "rcutils/format_string.h"
 #include "rcutils/logging.h"
 #include "rcutils/snprintf.h"
+#include "rcutils/strcasecmp.h"
 #include "rcutils/strdup.h"
 #include "rcutils/strerror.h"
 #include "rcutils/time.h"
 #include "rcutils/types/hash_map.h"
+#include "rcutils/types/string_pool.h"
+#include "rcutils/utf8.h"
 
 
-#define RCUTILS_LOGGING_SEPARATOR_CHAR '.'
-
 #define RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN (2048)
 
+#define RCUTILS_LOGGING_ASYNC_DEFAULT_QUEUE_SIZE (1024)
+#define RCUTILS_LOGGING_ASYNC_DEFAULT_RECORD_SIZE (512)
+
 #if defined(_WIN32)
 // Used with setvbuf, and size must be 2 <= size <= INT_MAX. For more info, see:
 // https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/setvbuf
@@ -83,48 +97,502 @@ enum rcutils_colorized_output
 
 bool g_rcutils_logging_initialized = false;
 
-static char g_rcutils_logging_output_format_string[RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN];
+uint32_t g_rcutils_logging_initialization_state = RCUTILS_LOGGING_UNINITIALIZED;
+
+uint32_t g_rcutils_logging_level_generation = 0u;
+
+uint32_t g_rcutils_logging_uniform_level = 0u;
+
+// The structure of the output, see RCUTILS_CONSOLE_OUTPUT_STRUCTURE.
+typedef enum logging_output_structure_e
+{
+  // Formatted as given by RCUTILS_CONSOLE_OUTPUT_FORMAT.
+  LOGGING_OUTPUT_STRUCTURE_TEXT,
+  // One JSON object per line.
+  LOGGING_OUTPUT_STRUCTURE_JSON,
+  // One line of space separated key=value pairs, with quoted and escaped strings.
+  LOGGING_OUTPUT_STRUCTURE_KEY_VALUE,
+} logging_output_structure_t;
+
+static logging_output_structure_t g_rcutils_logging_output_structure =
+  LOGGING_OUTPUT_STRUCTURE_TEXT;
+// Whether the strings of the structured output are sanitized to valid UTF-8, see
+// RCUTILS_CONSOLE_OUTPUT_SANITIZE_UTF8.
+static bool g_rcutils_logging_sanitize_utf8 = false;
 static const char * g_rcutils_logging_default_output_format =
   "[{severity}] [{time}] [{name}]: {message}";
 
 static rcutils_allocator_t g_rcutils_logging_allocator;
 
 static rcutils_logging_output_handler_t g_rcutils_logging_output_handler = NULL;
+// The levels set by the user, only used by rcutils_logging_set_logger_level(), which publishes
+// an immutable copy of them in g_rcutils_logging_levels after every change.  Readers only look
+// at the published copy, so they never take a lock and never see the map while it changes.
 static rcutils_hash_map_t g_rcutils_logging_severities_map;
+// The names of the loggers in the severities map, which are interned rather than copied, so that
+// names which are removed from the map, e.g. from the cache, and added again are not copied again.
+static rcutils_string_pool_t g_rcutils_logging_logger_names;
+static rcutils_logging_levels_publication_t g_rcutils_logging_levels;
+// Serializes the changes of the map and the publications.
+static rcutils_mutex_t g_rcutils_logging_levels_mutex;
+
+typedef struct logging_level_pattern_s
+{
+  char * pattern;
+  int level;
+} logging_level_pattern_t;
+
+// The level patterns in the order they were set, only changed with the levels mutex held and
+// published along with the severities map.
+static logging_level_pattern_t * g_rcutils_logging_level_patterns = NULL;
+static size_t g_rcutils_logging_level_pattern_count = 0;
+static size_t g_rcutils_logging_level_pattern_capacity = 0;
 
 // If this is false, attempts to use the severities map will be skipped.
 // This can happen if allocation of the map fails at initialization.
 static bool g_rcutils_logging_severities_map_valid = false;
 
+// Only changed with the levels mutex held, once the severities map is valid, but read without it,
+// so always accessed atomically.
 static int g_rcutils_logging_default_logger_level = 0;
 
+// Whether the published levels have a level for a logger other than the default one, or a
+// pattern, only accessed with the levels mutex held.
+static bool g_rcutils_logging_levels_configured = false;
+
+// Logger handles by name, created on the first call to rcutils_logging_get_logger_handle().
+// Each handle is a single allocation, followed by the copy of its name used as the key.
+static rcutils_hash_map_t g_rcutils_logging_logger_handles;
+static bool g_rcutils_logging_logger_handles_valid = false;
+
 static FILE * g_output_stream = NULL;
 
 static enum rcutils_colorized_output g_colorized_output = RCUTILS_COLORIZED_OUTPUT_AUTO;
+// Whether console output is colorized, resolved once at initialization.
+static bool g_output_colorized = false;
+#ifdef _WIN32
+// The console of the output stream, if the output is colorized.
+static HANDLE g_output_console_handle = INVALID_HANDLE_VALUE;
+// Whether the console interprets color escape sequences, otherwise its colors are set directly.
+static bool g_output_console_escapes = false;
+#endif
+
+// Non-NULL while the console output handler is in asynchronous mode.
+static rcutils_logging_async_writer_t * g_rcutils_logging_async_writer = NULL;
+
+// A rcutils_logging_timestamp_source_t, read for every message.
+static uint32_t g_rcutils_logging_timestamp_source = RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE;
+// How often the asynchronous consumer thread refreshes the cached timestamp.
+#define RCUTILS_LOGGING_TIMESTAMP_CACHE_PERIOD_MS (1u)
+
+// The interval of the repeated message summaries, or zero if repeats aren't suppressed.
+static int64_t g_rcutils_logging_repeat_interval = 0;
+
+// The fields of the rcutils_logging_flush_policy_t of the output stream.
+static int64_t g_rcutils_logging_flush_interval = 0;
+static uint32_t g_rcutils_logging_flush_message_count = 0u;
+static uint32_t g_rcutils_logging_flush_severity = RCUTILS_LOG_SEVERITY_UNSET;
+// Whether any of the above is set, so that nothing else is read for every message otherwise.
+static uint32_t g_rcutils_logging_flush_enabled = 0u;
+// The number of messages written since the last flush, and the timestamp of the message after
+// which the stream was last flushed.
+static uint32_t g_rcutils_logging_unflushed_messages = 0u;
+static int64_t g_rcutils_logging_last_flush_time = 0;
+#define RCUTILS_LOGGING_DEFAULT_FLUSH_INTERVAL_MS (20)
+
+// The buffers of the fully buffered output streams, allocated once for each of stdout and
+// stderr, and never freed, as the streams keep using them after the logging system is shut down.
+static char * g_stdout_buffer = NULL;
+static size_t g_stdout_buffer_size = 0u;
+static char * g_stderr_buffer = NULL;
+static size_t g_stderr_buffer_size = 0u;
+
+// Non-NULL while binary deferred-format logging is enabled.
+static rcutils_logging_async_writer_t * g_rcutils_logging_binary_writer = NULL;
+// The output handler to restore when binary deferred-format logging is disabled.
+static rcutils_logging_output_handler_t g_rcutils_logging_binary_previous_output_handler = NULL;
+
+typedef struct logging_sink_entry_s
+{
+  rcutils_logging_sink_t sink;
+  void * context;
+  int severity;
+} logging_sink_entry_t;
+
+static logging_sink_entry_t g_rcutils_logging_sinks[RCUTILS_LOGGING_MAX_SINKS];
+static size_t g_rcutils_logging_num_sinks = 0;
+// The lowest minimum severity of all sinks, so that messages no sink wants are never formatted.
+static int g_rcutils_logging_sinks_min_severity = INT_MAX;
+
+// Each thread keeps a small direct-mapped cache of the effective levels it resolved, so that
+// repeatedly logging with a logger whose level is inherited from an ancestor doesn't walk the
+// hierarchy every time.  Being thread local, the cache needs no synchronization of its own;
+// entries are only trusted if they were filled during the current level generation.
+#define RCUTILS_LOGGING_EFFECTIVE_LEVEL_CACHE_SIZE (16)
+#define RCUTILS_LOGGING_EFFECTIVE_LEVEL_CACHE_MAX_NAME_LEN (103)
+
+typedef struct effective_level_cache_entry_s
+{
+  // Zero if the entry was never filled, as generations are never zero once initialized.
+  uint32_t generation;
+  size_t hash;
+  int level;
+  char name[RCUTILS_LOGGING_EFFECTIVE_LEVEL_CACHE_MAX_NAME_LEN + 1];
+} effective_level_cache_entry_t;
+
+#ifdef RCUTILS_THREAD_LOCAL
+static RCUTILS_THREAD_LOCAL effective_level_cache_entry_t
+  gtls_rcutils_logging_effective_level_cache[RCUTILS_LOGGING_EFFECTIVE_LEVEL_CACHE_SIZE];
+#endif
+
+// The initial capacity of the buffers the output handlers format into.
+#define RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE (1024)
+// Per thread buffers which grew beyond this for a long message are shrunk back afterwards, so
+// that a single huge message doesn't stay allocated for the thread's lifetime.
+#define RCUTILS_LOGGING_OUTPUT_BUFFER_MAX_RETAINED_SIZE (64 * 1024)
+// The number of buffers each thread keeps, enough for an output handler and the sinks or the
+// nested output handlers it calls, which each take one while the others are in use.
+#define RCUTILS_LOGGING_THREAD_BUFFER_COUNT (4)
+
+typedef struct thread_buffer_pool_s
+{
+  // Created when first needed, with the allocator of the pool.
+  rcutils_char_array_t arrays[RCUTILS_LOGGING_THREAD_BUFFER_COUNT];
+  // Bit i is set while arrays[i] is in use.
+  unsigned int in_use;
+  rcutils_allocator_t allocator;
+} thread_buffer_pool_t;
+
+// Each thread reuses its own pool of buffers, created on the first message it logs and destroyed
+// when the thread exits, so that the buffers which grew for long messages aren't allocated and
+// freed again for each of them.  The key is created once and never deleted, so that pools of
+// threads which outlive a shutdown are still destroyed properly.
+static rcutils_thread_specific_t g_rcutils_logging_output_buffer_key;
+static bool g_rcutils_logging_output_buffer_key_valid = false;
+
+static void RCUTILS_THREAD_SPECIFIC_CALLBACK destroy_thread_buffer_pool(void * value)
+{
+  thread_buffer_pool_t * pool = (thread_buffer_pool_t *)value;
+  for (size_t i = 0; i < RCUTILS_LOGGING_THREAD_BUFFER_COUNT; ++i) {
+    if (NULL != pool->arrays[i].buffer &&
+      rcutils_char_array_fini(&pool->arrays[i]) != RCUTILS_RET_OK)
+    {
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to fini array.\n");
+    }
+  }
+  rcutils_allocator_t allocator = pool->allocator;
+  allocator.deallocate(pool, allocator.state);
+}
+
+static bool allocators_equal(const rcutils_allocator_t * a, const rcutils_allocator_t * b)
+{
+  return a->allocate == b->allocate && a->deallocate == b->deallocate &&
+         a->reallocate == b->reallocate && a->zero_allocate == b->zero_allocate &&
+         a->state == b->state;
+}
+
+// Get the buffer pool of the calling thread, or NULL if it isn't available.
+static thread_buffer_pool_t * get_thread_buffer_pool(void)
+{
+  if (!g_rcutils_logging_output_buffer_key_valid) {
+    return NULL;
+  }
+  thread_buffer_pool_t * pool =
+    (thread_buffer_pool_t *)rcutils_thread_specific_get(&g_rcutils_logging_output_buffer_key);
+  if (NULL != pool && !allocators_equal(&pool->allocator, &g_rcutils_logging_allocator)) {
+    if (0u != pool->in_use) {
+      return NULL;
+    }
+    // The logging system was reinitialized with another allocator since this was created.
+    (void)rcutils_thread_specific_set(&g_rcutils_logging_output_buffer_key, NULL);
+    destroy_thread_buffer_pool(pool);
+    pool = NULL;
+  }
+  if (NULL == pool) {
+    pool = g_rcutils_logging_allocator.allocate(
+      sizeof(thread_buffer_pool_t), g_rcutils_logging_allocator.state);
+    if (NULL == pool) {
+      return NULL;
+    }
+    for (size_t i = 0; i < RCUTILS_LOGGING_THREAD_BUFFER_COUNT; ++i) {
+      pool->arrays[i] = rcutils_get_zero_initialized_char_array();
+    }
+    pool->in_use = 0u;
+    pool->allocator = g_rcutils_logging_allocator;
+    if (rcutils_thread_specific_set(&g_rcutils_logging_output_buffer_key, pool) != RCUTILS_RET_OK) {
+      rcutils_reset_error();
+      destroy_thread_buffer_pool(pool);
+      return NULL;
+    }
+  }
+  return pool;
+}
+
+// Get an emptied buffer from the pool of the calling thread, or the given buffer on the stack if
+// the pool isn't available or all its buffers are in use.
+// Either way, it must be given back with release_thread_buffer().
+static rcutils_char_array_t * acquire_thread_buffer(rcutils_char_array_t * stack_array)
+{
+  thread_buffer_pool_t * pool = get_thread_buffer_pool();
+  if (NULL == pool) {
+    return stack_array;
+  }
+  for (size_t i = 0; i < RCUTILS_LOGGING_THREAD_BUFFER_COUNT; ++i) {
+    if (0u != (pool->in_use & (1u << i))) {
+      continue;
+    }
+    rcutils_char_array_t * array = &pool->arrays[i];
+    if (NULL == array->buffer) {
+      if (rcutils_char_array_init(
+          array, RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE, &pool->allocator) != RCUTILS_RET_OK)
+      {
+        rcutils_reset_error();
+        *array = rcutils_get_zero_initialized_char_array();
+        return stack_array;
+      }
+    }
+    pool->in_use |= 1u << i;
+    array->buffer_length = 0;
+    array->buffer[0] = '\0';
+    return array;
+  }
+  return stack_array;
+}
+
+static void release_thread_buffer(rcutils_char_array_t * array, rcutils_char_array_t * stack_array)
+{
+  if (array == stack_array) {
+    if (rcutils_char_array_fini(stack_array) != RCUTILS_RET_OK) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to fini array.\n");
+    }
+    return;
+  }
+  thread_buffer_pool_t * pool =
+    (thread_buffer_pool_t *)rcutils_thread_specific_get(&g_rcutils_logging_output_buffer_key);
+  if (array->buffer_capacity > RCUTILS_LOGGING_OUTPUT_BUFFER_MAX_RETAINED_SIZE) {
+    if (rcutils_char_array_resize(array, RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE) != RCUTILS_RET_OK) {
+      rcutils_reset_error();
+    }
+  }
+  pool->in_use &= ~(1u << (size_t)(array - pool->arrays));
+}
+
+// Destroy the buffer pool of the calling thread, if any.
+static void fini_thread_buffer_pool(void)
+{
+  if (!g_rcutils_logging_output_buffer_key_valid) {
+    return;
+  }
+  thread_buffer_pool_t * pool =
+    (thread_buffer_pool_t *)rcutils_thread_specific_get(&g_rcutils_logging_output_buffer_key);
+  if (NULL != pool && 0u == pool->in_use) {
+    (void)rcutils_thread_specific_set(&g_rcutils_logging_output_buffer_key, NULL);
+    destroy_thread_buffer_pool(pool);
+  }
+}
 
 typedef struct logging_input_s
 {
   const char * name;
   const rcutils_log_location_t * location;
+  // Either the already formatted message, or NULL to expand the format and args below instead.
   const char * msg;
+  // The length of msg, which needn't be null terminated.
+  size_t msg_length;
+  const char * format;
+  va_list * args;
   int severity;
   rcutils_time_point_value_t timestamp;
 } logging_input_t;
 
 typedef const char * (* token_handler)(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset);
+  rcutils_char_array_t * logging_output);
 
 typedef struct log_msg_part_s
 {
+  // The handler expanding a token, or NULL for a literal.
   token_handler handler;
-  size_t start_offset;
-  size_t end_offset;
+  // The literal, as a range of the literals of the format.
+  size_t literal_offset;
+  size_t literal_length;
+  // Whether the expansion is escaped to be the contents of a JSON string.
+  bool escape;
 } log_msg_part_t;
 
-static size_t g_num_log_msg_handlers = 0;
-static log_msg_part_t g_handlers[1024];
+// An output format compiled into its parts, where adjacent literals are merged into one part.
+// It is a single allocation: the parts, followed by all the literals, one after the other.
+typedef struct log_msg_format_s
+{
+  size_t num_parts;
+  log_msg_part_t * parts;
+  char * literals;
+  size_t literals_length;
+  // The format this one replaced, as threads formatting a message may still use it.
+  // The formats replaced are only deallocated when the logging system is shut down.
+  struct log_msg_format_s * replaced;
+} log_msg_format_t;
+
+// The current output format, swapped atomically by rcutils_logging_set_output_format().
+static log_msg_format_t * g_log_msg_format = NULL;
+
+// The increment of g_rcutils_logging_level_generation, which keeps its lowest bits free for the
+// effective level stored along with it in the callsite caches.
+#define RCUTILS_LOGGING_LEVEL_GENERATION_INCREMENT (0x100u)
+
+// Special values of rcutils_log_callsite_cache_t::state, none of which has the valid bit set.
+#define RCUTILS_LOG_CALLSITE_CACHE_UNCLAIMED (0u)
+#define RCUTILS_LOG_CALLSITE_CACHE_CLAIMING (1u)
+#define RCUTILS_LOG_CALLSITE_CACHE_UNCACHEABLE (2u)
+
+static uint32_t atomic_add_fetch_uint32(uint32_t * object, uint32_t arg)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedExchangeAdd((volatile LONG *)object, (LONG)arg) + arg;
+#else
+  return __atomic_add_fetch(object, arg, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static bool atomic_compare_exchange_uint32(uint32_t * object, uint32_t expected, uint32_t desired)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange(
+    (volatile LONG *)object, (LONG)desired, (LONG)expected) == expected;
+#else
+  return __atomic_compare_exchange_n(
+    object, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void atomic_store_release_uint32(uint32_t * object, uint32_t desired)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)object, (LONG)desired);
+#else
+  __atomic_store_n(object, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+static int atomic_load_acquire_int(int * object)
+{
+#ifdef _WIN32
+  return (int)InterlockedCompareExchange((volatile LONG *)object, 0, 0);
+#else
+  return __atomic_load_n(object, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void atomic_store_release_int(int * object, int desired)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)object, (LONG)desired);
+#else
+  __atomic_store_n(object, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+static int64_t atomic_load_int64(int64_t * object)
+{
+#ifdef _WIN32
+  return (int64_t)InterlockedCompareExchange64((volatile LONG64 *)object, 0, 0);
+#else
+  return __atomic_load_n(object, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void atomic_store_release_int64(int64_t * object, int64_t desired)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)object, (LONG64)desired);
+#else
+  __atomic_store_n(object, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+static bool atomic_compare_exchange_int64(int64_t * object, int64_t expected, int64_t desired)
+{
+#ifdef _WIN32
+  return (int64_t)InterlockedCompareExchange64(
+    (volatile LONG64 *)object, (LONG64)desired, (LONG64)expected) == expected;
+#else
+  return __atomic_compare_exchange_n(
+    object, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static log_msg_format_t * atomic_load_acquire_format(log_msg_format_t ** object)
+{
+#ifdef _WIN32
+  return (log_msg_format_t *)InterlockedCompareExchangePointer(
+    (PVOID volatile *)object, NULL, NULL);
+#else
+  return __atomic_load_n(object, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static bool atomic_compare_exchange_format(
+  log_msg_format_t ** object, log_msg_format_t * expected, log_msg_format_t * desired)
+{
+#ifdef _WIN32
+  return (log_msg_format_t *)InterlockedCompareExchangePointer(
+    (PVOID volatile *)object, desired, expected) == expected;
+#else
+  return __atomic_compare_exchange_n(
+    object, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// Publish the level of all loggers, if it is the default level of them all, see
+// g_rcutils_logging_uniform_level.
+// Must be called with the levels mutex held, or while the severities map is invalid, during
+// (de)initialization, so that the inputs can't change before the result is published.
+static void update_uniform_level(void)
+{
+  uint32_t uniform_level = RCUTILS_LOG_SEVERITY_UNSET;
+  int default_level = atomic_load_acquire_int(&g_rcutils_logging_default_logger_level);
+  if (g_rcutils_logging_severities_map_valid && !g_rcutils_logging_levels_configured &&
+    0u == RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_statistics_enabled) &&
+    default_level > 0)
+  {
+    uniform_level = (uint32_t)default_level;
+  }
+  atomic_store_release_uint32(&g_rcutils_logging_uniform_level, uniform_level);
+}
+
+// Must be called with the levels mutex held, or during (de)initialization, see
+// update_uniform_level().
+static void invalidate_effective_level_cache(void)
+{
+  // Zero is reserved for "never initialized", skip it when wrapping around.
+  if (0u == atomic_add_fetch_uint32(
+      &g_rcutils_logging_level_generation, RCUTILS_LOGGING_LEVEL_GENERATION_INCREMENT))
+  {
+    (void)atomic_add_fetch_uint32(
+      &g_rcutils_logging_level_generation, RCUTILS_LOGGING_LEVEL_GENERATION_INCREMENT);
+  }
+  update_uniform_level();
+}
+
+// Compute the hash used to index the effective level cache, along with the name length.
+// This must be the djb2 hash of rcutils_logging_constexpr_name_hash(), which computes the hash of
+// literal names passed to rcutils_logging_callsite_is_enabled_for_hash() at compile time.
+static size_t hash_logger_name(const char * name, size_t * length)
+{
+  *length = strlen(name);
+  return rcutils_logging_levels_hash(name, *length);
+}
+
+static effective_level_cache_entry_t * get_effective_level_cache_entry(size_t hash)
+{
+#ifdef RCUTILS_THREAD_LOCAL
+  return &gtls_rcutils_logging_effective_level_cache[
+    hash & (RCUTILS_LOGGING_EFFECTIVE_LEVEL_CACHE_SIZE - 1)];
+#else
+  (void)hash;
+  return NULL;
+#endif
+}
 
 rcutils_ret_t rcutils_logging_initialize(void)
 {
@@ -176,20 +644,81 @@ static enum rcutils_get_env_retval rcutils_get_env_var_zero_or_one(
   return RCUTILS_GET_ENV_ERROR;
 }
 
+// Read the asynchronous mode options from the RCUTILS_LOGGING_ASYNC_* environment variables,
+// starting from the defaults for any that are unset.
+static rcutils_ret_t get_async_options_from_env(rcutils_logging_async_options_t * options)
+{
+  *options = rcutils_logging_get_default_async_options();
+
+  const char * env_var_value = NULL;
+  const char * ret_str = rcutils_get_env("RCUTILS_LOGGING_ASYNC_QUEUE_SIZE", &env_var_value);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error getting environment variable RCUTILS_LOGGING_ASYNC_QUEUE_SIZE: %s", ret_str);
+    return RCUTILS_RET_ERROR;
+  }
+  if (strcmp(env_var_value, "") != 0) {
+    char * end = NULL;
+    errno = 0;
+    unsigned long long queue_size = strtoull(env_var_value, &end, 10);  // NOLINT(runtime/int)
+    if (0 != errno || end == env_var_value || '\0' != *end || '-' == env_var_value[0] ||
+      queue_size < 2u || queue_size > SIZE_MAX)
+    {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Warning: unexpected value [%s] specified for RCUTILS_LOGGING_ASYNC_QUEUE_SIZE. "
+        "It must be an integer greater than 1.", env_var_value);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    options->queue_size = (size_t)queue_size;
+  }
+
+  ret_str = rcutils_get_env("RCUTILS_LOGGING_ASYNC_OVERFLOW_POLICY", &env_var_value);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error getting environment variable RCUTILS_LOGGING_ASYNC_OVERFLOW_POLICY: %s", ret_str);
+    return RCUTILS_RET_ERROR;
+  }
+  if (strcmp(env_var_value, "") != 0) {
+    static const struct
+    {
+      const char * name;
+      rcutils_logging_async_overflow_policy_t policy;
+    } policies[] = {
+      {"drop", RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP},
+      {"block", RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK},
+      {"overwrite", RCUTILS_LOGGING_ASYNC_OVERFLOW_OVERWRITE_OLDEST},
+    };
+    bool found = false;
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); ++i) {
+      int cmp = -1;
+      if (rcutils_strcasecmp(env_var_value, policies[i].name, &cmp) == 0 && 0 == cmp) {
+        options->overflow_policy = policies[i].policy;
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Warning: unexpected value [%s] specified for RCUTILS_LOGGING_ASYNC_OVERFLOW_POLICY. "
+        "Valid values are drop, block or overwrite.", env_var_value);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+  }
+
+  return RCUTILS_RET_OK;
+}
+
 static const char * expand_time(
   const logging_input_t * logging_input, rcutils_char_array_t * logging_output,
-  rcutils_ret_t (* time_func)(const rcutils_time_point_value_t *, char *, size_t))
+  rcutils_ret_t (* time_func)(const rcutils_time_point_value_t *, char *, size_t, size_t *))
 {
   // Temporary, local storage for integer/float conversion to string
-  // Note:
-  //   32 characters enough, because the most it can be is 20 characters
-  //   for the 19 possible digits in a signed 64-bit number plus the optional
-  //   decimal point in the floating point seconds version
-  char numeric_storage[32];
+  char numeric_storage[RCUTILS_TIME_POINT_VALUE_STRING_SIZE];
+  size_t length = 0;
 
   if (time_func(
       &logging_input->timestamp, numeric_storage,
-      sizeof(numeric_storage)) != RCUTILS_RET_OK)
+      sizeof(numeric_storage), &length) != RCUTILS_RET_OK)
   {
     RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
     rcutils_reset_error();
@@ -197,7 +726,7 @@ static const char * expand_time(
     return NULL;
   }
 
-  if (rcutils_char_array_strcat(logging_output, numeric_storage) != RCUTILS_RET_OK) {
+  if (rcutils_char_array_strncat(logging_output, numeric_storage, length) != RCUTILS_RET_OK) {
     RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
@@ -209,49 +738,27 @@ static const char * expand_time(
 
 static const char * expand_time_as_seconds(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
-  return expand_time(logging_input, logging_output, rcutils_time_point_value_as_seconds_string);
+  return expand_time(logging_input, logging_output, rcutils_time_point_value_format_seconds);
 }
 
 static const char * expand_time_as_nanoseconds(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
-  return expand_time(logging_input, logging_output, rcutils_time_point_value_as_nanoseconds_string);
+  return expand_time(
+    logging_input, logging_output, rcutils_time_point_value_format_nanoseconds);
 }
 
 static const char * expand_line_number(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
   if (logging_input->location) {
-    // Allow 9 digits for the expansion of the line number (otherwise, truncate).
-    char line_number_expansion[10];
-
-    // Even in the case of truncation the result will still be null-terminated.
-    int written = rcutils_snprintf(
-      line_number_expansion, sizeof(line_number_expansion), "%zu",
-      logging_input->location->line_number);
-    if (written < 0) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-        "failed to format line number: '%zu'\n", logging_input->location->line_number);
-      return NULL;
-    }
-
-    if (rcutils_char_array_strcat(logging_output, line_number_expansion) != RCUTILS_RET_OK) {
+    if (rcutils_char_array_append_uint(
+        logging_output, logging_input->location->line_number) != RCUTILS_RET_OK)
+    {
       RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
       rcutils_reset_error();
       RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
@@ -264,12 +771,8 @@ static const char * expand_line_number(
 
 static const char * expand_severity(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
   const char * severity_string = g_rcutils_log_severity_names[logging_input->severity];
   if (rcutils_char_array_strcat(logging_output, severity_string) != RCUTILS_RET_OK) {
     RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
@@ -283,12 +786,8 @@ static const char * expand_severity(
 
 static const char * expand_name(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
   if (NULL != logging_input->name) {
     if (rcutils_char_array_strcat(logging_output, logging_input->name) != RCUTILS_RET_OK) {
       RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
@@ -303,13 +802,19 @@ static const char * expand_name(
 
 static const char * expand_message(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
-  if (rcutils_char_array_strcat(logging_output, logging_input->msg) != RCUTILS_RET_OK) {
+  rcutils_ret_t status;
+  if (NULL != logging_input->msg) {
+    status = rcutils_char_array_strncat(
+      logging_output, logging_input->msg, logging_input->msg_length);
+  } else {
+    // The args may be expanded more than once, e.g. if {message} appears twice in the format,
+    // which is fine as rcutils_char_array_vstrcatf clones them.
+    status = rcutils_char_array_vstrcatf(
+      logging_output, logging_input->format, *logging_input->args);
+  }
+  if (status != RCUTILS_RET_OK) {
     RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
@@ -321,12 +826,8 @@ static const char * expand_message(
 
 static const char * expand_function_name(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
   if (logging_input->location) {
     if (rcutils_char_array_strcat(
         logging_output,
@@ -344,12 +845,8 @@ static const char * expand_function_name(
 
 static const char * expand_file_name(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)start_offset;
-  (void)end_offset;
-
   if (logging_input->location) {
     if (rcutils_char_array_strcat(
         logging_output,
@@ -393,54 +890,159 @@ static token_handler find_token_handler(const char * token)
   return NULL;
 }
 
-static const char * copy_from_orig(
+static const char * expand_json_line_number(
   const logging_input_t * logging_input,
-  rcutils_char_array_t * logging_output,
-  size_t start_offset, size_t end_offset)
+  rcutils_char_array_t * logging_output)
 {
-  (void)logging_input;
+  if (NULL == logging_input->location) {
+    if (rcutils_char_array_strcat(logging_output, "null") != RCUTILS_RET_OK) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      return NULL;
+    }
+    return logging_output->buffer;
+  }
+  return expand_line_number(logging_input, logging_output);
+}
 
-  if (rcutils_char_array_strncat(
-      logging_output,
-      g_rcutils_logging_output_format_string + start_offset,
-      end_offset - start_offset) != RCUTILS_RET_OK)
-  {
+static const char * expand_json_time(
+  const logging_input_t * logging_input,
+  rcutils_char_array_t * logging_output)
+{
+  // The time_as_nanoseconds token is zero padded, which is not a valid JSON number.
+  if (rcutils_char_array_append_int(logging_output, logging_input->timestamp) != RCUTILS_RET_OK) {
     RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     return NULL;
   }
-
   return logging_output->buffer;
 }
 
-static bool add_handler(token_handler handler, size_t start_offset, size_t end_offset)
+// Allocate a format with room for at most max_parts parts and max_literals_length characters of
+// literals, plus a null terminator.
+static log_msg_format_t * allocate_format(size_t max_parts, size_t max_literals_length)
 {
-  if (g_num_log_msg_handlers >= (sizeof(g_handlers) / sizeof(g_handlers[0]))) {
-    RCUTILS_SET_ERROR_MSG("Too many substitutions in the logging output format string; truncating");
-    return false;
+  const size_t parts_size = max_parts * sizeof(log_msg_part_t);
+  log_msg_format_t * format = g_rcutils_logging_allocator.allocate(
+    sizeof(log_msg_format_t) + parts_size + max_literals_length + 1u,
+    g_rcutils_logging_allocator.state);
+  if (NULL == format) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for the logging output format");
+    return NULL;
+  }
+  format->num_parts = 0u;
+  format->parts = (log_msg_part_t *)(format + 1);
+  format->literals = (char *)format->parts + parts_size;
+  format->literals[0] = '\0';
+  format->literals_length = 0u;
+  format->replaced = NULL;
+  return format;
+}
+
+// Append a literal, merged into the previous part if that is a literal too.
+// The caller allocated room enough for all the parts and literals.
+static void add_literal(log_msg_format_t * format, const char * literal, size_t length)
+{
+  if (0u == length) {
+    return;
   }
+  memcpy(format->literals + format->literals_length, literal, length);
+  if (format->num_parts > 0u && NULL == format->parts[format->num_parts - 1u].handler) {
+    format->parts[format->num_parts - 1u].literal_length += length;
+  } else {
+    log_msg_part_t * part = &format->parts[format->num_parts++];
+    part->handler = NULL;
+    part->literal_offset = format->literals_length;
+    part->literal_length = length;
+    part->escape = false;
+  }
+  format->literals_length += length;
+  format->literals[format->literals_length] = '\0';
+}
+
+static void add_token(log_msg_format_t * format, token_handler handler, bool escape)
+{
+  log_msg_part_t * part = &format->parts[format->num_parts++];
+  part->handler = handler;
+  part->literal_offset = 0u;
+  part->literal_length = 0u;
+  part->escape = escape;
+}
 
-  g_handlers[g_num_log_msg_handlers].handler = handler;
-  g_handlers[g_num_log_msg_handlers].start_offset = start_offset;
-  g_handlers[g_num_log_msg_handlers].end_offset = end_offset;
+typedef struct structured_output_field_s
+{
+  // The literal text before the field.
+  const char * prefix;
+  // NULL after the last field.
+  token_handler handler;
+  bool escape;
+} structured_output_field_t;
+
+static const structured_output_field_t json_output_fields[] = {
+  {"{\"time_as_nanoseconds\":", expand_json_time, false},
+  {",\"severity\":\"", expand_severity, false},
+  {"\",\"name\":\"", expand_name, true},
+  {"\",\"message\":\"", expand_message, true},
+  {"\",\"function_name\":\"", expand_function_name, true},
+  {"\",\"file_name\":\"", expand_file_name, true},
+  {"\",\"line_number\":", expand_json_line_number, false},
+  {"}", NULL, false},
+};
 
-  g_num_log_msg_handlers++;
+static const structured_output_field_t key_value_output_fields[] = {
+  {"time_as_nanoseconds=", expand_json_time, false},
+  {" severity=", expand_severity, false},
+  {" name=\"", expand_name, true},
+  {"\" message=\"", expand_message, true},
+  {"\" function_name=\"", expand_function_name, true},
+  {"\" file_name=\"", expand_file_name, true},
+  {"\" line_number=", expand_line_number, false},
+  {"", NULL, false},
+};
 
-  return true;
+// Compile a structured output, whose literal parts replace the format string.
+static log_msg_format_t * compile_structured_format(const structured_output_field_t * fields)
+{
+  size_t max_parts = 0u;
+  size_t max_literals_length = 0u;
+  for (const structured_output_field_t * field = fields; ; ++field) {
+    max_parts += 2u;
+    max_literals_length += strlen(field->prefix);
+    if (NULL == field->handler) {
+      break;
+    }
+  }
+  log_msg_format_t * format = allocate_format(max_parts, max_literals_length);
+  if (NULL == format) {
+    return NULL;
+  }
+  for (const structured_output_field_t * field = fields; ; ++field) {
+    add_literal(format, field->prefix, strlen(field->prefix));
+    if (NULL == field->handler) {
+      break;
+    }
+    add_token(format, field->handler, field->escape);
+  }
+  return format;
 }
 
-static void parse_and_create_handlers_list(void)
+// Compile the text format string, whose tokens are enclosed in braces, while anything which
+// isn't a known token is copied as is.
+static log_msg_format_t * compile_text_format(const char * str)
 {
+  const size_t size = strlen(str);
+  // Every part is made of at least one character of the format string.
+  log_msg_format_t * format = allocate_format(size, size);
+  if (NULL == format) {
+    return NULL;
+  }
+
   // Process the format string looking for known tokens.
   const char token_start_delimiter = '{';
   const char token_end_delimiter = '}';
 
-  const char * str = g_rcutils_logging_output_format_string;
-  size_t size = strlen(g_rcutils_logging_output_format_string);
-
-  g_num_log_msg_handlers = 0;
-
   // Walk through the format string and create callbacks when they're encountered.
   size_t i = 0;
   while (i < size) {
@@ -451,10 +1053,7 @@ static void parse_and_create_handlers_list(void)
     if (chars_to_start_delim > 0) {  // there is stuff before a token start delimiter
       size_t chars_to_copy = chars_to_start_delim >
         remaining_chars ? remaining_chars : chars_to_start_delim;
-      if (!add_handler(copy_from_orig, i, i + chars_to_copy)) {
-        // The error was already set by add_handler
-        return;
-      }
+      add_literal(format, str + i, chars_to_copy);
 
       i += chars_to_copy;
       if (i >= size) {  // perhaps no start delimiter was found
@@ -475,10 +1074,7 @@ static void parse_and_create_handlers_list(void)
     if (chars_to_end_delim > remaining_chars) {
       // No end delimiters found in the remainder of the format string;
       // there won't be any more tokens so shortcut the rest of the checking.
-      if (!add_handler(copy_from_orig, i, i + remaining_chars)) {
-        // The error was already set by add_handler
-        return;
-      }
+      add_literal(format, str + i, remaining_chars);
       break;
     }
 
@@ -492,40 +1088,126 @@ static void parse_and_create_handlers_list(void)
     if (!expand_token) {
       // This wasn't a token; print the start delimiter and continue the search as usual
       // (the substring might contain more start delimiters).
-      if (!add_handler(copy_from_orig, i, i + 1)) {
-        // The error was already set by add_handler
-        return;
-      }
+      add_literal(format, str + i, 1u);
       i++;
       continue;
     }
 
-    if (!add_handler(expand_token, 0, 0)) {
-      // The error was already set by add_handler
-      return;
-    }
+    add_token(format, expand_token, false);
 
     // Skip ahead to avoid re-processing the token characters (including the 2 delimiters).
     i += token_len + 2;
   }
+  return format;
 }
 
-rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allocator)
+static log_msg_format_t * compile_format(const char * str)
 {
-  if (g_rcutils_logging_initialized) {
-    return RCUTILS_RET_OK;
+  switch (g_rcutils_logging_output_structure) {
+    case LOGGING_OUTPUT_STRUCTURE_JSON:
+      return compile_structured_format(json_output_fields);
+    case LOGGING_OUTPUT_STRUCTURE_KEY_VALUE:
+      return compile_structured_format(key_value_output_fields);
+    case LOGGING_OUTPUT_STRUCTURE_TEXT:
+    default:
+      return compile_text_format(str);
   }
+}
 
-  if (!rcutils_allocator_is_valid(&allocator)) {
-    RCUTILS_SET_ERROR_MSG("Provided allocator is invalid.");
-    return RCUTILS_RET_INVALID_ARGUMENT;
+// Make the format the current one, keeping the one it replaces until shutdown.
+static void publish_format(log_msg_format_t * format)
+{
+  log_msg_format_t * current = NULL;
+  do {
+    current = atomic_load_acquire_format(&g_log_msg_format);
+    format->replaced = current;
+  } while (!atomic_compare_exchange_format(&g_log_msg_format, current, format));
+}
+
+static void fini_formats(void)
+{
+  log_msg_format_t * format = NULL;
+  do {
+    format = atomic_load_acquire_format(&g_log_msg_format);
+  } while (!atomic_compare_exchange_format(&g_log_msg_format, format, NULL));
+  while (NULL != format) {
+    log_msg_format_t * replaced = format->replaced;
+    g_rcutils_logging_allocator.deallocate(format, g_rcutils_logging_allocator.state);
+    format = replaced;
   }
-  g_rcutils_logging_allocator = allocator;
+}
 
-  g_rcutils_logging_output_handler = &rcutils_logging_console_output_handler;
-  g_rcutils_logging_default_logger_level = RCUTILS_DEFAULT_LOGGER_DEFAULT_LEVEL;
+static void resolve_output_colors(void);
 
-  const char * line_buffered = NULL;
+// Get a non-negative integer of at most max from an environment variable, or -1 if it is unset.
+static rcutils_ret_t get_env_count(const char * name, int64_t max, int64_t * value)
+{
+  const char * env_value = NULL;
+  const char * ret_str = rcutils_get_env(name, &env_value);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error getting environment variable %s: %s", name, ret_str);
+    return RCUTILS_RET_ERROR;
+  }
+  *value = -1;
+  if (strcmp(env_value, "") == 0) {
+    return RCUTILS_RET_OK;
+  }
+  char * end = NULL;
+  errno = 0;
+  long long count = strtoll(env_value, &end, 10);  // NOLINT(runtime/int)
+  if (0 != errno || end == env_value || '\0' != *end || count < 0 || count > max) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Invalid value [%s] specified for %s, which must be an integer from 0 to %" PRId64,
+      env_value, name, max);
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  *value = (int64_t)count;
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t set_stream_fully_buffered(FILE * stream, size_t size)
+{
+  char ** buffer = stream == stdout ? &g_stdout_buffer : &g_stderr_buffer;
+  size_t * buffer_size = stream == stdout ? &g_stdout_buffer_size : &g_stderr_buffer_size;
+  if (NULL == *buffer) {
+    // Not from the logging allocator, which may be gone while the stream still uses the buffer.
+    *buffer = malloc(size);
+    if (NULL == *buffer) {
+      RCUTILS_SET_ERROR_MSG("Failed to allocate the stream buffer");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    *buffer_size = size;
+  }
+  // Once the stream was written to, its buffer can't be replaced by a larger one: the buffer it
+  // got first is kept.
+  if (setvbuf(stream, *buffer, _IOFBF, *buffer_size) != 0) {
+    char error_string[1024];
+    rcutils_strerror(error_string, sizeof(error_string));
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error setting stream buffering mode: %s", error_string);
+    return RCUTILS_RET_ERROR;
+  }
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t initialize_with_allocator(rcutils_allocator_t allocator)
+{
+  if (g_rcutils_logging_initialized) {
+    return RCUTILS_RET_OK;
+  }
+
+  if (!rcutils_allocator_is_valid(&allocator)) {
+    RCUTILS_SET_ERROR_MSG("Provided allocator is invalid.");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  g_rcutils_logging_allocator = allocator;
+
+  g_rcutils_logging_output_handler = &rcutils_logging_console_output_handler;
+  atomic_store_release_int(
+    &g_rcutils_logging_default_logger_level, RCUTILS_DEFAULT_LOGGER_DEFAULT_LEVEL);
+
+  const char * line_buffered = NULL;
   const char * ret_str = rcutils_get_env("RCUTILS_CONSOLE_STDOUT_LINE_BUFFERED", &line_buffered);
   if (NULL != ret_str) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
@@ -562,6 +1244,29 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
       return RCUTILS_RET_ERROR;
   }
 
+  // Allow the user to fully buffer the stream, with a buffer of the given size, by setting
+  // RCUTILS_LOGGING_STREAM_BUFFER_SIZE, which takes precedence over the buffering below.
+  int64_t stream_buffer_size = -1;
+  if (RCUTILS_RET_OK != get_env_count(
+      "RCUTILS_LOGGING_STREAM_BUFFER_SIZE", INT_MAX, &stream_buffer_size))
+  {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (stream_buffer_size >= 0) {
+    // The buffer size cannot be less than 2 on Windows, see RCUTILS_LOGGING_STREAM_BUFFER_SIZE.
+    if (stream_buffer_size < 2) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "RCUTILS_LOGGING_STREAM_BUFFER_SIZE must be at least 2, not %" PRId64,
+        stream_buffer_size);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    rcutils_ret_t buffer_ret = set_stream_fully_buffered(
+      g_output_stream, (size_t)stream_buffer_size);
+    if (RCUTILS_RET_OK != buffer_ret) {
+      return buffer_ret;
+    }
+  }
+
   // Allow the user to choose how buffering on the stream works by setting
   // RCUTILS_LOGGING_BUFFERED_STREAM.
   // With an empty environment variable, use the default of the stream.
@@ -572,7 +1277,9 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
   if (RCUTILS_GET_ENV_ERROR == retval) {
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
-  if (RCUTILS_GET_ENV_ZERO == retval || RCUTILS_GET_ENV_ONE == retval) {
+  if (stream_buffer_size < 0 &&
+    (RCUTILS_GET_ENV_ZERO == retval || RCUTILS_GET_ENV_ONE == retval))
+  {
     int mode = retval == RCUTILS_GET_ENV_ZERO ? _IONBF : _IOLBF;
     size_t buffer_size = (mode == _IOLBF) ? RCUTILS_LOGGING_STREAM_BUFFER_SIZE : 0;
 
@@ -584,12 +1291,55 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
         "Error setting stream buffering mode: %s", error_string);
       return RCUTILS_RET_ERROR;
     }
-  } else if (RCUTILS_GET_ENV_EMPTY != retval) {
+  } else if (RCUTILS_GET_ENV_EMPTY != retval && RCUTILS_GET_ENV_ZERO != retval &&
+    RCUTILS_GET_ENV_ONE != retval)
+  {
     RCUTILS_SET_ERROR_MSG(
       "Invalid return from environment fetch");
     return RCUTILS_RET_ERROR;
   }
 
+  // A fully buffered stream is flushed according to the default policy, unless overridden by
+  // RCUTILS_LOGGING_FLUSH_INTERVAL_MS, RCUTILS_LOGGING_FLUSH_MESSAGE_COUNT and
+  // RCUTILS_LOGGING_FLUSH_SEVERITY.
+  rcutils_logging_flush_policy_t flush_policy = {0, 0u, RCUTILS_LOG_SEVERITY_UNSET};
+  if (stream_buffer_size >= 0) {
+    flush_policy = rcutils_logging_get_default_flush_policy();
+  }
+  int64_t flush_interval_ms = -1;
+  int64_t flush_message_count = -1;
+  if (RCUTILS_RET_OK != get_env_count(
+      "RCUTILS_LOGGING_FLUSH_INTERVAL_MS", INT64_MAX / RCUTILS_MS_TO_NS(1), &flush_interval_ms) ||
+    RCUTILS_RET_OK != get_env_count(
+      "RCUTILS_LOGGING_FLUSH_MESSAGE_COUNT", UINT32_MAX, &flush_message_count))
+  {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (flush_interval_ms >= 0) {
+    flush_policy.interval = RCUTILS_MS_TO_NS(flush_interval_ms);
+  }
+  if (flush_message_count >= 0) {
+    flush_policy.message_count = (uint32_t)flush_message_count;
+  }
+  const char * flush_severity = NULL;
+  ret_str = rcutils_get_env("RCUTILS_LOGGING_FLUSH_SEVERITY", &flush_severity);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error getting environment variable RCUTILS_LOGGING_FLUSH_SEVERITY: %s", ret_str);
+    return RCUTILS_RET_ERROR;
+  }
+  if (strcmp(flush_severity, "") != 0 &&
+    RCUTILS_RET_OK != rcutils_logging_severity_level_from_string(
+      flush_severity, allocator, &flush_policy.severity))
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Invalid severity [%s] specified for RCUTILS_LOGGING_FLUSH_SEVERITY", flush_severity);
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  // The policy is valid, as its interval isn't negative.
+  rcutils_ret_t flush_ret = rcutils_logging_set_flush_policy(&flush_policy);
+  (void)flush_ret;
+
   retval = rcutils_get_env_var_zero_or_one(
     "RCUTILS_COLORIZED_OUTPUT", "force color",
     "force no color");
@@ -625,17 +1375,96 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
     }
   }
 
+  char output_format_string[RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN];
   size_t chars_to_copy = strlen(output_format);
   if (chars_to_copy > RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN - 1) {
     chars_to_copy = RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN - 1;
   }
-  memcpy(g_rcutils_logging_output_format_string, output_format, chars_to_copy);
-  g_rcutils_logging_output_format_string[chars_to_copy] = '\0';
+  memcpy(output_format_string, output_format, chars_to_copy);
+  output_format_string[chars_to_copy] = '\0';
+
+  // Check for the environment variable replacing the output format with a structured one
+  g_rcutils_logging_output_structure = LOGGING_OUTPUT_STRUCTURE_TEXT;
+  const char * output_structure = NULL;
+  ret_str = rcutils_get_env("RCUTILS_CONSOLE_OUTPUT_STRUCTURE", &output_structure);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to get output structure from env. variable [%s]. Using the output format.",
+      ret_str);
+  } else if (strcmp(output_structure, "json") == 0) {
+    g_rcutils_logging_output_structure = LOGGING_OUTPUT_STRUCTURE_JSON;
+  } else if (strcmp(output_structure, "key_value") == 0) {
+    g_rcutils_logging_output_structure = LOGGING_OUTPUT_STRUCTURE_KEY_VALUE;
+  } else if (strcmp(output_structure, "") != 0 && strcmp(output_structure, "text") != 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Warning: unexpected value [%s] specified for RCUTILS_CONSOLE_OUTPUT_STRUCTURE. "
+      "Valid values are text, json or key_value. Using the output format.", output_structure);
+  }
+
+  // Optionally replace invalid UTF-8 in the strings of the structured output.
+  retval = rcutils_get_env_var_zero_or_one(
+    "RCUTILS_CONSOLE_OUTPUT_SANITIZE_UTF8", "strings as they are", "valid UTF-8 only");
+  if (RCUTILS_GET_ENV_ERROR == retval) {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  g_rcutils_logging_sanitize_utf8 = RCUTILS_GET_ENV_ONE == retval;
+
+  // The format is compiled once, so that formatting a message needn't parse it.
+  log_msg_format_t * format = compile_format(output_format_string);
+  if (NULL == format) {
+    return RCUTILS_RET_ERROR;
+  }
+  publish_format(format);
+
+  // Checking whether the stream is a terminal is a system call, so this isn't done per message.
+  resolve_output_colors();
+
+  // Check for the environment variable choosing the clock of the timestamps.
+  g_rcutils_logging_timestamp_source = RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE;
+  const char * timestamp_source = NULL;
+  ret_str = rcutils_get_env("RCUTILS_LOGGING_TIMESTAMP_SOURCE", &timestamp_source);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to get timestamp source from env. variable [%s]. Using the precise clock.",
+      ret_str);
+  } else if (strcmp(timestamp_source, "coarse") == 0) {
+    g_rcutils_logging_timestamp_source = RCUTILS_LOGGING_TIMESTAMP_SOURCE_COARSE;
+  } else if (strcmp(timestamp_source, "cached") == 0) {
+    g_rcutils_logging_timestamp_source = RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED;
+  } else if (strcmp(timestamp_source, "") != 0 && strcmp(timestamp_source, "precise") != 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Warning: unexpected value [%s] specified for RCUTILS_LOGGING_TIMESTAMP_SOURCE. "
+      "Valid values are precise, coarse or cached. Using the precise clock.", timestamp_source);
+  }
+
+  // Check for the environment variable enabling the suppression of repeated messages.
+  const char * repeat_interval = NULL;
+  ret_str = rcutils_get_env("RCUTILS_LOGGING_REPEAT_INTERVAL_MS", &repeat_interval);
+  if (NULL != ret_str) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to get repeat interval from env. variable [%s]. Not suppressing repeats.",
+      ret_str);
+  } else if (strcmp(repeat_interval, "") != 0) {
+    char * end = NULL;
+    errno = 0;
+    long long interval_ms = strtoll(repeat_interval, &end, 10);  // NOLINT(runtime/int)
+    if (0 != errno || end == repeat_interval || '\0' != *end || interval_ms < 0 ||
+      interval_ms > INT64_MAX / RCUTILS_MS_TO_NS(1))
+    {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Warning: unexpected value [%s] specified for RCUTILS_LOGGING_REPEAT_INTERVAL_MS. "
+        "It must be a number of milliseconds. Not suppressing repeats.", repeat_interval);
+    } else if (interval_ms > 0) {
+      rcutils_ret_t repeat_ret =
+        rcutils_logging_enable_repeat_suppression(RCUTILS_MS_TO_NS((int64_t)interval_ms));
+      (void)repeat_ret;
+    }
+  }
 
   g_rcutils_logging_severities_map = rcutils_get_zero_initialized_hash_map();
   rcutils_ret_t hash_map_ret = rcutils_hash_map_init(
     &g_rcutils_logging_severities_map, 2, sizeof(const char *), sizeof(int),
-    rcutils_hash_map_string_hash_func, rcutils_hash_map_string_cmp_func, &allocator);
+    rcutils_hash_map_string_fast_hash_func, rcutils_hash_map_string_cmp_func, &allocator);
   if (hash_map_ret != RCUTILS_RET_OK) {
     // If an error message was set it will have been overwritten by rcutils_hash_map_init.
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
@@ -644,57 +1473,406 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
     g_rcutils_logging_severities_map_valid = false;
     return RCUTILS_RET_ERROR;
   }
+  g_rcutils_logging_logger_names = rcutils_get_zero_initialized_string_pool();
+  if (rcutils_string_pool_init(&g_rcutils_logging_logger_names, &allocator) != RCUTILS_RET_OK) {
+    // Finalizing the empty map can't fail.
+    hash_map_ret = rcutils_hash_map_fini(&g_rcutils_logging_severities_map);
+    (void)hash_map_ret;
+    RCUTILS_SET_ERROR_MSG("Failed to initialize the pool of logger names");
+    g_rcutils_logging_severities_map_valid = false;
+    return RCUTILS_RET_ERROR;
+  }
+  if (rcutils_mutex_init(&g_rcutils_logging_levels_mutex) != RCUTILS_RET_OK) {
+    // Finalizing the empty map and pool can't fail.
+    hash_map_ret = rcutils_hash_map_fini(&g_rcutils_logging_severities_map);
+    (void)hash_map_ret;
+    rcutils_ret_t pool_ret = rcutils_string_pool_fini(&g_rcutils_logging_logger_names);
+    (void)pool_ret;
+    RCUTILS_SET_ERROR_MSG("Failed to initialize the mutex of logger severities");
+    g_rcutils_logging_severities_map_valid = false;
+    return RCUTILS_RET_ERROR;
+  }
 
-  parse_and_create_handlers_list();
+  if (!g_rcutils_logging_output_buffer_key_valid) {
+    // Without it the output handlers format on the stack instead, so this isn't fatal.
+    if (rcutils_thread_specific_init(
+        &g_rcutils_logging_output_buffer_key, destroy_thread_buffer_pool) == RCUTILS_RET_OK)
+    {
+      g_rcutils_logging_output_buffer_key_valid = true;
+    } else {
+      rcutils_reset_error();
+    }
+  }
 
   g_rcutils_logging_severities_map_valid = true;
+  invalidate_effective_level_cache();
 
   g_rcutils_logging_initialized = true;
+  // Published before the statistics and the asynchronous mode are enabled, since enabling them
+  // may log, which must not wait for this initialization to finish.
+  atomic_store_release_uint32(
+    &g_rcutils_logging_initialization_state, RCUTILS_LOGGING_INITIALIZED);
+
+  retval = rcutils_get_env_var_zero_or_one(
+    "RCUTILS_LOGGING_STATISTICS", "no statistics", "collect statistics");
+  switch (retval) {
+    case RCUTILS_GET_ENV_ERROR:
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    case RCUTILS_GET_ENV_EMPTY:
+    case RCUTILS_GET_ENV_ZERO:
+      break;
+    case RCUTILS_GET_ENV_ONE:
+      rcutils_logging_enable_statistics();
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG(
+        "Invalid return from environment fetch");
+      return RCUTILS_RET_ERROR;
+  }
+
+  // Optionally move the console output to a background thread.
+  retval = rcutils_get_env_var_zero_or_one(
+    "RCUTILS_LOGGING_ASYNC", "synchronous output", "asynchronous output");
+  switch (retval) {
+    case RCUTILS_GET_ENV_ERROR:
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    case RCUTILS_GET_ENV_EMPTY:
+    case RCUTILS_GET_ENV_ZERO:
+      break;
+    case RCUTILS_GET_ENV_ONE:
+      {
+        rcutils_logging_async_options_t async_options;
+        rcutils_ret_t async_ret = get_async_options_from_env(&async_options);
+        if (RCUTILS_RET_OK != async_ret) {
+          return async_ret;
+        }
+        async_ret = rcutils_logging_enable_async(&async_options);
+        if (RCUTILS_RET_OK != async_ret) {
+          return async_ret;
+        }
+      }
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG(
+        "Invalid return from environment fetch");
+      return RCUTILS_RET_ERROR;
+  }
 
   return RCUTILS_RET_OK;
 }
 
+static rcutils_ret_t fini_logger_handles(void);
+
+rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allocator)
+{
+  // Only one thread initializes, while the others which log first at the same time wait for it.
+  while (!atomic_compare_exchange_uint32(
+      &g_rcutils_logging_initialization_state, RCUTILS_LOGGING_UNINITIALIZED,
+      RCUTILS_LOGGING_INITIALIZING))
+  {
+    if (RCUTILS_LOGGING_INITIALIZED == RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(
+        &g_rcutils_logging_initialization_state))
+    {
+      return RCUTILS_RET_OK;
+    }
+    rcutils_thread_yield();
+  }
+  rcutils_ret_t ret = initialize_with_allocator(allocator);
+  // If it failed before being published, the next call tries again.
+  (void)atomic_compare_exchange_uint32(
+    &g_rcutils_logging_initialization_state, RCUTILS_LOGGING_INITIALIZING,
+    g_rcutils_logging_initialized ? RCUTILS_LOGGING_INITIALIZED : RCUTILS_LOGGING_UNINITIALIZED);
+  return ret;
+}
+
 rcutils_ret_t rcutils_logging_shutdown(void)
 {
   if (!g_rcutils_logging_initialized) {
     return RCUTILS_RET_OK;
   }
 
-  rcutils_ret_t ret = RCUTILS_RET_OK;
+  // Flush everything still queued before tearing anything else down.
+  rcutils_ret_t ret = rcutils_logging_disable_async();
+  rcutils_ret_t binary_ret = rcutils_logging_disable_binary();
+  if (RCUTILS_RET_OK != binary_ret) {
+    ret = binary_ret;
+  }
   if (g_rcutils_logging_severities_map_valid) {
-    // Iterate over the map, getting every key so we can free it
-    char * key = NULL;
-    int level;
-    rcutils_ret_t hash_map_ret = rcutils_hash_map_get_next_key_and_data(
-      &g_rcutils_logging_severities_map, NULL, &key, &level);
-    while (RCUTILS_RET_OK == hash_map_ret) {
-      hash_map_ret = rcutils_hash_map_unset(&g_rcutils_logging_severities_map, &key);
-      if (hash_map_ret != RCUTILS_RET_OK) {
-        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-          "Failed to clear out logger severities [%s] during shutdown; memory will be leaked.",
-          rcutils_get_error_string().str);
-        break;
-      }
-      g_rcutils_logging_allocator.deallocate(key, g_rcutils_logging_allocator.state);
-
-      hash_map_ret = rcutils_hash_map_get_next_key_and_data(
-        &g_rcutils_logging_severities_map, NULL, &key, &level);
-    }
-
-    hash_map_ret = rcutils_hash_map_fini(&g_rcutils_logging_severities_map);
+    // The keys of the map belong to the pool of logger names, which is finalized right after
+    rcutils_ret_t hash_map_ret = rcutils_hash_map_fini(&g_rcutils_logging_severities_map);
     if (hash_map_ret != RCUTILS_RET_OK) {
       RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
         "Failed to finalize map for logger severities: %s",
         rcutils_get_error_string().str);
       ret = RCUTILS_RET_LOGGING_SEVERITY_MAP_INVALID;
     }
+    rcutils_ret_t pool_ret = rcutils_string_pool_fini(&g_rcutils_logging_logger_names);
+    (void)pool_ret;
+    rcutils_logging_levels_fini(rcutils_logging_levels_publish(&g_rcutils_logging_levels, NULL));
+    g_rcutils_logging_levels_configured = false;
+    for (size_t i = 0; i < g_rcutils_logging_level_pattern_count; ++i) {
+      g_rcutils_logging_allocator.deallocate(
+        g_rcutils_logging_level_patterns[i].pattern, g_rcutils_logging_allocator.state);
+    }
+    g_rcutils_logging_allocator.deallocate(
+      g_rcutils_logging_level_patterns, g_rcutils_logging_allocator.state);
+    g_rcutils_logging_level_patterns = NULL;
+    g_rcutils_logging_level_pattern_count = 0;
+    g_rcutils_logging_level_pattern_capacity = 0;
+    rcutils_mutex_fini(&g_rcutils_logging_levels_mutex);
     g_rcutils_logging_severities_map_valid = false;
   }
-  g_num_log_msg_handlers = 0;
+  rcutils_ret_t handles_ret = fini_logger_handles();
+  if (RCUTILS_RET_OK != handles_ret) {
+    ret = handles_ret;
+  }
+  fini_formats();
+  g_rcutils_logging_num_sinks = 0;
+  g_rcutils_logging_sinks_min_severity = INT_MAX;
+  fini_thread_buffer_pool();
+  invalidate_effective_level_cache();
+  rcutils_logging_disable_statistics();
+  rcutils_logging_disable_repeat_suppression();
+  if (NULL != g_output_stream) {
+    (void)fflush(g_output_stream);
+  }
+  const rcutils_logging_flush_policy_t no_flush_policy = {0, 0u, RCUTILS_LOG_SEVERITY_UNSET};
+  rcutils_ret_t flush_ret = rcutils_logging_set_flush_policy(&no_flush_policy);
+  (void)flush_ret;
+  g_rcutils_logging_timestamp_source = RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE;
+  g_output_colorized = false;
   g_rcutils_logging_initialized = false;
+  atomic_store_release_uint32(
+    &g_rcutils_logging_initialization_state, RCUTILS_LOGGING_UNINITIALIZED);
+  return ret;
+}
+
+rcutils_logging_async_options_t rcutils_logging_get_default_async_options(void)
+{
+  rcutils_logging_async_options_t options = {
+    .queue_size = RCUTILS_LOGGING_ASYNC_DEFAULT_QUEUE_SIZE,
+    .record_size = RCUTILS_LOGGING_ASYNC_DEFAULT_RECORD_SIZE,
+    .overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP,
+    .consumer_thread_attributes = rcutils_get_default_thread_attributes(),
+  };
+  return options;
+}
+
+rcutils_ret_t rcutils_logging_enable_async(const rcutils_logging_async_options_t * options)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  rcutils_logging_async_options_t default_options = rcutils_logging_get_default_async_options();
+  if (NULL == options) {
+    options = &default_options;
+  }
+
+  rcutils_ret_t ret = rcutils_logging_disable_async();
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  // Anything already buffered in the stream must come out before the queued records.
+  (void)fflush(g_output_stream);
+  ret = rcutils_logging_async_writer_init(
+    &g_rcutils_logging_async_writer, options, g_output_stream, NULL,
+    g_rcutils_logging_allocator);
+  if (RCUTILS_RET_OK == ret &&
+    RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED == g_rcutils_logging_timestamp_source)
+  {
+    rcutils_logging_async_writer_set_time_refresh(
+      g_rcutils_logging_async_writer, RCUTILS_LOGGING_TIMESTAMP_CACHE_PERIOD_MS);
+  }
   return ret;
 }
 
+rcutils_ret_t rcutils_logging_disable_async(void)
+{
+  if (NULL == g_rcutils_logging_async_writer) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_ret_t ret = rcutils_logging_async_writer_fini(g_rcutils_logging_async_writer);
+  if (RCUTILS_RET_OK != ret) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to stop the asynchronous logging thread: %s", rcutils_get_error_string().str);
+    return ret;
+  }
+  g_rcutils_logging_async_writer = NULL;
+  return RCUTILS_RET_OK;
+}
+
+bool rcutils_logging_is_async(void)
+{
+  return NULL != g_rcutils_logging_async_writer;
+}
+
+size_t rcutils_logging_get_async_dropped_count(void)
+{
+  return rcutils_logging_async_writer_get_dropped_count(g_rcutils_logging_async_writer);
+}
+
+rcutils_ret_t rcutils_logging_set_timestamp_source(rcutils_logging_timestamp_source_t source)
+{
+  switch (source) {
+    case RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE:
+    case RCUTILS_LOGGING_TIMESTAMP_SOURCE_COARSE:
+    case RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED:
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("invalid logging timestamp source");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  atomic_store_release_uint32(&g_rcutils_logging_timestamp_source, (uint32_t)source);
+  rcutils_logging_async_writer_set_time_refresh(
+    g_rcutils_logging_async_writer,
+    RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED == source ?
+    RCUTILS_LOGGING_TIMESTAMP_CACHE_PERIOD_MS : 0u);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_logging_timestamp_source_t rcutils_logging_get_timestamp_source(void)
+{
+  return (rcutils_logging_timestamp_source_t)RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(
+    &g_rcutils_logging_timestamp_source);
+}
+
+rcutils_ret_t rcutils_logging_enable_repeat_suppression(rcutils_duration_value_t interval)
+{
+  if (interval <= 0) {
+    RCUTILS_SET_ERROR_MSG("the repeat interval must be positive");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  // Repeats of a previous interval would be reported with the wrong period.
+  if (0 == atomic_load_int64(&g_rcutils_logging_repeat_interval)) {
+    rcutils_logging_dedup_reset();
+  }
+  atomic_store_release_int64(&g_rcutils_logging_repeat_interval, interval);
+  return RCUTILS_RET_OK;
+}
+
+void rcutils_logging_disable_repeat_suppression(void)
+{
+  atomic_store_release_int64(&g_rcutils_logging_repeat_interval, 0);
+}
+
+rcutils_logging_flush_policy_t rcutils_logging_get_default_flush_policy(void)
+{
+  rcutils_logging_flush_policy_t policy = {
+    .interval = RCUTILS_MS_TO_NS(RCUTILS_LOGGING_DEFAULT_FLUSH_INTERVAL_MS),
+    .message_count = 0u,
+    .severity = RCUTILS_LOG_SEVERITY_WARN,
+  };
+  return policy;
+}
+
+rcutils_ret_t rcutils_logging_set_flush_policy(const rcutils_logging_flush_policy_t * policy)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(policy, RCUTILS_RET_INVALID_ARGUMENT);
+  if (policy->interval < 0) {
+    RCUTILS_SET_ERROR_MSG("the flush interval cannot be negative");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const uint32_t severity =
+    policy->severity > RCUTILS_LOG_SEVERITY_UNSET ? (uint32_t)policy->severity : 0u;
+  atomic_store_release_int64(&g_rcutils_logging_flush_interval, policy->interval);
+  atomic_store_release_uint32(&g_rcutils_logging_flush_message_count, policy->message_count);
+  atomic_store_release_uint32(&g_rcutils_logging_flush_severity, severity);
+  // The interval starts now rather than at the last flush of a previous policy.
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    rcutils_reset_error();
+  }
+  atomic_store_release_int64(&g_rcutils_logging_last_flush_time, now);
+  atomic_store_release_uint32(&g_rcutils_logging_unflushed_messages, 0u);
+  atomic_store_release_uint32(
+    &g_rcutils_logging_flush_enabled,
+    0 != policy->interval || 0u != policy->message_count || 0u != severity);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_logging_flush_policy_t rcutils_logging_get_flush_policy(void)
+{
+  rcutils_logging_flush_policy_t policy = {
+    .interval = atomic_load_int64(&g_rcutils_logging_flush_interval),
+    .message_count =
+      RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_flush_message_count),
+    .severity = (int)RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_flush_severity),
+  };
+  return policy;
+}
+
+// Flush the output stream after a message was written to it, if the flush policy says so.
+static void flush_output_if_due(int severity, rcutils_time_point_value_t timestamp)
+{
+  if (RCUTILS_LIKELY(
+      0u == RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_flush_enabled)))
+  {
+    return;
+  }
+  const uint32_t unflushed_messages =
+    atomic_add_fetch_uint32(&g_rcutils_logging_unflushed_messages, 1u);
+  const uint32_t flush_severity =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_flush_severity);
+  const uint32_t flush_message_count =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_flush_message_count);
+  const int64_t flush_interval = atomic_load_int64(&g_rcutils_logging_flush_interval);
+  // Concurrent messages may each decide to flush, which only costs an empty flush.
+  if ((0u != flush_severity && severity >= (int)flush_severity) ||
+    (0u != flush_message_count && unflushed_messages >= flush_message_count) ||
+    (0 != flush_interval &&
+    timestamp - atomic_load_int64(&g_rcutils_logging_last_flush_time) >= flush_interval))
+  {
+    atomic_store_release_uint32(&g_rcutils_logging_unflushed_messages, 0u);
+    atomic_store_release_int64(&g_rcutils_logging_last_flush_time, timestamp);
+    (void)fflush(g_output_stream);
+  }
+}
+
+uint32_t g_rcutils_logging_statistics_enabled = 0u;
+
+// Enable or disable the statistics, along with the uniform level which depends on it.
+static void set_statistics_enabled(uint32_t enabled)
+{
+  // The mutex only exists while the severities map is valid, otherwise there is no uniform level.
+  bool locked = g_rcutils_logging_severities_map_valid;
+  if (locked) {
+    rcutils_mutex_lock(&g_rcutils_logging_levels_mutex);
+  }
+  atomic_store_release_uint32(&g_rcutils_logging_statistics_enabled, enabled);
+  update_uniform_level();
+  if (locked) {
+    rcutils_mutex_unlock(&g_rcutils_logging_levels_mutex);
+  }
+}
+
+void rcutils_logging_enable_statistics(void)
+{
+  // Filtered messages are only counted when the logging macros don't skip them inline.
+  set_statistics_enabled(1u);
+}
+
+void rcutils_logging_disable_statistics(void)
+{
+  set_statistics_enabled(0u);
+}
+
+rcutils_ret_t rcutils_logging_get_statistics(rcutils_logging_statistics_t * statistics)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(statistics, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_logging_statistics_sum(statistics);
+  statistics->async_dropped_messages = (uint64_t)rcutils_logging_get_async_dropped_count();
+  return RCUTILS_RET_OK;
+}
+
+void rcutils_logging_reset_statistics(void)
+{
+  rcutils_logging_statistics_reset();
+}
+
+void rcutils_logging_count_filtered_message(void)
+{
+  rcutils_logging_statistics_add_filtered();
+}
+
 rcutils_ret_t
 rcutils_logging_severity_level_from_string(
   const char * severity_string, rcutils_allocator_t allocator, int * severity)
@@ -747,7 +1925,7 @@ void rcutils_logging_set_output_handler(rcutils_logging_output_handler_t functio
 int rcutils_logging_get_default_logger_level(void)
 {
   RCUTILS_LOGGING_AUTOINIT;
-  return g_rcutils_logging_default_logger_level;
+  return atomic_load_acquire_int(&g_rcutils_logging_default_logger_level);
 }
 
 void rcutils_logging_set_default_logger_level(int level)
@@ -757,7 +1935,16 @@ void rcutils_logging_set_default_logger_level(int level)
     // Restore the default
     level = RCUTILS_DEFAULT_LOGGER_DEFAULT_LEVEL;
   }
-  g_rcutils_logging_default_logger_level = level;
+  // The mutex only exists while the severities map is valid, otherwise there is no uniform level.
+  bool locked = g_rcutils_logging_severities_map_valid;
+  if (locked) {
+    rcutils_mutex_lock(&g_rcutils_logging_levels_mutex);
+  }
+  atomic_store_release_int(&g_rcutils_logging_default_logger_level, level);
+  invalidate_effective_level_cache();
+  if (locked) {
+    rcutils_mutex_unlock(&g_rcutils_logging_levels_mutex);
+  }
 }
 
 int rcutils_logging_get_logger_level(const char * name)
@@ -771,20 +1958,17 @@ int rcutils_logging_get_logger_level(const char * name)
 
 static rcutils_ret_t add_key_to_hash_map(const char * name, int level, bool set_by_user)
 {
-  const char * copy_name = name;
-  // Check if key already exists, to avoid extra memory allocation
-  // If the key already exists, then rcutils_hash_map_set will not maintain the key we give it,
-  // so we do not need to copy the name
-  bool already_exists = rcutils_hash_map_key_exists(&g_rcutils_logging_severities_map, &copy_name);
-
-  if (!already_exists) {
-    // Copy the name to be stored, as there is no guarantee that the caller will keep it around.
-    copy_name = rcutils_strdup(name, g_rcutils_logging_allocator);
-    if (copy_name == NULL) {
-      // Don't report an error to the error handling machinery; some uses of this function are for
-      // caching so this is not necessarily fatal.
-      return RCUTILS_RET_ERROR;
-    }
+  // Intern the name to be stored, as there is no guarantee that the caller will keep it around.
+  // The pool also gives its hash, which is the one of the map, so that it isn't hashed again.
+  const char * interned_name = NULL;
+  size_t name_hash = 0;
+  if (rcutils_string_pool_intern(
+      &g_rcutils_logging_logger_names, name, &interned_name, &name_hash) != RCUTILS_RET_OK)
+  {
+    // Don't report an error to the error handling machinery; some uses of this function are for
+    // caching so this is not necessarily fatal.
+    rcutils_reset_error();
+    return RCUTILS_RET_ERROR;
   }
 
   if (set_by_user) {
@@ -794,8 +1978,8 @@ static rcutils_ret_t add_key_to_hash_map(const char * name, int level, bool set_
     level |= 0x1;
   }
 
-  rcutils_ret_t hash_map_ret =
-    rcutils_hash_map_set(&g_rcutils_logging_severities_map, &copy_name, &level);
+  rcutils_ret_t hash_map_ret = rcutils_hash_map_set_with_hash(
+    &g_rcutils_logging_severities_map, &interned_name, name_hash, &level);
   if (hash_map_ret != RCUTILS_RET_OK) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Error setting severity level for logger named '%s': %s",
@@ -806,21 +1990,6 @@ static rcutils_ret_t add_key_to_hash_map(const char * name, int level, bool set_
   return RCUTILS_RET_OK;
 }
 
-static rcutils_ret_t get_severity_level(const char * name, int * severity)
-{
-  rcutils_ret_t ret =
-    rcutils_hash_map_get(&g_rcutils_logging_severities_map, &name, severity);
-  if (ret != RCUTILS_RET_OK) {
-    // One possible response is RCUTILS_RET_NOT_FOUND, but the higher layers may be OK with that.
-    return ret;
-  }
-
-  // See the comment in add_key_to_hash_map() on why we remove the bottom bit.
-  (*severity) &= ~(0x1);
-
-  return RCUTILS_RET_OK;
-}
-
 int rcutils_logging_get_logger_leveln(const char * name, size_t name_length)
 {
   RCUTILS_LOGGING_AUTOINIT;
@@ -831,136 +2000,84 @@ int rcutils_logging_get_logger_leveln(const char * name, size_t name_length)
   // Skip the map lookup if the default was requested,
   // as it can still be used even if the severity map is invalid.
   if (0 == name_length) {
-    return g_rcutils_logging_default_logger_level;
-  }
-  if (!g_rcutils_logging_severities_map_valid) {
-    return RCUTILS_LOG_SEVERITY_UNSET;
+    return atomic_load_acquire_int(&g_rcutils_logging_default_logger_level);
   }
-
-  char * short_name = rcutils_strndup(name, name_length, g_rcutils_logging_allocator);
-  if (short_name == NULL) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Failed to allocate memory when looking up logger level for '%s'", name);
-    return -1;
+  // The name may be shorter than name_length.
+  const char * end = memchr(name, '\0', name_length);
+  if (NULL != end) {
+    name_length = (size_t)(end - name);
   }
 
-  int severity;
-  rcutils_ret_t ret = get_severity_level(short_name, &severity);
-  g_rcutils_logging_allocator.deallocate(short_name, g_rcutils_logging_allocator.state);
-  if (ret != RCUTILS_RET_OK) {
-    // The error message was already set by get_severity_level
-    return RCUTILS_LOG_SEVERITY_UNSET;
+  int severity = RCUTILS_LOG_SEVERITY_UNSET;
+  size_t reader_slot;
+  const rcutils_logging_levels_t * levels =
+    rcutils_logging_levels_read_begin(&g_rcutils_logging_levels, &reader_slot);
+  if (NULL != levels) {
+    severity = rcutils_logging_levels_find(
+      levels, name, name_length, rcutils_logging_levels_hash(name, name_length));
   }
+  rcutils_logging_levels_read_end(&g_rcutils_logging_levels, reader_slot);
 
   return severity;
 }
 
+static int get_logger_effective_level(const char * name, size_t name_length, size_t hash);
+
 int rcutils_logging_get_logger_effective_level(const char * name)
 {
   RCUTILS_LOGGING_AUTOINIT;
   if (NULL == name) {
     return -1;
   }
+  size_t name_length;
+  size_t hash = hash_logger_name(name, &name_length);
+  return get_logger_effective_level(name, name_length, hash);
+}
 
-  size_t hash_map_size;
-  rcutils_ret_t hash_map_ret = rcutils_hash_map_get_size(
-    &g_rcutils_logging_severities_map, &hash_map_size);
-  if (hash_map_ret != RCUTILS_RET_OK) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Error getting severity level for logger named '%s': %s",
-      name, rcutils_get_error_string().str);
-    return -1;
-  }
-
-  if (hash_map_size == 0) {
-    // The reason we do this extra check here is a bit tricky.  The call to get_severity_level()
-    // below calls rcutils_hash_map_get(), which already has an optimization to return early if
-    // there are no entries in the map.  However, the rest of this function doesn't know how to
-    // disambiguate between not finding this particular name in the map and there being no items in
-    // the map.  In the former case, we need to do the additional work of looking through the
-    // hierarchy of loggers, while in the latter case we can short-circuit.  To keep this function
-    // fast in the latter case, we do the disambiguation here.
-    return g_rcutils_logging_default_logger_level;
+// Resolve the effective level of a logger whose name hash and length are already known.
+static int get_logger_effective_level(const char * name, size_t name_length, size_t hash)
+{
+  // Check whether this thread already resolved the level of this logger since the last change.
+  // The generation is read before the levels, so that levels published concurrently are tagged
+  // with the old generation.
+  uint32_t generation =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_level_generation);
+  effective_level_cache_entry_t * cache_entry = get_effective_level_cache_entry(hash);
+  if (NULL != cache_entry && cache_entry->generation == generation &&
+    cache_entry->hash == hash && strcmp(cache_entry->name, name) == 0)
+  {
+    return cache_entry->level;
   }
 
-  // Start by trying to find the exact name.
-  int severity;
-  rcutils_ret_t ret = get_severity_level(name, &severity);
-  if (ret == RCUTILS_RET_OK) {
-    if (severity != RCUTILS_LOG_SEVERITY_UNSET) {
-      return severity;
-    }
-    // If the severity is UNSET, then we go through the slow path and try to find a parent logger
-    // that is set.  Failing that, we fall back to the default logger level.
-  } else if (ret != RCUTILS_RET_NOT_FOUND) {
-    // The error message was already set by get_severity_level
-    return -1;
+  int severity = RCUTILS_LOG_SEVERITY_UNSET;
+  size_t reader_slot;
+  const rcutils_logging_levels_t * levels =
+    rcutils_logging_levels_read_begin(&g_rcutils_logging_levels, &reader_slot);
+  if (NULL != levels) {
+    // Find the level of the name itself, or else of its closest ancestor which has one.
+    severity = rcutils_logging_levels_find_closest(levels, name, name_length, hash);
   }
+  rcutils_logging_levels_read_end(&g_rcutils_logging_levels, reader_slot);
 
-  // Since we didn't find the name in the fast path, fall back to the slow path where we break the
-  // string into substrings based on dots and look for any part that matches.
-
-  size_t substring_length = strlen(name);
-  char * tmp_name = rcutils_strdup(name, g_rcutils_logging_allocator);
-  if (tmp_name == NULL) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-      "Error copying string '%s'\n", name);
-    return -1;
+  if (severity == RCUTILS_LOG_SEVERITY_UNSET) {
+    // Neither the logger nor its ancestors have had their level specified.
+    severity = atomic_load_acquire_int(&g_rcutils_logging_default_logger_level);
   }
 
-  severity = RCUTILS_LOG_SEVERITY_UNSET;
-
-  while (true) {
-    // Determine the next ancestor's FQN by removing the child's name.
-    size_t index_last_separator = rcutils_find_lastn(
-      name, RCUTILS_LOGGING_SEPARATOR_CHAR, substring_length);
-    if (SIZE_MAX == index_last_separator) {
-      // There are no more separators in the substring, so this is the last name we needed to check.
-      break;
-    }
-
-    substring_length = index_last_separator;
-
-    // Shorten the substring to be the name of the ancestor (excluding the separator).
-    tmp_name[index_last_separator] = '\0';
-
-    rcutils_ret_t ret = get_severity_level(tmp_name, &severity);
-    if (ret == RCUTILS_RET_OK) {
-      if (severity != RCUTILS_LOG_SEVERITY_UNSET) {
-        break;
-      }
-    } else if (ret != RCUTILS_RET_NOT_FOUND) {
-      // The error message was already set by get_severity_level
-      g_rcutils_logging_allocator.deallocate(tmp_name, g_rcutils_logging_allocator.state);
-      return -1;
-    }
+  // Remember the result for next time, unless the name is too long for the cache.
+  if (NULL != cache_entry && name_length <= RCUTILS_LOGGING_EFFECTIVE_LEVEL_CACHE_MAX_NAME_LEN) {
+    memcpy(cache_entry->name, name, name_length + 1);
+    cache_entry->hash = hash;
+    cache_entry->level = severity;
+    cache_entry->generation = generation;
   }
 
-  g_rcutils_logging_allocator.deallocate(tmp_name, g_rcutils_logging_allocator.state);
-
-  if (severity == RCUTILS_LOG_SEVERITY_UNSET) {
-    // Neither the logger nor its ancestors have had their level specified.
-    severity = g_rcutils_logging_default_logger_level;
-  }
-
-  // TODO(wjwwood): restore or replace this optimization when thread-safety is addressed
-  //   see: https://github.com/ros2/rcutils/pull/393
-  // // If the calculated severity is anything but UNSET, we place it into the hashmap for speedier
-  // // lookup next time.  If the severity is UNSET, we don't bother because we are going to have to
-  // // walk the hierarchy next time anyway.
-  // if (severity != RCUTILS_LOG_SEVERITY_UNSET) {
-  //   ret = add_key_to_hash_map(name, severity, false);
-  //   if (ret != RCUTILS_RET_OK) {
-  //     // Continue on if we failed to add the key to the hashmap.
-  //     // This will affect performance but is not fatal.
-  //     RCUTILS_SAFE_FWRITE_TO_STDERR(
-  //       "Failed to cache severity; this is not fatal but will impact performance\n");
-  //   }
-  // }
-
   return severity;
 }
 
+static rcutils_ret_t set_severity_in_map(const char * name, int level);
+static rcutils_ret_t publish_logger_levels(void);
+
 rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
 {
   RCUTILS_LOGGING_AUTOINIT;
@@ -988,362 +2105,1523 @@ rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
 
-  size_t name_length = strlen(name);
-
-  if (rcutils_hash_map_key_exists(&g_rcutils_logging_severities_map, &name)) {
-    // Iterate over the entire contents of the severities map, looking for entries that start with
-    // this key name.  For any ones that match, check whether the user explicitly set them.  If the
-    // user did not set it, then we cached it and so we can throw it away.
-
-    char * key = NULL;
-    int tmp_level;
-
-    rcutils_ret_t hash_map_ret = rcutils_hash_map_get_next_key_and_data(
-      &g_rcutils_logging_severities_map, NULL, &key, &tmp_level);
-    while (RCUTILS_RET_OK == hash_map_ret) {
-      // Hold onto a reference to the pointer; we'll need it later
-      char * previous_key = key;
-      bool free_current_key = false;
-      if (key != NULL && strncmp(name, key, name_length) == 0) {
-        // If this is the key we are replacing, unconditionally remove it from the hash map;
-        // we'll be adding it back as a user-set level anyway
-        if (key[name_length] == '\0') {
-          free_current_key = true;
-        } else {
-          // Otherwise, this is a descendant; only remove it from the hash map
-          // if we cached it (the user didn't explicitly set it).
-          if (!(tmp_level & 0x1)) {
-            free_current_key = true;
-          }
-        }
-      }
+  rcutils_mutex_lock(&g_rcutils_logging_levels_mutex);
+  rcutils_ret_t ret = set_severity_in_map(name, level);
+  // Publish whatever the map holds now, even if it could only be changed partially.
+  rcutils_ret_t publish_ret = publish_logger_levels();
+  if (RCUTILS_RET_OK == ret) {
+    ret = publish_ret;
+  }
+  if ('\0' == name[0]) {
+    // If the name was empty, this also means we should update the default logger level
+    atomic_store_release_int(&g_rcutils_logging_default_logger_level, level);
+  }
+  // The effective level of any descendant may have changed.
+  invalidate_effective_level_cache();
+  rcutils_mutex_unlock(&g_rcutils_logging_levels_mutex);
 
-      // Note that we need to get the next key before we free the current
-      // key so that we can continue iterating over the hash_map
-      hash_map_ret = rcutils_hash_map_get_next_key_and_data(
-        &g_rcutils_logging_severities_map, &previous_key, &key, &tmp_level);
-      if (hash_map_ret != RCUTILS_RET_OK &&
-        hash_map_ret != RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES &&
-        hash_map_ret != RCUTILS_RET_NOT_FOUND)
-      {
-        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-          "Error accessing hash map when setting logger level for '%s': %s",
-          name, rcutils_get_error_string().str);
-        return hash_map_ret;
-      }
+  return ret;
+}
 
-      if (free_current_key) {
-        rcutils_ret_t unset_ret = rcutils_hash_map_unset(
-          &g_rcutils_logging_severities_map, &previous_key);
-        if (unset_ret != RCUTILS_RET_OK) {
-          // The only way that hash_map_unset can fail is if there is something wrong with the
-          // hashmap structure or the key is NULL.  Since we don't expect either, report it as an
-          // error and return.
-          RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-            "Error clearing old severity level for logger named '%s': %s",
-            name, rcutils_get_error_string().str);
-          return unset_ret;
-        }
-        g_rcutils_logging_allocator.deallocate(previous_key, g_rcutils_logging_allocator.state);
-      }
+rcutils_ret_t rcutils_logging_set_logger_levels(
+  const char * const * names, const int * levels, size_t count)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  if (0 == count) {
+    return RCUTILS_RET_OK;
+  }
+  if (NULL == names || NULL == levels) {
+    RCUTILS_SET_ERROR_MSG("Invalid logger names or levels");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  // Validate everything first, so that invalid arguments change no level at all.
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == names[i]) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Invalid logger name at index %zu", i);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    if (levels[i] < 0 ||
+      levels[i] >=
+      (int)(sizeof(g_rcutils_log_severity_names) / sizeof(g_rcutils_log_severity_names[0])) ||
+      NULL == g_rcutils_log_severity_names[levels[i]])
+    {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Invalid severity level specified for logger '%s'", names[i]);
+      return RCUTILS_RET_INVALID_ARGUMENT;
     }
   }
 
-  rcutils_ret_t add_key_ret = add_key_to_hash_map(name, level, true);
-  if (add_key_ret != RCUTILS_RET_OK) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Error setting severity level for logger named '%s': %s",
-      name, rcutils_get_error_string().str);
+  if (!g_rcutils_logging_severities_map_valid) {
+    RCUTILS_SET_ERROR_MSG("Logger severity level map is invalid");
+    return RCUTILS_RET_LOGGING_SEVERITY_MAP_INVALID;
   }
 
-  if (name_length == 0) {
-    // If the name was empty, this also means we should update the default logger level
-    g_rcutils_logging_default_logger_level = level;
+  rcutils_mutex_lock(&g_rcutils_logging_levels_mutex);
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0; i < count && RCUTILS_RET_OK == ret; ++i) {
+    ret = set_severity_in_map(names[i], levels[i]);
+    if (RCUTILS_RET_OK == ret && '\0' == names[i][0]) {
+      atomic_store_release_int(&g_rcutils_logging_default_logger_level, levels[i]);
+    }
+  }
+  // Publish whatever the map holds now, once for all the levels, even if it could only be
+  // changed partially.
+  rcutils_ret_t publish_ret = publish_logger_levels();
+  if (RCUTILS_RET_OK == ret) {
+    ret = publish_ret;
   }
+  // The effective level of any descendant may have changed.
+  invalidate_effective_level_cache();
+  rcutils_mutex_unlock(&g_rcutils_logging_levels_mutex);
 
-  return add_key_ret;
+  return ret;
 }
 
-bool rcutils_logging_logger_is_enabled_for(const char * name, int severity)
+static rcutils_ret_t set_level_pattern(const char * pattern, int level);
+
+rcutils_ret_t rcutils_logging_set_logger_level_pattern(const char * pattern, int level)
 {
   RCUTILS_LOGGING_AUTOINIT;
-  int logger_level = g_rcutils_logging_default_logger_level;
-  if (name) {
-    logger_level = rcutils_logging_get_logger_effective_level(name);
-    if (-1 == logger_level) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-        "Error determining if logger '%s' is enabled for severity '%d'\n",
-        name, severity);
-      return false;
+  if (NULL == pattern || !rcutils_logging_levels_is_pattern(pattern)) {
+    RCUTILS_SET_ERROR_MSG("Invalid logger name pattern");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (level < 0 ||
+    level >=
+    (int)(sizeof(g_rcutils_log_severity_names) / sizeof(g_rcutils_log_severity_names[0])) ||
+    NULL == g_rcutils_log_severity_names[level])
+  {
+    RCUTILS_SET_ERROR_MSG("Invalid severity level specified for logger name pattern");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  if (!g_rcutils_logging_severities_map_valid) {
+    RCUTILS_SET_ERROR_MSG("Logger severity level map is invalid");
+    return RCUTILS_RET_LOGGING_SEVERITY_MAP_INVALID;
+  }
+
+  rcutils_mutex_lock(&g_rcutils_logging_levels_mutex);
+  rcutils_ret_t ret = set_level_pattern(pattern, level);
+  if (RCUTILS_RET_OK == ret) {
+    ret = publish_logger_levels();
+  }
+  // The effective level of any logger may have changed.
+  invalidate_effective_level_cache();
+  rcutils_mutex_unlock(&g_rcutils_logging_levels_mutex);
+
+  return ret;
+}
+
+// Set or remove a level pattern, moving it after all others, with the levels mutex held.
+static rcutils_ret_t set_level_pattern(const char * pattern, int level)
+{
+  char * pattern_copy = NULL;
+  for (size_t i = 0; i < g_rcutils_logging_level_pattern_count; ++i) {
+    if (strcmp(g_rcutils_logging_level_patterns[i].pattern, pattern) == 0) {
+      pattern_copy = g_rcutils_logging_level_patterns[i].pattern;
+      memmove(
+        &g_rcutils_logging_level_patterns[i], &g_rcutils_logging_level_patterns[i + 1],
+        (g_rcutils_logging_level_pattern_count - i - 1) * sizeof(logging_level_pattern_t));
+      --g_rcutils_logging_level_pattern_count;
+      break;
     }
   }
-  return severity >= logger_level;
+
+  if (RCUTILS_LOG_SEVERITY_UNSET == level) {
+    if (NULL != pattern_copy) {
+      g_rcutils_logging_allocator.deallocate(pattern_copy, g_rcutils_logging_allocator.state);
+    }
+    return RCUTILS_RET_OK;
+  }
+
+  if (NULL == pattern_copy) {
+    pattern_copy = rcutils_strdup(pattern, g_rcutils_logging_allocator);
+    if (NULL == pattern_copy) {
+      RCUTILS_SET_ERROR_MSG("Failed to allocate memory for logger name pattern");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  if (g_rcutils_logging_level_pattern_count == g_rcutils_logging_level_pattern_capacity) {
+    size_t capacity = 2 * g_rcutils_logging_level_pattern_capacity;
+    if (0 == capacity) {
+      capacity = 4;
+    }
+    logging_level_pattern_t * patterns = g_rcutils_logging_allocator.reallocate(
+      g_rcutils_logging_level_patterns, capacity * sizeof(logging_level_pattern_t),
+      g_rcutils_logging_allocator.state);
+    if (NULL == patterns) {
+      g_rcutils_logging_allocator.deallocate(pattern_copy, g_rcutils_logging_allocator.state);
+      RCUTILS_SET_ERROR_MSG("Failed to allocate memory for logger name patterns");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    g_rcutils_logging_level_patterns = patterns;
+    g_rcutils_logging_level_pattern_capacity = capacity;
+  }
+  g_rcutils_logging_level_patterns[g_rcutils_logging_level_pattern_count].pattern = pattern_copy;
+  g_rcutils_logging_level_patterns[g_rcutils_logging_level_pattern_count].level = level;
+  ++g_rcutils_logging_level_pattern_count;
+  return RCUTILS_RET_OK;
 }
 
-static void vrcutils_log_internal(
-  const rcutils_log_location_t * location,
-  int severity, const char * name, const char * format, va_list * args)
+// Publish a copy of the levels in the severities map, with the levels mutex held.
+static rcutils_ret_t publish_logger_levels(void)
 {
-  rcutils_time_point_value_t now;
-  rcutils_ret_t ret = rcutils_system_time_now(&now);
-  if (ret != RCUTILS_RET_OK) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to get timestamp while doing a console logging.\n");
-    return;
+  // Loggers whose level is unset are left out, as looking them up has the same result.
+  size_t count = 0;
+  // The level of the default logger, whose name is empty, only applies to the default logger.
+  bool configured = g_rcutils_logging_level_pattern_count > 0;
+  size_t segment_count = 0;
+  size_t names_length = 0;
+  char * key = NULL;
+  int level;
+  rcutils_hash_map_iterator_t iterator;
+  rcutils_ret_t hash_map_ret = rcutils_hash_map_iterator_begin(
+    &g_rcutils_logging_severities_map, &iterator, &key, &level);
+  while (RCUTILS_RET_OK == hash_map_ret) {
+    if ((level & ~0x1) != RCUTILS_LOG_SEVERITY_UNSET) {
+      ++count;
+      configured = configured || '\0' != key[0];
+      segment_count += rcutils_logging_levels_count_segments(key);
+      names_length += strlen(key);
+    }
+    hash_map_ret = rcutils_hash_map_iterator_next(
+      &g_rcutils_logging_severities_map, &iterator, &key, &level);
   }
-  rcutils_logging_output_handler_t output_handler = g_rcutils_logging_output_handler;
-  if (output_handler != NULL) {
-    (*output_handler)(location, severity, name ? name : "", now, format, args);
+  if (RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES != hash_map_ret) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error accessing hash map when publishing logger levels: %s",
+      rcutils_get_error_string().str);
+    return hash_map_ret;
+  }
+
+  size_t pattern_segment_count = 0;
+  size_t patterns_length = 0;
+  for (size_t i = 0; i < g_rcutils_logging_level_pattern_count; ++i) {
+    pattern_segment_count +=
+      rcutils_logging_levels_count_segments(g_rcutils_logging_level_patterns[i].pattern);
+    patterns_length += strlen(g_rcutils_logging_level_patterns[i].pattern);
+  }
+
+  rcutils_logging_levels_t * levels = NULL;
+  rcutils_ret_t ret = rcutils_logging_levels_init(
+    &levels, count, segment_count, names_length, g_rcutils_logging_level_pattern_count,
+    pattern_segment_count, patterns_length, g_rcutils_logging_allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
   }
+  hash_map_ret = rcutils_hash_map_iterator_begin(
+    &g_rcutils_logging_severities_map, &iterator, &key, &level);
+  while (RCUTILS_RET_OK == hash_map_ret) {
+    // See the comment in add_key_to_hash_map() on why we remove the bottom bit.
+    level &= ~0x1;
+    if (level != RCUTILS_LOG_SEVERITY_UNSET) {
+      rcutils_logging_levels_add(levels, key, level);
+    }
+    hash_map_ret = rcutils_hash_map_iterator_next(
+      &g_rcutils_logging_severities_map, &iterator, &key, &level);
+  }
+  for (size_t i = 0; i < g_rcutils_logging_level_pattern_count; ++i) {
+    rcutils_logging_levels_add_pattern(
+      levels, g_rcutils_logging_level_patterns[i].pattern,
+      g_rcutils_logging_level_patterns[i].level);
+  }
+
+  rcutils_logging_levels_fini(rcutils_logging_levels_publish(&g_rcutils_logging_levels, levels));
+  g_rcutils_logging_levels_configured = configured;
+  return RCUTILS_RET_OK;
 }
 
-void rcutils_log(
-  const rcutils_log_location_t * location,
-  int severity, const char * name, const char * format, ...)
+// Set the level of a logger in the severities map, with the levels mutex held.
+static rcutils_ret_t set_severity_in_map(const char * name, int level)
 {
-  if (!rcutils_logging_logger_is_enabled_for(name, severity)) {
-    return;
+  // The map only holds the levels set by the user, the levels resolved for other loggers being
+  // cached per thread, so there are no cached descendants to purge, and setting the level of a
+  // logger which has one replaces it without walking the map.
+  rcutils_ret_t add_key_ret = add_key_to_hash_map(name, level, true);
+  if (add_key_ret != RCUTILS_RET_OK) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error setting severity level for logger named '%s': %s",
+      name, rcutils_get_error_string().str);
   }
+  return add_key_ret;
+}
 
-  va_list args;
-  va_start(args, format);
-  vrcutils_log_internal(location, severity, name, format, &args);
-  va_end(args);
+bool rcutils_logging_claim_first_evaluation(uint32_t * flag)
+{
+  return atomic_compare_exchange_uint32(flag, 0u, 1u);
 }
 
-void rcutils_log_internal(
-  const rcutils_log_location_t * location,
-  int severity, const char * name, const char * format, ...)
+bool rcutils_logging_claim_throttle_window(
+  rcutils_time_point_value_t * last_logged, rcutils_time_point_value_t now,
+  rcutils_duration_value_t duration)
 {
-  va_list args;
-  va_start(args, format);
-  vrcutils_log_internal(location, severity, name, format, &args);
-  va_end(args);
+  rcutils_time_point_value_t previous = atomic_load_int64(last_logged);
+  // Only the thread replacing the time point it compared against opens the new window.
+  return now >= previous + duration && atomic_compare_exchange_int64(last_logged, previous, now);
 }
 
-rcutils_ret_t rcutils_logging_format_message(
-  const rcutils_log_location_t * location,
-  int severity, const char * name, rcutils_time_point_value_t timestamp,
-  const char * msg, rcutils_char_array_t * logging_output)
+bool rcutils_logging_sample_every(uint32_t * counter, uint32_t n)
 {
-  const logging_input_t logging_input = {
-    .location = location,
-    .severity = severity,
-    .name = name,
-    .timestamp = timestamp,
-    .msg = msg
-  };
+  const uint32_t count = atomic_add_fetch_uint32(counter, 1u) - 1u;
+  return n <= 1u || 0u == count % n;
+}
 
-  for (size_t i = 0; i < g_num_log_msg_handlers; ++i) {
-    if (g_handlers[i].handler(
-        &logging_input, logging_output,
-        g_handlers[i].start_offset, g_handlers[i].end_offset) == NULL)
-    {
-      return RCUTILS_RET_ERROR;
-    }
-  }
+// The increment of the SplitMix64 generator, the golden ratio as a 64 bit fraction.
+#define RCUTILS_LOGGING_SAMPLE_STATE_INCREMENT (0x9e3779b97f4a7c15ull)
 
-  return RCUTILS_RET_OK;
+static uint64_t mix_sample_state(uint64_t state)
+{
+  state = (state ^ (state >> 30)) * 0xbf58476d1ce4e5b9ull;
+  state = (state ^ (state >> 27)) * 0x94d049bb133111ebull;
+  return state ^ (state >> 31);
 }
 
-#ifdef _WIN32
-# define COLOR_NORMAL 7
-# define COLOR_RED 4
-# define COLOR_GREEN 2
-# define COLOR_YELLOW 6
-# define IS_STREAM_A_TTY(stream) (_isatty(_fileno(stream)) != 0)
+#ifdef RCUTILS_THREAD_LOCAL
+// Zero until the thread samples for the first time.
+static RCUTILS_THREAD_LOCAL uint64_t gtls_rcutils_logging_sample_state = 0u;
+// Counts the threads which sampled, to start each of them at a different state.
+static uint32_t g_rcutils_logging_sample_threads = 0u;
 #else
-# define COLOR_NORMAL "\033[0m"
-# define COLOR_RED "\033[31m"
-# define COLOR_GREEN "\033[32m"
-# define COLOR_YELLOW "\033[33m"
-# define IS_STREAM_A_TTY(stream) (isatty(fileno(stream)) != 0)
+static uint64_t g_rcutils_logging_sample_state = 0u;
 #endif
 
-#define SET_COLOR_WITH_SEVERITY(status, severity, color) \
-  { \
-    switch (severity) { \
-      case RCUTILS_LOG_SEVERITY_DEBUG: \
-        color = COLOR_GREEN; \
-        break; \
-      case RCUTILS_LOG_SEVERITY_INFO: \
-        color = COLOR_NORMAL; \
-        break; \
-      case RCUTILS_LOG_SEVERITY_WARN: \
-        color = COLOR_YELLOW; \
-        break; \
-      case RCUTILS_LOG_SEVERITY_ERROR: \
-      case RCUTILS_LOG_SEVERITY_FATAL: \
-        color = COLOR_RED; \
-        break; \
-      default: \
-        RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING( \
-          "unknown severity level: %d\n", severity); \
-        status = RCUTILS_RET_INVALID_ARGUMENT; \
-    } \
+bool rcutils_logging_sample_probability(double probability)
+{
+  // Also rejects NaN.
+  if (!(probability > 0.0)) {
+    return false;
   }
-#ifdef _WIN32
-# define SET_OUTPUT_COLOR_WITH_COLOR(status, color, handle) \
-  { \
-    if (RCUTILS_RET_OK == status) { \
-      if (!SetConsoleTextAttribute(handle, color)) { \
-        DWORD error = GetLastError(); \
-        RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING( \
-          "SetConsoleTextAttribute failed with error code %lu.\n", error); \
-        status = RCUTILS_RET_ERROR; \
-      } \
-    } \
-  }
-# define GET_HANDLE_FROM_STREAM(status, handle) \
-  { \
-    if (RCUTILS_RET_OK == status) { \
-      if (g_output_stream == stdout) { \
-        handle = GetStdHandle(STD_OUTPUT_HANDLE); \
-      } else { \
-        handle = GetStdHandle(STD_ERROR_HANDLE); \
-      } \
-      if (INVALID_HANDLE_VALUE == handle) { \
-        DWORD error = GetLastError(); \
-        RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING( \
-          "GetStdHandle failed with error code %lu.\n", error); \
-        status = RCUTILS_RET_ERROR; \
-      } \
-    } \
-  }
-# define SET_OUTPUT_COLOR_WITH_SEVERITY(status, severity, output_array) \
-  { \
-    WORD color = COLOR_NORMAL; \
-    HANDLE handle = INVALID_HANDLE_VALUE; \
-    SET_COLOR_WITH_SEVERITY(status, severity, color) \
-    GET_HANDLE_FROM_STREAM(status, handle) \
-    SET_OUTPUT_COLOR_WITH_COLOR(status, color, handle) \
-  }
-# define SET_STANDARD_COLOR_IN_STREAM(is_colorized, status) \
-  { \
-    if (is_colorized) { \
-      HANDLE handle = INVALID_HANDLE_VALUE; \
-      GET_HANDLE_FROM_STREAM(status, handle) \
-      SET_OUTPUT_COLOR_WITH_COLOR(status, COLOR_NORMAL, handle) \
-    } \
-  }
-# define SET_STANDARD_COLOR_IN_BUFFER(is_colorized, status, output_array)
+  if (probability >= 1.0) {
+    return true;
+  }
+#ifdef RCUTILS_THREAD_LOCAL
+  if (RCUTILS_UNLIKELY(0u == gtls_rcutils_logging_sample_state)) {
+    gtls_rcutils_logging_sample_state =
+      mix_sample_state(atomic_add_fetch_uint32(&g_rcutils_logging_sample_threads, 1u));
+  }
+  gtls_rcutils_logging_sample_state += RCUTILS_LOGGING_SAMPLE_STATE_INCREMENT;
+  const uint64_t random = mix_sample_state(gtls_rcutils_logging_sample_state);
 #else
-# define SET_OUTPUT_COLOR_WITH_COLOR(status, color, output_array) \
-  { \
-    if (RCUTILS_RET_OK == status) { \
-      status = rcutils_char_array_strncat(&output_array, color, strlen(color)); \
-      if (RCUTILS_RET_OK != status) { \
-        RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING( \
-          "Error: rcutils_char_array_strncat failed with: %d\n", \
-          status); \
-      } \
-    } \
-  }
-# define SET_OUTPUT_COLOR_WITH_SEVERITY(status, severity, output_array) \
-  { \
-    const char * color = NULL; \
-    SET_COLOR_WITH_SEVERITY(status, severity, color) \
-    SET_OUTPUT_COLOR_WITH_COLOR(status, color, output_array) \
-  }
-# define SET_STANDARD_COLOR_IN_BUFFER(is_colorized, status, output_array) \
-  { \
-    if (is_colorized) { \
-      SET_OUTPUT_COLOR_WITH_COLOR(status, COLOR_NORMAL, output_array) \
-    } \
-  }
-# define SET_STANDARD_COLOR_IN_STREAM(is_colorized, status)
+  const uint64_t random = mix_sample_state(
+    __atomic_add_fetch(
+      &g_rcutils_logging_sample_state, RCUTILS_LOGGING_SAMPLE_STATE_INCREMENT, __ATOMIC_RELAXED));
 #endif
+  // The top 53 bits make a uniformly distributed double in [0, 1).
+  return (double)(random >> 11) / 9007199254740992.0 < probability;
+}
 
-void rcutils_logging_console_output_handler(
-  const rcutils_log_location_t * location,
-  int severity, const char * name, rcutils_time_point_value_t timestamp,
-  const char * format, va_list * args)
+// Pass through whether a message is enabled, counting it if it is filtered out.
+static bool count_if_filtered(bool enabled)
 {
-  rcutils_ret_t status = RCUTILS_RET_OK;
-  bool is_colorized = false;
-
-  if (!g_rcutils_logging_initialized) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR(
-      "logging system isn't initialized: "
-      "call to rcutils_logging_console_output_handler failed.\n");
-    return;
-  }
-  switch (severity) {
-    case RCUTILS_LOG_SEVERITY_DEBUG:
-    case RCUTILS_LOG_SEVERITY_INFO:
-    case RCUTILS_LOG_SEVERITY_WARN:
-    case RCUTILS_LOG_SEVERITY_ERROR:
-    case RCUTILS_LOG_SEVERITY_FATAL:
-      break;
-    default:
-      RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-        "unknown severity level: %d\n", severity);
-      return;
+  if (!enabled && 0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(
+      &g_rcutils_logging_statistics_enabled))
+  {
+    rcutils_logging_statistics_add_filtered();
   }
+  return enabled;
+}
 
-  if (g_colorized_output == RCUTILS_COLORIZED_OUTPUT_FORCE_ENABLE) {
-    is_colorized = true;
-  } else if (g_colorized_output == RCUTILS_COLORIZED_OUTPUT_FORCE_DISABLE) {
-    is_colorized = false;
-  } else {
-    is_colorized = IS_STREAM_A_TTY(g_output_stream);
+static bool update_callsite_cache(
+  rcutils_log_callsite_cache_t * cache, const char * name, size_t name_length, size_t hash,
+  int severity);
+
+static bool update_callsite_cache_for_name(
+  rcutils_log_callsite_cache_t * cache, const char * name, int severity)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  if (rcutils_logging_is_below_uniform_level(severity)) {
+    return false;
+  }
+  size_t name_length = 0;
+  size_t hash = 0;
+  if (name) {
+    hash = hash_logger_name(name, &name_length);
   }
+  return update_callsite_cache(cache, name, name_length, hash, severity);
+}
 
-  char msg_buf[1024] = "";
-  rcutils_char_array_t msg_array = {
-    .buffer = msg_buf,
-    .owns_buffer = false,
-    .buffer_length = 0u,
-    .buffer_capacity = sizeof(msg_buf),
-    .allocator = g_rcutils_logging_allocator
-  };
+bool rcutils_logging_logger_is_enabled_for(const char * name, int severity)
+{
+  // Only checking a logger doesn't filter out anything, so it isn't counted.
+  return update_callsite_cache_for_name(NULL, name, severity);
+}
 
-  char output_buf[1024] = "";
-  rcutils_char_array_t output_array = {
-    .buffer = output_buf,
-    .owns_buffer = false,
-    .buffer_length = 0u,
-    .buffer_capacity = sizeof(output_buf),
-    .allocator = g_rcutils_logging_allocator
-  };
+bool rcutils_logging_update_callsite_cache(
+  rcutils_log_callsite_cache_t * cache, const char * name, int severity)
+{
+  return count_if_filtered(update_callsite_cache_for_name(cache, name, severity));
+}
 
-  if (is_colorized) {
-    SET_OUTPUT_COLOR_WITH_SEVERITY(status, severity, output_array)
-  }
+bool rcutils_logging_update_callsite_cache_with_hash(
+  rcutils_log_callsite_cache_t * cache, const char * name, size_t name_length, size_t hash,
+  int severity)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  return count_if_filtered(update_callsite_cache(cache, name, name_length, hash, severity));
+}
 
-  if (RCUTILS_RET_OK == status) {
-    status = rcutils_char_array_vsprintf(&msg_array, format, *args);
-    if (RCUTILS_RET_OK != status) {
+bool rcutils_logging_update_logger_handle(rcutils_logger_handle_t * handle, int severity)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  return count_if_filtered(
+    update_callsite_cache(
+      &handle->cache, handle->cache.name, handle->name_length, handle->hash, severity));
+}
+
+static bool update_callsite_cache(
+  rcutils_log_callsite_cache_t * cache, const char * name, size_t name_length, size_t hash,
+  int severity)
+{
+  // Read the generation before resolving the level, so that a level resolved while it is being
+  // changed gets tagged with the old generation and is resolved again on the next call.
+  uint32_t generation =
+    RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_level_generation);
+  int logger_level = atomic_load_acquire_int(&g_rcutils_logging_default_logger_level);
+  if (name) {
+    logger_level = get_logger_effective_level(name, name_length, hash);
+    if (-1 == logger_level) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+        "Error determining if logger '%s' is enabled for severity '%d'\n",
+        name, severity);
+      return false;
+    }
+  }
+
+  if (NULL != cache) {
+    // The name of a cache is written exactly once, by the thread which claims it, before the
+    // state is published.  Afterwards only threads using the same name update the state.
+    uint32_t state = RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&cache->state);
+    bool owns_cache = false;
+    if (RCUTILS_LOG_CALLSITE_CACHE_UNCLAIMED == state) {
+      if (atomic_compare_exchange_uint32(
+          &cache->state, RCUTILS_LOG_CALLSITE_CACHE_UNCLAIMED, RCUTILS_LOG_CALLSITE_CACHE_CLAIMING))
+      {
+        cache->name = name;
+        owns_cache = true;
+      }
+    } else if (RCUTILS_LOG_CALLSITE_CACHE_CLAIMING != state) {
+      owns_cache = cache->name == name;
+    }
+    if (owns_cache) {
+      if (logger_level >= 0 && logger_level <= (int)RCUTILS_LOG_CALLSITE_CACHE_LEVEL_MASK) {
+        atomic_store_release_uint32(
+          &cache->state, generation | RCUTILS_LOG_CALLSITE_CACHE_VALID | (uint32_t)logger_level);
+      } else {
+        atomic_store_release_uint32(&cache->state, RCUTILS_LOG_CALLSITE_CACHE_UNCACHEABLE);
+      }
+    }
+  }
+
+  return severity >= logger_level;
+}
+
+static rcutils_ret_t get_log_timestamp(rcutils_time_point_value_t * now)
+{
+  switch (RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_timestamp_source)) {
+    case RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED:
+      if (rcutils_logging_async_writer_get_time(g_rcutils_logging_async_writer, now)) {
+        return RCUTILS_RET_OK;
+      }
+      // Without a consumer thread refreshing it, fall back to the next cheapest clock.
+      return rcutils_system_time_now_coarse(now);
+    case RCUTILS_LOGGING_TIMESTAMP_SOURCE_COARSE:
+      return rcutils_system_time_now_coarse(now);
+    default:
+      return rcutils_system_time_now(now);
+  }
+}
+
+static void call_output_handler(
+  rcutils_logging_output_handler_t output_handler, const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp, const char * format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  (*output_handler)(location, severity, name, timestamp, format, &args);
+  va_end(args);
+}
+
+// Return true if the message of the hash repeats the last one of its callsite within the
+// interval, and must be suppressed, otherwise output the summary of the repeats suppressed
+// before it, if any.
+static bool is_repeated_message_hash(
+  rcutils_logging_output_handler_t output_handler, const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  rcutils_duration_value_t interval, uint64_t message_hash)
+{
+  uint64_t repeats = 0u;
+  if (!rcutils_logging_dedup_check(location, message_hash, timestamp, interval, &repeats)) {
+    if (0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_statistics_enabled)) {
+      rcutils_logging_statistics_add_suppressed();
+    }
+    return true;
+  }
+  if (0u != repeats) {
+    call_output_handler(
+      output_handler, location, severity, name, timestamp,
+      "Last message repeated %" PRIu64 " times", repeats);
+  }
+  return false;
+}
+
+// Only the beginning of long messages is compared, along with their length.
+static uint64_t hash_message(const char * message, size_t length)
+{
+  const size_t hashed_length =
+    length < RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE ? length : RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE - 1u;
+  return rcutils_logging_dedup_hash(message, hashed_length) ^ (uint64_t)length;
+}
+
+// The message is either given as msg, or to be expanded from format and args.
+static bool is_repeated_message(
+  rcutils_logging_output_handler_t output_handler, const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  rcutils_duration_value_t interval, const char * msg, size_t msg_length,
+  const char * format, va_list * args)
+{
+  if (NULL != msg) {
+    return is_repeated_message_hash(
+      output_handler, location, severity, name, timestamp, interval,
+      hash_message(msg, msg_length));
+  }
+  char message_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+  va_list args_clone;
+  va_copy(args_clone, *args);
+  const int length = vsnprintf(message_buf, sizeof(message_buf), format, args_clone);
+  va_end(args_clone);
+  if (length < 0) {
+    return false;
+  }
+  return is_repeated_message_hash(
+    output_handler, location, severity, name, timestamp, interval,
+    hash_message(message_buf, (size_t)length));
+}
+
+static void sink_string_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, size_t length);
+
+// Pass an already formatted message to the output handler, straight to its string variant for
+// the output handlers of rcutils, or else through a format which copies it.
+static void call_string_output_handler(
+  rcutils_logging_output_handler_t output_handler, const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, size_t length)
+{
+  if (output_handler == rcutils_logging_console_output_handler) {
+    rcutils_logging_console_string_output_handler(
+      location, severity, name, timestamp, msg, length);
+  } else if (output_handler == rcutils_logging_sink_output_handler) {
+    sink_string_output(location, severity, name, timestamp, msg, length);
+  } else if (length <= INT_MAX) {
+    call_output_handler(
+      output_handler, location, severity, name, timestamp, "%.*s", (int)length, msg);
+  } else {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Log message too long for the output handler.\n");
+  }
+}
+
+// Output the message, either given as msg, or to be expanded from format and args.
+static void log_internal(
+  const rcutils_log_location_t * location, int severity, const char * name,
+  const char * msg, size_t msg_length, const char * format, va_list * args)
+{
+  rcutils_logging_output_handler_t output_handler = g_rcutils_logging_output_handler;
+  if (output_handler == NULL) {
+    return;
+  }
+  if (output_handler == rcutils_logging_sink_output_handler &&
+    severity < g_rcutils_logging_sinks_min_severity)
+  {
+    // No sink wants the message, so don't even read the clock.
+    (void)count_if_filtered(false);
+    return;
+  }
+  rcutils_time_point_value_t now;
+  rcutils_ret_t ret = get_log_timestamp(&now);
+  if (ret != RCUTILS_RET_OK) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to get timestamp while doing a console logging.\n");
+    return;
+  }
+  if (NULL != location) {
+    const rcutils_duration_value_t repeat_interval =
+      atomic_load_int64(&g_rcutils_logging_repeat_interval);
+    if (RCUTILS_UNLIKELY(repeat_interval > 0) &&
+      is_repeated_message(
+        output_handler, location, severity, name ? name : "", now, repeat_interval,
+        msg, msg_length, format, args))
+    {
+      return;
+    }
+  }
+  // If reading the clock fails, the message is counted with a zero duration.
+  rcutils_time_point_value_t handler_start = 0;
+  rcutils_time_point_value_t handler_end = 0;
+  const bool statistics_enabled =
+    0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(&g_rcutils_logging_statistics_enabled);
+  bool timed = RCUTILS_UNLIKELY(statistics_enabled) &&
+    RCUTILS_RET_OK == rcutils_steady_time_now(&handler_start);
+  if (NULL != msg) {
+    call_string_output_handler(
+      output_handler, location, severity, name ? name : "", now, msg, msg_length);
+  } else {
+    (*output_handler)(location, severity, name ? name : "", now, format, args);
+  }
+  if (RCUTILS_LIKELY(!statistics_enabled)) {
+    return;
+  }
+  timed = timed && RCUTILS_RET_OK == rcutils_steady_time_now(&handler_end);
+  if (!timed) {
+    rcutils_reset_error();
+  }
+  rcutils_logging_statistics_add_message(severity, timed ? handler_end - handler_start : 0);
+}
+
+static void vrcutils_log_internal(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, const char * format, va_list * args)
+{
+  log_internal(location, severity, name, NULL, 0u, format, args);
+}
+
+void rcutils_log(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, const char * format, ...)
+{
+  const bool enabled = rcutils_logging_logger_is_enabled_for(name, severity);
+  RCUTILS_LOGGING_TRACEPOINT3(log_enabled, name, severity, (int)enabled);
+  if (!count_if_filtered(enabled)) {
+    return;
+  }
+
+  va_list args;
+  va_start(args, format);
+  vrcutils_log_internal(location, severity, name, format, &args);
+  va_end(args);
+}
+
+void rcutils_log_string(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, const char * msg, size_t length)
+{
+  const bool enabled = rcutils_logging_logger_is_enabled_for(name, severity);
+  RCUTILS_LOGGING_TRACEPOINT3(log_enabled, name, severity, (int)enabled);
+  if (!count_if_filtered(enabled)) {
+    return;
+  }
+  log_internal(location, severity, name, NULL != msg ? msg : "", msg ? length : 0u, NULL, NULL);
+}
+
+void rcutils_log_string_internal(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, const char * msg, size_t length)
+{
+  log_internal(location, severity, name, NULL != msg ? msg : "", msg ? length : 0u, NULL, NULL);
+}
+
+void rcutils_log_internal(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, const char * format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  vrcutils_log_internal(location, severity, name, format, &args);
+  va_end(args);
+}
+
+void rcutils_log_with_handle(
+  const rcutils_log_location_t * location,
+  rcutils_logger_handle_t * handle, int severity, const char * format, ...)
+{
+  if (!rcutils_logging_logger_handle_is_enabled_for(handle, severity)) {
+    return;
+  }
+
+  va_list args;
+  va_start(args, format);
+  vrcutils_log_internal(location, severity, handle->cache.name, format, &args);
+  va_end(args);
+}
+
+rcutils_logger_handle_t * rcutils_logging_get_logger_handle(const char * name)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  if (NULL == name) {
+    RCUTILS_SET_ERROR_MSG("Invalid logger name");
+    return NULL;
+  }
+
+  if (!g_rcutils_logging_logger_handles_valid) {
+    g_rcutils_logging_logger_handles = rcutils_get_zero_initialized_hash_map();
+    rcutils_ret_t hash_map_ret = rcutils_hash_map_init(
+      &g_rcutils_logging_logger_handles, 2, sizeof(const char *),
+      sizeof(rcutils_logger_handle_t *), rcutils_hash_map_string_fast_hash_func,
+      rcutils_hash_map_string_cmp_func, &g_rcutils_logging_allocator);
+    if (hash_map_ret != RCUTILS_RET_OK) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Failed to initialize map for logger handles: %s", rcutils_get_error_string().str);
+      return NULL;
+    }
+    g_rcutils_logging_logger_handles_valid = true;
+  }
+
+  // The handles are keyed with the same hash as the effective level cache, so it is computed once
+  size_t name_length;
+  size_t hash = hash_logger_name(name, &name_length);
+  rcutils_logger_handle_t * handle = NULL;
+  if (rcutils_hash_map_get_with_hash(
+      &g_rcutils_logging_logger_handles, &name, hash, &handle) == RCUTILS_RET_OK)
+  {
+    return handle;
+  }
+
+  handle = g_rcutils_logging_allocator.allocate(
+    sizeof(rcutils_logger_handle_t) + name_length + 1, g_rcutils_logging_allocator.state);
+  if (NULL == handle) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to allocate memory for the handle of logger '%s'", name);
+    return NULL;
+  }
+  char * handle_name = (char *)(handle + 1);
+  memcpy(handle_name, name, name_length + 1);
+  // The cache is claimed by the copy of the name from the start, but holds no level yet.
+  handle->cache.state = RCUTILS_LOG_CALLSITE_CACHE_UNCACHEABLE;
+  handle->cache.name = handle_name;
+  handle->name_length = name_length;
+  handle->hash = hash;
+
+  const char * key = handle_name;
+  rcutils_ret_t hash_map_ret =
+    rcutils_hash_map_set_with_hash(&g_rcutils_logging_logger_handles, &key, hash, &handle);
+  if (hash_map_ret != RCUTILS_RET_OK) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to store the handle of logger '%s': %s", name, rcutils_get_error_string().str);
+    g_rcutils_logging_allocator.deallocate(handle, g_rcutils_logging_allocator.state);
+    return NULL;
+  }
+  return handle;
+}
+
+static rcutils_ret_t fini_logger_handles(void)
+{
+  if (!g_rcutils_logging_logger_handles_valid) {
+    return RCUTILS_RET_OK;
+  }
+  char * key = NULL;
+  rcutils_logger_handle_t * handle = NULL;
+  rcutils_hash_map_iterator_t iterator;
+  rcutils_ret_t hash_map_ret = rcutils_hash_map_iterator_begin(
+    &g_rcutils_logging_logger_handles, &iterator, &key, &handle);
+  while (RCUTILS_RET_OK == hash_map_ret) {
+    // The key is part of the handle allocation, and the map is finalized below.
+    g_rcutils_logging_allocator.deallocate(handle, g_rcutils_logging_allocator.state);
+    hash_map_ret = rcutils_hash_map_iterator_next(
+      &g_rcutils_logging_logger_handles, &iterator, &key, &handle);
+  }
+  if (RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES != hash_map_ret) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to clear out logger handles [%s] during shutdown; memory will be leaked.",
+      rcutils_get_error_string().str);
+  }
+  g_rcutils_logging_logger_handles_valid = false;
+  hash_map_ret = rcutils_hash_map_fini(&g_rcutils_logging_logger_handles);
+  if (hash_map_ret != RCUTILS_RET_OK) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to finalize map for logger handles: %s", rcutils_get_error_string().str);
+    return RCUTILS_RET_ERROR;
+  }
+  return RCUTILS_RET_OK;
+}
+
+// The letter of the two character escape sequence of a control character in JSON, or 0.
+static char get_json_short_escape(unsigned char c)
+{
+  switch (c) {
+    case '\b':
+      return 'b';
+    case '\t':
+      return 't';
+    case '\n':
+      return 'n';
+    case '\f':
+      return 'f';
+    case '\r':
+      return 'r';
+    default:
+      return 0;
+  }
+}
+
+// Escape what was appended to the output after `start` to be the contents of a JSON string.
+static rcutils_ret_t escape_json_string(rcutils_char_array_t * output, size_t start)
+{
+  // The length includes the terminating null character, if anything was appended at all.
+  if (output->buffer_length <= start + 1) {
+    return RCUTILS_RET_OK;
+  }
+  const size_t end = output->buffer_length - 1;
+
+  // Count the additional characters in a single pass without branches, which compilers
+  // vectorize, so that text without anything to escape, by far the most common case, is only
+  // scanned once.
+  size_t extra = 0;
+  for (size_t i = start; i < end; ++i) {
+    const unsigned char c = (unsigned char)output->buffer[i];
+    extra += (size_t)(c == '"' || c == '\\') +
+      (size_t)(c < 0x20u) * (0 != get_json_short_escape(c) ? 1u : 5u);
+  }
+  if (0 == extra) {
+    return RCUTILS_RET_OK;
+  }
+
+  rcutils_ret_t ret = rcutils_char_array_expand_as_needed(output, output->buffer_length + extra);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  // Escape from the back, so that each character is read before it is overwritten.
+  static const char hex_digits[] = "0123456789abcdef";
+  char * buffer = output->buffer;
+  size_t read = end;
+  size_t write = end + extra;
+  buffer[write] = '\0';
+  while (read > start) {
+    const unsigned char c = (unsigned char)buffer[--read];
+    if ('"' == c || '\\' == c) {
+      buffer[--write] = (char)c;
+      buffer[--write] = '\\';
+    } else if (c >= 0x20u) {
+      buffer[--write] = (char)c;
+    } else if (0 != get_json_short_escape(c)) {
+      buffer[--write] = get_json_short_escape(c);
+      buffer[--write] = '\\';
+    } else {
+      buffer[--write] = hex_digits[c & 0xFu];
+      buffer[--write] = hex_digits[c >> 4];
+      buffer[--write] = '0';
+      buffer[--write] = '0';
+      buffer[--write] = 'u';
+      buffer[--write] = '\\';
+    }
+  }
+  output->buffer_length += extra;
+  return RCUTILS_RET_OK;
+}
+
+// Replaces invalid UTF-8 from the given start of the output with U+FFFD.
+static rcutils_ret_t sanitize_utf8_string(rcutils_char_array_t * output, size_t start)
+{
+  if (output->buffer_length <= start + 1) {
+    return RCUTILS_RET_OK;
+  }
+  const size_t length = output->buffer_length - 1 - start;
+  const size_t invalid = rcutils_utf8_validate(output->buffer + start, length);
+  if (SIZE_MAX == invalid) {
+    return RCUTILS_RET_OK;
+  }
+
+  // The rest is copied out, since sanitizing appends it to the output, which may be reallocated.
+  rcutils_allocator_t * allocator = &output->allocator;
+  const size_t rest_length = length - invalid;
+  char * rest = allocator->allocate(rest_length, allocator->state);
+  if (NULL == rest) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory to sanitize the string");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  memcpy(rest, output->buffer + start + invalid, rest_length);
+  output->buffer_length = start + invalid + 1;
+  output->buffer[start + invalid] = '\0';
+  const rcutils_ret_t ret = rcutils_utf8_sanitize(rest, rest_length, output);
+  allocator->deallocate(rest, allocator->state);
+  return ret;
+}
+
+static rcutils_ret_t format_message(
+  const logging_input_t * logging_input, rcutils_char_array_t * logging_output)
+{
+  const log_msg_format_t * format = atomic_load_acquire_format(&g_log_msg_format);
+  if (NULL == format) {
+    return RCUTILS_RET_OK;
+  }
+  for (size_t i = 0; i < format->num_parts; ++i) {
+    const log_msg_part_t * part = &format->parts[i];
+    if (NULL == part->handler) {
+      if (rcutils_char_array_strncat(
+          logging_output, format->literals + part->literal_offset,
+          part->literal_length) != RCUTILS_RET_OK)
+      {
+        RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+        rcutils_reset_error();
+        RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+        return RCUTILS_RET_ERROR;
+      }
+      continue;
+    }
+    const size_t start =
+      0 == logging_output->buffer_length ? 0 : logging_output->buffer_length - 1;
+    if (part->handler(logging_input, logging_output) == NULL) {
+      return RCUTILS_RET_ERROR;
+    }
+    // Sanitized first, since escaping only adds ASCII.
+    if (part->escape && g_rcutils_logging_sanitize_utf8 &&
+      sanitize_utf8_string(logging_output, start) != RCUTILS_RET_OK)
+    {
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      return RCUTILS_RET_ERROR;
+    }
+    if (part->escape && escape_json_string(logging_output, start) != RCUTILS_RET_OK) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      return RCUTILS_RET_ERROR;
+    }
+  }
+
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t rcutils_logging_format_message(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, rcutils_char_array_t * logging_output)
+{
+  const logging_input_t logging_input = {
+    .location = location,
+    .severity = severity,
+    .name = name,
+    .timestamp = timestamp,
+    .msg = msg,
+    .msg_length = NULL != msg ? strlen(msg) : 0u,
+    .format = NULL,
+    .args = NULL
+  };
+
+  return format_message(&logging_input, logging_output);
+}
+
+rcutils_ret_t rcutils_logging_set_output_format(const char * output_format)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output_format, RCUTILS_RET_INVALID_ARGUMENT);
+  if (strlen(output_format) > RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN - 1) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "output format is longer than %d characters", RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN - 1);
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  RCUTILS_LOGGING_AUTOINIT;
+  if (LOGGING_OUTPUT_STRUCTURE_TEXT != g_rcutils_logging_output_structure) {
+    RCUTILS_SET_ERROR_MSG("the output is structured, so it has no output format");
+    return RCUTILS_RET_ERROR;
+  }
+  if (strcmp(output_format, "") == 0) {
+    output_format = g_rcutils_logging_default_output_format;
+  }
+  log_msg_format_t * format = compile_text_format(output_format);
+  if (NULL == format) {
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  publish_format(format);
+  return RCUTILS_RET_OK;
+}
+
+
+#define COLOR_NORMAL "\033[0m"
+#define COLOR_RED "\033[31m"
+#define COLOR_GREEN "\033[32m"
+#define COLOR_YELLOW "\033[33m"
+#ifdef _WIN32
+# define CONSOLE_COLOR_NORMAL 7
+# define CONSOLE_COLOR_RED 4
+# define CONSOLE_COLOR_GREEN 2
+# define CONSOLE_COLOR_YELLOW 6
+# define IS_STREAM_A_TTY(stream) (_isatty(_fileno(stream)) != 0)
+// Missing from older Windows SDKs.
+# ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#  define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+# endif
+#else
+# define IS_STREAM_A_TTY(stream) (isatty(fileno(stream)) != 0)
+#endif
+
+static void resolve_output_colors(void)
+{
+  if (g_colorized_output == RCUTILS_COLORIZED_OUTPUT_FORCE_ENABLE) {
+    g_output_colorized = true;
+  } else if (g_colorized_output == RCUTILS_COLORIZED_OUTPUT_FORCE_DISABLE) {
+    g_output_colorized = false;
+  } else {
+    g_output_colorized = IS_STREAM_A_TTY(g_output_stream);
+  }
+  // Color codes would be part of the structured fields.
+  if (LOGGING_OUTPUT_STRUCTURE_TEXT != g_rcutils_logging_output_structure) {
+    g_output_colorized = false;
+  }
+#ifdef _WIN32
+  g_output_console_handle = INVALID_HANDLE_VALUE;
+  g_output_console_escapes = false;
+  if (!g_output_colorized) {
+    return;
+  }
+  g_output_console_handle =
+    GetStdHandle(g_output_stream == stdout ? STD_OUTPUT_HANDLE : STD_ERROR_HANDLE);
+  if (INVALID_HANDLE_VALUE == g_output_console_handle) {
+    DWORD error = GetLastError();
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "GetStdHandle failed with error code %lu, disabling colors.\n", error);
+    g_output_colorized = false;
+    return;
+  }
+  // Consoles which interpret escape sequences get them in the output like any other terminal.
+  DWORD mode = 0;
+  if (GetConsoleMode(g_output_console_handle, &mode)) {
+    g_output_console_escapes = 0 != (mode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) ||
+      SetConsoleMode(g_output_console_handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+  }
+#endif
+}
+
+static const char * get_color(int severity)
+{
+  switch (severity) {
+    case RCUTILS_LOG_SEVERITY_DEBUG:
+      return COLOR_GREEN;
+    case RCUTILS_LOG_SEVERITY_WARN:
+      return COLOR_YELLOW;
+    case RCUTILS_LOG_SEVERITY_ERROR:
+    case RCUTILS_LOG_SEVERITY_FATAL:
+      return COLOR_RED;
+    default:
+      return COLOR_NORMAL;
+  }
+}
+
+static rcutils_ret_t append_color(rcutils_char_array_t * output_array, const char * color)
+{
+  rcutils_ret_t status = rcutils_char_array_strncat(output_array, color, strlen(color));
+  if (RCUTILS_RET_OK != status) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: rcutils_char_array_strncat failed with: %d\n", status);
+  }
+  return status;
+}
+
+#ifdef _WIN32
+static WORD get_console_color(int severity)
+{
+  switch (severity) {
+    case RCUTILS_LOG_SEVERITY_DEBUG:
+      return CONSOLE_COLOR_GREEN;
+    case RCUTILS_LOG_SEVERITY_WARN:
+      return CONSOLE_COLOR_YELLOW;
+    case RCUTILS_LOG_SEVERITY_ERROR:
+    case RCUTILS_LOG_SEVERITY_FATAL:
+      return CONSOLE_COLOR_RED;
+    default:
+      return CONSOLE_COLOR_NORMAL;
+  }
+}
+
+static rcutils_ret_t set_console_color(WORD color)
+{
+  if (!SetConsoleTextAttribute(g_output_console_handle, color)) {
+    DWORD error = GetLastError();
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "SetConsoleTextAttribute failed with error code %lu.\n", error);
+    return RCUTILS_RET_ERROR;
+  }
+  return RCUTILS_RET_OK;
+}
+#endif
+
+// Write a log message to the console, either given as msg, or to be expanded from format and args.
+static void console_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, size_t msg_length, const char * format, va_list * args)
+{
+  rcutils_ret_t status = RCUTILS_RET_OK;
+
+  if (!g_rcutils_logging_initialized) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "logging system isn't initialized: "
+      "call to rcutils_logging_console_output_handler failed.\n");
+    return;
+  }
+  switch (severity) {
+    case RCUTILS_LOG_SEVERITY_DEBUG:
+    case RCUTILS_LOG_SEVERITY_INFO:
+    case RCUTILS_LOG_SEVERITY_WARN:
+    case RCUTILS_LOG_SEVERITY_ERROR:
+    case RCUTILS_LOG_SEVERITY_FATAL:
+      break;
+    default:
       RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-        "Error: rcutils_char_array_vsprintf failed with: %d\n", status);
-    }
+        "unknown severity level: %d\n", severity);
+      return;
+  }
+
+  // The colors are written along with the message, so each message takes a single write.
+  bool colors_in_output = g_output_colorized;
+#ifdef _WIN32
+  // Otherwise they are set on the console before and after writing the message, which can't be
+  // synchronized with the records written by the asynchronous consumer thread.
+  bool colors_on_console = false;
+  if (colors_in_output && !g_output_console_escapes) {
+    colors_in_output = false;
+    colors_on_console = NULL == g_rcutils_logging_async_writer;
+  }
+#endif
+
+  // Format into a reusable buffer of this thread, falling back to a buffer on the stack
+  // (and the heap for long messages) if none is available.
+  char output_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+  rcutils_char_array_t stack_output_array = {
+    .buffer = output_buf,
+    .owns_buffer = false,
+    .buffer_length = 0u,
+    .buffer_capacity = sizeof(output_buf),
+    .allocator = g_rcutils_logging_allocator
+  };
+  rcutils_char_array_t * output_array = acquire_thread_buffer(&stack_output_array);
+  const size_t output_capacity = output_array->buffer_capacity;
+
+  if (colors_in_output) {
+    status = append_color(output_array, get_color(severity));
+  }
+#ifdef _WIN32
+  if (colors_on_console) {
+    status = set_console_color(get_console_color(severity));
+    colors_on_console = RCUTILS_RET_OK == status;
   }
+#endif
 
   if (RCUTILS_RET_OK == status) {
-    status = rcutils_logging_format_message(
-      location, severity, name, timestamp, msg_array.buffer, &output_array);
+    // Unless given, the message is formatted straight into the output, where {message} appears.
+    const logging_input_t logging_input = {
+      .location = location,
+      .severity = severity,
+      .name = name,
+      .timestamp = timestamp,
+      .msg = msg,
+      .msg_length = msg_length,
+      .format = format,
+      .args = args
+    };
+    RCUTILS_LOGGING_TRACEPOINT2(format_begin, name, severity);
+    status = format_message(&logging_input, output_array);
+    RCUTILS_LOGGING_TRACEPOINT3(format_end, name, output_array->buffer_length, (int)status);
     if (RCUTILS_RET_OK != status) {
       RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
         "Error: rcutils_logging_format_message failed with: %d\n", status);
     }
   }
 
-  // Does nothing in windows
-  SET_STANDARD_COLOR_IN_BUFFER(is_colorized, status, output_array)
+  if (colors_in_output && RCUTILS_RET_OK == status) {
+    status = append_color(output_array, COLOR_NORMAL);
+  }
 
   if (RCUTILS_RET_OK == status) {
-    fprintf(g_output_stream, "%s\n", output_array.buffer);
+    status = rcutils_char_array_strncat(output_array, "\n", 1);
+  }
+  if (RCUTILS_RET_OK == status) {
+    // The buffer length includes the terminating null character, which isn't written out.
+    const size_t bytes_written = output_array->buffer_length - 1;
+    RCUTILS_LOGGING_TRACEPOINT2(sink_write_begin, severity, bytes_written);
+    rcutils_logging_async_writer_t * async_writer = g_rcutils_logging_async_writer;
+    if (NULL != async_writer) {
+      status = rcutils_logging_async_writer_push(
+        async_writer, output_array->buffer, bytes_written);
+      if (RCUTILS_RET_OK != status) {
+        RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+          "Error: failed to queue log message for asynchronous output: %d\n", status);
+      }
+    } else {
+      (void)fwrite(output_array->buffer, 1, bytes_written, g_output_stream);
+      flush_output_if_due(severity, timestamp);
+    }
+    RCUTILS_LOGGING_TRACEPOINT2(sink_write_end, severity, (int)status);
+    if (RCUTILS_RET_OK == status && 0u != RCUTILS_LOGGING_ATOMIC_LOAD_ACQUIRE_UINT32(
+        &g_rcutils_logging_statistics_enabled))
+    {
+      rcutils_logging_statistics_add_output(
+        bytes_written, output_array->buffer_capacity > output_capacity);
+    }
+  }
+
+#ifdef _WIN32
+  if (colors_on_console) {
+    (void)set_console_color(CONSOLE_COLOR_NORMAL);
+  }
+#endif
+
+  release_thread_buffer(output_array, &stack_output_array);
+}
+
+void rcutils_logging_console_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  console_output(location, severity, name, timestamp, NULL, 0u, format, args);
+}
+
+void rcutils_logging_console_string_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, size_t length)
+{
+  if (NULL == msg) {
+    msg = "";
+    length = 0u;
   }
+  console_output(location, severity, name, timestamp, msg, length, NULL, NULL);
+}
+
+// Format a decoded binary record with the console output format, replacing the contents of output.
+static rcutils_ret_t format_binary_record(
+  const rcutils_logging_binary_record_view_t * view, rcutils_char_array_t * output)
+{
+  char message_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+  rcutils_char_array_t stack_message = {
+    .buffer = message_buf,
+    .owns_buffer = false,
+    .buffer_length = 0u,
+    .buffer_capacity = sizeof(message_buf),
+    .allocator = g_rcutils_logging_allocator
+  };
+  rcutils_char_array_t * message = acquire_thread_buffer(&stack_message);
+  rcutils_ret_t status = rcutils_logging_binary_format_message(view, message);
+  if (RCUTILS_RET_OK == status) {
+    const logging_input_t logging_input = {
+      .location = view->location,
+      .severity = view->severity,
+      .name = view->name,
+      .timestamp = view->timestamp,
+      .msg = message->buffer,
+      .msg_length = strlen(message->buffer),
+      .format = NULL,
+      .args = NULL
+    };
+    output->buffer_length = 0u;
+    status = format_message(&logging_input, output);
+  }
+  release_thread_buffer(message, &stack_message);
+  return status;
+}
+
+// Called on the consumer thread with the records pushed by rcutils_logging_binary_output_handler().
+static void write_binary_record_formatted(FILE * stream, const char * data, size_t length)
+{
+  rcutils_logging_binary_record_view_t view;
+  rcutils_ret_t status = rcutils_logging_binary_decode(data, length, &view);
+  if (RCUTILS_RET_OK == status) {
+    char output_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+    rcutils_char_array_t stack_output_array = {
+      .buffer = output_buf,
+      .owns_buffer = false,
+      .buffer_length = 0u,
+      .buffer_capacity = sizeof(output_buf),
+      .allocator = g_rcutils_logging_allocator
+    };
+    rcutils_char_array_t * output_array = acquire_thread_buffer(&stack_output_array);
+
+    status = format_binary_record(&view, output_array);
+    if (RCUTILS_RET_OK == status) {
+      fprintf(stream, "%s\n", output_array->buffer);
+    }
 
-  // Only does something in windows
-  // cppcheck-suppress uninitvar  // suppress cppcheck false positive
-  SET_STANDARD_COLOR_IN_STREAM(is_colorized, status)
+    release_thread_buffer(output_array, &stack_output_array);
+  }
+  if (RCUTILS_RET_OK != status) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to format binary log record: %s\n", rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+}
 
-  status = rcutils_char_array_fini(&msg_array);
+// Called on the consumer thread with the records pushed by rcutils_logging_binary_output_handler().
+static void write_binary_record_serialized(FILE * stream, const char * data, size_t length)
+{
+  rcutils_logging_binary_record_view_t view;
+  rcutils_ret_t status = rcutils_logging_binary_decode(data, length, &view);
+  if (RCUTILS_RET_OK == status) {
+    char serialized_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+    rcutils_char_array_t stack_serialized = {
+      .buffer = serialized_buf,
+      .owns_buffer = false,
+      .buffer_length = 0u,
+      .buffer_capacity = sizeof(serialized_buf),
+      .allocator = g_rcutils_logging_allocator
+    };
+    rcutils_char_array_t * serialized = acquire_thread_buffer(&stack_serialized);
+    status = rcutils_logging_binary_serialize(&view, serialized);
+    if (RCUTILS_RET_OK == status) {
+      (void)fwrite(serialized->buffer, 1, serialized->buffer_length, stream);
+    }
+    release_thread_buffer(serialized, &stack_serialized);
+  }
   if (RCUTILS_RET_OK != status) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to fini array.\n");
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to write binary log record: %s\n", rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+}
+
+rcutils_ret_t rcutils_logging_enable_binary(
+  const rcutils_logging_async_options_t * options, FILE * record_stream)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  rcutils_logging_async_options_t default_options = rcutils_logging_get_default_async_options();
+  if (NULL == options) {
+    options = &default_options;
+  }
+
+  rcutils_ret_t ret = rcutils_logging_disable_binary();
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  FILE * stream = NULL != record_stream ? record_stream : g_output_stream;
+  // Anything already buffered in the stream must come out before the queued records.
+  (void)fflush(stream);
+  ret = rcutils_logging_async_writer_init(
+    &g_rcutils_logging_binary_writer, options, stream,
+    NULL != record_stream ? write_binary_record_serialized : write_binary_record_formatted,
+    g_rcutils_logging_allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  g_rcutils_logging_binary_previous_output_handler = g_rcutils_logging_output_handler;
+  g_rcutils_logging_output_handler = rcutils_logging_binary_output_handler;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t rcutils_logging_disable_binary(void)
+{
+  if (NULL == g_rcutils_logging_binary_writer) {
+    return RCUTILS_RET_OK;
+  }
+  if (rcutils_logging_binary_output_handler == g_rcutils_logging_output_handler) {
+    g_rcutils_logging_output_handler = g_rcutils_logging_binary_previous_output_handler;
+  }
+  g_rcutils_logging_binary_previous_output_handler = NULL;
+  rcutils_ret_t ret = rcutils_logging_async_writer_fini(g_rcutils_logging_binary_writer);
+  if (RCUTILS_RET_OK != ret) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to stop the binary logging thread: %s", rcutils_get_error_string().str);
+    return ret;
+  }
+  g_rcutils_logging_binary_writer = NULL;
+  return RCUTILS_RET_OK;
+}
+
+size_t rcutils_logging_get_binary_dropped_count(void)
+{
+  return rcutils_logging_async_writer_get_dropped_count(g_rcutils_logging_binary_writer);
+}
+
+void rcutils_logging_binary_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  rcutils_logging_async_writer_t * binary_writer = g_rcutils_logging_binary_writer;
+  if (NULL == binary_writer) {
+    rcutils_logging_console_output_handler(location, severity, name, timestamp, format, args);
+    return;
+  }
+
+  char record_buf[RCUTILS_LOGGING_ASYNC_DEFAULT_RECORD_SIZE];
+  rcutils_char_array_t stack_record = {
+    .buffer = record_buf,
+    .owns_buffer = false,
+    .buffer_length = 0u,
+    .buffer_capacity = sizeof(record_buf),
+    .allocator = g_rcutils_logging_allocator
+  };
+  rcutils_char_array_t * record = acquire_thread_buffer(&stack_record);
+  rcutils_ret_t status = rcutils_logging_binary_encode(
+    location, severity, name, timestamp, format, args, record);
+  if (RCUTILS_RET_OK == status) {
+    status = rcutils_logging_async_writer_push(
+      binary_writer, record->buffer, record->buffer_length);
   }
-  status = rcutils_char_array_fini(&output_array);
   if (RCUTILS_RET_OK != status) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to fini array.\n");
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to queue binary log record: %s\n", rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  release_thread_buffer(record, &stack_record);
+}
+
+rcutils_ret_t rcutils_logging_binary_format_record(
+  const char * data, size_t size, size_t * record_size, rcutils_char_array_t * output)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(record_size, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_LOGGING_AUTOINIT;
+
+  rcutils_logging_binary_record_view_t view;
+  rcutils_ret_t ret = rcutils_logging_binary_deserialize(data, size, record_size, &view);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  return format_binary_record(&view, output);
+}
+
+static void update_sinks_min_severity(void)
+{
+  int min_severity = INT_MAX;
+  for (size_t i = 0; i < g_rcutils_logging_num_sinks; ++i) {
+    if (g_rcutils_logging_sinks[i].severity < min_severity) {
+      min_severity = g_rcutils_logging_sinks[i].severity;
+    }
+  }
+  g_rcutils_logging_sinks_min_severity = min_severity;
+}
+
+static logging_sink_entry_t * find_sink(rcutils_logging_sink_t sink, void * context)
+{
+  for (size_t i = 0; i < g_rcutils_logging_num_sinks; ++i) {
+    if (g_rcutils_logging_sinks[i].sink == sink && g_rcutils_logging_sinks[i].context == context) {
+      return &g_rcutils_logging_sinks[i];
+    }
+  }
+  return NULL;
+}
+
+rcutils_ret_t rcutils_logging_add_sink(rcutils_logging_sink_t sink, void * context, int severity)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != find_sink(sink, context)) {
+    RCUTILS_SET_ERROR_MSG("sink is already registered");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (g_rcutils_logging_num_sinks >= RCUTILS_LOGGING_MAX_SINKS) {
+    RCUTILS_SET_ERROR_MSG("too many sinks registered");
+    return RCUTILS_RET_NOT_ENOUGH_SPACE;
+  }
+  logging_sink_entry_t * entry = &g_rcutils_logging_sinks[g_rcutils_logging_num_sinks];
+  entry->sink = sink;
+  entry->context = context;
+  entry->severity = severity;
+  ++g_rcutils_logging_num_sinks;
+  update_sinks_min_severity();
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t rcutils_logging_remove_sink(rcutils_logging_sink_t sink, void * context)
+{
+  logging_sink_entry_t * entry = find_sink(sink, context);
+  if (NULL == entry) {
+    RCUTILS_SET_ERROR_MSG("sink is not registered");
+    return RCUTILS_RET_NOT_FOUND;
+  }
+  // Keep the remaining sinks in registration order.
+  logging_sink_entry_t * end = &g_rcutils_logging_sinks[g_rcutils_logging_num_sinks];
+  memmove(entry, entry + 1, (size_t)(end - (entry + 1)) * sizeof(*entry));
+  --g_rcutils_logging_num_sinks;
+  update_sinks_min_severity();
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t rcutils_logging_set_sink_severity(
+  rcutils_logging_sink_t sink, void * context, int severity)
+{
+  logging_sink_entry_t * entry = find_sink(sink, context);
+  if (NULL == entry) {
+    RCUTILS_SET_ERROR_MSG("sink is not registered");
+    return RCUTILS_RET_NOT_FOUND;
+  }
+  entry->severity = severity;
+  update_sinks_min_severity();
+  return RCUTILS_RET_OK;
+}
+
+// Pass a message to each of the sinks which want its severity.
+static void dispatch_to_sinks(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message)
+{
+  for (size_t i = 0; i < g_rcutils_logging_num_sinks; ++i) {
+    const logging_sink_entry_t * entry = &g_rcutils_logging_sinks[i];
+    if (severity >= entry->severity) {
+      RCUTILS_LOGGING_TRACEPOINT2(sink_call, i, severity);
+      entry->sink(location, severity, name, timestamp, message, entry->context);
+    }
+  }
+}
+
+void rcutils_logging_sink_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  if (severity < g_rcutils_logging_sinks_min_severity) {
+    // No sink wants the message, so don't even format it.
+    return;
   }
+
+  char message_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+  rcutils_char_array_t stack_message = {
+    .buffer = message_buf,
+    .owns_buffer = false,
+    .buffer_length = 0u,
+    .buffer_capacity = sizeof(message_buf),
+    .allocator = g_rcutils_logging_allocator
+  };
+  rcutils_char_array_t * message = acquire_thread_buffer(&stack_message);
+  rcutils_ret_t status = rcutils_char_array_vsprintf(message, format, *args);
+  if (RCUTILS_RET_OK == status) {
+    dispatch_to_sinks(location, severity, name, timestamp, message->buffer);
+  } else {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to format log message for the sinks: %s\n", rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  release_thread_buffer(message, &stack_message);
+}
+
+// The string variant of rcutils_logging_sink_output_handler(), which only copies the message to
+// null terminate it for the sinks.
+static void sink_string_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * msg, size_t length)
+{
+  if (severity < g_rcutils_logging_sinks_min_severity) {
+    return;
+  }
+
+  char message_buf[RCUTILS_LOGGING_OUTPUT_BUFFER_SIZE];
+  rcutils_char_array_t stack_message = {
+    .buffer = message_buf,
+    .owns_buffer = false,
+    .buffer_length = 0u,
+    .buffer_capacity = sizeof(message_buf),
+    .allocator = g_rcutils_logging_allocator
+  };
+  rcutils_char_array_t * message = acquire_thread_buffer(&stack_message);
+  rcutils_ret_t status = rcutils_char_array_strncat(message, msg, length);
+  if (RCUTILS_RET_OK == status) {
+    dispatch_to_sinks(location, severity, name, timestamp, message->buffer);
+  } else {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to copy log message for the sinks: %s\n", rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  release_thread_buffer(message, &stack_message);
+}
+
+void rcutils_logging_console_sink(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  (void)context;
+  console_output(location, severity, name, timestamp, message, strlen(message), NULL, NULL);
 }
@@ -0,0 +1,502 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./logging_async.h"
+#include "./logging_tracepoints.h"
+#include "./threads.h"
+
+#include "rcutils/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/time.h"
+
+// Slots are padded to a multiple of this so that neighboring slots written by
+// different producers don't share a cache line more than necessary.
+#define ASYNC_SLOT_ALIGNMENT (64u)
+
+// How long the consumer thread sleeps when the queue is empty before checking
+// again, in case a wake-up was missed.
+#define ASYNC_CONSUMER_IDLE_TIMEOUT_MS (100u)
+
+// The queue is the bounded multi-producer multi-consumer queue described by
+// Dmitry Vyukov: each slot carries a sequence number which tells producers and
+// consumers whether it is free for the lap they are on, so neither side ever
+// takes a lock.  Multiple consumers are needed for the overwrite-oldest policy,
+// where producers may discard records themselves.
+typedef struct async_slot_s
+{
+  atomic_size_t sequence;
+  size_t length;
+  // Heap copy of the record if it doesn't fit in the inline storage, else NULL.
+  char * overflow_data;
+  // Followed by record_size bytes of inline storage.
+} async_slot_t;
+
+struct rcutils_logging_async_writer_s
+{
+  rcutils_allocator_t allocator;
+  FILE * stream;
+  rcutils_logging_async_record_handler_t record_handler;
+  rcutils_logging_async_overflow_policy_t overflow_policy;
+  size_t record_size;
+  size_t slot_stride;
+  size_t mask;
+  char * slots;
+
+  atomic_size_t enqueue_position;
+  atomic_size_t dequeue_position;
+  atomic_size_t dropped_count;
+  atomic_bool consumer_sleeping;
+  atomic_bool stop_requested;
+  // How often the consumer refreshes the cached time, or 0 if it doesn't.
+  atomic_uint_least32_t time_refresh_ms;
+  // The system time last read by the consumer, or 0 until it is first read.
+  atomic_int_least64_t cached_time;
+
+  rcutils_mutex_t mutex;
+  rcutils_condition_variable_t condition;
+  rcutils_thread_t consumer;
+};
+
+typedef void (* record_consumer_t)(
+  rcutils_logging_async_writer_t * writer, const char * data, size_t length);
+
+static inline async_slot_t *
+get_slot(rcutils_logging_async_writer_t * writer, size_t position)
+{
+  return (async_slot_t *)(writer->slots + (position & writer->mask) * writer->slot_stride);
+}
+
+static inline char *
+get_slot_storage(async_slot_t * slot)
+{
+  return (char *)slot + sizeof(async_slot_t);
+}
+
+// The positions only hand out slots, so they are relaxed; the sequence of a slot is what
+// orders the accesses to its record, with acquire loads and release stores.
+static size_t
+load_size(atomic_size_t * value, memory_order order)
+{
+  size_t result = 0;
+  rcutils_atomic_load_explicit(value, result, order);
+  return result;
+}
+
+static bool
+compare_exchange_position(atomic_size_t * position, size_t * expected, size_t desired)
+{
+  bool result;
+  rcutils_atomic_compare_exchange_strong_explicit(
+    position, result, expected, desired, memory_order_relaxed, memory_order_relaxed);
+  return result;
+}
+
+static void
+increment_dropped_count(rcutils_logging_async_writer_t * writer)
+{
+  size_t previous;
+  rcutils_atomic_fetch_add_explicit(&writer->dropped_count, previous, 1u, memory_order_relaxed);
+  (void)previous;
+  RCUTILS_LOGGING_TRACEPOINT1(async_drop, (int)writer->overflow_policy);
+}
+
+// Take the oldest record out of the queue and hand it to `consume`, if there is one.
+static bool
+try_pop(rcutils_logging_async_writer_t * writer, record_consumer_t consume)
+{
+  size_t position = load_size(&writer->dequeue_position, memory_order_relaxed);
+  async_slot_t * slot;
+  while (true) {
+    slot = get_slot(writer, position);
+    size_t sequence = load_size(&slot->sequence, memory_order_acquire);
+    intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+    if (0 == difference) {
+      if (compare_exchange_position(&writer->dequeue_position, &position, position + 1)) {
+        break;
+      }
+      // position was updated by the failed exchange; try again.
+    } else if (difference < 0) {
+      // The slot for this lap hasn't been written yet: the queue is empty.
+      return false;
+    } else {
+      position = load_size(&writer->dequeue_position, memory_order_relaxed);
+    }
+  }
+
+  const char * data = slot->overflow_data ? slot->overflow_data : get_slot_storage(slot);
+  // The depth is approximate, as the producers carry on meanwhile.
+  RCUTILS_LOGGING_TRACEPOINT2(
+    async_dequeue, slot->length,
+    (intptr_t)(load_size(&writer->enqueue_position, memory_order_relaxed) - (position + 1)));
+  if (NULL != consume) {
+    consume(writer, data, slot->length);
+  }
+  if (NULL != slot->overflow_data) {
+    writer->allocator.deallocate(slot->overflow_data, writer->allocator.state);
+    slot->overflow_data = NULL;
+  }
+  // Release the slot for the producers of the next lap.
+  rcutils_atomic_store_explicit(
+    &slot->sequence, position + writer->mask + 1, memory_order_release);
+  return true;
+}
+
+static bool
+has_pending_records(rcutils_logging_async_writer_t * writer)
+{
+  // Sequentially consistent, as the consumer checks this after announcing it is going to sleep.
+  size_t position = load_size(&writer->dequeue_position, memory_order_seq_cst);
+  async_slot_t * slot = get_slot(writer, position);
+  return load_size(&slot->sequence, memory_order_seq_cst) == position + 1;
+}
+
+static void
+write_record(rcutils_logging_async_writer_t * writer, const char * data, size_t length)
+{
+  if (NULL != writer->record_handler) {
+    writer->record_handler(writer->stream, data, length);
+  } else {
+    (void)fwrite(data, 1, length, writer->stream);
+  }
+}
+
+static uint32_t
+get_time_refresh_ms(rcutils_logging_async_writer_t * writer)
+{
+  uint32_t result = 0;
+  rcutils_atomic_load(&writer->time_refresh_ms, result);
+  return result;
+}
+
+static void
+refresh_time(rcutils_logging_async_writer_t * writer)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK == rcutils_system_time_now(&now)) {
+    rcutils_atomic_store(&writer->cached_time, now);
+  } else {
+    rcutils_reset_error();
+  }
+}
+
+// Like write_record(), refreshing the cached time first so that it doesn't fall behind while
+// the consumer is busy writing.
+static void
+refresh_time_and_write_record(
+  rcutils_logging_async_writer_t * writer, const char * data, size_t length)
+{
+  refresh_time(writer);
+  write_record(writer, data, length);
+}
+
+static void
+wake_consumer(rcutils_logging_async_writer_t * writer)
+{
+  if (rcutils_atomic_load_bool(&writer->consumer_sleeping)) {
+    rcutils_mutex_lock(&writer->mutex);
+    rcutils_condition_variable_notify_all(&writer->condition);
+    rcutils_mutex_unlock(&writer->mutex);
+  }
+}
+
+static void
+consumer_main(void * arg)
+{
+  rcutils_logging_async_writer_t * writer = (rcutils_logging_async_writer_t *)arg;
+  while (true) {
+    // Read the stop flag before draining, so that everything pushed before the
+    // stop was requested is guaranteed to be written.
+    bool stop = rcutils_atomic_load_bool(&writer->stop_requested);
+    const uint32_t time_refresh_ms = get_time_refresh_ms(writer);
+    if (0u != time_refresh_ms) {
+      refresh_time(writer);
+    }
+    bool wrote_something = false;
+    while (try_pop(
+        writer, 0u != time_refresh_ms ? refresh_time_and_write_record : write_record))
+    {
+      wrote_something = true;
+    }
+    if (wrote_something) {
+      // Batch the flushes: only flush once the queue has been drained.
+      (void)fflush(writer->stream);
+    }
+    if (stop) {
+      break;
+    }
+
+    rcutils_mutex_lock(&writer->mutex);
+    // Producers check this flag after publishing a record, so either they see
+    // it set and notify, or the check below sees their record.
+    rcutils_atomic_store(&writer->consumer_sleeping, true);
+    if (!has_pending_records(writer) && !rcutils_atomic_load_bool(&writer->stop_requested)) {
+      rcutils_condition_variable_wait_for(
+        &writer->condition, &writer->mutex,
+        0u != time_refresh_ms && time_refresh_ms < ASYNC_CONSUMER_IDLE_TIMEOUT_MS ?
+        time_refresh_ms : ASYNC_CONSUMER_IDLE_TIMEOUT_MS);
+    }
+    rcutils_atomic_store(&writer->consumer_sleeping, false);
+    rcutils_mutex_unlock(&writer->mutex);
+  }
+}
+
+rcutils_ret_t
+rcutils_logging_async_writer_init(
+  rcutils_logging_async_writer_t ** writer,
+  const rcutils_logging_async_options_t * options,
+  FILE * stream,
+  rcutils_logging_async_record_handler_t record_handler,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(writer, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stream, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (options->queue_size < 2u || options->queue_size > (SIZE_MAX >> 2)) {
+    RCUTILS_SET_ERROR_MSG("async logging queue size must be at least 2");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == options->record_size) {
+    RCUTILS_SET_ERROR_MSG("async logging record size must be greater than 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  switch (options->overflow_policy) {
+    case RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP:
+    case RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK:
+    case RCUTILS_LOGGING_ASYNC_OVERFLOW_OVERWRITE_OLDEST:
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("invalid async logging overflow policy");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  size_t capacity = 2u;
+  while (capacity < options->queue_size) {
+    capacity <<= 1;
+  }
+  size_t stride = sizeof(async_slot_t) + options->record_size;
+  stride = (stride + ASYNC_SLOT_ALIGNMENT - 1) & ~((size_t)ASYNC_SLOT_ALIGNMENT - 1);
+  if (stride > SIZE_MAX / capacity) {
+    RCUTILS_SET_ERROR_MSG("async logging queue is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_logging_async_writer_t * new_writer =
+    allocator.zero_allocate(1, sizeof(rcutils_logging_async_writer_t), allocator.state);
+  if (NULL == new_writer) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate async logging writer");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_writer->slots = allocator.zero_allocate(capacity, stride, allocator.state);
+  if (NULL == new_writer->slots) {
+    allocator.deallocate(new_writer, allocator.state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate async logging queue");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_writer->allocator = allocator;
+  new_writer->stream = stream;
+  new_writer->record_handler = record_handler;
+  new_writer->overflow_policy = options->overflow_policy;
+  new_writer->record_size = options->record_size;
+  new_writer->slot_stride = stride;
+  new_writer->mask = capacity - 1;
+  for (size_t i = 0; i < capacity; ++i) {
+    atomic_init(&get_slot(new_writer, i)->sequence, i);
+  }
+  atomic_init(&new_writer->enqueue_position, 0u);
+  atomic_init(&new_writer->dequeue_position, 0u);
+  atomic_init(&new_writer->dropped_count, 0u);
+  atomic_init(&new_writer->consumer_sleeping, false);
+  atomic_init(&new_writer->stop_requested, false);
+  atomic_init(&new_writer->time_refresh_ms, 0u);
+  atomic_init(&new_writer->cached_time, 0);
+
+  rcutils_ret_t ret = rcutils_mutex_init(&new_writer->mutex);
+  if (RCUTILS_RET_OK != ret) {
+    goto fail_mutex;
+  }
+  ret = rcutils_condition_variable_init(&new_writer->condition);
+  if (RCUTILS_RET_OK != ret) {
+    goto fail_condition;
+  }
+  ret = rcutils_thread_create_with_attributes(
+    &new_writer->consumer, consumer_main, new_writer, &options->consumer_thread_attributes);
+  if (RCUTILS_RET_OK != ret) {
+    goto fail_thread;
+  }
+
+  *writer = new_writer;
+  return RCUTILS_RET_OK;
+
+fail_thread:
+  rcutils_condition_variable_fini(&new_writer->condition);
+fail_condition:
+  rcutils_mutex_fini(&new_writer->mutex);
+fail_mutex:
+  allocator.deallocate(new_writer->slots, allocator.state);
+  allocator.deallocate(new_writer, allocator.state);
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_logging_async_writer_push(
+  rcutils_logging_async_writer_t * writer, const char * data, size_t length)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(writer, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+
+  size_t position = load_size(&writer->enqueue_position, memory_order_relaxed);
+  async_slot_t * slot;
+  while (true) {
+    slot = get_slot(writer, position);
+    size_t sequence = load_size(&slot->sequence, memory_order_acquire);
+    intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+    if (0 == difference) {
+      if (compare_exchange_position(&writer->enqueue_position, &position, position + 1)) {
+        break;
+      }
+      // position was updated by the failed exchange; try again.
+    } else if (difference < 0) {
+      // The slot still holds a record from the previous lap: the queue is full.
+      switch (writer->overflow_policy) {
+        case RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK:
+          wake_consumer(writer);
+          rcutils_thread_yield();
+          break;
+        case RCUTILS_LOGGING_ASYNC_OVERFLOW_OVERWRITE_OLDEST:
+          if (try_pop(writer, NULL)) {
+            increment_dropped_count(writer);
+          }
+          break;
+        case RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP:
+        default:
+          increment_dropped_count(writer);
+          return RCUTILS_RET_OK;
+      }
+      position = load_size(&writer->enqueue_position, memory_order_relaxed);
+    } else {
+      position = load_size(&writer->enqueue_position, memory_order_relaxed);
+    }
+  }
+
+  if (length <= writer->record_size) {
+    memcpy(get_slot_storage(slot), data, length);
+  } else {
+    slot->overflow_data = writer->allocator.allocate(length, writer->allocator.state);
+    if (NULL != slot->overflow_data) {
+      memcpy(slot->overflow_data, data, length);
+    } else {
+      // We already own the slot, so it must be published; keep what fits.
+      memcpy(get_slot_storage(slot), data, writer->record_size);
+      length = writer->record_size;
+    }
+  }
+  slot->length = length;
+  // Publish the record to the consumers.  This is sequentially consistent rather than a
+  // release, so that it is ordered before checking whether the consumer is going to sleep.
+  rcutils_atomic_store(&slot->sequence, position + 1);
+  RCUTILS_LOGGING_TRACEPOINT2(
+    async_enqueue, length,
+    (intptr_t)(position + 1 - load_size(&writer->dequeue_position, memory_order_relaxed)));
+
+  wake_consumer(writer);
+  return RCUTILS_RET_OK;
+}
+
+size_t
+rcutils_logging_async_writer_get_dropped_count(rcutils_logging_async_writer_t * writer)
+{
+  if (NULL == writer) {
+    return 0u;
+  }
+  return load_size(&writer->dropped_count, memory_order_relaxed);
+}
+
+void
+rcutils_logging_async_writer_set_time_refresh(
+  rcutils_logging_async_writer_t * writer, uint32_t period_ms)
+{
+  if (NULL == writer) {
+    return;
+  }
+  if (0u != period_ms) {
+    // Don't leave the time unavailable until the consumer wakes up.
+    refresh_time(writer);
+  }
+  rcutils_atomic_store(&writer->time_refresh_ms, period_ms);
+  // Wake the consumer up to shorten its idle wait to the new period.
+  rcutils_mutex_lock(&writer->mutex);
+  rcutils_condition_variable_notify_all(&writer->condition);
+  rcutils_mutex_unlock(&writer->mutex);
+}
+
+bool
+rcutils_logging_async_writer_get_time(
+  rcutils_logging_async_writer_t * writer, rcutils_time_point_value_t * now)
+{
+  // The consumer may still store a time after the refresh was stopped, so check both.
+  if (NULL == writer || 0u == get_time_refresh_ms(writer)) {
+    return false;
+  }
+  const rcutils_time_point_value_t cached_time = rcutils_atomic_load_int64_t(&writer->cached_time);
+  if (0 == cached_time) {
+    return false;
+  }
+  *now = cached_time;
+  return true;
+}
+
+rcutils_ret_t
+rcutils_logging_async_writer_fini(rcutils_logging_async_writer_t * writer)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(writer, RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_mutex_lock(&writer->mutex);
+  rcutils_atomic_store(&writer->stop_requested, true);
+  rcutils_condition_variable_notify_all(&writer->condition);
+  rcutils_mutex_unlock(&writer->mutex);
+
+  rcutils_ret_t ret = rcutils_thread_join(&writer->consumer);
+  if (RCUTILS_RET_OK != ret) {
+    // The consumer thread may still be using the writer, so it can't be freed.
+    return ret;
+  }
+
+  // The consumer drained the queue before exiting, but write out anything that
+  // raced in afterwards so that nothing is lost or leaked.
+  while (try_pop(writer, write_record)) {
+  }
+  (void)fflush(writer->stream);
+
+  rcutils_condition_variable_fini(&writer->condition);
+  rcutils_mutex_fini(&writer->mutex);
+  rcutils_allocator_t allocator = writer->allocator;
+  allocator.deallocate(writer->slots, allocator.state);
+  allocator.deallocate(writer, allocator.state);
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,103 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal asynchronous writer used by the console output handler: a bounded
+// lock-free multi-producer queue of preformatted records, drained to a stream
+// by a dedicated consumer thread.
+
+#ifndef LOGGING_ASYNC_H_
+#define LOGGING_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control_macros.h"
+
+typedef struct rcutils_logging_async_writer_s rcutils_logging_async_writer_t;
+
+/// The signature of a function writing a record to the stream on the consumer thread.
+typedef void (* rcutils_logging_async_record_handler_t)(
+  FILE * stream, const char * data, size_t length);
+
+/// Allocate the queue and start the consumer thread writing to `stream`.
+/**
+ * Records are handed to `record_handler` on the consumer thread, or written to
+ * the stream as they are if it is NULL.
+ * The stream is flushed whenever the queue has been drained.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_async_writer_init(
+  rcutils_logging_async_writer_t ** writer,
+  const rcutils_logging_async_options_t * options,
+  FILE * stream,
+  rcutils_logging_async_record_handler_t record_handler,
+  rcutils_allocator_t allocator);
+
+/// Queue a copy of `length` bytes of `data` to be written to the stream.
+/**
+ * Safe to call concurrently from any number of threads.
+ * Returns #RCUTILS_RET_OK even if the record was dropped due to the overflow
+ * policy, as that is accounted for in the dropped count instead.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_async_writer_push(
+  rcutils_logging_async_writer_t * writer, const char * data, size_t length);
+
+/// Return the number of records dropped so far.
+RCUTILS_LOCAL
+size_t
+rcutils_logging_async_writer_get_dropped_count(rcutils_logging_async_writer_t * writer);
+
+/// Have the consumer thread refresh a cached system time every `period_ms`, or stop if 0.
+/**
+ * The consumer thread also refreshes the time before writing each record.
+ * Safe to call while other threads push records.
+ */
+RCUTILS_LOCAL
+void
+rcutils_logging_async_writer_set_time_refresh(
+  rcutils_logging_async_writer_t * writer, uint32_t period_ms);
+
+/// Get the system time cached by the consumer thread.
+/**
+ * Returns false if the time isn't being refreshed, in which case `now` is untouched.
+ */
+RCUTILS_LOCAL
+bool
+rcutils_logging_async_writer_get_time(
+  rcutils_logging_async_writer_t * writer, rcutils_time_point_value_t * now);
+
+/// Write out everything still queued, stop the consumer thread and free the writer.
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_async_writer_fini(rcutils_logging_async_writer_t * writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOGGING_ASYNC_H_
@@ -0,0 +1,903 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./logging_binary.h"
+
+#include "rcutils/error_handling.h"
+#include "rcutils/snprintf.h"
+
+// "RCLB" in a little endian dump, marks the start of every serialized record.
+#define BINARY_RECORD_MAGIC (0x424C4352u)
+
+#define BINARY_RECORD_FLAG_HAS_LOCATION (0x1u)
+#define BINARY_RECORD_FLAG_PREFORMATTED (0x2u)
+
+// Longer conversion specifications, e.g. with multi-digit widths, are formatted right away.
+#define BINARY_MAX_SPEC_LENGTH (32u)
+
+// Marks a NULL string argument.
+#define BINARY_NULL_STRING_LENGTH UINT32_MAX
+
+// All multi-byte values are copied with memcpy, as records are not aligned.
+typedef struct in_process_header_s
+{
+  rcutils_time_point_value_t timestamp;
+  const rcutils_log_location_t * location;
+  // NULL if the record is preformatted, in which case the message takes the place of the args.
+  const char * format;
+  int32_t severity;
+  // Excluding the null terminator, which follows the name.
+  uint32_t name_length;
+  uint32_t args_length;
+} in_process_header_t;
+
+typedef struct serialized_header_s
+{
+  uint32_t magic;
+  // Of the whole record, including this header.
+  uint32_t size;
+  int64_t timestamp;
+  uint64_t line_number;
+  int32_t severity;
+  uint32_t flags;
+  // The strings follow the header in this order, each followed by a null terminator, and are
+  // followed by the args.
+  uint32_t function_name_length;
+  uint32_t file_name_length;
+  uint32_t name_length;
+  uint32_t format_length;
+  uint32_t args_length;
+  uint32_t reserved;
+} serialized_header_t;
+
+typedef enum binary_arg_type_e
+{
+  BINARY_ARG_NONE,  // %%, no argument
+  BINARY_ARG_INT,
+  BINARY_ARG_UINT,
+  BINARY_ARG_LONG,
+  BINARY_ARG_ULONG,
+  BINARY_ARG_LLONG,
+  BINARY_ARG_ULLONG,
+  BINARY_ARG_INTMAX,
+  BINARY_ARG_UINTMAX,
+  BINARY_ARG_SIZE,
+  BINARY_ARG_PTRDIFF,
+  BINARY_ARG_DOUBLE,
+  BINARY_ARG_LONG_DOUBLE,
+  BINARY_ARG_POINTER,
+  BINARY_ARG_STRING,
+  BINARY_ARG_WRITE_COUNT,  // %n, the argument is consumed but nothing is written back
+  BINARY_ARG_UNSUPPORTED,
+} binary_arg_type_t;
+
+typedef struct binary_format_spec_s
+{
+  // Of the whole conversion specification, including the '%'.
+  size_t length;
+  bool width_from_arg;
+  bool precision_from_arg;
+  // The precision if it is given literally, else -1.
+  int precision;
+  binary_arg_type_t type;
+} binary_format_spec_t;
+
+typedef union binary_arg_value_u
+{
+  int64_t i;
+  uint64_t u;
+  double d;
+  long double ld;
+  const void * p;
+  const char * s;
+} binary_arg_value_t;
+
+static bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// Parse the conversion specification starting at the '%' pointed to by `start`.
+static void parse_format_spec(const char * start, binary_format_spec_t * spec)
+{
+  const char * c = start + 1;
+  spec->width_from_arg = false;
+  spec->precision_from_arg = false;
+  spec->precision = -1;
+  spec->type = BINARY_ARG_UNSUPPORTED;
+
+  if ('%' == *c) {
+    spec->type = BINARY_ARG_NONE;
+    spec->length = 2;
+    return;
+  }
+
+  while ('-' == *c || '+' == *c || ' ' == *c || '#' == *c || '0' == *c || '\'' == *c) {
+    ++c;
+  }
+  if ('*' == *c) {
+    spec->width_from_arg = true;
+    ++c;
+  } else {
+    while (is_digit(*c)) {
+      ++c;
+    }
+    if ('$' == *c) {
+      // Positional arguments can't be captured in order.
+      spec->length = (size_t)(c - start);
+      return;
+    }
+  }
+  if ('.' == *c) {
+    ++c;
+    if ('*' == *c) {
+      spec->precision_from_arg = true;
+      ++c;
+    } else {
+      spec->precision = 0;
+      while (is_digit(*c)) {
+        if (spec->precision < 100000) {
+          spec->precision = spec->precision * 10 + (*c - '0');
+        }
+        ++c;
+      }
+    }
+  }
+
+  enum {LENGTH_NONE, LENGTH_HH, LENGTH_H, LENGTH_L, LENGTH_LL, LENGTH_J, LENGTH_Z, LENGTH_T,
+    LENGTH_LONG_DOUBLE} length_modifier = LENGTH_NONE;
+  switch (*c) {
+    case 'h':
+      ++c;
+      length_modifier = LENGTH_H;
+      if ('h' == *c) {
+        ++c;
+        length_modifier = LENGTH_HH;
+      }
+      break;
+    case 'l':
+      ++c;
+      length_modifier = LENGTH_L;
+      if ('l' == *c) {
+        ++c;
+        length_modifier = LENGTH_LL;
+      }
+      break;
+    case 'j':
+      ++c;
+      length_modifier = LENGTH_J;
+      break;
+    case 'z':
+      ++c;
+      length_modifier = LENGTH_Z;
+      break;
+    case 't':
+      ++c;
+      length_modifier = LENGTH_T;
+      break;
+    case 'L':
+      ++c;
+      length_modifier = LENGTH_LONG_DOUBLE;
+      break;
+    default:
+      break;
+  }
+
+  if ('\0' == *c) {
+    spec->length = (size_t)(c - start);
+    return;
+  }
+  spec->length = (size_t)(c + 1 - start);
+
+  switch (*c) {
+    case 'd':
+    case 'i':
+      switch (length_modifier) {
+        case LENGTH_NONE:
+        case LENGTH_HH:
+        case LENGTH_H:
+          spec->type = BINARY_ARG_INT;
+          break;
+        case LENGTH_L:
+          spec->type = BINARY_ARG_LONG;
+          break;
+        case LENGTH_LL:
+          spec->type = BINARY_ARG_LLONG;
+          break;
+        case LENGTH_J:
+          spec->type = BINARY_ARG_INTMAX;
+          break;
+        case LENGTH_Z:
+          spec->type = BINARY_ARG_SIZE;
+          break;
+        case LENGTH_T:
+          spec->type = BINARY_ARG_PTRDIFF;
+          break;
+        default:
+          break;
+      }
+      break;
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+      switch (length_modifier) {
+        case LENGTH_NONE:
+        case LENGTH_HH:
+        case LENGTH_H:
+          spec->type = BINARY_ARG_UINT;
+          break;
+        case LENGTH_L:
+          spec->type = BINARY_ARG_ULONG;
+          break;
+        case LENGTH_LL:
+          spec->type = BINARY_ARG_ULLONG;
+          break;
+        case LENGTH_J:
+          spec->type = BINARY_ARG_UINTMAX;
+          break;
+        case LENGTH_Z:
+          spec->type = BINARY_ARG_SIZE;
+          break;
+        case LENGTH_T:
+          spec->type = BINARY_ARG_PTRDIFF;
+          break;
+        default:
+          break;
+      }
+      break;
+    case 'c':
+      // Wide characters (%lc) aren't supported.
+      if (LENGTH_NONE == length_modifier) {
+        spec->type = BINARY_ARG_INT;
+      }
+      break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      if (LENGTH_LONG_DOUBLE == length_modifier) {
+        spec->type = BINARY_ARG_LONG_DOUBLE;
+      } else if (LENGTH_NONE == length_modifier || LENGTH_L == length_modifier) {
+        spec->type = BINARY_ARG_DOUBLE;
+      }
+      break;
+    case 's':
+      // Wide strings (%ls) aren't supported.
+      if (LENGTH_NONE == length_modifier) {
+        spec->type = BINARY_ARG_STRING;
+      }
+      break;
+    case 'p':
+      if (LENGTH_NONE == length_modifier) {
+        spec->type = BINARY_ARG_POINTER;
+      }
+      break;
+    case 'n':
+      spec->type = BINARY_ARG_WRITE_COUNT;
+      break;
+    default:
+      // Anything else, e.g. glibc's %m which depends on errno at the time of the call.
+      break;
+  }
+
+  if (spec->length >= BINARY_MAX_SPEC_LENGTH) {
+    spec->type = BINARY_ARG_UNSUPPORTED;
+  }
+}
+
+static rcutils_ret_t append_bytes(rcutils_char_array_t * array, const void * data, size_t length)
+{
+  // Keep a spare byte, as growing a buffer which isn't owned overwrites its last byte with a
+  // null terminator.
+  rcutils_ret_t ret = rcutils_char_array_expand_as_needed(
+    array, array->buffer_length + length + 1);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  if (length > 0) {
+    memcpy(array->buffer + array->buffer_length, data, length);
+  }
+  array->buffer_length += length;
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t append_string(rcutils_char_array_t * array, const char * str, size_t length)
+{
+  rcutils_ret_t ret = append_bytes(array, str, length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  return append_bytes(array, "", 1);
+}
+
+static rcutils_ret_t append_string_arg(
+  rcutils_char_array_t * array, const char * str, int precision)
+{
+  uint32_t length = BINARY_NULL_STRING_LENGTH;
+  if (NULL != str) {
+    // With a precision the string doesn't need to be null terminated.
+    size_t string_length = 0;
+    while ((precision < 0 || string_length < (size_t)precision) && '\0' != str[string_length]) {
+      ++string_length;
+    }
+    if (string_length >= BINARY_NULL_STRING_LENGTH) {
+      RCUTILS_SET_ERROR_MSG("string argument is too long for a binary log record");
+      return RCUTILS_RET_ERROR;
+    }
+    length = (uint32_t)string_length;
+  }
+  rcutils_ret_t ret = append_bytes(array, &length, sizeof(length));
+  if (RCUTILS_RET_OK != ret || NULL == str) {
+    return ret;
+  }
+  return append_string(array, str, length);
+}
+
+// Append the arguments used by format to the record, or set `supported` to false.
+static rcutils_ret_t capture_args(
+  const char * format, va_list * args, rcutils_char_array_t * record, bool * supported)
+{
+  *supported = true;
+  const char * c = format;
+  while ('\0' != *c) {
+    if ('%' != *c) {
+      ++c;
+      continue;
+    }
+    binary_format_spec_t spec;
+    parse_format_spec(c, &spec);
+    if (BINARY_ARG_UNSUPPORTED == spec.type) {
+      *supported = false;
+      return RCUTILS_RET_OK;
+    }
+    c += spec.length;
+
+    rcutils_ret_t ret = RCUTILS_RET_OK;
+    int precision = spec.precision;
+    if (spec.width_from_arg) {
+      int64_t width = va_arg(*args, int);
+      ret = append_bytes(record, &width, sizeof(width));
+    }
+    if (RCUTILS_RET_OK == ret && spec.precision_from_arg) {
+      precision = va_arg(*args, int);
+      int64_t value = precision;
+      ret = append_bytes(record, &value, sizeof(value));
+    }
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+
+    binary_arg_value_t value;
+    size_t value_size = sizeof(uint64_t);
+    switch (spec.type) {
+      case BINARY_ARG_NONE:
+        value_size = 0;
+        break;
+      case BINARY_ARG_INT:
+        value.i = va_arg(*args, int);
+        break;
+      case BINARY_ARG_UINT:
+        value.u = va_arg(*args, unsigned int);
+        break;
+      case BINARY_ARG_LONG:
+        value.i = va_arg(*args, long);  // NOLINT(runtime/int)
+        break;
+      case BINARY_ARG_ULONG:
+        value.u = va_arg(*args, unsigned long);  // NOLINT(runtime/int)
+        break;
+      case BINARY_ARG_LLONG:
+        value.i = va_arg(*args, long long);  // NOLINT(runtime/int)
+        break;
+      case BINARY_ARG_ULLONG:
+        value.u = va_arg(*args, unsigned long long);  // NOLINT(runtime/int)
+        break;
+      case BINARY_ARG_INTMAX:
+        value.i = va_arg(*args, intmax_t);
+        break;
+      case BINARY_ARG_UINTMAX:
+        value.u = va_arg(*args, uintmax_t);
+        break;
+      case BINARY_ARG_SIZE:
+        value.u = va_arg(*args, size_t);
+        break;
+      case BINARY_ARG_PTRDIFF:
+        value.i = va_arg(*args, ptrdiff_t);
+        break;
+      case BINARY_ARG_DOUBLE:
+        value.d = va_arg(*args, double);
+        break;
+      case BINARY_ARG_LONG_DOUBLE:
+        value.ld = va_arg(*args, long double);
+        value_size = sizeof(long double);
+        break;
+      case BINARY_ARG_POINTER:
+        value.p = va_arg(*args, void *);
+        value_size = sizeof(void *);
+        break;
+      case BINARY_ARG_STRING:
+        ret = append_string_arg(record, va_arg(*args, const char *), precision);
+        if (RCUTILS_RET_OK != ret) {
+          return ret;
+        }
+        value_size = 0;
+        break;
+      case BINARY_ARG_WRITE_COUNT:
+        (void)va_arg(*args, void *);
+        value_size = 0;
+        break;
+      default:
+        *supported = false;
+        return RCUTILS_RET_OK;
+    }
+    if (value_size > 0) {
+      ret = append_bytes(record, &value, value_size);
+      if (RCUTILS_RET_OK != ret) {
+        return ret;
+      }
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_logging_binary_encode(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args, rcutils_char_array_t * record)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(format, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(args, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(record, RCUTILS_RET_INVALID_ARGUMENT);
+
+  in_process_header_t header;
+  memset(&header, 0, sizeof(header));
+  header.timestamp = timestamp;
+  header.location = location;
+  header.format = format;
+  header.severity = severity;
+  size_t name_length = NULL != name ? strlen(name) : 0;
+  if (name_length >= UINT32_MAX) {
+    RCUTILS_SET_ERROR_MSG("logger name is too long for a binary log record");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  header.name_length = (uint32_t)name_length;
+
+  record->buffer_length = 0;
+  rcutils_ret_t ret = append_bytes(record, &header, sizeof(header));
+  if (RCUTILS_RET_OK == ret) {
+    ret = append_string(record, NULL != name ? name : "", name_length);
+  }
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  const size_t args_offset = record->buffer_length;
+
+  bool supported = false;
+  va_list args_copy;
+  va_copy(args_copy, *args);
+  ret = capture_args(format, &args_copy, record, &supported);
+  va_end(args_copy);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  if (!supported) {
+    // Fall back to formatting the message now.
+    record->buffer_length = args_offset;
+    va_copy(args_copy, *args);
+    int size = rcutils_vsnprintf(NULL, 0, format, args_copy);
+    va_end(args_copy);
+    if (size < 0) {
+      RCUTILS_SET_ERROR_MSG("failed to format log message");
+      return RCUTILS_RET_ERROR;
+    }
+    ret = rcutils_char_array_expand_as_needed(record, args_offset + (size_t)size + 1);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+    va_copy(args_copy, *args);
+    int written = rcutils_vsnprintf(
+      record->buffer + args_offset, (size_t)size + 1, format, args_copy);
+    va_end(args_copy);
+    if (written != size) {
+      RCUTILS_SET_ERROR_MSG("failed to format log message");
+      return RCUTILS_RET_ERROR;
+    }
+    record->buffer_length = args_offset + (size_t)size + 1;
+    header.format = NULL;
+  }
+
+  if (record->buffer_length - args_offset >= UINT32_MAX) {
+    RCUTILS_SET_ERROR_MSG("arguments are too long for a binary log record");
+    return RCUTILS_RET_ERROR;
+  }
+  header.args_length = (uint32_t)(record->buffer_length - args_offset);
+  memcpy(record->buffer, &header, sizeof(header));
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_logging_binary_decode(
+  const char * record, size_t length, rcutils_logging_binary_record_view_t * view)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(record, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(view, RCUTILS_RET_INVALID_ARGUMENT);
+
+  in_process_header_t header;
+  if (length < sizeof(header)) {
+    RCUTILS_SET_ERROR_MSG("binary log record is truncated");
+    return RCUTILS_RET_ERROR;
+  }
+  memcpy(&header, record, sizeof(header));
+  if ((uint64_t)sizeof(header) + header.name_length + 1u + header.args_length != length) {
+    RCUTILS_SET_ERROR_MSG("binary log record is corrupted");
+    return RCUTILS_RET_ERROR;
+  }
+
+  view->severity = header.severity;
+  view->timestamp = header.timestamp;
+  view->location = header.location;
+  view->name = record + sizeof(header);
+  view->is_preformatted = NULL == header.format;
+  view->args = view->name + header.name_length + 1;
+  view->args_length = header.args_length;
+  view->format = view->is_preformatted ? view->args : header.format;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_logging_binary_serialize(
+  const rcutils_logging_binary_record_view_t * view, rcutils_char_array_t * output)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(view, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output, RCUTILS_RET_INVALID_ARGUMENT);
+
+  const char * function_name = "";
+  const char * file_name = "";
+  serialized_header_t header;
+  memset(&header, 0, sizeof(header));
+  header.magic = BINARY_RECORD_MAGIC;
+  header.timestamp = view->timestamp;
+  header.severity = view->severity;
+  if (NULL != view->location) {
+    header.flags |= BINARY_RECORD_FLAG_HAS_LOCATION;
+    function_name = view->location->function_name;
+    file_name = view->location->file_name;
+    header.line_number = view->location->line_number;
+  }
+  if (view->is_preformatted) {
+    header.flags |= BINARY_RECORD_FLAG_PREFORMATTED;
+  }
+  size_t function_name_length = strlen(function_name);
+  size_t file_name_length = strlen(file_name);
+  size_t name_length = strlen(view->name);
+  // The message of a preformatted record is stored as the format, without args.
+  size_t format_length = strlen(view->format);
+  size_t args_length = view->is_preformatted ? 0 : view->args_length;
+  uint64_t size = (uint64_t)sizeof(header) + function_name_length + file_name_length +
+    name_length + format_length + args_length + 4u;
+  if (size >= UINT32_MAX) {
+    RCUTILS_SET_ERROR_MSG("binary log record is too large to be serialized");
+    return RCUTILS_RET_ERROR;
+  }
+  header.size = (uint32_t)size;
+  header.function_name_length = (uint32_t)function_name_length;
+  header.file_name_length = (uint32_t)file_name_length;
+  header.name_length = (uint32_t)name_length;
+  header.format_length = (uint32_t)format_length;
+  header.args_length = (uint32_t)args_length;
+
+  rcutils_ret_t ret = append_bytes(output, &header, sizeof(header));
+  if (RCUTILS_RET_OK == ret) {
+    ret = append_string(output, function_name, function_name_length);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = append_string(output, file_name, file_name_length);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = append_string(output, view->name, name_length);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = append_string(output, view->format, format_length);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = append_bytes(output, view->args, args_length);
+  }
+  return ret;
+}
+
+// Return the string of the given length at data + *offset, and advance the offset past it.
+static const char * take_string(
+  const char * data, size_t size, size_t * offset, uint32_t length)
+{
+  if ((uint64_t)*offset + length + 1u > size || '\0' != data[*offset + length]) {
+    return NULL;
+  }
+  const char * str = data + *offset;
+  *offset += (size_t)length + 1u;
+  return str;
+}
+
+rcutils_ret_t
+rcutils_logging_binary_deserialize(
+  const char * data, size_t size, size_t * record_size,
+  rcutils_logging_binary_record_view_t * view)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(record_size, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(view, RCUTILS_RET_INVALID_ARGUMENT);
+
+  serialized_header_t header;
+  if (size < sizeof(header)) {
+    RCUTILS_SET_ERROR_MSG("binary log record is truncated");
+    return RCUTILS_RET_ERROR;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (BINARY_RECORD_MAGIC != header.magic) {
+    RCUTILS_SET_ERROR_MSG("not a binary log record");
+    return RCUTILS_RET_ERROR;
+  }
+  if (header.size > size) {
+    RCUTILS_SET_ERROR_MSG("binary log record is truncated");
+    return RCUTILS_RET_ERROR;
+  }
+  size = header.size;
+
+  size_t offset = sizeof(header);
+  const char * function_name = take_string(data, size, &offset, header.function_name_length);
+  const char * file_name = take_string(data, size, &offset, header.file_name_length);
+  const char * name = take_string(data, size, &offset, header.name_length);
+  const char * format = take_string(data, size, &offset, header.format_length);
+  if (NULL == function_name || NULL == file_name || NULL == name || NULL == format ||
+    (uint64_t)offset + header.args_length != size)
+  {
+    RCUTILS_SET_ERROR_MSG("binary log record is corrupted");
+    return RCUTILS_RET_ERROR;
+  }
+
+  view->severity = header.severity;
+  view->timestamp = header.timestamp;
+  view->location_storage.function_name = function_name;
+  view->location_storage.file_name = file_name;
+  view->location_storage.line_number = (size_t)header.line_number;
+  view->location =
+    (header.flags & BINARY_RECORD_FLAG_HAS_LOCATION) ? &view->location_storage : NULL;
+  view->name = name;
+  view->format = format;
+  view->is_preformatted = 0 != (header.flags & BINARY_RECORD_FLAG_PREFORMATTED);
+  view->args = data + offset;
+  view->args_length = header.args_length;
+  *record_size = size;
+  return RCUTILS_RET_OK;
+}
+
+typedef struct args_reader_s
+{
+  const char * data;
+  size_t remaining;
+} args_reader_t;
+
+static bool read_arg(args_reader_t * reader, void * value, size_t size)
+{
+  if (reader->remaining < size) {
+    return false;
+  }
+  memcpy(value, reader->data, size);
+  reader->data += size;
+  reader->remaining -= size;
+  return true;
+}
+
+static bool read_string_arg(args_reader_t * reader, const char ** str)
+{
+  uint32_t length;
+  if (!read_arg(reader, &length, sizeof(length))) {
+    return false;
+  }
+  if (BINARY_NULL_STRING_LENGTH == length) {
+    *str = NULL;
+    return true;
+  }
+  if (reader->remaining < (size_t)length + 1u || '\0' != reader->data[length]) {
+    return false;
+  }
+  *str = reader->data;
+  reader->data += (size_t)length + 1u;
+  reader->remaining -= (size_t)length + 1u;
+  return true;
+}
+
+#define FORMAT_VALUE(value) \
+  (spec->width_from_arg ? \
+  (spec->precision_from_arg ? \
+  rcutils_snprintf(buffer, buffer_size, spec_format, width, precision, value) : \
+  rcutils_snprintf(buffer, buffer_size, spec_format, width, value)) : \
+  (spec->precision_from_arg ? \
+  rcutils_snprintf(buffer, buffer_size, spec_format, precision, value) : \
+  rcutils_snprintf(buffer, buffer_size, spec_format, value)))
+
+static int format_value(
+  char * buffer, size_t buffer_size, const char * spec_format, const binary_format_spec_t * spec,
+  int width, int precision, const binary_arg_value_t * value)
+{
+  switch (spec->type) {
+    case BINARY_ARG_INT:
+      return FORMAT_VALUE((int)value->i);
+    case BINARY_ARG_UINT:
+      return FORMAT_VALUE((unsigned int)value->u);
+    case BINARY_ARG_LONG:
+      return FORMAT_VALUE((long)value->i);  // NOLINT(runtime/int)
+    case BINARY_ARG_ULONG:
+      return FORMAT_VALUE((unsigned long)value->u);  // NOLINT(runtime/int)
+    case BINARY_ARG_LLONG:
+      return FORMAT_VALUE((long long)value->i);  // NOLINT(runtime/int)
+    case BINARY_ARG_ULLONG:
+      return FORMAT_VALUE((unsigned long long)value->u);  // NOLINT(runtime/int)
+    case BINARY_ARG_INTMAX:
+      return FORMAT_VALUE((intmax_t)value->i);
+    case BINARY_ARG_UINTMAX:
+      return FORMAT_VALUE((uintmax_t)value->u);
+    case BINARY_ARG_SIZE:
+      return FORMAT_VALUE((size_t)value->u);
+    case BINARY_ARG_PTRDIFF:
+      return FORMAT_VALUE((ptrdiff_t)value->i);
+    case BINARY_ARG_DOUBLE:
+      return FORMAT_VALUE(value->d);
+    case BINARY_ARG_LONG_DOUBLE:
+      return FORMAT_VALUE(value->ld);
+    case BINARY_ARG_POINTER:
+      return FORMAT_VALUE(value->p);
+    case BINARY_ARG_STRING:
+      return FORMAT_VALUE(value->s);
+    default:
+      return -1;
+  }
+}
+
+#undef FORMAT_VALUE
+
+static rcutils_ret_t append_value(
+  rcutils_char_array_t * message, const char * spec_format, const binary_format_spec_t * spec,
+  int width, int precision, const binary_arg_value_t * value)
+{
+  // The message always holds a null terminated string here.
+  const size_t current_strlen = message->buffer_length - 1;
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    int size = format_value(
+      message->buffer + current_strlen, message->buffer_capacity - current_strlen,
+      spec_format, spec, width, precision, value);
+    if (size < 0) {
+      RCUTILS_SET_ERROR_MSG("failed to format an argument of a binary log record");
+      return RCUTILS_RET_ERROR;
+    }
+    const size_t new_length = current_strlen + (size_t)size + 1;
+    if (new_length <= message->buffer_capacity) {
+      message->buffer_length = new_length;
+      return RCUTILS_RET_OK;
+    }
+    rcutils_ret_t ret = rcutils_char_array_expand_as_needed(message, new_length);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+  RCUTILS_SET_ERROR_MSG("failed to format an argument of a binary log record");
+  return RCUTILS_RET_ERROR;
+}
+
+rcutils_ret_t
+rcutils_logging_binary_format_message(
+  const rcutils_logging_binary_record_view_t * view, rcutils_char_array_t * message)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(view, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message, RCUTILS_RET_INVALID_ARGUMENT);
+
+  message->buffer_length = 0;
+  if (view->is_preformatted) {
+    return rcutils_char_array_strcpy(message, view->format);
+  }
+  rcutils_ret_t ret = rcutils_char_array_strncat(message, "", 0);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  args_reader_t reader = {view->args, view->args_length};
+  const char * literal_start = view->format;
+  const char * c = view->format;
+  while ('\0' != *c) {
+    if ('%' != *c) {
+      ++c;
+      continue;
+    }
+    ret = rcutils_char_array_strncat(message, literal_start, (size_t)(c - literal_start));
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+
+    binary_format_spec_t spec;
+    parse_format_spec(c, &spec);
+    if (BINARY_ARG_UNSUPPORTED == spec.type) {
+      RCUTILS_SET_ERROR_MSG("unsupported conversion in the format of a binary log record");
+      return RCUTILS_RET_ERROR;
+    }
+    char spec_format[BINARY_MAX_SPEC_LENGTH];
+    memcpy(spec_format, c, spec.length);
+    spec_format[spec.length] = '\0';
+    c += spec.length;
+    literal_start = c;
+
+    int64_t width = 0;
+    int64_t precision = 0;
+    bool valid = true;
+    if (spec.width_from_arg) {
+      valid = read_arg(&reader, &width, sizeof(width));
+    }
+    if (valid && spec.precision_from_arg) {
+      valid = read_arg(&reader, &precision, sizeof(precision));
+    }
+
+    binary_arg_value_t value;
+    switch (spec.type) {
+      case BINARY_ARG_NONE:
+        ret = rcutils_char_array_strncat(message, "%", 1);
+        break;
+      case BINARY_ARG_WRITE_COUNT:
+        break;
+      case BINARY_ARG_LONG_DOUBLE:
+        valid = valid && read_arg(&reader, &value.ld, sizeof(long double));
+        break;
+      case BINARY_ARG_POINTER:
+        valid = valid && read_arg(&reader, &value.p, sizeof(void *));
+        break;
+      case BINARY_ARG_STRING:
+        valid = valid && read_string_arg(&reader, &value.s);
+        break;
+      default:
+        valid = valid && read_arg(&reader, &value.u, sizeof(uint64_t));
+        break;
+    }
+    if (!valid) {
+      RCUTILS_SET_ERROR_MSG("binary log record is missing arguments");
+      return RCUTILS_RET_ERROR;
+    }
+    if (RCUTILS_RET_OK == ret && BINARY_ARG_NONE != spec.type &&
+      BINARY_ARG_WRITE_COUNT != spec.type)
+    {
+      ret = append_value(message, spec_format, &spec, (int)width, (int)precision, &value);
+    }
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+  return rcutils_char_array_strncat(message, literal_start, (size_t)(c - literal_start));
+}
+
+#ifdef __cplusplus
+}
+#endif
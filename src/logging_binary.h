@@ -0,0 +1,106 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal encoding of log calls into binary records, which capture the raw
+// arguments instead of the formatted message so that formatting can happen
+// later, on another thread or offline.
+//
+// Records come in two forms:
+// - in-process records reference the location and the format string by
+//   pointer, which is what the logging thread produces, and
+// - serialized records contain copies of all strings, which is what is written
+//   to a stream for offline decoding.
+
+#ifndef LOGGING_BINARY_H_
+#define LOGGING_BINARY_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/logging.h"
+#include "rcutils/types/char_array.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control_macros.h"
+
+/// A decoded record of either form, pointing into the record it was decoded from.
+typedef struct rcutils_logging_binary_record_view_s
+{
+  int severity;
+  rcutils_time_point_value_t timestamp;
+  /// NULL if the log call had no location.
+  const rcutils_log_location_t * location;
+  /// Storage for the location of serialized records.
+  rcutils_log_location_t location_storage;
+  const char * name;
+  /// The format string, or the message if is_preformatted is true.
+  const char * format;
+  bool is_preformatted;
+  const char * args;
+  size_t args_length;
+} rcutils_logging_binary_record_view_t;
+
+/// Encode a log call into an in-process record, replacing the contents of `record`.
+/**
+ * The arguments are captured according to the format string, with string
+ * arguments copied.
+ * Format strings using conversions which can't be captured are formatted
+ * right away instead, which results in a preformatted record.
+ * The va_list is not modified.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_binary_encode(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args, rcutils_char_array_t * record);
+
+/// Decode an in-process record produced by rcutils_logging_binary_encode().
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_binary_decode(
+  const char * record, size_t length, rcutils_logging_binary_record_view_t * view);
+
+/// Append the serialized form of a decoded record to `output`.
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_binary_serialize(
+  const rcutils_logging_binary_record_view_t * view, rcutils_char_array_t * output);
+
+/// Decode the serialized record at the start of `data`.
+/**
+ * \param[out] record_size the size of the record, to find the next one
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_binary_deserialize(
+  const char * data, size_t size, size_t * record_size,
+  rcutils_logging_binary_record_view_t * view);
+
+/// Format the message of a decoded record, replacing the contents of `message`.
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_binary_format_message(
+  const rcutils_logging_binary_record_view_t * view, rcutils_char_array_t * message);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOGGING_BINARY_H_
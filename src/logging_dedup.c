@@ -0,0 +1,175 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#ifdef _WIN32
+// See logging.c for why warning C5105 is disabled.
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#endif
+
+#include "./logging_dedup.h"
+
+// Callsites sharing a slot take it over from each other, which only makes them suppress less.
+#define RCUTILS_LOGGING_DEDUP_SLOTS (256u)
+
+typedef struct logging_dedup_slot_s
+{
+  // The location of the callsite owning the slot.
+  uint64_t callsite;
+  // The hash of the callsite and of its last message, never zero once the slot is owned.
+  uint64_t key;
+  // The timestamp of the last output of the message.
+  uint64_t window_start;
+  // The messages suppressed since then.
+  uint64_t repeats;
+} logging_dedup_slot_t;
+
+static logging_dedup_slot_t g_rcutils_logging_dedup_slots[RCUTILS_LOGGING_DEDUP_SLOTS];
+
+static uint64_t load_uint64(uint64_t * object)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)object, 0, 0);
+#else
+  return __atomic_load_n(object, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void store_uint64(uint64_t * object, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)object, (LONG64)value);
+#else
+  __atomic_store_n(object, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static uint64_t exchange_uint64(uint64_t * object, uint64_t value)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedExchange64((volatile LONG64 *)object, (LONG64)value);
+#else
+  return __atomic_exchange_n(object, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static void add_uint64(uint64_t * object, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchangeAdd64((volatile LONG64 *)object, (LONG64)value);
+#else
+  __atomic_fetch_add(object, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static bool compare_exchange_uint64(uint64_t * object, uint64_t expected, uint64_t desired)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64(
+    (volatile LONG64 *)object, (LONG64)desired, (LONG64)expected) == expected;
+#else
+  return __atomic_compare_exchange_n(
+    object, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// The finalizer of MurmurHash3, spreading the bits of aligned pointers over the whole value.
+static uint64_t mix_uint64(uint64_t value)
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+uint64_t
+rcutils_logging_dedup_hash(const char * message, size_t length)
+{
+  // FNV-1a.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0u; i < length; ++i) {
+    hash ^= (uint64_t)(unsigned char)message[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+bool
+rcutils_logging_dedup_check(
+  const rcutils_log_location_t * location, uint64_t message_hash,
+  rcutils_time_point_value_t timestamp, rcutils_duration_value_t interval, uint64_t * repeats)
+{
+  const uint64_t callsite = (uint64_t)(uintptr_t)location;
+  const uint64_t callsite_hash = mix_uint64(callsite);
+  logging_dedup_slot_t * slot =
+    &g_rcutils_logging_dedup_slots[callsite_hash % RCUTILS_LOGGING_DEDUP_SLOTS];
+  const uint64_t key = (callsite_hash ^ message_hash) | 1u;
+  *repeats = 0u;
+
+  if (load_uint64(&slot->key) == key) {
+    const uint64_t window_start = load_uint64(&slot->window_start);
+    // A clock going backwards restarts the window rather than suppressing until it catches up.
+    const bool within_interval = timestamp >= (rcutils_time_point_value_t)window_start &&
+      timestamp - (rcutils_time_point_value_t)window_start < interval;
+    // Of the threads seeing the interval elapse, only the one restarting the window outputs.
+    if (within_interval ||
+      !compare_exchange_uint64(&slot->window_start, window_start, (uint64_t)timestamp))
+    {
+      add_uint64(&slot->repeats, 1u);
+      return false;
+    }
+    *repeats = exchange_uint64(&slot->repeats, 0u);
+    return true;
+  }
+
+  // Another message of this callsite, or another callsite sharing the slot, takes it over.
+  // Repeats counted concurrently by threads which still see the previous key may be reported
+  // along with the next summary, so the numbers are approximate under contention.
+  const uint64_t previous_callsite = exchange_uint64(&slot->callsite, callsite);
+  const uint64_t previous_repeats = exchange_uint64(&slot->repeats, 0u);
+  store_uint64(&slot->window_start, (uint64_t)timestamp);
+  store_uint64(&slot->key, key);
+  // The repeats of another callsite can't be reported in the name of this one.
+  if (previous_callsite == callsite) {
+    *repeats = previous_repeats;
+  }
+  return true;
+}
+
+void
+rcutils_logging_dedup_reset(void)
+{
+  for (size_t i = 0u; i < RCUTILS_LOGGING_DEDUP_SLOTS; ++i) {
+    logging_dedup_slot_t * slot = &g_rcutils_logging_dedup_slots[i];
+    store_uint64(&slot->key, 0u);
+    store_uint64(&slot->callsite, 0u);
+    store_uint64(&slot->window_start, 0u);
+    store_uint64(&slot->repeats, 0u);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,62 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal suppression of repeated messages: the last message of each callsite is remembered by
+// the hash of its formatted text in a fixed table indexed by the location pointer, which is only
+// updated with atomic operations, so that logging threads never wait on each other.
+
+#ifndef LOGGING_DEDUP_H_
+#define LOGGING_DEDUP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/visibility_control_macros.h"
+
+/// Hash the formatted text of a message.
+RCUTILS_LOCAL
+uint64_t
+rcutils_logging_dedup_hash(const char * message, size_t length);
+
+/// Check whether a message repeats the last one of its callsite within the interval.
+/**
+ * Returns false if the message must be suppressed, since it is the same as the last one of the
+ * callsite and the interval since the last output of that one hasn't elapsed yet.
+ * Otherwise the message must be output, after a summary if `repeats` is set to a non-zero number
+ * of messages of this callsite which were suppressed since its last output.
+ */
+RCUTILS_LOCAL
+bool
+rcutils_logging_dedup_check(
+  const rcutils_log_location_t * location, uint64_t message_hash,
+  rcutils_time_point_value_t timestamp, rcutils_duration_value_t interval, uint64_t * repeats);
+
+/// Forget the last message of every callsite, and the repeats not reported yet.
+RCUTILS_LOCAL
+void
+rcutils_logging_dedup_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOGGING_DEDUP_H_
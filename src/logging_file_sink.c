@@ -0,0 +1,773 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+# include <io.h>
+#else
+# include <sys/uio.h>
+# include <unistd.h>
+#endif
+
+#include "./logging_lz4.h"
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/async_write.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/format_string.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_file_sink.h"
+#include "rcutils/strdup.h"
+#include "rcutils/strerror.h"
+#include "rcutils/types/char_array.h"
+
+#define FILE_SINK_DEFAULT_BUFFER_SIZE (256u * 1024u)
+#define FILE_SINK_DEFAULT_BUFFER_COUNT (4u)
+#define FILE_SINK_DEFAULT_MAX_FILES (5u)
+#define FILE_SINK_DEFAULT_FLUSH_INTERVAL_MS (1000u)
+
+#define FILE_SINK_LINE_BUFFER_SIZE (1024)
+// The most buffers written with a single call.
+#define FILE_SINK_MAX_BATCH (16)
+// How long logging threads wait at a time for a buffer to be written when none is free.
+#define FILE_SINK_WAIT_MS (100u)
+
+typedef struct file_sink_buffer_s
+{
+  struct rcutils_logging_file_sink_s * sink;
+  char * data;
+  size_t length;
+  // Start a new file before writing this buffer.
+  bool rotate_before;
+} file_sink_buffer_t;
+
+struct rcutils_logging_file_sink_s
+{
+  rcutils_logging_file_sink_options_t options;
+  rcutils_allocator_t allocator;
+  // The capacity of each buffer, a multiple of the page size.
+  size_t buffer_capacity;
+  void * buffer_memory;
+  file_sink_buffer_t * buffers;
+
+  // Everything below up to the file descriptor is protected by the mutex.
+  rcutils_mutex_t mutex;
+  // Notified whenever buffers are submitted or written, and when stopping.
+  rcutils_condition_variable_t cv;
+  // The indices of the free buffers, used as a stack.
+  size_t * free_buffers;
+  size_t free_count;
+  // The indices of the buffers waiting to be written, used as a ring.
+  size_t * pending_buffers;
+  size_t pending_head;
+  size_t pending_count;
+  // The buffer being filled, or NULL.
+  file_sink_buffer_t * active;
+  // The next buffer taken starts a new file.
+  bool rotate_pending;
+  // A line is being appended while the mutex is released to wait for a free buffer.
+  bool line_in_progress;
+  // The size and the time of the first message of the file being filled, used for rotation.
+  size_t file_size;
+  rcutils_time_point_value_t file_start_time;
+  bool file_has_start_time;
+  uint64_t submitted_count;
+  uint64_t written_count;
+  // The buffers submitted to the async writer and not written yet.
+  size_t in_flight_count;
+  size_t lost_bytes;
+  bool stopping;
+
+  // Buffers are submitted to the async writer, at explicit offsets.
+  bool async_writes;
+  // Only used by the writer thread once it is started.
+  int fd;
+  // The offset to write the next buffer at, with async writes.
+  int64_t file_offset;
+  // The frame each buffer is compressed into, and the hash table of the compressor.
+  char * frame;
+  uint16_t * lz4_table;
+  rcutils_thread_t thread;
+  bool mutex_initialized;
+  bool cv_initialized;
+};
+
+static size_t get_page_size(void)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (size_t)info.dwPageSize;
+#else
+  long page_size = sysconf(_SC_PAGESIZE);  // NOLINT(runtime/int)
+  return page_size > 0 ? (size_t)page_size : 4096u;
+#endif
+}
+
+// Open the file for appending, or for writing at explicit offsets, which appending ignores.
+static int open_log_file(const char * path, bool append)
+{
+#ifdef _WIN32
+  return _open(
+    path, _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : 0), _S_IREAD | _S_IWRITE);
+#else
+  return open(path, O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : 0), 0644);
+#endif
+}
+
+static size_t get_log_file_size(int fd)
+{
+#ifdef _WIN32
+  struct _stat64 status;
+  if (0 != _fstat64(fd, &status) || status.st_size < 0) {
+    return 0u;
+  }
+#else
+  struct stat status;
+  if (0 != fstat(fd, &status) || status.st_size < 0) {
+    return 0u;
+  }
+#endif
+  return (size_t)status.st_size;
+}
+
+static void sync_log_file(int fd)
+{
+#ifdef _WIN32
+  (void)_commit(fd);
+#else
+  (void)fsync(fd);
+#endif
+}
+
+static void close_log_file(int fd)
+{
+#ifdef _WIN32
+  (void)_close(fd);
+#else
+  (void)close(fd);
+#endif
+}
+
+// Return the number of bytes which could not be written.
+static size_t write_all(int fd, const char * data, size_t length)
+{
+  while (length > 0) {
+#ifdef _WIN32
+    unsigned int chunk = length > INT_MAX ? (unsigned int)INT_MAX : (unsigned int)length;
+    int written = _write(fd, data, chunk);
+#else
+    ssize_t written = write(fd, data, length);
+#endif
+    if (written < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return length;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+  return 0u;
+}
+
+// Return the number of bytes which could not be written.
+static size_t write_buffers(int fd, file_sink_buffer_t * const * batch, size_t batch_count)
+{
+  size_t written = 0u;
+#ifndef _WIN32
+  struct iovec iov[FILE_SINK_MAX_BATCH];
+  size_t total = 0u;
+  for (size_t i = 0; i < batch_count; ++i) {
+    iov[i].iov_base = batch[i]->data;
+    iov[i].iov_len = batch[i]->length;
+    total += batch[i]->length;
+  }
+  ssize_t result;
+  do {
+    result = writev(fd, iov, (int)batch_count);
+  } while (result < 0 && EINTR == errno);
+  if (result > 0) {
+    written = (size_t)result;
+  }
+  if (written == total) {
+    return 0u;
+  }
+#endif
+  // Write whatever is left one buffer at a time.
+  size_t lost = 0u;
+  for (size_t i = 0; i < batch_count; ++i) {
+    if (written >= batch[i]->length) {
+      written -= batch[i]->length;
+      continue;
+    }
+    lost += write_all(fd, batch[i]->data + written, batch[i]->length - written);
+    written = 0u;
+  }
+  return lost;
+}
+
+// Compress each buffer into a frame of its own, and return the number of bytes which could not
+// be written, counted before compression.
+static size_t write_compressed_buffers(
+  rcutils_logging_file_sink_t * sink, file_sink_buffer_t * const * batch, size_t batch_count)
+{
+  size_t lost = 0u;
+  for (size_t i = 0; i < batch_count; ++i) {
+    size_t frame_length = rcutils_logging_lz4_compress_frame(
+      batch[i]->data, batch[i]->length, sink->frame, sink->lz4_table);
+    // Part of a frame can't be decompressed, so it is lost as a whole.
+    if (0u != write_all(sink->fd, sink->frame, frame_length)) {
+      lost += batch[i]->length;
+    }
+  }
+  return lost;
+}
+
+// Rename path to path.1, path.1 to path.2 and so on, and open a new file.
+static void rotate_log_file(rcutils_logging_file_sink_t * sink)
+{
+  const char * path = sink->options.path;
+  if (sink->fd >= 0) {
+    if (RCUTILS_LOGGING_FILE_SINK_FSYNC_NEVER != sink->options.fsync_policy) {
+      sync_log_file(sink->fd);
+    }
+    close_log_file(sink->fd);
+  }
+
+  if (0u == sink->options.max_files) {
+    (void)remove(path);
+  } else {
+    char * older = rcutils_format_string(
+      sink->allocator, "%s.%zu", path, sink->options.max_files);
+    // Renaming onto an existing file fails on Windows.
+    if (NULL != older) {
+      (void)remove(older);
+    }
+    for (size_t i = sink->options.max_files; NULL != older && i > 1; --i) {
+      char * newer = rcutils_format_string(sink->allocator, "%s.%zu", path, i - 1);
+      if (NULL != newer) {
+        (void)rename(newer, older);
+      }
+      sink->allocator.deallocate(older, sink->allocator.state);
+      older = newer;
+    }
+    if (NULL != older) {
+      (void)rename(path, older);
+      sink->allocator.deallocate(older, sink->allocator.state);
+    } else {
+      RCUTILS_SAFE_FWRITE_TO_STDERR(
+        "Error: failed to allocate the names of the rotated log files.\n");
+    }
+  }
+
+  sink->fd = open_log_file(path, !sink->async_writes);
+  if (sink->fd < 0) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to open log file '%s' after rotating it: %d\n", path, errno);
+  }
+  sink->file_offset = (int64_t)get_log_file_size(sink->fd);
+}
+
+// Must be called with the mutex held.
+static void release_buffer(rcutils_logging_file_sink_t * sink, file_sink_buffer_t * buffer)
+{
+  buffer->length = 0u;
+  buffer->rotate_before = false;
+  sink->free_buffers[sink->free_count++] = (size_t)(buffer - sink->buffers);
+}
+
+static void file_sink_write_done(rcutils_ret_t ret, size_t written, void * context)
+{
+  file_sink_buffer_t * buffer = (file_sink_buffer_t *)context;
+  rcutils_logging_file_sink_t * sink = buffer->sink;
+  rcutils_mutex_lock(&sink->mutex);
+  if (RCUTILS_RET_OK != ret) {
+    sink->lost_bytes += buffer->length - written;
+  }
+  release_buffer(sink, buffer);
+  --sink->in_flight_count;
+  ++sink->written_count;
+  rcutils_condition_variable_notify_all(&sink->cv);
+  rcutils_mutex_unlock(&sink->mutex);
+}
+
+// Submit the buffers to the async writer, marking those which were, and return the number of
+// bytes of the others, which are lost.
+static size_t submit_buffers(
+  rcutils_logging_file_sink_t * sink, file_sink_buffer_t * const * batch, size_t batch_count,
+  bool * submitted)
+{
+  rcutils_mutex_lock(&sink->mutex);
+  sink->in_flight_count += batch_count;
+  rcutils_mutex_unlock(&sink->mutex);
+
+  size_t lost = 0u;
+  for (size_t i = 0; i < batch_count; ++i) {
+    // The buffer may be written and reused as soon as it is submitted.
+    const size_t length = batch[i]->length;
+    rcutils_ret_t ret = rcutils_async_write(
+      sink->options.async_writer, sink->fd, batch[i]->data, length, sink->file_offset,
+      file_sink_write_done, batch[i]);
+    submitted[i] = RCUTILS_RET_OK == ret;
+    if (submitted[i]) {
+      sink->file_offset += (int64_t)length;
+    } else {
+      rcutils_reset_error();
+      lost += length;
+      rcutils_mutex_lock(&sink->mutex);
+      --sink->in_flight_count;
+      rcutils_mutex_unlock(&sink->mutex);
+    }
+  }
+  return lost;
+}
+
+static void wait_for_async_writes(rcutils_logging_file_sink_t * sink)
+{
+  rcutils_mutex_lock(&sink->mutex);
+  while (sink->in_flight_count > 0u) {
+    rcutils_condition_variable_wait_for(&sink->cv, &sink->mutex, FILE_SINK_WAIT_MS);
+  }
+  rcutils_mutex_unlock(&sink->mutex);
+}
+
+// Must be called with the mutex held.
+static void submit_active_buffer(rcutils_logging_file_sink_t * sink)
+{
+  file_sink_buffer_t * active = sink->active;
+  // An empty buffer stays active, along with its rotation flag.
+  if (NULL == active || 0u == active->length) {
+    return;
+  }
+  size_t index = (size_t)(active - sink->buffers);
+  size_t tail = (sink->pending_head + sink->pending_count) % sink->options.buffer_count;
+  sink->pending_buffers[tail] = index;
+  ++sink->pending_count;
+  ++sink->submitted_count;
+  sink->active = NULL;
+  rcutils_condition_variable_notify_all(&sink->cv);
+}
+
+static void file_sink_thread(void * arg)
+{
+  rcutils_logging_file_sink_t * sink = (rcutils_logging_file_sink_t *)arg;
+  const size_t buffer_count = sink->options.buffer_count;
+
+  rcutils_mutex_lock(&sink->mutex);
+  for (;;) {
+    if (0u == sink->pending_count) {
+      if (sink->stopping) {
+        break;
+      }
+      rcutils_condition_variable_wait_for(
+        &sink->cv, &sink->mutex, sink->options.flush_interval_ms);
+      if (0u == sink->pending_count) {
+        // Nothing filled a buffer for a while, write out what there is.
+        submit_active_buffer(sink);
+      }
+      continue;
+    }
+
+    // Take the pending buffers which go to the same file.
+    file_sink_buffer_t * batch[FILE_SINK_MAX_BATCH];
+    size_t batch_count = 0u;
+    while (batch_count < sink->pending_count && batch_count < FILE_SINK_MAX_BATCH) {
+      size_t index = sink->pending_buffers[(sink->pending_head + batch_count) % buffer_count];
+      if (batch_count > 0u && sink->buffers[index].rotate_before) {
+        break;
+      }
+      batch[batch_count++] = &sink->buffers[index];
+    }
+    sink->pending_head = (sink->pending_head + batch_count) % buffer_count;
+    sink->pending_count -= batch_count;
+    rcutils_mutex_unlock(&sink->mutex);
+
+    if (batch[0]->rotate_before) {
+      // The writes to the previous file have to complete before it is closed.
+      wait_for_async_writes(sink);
+      rotate_log_file(sink);
+    }
+    size_t lost = 0u;
+    // The buffers submitted to the async writer are released once they are written.
+    bool submitted[FILE_SINK_MAX_BATCH] = {false};
+    if (sink->fd >= 0) {
+      if (RCUTILS_LOGGING_FILE_SINK_COMPRESSION_LZ4 == sink->options.compression) {
+        lost = write_compressed_buffers(sink, batch, batch_count);
+      } else if (sink->async_writes) {
+        lost = submit_buffers(sink, batch, batch_count, submitted);
+      } else {
+        lost = write_buffers(sink->fd, batch, batch_count);
+      }
+      if (RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_WRITE == sink->options.fsync_policy) {
+        wait_for_async_writes(sink);
+        sync_log_file(sink->fd);
+      }
+    } else {
+      for (size_t i = 0; i < batch_count; ++i) {
+        lost += batch[i]->length;
+      }
+    }
+
+    rcutils_mutex_lock(&sink->mutex);
+    for (size_t i = 0; i < batch_count; ++i) {
+      if (!submitted[i]) {
+        release_buffer(sink, batch[i]);
+        ++sink->written_count;
+      }
+    }
+    sink->lost_bytes += lost;
+    rcutils_condition_variable_notify_all(&sink->cv);
+  }
+  rcutils_mutex_unlock(&sink->mutex);
+  wait_for_async_writes(sink);
+}
+
+static void append_line(
+  rcutils_logging_file_sink_t * sink, const char * line, size_t length,
+  rcutils_time_point_value_t timestamp)
+{
+  rcutils_mutex_lock(&sink->mutex);
+  // Another line is waiting for a free buffer halfway through.
+  while (sink->line_in_progress) {
+    rcutils_condition_variable_wait_for(&sink->cv, &sink->mutex, FILE_SINK_WAIT_MS);
+  }
+
+  // Rotate before the line rather than in the middle of it.
+  bool rotate = false;
+  if (sink->options.max_file_size > 0u && sink->file_size > 0u &&
+    sink->file_size + length > sink->options.max_file_size)
+  {
+    rotate = true;
+  }
+  if (sink->options.max_file_age > 0 && sink->file_has_start_time &&
+    timestamp - sink->file_start_time >= sink->options.max_file_age)
+  {
+    rotate = true;
+  }
+  if (rotate) {
+    submit_active_buffer(sink);
+    if (NULL != sink->active) {
+      sink->active->rotate_before = true;
+    } else {
+      sink->rotate_pending = true;
+    }
+    sink->file_size = 0u;
+    sink->file_has_start_time = false;
+  }
+  if (!sink->file_has_start_time) {
+    sink->file_start_time = timestamp;
+    sink->file_has_start_time = true;
+  }
+  sink->file_size += length;
+
+  // Lines longer than a buffer continue in the next one.
+  while (length > 0u) {
+    if (NULL == sink->active) {
+      while (0u == sink->free_count) {
+        // The mutex is released while waiting, so keep other lines from being interleaved.
+        sink->line_in_progress = true;
+        rcutils_condition_variable_wait_for(&sink->cv, &sink->mutex, FILE_SINK_WAIT_MS);
+      }
+      sink->active = &sink->buffers[sink->free_buffers[--sink->free_count]];
+      sink->active->rotate_before = sink->rotate_pending;
+      sink->rotate_pending = false;
+    }
+    file_sink_buffer_t * active = sink->active;
+    size_t available = sink->buffer_capacity - active->length;
+    size_t chunk = length < available ? length : available;
+    memcpy(active->data + active->length, line, chunk);
+    active->length += chunk;
+    line += chunk;
+    length -= chunk;
+    if (active->length == sink->buffer_capacity) {
+      submit_active_buffer(sink);
+    }
+  }
+  if (sink->line_in_progress) {
+    sink->line_in_progress = false;
+    rcutils_condition_variable_notify_all(&sink->cv);
+  }
+
+  rcutils_mutex_unlock(&sink->mutex);
+}
+
+static void free_sink(rcutils_logging_file_sink_t * sink)
+{
+  rcutils_allocator_t allocator = sink->allocator;
+  if (sink->fd >= 0) {
+    if (RCUTILS_LOGGING_FILE_SINK_FSYNC_NEVER != sink->options.fsync_policy) {
+      sync_log_file(sink->fd);
+    }
+    close_log_file(sink->fd);
+  }
+  if (sink->cv_initialized) {
+    rcutils_condition_variable_fini(&sink->cv);
+  }
+  if (sink->mutex_initialized) {
+    rcutils_mutex_fini(&sink->mutex);
+  }
+  allocator.deallocate(sink->lz4_table, allocator.state);
+  allocator.deallocate(sink->frame, allocator.state);
+  allocator.deallocate(sink->pending_buffers, allocator.state);
+  allocator.deallocate(sink->free_buffers, allocator.state);
+  allocator.deallocate(sink->buffers, allocator.state);
+  allocator.deallocate(sink->buffer_memory, allocator.state);
+  allocator.deallocate((char *)sink->options.path, allocator.state);
+  allocator.deallocate(sink, allocator.state);
+}
+
+rcutils_logging_file_sink_options_t rcutils_logging_file_sink_get_default_options(void)
+{
+  rcutils_logging_file_sink_options_t options = {
+    .path = NULL,
+    .buffer_size = FILE_SINK_DEFAULT_BUFFER_SIZE,
+    .buffer_count = FILE_SINK_DEFAULT_BUFFER_COUNT,
+    .max_file_size = 0u,
+    .max_file_age = 0,
+    .max_files = FILE_SINK_DEFAULT_MAX_FILES,
+    .flush_interval_ms = FILE_SINK_DEFAULT_FLUSH_INTERVAL_MS,
+    .fsync_policy = RCUTILS_LOGGING_FILE_SINK_FSYNC_NEVER,
+    .compression = RCUTILS_LOGGING_FILE_SINK_COMPRESSION_NONE,
+    .async_writer = NULL,
+    .thread_attributes = rcutils_get_default_thread_attributes(),
+  };
+  return options;
+}
+
+rcutils_ret_t rcutils_logging_file_sink_init(
+  rcutils_logging_file_sink_t ** sink,
+  const rcutils_logging_file_sink_options_t * options,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == options->path || '\0' == options->path[0]) {
+    RCUTILS_SET_ERROR_MSG("the path of the log file must be set");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == options->buffer_size || options->buffer_count < 2u ||
+    options->buffer_count > SIZE_MAX / sizeof(size_t) || options->max_file_age < 0)
+  {
+    RCUTILS_SET_ERROR_MSG("invalid file sink options");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  switch (options->fsync_policy) {
+    case RCUTILS_LOGGING_FILE_SINK_FSYNC_NEVER:
+    case RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_CLOSE:
+    case RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_WRITE:
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("invalid file sink fsync policy");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  switch (options->compression) {
+    case RCUTILS_LOGGING_FILE_SINK_COMPRESSION_NONE:
+    case RCUTILS_LOGGING_FILE_SINK_COMPRESSION_LZ4:
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("invalid file sink compression");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  const size_t page_size = get_page_size();
+  if (options->buffer_size > SIZE_MAX - page_size) {
+    RCUTILS_SET_ERROR_MSG("file sink buffer size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t buffer_capacity = (options->buffer_size + page_size - 1u) / page_size * page_size;
+  if (buffer_capacity > (SIZE_MAX - page_size) / options->buffer_count) {
+    RCUTILS_SET_ERROR_MSG("file sink buffers are too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_logging_file_sink_t * new_sink =
+    allocator.zero_allocate(1, sizeof(rcutils_logging_file_sink_t), allocator.state);
+  if (NULL == new_sink) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate the file sink");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_sink->options = *options;
+  new_sink->allocator = allocator;
+  new_sink->buffer_capacity = buffer_capacity;
+  new_sink->fd = -1;
+  new_sink->async_writes = NULL != options->async_writer &&
+    RCUTILS_LOGGING_FILE_SINK_COMPRESSION_NONE == options->compression;
+  new_sink->options.path = rcutils_strdup(options->path, allocator);
+
+  const size_t buffer_count = options->buffer_count;
+  // Over-allocate by a page to align the buffers on page boundaries.
+  new_sink->buffer_memory =
+    allocator.allocate(buffer_capacity * buffer_count + page_size, allocator.state);
+  new_sink->buffers =
+    allocator.zero_allocate(buffer_count, sizeof(file_sink_buffer_t), allocator.state);
+  new_sink->free_buffers = allocator.allocate(buffer_count * sizeof(size_t), allocator.state);
+  new_sink->pending_buffers = allocator.allocate(buffer_count * sizeof(size_t), allocator.state);
+  bool compressor_allocated = true;
+  if (RCUTILS_LOGGING_FILE_SINK_COMPRESSION_LZ4 == options->compression) {
+    new_sink->frame = allocator.allocate(
+      rcutils_logging_lz4_frame_bound(buffer_capacity), allocator.state);
+    new_sink->lz4_table = allocator.allocate(
+      RCUTILS_LOGGING_LZ4_TABLE_SIZE * sizeof(uint16_t), allocator.state);
+    compressor_allocated = NULL != new_sink->frame && NULL != new_sink->lz4_table;
+  }
+  if (NULL == new_sink->options.path || NULL == new_sink->buffer_memory ||
+    NULL == new_sink->buffers || NULL == new_sink->free_buffers ||
+    NULL == new_sink->pending_buffers || !compressor_allocated)
+  {
+    free_sink(new_sink);
+    RCUTILS_SET_ERROR_MSG("failed to allocate the file sink buffers");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  uintptr_t aligned = ((uintptr_t)new_sink->buffer_memory + page_size - 1u) &
+    ~((uintptr_t)page_size - 1u);
+  for (size_t i = 0; i < buffer_count; ++i) {
+    new_sink->buffers[i].sink = new_sink;
+    new_sink->buffers[i].data = (char *)aligned + i * buffer_capacity;
+    // The first buffer is taken first.
+    new_sink->free_buffers[i] = buffer_count - 1u - i;
+  }
+  new_sink->free_count = buffer_count;
+
+  new_sink->fd = open_log_file(new_sink->options.path, !new_sink->async_writes);
+  if (new_sink->fd < 0) {
+    char error_string[1024];
+    rcutils_strerror(error_string, sizeof(error_string));
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to open log file '%s': %s", options->path, error_string);
+    free_sink(new_sink);
+    return RCUTILS_RET_ERROR;
+  }
+  new_sink->file_size = get_log_file_size(new_sink->fd);
+  new_sink->file_offset = (int64_t)new_sink->file_size;
+
+  rcutils_ret_t ret = rcutils_mutex_init(&new_sink->mutex);
+  if (RCUTILS_RET_OK == ret) {
+    new_sink->mutex_initialized = true;
+    ret = rcutils_condition_variable_init(&new_sink->cv);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    new_sink->cv_initialized = true;
+    ret = rcutils_thread_create_with_attributes(
+      &new_sink->thread, file_sink_thread, new_sink, &new_sink->options.thread_attributes);
+  }
+  if (RCUTILS_RET_OK != ret) {
+    free_sink(new_sink);
+    return ret;
+  }
+
+  *sink = new_sink;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t rcutils_logging_file_sink_flush(rcutils_logging_file_sink_t * sink)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_mutex_lock(&sink->mutex);
+  submit_active_buffer(sink);
+  const uint64_t target = sink->submitted_count;
+  while (sink->written_count < target) {
+    rcutils_condition_variable_wait_for(&sink->cv, &sink->mutex, FILE_SINK_WAIT_MS);
+  }
+  rcutils_mutex_unlock(&sink->mutex);
+  return RCUTILS_RET_OK;
+}
+
+size_t rcutils_logging_file_sink_get_lost_bytes(rcutils_logging_file_sink_t * sink)
+{
+  if (NULL == sink) {
+    return 0u;
+  }
+  rcutils_mutex_lock(&sink->mutex);
+  size_t lost_bytes = sink->lost_bytes;
+  rcutils_mutex_unlock(&sink->mutex);
+  return lost_bytes;
+}
+
+rcutils_ret_t rcutils_logging_file_sink_fini(rcutils_logging_file_sink_t * sink)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_mutex_lock(&sink->mutex);
+  submit_active_buffer(sink);
+  sink->stopping = true;
+  rcutils_condition_variable_notify_all(&sink->cv);
+  rcutils_mutex_unlock(&sink->mutex);
+
+  rcutils_ret_t ret = rcutils_thread_join(&sink->thread);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  free_sink(sink);
+  return RCUTILS_RET_OK;
+}
+
+void rcutils_logging_file_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  rcutils_logging_file_sink_t * sink = (rcutils_logging_file_sink_t *)context;
+  if (NULL == sink) {
+    return;
+  }
+
+  char line_buf[FILE_SINK_LINE_BUFFER_SIZE];
+  rcutils_char_array_t line = {
+    .buffer = line_buf,
+    .owns_buffer = false,
+    .buffer_length = 0u,
+    .buffer_capacity = sizeof(line_buf),
+    .allocator = sink->allocator
+  };
+  rcutils_ret_t status = rcutils_logging_format_message(
+    location, severity, name, timestamp, message, &line);
+  if (RCUTILS_RET_OK == status) {
+    status = rcutils_char_array_strncat(&line, "\n", 1);
+  }
+  if (RCUTILS_RET_OK == status) {
+    // The buffer length includes the terminating null character, which isn't written out.
+    append_line(sink, line.buffer, line.buffer_length - 1, timestamp);
+  } else {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "Error: failed to format log message for the file sink: %s\n",
+      rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  if (RCUTILS_RET_OK != rcutils_char_array_fini(&line)) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to fini array.\n");
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
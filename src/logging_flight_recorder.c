@@ -0,0 +1,541 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_flight_recorder.h"
+#include "rcutils/macros.h"
+
+#define FLIGHT_RECORDER_DEFAULT_RECORD_COUNT (256u)
+#define FLIGHT_RECORDER_DEFAULT_RECORD_SIZE (256u)
+#define FLIGHT_RECORDER_DEFAULT_MAX_THREADS (16u)
+
+// Room in the dump buffer for everything of a line but the name and the message.
+#define FLIGHT_RECORDER_LINE_OVERHEAD (64u)
+
+// The fixed part of a record, followed by the logger name and then the message.
+typedef struct flight_recorder_record_s
+{
+  // Twice the index of the record in its ring plus one while it is written, plus two once written.
+  uint64_t sequence;
+  rcutils_time_point_value_t timestamp;
+  int32_t severity;
+  uint32_t name_length;
+  uint32_t message_length;
+  uint32_t padding;
+} flight_recorder_record_t;
+
+typedef struct flight_recorder_ring_s
+{
+  char * records;
+  // The number of records written to the ring so far, only increased by its thread.
+  uint64_t head;
+  // Set while the thread of the ring writes a record, to drop the messages of nested sinks.
+  bool writing;
+  // Keeps the rings of different threads on different cache lines.
+  char padding[64 - sizeof(char *) - sizeof(uint64_t) - sizeof(bool)];
+} flight_recorder_ring_t;
+
+// Where the dump is in a ring.
+typedef struct flight_recorder_cursor_s
+{
+  uint64_t next;
+  uint64_t end;
+} flight_recorder_cursor_t;
+
+struct rcutils_logging_flight_recorder_s
+{
+  rcutils_logging_flight_recorder_options_t options;
+  rcutils_allocator_t allocator;
+  // The size of a record with its name and message, a multiple of 8 bytes.
+  size_t record_stride;
+  char * record_memory;
+  flight_recorder_ring_t * rings;
+  // The number of rings claimed by threads.
+  uint32_t claimed_rings;
+  uint64_t dropped_records;
+  // The ring of each thread.
+  rcutils_thread_specific_t ring_key;
+  bool ring_key_initialized;
+
+  // Preallocated for the dump, which can't allocate, and only used while dumping is set.
+  uint32_t dumping;
+  flight_recorder_cursor_t * dump_cursors;
+  char * dump_buffer;
+};
+
+static uint64_t load_acquire_uint64(uint64_t * value)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)value, 0, 0);
+#else
+  return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void store_release_uint64(uint64_t * value, uint64_t new_value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)value, (LONG64)new_value);
+#else
+  __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+// Unlike a store, orders the stores after it after the new value.
+static void exchange_uint64(uint64_t * value, uint64_t new_value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)value, (LONG64)new_value);
+#else
+  (void)__atomic_exchange_n(value, new_value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+// Unlike a load, orders the loads before it before the value is read.
+static uint64_t load_after_uint64(uint64_t * value)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)value, 0);
+#else
+  return __atomic_fetch_add(value, 0u, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static void add_uint64(uint64_t * value, uint64_t addend)
+{
+#ifdef _WIN32
+  (void)InterlockedExchangeAdd64((volatile LONG64 *)value, (LONG64)addend);
+#else
+  __atomic_fetch_add(value, addend, __ATOMIC_RELAXED);
+#endif
+}
+
+static bool compare_exchange_uint32(uint32_t * value, uint32_t expected, uint32_t desired)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange(
+    (volatile LONG *)value, (LONG)desired, (LONG)expected) == expected;
+#else
+  return __atomic_compare_exchange_n(
+    value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#endif
+}
+
+static uint32_t load_uint32(uint32_t * value)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange((volatile LONG *)value, 0, 0);
+#else
+  return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void store_release_uint32(uint32_t * value, uint32_t new_value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)value, (LONG)new_value);
+#else
+  __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+static flight_recorder_record_t * get_record(
+  rcutils_logging_flight_recorder_t * recorder, flight_recorder_ring_t * ring, uint64_t index)
+{
+  const size_t slot = (size_t)(index % recorder->options.record_count);
+  return (flight_recorder_record_t *)(ring->records + slot * recorder->record_stride);
+}
+
+// Get the ring of the calling thread, claiming one if it has none yet, or NULL if none is left.
+static flight_recorder_ring_t * get_thread_ring(rcutils_logging_flight_recorder_t * recorder)
+{
+  flight_recorder_ring_t * ring =
+    (flight_recorder_ring_t *)rcutils_thread_specific_get(&recorder->ring_key);
+  if (RCUTILS_LIKELY(NULL != ring)) {
+    return ring;
+  }
+  uint32_t claimed = load_uint32(&recorder->claimed_rings);
+  for (;;) {
+    if (claimed >= recorder->options.max_threads) {
+      return NULL;
+    }
+    if (compare_exchange_uint32(&recorder->claimed_rings, claimed, claimed + 1u)) {
+      break;
+    }
+    claimed = load_uint32(&recorder->claimed_rings);
+  }
+  ring = &recorder->rings[claimed];
+  if (RCUTILS_RET_OK != rcutils_thread_specific_set(&recorder->ring_key, ring)) {
+    // The ring stays claimed without a thread, which only wastes it.
+    rcutils_reset_error();
+    return NULL;
+  }
+  return ring;
+}
+
+static void free_recorder(rcutils_logging_flight_recorder_t * recorder)
+{
+  rcutils_allocator_t allocator = recorder->allocator;
+  if (recorder->ring_key_initialized) {
+    rcutils_thread_specific_fini(&recorder->ring_key);
+  }
+  allocator.deallocate(recorder->dump_buffer, allocator.state);
+  allocator.deallocate(recorder->dump_cursors, allocator.state);
+  allocator.deallocate(recorder->rings, allocator.state);
+  allocator.deallocate(recorder->record_memory, allocator.state);
+  allocator.deallocate(recorder, allocator.state);
+}
+
+rcutils_logging_flight_recorder_options_t
+rcutils_logging_flight_recorder_get_default_options(void)
+{
+  rcutils_logging_flight_recorder_options_t options = {
+    .record_count = FLIGHT_RECORDER_DEFAULT_RECORD_COUNT,
+    .record_size = FLIGHT_RECORDER_DEFAULT_RECORD_SIZE,
+    .max_threads = FLIGHT_RECORDER_DEFAULT_MAX_THREADS,
+  };
+  return options;
+}
+
+rcutils_ret_t rcutils_logging_flight_recorder_init(
+  rcutils_logging_flight_recorder_t ** recorder,
+  const rcutils_logging_flight_recorder_options_t * options,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(recorder, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u == options->record_count || 0u == options->record_size ||
+    options->record_size > UINT32_MAX || 0u == options->max_threads ||
+    options->max_threads > UINT32_MAX)
+  {
+    RCUTILS_SET_ERROR_MSG("invalid flight recorder options");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (options->record_size > SIZE_MAX - sizeof(flight_recorder_record_t) - 8u -
+    FLIGHT_RECORDER_LINE_OVERHEAD)
+  {
+    RCUTILS_SET_ERROR_MSG("flight recorder records are too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t record_stride =
+    sizeof(flight_recorder_record_t) + (options->record_size + 7u) / 8u * 8u;
+  if (record_stride > SIZE_MAX / options->record_count / options->max_threads) {
+    RCUTILS_SET_ERROR_MSG("flight recorder rings are too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t ring_size = record_stride * options->record_count;
+
+  rcutils_logging_flight_recorder_t * new_recorder =
+    allocator.zero_allocate(1, sizeof(rcutils_logging_flight_recorder_t), allocator.state);
+  if (NULL == new_recorder) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate the flight recorder");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_recorder->options = *options;
+  new_recorder->allocator = allocator;
+  new_recorder->record_stride = record_stride;
+
+  // Zeroed records have sequence 0, which no written record has.
+  new_recorder->record_memory =
+    allocator.zero_allocate(options->max_threads, ring_size, allocator.state);
+  new_recorder->rings = allocator.zero_allocate(
+    options->max_threads, sizeof(flight_recorder_ring_t), allocator.state);
+  new_recorder->dump_cursors = allocator.zero_allocate(
+    options->max_threads, sizeof(flight_recorder_cursor_t), allocator.state);
+  new_recorder->dump_buffer =
+    allocator.allocate(options->record_size + FLIGHT_RECORDER_LINE_OVERHEAD, allocator.state);
+  if (NULL == new_recorder->record_memory || NULL == new_recorder->rings ||
+    NULL == new_recorder->dump_cursors || NULL == new_recorder->dump_buffer)
+  {
+    free_recorder(new_recorder);
+    RCUTILS_SET_ERROR_MSG("failed to allocate the flight recorder rings");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < options->max_threads; ++i) {
+    new_recorder->rings[i].records = new_recorder->record_memory + i * ring_size;
+  }
+
+  // Rings outlive their threads, so there is nothing to destroy on thread exit.
+  rcutils_ret_t ret = rcutils_thread_specific_init(&new_recorder->ring_key, NULL);
+  if (RCUTILS_RET_OK != ret) {
+    free_recorder(new_recorder);
+    return ret;
+  }
+  new_recorder->ring_key_initialized = true;
+
+  *recorder = new_recorder;
+  return RCUTILS_RET_OK;
+}
+
+size_t rcutils_logging_flight_recorder_get_dropped_records(
+  rcutils_logging_flight_recorder_t * recorder)
+{
+  if (NULL == recorder) {
+    return 0u;
+  }
+  return (size_t)load_acquire_uint64(&recorder->dropped_records);
+}
+
+rcutils_ret_t rcutils_logging_flight_recorder_fini(rcutils_logging_flight_recorder_t * recorder)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(recorder, RCUTILS_RET_INVALID_ARGUMENT);
+  free_recorder(recorder);
+  return RCUTILS_RET_OK;
+}
+
+void rcutils_logging_flight_recorder_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  (void)location;
+  rcutils_logging_flight_recorder_t * recorder = (rcutils_logging_flight_recorder_t *)context;
+  if (NULL == recorder) {
+    return;
+  }
+  flight_recorder_ring_t * ring = get_thread_ring(recorder);
+  if (NULL == ring || ring->writing) {
+    add_uint64(&recorder->dropped_records, 1u);
+    return;
+  }
+  ring->writing = true;
+
+  const size_t record_size = recorder->options.record_size;
+  size_t name_length = NULL == name ? 0u : strlen(name);
+  if (name_length > record_size) {
+    name_length = record_size;
+  }
+  size_t message_length = NULL == message ? 0u : strlen(message);
+  if (message_length > record_size - name_length) {
+    message_length = record_size - name_length;
+  }
+
+  // The ring is only written by this thread, so the head needs no atomic increment.
+  const uint64_t index = ring->head;
+  flight_recorder_record_t * record = get_record(recorder, ring, index);
+  // A seqlock: the dump skips the record unless its sequence is the same before and after.
+  exchange_uint64(&record->sequence, 2u * index + 1u);
+  record->timestamp = timestamp;
+  record->severity = (int32_t)severity;
+  record->name_length = (uint32_t)name_length;
+  record->message_length = (uint32_t)message_length;
+  char * data = (char *)(record + 1);
+  if (name_length > 0u) {
+    memcpy(data, name, name_length);
+  }
+  if (message_length > 0u) {
+    memcpy(data + name_length, message, message_length);
+  }
+  store_release_uint64(&record->sequence, 2u * index + 2u);
+  store_release_uint64(&ring->head, index + 1u);
+
+  ring->writing = false;
+}
+
+// Write all of the data, retrying on interruptions, with async-signal-safe calls only.
+static bool write_all(int fd, const char * data, size_t length)
+{
+  while (length > 0u) {
+#ifdef _WIN32
+    const unsigned int chunk = length > INT_MAX ? INT_MAX : (unsigned int)length;
+    const int written = _write(fd, data, chunk);
+#else
+    const ssize_t written = write(fd, data, length);
+#endif
+    if (written < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+  return true;
+}
+
+static size_t append_string(char * buffer, size_t offset, const char * string, size_t length)
+{
+  memcpy(buffer + offset, string, length);
+  return offset + length;
+}
+
+// Append the decimal digits of the value, padded with zeros to at least `width` digits.
+static size_t append_uint64(char * buffer, size_t offset, uint64_t value, size_t width)
+{
+  char digits[20];
+  size_t count = 0u;
+  do {
+    digits[count++] = (char)('0' + (char)(value % 10u));
+    value /= 10u;
+  } while (value > 0u);
+  while (count < width && count < sizeof(digits)) {
+    digits[count++] = '0';
+  }
+  while (count > 0u) {
+    buffer[offset++] = digits[--count];
+  }
+  return offset;
+}
+
+// Copy the record into the dump buffer formatted as a line, and return the line length or 0 if
+// the record was overwritten meanwhile.
+static size_t format_record(
+  rcutils_logging_flight_recorder_t * recorder, flight_recorder_record_t * record,
+  uint64_t sequence)
+{
+  char * buffer = recorder->dump_buffer;
+  const size_t record_size = recorder->options.record_size;
+  const int32_t severity = record->severity;
+  const rcutils_time_point_value_t timestamp = record->timestamp;
+  size_t name_length = record->name_length;
+  size_t message_length = record->message_length;
+  if (name_length > record_size) {
+    name_length = record_size;
+  }
+  if (message_length > record_size - name_length) {
+    message_length = record_size - name_length;
+  }
+
+  size_t offset = append_string(buffer, 0u, "[", 1u);
+  const char * severity_name = NULL;
+  if (severity >= 0 && severity <= RCUTILS_LOG_SEVERITY_FATAL) {
+    severity_name = g_rcutils_log_severity_names[severity];
+  }
+  if (NULL != severity_name) {
+    offset = append_string(buffer, offset, severity_name, strlen(severity_name));
+  } else if (severity < 0) {
+    offset = append_string(buffer, offset, "-", 1u);
+    offset = append_uint64(buffer, offset, (uint64_t)(-(int64_t)severity), 1u);
+  } else {
+    offset = append_uint64(buffer, offset, (uint64_t)severity, 1u);
+  }
+  offset = append_string(buffer, offset, "] [", 3u);
+  uint64_t magnitude = (uint64_t)timestamp;
+  if (timestamp < 0) {
+    offset = append_string(buffer, offset, "-", 1u);
+    magnitude = (uint64_t)0u - magnitude;
+  }
+  offset = append_uint64(buffer, offset, magnitude / 1000000000u, 10u);
+  offset = append_string(buffer, offset, ".", 1u);
+  offset = append_uint64(buffer, offset, magnitude % 1000000000u, 9u);
+  offset = append_string(buffer, offset, "] [", 3u);
+  const char * data = (const char *)(record + 1);
+  offset = append_string(buffer, offset, data, name_length);
+  offset = append_string(buffer, offset, "]: ", 3u);
+  offset = append_string(buffer, offset, data + name_length, message_length);
+  offset = append_string(buffer, offset, "\n", 1u);
+
+  if (load_after_uint64(&record->sequence) != sequence) {
+    return 0u;
+  }
+  return offset;
+}
+
+// Skip the records of the ring which were overwritten, and return the next one or NULL.
+static flight_recorder_record_t * next_record(
+  rcutils_logging_flight_recorder_t * recorder, size_t ring_index, uint64_t * sequence)
+{
+  flight_recorder_ring_t * ring = &recorder->rings[ring_index];
+  flight_recorder_cursor_t * cursor = &recorder->dump_cursors[ring_index];
+  for (; cursor->next < cursor->end; ++cursor->next) {
+    flight_recorder_record_t * record = get_record(recorder, ring, cursor->next);
+    *sequence = load_acquire_uint64(&record->sequence);
+    if (*sequence == 2u * cursor->next + 2u) {
+      return record;
+    }
+  }
+  return NULL;
+}
+
+rcutils_ret_t rcutils_logging_flight_recorder_dump(
+  rcutils_logging_flight_recorder_t * recorder, int fd)
+{
+  // No error message is set, since that isn't async-signal-safe.
+  if (NULL == recorder) {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (!compare_exchange_uint32(&recorder->dumping, 0u, 1u)) {
+    return RCUTILS_RET_ERROR;
+  }
+
+  uint32_t ring_count = load_uint32(&recorder->claimed_rings);
+  if (ring_count > recorder->options.max_threads) {
+    ring_count = (uint32_t)recorder->options.max_threads;
+  }
+  const uint64_t record_count = recorder->options.record_count;
+  for (size_t i = 0; i < ring_count; ++i) {
+    const uint64_t head = load_acquire_uint64(&recorder->rings[i].head);
+    recorder->dump_cursors[i].next = head > record_count ? head - record_count : 0u;
+    recorder->dump_cursors[i].end = head;
+  }
+
+  // Merge the rings by repeatedly writing the oldest next record, which needs no memory.
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (;;) {
+    flight_recorder_record_t * oldest = NULL;
+    uint64_t oldest_sequence = 0u;
+    size_t oldest_ring = 0u;
+    for (size_t i = 0; i < ring_count; ++i) {
+      uint64_t sequence = 0u;
+      flight_recorder_record_t * record = next_record(recorder, i, &sequence);
+      // The timestamp may be torn if the record is being overwritten, which is caught later.
+      if (NULL != record && (NULL == oldest || record->timestamp < oldest->timestamp)) {
+        oldest = record;
+        oldest_sequence = sequence;
+        oldest_ring = i;
+      }
+    }
+    if (NULL == oldest) {
+      break;
+    }
+    ++recorder->dump_cursors[oldest_ring].next;
+    const size_t length = format_record(recorder, oldest, oldest_sequence);
+    if (length > 0u && !write_all(fd, recorder->dump_buffer, length)) {
+      ret = RCUTILS_RET_ERROR;
+      break;
+    }
+  }
+
+  store_release_uint32(&recorder->dumping, 0u);
+  return ret;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,387 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/socket.h>
+# include <sys/uio.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_journal_sink.h"
+#include "rcutils/strdup.h"
+#include "rcutils/strerror.h"
+
+#define JOURNAL_SINK_JOURNALD_SOCKET_PATH "/run/systemd/journal/socket"
+#define JOURNAL_SINK_SYSLOG_SOCKET_PATH "/dev/log"
+
+// The most fields of a journald message, and the most iovecs they take.
+#define JOURNAL_SINK_MAX_FIELDS (7)
+#define JOURNAL_SINK_MAX_IOVECS (JOURNAL_SINK_MAX_FIELDS * 5)
+
+// The syslog facility of the messages, LOG_USER.
+#define JOURNAL_SINK_SYSLOG_FACILITY (1)
+
+struct rcutils_logging_journal_sink_s
+{
+  rcutils_logging_journal_sink_options_t options;
+  rcutils_allocator_t allocator;
+  // The length of the identifier, which is duplicated into the options.
+  size_t identifier_length;
+  int fd;
+  uint64_t dropped_count;
+};
+
+rcutils_logging_journal_sink_options_t rcutils_logging_journal_sink_get_default_options(void)
+{
+  rcutils_logging_journal_sink_options_t options = {
+    .protocol = RCUTILS_LOGGING_JOURNAL_SINK_JOURNALD,
+    .socket_path = NULL,
+    .identifier = NULL,
+  };
+  return options;
+}
+
+static void free_sink(rcutils_logging_journal_sink_t * sink)
+{
+  rcutils_allocator_t allocator = sink->allocator;
+#ifndef _WIN32
+  if (sink->fd >= 0) {
+    (void)close(sink->fd);
+  }
+#endif
+  allocator.deallocate((char *)sink->options.socket_path, allocator.state);
+  allocator.deallocate((char *)sink->options.identifier, allocator.state);
+  allocator.deallocate(sink, allocator.state);
+}
+
+size_t rcutils_logging_journal_sink_get_dropped_count(rcutils_logging_journal_sink_t * sink)
+{
+  if (NULL == sink) {
+    return 0u;
+  }
+#ifdef _WIN32
+  return (size_t)sink->dropped_count;
+#else
+  return (size_t)__atomic_load_n(&sink->dropped_count, __ATOMIC_RELAXED);
+#endif
+}
+
+rcutils_ret_t rcutils_logging_journal_sink_fini(rcutils_logging_journal_sink_t * sink)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  free_sink(sink);
+  return RCUTILS_RET_OK;
+}
+
+#ifdef _WIN32
+
+rcutils_ret_t rcutils_logging_journal_sink_init(
+  rcutils_logging_journal_sink_t ** sink,
+  const rcutils_logging_journal_sink_options_t * options,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_SET_ERROR_MSG("the journal sink is not supported on Windows");
+  return RCUTILS_RET_ERROR;
+}
+
+void rcutils_logging_journal_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  (void)location;
+  (void)severity;
+  (void)name;
+  (void)timestamp;
+  (void)message;
+  (void)context;
+}
+
+#else  // _WIN32
+
+// Connect the socket of the sink to the socket of the system logger, returning 0 or -1.
+static int connect_socket(rcutils_logging_journal_sink_t * sink)
+{
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  // The length was checked when the sink was created.
+  memcpy(address.sun_path, sink->options.socket_path, strlen(sink->options.socket_path));
+  return connect(sink->fd, (const struct sockaddr *)&address, sizeof(address));
+}
+
+rcutils_ret_t rcutils_logging_journal_sink_init(
+  rcutils_logging_journal_sink_t ** sink,
+  const rcutils_logging_journal_sink_options_t * options,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  const char * socket_path = options->socket_path;
+  switch (options->protocol) {
+    case RCUTILS_LOGGING_JOURNAL_SINK_JOURNALD:
+      if (NULL == socket_path) {
+        socket_path = JOURNAL_SINK_JOURNALD_SOCKET_PATH;
+      }
+      break;
+    case RCUTILS_LOGGING_JOURNAL_SINK_SYSLOG:
+      if (NULL == socket_path) {
+        socket_path = JOURNAL_SINK_SYSLOG_SOCKET_PATH;
+      }
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("invalid journal sink protocol");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  struct sockaddr_un address;
+  if ('\0' == socket_path[0] || strlen(socket_path) >= sizeof(address.sun_path)) {
+    RCUTILS_SET_ERROR_MSG("invalid journal sink socket path");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_logging_journal_sink_t * new_sink =
+    allocator.zero_allocate(1, sizeof(rcutils_logging_journal_sink_t), allocator.state);
+  if (NULL == new_sink) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate the journal sink");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_sink->options = *options;
+  new_sink->allocator = allocator;
+  new_sink->fd = -1;
+  new_sink->options.socket_path = rcutils_strdup(socket_path, allocator);
+  new_sink->options.identifier = NULL;
+  if (NULL != options->identifier) {
+    new_sink->options.identifier = rcutils_strdup(options->identifier, allocator);
+    new_sink->identifier_length = strlen(options->identifier);
+  }
+  if (NULL == new_sink->options.socket_path ||
+    (NULL != options->identifier && NULL == new_sink->options.identifier))
+  {
+    free_sink(new_sink);
+    RCUTILS_SET_ERROR_MSG("failed to allocate the journal sink options");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+#ifdef SOCK_CLOEXEC
+  new_sink->fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+#else
+  new_sink->fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (new_sink->fd >= 0) {
+    (void)fcntl(new_sink->fd, F_SETFD, FD_CLOEXEC);
+  }
+#endif
+  if (new_sink->fd < 0 || connect_socket(new_sink) < 0) {
+    char error_string[1024];
+    rcutils_strerror(error_string, sizeof(error_string));
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to connect to the system logger at '%s': %s", socket_path, error_string);
+    free_sink(new_sink);
+    return RCUTILS_RET_ERROR;
+  }
+
+  *sink = new_sink;
+  return RCUTILS_RET_OK;
+}
+
+static int get_syslog_priority(int severity)
+{
+  if (severity >= RCUTILS_LOG_SEVERITY_FATAL) {
+    return 2;
+  } else if (severity >= RCUTILS_LOG_SEVERITY_ERROR) {
+    return 3;
+  } else if (severity >= RCUTILS_LOG_SEVERITY_WARN) {
+    return 4;
+  } else if (severity >= RCUTILS_LOG_SEVERITY_INFO) {
+    return 6;
+  }
+  return 7;
+}
+
+// Write the decimal digits of the value without a terminating null character, returning the count.
+static size_t format_decimal(char * buffer, size_t value)
+{
+  char digits[20];
+  size_t count = 0u;
+  do {
+    digits[count++] = (char)('0' + (char)(value % 10u));
+    value /= 10u;
+  } while (value > 0u);
+  for (size_t i = 0u; i < count; ++i) {
+    buffer[i] = digits[count - 1u - i];
+  }
+  return count;
+}
+
+// The iovecs of a message being gathered, along with the storage of the values they point to
+// which aren't already somewhere.
+typedef struct journal_message_s
+{
+  struct iovec iovecs[JOURNAL_SINK_MAX_IOVECS];
+  size_t iovec_count;
+  // The little endian lengths of the fields containing newlines.
+  unsigned char lengths[JOURNAL_SINK_MAX_FIELDS][8];
+  size_t length_count;
+} journal_message_t;
+
+static void add_iovec(journal_message_t * message, const char * data, size_t length)
+{
+  message->iovecs[message->iovec_count].iov_base = (void *)data;
+  message->iovecs[message->iovec_count].iov_len = length;
+  ++message->iovec_count;
+}
+
+// Add a journald field, using the binary encoding for values containing newlines.
+static void add_journald_field(
+  journal_message_t * message, const char * key, const char * value, size_t value_length)
+{
+  add_iovec(message, key, strlen(key));
+  if (NULL == memchr(value, '\n', value_length)) {
+    add_iovec(message, "=", 1u);
+  } else {
+    unsigned char * length = message->lengths[message->length_count++];
+    uint64_t remaining = (uint64_t)value_length;
+    for (size_t i = 0u; i < 8u; ++i) {
+      length[i] = (unsigned char)(remaining & 0xffu);
+      remaining >>= 8;
+    }
+    add_iovec(message, "\n", 1u);
+    add_iovec(message, (const char *)length, 8u);
+  }
+  add_iovec(message, value, value_length);
+  add_iovec(message, "\n", 1u);
+}
+
+static void add_dropped(rcutils_logging_journal_sink_t * sink)
+{
+  __atomic_fetch_add(&sink->dropped_count, 1u, __ATOMIC_RELAXED);
+}
+
+static void send_message(rcutils_logging_journal_sink_t * sink, journal_message_t * message)
+{
+  struct msghdr header;
+  memset(&header, 0, sizeof(header));
+  header.msg_iov = message->iovecs;
+  header.msg_iovlen = message->iovec_count;
+  bool reconnected = false;
+  while (sendmsg(sink->fd, &header, MSG_DONTWAIT) < 0) {
+    if (EINTR == errno) {
+      continue;
+    }
+    // The system logger was restarted, which leaves the socket connected to its old socket.
+    if (!reconnected && (ECONNREFUSED == errno || ENOTCONN == errno)) {
+      reconnected = true;
+      if (0 == connect_socket(sink)) {
+        continue;
+      }
+    }
+    add_dropped(sink);
+    return;
+  }
+}
+
+void rcutils_logging_journal_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  (void)timestamp;
+  rcutils_logging_journal_sink_t * sink = (rcutils_logging_journal_sink_t *)context;
+  if (NULL == sink) {
+    return;
+  }
+  if (NULL == name) {
+    name = "";
+  }
+  if (NULL == message) {
+    message = "";
+  }
+  const int priority = get_syslog_priority(severity);
+  journal_message_t journal_message;
+  journal_message.iovec_count = 0u;
+  journal_message.length_count = 0u;
+
+  if (RCUTILS_LOGGING_JOURNAL_SINK_SYSLOG == sink->options.protocol) {
+    // The priority is at most 191, i.e. the prefix at most "<191>".
+    char prefix[8];
+    size_t prefix_length = 0u;
+    prefix[prefix_length++] = '<';
+    prefix_length += format_decimal(
+      prefix + prefix_length, (size_t)(JOURNAL_SINK_SYSLOG_FACILITY * 8 + priority));
+    prefix[prefix_length++] = '>';
+    add_iovec(&journal_message, prefix, prefix_length);
+    if (NULL != sink->options.identifier) {
+      add_iovec(&journal_message, sink->options.identifier, sink->identifier_length);
+      add_iovec(&journal_message, ": ", 2u);
+    }
+    add_iovec(&journal_message, "[", 1u);
+    add_iovec(&journal_message, name, strlen(name));
+    add_iovec(&journal_message, "] ", 2u);
+    add_iovec(&journal_message, message, strlen(message));
+    send_message(sink, &journal_message);
+    return;
+  }
+
+  add_journald_field(&journal_message, "MESSAGE", message, strlen(message));
+  const char priority_value = (char)('0' + priority);
+  add_journald_field(&journal_message, "PRIORITY", &priority_value, 1u);
+  if (NULL != sink->options.identifier) {
+    add_journald_field(
+      &journal_message, "SYSLOG_IDENTIFIER", sink->options.identifier, sink->identifier_length);
+  }
+  add_journald_field(&journal_message, "RCUTILS_LOGGER_NAME", name, strlen(name));
+  char line_number[20];
+  if (NULL != location) {
+    if (NULL != location->file_name) {
+      add_journald_field(
+        &journal_message, "CODE_FILE", location->file_name, strlen(location->file_name));
+    }
+    add_journald_field(
+      &journal_message, "CODE_LINE", line_number,
+      format_decimal(line_number, location->line_number));
+    if (NULL != location->function_name) {
+      add_journald_field(
+        &journal_message, "CODE_FUNC", location->function_name,
+        strlen(location->function_name));
+    }
+  }
+  send_message(sink, &journal_message);
+}
+
+#endif  // _WIN32
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,495 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./logging_levels.h"
+#include "./threads.h"
+
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+
+#define RCUTILS_LOGGING_SEPARATOR_CHAR '.'
+#define RCUTILS_LOGGING_LEVELS_WILDCARD_CHAR '*'
+
+// The table holds a node of the logger hierarchy for every prefix of an added name that ends
+// before a separator, and for the name itself, keyed by the hash of the prefix.  Since the hash
+// is computed from left to right, the nodes form a trie which a single scan of a name walks by
+// extending the hash of the previous prefix.
+typedef struct logging_levels_entry_s
+{
+  size_t hash;
+  // NULL if the entry is empty, otherwise points into the name of one of its descendants.
+  const char * name;
+  size_t name_length;
+  // RCUTILS_LOG_SEVERITY_UNSET for nodes which are only ancestors of added names.
+  int level;
+} logging_levels_entry_t;
+
+// The patterns form a trie of their segments, whose first node is the root without a segment.
+// Siblings are kept in a list, since a segment with wildcards can match any number of them.
+typedef struct logging_levels_pattern_node_s
+{
+  const char * segment;
+  size_t segment_length;
+  // RCUTILS_LOG_SEVERITY_UNSET for nodes which are only prefixes of added patterns.
+  int level;
+  // Patterns added later take precedence over the ones added before them.
+  size_t order;
+  // SIZE_MAX if there is none.
+  size_t first_child;
+  size_t next_sibling;
+} logging_levels_pattern_node_t;
+
+// The number of 64 bit words of the filter of the nodes of a table.
+#define RCUTILS_LOGGING_LEVELS_FILTER_WORDS 8u
+
+struct rcutils_logging_levels_s
+{
+  rcutils_allocator_t allocator;
+  size_t count;
+  // A bloom filter of the hashes of the nodes, with two bits set per node, next to the header
+  // rather than the entries, so that looking up a name which no node has, like most loggers
+  // when only a few have a level, usually ends without reading the entries.
+  uint64_t filter[RCUTILS_LOGGING_LEVELS_FILTER_WORDS];
+  // A power of two at least twice the number of segments, or zero if the table is empty.
+  size_t capacity;
+  logging_levels_entry_t * entries;
+  size_t pattern_count;
+  size_t pattern_node_count;
+  logging_levels_pattern_node_t * pattern_nodes;
+  // Where the name of the next added entry or pattern is copied to.
+  char * next_name;
+  // Followed by the entries, the pattern nodes, the names and the patterns.
+};
+
+size_t
+rcutils_logging_levels_hash(const char * name, size_t name_length)
+{
+  size_t hash = 5381;
+  for (size_t i = 0; i < name_length; ++i) {
+    hash = ((hash << 5) + hash) + (size_t)name[i];
+  }
+  return hash;
+}
+
+rcutils_ret_t
+rcutils_logging_levels_init(
+  rcutils_logging_levels_t ** levels, size_t count, size_t segment_count, size_t names_length,
+  size_t pattern_count, size_t pattern_segment_count, size_t patterns_length,
+  rcutils_allocator_t allocator)
+{
+  // Keep the load factor at or below one half, so that probe sequences stay short.
+  size_t capacity = 0;
+  if (segment_count > 0) {
+    capacity = 2;
+    while (capacity < 2 * segment_count) {
+      capacity *= 2;
+    }
+  }
+  // Each segment of a pattern adds at most one node to the root.
+  size_t pattern_node_capacity = pattern_count > 0 ? pattern_segment_count + 1 : 0;
+  size_t size = sizeof(rcutils_logging_levels_t) + capacity * sizeof(logging_levels_entry_t) +
+    pattern_node_capacity * sizeof(logging_levels_pattern_node_t) +
+    names_length + count + patterns_length + pattern_count;
+  rcutils_logging_levels_t * new_levels = allocator.zero_allocate(1, size, allocator.state);
+  if (NULL == new_levels) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for logger levels");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_levels->allocator = allocator;
+  new_levels->capacity = capacity;
+  new_levels->entries = (logging_levels_entry_t *)(new_levels + 1);
+  new_levels->pattern_nodes = (logging_levels_pattern_node_t *)(new_levels->entries + capacity);
+  new_levels->next_name = (char *)(new_levels->pattern_nodes + pattern_node_capacity);
+  if (pattern_count > 0) {
+    logging_levels_pattern_node_t * root = &new_levels->pattern_nodes[0];
+    root->level = RCUTILS_LOG_SEVERITY_UNSET;
+    root->first_child = SIZE_MAX;
+    root->next_sibling = SIZE_MAX;
+    new_levels->pattern_node_count = 1;
+  }
+  *levels = new_levels;
+  return RCUTILS_RET_OK;
+}
+
+size_t
+rcutils_logging_levels_count_segments(const char * name)
+{
+  size_t segment_count = 1;
+  for (const char * c = name; '\0' != *c; ++c) {
+    if (RCUTILS_LOGGING_SEPARATOR_CHAR == *c) {
+      ++segment_count;
+    }
+  }
+  return segment_count;
+}
+
+// Return the two bits of the filter of a hash, taken from the top of a multiplicative mix of it,
+// as the low bits of the hash are the ones the entries are indexed with.
+static void
+get_filter_bits(size_t hash, uint64_t * first_bit, uint64_t * second_bit)
+{
+  const uint64_t mixed = (uint64_t)hash * UINT64_C(0x9e3779b97f4a7c15);
+  *first_bit = mixed >> 55;
+  *second_bit = (mixed >> 46) & 511u;
+}
+
+static bool
+filter_may_contain(const rcutils_logging_levels_t * levels, size_t hash)
+{
+  uint64_t first_bit;
+  uint64_t second_bit;
+  get_filter_bits(hash, &first_bit, &second_bit);
+  return 0u != (levels->filter[first_bit / 64u] & (UINT64_C(1) << (first_bit % 64u))) &&
+         0u != (levels->filter[second_bit / 64u] & (UINT64_C(1) << (second_bit % 64u)));
+}
+
+// Return the node of the first `name_length` characters of `name`, or NULL if there is none.
+static logging_levels_entry_t *
+find_entry(
+  const rcutils_logging_levels_t * levels, const char * name, size_t name_length, size_t hash)
+{
+  if (!filter_may_contain(levels, hash)) {
+    return NULL;
+  }
+  size_t mask = levels->capacity - 1;
+  // The table is never full, so the probe sequence always reaches an empty entry.
+  size_t index = hash & mask;
+  while (NULL != levels->entries[index].name) {
+    logging_levels_entry_t * entry = &levels->entries[index];
+    if (entry->hash == hash && entry->name_length == name_length &&
+      memcmp(entry->name, name, name_length) == 0)
+    {
+      return entry;
+    }
+    index = (index + 1) & mask;
+  }
+  return NULL;
+}
+
+// Return the node of the first `name_length` characters of `name`, inserting it if necessary.
+static logging_levels_entry_t *
+insert_entry(
+  rcutils_logging_levels_t * levels, const char * name, size_t name_length, size_t hash)
+{
+  logging_levels_entry_t * entry = find_entry(levels, name, name_length, hash);
+  if (NULL != entry) {
+    return entry;
+  }
+  size_t mask = levels->capacity - 1;
+  size_t index = hash & mask;
+  while (NULL != levels->entries[index].name) {
+    index = (index + 1) & mask;
+  }
+  entry = &levels->entries[index];
+  uint64_t first_bit;
+  uint64_t second_bit;
+  get_filter_bits(hash, &first_bit, &second_bit);
+  levels->filter[first_bit / 64u] |= UINT64_C(1) << (first_bit % 64u);
+  levels->filter[second_bit / 64u] |= UINT64_C(1) << (second_bit % 64u);
+  entry->hash = hash;
+  entry->name = name;
+  entry->name_length = name_length;
+  entry->level = RCUTILS_LOG_SEVERITY_UNSET;
+  return entry;
+}
+
+void
+rcutils_logging_levels_add(rcutils_logging_levels_t * levels, const char * name, int level)
+{
+  size_t name_length = strlen(name);
+  char * name_copy = levels->next_name;
+  memcpy(name_copy, name, name_length + 1);
+  levels->next_name += name_length + 1;
+
+  // Add the ancestors which aren't in the table yet along the way.
+  size_t hash = 5381;
+  for (size_t i = 0; i < name_length; ++i) {
+    if (RCUTILS_LOGGING_SEPARATOR_CHAR == name_copy[i]) {
+      (void)insert_entry(levels, name_copy, i, hash);
+    }
+    hash = ((hash << 5) + hash) + (size_t)name_copy[i];
+  }
+  insert_entry(levels, name_copy, name_length, hash)->level = level;
+  ++levels->count;
+}
+
+bool
+rcutils_logging_levels_is_pattern(const char * name)
+{
+  return NULL != strchr(name, RCUTILS_LOGGING_LEVELS_WILDCARD_CHAR);
+}
+
+// Return the child of a pattern node with exactly the given segment, adding it if necessary.
+static logging_levels_pattern_node_t *
+insert_pattern_node(
+  rcutils_logging_levels_t * levels, logging_levels_pattern_node_t * parent,
+  const char * segment, size_t segment_length)
+{
+  size_t * link = &parent->first_child;
+  while (SIZE_MAX != *link) {
+    logging_levels_pattern_node_t * node = &levels->pattern_nodes[*link];
+    if (node->segment_length == segment_length &&
+      memcmp(node->segment, segment, segment_length) == 0)
+    {
+      return node;
+    }
+    link = &node->next_sibling;
+  }
+  *link = levels->pattern_node_count++;
+  logging_levels_pattern_node_t * node = &levels->pattern_nodes[*link];
+  node->segment = segment;
+  node->segment_length = segment_length;
+  node->level = RCUTILS_LOG_SEVERITY_UNSET;
+  node->first_child = SIZE_MAX;
+  node->next_sibling = SIZE_MAX;
+  return node;
+}
+
+void
+rcutils_logging_levels_add_pattern(
+  rcutils_logging_levels_t * levels, const char * pattern, int level)
+{
+  size_t pattern_length = strlen(pattern);
+  char * pattern_copy = levels->next_name;
+  memcpy(pattern_copy, pattern, pattern_length + 1);
+  levels->next_name += pattern_length + 1;
+
+  logging_levels_pattern_node_t * node = &levels->pattern_nodes[0];
+  size_t segment_start = 0;
+  for (size_t i = 0; i <= pattern_length; ++i) {
+    if (i == pattern_length || RCUTILS_LOGGING_SEPARATOR_CHAR == pattern_copy[i]) {
+      node = insert_pattern_node(
+        levels, node, pattern_copy + segment_start, i - segment_start);
+      segment_start = i + 1;
+    }
+  }
+  node->level = level;
+  node->order = levels->pattern_count++;
+}
+
+// Return whether a segment of a logger name matches a segment of a pattern.
+static bool
+match_segment(
+  const char * pattern, size_t pattern_length, const char * segment, size_t segment_length)
+{
+  // Where to continue after the last wildcard, if the characters following it don't match.
+  size_t star = SIZE_MAX;
+  size_t star_match = 0;
+  size_t p = 0;
+  size_t s = 0;
+  while (s < segment_length) {
+    if (p < pattern_length && RCUTILS_LOGGING_LEVELS_WILDCARD_CHAR == pattern[p]) {
+      star = p++;
+      star_match = s;
+    } else if (p < pattern_length && pattern[p] == segment[s]) {
+      ++p;
+      ++s;
+    } else if (SIZE_MAX != star) {
+      // Let the last wildcard match one more character.
+      p = star + 1;
+      s = ++star_match;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern_length && RCUTILS_LOGGING_LEVELS_WILDCARD_CHAR == pattern[p]) {
+    ++p;
+  }
+  return p == pattern_length;
+}
+
+typedef struct logging_levels_pattern_match_s
+{
+  int level;
+  // The length of the prefix of the name the pattern matched, and the order of the pattern.
+  size_t length;
+  size_t order;
+} logging_levels_pattern_match_t;
+
+// Match the segments of the name starting at `start` against the children of a pattern node.
+static void
+match_pattern_children(
+  const rcutils_logging_levels_t * levels, const logging_levels_pattern_node_t * parent,
+  const char * name, size_t name_length, size_t start, logging_levels_pattern_match_t * match)
+{
+  size_t end = start;
+  while (end < name_length && RCUTILS_LOGGING_SEPARATOR_CHAR != name[end]) {
+    ++end;
+  }
+  for (size_t child = parent->first_child; SIZE_MAX != child;
+    child = levels->pattern_nodes[child].next_sibling)
+  {
+    const logging_levels_pattern_node_t * node = &levels->pattern_nodes[child];
+    if (!match_segment(node->segment, node->segment_length, name + start, end - start)) {
+      continue;
+    }
+    if (RCUTILS_LOG_SEVERITY_UNSET != node->level &&
+      (RCUTILS_LOG_SEVERITY_UNSET == match->level || end > match->length ||
+      (end == match->length && node->order > match->order)))
+    {
+      match->level = node->level;
+      match->length = end;
+      match->order = node->order;
+    }
+    if (end < name_length) {
+      match_pattern_children(levels, node, name, name_length, end + 1, match);
+    }
+  }
+}
+
+int
+rcutils_logging_levels_find(
+  const rcutils_logging_levels_t * levels, const char * name, size_t name_length, size_t hash)
+{
+  if (0 == levels->count) {
+    return RCUTILS_LOG_SEVERITY_UNSET;
+  }
+  const logging_levels_entry_t * entry = find_entry(levels, name, name_length, hash);
+  return NULL != entry ? entry->level : RCUTILS_LOG_SEVERITY_UNSET;
+}
+
+int
+rcutils_logging_levels_find_closest(
+  const rcutils_logging_levels_t * levels, const char * name, size_t name_length,
+  size_t name_hash)
+{
+  if (0 != levels->count) {
+    // The level of the name itself applies over any other, including the ones of patterns, and
+    // with its hash already known it is a single probe, mostly rejected by the bloom filter.
+    const logging_levels_entry_t * entry = find_entry(levels, name, name_length, name_hash);
+    if (NULL != entry && RCUTILS_LOG_SEVERITY_UNSET != entry->level) {
+      return entry->level;
+    }
+  }
+
+  int level = RCUTILS_LOG_SEVERITY_UNSET;
+  // The length of the prefix of the name which has the level.
+  size_t level_length = 0;
+  size_t hash = 5381;
+  bool pruned = 0 == levels->count;
+  // Only the ancestors are left, which are the prefixes ending before a separator.
+  for (size_t i = 0; !pruned && i < name_length; ++i) {
+    if (RCUTILS_LOGGING_SEPARATOR_CHAR == name[i]) {
+      const logging_levels_entry_t * entry = find_entry(levels, name, i, hash);
+      if (NULL == entry) {
+        // No added name starts with this prefix, so there are no deeper ancestors either.
+        pruned = true;
+        break;
+      }
+      if (RCUTILS_LOG_SEVERITY_UNSET != entry->level) {
+        level = entry->level;
+        level_length = i;
+      }
+    }
+    hash = ((hash << 5) + hash) + (size_t)name[i];
+  }
+  if (!pruned && hash != name_hash) {
+    // The hash given for the name was wrong, look the name itself up again with the right one.
+    const logging_levels_entry_t * entry = find_entry(levels, name, name_length, hash);
+    if (NULL != entry && RCUTILS_LOG_SEVERITY_UNSET != entry->level) {
+      return entry->level;
+    }
+  }
+
+  // The empty name is the default logger, which patterns don't apply to.
+  if (0 != levels->pattern_count && 0 != name_length) {
+    logging_levels_pattern_match_t match = {RCUTILS_LOG_SEVERITY_UNSET, 0, 0};
+    match_pattern_children(levels, &levels->pattern_nodes[0], name, name_length, 0, &match);
+    // A pattern only takes precedence over a name which is an ancestor of what it matched.
+    if (RCUTILS_LOG_SEVERITY_UNSET != match.level &&
+      (RCUTILS_LOG_SEVERITY_UNSET == level || match.length > level_length))
+    {
+      level = match.level;
+    }
+  }
+  return level;
+}
+
+void
+rcutils_logging_levels_fini(rcutils_logging_levels_t * levels)
+{
+  if (NULL != levels) {
+    rcutils_allocator_t allocator = levels->allocator;
+    allocator.deallocate(levels, allocator.state);
+  }
+}
+
+const rcutils_logging_levels_t *
+rcutils_logging_levels_read_begin(
+  rcutils_logging_levels_publication_t * publication, size_t * reader_slot)
+{
+  size_t version;
+  rcutils_atomic_load(&publication->version, version);
+  *reader_slot = version & 1u;
+  size_t previous_readers;
+  rcutils_atomic_fetch_add(&publication->readers[*reader_slot], previous_readers, 1u);
+  (void)previous_readers;
+  // Loaded after announcing the reader, so that a writer which replaces it afterwards waits.
+  return (const rcutils_logging_levels_t *)rcutils_atomic_load_uintptr_t(&publication->levels);
+}
+
+void
+rcutils_logging_levels_read_end(
+  rcutils_logging_levels_publication_t * publication, size_t reader_slot)
+{
+  size_t previous_readers;
+  rcutils_atomic_fetch_add(&publication->readers[reader_slot], previous_readers, SIZE_MAX);
+  (void)previous_readers;
+}
+
+static void
+wait_for_readers(atomic_size_t * readers)
+{
+  while (true) {
+    size_t count;
+    rcutils_atomic_load(readers, count);
+    if (0u == count) {
+      return;
+    }
+    rcutils_thread_yield();
+  }
+}
+
+rcutils_logging_levels_t *
+rcutils_logging_levels_publish(
+  rcutils_logging_levels_publication_t * publication, rcutils_logging_levels_t * levels)
+{
+  rcutils_logging_levels_t * previous_levels = (rcutils_logging_levels_t *)
+    rcutils_atomic_exchange_uintptr_t(&publication->levels, (uintptr_t)levels);
+
+  size_t version;
+  rcutils_atomic_load(&publication->version, version);
+  const size_t current_slot = version & 1u;
+  // Readers which loaded the version before the previous publication flipped it may still be
+  // counted in the other slot, and may hold the previous table as well.
+  wait_for_readers(&publication->readers[current_slot ^ 1u]);
+  // New readers go to the other slot from now on, and can only get the new table.
+  rcutils_atomic_store(&publication->version, version + 1u);
+  wait_for_readers(&publication->readers[current_slot]);
+
+  return previous_levels;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,174 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal read-mostly storage of the logger levels: immutable open addressing
+// tables which readers look up without taking a lock, and which writers
+// replace as a whole, freeing the previous table once no reader uses it.
+
+#ifndef LOGGING_LEVELS_H_
+#define LOGGING_LEVELS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control_macros.h"
+
+typedef struct rcutils_logging_levels_s rcutils_logging_levels_t;
+
+/// The table currently published to readers, along with the readers using it.
+/**
+ * Readers announce themselves in one of two counters, selected by `version`.
+ * A writer publishing a new table flips `version` and waits for the counter
+ * used before to drain, after which no reader can still hold the previous
+ * table.
+ * All members are private, zero initialize it.
+ */
+typedef struct rcutils_logging_levels_publication_s
+{
+  atomic_uintptr_t levels;
+  atomic_size_t version;
+  atomic_size_t readers[2];
+} rcutils_logging_levels_publication_t;
+
+/// Return the djb2 hash of the first `name_length` characters of `name`.
+/**
+ * This is the same hash as rcutils_hash_map_string_hash_func() for the whole string.
+ */
+RCUTILS_LOCAL
+size_t
+rcutils_logging_levels_hash(const char * name, size_t name_length);
+
+/// Return the number of segments of a logger name, which is one more than its separators.
+RCUTILS_LOCAL
+size_t
+rcutils_logging_levels_count_segments(const char * name);
+
+/// Return whether a logger name is a pattern, which has at least one wildcard.
+RCUTILS_LOCAL
+bool
+rcutils_logging_levels_is_pattern(const char * name);
+
+/// Allocate a table for `count` levels with names of `names_length` characters in total.
+/**
+ * `segment_count` is the number of segments of all those names in total, see
+ * rcutils_logging_levels_count_segments(), which bounds the number of nodes
+ * of the logger hierarchy the table holds.
+ * The `pattern_` arguments are the same for `pattern_count` levels of patterns.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_logging_levels_init(
+  rcutils_logging_levels_t ** levels, size_t count, size_t segment_count, size_t names_length,
+  size_t pattern_count, size_t pattern_segment_count, size_t patterns_length,
+  rcutils_allocator_t allocator);
+
+/// Add a copy of a logger name and its level, before the table is published.
+/**
+ * At most `count` names of at most `names_length` characters in total may be
+ * added, and each name at most once.
+ */
+RCUTILS_LOCAL
+void
+rcutils_logging_levels_add(rcutils_logging_levels_t * levels, const char * name, int level);
+
+/// Add a copy of a pattern and its level, before the table is published.
+/**
+ * At most `pattern_count` patterns may be added, each at most once, and
+ * patterns added later take precedence over the ones added before them.
+ */
+RCUTILS_LOCAL
+void
+rcutils_logging_levels_add_pattern(
+  rcutils_logging_levels_t * levels, const char * pattern, int level);
+
+/// Return the level of the logger with the first `name_length` characters of `name`.
+/**
+ * \return The level, or
+ * \return #RCUTILS_LOG_SEVERITY_UNSET if the table has no level for the logger.
+ */
+RCUTILS_LOCAL
+int
+rcutils_logging_levels_find(
+  const rcutils_logging_levels_t * levels, const char * name, size_t name_length, size_t hash);
+
+/// Return the level of the logger, or else of its closest ancestor which has one.
+/**
+ * `name_hash` must be the hash of the name, see rcutils_logging_levels_hash(),
+ * which is used to look up the level of the name itself first.
+ *
+ * The ancestors are the prefixes of the name ending before a separator.
+ * Walks the logger hierarchy with a single scan of the name, which stops at
+ * the first prefix that no name in the table starts with.
+ * Such prefixes are mostly rejected by a bloom filter of the hierarchy, so
+ * that the table itself is only probed for the prefixes it likely holds.
+ *
+ * Patterns apply to the loggers they match like names, and the level of a
+ * name applies over the level of a pattern matching the same logger.
+ * The pattern trie is walked along with the segments of the name, following
+ * every child whose segment matches.
+ *
+ * \return The level, or
+ * \return #RCUTILS_LOG_SEVERITY_UNSET if the table has no level for the logger or its ancestors.
+ */
+RCUTILS_LOCAL
+int
+rcutils_logging_levels_find_closest(
+  const rcutils_logging_levels_t * levels, const char * name, size_t name_length,
+  size_t name_hash);
+
+/// Free a table which isn't published, or whose publication ended.
+RCUTILS_LOCAL
+void
+rcutils_logging_levels_fini(rcutils_logging_levels_t * levels);
+
+/// Start using the published table, which may be NULL.
+/**
+ * Lock-free and safe to call concurrently with rcutils_logging_levels_publish().
+ * The table stays valid until rcutils_logging_levels_read_end() is called with
+ * the returned `reader_slot`.
+ */
+RCUTILS_LOCAL
+const rcutils_logging_levels_t *
+rcutils_logging_levels_read_begin(
+  rcutils_logging_levels_publication_t * publication, size_t * reader_slot);
+
+/// Stop using the table returned by rcutils_logging_levels_read_begin().
+RCUTILS_LOCAL
+void
+rcutils_logging_levels_read_end(
+  rcutils_logging_levels_publication_t * publication, size_t reader_slot);
+
+/// Publish a new table, which may be NULL, and return the previous one once no reader uses it.
+/**
+ * The caller must serialize publications and owns the returned table.
+ * Waits for the readers which started before the publication to end.
+ */
+RCUTILS_LOCAL
+rcutils_logging_levels_t *
+rcutils_logging_levels_publish(
+  rcutils_logging_levels_publication_t * publication, rcutils_logging_levels_t * levels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOGGING_LEVELS_H_
@@ -0,0 +1,197 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./logging_lz4.h"
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md
+#define LZ4_FRAME_MAGIC (0x184D2204u)
+// Version 01 and independent blocks, without checksums nor content size.
+#define LZ4_FRAME_FLG (0x60u)
+// Blocks of at most 64 KiB.
+#define LZ4_FRAME_BD (0x40u)
+// The second byte of the xxHash32 of the FLG and BD bytes above.
+#define LZ4_FRAME_HC (0x82u)
+#define LZ4_FRAME_HEADER_SIZE (7u)
+#define LZ4_FRAME_END_MARK_SIZE (4u)
+#define LZ4_BLOCK_MAX_SIZE (64u * 1024u)
+// Set in the size of a block stored uncompressed.
+#define LZ4_BLOCK_UNCOMPRESSED (0x80000000u)
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+#define LZ4_MIN_MATCH (4u)
+// The last match must start at least 12 bytes before the end of the block.
+#define LZ4_MATCH_FIND_LIMIT (12u)
+// The last 5 bytes of a block are always literals.
+#define LZ4_LAST_LITERALS (5u)
+#define LZ4_HASH_BITS (12u)
+
+static void write_le32(unsigned char * out, uint32_t value)
+{
+  out[0] = (unsigned char)value;
+  out[1] = (unsigned char)(value >> 8);
+  out[2] = (unsigned char)(value >> 16);
+  out[3] = (unsigned char)(value >> 24);
+}
+
+static uint32_t read_uint32(const unsigned char * in)
+{
+  uint32_t value;
+  memcpy(&value, in, sizeof(value));
+  return value;
+}
+
+static uint32_t hash_sequence(uint32_t sequence)
+{
+  return (sequence * 2654435761u) >> (32u - LZ4_HASH_BITS);
+}
+
+// The worst case of a block is all literals, with a length byte per 255 of them.
+static size_t block_bound(size_t length)
+{
+  return length + length / 255u + 16u;
+}
+
+static unsigned char * write_length(unsigned char * out, size_t length)
+{
+  while (length >= 255u) {
+    *out++ = 255u;
+    length -= 255u;
+  }
+  *out++ = (unsigned char)length;
+  return out;
+}
+
+static unsigned char * write_sequence(
+  unsigned char * out, const unsigned char * literals, size_t literal_length,
+  size_t offset, size_t match_length)
+{
+  unsigned char * token = out++;
+  *token = (unsigned char)((literal_length < 15u ? literal_length : 15u) << 4);
+  if (literal_length >= 15u) {
+    out = write_length(out, literal_length - 15u);
+  }
+  memcpy(out, literals, literal_length);
+  out += literal_length;
+  if (0u == match_length) {
+    return out;
+  }
+  *out++ = (unsigned char)offset;
+  *out++ = (unsigned char)(offset >> 8);
+  const size_t extra_length = match_length - LZ4_MIN_MATCH;
+  *token |= (unsigned char)(extra_length < 15u ? extra_length : 15u);
+  if (extra_length >= 15u) {
+    out = write_length(out, extra_length - 15u);
+  }
+  return out;
+}
+
+// Greedily compress a block of at most 64 KiB, so that positions fit in the hash table entries.
+static size_t compress_block(
+  const unsigned char * block, size_t length, unsigned char * out, uint16_t * table)
+{
+  unsigned char * const out_start = out;
+  const unsigned char * anchor = block;
+  if (length > LZ4_MATCH_FIND_LIMIT) {
+    memset(table, 0, RCUTILS_LOGGING_LZ4_TABLE_SIZE * sizeof(uint16_t));
+    const unsigned char * const match_limit = block + length - LZ4_MATCH_FIND_LIMIT;
+    const unsigned char * const end_limit = block + length - LZ4_LAST_LITERALS;
+    const unsigned char * in = block + 1;
+    while (in < match_limit) {
+      const uint32_t sequence = read_uint32(in);
+      const uint32_t hash = hash_sequence(sequence);
+      // Empty entries point at the start of the block, which is checked like any other.
+      const unsigned char * candidate = block + table[hash];
+      table[hash] = (uint16_t)(in - block);
+      if (candidate >= in || read_uint32(candidate) != sequence) {
+        ++in;
+        continue;
+      }
+      // Extend the match backwards over the pending literals, then forwards.
+      while (in > anchor && candidate > block && in[-1] == candidate[-1]) {
+        --in;
+        --candidate;
+      }
+      const unsigned char * match_end = in + LZ4_MIN_MATCH;
+      const unsigned char * candidate_end = candidate + LZ4_MIN_MATCH;
+      while (match_end < end_limit && *match_end == *candidate_end) {
+        ++match_end;
+        ++candidate_end;
+      }
+      out = write_sequence(
+        out, anchor, (size_t)(in - anchor), (size_t)(in - candidate), (size_t)(match_end - in));
+      in = match_end;
+      anchor = in;
+      if (in < match_limit) {
+        // Index a position within the match, it often starts the next one.
+        table[hash_sequence(read_uint32(in - 2))] = (uint16_t)(in - 2 - block);
+      }
+    }
+  }
+  out = write_sequence(out, anchor, (size_t)(block + length - anchor), 0u, 0u);
+  return (size_t)(out - out_start);
+}
+
+size_t
+rcutils_logging_lz4_frame_bound(size_t length)
+{
+  const size_t blocks = (length + LZ4_BLOCK_MAX_SIZE - 1u) / LZ4_BLOCK_MAX_SIZE;
+  return LZ4_FRAME_HEADER_SIZE + blocks * (4u + block_bound(LZ4_BLOCK_MAX_SIZE)) +
+         LZ4_FRAME_END_MARK_SIZE;
+}
+
+size_t
+rcutils_logging_lz4_compress_frame(
+  const char * data, size_t length, char * frame, uint16_t * table)
+{
+  unsigned char * out = (unsigned char *)frame;
+  write_le32(out, LZ4_FRAME_MAGIC);
+  out[4] = LZ4_FRAME_FLG;
+  out[5] = LZ4_FRAME_BD;
+  out[6] = LZ4_FRAME_HC;
+  out += LZ4_FRAME_HEADER_SIZE;
+
+  const unsigned char * in = (const unsigned char *)data;
+  while (length > 0u) {
+    const size_t block_length = length < LZ4_BLOCK_MAX_SIZE ? length : LZ4_BLOCK_MAX_SIZE;
+    size_t compressed_length = compress_block(in, block_length, out + 4, table);
+    // Data which doesn't compress is stored as it is.
+    if (compressed_length >= block_length) {
+      memcpy(out + 4, in, block_length);
+      write_le32(out, (uint32_t)block_length | LZ4_BLOCK_UNCOMPRESSED);
+      compressed_length = block_length;
+    } else {
+      write_le32(out, (uint32_t)compressed_length);
+    }
+    out += 4u + compressed_length;
+    in += block_length;
+    length -= block_length;
+  }
+
+  write_le32(out, 0u);
+  out += LZ4_FRAME_END_MARK_SIZE;
+  return (size_t)(out - (unsigned char *)frame);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal LZ4 compressor used by the file sink: each call produces a complete frame of the LZ4
+// frame format, made of independent blocks of at most 64 KiB, which the `lz4` tool decompresses
+// and which can be concatenated, so every flushed frame is readable on its own.
+
+#ifndef LOGGING_LZ4_H_
+#define LOGGING_LZ4_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/visibility_control_macros.h"
+
+/// The number of entries of the hash table used by rcutils_logging_lz4_compress_frame().
+#define RCUTILS_LOGGING_LZ4_TABLE_SIZE (4096u)
+
+/// Return the size of the largest frame rcutils_logging_lz4_compress_frame() makes of `length`.
+RCUTILS_LOCAL
+size_t
+rcutils_logging_lz4_frame_bound(size_t length);
+
+/// Compress `length` bytes of `data` into a complete LZ4 frame, and return the size of the frame.
+/**
+ * `frame` must hold at least rcutils_logging_lz4_frame_bound() bytes, and
+ * `table` #RCUTILS_LOGGING_LZ4_TABLE_SIZE entries, which needn't be initialized.
+ */
+RCUTILS_LOCAL
+size_t
+rcutils_logging_lz4_compress_frame(
+  const char * data, size_t length, char * frame, uint16_t * table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOGGING_LZ4_H_
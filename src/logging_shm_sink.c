@@ -0,0 +1,616 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_shm_sink.h"
+#include "rcutils/process.h"
+#include "rcutils/snprintf.h"
+#include "rcutils/strdup.h"
+#include "rcutils/strerror.h"
+
+#define SHM_SINK_DEFAULT_CAPACITY ((size_t)1 << 20)
+#define SHM_SINK_MIN_CAPACITY ((size_t)1 << 12)
+#define SHM_SINK_MAX_CAPACITY ((size_t)1 << 30)
+// The longest name of a shared memory object, NAME_MAX on Linux.
+#define SHM_SINK_MAX_NAME_LENGTH (255u)
+
+// "RCLG", written last when the ring is created.
+#define SHM_SINK_MAGIC (0x52434c47u)
+#define SHM_SINK_VERSION (1u)
+#define SHM_SINK_CACHE_LINE_SIZE (64u)
+
+// The record only fills the end of the ring, which the next record didn't fit in.
+#define SHM_SINK_RECORD_PADDING (1u)
+// The record has a location.
+#define SHM_SINK_RECORD_LOCATION (2u)
+
+// The header of the shared memory, which the ring follows.
+// The writers and the reader only share the cache lines of the head and the tail.
+typedef struct shm_sink_header_s
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;
+  int64_t pid;
+  // Nonzero once the sink was finalized.
+  uint32_t closed;
+  uint32_t reserved;
+  uint64_t dropped_count;
+  uint8_t padding0[SHM_SINK_CACHE_LINE_SIZE - 40u];
+  // The number of bytes reserved by the writers so far.
+  uint64_t head;
+  uint8_t padding1[SHM_SINK_CACHE_LINE_SIZE - 8u];
+  // The number of bytes taken by the reader so far, which it zeroed before advancing this.
+  uint64_t tail;
+  uint8_t padding2[SHM_SINK_CACHE_LINE_SIZE - 8u];
+} shm_sink_header_t;
+
+// A record in the ring, followed by the null terminated name, message, file name and
+// function name, and padded to a multiple of 8 bytes.
+typedef struct shm_sink_record_s
+{
+  // The size of the record, written last once the rest of the record is, and zero until then.
+  uint32_t size;
+  uint32_t flags;
+  int64_t timestamp;
+  int32_t severity;
+  uint32_t line_number;
+  uint32_t name_length;
+  uint32_t message_length;
+  uint32_t file_name_length;
+  uint32_t function_name_length;
+} shm_sink_record_t;
+
+struct rcutils_logging_shm_sink_s
+{
+  rcutils_allocator_t allocator;
+  char * name;
+  shm_sink_header_t * header;
+  unsigned char * ring;
+  size_t mapped_size;
+};
+
+struct rcutils_logging_shm_reader_s
+{
+  rcutils_allocator_t allocator;
+  shm_sink_header_t * header;
+  unsigned char * ring;
+  size_t capacity;
+  size_t mapped_size;
+  uint64_t tail;
+  bool corrupted;
+};
+
+rcutils_logging_shm_sink_options_t rcutils_logging_shm_sink_get_default_options(void)
+{
+  rcutils_logging_shm_sink_options_t options = {
+    .name = NULL,
+    .capacity = SHM_SINK_DEFAULT_CAPACITY,
+  };
+  return options;
+}
+
+const char * rcutils_logging_shm_sink_get_name(const rcutils_logging_shm_sink_t * sink)
+{
+  return NULL != sink ? sink->name : NULL;
+}
+
+#ifdef _WIN32
+
+rcutils_ret_t rcutils_logging_shm_sink_init(
+  rcutils_logging_shm_sink_t ** sink,
+  const rcutils_logging_shm_sink_options_t * options,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_SET_ERROR_MSG("the shared memory sink is not supported on Windows");
+  return RCUTILS_RET_ERROR;
+}
+
+size_t rcutils_logging_shm_sink_get_dropped_count(const rcutils_logging_shm_sink_t * sink)
+{
+  (void)sink;
+  return 0u;
+}
+
+rcutils_ret_t rcutils_logging_shm_sink_fini(rcutils_logging_shm_sink_t * sink)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  return RCUTILS_RET_OK;
+}
+
+void rcutils_logging_shm_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  (void)location;
+  (void)severity;
+  (void)name;
+  (void)timestamp;
+  (void)message;
+  (void)context;
+}
+
+rcutils_ret_t rcutils_logging_shm_reader_open(
+  rcutils_logging_shm_reader_t ** reader,
+  const char * name,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(reader, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(name, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_SET_ERROR_MSG("the shared memory sink is not supported on Windows");
+  return RCUTILS_RET_ERROR;
+}
+
+rcutils_ret_t rcutils_logging_shm_reader_take(
+  rcutils_logging_shm_reader_t * reader,
+  rcutils_logging_shm_record_callback_t callback,
+  void * context,
+  size_t max_count,
+  size_t * count)
+{
+  (void)context;
+  (void)max_count;
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(reader, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(callback, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RCUTILS_RET_INVALID_ARGUMENT);
+  *count = 0u;
+  return RCUTILS_RET_OK;
+}
+
+bool rcutils_logging_shm_reader_is_closed(const rcutils_logging_shm_reader_t * reader)
+{
+  (void)reader;
+  return true;
+}
+
+int64_t rcutils_logging_shm_reader_get_pid(const rcutils_logging_shm_reader_t * reader)
+{
+  (void)reader;
+  return 0;
+}
+
+size_t rcutils_logging_shm_reader_get_dropped_count(const rcutils_logging_shm_reader_t * reader)
+{
+  (void)reader;
+  return 0u;
+}
+
+rcutils_ret_t rcutils_logging_shm_reader_close(rcutils_logging_shm_reader_t * reader)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(reader, RCUTILS_RET_INVALID_ARGUMENT);
+  return RCUTILS_RET_OK;
+}
+
+#else  // _WIN32
+
+static void set_error_from_errno(const char * what, const char * name)
+{
+  char error_string[1024];
+  rcutils_strerror(error_string, sizeof(error_string));
+  RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to %s '%s': %s", what, name, error_string);
+}
+
+static size_t align_record_size(size_t size)
+{
+  return (size + 7u) & ~(size_t)7u;
+}
+
+static void free_sink(rcutils_logging_shm_sink_t * sink)
+{
+  rcutils_allocator_t allocator = sink->allocator;
+  if (NULL != sink->header) {
+    (void)munmap(sink->header, sink->mapped_size);
+  }
+  allocator.deallocate(sink->name, allocator.state);
+  allocator.deallocate(sink, allocator.state);
+}
+
+rcutils_ret_t rcutils_logging_shm_sink_init(
+  rcutils_logging_shm_sink_t ** sink,
+  const rcutils_logging_shm_sink_options_t * options,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(options, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+  const size_t capacity = options->capacity;
+  if (capacity < SHM_SINK_MIN_CAPACITY || capacity > SHM_SINK_MAX_CAPACITY ||
+    0u != (capacity & (capacity - 1u)))
+  {
+    RCUTILS_SET_ERROR_MSG("shared memory sink capacity must be a power of two of 4 KiB to 1 GiB");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  char default_name[32];
+  const char * name = options->name;
+  if (NULL == name) {
+    int written = rcutils_snprintf(
+      default_name, sizeof(default_name), "/rcutils_log.%d", rcutils_get_pid());
+    if (written < 0 || (size_t)written >= sizeof(default_name)) {
+      RCUTILS_SET_ERROR_MSG("failed to format the shared memory sink name");
+      return RCUTILS_RET_ERROR;
+    }
+    name = default_name;
+  }
+  if ('/' != name[0] || '\0' == name[1] || NULL != strchr(name + 1, '/') ||
+    strlen(name) > SHM_SINK_MAX_NAME_LENGTH)
+  {
+    RCUTILS_SET_ERROR_MSG("invalid shared memory sink name");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_logging_shm_sink_t * new_sink =
+    allocator.zero_allocate(1, sizeof(rcutils_logging_shm_sink_t), allocator.state);
+  if (NULL == new_sink) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate the shared memory sink");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_sink->allocator = allocator;
+  new_sink->name = rcutils_strdup(name, allocator);
+  if (NULL == new_sink->name) {
+    free_sink(new_sink);
+    RCUTILS_SET_ERROR_MSG("failed to allocate the shared memory sink name");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  new_sink->mapped_size = sizeof(shm_sink_header_t) + capacity;
+  int fd = shm_open(name, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    set_error_from_errno("create the shared memory", name);
+    free_sink(new_sink);
+    return RCUTILS_RET_ERROR;
+  }
+  void * memory = MAP_FAILED;
+  if (0 == ftruncate(fd, (off_t)new_sink->mapped_size)) {
+    memory = mmap(NULL, new_sink->mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  if (MAP_FAILED == memory) {
+    set_error_from_errno("map the shared memory", name);
+    (void)close(fd);
+    (void)shm_unlink(name);
+    free_sink(new_sink);
+    return RCUTILS_RET_ERROR;
+  }
+  // The mapping keeps the shared memory object alive.
+  (void)close(fd);
+
+  new_sink->header = (shm_sink_header_t *)memory;
+  new_sink->ring = (unsigned char *)memory + sizeof(shm_sink_header_t);
+  // The truncated object is zeroed already, but this faults its pages in.
+  memset(memory, 0, new_sink->mapped_size);
+  new_sink->header->version = SHM_SINK_VERSION;
+  new_sink->header->capacity = (uint64_t)capacity;
+  new_sink->header->pid = (int64_t)rcutils_get_pid();
+  __atomic_store_n(&new_sink->header->magic, SHM_SINK_MAGIC, __ATOMIC_RELEASE);
+
+  *sink = new_sink;
+  return RCUTILS_RET_OK;
+}
+
+size_t rcutils_logging_shm_sink_get_dropped_count(const rcutils_logging_shm_sink_t * sink)
+{
+  if (NULL == sink) {
+    return 0u;
+  }
+  return (size_t)__atomic_load_n(&sink->header->dropped_count, __ATOMIC_RELAXED);
+}
+
+rcutils_ret_t rcutils_logging_shm_sink_fini(rcutils_logging_shm_sink_t * sink)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sink, RCUTILS_RET_INVALID_ARGUMENT);
+  __atomic_store_n(&sink->header->closed, 1u, __ATOMIC_RELEASE);
+  (void)shm_unlink(sink->name);
+  free_sink(sink);
+  return RCUTILS_RET_OK;
+}
+
+static uint32_t string_length(const char * string, size_t max_length)
+{
+  if (NULL == string) {
+    return 0u;
+  }
+  const size_t length = strlen(string);
+  return (uint32_t)(length < max_length ? length : max_length);
+}
+
+// Copy a string and its null terminator into the record, returning where the next one goes.
+static unsigned char * copy_string(unsigned char * destination, const char * string, size_t length)
+{
+  if (length > 0u) {
+    memcpy(destination, string, length);
+  }
+  destination[length] = '\0';
+  return destination + length + 1u;
+}
+
+void rcutils_logging_shm_sink_output(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  rcutils_logging_shm_sink_t * sink = (rcutils_logging_shm_sink_t *)context;
+  if (NULL == sink) {
+    return;
+  }
+  shm_sink_header_t * header = sink->header;
+  const size_t capacity = (size_t)header->capacity;
+  // No string is longer than the ring, so the sizes can't overflow.
+  const uint32_t name_length = string_length(name, capacity);
+  const uint32_t message_length = string_length(message, capacity);
+  const uint32_t file_name_length =
+    NULL != location ? string_length(location->file_name, capacity) : 0u;
+  const uint32_t function_name_length =
+    NULL != location ? string_length(location->function_name, capacity) : 0u;
+  const size_t size = align_record_size(
+    sizeof(shm_sink_record_t) + (size_t)name_length + message_length + file_name_length +
+    function_name_length + 4u);
+  if (size > capacity) {
+    __atomic_fetch_add(&header->dropped_count, 1u, __ATOMIC_RELAXED);
+    return;
+  }
+
+  // Reserve the room of the record, after the padding of the end of the ring if it doesn't fit
+  // there.
+  uint64_t head = __atomic_load_n(&header->head, __ATOMIC_RELAXED);
+  size_t padding = 0u;
+  do {
+    const uint64_t tail = __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE);
+    const size_t offset = (size_t)(head & (capacity - 1u));
+    padding = offset + size > capacity ? capacity - offset : 0u;
+    if (head + padding + size - tail > capacity) {
+      __atomic_fetch_add(&header->dropped_count, 1u, __ATOMIC_RELAXED);
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(
+      &header->head, &head, head + padding + size, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+  if (padding > 0u) {
+    shm_sink_record_t * padding_record =
+      (shm_sink_record_t *)(sink->ring + (size_t)(head & (capacity - 1u)));
+    padding_record->flags = SHM_SINK_RECORD_PADDING;
+    __atomic_store_n(&padding_record->size, (uint32_t)padding, __ATOMIC_RELEASE);
+  }
+  shm_sink_record_t * record =
+    (shm_sink_record_t *)(sink->ring + (size_t)((head + padding) & (capacity - 1u)));
+  record->flags = NULL != location ? SHM_SINK_RECORD_LOCATION : 0u;
+  record->timestamp = (int64_t)timestamp;
+  record->severity = (int32_t)severity;
+  record->line_number = NULL != location && (uint64_t)location->line_number <= UINT32_MAX ?
+    (uint32_t)location->line_number : 0u;
+  record->name_length = name_length;
+  record->message_length = message_length;
+  record->file_name_length = file_name_length;
+  record->function_name_length = function_name_length;
+  unsigned char * strings = (unsigned char *)(record + 1);
+  strings = copy_string(strings, name, name_length);
+  strings = copy_string(strings, message, message_length);
+  strings = copy_string(strings, NULL != location ? location->file_name : NULL, file_name_length);
+  (void)copy_string(
+    strings, NULL != location ? location->function_name : NULL, function_name_length);
+  __atomic_store_n(&record->size, (uint32_t)size, __ATOMIC_RELEASE);
+}
+
+rcutils_ret_t rcutils_logging_shm_reader_open(
+  rcutils_logging_shm_reader_t ** reader,
+  const char * name,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(reader, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(name, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) {
+    set_error_from_errno("open the shared memory", name);
+    return RCUTILS_RET_ERROR;
+  }
+  struct stat file_stat;
+  if (0 != fstat(fd, &file_stat)) {
+    set_error_from_errno("get the size of the shared memory", name);
+    (void)close(fd);
+    return RCUTILS_RET_ERROR;
+  }
+  const size_t mapped_size = (size_t)file_stat.st_size;
+  if (mapped_size < sizeof(shm_sink_header_t) + SHM_SINK_MIN_CAPACITY ||
+    mapped_size > sizeof(shm_sink_header_t) + SHM_SINK_MAX_CAPACITY)
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "the shared memory '%s' isn't the ring of a sink", name);
+    (void)close(fd);
+    return RCUTILS_RET_ERROR;
+  }
+  void * memory = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (MAP_FAILED == memory) {
+    set_error_from_errno("map the shared memory", name);
+    return RCUTILS_RET_ERROR;
+  }
+  shm_sink_header_t * header = (shm_sink_header_t *)memory;
+  if (SHM_SINK_MAGIC != __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) ||
+    SHM_SINK_VERSION != header->version ||
+    sizeof(shm_sink_header_t) + header->capacity != (uint64_t)mapped_size ||
+    0u != (header->capacity & (header->capacity - 1u)))
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "the shared memory '%s' isn't the ring of a sink", name);
+    (void)munmap(memory, mapped_size);
+    return RCUTILS_RET_ERROR;
+  }
+
+  rcutils_logging_shm_reader_t * new_reader =
+    allocator.zero_allocate(1, sizeof(rcutils_logging_shm_reader_t), allocator.state);
+  if (NULL == new_reader) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate the shared memory reader");
+    (void)munmap(memory, mapped_size);
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  new_reader->allocator = allocator;
+  new_reader->header = header;
+  new_reader->ring = (unsigned char *)memory + sizeof(shm_sink_header_t);
+  new_reader->capacity = (size_t)header->capacity;
+  new_reader->mapped_size = mapped_size;
+  new_reader->tail = __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE);
+  *reader = new_reader;
+  return RCUTILS_RET_OK;
+}
+
+// Check that a record, whose size was checked to be in the ring, holds its strings.
+static bool is_record_valid(const shm_sink_record_t * record, size_t size)
+{
+  if (size < sizeof(shm_sink_record_t)) {
+    return false;
+  }
+  const size_t lengths = (size_t)record->name_length + record->message_length +
+    record->file_name_length + record->function_name_length + 4u;
+  if (lengths > size - sizeof(shm_sink_record_t)) {
+    return false;
+  }
+  const char * strings = (const char *)(record + 1);
+  const size_t terminators[] = {
+    record->name_length,
+    record->name_length + record->message_length + 1u,
+    record->name_length + record->message_length + record->file_name_length + 2u,
+    lengths - 1u,
+  };
+  for (size_t i = 0u; i < sizeof(terminators) / sizeof(terminators[0]); ++i) {
+    if ('\0' != strings[terminators[i]]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+rcutils_ret_t rcutils_logging_shm_reader_take(
+  rcutils_logging_shm_reader_t * reader,
+  rcutils_logging_shm_record_callback_t callback,
+  void * context,
+  size_t max_count,
+  size_t * count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(reader, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(callback, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RCUTILS_RET_INVALID_ARGUMENT);
+  *count = 0u;
+  if (reader->corrupted) {
+    RCUTILS_SET_ERROR_MSG("the shared memory ring is corrupted");
+    return RCUTILS_RET_ERROR;
+  }
+  while (*count < max_count) {
+    const size_t offset = (size_t)(reader->tail & (reader->capacity - 1u));
+    shm_sink_record_t * record = (shm_sink_record_t *)(reader->ring + offset);
+    const size_t size = __atomic_load_n(&record->size, __ATOMIC_ACQUIRE);
+    if (0u == size) {
+      break;
+    }
+    // The ring is written by another process, so nothing in it is trusted.
+    if (0u != (size & 7u) || size > reader->capacity - offset ||
+      (0u == (record->flags & SHM_SINK_RECORD_PADDING) && !is_record_valid(record, size)))
+    {
+      reader->corrupted = true;
+      RCUTILS_SET_ERROR_MSG("the shared memory ring is corrupted");
+      return RCUTILS_RET_ERROR;
+    }
+    if (0u == (record->flags & SHM_SINK_RECORD_PADDING)) {
+      const char * strings = (const char *)(record + 1);
+      const bool has_location = 0u != (record->flags & SHM_SINK_RECORD_LOCATION);
+      rcutils_logging_shm_record_t taken = {
+        .timestamp = (rcutils_time_point_value_t)record->timestamp,
+        .severity = (int)record->severity,
+        .name = strings,
+        .message = strings + record->name_length + 1u,
+        .file_name = NULL,
+        .function_name = NULL,
+        .line_number = (size_t)record->line_number,
+      };
+      if (has_location) {
+        taken.file_name = taken.message + record->message_length + 1u;
+        taken.function_name = taken.file_name + record->file_name_length + 1u;
+      }
+      callback(&taken, context);
+      ++*count;
+    }
+    // The writers reserve room expecting it zeroed, including the size of the next records.
+    memset(record, 0, size);
+    reader->tail += size;
+    __atomic_store_n(&reader->header->tail, reader->tail, __ATOMIC_RELEASE);
+  }
+  return RCUTILS_RET_OK;
+}
+
+bool rcutils_logging_shm_reader_is_closed(const rcutils_logging_shm_reader_t * reader)
+{
+  if (NULL == reader) {
+    return true;
+  }
+  if (0u == __atomic_load_n(&reader->header->closed, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+  // All the records were reserved before the sink was closed.
+  return __atomic_load_n(&reader->header->head, __ATOMIC_ACQUIRE) == reader->tail;
+}
+
+int64_t rcutils_logging_shm_reader_get_pid(const rcutils_logging_shm_reader_t * reader)
+{
+  return NULL != reader ? reader->header->pid : 0;
+}
+
+size_t rcutils_logging_shm_reader_get_dropped_count(const rcutils_logging_shm_reader_t * reader)
+{
+  if (NULL == reader) {
+    return 0u;
+  }
+  return (size_t)__atomic_load_n(&reader->header->dropped_count, __ATOMIC_RELAXED);
+}
+
+rcutils_ret_t rcutils_logging_shm_reader_close(rcutils_logging_shm_reader_t * reader)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(reader, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_allocator_t allocator = reader->allocator;
+  (void)munmap(reader->header, reader->mapped_size);
+  allocator.deallocate(reader, allocator.state);
+  return RCUTILS_RET_OK;
+}
+
+#endif  // _WIN32
+
+#ifdef __cplusplus
+}
+#endif
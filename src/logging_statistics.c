@@ -0,0 +1,207 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#ifdef _WIN32
+// See logging.c for why warning C5105 is disabled.
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#endif
+
+#include "./logging_statistics.h"
+
+#include "rcutils/macros.h"
+
+// More slots than this only help threads which log at the same time, which are rarely that many.
+#define RCUTILS_LOGGING_STATISTICS_SLOTS (32u)
+
+typedef struct logging_statistics_slot_s
+{
+  uint64_t messages[RCUTILS_LOGGING_STATISTICS_SEVERITIES];
+  uint64_t filtered_messages;
+  uint64_t suppressed_messages;
+  uint64_t bytes_written;
+  uint64_t large_message_allocations;
+  uint64_t output_handler_duration_histogram[RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS];
+  // Pads the slot to a multiple of 64 bytes, the cache line size of common CPUs.
+  uint64_t padding[6];
+} logging_statistics_slot_t;
+
+static logging_statistics_slot_t g_rcutils_logging_statistics_slots[
+  RCUTILS_LOGGING_STATISTICS_SLOTS];
+
+#ifdef RCUTILS_THREAD_LOCAL
+// The index of the slot of the calling thread plus one, or zero until it is assigned.
+static RCUTILS_THREAD_LOCAL uint32_t gtls_rcutils_logging_statistics_slot = 0u;
+// Counts the threads which were assigned a slot, to assign them round robin.
+static uint32_t g_rcutils_logging_statistics_threads = 0u;
+#endif
+
+static void add_uint64(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchangeAdd64((volatile LONG64 *)counter, (LONG64)value);
+#else
+  __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static uint64_t load_uint64(uint64_t * counter)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)counter, 0, 0);
+#else
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#endif
+}
+
+static void store_uint64(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)counter, (LONG64)value);
+#else
+  __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static logging_statistics_slot_t * get_slot(void)
+{
+#ifdef RCUTILS_THREAD_LOCAL
+  if (RCUTILS_UNLIKELY(0u == gtls_rcutils_logging_statistics_slot)) {
+#ifdef _WIN32
+    const uint32_t thread =
+      (uint32_t)InterlockedIncrement((volatile LONG *)&g_rcutils_logging_statistics_threads);
+#else
+    const uint32_t thread =
+      __atomic_add_fetch(&g_rcutils_logging_statistics_threads, 1u, __ATOMIC_RELAXED);
+#endif
+    gtls_rcutils_logging_statistics_slot = thread % RCUTILS_LOGGING_STATISTICS_SLOTS + 1u;
+  }
+  return &g_rcutils_logging_statistics_slots[gtls_rcutils_logging_statistics_slot - 1u];
+#else
+  // Without thread local storage all threads share the first slot, which is still correct.
+  return &g_rcutils_logging_statistics_slots[0];
+#endif
+}
+
+static size_t get_severity_index(int severity)
+{
+  if (severity <= 0) {
+    return 0u;
+  }
+  if (severity >= RCUTILS_LOG_SEVERITY_FATAL) {
+    return RCUTILS_LOGGING_STATISTICS_SEVERITIES - 1u;
+  }
+  return (size_t)(severity / 10);
+}
+
+static size_t get_histogram_bucket(rcutils_duration_value_t duration)
+{
+  size_t bucket = 0u;
+  while (duration > 1 && bucket < RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS - 1u) {
+    duration >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void
+rcutils_logging_statistics_add_message(int severity, rcutils_duration_value_t handler_duration)
+{
+  logging_statistics_slot_t * slot = get_slot();
+  add_uint64(&slot->messages[get_severity_index(severity)], 1u);
+  add_uint64(&slot->output_handler_duration_histogram[get_histogram_bucket(handler_duration)], 1u);
+}
+
+void
+rcutils_logging_statistics_add_filtered(void)
+{
+  add_uint64(&get_slot()->filtered_messages, 1u);
+}
+
+void
+rcutils_logging_statistics_add_suppressed(void)
+{
+  add_uint64(&get_slot()->suppressed_messages, 1u);
+}
+
+void
+rcutils_logging_statistics_add_output(size_t bytes, bool allocated)
+{
+  logging_statistics_slot_t * slot = get_slot();
+  add_uint64(&slot->bytes_written, (uint64_t)bytes);
+  if (allocated) {
+    add_uint64(&slot->large_message_allocations, 1u);
+  }
+}
+
+void
+rcutils_logging_statistics_sum(rcutils_logging_statistics_t * statistics)
+{
+  for (size_t i = 0u; i < RCUTILS_LOGGING_STATISTICS_SEVERITIES; ++i) {
+    statistics->messages[i] = 0u;
+  }
+  statistics->filtered_messages = 0u;
+  statistics->suppressed_messages = 0u;
+  statistics->bytes_written = 0u;
+  statistics->large_message_allocations = 0u;
+  for (size_t i = 0u; i < RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS; ++i) {
+    statistics->output_handler_duration_histogram[i] = 0u;
+  }
+
+  for (size_t s = 0u; s < RCUTILS_LOGGING_STATISTICS_SLOTS; ++s) {
+    logging_statistics_slot_t * slot = &g_rcutils_logging_statistics_slots[s];
+    for (size_t i = 0u; i < RCUTILS_LOGGING_STATISTICS_SEVERITIES; ++i) {
+      statistics->messages[i] += load_uint64(&slot->messages[i]);
+    }
+    statistics->filtered_messages += load_uint64(&slot->filtered_messages);
+    statistics->suppressed_messages += load_uint64(&slot->suppressed_messages);
+    statistics->bytes_written += load_uint64(&slot->bytes_written);
+    statistics->large_message_allocations += load_uint64(&slot->large_message_allocations);
+    for (size_t i = 0u; i < RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS; ++i) {
+      statistics->output_handler_duration_histogram[i] +=
+        load_uint64(&slot->output_handler_duration_histogram[i]);
+    }
+  }
+}
+
+void
+rcutils_logging_statistics_reset(void)
+{
+  for (size_t s = 0u; s < RCUTILS_LOGGING_STATISTICS_SLOTS; ++s) {
+    logging_statistics_slot_t * slot = &g_rcutils_logging_statistics_slots[s];
+    for (size_t i = 0u; i < RCUTILS_LOGGING_STATISTICS_SEVERITIES; ++i) {
+      store_uint64(&slot->messages[i], 0u);
+    }
+    store_uint64(&slot->filtered_messages, 0u);
+    store_uint64(&slot->suppressed_messages, 0u);
+    store_uint64(&slot->bytes_written, 0u);
+    store_uint64(&slot->large_message_allocations, 0u);
+    for (size_t i = 0u; i < RCUTILS_LOGGING_STATISTICS_HISTOGRAM_BUCKETS; ++i) {
+      store_uint64(&slot->output_handler_duration_histogram[i], 0u);
+    }
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal storage of the logging statistics: the counters are striped across
+// cache line sized slots, and each thread always adds to the same slot, so
+// that concurrently logging threads rarely share a cache line.
+
+#ifndef LOGGING_STATISTICS_H_
+#define LOGGING_STATISTICS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+#include "rcutils/visibility_control_macros.h"
+
+/// Count a message passed to the output handler, and the time spent in the handler.
+RCUTILS_LOCAL
+void
+rcutils_logging_statistics_add_message(int severity, rcutils_duration_value_t handler_duration);
+
+/// Count a message filtered out by its severity.
+RCUTILS_LOCAL
+void
+rcutils_logging_statistics_add_filtered(void);
+
+/// Count a message suppressed because it repeats the last one of its callsite.
+RCUTILS_LOCAL
+void
+rcutils_logging_statistics_add_suppressed(void);
+
+/// Count bytes written by the console output handler, and whether formatting them allocated.
+RCUTILS_LOCAL
+void
+rcutils_logging_statistics_add_output(size_t bytes, bool allocated);
+
+/// Sum up the counters of all slots, leaving the fields not counted here untouched.
+RCUTILS_LOCAL
+void
+rcutils_logging_statistics_sum(rcutils_logging_statistics_t * statistics);
+
+/// Reset the counters of all slots to zero.
+RCUTILS_LOCAL
+void
+rcutils_logging_statistics_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOGGING_STATISTICS_H_
@@ -0,0 +1,50 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal tracepoints of the logging hot path, as USDT probes of the "rcutils" provider.
+// They are only compiled in when the library is built with RCUTILS_ENABLE_TRACEPOINTS, and
+// otherwise expand to nothing, without evaluating their arguments.
+// When compiled in, each probe is a single nop along with a note in the binary, which
+// perf (`perf probe sdt_rcutils:log_enabled`), bpftrace, SystemTap and LTTng (as userspace
+// probes) attach to at run time, so no tracing library is linked nor needs to be running.
+//
+// The probes and their arguments are:
+//   log_enabled(name, severity, enabled): the result of the enabled check of rcutils_log()
+//   format_begin(name, severity): the console output starts formatting a message
+//   format_end(name, length, status): it is formatted, into length bytes
+//   sink_write_begin(severity, length): the formatted message is written or queued
+//   sink_write_end(severity, status): it is written or queued
+//   sink_call(index, severity): the sink of that index is handed the message
+//   async_enqueue(length, depth): a record is queued, which leaves depth records queued
+//   async_dequeue(length, depth): a record is taken out, which leaves depth records queued
+//   async_drop(policy): a record is dropped, as the queue is full
+
+#ifndef LOGGING_TRACEPOINTS_H_
+#define LOGGING_TRACEPOINTS_H_
+
+#if defined(RCUTILS_ENABLE_TRACEPOINTS) && RCUTILS_ENABLE_TRACEPOINTS
+# include <sys/sdt.h>
+# define RCUTILS_LOGGING_TRACEPOINT1(name, arg1) \
+  DTRACE_PROBE1(rcutils, name, arg1)
+# define RCUTILS_LOGGING_TRACEPOINT2(name, arg1, arg2) \
+  DTRACE_PROBE2(rcutils, name, arg1, arg2)
+# define RCUTILS_LOGGING_TRACEPOINT3(name, arg1, arg2, arg3) \
+  DTRACE_PROBE3(rcutils, name, arg1, arg2, arg3)
+#else
+# define RCUTILS_LOGGING_TRACEPOINT1(name, arg1) ((void)0)
+# define RCUTILS_LOGGING_TRACEPOINT2(name, arg1, arg2) ((void)0)
+# define RCUTILS_LOGGING_TRACEPOINT3(name, arg1, arg2, arg3) ((void)0)
+#endif
+
+#endif  // LOGGING_TRACEPOINTS_H_
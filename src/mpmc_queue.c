@@ -0,0 +1,353 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/types/mpmc_queue.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/macros.h"
+
+// The indices advanced by the producers and by the consumers are at least this far apart, so
+// that they never share a cache line, whatever the alignment of the queue.
+#define MPMC_QUEUE_CACHE_LINE_SIZE 64
+
+// Each slot is its sequence number followed by the element, padded so that the sequence
+// numbers of all slots are aligned.
+typedef struct mpmc_queue_slot_s
+{
+  // Equal to the position of the slot when it is free for the producer of that position, and
+  // to the position plus one when it holds the element for the consumer of that position.
+  atomic_size_t sequence;
+} mpmc_queue_slot_t;
+
+typedef struct rcutils_mpmc_queue_impl_s
+{
+  uint8_t * slots;
+  size_t mask;
+  size_t element_size;
+  size_t slot_stride;
+  rcutils_allocator_t allocator;
+  char shared_padding[MPMC_QUEUE_CACHE_LINE_SIZE];
+  // The position of the next element to pop, advanced by the consumers.
+  atomic_size_t head;
+  char head_padding[MPMC_QUEUE_CACHE_LINE_SIZE];
+  // The position of the next element to push, advanced by the producers.
+  atomic_size_t tail;
+  char tail_padding[MPMC_QUEUE_CACHE_LINE_SIZE];
+} rcutils_mpmc_queue_impl_t;
+
+#define MPMC_QUEUE_VALIDATE_QUEUE(queue) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(queue, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == queue->impl) { \
+    RCUTILS_SET_ERROR_MSG("queue is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+static size_t load_index(atomic_size_t * index, memory_order order)
+{
+  size_t result = 0;
+  rcutils_atomic_load_explicit(index, result, order);
+  return result;
+}
+
+// The positions only hand out slots, so they are relaxed, while the sequence numbers order the
+// accesses to the elements, with acquire loads and release stores.
+static bool compare_exchange_position(atomic_size_t * position, size_t * expected, size_t desired)
+{
+  bool result;
+  rcutils_atomic_compare_exchange_strong_explicit(
+    position, result, expected, desired, memory_order_relaxed, memory_order_relaxed);
+  return result;
+}
+
+static mpmc_queue_slot_t * mpmc_queue_get_slot(
+  const rcutils_mpmc_queue_impl_t * impl, size_t position)
+{
+  return (mpmc_queue_slot_t *)(impl->slots + (position & impl->mask) * impl->slot_stride);
+}
+
+static uint8_t * mpmc_queue_get_element(mpmc_queue_slot_t * slot)
+{
+  return (uint8_t *)slot + sizeof(mpmc_queue_slot_t);
+}
+
+// Claims up to count consecutive slots whose sequence number is the position of the slot plus
+// ready_offset, from the given index, and returns the first position claimed and their number.
+static size_t mpmc_queue_claim(
+  const rcutils_mpmc_queue_impl_t * impl,
+  atomic_size_t * index,
+  size_t ready_offset,
+  size_t count,
+  size_t * position)
+{
+  *position = load_index(index, memory_order_relaxed);
+  while (true) {
+    size_t claimable = 0u;
+    intptr_t difference = 0;
+    while (claimable < count) {
+      mpmc_queue_slot_t * slot = mpmc_queue_get_slot(impl, *position + claimable);
+      size_t sequence = load_index(&slot->sequence, memory_order_acquire);
+      difference = (intptr_t)sequence - (intptr_t)(*position + claimable + ready_offset);
+      if (0 != difference) {
+        break;
+      }
+      ++claimable;
+    }
+    if (0u == claimable) {
+      if (difference < 0) {
+        // The first slot isn't ready for this lap yet: the queue is full, or empty.
+        return 0u;
+      }
+      // Another thread claimed the slot already.
+      *position = load_index(index, memory_order_relaxed);
+    } else if (compare_exchange_position(index, position, *position + claimable)) {
+      return claimable;
+    }
+    // Otherwise, position was updated by the failed exchange; try again.
+  }
+}
+
+static size_t mpmc_queue_push(
+  rcutils_mpmc_queue_impl_t * impl, const void * elements, size_t count)
+{
+  size_t position;
+  count = mpmc_queue_claim(impl, &impl->tail, 0u, count, &position);
+  for (size_t i = 0u; i < count; ++i) {
+    mpmc_queue_slot_t * slot = mpmc_queue_get_slot(impl, position + i);
+    memcpy(
+      mpmc_queue_get_element(slot), (const uint8_t *)elements + i * impl->element_size,
+      impl->element_size);
+    // Publish the element to the consumer of this position.
+    rcutils_atomic_store_explicit(&slot->sequence, position + i + 1u, memory_order_release);
+  }
+  return count;
+}
+
+static size_t mpmc_queue_pop(rcutils_mpmc_queue_impl_t * impl, void * elements, size_t count)
+{
+  size_t position;
+  count = mpmc_queue_claim(impl, &impl->head, 1u, count, &position);
+  for (size_t i = 0u; i < count; ++i) {
+    mpmc_queue_slot_t * slot = mpmc_queue_get_slot(impl, position + i);
+    memcpy(
+      (uint8_t *)elements + i * impl->element_size, mpmc_queue_get_element(slot),
+      impl->element_size);
+    // Release the slot to the producer of the next lap.
+    rcutils_atomic_store_explicit(
+      &slot->sequence, position + i + impl->mask + 1u, memory_order_release);
+  }
+  return count;
+}
+
+rcutils_mpmc_queue_t
+rcutils_get_zero_initialized_mpmc_queue(void)
+{
+  static rcutils_mpmc_queue_t zero_initialized_queue = {NULL};
+  return zero_initialized_queue;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_init(
+  rcutils_mpmc_queue_t * queue,
+  size_t capacity,
+  size_t element_size,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(queue, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u == capacity) {
+    RCUTILS_SET_ERROR_MSG("capacity cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == element_size) {
+    RCUTILS_SET_ERROR_MSG("element_size cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  // A single slot would be free and full at once, as its sequence numbers would collide.
+  size_t rounded_capacity = 2u;
+  while (rounded_capacity < capacity) {
+    if (rounded_capacity > SIZE_MAX / 2u) {
+      RCUTILS_SET_ERROR_MSG("capacity is too large");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    rounded_capacity <<= 1u;
+  }
+  const size_t alignment = sizeof(mpmc_queue_slot_t);
+  if (element_size > SIZE_MAX - 2u * alignment) {
+    RCUTILS_SET_ERROR_MSG("element_size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t slot_stride =
+    (sizeof(mpmc_queue_slot_t) + element_size + alignment - 1u) / alignment * alignment;
+  if (rounded_capacity > SIZE_MAX / slot_stride) {
+    RCUTILS_SET_ERROR_MSG("capacity times element_size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_mpmc_queue_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_mpmc_queue_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for queue impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->slots = allocator->allocate(rounded_capacity * slot_stride, allocator->state);
+  if (NULL == impl->slots) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for queue slots");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->mask = rounded_capacity - 1u;
+  impl->element_size = element_size;
+  impl->slot_stride = slot_stride;
+  impl->allocator = *allocator;
+  for (size_t i = 0u; i < rounded_capacity; ++i) {
+    atomic_init(&mpmc_queue_get_slot(impl, i)->sequence, i);
+  }
+  atomic_init(&impl->head, (size_t)0);
+  atomic_init(&impl->tail, (size_t)0);
+  queue->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_fini(rcutils_mpmc_queue_t * queue)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(queue, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_mpmc_queue_impl_t * impl = queue->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl->slots, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  queue->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_push(rcutils_mpmc_queue_t * queue, const void * element)
+{
+  MPMC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(element, RCUTILS_RET_INVALID_ARGUMENT);
+  if (1u != mpmc_queue_push(queue->impl, element, 1u)) {
+    return RCUTILS_RET_NOT_ENOUGH_SPACE;
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_push_many(
+  rcutils_mpmc_queue_t * queue,
+  const void * elements,
+  size_t count,
+  size_t * pushed)
+{
+  MPMC_QUEUE_VALIDATE_QUEUE(queue);
+  if (0u != count) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(elements, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pushed, RCUTILS_RET_INVALID_ARGUMENT);
+  // Claim as many slots as are free at once, then the remaining ones if others were freed
+  // meanwhile, until the queue is full.
+  size_t total = 0u;
+  while (total < count) {
+    size_t claimed = mpmc_queue_push(
+      queue->impl, (const uint8_t *)elements + total * queue->impl->element_size, count - total);
+    if (0u == claimed) {
+      break;
+    }
+    total += claimed;
+  }
+  *pushed = total;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_pop(rcutils_mpmc_queue_t * queue, void * element)
+{
+  MPMC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(element, RCUTILS_RET_INVALID_ARGUMENT);
+  if (1u != mpmc_queue_pop(queue->impl, element, 1u)) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_pop_many(
+  rcutils_mpmc_queue_t * queue,
+  void * elements,
+  size_t max_count,
+  size_t * popped)
+{
+  MPMC_QUEUE_VALIDATE_QUEUE(queue);
+  if (0u != max_count) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(elements, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(popped, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t total = 0u;
+  while (total < max_count) {
+    size_t claimed = mpmc_queue_pop(
+      queue->impl, (uint8_t *)elements + total * queue->impl->element_size, max_count - total);
+    if (0u == claimed) {
+      break;
+    }
+    total += claimed;
+  }
+  *popped = total;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_get_capacity(const rcutils_mpmc_queue_t * queue, size_t * capacity)
+{
+  MPMC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(capacity, RCUTILS_RET_INVALID_ARGUMENT);
+  *capacity = queue->impl->mask + 1u;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mpmc_queue_get_size(const rcutils_mpmc_queue_t * queue, size_t * size)
+{
+  MPMC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(size, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_mpmc_queue_impl_t * impl = queue->impl;
+  // The positions are advanced independently, so the tail read may be behind the head read.
+  const size_t head = load_index(&impl->head, memory_order_relaxed);
+  const intptr_t difference = (intptr_t)(load_index(&impl->tail, memory_order_relaxed) - head);
+  const size_t capacity = impl->mask + 1u;
+  if (difference < 0) {
+    *size = 0u;
+  } else {
+    *size = (size_t)difference < capacity ? (size_t)difference : capacity;
+  }
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,6 +18,8 @@ extern "C"
 #endif
 
 #include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -44,6 +46,8 @@ extern "C"
 #include "rcutils/process.h"
 #include "rcutils/strdup.h"
 
+#include "./threads.h"
+
 int rcutils_get_pid(void)
 {
 #if defined _WIN32 || defined __CYGWIN__
@@ -111,6 +115,186 @@ char * rcutils_get_executable_name(rcutils_allocator_t allocator)
   return executable_name;
 }
 
+rcutils_cpu_set_t
+rcutils_get_zero_initialized_cpu_set(void)
+{
+  static rcutils_cpu_set_t zero_initialized_cpu_set = {{0u}};
+  return zero_initialized_cpu_set;
+}
+
+rcutils_ret_t
+rcutils_cpu_set_add(rcutils_cpu_set_t * cpu_set, size_t cpu)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(cpu_set, RCUTILS_RET_INVALID_ARGUMENT);
+  if (cpu >= RCUTILS_CPU_SET_SIZE) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "cpu %zu is not less than %d", cpu, RCUTILS_CPU_SET_SIZE);
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  cpu_set->bits[cpu / 64u] |= (uint64_t)1u << (cpu % 64u);
+  return RCUTILS_RET_OK;
+}
+
+bool
+rcutils_cpu_set_contains(const rcutils_cpu_set_t * cpu_set, size_t cpu)
+{
+  if (NULL == cpu_set || cpu >= RCUTILS_CPU_SET_SIZE) {
+    return false;
+  }
+  return 0u != (cpu_set->bits[cpu / 64u] & ((uint64_t)1u << (cpu % 64u)));
+}
+
+size_t
+rcutils_cpu_set_count(const rcutils_cpu_set_t * cpu_set)
+{
+  if (NULL == cpu_set) {
+    return 0u;
+  }
+  size_t count = 0u;
+  for (size_t i = 0u; i < RCUTILS_CPU_SET_SIZE / 64u; ++i) {
+    for (uint64_t bits = cpu_set->bits[i]; 0u != bits; bits &= bits - 1u) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+rcutils_thread_attributes_t
+rcutils_get_default_thread_attributes(void)
+{
+  rcutils_thread_attributes_t attributes;
+  attributes.cpu_set = rcutils_get_zero_initialized_cpu_set();
+  attributes.scheduling_policy = RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT;
+  attributes.priority = 0;
+  return attributes;
+}
+
+// The longest executable name kept by the process identity, as file names are at most 255
+// characters on common file systems.
+#define PROCESS_IDENTITY_MAX_EXECUTABLE_NAME 255
+
+enum process_identity_state
+{
+  PROCESS_IDENTITY_UNINITIALIZED = 0,
+  PROCESS_IDENTITY_INITIALIZING = 1,
+  PROCESS_IDENTITY_INITIALIZED = 2,
+};
+
+static uint32_t g_process_identity_state = PROCESS_IDENTITY_UNINITIALIZED;
+static char g_process_identity_executable_name[PROCESS_IDENTITY_MAX_EXECUTABLE_NAME + 1];
+static rcutils_process_identity_t g_process_identity = {0, g_process_identity_executable_name};
+
+static uint32_t process_identity_load_state(void)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange((LONG volatile *)&g_process_identity_state, 0, 0);
+#else
+  return __atomic_load_n(&g_process_identity_state, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static bool process_identity_compare_exchange_state(uint32_t expected, uint32_t desired)
+{
+#ifdef _WIN32
+  return (LONG)expected == InterlockedCompareExchange(
+    (LONG volatile *)&g_process_identity_state, (LONG)desired, (LONG)expected);
+#else
+  return __atomic_compare_exchange_n(
+    &g_process_identity_state, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void process_identity_store_state(uint32_t state)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((LONG volatile *)&g_process_identity_state, (LONG)state);
+#else
+  __atomic_store_n(&g_process_identity_state, state, __ATOMIC_RELEASE);
+#endif
+}
+
+// Writes the executable name, without its directories, like rcutils_get_executable_name().
+static void process_identity_derive_executable_name(char * name, size_t size)
+{
+  name[0] = '\0';
+#if defined __APPLE__ || defined __FreeBSD__ || (defined __ANDROID__ && __ANDROID_API__ >= 21)
+  const char * appname = getprogname();
+#elif defined __GNUC__ && !defined(__QNXNTO__) && !defined(__OHOS__)
+  const char * appname = program_invocation_name;
+#elif defined _WIN32 || defined __CYGWIN__
+  char appname[MAX_PATH];
+  if (0 == GetModuleFileNameA(NULL, appname, MAX_PATH)) {
+    return;
+  }
+#elif defined __QNXNTO__ || defined __OHOS__
+  extern char * __progname;
+  const char * appname = __progname;
+#else
+#error "Unsupported OS"
+#endif
+  if (NULL == appname) {
+    return;
+  }
+
+#if defined __APPLE__ || defined __FreeBSD__ || defined __GNUC__
+  // Like basename(), which may modify its argument, without the trailing slashes.
+  size_t end = strlen(appname);
+  while (end > 1 && '/' == appname[end - 1]) {
+    --end;
+  }
+  size_t start = end;
+  while (start > 0 && '/' != appname[start - 1]) {
+    --start;
+  }
+  size_t length = end - start;
+  if (length >= size) {
+    length = size - 1;
+  }
+  memcpy(name, appname + start, length);
+  name[length] = '\0';
+#elif defined _WIN32 || defined __CYGWIN__
+  if (0 != _splitpath_s(appname, NULL, 0, NULL, 0, name, size, NULL, 0)) {
+    name[0] = '\0';
+  }
+#else
+#error "Unsupported OS"
+#endif
+}
+
+#if !defined _WIN32
+// The child of a fork has a new process ID, and only the thread which forked.
+static void process_identity_after_fork_in_child(void)
+{
+  g_process_identity.pid = rcutils_get_pid();
+}
+#endif
+
+const rcutils_process_identity_t * rcutils_get_process_identity(void)
+{
+  if (PROCESS_IDENTITY_INITIALIZED == process_identity_load_state()) {
+    return &g_process_identity;
+  }
+  // Only one thread derives the identity, while the others which query it at the same time
+  // wait for it.
+  while (!process_identity_compare_exchange_state(
+      PROCESS_IDENTITY_UNINITIALIZED, PROCESS_IDENTITY_INITIALIZING))
+  {
+    if (PROCESS_IDENTITY_INITIALIZED == process_identity_load_state()) {
+      return &g_process_identity;
+    }
+    rcutils_thread_yield();
+  }
+  process_identity_derive_executable_name(
+    g_process_identity_executable_name, sizeof(g_process_identity_executable_name));
+  g_process_identity.pid = rcutils_get_pid();
+#if !defined _WIN32
+  // If the handler can't be registered, the process ID is only wrong in forked children.
+  (void)pthread_atfork(NULL, NULL, process_identity_after_fork_in_child);
+#endif
+  process_identity_store_state(PROCESS_IDENTITY_INITIALIZED);
+  return &g_process_identity;
+}
+
 #ifdef __cplusplus
 }
 #endif
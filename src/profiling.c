@@ -0,0 +1,309 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+// See logging.c for why warning C5105 is disabled.
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+# include <intrin.h>
+#endif
+
+#include "rcutils/profiling.h"
+
+#include "rcutils/error_handling.h"
+#include "rcutils/time.h"
+
+static void add_uint64(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchangeAdd64((volatile LONG64 *)counter, (LONG64)value);
+#else
+  __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static uint64_t load_uint64(const uint64_t * counter)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)counter, 0, 0);
+#else
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#endif
+}
+
+static void store_uint64(uint64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)counter, (LONG64)value);
+#else
+  __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+// Raises a counter to a value, unless it is already larger.
+static void max_uint64(uint64_t * counter, uint64_t value)
+{
+  uint64_t current = load_uint64(counter);
+  while (current < value) {
+#ifdef _WIN32
+    const uint64_t previous = (uint64_t)InterlockedCompareExchange64(
+      (volatile LONG64 *)counter, (LONG64)value, (LONG64)current);
+    if (previous == current) {
+      return;
+    }
+    current = previous;
+#else
+    if (__atomic_compare_exchange_n(
+        counter, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+      return;
+    }
+#endif
+  }
+}
+
+// Returns the index of the most significant bit set in a value, which must not be zero.
+static unsigned int most_significant_bit(uint64_t value)
+{
+#ifdef _WIN32
+  unsigned long index;
+  (void)_BitScanReverse64(&index, value);
+  return (unsigned int)index;
+#else
+  return 63u - (unsigned int)__builtin_clzll(value);
+#endif
+}
+
+static size_t get_bucket(uint64_t duration)
+{
+  if (duration < RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS) {
+    return (size_t)duration;
+  }
+  // The sub-bucket is given by the bits after the most significant one, and the power of two
+  // by how far they are shifted, e.g. durations from 16 to 31 have buckets 16 to 31, and
+  // durations from 32 to 63 have buckets 32 to 47, two durations each.
+  const unsigned int shift =
+    most_significant_bit(duration) - RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+  return (size_t)shift * RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS + (size_t)(duration >> shift);
+}
+
+static uint64_t get_bucket_upper_bound(size_t bucket)
+{
+  if (bucket < RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS) {
+    return (uint64_t)bucket;
+  }
+  const unsigned int shift = (unsigned int)(bucket / RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS) - 1u;
+  const uint64_t sub_bucket = RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS +
+    (uint64_t)(bucket % RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS);
+  return (sub_bucket << shift) + ((UINT64_C(1) << shift) - 1u);
+}
+
+void
+rcutils_latency_histogram_record(
+  rcutils_latency_histogram_t * histogram, rcutils_duration_value_t duration)
+{
+  if (NULL == histogram) {
+    return;
+  }
+  const uint64_t value = duration > 0 ? (uint64_t)duration : 0u;
+  add_uint64(&histogram->counts[get_bucket(value)], 1u);
+  add_uint64(&histogram->total_count, 1u);
+  add_uint64(&histogram->total_duration, value);
+  max_uint64(&histogram->min_duration_complement, ~value);
+  max_uint64(&histogram->max_duration, value);
+}
+
+rcutils_ret_t
+rcutils_latency_histogram_snapshot(
+  const rcutils_latency_histogram_t * histogram, rcutils_latency_histogram_t * snapshot)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(histogram, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(snapshot, RCUTILS_RET_INVALID_ARGUMENT);
+  for (size_t i = 0u; i < RCUTILS_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    snapshot->counts[i] = load_uint64(&histogram->counts[i]);
+  }
+  snapshot->total_count = load_uint64(&histogram->total_count);
+  snapshot->total_duration = load_uint64(&histogram->total_duration);
+  snapshot->min_duration_complement = load_uint64(&histogram->min_duration_complement);
+  snapshot->max_duration = load_uint64(&histogram->max_duration);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_latency_histogram_merge(
+  rcutils_latency_histogram_t * histogram, const rcutils_latency_histogram_t * other)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(histogram, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(other, RCUTILS_RET_INVALID_ARGUMENT);
+  if (histogram == other) {
+    RCUTILS_SET_ERROR_MSG("cannot merge a histogram into itself");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0u; i < RCUTILS_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    const uint64_t count = load_uint64(&other->counts[i]);
+    // Most buckets of a histogram are empty, and skipping them spares contended writes.
+    if (0u != count) {
+      add_uint64(&histogram->counts[i], count);
+    }
+  }
+  add_uint64(&histogram->total_count, load_uint64(&other->total_count));
+  add_uint64(&histogram->total_duration, load_uint64(&other->total_duration));
+  max_uint64(&histogram->min_duration_complement, load_uint64(&other->min_duration_complement));
+  max_uint64(&histogram->max_duration, load_uint64(&other->max_duration));
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_latency_histogram_reset(rcutils_latency_histogram_t * histogram)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(histogram, RCUTILS_RET_INVALID_ARGUMENT);
+  for (size_t i = 0u; i < RCUTILS_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    store_uint64(&histogram->counts[i], 0u);
+  }
+  store_uint64(&histogram->total_count, 0u);
+  store_uint64(&histogram->total_duration, 0u);
+  store_uint64(&histogram->min_duration_complement, 0u);
+  store_uint64(&histogram->max_duration, 0u);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_latency_histogram_get_percentile(
+  const rcutils_latency_histogram_t * histogram,
+  double percentile,
+  rcutils_duration_value_t * duration)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(histogram, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(duration, RCUTILS_RET_INVALID_ARGUMENT);
+  // Written so that NaN is rejected as well.
+  if (!(percentile >= 0.0 && percentile <= 100.0)) {
+    RCUTILS_SET_ERROR_MSG("percentile must be between 0 and 100");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  // Counted from the buckets rather than read from the total count, which may disagree with
+  // them if durations were being recorded while the histogram was read.
+  uint64_t total_count = 0u;
+  for (size_t i = 0u; i < RCUTILS_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    total_count += load_uint64(&histogram->counts[i]);
+  }
+  *duration = 0;
+  if (0u == total_count) {
+    return RCUTILS_RET_OK;
+  }
+  // The rank of the duration, counted from 1, rounded up so that the 50th percentile of two
+  // durations is the smaller one and the 100th is the largest.
+  const double exact_rank = percentile / 100.0 * (double)total_count;
+  uint64_t rank = (uint64_t)exact_rank;
+  if ((double)rank < exact_rank) {
+    ++rank;
+  }
+  if (0u == rank) {
+    rank = 1u;
+  }
+  uint64_t count = 0u;
+  for (size_t i = 0u; i < RCUTILS_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    count += load_uint64(&histogram->counts[i]);
+    if (count >= rank) {
+      uint64_t value = get_bucket_upper_bound(i);
+      const uint64_t max_duration = load_uint64(&histogram->max_duration);
+      if (value > max_duration) {
+        value = max_duration;
+      }
+      *duration = (rcutils_duration_value_t)value;
+      break;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_duration_value_t
+rcutils_latency_histogram_get_min(const rcutils_latency_histogram_t * histogram)
+{
+  if (NULL == histogram) {
+    return 0;
+  }
+  const uint64_t min_duration_complement = load_uint64(&histogram->min_duration_complement);
+  if (0u == min_duration_complement) {
+    return 0;
+  }
+  return (rcutils_duration_value_t)~min_duration_complement;
+}
+
+rcutils_duration_value_t
+rcutils_latency_histogram_get_max(const rcutils_latency_histogram_t * histogram)
+{
+  if (NULL == histogram) {
+    return 0;
+  }
+  return (rcutils_duration_value_t)load_uint64(&histogram->max_duration);
+}
+
+rcutils_ret_t
+rcutils_stopwatch_start(rcutils_stopwatch_t * stopwatch)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stopwatch, RCUTILS_RET_INVALID_ARGUMENT);
+  return rcutils_steady_time_now_fast(&stopwatch->start);
+}
+
+rcutils_ret_t
+rcutils_stopwatch_elapsed(
+  const rcutils_stopwatch_t * stopwatch, rcutils_duration_value_t * elapsed)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stopwatch, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(elapsed, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_time_point_value_t now;
+  rcutils_ret_t ret = rcutils_steady_time_now_fast(&now);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  *elapsed = now - stopwatch->start;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_stopwatch_record(
+  rcutils_stopwatch_t * stopwatch,
+  rcutils_latency_histogram_t * histogram,
+  rcutils_duration_value_t * elapsed)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stopwatch, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(histogram, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_time_point_value_t now;
+  rcutils_ret_t ret = rcutils_steady_time_now_fast(&now);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  const rcutils_duration_value_t duration = now - stopwatch->start;
+  stopwatch->start = now;
+  rcutils_latency_histogram_record(histogram, duration);
+  if (NULL != elapsed) {
+    *elapsed = duration;
+  }
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
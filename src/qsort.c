@@ -17,10 +17,64 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
 #include "rcutils/qsort.h"
+#include "rcutils/sort.h"
+#include "rcutils/thread_pool.h"
+
+typedef struct qsort_context_s
+{
+  int (* comp)(const void *, const void *);
+} qsort_context_t;
+
+#define QSORT_LESS(lhs, rhs, context) (((const qsort_context_t *)(context))->comp(lhs, rhs) < 0)
+
+// Elements of the most common sizes are moved as a whole, rather than byte by byte.
+typedef struct qsort_element_4_s
+{
+  unsigned char bytes[4];
+} qsort_element_4_t;
+
+typedef struct qsort_element_8_s
+{
+  unsigned char bytes[8];
+} qsort_element_8_t;
+
+typedef struct qsort_element_16_s
+{
+  unsigned char bytes[16];
+} qsort_element_16_t;
+
+RCUTILS_DEFINE_SORT(qsort_4, qsort_element_4_t, QSORT_LESS)
+RCUTILS_DEFINE_SORT(qsort_8, qsort_element_8_t, QSORT_LESS)
+RCUTILS_DEFINE_SORT(qsort_16, qsort_element_16_t, QSORT_LESS)
+
+static void sort_elements(
+  void * ptr, size_t count, size_t size, int (* comp)(const void *, const void *))
+{
+  qsort_context_t context = {comp};
+  switch (size) {
+    case sizeof(qsort_element_4_t):
+      qsort_4((qsort_element_4_t *)ptr, count, &context);
+      break;
+    case sizeof(qsort_element_8_t):
+      qsort_8((qsort_element_8_t *)ptr, count, &context);
+      break;
+    case sizeof(qsort_element_16_t):
+      qsort_16((qsort_element_16_t *)ptr, count, &context);
+      break;
+    default:
+      qsort(ptr, count, size, comp);
+      break;
+  }
+}
 
 rcutils_ret_t
 rcutils_qsort(void * ptr, size_t count, size_t size, int (* comp)(const void *, const void *))
@@ -35,8 +89,170 @@ rcutils_qsort(void * ptr, size_t count, size_t size, int (* comp)(const void *,
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(
     ptr, "ptr is null", return RCUTILS_RET_INVALID_ARGUMENT);
 
-  qsort(ptr, count, size, comp);
+  sort_elements(ptr, count, size, comp);
+
+  return RCUTILS_RET_OK;
+}
+
+// A piece of the work of rcutils_qsort_parallel(), run by one thread.
+typedef struct qsort_parallel_task_s
+{
+  int (* comp)(const void *, const void *);
+  size_t size;
+  // Sorts the left_count elements at source in place if destination is NULL, or else merges
+  // them with the right_count elements following them into destination.
+  char * source;
+  size_t left_count;
+  size_t right_count;
+  char * destination;
+} qsort_parallel_task_t;
+
+static void qsort_parallel_run_task(void * arg)
+{
+  qsort_parallel_task_t * task = (qsort_parallel_task_t *)arg;
+  if (NULL == task->destination) {
+    sort_elements(task->source, task->left_count, task->size, task->comp);
+    return;
+  }
+
+  const size_t size = task->size;
+  const char * left = task->source;
+  const char * left_end = left + task->left_count * size;
+  const char * right = left_end;
+  const char * right_end = right + task->right_count * size;
+  char * out = task->destination;
+  while (left < left_end && right < right_end) {
+    if (task->comp(right, left) < 0) {
+      memcpy(out, right, size);
+      right += size;
+    } else {
+      memcpy(out, left, size);
+      left += size;
+    }
+    out += size;
+  }
+  memcpy(out, left, (size_t)(left_end - left));
+  out += left_end - left;
+  memcpy(out, right, (size_t)(right_end - right));
+}
+
+// Run the tasks at once, the last one in the calling thread, and wait for all of them.
+// Without a thread pool, or if it fails to queue a task, the tasks are run in the calling thread.
+static void qsort_parallel_run_tasks(
+  rcutils_thread_pool_t * pool, qsort_parallel_task_t * tasks, size_t task_count)
+{
+  for (size_t i = 0; i + 1 < task_count; ++i) {
+    if (NULL == pool->impl ||
+      RCUTILS_RET_OK != rcutils_thread_pool_submit(pool, qsort_parallel_run_task, &tasks[i]))
+    {
+      rcutils_reset_error();
+      qsort_parallel_run_task(&tasks[i]);
+    }
+  }
+  qsort_parallel_run_task(&tasks[task_count - 1]);
+  if (NULL != pool->impl && RCUTILS_RET_OK != rcutils_thread_pool_wait(pool)) {
+    rcutils_reset_error();
+  }
+}
+
+rcutils_ret_t
+rcutils_qsort_parallel(
+  void * ptr,
+  size_t count,
+  size_t size,
+  int (* comp)(const void *, const void *),
+  size_t thread_count,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    comp, "comp is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (0 == thread_count) {
+    thread_count = rcutils_thread_get_processor_count();
+  }
+  size_t piece_count = count / RCUTILS_QSORT_PARALLEL_MIN_COUNT;
+  if (piece_count > thread_count) {
+    piece_count = thread_count;
+  }
+  if (piece_count < 2 || 0 == size) {
+    return rcutils_qsort(ptr, count, size, comp);
+  }
+
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    ptr, "ptr is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (count > SIZE_MAX / size) {
+    RCUTILS_SET_ERROR_MSG("array is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  char * buffer = allocator->allocate(count * size, allocator->state);
+  qsort_parallel_task_t * tasks =
+    allocator->allocate(piece_count * sizeof(qsort_parallel_task_t), allocator->state);
+  // The first element of each run of sorted elements, and the end of the array
+  size_t * run_begins = allocator->allocate((piece_count + 1) * sizeof(size_t), allocator->state);
+  if (NULL == buffer || NULL == tasks || NULL == run_begins) {
+    allocator->deallocate(buffer, allocator->state);
+    allocator->deallocate(tasks, allocator->state);
+    allocator->deallocate(run_begins, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for parallel sort");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
 
+  // Sort pieces of the same size, give or take one element.
+  for (size_t i = 0; i < piece_count; ++i) {
+    run_begins[i] = i * (count / piece_count) + (i < count % piece_count ? i : count % piece_count);
+  }
+  run_begins[piece_count] = count;
+  for (size_t i = 0; i < piece_count; ++i) {
+    tasks[i].comp = comp;
+    tasks[i].size = size;
+    tasks[i].source = (char *)ptr + run_begins[i] * size;
+    tasks[i].left_count = run_begins[i + 1] - run_begins[i];
+    tasks[i].right_count = 0;
+    tasks[i].destination = NULL;
+  }
+  // The same threads sort the pieces and merge them, the calling thread being one of them.
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  options.thread_count = piece_count - 1;
+  if (RCUTILS_RET_OK != rcutils_thread_pool_init(&pool, &options, allocator)) {
+    rcutils_reset_error();
+  }
+  qsort_parallel_run_tasks(&pool, tasks, piece_count);
+
+  // Merge pairs of runs back and forth between the array and the buffer, until one is left.
+  char * source = (char *)ptr;
+  char * destination = buffer;
+  size_t run_count = piece_count;
+  while (run_count > 1) {
+    size_t task_count = 0;
+    for (size_t r = 0; r < run_count; r += 2) {
+      qsort_parallel_task_t * task = &tasks[task_count];
+      task->source = source + run_begins[r] * size;
+      task->left_count = run_begins[r + 1] - run_begins[r];
+      task->right_count = r + 1 < run_count ? run_begins[r + 2] - run_begins[r + 1] : 0;
+      task->destination = destination + run_begins[r] * size;
+      // The merged run begins where its left run did, which was read already.
+      run_begins[task_count++] = run_begins[r];
+    }
+    run_begins[task_count] = count;
+    qsort_parallel_run_tasks(&pool, tasks, task_count);
+    run_count = task_count;
+    char * tmp = source;
+    source = destination;
+    destination = tmp;
+  }
+  if (source != (char *)ptr) {
+    memcpy(ptr, source, count * size);
+  }
+
+  if (RCUTILS_RET_OK != rcutils_thread_pool_fini(&pool)) {
+    rcutils_reset_error();
+  }
+  allocator->deallocate(buffer, allocator->state);
+  allocator->deallocate(tasks, allocator->state);
+  allocator->deallocate(run_begins, allocator->state);
   return RCUTILS_RET_OK;
 }
 
@@ -20,129 +20,113 @@
 // It is released under the Public Domain, and has been placed additionally
 // under the Apache 2.0 license by me (William Woodall).
 //
-// It has been modified to take a custom allocator and to fit some of our
-// style standards.
-
-// Note: the "tuning" values at the beginning of the function have been left as-is.
+// It has since been rewritten to find and replace the matches in a single pass, writing into
+// a char array, so only its interface and documentation remain from the original.
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-#include <string.h>
-#include <stdlib.h>
 #include <stddef.h>
-
-#if (__STDC_VERSION__ >= 199901L)
 #include <stdint.h>
-#endif
+#include <string.h>
 
+#include "rcutils/error_handling.h"
 #include "rcutils/repl_str.h"
+#include "rcutils/types/char_array.h"
 
-// *INDENT-OFF* (prevent uncrustify from messing with the original style)
+// Make room for n more characters and the terminating null character after the first length.
+static rcutils_ret_t
+reserve(rcutils_char_array_t * char_array, size_t length, size_t n)
+{
+  if (n > SIZE_MAX - length - 1) {
+    RCUTILS_SET_ERROR_MSG("char array would be too long");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (length + n + 1 <= char_array->buffer_capacity) {
+    return RCUTILS_RET_OK;
+  }
+  return rcutils_char_array_expand_as_needed(char_array, length + n + 1);
+}
 
-char *
-rcutils_repl_str(
+rcutils_ret_t
+rcutils_repl_str_append(
   const char * str,
   const char * from,
   const char * to,
-  const rcutils_allocator_t * allocator)
+  rcutils_char_array_t * char_array)
 {
-  /* Adjust each of the below values to suit your needs. */
-
-  /* Increment positions cache size initially by this number. */
-  size_t cache_sz_inc = 16;
-  /* Thereafter, each time capacity needs to be increased,
-   * multiply the increment by this factor. */
-  const size_t cache_sz_inc_factor = 3;
-  /* But never increment capacity by more than this number. */
-  const size_t cache_sz_inc_max = 1048576;
-
-  char *pret, *ret = NULL;
-  const char *pstr2, *pstr = str;
-  size_t i, count = 0;
-  #if (__STDC_VERSION__ >= 199901L)
-  uintptr_t *pos_cache_tmp, *pos_cache = NULL;
-  #else
-  ptrdiff_t *pos_cache_tmp, *pos_cache = NULL;
-  #endif
-  size_t cache_sz = 0;
-  size_t cpylen, orglen, retlen, tolen, fromlen = strlen(from);
-
-  /* Find all matches and cache their positions. */
-  while ((pstr2 = strstr(pstr, from)) != NULL) {
-    count++;
-
-    /* Increase the cache size when necessary. */
-    if (cache_sz < count) {
-      cache_sz += cache_sz_inc;
-      pos_cache_tmp =
-        allocator->reallocate(pos_cache, sizeof(*pos_cache) * cache_sz, allocator->state);
-      if (pos_cache_tmp == NULL) {
-        goto end_repl_str;
-      } else {
-        pos_cache = pos_cache_tmp;
-      }
-      cache_sz_inc *= cache_sz_inc_factor;
-      if (cache_sz_inc > cache_sz_inc_max) {
-        cache_sz_inc = cache_sz_inc_max;
-      }
-    }
-
-    pos_cache[count-1] = (size_t)(pstr2 - str);
-    pstr = pstr2 + fromlen;
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(str, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(from, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(to, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(char_array, RCUTILS_RET_INVALID_ARGUMENT);
+  if ('\0' == from[0]) {
+    RCUTILS_SET_ERROR_MSG("from must not be empty");
+    return RCUTILS_RET_INVALID_ARGUMENT;
   }
 
-  orglen = (size_t)(pstr - str) + strlen(pstr);
+  const size_t from_length = strlen(from);
+  const size_t to_length = strlen(to);
+  // The buffer length always contains the trailing \0, so the strlen is one less than that.
+  size_t length = 0lu == char_array->buffer_length ? 0lu : char_array->buffer_length - 1;
+  const char * end = str + strlen(str);
 
-  /* Allocate memory for the post-replacement string. */
-  if (count > 0) {
-    tolen = strlen(to);
-    retlen = orglen + (tolen - fromlen) * count;
-  } else {
-    retlen = orglen;
-  }
-  ret = allocator->allocate(retlen + 1, allocator->state);
-  if (ret == NULL) {
-    goto end_repl_str;
+  // Unless the replacement is longer, the result fits in as many characters as the string.
+  rcutils_ret_t ret = reserve(char_array, length, (size_t)(end - str));
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
   }
 
-  if (count == 0) {
-    /* If no matches, then just duplicate the string. */
-#if defined(_MSC_VER)
-# pragma warning(push)
-# pragma warning(disable: 4996)  // strcpy may be unsafe
-#endif
-    strcpy(ret, str);  // NOLINT
-#if defined(_MSC_VER)
-# pragma warning(pop)
-#endif
-  } else {
-    /* Otherwise, duplicate the string whilst performing
-     * the replacements using the position cache. */
-    pret = ret;
-    memcpy(pret, str, pos_cache[0]);
-    pret += pos_cache[0];
-    for (i = 0; i < count; i++) {
-      memcpy(pret, to, tolen);
-      pret += tolen;
-      pstr = str + pos_cache[i] + fromlen;
-      cpylen = (i == count-1 ? orglen : pos_cache[i+1]) - pos_cache[i] - fromlen;
-      memcpy(pret, pstr, cpylen);
-      pret += cpylen;
+  // Copy the string up to each match, found with strstr, which the C libraries implement in
+  // linear time and vectorize, and then the replacement.
+  const char * rest = str;
+  const char * match;
+  while (NULL != (match = strstr(rest, from))) {
+    size_t segment_length = (size_t)(match - rest);
+    ret = reserve(char_array, length, segment_length);
+    if (RCUTILS_RET_OK == ret) {
+      ret = reserve(char_array, length + segment_length, to_length);
+    }
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
     }
-    ret[retlen] = '\0';
+    memcpy(char_array->buffer + length, rest, segment_length);
+    length += segment_length;
+    memcpy(char_array->buffer + length, to, to_length);
+    length += to_length;
+    rest = match + from_length;
   }
-
-end_repl_str:
-  /* Free the cache and return the post-replacement string,
-   * which will be NULL in the event of an error. */
-  allocator->deallocate(pos_cache, allocator->state);
-  return ret;
+  size_t rest_length = (size_t)(end - rest);
+  ret = reserve(char_array, length, rest_length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  memcpy(char_array->buffer + length, rest, rest_length);
+  length += rest_length;
+  char_array->buffer[length] = '\0';
+  char_array->buffer_length = length + 1;
+  return RCUTILS_RET_OK;
 }
 
-// *INDENT-ON*
+char *
+rcutils_repl_str(
+  const char * str,
+  const char * from,
+  const char * to,
+  const rcutils_allocator_t * allocator)
+{
+  rcutils_char_array_t result = rcutils_get_zero_initialized_char_array();
+  if (RCUTILS_RET_OK != rcutils_char_array_init(&result, 0, allocator)) {
+    return NULL;
+  }
+  if (RCUTILS_RET_OK != rcutils_repl_str_append(str, from, to, &result)) {
+    allocator->deallocate(result.buffer, allocator->state);
+    return NULL;
+  }
+  // The buffer of the char array is handed over to the caller.
+  return result.buffer;
+}
 
 #ifdef __cplusplus
 }
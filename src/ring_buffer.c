@@ -0,0 +1,277 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/ring_buffer.h"
+#include "rcutils/macros.h"
+
+typedef struct rcutils_ring_buffer_impl_s
+{
+  // Each slot is a sequence number followed by the words of the element.
+  // The sequence of the slot of the element of index i is 2 * i + 1 while the element is
+  // written, and 2 * i + 2 once it is, while zero means the slot was never written.
+  uint64_t * slots;
+  // The number of words of a slot.
+  size_t stride;
+  size_t capacity;
+  size_t element_size;
+  rcutils_allocator_t allocator;
+  // The number of elements pushed so far, only written by the writer.
+  uint64_t head;
+} rcutils_ring_buffer_impl_t;
+
+#define RING_BUFFER_VALIDATE_RING_BUFFER(ring_buffer) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(ring_buffer, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == ring_buffer->impl) { \
+    RCUTILS_SET_ERROR_MSG("ring buffer is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+static uint64_t load_relaxed_uint64(uint64_t * value)
+{
+#ifdef _WIN32
+  return *(volatile uint64_t *)value;
+#else
+  return __atomic_load_n(value, __ATOMIC_RELAXED);
+#endif
+}
+
+static void store_relaxed_uint64(uint64_t * value, uint64_t new_value)
+{
+#ifdef _WIN32
+  *(volatile uint64_t *)value = new_value;
+#else
+  __atomic_store_n(value, new_value, __ATOMIC_RELAXED);
+#endif
+}
+
+static uint64_t load_acquire_uint64(uint64_t * value)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)value, 0, 0);
+#else
+  return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void store_release_uint64(uint64_t * value, uint64_t new_value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)value, (LONG64)new_value);
+#else
+  __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+// Unlike a store, orders the stores after it after the new value.
+static void exchange_uint64(uint64_t * value, uint64_t new_value)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange64((volatile LONG64 *)value, (LONG64)new_value);
+#else
+  (void)__atomic_exchange_n(value, new_value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+// Unlike a load, orders the loads before it before the value is read.
+static uint64_t load_after_uint64(uint64_t * value)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)value, 0);
+#else
+  return __atomic_fetch_add(value, 0u, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static uint64_t * ring_buffer_get_slot(const rcutils_ring_buffer_impl_t * impl, uint64_t index)
+{
+  return impl->slots + (size_t)(index % impl->capacity) * impl->stride;
+}
+
+rcutils_ring_buffer_t
+rcutils_get_zero_initialized_ring_buffer(void)
+{
+  static rcutils_ring_buffer_t zero_initialized_ring_buffer = {NULL};
+  return zero_initialized_ring_buffer;
+}
+
+rcutils_ret_t
+rcutils_ring_buffer_init(
+  rcutils_ring_buffer_t * ring_buffer,
+  size_t capacity,
+  size_t element_size,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(ring_buffer, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u == capacity) {
+    RCUTILS_SET_ERROR_MSG("capacity cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == element_size) {
+    RCUTILS_SET_ERROR_MSG("element_size cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (element_size > SIZE_MAX - 2u * sizeof(uint64_t)) {
+    RCUTILS_SET_ERROR_MSG("element_size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t stride = 1u + (element_size + sizeof(uint64_t) - 1u) / sizeof(uint64_t);
+  if (capacity > SIZE_MAX / sizeof(uint64_t) / stride) {
+    RCUTILS_SET_ERROR_MSG("capacity times element_size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_ring_buffer_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_ring_buffer_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for ring buffer impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->slots = allocator->zero_allocate(capacity * stride, sizeof(uint64_t), allocator->state);
+  if (NULL == impl->slots) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for ring buffer slots");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->stride = stride;
+  impl->capacity = capacity;
+  impl->element_size = element_size;
+  impl->allocator = *allocator;
+  impl->head = 0u;
+  ring_buffer->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_ring_buffer_fini(rcutils_ring_buffer_t * ring_buffer)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(ring_buffer, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_ring_buffer_impl_t * impl = ring_buffer->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl->slots, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  ring_buffer->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_ring_buffer_push(rcutils_ring_buffer_t * ring_buffer, const void * element)
+{
+  RING_BUFFER_VALIDATE_RING_BUFFER(ring_buffer);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(element, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_ring_buffer_impl_t * impl = ring_buffer->impl;
+  // The head is only written by this thread, so it needs no atomic increment.
+  const uint64_t index = impl->head;
+  uint64_t * slot = ring_buffer_get_slot(impl, index);
+  exchange_uint64(slot, 2u * index + 1u);
+  // The words are stored atomically, if relaxed, as readers may read them meanwhile.
+  const uint8_t * bytes = (const uint8_t *)element;
+  size_t remaining = impl->element_size;
+  for (uint64_t * word = slot + 1; remaining > 0u; ++word) {
+    const size_t length = remaining < sizeof(uint64_t) ? remaining : sizeof(uint64_t);
+    uint64_t value = 0u;
+    memcpy(&value, bytes, length);
+    store_relaxed_uint64(word, value);
+    bytes += length;
+    remaining -= length;
+  }
+  store_release_uint64(slot, 2u * index + 2u);
+  store_release_uint64(&impl->head, index + 1u);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_ring_buffer_snapshot(
+  const rcutils_ring_buffer_t * ring_buffer,
+  void * elements,
+  size_t max_count,
+  size_t * count)
+{
+  RING_BUFFER_VALIDATE_RING_BUFFER(ring_buffer);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u != max_count) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(elements, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  rcutils_ring_buffer_impl_t * impl = ring_buffer->impl;
+  const uint64_t head = load_acquire_uint64(&impl->head);
+  uint64_t available = head < impl->capacity ? head : impl->capacity;
+  if (available > max_count) {
+    available = max_count;
+  }
+
+  uint8_t * out = (uint8_t *)elements;
+  size_t copied = 0u;
+  for (uint64_t index = head - available; index < head; ++index) {
+    uint64_t * slot = ring_buffer_get_slot(impl, index);
+    const uint64_t sequence = load_acquire_uint64(slot);
+    uint8_t * bytes = out + copied * impl->element_size;
+    size_t remaining = impl->element_size;
+    for (uint64_t * word = slot + 1; remaining > 0u; ++word) {
+      const size_t length = remaining < sizeof(uint64_t) ? remaining : sizeof(uint64_t);
+      const uint64_t value = load_relaxed_uint64(word);
+      memcpy(bytes, &value, length);
+      bytes += length;
+      remaining -= length;
+    }
+    if (2u * index + 2u != sequence || load_after_uint64(slot) != sequence) {
+      // The writer overwrote this element, so it also overwrote the ones copied before it,
+      // which are older.
+      copied = 0u;
+      continue;
+    }
+    ++copied;
+  }
+  *count = copied;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_ring_buffer_get_capacity(const rcutils_ring_buffer_t * ring_buffer, size_t * capacity)
+{
+  RING_BUFFER_VALIDATE_RING_BUFFER(ring_buffer);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(capacity, RCUTILS_RET_INVALID_ARGUMENT);
+  *capacity = ring_buffer->impl->capacity;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_ring_buffer_get_pushed_count(
+  const rcutils_ring_buffer_t * ring_buffer, uint64_t * pushed_count)
+{
+  RING_BUFFER_VALIDATE_RING_BUFFER(ring_buffer);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pushed_count, RCUTILS_RET_INVALID_ARGUMENT);
+  *pushed_count = load_acquire_uint64(&ring_buffer->impl->head);
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
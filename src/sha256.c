@@ -12,11 +12,82 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define RCUTILS_SHA256_X86
+#define RCUTILS_SHA256_X86_TARGET
+#define RCUTILS_SHA256_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define RCUTILS_SHA256_X86
+#define RCUTILS_SHA256_X86_TARGET __attribute__((target("sha,sse4.1")))
+#define RCUTILS_SHA256_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#define RCUTILS_SHA256_ARM64
+#define RCUTILS_SHA256_ARM64_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define RCUTILS_SHA256_ARM64
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define RCUTILS_SHA256_ARM64_TARGET
+#elif defined(__clang__)
+#define RCUTILS_SHA256_ARM64_TARGET __attribute__((target("crypto")))
+#else
+#define RCUTILS_SHA256_ARM64_TARGET __attribute__((target("+crypto")))
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#elif defined(__FreeBSD__)
+#include <machine/elf.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
 #include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
+#ifdef _WIN32
+// See logging.c for why warning C5105 is disabled.
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
 #include "rcutils/sha256.h"
 
+#include "rcutils/error_handling.h"
+#include "rcutils/filesystem.h"
+
+#include "./threads.h"
+
+// Hashes consecutive blocks of 64 bytes into the state.
+typedef void (* sha256_transform_t)(uint32_t state[8], const uint8_t * data, size_t blocks);
+
+// The number of independent messages hashed at once by SIMD instructions.
+#define SHA256_LANES (8)
+
+// Hashes as many consecutive blocks of each of SHA256_LANES messages into their states.
+typedef void (* sha256_transform_lanes_t)(
+  uint32_t * states[SHA256_LANES], const uint8_t * data[SHA256_LANES], size_t blocks);
+
+// Consecutive blocks of a message which are yet to be hashed into its state.
+typedef struct sha256_stream_s
+{
+  uint32_t * state;
+  const uint8_t * data;
+  size_t blocks;
+} sha256_stream_t;
+
 static inline size_t min(size_t a, size_t b)
 {
   return a < b ? a : b;
@@ -74,48 +145,486 @@ static const uint32_t k[64] = {
   0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
 };
 
-static void sha256_transform(rcutils_sha256_ctx_t * ctx)
+static void sha256_transform_portable(uint32_t state[8], const uint8_t * data, size_t blocks)
 {
   uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
-  uint8_t * data = ctx->data;
-
-  for (i = 0, j = 0; i < 16; ++i, j += 4) {
-    m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-  }
-  for ( ; i < 64; ++i) {
-    m[i] = sig1(m[i - 2]) + m[i - 7] + sig0(m[i - 15]) + m[i - 16];
-  }
-
-  a = ctx->state[0];
-  b = ctx->state[1];
-  c = ctx->state[2];
-  d = ctx->state[3];
-  e = ctx->state[4];
-  f = ctx->state[5];
-  g = ctx->state[6];
-  h = ctx->state[7];
-
-  for (i = 0; i < 64; ++i) {
-    t1 = h + ep1(e) + ch(e, f, g) + k[i] + m[i];
-    t2 = ep0(a) + maj(a, b, c);
-    h = g;
-    g = f;
-    f = e;
-    e = d + t1;
-    d = c;
-    c = b;
-    b = a;
-    a = t1 + t2;
-  }
-
-  ctx->state[0] += a;
-  ctx->state[1] += b;
-  ctx->state[2] += c;
-  ctx->state[3] += d;
-  ctx->state[4] += e;
-  ctx->state[5] += f;
-  ctx->state[6] += g;
-  ctx->state[7] += h;
+
+  for ( ; blocks > 0; --blocks, data += 64) {
+    for (i = 0, j = 0; i < 16; ++i, j += 4) {
+      m[i] = ((uint32_t)data[j] << 24) | ((uint32_t)data[j + 1] << 16) |
+        ((uint32_t)data[j + 2] << 8) | ((uint32_t)data[j + 3]);
+    }
+    for ( ; i < 64; ++i) {
+      m[i] = sig1(m[i - 2]) + m[i - 7] + sig0(m[i - 15]) + m[i - 16];
+    }
+
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
+
+    for (i = 0; i < 64; ++i) {
+      t1 = h + ep1(e) + ch(e, f, g) + k[i] + m[i];
+      t2 = ep0(a) + maj(a, b, c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+#if defined(RCUTILS_SHA256_X86)
+// The SHA extensions keep the state as the words ABEF and CDGH, and do two rounds per
+// instruction, with the sum of the message words and the constants in the low 64 bits.
+RCUTILS_SHA256_X86_TARGET
+static void sha256_transform_x86(uint32_t state[8], const uint8_t * data, size_t blocks)
+{
+  // Reverses the bytes of each 32-bit word, since SHA-256 is big endian.
+  const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+  __m128i dcba = _mm_loadu_si128((const __m128i *)&state[0]);
+  __m128i hgfe = _mm_loadu_si128((const __m128i *)&state[4]);
+  __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+  __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+  __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+  __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+  for ( ; blocks > 0; --blocks, data += 64) {
+    const __m128i abef_saved = abef;
+    const __m128i cdgh_saved = cdgh;
+    // The message words of four consecutive rounds each, of which msg[i % 4] are next.
+    __m128i msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * i)), byte_swap);
+    }
+    for (int i = 0; i < 16; ++i) {
+      __m128i words = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i *)&k[4 * i]));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(words, 0x0E));
+      if (i < 12) {
+        // Schedule the message words of the rounds 16 after these ones.
+        __m128i next = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+        next = _mm_add_epi32(next, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+        msg[i & 3] = _mm_sha256msg2_epu32(next, msg[(i + 3) & 3]);
+      }
+    }
+    abef = _mm_add_epi32(abef, abef_saved);
+    cdgh = _mm_add_epi32(cdgh, cdgh_saved);
+  }
+
+  __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+  __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+  dcba = _mm_blend_epi16(feba, dchg, 0xF0);
+  hgfe = _mm_alignr_epi8(dchg, feba, 8);
+  _mm_storeu_si128((__m128i *)&state[0], dcba);
+  _mm_storeu_si128((__m128i *)&state[4], hgfe);
+}
+
+static int sha256_has_x86_extensions(void)
+{
+  // SHA is reported by bit 29 of EBX in the leaf 7, and SSSE3 and SSE4.1 by bits 9 and 19 of
+  // ECX in the leaf 1.
+#ifdef _MSC_VER
+  int registers[4];
+  __cpuid(registers, 0);
+  if (registers[0] < 7) {
+    return 0;
+  }
+  __cpuid(registers, 1);
+  const unsigned int ecx = (unsigned int)registers[2];
+  __cpuidex(registers, 7, 0);
+  const unsigned int ebx = (unsigned int)registers[1];
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0u, NULL) < 7u || !__get_cpuid(1u, &eax, &ebx, &ecx, &edx)) {
+    return 0;
+  }
+  const unsigned int leaf_1_ecx = ecx;
+  __cpuid_count(7u, 0u, eax, ebx, ecx, edx);
+  ecx = leaf_1_ecx;
+#endif
+  return 0u != (ebx & (1u << 29)) && 0u != (ecx & (1u << 9)) && 0u != (ecx & (1u << 19));
+}
+
+#define SHA256_AVX2_ROTRIGHT(x, n) \
+  _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+// Transposes the 8 words of 8 lanes, so that each vector holds a word of every lane.
+RCUTILS_SHA256_AVX2_TARGET
+static inline void sha256_transpose_avx2(__m256i r[8])
+{
+  const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// The portable rounds, on a word of each of 8 messages at once.
+RCUTILS_SHA256_AVX2_TARGET
+static void sha256_transform_lanes_avx2(
+  uint32_t * states[SHA256_LANES], const uint8_t * data[SHA256_LANES], size_t blocks)
+{
+  // Reverses the bytes of each 32-bit word, since SHA-256 is big endian.
+  const __m256i byte_swap = _mm256_set_epi64x(
+    0x0c0d0e0f08090a0bLL, 0x0405060700010203LL, 0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+  __m256i state[8], m[16];
+  size_t i, lane;
+
+  for (i = 0; i < 8; ++i) {
+    state[i] = _mm256_loadu_si256((const __m256i *)states[i]);
+  }
+  sha256_transpose_avx2(state);
+
+  for (size_t offset = 0; offset < blocks * 64; offset += 64) {
+    for (lane = 0; lane < SHA256_LANES; ++lane) {
+      m[lane] = _mm256_loadu_si256((const __m256i *)(data[lane] + offset));
+      m[lane + 8] = _mm256_loadu_si256((const __m256i *)(data[lane] + offset + 32));
+    }
+    sha256_transpose_avx2(m);
+    sha256_transpose_avx2(m + 8);
+    for (i = 0; i < 16; ++i) {
+      m[i] = _mm256_shuffle_epi8(m[i], byte_swap);
+    }
+
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+    for (i = 0; i < 64; ++i) {
+      // The message words are scheduled in place, m[i % 16] holding the word of round i.
+      if (i >= 16) {
+        const __m256i w2 = m[(i - 2) & 15];
+        const __m256i w15 = m[(i - 15) & 15];
+        const __m256i s1 = _mm256_xor_si256(
+          _mm256_xor_si256(SHA256_AVX2_ROTRIGHT(w2, 17), SHA256_AVX2_ROTRIGHT(w2, 19)),
+          _mm256_srli_epi32(w2, 10));
+        const __m256i s0 = _mm256_xor_si256(
+          _mm256_xor_si256(SHA256_AVX2_ROTRIGHT(w15, 7), SHA256_AVX2_ROTRIGHT(w15, 18)),
+          _mm256_srli_epi32(w15, 3));
+        m[i & 15] = _mm256_add_epi32(
+          _mm256_add_epi32(m[i & 15], s0), _mm256_add_epi32(m[(i - 7) & 15], s1));
+      }
+      const __m256i e1 = _mm256_xor_si256(
+        _mm256_xor_si256(SHA256_AVX2_ROTRIGHT(e, 6), SHA256_AVX2_ROTRIGHT(e, 11)),
+        SHA256_AVX2_ROTRIGHT(e, 25));
+      const __m256i choice = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+      const __m256i t1 = _mm256_add_epi32(
+        _mm256_add_epi32(_mm256_add_epi32(h, e1), _mm256_add_epi32(choice, m[i & 15])),
+        _mm256_set1_epi32((int)k[i]));
+      const __m256i e0 = _mm256_xor_si256(
+        _mm256_xor_si256(SHA256_AVX2_ROTRIGHT(a, 2), SHA256_AVX2_ROTRIGHT(a, 13)),
+        SHA256_AVX2_ROTRIGHT(a, 22));
+      const __m256i majority = _mm256_or_si256(
+        _mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+      const __m256i t2 = _mm256_add_epi32(e0, majority);
+      h = g;
+      g = f;
+      f = e;
+      e = _mm256_add_epi32(d, t1);
+      d = c;
+      c = b;
+      b = a;
+      a = _mm256_add_epi32(t1, t2);
+    }
+    state[0] = _mm256_add_epi32(state[0], a);
+    state[1] = _mm256_add_epi32(state[1], b);
+    state[2] = _mm256_add_epi32(state[2], c);
+    state[3] = _mm256_add_epi32(state[3], d);
+    state[4] = _mm256_add_epi32(state[4], e);
+    state[5] = _mm256_add_epi32(state[5], f);
+    state[6] = _mm256_add_epi32(state[6], g);
+    state[7] = _mm256_add_epi32(state[7], h);
+  }
+
+  // The transposition is its own inverse.
+  sha256_transpose_avx2(state);
+  for (i = 0; i < 8; ++i) {
+    _mm256_storeu_si256((__m256i *)states[i], state[i]);
+  }
+}
+
+static int sha256_has_avx2(void)
+{
+  // AVX2 is reported by bit 5 of EBX in the leaf 7, but is only usable if the OS saves the
+  // YMM registers, which is reported by bit 27 (OSXSAVE) of ECX in the leaf 1 and XCR0.
+#ifdef _MSC_VER
+  int registers[4];
+  __cpuid(registers, 0);
+  if (registers[0] < 7) {
+    return 0;
+  }
+  __cpuid(registers, 1);
+  const unsigned int ecx = (unsigned int)registers[2];
+  if (0u == (ecx & (1u << 27)) || 6u != (_xgetbv(0) & 6u)) {
+    return 0;
+  }
+  __cpuidex(registers, 7, 0);
+  const unsigned int ebx = (unsigned int)registers[1];
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0u, NULL) < 7u || !__get_cpuid(1u, &eax, &ebx, &ecx, &edx) ||
+    0u == (ecx & (1u << 27)))
+  {
+    return 0;
+  }
+  unsigned int xcr0, xcr0_high;
+  __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0_high) : "c" (0u));
+  if (6u != (xcr0 & 6u)) {
+    return 0;
+  }
+  __cpuid_count(7u, 0u, eax, ebx, ecx, edx);
+#endif
+  return 0u != (ebx & (1u << 5));
+}
+#endif
+
+#if defined(RCUTILS_SHA256_ARM64)
+RCUTILS_SHA256_ARM64_TARGET
+static void sha256_transform_arm64(uint32_t state[8], const uint8_t * data, size_t blocks)
+{
+  uint32x4_t abcd = vld1q_u32(&state[0]);
+  uint32x4_t efgh = vld1q_u32(&state[4]);
+
+  for ( ; blocks > 0; --blocks, data += 64) {
+    const uint32x4_t abcd_saved = abcd;
+    const uint32x4_t efgh_saved = efgh;
+    // The message words of four consecutive rounds each, of which msg[i % 4] are next.
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+    }
+    for (int i = 0; i < 16; ++i) {
+      const uint32x4_t words = vaddq_u32(msg[i & 3], vld1q_u32(&k[4 * i]));
+      if (i < 12) {
+        // Schedule the message words of the rounds 16 after these ones.
+        msg[i & 3] = vsha256su1q_u32(
+          vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]), msg[(i + 2) & 3], msg[(i + 3) & 3]);
+      }
+      const uint32x4_t abcd_previous = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, words);
+      efgh = vsha256h2q_u32(efgh, abcd_previous, words);
+    }
+    abcd = vaddq_u32(abcd, abcd_saved);
+    efgh = vaddq_u32(efgh, efgh_saved);
+  }
+
+  vst1q_u32(&state[0], abcd);
+  vst1q_u32(&state[4], efgh);
+}
+
+static int sha256_has_arm64_extensions(void)
+{
+#if defined(_WIN32)
+  return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) ? 1 : 0;
+#elif defined(__APPLE__)
+  // Every 64-bit Apple processor has the cryptography extensions.
+  return 1;
+#elif defined(__linux__)
+  // HWCAP_SHA2 from asm/hwcap.h.
+  return 0u != (getauxval(AT_HWCAP) & (1u << 6));
+#elif defined(__FreeBSD__)
+  unsigned long hwcap = 0u;
+  return 0 == elf_aux_info(AT_HWCAP, &hwcap, sizeof(hwcap)) && 0u != (hwcap & (1u << 6));
+#else
+  return 0;
+#endif
+}
+#endif
+
+static sha256_transform_t g_sha256_transform = NULL;
+static sha256_transform_lanes_t g_sha256_transform_lanes = NULL;
+
+static sha256_transform_t get_sha256_transform(void)
+{
+#ifdef _WIN32
+  sha256_transform_t transform =
+    (sha256_transform_t)InterlockedCompareExchangePointer(
+    (PVOID volatile *)&g_sha256_transform, NULL, NULL);
+#else
+  sha256_transform_t transform = __atomic_load_n(&g_sha256_transform, __ATOMIC_ACQUIRE);
+#endif
+  if (NULL != transform) {
+    return transform;
+  }
+  // Threads racing here pick the same functions, so they may be stored more than once.
+  sha256_transform_lanes_t transform_lanes = NULL;
+  transform = sha256_transform_portable;
+#if defined(RCUTILS_SHA256_X86)
+  if (sha256_has_x86_extensions()) {
+    transform = sha256_transform_x86;
+  } else if (sha256_has_avx2()) {
+    // The SHA extensions hash a single message about as fast as AVX2 hashes 8 of them.
+    transform_lanes = sha256_transform_lanes_avx2;
+  }
+#elif defined(RCUTILS_SHA256_ARM64)
+  if (sha256_has_arm64_extensions()) {
+    transform = sha256_transform_arm64;
+  }
+#endif
+  // The lanes are stored first, so that they are set once the single transform is.
+#ifdef _WIN32
+  (void)InterlockedExchangePointer(
+    (PVOID volatile *)&g_sha256_transform_lanes, (PVOID)transform_lanes);
+  (void)InterlockedExchangePointer((PVOID volatile *)&g_sha256_transform, (PVOID)transform);
+#else
+  __atomic_store_n(&g_sha256_transform_lanes, transform_lanes, __ATOMIC_RELAXED);
+  __atomic_store_n(&g_sha256_transform, transform, __ATOMIC_RELEASE);
+#endif
+  return transform;
+}
+
+// Returns the function hashing several messages at once, or NULL if there is none faster than
+// hashing them one after the other.
+static sha256_transform_lanes_t get_sha256_transform_lanes(void)
+{
+  (void)get_sha256_transform();
+#ifdef _WIN32
+  return (sha256_transform_lanes_t)InterlockedCompareExchangePointer(
+    (PVOID volatile *)&g_sha256_transform_lanes, NULL, NULL);
+#else
+  return __atomic_load_n(&g_sha256_transform_lanes, __ATOMIC_RELAXED);
+#endif
+}
+
+// Hashes the blocks of many messages, SHA256_LANES at once where possible.
+static void sha256_transform_streams(sha256_stream_t * streams, size_t count)
+{
+  sha256_transform_t transform = get_sha256_transform();
+  sha256_transform_lanes_t transform_lanes = get_sha256_transform_lanes();
+  size_t next = 0;
+
+  if (NULL != transform_lanes) {
+    // Each lane hashes a stream until it runs out of blocks, and then takes the next one.
+    // Lanes without a stream hash the data of another into a scratch state.
+    sha256_stream_t * lanes[SHA256_LANES] = {NULL};
+    uint32_t scratch_states[SHA256_LANES][8];
+    uint32_t * states[SHA256_LANES];
+    const uint8_t * data[SHA256_LANES];
+    size_t lane, active;
+    for (;;) {
+      active = 0;
+      for (lane = 0; lane < SHA256_LANES; ++lane) {
+        while (NULL == lanes[lane] && next < count) {
+          if (streams[next].blocks > 0) {
+            lanes[lane] = &streams[next];
+          }
+          ++next;
+        }
+        if (NULL != lanes[lane]) {
+          ++active;
+        }
+      }
+      // Too few streams are left to be worth hashing at once.
+      if (active < SHA256_LANES / 2) {
+        break;
+      }
+      size_t blocks = SIZE_MAX;
+      sha256_stream_t * any = NULL;
+      for (lane = 0; lane < SHA256_LANES; ++lane) {
+        if (NULL != lanes[lane]) {
+          blocks = min(blocks, lanes[lane]->blocks);
+          any = lanes[lane];
+        }
+      }
+      for (lane = 0; lane < SHA256_LANES; ++lane) {
+        states[lane] = NULL != lanes[lane] ? lanes[lane]->state : scratch_states[lane];
+        data[lane] = NULL != lanes[lane] ? lanes[lane]->data : any->data;
+      }
+      transform_lanes(states, data, blocks);
+      for (lane = 0; lane < SHA256_LANES; ++lane) {
+        if (NULL != lanes[lane]) {
+          lanes[lane]->data += blocks * 64;
+          lanes[lane]->blocks -= blocks;
+          if (0 == lanes[lane]->blocks) {
+            lanes[lane] = NULL;
+          }
+        }
+      }
+    }
+    for (lane = 0; lane < SHA256_LANES; ++lane) {
+      if (NULL != lanes[lane]) {
+        transform(lanes[lane]->state, lanes[lane]->data, lanes[lane]->blocks);
+      }
+    }
+  }
+
+  for ( ; next < count; ++next) {
+    if (streams[next].blocks > 0) {
+      transform(streams[next].state, streams[next].data, streams[next].blocks);
+    }
+  }
+}
+
+// Writes the padding of the data left in the context, with the length of the message, in one
+// or two blocks and returns how many.
+static size_t sha256_pad(const rcutils_sha256_ctx_t * ctx, uint8_t blocks[128])
+{
+  size_t i = ctx->datalen;
+  const size_t length = ctx->datalen < 56 ? 64 : 128;
+  const uint64_t bitlen = ctx->bitlen + ctx->datalen * 8;
+
+  memcpy(blocks, ctx->data, ctx->datalen);
+  blocks[i++] = 0x80;
+  memset(blocks + i, 0x00, length - 8 - i);
+  for (i = 0; i < 8; ++i) {
+    blocks[length - 1 - i] = (uint8_t)(bitlen >> (i * 8));
+  }
+  return length / 64;
+}
+
+static void sha256_output(
+  const uint32_t state[8], uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE])
+{
+  size_t i;
+
+  // Since this implementation uses little endian byte ordering and SHA uses big endian,
+  // reverse all the bytes when copying the final state to the output hash.
+  for (i = 0; i < 4; ++i) {
+    output_hash[i + 0] = (state[0] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 4] = (state[1] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 8] = (state[2] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 12] = (state[3] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 16] = (state[4] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 20] = (state[5] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 24] = (state[6] >> (24 - i * 8)) & 0x000000ff;
+    output_hash[i + 28] = (state[7] >> (24 - i * 8)) & 0x000000ff;
+  }
 }
 
 void rcutils_sha256_init(rcutils_sha256_ctx_t * ctx)
@@ -134,11 +643,20 @@ void rcutils_sha256_init(rcutils_sha256_ctx_t * ctx)
 
 void rcutils_sha256_update(rcutils_sha256_ctx_t * ctx, const uint8_t * data, size_t len)
 {
-  size_t i, data_remaining, block_remaining, copy_len;
+  sha256_transform_t transform = get_sha256_transform();
+  size_t i, data_remaining, block_remaining, copy_len, blocks;
   i = 0;
 
   while (i < len) {
     data_remaining = len - i;
+    if (0 == ctx->datalen && data_remaining >= 64) {
+      // Hash whole blocks straight from the input, rather than copying them to the context.
+      blocks = data_remaining / 64;
+      transform(ctx->state, data + i, blocks);
+      ctx->bitlen += 512 * (uint64_t)blocks;
+      i += blocks * 64;
+      continue;
+    }
     block_remaining = 64 - ctx->datalen;
     copy_len = min(min(block_remaining, data_remaining), 64);
 
@@ -147,7 +665,7 @@ void rcutils_sha256_update(rcutils_sha256_ctx_t * ctx, const uint8_t * data, siz
     i += copy_len;
 
     if (ctx->datalen >= 64) {
-      sha256_transform(ctx);
+      transform(ctx->state, ctx->data, 1);
       ctx->bitlen += 512;
       ctx->datalen = 0;
     }
@@ -157,43 +675,327 @@ void rcutils_sha256_update(rcutils_sha256_ctx_t * ctx, const uint8_t * data, siz
 void rcutils_sha256_final(
   rcutils_sha256_ctx_t * ctx, uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE])
 {
-  size_t i = ctx->datalen;
+  uint8_t blocks[128];
 
-  // Pad whatever data is left in the buffer.
-  if (ctx->datalen < 56) {
-    ctx->data[i++] = 0x80;
-    memset(ctx->data + i, 0x00, 56 - i);
-  } else {
-    ctx->data[i++] = 0x80;
-    if (i < 64) {
-      memset(ctx->data + i, 0x00, 64 - i);
-    }
-    sha256_transform(ctx);
-    memset(ctx->data, 0, 56);
-  }
-
-  // Append to the padding the total message's length in bits and transform.
-  ctx->bitlen += ctx->datalen * 8;
-  ctx->data[63] = (uint8_t)(ctx->bitlen >> 0);
-  ctx->data[62] = (uint8_t)(ctx->bitlen >> 8);
-  ctx->data[61] = (uint8_t)(ctx->bitlen >> 16);
-  ctx->data[60] = (uint8_t)(ctx->bitlen >> 24);
-  ctx->data[59] = (uint8_t)(ctx->bitlen >> 32);
-  ctx->data[58] = (uint8_t)(ctx->bitlen >> 40);
-  ctx->data[57] = (uint8_t)(ctx->bitlen >> 48);
-  ctx->data[56] = (uint8_t)(ctx->bitlen >> 56);
-  sha256_transform(ctx);
+  // Pad whatever data is left in the buffer, and append the total message's length in bits.
+  get_sha256_transform()(ctx->state, blocks, sha256_pad(ctx, blocks));
+  sha256_output(ctx->state, output_hash);
+}
 
-  // Since this implementation uses little endian byte ordering and SHA uses big endian,
-  // reverse all the bytes when copying the final state to the output hash.
-  for (i = 0; i < 4; ++i) {
-    output_hash[i + 0] = (ctx->state[0] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 4] = (ctx->state[1] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 8] = (ctx->state[2] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 12] = (ctx->state[3] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 16] = (ctx->state[4] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 20] = (ctx->state[5] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 24] = (ctx->state[6] >> (24 - i * 8)) & 0x000000ff;
-    output_hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
+// The number of contexts handled at once by the functions for many contexts, bounding the
+// memory they need on the stack.
+#define SHA256_MANY_GROUP (32)
+
+void rcutils_sha256_update_many(
+  rcutils_sha256_ctx_t * ctxs, const uint8_t * const * data, const size_t * data_lens,
+  size_t count)
+{
+  sha256_stream_t streams[SHA256_MANY_GROUP];
+  size_t ends[SHA256_MANY_GROUP];
+  size_t group, i, offset, copy_len;
+
+  for (group = 0; group < count; group += SHA256_MANY_GROUP) {
+    const size_t group_count = min(count - group, SHA256_MANY_GROUP);
+    for (i = 0; i < group_count; ++i) {
+      rcutils_sha256_ctx_t * ctx = &ctxs[group + i];
+      const uint8_t * input = data[group + i];
+      const size_t len = data_lens[group + i];
+      streams[i].state = ctx->state;
+      streams[i].data = input;
+      streams[i].blocks = 0;
+      ends[i] = 0;
+      if (0 == len) {
+        continue;
+      }
+      // Complete the block buffered in the context first.
+      offset = 0;
+      if (ctx->datalen > 0) {
+        copy_len = min(64 - ctx->datalen, len);
+        memcpy(ctx->data + ctx->datalen, input, copy_len);
+        ctx->datalen += copy_len;
+        offset = copy_len;
+        if (ctx->datalen == 64) {
+          get_sha256_transform()(ctx->state, ctx->data, 1);
+          ctx->bitlen += 512;
+          ctx->datalen = 0;
+        }
+      }
+      streams[i].data = input + offset;
+      streams[i].blocks = (len - offset) / 64;
+      ctx->bitlen += 512 * (uint64_t)streams[i].blocks;
+      ends[i] = offset + streams[i].blocks * 64;
+    }
+    sha256_transform_streams(streams, group_count);
+    // Buffer the data left after the last whole block.
+    for (i = 0; i < group_count; ++i) {
+      rcutils_sha256_ctx_t * ctx = &ctxs[group + i];
+      copy_len = data_lens[group + i] - ends[i];
+      if (copy_len > 0) {
+        memcpy(ctx->data + ctx->datalen, data[group + i] + ends[i], copy_len);
+        ctx->datalen += copy_len;
+      }
+    }
+  }
+}
+
+void rcutils_sha256_final_many(
+  rcutils_sha256_ctx_t * ctxs, size_t count,
+  uint8_t (* output_hashes)[RCUTILS_SHA256_BLOCK_SIZE])
+{
+  sha256_stream_t streams[SHA256_MANY_GROUP];
+  uint8_t blocks[SHA256_MANY_GROUP][128];
+  size_t group, i;
+
+  for (group = 0; group < count; group += SHA256_MANY_GROUP) {
+    const size_t group_count = min(count - group, SHA256_MANY_GROUP);
+    for (i = 0; i < group_count; ++i) {
+      streams[i].state = ctxs[group + i].state;
+      streams[i].data = blocks[i];
+      streams[i].blocks = sha256_pad(&ctxs[group + i], blocks[i]);
+    }
+    sha256_transform_streams(streams, group_count);
+    for (i = 0; i < group_count; ++i) {
+      sha256_output(ctxs[group + i].state, output_hashes[group + i]);
+    }
+  }
+}
+
+// The size of the parts of a file hashed at once, after asking for the next one to be read.
+#define SHA256_FILE_CHUNK_SIZE ((size_t)1 << 20)
+
+// Hash a mapped file a chunk at a time, letting the system read the next chunk meanwhile.
+static void sha256_mapped_file(
+  const rcutils_mapped_file_t * mapped_file, uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE])
+{
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  for (size_t offset = 0; offset < mapped_file->size; offset += SHA256_FILE_CHUNK_SIZE) {
+    const size_t length = min(mapped_file->size - offset, SHA256_FILE_CHUNK_SIZE);
+#ifndef _WIN32
+    // Chunks start at multiples of the page size, as posix_madvise() requires.
+    const size_t next = offset + length;
+    if (next < mapped_file->size) {
+      (void)posix_madvise(
+        (void *)(mapped_file->data + next), min(mapped_file->size - next, SHA256_FILE_CHUNK_SIZE),
+        POSIX_MADV_WILLNEED);
+    }
+#endif
+    rcutils_sha256_update(&ctx, mapped_file->data + offset, length);
+  }
+  rcutils_sha256_final(&ctx, output_hash);
+}
+
+// Files which can't be mapped, e.g. pipes, are read by a thread into one buffer while the
+// other one is hashed.
+typedef struct sha256_file_reader_s
+{
+#ifdef _WIN32
+  HANDLE file;
+#else
+  int fd;
+#endif
+  uint8_t * buffers[2];
+  // The number of bytes read into each buffer, which is less than SHA256_FILE_CHUNK_SIZE only
+  // for the last one.
+  size_t lengths[2];
+  bool filled[2];
+  // The error of the last read, or 0.
+  int error;
+  // Set when the hashing stopped, so that the reader doesn't wait for a buffer anymore.
+  bool stopped;
+  rcutils_mutex_t mutex;
+  rcutils_condition_variable_t cv;
+} sha256_file_reader_t;
+
+// Read into a buffer until it is full or the end of the file, returning an error code or 0.
+static int sha256_file_read(sha256_file_reader_t * reader, uint8_t * buffer, size_t * length)
+{
+  *length = 0;
+  while (*length < SHA256_FILE_CHUNK_SIZE) {
+#ifdef _WIN32
+    DWORD bytes_read = 0;
+    if (!ReadFile(
+        reader->file, buffer + *length, (DWORD)(SHA256_FILE_CHUNK_SIZE - *length), &bytes_read,
+        NULL))
+    {
+      const DWORD error = GetLastError();
+      // Reading a pipe whose writer closed it fails instead of returning 0 bytes.
+      return ERROR_BROKEN_PIPE == error ? 0 : (int)error;
+    }
+#else
+    const ssize_t bytes_read =
+      read(reader->fd, buffer + *length, SHA256_FILE_CHUNK_SIZE - *length);
+    if (bytes_read < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return errno;
+    }
+#endif
+    if (0 == bytes_read) {
+      break;
+    }
+    *length += (size_t)bytes_read;
+  }
+  return 0;
+}
+
+static void sha256_file_read_ahead(void * arg)
+{
+  sha256_file_reader_t * reader = arg;
+  for (size_t i = 0; ; i ^= 1) {
+    rcutils_mutex_lock(&reader->mutex);
+    while (reader->filled[i] && !reader->stopped) {
+      rcutils_condition_variable_wait_for(&reader->cv, &reader->mutex, 100);
+    }
+    const bool stopped = reader->stopped;
+    rcutils_mutex_unlock(&reader->mutex);
+    if (stopped) {
+      return;
+    }
+    size_t length;
+    const int error = sha256_file_read(reader, reader->buffers[i], &length);
+    rcutils_mutex_lock(&reader->mutex);
+    reader->lengths[i] = length;
+    reader->filled[i] = true;
+    reader->error = error;
+    rcutils_condition_variable_notify_all(&reader->cv);
+    rcutils_mutex_unlock(&reader->mutex);
+    if (0 != error || length < SHA256_FILE_CHUNK_SIZE) {
+      return;
+    }
+  }
+}
+
+static rcutils_ret_t sha256_read_file(
+  sha256_file_reader_t * reader, uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE])
+{
+  rcutils_thread_t thread;
+  const bool threaded =
+    RCUTILS_RET_OK == rcutils_thread_create(&thread, sha256_file_read_ahead, reader);
+  if (!threaded) {
+    rcutils_reset_error();
+  }
+
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  size_t length;
+  int error = 0;
+  for (size_t i = 0; ; i ^= 1) {
+    if (threaded) {
+      rcutils_mutex_lock(&reader->mutex);
+      while (!reader->filled[i]) {
+        rcutils_condition_variable_wait_for(&reader->cv, &reader->mutex, 100);
+      }
+      length = reader->lengths[i];
+      error = reader->error;
+      rcutils_mutex_unlock(&reader->mutex);
+    } else {
+      error = sha256_file_read(reader, reader->buffers[i], &length);
+    }
+    if (0 != error) {
+      break;
+    }
+    rcutils_sha256_update(&ctx, reader->buffers[i], length);
+    if (length < SHA256_FILE_CHUNK_SIZE) {
+      break;
+    }
+    if (threaded) {
+      rcutils_mutex_lock(&reader->mutex);
+      reader->filled[i] = false;
+      rcutils_condition_variable_notify_all(&reader->cv);
+      rcutils_mutex_unlock(&reader->mutex);
+    }
+  }
+
+  if (threaded) {
+    rcutils_mutex_lock(&reader->mutex);
+    reader->stopped = true;
+    rcutils_condition_variable_notify_all(&reader->cv);
+    rcutils_mutex_unlock(&reader->mutex);
+    if (RCUTILS_RET_OK != rcutils_thread_join(&thread)) {
+      rcutils_reset_error();
+    }
+  }
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Can't read file. Error code: %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+  rcutils_sha256_final(&ctx, output_hash);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t rcutils_sha256_file(
+  const char * file_path, uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE],
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output_hash, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  // Mapping the file spares copying it, and lets the system read it ahead of the hashing.
+  // Only regular files are mapped, checked without opening them, since opening a pipe would
+  // take its writer, and the ones which seem empty are read instead, since some have contents
+  // but no size, e.g. the ones of /proc.
+  if (rcutils_is_file(file_path) && rcutils_get_file_size(file_path) > 0) {
+    rcutils_mapped_file_t mapped_file = rcutils_get_zero_initialized_mapped_file();
+    if (RCUTILS_RET_OK ==
+      rcutils_mmap_file(file_path, RCUTILS_MMAP_ACCESS_SEQUENTIAL, &mapped_file))
+    {
+      sha256_mapped_file(&mapped_file, output_hash);
+      if (RCUTILS_RET_OK != rcutils_munmap_file(&mapped_file)) {
+        rcutils_reset_error();
+      }
+      return RCUTILS_RET_OK;
+    }
+    rcutils_reset_error();
+  }
+
+  sha256_file_reader_t reader;
+  memset(&reader, 0, sizeof(reader));
+#ifdef _WIN32
+  reader.file = CreateFileA(
+    file_path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (INVALID_HANDLE_VALUE == reader.file) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open file %s. Error code: %lu", file_path, GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+#else
+  reader.fd = open(file_path, O_RDONLY | O_CLOEXEC);
+  if (reader.fd < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open file %s. Error code: %d", file_path, errno);
+    return RCUTILS_RET_ERROR;
+  }
+#ifdef __linux__
+  (void)posix_fadvise(reader.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+
+  rcutils_ret_t ret = RCUTILS_RET_BAD_ALLOC;
+  reader.buffers[0] = allocator.allocate(2 * SHA256_FILE_CHUNK_SIZE, allocator.state);
+  if (NULL == reader.buffers[0]) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate the buffers to read the file");
+  } else {
+    reader.buffers[1] = reader.buffers[0] + SHA256_FILE_CHUNK_SIZE;
+    ret = rcutils_mutex_init(&reader.mutex);
+    if (RCUTILS_RET_OK == ret) {
+      ret = rcutils_condition_variable_init(&reader.cv);
+      if (RCUTILS_RET_OK == ret) {
+        ret = sha256_read_file(&reader, output_hash);
+        rcutils_condition_variable_fini(&reader.cv);
+      }
+      rcutils_mutex_fini(&reader.mutex);
+    }
+    allocator.deallocate(reader.buffers[0], allocator.state);
   }
+#ifdef _WIN32
+  CloseHandle(reader.file);
+#else
+  close(reader.fd);
+#endif
+  return ret;
 }
@@ -16,8 +16,11 @@
 extern "C"
 {
 #endif
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef _WIN32
 #if defined(__APPLE__)
@@ -28,6 +31,8 @@ extern "C"
 #include <sys/link.h>
 #endif
 #include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #else
 // When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
 // there appears to be a problem with winbase.h (which is included by
@@ -48,10 +53,216 @@ C_ASSERT(sizeof(void *) == sizeof(HINSTANCE));
 C_ASSERT(sizeof(char) == sizeof(TCHAR));
 #endif  // _WIN32
 
+#include "./threads.h"
+
 #include "rcutils/error_handling.h"
 #include "rcutils/macros.h"
 #include "rcutils/shared_library.h"
 #include "rcutils/strdup.h"
+#include "rcutils/thread_pool.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/string_pool.h"
+
+// The most symbols rcutils_get_symbols() looks up outside of the cache at once.
+#define SHARED_LIBRARY_SYMBOL_BATCH (32u)
+
+// The entry of a loaded library in the process-wide registry, shared by all the
+// rcutils_shared_library_t loading it, which remembers its resolved path and the symbols looked
+// up in it, including the missing ones, whose address is NULL.
+// The entries are keyed by the handle of the library, which is the same for all the loads of
+// a library, so that the path of a library only has to be resolved the first time it is loaded.
+struct rcutils_shared_library_symbol_cache_s
+{
+  struct rcutils_shared_library_symbol_cache_s * next;
+  void * lib_pointer;
+  // Protected by the registry lock, NULL until the first load resolved it.
+  char * library_path;
+  // Protected by the registry lock.
+  size_t ref_count;
+  rcutils_mutex_t lock;
+  // The interned symbol names to their addresses.
+  rcutils_hash_map_t symbols;
+  rcutils_string_pool_t names;
+};
+
+typedef struct rcutils_shared_library_symbol_cache_s symbol_cache_t;
+
+// The registry is a list, as few libraries are loaded, and only guarded by a spin lock so that
+// it doesn't need initializing.
+static symbol_cache_t * g_registry = NULL;
+static uint32_t g_registry_lock = 0u;
+
+// A lock which needs no initialization, for the process-wide state only held briefly.
+static void spin_lock(uint32_t * lock)
+{
+#ifdef _WIN32
+  while (InterlockedCompareExchange((volatile LONG *)lock, 1, 0) != 0) {
+    rcutils_thread_yield();
+  }
+#else
+  uint32_t expected = 0u;
+  while (!__atomic_compare_exchange_n(
+      lock, &expected, 1u, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+  {
+    expected = 0u;
+    rcutils_thread_yield();
+  }
+#endif
+}
+
+static void spin_unlock(uint32_t * lock)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)lock, 0);
+#else
+  __atomic_store_n(lock, 0u, __ATOMIC_RELEASE);
+#endif
+}
+
+static void fini_symbol_cache(symbol_cache_t * cache)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  if (NULL != cache->symbols.impl) {
+    rcutils_ret_t ret = rcutils_hash_map_fini(&cache->symbols);
+    (void)ret;
+  }
+  if (NULL != cache->names.impl) {
+    rcutils_ret_t ret = rcutils_string_pool_fini(&cache->names);
+    (void)ret;
+  }
+  rcutils_mutex_fini(&cache->lock);
+  allocator.deallocate(cache->library_path, allocator.state);
+  allocator.deallocate(cache, allocator.state);
+}
+
+// The registry outlives the allocators of the libraries, so it uses the default one.
+static symbol_cache_t * init_symbol_cache(void * lib_pointer)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  symbol_cache_t * cache = allocator.zero_allocate(1, sizeof(symbol_cache_t), allocator.state);
+  if (NULL == cache) {
+    return NULL;
+  }
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&cache->lock)) {
+    allocator.deallocate(cache, allocator.state);
+    return NULL;
+  }
+  if (RCUTILS_RET_OK != rcutils_hash_map_init(
+      &cache->symbols, 16, sizeof(const char *), sizeof(void *),
+      rcutils_hash_map_string_fast_hash_func, rcutils_hash_map_string_cmp_func, &allocator) ||
+    RCUTILS_RET_OK != rcutils_string_pool_init(&cache->names, &allocator))
+  {
+    rcutils_reset_error();
+    fini_symbol_cache(cache);
+    return NULL;
+  }
+  cache->lib_pointer = lib_pointer;
+  cache->ref_count = 1u;
+  return cache;
+}
+
+// Return the registry entry of a loaded library, adding it if needed, or NULL if it can't be
+// allocated, which only makes the library resolve its path and look every symbol up itself.
+static symbol_cache_t * acquire_symbol_cache(void * lib_pointer)
+{
+  spin_lock(&g_registry_lock);
+  for (symbol_cache_t * cache = g_registry; NULL != cache; cache = cache->next) {
+    if (cache->lib_pointer == lib_pointer) {
+      ++cache->ref_count;
+      spin_unlock(&g_registry_lock);
+      return cache;
+    }
+  }
+  spin_unlock(&g_registry_lock);
+
+  // Allocate outside of the lock, and check again whether another thread added it meanwhile.
+  symbol_cache_t * new_cache = init_symbol_cache(lib_pointer);
+  spin_lock(&g_registry_lock);
+  for (symbol_cache_t * cache = g_registry; NULL != cache; cache = cache->next) {
+    if (cache->lib_pointer == lib_pointer) {
+      ++cache->ref_count;
+      spin_unlock(&g_registry_lock);
+      if (NULL != new_cache) {
+        fini_symbol_cache(new_cache);
+      }
+      return cache;
+    }
+  }
+  if (NULL != new_cache) {
+    new_cache->next = g_registry;
+    g_registry = new_cache;
+  }
+  spin_unlock(&g_registry_lock);
+  return new_cache;
+}
+
+// Must be called before the library is closed, as its handle may then be reused by another one.
+static void release_symbol_cache(symbol_cache_t * cache)
+{
+  spin_lock(&g_registry_lock);
+  bool last = 0u == --cache->ref_count;
+  if (last) {
+    symbol_cache_t ** link = &g_registry;
+    while (*link != cache) {
+      link = &(*link)->next;
+    }
+    *link = cache->next;
+  }
+  spin_unlock(&g_registry_lock);
+  if (last) {
+    fini_symbol_cache(cache);
+  }
+}
+
+// Look the symbol up in the library, returning NULL if it doesn't exist.
+static void * lookup_symbol(const rcutils_shared_library_t * lib, const char * symbol_name)
+{
+#ifndef _WIN32
+  // the correct way to test for an error is to call dlerror() to clear any old error conditions,
+  // then call dlsym(), and then call dlerror() again, saving its return value into a variable,
+  // and check whether this saved value is not NULL.
+  dlerror(); /* Clear any existing error */
+  void * lib_symbol = dlsym(lib->lib_pointer, symbol_name);
+  return NULL == dlerror() ? lib_symbol : NULL;
+#else
+  return (void *)GetProcAddress((HINSTANCE)(lib->lib_pointer), symbol_name);
+#endif  // _WIN32
+}
+
+// Must be called with the lock of the cache held.
+static void remember_symbol(symbol_cache_t * cache, const char * symbol_name, void * lib_symbol)
+{
+  const char * name = NULL;
+  if (RCUTILS_RET_OK != rcutils_string_pool_intern(&cache->names, symbol_name, &name, NULL) ||
+    RCUTILS_RET_OK != rcutils_hash_map_set(&cache->symbols, &name, &lib_symbol))
+  {
+    // The symbol is looked up again next time.
+    rcutils_reset_error();
+  }
+}
+
+// Look the symbol up in the cache of the library, then in the library itself.
+static void * find_symbol(const rcutils_shared_library_t * lib, const char * symbol_name)
+{
+  symbol_cache_t * cache = lib->symbol_cache;
+  if (NULL == cache) {
+    return lookup_symbol(lib, symbol_name);
+  }
+  void * lib_symbol = NULL;
+  rcutils_mutex_lock(&cache->lock);
+  rcutils_ret_t ret = rcutils_hash_map_get(&cache->symbols, &symbol_name, &lib_symbol);
+  rcutils_mutex_unlock(&cache->lock);
+  if (RCUTILS_RET_OK == ret) {
+    return lib_symbol;
+  }
+
+  // Other threads may look symbols up meanwhile, even the same one, which is harmless.
+  lib_symbol = lookup_symbol(lib, symbol_name);
+  rcutils_mutex_lock(&cache->lock);
+  remember_symbol(cache, symbol_name, lib_symbol);
+  rcutils_mutex_unlock(&cache->lock);
+  return lib_symbol;
+}
 
 rcutils_shared_library_t
 rcutils_get_zero_initialized_shared_library(void)
@@ -60,47 +271,270 @@ rcutils_get_zero_initialized_shared_library(void)
   zero_initialized_shared_library.library_path = NULL;
   zero_initialized_shared_library.lib_pointer = NULL;
   zero_initialized_shared_library.allocator = rcutils_get_zero_initialized_allocator();
+  zero_initialized_shared_library.symbol_cache = NULL;
   return zero_initialized_shared_library;
 }
 
-rcutils_ret_t
-rcutils_load_shared_library(
-  rcutils_shared_library_t * lib,
-  const char * library_path,
-  rcutils_allocator_t allocator)
+#if defined(__APPLE__)
+// dyld has no way to get the path of an image from its handle, which used to be found by calling
+// dlopen(RTLD_NOLOAD) on every image, in turn, until one had the same handle, i.e. quadratically
+// across a batch of loads.
+// Instead, the paths of the images are indexed by their handles, which are looked up once for
+// each image as dyld adds them.
+// The image registering the dyld callbacks can't be unloaded anymore, which doesn't matter for
+// this library.
+
+// An image added or removed by dyld, which the callbacks queue, as they can't call into dyld.
+typedef struct dyld_image_event_s
 {
-  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_BAD_ALLOC);
-  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_ERROR);
+  const struct mach_header * header;
+  bool added;
+} dyld_image_event_t;
 
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(lib, RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(library_path, RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CHECK_ALLOCATOR(&allocator, return RCUTILS_RET_INVALID_ARGUMENT);
-  if (NULL != lib->lib_pointer) {
-    RCUTILS_SET_ERROR_MSG("lib argument is not zero-initialized");
-    return RCUTILS_RET_INVALID_ARGUMENT;
+// An indexed image.
+typedef struct dyld_image_s
+{
+  const struct mach_header * header;
+  char * path;
+} dyld_image_t;
+
+static dyld_image_event_t * g_dyld_image_events = NULL;
+static size_t g_dyld_image_event_count = 0u;
+static size_t g_dyld_image_event_capacity = 0u;
+// Whether some events couldn't be queued, which makes the index rebuilt.
+static bool g_dyld_image_events_lost = false;
+// Never held while calling into dyld, as the callbacks take it.
+static uint32_t g_dyld_image_events_lock = 0u;
+
+// The images by their handles, and their handles by their headers.
+static rcutils_hash_map_t g_dyld_images;
+static rcutils_hash_map_t g_dyld_image_handles;
+static bool g_dyld_image_index_initialized = false;
+static uint32_t g_dyld_image_index_lock = 0u;
+
+static size_t hash_pointer(const void * key)
+{
+  uintptr_t pointer = *(const uintptr_t *)key;
+  return (size_t)((pointer >> 4) * UINT64_C(0x9E3779B97F4A7C15));
+}
+
+static int compare_pointers(const void * lhs, const void * rhs)
+{
+  return *(void * const *)lhs != *(void * const *)rhs;
+}
+
+static void queue_dyld_image_event(const struct mach_header * header, bool added)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  spin_lock(&g_dyld_image_events_lock);
+  if (g_dyld_image_event_count == g_dyld_image_event_capacity) {
+    size_t capacity = 2u * g_dyld_image_event_capacity + 64u;
+    dyld_image_event_t * events = allocator.reallocate(
+      g_dyld_image_events, capacity * sizeof(dyld_image_event_t), allocator.state);
+    if (NULL == events) {
+      g_dyld_image_events_lost = true;
+      g_dyld_image_event_count = 0u;
+      spin_unlock(&g_dyld_image_events_lock);
+      return;
+    }
+    g_dyld_image_events = events;
+    g_dyld_image_event_capacity = capacity;
   }
+  g_dyld_image_events[g_dyld_image_event_count].header = header;
+  g_dyld_image_events[g_dyld_image_event_count].added = added;
+  ++g_dyld_image_event_count;
+  spin_unlock(&g_dyld_image_events_lock);
+}
 
-  rcutils_ret_t ret = RCUTILS_RET_OK;
-  lib->allocator = allocator;
+static void on_dyld_image_added(const struct mach_header * header, intptr_t slide)
+{
+  (void)slide;
+  queue_dyld_image_event(header, true);
+}
 
-  // Delegate library path resolution to dynamic linker.
+static void on_dyld_image_removed(const struct mach_header * header, intptr_t slide)
+{
+  (void)slide;
+  queue_dyld_image_event(header, false);
+}
 
-  // Since the given library path might be relative, let the dynamic
-  // linker search for the binary object in all standard locations and
-  // current process space (if already loaded) first.
-  // Then lookup its full path with the handle obtained.
-  // See POSIX dlopen() API and Windows' LoadLibrary() API documentation
-  // for further reference.
+// The functions below must be called with the index lock held.
 
-#ifndef _WIN32
-  lib->lib_pointer = dlopen(library_path, RTLD_LAZY);
-  if (NULL == lib->lib_pointer) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("dlopen error: %s", dlerror());
-    return RCUTILS_RET_ERROR;
+static void forget_dyld_image(const struct mach_header * header)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  void * handle = NULL;
+  if (RCUTILS_RET_OK != rcutils_hash_map_get(&g_dyld_image_handles, &header, &handle)) {
+    return;
+  }
+  rcutils_ret_t ret = rcutils_hash_map_unset(&g_dyld_image_handles, &header);
+  (void)ret;
+  dyld_image_t image;
+  // The handle may have been reused by another image since.
+  if (RCUTILS_RET_OK == rcutils_hash_map_get(&g_dyld_images, &handle, &image) &&
+    image.header == header)
+  {
+    ret = rcutils_hash_map_unset(&g_dyld_images, &handle);
+    (void)ret;
+    allocator.deallocate(image.path, allocator.state);
+  }
+}
+
+static void index_dyld_image(const struct mach_header * header, const char * path)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  forget_dyld_image(header);
+  void * handle = dlopen(path, RTLD_LAZY | RTLD_NOLOAD);
+  if (NULL == handle) {
+    return;
+  }
+  dyld_image_t image;
+  if (RCUTILS_RET_OK == rcutils_hash_map_get(&g_dyld_images, &handle, &image)) {
+    allocator.deallocate(image.path, allocator.state);
+    rcutils_ret_t ret = rcutils_hash_map_unset(&g_dyld_images, &handle);
+    (void)ret;
+  }
+  image.header = header;
+  image.path = rcutils_strdup(path, allocator);
+  if (NULL == image.path ||
+    RCUTILS_RET_OK != rcutils_hash_map_set(&g_dyld_images, &handle, &image) ||
+    RCUTILS_RET_OK != rcutils_hash_map_set(&g_dyld_image_handles, &header, &handle))
+  {
+    // The image is found by scanning them all instead.
+    rcutils_reset_error();
+    rcutils_ret_t ret = rcutils_hash_map_unset(&g_dyld_images, &handle);
+    (void)ret;
+    allocator.deallocate(image.path, allocator.state);
+  }
+  if (dlclose(handle) != 0) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING("dlclose error: %s\n", dlerror());
   }
+}
 
+static void clear_dyld_image_index(void)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  void * handle = NULL;
+  dyld_image_t image;
+  rcutils_ret_t ret = rcutils_hash_map_get_next_key_and_data(
+    &g_dyld_images, NULL, &handle, &image);
+  while (RCUTILS_RET_OK == ret) {
+    allocator.deallocate(image.path, allocator.state);
+    ret = rcutils_hash_map_get_next_key_and_data(&g_dyld_images, &handle, &handle, &image);
+  }
+  ret = rcutils_hash_map_fini(&g_dyld_images);
+  (void)ret;
+  ret = rcutils_hash_map_fini(&g_dyld_image_handles);
+  (void)ret;
+}
+
+static bool init_dyld_image_index(void)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  g_dyld_images = rcutils_get_zero_initialized_hash_map();
+  g_dyld_image_handles = rcutils_get_zero_initialized_hash_map();
+  if (RCUTILS_RET_OK != rcutils_hash_map_init(
+      &g_dyld_images, 256, sizeof(void *), sizeof(dyld_image_t),
+      hash_pointer, compare_pointers, &allocator) ||
+    RCUTILS_RET_OK != rcutils_hash_map_init(
+      &g_dyld_image_handles, 256, sizeof(const struct mach_header *), sizeof(void *),
+      hash_pointer, compare_pointers, &allocator))
+  {
+    rcutils_reset_error();
+    if (NULL != g_dyld_images.impl) {
+      rcutils_ret_t ret = rcutils_hash_map_fini(&g_dyld_images);
+      (void)ret;
+    }
+    return false;
+  }
+  return true;
+}
+
+// Copy the path of a loaded image from the index, returning RCUTILS_RET_NOT_FOUND if it isn't
+// there, in which case the images should be scanned.
+static rcutils_ret_t
+find_dyld_image_path(void * lib_pointer, rcutils_allocator_t allocator, char ** path)
+{
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  spin_lock(&g_dyld_image_index_lock);
+  if (!g_dyld_image_index_initialized) {
+    if (!init_dyld_image_index()) {
+      spin_unlock(&g_dyld_image_index_lock);
+      return RCUTILS_RET_NOT_FOUND;
+    }
+    g_dyld_image_index_initialized = true;
+    // The callback is called for the images already loaded as well.
+    _dyld_register_func_for_add_image(on_dyld_image_added);
+    _dyld_register_func_for_remove_image(on_dyld_image_removed);
+  }
+
+  spin_lock(&g_dyld_image_events_lock);
+  dyld_image_event_t * events = g_dyld_image_events;
+  size_t event_count = g_dyld_image_event_count;
+  bool events_lost = g_dyld_image_events_lost;
+  g_dyld_image_events = NULL;
+  g_dyld_image_event_count = 0u;
+  g_dyld_image_event_capacity = 0u;
+  g_dyld_image_events_lost = false;
+  spin_unlock(&g_dyld_image_events_lock);
+
+  if (events_lost) {
+    clear_dyld_image_index();
+    if (!init_dyld_image_index()) {
+      g_dyld_image_index_initialized = false;
+      spin_unlock(&g_dyld_image_index_lock);
+      default_allocator.deallocate(events, default_allocator.state);
+      return RCUTILS_RET_NOT_FOUND;
+    }
+    uint32_t image_count = _dyld_image_count();
+    for (uint32_t i = 0; i < image_count; ++i) {
+      const struct mach_header * header = _dyld_get_image_header(i);
+      const char * name = _dyld_get_image_name(i);
+      if (NULL != header && NULL != name) {
+        index_dyld_image(header, name);
+      }
+    }
+  }
+  for (size_t i = 0; i < event_count; ++i) {
+    Dl_info info;
+    if (!events[i].added) {
+      forget_dyld_image(events[i].header);
+    } else if (dladdr(events[i].header, &info) && NULL != info.dli_fname) {
+      index_dyld_image(events[i].header, info.dli_fname);
+    }
+  }
+  default_allocator.deallocate(events, default_allocator.state);
+
+  rcutils_ret_t ret = RCUTILS_RET_NOT_FOUND;
+  dyld_image_t image;
+  if (RCUTILS_RET_OK == rcutils_hash_map_get(&g_dyld_images, &lib_pointer, &image)) {
+    *path = rcutils_strdup(image.path, allocator);
+    ret = RCUTILS_RET_OK;
+    if (NULL == *path) {
+      RCUTILS_SET_ERROR_MSG("unable to allocate memory");
+      ret = RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  spin_unlock(&g_dyld_image_index_lock);
+  return ret;
+}
+#endif  // __APPLE__
+
+// Resolve the full path of a loaded library.
+static rcutils_ret_t
+resolve_library_path(
+  void * lib_pointer,
+  const char * library_path,
+  rcutils_allocator_t allocator,
+  char ** resolved_path)
+{
+#ifndef _WIN32
 #if defined(__APPLE__)
+  (void)library_path;
+  rcutils_ret_t ret = find_dyld_image_path(lib_pointer, allocator, resolved_path);
+  if (RCUTILS_RET_NOT_FOUND != ret) {
+    return ret;
+  }
   const char * image_name = NULL;
   uint32_t image_count = _dyld_image_count();
   for (uint32_t i = 0; NULL == image_name && i < image_count; ++i) {
@@ -108,93 +542,267 @@ rcutils_load_shared_library(
     const char * candidate_name = _dyld_get_image_name(image_count - i - 1);
     if (NULL == candidate_name) {
       RCUTILS_SET_ERROR_MSG("dyld image index out of range");
-      ret = RCUTILS_RET_ERROR;
-      goto fail;
+      return RCUTILS_RET_ERROR;
     }
     void * handle = dlopen(candidate_name, RTLD_LAZY | RTLD_NOLOAD);
-    if (handle == lib->lib_pointer) {
+    if (handle == lib_pointer) {
       image_name = candidate_name;
     }
     if (dlclose(handle) != 0) {
       RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("dlclose error: %s", dlerror());
-      ret = RCUTILS_RET_ERROR;
-      goto fail;
+      return RCUTILS_RET_ERROR;
     }
   }
   if (NULL == image_name) {
     RCUTILS_SET_ERROR_MSG("dyld image name could not be found");
-    ret = RCUTILS_RET_ERROR;
-    goto fail;
+    return RCUTILS_RET_ERROR;
   }
-  lib->library_path = rcutils_strdup(image_name, lib->allocator);
+  *resolved_path = rcutils_strdup(image_name, allocator);
 #elif defined(_GNU_SOURCE) && !defined(__QNXNTO__) && !defined(__ANDROID__) && !defined(__OHOS__)
+  (void)library_path;
   struct link_map * map = NULL;
-  if (dlinfo(lib->lib_pointer, RTLD_DI_LINKMAP, &map) != 0) {
+  if (dlinfo(lib_pointer, RTLD_DI_LINKMAP, &map) != 0) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("dlinfo error: %s", dlerror());
-    ret = RCUTILS_RET_ERROR;
-    goto fail;
+    return RCUTILS_RET_ERROR;
   }
-  lib->library_path = rcutils_strdup(map->l_name, lib->allocator);
+  *resolved_path = rcutils_strdup(map->l_name, allocator);
 #else
-  lib->library_path = rcutils_strdup(library_path, lib->allocator);
+  (void)lib_pointer;
+  *resolved_path = rcutils_strdup(library_path, allocator);
 #endif
-  if (NULL == lib->library_path) {
+  if (NULL == *resolved_path) {
     RCUTILS_SET_ERROR_MSG("unable to allocate memory");
-    ret = RCUTILS_RET_BAD_ALLOC;
-    goto fail;
+    return RCUTILS_RET_BAD_ALLOC;
   }
-
   return RCUTILS_RET_OK;
-fail:
-  if (dlclose(lib->lib_pointer) != 0) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-      "dlclose error: %s\n", dlerror());
-  }
-  lib->lib_pointer = NULL;
-  return ret;
 #else
-  HMODULE module = LoadLibrary(library_path);
-  if (!module) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "LoadLibrary error: %lu", GetLastError());
-    return RCUTILS_RET_ERROR;
-  }
-
+  (void)library_path;
   for (DWORD buffer_capacity = MAX_PATH; ; buffer_capacity *= 2) {
-    LPSTR buffer = lib->allocator.allocate(buffer_capacity, lib->allocator.state);
+    LPSTR buffer = allocator.allocate(buffer_capacity, allocator.state);
     if (NULL == buffer) {
       RCUTILS_SET_ERROR_MSG("unable to allocate memory");
-      ret = RCUTILS_RET_BAD_ALLOC;
-      goto fail;
+      return RCUTILS_RET_BAD_ALLOC;
     }
-    DWORD buffer_size = GetModuleFileName(module, buffer, buffer_capacity);
+    DWORD buffer_size = GetModuleFileName((HINSTANCE)lib_pointer, buffer, buffer_capacity);
     if (0 == buffer_size) {
       RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
         "GetModuleFileName error: %lu", GetLastError());
-      ret = RCUTILS_RET_ERROR;
-      goto fail;
+      allocator.deallocate(buffer, allocator.state);
+      return RCUTILS_RET_ERROR;
     }
     if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
-      lib->allocator.deallocate(buffer, lib->allocator.state);
+      allocator.deallocate(buffer, allocator.state);
       continue;
     }
-    lib->library_path = lib->allocator.reallocate(
-      buffer, buffer_size + 1, lib->allocator.state);
-    if (NULL == lib->library_path) {
-      lib->library_path = buffer;
+    *resolved_path = allocator.reallocate(buffer, buffer_size + 1, allocator.state);
+    if (NULL == *resolved_path) {
+      *resolved_path = buffer;
     }
-    break;
+    return RCUTILS_RET_OK;
+  }
+#endif  // _WIN32
+}
+
+// The flags rcutils_load_shared_library_with_flags() knows of.
+#define SHARED_LIBRARY_ALL_FLAGS \
+  (RCUTILS_SHARED_LIBRARY_BIND_NOW | RCUTILS_SHARED_LIBRARY_GLOBAL | \
+  RCUTILS_SHARED_LIBRARY_PREFAULT)
+
+#if defined(__linux__) && defined(_GNU_SOURCE) && !defined(__ANDROID__) && !defined(__OHOS__)
+#define SHARED_LIBRARY_PREFAULT_SEGMENTS
+
+typedef struct prefault_context_s
+{
+  // The base address and the name of the library, as in its link map
+  ElfW(Addr) base;
+  const char * name;
+} prefault_context_t;
+
+// Read the pages of the loadable segments of the library into memory, once it is found.
+static int
+prefault_segments(struct dl_phdr_info * info, size_t size, void * data)
+{
+  (void)size;
+  const prefault_context_t * context = (const prefault_context_t *)data;
+  if (info->dlpi_addr != context->base || NULL == info->dlpi_name ||
+    0 != strcmp(info->dlpi_name, context->name))
+  {
+    return 0;
+  }
+  const uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+  for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+    const ElfW(Phdr) * phdr = &info->dlpi_phdr[i];
+    if (PT_LOAD != phdr->p_type || 0u == phdr->p_memsz) {
+      continue;
+    }
+    const uintptr_t start = (uintptr_t)(info->dlpi_addr + phdr->p_vaddr) & ~(page_size - 1u);
+    const uintptr_t end = (uintptr_t)(info->dlpi_addr + phdr->p_vaddr + phdr->p_memsz);
+    // Start reading the pages from the file ahead of touching them.
+    (void)madvise((void *)start, end - start, MADV_WILLNEED);
+    if (0u == (phdr->p_flags & PF_R)) {
+      continue;
+    }
+    bool populated = false;
+#ifdef MADV_POPULATE_READ
+    // Since Linux 5.14, the pages are all mapped at once.
+    populated = 0 == madvise((void *)start, end - start, MADV_POPULATE_READ);
+#endif
+    for (uintptr_t page = start; !populated && page < end; page += page_size) {
+      (void)*(const volatile char *)page;
+    }
+  }
+  return 1;
+}
+#endif
+
+// Read the pages of a loaded library into memory, if supported, ignoring failures.
+static void
+prefault_library(void * lib_pointer)
+{
+#if defined(SHARED_LIBRARY_PREFAULT_SEGMENTS)
+  struct link_map * map = NULL;
+  if (dlinfo(lib_pointer, RTLD_DI_LINKMAP, &map) != 0 || NULL == map) {
+    return;
+  }
+  prefault_context_t context = {map->l_addr, map->l_name};
+  (void)dl_iterate_phdr(prefault_segments, &context);
+#elif defined(_WIN32)
+  // The module handle is the address the image is mapped at, starting with its headers.
+  const char * image = (const char *)lib_pointer;
+  const IMAGE_DOS_HEADER * dos_header = (const IMAGE_DOS_HEADER *)image;
+  const IMAGE_NT_HEADERS * nt_headers = (const IMAGE_NT_HEADERS *)(image + dos_header->e_lfanew);
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = lib_pointer;
+  range.NumberOfBytes = nt_headers->OptionalHeader.SizeOfImage;
+  (void)PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  (void)lib_pointer;
+#endif
+}
+
+rcutils_ret_t
+rcutils_load_shared_library(
+  rcutils_shared_library_t * lib,
+  const char * library_path,
+  rcutils_allocator_t allocator)
+{
+  return rcutils_load_shared_library_with_flags(
+    lib, library_path, RCUTILS_SHARED_LIBRARY_DEFAULT_FLAGS, allocator);
+}
+
+rcutils_ret_t
+rcutils_load_shared_library_with_flags(
+  rcutils_shared_library_t * lib,
+  const char * library_path,
+  uint32_t flags,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_BAD_ALLOC);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_ERROR);
+
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(lib, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(library_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(&allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != lib->lib_pointer) {
+    RCUTILS_SET_ERROR_MSG("lib argument is not zero-initialized");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u != (flags & ~(uint32_t)SHARED_LIBRARY_ALL_FLAGS)) {
+    RCUTILS_SET_ERROR_MSG("unknown shared library flags");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  lib->allocator = allocator;
+
+  // Delegate library path resolution to dynamic linker.
+
+  // Since the given library path might be relative, let the dynamic
+  // linker search for the binary object in all standard locations and
+  // current process space (if already loaded) first.
+  // Then lookup its full path with the handle obtained.
+  // See POSIX dlopen() API and Windows' LoadLibrary() API documentation
+  // for further reference.
+
+#ifndef _WIN32
+  int mode = 0u != (flags & RCUTILS_SHARED_LIBRARY_BIND_NOW) ? RTLD_NOW : RTLD_LAZY;
+  mode |= 0u != (flags & RCUTILS_SHARED_LIBRARY_GLOBAL) ? RTLD_GLOBAL : RTLD_LOCAL;
+  lib->lib_pointer = dlopen(library_path, mode);
+  if (NULL == lib->lib_pointer) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("dlopen error: %s", dlerror());
+    return RCUTILS_RET_ERROR;
+  }
+#else
+  // LoadLibrary() always binds the imports of the library, and has no global symbol namespace.
+  HMODULE module = LoadLibrary(library_path);
+  if (!module) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "LoadLibrary error: %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
   }
   lib->lib_pointer = (void *)module;
+#endif  // _WIN32
+  if (0u != (flags & RCUTILS_SHARED_LIBRARY_PREFAULT)) {
+    prefault_library(lib->lib_pointer);
+  }
+
+  // Only the first load of a library resolves its path, which the others copy.
+  symbol_cache_t * cache = acquire_symbol_cache(lib->lib_pointer);
+  if (NULL != cache) {
+    spin_lock(&g_registry_lock);
+    bool resolved = NULL != cache->library_path;
+    if (resolved) {
+      lib->library_path = rcutils_strdup(cache->library_path, lib->allocator);
+    }
+    spin_unlock(&g_registry_lock);
+    if (resolved && NULL != lib->library_path) {
+      lib->symbol_cache = cache;
+      return RCUTILS_RET_OK;
+    }
+    if (resolved) {
+      RCUTILS_SET_ERROR_MSG("unable to allocate memory");
+      ret = RCUTILS_RET_BAD_ALLOC;
+      goto fail;
+    }
+  }
 
+  ret = resolve_library_path(lib->lib_pointer, library_path, lib->allocator, &lib->library_path);
+  if (RCUTILS_RET_OK != ret) {
+    goto fail;
+  }
+  if (NULL != cache) {
+    // This fails harmlessly, leaving the next load to resolve the path again.
+    char * resolved_path = rcutils_strdup(lib->library_path, rcutils_get_default_allocator());
+    spin_lock(&g_registry_lock);
+    if (NULL == cache->library_path) {
+      cache->library_path = resolved_path;
+      resolved_path = NULL;
+    }
+    spin_unlock(&g_registry_lock);
+    rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+    default_allocator.deallocate(resolved_path, default_allocator.state);
+  }
+  lib->symbol_cache = cache;
   return RCUTILS_RET_OK;
+
 fail:
+  if (NULL != cache) {
+    release_symbol_cache(cache);
+  }
+#ifndef _WIN32
+  if (dlclose(lib->lib_pointer) != 0) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "dlclose error: %s\n", dlerror());
+  }
+#else
   if (!FreeLibrary(module)) {
     RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
       "FreeLibrary error: %lu\n", GetLastError());
   }
-  return ret;
 #endif  // _WIN32
+  lib->lib_pointer = NULL;
+  return ret;
 }
 
 void *
@@ -205,24 +813,7 @@ rcutils_get_symbol(const rcutils_shared_library_t * lib, const char * symbol_nam
     return NULL;
   }
 
-#ifndef _WIN32
-  void * lib_symbol = dlsym(lib->lib_pointer, symbol_name);
-  char * error = dlerror();
-  if (error != NULL) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Error getting the symbol '%s'. Error '%s'",
-      symbol_name, error);
-    return NULL;
-  }
-#else
-  void * lib_symbol = GetProcAddress((HINSTANCE)(lib->lib_pointer), symbol_name);
-  if (lib_symbol == NULL) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Error getting the symbol '%s'. Error '%d'",
-      symbol_name, GetLastError());
-    return NULL;
-  }
-#endif  // _WIN32
+  void * lib_symbol = find_symbol(lib, symbol_name);
   if (!lib_symbol) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "symbol '%s' does not exist in the library '%s'",
@@ -239,17 +830,68 @@ rcutils_has_symbol(const rcutils_shared_library_t * lib, const char * symbol_nam
     return false;
   }
 
-#ifndef _WIN32
-  // the correct way to test for an error is to call dlerror() to clear any old error conditions,
-  // then call dlsym(), and then call dlerror() again, saving its return value into a variable,
-  // and check whether this saved value is not NULL.
-  dlerror(); /* Clear any existing error */
-  void * lib_symbol = dlsym(lib->lib_pointer, symbol_name);
-  return dlerror() == NULL && lib_symbol != 0;
-#else
-  void * lib_symbol = GetProcAddress((HINSTANCE)(lib->lib_pointer), symbol_name);
-  return lib_symbol != NULL;
-#endif  // _WIN32
+  return find_symbol(lib, symbol_name) != NULL;
+}
+
+rcutils_ret_t
+rcutils_get_symbols(
+  const rcutils_shared_library_t * lib,
+  const char * const * symbol_names,
+  size_t count,
+  void ** symbols)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(lib, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(lib->lib_pointer, RCUTILS_RET_INVALID_ARGUMENT);
+  if (count > 0u) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(symbol_names, RCUTILS_RET_INVALID_ARGUMENT);
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(symbols, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(symbol_names[i], RCUTILS_RET_INVALID_ARGUMENT);
+  }
+
+  symbol_cache_t * cache = lib->symbol_cache;
+  for (size_t begin = 0; begin < count; ) {
+    // The indices of the symbols which aren't in the cache yet.
+    size_t missing[SHARED_LIBRARY_SYMBOL_BATCH];
+    size_t missing_count = 0u;
+    size_t i = begin;
+    if (NULL != cache) {
+      rcutils_mutex_lock(&cache->lock);
+    }
+    for (; i < count && missing_count < SHARED_LIBRARY_SYMBOL_BATCH; ++i) {
+      if (NULL == cache ||
+        RCUTILS_RET_OK != rcutils_hash_map_get(&cache->symbols, &symbol_names[i], &symbols[i]))
+      {
+        missing[missing_count++] = i;
+      }
+    }
+    if (NULL != cache) {
+      rcutils_mutex_unlock(&cache->lock);
+    }
+
+    for (size_t j = 0; j < missing_count; ++j) {
+      symbols[missing[j]] = lookup_symbol(lib, symbol_names[missing[j]]);
+    }
+    if (NULL != cache && missing_count > 0u) {
+      rcutils_mutex_lock(&cache->lock);
+      for (size_t j = 0; j < missing_count; ++j) {
+        remember_symbol(cache, symbol_names[missing[j]], symbols[missing[j]]);
+      }
+      rcutils_mutex_unlock(&cache->lock);
+    }
+    begin = i;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == symbols[i]) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "symbol '%s' does not exist in the library '%s'",
+        symbol_names[i], lib->library_path);
+      return RCUTILS_RET_NOT_FOUND;
+    }
+  }
+  return RCUTILS_RET_OK;
 }
 
 rcutils_ret_t
@@ -261,6 +903,10 @@ rcutils_unload_shared_library(rcutils_shared_library_t * lib)
   RCUTILS_CHECK_ALLOCATOR(&lib->allocator, return RCUTILS_RET_INVALID_ARGUMENT);
 
   rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (NULL != lib->symbol_cache) {
+    release_symbol_cache(lib->symbol_cache);
+    lib->symbol_cache = NULL;
+  }
 #ifndef _WIN32
   // The function dlclose() returns 0 on success, and nonzero on error.
   int error_code = dlclose(lib->lib_pointer);
@@ -340,6 +986,253 @@ rcutils_get_platform_library_name(
   return RCUTILS_RET_OK;
 }
 
+// No dependency of the library failed to load.
+#define LOAD_NO_FAILED_DEPENDENCY SIZE_MAX
+
+// The state shared by the threads of rcutils_load_shared_libraries().
+typedef struct load_scheduler_s
+{
+  rcutils_shared_library_load_t * loads;
+  size_t count;
+  rcutils_allocator_t allocator;
+  // The dependents of library i are dependents[dependents_offsets[i]:dependents_offsets[i + 1]].
+  size_t * dependents_offsets;
+  size_t * dependents;
+  // The number of dependencies of each library which are not loaded yet.
+  size_t * pending_dependencies;
+  // A dependency of each library which failed to load, or LOAD_NO_FAILED_DEPENDENCY.
+  size_t * failed_dependencies;
+  // The queue of the libraries which can be loaded, each library being pushed once.
+  size_t * ready;
+  size_t ready_begin;
+  size_t ready_end;
+  size_t done_count;
+  rcutils_mutex_t lock;
+  rcutils_condition_variable_t ready_changed;
+} load_scheduler_t;
+
+// Queue the libraries without dependencies, and return whether all the libraries can then be
+// loaded, i.e. whether there is no dependency cycle.
+static bool load_scheduler_start(load_scheduler_t * scheduler)
+{
+  size_t count = scheduler->count;
+  for (size_t i = 0; i < count; ++i) {
+    scheduler->pending_dependencies[i] = scheduler->loads[i].dependency_count;
+    if (0u == scheduler->pending_dependencies[i]) {
+      scheduler->ready[scheduler->ready_end++] = i;
+    }
+  }
+  // Walk the libraries in the order they'd be loaded in, to check that they all are.
+  for (size_t visited = 0; visited < scheduler->ready_end; ++visited) {
+    size_t index = scheduler->ready[visited];
+    for (size_t j = scheduler->dependents_offsets[index];
+      j < scheduler->dependents_offsets[index + 1]; ++j)
+    {
+      if (0u == --scheduler->pending_dependencies[scheduler->dependents[j]]) {
+        scheduler->ready[scheduler->ready_end++] = scheduler->dependents[j];
+      }
+    }
+  }
+  if (scheduler->ready_end < count) {
+    return false;
+  }
+
+  scheduler->ready_end = 0u;
+  for (size_t i = 0; i < count; ++i) {
+    scheduler->pending_dependencies[i] = scheduler->loads[i].dependency_count;
+    scheduler->failed_dependencies[i] = LOAD_NO_FAILED_DEPENDENCY;
+    if (0u == scheduler->pending_dependencies[i]) {
+      scheduler->ready[scheduler->ready_end++] = i;
+    }
+  }
+  return true;
+}
+
+static void load_shared_libraries_work(void * arg)
+{
+  load_scheduler_t * scheduler = arg;
+  rcutils_mutex_lock(&scheduler->lock);
+  while (scheduler->done_count < scheduler->count) {
+    if (scheduler->ready_begin == scheduler->ready_end) {
+      rcutils_condition_variable_wait_for(&scheduler->ready_changed, &scheduler->lock, 1000u);
+      continue;
+    }
+    size_t index = scheduler->ready[scheduler->ready_begin++];
+    size_t failed_dependency = scheduler->failed_dependencies[index];
+    rcutils_mutex_unlock(&scheduler->lock);
+
+    rcutils_shared_library_load_t * load = &scheduler->loads[index];
+    if (LOAD_NO_FAILED_DEPENDENCY != failed_dependency) {
+      load->ret = RCUTILS_RET_ERROR;
+      int written = rcutils_snprintf(
+        load->error.str, sizeof(load->error.str), "dependency '%s' failed to load",
+        scheduler->loads[failed_dependency].library_path);
+      (void)written;
+    } else {
+      load->ret = rcutils_load_shared_library_with_flags(
+        &load->library, load->library_path, load->flags, scheduler->allocator);
+      if (RCUTILS_RET_OK != load->ret) {
+        load->error = rcutils_get_error_string();
+        rcutils_reset_error();
+      }
+    }
+
+    rcutils_mutex_lock(&scheduler->lock);
+    for (size_t j = scheduler->dependents_offsets[index];
+      j < scheduler->dependents_offsets[index + 1]; ++j)
+    {
+      size_t dependent = scheduler->dependents[j];
+      if (RCUTILS_RET_OK != load->ret &&
+        LOAD_NO_FAILED_DEPENDENCY == scheduler->failed_dependencies[dependent])
+      {
+        scheduler->failed_dependencies[dependent] = index;
+      }
+      if (0u == --scheduler->pending_dependencies[dependent]) {
+        scheduler->ready[scheduler->ready_end++] = dependent;
+      }
+    }
+    ++scheduler->done_count;
+    rcutils_condition_variable_notify_all(&scheduler->ready_changed);
+  }
+  rcutils_mutex_unlock(&scheduler->lock);
+}
+
+rcutils_ret_t
+rcutils_load_shared_libraries(
+  rcutils_shared_library_load_t * loads,
+  size_t count,
+  size_t thread_count,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_BAD_ALLOC);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_ERROR);
+
+  RCUTILS_CHECK_ALLOCATOR(&allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u == count) {
+    return RCUTILS_RET_OK;
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(loads, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t dependency_count = 0u;
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == loads[i].library_path) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("library %zu has no path", i);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    if (NULL != loads[i].library.lib_pointer) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "library '%s' is not zero-initialized", loads[i].library_path);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    if (loads[i].dependency_count > 0u && NULL == loads[i].dependencies) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "the dependencies of library '%s' are NULL", loads[i].library_path);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    for (size_t j = 0; j < loads[i].dependency_count; ++j) {
+      if (loads[i].dependencies[j] >= count) {
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "dependency %zu of library '%s' is out of range", loads[i].dependencies[j],
+          loads[i].library_path);
+        return RCUTILS_RET_INVALID_ARGUMENT;
+      }
+    }
+    dependency_count += loads[i].dependency_count;
+  }
+
+  load_scheduler_t scheduler;
+  memset(&scheduler, 0, sizeof(scheduler));
+  scheduler.loads = loads;
+  scheduler.count = count;
+  scheduler.allocator = allocator;
+  size_t * buffer = allocator.allocate(
+    (5u * count + 1u + dependency_count) * sizeof(size_t), allocator.state);
+  if (NULL == buffer) {
+    RCUTILS_SET_ERROR_MSG("unable to allocate memory");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  scheduler.dependents_offsets = buffer;
+  scheduler.pending_dependencies = buffer + count + 1u;
+  scheduler.failed_dependencies = scheduler.pending_dependencies + count;
+  scheduler.ready = scheduler.failed_dependencies + count;
+  scheduler.dependents = scheduler.ready + count;
+  // Count the dependents of each library, and lay them out after each other.
+  memset(scheduler.dependents_offsets, 0, (count + 1u) * sizeof(size_t));
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < loads[i].dependency_count; ++j) {
+      ++scheduler.dependents_offsets[loads[i].dependencies[j] + 1u];
+    }
+  }
+  for (size_t i = 0; i < count; ++i) {
+    scheduler.dependents_offsets[i + 1u] += scheduler.dependents_offsets[i];
+  }
+  // Use the failed dependencies as the number of dependents laid out so far.
+  memset(scheduler.failed_dependencies, 0, count * sizeof(size_t));
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < loads[i].dependency_count; ++j) {
+      size_t dependency = loads[i].dependencies[j];
+      scheduler.dependents[scheduler.dependents_offsets[dependency] +
+        scheduler.failed_dependencies[dependency]++] = i;
+    }
+  }
+  if (!load_scheduler_start(&scheduler)) {
+    allocator.deallocate(buffer, allocator.state);
+    RCUTILS_SET_ERROR_MSG("the dependencies of the libraries have a cycle");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&scheduler.lock)) {
+    allocator.deallocate(buffer, allocator.state);
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK != rcutils_condition_variable_init(&scheduler.ready_changed)) {
+    rcutils_mutex_fini(&scheduler.lock);
+    allocator.deallocate(buffer, allocator.state);
+    return RCUTILS_RET_ERROR;
+  }
+
+  if (0u == thread_count) {
+    thread_count = rcutils_thread_get_processor_count();
+  }
+  if (thread_count > count) {
+    thread_count = count;
+  }
+  // The libraries are loaded by the calling thread alone if the threads can't be started.
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  if (thread_count > 1u) {
+    rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+    options.thread_count = thread_count - 1u;
+    if (RCUTILS_RET_OK == rcutils_thread_pool_init(&pool, &options, &allocator)) {
+      for (size_t i = 0; i + 1u < thread_count; ++i) {
+        if (RCUTILS_RET_OK !=
+          rcutils_thread_pool_submit(&pool, load_shared_libraries_work, &scheduler))
+        {
+          rcutils_reset_error();
+          break;
+        }
+      }
+    } else {
+      rcutils_reset_error();
+    }
+  }
+  load_shared_libraries_work(&scheduler);
+  if (NULL != pool.impl && RCUTILS_RET_OK != rcutils_thread_pool_fini(&pool)) {
+    rcutils_reset_error();
+  }
+  rcutils_condition_variable_fini(&scheduler.ready_changed);
+  rcutils_mutex_fini(&scheduler.lock);
+  allocator.deallocate(buffer, allocator.state);
+
+  for (size_t i = 0; i < count; ++i) {
+    if (RCUTILS_RET_OK != loads[i].ret) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "library '%s' failed to load: %s", loads[i].library_path, loads[i].error.str);
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
 bool
 rcutils_is_shared_library_loaded(rcutils_shared_library_t * lib)
 {
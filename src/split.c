@@ -17,6 +17,7 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +44,8 @@ rcutils_split(
     return RCUTILS_RET_OK;
   }
   string_array->allocator = allocator;
+  string_array->arena = NULL;
+  string_array->arena_size = 0;
 
   size_t string_size = strlen(str);
 
@@ -89,7 +92,9 @@ rcutils_split(
           string_array->size = token_counter;
           goto fail;
         }
-        snprintf(string_array->data[token_counter], (rhs - lhs + 1), "%s", str + lhs);
+        // not snprintf, which would scan the rest of str for every token
+        memcpy(string_array->data[token_counter], str + lhs, rhs - lhs);
+        string_array->data[token_counter][rhs - lhs] = '\0';
         ++token_counter;
       }
       lhs = rhs;
@@ -104,7 +109,12 @@ rcutils_split(
   } else {
     string_array->data[token_counter] =
       allocator.allocate((rhs - lhs + 2) * sizeof(char), allocator.state);
-    snprintf(string_array->data[token_counter], (rhs - lhs + 1), "%s", str + lhs);
+    if (NULL == string_array->data[token_counter]) {
+      string_array->size = token_counter;
+      goto fail;
+    }
+    memcpy(string_array->data[token_counter], str + lhs, rhs - lhs);
+    string_array->data[token_counter][rhs - lhs] = '\0';
   }
 
   return RCUTILS_RET_OK;
@@ -121,6 +131,72 @@ fail:
   return RCUTILS_RET_ERROR;
 }
 
+rcutils_ret_t
+rcutils_split_packed(
+  const char * str,
+  char delimiter,
+  rcutils_allocator_t allocator,
+  rcutils_string_array_t * string_array)
+{
+  if (NULL == string_array) {
+    RCUTILS_SET_ERROR_MSG("string_array is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  *string_array = rcutils_get_zero_initialized_string_array();
+  if (NULL == str) {
+    return RCUTILS_RET_OK;
+  }
+
+  // Count the non-empty tokens and the bytes they take, with their terminating null bytes.
+  size_t token_count = 0;
+  size_t arena_size = 0;
+  bool in_token = false;
+  const char * c;
+  for (c = str; '\0' != *c; ++c) {
+    if (*c == delimiter) {
+      in_token = false;
+      continue;
+    }
+    if (!in_token) {
+      in_token = true;
+      ++token_count;
+      ++arena_size;
+    }
+    ++arena_size;
+  }
+  if (0 == token_count) {
+    return RCUTILS_RET_OK;
+  }
+
+  rcutils_ret_t ret =
+    rcutils_string_array_init_packed(string_array, token_count, arena_size, &allocator);
+  if (RCUTILS_RET_OK != ret) {
+    // rcutils_string_array_init_packed should have already set an error message
+    return ret;
+  }
+
+  char * next = string_array->arena;
+  size_t token_index = 0;
+  for (c = str; '\0' != *c; ) {
+    if (*c == delimiter) {
+      ++c;
+      continue;
+    }
+    const char * token_end = c;
+    while ('\0' != *token_end && *token_end != delimiter) {
+      ++token_end;
+    }
+    size_t token_length = (size_t)(token_end - c);
+    memcpy(next, c, token_length);
+    next[token_length] = '\0';
+    string_array->data[token_index++] = next;
+    next += token_length + 1;
+    c = token_end;
+  }
+
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_split_last(
   const char * str,
@@ -214,6 +290,67 @@ fail:
   return result_error;
 }
 
+rcutils_split_iterator_t
+rcutils_get_split_iterator(const char * str, char delimiter)
+{
+  rcutils_split_iterator_t iterator = {str, delimiter};
+  return iterator;
+}
+
+bool
+rcutils_split_iterator_next(rcutils_split_iterator_t * iterator, rcutils_split_token_t * token)
+{
+  if (NULL == iterator || NULL == token || NULL == iterator->rest) {
+    return false;
+  }
+  const char * c = iterator->rest;
+  while (*c == iterator->delimiter && '\0' != *c) {
+    ++c;
+  }
+  if ('\0' == *c) {
+    iterator->rest = NULL;
+    return false;
+  }
+  const char * token_end = c;
+  while ('\0' != *token_end && *token_end != iterator->delimiter) {
+    ++token_end;
+  }
+  token->data = c;
+  token->length = (size_t)(token_end - c);
+  iterator->rest = token_end;
+  return true;
+}
+
+rcutils_ret_t
+rcutils_split_tokens(
+  const char * str,
+  char delimiter,
+  rcutils_split_token_t * tokens,
+  size_t capacity,
+  size_t * count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RCUTILS_RET_INVALID_ARGUMENT);
+  if (capacity > 0) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(tokens, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+
+  rcutils_split_iterator_t iterator = rcutils_get_split_iterator(str, delimiter);
+  rcutils_split_token_t token;
+  size_t token_count = 0;
+  while (rcutils_split_iterator_next(&iterator, &token)) {
+    if (token_count < capacity) {
+      tokens[token_count] = token;
+    }
+    ++token_count;
+  }
+  *count = token_count;
+  if (token_count > capacity) {
+    RCUTILS_SET_ERROR_MSG("not enough space for the tokens of the string");
+    return RCUTILS_RET_NOT_ENOUGH_SPACE;
+  }
+  return RCUTILS_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
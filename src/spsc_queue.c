@@ -0,0 +1,292 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/spsc_queue.h"
+#include "rcutils/macros.h"
+
+// The fields written by the producer and by the consumer are at least this far apart, so that
+// they never share a cache line, whatever the alignment of the queue.
+#define SPSC_QUEUE_CACHE_LINE_SIZE 64
+
+typedef struct rcutils_spsc_queue_impl_s
+{
+  uint8_t * slots;
+  size_t mask;
+  size_t element_size;
+  rcutils_allocator_t allocator;
+  char shared_padding[SPSC_QUEUE_CACHE_LINE_SIZE];
+  // The index of the next element to pop, only written by the consumer.
+  atomic_size_t head;
+  // The tail as last read by the consumer, so that it only reads the tail again when the queue
+  // looks empty.
+  size_t cached_tail;
+  char head_padding[SPSC_QUEUE_CACHE_LINE_SIZE];
+  // The index of the next element to push, only written by the producer.
+  atomic_size_t tail;
+  // The head as last read by the producer, so that it only reads the head again when the queue
+  // looks full.
+  size_t cached_head;
+  char tail_padding[SPSC_QUEUE_CACHE_LINE_SIZE];
+} rcutils_spsc_queue_impl_t;
+
+#define SPSC_QUEUE_VALIDATE_QUEUE(queue) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(queue, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == queue->impl) { \
+    RCUTILS_SET_ERROR_MSG("queue is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+static size_t load_index(atomic_size_t * index, memory_order order)
+{
+  size_t result = 0;
+  rcutils_atomic_load_explicit(index, result, order);
+  return result;
+}
+
+// Copies count elements to the slots from the given index on, wrapping around the ring.
+static void spsc_queue_copy_in(
+  rcutils_spsc_queue_impl_t * impl, size_t index, const uint8_t * elements, size_t count)
+{
+  size_t first = index & impl->mask;
+  size_t until_end = impl->mask + 1 - first;
+  size_t count_until_end = count < until_end ? count : until_end;
+  memcpy(impl->slots + first * impl->element_size, elements, count_until_end * impl->element_size);
+  memcpy(
+    impl->slots, elements + count_until_end * impl->element_size,
+    (count - count_until_end) * impl->element_size);
+}
+
+// Copies count elements from the slots from the given index on, wrapping around the ring.
+static void spsc_queue_copy_out(
+  const rcutils_spsc_queue_impl_t * impl, size_t index, uint8_t * elements, size_t count)
+{
+  size_t first = index & impl->mask;
+  size_t until_end = impl->mask + 1 - first;
+  size_t count_until_end = count < until_end ? count : until_end;
+  memcpy(elements, impl->slots + first * impl->element_size, count_until_end * impl->element_size);
+  memcpy(
+    elements + count_until_end * impl->element_size, impl->slots,
+    (count - count_until_end) * impl->element_size);
+}
+
+static size_t spsc_queue_push(
+  rcutils_spsc_queue_impl_t * impl, const void * elements, size_t count)
+{
+  const size_t capacity = impl->mask + 1;
+  const size_t tail = load_index(&impl->tail, memory_order_relaxed);
+  size_t free_slots = capacity - (tail - impl->cached_head);
+  if (free_slots < count) {
+    // Acquire the slots the consumer is done with.
+    impl->cached_head = load_index(&impl->head, memory_order_acquire);
+    free_slots = capacity - (tail - impl->cached_head);
+  }
+  if (count > free_slots) {
+    count = free_slots;
+  }
+  if (0u != count) {
+    spsc_queue_copy_in(impl, tail, (const uint8_t *)elements, count);
+    rcutils_atomic_store_explicit(&impl->tail, tail + count, memory_order_release);
+  }
+  return count;
+}
+
+static size_t spsc_queue_pop(rcutils_spsc_queue_impl_t * impl, void * elements, size_t count)
+{
+  const size_t head = load_index(&impl->head, memory_order_relaxed);
+  size_t available = impl->cached_tail - head;
+  if (available < count) {
+    // Acquire the elements the producer has published.
+    impl->cached_tail = load_index(&impl->tail, memory_order_acquire);
+    available = impl->cached_tail - head;
+  }
+  if (count > available) {
+    count = available;
+  }
+  if (0u != count) {
+    spsc_queue_copy_out(impl, head, (uint8_t *)elements, count);
+    rcutils_atomic_store_explicit(&impl->head, head + count, memory_order_release);
+  }
+  return count;
+}
+
+rcutils_spsc_queue_t
+rcutils_get_zero_initialized_spsc_queue(void)
+{
+  static rcutils_spsc_queue_t zero_initialized_queue = {NULL};
+  return zero_initialized_queue;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_init(
+  rcutils_spsc_queue_t * queue,
+  size_t capacity,
+  size_t element_size,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(queue, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u == capacity) {
+    RCUTILS_SET_ERROR_MSG("capacity cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == element_size) {
+    RCUTILS_SET_ERROR_MSG("element_size cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  size_t rounded_capacity = 1u;
+  while (rounded_capacity < capacity) {
+    if (rounded_capacity > SIZE_MAX / 2u) {
+      RCUTILS_SET_ERROR_MSG("capacity is too large");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    rounded_capacity <<= 1u;
+  }
+  if (rounded_capacity > SIZE_MAX / element_size) {
+    RCUTILS_SET_ERROR_MSG("capacity times element_size is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_spsc_queue_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_spsc_queue_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for queue impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->slots = allocator->allocate(rounded_capacity * element_size, allocator->state);
+  if (NULL == impl->slots) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for queue slots");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->mask = rounded_capacity - 1u;
+  impl->element_size = element_size;
+  impl->allocator = *allocator;
+  atomic_init(&impl->head, (size_t)0);
+  impl->cached_tail = 0u;
+  atomic_init(&impl->tail, (size_t)0);
+  impl->cached_head = 0u;
+  queue->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_fini(rcutils_spsc_queue_t * queue)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(queue, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_spsc_queue_impl_t * impl = queue->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl->slots, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  queue->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_push(rcutils_spsc_queue_t * queue, const void * element)
+{
+  SPSC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(element, RCUTILS_RET_INVALID_ARGUMENT);
+  if (1u != spsc_queue_push(queue->impl, element, 1u)) {
+    return RCUTILS_RET_NOT_ENOUGH_SPACE;
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_push_many(
+  rcutils_spsc_queue_t * queue,
+  const void * elements,
+  size_t count,
+  size_t * pushed)
+{
+  SPSC_QUEUE_VALIDATE_QUEUE(queue);
+  if (0u != count) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(elements, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pushed, RCUTILS_RET_INVALID_ARGUMENT);
+  *pushed = 0u == count ? 0u : spsc_queue_push(queue->impl, elements, count);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_pop(rcutils_spsc_queue_t * queue, void * element)
+{
+  SPSC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(element, RCUTILS_RET_INVALID_ARGUMENT);
+  if (1u != spsc_queue_pop(queue->impl, element, 1u)) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_pop_many(
+  rcutils_spsc_queue_t * queue,
+  void * elements,
+  size_t max_count,
+  size_t * popped)
+{
+  SPSC_QUEUE_VALIDATE_QUEUE(queue);
+  if (0u != max_count) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(elements, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(popped, RCUTILS_RET_INVALID_ARGUMENT);
+  *popped = 0u == max_count ? 0u : spsc_queue_pop(queue->impl, elements, max_count);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_get_capacity(const rcutils_spsc_queue_t * queue, size_t * capacity)
+{
+  SPSC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(capacity, RCUTILS_RET_INVALID_ARGUMENT);
+  *capacity = queue->impl->mask + 1u;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_spsc_queue_get_size(const rcutils_spsc_queue_t * queue, size_t * size)
+{
+  SPSC_QUEUE_VALIDATE_QUEUE(queue);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(size, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_spsc_queue_impl_t * impl = queue->impl;
+  // Read the head first, so that the tail is never behind it.
+  const size_t head = load_index(&impl->head, memory_order_acquire);
+  const size_t tail = load_index(&impl->tail, memory_order_acquire);
+  const size_t capacity = impl->mask + 1u;
+  *size = tail - head < capacity ? tail - head : capacity;
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
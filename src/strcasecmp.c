@@ -22,6 +22,10 @@ extern "C"
 
 #include "rcutils/strcasecmp.h"
 
+// The C library implementations are used as is: they are vectorized where it matters, e.g.
+// glibc compares 16 or 32 characters at a time, reading past the end of the strings within a
+// page, which portable code can't do and which makes them faster than a word at a time.
+
 int
 rcutils_strcasecmp(
   const char * s1,
@@ -17,11 +17,14 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
+#include "rcutils/types/hash_map.h"
 #include "rcutils/types/string_array.h"
 #include "rcutils/types/rcutils_ret.h"
 
@@ -31,6 +34,8 @@ rcutils_get_zero_initialized_string_array(void)
   static rcutils_string_array_t array = {
     .size = 0,
     .data = NULL,
+    .arena = NULL,
+    .arena_size = 0,
   };
   array.allocator = rcutils_get_zero_initialized_allocator();
   return array;
@@ -54,6 +59,8 @@ rcutils_string_array_init(
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
   string_array->size = size;
+  string_array->arena = NULL;
+  string_array->arena_size = 0;
   string_array->data = allocator->zero_allocate(size, sizeof(char *), allocator->state);
   if (NULL == string_array->data && 0 != size) {
     RCUTILS_SET_ERROR_MSG("failed to allocate string array");
@@ -63,6 +70,165 @@ rcutils_string_array_init(
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_string_array_init_packed(
+  rcutils_string_array_t * string_array,
+  size_t size,
+  size_t arena_size,
+  const rcutils_allocator_t * allocator)
+{
+  rcutils_ret_t ret = rcutils_string_array_init(string_array, size, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    // rcutils_string_array_init should have already set an error message
+    return ret;
+  }
+  if (0 == arena_size) {
+    return RCUTILS_RET_OK;
+  }
+  string_array->arena = allocator->allocate(arena_size, allocator->state);
+  if (NULL == string_array->arena) {
+    allocator->deallocate(string_array->data, allocator->state);
+    *string_array = rcutils_get_zero_initialized_string_array();
+    RCUTILS_SET_ERROR_MSG("failed to allocate string array arena");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  string_array->arena_size = arena_size;
+  return RCUTILS_RET_OK;
+}
+
+// The number of bytes the views take as null terminated strings, or false if it overflows.
+static bool
+get_views_size(const rcutils_string_view_t * views, size_t count, size_t * size)
+{
+  size_t total = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == views[i].data && 0 != views[i].length) {
+      RCUTILS_SET_ERROR_MSG("string view data is null");
+      return false;
+    }
+    if (views[i].length >= SIZE_MAX - total) {
+      RCUTILS_SET_ERROR_MSG("string views are too large");
+      return false;
+    }
+    total += views[i].length + 1;
+  }
+  *size = total;
+  return true;
+}
+
+// Copy the views back to back from the given position of the arena, and point the entries at them.
+static void
+copy_views(char ** entries, char * next, const rcutils_string_view_t * views, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    if (0 != views[i].length) {
+      memcpy(next, views[i].data, views[i].length);
+    }
+    next[views[i].length] = '\0';
+    entries[i] = next;
+    next += views[i].length + 1;
+  }
+}
+
+rcutils_ret_t
+rcutils_string_array_init_from_views(
+  rcutils_string_array_t * string_array,
+  const rcutils_string_view_t * views,
+  size_t count,
+  const rcutils_allocator_t * allocator)
+{
+  if (0 != count) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(views, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  size_t arena_size = 0;
+  if (!get_views_size(views, count, &arena_size)) {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  rcutils_ret_t ret = rcutils_string_array_init_packed(
+    string_array, count, arena_size, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    // rcutils_string_array_init_packed should have already set an error message
+    return ret;
+  }
+  copy_views(string_array->data, string_array->arena, views, count);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_string_array_append_views(
+  rcutils_string_array_t * string_array,
+  const rcutils_string_view_t * views,
+  size_t count)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_array, "string_array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0 == count) {
+    return RCUTILS_RET_OK;
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(views, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_allocator_t * allocator = &string_array->allocator;
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+  size_t added_size = 0;
+  if (!get_views_size(views, count, &added_size)) {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (count > SIZE_MAX / sizeof(char *) - string_array->size ||
+    added_size > SIZE_MAX - string_array->arena_size)
+  {
+    RCUTILS_SET_ERROR_MSG("string views are too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  // The entries beyond the size are not part of the array until both allocations succeeded.
+  char ** new_data = allocator->reallocate(
+    string_array->data, (string_array->size + count) * sizeof(char *), allocator->state);
+  if (NULL == new_data) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate string array");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  string_array->data = new_data;
+
+  const uintptr_t old_arena = (uintptr_t)string_array->arena;
+  const size_t old_arena_size = string_array->arena_size;
+  char * new_arena = allocator->reallocate(
+    string_array->arena, old_arena_size + added_size, allocator->state);
+  if (NULL == new_arena) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate string array arena");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (0 != old_arena && (uintptr_t)new_arena != old_arena) {
+    // The strings allocated on their own were allocated before the arena was moved, so only
+    // the entries which pointed into the arena are within its former bounds.
+    for (size_t i = 0; i < string_array->size; ++i) {
+      const uintptr_t address = (uintptr_t)string_array->data[i];
+      if (NULL != string_array->data[i] && address >= old_arena &&
+        address - old_arena < old_arena_size)
+      {
+        string_array->data[i] = new_arena + (address - old_arena);
+      }
+    }
+  }
+  string_array->arena = new_arena;
+  string_array->arena_size = old_arena_size + added_size;
+
+  copy_views(string_array->data + string_array->size, new_arena + old_arena_size, views, count);
+  string_array->size += count;
+  return RCUTILS_RET_OK;
+}
+
+// Whether the string is stored in the arena of the string array, rather than on its own.
+static bool
+is_in_arena(const rcutils_string_array_t * string_array, const char * string)
+{
+  if (NULL == string_array->arena || NULL == string) {
+    return false;
+  }
+  uintptr_t begin = (uintptr_t)string_array->arena;
+  uintptr_t address = (uintptr_t)string;
+  return address >= begin && address - begin < string_array->arena_size;
+}
+
 rcutils_ret_t
 rcutils_string_array_fini(rcutils_string_array_t * string_array)
 {
@@ -73,7 +239,7 @@ rcutils_string_array_fini(rcutils_string_array_t * string_array)
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
 
-  if (NULL == string_array->data) {
+  if (NULL == string_array->data && NULL == string_array->arena) {
     return RCUTILS_RET_OK;
   }
 
@@ -83,13 +249,18 @@ rcutils_string_array_fini(rcutils_string_array_t * string_array)
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
   size_t i;
-  for (i = 0; i < string_array->size; ++i) {
-    allocator->deallocate(string_array->data[i], allocator->state);
+  for (i = 0; NULL != string_array->data && i < string_array->size; ++i) {
+    if (!is_in_arena(string_array, string_array->data[i])) {
+      allocator->deallocate(string_array->data[i], allocator->state);
+    }
     string_array->data[i] = NULL;
   }
   allocator->deallocate(string_array->data, allocator->state);
+  allocator->deallocate(string_array->arena, allocator->state);
   string_array->data = NULL;
   string_array->size = 0;
+  string_array->arena = NULL;
+  string_array->arena_size = 0;
 
   return RCUTILS_RET_OK;
 }
@@ -142,6 +313,73 @@ rcutils_string_array_cmp(
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_string_array_equal(
+  const rcutils_string_array_t * lhs,
+  const rcutils_string_array_t * rhs,
+  bool * equal)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    lhs, "lhs string array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    rhs, "rhs string array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    equal, "equal argument is null", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (lhs->size != rhs->size) {
+    *equal = false;
+    return RCUTILS_RET_OK;
+  }
+  if (lhs->size > 0) {
+    RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+      lhs->data, "lhs->data is null", return RCUTILS_RET_INVALID_ARGUMENT);
+    RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+      rhs->data, "rhs->data is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  }
+
+  *equal = false;
+  for (size_t i = 0; i < lhs->size; ++i) {
+    const char * left = lhs->data[i];
+    const char * right = rhs->data[i];
+    if (left == right) {
+      continue;
+    }
+    if (NULL == left || NULL == right || 0 != strcmp(left, right)) {
+      return RCUTILS_RET_OK;
+    }
+  }
+  *equal = true;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_string_array_hash(const rcutils_string_array_t * string_array, size_t * hash)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_array, "string_array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    hash, "hash argument is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (string_array->size > 0) {
+    RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+      string_array->data, "string_array->data is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  }
+
+  // Combined like boost::hash_combine(), so that the order of the strings matters.
+  size_t result = string_array->size;
+  for (size_t i = 0; i < string_array->size; ++i) {
+    size_t string_hash = 0;
+    if (NULL != string_array->data[i]) {
+      const size_t length = strlen(string_array->data[i]);
+      string_hash = rcutils_hash_map_string_fast_hashn(string_array->data[i], length) ^ length;
+      // Tell apart empty strings from empty entries.
+      ++string_hash;
+    }
+    result ^= string_hash + (size_t)UINT64_C(0x9e3779b97f4a7c15) + (result << 6) + (result >> 2);
+  }
+  *hash = result;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_string_array_resize(
   rcutils_string_array_t * string_array,
@@ -170,6 +408,12 @@ rcutils_string_array_resize(
     memcpy(
       to_reclaim.data, &string_array->data[new_size],
       to_reclaim.size * sizeof(char *));
+    // The strings in the arena are only reclaimed with the arena.
+    for (size_t i = 0; i < to_reclaim.size; ++i) {
+      if (is_in_arena(string_array, to_reclaim.data[i])) {
+        to_reclaim.data[i] = NULL;
+      }
+    }
   }
 
   char ** new_data = allocator->reallocate(
@@ -198,6 +442,80 @@ rcutils_string_array_resize(
   return rcutils_string_array_fini(&to_reclaim);
 }
 
+rcutils_ret_t
+rcutils_string_array_shrink_to_fit(rcutils_string_array_t * string_array)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_array, "string_array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (NULL == string_array->arena) {
+    // the array of strings has no spare capacity, and the strings are allocated on their own
+    return RCUTILS_RET_OK;
+  }
+
+  rcutils_allocator_t * allocator = &string_array->allocator;
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  // Entries of a packed string array may have been replaced since, leaving strings in the arena
+  // which nothing points to anymore.
+  size_t used_size = 0;
+  for (size_t i = 0; i < string_array->size; ++i) {
+    if (is_in_arena(string_array, string_array->data[i])) {
+      used_size += strlen(string_array->data[i]) + 1;
+    }
+  }
+  if (used_size >= string_array->arena_size) {
+    return RCUTILS_RET_OK;
+  }
+
+  char * new_arena = NULL;
+  if (0 != used_size) {
+    new_arena = allocator->allocate(used_size, allocator->state);
+    if (NULL == new_arena) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate string array arena");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    char * next = new_arena;
+    for (size_t i = 0; i < string_array->size; ++i) {
+      if (is_in_arena(string_array, string_array->data[i])) {
+        size_t length = strlen(string_array->data[i]) + 1;
+        memcpy(next, string_array->data[i], length);
+        string_array->data[i] = next;
+        next += length;
+      }
+    }
+  }
+  allocator->deallocate(string_array->arena, allocator->state);
+  string_array->arena = new_arena;
+  string_array->arena_size = used_size;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_string_array_get_allocated_size(
+  const rcutils_string_array_t * string_array, size_t * allocated_size)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_array, "string_array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    allocated_size, "allocated_size is null", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  size_t size = string_array->arena_size;
+  if (NULL != string_array->data) {
+    size += string_array->size * sizeof(char *);
+    for (size_t i = 0; i < string_array->size; ++i) {
+      // strings allocated on their own are counted by their length, which is what rcutils_strdup()
+      // allocates
+      if (NULL != string_array->data[i] && !is_in_arena(string_array, string_array->data[i])) {
+        size += strlen(string_array->data[i]) + 1;
+      }
+    }
+  }
+  *allocated_size = size;
+  return RCUTILS_RET_OK;
+}
+
 int
 rcutils_string_array_sort_compare(const void * lhs, const void * rhs)
 {
@@ -211,6 +529,118 @@ rcutils_string_array_sort_compare(const void * lhs, const void * rhs)
   return strcmp(left, right);
 }
 
+// Below this many strings, sorting them by insertion is faster than partitioning them
+#define STRING_ARRAY_SORT_INSERTION_THRESHOLD 16
+
+static void swap_strings(char ** lhs, char ** rhs)
+{
+  char * tmp = *lhs;
+  *lhs = *rhs;
+  *rhs = tmp;
+}
+
+// The length of the prefix all the strings have in common after the given depth.
+static size_t common_prefix_length(char ** strings, size_t count, size_t depth)
+{
+  const char * first = strings[0] + depth;
+  size_t length = strlen(first);
+  for (size_t i = 1; i < count && length > 0; ++i) {
+    const char * string = strings[i] + depth;
+    size_t j = 0;
+    while (j < length && string[j] == first[j]) {
+      ++j;
+    }
+    length = j;
+  }
+  return length;
+}
+
+// Sort strings which are all the same up to the given depth, with multikey quicksort.
+static void sort_strings_from(char ** strings, size_t count, size_t depth)
+{
+  while (count > 1) {
+    if (count < STRING_ARRAY_SORT_INSERTION_THRESHOLD) {
+      for (size_t i = 1; i < count; ++i) {
+        char * string = strings[i];
+        size_t j = i;
+        for (; j > 0 && strcmp(strings[j - 1] + depth, string + depth) > 0; --j) {
+          strings[j] = strings[j - 1];
+        }
+        strings[j] = string;
+      }
+      return;
+    }
+
+    // Partition the strings by their character at the depth, around the median of three.
+    unsigned char first = (unsigned char)strings[0][depth];
+    unsigned char middle = (unsigned char)strings[count / 2][depth];
+    unsigned char last = (unsigned char)strings[count - 1][depth];
+    unsigned char pivot = middle;
+    if ((middle <= first) == (first <= last)) {
+      pivot = first;
+    } else if ((middle <= last) == (last <= first)) {
+      pivot = last;
+    }
+    size_t less_end = 0;
+    size_t greater_begin = count;
+    size_t i = 0;
+    while (i < greater_begin) {
+      unsigned char c = (unsigned char)strings[i][depth];
+      if (c < pivot) {
+        swap_strings(&strings[less_end++], &strings[i++]);
+      } else if (c > pivot) {
+        swap_strings(&strings[i], &strings[--greater_begin]);
+      } else {
+        ++i;
+      }
+    }
+
+    // The strings equal up to the end of the pivot are sorted, unless it is the terminator.
+    char ** segments[3] = {strings, strings + less_end, strings + greater_begin};
+    size_t counts[3] = {less_end, greater_begin - less_end, count - greater_begin};
+    size_t depths[3] = {depth, depth + 1, depth};
+    if ('\0' == pivot) {
+      counts[1] = 0;
+    } else if (counts[1] == count) {
+      // All the strings share the character, so skip the rest of their common prefix at once.
+      depths[1] += common_prefix_length(strings, count, depth + 1);
+    }
+    // Recurse into the two smaller segments, which bounds the recursion depth, and loop on
+    // the largest one.
+    size_t largest = 0;
+    for (size_t k = 1; k < 3; ++k) {
+      if (counts[k] > counts[largest]) {
+        largest = k;
+      }
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      if (k != largest) {
+        sort_strings_from(segments[k], counts[k], depths[k]);
+      }
+    }
+    strings = segments[largest];
+    count = counts[largest];
+    depth = depths[largest];
+  }
+}
+
+rcutils_ret_t
+rcutils_string_array_sort(rcutils_string_array_t * string_array)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_array, "string_array is null", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  // Move the empty entries to the end, keeping the order of the others.
+  size_t count = 0;
+  for (size_t i = 0; i < string_array->size; ++i) {
+    if (NULL != string_array->data[i]) {
+      swap_strings(&string_array->data[count++], &string_array->data[i]);
+    }
+  }
+  sort_strings_from(string_array->data, count, 0);
+  return RCUTILS_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,20 +27,45 @@ extern "C"
 #include "./common.h"
 #include "rcutils/strdup.h"
 #include "rcutils/format_string.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/types/hash_map.h"
 #include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/string_pool.h"
 
 typedef struct key_value_pair
 {
   char * key;
   char * value;
+  // The length and hash of the key, set along with it
+  size_t key_length;
+  size_t key_hash;
 } key_value_pair_t;
 
+// The storage shared by string maps copied with rcutils_string_map_copy_shared(), allocated at
+// once with the key value pairs, the index, and the keys and values they point to after it
+typedef struct shared_storage
+{
+  atomic_size_t references;
+  rcutils_allocator_t allocator;
+} shared_storage_t;
+
 typedef struct rcutils_string_map_impl_s
 {
+  // With shared storage, the key value pairs and the index point into it, and must be copied
+  // before the map is modified, or NULL otherwise
+  shared_storage_t * shared;
   key_value_pair_t * key_value_pairs;
+  // An open addressing index of the keys, with linear probing, where each slot holds the index of
+  // a key value pair plus one, or 0 if it is empty, and which is kept at most half full
+  size_t * index;
+  size_t index_capacity;
+  // No key value pair before this one is unused
+  size_t first_unused;
   size_t capacity;
   size_t size;
   rcutils_allocator_t allocator;
+  // The pool the keys are interned in, or NULL if they are allocated with the allocator
+  rcutils_string_pool_t * string_pool;
 } rcutils_string_map_impl_t;
 
 rcutils_string_map_t
@@ -51,6 +76,184 @@ rcutils_get_zero_initialized_string_map(void)
   return zero_initialized_string_map;
 }
 
+// Copy a key, either into the string pool of the map or with its allocator.
+static char *
+__copy_key(rcutils_string_map_impl_t * string_map_impl, const char * key, size_t key_length)
+{
+  if (NULL == string_map_impl->string_pool) {
+    return rcutils_strndup(key, key_length, string_map_impl->allocator);
+  }
+  const char * interned_key = NULL;
+  if (RCUTILS_RET_OK != rcutils_string_pool_internn(
+      string_map_impl->string_pool, key, key_length, &interned_key, NULL))
+  {
+    rcutils_reset_error();
+    return NULL;
+  }
+  // interned keys are never modified, nor deallocated by the map
+  return (char *)interned_key;
+}
+
+// Deallocate a key copied by __copy_key(), unless it is interned.
+static void
+__free_key(rcutils_string_map_impl_t * string_map_impl, char * key)
+{
+  if (NULL == string_map_impl->string_pool) {
+    string_map_impl->allocator.deallocate(key, string_map_impl->allocator.state);
+  }
+}
+
+// Drop a reference to shared storage, deallocating it with the last one.
+static void
+__release_shared_storage(shared_storage_t * shared)
+{
+  size_t previous_references;
+  rcutils_atomic_fetch_add(&shared->references, previous_references, SIZE_MAX);
+  if (1u == previous_references) {
+    shared->allocator.deallocate(shared, shared->allocator.state);
+  }
+}
+
+// Deallocate, or stop sharing, the key value pairs and the index of a map, which must have no
+// keys and values of its own, leaving it with no capacity.
+static void
+__drop_storage(rcutils_string_map_impl_t * string_map_impl)
+{
+  rcutils_allocator_t allocator = string_map_impl->allocator;
+  if (NULL != string_map_impl->shared) {
+    __release_shared_storage(string_map_impl->shared);
+    string_map_impl->shared = NULL;
+  } else {
+    assert(0 == string_map_impl->size);  // defensive, should not happen
+    allocator.deallocate(string_map_impl->key_value_pairs, allocator.state);
+    allocator.deallocate(string_map_impl->index, allocator.state);
+  }
+  string_map_impl->key_value_pairs = NULL;
+  string_map_impl->index = NULL;
+  string_map_impl->index_capacity = 0;
+  string_map_impl->first_unused = 0;
+  string_map_impl->capacity = 0;
+  string_map_impl->size = 0;
+}
+
+// Stop sharing the storage of a map before modifying it, copying its keys and values into
+// storage of its own if copy_entries is true, or leaving it empty otherwise.
+static rcutils_ret_t
+__unshare_storage(rcutils_string_map_impl_t * string_map_impl, bool copy_entries)
+{
+  if (NULL == string_map_impl->shared) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = string_map_impl->allocator;
+  size_t capacity = string_map_impl->capacity;
+  key_value_pair_t * key_value_pairs =
+    allocator.allocate(capacity * sizeof(key_value_pair_t), allocator.state);
+  size_t * index = allocator.allocate(
+    string_map_impl->index_capacity * sizeof(size_t), allocator.state);
+  if (NULL == key_value_pairs || NULL == index) {
+    allocator.deallocate(key_value_pairs, allocator.state);
+    allocator.deallocate(index, allocator.state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for string_map key-value pairs");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < capacity; ++i) {
+    key_value_pairs[i] = string_map_impl->key_value_pairs[i];
+    if (!copy_entries || NULL == key_value_pairs[i].key) {
+      key_value_pairs[i].key = NULL;
+      key_value_pairs[i].value = NULL;
+      continue;
+    }
+    key_value_pairs[i].key =
+      __copy_key(string_map_impl, key_value_pairs[i].key, key_value_pairs[i].key_length);
+    key_value_pairs[i].value = rcutils_strdup(key_value_pairs[i].value, allocator);
+    if (NULL == key_value_pairs[i].key || NULL == key_value_pairs[i].value) {
+      for (size_t j = 0; j <= i; ++j) {
+        if (NULL != key_value_pairs[j].key) {
+          __free_key(string_map_impl, key_value_pairs[j].key);
+        }
+        allocator.deallocate(key_value_pairs[j].value, allocator.state);
+      }
+      allocator.deallocate(key_value_pairs, allocator.state);
+      allocator.deallocate(index, allocator.state);
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for string_map keys and values");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  if (copy_entries) {
+    // the pairs keep their positions, so the index stays the same
+    memcpy(index, string_map_impl->index, string_map_impl->index_capacity * sizeof(size_t));
+  } else {
+    memset(index, 0, string_map_impl->index_capacity * sizeof(size_t));
+    string_map_impl->size = 0;
+    string_map_impl->first_unused = 0;
+  }
+  __release_shared_storage(string_map_impl->shared);
+  string_map_impl->shared = NULL;
+  string_map_impl->key_value_pairs = key_value_pairs;
+  string_map_impl->index = index;
+  return RCUTILS_RET_OK;
+}
+
+// Move the key value pairs, the index, and the keys and values of a map into shared storage.
+static rcutils_ret_t
+__share_storage(rcutils_string_map_impl_t * string_map_impl)
+{
+  if (NULL != string_map_impl->shared) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = string_map_impl->allocator;
+  size_t capacity = string_map_impl->capacity;
+  size_t strings_size = 0;
+  for (size_t i = 0; i < capacity; ++i) {
+    if (NULL != string_map_impl->key_value_pairs[i].key) {
+      if (NULL == string_map_impl->string_pool) {
+        strings_size += string_map_impl->key_value_pairs[i].key_length + 1;
+      }
+      strings_size += strlen(string_map_impl->key_value_pairs[i].value) + 1;
+    }
+  }
+  // The structs which follow each other only hold pointers and sizes, so are all aligned
+  size_t pairs_size = capacity * sizeof(key_value_pair_t);
+  size_t index_size = string_map_impl->index_capacity * sizeof(size_t);
+  shared_storage_t * shared = allocator.allocate(
+    sizeof(shared_storage_t) + pairs_size + index_size + strings_size, allocator.state);
+  if (NULL == shared) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for shared string_map storage");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  rcutils_atomic_store(&shared->references, 1u);
+  shared->allocator = allocator;
+  key_value_pair_t * key_value_pairs = (key_value_pair_t *)(shared + 1);
+  size_t * index = (size_t *)((char *)key_value_pairs + pairs_size);
+  char * strings = (char *)index + index_size;
+  for (size_t i = 0; i < capacity; ++i) {
+    key_value_pair_t * pair = &string_map_impl->key_value_pairs[i];
+    key_value_pairs[i] = *pair;
+    if (NULL == pair->key) {
+      continue;
+    }
+    if (NULL == string_map_impl->string_pool) {
+      // interned keys stay where they are
+      memcpy(strings, pair->key, pair->key_length + 1);
+      key_value_pairs[i].key = strings;
+      strings += pair->key_length + 1;
+      allocator.deallocate(pair->key, allocator.state);
+    }
+    size_t value_size = strlen(pair->value) + 1;
+    memcpy(strings, pair->value, value_size);
+    key_value_pairs[i].value = strings;
+    strings += value_size;
+    allocator.deallocate(pair->value, allocator.state);
+  }
+  memcpy(index, string_map_impl->index, index_size);
+  allocator.deallocate(string_map_impl->key_value_pairs, allocator.state);
+  allocator.deallocate(string_map_impl->index, allocator.state);
+  string_map_impl->shared = shared;
+  string_map_impl->key_value_pairs = key_value_pairs;
+  string_map_impl->index = index;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_string_map_init(
   rcutils_string_map_t * string_map,
@@ -69,10 +272,15 @@ rcutils_string_map_init(
     RCUTILS_SET_ERROR_MSG("failed to allocate memory for string map impl struct");
     return RCUTILS_RET_BAD_ALLOC;
   }
+  string_map->impl->shared = NULL;
   string_map->impl->key_value_pairs = NULL;
+  string_map->impl->index = NULL;
+  string_map->impl->index_capacity = 0;
+  string_map->impl->first_unused = 0;
   string_map->impl->capacity = 0;
   string_map->impl->size = 0;
   string_map->impl->allocator = allocator;
+  string_map->impl->string_pool = NULL;
   rcutils_ret_t ret = rcutils_string_map_reserve(string_map, initial_capacity);
   if (ret != RCUTILS_RET_OK) {
     // error mesage is already set, clean up and return the ret
@@ -83,6 +291,23 @@ rcutils_string_map_init(
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_string_map_init_with_string_pool(
+  rcutils_string_map_t * string_map,
+  size_t initial_capacity,
+  rcutils_allocator_t allocator,
+  rcutils_string_pool_t * string_pool)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string_pool, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_ret_t ret = rcutils_string_map_init(string_map, initial_capacity, allocator);
+  if (ret != RCUTILS_RET_OK) {
+    // error message already set
+    return ret;
+  }
+  string_map->impl->string_pool = string_pool;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_string_map_fini(rcutils_string_map_t * string_map)
 {
@@ -90,6 +315,10 @@ rcutils_string_map_fini(rcutils_string_map_t * string_map)
   if (NULL == string_map->impl) {
     return RCUTILS_RET_OK;
   }
+  if (NULL != string_map->impl->shared) {
+    // the keys and values belong to the shared storage, so there is nothing to clear
+    __drop_storage(string_map->impl);
+  }
   rcutils_ret_t ret = rcutils_string_map_clear(string_map);
   if (ret != RCUTILS_RET_OK) {
     // error message already set
@@ -134,11 +363,98 @@ rcutils_string_map_get_size(const rcutils_string_map_t * string_map, size_t * si
   return RCUTILS_RET_OK;
 }
 
+// Return the slot of the index where the probing for a hash starts.
+static size_t
+__get_index_slot(const rcutils_string_map_impl_t * string_map_impl, size_t key_hash)
+{
+  return key_hash & (string_map_impl->index_capacity - 1);
+}
+
+// Add the key value pair at the given position to the index.
+static void
+__index_key_value_pair(rcutils_string_map_impl_t * string_map_impl, size_t position)
+{
+  size_t mask = string_map_impl->index_capacity - 1;
+  size_t slot = __get_index_slot(
+    string_map_impl, string_map_impl->key_value_pairs[position].key_hash);
+  while (0 != string_map_impl->index[slot]) {
+    slot = (slot + 1) & mask;
+  }
+  string_map_impl->index[slot] = position + 1;
+}
+
+// Remove the key value pair at the given position from the index, moving the following pairs
+// of the probe sequence back, so that no deleted markers are needed.
+static void
+__unindex_key_value_pair(rcutils_string_map_impl_t * string_map_impl, size_t position)
+{
+  size_t mask = string_map_impl->index_capacity - 1;
+  size_t slot = __get_index_slot(
+    string_map_impl, string_map_impl->key_value_pairs[position].key_hash);
+  while (string_map_impl->index[slot] != position + 1) {
+    slot = (slot + 1) & mask;
+  }
+  size_t next = slot;
+  for (;; ) {
+    next = (next + 1) & mask;
+    if (0 == string_map_impl->index[next]) {
+      break;
+    }
+    // A pair can only move back to an empty slot which comes before it, from where it started
+    size_t home = __get_index_slot(
+      string_map_impl,
+      string_map_impl->key_value_pairs[string_map_impl->index[next] - 1].key_hash);
+    if (((next - home) & mask) >= ((next - slot) & mask)) {
+      string_map_impl->index[slot] = string_map_impl->index[next];
+      slot = next;
+    }
+  }
+  string_map_impl->index[slot] = 0;
+}
+
+// Index all the key value pairs, into an index with no entries yet.
+static void
+__index_key_value_pairs(rcutils_string_map_impl_t * string_map_impl)
+{
+  string_map_impl->first_unused = string_map_impl->capacity;
+  for (size_t i = 0; i < string_map_impl->capacity; ++i) {
+    if (NULL != string_map_impl->key_value_pairs[i].key) {
+      __index_key_value_pair(string_map_impl, i);
+    } else if (i < string_map_impl->first_unused) {
+      string_map_impl->first_unused = i;
+    }
+  }
+}
+
+// Move the key value pairs in front of the unused ones, keeping their order, which leaves the
+// index to be rebuilt.
+static void
+__compact_key_value_pairs(rcutils_string_map_impl_t * string_map_impl)
+{
+  size_t used = 0;
+  for (size_t i = 0; i < string_map_impl->capacity; ++i) {
+    key_value_pair_t * pair = &string_map_impl->key_value_pairs[i];
+    if (NULL == pair->key) {
+      continue;
+    }
+    if (i != used) {
+      string_map_impl->key_value_pairs[used] = *pair;
+      pair->key = NULL;
+      pair->value = NULL;
+    }
+    ++used;
+  }
+}
+
 static void
 __remove_key_and_value_at_index(rcutils_string_map_impl_t * string_map_impl, size_t index)
 {
   rcutils_allocator_t allocator = string_map_impl->allocator;
-  allocator.deallocate(string_map_impl->key_value_pairs[index].key, allocator.state);
+  __unindex_key_value_pair(string_map_impl, index);
+  if (index < string_map_impl->first_unused) {
+    string_map_impl->first_unused = index;
+  }
+  __free_key(string_map_impl, string_map_impl->key_value_pairs[index].key);
   string_map_impl->key_value_pairs[index].key = NULL;
   allocator.deallocate(string_map_impl->key_value_pairs[index].value, allocator.state);
   string_map_impl->key_value_pairs[index].value = NULL;
@@ -152,6 +468,7 @@ rcutils_string_map_reserve(rcutils_string_map_t * string_map, size_t capacity)
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(
     string_map->impl, "invalid string map", return RCUTILS_RET_STRING_MAP_INVALID);
   rcutils_allocator_t allocator = string_map->impl->allocator;
+  rcutils_ret_t ret = RCUTILS_RET_OK;
   // short circuit, if requested capacity is less than the size of the map
   if (capacity < string_map->impl->size) {
     // set the capacity to the current size instead
@@ -163,24 +480,57 @@ rcutils_string_map_reserve(rcutils_string_map_t * string_map, size_t capacity)
   } else if (capacity == 0) {
     // if the requested capacity is zero, then make sure the existing keys and values are free'd
     // size is known to be 0 here because of the recursive call above.
-    allocator.deallocate(string_map->impl->key_value_pairs, allocator.state);
-    string_map->impl->key_value_pairs = NULL;
+    __drop_storage(string_map->impl);
     // falls through to normal function end
   } else {
     // if the capacity non-zero and different, use realloc to increase/shrink the size
     // note that realloc when the pointer is NULL is the same as malloc
     // note also that realloc will shrink the space if needed
 
-    // ensure that reallocate won't overflow SIZE_MAX
-    if (capacity > (SIZE_MAX / sizeof(key_value_pair_t))) {
+    // ensure that reallocate won't overflow SIZE_MAX, nor the index, which is twice as large
+    if (capacity > (SIZE_MAX / sizeof(key_value_pair_t)) ||
+      capacity > (SIZE_MAX / 4 / sizeof(size_t)))
+    {
       RCUTILS_SET_ERROR_MSG("requested capacity for string_map too large");
       return RCUTILS_RET_BAD_ALLOC;
     }
 
+    // shared storage cannot be resized, so copy it first
+    ret = __unshare_storage(string_map->impl, true);
+    if (ret != RCUTILS_RET_OK) {
+      // error message already set
+      return ret;
+    }
+
+    // allocate the index first, so that nothing changes if allocating fails
+    size_t index_capacity = 2;
+    while (index_capacity < 2 * capacity) {
+      index_capacity *= 2;
+    }
+    size_t * new_index = allocator.zero_allocate(index_capacity, sizeof(size_t), allocator.state);
+    if (NULL == new_index) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for string_map index");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+
+    // keys may have been unset anywhere, so move the pairs in front of the new capacity before
+    // shrinking, so that none of them is cut off
+    const bool shrinking = capacity < string_map->impl->capacity;
+    if (shrinking) {
+      __compact_key_value_pairs(string_map->impl);
+    }
+
     // resize the keys and values, assigning the result only if it succeeds
     key_value_pair_t * new_key_value_pairs = allocator.reallocate(
       string_map->impl->key_value_pairs, capacity * sizeof(key_value_pair_t), allocator.state);
     if (NULL == new_key_value_pairs) {
+      allocator.deallocate(new_index, allocator.state);
+      if (shrinking) {
+        // the pairs moved, so index them again where they are now
+        memset(
+          string_map->impl->index, 0, string_map->impl->index_capacity * sizeof(size_t));
+        __index_key_value_pairs(string_map->impl);
+      }
       RCUTILS_SET_ERROR_MSG("failed to allocate memory for string_map key-value pairs");
       return RCUTILS_RET_BAD_ALLOC;
     }
@@ -193,18 +543,73 @@ rcutils_string_map_reserve(rcutils_string_map_t * string_map, size_t capacity)
         string_map->impl->key_value_pairs[i].value = NULL;
       }
     }
+
+    // rebuild the index of the keys
+    allocator.deallocate(string_map->impl->index, allocator.state);
+    string_map->impl->index = new_index;
+    string_map->impl->index_capacity = index_capacity;
+    string_map->impl->capacity = capacity;
+    __index_key_value_pairs(string_map->impl);
     // falls through to normal function end
   }
   string_map->impl->capacity = capacity;
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_string_map_shrink_to_fit(rcutils_string_map_t * string_map)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string_map, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_map->impl, "invalid string map", return RCUTILS_RET_STRING_MAP_INVALID);
+  if (NULL != string_map->impl->shared) {
+    // shared storage is already as small as it gets, and copying it would take more memory
+    return RCUTILS_RET_OK;
+  }
+  return rcutils_string_map_reserve(string_map, string_map->impl->size);
+}
+
+rcutils_ret_t
+rcutils_string_map_get_allocated_size(
+  const rcutils_string_map_t * string_map, size_t * allocated_size)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string_map, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    string_map->impl, "invalid string map", return RCUTILS_RET_STRING_MAP_INVALID);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocated_size, RCUTILS_RET_INVALID_ARGUMENT);
+  const rcutils_string_map_impl_t * string_map_impl = string_map->impl;
+  size_t size = sizeof(rcutils_string_map_impl_t) +
+    string_map_impl->capacity * sizeof(key_value_pair_t) +
+    string_map_impl->index_capacity * sizeof(size_t);
+  if (NULL != string_map_impl->shared) {
+    size += sizeof(shared_storage_t);
+  }
+  // the keys and values are either each allocated on their own or copied into the shared
+  // storage, and take as much room in both cases, while interned keys belong to the pool
+  for (size_t i = 0; i < string_map_impl->capacity; ++i) {
+    const key_value_pair_t * pair = &string_map_impl->key_value_pairs[i];
+    if (NULL == pair->key) {
+      continue;
+    }
+    if (NULL == string_map_impl->string_pool) {
+      size += pair->key_length + 1;
+    }
+    size += strlen(pair->value) + 1;
+  }
+  *allocated_size = size;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_string_map_clear(rcutils_string_map_t * string_map)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(string_map, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(
     string_map->impl, "invalid string map", return RCUTILS_RET_STRING_MAP_INVALID);
+  if (NULL != string_map->impl->shared) {
+    // the keys and values belong to the shared storage, so just stop sharing it
+    return __unshare_storage(string_map->impl, false);
+  }
 
   for (size_t i = 0; i < string_map->impl->capacity; ++i) {
     if (string_map->impl->key_value_pairs[i].key != NULL) {
@@ -240,24 +645,36 @@ rcutils_string_map_set(rcutils_string_map_t * string_map, const char * key, cons
   return ret;
 }
 
+// Return the length of a key, which ends at key_length or at its terminating null character.
+static size_t
+__get_key_length(const char * key, size_t key_length)
+{
+  const char * end = memchr(key, '\0', key_length);
+  return NULL == end ? key_length : (size_t)(end - key);
+}
+
+// Look up a key of the given length, as returned by __get_key_length(), with the given hash.
 static bool
 __get_index_of_key_if_exists(
-  rcutils_string_map_impl_t * string_map_impl,
+  const rcutils_string_map_impl_t * string_map_impl,
   const char * key,
   size_t key_length,
+  size_t key_hash,
   size_t * index)
 {
-  size_t i = 0;
-  for (; i < string_map_impl->capacity; ++i) {
-    if (NULL == string_map_impl->key_value_pairs[i].key) {
-      continue;
-    }
-    size_t cmp_count = strlen(string_map_impl->key_value_pairs[i].key);
-    if (key_length > cmp_count) {
-      cmp_count = key_length;
-    }
-    if (strncmp(key, string_map_impl->key_value_pairs[i].key, cmp_count) == 0) {
-      *index = i;
+  if (0 == string_map_impl->index_capacity) {
+    return false;
+  }
+  size_t mask = string_map_impl->index_capacity - 1;
+  for (size_t slot = __get_index_slot(string_map_impl, key_hash);
+    0 != string_map_impl->index[slot]; slot = (slot + 1) & mask)
+  {
+    const key_value_pair_t * pair =
+      &string_map_impl->key_value_pairs[string_map_impl->index[slot] - 1];
+    if (pair->key_hash == key_hash && pair->key_length == key_length &&
+      memcmp(pair->key, key, key_length) == 0)
+    {
+      *index = string_map_impl->index[slot] - 1;
       return true;
     }
   }
@@ -276,26 +693,39 @@ rcutils_string_map_set_no_resize(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
   rcutils_allocator_t allocator = string_map->impl->allocator;
+  rcutils_ret_t ret = __unshare_storage(string_map->impl, true);
+  if (ret != RCUTILS_RET_OK) {
+    // error message already set
+    return ret;
+  }
   size_t key_index;
   bool should_free_key_on_error = false;
-  bool key_exists = __get_index_of_key_if_exists(string_map->impl, key, strlen(key), &key_index);
+  size_t key_length = strlen(key);
+  size_t key_hash = rcutils_hash_map_string_fast_hashn(key, key_length);
+  bool key_exists = __get_index_of_key_if_exists(
+    string_map->impl, key, key_length, key_hash, &key_index);
   if (!key_exists) {
     // create space for, and store the key if it doesn't exist yet
     assert(string_map->impl->size <= string_map->impl->capacity);  // defensive, should not happen
     if (string_map->impl->size == string_map->impl->capacity) {
       return RCUTILS_RET_NOT_ENOUGH_SPACE;
     }
-    for (key_index = 0; key_index < string_map->impl->capacity; ++key_index) {
+    for (key_index = string_map->impl->first_unused; key_index < string_map->impl->capacity;
+      ++key_index)
+    {
       if (NULL == string_map->impl->key_value_pairs[key_index].key) {
         break;
       }
     }
     assert(key_index < string_map->impl->capacity);  // defensive, this should not happen
-    string_map->impl->key_value_pairs[key_index].key = rcutils_strdup(key, allocator);
+    string_map->impl->key_value_pairs[key_index].key =
+      __copy_key(string_map->impl, key, key_length);
     if (NULL == string_map->impl->key_value_pairs[key_index].key) {
       RCUTILS_SET_ERROR_MSG("failed to allocate memory for key");
       return RCUTILS_RET_BAD_ALLOC;
     }
+    string_map->impl->key_value_pairs[key_index].key_length = key_length;
+    string_map->impl->key_value_pairs[key_index].key_hash = key_hash;
     should_free_key_on_error = true;
   }
   // at this point the key is in the map, waiting for the value to set/overwritten
@@ -304,7 +734,7 @@ rcutils_string_map_set_no_resize(
   if (NULL == new_value) {
     RCUTILS_SET_ERROR_MSG("failed to allocate memory for value");
     if (should_free_key_on_error) {
-      allocator.deallocate(string_map->impl->key_value_pairs[key_index].key, allocator.state);
+      __free_key(string_map->impl, string_map->impl->key_value_pairs[key_index].key);
       string_map->impl->key_value_pairs[key_index].key = NULL;
     }
     return RCUTILS_RET_BAD_ALLOC;
@@ -316,6 +746,8 @@ rcutils_string_map_set_no_resize(
   }
   if (!key_exists) {
     // if the key didn't exist, then we had to add it, so increase the size
+    __index_key_value_pair(string_map->impl, key_index);
+    string_map->impl->first_unused = key_index + 1;
     string_map->impl->size++;
   }
   return RCUTILS_RET_OK;
@@ -329,10 +761,20 @@ rcutils_string_map_unset(rcutils_string_map_t * string_map, const char * key)
     string_map->impl, "invalid string map", return RCUTILS_RET_STRING_MAP_INVALID);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
   size_t key_index;
-  if (!__get_index_of_key_if_exists(string_map->impl, key, strlen(key), &key_index)) {
+  size_t key_length = strlen(key);
+  if (!__get_index_of_key_if_exists(
+      string_map->impl, key, key_length, rcutils_hash_map_string_fast_hashn(key, key_length),
+      &key_index))
+  {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("key '%s' not found", key);
     return RCUTILS_RET_STRING_KEY_NOT_FOUND;
   }
+  // the pairs keep their positions when unsharing the storage, so key_index stays valid
+  rcutils_ret_t ret = __unshare_storage(string_map->impl, true);
+  if (ret != RCUTILS_RET_OK) {
+    // error message already set
+    return ret;
+  }
   __remove_key_and_value_at_index(string_map->impl, key_index);
   return RCUTILS_RET_OK;
 }
@@ -356,7 +798,10 @@ rcutils_string_map_key_existsn(
     return false;
   }
   size_t key_index;
-  bool key_exists = __get_index_of_key_if_exists(string_map->impl, key, key_length, &key_index);
+  key_length = __get_key_length(key, key_length);
+  bool key_exists = __get_index_of_key_if_exists(
+    string_map->impl, key, key_length, rcutils_hash_map_string_fast_hashn(key, key_length),
+    &key_index);
   return key_exists;
 }
 
@@ -379,7 +824,11 @@ rcutils_string_map_getn(
     return NULL;
   }
   size_t key_index;
-  if (__get_index_of_key_if_exists(string_map->impl, key, key_length, &key_index)) {
+  key_length = __get_key_length(key, key_length);
+  if (__get_index_of_key_if_exists(
+      string_map->impl, key, key_length, rcutils_hash_map_string_fast_hashn(key, key_length),
+      &key_index))
+  {
     return string_map->impl->key_value_pairs[key_index].value;
   }
   return NULL;
@@ -398,20 +847,18 @@ rcutils_string_map_get_next_key(
   }
   size_t start_index = 0;
   if (key != NULL) {
-    // if given a key, try to find it
-    bool given_key_found = false;
+    // if given a key, try to find it, by looking up the string and checking that it is the key
+    size_t key_length = strlen(key);
     size_t i = 0;
-    for (; i < string_map->impl->capacity; ++i) {
-      if (string_map->impl->key_value_pairs[i].key == key) {
-        given_key_found = true;
-        // given key found at index i, start there + 1
-        start_index = i + 1;
-      }
-    }
-    if (!given_key_found) {
+    if (!__get_index_of_key_if_exists(
+        string_map->impl, key, key_length, rcutils_hash_map_string_fast_hashn(key, key_length), &i)
+      || string_map->impl->key_value_pairs[i].key != key)
+    {
       // given key not found, cannot return next key with that
       return NULL;
     }
+    // given key found at index i, start there + 1
+    start_index = i + 1;
   }
   // iterate through the storage and look for another non-NULL key to return
   size_t i = start_index;
@@ -454,6 +901,43 @@ rcutils_string_map_copy(
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_string_map_copy_shared(
+  rcutils_string_map_t * src_string_map,
+  rcutils_string_map_t * dst_string_map)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(src_string_map, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(dst_string_map, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    src_string_map->impl, "source string map is invalid", return RCUTILS_RET_STRING_MAP_INVALID);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    dst_string_map->impl, "destination string map is invalid",
+    return RCUTILS_RET_STRING_MAP_INVALID);
+  rcutils_string_map_impl_t * src = src_string_map->impl;
+  rcutils_string_map_impl_t * dst = dst_string_map->impl;
+  if (src == dst || 0 == src->size || 0 != dst->size) {
+    // there is nothing to share, or the copy must be merged with the existing keys and values
+    return rcutils_string_map_copy(src_string_map, dst_string_map);
+  }
+  rcutils_ret_t ret = __share_storage(src);
+  if (ret != RCUTILS_RET_OK) {
+    // error message already set
+    return ret;
+  }
+  __drop_storage(dst);
+  size_t previous_references;
+  rcutils_atomic_fetch_add(&src->shared->references, previous_references, 1u);
+  (void)previous_references;
+  dst->shared = src->shared;
+  dst->key_value_pairs = src->key_value_pairs;
+  dst->index = src->index;
+  dst->index_capacity = src->index_capacity;
+  dst->first_unused = src->first_unused;
+  dst->capacity = src->capacity;
+  dst->size = src->size;
+  return RCUTILS_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,317 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/string_pool.h"
+#include "rcutils/macros.h"
+
+// The strings are copied into blocks of at least this size, which are never reallocated
+#define STRING_POOL_BLOCK_SIZE 4096
+
+// An interned string, whose characters follow it
+typedef struct string_pool_entry_s
+{
+  size_t hash;
+  size_t length;
+} string_pool_entry_t;
+
+// A block holding entries, which follow it
+typedef struct string_pool_block_s
+{
+  struct string_pool_block_s * next;
+  size_t size;
+} string_pool_block_t;
+
+typedef struct rcutils_string_pool_impl_s
+{
+  rcutils_rwlock_t lock;
+  // An open addressing index of the entries, with linear probing, kept at most half full
+  string_pool_entry_t ** index;
+  size_t index_capacity;
+  size_t size;
+  // The block where entries are added, followed by the full ones
+  string_pool_block_t * blocks;
+  size_t block_used;
+  rcutils_allocator_t allocator;
+} rcutils_string_pool_impl_t;
+
+#define STRING_POOL_VALIDATE_STRING_POOL(pool) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pool, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == pool->impl) { \
+    RCUTILS_SET_ERROR_MSG("string pool is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+rcutils_string_pool_t
+rcutils_get_zero_initialized_string_pool(void)
+{
+  static rcutils_string_pool_t zero_initialized_string_pool = {NULL};
+  return zero_initialized_string_pool;
+}
+
+rcutils_ret_t
+rcutils_string_pool_init(
+  rcutils_string_pool_t * string_pool,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string_pool, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_string_pool_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_string_pool_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for string pool impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->index_capacity = 16;
+  impl->index = allocator->zero_allocate(
+    impl->index_capacity, sizeof(string_pool_entry_t *), allocator->state);
+  if (NULL == impl->index) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for string pool index");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (RCUTILS_RET_OK != rcutils_rwlock_init(&impl->lock)) {
+    allocator->deallocate(impl->index, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the lock of the string pool");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->size = 0;
+  impl->blocks = NULL;
+  impl->block_used = 0;
+  impl->allocator = *allocator;
+  string_pool->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_string_pool_fini(rcutils_string_pool_t * string_pool)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string_pool, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_string_pool_impl_t * impl = string_pool->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  while (NULL != impl->blocks) {
+    string_pool_block_t * next = impl->blocks->next;
+    allocator.deallocate(impl->blocks, allocator.state);
+    impl->blocks = next;
+  }
+  allocator.deallocate(impl->index, allocator.state);
+  rcutils_rwlock_fini(&impl->lock);
+  allocator.deallocate(impl, allocator.state);
+  string_pool->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_string_pool_get_size(const rcutils_string_pool_t * string_pool, size_t * size)
+{
+  STRING_POOL_VALIDATE_STRING_POOL(string_pool);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(size, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_rwlock_read_lock(&string_pool->impl->lock);
+  *size = string_pool->impl->size;
+  rcutils_rwlock_read_unlock(&string_pool->impl->lock);
+  return RCUTILS_RET_OK;
+}
+
+// Return the characters of an entry.
+static const char *
+string_pool_entry_string(const string_pool_entry_t * entry)
+{
+  return (const char *)(entry + 1);
+}
+
+// Return the slot of the index holding an equal string, or the empty slot where it would go.
+static size_t
+string_pool_find_slot(
+  const rcutils_string_pool_impl_t * impl, const char * string, size_t length, size_t hash)
+{
+  size_t mask = impl->index_capacity - 1;
+  size_t slot = hash & mask;
+  while (NULL != impl->index[slot]) {
+    const string_pool_entry_t * entry = impl->index[slot];
+    if (entry->hash == hash && entry->length == length &&
+      memcmp(string_pool_entry_string(entry), string, length) == 0)
+    {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+// Double the capacity of the index, which is kept at most half full.
+static rcutils_ret_t
+string_pool_grow_index(rcutils_string_pool_impl_t * impl)
+{
+  rcutils_allocator_t allocator = impl->allocator;
+  if (impl->index_capacity > SIZE_MAX / 2 / sizeof(string_pool_entry_t *)) {
+    RCUTILS_SET_ERROR_MSG("string pool index is too large");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  size_t index_capacity = impl->index_capacity * 2;
+  string_pool_entry_t ** index =
+    allocator.zero_allocate(index_capacity, sizeof(string_pool_entry_t *), allocator.state);
+  if (NULL == index) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for string pool index");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  size_t mask = index_capacity - 1;
+  for (size_t i = 0; i < impl->index_capacity; ++i) {
+    if (NULL != impl->index[i]) {
+      size_t slot = impl->index[i]->hash & mask;
+      while (NULL != index[slot]) {
+        slot = (slot + 1) & mask;
+      }
+      index[slot] = impl->index[i];
+    }
+  }
+  allocator.deallocate(impl->index, allocator.state);
+  impl->index = index;
+  impl->index_capacity = index_capacity;
+  return RCUTILS_RET_OK;
+}
+
+// Copy a string into a new entry, in the current block if it fits, or in a new block.
+static string_pool_entry_t *
+string_pool_add_entry(
+  rcutils_string_pool_impl_t * impl, const char * string, size_t length, size_t hash)
+{
+  rcutils_allocator_t allocator = impl->allocator;
+  if (length > SIZE_MAX - sizeof(string_pool_block_t) - 2 * sizeof(string_pool_entry_t)) {
+    RCUTILS_SET_ERROR_MSG("string is too long for the string pool");
+    return NULL;
+  }
+  // round up, so that the next entry is aligned too
+  size_t entry_size = sizeof(string_pool_entry_t) + length + 1;
+  entry_size += (sizeof(string_pool_entry_t) - entry_size % sizeof(string_pool_entry_t)) %
+    sizeof(string_pool_entry_t);
+  string_pool_entry_t * entry;
+  if (NULL != impl->blocks && impl->blocks->size - impl->block_used >= entry_size) {
+    entry = (string_pool_entry_t *)((char *)(impl->blocks + 1) + impl->block_used);
+    impl->block_used += entry_size;
+  } else {
+    size_t block_size = entry_size > STRING_POOL_BLOCK_SIZE ? entry_size : STRING_POOL_BLOCK_SIZE;
+    string_pool_block_t * block = allocator.allocate(
+      sizeof(string_pool_block_t) + block_size, allocator.state);
+    if (NULL == block) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for string pool block");
+      return NULL;
+    }
+    block->size = block_size;
+    entry = (string_pool_entry_t *)(block + 1);
+    if (NULL != impl->blocks && entry_size >= STRING_POOL_BLOCK_SIZE) {
+      // a long string fills a block of its own, so keep adding to the current block
+      block->next = impl->blocks->next;
+      impl->blocks->next = block;
+    } else {
+      block->next = impl->blocks;
+      impl->blocks = block;
+      impl->block_used = entry_size;
+    }
+  }
+  entry->hash = hash;
+  entry->length = length;
+  char * entry_string = (char *)(entry + 1);
+  memcpy(entry_string, string, length);
+  entry_string[length] = '\0';
+  return entry;
+}
+
+rcutils_ret_t
+rcutils_string_pool_intern(
+  rcutils_string_pool_t * string_pool,
+  const char * string,
+  const char ** interned_string,
+  size_t * hash)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string, RCUTILS_RET_INVALID_ARGUMENT);
+  return rcutils_string_pool_internn(string_pool, string, strlen(string), interned_string, hash);
+}
+
+rcutils_ret_t
+rcutils_string_pool_internn(
+  rcutils_string_pool_t * string_pool,
+  const char * string,
+  size_t string_length,
+  const char ** interned_string,
+  size_t * hash)
+{
+  STRING_POOL_VALIDATE_STRING_POOL(string_pool);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(interned_string, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_string_pool_impl_t * impl = string_pool->impl;
+  size_t string_hash = rcutils_hash_map_string_fast_hashn(string, string_length);
+  if (NULL != hash) {
+    *hash = string_hash;
+  }
+
+  // most strings are interned again and again, so look them up while sharing the lock first
+  rcutils_rwlock_read_lock(&impl->lock);
+  string_pool_entry_t * entry =
+    impl->index[string_pool_find_slot(impl, string, string_length, string_hash)];
+  rcutils_rwlock_read_unlock(&impl->lock);
+  if (NULL != entry) {
+    *interned_string = string_pool_entry_string(entry);
+    return RCUTILS_RET_OK;
+  }
+
+  // another thread may have added the string since the lookup, so look it up again
+  rcutils_rwlock_write_lock(&impl->lock);
+  size_t slot = string_pool_find_slot(impl, string, string_length, string_hash);
+  if (NULL == impl->index[slot]) {
+    if (2 * (impl->size + 1) > impl->index_capacity) {
+      rcutils_ret_t ret = string_pool_grow_index(impl);
+      if (RCUTILS_RET_OK != ret) {
+        rcutils_rwlock_write_unlock(&impl->lock);
+        // error message already set
+        return ret;
+      }
+      slot = string_pool_find_slot(impl, string, string_length, string_hash);
+    }
+    entry = string_pool_add_entry(impl, string, string_length, string_hash);
+    if (NULL == entry) {
+      rcutils_rwlock_write_unlock(&impl->lock);
+      // error message already set
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    impl->index[slot] = entry;
+    impl->size++;
+  }
+  *interned_string = string_pool_entry_string(impl->index[slot]);
+  rcutils_rwlock_write_unlock(&impl->lock);
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
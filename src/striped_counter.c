@@ -0,0 +1,266 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__linux__) && defined(_GNU_SOURCE)
+# include <sched.h>
+# define STRIPED_COUNTER_HAVE_SCHED_GETCPU
+#endif
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/striped_counter.h"
+#include "rcutils/macros.h"
+
+// The stripes start on, and are padded to, cache lines of this size.
+#define STRIPED_COUNTER_CACHE_LINE_SIZE 64u
+#define STRIPED_COUNTER_CACHE_LINE_COUNTERS (STRIPED_COUNTER_CACHE_LINE_SIZE / sizeof(uint64_t))
+
+typedef struct rcutils_striped_counter_impl_s
+{
+  // The stripes, one after the other, each holding all the counters.
+  uint64_t * stripes;
+  // The number of stripes minus one.
+  size_t stripe_mask;
+  // The distance between the stripes, in counters.
+  size_t stride;
+  size_t counter_count;
+  rcutils_striped_counter_mode_t mode;
+  rcutils_allocator_t allocator;
+} rcutils_striped_counter_impl_t;
+
+#define STRIPED_COUNTER_VALIDATE_COUNTER(counter) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(counter, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == counter->impl) { \
+    RCUTILS_SET_ERROR_MSG("striped counter is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+#ifdef RCUTILS_THREAD_LOCAL
+// The number of the calling thread plus one, or zero until it is assigned, which is shared by
+// all the striped counters, so that threads spread evenly over the stripes of each.
+static RCUTILS_THREAD_LOCAL uint32_t gtls_rcutils_striped_counter_thread = 0u;
+// Counts the threads which were assigned a number.
+static uint32_t g_rcutils_striped_counter_threads = 0u;
+#endif
+
+static size_t striped_counter_get_thread(void)
+{
+#ifdef RCUTILS_THREAD_LOCAL
+  if (RCUTILS_UNLIKELY(0u == gtls_rcutils_striped_counter_thread)) {
+#ifdef _WIN32
+    gtls_rcutils_striped_counter_thread =
+      (uint32_t)InterlockedIncrement((volatile LONG *)&g_rcutils_striped_counter_threads);
+#else
+    gtls_rcutils_striped_counter_thread =
+      __atomic_add_fetch(&g_rcutils_striped_counter_threads, 1u, __ATOMIC_RELAXED);
+#endif
+  }
+  return gtls_rcutils_striped_counter_thread - 1u;
+#else
+  // Without thread local storage all threads share the first stripe, which is still correct.
+  return 0u;
+#endif
+}
+
+static size_t striped_counter_get_stripe(const rcutils_striped_counter_impl_t * impl)
+{
+  if (RCUTILS_STRIPED_COUNTER_PER_CPU == impl->mode) {
+#if defined(_WIN32)
+    return (size_t)GetCurrentProcessorNumber() & impl->stripe_mask;
+#elif defined(STRIPED_COUNTER_HAVE_SCHED_GETCPU)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+      return (size_t)cpu & impl->stripe_mask;
+    }
+#endif
+  }
+  return striped_counter_get_thread() & impl->stripe_mask;
+}
+
+static uint64_t striped_counter_load(uint64_t * counter)
+{
+#ifdef _WIN32
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)counter, 0, 0);
+#else
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#endif
+}
+
+rcutils_striped_counter_t
+rcutils_get_zero_initialized_striped_counter(void)
+{
+  static rcutils_striped_counter_t zero_initialized_counter = {NULL};
+  return zero_initialized_counter;
+}
+
+rcutils_ret_t
+rcutils_striped_counter_init(
+  rcutils_striped_counter_t * counter,
+  size_t counter_count,
+  size_t stripe_count,
+  rcutils_striped_counter_mode_t mode,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(counter, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (0u == counter_count) {
+    RCUTILS_SET_ERROR_MSG("counter_count cannot be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (RCUTILS_STRIPED_COUNTER_PER_THREAD != mode && RCUTILS_STRIPED_COUNTER_PER_CPU != mode) {
+    RCUTILS_SET_ERROR_MSG("invalid striped counter mode");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0u == stripe_count) {
+    stripe_count = rcutils_thread_get_processor_count();
+  }
+  size_t rounded_stripe_count = 1u;
+  while (rounded_stripe_count < stripe_count) {
+    if (rounded_stripe_count > SIZE_MAX / 2u) {
+      RCUTILS_SET_ERROR_MSG("stripe_count is too large");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    rounded_stripe_count <<= 1u;
+  }
+  if (counter_count > SIZE_MAX / sizeof(uint64_t) - STRIPED_COUNTER_CACHE_LINE_COUNTERS) {
+    RCUTILS_SET_ERROR_MSG("counter_count is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t stride =
+    (counter_count + STRIPED_COUNTER_CACHE_LINE_COUNTERS - 1u) &
+    ~(STRIPED_COUNTER_CACHE_LINE_COUNTERS - 1u);
+  if (rounded_stripe_count > SIZE_MAX / sizeof(uint64_t) / stride) {
+    RCUTILS_SET_ERROR_MSG("counter_count times stripe_count is too large");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_striped_counter_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_striped_counter_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for striped counter impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  const size_t size = rounded_stripe_count * stride * sizeof(uint64_t);
+  impl->stripes = rcutils_aligned_allocate(STRIPED_COUNTER_CACHE_LINE_SIZE, size, allocator);
+  if (NULL == impl->stripes) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for striped counter stripes");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  memset(impl->stripes, 0, size);
+  impl->stripe_mask = rounded_stripe_count - 1u;
+  impl->stride = stride;
+  impl->counter_count = counter_count;
+  impl->mode = mode;
+  impl->allocator = *allocator;
+  counter->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_striped_counter_fini(rcutils_striped_counter_t * counter)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(counter, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_striped_counter_impl_t * impl = counter->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  rcutils_aligned_deallocate(impl->stripes, &allocator);
+  allocator.deallocate(impl, allocator.state);
+  counter->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_striped_counter_add(rcutils_striped_counter_t * counter, size_t index, uint64_t value)
+{
+  rcutils_striped_counter_impl_t * impl = counter->impl;
+  uint64_t * slot = impl->stripes + striped_counter_get_stripe(impl) * impl->stride + index;
+#ifdef _WIN32
+  (void)InterlockedExchangeAdd64((volatile LONG64 *)slot, (LONG64)value);
+#else
+  __atomic_fetch_add(slot, value, __ATOMIC_RELAXED);
+#endif
+}
+
+rcutils_ret_t
+rcutils_striped_counter_get(
+  const rcutils_striped_counter_t * counter, size_t index, uint64_t * value)
+{
+  STRIPED_COUNTER_VALIDATE_COUNTER(counter);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_striped_counter_impl_t * impl = counter->impl;
+  if (index >= impl->counter_count) {
+    RCUTILS_SET_ERROR_MSG("index is out of range");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  uint64_t sum = 0u;
+  for (size_t stripe = 0u; stripe <= impl->stripe_mask; ++stripe) {
+    sum += striped_counter_load(impl->stripes + stripe * impl->stride + index);
+  }
+  *value = sum;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_striped_counter_get_all(const rcutils_striped_counter_t * counter, uint64_t * values)
+{
+  STRIPED_COUNTER_VALIDATE_COUNTER(counter);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(values, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_striped_counter_impl_t * impl = counter->impl;
+  memset(values, 0, impl->counter_count * sizeof(uint64_t));
+  // Read each stripe's cache lines in order.
+  for (size_t stripe = 0u; stripe <= impl->stripe_mask; ++stripe) {
+    uint64_t * counters = impl->stripes + stripe * impl->stride;
+    for (size_t i = 0u; i < impl->counter_count; ++i) {
+      values[i] += striped_counter_load(counters + i);
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_striped_counter_reset(rcutils_striped_counter_t * counter)
+{
+  STRIPED_COUNTER_VALIDATE_COUNTER(counter);
+  rcutils_striped_counter_impl_t * impl = counter->impl;
+  for (size_t stripe = 0u; stripe <= impl->stripe_mask; ++stripe) {
+    uint64_t * counters = impl->stripes + stripe * impl->stride;
+    for (size_t i = 0u; i < impl->counter_count; ++i) {
+#ifdef _WIN32
+      (void)InterlockedExchange64((volatile LONG64 *)(counters + i), 0);
+#else
+      __atomic_store_n(counters + i, 0u, __ATOMIC_RELAXED);
+#endif
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,9 +18,18 @@
 
 static atomic_int_least64_t g_rcutils_fault_injection_count = ATOMIC_VAR_INIT(-1);
 
+uint32_t g_rcutils_fault_injection_armed = 0u;
+
 void rcutils_fault_injection_set_count(int_least64_t count)
 {
   rcutils_atomic_store(&g_rcutils_fault_injection_count, count);
+  // The flag stays set after the counter goes negative by failing, which only costs the calls
+  // to _rcutils_fault_injection_maybe_fail() until the counter is set again.
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)&g_rcutils_fault_injection_armed, count >= 0 ? 1 : 0);
+#else
+  __atomic_store_n(&g_rcutils_fault_injection_armed, count >= 0 ? 1u : 0u, __ATOMIC_RELAXED);
+#endif
 }
 
 int_least64_t rcutils_fault_injection_get_count()
@@ -0,0 +1,538 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/macros.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/thread_pool.h"
+
+// The number of tasks each queue has room for at first, a power of two.
+#define THREAD_POOL_INITIAL_QUEUE_CAPACITY (64u)
+// How long threads wait at a time for tasks to be submitted or run.
+#define THREAD_POOL_WAIT_MS (100u)
+// The queue index of a thread which has no queue, e.g. one waiting for the tasks.
+#define THREAD_POOL_NO_QUEUE SIZE_MAX
+
+#define THREAD_POOL_VALIDATE_THREAD_POOL(thread_pool) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread_pool, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == thread_pool->impl) { \
+    RCUTILS_SET_ERROR_MSG("thread pool is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+typedef struct thread_pool_task_s
+{
+  rcutils_thread_pool_task_function_t function;
+  void * arg;
+} thread_pool_task_t;
+
+// The tasks queued for a worker, in a ring buffer, of which the worker takes the newest task
+// from the back, while the other threads steal the oldest one from the front.
+typedef struct thread_pool_queue_s
+{
+  rcutils_mutex_t mutex;
+  thread_pool_task_t * tasks;
+  // A power of two
+  size_t capacity;
+  size_t front;
+  size_t count;
+} thread_pool_queue_t;
+
+typedef struct thread_pool_worker_s
+{
+  struct rcutils_thread_pool_impl_s * impl;
+  // The index of the queue and thread of the worker, or THREAD_POOL_NO_QUEUE
+  size_t index;
+} thread_pool_worker_t;
+
+typedef struct rcutils_thread_pool_impl_s
+{
+  rcutils_allocator_t allocator;
+  size_t thread_count;
+  rcutils_thread_t * threads;
+  thread_pool_worker_t * workers;
+  // One queue per worker
+  thread_pool_queue_t * queues;
+  // The queues whose mutex was initialized, to clean up after a failed initialization
+  size_t queue_initialized_count;
+  rcutils_mutex_t mutex;
+  // Signaled when tasks are submitted while workers sleep, and when the workers should stop
+  rcutils_condition_variable_t work_cv;
+  // Signaled when the last pending task ran
+  rcutils_condition_variable_t done_cv;
+  bool mutex_initialized;
+  bool cv_initialized;
+  // The tasks in the queues, which may be briefly off by the tasks being pushed or taken
+  atomic_size_t queued_count;
+  // The tasks queued or running
+  atomic_size_t pending_count;
+  // The workers waiting for tasks, which submitters wake up
+  atomic_size_t sleeping_count;
+  // The queue the next task submitted by a thread other than a worker goes to
+  atomic_size_t next_queue;
+  atomic_bool stop_requested;
+} rcutils_thread_pool_impl_t;
+
+#ifdef RCUTILS_THREAD_LOCAL
+// The worker the calling thread is, or which waits for a thread pool, if any.
+static RCUTILS_THREAD_LOCAL const thread_pool_worker_t * gtls_thread_pool_worker = NULL;
+#endif
+
+static size_t
+load_size(atomic_size_t * value)
+{
+  size_t result;
+  rcutils_atomic_load(value, result);
+  return result;
+}
+
+// Return the index of the queue the calling thread pushes the tasks it submits to, if any.
+static size_t
+get_own_queue(const rcutils_thread_pool_impl_t * impl)
+{
+#ifdef RCUTILS_THREAD_LOCAL
+  if (NULL != gtls_thread_pool_worker && impl == gtls_thread_pool_worker->impl) {
+    return gtls_thread_pool_worker->index;
+  }
+#else
+  (void)impl;
+#endif
+  return THREAD_POOL_NO_QUEUE;
+}
+
+static bool
+queue_push(
+  rcutils_thread_pool_impl_t * impl, thread_pool_queue_t * queue, const thread_pool_task_t * task)
+{
+  rcutils_mutex_lock(&queue->mutex);
+  if (queue->count == queue->capacity) {
+    if (queue->capacity > SIZE_MAX / 2u / sizeof(thread_pool_task_t)) {
+      rcutils_mutex_unlock(&queue->mutex);
+      return false;
+    }
+    size_t capacity = queue->capacity * 2u;
+    thread_pool_task_t * tasks =
+      impl->allocator.allocate(capacity * sizeof(thread_pool_task_t), impl->allocator.state);
+    if (NULL == tasks) {
+      rcutils_mutex_unlock(&queue->mutex);
+      return false;
+    }
+    // Unwrap the tasks, from the front
+    size_t first_count = queue->capacity - queue->front;
+    memcpy(tasks, queue->tasks + queue->front, first_count * sizeof(thread_pool_task_t));
+    memcpy(tasks + first_count, queue->tasks, queue->front * sizeof(thread_pool_task_t));
+    impl->allocator.deallocate(queue->tasks, impl->allocator.state);
+    queue->tasks = tasks;
+    queue->capacity = capacity;
+    queue->front = 0u;
+  }
+  queue->tasks[(queue->front + queue->count) & (queue->capacity - 1u)] = *task;
+  ++queue->count;
+  rcutils_mutex_unlock(&queue->mutex);
+  return true;
+}
+
+static bool
+queue_pop(thread_pool_queue_t * queue, bool from_front, thread_pool_task_t * task)
+{
+  rcutils_mutex_lock(&queue->mutex);
+  bool popped = queue->count > 0u;
+  if (popped) {
+    --queue->count;
+    if (from_front) {
+      *task = queue->tasks[queue->front];
+      queue->front = (queue->front + 1u) & (queue->capacity - 1u);
+    } else {
+      *task = queue->tasks[(queue->front + queue->count) & (queue->capacity - 1u)];
+    }
+  }
+  rcutils_mutex_unlock(&queue->mutex);
+  return popped;
+}
+
+// Take the newest task of the own queue, or else steal the oldest task of another queue.
+static bool
+take_task(rcutils_thread_pool_impl_t * impl, size_t own_queue, thread_pool_task_t * task)
+{
+  if (0u == load_size(&impl->queued_count)) {
+    return false;
+  }
+  bool taken =
+    THREAD_POOL_NO_QUEUE != own_queue && queue_pop(&impl->queues[own_queue], false, task);
+  // Start with the queue after the own one, so that the workers don't all steal from the same
+  size_t start = THREAD_POOL_NO_QUEUE != own_queue ? own_queue + 1u : 0u;
+  for (size_t i = 0u; !taken && i < impl->thread_count; ++i) {
+    size_t index = (start + i) % impl->thread_count;
+    taken = index != own_queue && queue_pop(&impl->queues[index], true, task);
+  }
+  if (taken) {
+    size_t previous;
+    rcutils_atomic_fetch_sub(&impl->queued_count, previous, 1u);
+    (void)previous;
+  }
+  return taken;
+}
+
+// Account for a task which ran, or which couldn't be queued.
+static void
+finish_task(rcutils_thread_pool_impl_t * impl)
+{
+  size_t previous;
+  rcutils_atomic_fetch_sub(&impl->pending_count, previous, 1u);
+  if (1u == previous) {
+    rcutils_mutex_lock(&impl->mutex);
+    rcutils_condition_variable_notify_all(&impl->done_cv);
+    // Workers which were asked to stop wait for the last task too.
+    rcutils_condition_variable_notify_all(&impl->work_cv);
+    rcutils_mutex_unlock(&impl->mutex);
+  }
+}
+
+static void
+worker_main(void * arg)
+{
+  const thread_pool_worker_t * worker = (const thread_pool_worker_t *)arg;
+  rcutils_thread_pool_impl_t * impl = worker->impl;
+#ifdef RCUTILS_THREAD_LOCAL
+  gtls_thread_pool_worker = worker;
+#endif
+  while (true) {
+    thread_pool_task_t task;
+    if (take_task(impl, worker->index, &task)) {
+      task.function(task.arg);
+      finish_task(impl);
+      continue;
+    }
+
+    rcutils_mutex_lock(&impl->mutex);
+    // Submitters check the sleeping workers after queuing a task, so either they see this one
+    // and wake it up, or it sees their task below.
+    size_t previous;
+    rcutils_atomic_fetch_add(&impl->sleeping_count, previous, 1u);
+    (void)previous;
+    bool stop = false;
+    while (0u == load_size(&impl->queued_count)) {
+      // Running tasks may still submit more, so the workers only stop once there are none.
+      if (rcutils_atomic_load_bool(&impl->stop_requested) &&
+        0u == load_size(&impl->pending_count))
+      {
+        stop = true;
+        break;
+      }
+      rcutils_condition_variable_wait_for(&impl->work_cv, &impl->mutex, THREAD_POOL_WAIT_MS);
+    }
+    rcutils_atomic_fetch_sub(&impl->sleeping_count, previous, 1u);
+    rcutils_mutex_unlock(&impl->mutex);
+    if (stop) {
+      break;
+    }
+  }
+#ifdef RCUTILS_THREAD_LOCAL
+  gtls_thread_pool_worker = NULL;
+#endif
+}
+
+// Return the index-th CPU of the set, wrapping around, which must not be empty.
+static size_t
+get_nth_cpu(const rcutils_cpu_set_t * cpu_set, size_t index)
+{
+  index %= rcutils_cpu_set_count(cpu_set);
+  for (size_t cpu = 0u; cpu < RCUTILS_CPU_SET_SIZE; ++cpu) {
+    if (rcutils_cpu_set_contains(cpu_set, cpu) && 0u == index--) {
+      return cpu;
+    }
+  }
+  return 0u;
+}
+
+static rcutils_ret_t
+stop_threads(rcutils_thread_pool_impl_t * impl, size_t started_count)
+{
+  rcutils_atomic_store(&impl->stop_requested, true);
+  rcutils_mutex_lock(&impl->mutex);
+  rcutils_condition_variable_notify_all(&impl->work_cv);
+  rcutils_mutex_unlock(&impl->mutex);
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0u; i < started_count; ++i) {
+    if (RCUTILS_RET_OK != rcutils_thread_join(&impl->threads[i])) {
+      ret = RCUTILS_RET_ERROR;
+    }
+  }
+  return ret;
+}
+
+static void
+free_impl(rcutils_thread_pool_impl_t * impl)
+{
+  rcutils_allocator_t allocator = impl->allocator;
+  for (size_t i = 0u; i < impl->queue_initialized_count; ++i) {
+    rcutils_mutex_fini(&impl->queues[i].mutex);
+    allocator.deallocate(impl->queues[i].tasks, allocator.state);
+  }
+  allocator.deallocate(impl->queues, allocator.state);
+  allocator.deallocate(impl->workers, allocator.state);
+  allocator.deallocate(impl->threads, allocator.state);
+  if (impl->cv_initialized) {
+    rcutils_condition_variable_fini(&impl->done_cv);
+    rcutils_condition_variable_fini(&impl->work_cv);
+  }
+  if (impl->mutex_initialized) {
+    rcutils_mutex_fini(&impl->mutex);
+  }
+  allocator.deallocate(impl, allocator.state);
+}
+
+rcutils_thread_pool_options_t
+rcutils_thread_pool_get_default_options(void)
+{
+  rcutils_thread_pool_options_t options = {
+    .thread_count = 0u,
+    .thread_attributes = rcutils_get_default_thread_attributes(),
+    .pin_threads = false,
+  };
+  return options;
+}
+
+rcutils_thread_pool_t
+rcutils_get_zero_initialized_thread_pool(void)
+{
+  static rcutils_thread_pool_t zero_initialized_thread_pool = {NULL};
+  return zero_initialized_thread_pool;
+}
+
+rcutils_ret_t
+rcutils_thread_pool_init(
+  rcutils_thread_pool_t * thread_pool,
+  const rcutils_thread_pool_options_t * options,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread_pool, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_thread_pool_options_t default_options = rcutils_thread_pool_get_default_options();
+  if (NULL == options) {
+    options = &default_options;
+  }
+  if (options->pin_threads && 0u == rcutils_cpu_set_count(&options->thread_attributes.cpu_set)) {
+    RCUTILS_SET_ERROR_MSG("pinned thread pool threads need a CPU set");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  size_t thread_count = options->thread_count;
+  if (0u == thread_count) {
+    thread_count = rcutils_thread_get_processor_count();
+  }
+  if (thread_count > SIZE_MAX / sizeof(thread_pool_queue_t)) {
+    RCUTILS_SET_ERROR_MSG("too many thread pool threads");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_thread_pool_impl_t * impl =
+    allocator->zero_allocate(1, sizeof(rcutils_thread_pool_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for thread pool impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->allocator = *allocator;
+  impl->thread_count = thread_count;
+  rcutils_atomic_store(&impl->queued_count, 0u);
+  rcutils_atomic_store(&impl->pending_count, 0u);
+  rcutils_atomic_store(&impl->sleeping_count, 0u);
+  rcutils_atomic_store(&impl->next_queue, 0u);
+  rcutils_atomic_store(&impl->stop_requested, false);
+
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->mutex)) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the mutex of the thread pool");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->mutex_initialized = true;
+  if (RCUTILS_RET_OK != rcutils_condition_variable_init(&impl->work_cv)) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the condition variables of the thread pool");
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK != rcutils_condition_variable_init(&impl->done_cv)) {
+    rcutils_condition_variable_fini(&impl->work_cv);
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the condition variables of the thread pool");
+    return RCUTILS_RET_ERROR;
+  }
+  impl->cv_initialized = true;
+
+  impl->queues = allocator->zero_allocate(
+    thread_count, sizeof(thread_pool_queue_t), allocator->state);
+  impl->workers = allocator->allocate(
+    thread_count * sizeof(thread_pool_worker_t), allocator->state);
+  impl->threads = allocator->allocate(thread_count * sizeof(rcutils_thread_t), allocator->state);
+  if (NULL == impl->queues || NULL == impl->workers || NULL == impl->threads) {
+    free_impl(impl);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for thread pool threads");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0u; i < thread_count; ++i) {
+    thread_pool_queue_t * queue = &impl->queues[i];
+    if (RCUTILS_RET_OK != rcutils_mutex_init(&queue->mutex)) {
+      free_impl(impl);
+      RCUTILS_SET_ERROR_MSG("failed to initialize the mutex of a thread pool queue");
+      return RCUTILS_RET_ERROR;
+    }
+    ++impl->queue_initialized_count;
+    queue->capacity = THREAD_POOL_INITIAL_QUEUE_CAPACITY;
+    queue->tasks = allocator->allocate(
+      queue->capacity * sizeof(thread_pool_task_t), allocator->state);
+    if (NULL == queue->tasks) {
+      free_impl(impl);
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for thread pool queues");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+
+  rcutils_thread_attributes_t attributes = options->thread_attributes;
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0u; i < thread_count; ++i) {
+    impl->workers[i].impl = impl;
+    impl->workers[i].index = i;
+    if (options->pin_threads) {
+      attributes.cpu_set = rcutils_get_zero_initialized_cpu_set();
+      ret = rcutils_cpu_set_add(
+        &attributes.cpu_set, get_nth_cpu(&options->thread_attributes.cpu_set, i));
+    }
+    if (RCUTILS_RET_OK == ret) {
+      ret = rcutils_thread_create_with_attributes(
+        &impl->threads[i], worker_main, &impl->workers[i], &attributes);
+    }
+    if (RCUTILS_RET_OK != ret) {
+      (void)stop_threads(impl, i);
+      free_impl(impl);
+      return ret;
+    }
+  }
+
+  thread_pool->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_thread_pool_fini(rcutils_thread_pool_t * thread_pool)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread_pool, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_thread_pool_impl_t * impl = thread_pool->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  if (RCUTILS_RET_OK != stop_threads(impl, impl->thread_count)) {
+    RCUTILS_SET_ERROR_MSG("failed to join the thread pool threads");
+    return RCUTILS_RET_ERROR;
+  }
+  free_impl(impl);
+  thread_pool->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_thread_pool_submit(
+  rcutils_thread_pool_t * thread_pool,
+  rcutils_thread_pool_task_function_t function,
+  void * arg)
+{
+  THREAD_POOL_VALIDATE_THREAD_POOL(thread_pool);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(function, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_thread_pool_impl_t * impl = thread_pool->impl;
+
+  size_t index = get_own_queue(impl);
+  size_t previous;
+  if (THREAD_POOL_NO_QUEUE == index) {
+    rcutils_atomic_fetch_add(&impl->next_queue, previous, 1u);
+    index = previous % impl->thread_count;
+  }
+  // The task is pending before it can be taken, so that it is never finished before that.
+  rcutils_atomic_fetch_add(&impl->pending_count, previous, 1u);
+  thread_pool_task_t task = {function, arg};
+  if (!queue_push(impl, &impl->queues[index], &task)) {
+    finish_task(impl);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for thread pool task");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  rcutils_atomic_fetch_add(&impl->queued_count, previous, 1u);
+  if (0u != load_size(&impl->sleeping_count)) {
+    rcutils_mutex_lock(&impl->mutex);
+    rcutils_condition_variable_notify_one(&impl->work_cv);
+    rcutils_mutex_unlock(&impl->mutex);
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_thread_pool_wait(rcutils_thread_pool_t * thread_pool)
+{
+  THREAD_POOL_VALIDATE_THREAD_POOL(thread_pool);
+  rcutils_thread_pool_impl_t * impl = thread_pool->impl;
+#ifdef RCUTILS_THREAD_LOCAL
+  if (NULL != gtls_thread_pool_worker && impl == gtls_thread_pool_worker->impl) {
+    RCUTILS_SET_ERROR_MSG("a task can't wait for its own thread pool");
+    return RCUTILS_RET_ERROR;
+  }
+  // The tasks run here mustn't wait for the pool either, and submit tasks as other threads do.
+  const thread_pool_worker_t * previous_worker = gtls_thread_pool_worker;
+  thread_pool_worker_t waiter = {impl, THREAD_POOL_NO_QUEUE};
+  gtls_thread_pool_worker = &waiter;
+#endif
+  while (true) {
+    thread_pool_task_t task;
+    if (take_task(impl, THREAD_POOL_NO_QUEUE, &task)) {
+      task.function(task.arg);
+      finish_task(impl);
+      continue;
+    }
+    rcutils_mutex_lock(&impl->mutex);
+    while (0u == load_size(&impl->queued_count) && 0u != load_size(&impl->pending_count)) {
+      rcutils_condition_variable_wait_for(&impl->done_cv, &impl->mutex, THREAD_POOL_WAIT_MS);
+    }
+    bool done = 0u == load_size(&impl->pending_count);
+    rcutils_mutex_unlock(&impl->mutex);
+    if (done) {
+      break;
+    }
+  }
+#ifdef RCUTILS_THREAD_LOCAL
+  gtls_thread_pool_worker = previous_worker;
+#endif
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_thread_pool_get_thread_count(
+  const rcutils_thread_pool_t * thread_pool, size_t * thread_count)
+{
+  THREAD_POOL_VALIDATE_THREAD_POOL(thread_pool);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread_count, RCUTILS_RET_INVALID_ARGUMENT);
+  *thread_count = thread_pool->impl->thread_count;
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,687 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <string.h>
+
+#ifndef _WIN32
+# include <errno.h>
+# include <sched.h>
+# include <time.h>
+# include <unistd.h>
+#endif
+
+#include "./threads.h"
+
+#include "rcutils/error_handling.h"
+#include "rcutils/time.h"
+
+#ifdef _WIN32
+// Only defined by the headers of the Windows 10 SDK 1803 and later.
+# ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#  define RCUTILS_CREATE_WAITABLE_TIMER_HIGH_RESOLUTION CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+# else
+#  define RCUTILS_CREATE_WAITABLE_TIMER_HIGH_RESOLUTION (0x00000002)
+# endif
+#endif
+
+#ifdef _WIN32
+static DWORD WINAPI thread_trampoline(LPVOID arg)
+{
+  rcutils_thread_t * thread = (rcutils_thread_t *)arg;
+  thread->function(thread->arg);
+  return 0;
+}
+#else
+static void * thread_trampoline(void * arg)
+{
+  rcutils_thread_t * thread = (rcutils_thread_t *)arg;
+  thread->function(thread->arg);
+  return NULL;
+}
+#endif
+
+rcutils_ret_t
+rcutils_thread_create(rcutils_thread_t * thread, rcutils_thread_function_t function, void * arg)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(function, RCUTILS_RET_INVALID_ARGUMENT);
+
+  thread->function = function;
+  thread->arg = arg;
+#ifdef _WIN32
+  thread->handle = CreateThread(NULL, 0, thread_trampoline, thread, 0, NULL);
+  if (NULL == thread->handle) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "CreateThread failed with error code %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+#else
+  int error = pthread_create(&thread->handle, NULL, thread_trampoline, thread);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_create failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+// Beyond Windows, setting the CPUs of threads relies on the GNU extensions of glibc on Linux.
+#if defined(__linux__) && defined(_GNU_SOURCE)
+# define THREADS_HAVE_GNU_CPU_SETS
+#endif
+
+#ifndef _WIN32
+static int thread_native_scheduling_policy(rcutils_thread_scheduling_policy_t policy)
+{
+  switch (policy) {
+    case RCUTILS_THREAD_SCHEDULING_POLICY_FIFO:
+      return SCHED_FIFO;
+    case RCUTILS_THREAD_SCHEDULING_POLICY_RR:
+      return SCHED_RR;
+    default:
+      return SCHED_OTHER;
+  }
+}
+#endif
+
+#ifdef THREADS_HAVE_GNU_CPU_SETS
+static void thread_native_cpu_set(const rcutils_cpu_set_t * cpu_set, cpu_set_t * native)
+{
+  CPU_ZERO(native);
+  for (size_t cpu = 0; cpu < RCUTILS_CPU_SET_SIZE && cpu < CPU_SETSIZE; ++cpu) {
+    if (rcutils_cpu_set_contains(cpu_set, cpu)) {
+      CPU_SET(cpu, native);
+    }
+  }
+}
+#endif
+
+// Checks that the attributes are valid and supported, before setting any of them.
+static rcutils_ret_t thread_check_attributes(const rcutils_thread_attributes_t * attributes)
+{
+  switch (attributes->scheduling_policy) {
+    case RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT:
+      break;
+    case RCUTILS_THREAD_SCHEDULING_POLICY_OTHER:
+    case RCUTILS_THREAD_SCHEDULING_POLICY_FIFO:
+    case RCUTILS_THREAD_SCHEDULING_POLICY_RR:
+      {
+#ifdef _WIN32
+        const int min_priority = THREAD_PRIORITY_IDLE;
+        const int max_priority = THREAD_PRIORITY_TIME_CRITICAL;
+#else
+        const int policy = thread_native_scheduling_policy(attributes->scheduling_policy);
+        const int min_priority = sched_get_priority_min(policy);
+        const int max_priority = sched_get_priority_max(policy);
+#endif
+        if (attributes->priority < min_priority || attributes->priority > max_priority) {
+          RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+            "priority %d is not within [%d, %d] for the scheduling policy",
+            attributes->priority, min_priority, max_priority);
+          return RCUTILS_RET_INVALID_ARGUMENT;
+        }
+        break;
+      }
+    default:
+      RCUTILS_SET_ERROR_MSG("scheduling_policy is not a valid scheduling policy");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  if (0u == rcutils_cpu_set_count(&attributes->cpu_set)) {
+    return RCUTILS_RET_OK;
+  }
+#if defined(_WIN32)
+  // The affinity mask of a thread only covers the processors of its group.
+  for (size_t cpu = sizeof(DWORD_PTR) * 8u; cpu < RCUTILS_CPU_SET_SIZE; ++cpu) {
+    if (rcutils_cpu_set_contains(&attributes->cpu_set, cpu)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "cpu %zu is beyond the %zu a thread can be set to run on",
+        cpu, sizeof(DWORD_PTR) * 8u);
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+  }
+#elif !defined(THREADS_HAVE_GNU_CPU_SETS)
+  RCUTILS_SET_ERROR_MSG("setting the CPUs of a thread is not supported on this platform");
+  return RCUTILS_RET_ERROR;
+#endif
+  return RCUTILS_RET_OK;
+}
+
+#ifdef _WIN32
+static rcutils_ret_t thread_set_attributes(
+  HANDLE handle, const rcutils_thread_attributes_t * attributes)
+{
+  if (0u != rcutils_cpu_set_count(&attributes->cpu_set) &&
+    0 == SetThreadAffinityMask(handle, (DWORD_PTR)attributes->cpu_set.bits[0]))
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "SetThreadAffinityMask failed with error code %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT != attributes->scheduling_policy) {
+    int priority = RCUTILS_THREAD_SCHEDULING_POLICY_OTHER == attributes->scheduling_policy ?
+      attributes->priority : THREAD_PRIORITY_TIME_CRITICAL;
+    if (!SetThreadPriority(handle, priority)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "SetThreadPriority failed with error code %lu", GetLastError());
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+#endif
+
+rcutils_ret_t
+rcutils_thread_create_with_attributes(
+  rcutils_thread_t * thread,
+  rcutils_thread_function_t function,
+  void * arg,
+  const rcutils_thread_attributes_t * attributes)
+{
+  if (NULL == attributes) {
+    return rcutils_thread_create(thread, function, arg);
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(function, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_ret_t ret = thread_check_attributes(attributes);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  thread->function = function;
+  thread->arg = arg;
+#ifdef _WIN32
+  // The thread is created suspended, so that it doesn't run before it has its attributes.
+  thread->handle = CreateThread(NULL, 0, thread_trampoline, thread, CREATE_SUSPENDED, NULL);
+  if (NULL == thread->handle) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "CreateThread failed with error code %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+  ret = thread_set_attributes(thread->handle, attributes);
+  if (RCUTILS_RET_OK != ret) {
+    // It never ran, so it holds nothing which terminating it would leak.
+    (void)TerminateThread(thread->handle, 1);
+    CloseHandle(thread->handle);
+    return ret;
+  }
+  if ((DWORD)-1 == ResumeThread(thread->handle)) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "ResumeThread failed with error code %lu", GetLastError());
+    (void)TerminateThread(thread->handle, 1);
+    CloseHandle(thread->handle);
+    return RCUTILS_RET_ERROR;
+  }
+#else
+  // The attributes are given to pthread_create(), so that the thread runs with them from its start.
+  pthread_attr_t thread_attributes;
+  int error = pthread_attr_init(&thread_attributes);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_attr_init failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT != attributes->scheduling_policy) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = attributes->priority;
+    error = pthread_attr_setinheritsched(&thread_attributes, PTHREAD_EXPLICIT_SCHED);
+    if (0 == error) {
+      error = pthread_attr_setschedpolicy(
+        &thread_attributes, thread_native_scheduling_policy(attributes->scheduling_policy));
+    }
+    if (0 == error) {
+      error = pthread_attr_setschedparam(&thread_attributes, &param);
+    }
+  }
+#ifdef THREADS_HAVE_GNU_CPU_SETS
+  if (0 == error && 0u != rcutils_cpu_set_count(&attributes->cpu_set)) {
+    cpu_set_t cpu_set;
+    thread_native_cpu_set(&attributes->cpu_set, &cpu_set);
+    error = pthread_attr_setaffinity_np(&thread_attributes, sizeof(cpu_set), &cpu_set);
+  }
+#endif
+  if (0 != error) {
+    (void)pthread_attr_destroy(&thread_attributes);
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "setting the thread attributes failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+  error = pthread_create(&thread->handle, &thread_attributes, thread_trampoline, thread);
+  (void)pthread_attr_destroy(&thread_attributes);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_create failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_thread_set_current_attributes(const rcutils_thread_attributes_t * attributes)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(attributes, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_ret_t ret = thread_check_attributes(attributes);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+#ifdef _WIN32
+  return thread_set_attributes(GetCurrentThread(), attributes);
+#else
+#ifdef THREADS_HAVE_GNU_CPU_SETS
+  if (0u != rcutils_cpu_set_count(&attributes->cpu_set)) {
+    cpu_set_t cpu_set;
+    thread_native_cpu_set(&attributes->cpu_set, &cpu_set);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (0 != error) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "pthread_setaffinity_np failed with error code %d", error);
+      return RCUTILS_RET_ERROR;
+    }
+  }
+#endif
+  if (RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT != attributes->scheduling_policy) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = attributes->priority;
+    int error = pthread_setschedparam(
+      pthread_self(), thread_native_scheduling_policy(attributes->scheduling_policy), &param);
+    if (0 != error) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "pthread_setschedparam failed with error code %d", error);
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  return RCUTILS_RET_OK;
+#endif
+}
+
+rcutils_ret_t
+rcutils_thread_get_current_cpu_set(rcutils_cpu_set_t * cpu_set)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(cpu_set, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef THREADS_HAVE_GNU_CPU_SETS
+  cpu_set_t native;
+  int error = pthread_getaffinity_np(pthread_self(), sizeof(native), &native);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "pthread_getaffinity_np failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+  *cpu_set = rcutils_get_zero_initialized_cpu_set();
+  for (size_t cpu = 0; cpu < RCUTILS_CPU_SET_SIZE && cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &native)) {
+      cpu_set->bits[cpu / 64u] |= (uint64_t)1u << (cpu % 64u);
+    }
+  }
+  return RCUTILS_RET_OK;
+#else
+  RCUTILS_SET_ERROR_MSG("getting the CPUs of a thread is not supported on this platform");
+  return RCUTILS_RET_ERROR;
+#endif
+}
+
+rcutils_ret_t
+rcutils_thread_join(rcutils_thread_t * thread)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(thread, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef _WIN32
+  if (WaitForSingleObject(thread->handle, INFINITE) != WAIT_OBJECT_0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "WaitForSingleObject failed with error code %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+  CloseHandle(thread->handle);
+#else
+  int error = pthread_join(thread->handle, NULL);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_join failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_thread_yield(void)
+{
+#ifdef _WIN32
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+rcutils_ret_t
+rcutils_thread_sleep_until(int64_t steady_deadline)
+{
+#if !defined(_WIN32) && defined(TIMER_ABSTIME) && !(defined(__MACH__) && defined(__APPLE__))
+  // rcutils_steady_time_now() reads CLOCK_MONOTONIC here, so the deadline can be slept to.
+  if (steady_deadline <= 0) {
+    return RCUTILS_RET_OK;
+  }
+  struct timespec deadline;
+  deadline.tv_sec = (time_t)(steady_deadline / 1000000000);
+  deadline.tv_nsec = (long)(steady_deadline % 1000000000);
+  int error;
+  do {
+    error = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+  } while (EINTR == error);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("clock_nanosleep failed with error %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+  return RCUTILS_RET_OK;
+#else
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return RCUTILS_RET_ERROR;
+  }
+  if (steady_deadline <= now) {
+    return RCUTILS_RET_OK;
+  }
+  const int64_t duration = steady_deadline - now;
+# ifdef _WIN32
+  // A high resolution timer wakes up within a few hundred microseconds, where Sleep() waits for
+  // the next tick of the scheduler, every 15.6 milliseconds by default.
+  HANDLE timer = CreateWaitableTimerExW(
+    NULL, NULL, RCUTILS_CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+  if (NULL != timer) {
+    LARGE_INTEGER due_time;
+    // Negative due times are relative, in units of 100 nanoseconds.
+    due_time.QuadPart = -(LONGLONG)((duration + 99) / 100);
+    BOOL waited = SetWaitableTimer(timer, &due_time, 0, NULL, NULL, FALSE) &&
+      WAIT_OBJECT_0 == WaitForSingleObject(timer, INFINITE);
+    CloseHandle(timer);
+    if (waited) {
+      return RCUTILS_RET_OK;
+    }
+  }
+  // Before Windows 10 1803, high resolution timers can't be created.
+  Sleep((DWORD)(duration / 1000000));
+# else
+  struct timespec remaining;
+  remaining.tv_sec = (time_t)(duration / 1000000000);
+  remaining.tv_nsec = (long)(duration % 1000000000);
+  if (0 != nanosleep(&remaining, NULL) && EINTR != errno) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("nanosleep failed with error %d", errno);
+    return RCUTILS_RET_ERROR;
+  }
+# endif
+  return RCUTILS_RET_OK;
+#endif
+}
+
+size_t
+rcutils_thread_get_processor_count(void)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1u;
+#else
+  long count = sysconf(_SC_NPROCESSORS_ONLN);  // NOLINT(runtime/int)
+  return count > 0 ? (size_t)count : 1u;
+#endif
+}
+
+rcutils_ret_t
+rcutils_thread_specific_init(
+  rcutils_thread_specific_t * key, rcutils_thread_specific_destructor_t destructor)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef _WIN32
+  // Unlike TLS, fiber local storage supports destructors, and behaves the same without fibers.
+  key->index = FlsAlloc(destructor);
+  if (FLS_OUT_OF_INDEXES == key->index) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "FlsAlloc failed with error code %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+#else
+  int error = pthread_key_create(&key->key, destructor);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_key_create failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void *
+rcutils_thread_specific_get(rcutils_thread_specific_t * key)
+{
+#ifdef _WIN32
+  return FlsGetValue(key->index);
+#else
+  return pthread_getspecific(key->key);
+#endif
+}
+
+rcutils_ret_t
+rcutils_thread_specific_set(rcutils_thread_specific_t * key, void * value)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef _WIN32
+  if (!FlsSetValue(key->index, value)) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "FlsSetValue failed with error code %lu", GetLastError());
+    return RCUTILS_RET_ERROR;
+  }
+#else
+  int error = pthread_setspecific(key->key, value);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "pthread_setspecific failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_thread_specific_fini(rcutils_thread_specific_t * key)
+{
+#ifdef _WIN32
+  (void)FlsFree(key->index);
+#else
+  (void)pthread_key_delete(key->key);
+#endif
+}
+
+rcutils_ret_t
+rcutils_mutex_init(rcutils_mutex_t * mutex)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(mutex, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef _WIN32
+  InitializeCriticalSection(&mutex->impl);
+#else
+  int error = pthread_mutex_init(&mutex->impl, NULL);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_mutex_init failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_mutex_lock(rcutils_mutex_t * mutex)
+{
+#ifdef _WIN32
+  EnterCriticalSection(&mutex->impl);
+#else
+  (void)pthread_mutex_lock(&mutex->impl);
+#endif
+}
+
+void
+rcutils_mutex_unlock(rcutils_mutex_t * mutex)
+{
+#ifdef _WIN32
+  LeaveCriticalSection(&mutex->impl);
+#else
+  (void)pthread_mutex_unlock(&mutex->impl);
+#endif
+}
+
+void
+rcutils_mutex_fini(rcutils_mutex_t * mutex)
+{
+#ifdef _WIN32
+  DeleteCriticalSection(&mutex->impl);
+#else
+  (void)pthread_mutex_destroy(&mutex->impl);
+#endif
+}
+
+rcutils_ret_t
+rcutils_rwlock_init(rcutils_rwlock_t * lock)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(lock, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef _WIN32
+  InitializeSRWLock(&lock->impl);
+#else
+  int error = pthread_rwlock_init(&lock->impl, NULL);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "pthread_rwlock_init failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_rwlock_read_lock(rcutils_rwlock_t * lock)
+{
+#ifdef _WIN32
+  AcquireSRWLockShared(&lock->impl);
+#else
+  (void)pthread_rwlock_rdlock(&lock->impl);
+#endif
+}
+
+void
+rcutils_rwlock_read_unlock(rcutils_rwlock_t * lock)
+{
+#ifdef _WIN32
+  ReleaseSRWLockShared(&lock->impl);
+#else
+  (void)pthread_rwlock_unlock(&lock->impl);
+#endif
+}
+
+void
+rcutils_rwlock_write_lock(rcutils_rwlock_t * lock)
+{
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&lock->impl);
+#else
+  (void)pthread_rwlock_wrlock(&lock->impl);
+#endif
+}
+
+void
+rcutils_rwlock_write_unlock(rcutils_rwlock_t * lock)
+{
+#ifdef _WIN32
+  ReleaseSRWLockExclusive(&lock->impl);
+#else
+  (void)pthread_rwlock_unlock(&lock->impl);
+#endif
+}
+
+void
+rcutils_rwlock_fini(rcutils_rwlock_t * lock)
+{
+#ifdef _WIN32
+  (void)lock;
+#else
+  (void)pthread_rwlock_destroy(&lock->impl);
+#endif
+}
+
+rcutils_ret_t
+rcutils_condition_variable_init(rcutils_condition_variable_t * cv)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(cv, RCUTILS_RET_INVALID_ARGUMENT);
+#ifdef _WIN32
+  InitializeConditionVariable(&cv->impl);
+#else
+  int error = pthread_cond_init(&cv->impl, NULL);
+  if (0 != error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("pthread_cond_init failed with error code %d", error);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+void
+rcutils_condition_variable_wait_for(
+  rcutils_condition_variable_t * cv, rcutils_mutex_t * mutex, uint32_t timeout_ms)
+{
+#ifdef _WIN32
+  (void)SleepConditionVariableCS(&cv->impl, &mutex->impl, timeout_ms);
+#else
+  struct timespec deadline;
+  (void)clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += (time_t)(timeout_ms / 1000u);
+  deadline.tv_nsec += (long)(timeout_ms % 1000u) * 1000000L;  // NOLINT(runtime/int)
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  (void)pthread_cond_timedwait(&cv->impl, &mutex->impl, &deadline);
+#endif
+}
+
+void
+rcutils_condition_variable_notify_all(rcutils_condition_variable_t * cv)
+{
+#ifdef _WIN32
+  WakeAllConditionVariable(&cv->impl);
+#else
+  (void)pthread_cond_broadcast(&cv->impl);
+#endif
+}
+
+void
+rcutils_condition_variable_notify_one(rcutils_condition_variable_t * cv)
+{
+#ifdef _WIN32
+  WakeConditionVariable(&cv->impl);
+#else
+  (void)pthread_cond_signal(&cv->impl);
+#endif
+}
+
+void
+rcutils_condition_variable_fini(rcutils_condition_variable_t * cv)
+{
+#ifdef _WIN32
+  (void)cv;
+#else
+  (void)pthread_cond_destroy(&cv->impl);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
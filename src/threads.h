@@ -0,0 +1,260 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Minimal, internal-only portable wrappers around the native thread, mutex,
+// reader-writer lock and condition variable primitives, for the few places in rcutils which need a
+// background thread.
+
+#ifndef THREADS_H_
+#define THREADS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+// When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
+// there appears to be a problem with winbase.h (which is included by
+// Windows.h).  In particular, warnings of the form:
+//
+// warning C5105: macro expansion producing 'defined' has undefined behavior
+//
+// See https://developercommunity.visualstudio.com/content/problem/695656/wdk-and-sdk-are-not-compatible-with-experimentalpr.html
+// for more information.  For now disable that warning when including windows.h
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#else
+# include <pthread.h>
+#endif
+
+#include "rcutils/process.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control_macros.h"
+
+/// The signature of the function run by a thread started with rcutils_thread_create().
+typedef void (* rcutils_thread_function_t)(void * arg);
+
+typedef struct rcutils_thread_s
+{
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  pthread_t handle;
+#endif
+  rcutils_thread_function_t function;
+  void * arg;
+} rcutils_thread_t;
+
+/**
+ * \def RCUTILS_THREAD_SPECIFIC_CALLBACK
+ * The calling convention of rcutils_thread_specific_destructor_t functions.
+ */
+#ifdef _WIN32
+# define RCUTILS_THREAD_SPECIFIC_CALLBACK NTAPI
+#else
+# define RCUTILS_THREAD_SPECIFIC_CALLBACK
+#endif
+
+/// The signature of the function destroying the value of a thread specific key on thread exit.
+typedef void (RCUTILS_THREAD_SPECIFIC_CALLBACK * rcutils_thread_specific_destructor_t)(
+  void * value);
+
+typedef struct rcutils_thread_specific_s
+{
+#ifdef _WIN32
+  DWORD index;
+#else
+  pthread_key_t key;
+#endif
+} rcutils_thread_specific_t;
+
+typedef struct rcutils_mutex_s
+{
+#ifdef _WIN32
+  CRITICAL_SECTION impl;
+#else
+  pthread_mutex_t impl;
+#endif
+} rcutils_mutex_t;
+
+typedef struct rcutils_rwlock_s
+{
+#ifdef _WIN32
+  SRWLOCK impl;
+#else
+  pthread_rwlock_t impl;
+#endif
+} rcutils_rwlock_t;
+
+typedef struct rcutils_condition_variable_s
+{
+#ifdef _WIN32
+  CONDITION_VARIABLE impl;
+#else
+  pthread_cond_t impl;
+#endif
+} rcutils_condition_variable_t;
+
+/// Start a thread running `function(arg)`.
+/**
+ * The thread structure must stay valid until rcutils_thread_join() returns.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_thread_create(rcutils_thread_t * thread, rcutils_thread_function_t function, void * arg);
+
+/// Start a thread running `function(arg)` with the given attributes.
+/**
+ * The thread is given its attributes before it runs, and isn't started if they can't be set.
+ * With NULL attributes, this behaves like rcutils_thread_create().
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_thread_create_with_attributes(
+  rcutils_thread_t * thread,
+  rcutils_thread_function_t function,
+  void * arg,
+  const rcutils_thread_attributes_t * attributes);
+
+/// Wait for a thread started with rcutils_thread_create() to finish.
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_thread_join(rcutils_thread_t * thread);
+
+/// Yield the remainder of the calling thread's time slice.
+RCUTILS_LOCAL
+void
+rcutils_thread_yield(void);
+
+/// Put the calling thread to sleep until the steady clock reaches a deadline, in nanoseconds.
+/**
+ * The deadline is a time point of rcutils_steady_time_now().
+ * Where `clock_nanosleep()` sleeps on the same clock, it is given the deadline itself, so that
+ * the time spent until the call doesn't delay the wake up, and it is resumed after a signal.
+ * Elsewhere the time left is slept, which a signal can cut short.
+ * The thread can wake up later than the deadline, by the timer slack of the scheduler.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_thread_sleep_until(int64_t steady_deadline);
+
+/// Return the number of processors available to the process, or 1 if it is unknown.
+RCUTILS_LOCAL
+size_t
+rcutils_thread_get_processor_count(void);
+
+/// Create a key for a value which is different in each thread.
+/**
+ * When a thread which set a non-NULL value exits, `destructor` is called with
+ * that value.
+ * The destructor should be declared with #RCUTILS_THREAD_SPECIFIC_CALLBACK.
+ */
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_thread_specific_init(
+  rcutils_thread_specific_t * key, rcutils_thread_specific_destructor_t destructor);
+
+/// Return the value of the key in the calling thread, or NULL if it wasn't set.
+RCUTILS_LOCAL
+void *
+rcutils_thread_specific_get(rcutils_thread_specific_t * key);
+
+/// Set the value of the key in the calling thread.
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_thread_specific_set(rcutils_thread_specific_t * key, void * value);
+
+/// Delete the key; whether the destructor is called for values still set depends on the platform.
+RCUTILS_LOCAL
+void
+rcutils_thread_specific_fini(rcutils_thread_specific_t * key);
+
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_mutex_init(rcutils_mutex_t * mutex);
+
+RCUTILS_LOCAL
+void
+rcutils_mutex_lock(rcutils_mutex_t * mutex);
+
+RCUTILS_LOCAL
+void
+rcutils_mutex_unlock(rcutils_mutex_t * mutex);
+
+RCUTILS_LOCAL
+void
+rcutils_mutex_fini(rcutils_mutex_t * mutex);
+
+/// Initialize a lock which can be held by many readers at once, or by a single writer.
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_rwlock_init(rcutils_rwlock_t * lock);
+
+RCUTILS_LOCAL
+void
+rcutils_rwlock_read_lock(rcutils_rwlock_t * lock);
+
+RCUTILS_LOCAL
+void
+rcutils_rwlock_read_unlock(rcutils_rwlock_t * lock);
+
+RCUTILS_LOCAL
+void
+rcutils_rwlock_write_lock(rcutils_rwlock_t * lock);
+
+RCUTILS_LOCAL
+void
+rcutils_rwlock_write_unlock(rcutils_rwlock_t * lock);
+
+RCUTILS_LOCAL
+void
+rcutils_rwlock_fini(rcutils_rwlock_t * lock);
+
+RCUTILS_LOCAL
+rcutils_ret_t
+rcutils_condition_variable_init(rcutils_condition_variable_t * cv);
+
+/// Wait on the condition variable with the mutex held, for at most timeout_ms milliseconds.
+/**
+ * Spurious wake-ups are possible, so callers must re-check their predicate.
+ */
+RCUTILS_LOCAL
+void
+rcutils_condition_variable_wait_for(
+  rcutils_condition_variable_t * cv, rcutils_mutex_t * mutex, uint32_t timeout_ms);
+
+RCUTILS_LOCAL
+void
+rcutils_condition_variable_notify_all(rcutils_condition_variable_t * cv);
+
+/// Wake up one of the threads waiting on the condition variable, if any.
+RCUTILS_LOCAL
+void
+rcutils_condition_variable_notify_one(rcutils_condition_variable_t * cv);
+
+RCUTILS_LOCAL
+void
+rcutils_condition_variable_fini(rcutils_condition_variable_t * cv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // THREADS_H_
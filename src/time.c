@@ -19,15 +19,164 @@ extern "C"
 
 #include "rcutils/time.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define RCUTILS_FAST_CLOCK_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define RCUTILS_FAST_CLOCK_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define RCUTILS_FAST_CLOCK_ARM64
+#endif
+
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
+#include "rcutils/macros.h"
 #include "rcutils/snprintf.h"
 
+#include "./threads.h"
+
+// Both string representations of a time point consist of an optional sign, the seconds padded
+// to 10 digits (enough for any signed 64-bit time point) and the nanoseconds padded to 9 digits.
+#define SECONDS_DIGITS (10)
+#define NANOSECONDS_DIGITS (9)
+
+static const char g_two_digits[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+// Render value as exactly num_digits decimal digits, padded with leading zeros.
+static void render_digits(uint64_t value, char * digits, size_t num_digits)
+{
+  size_t i = num_digits;
+  while (i >= 2) {
+    const size_t pair = (size_t)(value % 100u) * 2u;
+    value /= 100u;
+    digits[--i] = g_two_digits[pair + 1];
+    digits[--i] = g_two_digits[pair];
+  }
+  if (i > 0) {
+    digits[--i] = (char)('0' + (value % 10u));
+  }
+}
+
+#ifdef RCUTILS_THREAD_LOCAL
+// Consecutive timestamps rendered by a thread are usually within the same second, so the digits
+// of the seconds are kept around until the next second.
+typedef struct seconds_digits_cache_s
+{
+  bool valid;
+  uint64_t seconds;
+  char digits[SECONDS_DIGITS];
+} seconds_digits_cache_t;
+
+static RCUTILS_THREAD_LOCAL seconds_digits_cache_t gtls_rcutils_seconds_digits_cache;
+#endif
+
+// Render the time point into buffer, which must fit at least 21 characters, and return the
+// length, without null terminator.
+static size_t render_time_point(
+  rcutils_time_point_value_t time_point, bool with_decimal_point, char * buffer)
+{
+  size_t length = 0;
+  // Negating in unsigned arithmetic also works for INT64_MIN.
+  uint64_t abs_time_point = (uint64_t)time_point;
+  if (time_point < 0) {
+    buffer[length++] = '-';
+    abs_time_point = 0u - abs_time_point;
+  }
+  const uint64_t seconds = abs_time_point / (1000u * 1000u * 1000u);
+  const uint64_t nanoseconds = abs_time_point % (1000u * 1000u * 1000u);
+
+#ifdef RCUTILS_THREAD_LOCAL
+  seconds_digits_cache_t * cache = &gtls_rcutils_seconds_digits_cache;
+  if (!cache->valid || cache->seconds != seconds) {
+    render_digits(seconds, cache->digits, SECONDS_DIGITS);
+    cache->seconds = seconds;
+    cache->valid = true;
+  }
+  memcpy(buffer + length, cache->digits, SECONDS_DIGITS);
+#else
+  render_digits(seconds, buffer + length, SECONDS_DIGITS);
+#endif
+  length += SECONDS_DIGITS;
+
+  if (with_decimal_point) {
+    buffer[length++] = '.';
+  }
+  render_digits(nanoseconds, buffer + length, NANOSECONDS_DIGITS);
+  length += NANOSECONDS_DIGITS;
+  return length;
+}
+
+static rcutils_ret_t format_time_point(
+  const rcutils_time_point_value_t * time_point, bool with_decimal_point,
+  char * str, size_t str_size, size_t * length)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(time_point, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(str, RCUTILS_RET_INVALID_ARGUMENT);
+  if (0 == str_size) {
+    if (NULL != length) {
+      *length = 0;
+    }
+    return RCUTILS_RET_OK;
+  }
+
+  size_t rendered_length;
+  if (str_size >= RCUTILS_TIME_POINT_VALUE_STRING_SIZE) {
+    rendered_length = render_time_point(*time_point, with_decimal_point, str);
+  } else {
+    // Truncate like snprintf() would.
+    char buffer[RCUTILS_TIME_POINT_VALUE_STRING_SIZE];
+    rendered_length = render_time_point(*time_point, with_decimal_point, buffer);
+    if (rendered_length > str_size - 1) {
+      rendered_length = str_size - 1;
+    }
+    memcpy(str, buffer, rendered_length);
+  }
+  str[rendered_length] = '\0';
+  if (NULL != length) {
+    *length = rendered_length;
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_time_point_value_format_nanoseconds(
+  const rcutils_time_point_value_t * time_point,
+  char * str,
+  size_t str_size,
+  size_t * length)
+{
+  return format_time_point(time_point, false, str, str_size, length);
+}
+
+rcutils_ret_t
+rcutils_time_point_value_format_seconds(
+  const rcutils_time_point_value_t * time_point,
+  char * str,
+  size_t str_size,
+  size_t * length)
+{
+  return format_time_point(time_point, true, str, str_size, length);
+}
+
 rcutils_ret_t
 rcutils_time_point_value_as_nanoseconds_string(
   const rcutils_time_point_value_t * time_point,
@@ -74,6 +223,292 @@ rcutils_time_point_value_as_seconds_string(
   return RCUTILS_RET_OK;
 }
 
+// The states of the fast steady clock.
+#define FAST_CLOCK_UNCALIBRATED (0u)
+#define FAST_CLOCK_CALIBRATING (1u)
+#define FAST_CLOCK_COUNTER (2u)
+#define FAST_CLOCK_FALLBACK (3u)
+
+// How long the rate of the counter is measured for.
+#define FAST_CLOCK_CALIBRATION_NS RCUTILS_MS_TO_NS(10)
+
+static uint32_t g_fast_clock_state = FAST_CLOCK_UNCALIBRATED;
+// Written once before the state becomes FAST_CLOCK_COUNTER.
+// The time is time_base + (counter - counter_base) * multiplier / 2^shift, where the multiplier
+// fits in 32 bits, so that the product can be computed in two 64-bit halves.
+static struct
+{
+  uint64_t counter_base;
+  rcutils_time_point_value_t time_base;
+  uint64_t multiplier;
+  uint32_t shift;
+} g_fast_clock;
+
+static uint32_t fast_clock_load_state(void)
+{
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange((volatile LONG *)&g_fast_clock_state, 0, 0);
+#else
+  return __atomic_load_n(&g_fast_clock_state, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void fast_clock_store_state(uint32_t state)
+{
+#ifdef _WIN32
+  (void)InterlockedExchange((volatile LONG *)&g_fast_clock_state, (LONG)state);
+#else
+  __atomic_store_n(&g_fast_clock_state, state, __ATOMIC_RELEASE);
+#endif
+}
+
+static bool fast_clock_claim(void)
+{
+#ifdef _WIN32
+  return InterlockedCompareExchange(
+    (volatile LONG *)&g_fast_clock_state, FAST_CLOCK_CALIBRATING, FAST_CLOCK_UNCALIBRATED) ==
+         FAST_CLOCK_UNCALIBRATED;
+#else
+  uint32_t expected = FAST_CLOCK_UNCALIBRATED;
+  return __atomic_compare_exchange_n(
+    &g_fast_clock_state, &expected, FAST_CLOCK_CALIBRATING, false, __ATOMIC_ACQ_REL,
+    __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline uint64_t read_counter(void)
+{
+#if defined(RCUTILS_FAST_CLOCK_X86)
+  return __rdtsc();
+#elif defined(RCUTILS_FAST_CLOCK_ARM64)
+  uint64_t counter;
+  __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (counter));
+  return counter;
+#else
+  return 0u;
+#endif
+}
+
+// Return whether the counter ticks at a constant rate, synchronized between all the cores.
+static bool has_reliable_counter(void)
+{
+#if defined(RCUTILS_FAST_CLOCK_X86)
+  // The invariant TSC is reported by bit 8 of EDX in the leaf 0x80000007.
+#ifdef _MSC_VER
+  int registers[4];
+  __cpuid(registers, (int)0x80000000);
+  if ((unsigned int)registers[0] < 0x80000007u) {
+    return false;
+  }
+  __cpuid(registers, (int)0x80000007);
+  unsigned int edx = (unsigned int)registers[3];
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+#endif
+  if (0u == (edx & (1u << 8))) {
+    return false;
+  }
+#if defined(__linux__)
+  // Linux switches away from the TSC when it finds it unsynchronized, e.g. between sockets.
+  FILE * file = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+  if (NULL != file) {
+    char clocksource[16] = "";
+    bool is_tsc = NULL != fgets(clocksource, sizeof(clocksource), file) &&
+      0 == strncmp(clocksource, "tsc", 3) && ('\n' == clocksource[3] || '\0' == clocksource[3]);
+    fclose(file);
+    return is_tsc;
+  }
+#endif
+  return true;
+#elif defined(RCUTILS_FAST_CLOCK_ARM64)
+  // The generic timer is architecturally constant rate, and synchronized between cores.
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Read the counter between two reads of the steady clock, keeping the tightest of a few tries.
+static rcutils_ret_t sample_counter(rcutils_time_point_value_t * time, uint64_t * counter)
+{
+  rcutils_time_point_value_t best_window = INT64_MAX;
+  for (int i = 0; i < 8; ++i) {
+    rcutils_time_point_value_t before, after;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&before)) {
+      return RCUTILS_RET_ERROR;
+    }
+    uint64_t value = read_counter();
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&after)) {
+      return RCUTILS_RET_ERROR;
+    }
+    if (after - before < best_window) {
+      best_window = after - before;
+      *time = before + (after - before) / 2;
+      *counter = value;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+static rcutils_ret_t calibrate_fast_clock(void)
+{
+  rcutils_time_point_value_t start_time, end_time;
+  uint64_t start_counter, end_counter;
+  if (RCUTILS_RET_OK != sample_counter(&start_time, &start_counter)) {
+    return RCUTILS_RET_ERROR;
+  }
+  do {
+    if (RCUTILS_RET_OK != sample_counter(&end_time, &end_counter)) {
+      return RCUTILS_RET_ERROR;
+    }
+  } while (end_time - start_time < FAST_CLOCK_CALIBRATION_NS);
+  if (end_counter <= start_counter) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+
+  double ns_per_tick = (double)(end_time - start_time) / (double)(end_counter - start_counter);
+  uint32_t shift = 32u;
+  while (shift > 0u && ns_per_tick * (double)(UINT64_C(1) << shift) >= 4294967296.0) {
+    --shift;
+  }
+  if (ns_per_tick * (double)(UINT64_C(1) << shift) >= 4294967296.0) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+  g_fast_clock.counter_base = end_counter;
+  g_fast_clock.time_base = end_time;
+  g_fast_clock.multiplier = (uint64_t)(ns_per_tick * (double)(UINT64_C(1) << shift) + 0.5);
+  g_fast_clock.shift = shift;
+  return RCUTILS_RET_OK;
+}
+
+static inline rcutils_time_point_value_t ticks_to_ns(uint64_t ticks)
+{
+  uint64_t high = (ticks >> 32) * g_fast_clock.multiplier;
+  uint64_t low = (ticks & UINT32_MAX) * g_fast_clock.multiplier;
+  return (rcutils_time_point_value_t)(
+    (high << (32u - g_fast_clock.shift)) + (low >> g_fast_clock.shift));
+}
+
+rcutils_ret_t
+rcutils_steady_time_fast_init(void)
+{
+  if (fast_clock_claim()) {
+    rcutils_ret_t ret = RCUTILS_RET_NOT_FOUND;
+    if (has_reliable_counter()) {
+      ret = calibrate_fast_clock();
+    }
+    if (RCUTILS_RET_ERROR == ret) {
+      fast_clock_store_state(FAST_CLOCK_UNCALIBRATED);
+      return RCUTILS_RET_ERROR;
+    }
+    fast_clock_store_state(RCUTILS_RET_OK == ret ? FAST_CLOCK_COUNTER : FAST_CLOCK_FALLBACK);
+    return RCUTILS_RET_OK;
+  }
+  uint32_t state;
+  while (FAST_CLOCK_CALIBRATING == (state = fast_clock_load_state())) {
+    rcutils_thread_yield();
+  }
+  if (FAST_CLOCK_UNCALIBRATED == state) {
+    // The calibration failed in another thread.
+    return rcutils_steady_time_fast_init();
+  }
+  return RCUTILS_RET_OK;
+}
+
+bool
+rcutils_steady_time_fast_is_reliable(void)
+{
+  return FAST_CLOCK_COUNTER == fast_clock_load_state();
+}
+
+rcutils_ret_t
+rcutils_steady_time_now_fast(rcutils_time_point_value_t * now)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(now, RCUTILS_RET_INVALID_ARGUMENT);
+  if (FAST_CLOCK_COUNTER != fast_clock_load_state()) {
+    return rcutils_steady_time_now(now);
+  }
+  uint64_t counter = read_counter();
+  // The counters of the cores may differ slightly, so the counter may be behind its base.
+  if (counter >= g_fast_clock.counter_base) {
+    *now = g_fast_clock.time_base + ticks_to_ns(counter - g_fast_clock.counter_base);
+  } else {
+    *now = g_fast_clock.time_base - ticks_to_ns(g_fast_clock.counter_base - counter);
+  }
+  return RCUTILS_RET_OK;
+}
+
+// Tells the processor that the thread is spinning, which saves power and lets a sibling
+// hyper-thread run.
+static inline void sleep_cpu_relax(void)
+{
+#if defined(_WIN32)
+  YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__ ("yield");
+#endif
+}
+
+rcutils_ret_t
+rcutils_sleep_until(rcutils_time_point_value_t steady_deadline)
+{
+  return rcutils_sleep_until_with_spin_threshold(
+    steady_deadline, RCUTILS_SLEEP_DEFAULT_SPIN_THRESHOLD);
+}
+
+rcutils_ret_t
+rcutils_sleep_until_with_spin_threshold(
+  rcutils_time_point_value_t steady_deadline,
+  rcutils_duration_value_t spin_threshold)
+{
+  if (spin_threshold < 0) {
+    RCUTILS_SET_ERROR_MSG("spin threshold must not be negative");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return RCUTILS_RET_ERROR;
+  }
+  if (steady_deadline - now > spin_threshold) {
+    if (RCUTILS_RET_OK != rcutils_thread_sleep_until(steady_deadline - spin_threshold)) {
+      return RCUTILS_RET_ERROR;
+    }
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  if (now >= steady_deadline) {
+    return RCUTILS_RET_OK;
+  }
+  if (FAST_CLOCK_COUNTER == fast_clock_load_state()) {
+    // The fast clock drifts from the steady clock, but not measurably over the time left.
+    rcutils_time_point_value_t fast_now;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now_fast(&fast_now)) {
+      return RCUTILS_RET_ERROR;
+    }
+    const rcutils_time_point_value_t fast_deadline = fast_now + (steady_deadline - now);
+    while (fast_now < fast_deadline) {
+      sleep_cpu_relax();
+      if (RCUTILS_RET_OK != rcutils_steady_time_now_fast(&fast_now)) {
+        return RCUTILS_RET_ERROR;
+      }
+    }
+    return RCUTILS_RET_OK;
+  }
+  while (now < steady_deadline) {
+    sleep_cpu_relax();
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
 #if __cplusplus
 }
 #endif
@@ -49,6 +49,23 @@
 # endif  // !defined(_POSIX_TIMERS) || !_POSIX_TIMERS
 #endif  // !defined(__MACH__) && !defined(__APPLE__)
 
+// The clocks which are only updated every tick, and cheaper to read, where there are some.
+#if defined(CLOCK_REALTIME_COARSE)
+# define RCUTILS_CLOCK_REALTIME_COARSE CLOCK_REALTIME_COARSE
+#elif defined(CLOCK_REALTIME_FAST)
+// FreeBSD
+# define RCUTILS_CLOCK_REALTIME_COARSE CLOCK_REALTIME_FAST
+#endif
+#if defined(CLOCK_MONOTONIC_COARSE)
+# define RCUTILS_CLOCK_MONOTONIC_COARSE CLOCK_MONOTONIC_COARSE
+#elif defined(__MACH__) && defined(__APPLE__) && defined(CLOCK_MONOTONIC_RAW_APPROX)
+// The counterpart of the CLOCK_MONOTONIC_RAW used by rcutils_steady_time_now().
+# define RCUTILS_CLOCK_MONOTONIC_COARSE CLOCK_MONOTONIC_RAW_APPROX
+#elif defined(CLOCK_MONOTONIC_FAST)
+// FreeBSD
+# define RCUTILS_CLOCK_MONOTONIC_COARSE CLOCK_MONOTONIC_FAST
+#endif
+
 static inline bool would_be_negative(const struct timespec * const now)
 {
   return now->tv_sec < 0 || (now->tv_nsec < 0 && now->tv_sec == 0);
@@ -74,6 +91,27 @@ rcutils_system_time_now(rcutils_time_point_value_t * now)
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_system_time_now_coarse(rcutils_time_point_value_t * now)
+{
+#if defined(RCUTILS_CLOCK_REALTIME_COARSE)
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(now, RCUTILS_RET_INVALID_ARGUMENT);
+  struct timespec timespec_now;
+  if (clock_gettime(RCUTILS_CLOCK_REALTIME_COARSE, &timespec_now) < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to get coarse system time: %d", errno);
+    return RCUTILS_RET_ERROR;
+  }
+  if (would_be_negative(&timespec_now)) {
+    RCUTILS_SET_ERROR_MSG("unexpected negative time");
+    return RCUTILS_RET_ERROR;
+  }
+  *now = RCUTILS_S_TO_NS((int64_t)timespec_now.tv_sec) + timespec_now.tv_nsec;
+  return RCUTILS_RET_OK;
+#else
+  return rcutils_system_time_now(now);
+#endif
+}
+
 rcutils_ret_t
 rcutils_steady_time_now(rcutils_time_point_value_t * now)
 {
@@ -98,3 +136,24 @@ rcutils_steady_time_now(rcutils_time_point_value_t * now)
   *now = RCUTILS_S_TO_NS((int64_t)timespec_now.tv_sec) + timespec_now.tv_nsec;
   return RCUTILS_RET_OK;
 }
+
+rcutils_ret_t
+rcutils_steady_time_now_coarse(rcutils_time_point_value_t * now)
+{
+#if defined(RCUTILS_CLOCK_MONOTONIC_COARSE)
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(now, RCUTILS_RET_INVALID_ARGUMENT);
+  struct timespec timespec_now;
+  if (clock_gettime(RCUTILS_CLOCK_MONOTONIC_COARSE, &timespec_now) < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to get coarse steady time: %d", errno);
+    return RCUTILS_RET_ERROR;
+  }
+  if (would_be_negative(&timespec_now)) {
+    RCUTILS_SET_ERROR_MSG("unexpected negative time");
+    return RCUTILS_RET_ERROR;
+  }
+  *now = RCUTILS_S_TO_NS((int64_t)timespec_now.tv_sec) + timespec_now.tv_nsec;
+  return RCUTILS_RET_OK;
+#else
+  return rcutils_steady_time_now(now);
+#endif
+}
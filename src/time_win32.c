@@ -35,6 +35,11 @@ extern "C"
 #pragma warning(disable : 5105)
 #include <windows.h>
 #pragma warning(pop)
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
+#include <stdint.h>
 
 #include "./common.h"
 #include "rcutils/allocator.h"
@@ -58,29 +63,124 @@ rcutils_system_time_now(rcutils_time_point_value_t * now)
 }
 
 rcutils_ret_t
-rcutils_steady_time_now(rcutils_time_point_value_t * now)
+rcutils_system_time_now_coarse(rcutils_time_point_value_t * now)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(now, RCUTILS_RET_INVALID_ARGUMENT);
-  LARGE_INTEGER cpu_frequency, performance_count;
-  // These should not ever fail since XP is already end of life:
-  // From https://msdn.microsoft.com/en-us/library/windows/desktop/ms644905(v=vs.85).aspx and
-  //      https://msdn.microsoft.com/en-us/library/windows/desktop/ms644904(v=vs.85).aspx:
+  FILETIME ft;
+  // Unlike GetSystemTimePreciseAsFileTime(), this only reads the time of the last clock tick.
+  GetSystemTimeAsFileTime(&ft);
+  LARGE_INTEGER li;
+  li.LowPart = ft.dwLowDateTime;
+  li.HighPart = ft.dwHighDateTime;
+  li.QuadPart -= 116444736000000000;
+  *now = li.QuadPart * 100;
+  return RCUTILS_RET_OK;
+}
+
+// The states of the conversion of the performance counter to nanoseconds.
+#define STEADY_CLOCK_UNINITIALIZED (0)
+#define STEADY_CLOCK_INITIALIZING (1)
+#define STEADY_CLOCK_INITIALIZED (2)
+
+// The performance counter is converted to nanoseconds as (counter * multiplier) >> shift,
+// where the multiplier is 10^9 * 2^shift / frequency with as many bits as fit in 64, so that
+// the conversion is exact for the usual 10 MHz, and off by a few nanoseconds at most otherwise,
+// without dividing.
+typedef struct steady_clock_conversion_s
+{
+  uint64_t multiplier;
+  uint32_t shift;
+} steady_clock_conversion_t;
+
+static volatile LONG g_steady_clock_state = STEADY_CLOCK_UNINITIALIZED;
+// Written once before the state becomes STEADY_CLOCK_INITIALIZED.
+static steady_clock_conversion_t g_steady_clock_conversion;
+
+static steady_clock_conversion_t compute_steady_clock_conversion(void)
+{
+  LARGE_INTEGER cpu_frequency;
+  // This should not ever fail since XP is already end of life:
+  // From https://msdn.microsoft.com/en-us/library/windows/desktop/ms644905(v=vs.85).aspx:
   // "On systems that run Windows XP or later, the function will always succeed and will
   //  thus never return zero."
+  // The frequency is fixed at boot, so it only needs to be queried once.
   QueryPerformanceFrequency(&cpu_frequency);
+  const uint64_t frequency = (uint64_t)cpu_frequency.QuadPart;
+  // The multiplier is doubled one bit of the shift at a time, along with the remainder of the
+  // division, so that 10^9 * 2^shift is never computed and can't overflow.
+  steady_clock_conversion_t conversion;
+  conversion.multiplier = UINT64_C(1000000000) / frequency;
+  conversion.shift = 0u;
+  uint64_t remainder = UINT64_C(1000000000) % frequency;
+  while (conversion.shift < 63u && conversion.multiplier < (UINT64_C(1) << 63)) {
+    conversion.multiplier *= 2u;
+    remainder *= 2u;
+    if (remainder >= frequency) {
+      ++conversion.multiplier;
+      remainder -= frequency;
+    }
+    ++conversion.shift;
+  }
+  return conversion;
+}
+
+// Return the 128-bit product of a and b shifted right by shift, less than 64.
+static inline uint64_t multiply_shift(uint64_t a, uint64_t b, uint32_t shift)
+{
+  uint64_t high;
+  uint64_t low;
+#if defined(_MSC_VER) && defined(_M_X64)
+  low = _umul128(a, b, &high);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+  low = a * b;
+  high = __umulh(a, b);
+#else
+  const uint64_t low_low = (a & UINT32_MAX) * (b & UINT32_MAX);
+  const uint64_t high_low = (a >> 32) * (b & UINT32_MAX);
+  const uint64_t low_high = (a & UINT32_MAX) * (b >> 32);
+  const uint64_t middle = (low_low >> 32) + (high_low & UINT32_MAX) + low_high;
+  high = (a >> 32) * (b >> 32) + (high_low >> 32) + (middle >> 32);
+  low = (middle << 32) | (low_low & UINT32_MAX);
+#endif
+  return 0u == shift ? low : (high << (64u - shift)) | (low >> shift);
+}
+
+rcutils_ret_t
+rcutils_steady_time_now(rcutils_time_point_value_t * now)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(now, RCUTILS_RET_INVALID_ARGUMENT);
+  steady_clock_conversion_t conversion;
+  // Unlike InterlockedCompareExchange(), ReadAcquire() doesn't take the cache line of the state
+  // for itself, which would make threads reading the clock at once contend for it.
+  if (STEADY_CLOCK_INITIALIZED == ReadAcquire(&g_steady_clock_state)) {
+    conversion = g_steady_clock_conversion;
+  } else {
+    // Threads racing to initialize it all compute the same conversion, and one stores it.
+    conversion = compute_steady_clock_conversion();
+    if (STEADY_CLOCK_UNINITIALIZED == InterlockedCompareExchange(
+        &g_steady_clock_state, STEADY_CLOCK_INITIALIZING, STEADY_CLOCK_UNINITIALIZED))
+    {
+      g_steady_clock_conversion = conversion;
+      (void)InterlockedExchange(&g_steady_clock_state, STEADY_CLOCK_INITIALIZED);
+    }
+  }
+  LARGE_INTEGER performance_count;
+  // This should not ever fail either, see
+  // https://msdn.microsoft.com/en-us/library/windows/desktop/ms644904(v=vs.85).aspx
   QueryPerformanceCounter(&performance_count);
-  // Calculate nanoseconds and seconds separately because
-  // otherwise overflow can happen in intermediate calculations
   // This conversion will overflow if the PC runs >292 years non-stop
-  const rcutils_time_point_value_t whole_seconds =
-    performance_count.QuadPart / cpu_frequency.QuadPart;
-  const rcutils_time_point_value_t remainder_count =
-    performance_count.QuadPart % cpu_frequency.QuadPart;
-  const rcutils_time_point_value_t remainder_ns =
-    RCUTILS_S_TO_NS(remainder_count) / cpu_frequency.QuadPart;
-  const rcutils_time_point_value_t total_ns =
-    RCUTILS_S_TO_NS(whole_seconds) + remainder_ns;
-  *now = total_ns;
+  *now = (rcutils_time_point_value_t)multiply_shift(
+    (uint64_t)performance_count.QuadPart, conversion.multiplier, conversion.shift);
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_steady_time_now_coarse(rcutils_time_point_value_t * now)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(now, RCUTILS_RET_INVALID_ARGUMENT);
+  // Unlike QueryPerformanceCounter(), this only reads the time of the last clock tick, from
+  // memory shared with the kernel, in milliseconds.
+  *now = RCUTILS_MS_TO_NS((rcutils_time_point_value_t)GetTickCount64());
   return RCUTILS_RET_OK;
 }
 
@@ -104,3 +104,46 @@ rcutils_uint8_array_resize(rcutils_uint8_array_t * uint8_array, size_t new_size)
 
   return RCUTILS_RET_OK;
 }
+
+static rcutils_ret_t
+_rcutils_uint8_array_view_of(
+  const uint8_t * buffer, size_t buffer_length, size_t offset, size_t length,
+  rcutils_uint8_array_view_t * view)
+{
+  if (offset > buffer_length || length > buffer_length - offset) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "range of %zu bytes at offset %zu is out of bounds of %zu bytes",
+      length, offset, buffer_length);
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  view->buffer = NULL == buffer ? NULL : buffer + offset;
+  view->buffer_length = length;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_uint8_array_get_view(
+  const rcutils_uint8_array_t * uint8_array,
+  size_t offset,
+  size_t length,
+  rcutils_uint8_array_view_t * view)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(uint8_array, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(view, RCUTILS_RET_INVALID_ARGUMENT);
+
+  return _rcutils_uint8_array_view_of(
+    uint8_array->buffer, uint8_array->buffer_length, offset, length, view);
+}
+
+rcutils_ret_t
+rcutils_uint8_array_view_slice(
+  const rcutils_uint8_array_view_t * view,
+  size_t offset,
+  size_t length,
+  rcutils_uint8_array_view_t * slice)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(view, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(slice, RCUTILS_RET_INVALID_ARGUMENT);
+
+  return _rcutils_uint8_array_view_of(view->buffer, view->buffer_length, offset, length, slice);
+}
@@ -0,0 +1,233 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "./threads.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/uint8_array.h"
+#include "rcutils/types/uint8_array_pool.h"
+#include "rcutils/macros.h"
+
+// One size class per power of two a size_t can hold
+#define UINT8_ARRAY_POOL_CLASS_COUNT (sizeof(size_t) * CHAR_BIT)
+
+// A buffer held by the pool, which is stored at the start of the buffer itself
+typedef struct uint8_array_pool_buffer_s
+{
+  struct uint8_array_pool_buffer_s * next;
+  size_t capacity;
+} uint8_array_pool_buffer_t;
+
+typedef struct uint8_array_pool_class_s
+{
+  uint8_array_pool_buffer_t * buffers;
+  size_t count;
+} uint8_array_pool_class_t;
+
+typedef struct rcutils_uint8_array_pool_impl_s
+{
+  rcutils_mutex_t lock;
+  // The buffers of class k have a capacity of at least 2^k and less than 2^(k + 1)
+  uint8_array_pool_class_t classes[UINT8_ARRAY_POOL_CLASS_COUNT];
+  size_t max_buffers_per_class;
+  rcutils_allocator_t allocator;
+} rcutils_uint8_array_pool_impl_t;
+
+#define UINT8_ARRAY_POOL_VALIDATE_POOL(pool) \
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pool, RCUTILS_RET_INVALID_ARGUMENT); \
+  if (NULL == pool->impl) { \
+    RCUTILS_SET_ERROR_MSG("uint8 array pool is not initialized"); \
+    return RCUTILS_RET_NOT_INITIALIZED; \
+  }
+
+// The size class of buffers with the given capacity, which must not be zero
+static size_t class_of_capacity(size_t capacity)
+{
+  size_t k = 0;
+  while (capacity > 1) {
+    capacity >>= 1;
+    ++k;
+  }
+  return k;
+}
+
+static bool is_same_allocator(const rcutils_allocator_t * a, const rcutils_allocator_t * b)
+{
+  return a->allocate == b->allocate && a->deallocate == b->deallocate && a->state == b->state;
+}
+
+rcutils_uint8_array_pool_t
+rcutils_get_zero_initialized_uint8_array_pool(void)
+{
+  static rcutils_uint8_array_pool_t zero_initialized_uint8_array_pool = {NULL};
+  return zero_initialized_uint8_array_pool;
+}
+
+rcutils_ret_t
+rcutils_uint8_array_pool_init(
+  rcutils_uint8_array_pool_t * pool,
+  size_t max_buffers_per_class,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pool, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_uint8_array_pool_impl_t * impl =
+    allocator->allocate(sizeof(rcutils_uint8_array_pool_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for uint8 array pool impl");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (RCUTILS_RET_OK != rcutils_mutex_init(&impl->lock)) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to initialize the lock of the uint8 array pool");
+    return RCUTILS_RET_ERROR;
+  }
+  for (size_t k = 0; k < UINT8_ARRAY_POOL_CLASS_COUNT; ++k) {
+    impl->classes[k].buffers = NULL;
+    impl->classes[k].count = 0;
+  }
+  impl->max_buffers_per_class = max_buffers_per_class;
+  impl->allocator = *allocator;
+  pool->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_uint8_array_pool_fini(rcutils_uint8_array_pool_t * pool)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(pool, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_uint8_array_pool_impl_t * impl = pool->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+  rcutils_allocator_t allocator = impl->allocator;
+  for (size_t k = 0; k < UINT8_ARRAY_POOL_CLASS_COUNT; ++k) {
+    uint8_array_pool_buffer_t * buffer = impl->classes[k].buffers;
+    while (NULL != buffer) {
+      uint8_array_pool_buffer_t * next = buffer->next;
+      allocator.deallocate(buffer, allocator.state);
+      buffer = next;
+    }
+  }
+  rcutils_mutex_fini(&impl->lock);
+  allocator.deallocate(impl, allocator.state);
+  pool->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_uint8_array_pool_acquire(
+  rcutils_uint8_array_pool_t * pool,
+  size_t capacity,
+  rcutils_uint8_array_t * uint8_array)
+{
+  UINT8_ARRAY_POOL_VALIDATE_POOL(pool);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(uint8_array, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_uint8_array_pool_impl_t * impl = pool->impl;
+
+  if (capacity < RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY) {
+    capacity = RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY;
+  }
+  // Round the capacity up to a power of two, so any buffer of its class is large enough.
+  size_t k = class_of_capacity(capacity);
+  if (((size_t)1 << k) < capacity) {
+    ++k;
+  }
+  if (k >= UINT8_ARRAY_POOL_CLASS_COUNT) {
+    RCUTILS_SET_ERROR_MSG("uint8 array capacity is too large");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  rcutils_mutex_lock(&impl->lock);
+  uint8_array_pool_class_t * size_class = &impl->classes[k];
+  uint8_array_pool_buffer_t * buffer = size_class->buffers;
+  if (NULL != buffer) {
+    size_class->buffers = buffer->next;
+    --size_class->count;
+  }
+  rcutils_mutex_unlock(&impl->lock);
+
+  if (NULL != buffer) {
+    capacity = buffer->capacity;
+  } else {
+    capacity = (size_t)1 << k;
+    buffer = impl->allocator.allocate(capacity, impl->allocator.state);
+    if (NULL == buffer) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for uint8 array");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+
+  uint8_array->buffer = (uint8_t *)buffer;
+  uint8_array->buffer_length = 0;
+  uint8_array->buffer_capacity = capacity;
+  uint8_array->allocator = impl->allocator;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_uint8_array_pool_release(
+  rcutils_uint8_array_pool_t * pool,
+  rcutils_uint8_array_t * uint8_array)
+{
+  UINT8_ARRAY_POOL_VALIDATE_POOL(pool);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(uint8_array, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_uint8_array_pool_impl_t * impl = pool->impl;
+
+  bool kept = false;
+  if (NULL != uint8_array->buffer &&
+    uint8_array->buffer_capacity >= RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY &&
+    is_same_allocator(&uint8_array->allocator, &impl->allocator))
+  {
+    uint8_array_pool_buffer_t * buffer = (uint8_array_pool_buffer_t *)uint8_array->buffer;
+    buffer->capacity = uint8_array->buffer_capacity;
+    uint8_array_pool_class_t * size_class =
+      &impl->classes[class_of_capacity(uint8_array->buffer_capacity)];
+
+    rcutils_mutex_lock(&impl->lock);
+    if (size_class->count < impl->max_buffers_per_class) {
+      buffer->next = size_class->buffers;
+      size_class->buffers = buffer;
+      ++size_class->count;
+      kept = true;
+    }
+    rcutils_mutex_unlock(&impl->lock);
+  }
+
+  if (!kept && NULL != uint8_array->buffer) {
+    rcutils_ret_t ret = rcutils_uint8_array_fini(uint8_array);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+  *uint8_array = rcutils_get_zero_initialized_uint8_array();
+  return RCUTILS_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,416 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define RCUTILS_UTF8_AVX2
+#define RCUTILS_UTF8_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define RCUTILS_UTF8_AVX2
+#define RCUTILS_UTF8_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+// See logging.c for why warning C5105 is disabled.
+# pragma warning(push)
+# pragma warning(disable : 5105)
+# include <windows.h>
+# pragma warning(pop)
+#endif
+
+#include "rcutils/utf8.h"
+
+#include "rcutils/error_handling.h"
+
+// Returns the index of the first invalid byte of a string, or SIZE_MAX if it is valid.
+typedef size_t (* utf8_validate_t)(const uint8_t * str, size_t length);
+
+// Returns the length of the valid sequence at the start of a string, which isn't empty, or 0 if
+// it is invalid, in which case the length of its maximal invalid subpart is returned in
+// invalid_length.
+static size_t utf8_sequence_length(const uint8_t * str, size_t length, size_t * invalid_length)
+{
+  const uint8_t lead = str[0];
+  if (lead < 0x80u) {
+    return 1;
+  }
+  size_t continuations;
+  if (lead < 0xC2u) {
+    // A continuation byte, or the lead byte of an overlong encoding of an ASCII character.
+    *invalid_length = 1;
+    return 0;
+  } else if (lead < 0xE0u) {
+    continuations = 1;
+  } else if (lead < 0xF0u) {
+    continuations = 2;
+  } else if (lead < 0xF5u) {
+    continuations = 3;
+  } else {
+    *invalid_length = 1;
+    return 0;
+  }
+  // Only the second byte has a narrower range, which rules out overlong encodings, surrogates
+  // and code points above U+10FFFF.
+  uint8_t lower = 0x80u;
+  uint8_t upper = 0xBFu;
+  if (0xE0u == lead) {
+    lower = 0xA0u;
+  } else if (0xEDu == lead) {
+    upper = 0x9Fu;
+  } else if (0xF0u == lead) {
+    lower = 0x90u;
+  } else if (0xF4u == lead) {
+    upper = 0x8Fu;
+  }
+  for (size_t i = 1; i <= continuations; ++i) {
+    if (i >= length || str[i] < lower || str[i] > upper) {
+      *invalid_length = i;
+      return 0;
+    }
+    lower = 0x80u;
+    upper = 0xBFu;
+  }
+  return continuations + 1;
+}
+
+static size_t utf8_validate_scalar(const uint8_t * str, size_t length)
+{
+  size_t i = 0;
+  while (i < length) {
+    // Skip 8 characters of ASCII at once, which is the bulk of log messages.
+    if (length - i >= 8) {
+      uint64_t word;
+      memcpy(&word, str + i, sizeof(word));
+      if (0u == (word & UINT64_C(0x8080808080808080))) {
+        i += 8;
+        continue;
+      }
+    }
+    size_t invalid_length;
+    const size_t sequence_length = utf8_sequence_length(str + i, length - i, &invalid_length);
+    if (0 == sequence_length) {
+      return i;
+    }
+    i += sequence_length;
+  }
+  return SIZE_MAX;
+}
+
+#if defined(RCUTILS_UTF8_AVX2)
+// The kinds of errors of a pair of consecutive bytes, of which the lookup tables below tell
+// which the high and low nibbles of the first byte and the high nibble of the second byte allow.
+// The pair is invalid if all three agree on any kind, which is the algorithm of "Validating
+// UTF-8 In Less Than One Instruction Per Byte" by Keiser and Lemire, as used by simdutf.
+#define UTF8_TOO_SHORT (1u << 0)  // A lead byte followed by a lead byte or ASCII.
+#define UTF8_TOO_LONG (1u << 1)  // ASCII followed by a continuation byte.
+#define UTF8_OVERLONG_3 (1u << 2)  // 11100000 100_____
+#define UTF8_TOO_LARGE (1u << 3)  // 11110100 1001____ and above.
+#define UTF8_SURROGATE (1u << 4)  // 11101101 101_____
+#define UTF8_OVERLONG_2 (1u << 5)  // 1100000_ 10______
+#define UTF8_TOO_LARGE_1000 (1u << 6)  // 11110101 1000____ and above.
+#define UTF8_OVERLONG_4 (1u << 6)  // 11110000 1000____
+#define UTF8_TWO_CONTS (1u << 7)  // A continuation byte followed by a continuation byte.
+// The kinds of errors which don't depend on the low nibble of the first byte.
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static const uint8_t g_utf8_byte_1_high[16] = {
+  UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+  UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+  UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+  UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+  UTF8_TOO_SHORT,
+  UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+  UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+static const uint8_t g_utf8_byte_1_low[16] = {
+  UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+  UTF8_CARRY | UTF8_OVERLONG_2,
+  UTF8_CARRY,
+  UTF8_CARRY,
+  UTF8_CARRY | UTF8_TOO_LARGE,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+static const uint8_t g_utf8_byte_2_high[16] = {
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 |
+  UTF8_OVERLONG_4,
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+// The bytes which are still missing continuation bytes at the end of a block, if they are lead
+// bytes of sequences of at least 4, 3 and 2 bytes respectively.
+static const uint8_t g_utf8_incomplete_max[32] = {
+  0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+  0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+  0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+  0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xF0u - 1u, 0xE0u - 1u, 0xC0u - 1u,
+};
+
+// Returns the bytes of the block shifted by n towards its end, with the last n bytes of the
+// previous block in front.
+#define UTF8_PREVIOUS(block, previous, n) \
+  _mm256_alignr_epi8((block), _mm256_permute2x128_si256((previous), (block), 0x21), 16 - (n))
+
+// Returns the high nibble of each byte.
+RCUTILS_UTF8_AVX2_TARGET
+static __m256i utf8_high_nibbles_avx2(__m256i bytes)
+{
+  return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+// Returns the errors of the block, which are nonzero bytes.
+RCUTILS_UTF8_AVX2_TARGET
+static __m256i utf8_check_block_avx2(__m256i block, __m256i previous)
+{
+  const __m256i byte_1_high_table =
+    _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)g_utf8_byte_1_high));
+  const __m256i byte_1_low_table =
+    _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)g_utf8_byte_1_low));
+  const __m256i byte_2_high_table =
+    _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)g_utf8_byte_2_high));
+
+  const __m256i previous_1 = UTF8_PREVIOUS(block, previous, 1);
+  const __m256i byte_1_high =
+    _mm256_shuffle_epi8(byte_1_high_table, utf8_high_nibbles_avx2(previous_1));
+  const __m256i byte_1_low = _mm256_shuffle_epi8(
+    byte_1_low_table, _mm256_and_si256(previous_1, _mm256_set1_epi8(0x0F)));
+  const __m256i byte_2_high =
+    _mm256_shuffle_epi8(byte_2_high_table, utf8_high_nibbles_avx2(block));
+  const __m256i special_cases =
+    _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  // The third and fourth bytes of sequences must be continuation bytes, which the pairs above
+  // report as two continuation bytes in a row, so that flag is expected exactly there.
+  const __m256i previous_2 = UTF8_PREVIOUS(block, previous, 2);
+  const __m256i previous_3 = UTF8_PREVIOUS(block, previous, 3);
+  const __m256i third_byte = _mm256_subs_epu8(previous_2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+  const __m256i fourth_byte = _mm256_subs_epu8(previous_3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+  const __m256i must_be_continuation = _mm256_and_si256(
+    _mm256_or_si256(third_byte, fourth_byte), _mm256_set1_epi8((char)0x80));
+  return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+// Returns the index of the first byte at or before the given index which starts a sequence,
+// when the bytes before it are known to be valid, except for the last sequence maybe being cut
+// short.
+static size_t utf8_sequence_start(const uint8_t * str, size_t index)
+{
+  size_t continuations = 0;
+  while (continuations < 3 && continuations < index &&
+    0x80u == (str[index - continuations - 1] & 0xC0u))
+  {
+    ++continuations;
+  }
+  if (continuations < 3 && continuations < index && str[index - continuations - 1] >= 0xC0u) {
+    return index - continuations - 1;
+  }
+  return index;
+}
+
+RCUTILS_UTF8_AVX2_TARGET
+static size_t utf8_validate_avx2(const uint8_t * str, size_t length)
+{
+  const __m256i incomplete_max = _mm256_loadu_si256((const __m256i *)g_utf8_incomplete_max);
+  __m256i previous = _mm256_setzero_si256();
+  __m256i previous_incomplete = _mm256_setzero_si256();
+  size_t offset = 0;
+  while (offset < length) {
+    __m256i block;
+    if (length - offset >= 32) {
+      block = _mm256_loadu_si256((const __m256i *)(str + offset));
+    } else {
+      // The end is padded with null characters, after which a sequence cut short is an error.
+      uint8_t padded[32] = {0};
+      memcpy(padded, str + offset, length - offset);
+      block = _mm256_loadu_si256((const __m256i *)padded);
+    }
+    __m256i error;
+    if (0 == _mm256_movemask_epi8(block)) {
+      error = previous_incomplete;
+      previous_incomplete = _mm256_setzero_si256();
+    } else {
+      error = utf8_check_block_avx2(block, previous);
+      previous_incomplete = _mm256_subs_epu8(block, incomplete_max);
+    }
+    if (!_mm256_testz_si256(error, error)) {
+      break;
+    }
+    previous = block;
+    offset += 32;
+  }
+  if (offset >= length && _mm256_testz_si256(previous_incomplete, previous_incomplete)) {
+    return SIZE_MAX;
+  }
+  // The error may be in a sequence started in the previous block, so the scalar validation,
+  // which finds the exact index, starts from there.
+  offset = offset < length ? offset : length;
+  const size_t start = utf8_sequence_start(str, offset);
+  const size_t invalid = utf8_validate_scalar(str + start, length - start);
+  return SIZE_MAX == invalid ? SIZE_MAX : start + invalid;
+}
+
+static int utf8_has_avx2(void)
+{
+  // AVX2 is reported by bit 5 of EBX in the leaf 7, but is only usable if the OS saves the
+  // YMM registers, which is reported by bit 27 (OSXSAVE) of ECX in the leaf 1 and XCR0.
+#ifdef _MSC_VER
+  int registers[4];
+  __cpuid(registers, 0);
+  if (registers[0] < 7) {
+    return 0;
+  }
+  __cpuid(registers, 1);
+  const unsigned int ecx = (unsigned int)registers[2];
+  if (0u == (ecx & (1u << 27)) || 6u != (_xgetbv(0) & 6u)) {
+    return 0;
+  }
+  __cpuidex(registers, 7, 0);
+  const unsigned int ebx = (unsigned int)registers[1];
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0u, NULL) < 7u || !__get_cpuid(1u, &eax, &ebx, &ecx, &edx) ||
+    0u == (ecx & (1u << 27)))
+  {
+    return 0;
+  }
+  unsigned int xcr0, xcr0_high;
+  __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0_high) : "c" (0u));
+  if (6u != (xcr0 & 6u)) {
+    return 0;
+  }
+  __cpuid_count(7u, 0u, eax, ebx, ecx, edx);
+#endif
+  return 0u != (ebx & (1u << 5));
+}
+#endif
+
+static utf8_validate_t g_utf8_validate = NULL;
+
+static utf8_validate_t get_utf8_validate(void)
+{
+#ifdef _WIN32
+  utf8_validate_t validate =
+    (utf8_validate_t)InterlockedCompareExchangePointer(
+    (PVOID volatile *)&g_utf8_validate, NULL, NULL);
+#else
+  utf8_validate_t validate = __atomic_load_n(&g_utf8_validate, __ATOMIC_ACQUIRE);
+#endif
+  if (NULL != validate) {
+    return validate;
+  }
+  // Threads racing here pick the same function, so it may be stored more than once.
+  validate = utf8_validate_scalar;
+#if defined(RCUTILS_UTF8_AVX2)
+  if (utf8_has_avx2()) {
+    validate = utf8_validate_avx2;
+  }
+#endif
+#ifdef _WIN32
+  (void)InterlockedExchangePointer((PVOID volatile *)&g_utf8_validate, (PVOID)validate);
+#else
+  __atomic_store_n(&g_utf8_validate, validate, __ATOMIC_RELEASE);
+#endif
+  return validate;
+}
+
+size_t
+rcutils_utf8_validate(const char * str, size_t length)
+{
+  if (0 == length) {
+    return SIZE_MAX;
+  }
+  if (NULL == str) {
+    return 0;
+  }
+  return get_utf8_validate()((const uint8_t *)str, length);
+}
+
+rcutils_ret_t
+rcutils_utf8_sanitize(const char * str, size_t length, rcutils_char_array_t * output)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output, RCUTILS_RET_INVALID_ARGUMENT);
+  if (0 != length) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(str, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  const utf8_validate_t validate = get_utf8_validate();
+  const uint8_t * input = (const uint8_t *)str;
+  size_t invalid = 0 == length ? SIZE_MAX : validate(input, length);
+  if (SIZE_MAX == invalid) {
+    // str may be NULL when length is 0, which memcpy() doesn't accept.
+    return rcutils_char_array_strncat(output, 0 == length ? "" : str, length);
+  }
+
+  // Each invalid byte is replaced by at most the 3 bytes of U+FFFD.
+  const size_t position = 0 == output->buffer_length ? 0 : output->buffer_length - 1;
+  const size_t invalid_bytes = length - invalid;
+  if (invalid_bytes > (SIZE_MAX - position - length - 1) / 2) {
+    RCUTILS_SET_ERROR_MSG("sanitized string is too long");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  rcutils_ret_t ret =
+    rcutils_char_array_expand_as_needed(output, position + length + 2 * invalid_bytes + 1);
+  if (RCUTILS_RET_OK != ret) {
+    RCUTILS_SET_ERROR_MSG("char array failed to expand");
+    return ret;
+  }
+
+  // Copy the valid runs, each found with a single validation, and replace what is between them.
+  char * buffer = output->buffer + position;
+  size_t written = 0;
+  size_t i = 0;
+  for (;;) {
+    memcpy(buffer + written, str + i, invalid);
+    written += invalid;
+    i += invalid;
+    size_t invalid_length = 0;
+    (void)utf8_sequence_length(input + i, length - i, &invalid_length);
+    memcpy(buffer + written, "\xEF\xBF\xBD", 3);
+    written += 3;
+    i += invalid_length;
+    if (i == length) {
+      break;
+    }
+    invalid = validate(input + i, length - i);
+    if (SIZE_MAX == invalid) {
+      memcpy(buffer + written, str + i, length - i);
+      written += length - i;
+      break;
+    }
+  }
+  buffer[written] = '\0';
+  output->buffer_length = position + written + 1;
+  return RCUTILS_RET_OK;
+}
@@ -15,6 +15,8 @@
 #ifndef ALLOCATOR_TESTING_UTILS_H_
 #define ALLOCATOR_TESTING_UTILS_H_
 
+#include <atomic>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -87,6 +89,80 @@ set_failing_allocator_is_failing(rcutils_allocator_t & failing_allocator, bool s
   ((__failing_allocator_state *)failing_allocator.state)->is_failing = state;
 }
 
+typedef struct __counting_allocator_state
+{
+  std::atomic<size_t> allocations;
+  std::atomic<size_t> deallocations;
+} __counting_allocator_state;
+
+void *
+counting_malloc(size_t size, void * state)
+{
+  ++((__counting_allocator_state *)state)->allocations;
+  return rcutils_get_default_allocator().allocate(size, rcutils_get_default_allocator().state);
+}
+
+void *
+counting_realloc(void * pointer, size_t size, void * state)
+{
+  ++((__counting_allocator_state *)state)->allocations;
+  return rcutils_get_default_allocator().reallocate(
+    pointer, size, rcutils_get_default_allocator().state);
+}
+
+void
+counting_free(void * pointer, void * state)
+{
+  if (NULL != pointer) {
+    ++((__counting_allocator_state *)state)->deallocations;
+  }
+  rcutils_get_default_allocator().deallocate(pointer, rcutils_get_default_allocator().state);
+}
+
+void *
+counting_calloc(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  ++((__counting_allocator_state *)state)->allocations;
+  return rcutils_get_default_allocator().zero_allocate(
+    number_of_elements, size_of_element, rcutils_get_default_allocator().state);
+}
+
+/// Return an allocator counting its allocations and reallocations, and its deallocations,
+/// from any thread.
+static inline rcutils_allocator_t
+get_counting_allocator(void)
+{
+  static __counting_allocator_state state;
+  state.allocations = 0;
+  state.deallocations = 0;
+  auto counting_allocator = rcutils_get_default_allocator();
+  counting_allocator.allocate = counting_malloc;
+  counting_allocator.deallocate = counting_free;
+  counting_allocator.reallocate = counting_realloc;
+  counting_allocator.zero_allocate = counting_calloc;
+  counting_allocator.state = &state;
+  return counting_allocator;
+}
+
+static inline size_t
+get_counting_allocator_allocations(const rcutils_allocator_t & counting_allocator)
+{
+  return ((__counting_allocator_state *)counting_allocator.state)->allocations;
+}
+
+static inline size_t
+get_counting_allocator_deallocations(const rcutils_allocator_t & counting_allocator)
+{
+  return ((__counting_allocator_state *)counting_allocator.state)->deallocations;
+}
+
+static inline void
+reset_counting_allocator_allocations(rcutils_allocator_t & counting_allocator)
+{
+  ((__counting_allocator_state *)counting_allocator.state)->allocations = 0;
+  ((__counting_allocator_state *)counting_allocator.state)->deallocations = 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
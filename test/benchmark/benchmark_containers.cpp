@@ -0,0 +1,978 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../allocator_testing_utils.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/isalnum_no_locale.h"
+#include "rcutils/qsort.h"
+#include "rcutils/split.h"
+#include "rcutils/strcasecmp.h"
+#include "rcutils/strdup.h"
+#include "rcutils/types/array_list.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/string_array.h"
+#include "rcutils/types/string_map.h"
+#include "rcutils/validate_charset.h"
+
+// Counts the allocations made while the benchmark is timed, and reports them per operation,
+// where an operation is an item processed, e.g. an entry set in a map.
+class AllocationCounter
+{
+public:
+  explicit AllocationCounter(benchmark::State & state)
+  : state_(state), allocator_(get_counting_allocator()), allocations_(0)
+  {
+  }
+
+  ~AllocationCounter()
+  {
+    pause();
+    int64_t operations = std::max<int64_t>(state_.items_processed(), 1);
+    state_.counters["allocations_per_operation"] =
+      static_cast<double>(allocations_) / static_cast<double>(operations);
+  }
+
+  // Stops counting, e.g. while the state is paused.
+  void pause()
+  {
+    allocations_ += get_counting_allocator_allocations(allocator_);
+    reset_counting_allocator_allocations(allocator_);
+  }
+
+  // Doesn't count the allocations made since the last pause.
+  void resume()
+  {
+    reset_counting_allocator_allocations(allocator_);
+  }
+
+  rcutils_allocator_t * allocator()
+  {
+    return &allocator_;
+  }
+
+private:
+  benchmark::State & state_;
+  rcutils_allocator_t allocator_;
+  size_t allocations_;
+};
+
+// Names which look like the fully qualified names of loggers or topics.
+static std::vector<std::string> make_names(size_t count, const char * prefix = "/robot/node_")
+{
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    names.push_back(prefix + std::to_string(i) + "/topic");
+  }
+  return names;
+}
+
+static size_t uint64_hash_func(const void * key)
+{
+  return static_cast<size_t>(*static_cast<const uint64_t *>(key));
+}
+
+static int uint64_cmp_func(const void * val1, const void * val2)
+{
+  uint64_t key1 = *static_cast<const uint64_t *>(val1);
+  uint64_t key2 = *static_cast<const uint64_t *>(val2);
+  return key1 < key2 ? -1 : (key1 > key2 ? 1 : 0);
+}
+
+// The keys of a hash map benchmark, which are either integers or strings, and keys which
+// are not in the map, in a random order.
+class HashMapKeys
+{
+public:
+  HashMapKeys(size_t count, bool string_keys)
+  : string_keys_(string_keys)
+  {
+    std::mt19937 random(42);
+    if (string_keys_) {
+      names_ = make_names(count);
+      missing_names_ = make_names(count, "/robot/missing_node_");
+      for (size_t i = 0; i < count; ++i) {
+        string_keys_storage_.push_back(names_[i].c_str());
+        missing_string_keys_.push_back(missing_names_[i].c_str());
+      }
+      std::shuffle(string_keys_storage_.begin(), string_keys_storage_.end(), random);
+      std::shuffle(missing_string_keys_.begin(), missing_string_keys_.end(), random);
+    } else {
+      for (uint64_t i = 0; i < count; ++i) {
+        integer_keys_.push_back(i * 7919u);
+        missing_integer_keys_.push_back(i * 7919u + 1u);
+      }
+      std::shuffle(integer_keys_.begin(), integer_keys_.end(), random);
+      std::shuffle(missing_integer_keys_.begin(), missing_integer_keys_.end(), random);
+    }
+  }
+
+  const void * key(size_t index) const
+  {
+    return string_keys_ ?
+           static_cast<const void *>(&string_keys_storage_[index]) :
+           static_cast<const void *>(&integer_keys_[index]);
+  }
+
+  const void * missing_key(size_t index) const
+  {
+    return string_keys_ ?
+           static_cast<const void *>(&missing_string_keys_[index]) :
+           static_cast<const void *>(&missing_integer_keys_[index]);
+  }
+
+  rcutils_ret_t init(
+    rcutils_hash_map_t * hash_map, rcutils_hash_map_backend_t backend,
+    rcutils_allocator_t * allocator) const
+  {
+    *hash_map = rcutils_get_zero_initialized_hash_map();
+    if (string_keys_) {
+      return rcutils_hash_map_init_with_backend(
+        hash_map, 2, sizeof(const char *), sizeof(uint64_t),
+        rcutils_hash_map_string_fast_hash_func, rcutils_hash_map_string_cmp_func, backend,
+        allocator);
+    }
+    return rcutils_hash_map_init_with_backend(
+      hash_map, 2, sizeof(uint64_t), sizeof(uint64_t), uint64_hash_func, uint64_cmp_func,
+      backend, allocator);
+  }
+
+private:
+  bool string_keys_;
+  std::vector<std::string> names_;
+  std::vector<std::string> missing_names_;
+  std::vector<const char *> string_keys_storage_;
+  std::vector<const char *> missing_string_keys_;
+  std::vector<uint64_t> integer_keys_;
+  std::vector<uint64_t> missing_integer_keys_;
+};
+
+// The arguments of the hash map benchmarks: the number of entries, the backend, and whether
+// the keys are strings.
+static void hash_map_arguments(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgNames({"entries", "backend", "string_keys"})->ArgsProduct(
+  {
+    benchmark::CreateRange(10, 1000000, 10),
+    {
+      RCUTILS_HASH_MAP_BACKEND_CHAINING,
+      RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL
+    },
+    {0, 1}
+  });
+}
+
+// Sets every key in a map, with room reserved for them if reserve is true, or growing it from
+// its initial capacity otherwise.
+static void benchmark_hash_map_set(benchmark::State & state, bool reserve)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const auto backend = static_cast<rcutils_hash_map_backend_t>(state.range(1));
+  HashMapKeys keys(count, 0 != state.range(2));
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocations.pause();
+    rcutils_hash_map_t hash_map;
+    if (RCUTILS_RET_OK != keys.init(&hash_map, backend, allocations.allocator()) ||
+      (reserve && RCUTILS_RET_OK != rcutils_hash_map_reserve(&hash_map, count)))
+    {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    allocations.resume();
+    state.ResumeTiming();
+
+    for (uint64_t i = 0; i < count; ++i) {
+      benchmark::DoNotOptimize(rcutils_hash_map_set(&hash_map, keys.key(i), &i));
+    }
+
+    state.PauseTiming();
+    allocations.pause();
+    if (RCUTILS_RET_OK != rcutils_hash_map_fini(&hash_map)) {
+      rcutils_reset_error();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+static void benchmark_hash_map_insert(benchmark::State & state)
+{
+  benchmark_hash_map_set(state, true);
+}
+BENCHMARK(benchmark_hash_map_insert)->Apply(hash_map_arguments);
+
+static void benchmark_hash_map_growth(benchmark::State & state)
+{
+  benchmark_hash_map_set(state, false);
+}
+BENCHMARK(benchmark_hash_map_growth)->Apply(hash_map_arguments);
+
+// Looks up keys which are in the map if hit is true, or keys which aren't otherwise.
+static void benchmark_hash_map_get(benchmark::State & state, bool hit)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const auto backend = static_cast<rcutils_hash_map_backend_t>(state.range(1));
+  HashMapKeys keys(count, 0 != state.range(2));
+  AllocationCounter allocations(state);
+  rcutils_hash_map_t hash_map;
+  if (RCUTILS_RET_OK != keys.init(&hash_map, backend, allocations.allocator())) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  for (uint64_t i = 0; i < count; ++i) {
+    if (RCUTILS_RET_OK != rcutils_hash_map_set(&hash_map, keys.key(i), &i)) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+  allocations.resume();
+
+  size_t index = 0;
+  uint64_t data = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      rcutils_hash_map_get(&hash_map, hit ? keys.key(index) : keys.missing_key(index), &data));
+    if (++index == count) {
+      index = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  allocations.pause();
+  if (RCUTILS_RET_OK != rcutils_hash_map_fini(&hash_map)) {
+    rcutils_reset_error();
+  }
+}
+
+static void benchmark_hash_map_hit(benchmark::State & state)
+{
+  benchmark_hash_map_get(state, true);
+}
+BENCHMARK(benchmark_hash_map_hit)->Apply(hash_map_arguments);
+
+static void benchmark_hash_map_miss(benchmark::State & state)
+{
+  benchmark_hash_map_get(state, false);
+}
+BENCHMARK(benchmark_hash_map_miss)->Apply(hash_map_arguments);
+
+// Unsets every key of a map.
+static void benchmark_hash_map_unset(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const auto backend = static_cast<rcutils_hash_map_backend_t>(state.range(1));
+  HashMapKeys keys(count, 0 != state.range(2));
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocations.pause();
+    rcutils_hash_map_t hash_map;
+    if (RCUTILS_RET_OK != keys.init(&hash_map, backend, allocations.allocator())) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+      if (RCUTILS_RET_OK != rcutils_hash_map_set(&hash_map, keys.key(i), &i)) {
+        state.SkipWithError(rcutils_get_error_string().str);
+        rcutils_reset_error();
+      }
+    }
+    allocations.resume();
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < count; ++i) {
+      benchmark::DoNotOptimize(rcutils_hash_map_unset(&hash_map, keys.key(i)));
+    }
+
+    state.PauseTiming();
+    allocations.pause();
+    if (RCUTILS_RET_OK != rcutils_hash_map_fini(&hash_map)) {
+      rcutils_reset_error();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(benchmark_hash_map_unset)->Apply(hash_map_arguments);
+
+static void string_map_arguments(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgName("entries")->RangeMultiplier(10)->Range(10, 1000000);
+}
+
+// Sets every key in a string map, growing it from its initial capacity.
+static void benchmark_string_map_set(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<std::string> names = make_names(count);
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocations.pause();
+    rcutils_string_map_t string_map = rcutils_get_zero_initialized_string_map();
+    if (RCUTILS_RET_OK != rcutils_string_map_init(&string_map, 2, *allocations.allocator())) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    allocations.resume();
+    state.ResumeTiming();
+
+    for (const std::string & name : names) {
+      benchmark::DoNotOptimize(rcutils_string_map_set(&string_map, name.c_str(), "value"));
+    }
+
+    state.PauseTiming();
+    allocations.pause();
+    if (RCUTILS_RET_OK != rcutils_string_map_fini(&string_map)) {
+      rcutils_reset_error();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(benchmark_string_map_set)->Apply(string_map_arguments);
+
+// Looks up keys which are in the string map if hit is true, or keys which aren't otherwise.
+static void benchmark_string_map_get(benchmark::State & state, bool hit)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<std::string> names = make_names(count);
+  std::vector<std::string> missing_names = make_names(count, "/robot/missing_node_");
+  std::mt19937 random(42);
+  std::shuffle(names.begin(), names.end(), random);
+  AllocationCounter allocations(state);
+  rcutils_string_map_t string_map = rcutils_get_zero_initialized_string_map();
+  if (RCUTILS_RET_OK != rcutils_string_map_init(&string_map, count, *allocations.allocator())) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  for (const std::string & name : names) {
+    if (RCUTILS_RET_OK != rcutils_string_map_set(&string_map, name.c_str(), "value")) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+  const std::vector<std::string> & keys = hit ? names : missing_names;
+  allocations.resume();
+
+  size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_string_map_get(&string_map, keys[index].c_str()));
+    if (++index == count) {
+      index = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  allocations.pause();
+  if (RCUTILS_RET_OK != rcutils_string_map_fini(&string_map)) {
+    rcutils_reset_error();
+  }
+}
+
+static void benchmark_string_map_hit(benchmark::State & state)
+{
+  benchmark_string_map_get(state, true);
+}
+BENCHMARK(benchmark_string_map_hit)->Apply(string_map_arguments);
+
+static void benchmark_string_map_miss(benchmark::State & state)
+{
+  benchmark_string_map_get(state, false);
+}
+BENCHMARK(benchmark_string_map_miss)->Apply(string_map_arguments);
+
+// Copies a string map into an empty one, either entry by entry or by sharing its storage.
+static void benchmark_string_map_copy(benchmark::State & state, bool shared)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<std::string> names = make_names(count);
+  AllocationCounter allocations(state);
+  rcutils_string_map_t src_string_map = rcutils_get_zero_initialized_string_map();
+  if (RCUTILS_RET_OK != rcutils_string_map_init(&src_string_map, count, *allocations.allocator())) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  for (const std::string & name : names) {
+    if (RCUTILS_RET_OK != rcutils_string_map_set(&src_string_map, name.c_str(), "value")) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+  allocations.resume();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocations.pause();
+    rcutils_string_map_t dst_string_map = rcutils_get_zero_initialized_string_map();
+    if (RCUTILS_RET_OK != rcutils_string_map_init(&dst_string_map, 0, *allocations.allocator())) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    allocations.resume();
+    state.ResumeTiming();
+
+    if (shared) {
+      benchmark::DoNotOptimize(rcutils_string_map_copy_shared(&src_string_map, &dst_string_map));
+    } else {
+      benchmark::DoNotOptimize(rcutils_string_map_copy(&src_string_map, &dst_string_map));
+    }
+
+    state.PauseTiming();
+    allocations.pause();
+    if (RCUTILS_RET_OK != rcutils_string_map_fini(&dst_string_map)) {
+      rcutils_reset_error();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (RCUTILS_RET_OK != rcutils_string_map_fini(&src_string_map)) {
+    rcutils_reset_error();
+  }
+}
+
+static void benchmark_string_map_copy(benchmark::State & state)
+{
+  benchmark_string_map_copy(state, false);
+}
+BENCHMARK(benchmark_string_map_copy)->Apply(string_map_arguments);
+
+static void benchmark_string_map_copy_shared(benchmark::State & state)
+{
+  benchmark_string_map_copy(state, true);
+}
+BENCHMARK(benchmark_string_map_copy_shared)->Apply(string_map_arguments);
+
+static void array_list_arguments(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgName("elements")->RangeMultiplier(10)->Range(10, 1000000);
+}
+
+// Adds the elements to an array list, growing it from its initial capacity.
+static void benchmark_array_list_add(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocations.pause();
+    rcutils_array_list_t array_list = rcutils_get_zero_initialized_array_list();
+    if (RCUTILS_RET_OK !=
+      rcutils_array_list_init(&array_list, 2, sizeof(uint64_t), allocations.allocator()))
+    {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    allocations.resume();
+    state.ResumeTiming();
+
+    for (uint64_t i = 0; i < count; ++i) {
+      benchmark::DoNotOptimize(rcutils_array_list_add(&array_list, &i));
+    }
+
+    state.PauseTiming();
+    allocations.pause();
+    if (RCUTILS_RET_OK != rcutils_array_list_fini(&array_list)) {
+      rcutils_reset_error();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(benchmark_array_list_add)->Apply(array_list_arguments);
+
+// Gets every element of an array list.
+static void benchmark_array_list_get(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  rcutils_array_list_t array_list = rcutils_get_zero_initialized_array_list();
+  if (RCUTILS_RET_OK !=
+    rcutils_array_list_init(&array_list, count, sizeof(uint64_t), allocations.allocator()))
+  {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  for (uint64_t i = 0; i < count; ++i) {
+    if (RCUTILS_RET_OK != rcutils_array_list_add(&array_list, &i)) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+  allocations.resume();
+
+  uint64_t data = 0;
+  for (auto _ : state) {
+    for (size_t i = 0; i < count; ++i) {
+      benchmark::DoNotOptimize(rcutils_array_list_get(&array_list, i, &data));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+
+  allocations.pause();
+  if (RCUTILS_RET_OK != rcutils_array_list_fini(&array_list)) {
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_array_list_get)->Apply(array_list_arguments);
+
+// Removes the elements of an array list from the given end, where removing the first element
+// moves all the following ones.
+static void benchmark_array_list_remove(benchmark::State & state, bool front)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocations.pause();
+    rcutils_array_list_t array_list = rcutils_get_zero_initialized_array_list();
+    if (RCUTILS_RET_OK !=
+      rcutils_array_list_init(&array_list, count, sizeof(uint64_t), allocations.allocator()))
+    {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+      if (RCUTILS_RET_OK != rcutils_array_list_add(&array_list, &i)) {
+        state.SkipWithError(rcutils_get_error_string().str);
+        rcutils_reset_error();
+      }
+    }
+    allocations.resume();
+    state.ResumeTiming();
+
+    for (size_t i = count; i > 0; --i) {
+      benchmark::DoNotOptimize(rcutils_array_list_remove(&array_list, front ? 0 : i - 1));
+    }
+
+    state.PauseTiming();
+    allocations.pause();
+    if (RCUTILS_RET_OK != rcutils_array_list_fini(&array_list)) {
+      rcutils_reset_error();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+static void benchmark_array_list_remove_back(benchmark::State & state)
+{
+  benchmark_array_list_remove(state, false);
+}
+BENCHMARK(benchmark_array_list_remove_back)->Apply(array_list_arguments);
+
+static void benchmark_array_list_remove_front(benchmark::State & state)
+{
+  benchmark_array_list_remove(state, true);
+}
+BENCHMARK(benchmark_array_list_remove_front)->ArgName("elements")
+->RangeMultiplier(10)->Range(10, 100000);
+
+// Sorts a string array of names in a random order.
+static void benchmark_string_array_sort(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  rcutils_string_array_t string_array = rcutils_get_zero_initialized_string_array();
+  if (RCUTILS_RET_OK != rcutils_string_array_init(&string_array, count, allocations.allocator())) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  std::vector<std::string> names = make_names(count);
+  for (size_t i = 0; i < count; ++i) {
+    string_array.data[i] = rcutils_strdup(names[i].c_str(), *allocations.allocator());
+  }
+  std::vector<char *> shuffled(string_array.data, string_array.data + count);
+  std::mt19937 random(42);
+  std::shuffle(shuffled.begin(), shuffled.end(), random);
+  allocations.resume();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Sorting only moves the pointers to the strings, so the array still owns them.
+    std::copy(shuffled.begin(), shuffled.end(), string_array.data);
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(rcutils_string_array_sort(&string_array));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+
+  allocations.pause();
+  if (RCUTILS_RET_OK != rcutils_string_array_fini(&string_array)) {
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_string_array_sort)->ArgName("strings")
+->RangeMultiplier(10)->Range(10, 1000000);
+
+// Sorts an array of integers in a random order with rcutils_qsort(), or
+// rcutils_qsort_parallel() on as many threads as there are processors.
+static void benchmark_qsort(benchmark::State & state, bool parallel)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<uint64_t> shuffled(count);
+  std::mt19937_64 random(42);
+  for (uint64_t & value : shuffled) {
+    value = random();
+  }
+  std::vector<uint64_t> values(count);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(shuffled.begin(), shuffled.end(), values.begin());
+    state.ResumeTiming();
+
+    if (parallel) {
+      benchmark::DoNotOptimize(
+        rcutils_qsort_parallel(
+          values.data(), values.size(), sizeof(uint64_t), uint64_cmp_func, 0, &allocator));
+    } else {
+      benchmark::DoNotOptimize(
+        rcutils_qsort(values.data(), values.size(), sizeof(uint64_t), uint64_cmp_func));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+static void benchmark_qsort(benchmark::State & state)
+{
+  benchmark_qsort(state, false);
+}
+BENCHMARK(benchmark_qsort)->ArgName("elements")->RangeMultiplier(10)->Range(10, 1000000);
+
+static void benchmark_qsort_parallel(benchmark::State & state)
+{
+  benchmark_qsort(state, true);
+}
+BENCHMARK(benchmark_qsort_parallel)->ArgName("elements")->RangeMultiplier(10)
+->Range(10000, 10000000)->UseRealTime();
+
+// Splits a path of names into its tokens, and finalizes the tokens.
+static void benchmark_split(benchmark::State & state, bool packed)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  std::string path;
+  for (const std::string & name : make_names(count, "node_")) {
+    path += "/" + name;
+  }
+  allocations.resume();
+
+  for (auto _ : state) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    rcutils_ret_t ret = packed ?
+      rcutils_split_packed(path.c_str(), '/', *allocations.allocator(), &tokens) :
+      rcutils_split(path.c_str(), '/', *allocations.allocator(), &tokens);
+    if (RCUTILS_RET_OK != ret || RCUTILS_RET_OK != rcutils_string_array_fini(&tokens)) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+static void benchmark_split(benchmark::State & state)
+{
+  benchmark_split(state, false);
+}
+BENCHMARK(benchmark_split)->ArgName("tokens")->RangeMultiplier(10)->Range(10, 100000);
+
+static void benchmark_split_packed(benchmark::State & state)
+{
+  benchmark_split(state, true);
+}
+BENCHMARK(benchmark_split_packed)->ArgName("tokens")->RangeMultiplier(10)->Range(10, 100000);
+
+// Splits into an arena which is reset after every split, instead of finalizing the tokens.
+static void benchmark_split_arena(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  std::string path;
+  for (const std::string & name : make_names(count, "node_")) {
+    path += "/" + name;
+  }
+  rcutils_arena_t arena = rcutils_get_zero_initialized_arena();
+  if (RCUTILS_RET_OK != rcutils_arena_init(&arena, 0, allocations.allocator())) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  rcutils_allocator_t allocator = rcutils_arena_get_allocator(&arena);
+  allocations.resume();
+
+  for (auto _ : state) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    if (RCUTILS_RET_OK != rcutils_split(path.c_str(), '/', allocator, &tokens) ||
+      RCUTILS_RET_OK != rcutils_arena_reset(&arena))
+    {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+  }
+  if (RCUTILS_RET_OK != rcutils_arena_fini(&arena)) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(benchmark_split_arena)->ArgName("tokens")->RangeMultiplier(10)->Range(10, 100000);
+
+// Iterates over the tokens of a path of names, without copying them.
+static void benchmark_split_iterator(benchmark::State & state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  AllocationCounter allocations(state);
+  std::string path;
+  for (const std::string & name : make_names(count, "node_")) {
+    path += "/" + name;
+  }
+  allocations.resume();
+
+  for (auto _ : state) {
+    rcutils_split_iterator_t iterator = rcutils_get_split_iterator(path.c_str(), '/');
+    rcutils_split_token_t token;
+    while (rcutils_split_iterator_next(&iterator, &token)) {
+      benchmark::DoNotOptimize(token);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(benchmark_split_iterator)->ArgName("tokens")->RangeMultiplier(10)->Range(10, 100000);
+
+// Compares a string with a copy of it in upper case, e.g. a severity name or a logger name.
+static void benchmark_strcasecmp(benchmark::State & state)
+{
+  const size_t length = static_cast<size_t>(state.range(0));
+  std::string lower;
+  for (size_t i = 0; i < length; ++i) {
+    lower += static_cast<char>('a' + i % 26);
+  }
+  std::string upper = lower;
+  for (char & c : upper) {
+    c = static_cast<char>(c - 'a' + 'A');
+  }
+
+  for (auto _ : state) {
+    int value = 0;
+    if (0 != rcutils_strcasecmp(lower.c_str(), upper.c_str(), &value) || 0 != value) {
+      state.SkipWithError("strings don't compare equal");
+      break;
+    }
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(length));
+}
+BENCHMARK(benchmark_strcasecmp)->ArgName("length")->RangeMultiplier(8)->Range(4, 4096);
+
+// Validates a fully qualified name, made of node names and forward slashes.
+static void benchmark_validate_charset(benchmark::State & state, bool bulk)
+{
+  const size_t length = static_cast<size_t>(state.range(0));
+  std::string name;
+  while (name.size() < length) {
+    name += "/my_node_" + std::to_string(name.size());
+  }
+  name.resize(length);
+
+  for (auto _ : state) {
+    size_t invalid_index = SIZE_MAX;
+    if (bulk) {
+      invalid_index = rcutils_validate_charset(
+        name.c_str(), name.size(),
+        RCUTILS_CHARSET_ALNUM | RCUTILS_CHARSET_UNDERSCORE | RCUTILS_CHARSET_FORWARD_SLASH);
+    } else {
+      for (size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        if (!rcutils_isalnum_no_locale(c) && '_' != c && '/' != c) {
+          invalid_index = i;
+          break;
+        }
+      }
+    }
+    if (SIZE_MAX != invalid_index) {
+      state.SkipWithError("valid name is reported as invalid");
+      break;
+    }
+    benchmark::DoNotOptimize(invalid_index);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(length));
+}
+
+static void benchmark_validate_charset(benchmark::State & state)
+{
+  benchmark_validate_charset(state, true);
+}
+BENCHMARK(benchmark_validate_charset)->ArgName("length")->RangeMultiplier(8)->Range(8, 4096);
+
+static void benchmark_validate_isalnum_no_locale(benchmark::State & state)
+{
+  benchmark_validate_charset(state, false);
+}
+BENCHMARK(benchmark_validate_isalnum_no_locale)->ArgName("length")->RangeMultiplier(8)
+->Range(8, 4096);
+
+// Allocates and deallocates the nodes of a container, e.g. the entries of a chained hash map.
+static void benchmark_node_allocations(benchmark::State & state, int pool_kind)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_block_pool_t pool = rcutils_get_zero_initialized_block_pool();
+  rcutils_allocator_t allocator = default_allocator;
+  if (0 != pool_kind) {
+    if (RCUTILS_RET_OK != rcutils_block_pool_init(&pool, 2 == pool_kind, &default_allocator)) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      return;
+    }
+    allocator = rcutils_block_pool_get_allocator(&pool);
+  }
+  std::vector<void *> nodes(count);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < count; ++i) {
+      nodes[i] = allocator.allocate(24 + (i % 3) * 16, allocator.state);
+      benchmark::DoNotOptimize(nodes[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      allocator.deallocate(nodes[(i * 7919) % count], allocator.state);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+  if (RCUTILS_RET_OK != rcutils_block_pool_fini(&pool)) {
+    rcutils_reset_error();
+  }
+}
+
+static void benchmark_node_allocations_default(benchmark::State & state)
+{
+  benchmark_node_allocations(state, 0);
+}
+BENCHMARK(benchmark_node_allocations_default)->ArgName("nodes")->Arg(1000)->Arg(100000);
+
+static void benchmark_node_allocations_block_pool(benchmark::State & state)
+{
+  benchmark_node_allocations(state, 1);
+}
+BENCHMARK(benchmark_node_allocations_block_pool)->ArgName("nodes")->Arg(1000)->Arg(100000);
+
+static void benchmark_node_allocations_thread_safe_block_pool(benchmark::State & state)
+{
+  benchmark_node_allocations(state, 2);
+}
+BENCHMARK(benchmark_node_allocations_thread_safe_block_pool)->ArgName("nodes")->Arg(1000)
+->Arg(100000);
+
+enum allocation_cycles_allocator_t
+{
+  ALLOCATION_CYCLES_DEFAULT,
+  ALLOCATION_CYCLES_CACHING,
+  ALLOCATION_CYCLES_TRACKING,
+  ALLOCATION_CYCLES_TRACKING_CALL_SITES,
+};
+
+// A cycle of a loop allocating and deallocating a burst of buffers of different sizes
+static void benchmark_allocation_cycles(
+  benchmark::State & state, allocation_cycles_allocator_t kind)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_caching_allocator_t caching_allocator = rcutils_get_zero_initialized_caching_allocator();
+  rcutils_tracking_allocator_t tracking_allocator =
+    rcutils_get_zero_initialized_tracking_allocator();
+  rcutils_allocator_t allocator = default_allocator;
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (ALLOCATION_CYCLES_CACHING == kind) {
+    ret = rcutils_caching_allocator_init(
+      &caching_allocator, RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_BLOCK_SIZE,
+      RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_CACHED_BLOCKS, &default_allocator);
+    allocator = rcutils_caching_allocator_get_allocator(&caching_allocator);
+  } else if (ALLOCATION_CYCLES_DEFAULT != kind) {
+    ret = rcutils_tracking_allocator_init(
+      &tracking_allocator, ALLOCATION_CYCLES_TRACKING_CALL_SITES == kind, &default_allocator);
+    allocator = rcutils_tracking_allocator_get_allocator(&tracking_allocator);
+  }
+  if (RCUTILS_RET_OK != ret) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+    return;
+  }
+  std::vector<void *> buffers(count);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < count; ++i) {
+      buffers[i] = allocator.allocate(24 + (i % 4) * 200, allocator.state);
+      benchmark::DoNotOptimize(buffers[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      allocator.deallocate(buffers[i], allocator.state);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+  if (RCUTILS_RET_OK != rcutils_caching_allocator_fini(&caching_allocator) ||
+    RCUTILS_RET_OK != rcutils_tracking_allocator_fini(&tracking_allocator))
+  {
+    rcutils_reset_error();
+  }
+}
+
+static void benchmark_allocation_cycles_default(benchmark::State & state)
+{
+  benchmark_allocation_cycles(state, ALLOCATION_CYCLES_DEFAULT);
+}
+BENCHMARK(benchmark_allocation_cycles_default)->ArgName("buffers")->Arg(4)->Arg(64);
+
+static void benchmark_allocation_cycles_caching(benchmark::State & state)
+{
+  benchmark_allocation_cycles(state, ALLOCATION_CYCLES_CACHING);
+}
+BENCHMARK(benchmark_allocation_cycles_caching)->ArgName("buffers")->Arg(4)->Arg(64);
+
+static void benchmark_allocation_cycles_tracking(benchmark::State & state)
+{
+  benchmark_allocation_cycles(state, ALLOCATION_CYCLES_TRACKING);
+}
+BENCHMARK(benchmark_allocation_cycles_tracking)->ArgName("buffers")->Arg(4)->Arg(64);
+
+static void benchmark_allocation_cycles_tracking_call_sites(benchmark::State & state)
+{
+  benchmark_allocation_cycles(state, ALLOCATION_CYCLES_TRACKING_CALL_SITES);
+}
+BENCHMARK(benchmark_allocation_cycles_tracking_call_sites)->ArgName("buffers")->Arg(4)->Arg(64);
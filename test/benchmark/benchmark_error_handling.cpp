@@ -14,21 +14,168 @@
 
 #include <benchmark/benchmark.h>
 #include <cassert>
+#include <cstdio>
 #include <string>
+#include <thread>
 
+#ifdef _WIN32
+# include <io.h>
+# define dup _dup
+# define dup2 _dup2
+# define close _close
+# define fileno _fileno
+# define NULL_DEVICE "NUL"
+#else
+# include <unistd.h>
+# define NULL_DEVICE "/dev/null"
+#endif
+
+// This executable is never unloaded, so the string literals of its errors needn't be copied.
+#define RCUTILS_SET_ERROR_MSG_STATIC_LITERALS 1
 #include "rcutils/error_handling.h"
 
-static void benchmark_err_handling(benchmark::State & state)
+// Redirects stderr, where overwriting an error is reported, to the null device.
+class DiscardStderr
+{
+public:
+  DiscardStderr()
+  {
+    fflush(stderr);
+    saved_fd_ = dup(fileno(stderr));
+    FILE * null_device = fopen(NULL_DEVICE, "w");
+    if (nullptr != null_device) {
+      dup2(fileno(null_device), fileno(stderr));
+      fclose(null_device);
+    }
+  }
+
+  ~DiscardStderr()
+  {
+    if (saved_fd_ >= 0) {
+      fflush(stderr);
+      dup2(saved_fd_, fileno(stderr));
+      close(saved_fd_);
+    }
+  }
+
+private:
+  int saved_fd_;
+};
+
+// Initializes the thread-local storage of the benchmark thread before measuring.
+static void initialize_error_handling(benchmark::State & state)
 {
+  rcutils_ret_t ret =
+    rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
+  if (RCUTILS_RET_OK != ret) {
+    state.SkipWithError("failed to initialize the error handling thread-local storage");
+  }
+  rcutils_reset_error();
+}
+
+// Setting a string literal, then resetting it so that the next one doesn't overwrite it.
+static void benchmark_set_error_literal(benchmark::State & state)
+{
+  initialize_error_handling(state);
   for (auto _ : state) {
-    rcutils_ret_t ret =
-      rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
-    assert(ret == RCUTILS_RET_OK);
-    (void)ret;
+    RCUTILS_SET_ERROR_MSG("error message");
     rcutils_reset_error();
-    const char * test_message = "test message";
-    RCUTILS_SET_ERROR_MSG(test_message);
   }
 }
+BENCHMARK(benchmark_set_error_literal);
 
-BENCHMARK(benchmark_err_handling);
+// Setting a message which is not a literal, so it is copied.
+static void benchmark_set_error_copied(benchmark::State & state)
+{
+  initialize_error_handling(state);
+  char message[] = "error message";
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG(message);
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_set_error_copied);
+
+static void benchmark_set_error_formatted(benchmark::State & state)
+{
+  initialize_error_handling(state);
+  int argument = 42;
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("error message %d", argument);
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_set_error_formatted);
+
+// Overwriting an error with a different one, which is reported to stderr.
+static void benchmark_overwrite_error(benchmark::State & state)
+{
+  DiscardStderr discard_stderr;
+  initialize_error_handling(state);
+  RCUTILS_SET_ERROR_MSG("first error message");
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG("second error message");
+    RCUTILS_SET_ERROR_MSG("first error message");
+  }
+  rcutils_reset_error();
+}
+BENCHMARK(benchmark_overwrite_error);
+
+// Formatting the error string of a new error with the given number of frames pushed onto it.
+static void benchmark_get_error_string(benchmark::State & state)
+{
+  initialize_error_handling(state);
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG("error message");
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      RCUTILS_PUSH_ERROR_FRAME(RCUTILS_RET_ERROR, "frame message");
+    }
+    rcutils_error_string_t error_string = rcutils_get_error_string();
+    benchmark::DoNotOptimize(error_string);
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_get_error_string)->ArgName("frames")->Arg(0)->Arg(4);
+
+// Getting the error string again, which is formatted only once unless the error state is compact.
+static void benchmark_get_error_string_again(benchmark::State & state)
+{
+  initialize_error_handling(state);
+  RCUTILS_SET_ERROR_MSG("error message");
+  for (auto _ : state) {
+    rcutils_error_string_t error_string = rcutils_get_error_string();
+    benchmark::DoNotOptimize(error_string);
+  }
+  rcutils_reset_error();
+}
+BENCHMARK(benchmark_get_error_string_again);
+
+static void benchmark_reset_error(benchmark::State & state)
+{
+  initialize_error_handling(state);
+  for (auto _ : state) {
+    rcutils_reset_error();
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(benchmark_reset_error);
+
+// Creating a thread which sets, gets and resets an error (1), compared to one which doesn't (0),
+// for the cost of initializing the error handling thread-local storage on the first use.
+static void benchmark_first_use_in_thread(benchmark::State & state)
+{
+  bool use_error_handling = 0 != state.range(0);
+  for (auto _ : state) {
+    std::thread thread(
+      [use_error_handling]() {
+        if (use_error_handling) {
+          RCUTILS_SET_ERROR_MSG("error message");
+          rcutils_error_string_t error_string = rcutils_get_error_string();
+          benchmark::DoNotOptimize(error_string);
+          rcutils_reset_error();
+        }
+      });
+    thread.join();
+  }
+}
+BENCHMARK(benchmark_first_use_in_thread)->ArgName("use")->Arg(0)->Arg(1)->UseRealTime();
@@ -14,12 +14,27 @@
 
 #include <benchmark/benchmark.h>
 #include <cassert>
+#include <cstdio>
 #include <string>
 #include <vector>
 
+#ifdef _WIN32
+# include <io.h>
+# define dup _dup
+# define dup2 _dup2
+# define close _close
+# define fileno _fileno
+# define NULL_DEVICE "NUL"
+#else
+# include <unistd.h>
+# define NULL_DEVICE "/dev/null"
+#endif
+
 #include "../allocator_testing_utils.h"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/env.h"
 #include "rcutils/logging.h"
+#include "rcutils/logging_macros.h"
 
 #ifdef RMW_IMPLEMENTATION
 # define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
@@ -88,3 +103,231 @@ static void benchmark_logging(benchmark::State & state)
 }
 
 BENCHMARK(benchmark_logging);
+
+// Run a benchmark with 1, 4, 16 and 64 producer threads.
+static void producer_threads(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->Threads(1)->Threads(4)->Threads(16)->Threads(64)->UseRealTime();
+}
+
+// An output handler which formats the message, like any real one, but doesn't write it anywhere.
+static void format_only_output_handler(
+  const rcutils_log_location_t * location,
+  int level, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  (void)location;
+  (void)level;
+  (void)name;
+  (void)timestamp;
+  char buffer[1024];
+  benchmark::DoNotOptimize(vsnprintf(buffer, sizeof(buffer), format, *args));
+  benchmark::ClobberMemory();
+}
+
+// Redirects stderr, where the console output handler writes to, to the null device.
+// Only the first benchmark thread redirects it, before the other threads start logging.
+class DiscardStderr
+{
+public:
+  explicit DiscardStderr(const benchmark::State & state)
+  : saved_fd_(-1)
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+    fflush(stderr);
+    saved_fd_ = dup(fileno(stderr));
+    FILE * null_device = fopen(NULL_DEVICE, "w");
+    if (nullptr != null_device) {
+      dup2(fileno(null_device), fileno(stderr));
+      fclose(null_device);
+    }
+  }
+
+  ~DiscardStderr()
+  {
+    if (saved_fd_ >= 0) {
+      fflush(stderr);
+      dup2(saved_fd_, fileno(stderr));
+      close(saved_fd_);
+    }
+  }
+
+private:
+  int saved_fd_;
+};
+
+// Initializes the logging system with a counting allocator on the first benchmark thread, and
+// reports the allocations per message once all threads are done.
+// The other threads must not log before the measurement starts, which waits for all of them.
+class LoggingScope
+{
+public:
+  explicit LoggingScope(
+    benchmark::State & state,
+    rcutils_logging_output_handler_t output_handler = format_only_output_handler,
+    const char * output_format = nullptr)
+  : state_(state), allocator_(get_counting_allocator())
+  {
+    if (0 != state_.thread_index()) {
+      return;
+    }
+    if (nullptr != output_format &&
+      !rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_FORMAT", output_format))
+    {
+      state_.SkipWithError("failed to set the output format");
+    }
+    if (RCUTILS_RET_OK != rcutils_logging_initialize_with_allocator(allocator_)) {
+      state_.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+    if (nullptr != output_format && !rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_FORMAT", nullptr)) {
+      state_.SkipWithError("failed to unset the output format");
+    }
+    rcutils_logging_set_output_handler(output_handler);
+    rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+  }
+
+  ~LoggingScope()
+  {
+    if (0 != state_.thread_index()) {
+      return;
+    }
+    state_.counters["allocations_per_message"] = benchmark::Counter(
+      static_cast<double>(get_counting_allocator_allocations(allocator_)),
+      benchmark::Counter::kAvgIterations);
+    if (RCUTILS_RET_OK != rcutils_logging_shutdown()) {
+      rcutils_reset_error();
+    }
+  }
+
+  // Don't count the allocations of the setup, e.g. of per thread buffers.
+  void start_counting()
+  {
+    if (0 == state_.thread_index()) {
+      reset_counting_allocator_allocations(allocator_);
+    }
+  }
+
+private:
+  benchmark::State & state_;
+  rcutils_allocator_t allocator_;
+};
+
+// A statement whose severity is below the logger level, taking the cached fast path.
+static void benchmark_log_disabled(benchmark::State & state)
+{
+  LoggingScope scope(state);
+  scope.start_counting();
+  for (auto _ : state) {
+    RCUTILS_LOG_DEBUG_NAMED("benchmark", "message %d", 42);
+  }
+}
+BENCHMARK(benchmark_log_disabled)->Apply(producer_threads);
+
+// A statement which is enabled, passing its message to an output handler which only formats it.
+static void benchmark_log_enabled(benchmark::State & state)
+{
+  LoggingScope scope(state);
+  scope.start_counting();
+  for (auto _ : state) {
+    RCUTILS_LOG_INFO_NAMED("benchmark", "message %d", 42);
+  }
+}
+BENCHMARK(benchmark_log_enabled)->Apply(producer_threads);
+
+// The whole console output, synchronous (0) and asynchronous (1).
+static void benchmark_log_console(benchmark::State & state)
+{
+  DiscardStderr discard_stderr(state);
+  LoggingScope scope(state, rcutils_logging_console_output_handler);
+  if (0 == state.thread_index() && 0 != state.range(0)) {
+    rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+    options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK;
+    if (RCUTILS_RET_OK != rcutils_logging_enable_async(&options)) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+  // Creates the output buffer of the first thread, the others create theirs while measured.
+  if (0 == state.thread_index()) {
+    RCUTILS_LOG_INFO_NAMED("benchmark", "warming up");
+  }
+  scope.start_counting();
+  for (auto _ : state) {
+    RCUTILS_LOG_INFO_NAMED("benchmark", "message %d", 42);
+  }
+  if (0 == state.thread_index() && RCUTILS_RET_OK != rcutils_logging_disable_async()) {
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_log_console)->ArgName("async")->Arg(0)->Arg(1)->Apply(producer_threads);
+
+// A logger with the given number of name components, whose level is set on the root ancestor.
+// rcutils_log() resolves the effective level on every call, unlike the logging macros.
+static void benchmark_log_deep_logger_name(benchmark::State & state)
+{
+  LoggingScope scope(state);
+  std::string name = "root";
+  for (int64_t i = 1; i < state.range(0); ++i) {
+    name += ".child" + std::to_string(i);
+  }
+  if (RCUTILS_RET_OK != rcutils_logging_set_logger_level("root", RCUTILS_LOG_SEVERITY_WARN)) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  rcutils_log_location_t location = {"function", "file", 42u};
+  scope.start_counting();
+  for (auto _ : state) {
+    rcutils_log(&location, RCUTILS_LOG_SEVERITY_WARN, name.c_str(), "message %d", 42);
+  }
+}
+BENCHMARK(benchmark_log_deep_logger_name)->ArgName("depth")->Arg(1)->Arg(4)->Arg(16);
+
+// Formatting a message with an output format consisting of a single token.
+static void benchmark_format_token(benchmark::State & state)
+{
+  static const char * const output_formats[] = {
+    "{message}", "{severity}", "{name}", "{time}", "{time_as_nanoseconds}",
+    "{file_name}", "{function_name}", "{line_number}",
+  };
+  const char * output_format = output_formats[state.range(0)];
+  state.SetLabel(output_format);
+  LoggingScope scope(state, format_only_output_handler, output_format);
+  rcutils_log_location_t location = {"function", "file", 42u};
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  if (RCUTILS_RET_OK != rcutils_char_array_init(&output, 1024, &allocator)) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+  scope.start_counting();
+  for (auto _ : state) {
+    output.buffer_length = 0;
+    output.buffer[0] = '\0';
+    benchmark::DoNotOptimize(
+      rcutils_logging_format_message(
+        &location, RCUTILS_LOG_SEVERITY_INFO, "benchmark", 1234567890, "message", &output));
+  }
+  if (RCUTILS_RET_OK != rcutils_char_array_fini(&output)) {
+    rcutils_reset_error();
+  }
+}
+BENCHMARK(benchmark_format_token)->DenseRange(0, 7);
+
+// Console output of messages of the given length, around and beyond the 1024 byte buffers.
+static void benchmark_log_long_message(benchmark::State & state)
+{
+  DiscardStderr discard_stderr(state);
+  LoggingScope scope(state, rcutils_logging_console_output_handler, "{message}");
+  const std::string message(static_cast<size_t>(state.range(0)), 'x');
+  RCUTILS_LOG_INFO_NAMED("benchmark", "warming up");
+  scope.start_counting();
+  for (auto _ : state) {
+    RCUTILS_LOG_INFO_NAMED("benchmark", "%s", message.c_str());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(benchmark_log_long_message)->ArgName("length")
+->Arg(100)->Arg(1000)->Arg(1023)->Arg(1024)->Arg(4000)->Arg(100000);
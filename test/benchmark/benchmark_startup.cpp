@@ -0,0 +1,331 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks of what a process does once when it starts using rcutils.
+// A "cold" measurement is of the first time something is done, a "warm" one of doing it again
+// once it was done before, e.g. by an earlier node of the same process.
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rcutils/env.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/macros.h"
+#include "rcutils/shared_library.h"
+
+using steady_clock = std::chrono::steady_clock;
+
+static double elapsed_seconds(steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(steady_clock::now() - start).count();
+}
+
+// Reports a time as the average over the iterations, in nanoseconds like the benchmark itself.
+static benchmark::Counter average_ns(double seconds)
+{
+  return benchmark::Counter(seconds * 1e9, benchmark::Counter::kAvgIterations);
+}
+
+static bool get_library_path(benchmark::State & state, char * library_path, unsigned int size)
+{
+  rcutils_ret_t ret = rcutils_get_platform_library_name(
+    RCUTILS_STRINGIFY(SHARED_LIBRARY_UNDER_TEST), library_path, size, false);
+  if (RCUTILS_RET_OK != ret) {
+    state.SkipWithError("failed to get the platform name of the library");
+    return false;
+  }
+  return true;
+}
+
+// The phases of the startup of a process, each timed on its own.
+struct StartupTimes
+{
+  double get_env = 0.0;
+  double logging_initialize = 0.0;
+  double error_handling_initialize = 0.0;
+  double load_shared_library = 0.0;
+};
+
+static const char * const startup_env_names[] = {
+  "RCUTILS_CONSOLE_OUTPUT_FORMAT",
+  "RCUTILS_COLORIZED_OUTPUT",
+  "RCUTILS_LOGGING_USE_STDOUT",
+  "RCUTILS_LOGGING_BUFFERED_STREAM",
+  "ROS_HOME",
+};
+
+// Runs the startup phases once, and undoes them except for the thread-local storage of the
+// thread the error handling was initialized in, which only goes away with that thread.
+static bool run_startup(
+  benchmark::State & state, const char * library_path, StartupTimes & times)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  steady_clock::time_point start = steady_clock::now();
+  for (const char * name : startup_env_names) {
+    const char * value = nullptr;
+    const char * error = rcutils_get_env(name, &value);
+    benchmark::DoNotOptimize(error);
+    benchmark::DoNotOptimize(value);
+  }
+  times.get_env += elapsed_seconds(start);
+
+  start = steady_clock::now();
+  rcutils_ret_t ret = rcutils_logging_initialize_with_allocator(allocator);
+  times.logging_initialize += elapsed_seconds(start);
+  if (RCUTILS_RET_OK != ret) {
+    state.SkipWithError("failed to initialize logging");
+    return false;
+  }
+
+  // Measured in a new thread, as the thread-local storage is initialized once per thread.
+  double error_handling_seconds = 0.0;
+  std::thread thread(
+    [&ret, &error_handling_seconds, allocator]() {
+      steady_clock::time_point start = steady_clock::now();
+      ret = rcutils_initialize_error_handling_thread_local_storage(allocator);
+      error_handling_seconds = elapsed_seconds(start);
+    });
+  thread.join();
+  times.error_handling_initialize += error_handling_seconds;
+
+  rcutils_shared_library_t lib = rcutils_get_zero_initialized_shared_library();
+  if (RCUTILS_RET_OK == ret) {
+    start = steady_clock::now();
+    ret = rcutils_load_shared_library(&lib, library_path, allocator);
+    times.load_shared_library += elapsed_seconds(start);
+    if (RCUTILS_RET_OK != ret) {
+      state.SkipWithError("failed to load the shared library");
+    }
+  } else {
+    state.SkipWithError("failed to initialize the error handling thread-local storage");
+  }
+
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_unload_shared_library(&lib);
+  }
+  rcutils_ret_t shutdown_ret = rcutils_logging_shutdown();
+  return RCUTILS_RET_OK == ret && RCUTILS_RET_OK == shutdown_ret;
+}
+
+static void report_startup(benchmark::State & state, const StartupTimes & times)
+{
+  state.counters["get_env_ns"] = average_ns(times.get_env);
+  state.counters["logging_initialize_ns"] = average_ns(times.logging_initialize);
+  state.counters["error_handling_initialize_ns"] = average_ns(times.error_handling_initialize);
+  state.counters["load_shared_library_ns"] = average_ns(times.load_shared_library);
+}
+
+// The startup of the process itself, the first time each phase is done in it.
+// This is registered first so that it runs before any other benchmark warmed anything up, and
+// it can only be measured once per process, so it isn't repeated.
+static void benchmark_startup_cold(benchmark::State & state)
+{
+  static bool has_run = false;
+  char library_path[1024];
+  if (!get_library_path(state, library_path, sizeof(library_path))) {
+    return;
+  }
+  StartupTimes times;
+  for (auto _ : state) {
+    if (has_run) {
+      state.SkipWithError("the cold startup can only be measured once per process");
+      break;
+    }
+    has_run = true;
+    if (!run_startup(state, library_path, times)) {
+      break;
+    }
+  }
+  report_startup(state, times);
+}
+BENCHMARK(benchmark_startup_cold)->Iterations(1)->Repetitions(1)->UseRealTime();
+
+// The startup of one more node of a process which already did it before.
+static void benchmark_startup_warm(benchmark::State & state)
+{
+  char library_path[1024];
+  if (!get_library_path(state, library_path, sizeof(library_path))) {
+    return;
+  }
+  StartupTimes times;
+  for (auto _ : state) {
+    if (!run_startup(state, library_path, times)) {
+      break;
+    }
+  }
+  report_startup(state, times);
+}
+BENCHMARK(benchmark_startup_warm)->UseRealTime();
+
+// Initializing logging, which parses the environment variables and compiles the output format.
+static void benchmark_logging_initialize(benchmark::State & state)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  for (auto _ : state) {
+    if (RCUTILS_RET_OK != rcutils_logging_initialize_with_allocator(allocator)) {
+      state.SkipWithError("failed to initialize logging");
+      break;
+    }
+    state.PauseTiming();
+    if (RCUTILS_RET_OK != rcutils_logging_shutdown()) {
+      state.SkipWithError("failed to shut logging down");
+      break;
+    }
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(benchmark_logging_initialize);
+
+// Initializing logging again while it is initialized, as each library of a process may do.
+static void benchmark_logging_initialize_again(benchmark::State & state)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  if (RCUTILS_RET_OK != rcutils_logging_initialize_with_allocator(allocator)) {
+    state.SkipWithError("failed to initialize logging");
+    return;
+  }
+  for (auto _ : state) {
+    rcutils_ret_t ret = rcutils_logging_initialize_with_allocator(allocator);
+    benchmark::DoNotOptimize(ret);
+  }
+  if (RCUTILS_RET_OK != rcutils_logging_shutdown()) {
+    state.SkipWithError("failed to shut logging down");
+  }
+}
+BENCHMARK(benchmark_logging_initialize_again);
+
+// Initializing the error handling thread-local storage on the given number of new threads at
+// once, the first time (cold) and again (warm) in each of them.
+// The time of the benchmark includes starting and joining the threads, the counters are the
+// average time of one initialization.
+static void benchmark_error_handling_initialize(benchmark::State & state)
+{
+  const size_t thread_count = static_cast<size_t>(state.range(0));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  std::vector<double> cold_seconds(thread_count);
+  std::vector<double> warm_seconds(thread_count);
+  double total_cold_seconds = 0.0;
+  double total_warm_seconds = 0.0;
+  for (auto _ : state) {
+    std::atomic<bool> failed(false);
+    std::atomic<size_t> ready_count(0);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads.emplace_back(
+        [&, i]() {
+          // Start together, to measure the threads initializing concurrently.
+          ready_count.fetch_add(1);
+          while (ready_count.load() < thread_count) {
+            std::this_thread::yield();
+          }
+          steady_clock::time_point start = steady_clock::now();
+          if (RCUTILS_RET_OK != rcutils_initialize_error_handling_thread_local_storage(allocator)) {
+            failed.store(true);
+          }
+          cold_seconds[i] = elapsed_seconds(start);
+          start = steady_clock::now();
+          if (RCUTILS_RET_OK != rcutils_initialize_error_handling_thread_local_storage(allocator)) {
+            failed.store(true);
+          }
+          warm_seconds[i] = elapsed_seconds(start);
+        });
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads[i].join();
+      total_cold_seconds += cold_seconds[i];
+      total_warm_seconds += warm_seconds[i];
+    }
+    if (failed.load()) {
+      state.SkipWithError("failed to initialize the error handling thread-local storage");
+      break;
+    }
+  }
+  const double initializations = static_cast<double>(thread_count);
+  state.counters["cold_ns"] = average_ns(total_cold_seconds / initializations);
+  state.counters["warm_ns"] = average_ns(total_warm_seconds / initializations);
+}
+BENCHMARK(benchmark_error_handling_initialize)
+->ArgName("threads")->Arg(1)->Arg(8)->Arg(64)->UseRealTime();
+
+// Loading the library when it isn't loaded yet (0), which maps and relocates it, and when
+// another handle keeps it loaded (1), which only finds it.
+static void benchmark_load_shared_library(benchmark::State & state)
+{
+  const bool already_loaded = 0 != state.range(0);
+  char library_path[1024];
+  if (!get_library_path(state, library_path, sizeof(library_path))) {
+    return;
+  }
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_shared_library_t keep_loaded = rcutils_get_zero_initialized_shared_library();
+  if (already_loaded &&
+    RCUTILS_RET_OK != rcutils_load_shared_library(&keep_loaded, library_path, allocator))
+  {
+    state.SkipWithError("failed to load the shared library");
+    return;
+  }
+  for (auto _ : state) {
+    rcutils_shared_library_t lib = rcutils_get_zero_initialized_shared_library();
+    if (RCUTILS_RET_OK != rcutils_load_shared_library(&lib, library_path, allocator)) {
+      state.SkipWithError("failed to load the shared library");
+      break;
+    }
+    state.PauseTiming();
+    if (RCUTILS_RET_OK != rcutils_unload_shared_library(&lib)) {
+      state.SkipWithError("failed to unload the shared library");
+      break;
+    }
+    state.ResumeTiming();
+  }
+  if (already_loaded && RCUTILS_RET_OK != rcutils_unload_shared_library(&keep_loaded)) {
+    state.SkipWithError("failed to unload the shared library");
+  }
+}
+BENCHMARK(benchmark_load_shared_library)->ArgName("already_loaded")->Arg(0)->Arg(1);
+
+// Getting a variable which is set (1) and one which isn't (0), directly (lookup 0), from the
+// snapshot of the environment (lookup 1), and from a new snapshot taken first (lookup 2).
+static void benchmark_get_env(benchmark::State & state)
+{
+  const char * name =
+    0 != state.range(0) ? "RCUTILS_BENCHMARK_STARTUP_SET" : "RCUTILS_BENCHMARK_STARTUP_UNSET";
+  const int64_t lookup = state.range(1);
+  if (!rcutils_set_env("RCUTILS_BENCHMARK_STARTUP_SET", "value")) {
+    state.SkipWithError("failed to set the environment variable");
+    return;
+  }
+  for (auto _ : state) {
+    const char * value = nullptr;
+    const char * error = nullptr;
+    if (0 == lookup) {
+      error = rcutils_get_env(name, &value);
+    } else {
+      if (2 == lookup) {
+        rcutils_env_cache_invalidate();
+      }
+      error = rcutils_get_env_cached(name, &value);
+    }
+    benchmark::DoNotOptimize(error);
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(benchmark_get_env)->ArgNames({"set", "lookup"})->Ranges({{0, 1}, {0, 2}});
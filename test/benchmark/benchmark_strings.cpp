@@ -0,0 +1,309 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/find.h"
+#include "rcutils/format_string.h"
+#include "rcutils/repl_str.h"
+#include "rcutils/sha256.h"
+#include "rcutils/split.h"
+#include "rcutils/strcasecmp.h"
+#include "rcutils/types/string_array.h"
+#include "rcutils/utf8.h"
+
+// Inputs from 16 B to 16 MiB, so that the per call overhead, the throughput in the caches and
+// the throughput from memory each show.
+static void size_arguments(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgName("bytes")->RangeMultiplier(16)->Range(16, 16 << 20);
+}
+
+static void set_bytes_processed(benchmark::State & state, size_t bytes_per_iteration)
+{
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes_per_iteration));
+}
+
+// Bytes which are neither null characters nor any of the delimiters searched for.
+static std::string make_text(size_t size)
+{
+  std::string text(size, 'a');
+  for (size_t i = 0; i < size; ++i) {
+    text[i] = static_cast<char>('a' + (i * 7) % 26);
+  }
+  return text;
+}
+
+// A path of names separated by slashes, e.g. the name of a topic, of about the given size.
+static std::string make_path(size_t size)
+{
+  std::string path;
+  for (size_t i = 0; path.size() < size; ++i) {
+    path += "/node_" + std::to_string(i);
+  }
+  path.resize(size);
+  return path;
+}
+
+static void benchmark_sha256(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const std::string data = make_text(size);
+  uint8_t hash[RCUTILS_SHA256_BLOCK_SIZE];
+
+  for (auto _ : state) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    rcutils_sha256_update(&ctx, reinterpret_cast<const uint8_t *>(data.data()), size);
+    rcutils_sha256_final(&ctx, hash);
+    benchmark::DoNotOptimize(hash);
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_sha256)->Apply(size_arguments);
+
+// Hashes 64 messages of the given size at once.
+static void benchmark_sha256_many(benchmark::State & state)
+{
+  constexpr size_t count = 64;
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::vector<std::string> messages;
+  std::vector<const uint8_t *> data;
+  std::vector<size_t> data_lens(count, size);
+  for (size_t i = 0; i < count; ++i) {
+    messages.push_back(make_text(size));
+    messages.back()[0] = static_cast<char>('a' + i % 26);
+  }
+  for (const std::string & message : messages) {
+    data.push_back(reinterpret_cast<const uint8_t *>(message.data()));
+  }
+  std::vector<rcutils_sha256_ctx_t> ctxs(count);
+  std::vector<uint8_t> hashes(count * RCUTILS_SHA256_BLOCK_SIZE);
+
+  for (auto _ : state) {
+    for (rcutils_sha256_ctx_t & ctx : ctxs) {
+      rcutils_sha256_init(&ctx);
+    }
+    rcutils_sha256_update_many(ctxs.data(), data.data(), data_lens.data(), count);
+    rcutils_sha256_final_many(
+      ctxs.data(), count, reinterpret_cast<uint8_t (*)[RCUTILS_SHA256_BLOCK_SIZE]>(hashes.data()));
+    benchmark::DoNotOptimize(hashes.data());
+  }
+  set_bytes_processed(state, count * size);
+}
+BENCHMARK(benchmark_sha256_many)->ArgName("bytes")->RangeMultiplier(16)->Range(16, 1 << 20);
+
+// Text of ASCII and of 2, 3 and 4 byte sequences, as in messages in other languages than English.
+static std::string make_utf8_text(size_t size)
+{
+  std::string text;
+  while (text.size() < size) {
+    text += "caf\xC3\xA9 \xE2\x82\xAC 12 \xF0\x9F\x98\x80 ok ";
+  }
+  // Cut at the start of a sequence, so that the text stays valid.
+  while (0x80 == (static_cast<unsigned char>(text[size]) & 0xC0)) {
+    --size;
+  }
+  text.resize(size);
+  return text;
+}
+
+static void benchmark_utf8_validate_ascii(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const std::string text = make_text(size);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_utf8_validate(text.data(), text.size()));
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_utf8_validate_ascii)->Apply(size_arguments);
+
+static void benchmark_utf8_validate(benchmark::State & state)
+{
+  const std::string text = make_utf8_text(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_utf8_validate(text.data(), text.size()));
+  }
+  set_bytes_processed(state, text.size());
+}
+BENCHMARK(benchmark_utf8_validate)->Apply(size_arguments);
+
+// Sanitizes text with an invalid byte every 1000 bytes.
+static void benchmark_utf8_sanitize(benchmark::State & state)
+{
+  std::string text = make_utf8_text(static_cast<size_t>(state.range(0)));
+  for (size_t i = 0; i < text.size(); i += 1000) {
+    text[i] = '\xFF';
+  }
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  if (rcutils_char_array_init(&output, 3 * text.size() + 1, &allocator) != RCUTILS_RET_OK) {
+    state.SkipWithError(rcutils_get_error_string().str);
+    return;
+  }
+
+  for (auto _ : state) {
+    output.buffer_length = 0;
+    if (rcutils_utf8_sanitize(text.data(), text.size(), &output) != RCUTILS_RET_OK) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+    benchmark::DoNotOptimize(output.buffer);
+  }
+  set_bytes_processed(state, text.size());
+  if (rcutils_char_array_fini(&output) != RCUTILS_RET_OK) {
+    state.SkipWithError(rcutils_get_error_string().str);
+  }
+}
+BENCHMARK(benchmark_utf8_sanitize)->Apply(size_arguments);
+
+static void benchmark_split(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const std::string path = make_path(size);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : state) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    if (RCUTILS_RET_OK != rcutils_split(path.c_str(), '/', allocator, &tokens) ||
+      RCUTILS_RET_OK != rcutils_string_array_fini(&tokens))
+    {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      return;
+    }
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_split)->Apply(size_arguments);
+
+// The delimiter is the last character, so that the whole string is searched.
+static void benchmark_find(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::string text = make_text(size);
+  text.back() = '/';
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_find(text.c_str(), '/'));
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_find)->Apply(size_arguments);
+
+static void benchmark_findn(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::string text = make_text(size);
+  text.back() = '/';
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_findn(text.data(), '/', size));
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_findn)->Apply(size_arguments);
+
+// The delimiter is the first character, so that the whole string is searched.
+static void benchmark_find_last(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::string text = make_text(size);
+  text.front() = '/';
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_find_last(text.c_str(), '/'));
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_find_last)->Apply(size_arguments);
+
+static void benchmark_find_any(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::string text = make_text(size);
+  text.back() = '/';
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_find_any(text.c_str(), "/.:"));
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_find_any)->Apply(size_arguments);
+
+// Replaces the separators of a path, which occur every 8 bytes or so.
+static void benchmark_repl_str(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const std::string path = make_path(size);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : state) {
+    char * result = rcutils_repl_str(path.c_str(), "/node_", "::n", &allocator);
+    if (nullptr == result) {
+      state.SkipWithError("rcutils_repl_str failed");
+      return;
+    }
+    allocator.deallocate(result, allocator.state);
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_repl_str)->Apply(size_arguments);
+
+// Compares strings which only differ by case, so that they are compared to their end.
+static void benchmark_strcasecmp(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const std::string lower = make_text(size);
+  std::string upper = lower;
+  for (char & c : upper) {
+    c = static_cast<char>(c - 'a' + 'A');
+  }
+
+  for (auto _ : state) {
+    int value = 1;
+    if (0 != rcutils_strcasecmp(lower.c_str(), upper.c_str(), &value) || 0 != value) {
+      state.SkipWithError("rcutils_strcasecmp failed");
+      return;
+    }
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_strcasecmp)->Apply(size_arguments);
+
+static void benchmark_format_string_limit(benchmark::State & state)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const std::string text = make_text(size);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : state) {
+    char * result = rcutils_format_string_limit(allocator, size + 1, "%s", text.c_str());
+    if (nullptr == result) {
+      state.SkipWithError("rcutils_format_string_limit failed");
+      return;
+    }
+    allocator.deallocate(result, allocator.state);
+  }
+  set_bytes_processed(state, size);
+}
+BENCHMARK(benchmark_format_string_limit)->Apply(size_arguments);
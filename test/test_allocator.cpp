@@ -14,8 +14,23 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+# include <linux/mempolicy.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
 #include "./allocator_testing_utils.h"
 #include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/split.h"
+#include "rcutils/strdup.h"
+#include "rcutils/types/hash_map.h"
 #include "rcutils/testing/fault_injection.h"
 
 #include "osrf_testing_tools_cpp/memory_tools/memory_tools.hpp"
@@ -138,3 +153,980 @@ TEST(test_allocator, default_allocator_maybe_fail) {
   EXPECT_EQ(nullptr, allocator.zero_allocate(1u, 1u, allocator.state));
   EXPECT_EQ(RCUTILS_FAULT_INJECTION_NEVER_FAIL, rcutils_fault_injection_get_count());
 }
+
+TEST(test_allocator, fault_injection_armed) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_fault_injection_set_count(RCUTILS_FAULT_INJECTION_NEVER_FAIL);
+  EXPECT_FALSE(RCUTILS_FAULT_INJECTION_IS_ARMED());
+
+  rcutils_fault_injection_set_count(1);
+  EXPECT_TRUE(RCUTILS_FAULT_INJECTION_IS_ARMED());
+  void * pointer = allocator.allocate(1u, allocator.state);
+  EXPECT_NE(nullptr, pointer);
+  allocator.deallocate(pointer, allocator.state);
+  EXPECT_EQ(nullptr, allocator.allocate(1u, allocator.state));
+  // The flag stays set once the counter went negative by failing, which is still correct.
+  EXPECT_TRUE(RCUTILS_FAULT_INJECTION_IS_ARMED());
+  pointer = allocator.allocate(1u, allocator.state);
+  EXPECT_NE(nullptr, pointer);
+  allocator.deallocate(pointer, allocator.state);
+
+  rcutils_fault_injection_set_count(RCUTILS_FAULT_INJECTION_NEVER_FAIL);
+  EXPECT_FALSE(RCUTILS_FAULT_INJECTION_IS_ARMED());
+}
+
+TEST(test_allocator, aligned_allocate) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  for (const rcutils_allocator_t & allocator : {default_allocator, counting_allocator}) {
+    for (size_t alignment : {1u, 2u, 8u, 16u, 64u, 4096u}) {
+      for (size_t size : {0u, 1u, 100u, 5000u}) {
+        auto pointer = static_cast<char *>(rcutils_aligned_allocate(alignment, size, &allocator));
+        ASSERT_NE(nullptr, pointer);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer) % alignment);
+        memset(pointer, 'x', size);
+        rcutils_aligned_deallocate(pointer, &allocator);
+      }
+    }
+  }
+  // other allocators allocate aligned memory with their own functions
+  reset_counting_allocator_allocations(counting_allocator);
+  void * pointer = rcutils_aligned_allocate(64, 64, &counting_allocator);
+  ASSERT_NE(nullptr, pointer);
+  EXPECT_EQ(1u, get_counting_allocator_allocations(counting_allocator));
+  rcutils_aligned_deallocate(pointer, &counting_allocator);
+  EXPECT_EQ(1u, get_counting_allocator_deallocations(counting_allocator));
+
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(0, 64, &default_allocator));
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(48, 64, &default_allocator));
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(64, SIZE_MAX, &default_allocator));
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(64, SIZE_MAX, &counting_allocator));
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(64, 64, nullptr));
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(64, 64, &failing_allocator));
+  rcutils_aligned_deallocate(nullptr, &default_allocator);
+
+  rcutils_fault_injection_set_count(RCUTILS_FAULT_INJECTION_FAIL_NOW);
+  EXPECT_EQ(nullptr, rcutils_aligned_allocate(64, 64, &default_allocator));
+  EXPECT_EQ(RCUTILS_FAULT_INJECTION_NEVER_FAIL, rcutils_fault_injection_get_count());
+}
+
+static void * counting_aligned_allocate(size_t alignment, size_t size, void * state)
+{
+  ++*static_cast<size_t *>(state);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  return rcutils_aligned_allocate(alignment, size, &allocator);
+}
+
+static void counting_aligned_deallocate(void * pointer, void * state)
+{
+  --*static_cast<size_t *>(state);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_aligned_deallocate(pointer, &allocator);
+}
+
+TEST(test_allocator, aligned_allocate_custom) {
+  // allocators may implement aligned allocations themselves
+  size_t outstanding = 0;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  allocator.aligned_allocate = counting_aligned_allocate;
+  allocator.aligned_deallocate = counting_aligned_deallocate;
+  allocator.state = &outstanding;
+  void * pointer = rcutils_aligned_allocate(128, 100, &allocator);
+  ASSERT_NE(nullptr, pointer);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer) % 128);
+  EXPECT_EQ(1u, outstanding);
+  rcutils_aligned_deallocate(pointer, &allocator);
+  EXPECT_EQ(0u, outstanding);
+}
+
+TEST(test_allocator, arena_init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_arena_t arena = rcutils_get_zero_initialized_arena();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_arena_init(nullptr, 0, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_arena_init(&arena, 0, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_arena_init(&arena, SIZE_MAX, &allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_arena_init(&arena, 0, &failing_allocator));
+  rcutils_reset_error();
+
+  allocator = rcutils_arena_get_allocator(&arena);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  allocator = rcutils_arena_get_allocator(nullptr);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_arena_reset(&arena));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_arena_reset(nullptr));
+  rcutils_reset_error();
+
+  allocator = rcutils_get_default_allocator();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_init(&arena, 0, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_reset(&arena));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_fini(&arena));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_fini(&arena));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_arena_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_allocator, arena_allocate) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_arena_t arena = rcutils_get_zero_initialized_arena();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_init(&arena, 1024, &counting_allocator));
+  rcutils_allocator_t allocator = rcutils_arena_get_allocator(&arena);
+  ASSERT_TRUE(rcutils_allocator_is_valid(&allocator));
+
+  // many small allocations take a single block
+  reset_counting_allocator_allocations(counting_allocator);
+  char * pointers[32];
+  for (size_t i = 0; i < 32; ++i) {
+    pointers[i] = static_cast<char *>(allocator.allocate(i + 1, allocator.state));
+    ASSERT_NE(nullptr, pointers[i]);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointers[i]) % 16u);
+    memset(pointers[i], static_cast<int>(i), i + 1);
+  }
+  EXPECT_EQ(1u, get_counting_allocator_allocations(counting_allocator));
+  for (size_t i = 0; i < 32; ++i) {
+    for (size_t j = 0; j <= i; ++j) {
+      ASSERT_EQ(static_cast<char>(i), pointers[i][j]);
+    }
+    allocator.deallocate(pointers[i], allocator.state);
+  }
+
+  int * zeros = static_cast<int *>(allocator.zero_allocate(10, sizeof(int), allocator.state));
+  ASSERT_NE(nullptr, zeros);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(0, zeros[i]);
+  }
+  EXPECT_EQ(nullptr, allocator.zero_allocate(SIZE_MAX / 2, 4, allocator.state));
+  EXPECT_EQ(nullptr, allocator.allocate(SIZE_MAX, allocator.state));
+
+  // a large allocation gets a block of its own, and the current block keeps being used
+  char * small = static_cast<char *>(allocator.allocate(8, allocator.state));
+  char * large = static_cast<char *>(allocator.allocate(4000, allocator.state));
+  ASSERT_NE(nullptr, large);
+  memset(large, 1, 4000);
+  char * next = static_cast<char *>(allocator.allocate(8, allocator.state));
+  EXPECT_EQ(small + 16, next);
+
+  // an arena fails to allocate when its allocator does
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  rcutils_arena_t failing_arena = rcutils_get_zero_initialized_arena();
+  set_failing_allocator_is_failing(failing_allocator, false);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_init(&failing_arena, 0, &failing_allocator));
+  set_failing_allocator_is_failing(failing_allocator, true);
+  rcutils_allocator_t failing_arena_allocator = rcutils_arena_get_allocator(&failing_arena);
+  EXPECT_EQ(nullptr, failing_arena_allocator.allocate(8, failing_arena_allocator.state));
+  set_failing_allocator_is_failing(failing_allocator, false);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_fini(&failing_arena));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_fini(&arena));
+}
+
+TEST(test_allocator, arena_reallocate) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_arena_t arena = rcutils_get_zero_initialized_arena();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_init(&arena, 256, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_arena_get_allocator(&arena);
+
+  // the last allocation grows and shrinks in place
+  char * last = static_cast<char *>(allocator.reallocate(nullptr, 10, allocator.state));
+  ASSERT_NE(nullptr, last);
+  memcpy(last, "abcdefghi", 10);
+  EXPECT_EQ(last, allocator.reallocate(last, 100, allocator.state));
+  EXPECT_EQ(last, allocator.reallocate(last, 20, allocator.state));
+  EXPECT_STREQ("abcdefghi", last);
+
+  // any other allocation is copied
+  char * other = static_cast<char *>(allocator.allocate(16, allocator.state));
+  ASSERT_NE(nullptr, other);
+  char * moved = static_cast<char *>(allocator.reallocate(last, 40, allocator.state));
+  ASSERT_NE(nullptr, moved);
+  EXPECT_NE(last, moved);
+  EXPECT_STREQ("abcdefghi", moved);
+
+  // growing past the block moves the last allocation to a new block
+  char * grown = static_cast<char *>(allocator.reallocate(moved, 1000, allocator.state));
+  ASSERT_NE(nullptr, grown);
+  EXPECT_STREQ("abcdefghi", grown);
+  memset(grown, 'x', 1000);
+
+  // deallocating the last allocation gives its memory back
+  char * freed = static_cast<char *>(allocator.allocate(32, allocator.state));
+  allocator.deallocate(freed, allocator.state);
+  EXPECT_EQ(freed, allocator.allocate(32, allocator.state));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_fini(&arena));
+}
+
+TEST(test_allocator, arena_reset) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_arena_t arena = rcutils_get_zero_initialized_arena();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_init(&arena, 0, &counting_allocator));
+  rcutils_allocator_t allocator = rcutils_arena_get_allocator(&arena);
+
+  // once the arena has a block, the next phases don't allocate from its allocator
+  for (size_t phase = 0; phase < 3; ++phase) {
+    reset_counting_allocator_allocations(counting_allocator);
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_split("/robot/arm/joint_1", '/', allocator, &tokens));
+    ASSERT_EQ(3u, tokens.size);
+    EXPECT_STREQ("joint_1", tokens.data[2]);
+    EXPECT_EQ(0 == phase ? 1u : 0u, get_counting_allocator_allocations(counting_allocator));
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_reset(&arena));
+  }
+
+  // the current block is reused, the others are deallocated
+  char * first = static_cast<char *>(allocator.allocate(8, allocator.state));
+  ASSERT_NE(nullptr, allocator.allocate(100000, allocator.state));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_arena_reset(&arena));
+  EXPECT_EQ(first, allocator.allocate(8, allocator.state));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_arena_fini(&arena));
+}
+
+TEST(test_allocator, block_pool_init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_block_pool_t pool = rcutils_get_zero_initialized_block_pool();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_block_pool_init(nullptr, false, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_block_pool_init(&pool, false, nullptr));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_block_pool_init(&pool, true, &failing_allocator));
+  rcutils_reset_error();
+
+  allocator = rcutils_block_pool_get_allocator(&pool);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  allocator = rcutils_block_pool_get_allocator(nullptr);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+
+  allocator = rcutils_get_default_allocator();
+  for (bool thread_safe : {false, true}) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_block_pool_init(&pool, thread_safe, &allocator));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_block_pool_fini(&pool));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_block_pool_fini(&pool));
+  }
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_block_pool_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_allocator, block_pool_allocate) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_block_pool_t pool = rcutils_get_zero_initialized_block_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_block_pool_init(&pool, false, &counting_allocator));
+  rcutils_allocator_t allocator = rcutils_block_pool_get_allocator(&pool);
+  ASSERT_TRUE(rcutils_allocator_is_valid(&allocator));
+
+  // every size up to the largest block size
+  std::vector<char *> pointers;
+  for (size_t size = 0; size <= RCUTILS_BLOCK_POOL_MAX_BLOCK_SIZE + 1; ++size) {
+    char * pointer = static_cast<char *>(allocator.allocate(size, allocator.state));
+    ASSERT_NE(nullptr, pointer);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer) % 16u);
+    memset(pointer, static_cast<int>(size), size);
+    pointers.push_back(pointer);
+  }
+  for (size_t size = 0; size < pointers.size(); ++size) {
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(static_cast<char>(size), pointers[size][i]);
+    }
+    allocator.deallocate(pointers[size], allocator.state);
+  }
+  allocator.deallocate(nullptr, allocator.state);
+
+  // deallocated blocks are reused without allocating
+  reset_counting_allocator_allocations(counting_allocator);
+  for (size_t i = 0; i < 1000; ++i) {
+    void * pointer = allocator.allocate(40, allocator.state);
+    ASSERT_NE(nullptr, pointer);
+    allocator.deallocate(pointer, allocator.state);
+    EXPECT_EQ(pointer, allocator.allocate(48, allocator.state));
+  }
+  // 1000 blocks of 48 bytes take a few chunks
+  EXPECT_LT(get_counting_allocator_allocations(counting_allocator), 10u);
+
+  int * zeros = static_cast<int *>(allocator.zero_allocate(10, sizeof(int), allocator.state));
+  ASSERT_NE(nullptr, zeros);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(0, zeros[i]);
+  }
+  allocator.deallocate(zeros, allocator.state);
+  EXPECT_EQ(nullptr, allocator.zero_allocate(SIZE_MAX / 2, 4, allocator.state));
+  EXPECT_EQ(nullptr, allocator.allocate(SIZE_MAX, allocator.state));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_block_pool_fini(&pool));
+}
+
+TEST(test_allocator, block_pool_reallocate) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_block_pool_t pool = rcutils_get_zero_initialized_block_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_block_pool_init(&pool, false, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_block_pool_get_allocator(&pool);
+
+  char * pointer = static_cast<char *>(allocator.reallocate(nullptr, 10, allocator.state));
+  ASSERT_NE(nullptr, pointer);
+  memcpy(pointer, "abcdefghi", 10);
+  // within the size class of the block
+  EXPECT_EQ(pointer, allocator.reallocate(pointer, 16, allocator.state));
+  // growing through the size classes and beyond the largest block size
+  for (size_t size : {17u, 100u, 256u, 257u, 1000u, 100000u, 200u, 12u}) {
+    pointer = static_cast<char *>(allocator.reallocate(pointer, size, allocator.state));
+    ASSERT_NE(nullptr, pointer);
+    EXPECT_STREQ("abcdefghi", pointer);
+    memset(pointer + 10, 'x', size - 10);
+  }
+  allocator.deallocate(pointer, allocator.state);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_block_pool_fini(&pool));
+}
+
+static size_t uint32_hash(const void * key)
+{
+  return *static_cast<const uint32_t *>(key);
+}
+
+static int uint32_cmp(const void * lhs, const void * rhs)
+{
+  uint32_t left = *static_cast<const uint32_t *>(lhs);
+  uint32_t right = *static_cast<const uint32_t *>(rhs);
+  return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+TEST(test_allocator, block_pool_hash_map) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_block_pool_t pool = rcutils_get_zero_initialized_block_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_block_pool_init(&pool, false, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_block_pool_get_allocator(&pool);
+
+  rcutils_hash_map_t hash_map = rcutils_get_zero_initialized_hash_map();
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_hash_map_init(
+      &hash_map, 2, sizeof(uint32_t), sizeof(uint32_t), uint32_hash, uint32_cmp, &allocator));
+  for (uint32_t key = 0; key < 1000; ++key) {
+    uint32_t value = key * 2;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&hash_map, &key, &value));
+  }
+  for (uint32_t key = 0; key < 1000; ++key) {
+    uint32_t value = 0;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get(&hash_map, &key, &value));
+    EXPECT_EQ(key * 2, value);
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&hash_map));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_block_pool_fini(&pool));
+}
+
+TEST(test_allocator, block_pool_from_many_threads) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_block_pool_t pool = rcutils_get_zero_initialized_block_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_block_pool_init(&pool, true, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_block_pool_get_allocator(&pool);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 8; ++t) {
+    threads.emplace_back(
+      [&allocator, t]() {
+        std::vector<unsigned char *> pointers;
+        for (size_t i = 0; i < 1000; ++i) {
+          size_t size = 8 + (i + t) % 64;
+          auto pointer = static_cast<unsigned char *>(allocator.allocate(size, allocator.state));
+          ASSERT_NE(nullptr, pointer);
+          memset(pointer, static_cast<int>(t), size);
+          pointers.push_back(pointer);
+          if (i % 3 == 0) {
+            for (size_t j = 0; j < 8; ++j) {
+              ASSERT_EQ(t, pointers.front()[j]);
+            }
+            allocator.deallocate(pointers.front(), allocator.state);
+            pointers.erase(pointers.begin());
+          }
+        }
+        for (unsigned char * pointer : pointers) {
+          allocator.deallocate(pointer, allocator.state);
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+
+  // blocks may be deallocated from another thread than the one which allocated them
+  std::vector<void *> pointers;
+  for (size_t i = 0; i < 100; ++i) {
+    pointers.push_back(allocator.allocate(32, allocator.state));
+    ASSERT_NE(nullptr, pointers.back());
+  }
+  std::thread(
+    [&allocator, &pointers]() {
+      for (void * pointer : pointers) {
+        allocator.deallocate(pointer, allocator.state);
+      }
+    }).join();
+  // the pool is finalized while this thread still caches blocks
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_block_pool_fini(&pool));
+}
+
+TEST(test_allocator, caching_allocator_init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_caching_allocator_t caching_allocator = rcutils_get_zero_initialized_caching_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_caching_allocator_init(nullptr, 64, 8, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_caching_allocator_init(&caching_allocator, 64, 8, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_caching_allocator_init(&caching_allocator, SIZE_MAX, 8, &allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_caching_allocator_init(&caching_allocator, 64, 8, &failing_allocator));
+  rcutils_reset_error();
+
+  allocator = rcutils_caching_allocator_get_allocator(&caching_allocator);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  allocator = rcutils_caching_allocator_get_allocator(nullptr);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED,
+    rcutils_caching_allocator_drain_thread_cache(&caching_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_caching_allocator_drain_thread_cache(nullptr));
+  rcutils_reset_error();
+
+  allocator = rcutils_get_default_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_caching_allocator_init(
+      &caching_allocator, RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_BLOCK_SIZE,
+      RCUTILS_CACHING_ALLOCATOR_DEFAULT_MAX_CACHED_BLOCKS, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_drain_thread_cache(&caching_allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_fini(&caching_allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_fini(&caching_allocator));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_caching_allocator_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_allocator, caching_allocator_allocate) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_caching_allocator_t caching_allocator = rcutils_get_zero_initialized_caching_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_caching_allocator_init(&caching_allocator, 100, 2, &counting_allocator));
+  rcutils_allocator_t allocator = rcutils_caching_allocator_get_allocator(&caching_allocator);
+  ASSERT_TRUE(rcutils_allocator_is_valid(&allocator));
+
+  // a freed block is reused for any size of its class, without touching the other allocator
+  void * pointer = allocator.allocate(40, allocator.state);
+  ASSERT_NE(nullptr, pointer);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer) % 16);
+  memset(pointer, 'x', 40);
+  allocator.deallocate(pointer, allocator.state);
+  reset_counting_allocator_allocations(counting_allocator);
+  EXPECT_EQ(pointer, allocator.allocate(64, allocator.state));
+  EXPECT_EQ(0u, get_counting_allocator_allocations(counting_allocator));
+  allocator.deallocate(pointer, allocator.state);
+  EXPECT_EQ(0u, get_counting_allocator_deallocations(counting_allocator));
+
+  // at most two blocks of a class are cached
+  void * pointers[3];
+  for (void *& p : pointers) {
+    p = allocator.allocate(128, allocator.state);
+    ASSERT_NE(nullptr, p);
+  }
+  reset_counting_allocator_allocations(counting_allocator);
+  for (void * p : pointers) {
+    allocator.deallocate(p, allocator.state);
+  }
+  EXPECT_EQ(1u, get_counting_allocator_deallocations(counting_allocator));
+
+  // the largest cached block size is rounded up to a power of two, larger blocks aren't cached
+  pointer = allocator.allocate(129, allocator.state);
+  ASSERT_NE(nullptr, pointer);
+  memset(pointer, 'x', 129);
+  reset_counting_allocator_allocations(counting_allocator);
+  allocator.deallocate(pointer, allocator.state);
+  EXPECT_EQ(1u, get_counting_allocator_deallocations(counting_allocator));
+
+  auto zeroed = static_cast<char *>(allocator.zero_allocate(3, 10, allocator.state));
+  ASSERT_NE(nullptr, zeroed);
+  for (size_t i = 0; i < 30; ++i) {
+    EXPECT_EQ(0, zeroed[i]);
+  }
+  allocator.deallocate(zeroed, allocator.state);
+  EXPECT_EQ(nullptr, allocator.zero_allocate(SIZE_MAX, 2, allocator.state));
+  EXPECT_EQ(nullptr, allocator.allocate(SIZE_MAX, allocator.state));
+  allocator.deallocate(nullptr, allocator.state);
+
+  // draining deallocates the cached blocks
+  reset_counting_allocator_allocations(counting_allocator);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_drain_thread_cache(&caching_allocator));
+  EXPECT_EQ(4u, get_counting_allocator_deallocations(counting_allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_fini(&caching_allocator));
+}
+
+TEST(test_allocator, caching_allocator_reallocate) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_caching_allocator_t caching_allocator = rcutils_get_zero_initialized_caching_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_caching_allocator_init(&caching_allocator, 256, 4, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_caching_allocator_get_allocator(&caching_allocator);
+
+  auto pointer = static_cast<char *>(allocator.reallocate(nullptr, 10, allocator.state));
+  ASSERT_NE(nullptr, pointer);
+  strcpy(pointer, "abcdefghi");  // NOLINT(runtime/printf)
+  // a block of the class of the new size is kept
+  EXPECT_EQ(pointer, allocator.reallocate(pointer, 16, allocator.state));
+  // growing through the size classes and beyond the largest cached block size
+  for (size_t size : {17u, 100u, 256u, 257u, 1000u, 100000u, 200u, 12u}) {
+    pointer = static_cast<char *>(allocator.reallocate(pointer, size, allocator.state));
+    ASSERT_NE(nullptr, pointer);
+    EXPECT_STREQ("abcdefghi", pointer);
+    memset(pointer + 10, 'x', size - 10);
+  }
+  allocator.deallocate(pointer, allocator.state);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_fini(&caching_allocator));
+}
+
+TEST(test_allocator, caching_allocator_from_many_threads) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_caching_allocator_t caching_allocator = rcutils_get_zero_initialized_caching_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_caching_allocator_init(&caching_allocator, 1024, 16, &counting_allocator));
+  rcutils_allocator_t allocator = rcutils_caching_allocator_get_allocator(&caching_allocator);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 8; ++t) {
+    threads.emplace_back(
+      [&allocator, t]() {
+        std::vector<unsigned char *> pointers;
+        for (size_t i = 0; i < 1000; ++i) {
+          size_t size = 8 + (i + t) % 200;
+          auto pointer = static_cast<unsigned char *>(allocator.allocate(size, allocator.state));
+          ASSERT_NE(nullptr, pointer);
+          memset(pointer, static_cast<int>(t), size);
+          pointers.push_back(pointer);
+          if (i % 3 == 0) {
+            for (size_t j = 0; j < 8; ++j) {
+              ASSERT_EQ(t, pointers.front()[j]);
+            }
+            allocator.deallocate(pointers.front(), allocator.state);
+            pointers.erase(pointers.begin());
+          }
+        }
+        for (unsigned char * pointer : pointers) {
+          allocator.deallocate(pointer, allocator.state);
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  // the threads deallocated all blocks they cached when they exited, and their caches, so
+  // only the caching allocator itself is left
+  EXPECT_EQ(
+    get_counting_allocator_allocations(counting_allocator),
+    get_counting_allocator_deallocations(counting_allocator) + 1);
+
+  // blocks may be deallocated in another thread than the one which allocated them
+  std::vector<void *> pointers;
+  for (size_t i = 0; i < 100; ++i) {
+    pointers.push_back(allocator.allocate(32, allocator.state));
+    ASSERT_NE(nullptr, pointers.back());
+  }
+  std::thread(
+    [&allocator, &pointers]() {
+      for (void * pointer : pointers) {
+        allocator.deallocate(pointer, allocator.state);
+      }
+    }).join();
+  // the caching allocator is finalized while this thread still caches blocks
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_caching_allocator_fini(&caching_allocator));
+  EXPECT_EQ(
+    get_counting_allocator_allocations(counting_allocator),
+    get_counting_allocator_deallocations(counting_allocator));
+}
+
+TEST(test_allocator, tracking_allocator_init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_tracking_allocator_t tracking_allocator =
+    rcutils_get_zero_initialized_tracking_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_tracking_allocator_init(nullptr, false, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_tracking_allocator_init(&tracking_allocator, false, nullptr));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_tracking_allocator_init(&tracking_allocator, true, &failing_allocator));
+  rcutils_reset_error();
+
+  allocator = rcutils_tracking_allocator_get_allocator(&tracking_allocator);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  allocator = rcutils_tracking_allocator_get_allocator(nullptr);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  rcutils_tracking_allocator_statistics_t statistics;
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED,
+    rcutils_tracking_allocator_get_statistics(&tracking_allocator, &statistics));
+  rcutils_reset_error();
+  size_t count = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED,
+    rcutils_tracking_allocator_get_call_sites(&tracking_allocator, nullptr, 0, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_tracking_allocator_reset(&tracking_allocator));
+  rcutils_reset_error();
+
+  allocator = rcutils_get_default_allocator();
+  for (bool track_call_sites : {false, true}) {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_tracking_allocator_init(&tracking_allocator, track_call_sites, &allocator));
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT,
+      rcutils_tracking_allocator_get_statistics(&tracking_allocator, nullptr));
+    rcutils_reset_error();
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT,
+      rcutils_tracking_allocator_get_call_sites(&tracking_allocator, nullptr, 1, &count));
+    rcutils_reset_error();
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT,
+      rcutils_tracking_allocator_get_call_sites(&tracking_allocator, nullptr, 0, nullptr));
+    rcutils_reset_error();
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_fini(&tracking_allocator));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_fini(&tracking_allocator));
+  }
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_tracking_allocator_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_allocator, tracking_allocator_statistics) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_tracking_allocator_t tracking_allocator =
+    rcutils_get_zero_initialized_tracking_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_init(&tracking_allocator, false, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_tracking_allocator_get_allocator(&tracking_allocator);
+  ASSERT_TRUE(rcutils_allocator_is_valid(&allocator));
+
+  void * a = allocator.allocate(100, allocator.state);
+  ASSERT_NE(nullptr, a);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a) % 16);
+  auto b = static_cast<char *>(allocator.zero_allocate(10, 5, allocator.state));
+  ASSERT_NE(nullptr, b);
+  for (size_t i = 0; i < 50; ++i) {
+    EXPECT_EQ(0, b[i]);
+  }
+  b = static_cast<char *>(allocator.reallocate(b, 200, allocator.state));
+  ASSERT_NE(nullptr, b);
+  allocator.deallocate(a, allocator.state);
+  allocator.deallocate(nullptr, allocator.state);
+  EXPECT_EQ(nullptr, allocator.allocate(SIZE_MAX, allocator.state));
+  EXPECT_EQ(nullptr, allocator.zero_allocate(SIZE_MAX, 2, allocator.state));
+
+  rcutils_tracking_allocator_statistics_t statistics;
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_tracking_allocator_get_statistics(&tracking_allocator, &statistics));
+  EXPECT_EQ(2u, statistics.allocations);
+  EXPECT_EQ(1u, statistics.reallocations);
+  EXPECT_EQ(1u, statistics.deallocations);
+  EXPECT_EQ(350u, statistics.total_bytes);
+  EXPECT_EQ(200u, statistics.current_bytes);
+  EXPECT_EQ(300u, statistics.peak_bytes);
+
+  // the bytes currently allocated are kept by a reset, and still counted once deallocated
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_reset(&tracking_allocator));
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_tracking_allocator_get_statistics(&tracking_allocator, &statistics));
+  EXPECT_EQ(0u, statistics.allocations);
+  EXPECT_EQ(0u, statistics.total_bytes);
+  EXPECT_EQ(200u, statistics.current_bytes);
+  EXPECT_EQ(200u, statistics.peak_bytes);
+  allocator.deallocate(b, allocator.state);
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_tracking_allocator_get_statistics(&tracking_allocator, &statistics));
+  EXPECT_EQ(1u, statistics.deallocations);
+  EXPECT_EQ(0u, statistics.current_bytes);
+  EXPECT_EQ(200u, statistics.peak_bytes);
+
+  // call sites aren't tracked
+  size_t count = 1;
+  EXPECT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_get_call_sites(&tracking_allocator, nullptr, 0, &count));
+  EXPECT_EQ(0u, count);
+
+  // e.g. to find out whether a function allocates
+  char * copy = rcutils_strdup("hello", allocator);
+  ASSERT_NE(nullptr, copy);
+  allocator.deallocate(copy, allocator.state);
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_tracking_allocator_get_statistics(&tracking_allocator, &statistics));
+  EXPECT_EQ(1u, statistics.allocations);
+  EXPECT_EQ(6u, statistics.total_bytes);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_fini(&tracking_allocator));
+}
+
+TEST(test_allocator, tracking_allocator_call_sites) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_tracking_allocator_t tracking_allocator =
+    rcutils_get_zero_initialized_tracking_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_init(&tracking_allocator, true, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_tracking_allocator_get_allocator(&tracking_allocator);
+
+  size_t count = 0;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_get_call_sites(&tracking_allocator, nullptr, 0, &count));
+  EXPECT_EQ(0u, count);
+
+  char * copies[3];
+  for (char *& copy : copies) {
+    copy = rcutils_strdup("hello", allocator);
+    ASSERT_NE(nullptr, copy);
+  }
+  void * pointer = allocator.allocate(100, allocator.state);
+  ASSERT_NE(nullptr, pointer);
+
+  rcutils_tracking_allocator_call_site_t call_sites[2];
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_get_call_sites(&tracking_allocator, call_sites, 2, &count));
+  EXPECT_EQ(2u, count);
+  EXPECT_NE(nullptr, call_sites[0].address);
+  EXPECT_EQ(3u, call_sites[0].allocations);
+  EXPECT_EQ(18u, call_sites[0].bytes);
+  EXPECT_NE(nullptr, call_sites[1].address);
+  EXPECT_NE(call_sites[0].address, call_sites[1].address);
+  EXPECT_EQ(1u, call_sites[1].allocations);
+  EXPECT_EQ(100u, call_sites[1].bytes);
+
+  // only the most allocating call sites are copied
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_get_call_sites(&tracking_allocator, call_sites, 1, &count));
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(3u, call_sites[0].allocations);
+
+  for (char * copy : copies) {
+    allocator.deallocate(copy, allocator.state);
+  }
+  allocator.deallocate(pointer, allocator.state);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_reset(&tracking_allocator));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_get_call_sites(&tracking_allocator, call_sites, 2, &count));
+  EXPECT_EQ(0u, count);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_fini(&tracking_allocator));
+}
+
+TEST(test_allocator, tracking_allocator_from_many_threads) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_tracking_allocator_t tracking_allocator =
+    rcutils_get_zero_initialized_tracking_allocator();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_tracking_allocator_init(&tracking_allocator, true, &default_allocator));
+  rcutils_allocator_t allocator = rcutils_tracking_allocator_get_allocator(&tracking_allocator);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 8; ++t) {
+    threads.emplace_back(
+      [&allocator]() {
+        for (size_t i = 0; i < 1000; ++i) {
+          void * pointer = allocator.allocate(16, allocator.state);
+          ASSERT_NE(nullptr, pointer);
+          pointer = allocator.reallocate(pointer, 32, allocator.state);
+          ASSERT_NE(nullptr, pointer);
+          allocator.deallocate(pointer, allocator.state);
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+
+  rcutils_tracking_allocator_statistics_t statistics;
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_tracking_allocator_get_statistics(&tracking_allocator, &statistics));
+  EXPECT_EQ(8000u, statistics.allocations);
+  EXPECT_EQ(8000u, statistics.reallocations);
+  EXPECT_EQ(8000u, statistics.deallocations);
+  EXPECT_EQ(8000u * 48u, statistics.total_bytes);
+  EXPECT_EQ(0u, statistics.current_bytes);
+  EXPECT_LE(32u, statistics.peak_bytes);
+  EXPECT_GE(8u * 32u, statistics.peak_bytes);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_tracking_allocator_fini(&tracking_allocator));
+}
+
+TEST(test_allocator, page_allocator_init_fini) {
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_page_allocator_t page_allocator = rcutils_get_zero_initialized_page_allocator();
+  rcutils_page_allocator_options_t options = rcutils_page_allocator_get_default_options();
+  EXPECT_EQ(RCUTILS_PAGE_ALLOCATOR_ANY_NODE, options.numa_node);
+  EXPECT_EQ(RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE, options.huge_pages);
+  EXPECT_EQ(static_cast<size_t>(RCUTILS_PAGE_ALLOCATOR_DEFAULT_MIN_SIZE), options.min_size);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_page_allocator_init(nullptr, &options, &default_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_page_allocator_init(&page_allocator, nullptr, &default_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_page_allocator_init(&page_allocator, &options, nullptr));
+  rcutils_reset_error();
+  options.numa_node = -3;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_page_allocator_init(&page_allocator, &options, &default_allocator));
+  rcutils_reset_error();
+  options = rcutils_page_allocator_get_default_options();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_page_allocator_init(&page_allocator, &options, &failing_allocator));
+  rcutils_reset_error();
+
+  rcutils_allocator_t allocator = rcutils_page_allocator_get_allocator(&page_allocator);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+  allocator = rcutils_page_allocator_get_allocator(nullptr);
+  EXPECT_FALSE(rcutils_allocator_is_valid(&allocator));
+
+#ifdef __linux__
+  options.numa_node = 4000;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_page_allocator_init(&page_allocator, &options, &default_allocator));
+  rcutils_reset_error();
+  options.numa_node = 0;
+  options.huge_pages = RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_TRANSPARENT;
+#else
+  options.numa_node = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_page_allocator_init(&page_allocator, &options, &default_allocator));
+  rcutils_reset_error();
+  options.numa_node = RCUTILS_PAGE_ALLOCATOR_ANY_NODE;
+#endif
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_page_allocator_init(&page_allocator, &options, &default_allocator));
+  allocator = rcutils_page_allocator_get_allocator(&page_allocator);
+  EXPECT_TRUE(rcutils_allocator_is_valid(&allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_page_allocator_fini(&page_allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_page_allocator_fini(&page_allocator));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_page_allocator_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_allocator, page_allocator_allocate) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  const size_t min_size = 64 * 1024;
+  const size_t huge_page_size = 2 * 1024 * 1024;
+#ifdef __linux__
+  const std::vector<int> nodes = {
+    RCUTILS_PAGE_ALLOCATOR_ANY_NODE, RCUTILS_PAGE_ALLOCATOR_LOCAL_NODE, 0};
+  const std::vector<rcutils_page_allocator_huge_pages_t> huge_pages = {
+    RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE, RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_TRANSPARENT,
+    RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_EXPLICIT};
+#else
+  const std::vector<int> nodes = {RCUTILS_PAGE_ALLOCATOR_ANY_NODE};
+  const std::vector<rcutils_page_allocator_huge_pages_t> huge_pages = {
+    RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE};
+#endif
+  for (int node : nodes) {
+    for (rcutils_page_allocator_huge_pages_t huge_page_mode : huge_pages) {
+      rcutils_page_allocator_options_t options = rcutils_page_allocator_get_default_options();
+      options.numa_node = node;
+      options.huge_pages = huge_page_mode;
+      options.min_size = min_size;
+      rcutils_page_allocator_t page_allocator = rcutils_get_zero_initialized_page_allocator();
+      ASSERT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_page_allocator_init(&page_allocator, &options, &counting_allocator));
+      rcutils_allocator_t allocator = rcutils_page_allocator_get_allocator(&page_allocator);
+
+      // Small allocations are forwarded.
+      reset_counting_allocator_allocations(counting_allocator);
+      char * small = static_cast<char *>(allocator.allocate(100, allocator.state));
+      ASSERT_NE(nullptr, small);
+      EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(small) % 16);
+      EXPECT_EQ(1u, get_counting_allocator_allocations(counting_allocator));
+      memset(small, 'a', 100);
+      small = static_cast<char *>(allocator.reallocate(small, 1000, allocator.state));
+      ASSERT_NE(nullptr, small);
+      EXPECT_EQ('a', small[99]);
+
+      // Large ones are mapped, also when a small allocation grows.
+      reset_counting_allocator_allocations(counting_allocator);
+      char * large = static_cast<char *>(allocator.reallocate(small, min_size, allocator.state));
+      ASSERT_NE(nullptr, large);
+      EXPECT_EQ('a', large[99]);
+      memset(large, 'b', min_size);
+      char * zeroed =
+        static_cast<char *>(allocator.zero_allocate(3, huge_page_size, allocator.state));
+      ASSERT_NE(nullptr, zeroed);
+      EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(zeroed) % 16);
+#ifdef __linux__
+      EXPECT_EQ(0u, get_counting_allocator_allocations(counting_allocator));
+      EXPECT_EQ(1u, get_counting_allocator_deallocations(counting_allocator));
+      if (RCUTILS_PAGE_ALLOCATOR_HUGE_PAGES_NONE != huge_page_mode) {
+        // The mappings are aligned to the huge page size, before the header of the allocation.
+        EXPECT_EQ(16u, reinterpret_cast<uintptr_t>(zeroed) % huge_page_size);
+      }
+      if (0 == node) {
+        int mode = -1;
+        unsigned long nodemask = 0;  // NOLINT(runtime/int)
+        ASSERT_EQ(
+          0, syscall(
+            SYS_get_mempolicy, &mode, &nodemask, sizeof(nodemask) * 8, zeroed, MPOL_F_ADDR));
+        EXPECT_EQ(MPOL_BIND, mode);
+        EXPECT_EQ(1u, nodemask);
+      }
+#endif
+      for (size_t i = 0; i < 3 * huge_page_size; ++i) {
+        ASSERT_EQ(0, zeroed[i]);
+      }
+      memset(zeroed, 'c', 3 * huge_page_size);
+
+      // A mapping is kept while it is large enough.
+      EXPECT_EQ(zeroed, allocator.reallocate(zeroed, 2 * huge_page_size, allocator.state));
+      char * grown =
+        static_cast<char *>(allocator.reallocate(zeroed, 4 * huge_page_size, allocator.state));
+      ASSERT_NE(nullptr, grown);
+      EXPECT_EQ('c', grown[2 * huge_page_size - 1]);
+      memset(grown, 'd', 4 * huge_page_size);
+
+      // A mapping shrinking below the smallest mapped size is forwarded again.
+      small = static_cast<char *>(allocator.reallocate(large, 10, allocator.state));
+      ASSERT_NE(nullptr, small);
+      EXPECT_EQ('b', small[9]);
+      allocator.deallocate(small, allocator.state);
+      allocator.deallocate(grown, allocator.state);
+      allocator.deallocate(nullptr, allocator.state);
+
+      EXPECT_EQ(nullptr, allocator.allocate(SIZE_MAX, allocator.state));
+      EXPECT_EQ(nullptr, allocator.zero_allocate(SIZE_MAX, 2, allocator.state));
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_page_allocator_fini(&page_allocator));
+    }
+  }
+}
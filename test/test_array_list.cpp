@@ -438,3 +438,328 @@ TEST_F(ArrayListTest, list_add_bad_allocator_fails) {
   state.is_failing = false;
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_fini(&list));
 }
+
+TEST_F(ArrayListTest, get_ptr_list_null_fails) {
+  void * ret_data = nullptr;
+  rcutils_ret_t ret = rcutils_array_list_get_ptr(nullptr, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_get_ptr(&list, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, ret) << rcutils_get_error_string().str;
+}
+
+TEST_F(ArrayListPreInitTest, get_ptr_points_into_list) {
+  void * ret_data = nullptr;
+  rcutils_ret_t ret = rcutils_array_list_get_ptr(&list, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  for (uint32_t i = 0; i < 3; ++i) {
+    uint32_t data = i * 2;
+    ret = rcutils_array_list_add(&list, &data);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  ret = rcutils_array_list_get_ptr(&list, 1, nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  ret = rcutils_array_list_get_ptr(&list, 1, &ret_data);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint32_t * entries = static_cast<uint32_t *>(ret_data);
+  EXPECT_EQ(2u, entries[0]);
+  EXPECT_EQ(4u, entries[1]);
+
+  // the entry can be modified in place
+  entries[0] = 3;
+  uint32_t ret_data_copy = 0;
+  ret = rcutils_array_list_get(&list, 1, &ret_data_copy);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(3u, ret_data_copy);
+}
+
+TEST_F(ArrayListPreInitTest, add_n_and_reserve) {
+  uint32_t data[5] = {1, 2, 3, 4, 5};
+  rcutils_ret_t ret = rcutils_array_list_add_n(&list, nullptr, 1);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_add_n(&list, data, SIZE_MAX);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  ret = rcutils_array_list_add_n(&list, data, 0);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_add_n(&list, data, 5);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_add_n(&list, data, 2);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  size_t size = 0;
+  ret = rcutils_array_list_get_size(&list, &size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(7u, size);
+  uint32_t expected[7] = {1, 2, 3, 4, 5, 1, 2};
+  for (size_t i = 0; i < size; ++i) {
+    uint32_t ret_data = 0;
+    ret = rcutils_array_list_get(&list, i, &ret_data);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_EQ(expected[i], ret_data);
+  }
+
+  // after reserving, adding doesn't move the entries
+  ret = rcutils_array_list_reserve(&list, 100);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_reserve(&list, 1);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  void * first = nullptr;
+  ret = rcutils_array_list_get_ptr(&list, 0, &first);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  for (uint32_t i = 0; i < 93; ++i) {
+    ret = rcutils_array_list_add(&list, &i);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  void * first_after = nullptr;
+  ret = rcutils_array_list_get_ptr(&list, 0, &first_after);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(first, first_after);
+
+  ret = rcutils_array_list_reserve(&list, SIZE_MAX);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_reserve(nullptr, 1);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+}
+
+TEST_F(ArrayListPreInitTest, swap_remove_moves_last_entry) {
+  rcutils_ret_t ret = rcutils_array_list_swap_remove(&list, 0);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  uint32_t data[4] = {0, 2, 4, 6};
+  ret = rcutils_array_list_add_n(&list, data, 4);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  ret = rcutils_array_list_swap_remove(&list, 1);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint32_t expected[3] = {0, 6, 4};
+  for (size_t i = 0; i < 3; ++i) {
+    uint32_t ret_data = 0;
+    ret = rcutils_array_list_get(&list, i, &ret_data);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_EQ(expected[i], ret_data);
+  }
+
+  // removing the last entry just drops it
+  ret = rcutils_array_list_swap_remove(&list, 2);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t size = 0;
+  ret = rcutils_array_list_get_size(&list, &size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(2u, size);
+  ret = rcutils_array_list_swap_remove(&list, 2);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+}
+
+TEST_F(ArrayListTest, init_with_inline_capacity) {
+  rcutils_ret_t ret = rcutils_array_list_init_with_inline_capacity(
+    nullptr, 2, sizeof(uint32_t), &allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_init_with_inline_capacity(&list, 0, sizeof(uint32_t), &allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_init_with_inline_capacity(&list, 2, 0, &allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_init_with_inline_capacity(&list, SIZE_MAX, 2, &allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_init_with_inline_capacity(&list, 2, sizeof(uint32_t), nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  // the list and its inline entries take a single allocation
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  ret = rcutils_array_list_init_with_inline_capacity(
+    &list, 2, sizeof(uint32_t), &time_bomb_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint32_t data[2] = {1, 2};
+  ret = rcutils_array_list_add_n(&list, data, 2);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  // growing past the inline capacity moves the entries into an allocation of their own
+  ret = rcutils_array_list_add(&list, &data[0]);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, -1);
+  for (uint32_t i = 3; i <= 9; ++i) {
+    ret = rcutils_array_list_add(&list, &i);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  for (uint32_t i = 1; i <= 9; ++i) {
+    uint32_t ret_data = 0;
+    ret = rcutils_array_list_get(&list, i - 1, &ret_data);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_EQ(i, ret_data);
+  }
+
+  ret = rcutils_array_list_init_with_inline_capacity(&list, 2, sizeof(uint32_t), &allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_fini(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+}
+
+TEST_F(ArrayListTest, inline_list_reserve_and_fini) {
+  rcutils_ret_t ret = rcutils_array_list_init_with_inline_capacity(
+    &list, 4, sizeof(uint64_t), &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint64_t data = 42;
+  ret = rcutils_array_list_add(&list, &data);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_reserve(&list, 16);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint64_t ret_data = 0;
+  ret = rcutils_array_list_get(&list, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(42u, ret_data);
+  ret = rcutils_array_list_fini(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+}
+
+TEST_F(ArrayListTest, shrink_to_fit_and_allocated_size) {
+  size_t allocated_size = 0;
+  rcutils_ret_t ret = rcutils_array_list_get_allocated_size(nullptr, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_shrink_to_fit(nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  ret = rcutils_array_list_shrink_to_fit(&list);
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  ret = rcutils_array_list_init(&list, 2, sizeof(uint32_t), &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_get_allocated_size(&list, nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  size_t initial_size = 0;
+  ret = rcutils_array_list_get_allocated_size(&list, &initial_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_LE(2 * sizeof(uint32_t), initial_size);
+
+  // a burst of entries grows the list, which keeps its capacity after they are removed
+  for (uint32_t i = 0; i < 100; ++i) {
+    ret = rcutils_array_list_add(&list, &i);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  for (uint32_t i = 0; i < 97; ++i) {
+    ret = rcutils_array_list_remove(&list, 0);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  size_t grown_size = 0;
+  ret = rcutils_array_list_get_allocated_size(&list, &grown_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_LE(initial_size + 98 * sizeof(uint32_t), grown_size);
+
+  ret = rcutils_array_list_shrink_to_fit(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(initial_size + sizeof(uint32_t), allocated_size);
+  for (uint32_t i = 0; i < 3; ++i) {
+    uint32_t ret_data = 0;
+    ret = rcutils_array_list_get(&list, i, &ret_data);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_EQ(97u + i, ret_data);
+  }
+
+  // an empty list keeps room for an entry
+  for (uint32_t i = 0; i < 3; ++i) {
+    ret = rcutils_array_list_remove(&list, 0);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  ret = rcutils_array_list_shrink_to_fit(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(initial_size - sizeof(uint32_t), allocated_size);
+  ret = rcutils_array_list_fini(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+}
+
+TEST_F(ArrayListTest, inline_list_shrink_to_fit) {
+  rcutils_ret_t ret = rcutils_array_list_init_with_inline_capacity(
+    &list, 4, sizeof(uint64_t), &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t inline_size = 0;
+  ret = rcutils_array_list_get_allocated_size(&list, &inline_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_LE(4 * sizeof(uint64_t), inline_size);
+
+  // shrinking inline entries does nothing
+  ret = rcutils_array_list_shrink_to_fit(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t allocated_size = 0;
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(inline_size, allocated_size);
+
+  for (uint64_t i = 0; i < 20; ++i) {
+    ret = rcutils_array_list_add(&list, &i);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_LE(inline_size + 20 * sizeof(uint64_t), allocated_size);
+
+  // entries which don't fit inline stay in an allocation of their own, fitted to them
+  for (size_t i = 0; i < 14; ++i) {
+    ret = rcutils_array_list_swap_remove(&list, 0);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  ret = rcutils_array_list_shrink_to_fit(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(inline_size + 6 * sizeof(uint64_t), allocated_size);
+
+  // and move back inline once they fit there
+  ret = rcutils_array_list_remove(&list, 0);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_remove(&list, 0);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint64_t expected[4];
+  for (size_t i = 0; i < 4; ++i) {
+    ret = rcutils_array_list_get(&list, i, &expected[i]);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  ret = rcutils_array_list_shrink_to_fit(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_array_list_get_allocated_size(&list, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(inline_size, allocated_size);
+  for (size_t i = 0; i < 4; ++i) {
+    uint64_t ret_data = 0;
+    ret = rcutils_array_list_get(&list, i, &ret_data);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_EQ(expected[i], ret_data);
+  }
+
+  // and can grow out of it again
+  uint64_t data = 42;
+  ret = rcutils_array_list_add(&list, &data);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  uint64_t ret_data = 0;
+  ret = rcutils_array_list_get(&list, 4, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(42u, ret_data);
+  ret = rcutils_array_list_fini(&list);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+}
@@ -0,0 +1,316 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#ifdef _WIN32
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/async_write.h"
+#include "rcutils/error_handling.h"
+
+#ifdef _WIN32
+# define open _open
+# define close _close
+# define O_WRONLY _O_WRONLY
+# define O_RDONLY _O_RDONLY
+# define O_CREAT _O_CREAT
+# define O_TRUNC _O_TRUNC
+# define O_BINARY_FLAG _O_BINARY
+#else
+# define O_BINARY_FLAG 0
+#endif
+
+struct write_result_t
+{
+  std::atomic<size_t> calls{0};
+  std::atomic<size_t> failures{0};
+  std::atomic<size_t> written{0};
+};
+
+static void count_write(rcutils_ret_t ret, size_t written, void * context)
+{
+  write_result_t * result = static_cast<write_result_t *>(context);
+  if (RCUTILS_RET_OK != ret) {
+    ++result->failures;
+  }
+  result->written += written;
+  ++result->calls;
+}
+
+static std::string read_file(const std::string & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+class AsyncWriteTest : public ::testing::TestWithParam<rcutils_async_write_backend_t>
+{
+protected:
+  void SetUp() override
+  {
+    path = std::string("test_async_write_") + std::to_string(GetParam()) + ".bin";
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY_FLAG, 0644);
+    ASSERT_GE(fd, 0);
+    allocator = rcutils_get_default_allocator();
+    writer = rcutils_get_zero_initialized_async_writer();
+    rcutils_async_writer_options_t options = rcutils_async_writer_get_default_options();
+    options.backend = GetParam();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_init(&writer, &options, &allocator)) <<
+      rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_writer_fini(&writer));
+    close(fd);
+    std::remove(path.c_str());
+  }
+
+  std::string path;
+  int fd = -1;
+  rcutils_allocator_t allocator;
+  rcutils_async_writer_t writer;
+};
+
+TEST_P(AsyncWriteTest, write_at_offsets) {
+  EXPECT_NE(RCUTILS_ASYNC_WRITE_BACKEND_AUTO, rcutils_async_writer_get_backend(&writer));
+  if (RCUTILS_ASYNC_WRITE_BACKEND_THREADS == GetParam()) {
+    EXPECT_EQ(RCUTILS_ASYNC_WRITE_BACKEND_THREADS, rcutils_async_writer_get_backend(&writer));
+  }
+
+  // Chunks submitted out of order, more than the writer has in flight at once.
+  const size_t chunk_count = 300;
+  const size_t chunk_size = 1000;
+  std::vector<std::string> chunks;
+  std::string expected;
+  for (size_t i = 0; i < chunk_count; ++i) {
+    chunks.push_back(std::string(chunk_size, static_cast<char>('a' + i % 26)));
+    expected += chunks.back();
+  }
+  write_result_t result;
+  for (size_t i = chunk_count; i > 0; --i) {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_async_write(
+        &writer, fd, chunks[i - 1].data(), chunk_size, static_cast<int64_t>((i - 1) * chunk_size),
+        count_write, &result));
+  }
+  // A write of nothing completes as well.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_write(&writer, fd, nullptr, 0u, 0, count_write, &result));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_flush(&writer));
+  EXPECT_EQ(chunk_count + 1, result.calls);
+  EXPECT_EQ(0u, result.failures);
+  EXPECT_EQ(chunk_count * chunk_size, result.written);
+  EXPECT_EQ(expected, read_file(path));
+
+  // Without a callback
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_async_write(&writer, fd, "xyz", 3u, static_cast<int64_t>(expected.size()), NULL, NULL));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_flush(&writer));
+  EXPECT_EQ(expected + "xyz", read_file(path));
+}
+
+TEST_P(AsyncWriteTest, write_from_many_threads) {
+  const size_t thread_count = 4;
+  const size_t writes_per_thread = 200;
+  const size_t record_size = 64;
+  std::vector<std::string> records(thread_count * writes_per_thread);
+  write_result_t result;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back(
+      [&, t]() {
+        for (size_t i = 0; i < writes_per_thread; ++i) {
+          size_t index = t * writes_per_thread + i;
+          records[index] = std::string(record_size - 1, static_cast<char>('A' + t)) + "\n";
+          ASSERT_EQ(
+            RCUTILS_RET_OK,
+            rcutils_async_write(
+              &writer, fd, records[index].data(), record_size,
+              static_cast<int64_t>(index * record_size), count_write, &result));
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_flush(&writer));
+  EXPECT_EQ(records.size(), result.calls);
+  EXPECT_EQ(0u, result.failures);
+
+  std::string expected;
+  for (const std::string & record : records) {
+    expected += record;
+  }
+  EXPECT_EQ(expected, read_file(path));
+}
+
+struct chained_write_t
+{
+  rcutils_async_writer_t * writer;
+  int fd;
+  std::string data;
+  size_t next;
+  std::atomic<bool> done{false};
+};
+
+// Write one byte at a time, submitting the next write from the callback of the previous one.
+static void write_next_byte(rcutils_ret_t ret, size_t written, void * context)
+{
+  chained_write_t * chain = static_cast<chained_write_t *>(context);
+  if (RCUTILS_RET_OK != ret || 1u != written || ++chain->next == chain->data.size()) {
+    chain->done = true;
+    return;
+  }
+  if (RCUTILS_RET_OK != rcutils_async_write(
+      chain->writer, chain->fd, &chain->data[chain->next], 1u,
+      static_cast<int64_t>(chain->next), write_next_byte, chain))
+  {
+    chain->done = true;
+  }
+}
+
+TEST_P(AsyncWriteTest, write_from_callback) {
+  chained_write_t chain;
+  chain.writer = &writer;
+  chain.fd = fd;
+  chain.data = "written one byte at a time";
+  chain.next = 0;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_async_write(&writer, fd, chain.data.data(), 1u, 0, write_next_byte, &chain));
+  while (!chain.done) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_flush(&writer));
+  }
+  EXPECT_EQ(chain.data.size(), chain.next);
+  EXPECT_EQ(chain.data, read_file(path));
+}
+
+TEST_P(AsyncWriteTest, write_errors) {
+  int read_only_fd = open(path.c_str(), O_RDONLY | O_BINARY_FLAG);
+  ASSERT_GE(read_only_fd, 0);
+  write_result_t result;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_async_write(&writer, read_only_fd, "data", 4u, 0, count_write, &result));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_flush(&writer));
+  close(read_only_fd);
+  EXPECT_EQ(1u, result.calls);
+  EXPECT_EQ(1u, result.failures);
+  EXPECT_EQ(0u, result.written);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_write(&writer, -1, "data", 4u, 0, NULL, NULL));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_write(&writer, fd, "data", 4u, -1, NULL, NULL));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_write(&writer, fd, nullptr, 4u, 0, NULL, NULL));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_async_write(&writer, fd, "data", 4u, INT64_MAX - 1, NULL, NULL));
+  rcutils_reset_error();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  backends, AsyncWriteTest,
+  ::testing::Values(RCUTILS_ASYNC_WRITE_BACKEND_AUTO, RCUTILS_ASYNC_WRITE_BACKEND_THREADS));
+
+TEST(test_async_write, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_async_writer_t writer = rcutils_get_zero_initialized_async_writer();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_writer_init(nullptr, NULL, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_writer_init(&writer, NULL, nullptr));
+  rcutils_reset_error();
+  rcutils_async_writer_options_t options = rcutils_async_writer_get_default_options();
+  options.thread_count = 0u;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_writer_init(&writer, &options, &allocator));
+  rcutils_reset_error();
+  options = rcutils_async_writer_get_default_options();
+  options.backend = static_cast<rcutils_async_write_backend_t>(3);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_writer_init(&writer, &options, &allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_async_writer_init(&writer, NULL, &failing_allocator));
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_ASYNC_WRITE_BACKEND_AUTO, rcutils_async_writer_get_backend(&writer));
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED, rcutils_async_write(&writer, 1, "data", 4u, 0, NULL, NULL));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_async_writer_flush(&writer));
+  rcutils_reset_error();
+
+  // io_uring is either used or reported as unavailable.
+  options = rcutils_async_writer_get_default_options();
+  options.backend = RCUTILS_ASYNC_WRITE_BACKEND_IO_URING;
+  rcutils_ret_t ret = rcutils_async_writer_init(&writer, &options, &allocator);
+  if (RCUTILS_RET_OK == ret) {
+    EXPECT_EQ(RCUTILS_ASYNC_WRITE_BACKEND_IO_URING, rcutils_async_writer_get_backend(&writer));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_writer_fini(&writer));
+  } else {
+    EXPECT_EQ(RCUTILS_RET_ERROR, ret);
+    rcutils_reset_error();
+  }
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_init(&writer, NULL, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_writer_flush(&writer));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_writer_fini(&writer));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_writer_fini(&writer));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_writer_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_async_write, fini_waits_for_writes) {
+  const std::string path = "test_async_write_fini.bin";
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY_FLAG, 0644);
+  ASSERT_GE(fd, 0);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_async_writer_t writer = rcutils_get_zero_initialized_async_writer();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_init(&writer, NULL, &allocator));
+  const std::string data(1 << 20, 'x');
+  write_result_t result;
+  for (size_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_async_write(
+        &writer, fd, data.data(), data.size(), static_cast<int64_t>(i * data.size()),
+        count_write, &result));
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_fini(&writer));
+  EXPECT_EQ(8u, result.calls);
+  EXPECT_EQ(8u * data.size(), result.written);
+  close(fd);
+  EXPECT_EQ(8u * data.size(), read_file(path).size());
+  std::remove(path.c_str());
+}
@@ -41,6 +41,117 @@
     } \
   } while (0)
 
+#define TEST_ATOMIC_TYPE_EXPLICIT(BASE_TYPE, ATOMIC_TYPE) \
+  do { \
+    ATOMIC_TYPE uut; \
+    atomic_init(&uut, (BASE_TYPE)0); \
+    BASE_TYPE loaded_value; \
+    rcutils_atomic_load_explicit(&uut, loaded_value, memory_order_relaxed); \
+    if ((BASE_TYPE)0 != loaded_value) { \
+      fprintf(stderr, "explicit load test failed " #ATOMIC_TYPE " base " #BASE_TYPE "\n"); \
+      return 1; \
+    } \
+    BASE_TYPE exchanged_value; \
+    rcutils_atomic_store_explicit(&uut, (BASE_TYPE)28, memory_order_release); \
+    rcutils_atomic_exchange_explicit(&uut, exchanged_value, (BASE_TYPE)42, memory_order_acq_rel); \
+    rcutils_atomic_load_explicit(&uut, loaded_value, memory_order_acquire); \
+    if ((BASE_TYPE)28 != exchanged_value || (BASE_TYPE)42 != loaded_value) { \
+      fprintf(stderr, "explicit exchange test failed " #ATOMIC_TYPE " base " #BASE_TYPE "\n"); \
+      return 1; \
+    } \
+    BASE_TYPE expected = (BASE_TYPE)0; \
+    bool exchanged = true; \
+    rcutils_atomic_compare_exchange_strong_explicit( \
+      &uut, exchanged, &expected, (BASE_TYPE)0, memory_order_acq_rel, memory_order_acquire); \
+    if (exchanged || (BASE_TYPE)42 != expected) { \
+      fprintf(stderr, "explicit compare exchange test failed " #ATOMIC_TYPE "\n"); \
+      return 1; \
+    } \
+    rcutils_atomic_compare_exchange_strong_explicit( \
+      &uut, exchanged, &expected, (BASE_TYPE)0, memory_order_release, memory_order_relaxed); \
+    rcutils_atomic_load_explicit(&uut, loaded_value, memory_order_seq_cst); \
+    if (!exchanged || (BASE_TYPE)0 != loaded_value) { \
+      fprintf(stderr, "explicit compare exchange test failed " #ATOMIC_TYPE "\n"); \
+      return 1; \
+    } \
+  } while (0)
+
+#define TEST_ATOMIC_ARITHMETIC(BASE_TYPE, ATOMIC_TYPE) \
+  do { \
+    ATOMIC_TYPE uut; \
+    atomic_init(&uut, (BASE_TYPE)12); \
+    BASE_TYPE previous_value; \
+    BASE_TYPE loaded_value; \
+    rcutils_atomic_fetch_add_explicit(&uut, previous_value, (BASE_TYPE)3, memory_order_relaxed); \
+    rcutils_atomic_fetch_sub(&uut, previous_value, (BASE_TYPE)5); \
+    rcutils_atomic_load(&uut, loaded_value); \
+    if ((BASE_TYPE)15 != previous_value || (BASE_TYPE)10 != loaded_value) { \
+      fprintf(stderr, "add/sub test failed " #ATOMIC_TYPE " base " #BASE_TYPE "\n"); \
+      return 1; \
+    } \
+    rcutils_atomic_fetch_or_explicit(&uut, previous_value, (BASE_TYPE)5, memory_order_release); \
+    rcutils_atomic_fetch_and(&uut, previous_value, (BASE_TYPE)6); \
+    rcutils_atomic_fetch_sub_explicit(&uut, loaded_value, (BASE_TYPE)1, memory_order_acquire); \
+    if ((BASE_TYPE)15 != previous_value || (BASE_TYPE)6 != loaded_value) { \
+      fprintf(stderr, "or/and test failed " #ATOMIC_TYPE " base " #BASE_TYPE "\n"); \
+      return 1; \
+    } \
+    rcutils_atomic_fetch_or(&uut, previous_value, (BASE_TYPE)8); \
+    rcutils_atomic_fetch_and_explicit(&uut, previous_value, (BASE_TYPE)9, memory_order_acq_rel); \
+    rcutils_atomic_load(&uut, loaded_value); \
+    if ((BASE_TYPE)13 != previous_value || (BASE_TYPE)9 != loaded_value) { \
+      fprintf(stderr, "or/and test failed " #ATOMIC_TYPE " base " #BASE_TYPE "\n"); \
+      return 1; \
+    } \
+  } while (0)
+
+static int
+test_typed_explicit(void)
+{
+  atomic_uint_least64_t counter;
+  atomic_init(&counter, (uint64_t)0);
+  if (0u != rcutils_atomic_fetch_add_uint64_t_explicit(&counter, 40u, memory_order_relaxed) ||
+    40u != rcutils_atomic_fetch_sub_uint64_t_explicit(&counter, 8u, memory_order_release) ||
+    32u != rcutils_atomic_fetch_or_uint64_t_explicit(&counter, 3u, memory_order_acquire) ||
+    35u != rcutils_atomic_fetch_and_uint64_t_explicit(&counter, 6u, memory_order_acq_rel) ||
+    2u != rcutils_atomic_fetch_sub_uint64_t(&counter, 2u) ||
+    0u != rcutils_atomic_fetch_or_uint64_t(&counter, 12u) ||
+    12u != rcutils_atomic_fetch_and_uint64_t(&counter, 4u) ||
+    4u != rcutils_atomic_load_uint64_t_explicit(&counter, memory_order_acquire))
+  {
+    fprintf(stderr, "typed explicit arithmetic test failed\n");
+    return 1;
+  }
+  uint64_t expected = 5u;
+  if (rcutils_atomic_compare_exchange_strong_uint_least64_t_explicit(
+      &counter, &expected, 9u, memory_order_acq_rel, memory_order_relaxed) || 4u != expected ||
+    !rcutils_atomic_compare_exchange_strong_uint_least64_t_explicit(
+      &counter, &expected, 9u, memory_order_acq_rel, memory_order_relaxed) ||
+    9u != rcutils_atomic_exchange_uint64_t_explicit(&counter, 1u, memory_order_release))
+  {
+    fprintf(stderr, "typed explicit compare exchange test failed\n");
+    return 1;
+  }
+
+  atomic_bool flag;
+  atomic_init(&flag, false);
+  atomic_int_least64_t value;
+  atomic_init(&value, (int64_t)-3);
+  atomic_uintptr_t pointer;
+  atomic_init(&pointer, (uintptr_t)0);
+  if (rcutils_atomic_exchange_bool_explicit(&flag, true, memory_order_acq_rel) ||
+    !rcutils_atomic_load_bool_explicit(&flag, memory_order_relaxed) ||
+    -3 != rcutils_atomic_exchange_int64_t_explicit(&value, 5, memory_order_relaxed) ||
+    5 != rcutils_atomic_load_int64_t_explicit(&value, memory_order_acquire) ||
+    0u != rcutils_atomic_exchange_uintptr_t_explicit(&pointer, 16u, memory_order_release) ||
+    16u != rcutils_atomic_load_uintptr_t_explicit(&pointer, memory_order_relaxed))
+  {
+    fprintf(stderr, "typed explicit exchange test failed\n");
+    return 1;
+  }
+  return 0;
+}
+
 int
 main()
 {
@@ -77,5 +188,22 @@ main()
 
   TEST_ATOMIC_TYPE(int *, _Atomic(int *));
   TEST_ATOMIC_TYPE(int **, _Atomic(int **));
-  return 0;
+
+  TEST_ATOMIC_TYPE_EXPLICIT(_Bool, atomic_bool);
+  TEST_ATOMIC_TYPE_EXPLICIT(char, atomic_char);
+  TEST_ATOMIC_TYPE_EXPLICIT(short, atomic_short);  // NOLINT(runtime/int)
+  TEST_ATOMIC_TYPE_EXPLICIT(int, atomic_int);
+  TEST_ATOMIC_TYPE_EXPLICIT(unsigned int, atomic_uint);
+  TEST_ATOMIC_TYPE_EXPLICIT(int_least64_t, atomic_int_least64_t);
+  TEST_ATOMIC_TYPE_EXPLICIT(uint_least64_t, atomic_uint_least64_t);
+  TEST_ATOMIC_TYPE_EXPLICIT(uintptr_t, atomic_uintptr_t);
+  TEST_ATOMIC_TYPE_EXPLICIT(size_t, atomic_size_t);
+
+  TEST_ATOMIC_ARITHMETIC(unsigned char, atomic_uchar);
+  TEST_ATOMIC_ARITHMETIC(uint_least16_t, atomic_uint_least16_t);
+  TEST_ATOMIC_ARITHMETIC(uint_least32_t, atomic_uint_least32_t);
+  TEST_ATOMIC_ARITHMETIC(uint_least64_t, atomic_uint_least64_t);
+  TEST_ATOMIC_ARITHMETIC(size_t, atomic_size_t);
+
+  return test_typed_explicit();
 }
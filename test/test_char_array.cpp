@@ -13,8 +13,12 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include <string>
+
 #include "./allocator_testing_utils.h"
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
@@ -51,6 +55,18 @@ static rcutils_ret_t example_logger(
   return status;
 }
 
+static rcutils_ret_t example_appender(
+  rcutils_char_array_t * char_array,
+  const char * format, ...)
+{
+  rcutils_ret_t status;
+  va_list args;
+  va_start(args, format);
+  status = rcutils_char_array_vstrcatf(char_array, format, args);
+  va_end(args);
+  return status;
+}
+
 TEST_F(ArrayCharTest, default_initialization) {
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&char_array, 0, &allocator));
   EXPECT_EQ(0lu, char_array.buffer_capacity);
@@ -118,6 +134,69 @@ TEST_F(ArrayCharTest, resize) {
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
 }
 
+TEST_F(ArrayCharTest, shrink_to_fit_and_allocated_size) {
+  size_t allocated_size = 1;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_char_array_shrink_to_fit(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_char_array_get_allocated_size(nullptr, &allocated_size));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_char_array_get_allocated_size(&char_array, nullptr));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&char_array, 8, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_get_allocated_size(&char_array, &allocated_size));
+  EXPECT_EQ(8u, allocated_size);
+
+  // a long message grows the buffer, which a shorter one doesn't shrink
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, std::string(100, 'a').c_str()));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, "abc"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_get_allocated_size(&char_array, &allocated_size));
+  EXPECT_LE(101u, allocated_size);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_shrink_to_fit(&char_array));
+  EXPECT_EQ(4u, char_array.buffer_capacity);
+  EXPECT_EQ(4u, char_array.buffer_length);
+  EXPECT_STREQ("abc", char_array.buffer);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_get_allocated_size(&char_array, &allocated_size));
+  EXPECT_EQ(4u, allocated_size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcat(&char_array, "def"));
+  EXPECT_STREQ("abcdef", char_array.buffer);
+
+  // an empty buffer is given back altogether
+  char_array.buffer_length = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_shrink_to_fit(&char_array));
+  EXPECT_EQ(nullptr, char_array.buffer);
+  EXPECT_EQ(0u, char_array.buffer_capacity);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, "ghi"));
+  EXPECT_STREQ("ghi", char_array.buffer);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+
+  // a buffer which isn't owned is left alone, and counts for nothing
+  char buffer[16] = "abc";
+  char_array.buffer = buffer;
+  char_array.owns_buffer = false;
+  char_array.buffer_length = 4;
+  char_array.buffer_capacity = sizeof(buffer);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_shrink_to_fit(&char_array));
+  EXPECT_EQ(buffer, char_array.buffer);
+  EXPECT_EQ(sizeof(buffer), char_array.buffer_capacity);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_get_allocated_size(&char_array, &allocated_size));
+  EXPECT_EQ(0u, allocated_size);
+
+  // the buffer is kept if it can't be reallocated
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&char_array, 16, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, "abc"));
+  char_array.allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_char_array_shrink_to_fit(&char_array));
+  rcutils_reset_error();
+  EXPECT_EQ(16u, char_array.buffer_capacity);
+  EXPECT_STREQ("abc", char_array.buffer);
+  char_array.allocator = allocator;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+}
+
 TEST_F(ArrayCharTest, vsprintf_fail) {
   rcutils_allocator_t failing_allocator = get_failing_allocator();
   rcutils_ret_t ret = rcutils_char_array_init(&char_array, 10, &allocator);
@@ -132,6 +211,73 @@ TEST_F(ArrayCharTest, vsprintf_fail) {
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
 }
 
+TEST_F(ArrayCharTest, vsprintf) {
+  rcutils_ret_t ret = rcutils_char_array_init(&char_array, 0, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  EXPECT_EQ(RCUTILS_RET_OK, example_logger(&char_array, "%s %d", "first", 1));
+  EXPECT_STREQ("first 1", char_array.buffer);
+  EXPECT_EQ(8lu, char_array.buffer_length);
+
+  // fits in the current capacity
+  char * buffer = char_array.buffer;
+  EXPECT_EQ(RCUTILS_RET_OK, example_logger(&char_array, "%d", 22));
+  EXPECT_STREQ("22", char_array.buffer);
+  EXPECT_EQ(3lu, char_array.buffer_length);
+  EXPECT_EQ(buffer, char_array.buffer);
+
+  // has to grow
+  EXPECT_EQ(RCUTILS_RET_OK, example_logger(&char_array, "a much longer string %d", 333));
+  EXPECT_STREQ("a much longer string 333", char_array.buffer);
+  EXPECT_EQ(25lu, char_array.buffer_length);
+  EXPECT_LE(25lu, char_array.buffer_capacity);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+}
+
+TEST_F(ArrayCharTest, vstrcatf) {
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  rcutils_ret_t ret = rcutils_char_array_init(&char_array, 8, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  EXPECT_EQ(RCUTILS_RET_OK, example_appender(&char_array, "%d", 12));
+  EXPECT_STREQ("12", char_array.buffer);
+  EXPECT_EQ(3lu, char_array.buffer_length);
+
+  EXPECT_EQ(RCUTILS_RET_OK, example_appender(&char_array, "%s", "34"));
+  EXPECT_STREQ("1234", char_array.buffer);
+  EXPECT_EQ(5lu, char_array.buffer_length);
+
+  // has to grow, keeping what was there
+  EXPECT_EQ(RCUTILS_RET_OK, example_appender(&char_array, "%d%s", 56789, "abcdef"));
+  EXPECT_STREQ("123456789abcdef", char_array.buffer);
+  EXPECT_EQ(16lu, char_array.buffer_length);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcat(&char_array, "g"));
+  EXPECT_EQ(RCUTILS_RET_OK, example_appender(&char_array, ""));
+  EXPECT_STREQ("123456789abcdefg", char_array.buffer);
+  EXPECT_EQ(17lu, char_array.buffer_length);
+
+  char_array.allocator = failing_allocator;
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    example_appender(&char_array, "%s", "a string which is longer than the capacity"));
+  rcutils_reset_error();
+  EXPECT_STREQ("123456789abcdefg", char_array.buffer);
+  EXPECT_EQ(17lu, char_array.buffer_length);
+
+  char_array.allocator = allocator;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+
+  // appending to an empty char array without a buffer
+  ret = rcutils_char_array_init(&char_array, 0, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(RCUTILS_RET_OK, example_appender(&char_array, "%d", 1));
+  EXPECT_STREQ("1", char_array.buffer);
+  EXPECT_EQ(2lu, char_array.buffer_length);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+}
+
 TEST_F(ArrayCharTest, strcpy) {
   rcutils_allocator_t failing_allocator = get_failing_allocator();
   rcutils_ret_t ret = rcutils_char_array_init(&char_array, 8, &allocator);
@@ -169,3 +315,104 @@ TEST_F(ArrayCharTest, strcat) {
   char_array.allocator = allocator;
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
 }
+
+TEST_F(ArrayCharTest, append_chars) {
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  rcutils_ret_t ret = rcutils_char_array_init(&char_array, 0, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, 'a'));
+  EXPECT_STREQ("a", char_array.buffer);
+  EXPECT_EQ(2lu, char_array.buffer_length);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_repeated_char(&char_array, ' ', 3));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_repeated_char(&char_array, 'b', 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, 'c'));
+  EXPECT_STREQ("a   c", char_array.buffer);
+  EXPECT_EQ(6lu, char_array.buffer_length);
+
+  // the buffer grows geometrically
+  for (size_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, 'x'));
+  }
+  EXPECT_EQ(1006lu, char_array.buffer_length);
+  EXPECT_EQ(1005lu, strlen(char_array.buffer));
+  EXPECT_GE(char_array.buffer_capacity, 1006lu);
+  EXPECT_LT(char_array.buffer_capacity, 1006lu * 2);
+
+  size_t capacity = char_array.buffer_capacity;
+  char_array.allocator = failing_allocator;
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_char_array_append_repeated_char(&char_array, 'y', capacity));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_char_array_append_repeated_char(&char_array, 'y', SIZE_MAX));
+  rcutils_reset_error();
+  EXPECT_EQ(1006lu, char_array.buffer_length);
+  EXPECT_EQ(1005lu, strlen(char_array.buffer));
+
+  char_array.allocator = allocator;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+}
+
+TEST_F(ArrayCharTest, append_numbers) {
+  rcutils_ret_t ret = rcutils_char_array_init(&char_array, 4, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, "n="));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_uint(&char_array, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_uint(&char_array, 7));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_uint(&char_array, 42));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_uint(&char_array, 100));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_uint(&char_array, UINT64_MAX));
+  EXPECT_STREQ("n=0,7,42,100,18446744073709551615", char_array.buffer);
+  EXPECT_EQ(strlen(char_array.buffer) + 1, char_array.buffer_length);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, ""));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_int(&char_array, -1));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_int(&char_array, 12345));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_int(&char_array, INT64_MIN));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_char(&char_array, ','));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_int(&char_array, INT64_MAX));
+  EXPECT_STREQ("-1,12345,-9223372036854775808,9223372036854775807", char_array.buffer);
+
+  for (int64_t value : {0ll, 5ll, -5ll, 1234567890123ll, -1000000000ll, 999999999ll}) {
+    for (size_t decimals : {0u, 1u, 3u, 9u}) {
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, ""));
+      EXPECT_EQ(
+        RCUTILS_RET_OK, rcutils_char_array_append_fixed_point(&char_array, value, decimals));
+      int64_t scale = 1;
+      for (size_t i = 0; i < decimals; ++i) {
+        scale *= 10;
+      }
+      char expected[64];
+      if (decimals > 0) {
+        snprintf(
+          expected, sizeof(expected), "%s%lld.%0*lld", value < 0 ? "-" : "",
+          static_cast<long long>(std::llabs(value / scale)), static_cast<int>(decimals),
+          static_cast<long long>(std::llabs(value % scale)));
+      } else {
+        snprintf(expected, sizeof(expected), "%lld", static_cast<long long>(value));
+      }
+      EXPECT_STREQ(expected, char_array.buffer) << value << " " << decimals;
+    }
+  }
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&char_array, ""));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_append_fixed_point(&char_array, INT64_MIN, 19));
+  EXPECT_STREQ("-0.9223372036854775808", char_array.buffer);
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_char_array_append_fixed_point(&char_array, 1, 20));
+  rcutils_reset_error();
+  EXPECT_STREQ("-0.9223372036854775808", char_array.buffer);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+}
@@ -14,7 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "./time_bomb_allocator_testing_utils.h"
+#include "rcutils/allocator.h"
 #include "rcutils/cmdline_parser.h"
+#include "rcutils/error_handling.h"
 
 
 TEST(CmdLineParser, cli_option_exist) {
@@ -38,3 +45,133 @@ TEST(CmdLineParser, cli_get_option) {
   EXPECT_STREQ(rcutils_cli_get_option(arr, arr + args_count, "NotRelated"), NULL);
   EXPECT_STREQ(rcutils_cli_get_option(arr, arr + args_count, "option2"), NULL);
 }
+
+TEST(CmdLineParser, cli_index_init_fini) {
+  char const * args[] = {"option1", "sub1", "option2"};
+  const int args_count = sizeof(args) / sizeof(char *);
+  char ** arr = const_cast<char **>(args);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_cli_index_t index = rcutils_get_zero_initialized_cli_index();
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_cli_index_init(nullptr, arr, arr + args_count, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_cli_index_init(&index, arr, arr + args_count, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_cli_index_init(&index, nullptr, arr + args_count, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_cli_index_init(&index, arr + args_count, arr, &allocator));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_cli_index_init(&index, arr, arr + args_count, &failing_allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_calloc_count(time_bomb_allocator, 0);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_cli_index_init(&index, arr, arr + args_count, &time_bomb_allocator));
+  rcutils_reset_error();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_cli_index_init(&index, arr, arr + args_count, &time_bomb_allocator));
+  rcutils_reset_error();
+
+  // An uninitialized index has no options.
+  EXPECT_FALSE(rcutils_cli_index_option_exist(&index, "option1"));
+  EXPECT_FALSE(rcutils_cli_index_option_exist(nullptr, "option1"));
+  EXPECT_EQ(0u, rcutils_cli_index_get_option_count(&index, "option1"));
+  EXPECT_EQ(nullptr, rcutils_cli_index_get_option(&index, "option1"));
+
+  // No arguments at all.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_cli_index_init(&index, nullptr, nullptr, &allocator));
+  EXPECT_FALSE(rcutils_cli_index_option_exist(&index, "option1"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cli_index_fini(&index));
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_cli_index_init(&index, arr, arr + args_count, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cli_index_fini(&index));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cli_index_fini(&index));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_cli_index_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(CmdLineParser, cli_index_get_option) {
+  char const * args[] = {
+    "node", "--ros-args", "-r", "a:=b", "-p", "x:=1", nullptr, "-r", "c:=d", "", "-r"};
+  const int args_count = sizeof(args) / sizeof(char *);
+  char ** arr = const_cast<char **>(args);
+  rcutils_allocator_t allocator = get_counting_allocator();
+  rcutils_cli_index_t index = rcutils_get_zero_initialized_cli_index();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_cli_index_init(&index, arr, arr + args_count, &allocator));
+
+  EXPECT_TRUE(rcutils_cli_index_option_exist(&index, "node"));
+  EXPECT_TRUE(rcutils_cli_index_option_exist(&index, "--ros-args"));
+  EXPECT_TRUE(rcutils_cli_index_option_exist(&index, ""));
+  EXPECT_FALSE(rcutils_cli_index_option_exist(&index, "--ros"));
+  EXPECT_FALSE(rcutils_cli_index_option_exist(&index, "NotRelated"));
+  EXPECT_FALSE(rcutils_cli_index_option_exist(&index, nullptr));
+
+  EXPECT_STREQ("-r", rcutils_cli_index_get_option(&index, "--ros-args"));
+  EXPECT_STREQ("x:=1", rcutils_cli_index_get_option(&index, "-p"));
+  EXPECT_EQ(nullptr, rcutils_cli_index_get_option(&index, "x:=1"));
+  EXPECT_EQ(nullptr, rcutils_cli_index_get_option(&index, "NotRelated"));
+
+  EXPECT_EQ(3u, rcutils_cli_index_get_option_count(&index, "-r"));
+  EXPECT_EQ(1u, rcutils_cli_index_get_option_count(&index, "-p"));
+  EXPECT_EQ(0u, rcutils_cli_index_get_option_count(&index, "-q"));
+  EXPECT_STREQ("a:=b", rcutils_cli_index_get_option_at(&index, "-r", 0));
+  EXPECT_STREQ("c:=d", rcutils_cli_index_get_option_at(&index, "-r", 1));
+  // The last occurrence is the last argument.
+  EXPECT_EQ(nullptr, rcutils_cli_index_get_option_at(&index, "-r", 2));
+  EXPECT_EQ(nullptr, rcutils_cli_index_get_option_at(&index, "-r", 3));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cli_index_fini(&index));
+  EXPECT_EQ(
+    get_counting_allocator_allocations(allocator),
+    get_counting_allocator_deallocations(allocator));
+}
+
+TEST(CmdLineParser, cli_index_many_arguments) {
+  std::vector<std::string> strings = {"node", "--ros-args"};
+  for (int i = 0; i < 500; ++i) {
+    strings.push_back(0 == i % 2 ? "-r" : "-p");
+    strings.push_back("name" + std::to_string(i) + ":=" + std::to_string(i));
+  }
+  std::vector<char *> args;
+  for (auto & string : strings) {
+    args.push_back(&string[0]);
+  }
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_cli_index_t index = rcutils_get_zero_initialized_cli_index();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_cli_index_init(&index, args.data(), args.data() + args.size(), &allocator));
+
+  ASSERT_EQ(250u, rcutils_cli_index_get_option_count(&index, "-r"));
+  ASSERT_EQ(250u, rcutils_cli_index_get_option_count(&index, "-p"));
+  for (size_t i = 0; i < 250; ++i) {
+    EXPECT_EQ(
+      "name" + std::to_string(2 * i) + ":=" + std::to_string(2 * i),
+      rcutils_cli_index_get_option_at(&index, "-r", i));
+    EXPECT_EQ(
+      "name" + std::to_string(2 * i + 1) + ":=" + std::to_string(2 * i + 1),
+      rcutils_cli_index_get_option_at(&index, "-p", i));
+  }
+  for (size_t i = 2; i < strings.size(); i += 2) {
+    EXPECT_TRUE(rcutils_cli_index_option_exist(&index, strings[i + 1].c_str()));
+    EXPECT_EQ(
+      rcutils_cli_option_exist(args.data(), args.data() + args.size(), strings[i + 1].c_str()),
+      rcutils_cli_index_option_exist(&index, strings[i + 1].c_str()));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cli_index_fini(&index));
+}
@@ -0,0 +1,207 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "./time_bomb_allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/concurrent_hash_map.h"
+
+static size_t test_uint64_hash_func(const void * key)
+{
+  return static_cast<size_t>(*static_cast<const uint64_t *>(key));
+}
+
+static int test_uint64_cmp(const void * val1, const void * val2)
+{
+  uint64_t value1 = *static_cast<const uint64_t *>(val1);
+  uint64_t value2 = *static_cast<const uint64_t *>(val2);
+  return value1 < value2 ? -1 : (value1 > value2 ? 1 : 0);
+}
+
+class ConcurrentHashMapTest : public ::testing::TestWithParam<rcutils_hash_map_backend_t>
+{
+protected:
+  void SetUp() override
+  {
+    allocator = rcutils_get_default_allocator();
+    map = rcutils_get_zero_initialized_concurrent_hash_map();
+    rcutils_ret_t ret = rcutils_concurrent_hash_map_init(
+      &map, RCUTILS_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT, 4, sizeof(uint64_t),
+      sizeof(uint64_t), test_uint64_hash_func, test_uint64_cmp, GetParam(), &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_fini(&map));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_concurrent_hash_map_t map;
+};
+
+TEST(ConcurrentHashMap, init_invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_concurrent_hash_map_t map = rcutils_get_zero_initialized_concurrent_hash_map();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_init(
+      nullptr, 4, 4, sizeof(uint64_t), sizeof(uint64_t), test_uint64_hash_func, test_uint64_cmp,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_init(
+      &map, 0, 4, sizeof(uint64_t), sizeof(uint64_t), test_uint64_hash_func, test_uint64_cmp,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_init(
+      &map, 4, 4, 0, sizeof(uint64_t), test_uint64_hash_func, test_uint64_cmp,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_init(
+      &map, 4, 4, sizeof(uint64_t), sizeof(uint64_t), nullptr, test_uint64_cmp,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_init(
+      &map, 4, 4, sizeof(uint64_t), sizeof(uint64_t), test_uint64_hash_func, nullptr,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, map.impl);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_fini(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_concurrent_hash_map_fini(&map));
+  rcutils_reset_error();
+  uint64_t key = 1, data = 0;
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_concurrent_hash_map_get_size(&map, &size));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_concurrent_hash_map_set(&map, &key, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_concurrent_hash_map_unset(&map, &key));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_concurrent_hash_map_get(&map, &key, &data));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_concurrent_hash_map_key_exists(&map, &key));
+  EXPECT_FALSE(rcutils_concurrent_hash_map_key_exists(nullptr, &key));
+}
+
+TEST(ConcurrentHashMap, init_failing_allocator) {
+  rcutils_allocator_t failing_allocator = get_time_bomb_allocator();
+  rcutils_concurrent_hash_map_t map = rcutils_get_zero_initialized_concurrent_hash_map();
+  for (int count = 0; count < 6; ++count) {
+    set_time_bomb_allocator_malloc_count(failing_allocator, count);
+    EXPECT_EQ(
+      RCUTILS_RET_BAD_ALLOC, rcutils_concurrent_hash_map_init(
+        &map, 4, 4, sizeof(uint64_t), sizeof(uint64_t), test_uint64_hash_func, test_uint64_cmp,
+        RCUTILS_HASH_MAP_BACKEND_CHAINING, &failing_allocator)) << count;
+    rcutils_reset_error();
+    EXPECT_EQ(nullptr, map.impl);
+  }
+}
+
+TEST_P(ConcurrentHashMapTest, set_get_unset) {
+  uint64_t data = 0;
+  size_t size = 0;
+  for (uint64_t key = 0; key < 100; ++key) {
+    uint64_t value = key * 2;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_set(&map, &key, &value));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_get_size(&map, &size));
+  EXPECT_EQ(100u, size);
+  for (uint64_t key = 0; key < 100; ++key) {
+    EXPECT_TRUE(rcutils_concurrent_hash_map_key_exists(&map, &key));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_get(&map, &key, &data));
+    EXPECT_EQ(key * 2, data);
+  }
+  for (uint64_t key = 0; key < 100; key += 2) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_unset(&map, &key));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_get_size(&map, &size));
+  EXPECT_EQ(50u, size);
+  uint64_t key = 42;
+  EXPECT_FALSE(rcutils_concurrent_hash_map_key_exists(&map, &key));
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_concurrent_hash_map_get(&map, &key, &data));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_get(&map, nullptr, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_concurrent_hash_map_set(&map, &key, nullptr));
+  rcutils_reset_error();
+}
+
+TEST_P(ConcurrentHashMapTest, concurrent_readers_and_writers) {
+  const uint64_t keys_per_writer = 2000;
+  const size_t writer_count = 4;
+  std::atomic<bool> done(false);
+  std::atomic<size_t> bad_reads(0);
+
+  // A key is only ever set to its double, so a reader sees either no value or the right one.
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < 4; ++r) {
+    readers.emplace_back(
+      [&]() {
+        uint64_t key = 0, data = 0;
+        while (!done) {
+          key = (key + 7919) % (keys_per_writer * writer_count);
+          rcutils_ret_t ret = rcutils_concurrent_hash_map_get(&map, &key, &data);
+          if (RCUTILS_RET_OK == ret ? data != key * 2 : RCUTILS_RET_NOT_FOUND != ret) {
+            ++bad_reads;
+          }
+        }
+      });
+  }
+  std::vector<std::thread> writers;
+  for (size_t w = 0; w < writer_count; ++w) {
+    writers.emplace_back(
+      [&, w]() {
+        for (uint64_t i = 0; i < keys_per_writer; ++i) {
+          uint64_t key = i * writer_count + w;
+          uint64_t value = key * 2;
+          EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_set(&map, &key, &value));
+          if (0 == i % 3) {
+            EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_unset(&map, &key));
+          }
+        }
+      });
+  }
+  for (auto & writer : writers) {
+    writer.join();
+  }
+  done = true;
+  for (auto & reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0u, bad_reads.load());
+
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_concurrent_hash_map_get_size(&map, &size));
+  EXPECT_EQ(writer_count * (keys_per_writer - (keys_per_writer + 2) / 3), size);
+  for (uint64_t key = 0; key < keys_per_writer * writer_count; ++key) {
+    EXPECT_EQ(0 != (key / writer_count) % 3, rcutils_concurrent_hash_map_key_exists(&map, &key));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  ConcurrentHashMapBackends, ConcurrentHashMapTest,
+  ::testing::Values(
+    RCUTILS_HASH_MAP_BACKEND_CHAINING, RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING,
+    RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL));
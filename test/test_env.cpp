@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "rcutils/env.h"
 #include "rcutils/error_handling.h"
@@ -84,6 +86,98 @@ TEST(TestEnv, test_get_env) {
   EXPECT_STREQ("", env);
 }
 
+TEST(TestEnv, test_get_env_cached) {
+  const char * env;
+  EXPECT_STREQ("argument env_value is null", rcutils_get_env_cached("NORMAL_TEST", NULL));
+  EXPECT_STREQ("argument env_name is null", rcutils_get_env_cached(NULL, &env));
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("SHOULD_NOT_EXIST_TEST", &env));
+  EXPECT_STREQ("", env);
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NORMAL_TEST", &env));
+  EXPECT_STREQ("foo", env);
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("EMPTY_TEST", &env));
+  EXPECT_STREQ("", env);
+  // Only whole names match.
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NORMAL_TES", &env));
+  EXPECT_STREQ("", env);
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NORMAL_TEST_", &env));
+  EXPECT_STREQ("", env);
+
+  // The snapshot agrees with the environment for every variable.
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("HOME", &env));
+  const char * expected;
+  ASSERT_EQ(nullptr, rcutils_get_env("HOME", &expected));
+  EXPECT_STREQ(expected, env);
+
+  // Setting variables discards the snapshot.
+  ASSERT_TRUE(rcutils_set_env("NEW_CACHED_ENV_VAR", "CachedValue"));
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NEW_CACHED_ENV_VAR", &env));
+  EXPECT_STREQ("CachedValue", env);
+  ASSERT_TRUE(rcutils_set_env("NEW_CACHED_ENV_VAR", "OtherValue"));
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NEW_CACHED_ENV_VAR", &env));
+  EXPECT_STREQ("OtherValue", env);
+  ASSERT_TRUE(rcutils_set_env("NEW_CACHED_ENV_VAR", nullptr));
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NEW_CACHED_ENV_VAR", &env));
+  EXPECT_STREQ("", env);
+
+#ifndef _WIN32
+  // Changes made otherwise are only seen once the snapshot is invalidated.
+  ASSERT_EQ(0, setenv("NEW_CACHED_ENV_VAR", "DirectValue", 1));
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NEW_CACHED_ENV_VAR", &env));
+  EXPECT_STREQ("", env);
+  rcutils_env_cache_invalidate();
+  ASSERT_EQ(nullptr, rcutils_get_env_cached("NEW_CACHED_ENV_VAR", &env));
+  EXPECT_STREQ("DirectValue", env);
+  ASSERT_EQ(0, unsetenv("NEW_CACHED_ENV_VAR"));
+  rcutils_env_cache_invalidate();
+#endif
+
+  // Invalidating twice, or without a snapshot, does nothing.
+  rcutils_env_cache_invalidate();
+  rcutils_env_cache_invalidate();
+}
+
+TEST(TestEnv, test_get_env_many) {
+  const char * names[] = {"NORMAL_TEST", "SHOULD_NOT_EXIST_TEST", "EMPTY_TEST", "NORMAL_TEST"};
+  const char * values[4] = {nullptr, nullptr, nullptr, nullptr};
+  EXPECT_STREQ("argument env_names is null", rcutils_get_env_many(nullptr, 4, values));
+  EXPECT_STREQ("argument env_values is null", rcutils_get_env_many(names, 4, nullptr));
+  const char * null_names[] = {"NORMAL_TEST", nullptr};
+  EXPECT_STREQ(
+    "argument env_names contains a null name", rcutils_get_env_many(null_names, 2, values));
+  EXPECT_EQ(nullptr, rcutils_get_env_many(nullptr, 0, nullptr));
+
+  ASSERT_EQ(nullptr, rcutils_get_env_many(names, 4, values));
+  EXPECT_STREQ("foo", values[0]);
+  EXPECT_STREQ("", values[1]);
+  EXPECT_STREQ("", values[2]);
+  EXPECT_STREQ("foo", values[3]);
+}
+
+TEST(TestEnv, test_get_env_cached_concurrently) {
+  rcutils_env_cache_invalidate();
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(8, 0);
+  for (size_t i = 0; i < mismatches.size(); ++i) {
+    threads.emplace_back(
+      [&mismatches, i]() {
+        for (int j = 0; j < 1000; ++j) {
+          const char * env = nullptr;
+          if (nullptr != rcutils_get_env_cached("NORMAL_TEST", &env) ||
+          std::string("foo") != env)
+          {
+            ++mismatches[i];
+          }
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  for (int count : mismatches) {
+    EXPECT_EQ(0, count);
+  }
+}
+
 TEST(TestEnv, test_get_home) {
   EXPECT_STRNE(NULL, rcutils_get_home_dir());
   const char * home = NULL;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <thread>
 
 #include "./allocator_testing_utils.h"
 #include "gmock/gmock.h"
@@ -340,3 +341,169 @@ TEST(test_error_handling, overwrite) {
     rcutils_reset_error();
   });
 }
+
+TEST(test_error_handling, set_static_error_state) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest scoped_quickstart_gtest;
+  rcutils_ret_t ret =
+    rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
+  ASSERT_EQ(ret, RCUTILS_RET_OK);
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_reset_error();
+  });
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_set_error_state_static("static message", __FILE__, 42);
+  });
+  EXPECT_TRUE(rcutils_error_is_set());
+  {
+    EXPECT_NO_MEMORY_OPERATIONS_BEGIN();
+    rcutils_error_string_t error_string = rcutils_get_error_string();
+    EXPECT_NO_MEMORY_OPERATIONS_END();
+    EXPECT_EQ(std::string("static message, at ") + __FILE__ + ":42", error_string.str);
+  }
+  {
+    EXPECT_NO_MEMORY_OPERATIONS_BEGIN();
+    const rcutils_error_state_t * error_state = rcutils_get_error_state();
+    EXPECT_NO_MEMORY_OPERATIONS_END();
+    ASSERT_NE(nullptr, error_state);
+    EXPECT_STREQ("static message", error_state->message);
+    EXPECT_STREQ(__FILE__, error_state->file);
+    EXPECT_EQ(42u, error_state->line_number);
+  }
+
+  // Setting the error state again with its own message doesn't warn and keeps the message.
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    RCUTILS_SET_ERROR_MSG(rcutils_get_error_state()->message);
+  });
+  EXPECT_STREQ("static message", rcutils_get_error_state()->message);
+
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_reset_error();
+  });
+  const rcutils_error_state_t * error_state = rcutils_get_error_state();
+  EXPECT_STREQ("", error_state->message);
+  EXPECT_STREQ("", error_state->file);
+  EXPECT_EQ(0u, error_state->line_number);
+
+  printf("The following error from within error_handling.c is expected.\n");
+  rcutils_set_error_state_static(NULL, __FILE__, 42);
+  EXPECT_FALSE(rcutils_error_is_set());
+}
+
+TEST(test_error_handling, set_error_msg_copies_literals_by_default) {
+  // Outside of rcutils, the string literals of a library may dangle once it is unloaded.
+  static_assert(
+    0 == RCUTILS_SET_ERROR_MSG_STATIC_LITERALS,
+    "string literals must be copied unless their code is known never to be unloaded");
+  RCUTILS_SET_ERROR_MSG("literal message");
+  EXPECT_STREQ("literal message", rcutils_get_error_state()->message);
+  rcutils_reset_error();
+}
+
+TEST(test_error_handling, new_thread) {
+  // Without initializing its thread-local storage first, a thread still handles errors.
+  std::string error_string;
+  std::string error_message;
+  std::thread thread(
+    [&]() {
+      EXPECT_FALSE(rcutils_error_is_set());
+      EXPECT_STREQ("", rcutils_get_error_state()->message);
+      RCUTILS_SET_ERROR_MSG("error of a new thread");
+      error_string = rcutils_get_error_string().str;
+      error_message = rcutils_get_error_state()->message;
+      rcutils_reset_error();
+    });
+  thread.join();
+  EXPECT_EQ(0u, error_string.find("error of a new thread, at "));
+  EXPECT_EQ("error of a new thread", error_message);
+}
+
+TEST(test_error_handling, set_literal_and_buffer) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest scoped_quickstart_gtest;
+  rcutils_ret_t ret =
+    rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
+  ASSERT_EQ(ret, RCUTILS_RET_OK);
+  rcutils_reset_error();
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    RCUTILS_SET_ERROR_MSG("literal message");
+  });
+  EXPECT_STREQ("literal message", rcutils_get_error_state()->message);
+  EXPECT_EQ(0u, std::string(rcutils_get_error_string().str).find("literal message, at "));
+  rcutils_reset_error();
+
+  // A message which is not a literal is copied, so changing it afterwards doesn't change the error.
+  char buffer[] = "buffer message";
+  RCUTILS_SET_ERROR_MSG(buffer);
+  buffer[0] = 'B';
+  EXPECT_STREQ("buffer message", rcutils_get_error_state()->message);
+  EXPECT_EQ(0u, std::string(rcutils_get_error_string().str).find("buffer message, at "));
+  rcutils_reset_error();
+}
+
+TEST(test_error_handling, error_frames) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest scoped_quickstart_gtest;
+  rcutils_ret_t ret =
+    rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
+  ASSERT_EQ(ret, RCUTILS_RET_OK);
+  rcutils_reset_error();
+
+  // Without an error set, the frame becomes the error.
+  RCUTILS_PUSH_ERROR_FRAME(RCUTILS_RET_ERROR, "no error yet");
+  EXPECT_TRUE(rcutils_error_is_set());
+  EXPECT_EQ(0u, rcutils_get_error_frame_count());
+  EXPECT_STREQ("no error yet", rcutils_get_error_state()->message);
+  rcutils_reset_error();
+
+  rcutils_set_error_state("error", "error.c", 1);
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_push_error_frame(RCUTILS_RET_BAD_ALLOC, "inner", "inner.c", 2);
+    rcutils_push_error_frame(RCUTILS_RET_ERROR, "outer", "outer.c", 3);
+  });
+  ASSERT_EQ(2u, rcutils_get_error_frame_count());
+  const rcutils_error_frame_t * frame = rcutils_get_error_frame(0);
+  ASSERT_NE(nullptr, frame);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, frame->code);
+  EXPECT_STREQ("inner", frame->message);
+  EXPECT_STREQ("inner.c", frame->file);
+  EXPECT_EQ(2u, frame->line_number);
+  EXPECT_EQ(nullptr, rcutils_get_error_frame(2));
+  EXPECT_STREQ(
+    "outer: inner: error, at error.c:1, at inner.c:2, at outer.c:3",
+    rcutils_get_error_string().str);
+  // The error state only holds the error.
+  EXPECT_STREQ("error", rcutils_get_error_state()->message);
+
+  // The text is the same as when appending the previous error for each frame.
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_get_error_frame_count());
+  rcutils_set_error_state("error", "error.c", 1);
+  rcutils_error_string_t error_string = rcutils_get_error_string();
+  rcutils_reset_error();
+  rcutils_set_error_state((std::string("inner: ") + error_string.str).c_str(), "inner.c", 2);
+  error_string = rcutils_get_error_string();
+  rcutils_reset_error();
+  rcutils_set_error_state((std::string("outer: ") + error_string.str).c_str(), "outer.c", 3);
+  EXPECT_STREQ(
+    "outer: inner: error, at error.c:1, at inner.c:2, at outer.c:3",
+    rcutils_get_error_string().str);
+  rcutils_reset_error();
+
+  // Frames beyond the maximum are ignored, and setting the error removes them.
+  RCUTILS_SET_ERROR_MSG("error");
+  for (size_t i = 0; i < RCUTILS_ERROR_FRAMES_MAX_COUNT + 2; ++i) {
+    RCUTILS_PUSH_ERROR_FRAME(RCUTILS_RET_ERROR, "frame");
+  }
+  EXPECT_EQ(static_cast<size_t>(RCUTILS_ERROR_FRAMES_MAX_COUNT), rcutils_get_error_frame_count());
+  EXPECT_EQ(
+    RCUTILS_ERROR_FRAMES_MAX_COUNT,
+    count_substrings(rcutils_get_error_string().str, "frame: "));
+  printf("The following warning from error_handling.c is expected...\n");
+  RCUTILS_SET_ERROR_MSG("another error");
+  EXPECT_EQ(0u, rcutils_get_error_frame_count());
+  rcutils_reset_error();
+}
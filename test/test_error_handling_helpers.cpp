@@ -160,6 +160,17 @@ TEST(test_error_handling, format_error_string) {
 
   EXPECT_NO_MEMORY_OPERATIONS(
   {
-    __rcutils_format_error_string(&error_string, &error_state);
+    __rcutils_format_error_string_from_parts(
+      &error_string, error_state.message, error_state.file, error_state.line_number);
   });
+  EXPECT_STREQ("test error message, at /path/to/source:42", error_string.str);
+
+  // The message and the file are truncated as if they were copied into an error state.
+  std::string message(RCUTILS_ERROR_STATE_MESSAGE_MAX_LENGTH + 10, 'm');
+  std::string file(RCUTILS_ERROR_STATE_FILE_MAX_LENGTH + 10, 'f');
+  __rcutils_format_error_string_from_parts(&error_string, message.c_str(), file.c_str(), 42);
+  EXPECT_EQ(
+    message.substr(0, RCUTILS_ERROR_STATE_MESSAGE_MAX_LENGTH - 1) + ", at " +
+    file.substr(0, RCUTILS_ERROR_STATE_FILE_MAX_LENGTH - 1) + ":42",
+    error_string.str);
 }
@@ -13,8 +13,17 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
 #include <set>
 #include <string>
+#include <thread>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 #include "rcutils/env.h"
 #include "rcutils/error_handling.h"
@@ -22,6 +31,7 @@
 
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 
+#include "./allocator_testing_utils.h"
 #include "./mocking_utils/filesystem.hpp"
 
 static rcutils_allocator_t g_allocator = rcutils_get_default_allocator();
@@ -104,6 +114,116 @@ TEST_F(TestFilesystemFixture, to_native_path) {
   }
 }
 
+TEST_F(TestFilesystemFixture, path_builder) {
+#ifdef _WIN32
+  const std::string separator = "\\";
+#else
+  const std::string separator = "/";
+#endif  // _WIN32
+  rcutils_allocator_t allocator = get_counting_allocator();
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_init(nullptr, "foo", &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_init(&builder, nullptr, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_init(&builder, "foo", nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_path_builder_push(&builder, "bar"));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_path_builder_pop(&builder));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_path_builder_init(&builder, "foo", &failing_allocator));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_init(&builder, "foo", &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+  });
+  EXPECT_STREQ("foo", builder.path);
+  EXPECT_EQ(3u, builder.length);
+
+  // The same paths as with rcutils_join_path() and rcutils_to_native_path()
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "bar"));
+  char * joined_path = rcutils_join_path("foo", "bar", g_allocator);
+  ASSERT_NE(nullptr, joined_path);
+  EXPECT_STREQ(joined_path, builder.path);
+  g_allocator.deallocate(joined_path, g_allocator.state);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "baz/qux"));
+  EXPECT_EQ("foo" + separator + "bar" + separator + "baz" + separator + "qux", builder.path);
+  EXPECT_EQ(strlen(builder.path), builder.length);
+  EXPECT_EQ(2u, builder.depth);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("foo" + separator + "bar", builder.path);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_pop(&builder));
+  EXPECT_STREQ("foo", builder.path);
+  EXPECT_EQ(3u, builder.length);
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_path_builder_pop(&builder));
+  rcutils_reset_error();
+  EXPECT_STREQ("foo", builder.path);
+
+  // Deep and long paths grow the buffers, which are reused afterwards without allocating.
+  std::string expected = "foo";
+  for (size_t i = 0; i < 100; ++i) {
+    std::string component = "component_" + std::to_string(i);
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, component.c_str()));
+    expected += separator + component;
+  }
+  EXPECT_EQ(expected, builder.path);
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_pop(&builder));
+  }
+  EXPECT_STREQ("foo", builder.path);
+  reset_counting_allocator_allocations(allocator);
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "entry"));
+  }
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_pop(&builder));
+  }
+  EXPECT_EQ(0u, get_counting_allocator_allocations(allocator));
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_push(&builder, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_push(nullptr, "bar"));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_pop(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(TestFilesystemFixture, path_builder_separators) {
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  // No separator is added to an empty path, nor to a path ending with one.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_init(&builder, "", &g_allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "foo"));
+  EXPECT_STREQ("foo", builder.path);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+  EXPECT_EQ(nullptr, builder.path);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_init(&builder, "/", &g_allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "foo"));
+#ifdef _WIN32
+  EXPECT_STREQ("\\foo", builder.path);
+#else
+  EXPECT_STREQ("/foo", builder.path);
+#endif  // _WIN32
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_pop(&builder));
+#ifdef _WIN32
+  EXPECT_STREQ("\\", builder.path);
+#else
+  EXPECT_STREQ("/", builder.path);
+#endif  // _WIN32
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+}
+
 TEST_F(TestFilesystemFixture, exists) {
   {
     char * path = rcutils_join_path(this->test_path, "dummy_readable_file.txt", g_allocator);
@@ -168,6 +288,98 @@ TEST_F(TestFilesystemFixture, is_file) {
   }
 }
 
+TEST_F(TestFilesystemFixture, stat_cache) {
+  char * path = rcutils_join_path(BUILD_DIR, "stat_cache_test_file", g_allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    remove(path);
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+  remove(path);
+  auto create_file = [path]() {
+      FILE * file = fopen(path, "wb");
+      ASSERT_NE(nullptr, file);
+      fclose(file);
+    };
+
+  rcutils_stat_cache_t stat_cache = rcutils_get_zero_initialized_stat_cache();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stat_cache_init(nullptr, nullptr, &g_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stat_cache_init(&stat_cache, nullptr, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_stat_cache_clear(&stat_cache));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stat_cache_clear(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stat_cache_fini(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_fini(&stat_cache));
+  // A zero initialized stat cache checks the paths without caching them.
+  EXPECT_TRUE(rcutils_stat_cache_is_directory(&stat_cache, BUILD_DIR));
+  EXPECT_FALSE(rcutils_stat_cache_exists(nullptr, path));
+
+  // Without watching changes, the metadata is cached until the stat cache is cleared.
+  rcutils_stat_cache_options_t options = rcutils_stat_cache_get_default_options();
+  options.ttl = RCUTILS_S_TO_NS(3600);
+  options.watch_changes = false;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_init(&stat_cache, &options, &g_allocator));
+  EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, path));
+  create_file();
+  EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, path));
+  EXPECT_FALSE(rcutils_stat_cache_is_file(&stat_cache, path));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_clear(&stat_cache));
+  EXPECT_TRUE(rcutils_stat_cache_exists(&stat_cache, path));
+  EXPECT_TRUE(rcutils_stat_cache_is_file(&stat_cache, path));
+  EXPECT_FALSE(rcutils_stat_cache_is_directory(&stat_cache, path));
+  EXPECT_TRUE(rcutils_stat_cache_is_directory(&stat_cache, BUILD_DIR));
+  EXPECT_FALSE(rcutils_stat_cache_is_file(&stat_cache, BUILD_DIR));
+  EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, nullptr));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_fini(&stat_cache));
+
+  // Or until it expires.
+  options.ttl = RCUTILS_MS_TO_NS(10);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_init(&stat_cache, &options, &g_allocator));
+  EXPECT_TRUE(rcutils_stat_cache_exists(&stat_cache, path));
+  ASSERT_EQ(0, remove(path));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, path));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_fini(&stat_cache));
+
+#ifdef __linux__
+  // Changes to the parent directory are seen shortly after they happen.
+  auto eventually = [](std::function<bool()> condition) {
+      for (int i = 0; i < 1000 && !condition(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return condition();
+    };
+  options.ttl = 0;
+  options.watch_changes = true;
+  options.max_entries = 4;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_init(&stat_cache, &options, &g_allocator));
+  EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, path));
+  create_file();
+  EXPECT_TRUE(eventually([&]() {return rcutils_stat_cache_exists(&stat_cache, path);}));
+  EXPECT_TRUE(rcutils_stat_cache_is_file(&stat_cache, path));
+  ASSERT_EQ(0, remove(path));
+  EXPECT_TRUE(eventually([&]() {return !rcutils_stat_cache_exists(&stat_cache, path);}));
+
+  // More paths than the stat cache holds
+  for (int i = 0; i < 3; ++i) {
+    for (const char * other_path : {"/", "/tmp", "/proc/self", "/proc/self/status", "/dev/null"}) {
+      EXPECT_TRUE(rcutils_stat_cache_exists(&stat_cache, other_path)) << other_path;
+    }
+    EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, path));
+    EXPECT_TRUE(rcutils_stat_cache_is_directory(&stat_cache, BUILD_DIR));
+  }
+  EXPECT_FALSE(rcutils_stat_cache_is_file(&stat_cache, "/dev/null"));
+  EXPECT_FALSE(rcutils_stat_cache_is_directory(&stat_cache, "/dev/null"));
+  EXPECT_FALSE(rcutils_stat_cache_exists(&stat_cache, "non_existing_relative_path"));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stat_cache_fini(&stat_cache));
+#endif
+}
+
 TEST_F(TestFilesystemFixture, is_readable) {
   {
     char * path = rcutils_join_path(this->test_path, "dummy_readable_file.txt", g_allocator);
@@ -520,6 +732,92 @@ TEST_F(TestFilesystemFixture, calculate_directory_size_with_recursion) {
   }
 }
 
+TEST_F(TestFilesystemFixture, calculate_directory_size_parallel) {
+  char * path =
+    rcutils_join_path(this->test_path, "dummy_folder_with_subdir", g_allocator);
+  ASSERT_NE(nullptr, path);
+  for (size_t thread_count : {0u, 1u, 2u, 8u}) {
+    uint64_t size = 0;
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_calculate_directory_size_parallel(path, 2, thread_count, &size, g_allocator));
+#ifdef WIN32
+    EXPECT_EQ(12u, size);
+#else
+    EXPECT_EQ(10u, size);
+#endif
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_calculate_directory_size_parallel(path, 0, thread_count, &size, g_allocator));
+#ifdef WIN32
+    EXPECT_EQ(18u, size);
+#else
+    EXPECT_EQ(15u, size);
+#endif
+  }
+  g_allocator.deallocate(path, g_allocator.state);
+
+  // A wider tree, whose subdirectories are iterated by several threads
+  path = rcutils_join_path(BUILD_DIR, "directory_size_test_dir", g_allocator);
+  ASSERT_NE(nullptr, path);
+  ASSERT_TRUE(rcutils_mkdir(path));
+  uint64_t expected_size = 0;
+  uint64_t expected_size_depth_2 = 0;
+  for (int i = 0; i < 8; ++i) {
+    std::string subdir = std::string(path) + "/subdir" + std::to_string(i);
+    ASSERT_TRUE(rcutils_mkdir(subdir.c_str()));
+    for (int j = 0; j < 4; ++j) {
+      std::string subsubdir = subdir + "/subdir" + std::to_string(j);
+      ASSERT_TRUE(rcutils_mkdir(subsubdir.c_str()));
+      for (int k = 0; k < 3; ++k) {
+        for (const std::string & dir : {subdir, subsubdir}) {
+          std::string file_path = dir + "/file" + std::to_string(j * 3 + k);
+          FILE * file = fopen(file_path.c_str(), "wb");
+          ASSERT_NE(nullptr, file);
+          std::string contents(static_cast<size_t>(i * 100 + j * 10 + k), 'x');
+          ASSERT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+          fclose(file);
+        }
+        expected_size += 2u * static_cast<uint64_t>(i * 100 + j * 10 + k);
+        expected_size_depth_2 += static_cast<uint64_t>(i * 100 + j * 10 + k);
+      }
+    }
+  }
+#ifndef _WIN32
+  // Symbolic links are not followed.
+  std::string link_path = std::string(path) + "/subdir0/link";
+  unlink(link_path.c_str());
+  ASSERT_EQ(0, symlink(path, link_path.c_str()));
+#endif
+  for (size_t thread_count : {0u, 1u, 3u, 16u}) {
+    uint64_t size = 0;
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_calculate_directory_size_parallel(path, 0, thread_count, &size, g_allocator));
+    EXPECT_EQ(expected_size, size) << thread_count << " threads";
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_calculate_directory_size_parallel(path, 2, thread_count, &size, g_allocator));
+    EXPECT_EQ(expected_size_depth_2, size) << thread_count << " threads";
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_calculate_directory_size_parallel(path, 1, thread_count, &size, g_allocator));
+    EXPECT_EQ(0u, size) << thread_count << " threads";
+  }
+  uint64_t size = 0;
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_calculate_directory_size_with_recursion(path, 0, &size, g_allocator));
+  EXPECT_EQ(expected_size, size);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_calculate_directory_size_parallel(path, 0, 2, nullptr, g_allocator));
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_calculate_directory_size_parallel(nullptr, 0, 2, &size, g_allocator));
+  g_allocator.deallocate(path, g_allocator.state);
+}
+
 TEST_F(TestFilesystemFixture, calculate_file_size) {
   char * path =
     rcutils_join_path(this->test_path, "dummy_readable_file.txt", g_allocator);
@@ -546,6 +844,156 @@ TEST_F(TestFilesystemFixture, calculate_file_size) {
   });
 }
 
+TEST_F(TestFilesystemFixture, mmap_file) {
+  char * path = rcutils_join_path(BUILD_DIR, "mmap_test_file", g_allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+  std::string contents;
+  for (size_t i = 0; i < 100000; ++i) {
+    contents += static_cast<char>('a' + i % 26);
+  }
+  FILE * file = fopen(path, "wb");
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+  fclose(file);
+
+  for (rcutils_mmap_access_t access :
+    {RCUTILS_MMAP_ACCESS_NORMAL, RCUTILS_MMAP_ACCESS_SEQUENTIAL, RCUTILS_MMAP_ACCESS_RANDOM})
+  {
+    rcutils_mapped_file_t mapped_file = rcutils_get_zero_initialized_mapped_file();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_mmap_file(path, access, &mapped_file));
+    ASSERT_NE(nullptr, mapped_file.data);
+    EXPECT_EQ(rcutils_get_file_size(path), mapped_file.size);
+    EXPECT_EQ(
+      contents,
+      std::string(reinterpret_cast<const char *>(mapped_file.data), mapped_file.size));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_munmap_file(&mapped_file));
+    EXPECT_EQ(nullptr, mapped_file.data);
+    EXPECT_EQ(0u, mapped_file.size);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_munmap_file(&mapped_file));
+  }
+
+  // Empty files are not mapped.
+  file = fopen(path, "wb");
+  ASSERT_NE(nullptr, file);
+  fclose(file);
+  rcutils_mapped_file_t mapped_file = rcutils_get_zero_initialized_mapped_file();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_mmap_file(path, RCUTILS_MMAP_ACCESS_NORMAL, &mapped_file));
+  EXPECT_EQ(nullptr, mapped_file.data);
+  EXPECT_EQ(0u, mapped_file.size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_munmap_file(&mapped_file));
+
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR, rcutils_mmap_file(BUILD_DIR, RCUTILS_MMAP_ACCESS_NORMAL, &mapped_file));
+  rcutils_reset_error();
+  char * non_existing_path =
+    rcutils_join_path(this->test_path, "non_existing_file.txt", g_allocator);
+  ASSERT_NE(nullptr, non_existing_path);
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_mmap_file(non_existing_path, RCUTILS_MMAP_ACCESS_NORMAL, &mapped_file));
+  rcutils_reset_error();
+  g_allocator.deallocate(non_existing_path, g_allocator.state);
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mmap_file(nullptr, RCUTILS_MMAP_ACCESS_NORMAL, &mapped_file));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_mmap_file(path, RCUTILS_MMAP_ACCESS_NORMAL, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_munmap_file(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(TestFilesystemFixture, read_file) {
+  char * path = rcutils_join_path(BUILD_DIR, "read_test_file", g_allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+  std::string contents;
+  for (size_t i = 0; i < 3000000; ++i) {
+    contents += static_cast<char>('a' + i % 26);
+  }
+  FILE * file = fopen(path, "wb");
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+  fclose(file);
+
+  // The buffer is allocated once, to the size of the file, and reused afterwards.
+  rcutils_allocator_t allocator = get_counting_allocator();
+  rcutils_uint8_array_t uint8_array = rcutils_get_zero_initialized_uint8_array();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_init(&uint8_array, 0, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&uint8_array));
+  });
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_read_file(path, false, &uint8_array));
+  EXPECT_EQ(1u, get_counting_allocator_allocations(allocator));
+  uint8_t * buffer = uint8_array.buffer;
+  for (bool direct_io : {false, true}) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_read_file(path, direct_io, &uint8_array));
+    EXPECT_EQ(buffer, uint8_array.buffer);
+    EXPECT_EQ(contents.size(), uint8_array.buffer_length);
+    EXPECT_EQ(contents.size(), uint8_array.buffer_capacity);
+    EXPECT_EQ(
+      contents,
+      std::string(reinterpret_cast<const char *>(uint8_array.buffer), uint8_array.buffer_length));
+  }
+
+  rcutils_char_array_t char_array = rcutils_get_zero_initialized_char_array();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&char_array, 0, &g_allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+  });
+  for (bool direct_io : {false, true}) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_read_file_to_char_array(path, direct_io, &char_array));
+    EXPECT_EQ(contents.size() + 1, char_array.buffer_length);
+    EXPECT_EQ(contents, char_array.buffer);
+  }
+
+#ifdef __linux__
+  // Files whose size isn't known in advance are read too.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_read_file_to_char_array("/proc/self/status", false, &char_array));
+  EXPECT_LT(1u, char_array.buffer_length);
+  EXPECT_EQ(char_array.buffer_length - 1, strlen(char_array.buffer));
+  EXPECT_NE(nullptr, strstr(char_array.buffer, "Name:"));
+#endif
+
+  file = fopen(path, "wb");
+  ASSERT_NE(nullptr, file);
+  fclose(file);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_read_file(path, false, &uint8_array));
+  EXPECT_EQ(0u, uint8_array.buffer_length);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_read_file_to_char_array(path, false, &char_array));
+  EXPECT_EQ(1u, char_array.buffer_length);
+  EXPECT_STREQ("", char_array.buffer);
+
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_read_file(BUILD_DIR, false, &uint8_array));
+  rcutils_reset_error();
+  char * non_existing_path =
+    rcutils_join_path(this->test_path, "non_existing_file.txt", g_allocator);
+  ASSERT_NE(nullptr, non_existing_path);
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_read_file(non_existing_path, false, &uint8_array));
+  rcutils_reset_error();
+  g_allocator.deallocate(non_existing_path, g_allocator.state);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_read_file(nullptr, false, &uint8_array));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_read_file(path, false, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_read_file_to_char_array(nullptr, false, &char_array));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_read_file_to_char_array(path, false, nullptr));
+  rcutils_reset_error();
+}
+
 TEST_F(TestFilesystemFixture, directory_iterator) {
   char * path =
     rcutils_join_path(this->test_path, "dummy_folder", g_allocator);
@@ -601,3 +1049,89 @@ TEST_F(TestFilesystemFixture, directory_iterator_on_file) {
   EXPECT_EQ(nullptr, rcutils_dir_iter_start(path, g_allocator));
   rcutils_reset_error();
 }
+
+TEST_F(TestFilesystemFixture, directory_batch_iterator) {
+  char * path = rcutils_join_path(BUILD_DIR, "dir_batch_test_dir", g_allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+  ASSERT_TRUE(rcutils_mkdir(path));
+
+  // More entries than are read by a single system call
+  std::map<std::string, rcutils_dir_entry_type_t> expected_types;
+  std::map<std::string, uint64_t> expected_sizes;
+  for (size_t i = 0; i < 2000; ++i) {
+    std::string name = "file_with_a_long_name_" + std::to_string(i);
+    FILE * file = fopen((std::string(path) + "/" + name).c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    std::string contents(i % 100, 'x');
+    ASSERT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+    fclose(file);
+    expected_types[name] = RCUTILS_DIR_ENTRY_TYPE_FILE;
+    expected_sizes[name] = i % 100;
+  }
+  ASSERT_TRUE(rcutils_mkdir((std::string(path) + "/subdir").c_str()));
+  expected_types["subdir"] = RCUTILS_DIR_ENTRY_TYPE_DIRECTORY;
+  expected_sizes["subdir"] = 0u;
+#ifndef _WIN32
+  std::string link_path = std::string(path) + "/link";
+  unlink(link_path.c_str());
+  ASSERT_EQ(0, symlink(path, link_path.c_str()));
+  expected_types["link"] = RCUTILS_DIR_ENTRY_TYPE_SYMLINK;
+  expected_sizes["link"] = 0u;
+#endif
+
+  for (bool with_size : {false, true}) {
+    rcutils_dir_batch_iter_t * iter = rcutils_dir_batch_iter_start(path, with_size, g_allocator);
+    ASSERT_NE(nullptr, iter);
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcutils_dir_batch_iter_end(iter);
+    });
+    std::map<std::string, rcutils_dir_entry_type_t> types;
+    std::map<std::string, uint64_t> sizes;
+    rcutils_dir_entry_t entries[7];
+    size_t count = 0;
+    do {
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_dir_batch_iter_next(iter, entries, 7, &count));
+      ASSERT_LE(count, 7u);
+      for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(0u, types.count(entries[i].name)) << entries[i].name;
+        types[entries[i].name] = entries[i].type;
+        sizes[entries[i].name] = entries[i].size;
+      }
+    } while (count > 0);
+    EXPECT_EQ(expected_types, types);
+    if (with_size) {
+      EXPECT_EQ(expected_sizes, sizes);
+    } else {
+      for (const auto & size : sizes) {
+        EXPECT_EQ(0u, size.second) << size.first;
+      }
+    }
+
+    // The end of the directory is reported again.
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_dir_batch_iter_next(iter, entries, 7, &count));
+    EXPECT_EQ(0u, count);
+    EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_dir_batch_iter_next(iter, entries, 0, &count));
+    rcutils_reset_error();
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT, rcutils_dir_batch_iter_next(iter, nullptr, 7, &count));
+    rcutils_reset_error();
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT, rcutils_dir_batch_iter_next(iter, entries, 7, nullptr));
+    rcutils_reset_error();
+  }
+
+  char * non_existing_path =
+    rcutils_join_path(this->test_path, "non_existing_folder", g_allocator);
+  ASSERT_NE(nullptr, non_existing_path);
+  EXPECT_EQ(nullptr, rcutils_dir_batch_iter_start(non_existing_path, false, g_allocator));
+  rcutils_reset_error();
+  g_allocator.deallocate(non_existing_path, g_allocator.state);
+  EXPECT_EQ(nullptr, rcutils_dir_batch_iter_start(nullptr, false, g_allocator));
+  rcutils_reset_error();
+  rcutils_dir_batch_iter_end(nullptr);
+}
@@ -14,6 +14,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include "gtest/gtest.h"
 
 #include "rcutils/find.h"
@@ -153,3 +155,53 @@ TEST(test_find, find_lastn) {
     "hello/world///", '/', strlen("hello/world/"), strlen("hello/world/") - 1);
   LOG((size_t)strlen("hello/world/") - 1, ret5);
 }
+
+TEST(test_find, find_any) {
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any(NULL, "/:"));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("hello/world", NULL));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("hello/world", ""));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("", "/:"));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("hello_world", "/:"));
+  EXPECT_EQ(5u, rcutils_find_any("hello/world:=x", "/:"));
+  EXPECT_EQ(5u, rcutils_find_any("hello:=world/x", "/:"));
+  EXPECT_EQ(0u, rcutils_find_any("/hello", "/:"));
+
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn(NULL, "/:", 10));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn("hello/world", NULL, 11));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn("hello/world", "", 11));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn("hello/world", "/:", 0));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn("hello/world", "/:", 5));
+  EXPECT_EQ(5u, rcutils_find_anyn("hello/world", "/:", 6));
+  EXPECT_EQ(5u, rcutils_find_anyn("hello:world", ":", 11));
+  EXPECT_EQ(4u, rcutils_find_anyn("a/b;\xff", ":\xff", 5));
+  // the string may hold null characters
+  EXPECT_EQ(3u, rcutils_find_anyn("ab\0:", "/:", 4));
+}
+
+TEST(test_find, long_strings) {
+  // the delimiter at every position of strings of many lengths, around the word boundaries
+  for (size_t length = 1; length < 40; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      std::string str(length, 'a');
+      str[position] = '/';
+      EXPECT_EQ(position, rcutils_find(str.c_str(), '/'));
+      EXPECT_EQ(position, rcutils_findn(str.c_str(), '/', length));
+      EXPECT_EQ(position, rcutils_find_last(str.c_str(), '/'));
+      EXPECT_EQ(position, rcutils_find_lastn(str.c_str(), '/', length));
+      EXPECT_EQ(position, rcutils_find_any(str.c_str(), ":/"));
+      EXPECT_EQ(position, rcutils_find_anyn(str.c_str(), ":/", length));
+      // only the given length is searched
+      EXPECT_EQ(SIZE_MAX, rcutils_findn(str.c_str(), '/', position));
+      EXPECT_EQ(
+        SIZE_MAX, rcutils_find_lastn(str.c_str() + position + 1, '/', length - position - 1));
+    }
+    std::string str(length, '/');
+    EXPECT_EQ(0u, rcutils_find(str.c_str(), '/'));
+    EXPECT_EQ(length - 1, rcutils_find_last(str.c_str(), '/'));
+    EXPECT_EQ(length - 1, rcutils_find_lastn(str.c_str(), '/', length));
+  }
+
+  // the terminating null character is not a part of the string
+  EXPECT_EQ(SIZE_MAX, rcutils_find("hello", '\0'));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_last("hello", '\0'));
+}
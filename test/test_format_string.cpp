@@ -61,3 +61,95 @@ TEST(test_format_string_limit, invalid_arguments) {
   formatted = rcutils_format_string_limit(failing_allocator, 10, "%s", "test");
   EXPECT_STREQ(NULL, formatted);
 }
+
+TEST(test_format_string_limit, long_string) {
+  auto allocator = rcutils_get_default_allocator();
+  std::string expected(1000, 'x');
+  char * formatted = rcutils_format_string_limit(allocator, 2048, "%s!", expected.c_str());
+  expected += "!";
+  EXPECT_STREQ(expected.c_str(), formatted);
+  allocator.deallocate(formatted, allocator.state);
+
+  formatted = rcutils_format_string_limit(allocator, 500, "%s", expected.c_str());
+  EXPECT_EQ(expected.substr(0, 499), formatted);
+  allocator.deallocate(formatted, allocator.state);
+
+  EXPECT_EQ(nullptr, rcutils_format_string_limit(allocator, 0, "%s", "test"));
+}
+
+TEST(test_format_string_buffer, fits_buffer) {
+  auto failing_allocator = get_failing_allocator();
+  char buffer[16];
+  size_t length = 0;
+  char * formatted = rcutils_format_string_buffer(
+    buffer, sizeof(buffer), failing_allocator, 2048, &length, "%s %d", "test", 42);
+  EXPECT_EQ(buffer, formatted);
+  EXPECT_STREQ("test 42", formatted);
+  EXPECT_EQ(7u, length);
+
+  // fifteen characters and the null terminator fill the buffer
+  formatted = rcutils_format_string_buffer(
+    buffer, sizeof(buffer), failing_allocator, 2048, &length, "%s", "0123456789abcde");
+  EXPECT_EQ(buffer, formatted);
+  EXPECT_STREQ("0123456789abcde", formatted);
+  EXPECT_EQ(15u, length);
+
+  // truncated to the limit
+  formatted = rcutils_format_string_buffer(
+    buffer, sizeof(buffer), failing_allocator, 3, &length, "%s", "0123456789abcdefgh");
+  EXPECT_EQ(buffer, formatted);
+  EXPECT_STREQ("01", formatted);
+  EXPECT_EQ(2u, length);
+
+  formatted = rcutils_format_string_buffer(
+    buffer, sizeof(buffer), failing_allocator, 2048, nullptr, "%s", "");
+  EXPECT_EQ(buffer, formatted);
+  EXPECT_STREQ("", formatted);
+}
+
+TEST(test_format_string_buffer, allocates) {
+  auto allocator = rcutils_get_default_allocator();
+  auto failing_allocator = get_failing_allocator();
+  char buffer[16];
+  size_t length = 0;
+  char * formatted = rcutils_format_string_buffer(
+    buffer, sizeof(buffer), allocator, 2048, &length, "%s", "0123456789abcdef");
+  ASSERT_NE(nullptr, formatted);
+  EXPECT_NE(buffer, formatted);
+  EXPECT_STREQ("0123456789abcdef", formatted);
+  EXPECT_EQ(16u, length);
+  allocator.deallocate(formatted, allocator.state);
+
+  formatted = rcutils_format_string_buffer(
+    buffer, sizeof(buffer), allocator, 20, &length, "%s", "0123456789abcdefghijklmn");
+  ASSERT_NE(nullptr, formatted);
+  EXPECT_NE(buffer, formatted);
+  EXPECT_STREQ("0123456789abcdefghi", formatted);
+  EXPECT_EQ(19u, length);
+  allocator.deallocate(formatted, allocator.state);
+
+  // without a buffer, the output is always allocated
+  formatted = rcutils_format_string_buffer(nullptr, 0, allocator, 2048, &length, "%d", 7);
+  ASSERT_NE(nullptr, formatted);
+  EXPECT_STREQ("7", formatted);
+  EXPECT_EQ(1u, length);
+  allocator.deallocate(formatted, allocator.state);
+
+  length = 42;
+  EXPECT_EQ(
+    nullptr, rcutils_format_string_buffer(
+      buffer, sizeof(buffer), failing_allocator, 2048, &length, "%s", "0123456789abcdef"));
+  EXPECT_EQ(42u, length);
+}
+
+TEST(test_format_string_buffer, invalid_arguments) {
+  auto allocator = rcutils_get_default_allocator();
+  char buffer[16];
+  EXPECT_EQ(
+    nullptr, rcutils_format_string_buffer(buffer, sizeof(buffer), allocator, 2048, nullptr, NULL));
+  EXPECT_EQ(
+    nullptr, rcutils_format_string_buffer(nullptr, 16, allocator, 2048, nullptr, "%s", "test"));
+  EXPECT_EQ(
+    nullptr, rcutils_format_string_buffer(
+      buffer, sizeof(buffer), allocator, 0, nullptr, "%s", "test"));
+}
@@ -14,8 +14,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
 #include <string>
+#include <tuple>
+#include <vector>
 
+#include "./allocator_testing_utils.h"
 #include "./time_bomb_allocator_testing_utils.h"
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
@@ -455,6 +462,35 @@ TEST_F(HashMapPreInitTest, get_next_key_and_data_working) {
 /* Use BaseTest as the fixture here so we can control the initial capacity independent of the
  * other tests
  */
+TEST_F(HashMapPreInitTest, iterator_invalid_arguments) {
+  rcutils_hash_map_iterator_t iterator;
+  uint32_t key = 0, data = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_iterator_begin(nullptr, &iterator, &key, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_iterator_begin(&map, nullptr, &key, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_iterator_begin(&map, &iterator, nullptr, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_iterator_next(&map, &iterator, &key, nullptr));
+  rcutils_reset_error();
+  rcutils_hash_map_t uninitialized_map = rcutils_get_zero_initialized_hash_map();
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED,
+    rcutils_hash_map_iterator_next(&uninitialized_map, &iterator, &key, &data));
+  rcutils_reset_error();
+
+  EXPECT_EQ(
+    RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES,
+    rcutils_hash_map_iterator_begin(&map, &iterator, &key, &data));
+  EXPECT_EQ(
+    RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES,
+    rcutils_hash_map_iterator_next(&map, &iterator, &key, &data));
+}
+
 TEST_F(HashMapBaseTest, growing_the_map_beyond_initial_capacity) {
   size_t capacity = 0;
   uint32_t key = 22, data = 0;
@@ -512,3 +548,630 @@ TEST_F(HashMapBaseTest, string_keys) {
   ret = rcutils_hash_map_fini(&map);
   EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
 }
+
+TEST_F(HashMapBaseTest, init_map_invalid_backend_fails) {
+  int invalid_backend = 3;
+  rcutils_ret_t ret = rcutils_hash_map_init_with_backend(
+    &map, 2, sizeof(uint32_t), sizeof(uint32_t),
+    test_hash_map_uint32_hash_func, test_uint32_cmp,
+    static_cast<rcutils_hash_map_backend_t>(invalid_backend), &allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+}
+
+TEST_F(HashMapBaseTest, open_addressing_failing_allocator) {
+  rcutils_allocator_t failing_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(failing_allocator, 1);
+  rcutils_ret_t ret = rcutils_hash_map_init_with_backend(
+    &map, 2, sizeof(uint32_t), sizeof(uint32_t),
+    test_hash_map_uint32_hash_func, test_uint32_cmp,
+    RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING, &failing_allocator);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret);
+  EXPECT_EQ(nullptr, map.impl);
+  rcutils_reset_error();
+}
+
+TEST_F(HashMapBaseTest, entry_takes_one_allocation) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_ret_t ret = rcutils_hash_map_init(
+    &map, 64, sizeof(uint32_t), sizeof(uint32_t),
+    test_hash_map_uint32_hash_func, test_uint32_cmp, &counting_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  // The bucket of the key is initialized by the first set, and kept after the key is unset
+  uint32_t key = 3, data = 5;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &data));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &key));
+  reset_counting_allocator_allocations(counting_allocator);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &data));
+  EXPECT_EQ(1u, get_counting_allocator_allocations(counting_allocator));
+
+  data = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get(&map, &key, &data));
+  EXPECT_EQ(5u, data);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&map));
+}
+
+TEST_F(HashMapBaseTest, open_addressing_capacity) {
+  size_t capacity = 0;
+  rcutils_ret_t ret = rcutils_hash_map_init_with_backend(
+    &map, 2, sizeof(uint32_t), sizeof(uint32_t),
+    test_hash_map_uint32_hash_func, test_uint32_cmp,
+    RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(8u, capacity);
+  for (uint32_t i = 0; i < 7; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &i, &i));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(8u, capacity);
+  uint32_t key = 7;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &key));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(16u, capacity);
+
+  // Unsetting and setting keys over and over reuses the deleted slots instead of growing.
+  for (uint32_t i = 100; i < 1000; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &i, &i));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &i));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(16u, capacity);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&map));
+}
+
+TEST_F(HashMapBaseTest, incremental_growth) {
+  size_t capacity = 0;
+  rcutils_ret_t ret = rcutils_hash_map_init_with_backend(
+    &map, 64, sizeof(uint32_t), sizeof(uint32_t),
+    test_hash_map_uint32_hash_func, test_uint32_cmp,
+    RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  for (uint32_t i = 0; i < 48; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &i, &i));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(128u, capacity);
+
+  // Until the 64 old buckets are moved, the entries are found in both the new and old buckets.
+  for (uint32_t i = 48; i < 56; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &i, &i));
+    uint32_t removed = i - 48;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &removed));
+    EXPECT_FALSE(rcutils_hash_map_key_exists(&map, &removed));
+
+    std::set<uint32_t> keys;
+    uint32_t key = 0, data = 0;
+    ret = rcutils_hash_map_get_next_key_and_data(&map, nullptr, &key, &data);
+    while (RCUTILS_RET_OK == ret) {
+      EXPECT_EQ(key, data);
+      EXPECT_TRUE(keys.insert(key).second) << key;
+      ret = rcutils_hash_map_get_next_key_and_data(&map, &key, &key, &data);
+    }
+    EXPECT_EQ(RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES, ret);
+    EXPECT_EQ(48u, keys.size());
+    for (uint32_t k = removed + 1; k <= i; ++k) {
+      EXPECT_EQ(1u, keys.count(k)) << k;
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get(&map, &k, &data)) << k;
+      EXPECT_EQ(k, data);
+    }
+  }
+
+  // Finalizing frees the entries left in the old buckets.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&map));
+}
+
+TEST_F(HashMapPreInitTest, reserve_and_set_many_invalid_arguments) {
+  uint32_t keys[] = {1, 2};
+  uint32_t values[] = {3, 4};
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_reserve(nullptr, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_set_many(nullptr, keys, values, 2));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_set_many(&map, nullptr, values, 2));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_set_many(&map, keys, nullptr, 2));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_hash_map_reserve(&map, SIZE_MAX));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_hash_map_set_many(&map, keys, values, SIZE_MAX));
+  rcutils_reset_error();
+
+  rcutils_hash_map_t uninitialized_map = rcutils_get_zero_initialized_hash_map();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_hash_map_reserve(&uninitialized_map, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED, rcutils_hash_map_set_many(&uninitialized_map, keys, values, 2));
+  rcutils_reset_error();
+}
+
+size_t test_colliding_hash_func(const void * key)
+{
+  (void)key;
+  return 42;
+}
+
+int test_uint64_cmp(const void * val1, const void * val2)
+{
+  uint64_t value1 = *static_cast<const uint64_t *>(val1);
+  uint64_t value2 = *static_cast<const uint64_t *>(val2);
+  return value1 < value2 ? -1 : (value1 > value2 ? 1 : 0);
+}
+
+size_t test_uint64_hash_func(const void * key)
+{
+  return static_cast<size_t>(*static_cast<const uint64_t *>(key));
+}
+
+// Both backends, compared with a std::map through random operations.
+class HashMapBackendTest
+  : public ::testing::TestWithParam<std::tuple<rcutils_hash_map_backend_t, bool>>
+{
+protected:
+  void SetUp() override
+  {
+    allocator = rcutils_get_default_allocator();
+    map = rcutils_get_zero_initialized_hash_map();
+    rcutils_hash_map_key_hasher_t hash_func =
+      std::get<1>(GetParam()) ? test_colliding_hash_func : test_uint64_hash_func;
+    rcutils_ret_t ret = rcutils_hash_map_init_with_backend(
+      &map, 4, sizeof(uint64_t), sizeof(double), hash_func, test_uint64_cmp,
+      std::get<0>(GetParam()), &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&map)) << rcutils_get_error_string().str;
+  }
+
+  void expect_same_entries(const std::map<uint64_t, double> & expected)
+  {
+    size_t size = 0;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_size(&map, &size));
+    EXPECT_EQ(expected.size(), size);
+    std::map<uint64_t, double> entries;
+    std::vector<uint64_t> order;
+    uint64_t key = 0;
+    double data = 0.;
+    rcutils_ret_t ret = rcutils_hash_map_get_next_key_and_data(&map, nullptr, &key, &data);
+    while (RCUTILS_RET_OK == ret) {
+      EXPECT_TRUE(entries.emplace(key, data).second) << key;
+      order.push_back(key);
+      ret = rcutils_hash_map_get_next_key_and_data(&map, &key, &key, &data);
+    }
+    EXPECT_EQ(RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES, ret);
+    EXPECT_EQ(expected, entries);
+
+    // The iterator visits the same entries in the same order.
+    std::vector<uint64_t> iterator_order;
+    rcutils_hash_map_iterator_t iterator;
+    ret = rcutils_hash_map_iterator_begin(&map, &iterator, &key, &data);
+    while (RCUTILS_RET_OK == ret) {
+      EXPECT_EQ(expected.at(key), data) << key;
+      iterator_order.push_back(key);
+      ret = rcutils_hash_map_iterator_next(&map, &iterator, &key, &data);
+    }
+    EXPECT_EQ(RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES, ret);
+    EXPECT_EQ(order, iterator_order);
+    // and stays past the end
+    EXPECT_EQ(
+      RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES,
+      rcutils_hash_map_iterator_next(&map, &iterator, &key, &data));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_hash_map_t map;
+};
+
+TEST_P(HashMapBackendTest, random_operations) {
+  std::map<uint64_t, double> expected;
+  std::mt19937 random(42);
+  std::uniform_int_distribution<uint64_t> keys(0, 300);
+  const int operations = std::get<1>(GetParam()) ? 2000 : 20000;
+  for (int i = 0; i < operations; ++i) {
+    uint64_t key = keys(random);
+    double data = static_cast<double>(i);
+    switch (random() % 3) {
+      case 0:
+        ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &data));
+        expected[key] = data;
+        break;
+      case 1:
+        ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &key));
+        expected.erase(key);
+        break;
+      default:
+        {
+          auto it = expected.find(key);
+          EXPECT_EQ(it != expected.end(), rcutils_hash_map_key_exists(&map, &key)) << key;
+          rcutils_ret_t ret = rcutils_hash_map_get(&map, &key, &data);
+          if (it == expected.end()) {
+            EXPECT_EQ(RCUTILS_RET_NOT_FOUND, ret) << key;
+          } else {
+            EXPECT_EQ(RCUTILS_RET_OK, ret) << key;
+            EXPECT_EQ(it->second, data) << key;
+          }
+        }
+    }
+  }
+  expect_same_entries(expected);
+
+  for (auto & entry : expected) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &entry.first));
+  }
+  expected.clear();
+  expect_same_entries(expected);
+}
+
+TEST_P(HashMapBackendTest, reserve_and_set_many) {
+  size_t capacity = 0, reserved_capacity = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_reserve(&map, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_reserve(&map, 200));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &reserved_capacity));
+  EXPECT_LT(capacity, reserved_capacity);
+
+  // Reserving never shrinks the map, and the reserved entries fit without growing it.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_reserve(&map, 10));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(reserved_capacity, capacity);
+  std::map<uint64_t, double> expected;
+  std::vector<uint64_t> keys;
+  std::vector<double> values;
+  for (uint64_t i = 0; i < 150; ++i) {
+    keys.push_back(i * 7);
+    values.push_back(static_cast<double>(i));
+    expected[i * 7] = static_cast<double>(i);
+  }
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_hash_map_set_many(&map, keys.data(), values.data(), keys.size()));
+  expect_same_entries(expected);
+
+  // A repeated key keeps its last value, as with rcutils_hash_map_set().
+  keys = {7, 1000, 7, 14};
+  values = {1., 2., 3., 4.};
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_hash_map_set_many(&map, keys.data(), values.data(), keys.size()));
+  expected[7] = 3.;
+  expected[1000] = 2.;
+  expected[14] = 4.;
+  expect_same_entries(expected);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_EQ(reserved_capacity, capacity);
+
+  // Setting many more keys than reserved grows the map.
+  keys.clear();
+  values.clear();
+  for (uint64_t i = 0; i < 1000; ++i) {
+    keys.push_back(i + 2000);
+    values.push_back(static_cast<double>(i));
+    expected[i + 2000] = static_cast<double>(i);
+  }
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_hash_map_set_many(&map, keys.data(), values.data(), keys.size()));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_LT(reserved_capacity, capacity);
+  expect_same_entries(expected);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set_many(&map, keys.data(), values.data(), 0));
+}
+
+TEST_P(HashMapBackendTest, with_hash) {
+  rcutils_hash_map_key_hasher_t hash_func =
+    std::get<1>(GetParam()) ? test_colliding_hash_func : test_uint64_hash_func;
+  std::map<uint64_t, double> expected;
+  for (uint64_t key = 0; key < 100; ++key) {
+    double data = static_cast<double>(key);
+    size_t hash = hash_func(&key);
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set_with_hash(&map, &key, hash, &data));
+    expected[key] = data;
+  }
+  expect_same_entries(expected);
+
+  // The keys set with their hash are found without it and the other way around.
+  for (uint64_t key = 0; key < 120; ++key) {
+    size_t hash = hash_func(&key);
+    double data = 0.;
+    bool exists = key < 100;
+    EXPECT_EQ(exists, rcutils_hash_map_key_exists_with_hash(&map, &key, hash));
+    EXPECT_EQ(exists, rcutils_hash_map_key_exists(&map, &key));
+    EXPECT_EQ(
+      exists ? RCUTILS_RET_OK : RCUTILS_RET_NOT_FOUND,
+      rcutils_hash_map_get_with_hash(&map, &key, hash, &data));
+    if (exists) {
+      EXPECT_EQ(static_cast<double>(key), data);
+    }
+  }
+  for (uint64_t key = 0; key < 100; key += 2) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset_with_hash(&map, &key, hash_func(&key)));
+    expected.erase(key);
+  }
+  expect_same_entries(expected);
+
+  uint64_t key = 1;
+  double data = 0.;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_set_with_hash(nullptr, &key, 1, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_set_with_hash(&map, &key, 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_unset_with_hash(&map, nullptr, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_get_with_hash(&map, &key, 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_hash_map_key_exists_with_hash(nullptr, &key, 1));
+  EXPECT_FALSE(rcutils_hash_map_key_exists_with_hash(&map, nullptr, 1));
+}
+
+TEST_P(HashMapBackendTest, shrink_to_fit) {
+  size_t initial_size = 0, allocated_size = 0, capacity = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_allocated_size(&map, &initial_size));
+  EXPECT_LT(0u, initial_size);
+
+  // A burst of entries at startup grows the map, which keeps its capacity when they are unset.
+  std::map<uint64_t, double> expected;
+  for (uint64_t key = 0; key < 1000; ++key) {
+    double data = static_cast<double>(key);
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &data));
+    expected[key] = data;
+  }
+  size_t grown_size = 0, grown_capacity = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_allocated_size(&map, &grown_size));
+  EXPECT_LT(initial_size + 1000 * (sizeof(uint64_t) + sizeof(double)), grown_size);
+  for (uint64_t key = 10; key < 1000; ++key) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &key));
+    expected.erase(key);
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &grown_capacity));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_allocated_size(&map, &allocated_size));
+  EXPECT_LT(initial_size, allocated_size);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_shrink_to_fit(&map));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_capacity(&map, &capacity));
+  EXPECT_GT(grown_capacity / 16, capacity);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_allocated_size(&map, &allocated_size));
+  EXPECT_GT(grown_size / 16, allocated_size);
+  expect_same_entries(expected);
+
+  // Shrinking again changes nothing, and the map grows again as needed.
+  size_t shrunk_size = allocated_size;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_shrink_to_fit(&map));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_allocated_size(&map, &allocated_size));
+  EXPECT_EQ(shrunk_size, allocated_size);
+  for (uint64_t key = 2000; key < 2100; ++key) {
+    double data = static_cast<double>(key);
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &data));
+    expected[key] = data;
+  }
+  expect_same_entries(expected);
+
+  // An empty map keeps as little as it can.
+  for (auto & entry : expected) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &entry.first));
+  }
+  expected.clear();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_shrink_to_fit(&map));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_allocated_size(&map, &allocated_size));
+  EXPECT_GE(initial_size, allocated_size);
+  expect_same_entries(expected);
+  uint64_t key = 1;
+  double data = 1.;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &data));
+  expected[key] = data;
+  expect_same_entries(expected);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_shrink_to_fit(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_get_allocated_size(nullptr, &capacity));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_get_allocated_size(&map, nullptr));
+  rcutils_reset_error();
+  rcutils_hash_map_t uninitialized_map = rcutils_get_zero_initialized_hash_map();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_hash_map_shrink_to_fit(&uninitialized_map));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED,
+    rcutils_hash_map_get_allocated_size(&uninitialized_map, &capacity));
+  rcutils_reset_error();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  HashMapBackends, HashMapBackendTest,
+  ::testing::Combine(
+    ::testing::Values(
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL),
+    ::testing::Bool()));
+
+TEST(HashMapStringHash, fast_hash) {
+  const std::string name = "/a/rather/long/topic/name/with/many/segments";
+  const char * c_name = name.c_str();
+  for (size_t length = 0; length <= name.size(); ++length) {
+    // The hash of a prefix doesn't depend on the characters after it.
+    std::string prefix = name.substr(0, length);
+    const char * c_prefix = prefix.c_str();
+    EXPECT_EQ(
+      rcutils_hash_map_string_fast_hash_func(&c_prefix),
+      rcutils_hash_map_string_fast_hashn(c_name, length)) << length;
+    if (length > 0) {
+      EXPECT_NE(
+        rcutils_hash_map_string_fast_hashn(c_name, length - 1),
+        rcutils_hash_map_string_fast_hashn(c_name, length)) << length;
+    }
+  }
+  // A single different character changes the hash, including the last one.
+  EXPECT_NE(
+    rcutils_hash_map_string_fast_hashn("node_name_a", 11),
+    rcutils_hash_map_string_fast_hashn("node_name_b", 11));
+  EXPECT_NE(
+    rcutils_hash_map_string_fast_hashn("0123456789abcdefX", 17),
+    rcutils_hash_map_string_fast_hashn("0123456789abcdefY", 17));
+}
+
+TEST(HashMapStringHash, fast_hash_low_bits_are_distributed) {
+  // Similar names spread evenly over 64 buckets indexed by the low bits of their hash.
+  size_t buckets[64] = {0};
+  for (int i = 0; i < 6400; ++i) {
+    std::string name = "node_" + std::to_string(i);
+    ++buckets[rcutils_hash_map_string_fast_hashn(name.c_str(), name.size()) & 63u];
+  }
+  for (size_t count : buckets) {
+    EXPECT_LT(50u, count);
+    EXPECT_GT(150u, count);
+  }
+}
+
+TEST_F(HashMapBaseTest, string_keys_fast_hash) {
+  uint32_t data = 1, ret_data = 0;
+  std::string key1 = "one";
+  std::string key2 = "two";
+  const char * c_key1 = key1.c_str();
+  const char * c_key2 = key2.c_str();
+  const char * lookup_key = "one";
+  rcutils_ret_t ret = rcutils_hash_map_init(
+    &map, 8, sizeof(char *), sizeof(uint32_t),
+    rcutils_hash_map_string_fast_hash_func, rcutils_hash_map_string_cmp_func,
+    &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &c_key1, &data));
+  data++;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &c_key2, &data));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get(&map, &lookup_key, &ret_data));
+  EXPECT_EQ(1u, ret_data);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&map));
+}
+
+class HashMapKeyViewTest
+  : public ::testing::TestWithParam<std::tuple<rcutils_hash_map_backend_t, bool>>
+{
+protected:
+  void SetUp() override
+  {
+    allocator = rcutils_get_default_allocator();
+    map = rcutils_get_zero_initialized_hash_map();
+    const bool fast_hash = std::get<1>(GetParam());
+    rcutils_ret_t ret = rcutils_hash_map_init_with_backend(
+      &map, 2, sizeof(char *), sizeof(uint32_t),
+      fast_hash ? rcutils_hash_map_string_fast_hash_func : rcutils_hash_map_string_hash_func,
+      rcutils_hash_map_string_cmp_func, std::get<0>(GetParam()), &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    ret = rcutils_hash_map_set_key_view_funcs(
+      &map,
+      fast_hash ?
+      rcutils_hash_map_string_fast_hash_view_func : rcutils_hash_map_string_hash_view_func,
+      rcutils_hash_map_string_view_cmp_func);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&map));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_hash_map_t map;
+};
+
+TEST_P(HashMapKeyViewTest, prefixes) {
+  // Each prefix ending before a '/' is a key, so that views of the name find each of them.
+  const std::string name = "/a/rather/long/logger/name/with/many/segments";
+  std::vector<std::string> keys;
+  for (size_t length = 1; length < name.size(); ++length) {
+    if ('/' == name[length]) {
+      keys.push_back(name.substr(0, length));
+    }
+  }
+  for (uint32_t i = 0; i < keys.size(); ++i) {
+    const char * key = keys[i].c_str();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&map, &key, &i));
+  }
+
+  for (size_t length = 0; length <= name.size(); ++length) {
+    auto it = std::find(keys.begin(), keys.end(), name.substr(0, length));
+    const bool exists = keys.end() != it;
+    EXPECT_EQ(exists, rcutils_hash_map_key_view_exists(&map, name.c_str(), length)) << length;
+    uint32_t data = 0;
+    EXPECT_EQ(
+      exists ? RCUTILS_RET_OK : RCUTILS_RET_NOT_FOUND,
+      rcutils_hash_map_get_with_key_view(&map, name.c_str(), length, &data)) << length;
+    if (exists) {
+      EXPECT_EQ(static_cast<uint32_t>(it - keys.begin()), data) << length;
+    }
+  }
+
+  // A view holding a null character doesn't match the key it is a prefix of.
+  const char with_null[] = "/a\0b";
+  EXPECT_TRUE(rcutils_hash_map_key_view_exists(&map, with_null, 2));
+  EXPECT_FALSE(rcutils_hash_map_key_view_exists(&map, with_null, 4));
+}
+
+TEST_P(HashMapKeyViewTest, invalid_arguments) {
+  uint32_t data = 0;
+  EXPECT_FALSE(rcutils_hash_map_key_view_exists(&map, "/a", 2));
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_hash_map_get_with_key_view(&map, "/a", 2, &data));
+  EXPECT_FALSE(rcutils_hash_map_key_view_exists(nullptr, "/a", 2));
+  EXPECT_FALSE(rcutils_hash_map_key_view_exists(&map, nullptr, 2));
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_get_with_key_view(nullptr, "/a", 2, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_get_with_key_view(&map, nullptr, 2, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_hash_map_get_with_key_view(&map, "/a", 2, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_hash_map_set_key_view_funcs(&map, nullptr, rcutils_hash_map_string_view_cmp_func));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_hash_map_set_key_view_funcs(&map, rcutils_hash_map_string_hash_view_func, nullptr));
+  rcutils_reset_error();
+
+  // Maps without key view functions can't be searched with key views.
+  rcutils_hash_map_t other = rcutils_get_zero_initialized_hash_map();
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED, rcutils_hash_map_get_with_key_view(&other, "/a", 2, &data));
+  rcutils_reset_error();
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_hash_map_init(
+      &other, 2, sizeof(char *), sizeof(uint32_t), rcutils_hash_map_string_hash_func,
+      rcutils_hash_map_string_cmp_func, &allocator));
+  const char * key = "/a";
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_hash_map_set(&other, &key, &data));
+  EXPECT_FALSE(rcutils_hash_map_key_view_exists(&other, "/a", 2));
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_hash_map_get_with_key_view(&other, "/a", 2, &data));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_fini(&other));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  HashMapBackends, HashMapKeyViewTest,
+  ::testing::Combine(
+    ::testing::Values(
+      RCUTILS_HASH_MAP_BACKEND_CHAINING, RCUTILS_HASH_MAP_BACKEND_OPEN_ADDRESSING,
+      RCUTILS_HASH_MAP_BACKEND_CHAINING_INCREMENTAL),
+    ::testing::Bool()));
+
+TEST(HashMapStringHash, view_funcs_match_key_funcs) {
+  const std::string name = "/a/rather/long/topic/name/with/many/segments";
+  for (size_t length = 0; length <= name.size(); ++length) {
+    std::string prefix = name.substr(0, length);
+    const char * c_prefix = prefix.c_str();
+    EXPECT_EQ(
+      rcutils_hash_map_string_hash_func(&c_prefix),
+      rcutils_hash_map_string_hash_view_func(name.c_str(), length)) << length;
+    EXPECT_EQ(
+      rcutils_hash_map_string_fast_hash_func(&c_prefix),
+      rcutils_hash_map_string_fast_hash_view_func(name.c_str(), length)) << length;
+    EXPECT_EQ(0, rcutils_hash_map_string_view_cmp_func(&c_prefix, name.c_str(), length));
+    if (length < name.size()) {
+      EXPECT_NE(0, rcutils_hash_map_string_view_cmp_func(&c_prefix, name.c_str(), length + 1));
+    }
+    if (length > 0) {
+      EXPECT_NE(0, rcutils_hash_map_string_view_cmp_func(&c_prefix, name.c_str(), length - 1));
+    }
+  }
+}
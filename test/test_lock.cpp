@@ -0,0 +1,207 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "rcutils/error_handling.h"
+#include "rcutils/lock.h"
+
+static constexpr size_t thread_count = 4;
+static constexpr uint64_t iteration_count = 20000;
+
+// Runs the function in a few threads at once, and returns when they are all done.
+static void run_concurrently(const std::function<void(size_t)> & function)
+{
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back(function, i);
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(test_lock, spinlock) {
+  rcutils_spinlock_t lock = RCUTILS_SPINLOCK_INITIALIZER;
+  EXPECT_TRUE(rcutils_spinlock_try_lock(&lock));
+  EXPECT_FALSE(rcutils_spinlock_try_lock(&lock));
+  rcutils_spinlock_unlock(&lock);
+
+  uint64_t counter = 0;
+  run_concurrently(
+    [&](size_t) {
+      for (uint64_t i = 0; i < iteration_count; ++i) {
+        rcutils_spinlock_lock(&lock);
+        ++counter;
+        rcutils_spinlock_unlock(&lock);
+      }
+    });
+  EXPECT_EQ(thread_count * iteration_count, counter);
+}
+
+TEST(test_lock, adaptive_mutex_init) {
+  rcutils_adaptive_mutex_options_t options = rcutils_get_default_adaptive_mutex_options();
+  EXPECT_EQ(RCUTILS_LOCK_DEFAULT_SPIN_COUNT, options.spin_count);
+  EXPECT_FALSE(options.priority_inheritance);
+
+  rcutils_adaptive_mutex_t mutex = RCUTILS_ADAPTIVE_MUTEX_INITIALIZER;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_adaptive_mutex_init(nullptr, &options));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_adaptive_mutex_init(&mutex, nullptr));
+  rcutils_reset_error();
+
+  options.spin_count = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_adaptive_mutex_init(&mutex, &options));
+  EXPECT_TRUE(rcutils_adaptive_mutex_try_lock(&mutex));
+  EXPECT_FALSE(rcutils_adaptive_mutex_try_lock(&mutex));
+  rcutils_adaptive_mutex_unlock(&mutex);
+  EXPECT_TRUE(rcutils_adaptive_mutex_try_lock(&mutex));
+  rcutils_adaptive_mutex_unlock(&mutex);
+
+  options.priority_inheritance = true;
+  rcutils_ret_t ret = rcutils_adaptive_mutex_init(&mutex, &options);
+#if defined(__linux__) || defined(__APPLE__)
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+#else
+  EXPECT_EQ(RCUTILS_RET_ERROR, ret);
+  rcutils_reset_error();
+#endif
+}
+
+class AdaptiveMutexTest : public ::testing::TestWithParam<rcutils_adaptive_mutex_options_t>
+{
+};
+
+TEST_P(AdaptiveMutexTest, contention) {
+  rcutils_adaptive_mutex_options_t options = GetParam();
+  rcutils_adaptive_mutex_t mutex;
+  rcutils_ret_t ret = rcutils_adaptive_mutex_init(&mutex, &options);
+  if (RCUTILS_RET_ERROR == ret) {
+    rcutils_reset_error();
+    GTEST_SKIP() << "priority inheritance isn't supported";
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  uint64_t counter = 0;
+  run_concurrently(
+    [&](size_t thread_index) {
+      for (uint64_t i = 0; i < iteration_count; ++i) {
+        if (0 == (i + thread_index) % 3) {
+          while (!rcutils_adaptive_mutex_try_lock(&mutex)) {
+            std::this_thread::yield();
+          }
+        } else {
+          rcutils_adaptive_mutex_lock(&mutex);
+        }
+        ++counter;
+        if (0 == i % 1000) {
+          // Hold the mutex long enough for the others to sleep on it.
+          std::this_thread::yield();
+        }
+        rcutils_adaptive_mutex_unlock(&mutex);
+      }
+    });
+  EXPECT_EQ(thread_count * iteration_count, counter);
+  EXPECT_TRUE(rcutils_adaptive_mutex_try_lock(&mutex));
+  rcutils_adaptive_mutex_unlock(&mutex);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  test_lock, AdaptiveMutexTest,
+  ::testing::Values(
+    rcutils_adaptive_mutex_options_t{RCUTILS_LOCK_DEFAULT_SPIN_COUNT, false},
+    rcutils_adaptive_mutex_options_t{0u, false},
+    rcutils_adaptive_mutex_options_t{RCUTILS_LOCK_DEFAULT_SPIN_COUNT, true},
+    rcutils_adaptive_mutex_options_t{0u, true}));
+
+TEST(test_lock, adaptive_rwlock_exclusion) {
+  rcutils_adaptive_rwlock_t lock = RCUTILS_ADAPTIVE_RWLOCK_INITIALIZER;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_adaptive_rwlock_init(nullptr, 0));
+  rcutils_reset_error();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_adaptive_rwlock_init(&lock, 0));
+
+  // Readers share the lock, but not with a writer.
+  EXPECT_TRUE(rcutils_adaptive_rwlock_try_read_lock(&lock));
+  EXPECT_TRUE(rcutils_adaptive_rwlock_try_read_lock(&lock));
+  EXPECT_FALSE(rcutils_adaptive_rwlock_try_write_lock(&lock));
+  rcutils_adaptive_rwlock_read_unlock(&lock);
+  EXPECT_FALSE(rcutils_adaptive_rwlock_try_write_lock(&lock));
+  rcutils_adaptive_rwlock_read_unlock(&lock);
+  EXPECT_TRUE(rcutils_adaptive_rwlock_try_write_lock(&lock));
+  EXPECT_FALSE(rcutils_adaptive_rwlock_try_read_lock(&lock));
+  EXPECT_FALSE(rcutils_adaptive_rwlock_try_write_lock(&lock));
+  rcutils_adaptive_rwlock_write_unlock(&lock);
+
+  // A waiting writer keeps new readers out.
+  rcutils_adaptive_rwlock_read_lock(&lock);
+  std::atomic<bool> written(false);
+  std::thread writer(
+    [&]() {
+      rcutils_adaptive_rwlock_write_lock(&lock);
+      written = true;
+      rcutils_adaptive_rwlock_write_unlock(&lock);
+    });
+  while (rcutils_adaptive_rwlock_try_read_lock(&lock)) {
+    rcutils_adaptive_rwlock_read_unlock(&lock);
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(written);
+  rcutils_adaptive_rwlock_read_unlock(&lock);
+  writer.join();
+  EXPECT_TRUE(written);
+  EXPECT_TRUE(rcutils_adaptive_rwlock_try_read_lock(&lock));
+  rcutils_adaptive_rwlock_read_unlock(&lock);
+}
+
+TEST(test_lock, adaptive_rwlock_contention) {
+  for (uint32_t spin_count : {RCUTILS_LOCK_DEFAULT_SPIN_COUNT, 0u}) {
+    rcutils_adaptive_rwlock_t lock;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_adaptive_rwlock_init(&lock, spin_count));
+    // Writers keep both values equal, which readers check.
+    uint64_t first = 0;
+    uint64_t second = 0;
+    std::atomic<uint64_t> torn_reads(0);
+    run_concurrently(
+      [&](size_t thread_index) {
+        for (uint64_t i = 0; i < iteration_count; ++i) {
+          if (0 == (i + thread_index) % 4) {
+            rcutils_adaptive_rwlock_write_lock(&lock);
+            ++first;
+            if (0 == i % 1000) {
+              std::this_thread::yield();
+            }
+            ++second;
+            rcutils_adaptive_rwlock_write_unlock(&lock);
+          } else {
+            rcutils_adaptive_rwlock_read_lock(&lock);
+            if (first != second) {
+              ++torn_reads;
+            }
+            rcutils_adaptive_rwlock_read_unlock(&lock);
+          }
+        }
+      });
+    EXPECT_EQ(0u, torn_reads);
+    EXPECT_EQ(thread_count * iteration_count / 4, first);
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(rcutils_adaptive_rwlock_try_write_lock(&lock));
+    rcutils_adaptive_rwlock_write_unlock(&lock);
+  }
+}
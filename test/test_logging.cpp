@@ -14,7 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <string>
 #include <thread>
 #include <vector>
@@ -23,6 +25,8 @@
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 #include "rcutils/logging.h"
 #include "rcutils/strdup.h"
+#include "rcutils/time.h"
+#include "rcutils/types/hash_map.h"
 
 TEST(TestLogging, test_logging_initialization) {
   EXPECT_FALSE(g_rcutils_logging_initialized);
@@ -50,6 +54,39 @@ TEST(TestLogging, test_logging_initialization) {
     RCUTILS_RET_ERROR, rcutils_logging_initialize_with_allocator(failing_allocator));
 }
 
+TEST(TestLogging, test_logging_concurrent_first_use) {
+  EXPECT_FALSE(g_rcutils_logging_initialized);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    EXPECT_EQ(RCUTILS_LOGGING_UNINITIALIZED, g_rcutils_logging_initialization_state);
+  });
+  EXPECT_EQ(RCUTILS_LOGGING_UNINITIALIZED, g_rcutils_logging_initialization_state);
+
+  // Every thread sees the logging system initialized once, by whichever of them came first.
+  std::atomic<bool> start{false};
+  std::atomic<int> enabled{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back(
+      [&start, &enabled]() {
+        while (!start) {
+          std::this_thread::yield();
+        }
+        if (rcutils_logging_logger_is_enabled_for("name", RCUTILS_LOG_SEVERITY_INFO)) {
+          ++enabled;
+        }
+      });
+  }
+  start = true;
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(8, enabled);
+  EXPECT_TRUE(g_rcutils_logging_initialized);
+  EXPECT_EQ(RCUTILS_LOGGING_INITIALIZED, g_rcutils_logging_initialization_state);
+}
+
 size_t g_log_calls = 0;
 
 struct LogEvent
@@ -143,6 +180,339 @@ TEST(TestLogging, test_logging) {
   rcutils_logging_set_output_handler(original_function);
 }
 
+struct SinkEvents
+{
+  std::vector<int> levels;
+  std::vector<std::string> messages;
+  std::vector<const char *> message_pointers;
+};
+
+static void record_sink_event(
+  const rcutils_log_location_t * location,
+  int level, const char * name, rcutils_time_point_value_t timestamp,
+  const char * message, void * context)
+{
+  (void)location;
+  (void)name;
+  (void)timestamp;
+  SinkEvents * events = static_cast<SinkEvents *>(context);
+  events->levels.push_back(level);
+  events->messages.push_back(message);
+  events->message_pointers.push_back(message);
+}
+
+TEST(TestLogging, test_logging_sinks) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_DEBUG);
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+
+  SinkEvents all;
+  SinkEvents warnings;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_add_sink(NULL, &all, RCUTILS_LOG_SEVERITY_UNSET));
+  rcutils_reset_error();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(record_sink_event, &all, RCUTILS_LOG_SEVERITY_UNSET));
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_add_sink(record_sink_event, &all, RCUTILS_LOG_SEVERITY_INFO));
+  rcutils_reset_error();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(record_sink_event, &warnings, RCUTILS_LOG_SEVERITY_WARN));
+
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_DEBUG, "name", "debug %d", 1);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_ERROR, "name", "error %d", 2);
+  ASSERT_EQ(2u, all.messages.size());
+  EXPECT_EQ("debug 1", all.messages[0]);
+  EXPECT_EQ("error 2", all.messages[1]);
+  ASSERT_EQ(1u, warnings.messages.size());
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, warnings.levels[0]);
+  EXPECT_EQ("error 2", warnings.messages[0]);
+  // The message is formatted once and shared by the sinks.
+  EXPECT_EQ(all.message_pointers[1], warnings.message_pointers[0]);
+
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_sink_severity(record_sink_event, &all, RCUTILS_LOG_SEVERITY_FATAL));
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "name", "info");
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_WARN, "name", "warn");
+  EXPECT_EQ(2u, all.messages.size());
+  ASSERT_EQ(2u, warnings.messages.size());
+  EXPECT_EQ("warn", warnings.messages[1]);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_remove_sink(record_sink_event, &warnings));
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_logging_remove_sink(record_sink_event, &warnings));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_FOUND,
+    rcutils_logging_set_sink_severity(record_sink_event, &warnings, RCUTILS_LOG_SEVERITY_INFO));
+  rcutils_reset_error();
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_FATAL, "name", "fatal");
+  EXPECT_EQ(3u, all.messages.size());
+  EXPECT_EQ(2u, warnings.messages.size());
+
+  // The registry is bounded.
+  std::vector<SinkEvents> more(RCUTILS_LOGGING_MAX_SINKS);
+  size_t added = 1;
+  for (auto & events : more) {
+    rcutils_ret_t ret = rcutils_logging_add_sink(
+      record_sink_event, &events, RCUTILS_LOG_SEVERITY_UNSET);
+    if (added < RCUTILS_LOGGING_MAX_SINKS) {
+      EXPECT_EQ(RCUTILS_RET_OK, ret);
+      ++added;
+    } else {
+      EXPECT_EQ(RCUTILS_RET_NOT_ENOUGH_SPACE, ret);
+      rcutils_reset_error();
+    }
+  }
+
+  // Shutdown removes all sinks.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_logging_remove_sink(record_sink_event, &all));
+  rcutils_reset_error();
+}
+
+static rcutils_time_point_value_t g_last_log_timestamp = 0;
+
+static void record_log_timestamp(
+  const rcutils_log_location_t * location, int severity, const char * name,
+  rcutils_time_point_value_t timestamp, const char * format, va_list * args)
+{
+  (void)location;
+  (void)severity;
+  (void)name;
+  (void)format;
+  (void)args;
+  g_last_log_timestamp = timestamp;
+}
+
+// Log a message and check that its timestamp is close to the precise system time.
+static void expect_recent_log_timestamp()
+{
+  g_last_log_timestamp = 0;
+  rcutils_time_point_value_t before = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_system_time_now(&before));
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "name", "message");
+  rcutils_time_point_value_t after = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_system_time_now(&after));
+  // Coarse and cached timestamps lag behind by up to their resolution.
+  EXPECT_LE(before - RCUTILS_MS_TO_NS(20), g_last_log_timestamp);
+  EXPECT_GE(after, g_last_log_timestamp);
+}
+
+TEST(TestLogging, test_logging_timestamp_source) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_output_handler(record_log_timestamp);
+  EXPECT_EQ(RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE, rcutils_logging_get_timestamp_source());
+  expect_recent_log_timestamp();
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_set_timestamp_source(static_cast<rcutils_logging_timestamp_source_t>(3)));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE, rcutils_logging_get_timestamp_source());
+
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_timestamp_source(RCUTILS_LOGGING_TIMESTAMP_SOURCE_COARSE));
+  EXPECT_EQ(RCUTILS_LOGGING_TIMESTAMP_SOURCE_COARSE, rcutils_logging_get_timestamp_source());
+  expect_recent_log_timestamp();
+
+  // Without asynchronous mode the cached source falls back to the coarse clock.
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_timestamp_source(RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED));
+  EXPECT_EQ(RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED, rcutils_logging_get_timestamp_source());
+  expect_recent_log_timestamp();
+
+  // The consumer thread keeps the cached time fresh, also while nothing is logged.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(NULL));
+  expect_recent_log_timestamp();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  expect_recent_log_timestamp();
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_timestamp_source(RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE));
+  expect_recent_log_timestamp();
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_timestamp_source(RCUTILS_LOGGING_TIMESTAMP_SOURCE_CACHED));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  expect_recent_log_timestamp();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+  expect_recent_log_timestamp();
+
+  // Shutdown restores the default.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  EXPECT_EQ(RCUTILS_LOGGING_TIMESTAMP_SOURCE_PRECISE, rcutils_logging_get_timestamp_source());
+}
+
+TEST(TestLogging, test_logging_no_sink_wants_message) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_logging_disable_statistics();
+    rcutils_logging_reset_statistics();
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_DEBUG);
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  SinkEvents warnings;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(record_sink_event, &warnings, RCUTILS_LOG_SEVERITY_WARN));
+  rcutils_logging_reset_statistics();
+  rcutils_logging_enable_statistics();
+
+  // A message enabled for its logger but below every sink is counted as filtered, since it
+  // doesn't even reach the output handler.
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "name", "info");
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_WARN, "name", "warn");
+  rcutils_logging_statistics_t statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(1u, statistics.filtered_messages);
+  ASSERT_EQ(1u, warnings.messages.size());
+  EXPECT_EQ("warn", warnings.messages[0]);
+}
+
+TEST(TestLogging, test_logging_repeat_suppression) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_logging_disable_statistics();
+    rcutils_logging_reset_statistics();
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  SinkEvents events;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(record_sink_event, &events, RCUTILS_LOG_SEVERITY_INFO));
+  rcutils_logging_reset_statistics();
+  rcutils_logging_enable_statistics();
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_enable_repeat_suppression(0));
+  rcutils_reset_error();
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_enable_repeat_suppression(RCUTILS_S_TO_NS(3600)));
+
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  rcutils_log_location_t other_location = {"func", "file.c", 43u};
+  for (int i = 0; i < 5; ++i) {
+    rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  }
+  // Other callsites, and messages without a location, aren't affected.
+  rcutils_log(&other_location, RCUTILS_LOG_SEVERITY_INFO, "name", "sensor 1 offline");
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "no location");
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "no location");
+  // A different message from the callsite reports the repeats of the previous one first.
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 2);
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 2);
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  std::vector<std::string> expected = {
+    "sensor 1 offline",
+    "sensor 1 offline",
+    "no location",
+    "no location",
+    "Last message repeated 4 times",
+    "sensor 2 offline",
+    "Last message repeated 1 times",
+    "sensor 1 offline",
+  };
+  EXPECT_EQ(expected, events.messages);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, events.levels[4]);
+  rcutils_logging_statistics_t statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(5u, statistics.suppressed_messages);
+
+  // Once the interval elapsed, a burst is summarized and the message is output again.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_enable_repeat_suppression(RCUTILS_MS_TO_NS(20)));
+  events.messages.clear();
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  expected = {"Last message repeated 2 times", "sensor 1 offline"};
+  EXPECT_EQ(expected, events.messages);
+
+  rcutils_logging_disable_repeat_suppression();
+  events.messages.clear();
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "name", "sensor %d offline", 1);
+  EXPECT_EQ(2u, events.messages.size());
+}
+
+TEST(TestLogging, test_log_string) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+
+  // The message isn't null terminated, nor used as a format.
+  const char message[] = {'1', '0', '0', '%', ' ', '%', 's', '!', '!'};
+  const size_t length = 7u;
+
+  // Other output handlers are passed the message through a format.
+  auto format_output_handler = [](
+    const rcutils_log_location_t * location,
+    int level, const char * name, rcutils_time_point_value_t timestamp,
+    const char * format, va_list * args) -> void
+    {
+      g_log_calls += 1;
+      g_last_log_event.location = location;
+      g_last_log_event.level = level;
+      g_last_log_event.name = name;
+      g_last_log_event.timestamp = timestamp;
+      char buffer[1024];
+      vsnprintf(buffer, sizeof(buffer), format, *args);
+      g_last_log_event.message = buffer;
+    };
+  rcutils_logging_set_output_handler(format_output_handler);
+  g_log_calls = 0;
+  rcutils_log_location_t location = {"func", "file", 42u};
+  rcutils_log_string(&location, RCUTILS_LOG_SEVERITY_WARN, "name", message, length);
+  EXPECT_EQ(1u, g_log_calls);
+  EXPECT_EQ(&location, g_last_log_event.location);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, g_last_log_event.level);
+  EXPECT_EQ("name", g_last_log_event.name);
+  EXPECT_EQ("100% %s", g_last_log_event.message);
+  rcutils_log_string(nullptr, RCUTILS_LOG_SEVERITY_DEBUG, "name", message, length);
+  EXPECT_EQ(1u, g_log_calls);
+  rcutils_log_string(nullptr, RCUTILS_LOG_SEVERITY_INFO, nullptr, nullptr, 42u);
+  EXPECT_EQ(2u, g_log_calls);
+  EXPECT_EQ("", g_last_log_event.name);
+  EXPECT_EQ("", g_last_log_event.message);
+
+  // The sinks are passed a null terminated copy, and repeats of formatted messages are detected.
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  SinkEvents events;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(record_sink_event, &events, RCUTILS_LOG_SEVERITY_WARN));
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_enable_repeat_suppression(RCUTILS_S_TO_NS(3600)));
+  rcutils_log_string(&location, RCUTILS_LOG_SEVERITY_INFO, "name", message, length);
+  rcutils_log_string(&location, RCUTILS_LOG_SEVERITY_WARN, "name", message, length);
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_WARN, "name", "%s", "100% %s");
+  rcutils_log_string(&location, RCUTILS_LOG_SEVERITY_WARN, "name", message, length + 2u);
+  std::vector<std::string> expected = {
+    "100% %s", "Last message repeated 1 times", "100% %s!!"};
+  EXPECT_EQ(expected, events.messages);
+  rcutils_logging_disable_repeat_suppression();
+}
+
 TEST(TestLogging, test_log_severity) {
   rcutils_allocator_t allocator = rcutils_get_default_allocator();
   int severity;
@@ -325,6 +695,371 @@ TEST(TestLogging, test_logger_severity_hierarchy) {
     rcutils_logging_get_logger_effective_level("rcutils_test_logging_cpp.."));
 }
 
+TEST(TestLogging, test_logger_severity_hierarchy_gaps) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // Ancestors of loggers with a level don't get one themselves.
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test.a.b.c", RCUTILS_LOG_SEVERITY_ERROR));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test.a.x", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("rcutils_test.a.b"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_UNSET, rcutils_logging_get_logger_level("rcutils_test.a.b"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR,
+    rcutils_logging_get_logger_effective_level("rcutils_test.a.b.c.d.e"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("rcutils_test.a.x.b.c"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("rcutils_test.a.bc"));
+
+  // Giving one of them a level applies to the descendants without a closer level.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test.a", RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level("rcutils_test.a.b"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level("rcutils_test.a.bc"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level("rcutils_test.a.b.c"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("rcutils_test"));
+}
+
+TEST(TestLogging, test_logger_severity_many_names) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // Enough names for lookups of the others to pass the filter of the levels sometimes.
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+  for (int i = 0; i < 300; ++i) {
+    std::string name = "rcutils_test_" + std::to_string(i) + ".child";
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_set_logger_level(name.c_str(), RCUTILS_LOG_SEVERITY_ERROR));
+  }
+  for (int i = 0; i < 300; ++i) {
+    std::string name = "rcutils_test_" + std::to_string(i);
+    EXPECT_EQ(
+      RCUTILS_LOG_SEVERITY_ERROR,
+      rcutils_logging_get_logger_effective_level((name + ".child.grandchild").c_str()));
+    EXPECT_EQ(
+      RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level(name.c_str()));
+    EXPECT_EQ(
+      RCUTILS_LOG_SEVERITY_INFO,
+      rcutils_logging_get_logger_effective_level((name + ".other").c_str()));
+    EXPECT_EQ(
+      RCUTILS_LOG_SEVERITY_INFO,
+      rcutils_logging_get_logger_effective_level(("other_" + name + ".child").c_str()));
+  }
+}
+
+TEST(TestLogging, test_logger_severity_given_hash) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_WARN);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test.child", RCUTILS_LOG_SEVERITY_DEBUG));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("rcutils_test.*", RCUTILS_LOG_SEVERITY_ERROR));
+
+  // The hash of the name is used to look up its own level, which applies over the pattern.
+  const char * names[] = {"rcutils_test.child", "rcutils_test.child.grandchild"};
+  for (const char * name : names) {
+    SCOPED_TRACE(name);
+    const size_t length = strlen(name);
+    EXPECT_TRUE(
+      rcutils_logging_update_callsite_cache_with_hash(
+        nullptr, name, length, rcutils_hash_map_string_hash_func(&name),
+        RCUTILS_LOG_SEVERITY_DEBUG));
+    // A wrong hash only makes the lookup slower.
+    EXPECT_TRUE(
+      rcutils_logging_update_callsite_cache_with_hash(
+        nullptr, name, length, rcutils_hash_map_string_hash_func(&name) + 1u,
+        RCUTILS_LOG_SEVERITY_DEBUG));
+  }
+  const char * other_name = "rcutils_test.other";
+  EXPECT_FALSE(
+    rcutils_logging_update_callsite_cache_with_hash(
+      nullptr, other_name, strlen(other_name), rcutils_hash_map_string_hash_func(&other_name),
+      RCUTILS_LOG_SEVERITY_WARN));
+}
+
+TEST(TestLogging, test_logger_set_levels) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_set_logger_levels(nullptr, nullptr, 0));
+  const char * names[] = {"rcutils_test", "rcutils_test.a", "rcutils_test.b", "rcutils_test.a"};
+  int levels[] = {
+    RCUTILS_LOG_SEVERITY_WARN, RCUTILS_LOG_SEVERITY_DEBUG, RCUTILS_LOG_SEVERITY_ERROR,
+    RCUTILS_LOG_SEVERITY_FATAL};
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_logger_levels(nullptr, levels, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_logger_levels(names, nullptr, 1));
+  rcutils_reset_error();
+
+  // Invalid arguments anywhere change no level.
+  const char * invalid_names[] = {"rcutils_test", nullptr};
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_logger_levels(invalid_names, levels, 2));
+  rcutils_reset_error();
+  int invalid_levels[] = {RCUTILS_LOG_SEVERITY_WARN, 1000};
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_logger_levels(names, invalid_levels, 2));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_UNSET, rcutils_logging_get_logger_level("rcutils_test"));
+
+  // The last level of a name is used.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_logger_levels(names, levels, 4));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_level("rcutils_test"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_FATAL, rcutils_logging_get_logger_level("rcutils_test.a"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level("rcutils_test.b.c"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level("rcutils_test.c"));
+
+  // Levels which were set already are replaced, and an empty name sets the default level.
+  const char * more_names[] = {"rcutils_test.a", "", "other"};
+  int more_levels[] = {
+    RCUTILS_LOG_SEVERITY_UNSET, RCUTILS_LOG_SEVERITY_ERROR, RCUTILS_LOG_SEVERITY_DEBUG};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_logger_levels(more_names, more_levels, 3));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level("rcutils_test.a.x"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_default_logger_level());
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level("unknown"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("other.x"));
+
+  // Many levels at once.
+  std::vector<std::string> many_names;
+  for (int i = 0; i < 500; ++i) {
+    many_names.push_back("rcutils_test_" + std::to_string(i));
+  }
+  std::vector<const char *> many_name_pointers;
+  std::vector<int> many_levels;
+  for (const std::string & name : many_names) {
+    many_name_pointers.push_back(name.c_str());
+    many_levels.push_back(RCUTILS_LOG_SEVERITY_DEBUG);
+  }
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_levels(
+      many_name_pointers.data(), many_levels.data(), many_levels.size()));
+  for (const std::string & name : many_names) {
+    EXPECT_EQ(
+      RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level(name.c_str()));
+  }
+}
+
+TEST(TestLogging, test_logger_uniform_level) {
+  EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+  });
+
+  // All loggers have the default level.
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_WARN);
+  EXPECT_TRUE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_INFO));
+  EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_FALSE(rcutils_logging_logger_is_enabled_for("rcutils_test", RCUTILS_LOG_SEVERITY_INFO));
+  // Setting the level of the default logger only changes the default level.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_logger_level("", RCUTILS_LOG_SEVERITY_ERROR));
+  EXPECT_TRUE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_WARN));
+
+  // Filtered messages are counted while statistics are enabled.
+  rcutils_logging_enable_statistics();
+  EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+  rcutils_logging_disable_statistics();
+  EXPECT_TRUE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+
+  // Loggers with a level of their own may be enabled below the default level.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcutils_logging_logger_is_enabled_for("rcutils_test", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcutils_logging_logger_is_enabled_for("other", RCUTILS_LOG_SEVERITY_DEBUG));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test", RCUTILS_LOG_SEVERITY_UNSET));
+  EXPECT_TRUE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+
+  // So may loggers matching a pattern.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("rcutils_*", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcutils_logging_logger_is_enabled_for("rcutils_test", RCUTILS_LOG_SEVERITY_DEBUG));
+}
+
+TEST(TestLogging, test_logger_uniform_level_concurrent_setters) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // The uniform level published by the last setter must account for the changes of the others.
+  for (int i = 0; i < 200; ++i) {
+    rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_WARN);
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_set_logger_level("rcutils_test", RCUTILS_LOG_SEVERITY_UNSET));
+    std::thread level_thread(
+      [] {
+        EXPECT_EQ(
+          RCUTILS_RET_OK,
+          rcutils_logging_set_logger_level("rcutils_test", RCUTILS_LOG_SEVERITY_DEBUG));
+      });
+    std::thread default_level_thread(
+      [] {
+        rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_ERROR);
+        rcutils_logging_enable_statistics();
+        rcutils_logging_disable_statistics();
+      });
+    level_thread.join();
+    default_level_thread.join();
+
+    EXPECT_FALSE(rcutils_logging_is_below_uniform_level(RCUTILS_LOG_SEVERITY_DEBUG));
+    EXPECT_TRUE(
+      rcutils_logging_logger_is_enabled_for("rcutils_test", RCUTILS_LOG_SEVERITY_DEBUG));
+  }
+}
+
+TEST(TestLogging, test_logger_level_patterns) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_set_logger_level_pattern(nullptr, RCUTILS_LOG_SEVERITY_WARN));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_set_logger_level_pattern("no_wildcard", RCUTILS_LOG_SEVERITY_WARN));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_logger_level_pattern("*", -1));
+  rcutils_reset_error();
+
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("planner.*.debug_viz", RCUTILS_LOG_SEVERITY_ERROR));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("*.costmap", RCUTILS_LOG_SEVERITY_WARN));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("sensor_*_driver", RCUTILS_LOG_SEVERITY_DEBUG));
+
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR,
+    rcutils_logging_get_logger_effective_level("planner.global.debug_viz"));
+  // Patterns apply to the descendants of what they match.
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR,
+    rcutils_logging_get_logger_effective_level("planner.local.debug_viz.markers"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("planner.global"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO,
+    rcutils_logging_get_logger_effective_level("planner.a.b.debug_viz"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level("local.costmap"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level(".costmap"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("a.b.costmap"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("sensor_lidar_driver"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("sensor__driver.x"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("sensor_driver"));
+  // Patterns don't set the level of loggers, only their effective level.
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_UNSET, rcutils_logging_get_logger_level("local.costmap"));
+
+  // A name takes precedence over patterns at the same depth, but not over deeper ones.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("local.costmap", RCUTILS_LOG_SEVERITY_FATAL));
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level("planner", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_FATAL, rcutils_logging_get_logger_effective_level("local.costmap"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level("global.costmap"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR,
+    rcutils_logging_get_logger_effective_level("planner.global.debug_viz"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("planner.global"));
+
+  // The pattern set last takes precedence, also when it is set again.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("global.*", RCUTILS_LOG_SEVERITY_ERROR));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level("global.costmap"));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("*.costmap", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("global.costmap"));
+
+  // Unsetting removes the pattern.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level_pattern("*.costmap", RCUTILS_LOG_SEVERITY_UNSET));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level("global.costmap"));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("other.costmap"));
+
+  // Cached decisions follow pattern changes.
+  EXPECT_TRUE(rcutils_logging_logger_is_enabled_for("robot.arm", RCUTILS_LOG_SEVERITY_INFO));
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level_pattern("*.arm", RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_FALSE(rcutils_logging_logger_is_enabled_for("robot.arm", RCUTILS_LOG_SEVERITY_INFO));
+
+  // The patterns are cleared on logging restart.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  EXPECT_EQ(
+    rcutils_logging_get_default_logger_level(),
+    rcutils_logging_get_logger_effective_level("robot.arm"));
+}
+
 TEST(TestLogging, test_logger_unset_change_ancestor) {
   ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
   OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
@@ -369,6 +1104,129 @@ TEST(TestLogging, test_logger_unset_change_ancestor) {
       "rcutils_test_logging_cpp.x"));
 }
 
+TEST(TestLogging, test_logger_effective_level_cache) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp", RCUTILS_LOG_SEVERITY_WARN));
+
+  // Names short enough to be cached, longer than the cache entries and longer than the stack
+  // buffer used to walk the hierarchy.
+  std::vector<std::string> names = {
+    "rcutils_test_logging_cpp.a.b.c.d",
+    "rcutils_test_logging_cpp." + std::string(150, 'x'),
+    "rcutils_test_logging_cpp." + std::string(300, 'y') + ".z",
+  };
+
+  for (const auto & name : names) {
+    // Resolve repeatedly, the later calls are served from the cache.
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(
+        RCUTILS_LOG_SEVERITY_WARN, rcutils_logging_get_logger_effective_level(name.c_str()));
+    }
+  }
+
+  // Changing the level of the ancestor invalidates the cached levels.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp", RCUTILS_LOG_SEVERITY_ERROR));
+  for (const auto & name : names) {
+    EXPECT_EQ(
+      RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level(name.c_str()));
+  }
+
+  // Loggers falling back to the default level follow changes of the default level.
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_INFO, rcutils_logging_get_logger_effective_level("other_logger.child"));
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_DEBUG);
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG, rcutils_logging_get_logger_effective_level("other_logger.child"));
+
+  // Setting a level on a descendant takes precedence over the cached inherited level.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp.a.b", RCUTILS_LOG_SEVERITY_FATAL));
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_FATAL, rcutils_logging_get_logger_effective_level(names[0].c_str()));
+
+  // Levels changed on one thread are seen by the cache of another thread.
+  std::thread other_thread(
+    [&names]() {
+      EXPECT_EQ(
+        RCUTILS_LOG_SEVERITY_FATAL, rcutils_logging_get_logger_effective_level(names[0].c_str()));
+    });
+  other_thread.join();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp.a.b", RCUTILS_LOG_SEVERITY_UNSET));
+  other_thread = std::thread(
+    [&names]() {
+      EXPECT_EQ(
+        RCUTILS_LOG_SEVERITY_ERROR, rcutils_logging_get_logger_effective_level(names[0].c_str()));
+    });
+  other_thread.join();
+}
+
+TEST(TestLogging, test_logger_handles) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  EXPECT_EQ(nullptr, rcutils_logging_get_logger_handle(nullptr));
+  rcutils_reset_error();
+
+  // The handle keeps its own copy of the name and is the same for the same name.
+  std::string name = "rcutils_test_logging_cpp.handle";
+  rcutils_logger_handle_t * handle = rcutils_logging_get_logger_handle(name.c_str());
+  ASSERT_NE(nullptr, handle);
+  EXPECT_NE(name.c_str(), rcutils_logging_get_logger_handle_name(handle));
+  EXPECT_STREQ(name.c_str(), rcutils_logging_get_logger_handle_name(handle));
+  EXPECT_EQ(handle, rcutils_logging_get_logger_handle("rcutils_test_logging_cpp.handle"));
+  rcutils_logger_handle_t * other_handle = rcutils_logging_get_logger_handle("");
+  ASSERT_NE(nullptr, other_handle);
+  EXPECT_NE(handle, other_handle);
+
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+  EXPECT_FALSE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_INFO));
+  EXPECT_TRUE(
+    rcutils_logging_logger_handle_is_enabled_for(other_handle, RCUTILS_LOG_SEVERITY_INFO));
+
+  // The cached level follows changes of the logger, its ancestors and the default level.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp", RCUTILS_LOG_SEVERITY_ERROR));
+  EXPECT_FALSE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_TRUE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_ERROR));
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level(name.c_str(), RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_DEBUG));
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level(name.c_str(), RCUTILS_LOG_SEVERITY_UNSET));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp", RCUTILS_LOG_SEVERITY_UNSET));
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_WARN);
+  EXPECT_FALSE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_INFO));
+  EXPECT_FALSE(
+    rcutils_logging_logger_handle_is_enabled_for(other_handle, RCUTILS_LOG_SEVERITY_INFO));
+
+  // Handles don't survive a shutdown, new ones are created afterwards.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  handle = rcutils_logging_get_logger_handle(name.c_str());
+  ASSERT_NE(nullptr, handle);
+  EXPECT_TRUE(rcutils_logging_logger_handle_is_enabled_for(handle, RCUTILS_LOG_SEVERITY_INFO));
+}
+
 TEST(TestLogging, test_logger_set_change_ancestor) {
   ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
   OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
@@ -536,3 +1394,59 @@ TEST(TestLogging, test_logging_macro_thread_safety)
     thread.join();
   }
 }
+
+TEST(TestLogging, test_logger_level_changes_while_logging)
+{
+  // Levels are changed while other threads keep resolving them, which must only ever see the
+  // level before or after a change.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level("rcutils_test_logging_cpp", RCUTILS_LOG_SEVERITY_WARN));
+
+  std::atomic<bool> done(false);
+  std::atomic<size_t> unexpected_levels(0);
+  auto task = [&done, &unexpected_levels](size_t thread_number) {
+      const std::string name = "rcutils_test_logging_cpp.thread" + std::to_string(thread_number);
+      while (!done) {
+        int level = rcutils_logging_get_logger_effective_level(name.c_str());
+        if (RCUTILS_LOG_SEVERITY_WARN != level && RCUTILS_LOG_SEVERITY_ERROR != level) {
+          ++unexpected_levels;
+        }
+        if (rcutils_logging_logger_is_enabled_for(name.c_str(), RCUTILS_LOG_SEVERITY_INFO)) {
+          ++unexpected_levels;
+        }
+      }
+    };
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back(task, i);
+  }
+
+  for (int i = 0; i < 500; ++i) {
+    // Alternate the level of the ancestor, and grow and shrink the set of levels.
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_set_logger_level(
+        "rcutils_test_logging_cpp",
+        (i % 2) ? RCUTILS_LOG_SEVERITY_ERROR : RCUTILS_LOG_SEVERITY_WARN));
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_set_logger_level(
+        ("other_logger" + std::to_string(i % 50)).c_str(),
+        (i % 100) < 50 ? RCUTILS_LOG_SEVERITY_DEBUG : RCUTILS_LOG_SEVERITY_UNSET));
+  }
+  done = true;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0u, unexpected_levels);
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_ERROR,
+    rcutils_logging_get_logger_effective_level("rcutils_test_logging_cpp.thread0"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_UNSET, rcutils_logging_get_logger_level("other_logger0"));
+}
@@ -0,0 +1,286 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+
+TEST(TestLoggingAsync, default_options) {
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  EXPECT_LT(1u, options.queue_size);
+  EXPECT_LT(0u, options.record_size);
+  EXPECT_EQ(RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP, options.overflow_policy);
+}
+
+TEST(TestLoggingAsync, enable_disable) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  EXPECT_FALSE(rcutils_logging_is_async());
+  EXPECT_EQ(0u, rcutils_logging_get_async_dropped_count());
+
+  // Disabling when not enabled is a no-op.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.queue_size = 1;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_enable_async(&options));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_logging_is_async());
+
+  options = rcutils_logging_get_default_async_options();
+  options.record_size = 0;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_enable_async(&options));
+  rcutils_reset_error();
+
+  options = rcutils_logging_get_default_async_options();
+  options.overflow_policy = static_cast<rcutils_logging_async_overflow_policy_t>(3);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_enable_async(&options));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_logging_is_async());
+
+  options = rcutils_logging_get_default_async_options();
+  // All the values in the range of the policies are valid, so copy in an invalid one like C would.
+  const int invalid_policy = 4;
+  static_assert(
+    sizeof(invalid_policy) == sizeof(options.consumer_thread_attributes.scheduling_policy),
+    "the policies are stored as ints");
+  memcpy(
+    &options.consumer_thread_attributes.scheduling_policy, &invalid_policy,
+    sizeof(invalid_policy));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_enable_async(&options));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_logging_is_async());
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(NULL));
+  EXPECT_TRUE(rcutils_logging_is_async());
+  // Enabling again restarts it.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(NULL));
+  EXPECT_TRUE(rcutils_logging_is_async());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+  EXPECT_FALSE(rcutils_logging_is_async());
+
+  // Shutdown disables it as well.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(NULL));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  EXPECT_FALSE(rcutils_logging_is_async());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+}
+
+#ifndef _WIN32
+// Redirects stderr, where the console output handler writes by default, to a
+// temporary file for the lifetime of the object.
+class StderrCapture
+{
+public:
+  StderrCapture()
+  {
+    fflush(stderr);
+    file_ = tmpfile();
+    saved_fd_ = dup(fileno(stderr));
+    dup2(fileno(file_), fileno(stderr));
+  }
+
+  ~StderrCapture()
+  {
+    restore();
+    fclose(file_);
+  }
+
+  // Stop capturing and return the lines written to stderr in the meantime.
+  std::vector<std::string> lines()
+  {
+    restore();
+    std::vector<std::string> result;
+    rewind(file_);
+    std::string line;
+    int c;
+    while ((c = fgetc(file_)) != EOF) {
+      if ('\n' == c) {
+        result.push_back(line);
+        line.clear();
+      } else {
+        line.push_back(static_cast<char>(c));
+      }
+    }
+    return result;
+  }
+
+private:
+  void restore()
+  {
+    if (saved_fd_ >= 0) {
+      fflush(stderr);
+      dup2(saved_fd_, fileno(stderr));
+      close(saved_fd_);
+      saved_fd_ = -1;
+    }
+  }
+
+  FILE * file_;
+  int saved_fd_;
+};
+
+static size_t
+log_from_threads(size_t num_threads, size_t messages_per_thread)
+{
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back(
+      [t, messages_per_thread]() {
+        for (size_t i = 0; i < messages_per_thread; ++i) {
+          rcutils_log(
+            NULL, RCUTILS_LOG_SEVERITY_INFO, "async", "thread %zu message %zu", t, i);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  return num_threads * messages_per_thread;
+}
+
+TEST(TestLoggingAsync, block_policy_delivers_everything) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  StderrCapture capture;
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.queue_size = 8;
+  options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(&options));
+  size_t expected = log_from_threads(4, 500);
+  EXPECT_EQ(0u, rcutils_logging_get_async_dropped_count());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+
+  std::vector<std::string> lines = capture.lines();
+  ASSERT_EQ(expected, lines.size());
+  for (const auto & line : lines) {
+    EXPECT_NE(std::string::npos, line.find("[async]: thread ")) << line;
+  }
+}
+
+#ifdef __linux__
+TEST(TestLoggingAsync, consumer_on_one_cpu) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  rcutils_cpu_set_t allowed = rcutils_get_zero_initialized_cpu_set();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_get_current_cpu_set(&allowed));
+  size_t cpu = 0;
+  while (!rcutils_cpu_set_contains(&allowed, cpu)) {
+    ++cpu;
+  }
+
+  StderrCapture capture;
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK;
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_cpu_set_add(&options.consumer_thread_attributes.cpu_set, cpu));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(&options)) <<
+    rcutils_get_error_string().str;
+  size_t expected = log_from_threads(2, 100);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+
+  EXPECT_EQ(expected, capture.lines().size());
+}
+#endif
+
+TEST(TestLoggingAsync, drop_policy_accounts_for_everything) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  StderrCapture capture;
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.queue_size = 4;
+  options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_DROP;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(&options));
+  size_t expected = log_from_threads(4, 500);
+  size_t dropped = rcutils_logging_get_async_dropped_count();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+
+  EXPECT_EQ(expected, capture.lines().size() + dropped);
+}
+
+TEST(TestLoggingAsync, overwrite_policy_keeps_newest) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  StderrCapture capture;
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.queue_size = 4;
+  options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_OVERWRITE_OLDEST;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(&options));
+  size_t expected = log_from_threads(1, 1000);
+  size_t dropped = rcutils_logging_get_async_dropped_count();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_async());
+
+  std::vector<std::string> lines = capture.lines();
+  EXPECT_EQ(expected, lines.size() + dropped);
+  // The newest record can never be overwritten.
+  ASSERT_FALSE(lines.empty());
+  EXPECT_NE(std::string::npos, lines.back().find("thread 0 message 999")) << lines.back();
+}
+
+TEST(TestLoggingAsync, records_larger_than_record_size) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  StderrCapture capture;
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.record_size = 16;
+  options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_async(&options));
+  std::string long_message(4000, 'x');
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_WARN, "async", "%s", long_message.c_str());
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_WARN, "async", "short");
+  // Shutdown must flush everything still queued.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+
+  std::vector<std::string> lines = capture.lines();
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_NE(std::string::npos, lines[0].find(long_message));
+  EXPECT_NE(std::string::npos, lines[1].find("[async]: short"));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+}
+#endif  // _WIN32
@@ -0,0 +1,282 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/allocator.h"
+#include "rcutils/env.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/snprintf.h"
+#include "rcutils/types/char_array.h"
+
+static std::string
+format_expected(const char * format, ...)
+// Only GCC checks the format, as the arguments can include long doubles.
+#if defined(__GNUC__) && !defined(__clang__)
+__attribute__((format(printf, 1, 2)))
+#endif
+;
+
+static std::string
+format_expected(const char * format, ...)
+{
+  char buffer[1024];
+  va_list args;
+  va_start(args, format);
+  int size = rcutils_vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  return size < 0 ? std::string() : std::string(buffer);
+}
+
+// Read the whole stream written by the binary mode.
+static std::string
+read_stream(FILE * stream)
+{
+  std::string data;
+  rewind(stream);
+  char buffer[4096];
+  size_t read = 0;
+  while ((read = fread(buffer, 1, sizeof(buffer), stream)) > 0) {
+    data.append(buffer, read);
+  }
+  return data;
+}
+
+// Return the messages of the records in data, formatted with the default output format.
+static std::vector<std::string>
+decode_messages(const std::string & data)
+{
+  std::vector<std::string> messages;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&output, 0, &allocator));
+  size_t offset = 0;
+  while (offset < data.size()) {
+    size_t record_size = 0;
+    rcutils_ret_t ret = rcutils_logging_binary_format_record(
+      data.data() + offset, data.size() - offset, &record_size, &output);
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    if (RCUTILS_RET_OK != ret) {
+      rcutils_reset_error();
+      break;
+    }
+    std::string line(output.buffer);
+    size_t position = line.find("]: ");
+    EXPECT_NE(std::string::npos, position) << line;
+    messages.push_back(std::string::npos != position ? line.substr(position + 3) : line);
+    offset += record_size;
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&output));
+  return messages;
+}
+
+#define LOG_AND_EXPECT(expected, ...) \
+  do { \
+    expected.push_back(format_expected(__VA_ARGS__)); \
+    rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "binary", __VA_ARGS__); \
+  } while (0)
+
+TEST(TestLoggingBinary, records_round_trip) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  FILE * stream = tmpfile();
+  ASSERT_NE(nullptr, stream);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    fclose(stream);
+  });
+
+  rcutils_logging_async_options_t options = rcutils_logging_get_default_async_options();
+  options.overflow_policy = RCUTILS_LOGGING_ASYNC_OVERFLOW_BLOCK;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_binary(&options, stream));
+  EXPECT_EQ(rcutils_logging_binary_output_handler, rcutils_logging_get_output_handler());
+
+  std::vector<std::string> expected;
+  int value = -42;
+  char not_terminated[3] = {'a', 'b', 'c'};
+  LOG_AND_EXPECT(expected, "no arguments");
+  LOG_AND_EXPECT(expected, "100%% %d", 42);
+  LOG_AND_EXPECT(expected, "%d %i %u %x %X %o %c", -1, 2, 3u, 0xabu, 0xcdu, 8u, 'z');
+  LOG_AND_EXPECT(expected, "%hhd %hd %hu", 1, -2, 3);
+  LOG_AND_EXPECT(expected, "%ld %lu %lld %llx", -1L, 2UL, LLONG_MIN, ULLONG_MAX);
+  LOG_AND_EXPECT(
+    expected, "%jd %ju %zu %td", INTMAX_MIN, UINTMAX_MAX, SIZE_MAX,
+    static_cast<ptrdiff_t>(-3));
+  LOG_AND_EXPECT(expected, "%f %.3e %g %10.4f|%-10.1f|", 3.25, -1e10, 0.0001, 2.5, 1.5);
+  LOG_AND_EXPECT(expected, "%Lf", static_cast<long double>(1.125));
+  LOG_AND_EXPECT(expected, "%*d|%-*d|%.*f", 6, 7, 4, 8, 2, 3.14159);
+  LOG_AND_EXPECT(expected, "[%s] [%10s] [%-6s] [%.2s]", "str", "right", "left", "truncated");
+  LOG_AND_EXPECT(expected, "[%.3s] [%.*s]", not_terminated, 2, not_terminated);
+  LOG_AND_EXPECT(expected, "%p", static_cast<void *>(&value));
+  LOG_AND_EXPECT(expected, "%+d % d %#x %05d", 1, 2, 3u, 4);
+  LOG_AND_EXPECT(expected, "empty [%s]", "");
+  // Wide strings can't be captured and are formatted right away instead.
+  LOG_AND_EXPECT(expected, "wide %ls %d", L"string", 5);
+
+  // String arguments are copied, rather than referenced.
+  char mutable_string[] = "before";
+  LOG_AND_EXPECT(expected, "copied %s", mutable_string);
+  snprintf(mutable_string, sizeof(mutable_string), "after");
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_binary());
+  EXPECT_EQ(0u, rcutils_logging_get_binary_dropped_count());
+  EXPECT_EQ(rcutils_logging_console_output_handler, rcutils_logging_get_output_handler());
+
+  std::vector<std::string> messages = decode_messages(read_stream(stream));
+  ASSERT_EQ(expected.size(), messages.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i], messages[i]);
+  }
+}
+
+TEST(TestLoggingBinary, records_keep_location_and_severity) {
+  ASSERT_TRUE(
+    rcutils_set_env(
+      "RCUTILS_CONSOLE_OUTPUT_FORMAT",
+      "[{severity}] [{time_as_nanoseconds}] [{name}] [{function_name}:{file_name}:{line_number}]: "
+      "{message}"));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_FORMAT", NULL));
+  });
+
+  FILE * stream = tmpfile();
+  ASSERT_NE(nullptr, stream);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    fclose(stream);
+  });
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_binary(NULL, stream));
+  rcutils_log_location_t location = {"function", "file.c", 17u};
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_WARN, "a.b", "value %d", 3);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_binary());
+
+  std::string data = read_stream(stream);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&output, 0, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&output));
+  });
+  size_t record_size = 0;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_binary_format_record(data.data(), data.size(), &record_size, &output));
+  EXPECT_EQ(data.size(), record_size);
+  std::string line(output.buffer);
+  EXPECT_EQ(0u, line.find("[WARN] [")) << line;
+  EXPECT_NE(std::string::npos, line.find("] [a.b] [function:file.c:17]: value 3")) << line;
+
+  // Truncated and corrupted records are rejected.
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_binary_format_record(data.data(), data.size() - 1, &record_size, &output));
+  rcutils_reset_error();
+  std::string corrupted = data;
+  corrupted[0] = 'X';
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_binary_format_record(
+      corrupted.data(), corrupted.size(), &record_size, &output));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_binary_format_record(NULL, data.size(), &record_size, &output));
+  rcutils_reset_error();
+}
+
+TEST(TestLoggingBinary, handler_without_binary_mode_forwards_to_console) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // Disabling when not enabled is a no-op.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_disable_binary());
+  EXPECT_EQ(0u, rcutils_logging_get_binary_dropped_count());
+
+  rcutils_logging_set_output_handler(rcutils_logging_binary_output_handler);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "binary", "forwarded %d", 1);
+
+  // Shutdown disables binary mode as well.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_enable_binary(NULL, NULL));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  EXPECT_EQ(rcutils_logging_console_output_handler, rcutils_logging_get_output_handler());
+}
+
+#ifndef _WIN32
+TEST(TestLoggingBinary, formatted_on_consumer_thread) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // The console output handler writes to stderr by default.
+  fflush(stderr);
+  FILE * capture = tmpfile();
+  ASSERT_NE(nullptr, capture);
+  int saved_fd = dup(fileno(stderr));
+  ASSERT_LE(0, saved_fd);
+  dup2(fileno(capture), fileno(stderr));
+
+  rcutils_ret_t ret = rcutils_logging_enable_binary(NULL, NULL);
+  if (RCUTILS_RET_OK == ret) {
+    for (int i = 0; i < 10; ++i) {
+      rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "binary", "message %d of %s", i, "ten");
+    }
+    ret = rcutils_logging_disable_binary();
+  }
+
+  fflush(stderr);
+  dup2(saved_fd, fileno(stderr));
+  close(saved_fd);
+  std::string output = read_stream(capture);
+  fclose(capture);
+
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  size_t position = 0;
+  for (int i = 0; i < 10; ++i) {
+    std::string expected = "[binary]: message " + std::to_string(i) + " of ten\n";
+    size_t found = output.find(expected, position);
+    ASSERT_NE(std::string::npos, found) << output;
+    position = found + expected.size();
+  }
+}
+#endif
@@ -0,0 +1,135 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS \
+  {"noisy", RCUTILS_LOG_MIN_SEVERITY_NONE}, \
+  {"noisy.kept", RCUTILS_LOG_MIN_SEVERITY_DEBUG}, \
+  {"quiet", RCUTILS_LOG_MIN_SEVERITY_WARN}
+
+#include "rcutils/logging_format.hpp"
+#include "rcutils/logging_macros.h"
+
+namespace
+{
+
+std::vector<std::string> g_messages;
+
+constexpr rcutils_logging_logger_min_severity_t g_min_severities[] = {
+  RCUTILS_LOG_MIN_SEVERITY_FOR_LOGGERS};
+
+constexpr bool is_compiled_out(const char * name, int severity)
+{
+  return rcutils_logging_constexpr_is_compiled_out(
+    name, rcutils_logging_constexpr_name_length(name, SIZE_MAX), severity, g_min_severities);
+}
+
+}  // namespace
+
+static_assert(is_compiled_out("noisy", RCUTILS_LOG_SEVERITY_FATAL), "all severities");
+static_assert(is_compiled_out("noisy.child", RCUTILS_LOG_SEVERITY_ERROR), "descendant");
+static_assert(!is_compiled_out("noisy_other", RCUTILS_LOG_SEVERITY_DEBUG), "not a descendant");
+static_assert(!is_compiled_out("noisy.kept", RCUTILS_LOG_SEVERITY_DEBUG), "longest prefix");
+static_assert(!is_compiled_out("noisy.kept.child", RCUTILS_LOG_SEVERITY_DEBUG), "longest prefix");
+static_assert(is_compiled_out("quiet", RCUTILS_LOG_SEVERITY_INFO), "below WARN");
+static_assert(!is_compiled_out("quiet", RCUTILS_LOG_SEVERITY_WARN), "WARN");
+static_assert(!is_compiled_out("", RCUTILS_LOG_SEVERITY_DEBUG), "other loggers");
+
+class TestLoggingCompileTimeFilter : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    g_messages.clear();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+    rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_DEBUG);
+
+    auto output_handler = [](
+      const rcutils_log_location_t * location,
+      int level, const char * name, rcutils_time_point_value_t timestamp,
+      const char * format, va_list * args) -> void
+      {
+        (void)location;
+        (void)level;
+        (void)name;
+        (void)timestamp;
+        char buffer[1024];
+        vsnprintf(buffer, sizeof(buffer), format, *args);
+        g_messages.push_back(buffer);
+      };
+    rcutils_logging_set_output_handler(output_handler);
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  }
+};
+
+TEST_F(TestLoggingCompileTimeFilter, named) {
+  int evaluations = 0;
+  auto evaluate = [&evaluations]() {
+      return ++evaluations;
+    };
+  RCUTILS_LOG_FATAL_NAMED("noisy", "noisy %d", evaluate());
+  RCUTILS_LOG_ERROR_NAMED("noisy.child", "noisy.child %d", evaluate());
+  RCUTILS_LOG_DEBUG_NAMED("noisy_other", "noisy_other");
+  RCUTILS_LOG_DEBUG_NAMED("noisy.kept", "noisy.kept");
+  RCUTILS_LOG_INFO_NAMED("noisy.kept.child", "noisy.kept.child");
+  RCUTILS_LOG_INFO_NAMED("quiet", "quiet info %d", evaluate());
+  RCUTILS_LOG_WARN_NAMED("quiet", "quiet warn");
+  RCUTILS_LOG_DEBUG("unnamed");
+  EXPECT_EQ(0, evaluations);
+  EXPECT_EQ(
+    std::vector<std::string>({
+    "noisy_other", "noisy.kept", "noisy.kept.child", "quiet warn", "unnamed"}),
+    g_messages);
+}
+
+TEST_F(TestLoggingCompileTimeFilter, conditions) {
+  for (int i = 0; i < 3; ++i) {
+    RCUTILS_LOG_ERROR_ONCE_NAMED("noisy", "once");
+    RCUTILS_LOG_ERROR_EXPRESSION_NAMED(true, "noisy", "expression");
+    RCUTILS_LOG_WARN_SKIPFIRST_NAMED("quiet", "skipfirst");
+  }
+  EXPECT_EQ(std::vector<std::string>({"skipfirst", "skipfirst"}), g_messages);
+}
+
+TEST_F(TestLoggingCompileTimeFilter, format) {
+  int evaluations = 0;
+  auto evaluate = [&evaluations]() {
+      return ++evaluations;
+    };
+  RCUTILS_LOG_ERROR_FMT_NAMED("noisy", "noisy {}", evaluate());
+  RCUTILS_LOG_DEBUG_FMT_NAMED("noisy.kept", "noisy.kept {}", evaluate());
+  EXPECT_EQ(1, evaluations);
+  EXPECT_EQ(std::vector<std::string>({"noisy.kept 1"}), g_messages);
+}
+
+// Logger names which aren't string literals are only filtered at runtime.
+TEST_F(TestLoggingCompileTimeFilter, runtime_name) {
+  const char * name = "noisy";
+  const std::string string_name = "quiet";
+  RCUTILS_LOG_INFO_NAMED(name, "runtime name");
+  RCUTILS_LOG_INFO_NAMED(string_name.c_str(), "runtime string name");
+  EXPECT_EQ(
+    std::vector<std::string>({"runtime name", "runtime string name"}), g_messages);
+}
@@ -14,10 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "./allocator_testing_utils.h"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/env.h"
 #include "rcutils/logging.h"
 
 static void call_handler(
@@ -95,3 +99,249 @@ TEST(TestLoggingConsoleOutputHandler, bad_inputs) {
   call_handler(
     &log_location, RCUTILS_LOG_SEVERITY_INFO, log_name, timestamp, "bad format", "part1", "part2");
 }
+
+// Messages of growing sizes from several threads, which each reuse their own output buffer.
+// This is a smoke test as well, to be run with tools checking for memory errors and leaks.
+TEST(TestLoggingConsoleOutputHandler, long_messages_from_threads) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  auto log_messages = []() {
+      rcutils_log_location_t log_location = {"test_function", "test_file", 1};
+      for (size_t length : {10u, 2000u, 100u, 70000u, 10u}) {
+        std::string message(length, 'x');
+        call_handler(
+          &log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", 1, "%s %zu",
+          message.c_str(), length);
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back(log_messages);
+  }
+  log_messages();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  // The buffer of this thread is released on shutdown and created again afterwards.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  log_messages();
+}
+
+// Once the buffers of a thread grew for long messages, the next ones don't allocate, also when
+// the sink output handler formats into one buffer and the console sink into another.
+TEST(TestLoggingConsoleOutputHandler, long_messages_reuse_buffers) {
+  rcutils_allocator_t allocator = get_counting_allocator();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize_with_allocator(allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  rcutils_log_location_t log_location = {"test_function", "test_file", 1};
+  const std::string long_message(3000u, 'x');
+  auto log_long_messages = [&]() {
+      rcutils_log(
+        &log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", "%s", long_message.c_str());
+      rcutils_log_string(
+        &log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", long_message.c_str(),
+        long_message.size());
+    };
+  log_long_messages();
+  reset_counting_allocator_allocations(allocator);
+  log_long_messages();
+  EXPECT_EQ(0u, get_counting_allocator_allocations(allocator));
+
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(rcutils_logging_console_sink, nullptr, RCUTILS_LOG_SEVERITY_INFO));
+  log_long_messages();
+  reset_counting_allocator_allocations(allocator);
+  log_long_messages();
+  EXPECT_EQ(0u, get_counting_allocator_allocations(allocator));
+}
+
+// The console sink writes preformatted messages, the same way the handler writes formatted ones.
+// This is a smoke test as well, since there are no outputs besides the fprintf() calls.
+TEST(TestLoggingConsoleOutputHandler, console_sink) {
+  rcutils_log_location_t log_location = {
+    "test_function",
+    "test_file",
+    1,
+  };
+  // Check !g_rcutils_logging_initialized
+  rcutils_logging_console_sink(
+    &log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", 1, "message", nullptr);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // The message isn't used as a format string.
+  rcutils_logging_console_sink(
+    &log_location, RCUTILS_LOG_SEVERITY_WARN, "test_name", 1, "100% %s %d", nullptr);
+  rcutils_logging_console_sink(
+    nullptr, RCUTILS_LOG_SEVERITY_UNSET, "test_name", 1, "message", nullptr);
+
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(rcutils_logging_console_sink, nullptr, RCUTILS_LOG_SEVERITY_INFO));
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", "%s - %s", "part1", "part2");
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_DEBUG, "test_name", "not %s", "written");
+}
+
+// Written as is, an already formatted message takes as many bytes as when formatted by "%s".
+TEST(TestLoggingConsoleOutputHandler, string_output_handler) {
+  rcutils_log_location_t log_location = {"test_function", "test_file", 1};
+  // Check !g_rcutils_logging_initialized
+  rcutils_logging_console_string_output_handler(
+    &log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", 1, "message", 7u);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_logging_disable_statistics();
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_enable_statistics();
+
+  // The message isn't used as a format string, and only its given length is written.
+  const char message[] = "100% %s %d and more";
+  rcutils_logging_reset_statistics();
+  call_handler(&log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", 1, "%s", "100% %s %d");
+  rcutils_logging_statistics_t formatted_statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&formatted_statistics));
+
+  rcutils_logging_reset_statistics();
+  rcutils_logging_console_string_output_handler(
+    &log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", 1, message, 10u);
+  rcutils_logging_statistics_t statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(formatted_statistics.bytes_written, statistics.bytes_written);
+
+  rcutils_logging_reset_statistics();
+  rcutils_log_string(&log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", message, 10u);
+  rcutils_log_string(&log_location, RCUTILS_LOG_SEVERITY_DEBUG, "test_name", message, 10u);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(formatted_statistics.bytes_written, statistics.bytes_written);
+  EXPECT_EQ(1u, statistics.messages[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(1u, statistics.filtered_messages);
+
+  // Long messages go to the heap like formatted ones.
+  const std::string long_message(2000u, 'x');
+  rcutils_log_string(
+    &log_location, RCUTILS_LOG_SEVERITY_WARN, "test_name", long_message.c_str(),
+    long_message.size());
+  rcutils_log_string(&log_location, RCUTILS_LOG_SEVERITY_WARN, "test_name", nullptr, 0u);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(2u, statistics.messages[RCUTILS_LOG_SEVERITY_WARN / 10]);
+  EXPECT_GE(statistics.bytes_written, formatted_statistics.bytes_written + long_message.size());
+}
+
+TEST(TestLoggingConsoleOutputHandler, statistics) {
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_get_statistics(nullptr));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_logging_disable_statistics();
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_enable_statistics();
+  rcutils_logging_reset_statistics();
+
+  rcutils_log_location_t log_location = {"test_function", "test_file", 1};
+  const std::string long_message(2000u, 'x');
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", "short");
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_WARN, "test_name", "%s", long_message.c_str());
+  // The buffer of this thread grew for the first long message and is reused now.
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_WARN, "test_name", "%s", long_message.c_str());
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_DEBUG, "test_name", "filtered");
+  static rcutils_log_callsite_cache_t cache = RCUTILS_LOG_CALLSITE_CACHE_INITIALIZER;
+  for (int i = 0; i < 3; ++i) {
+    // Resolved the first time, and taken from the cache afterwards.
+    EXPECT_FALSE(
+      rcutils_logging_callsite_is_enabled_for(&cache, "test_name", RCUTILS_LOG_SEVERITY_DEBUG));
+  }
+  // Only checking a logger doesn't count as filtering a message.
+  EXPECT_FALSE(rcutils_logging_logger_is_enabled_for("test_name", RCUTILS_LOG_SEVERITY_DEBUG));
+
+  rcutils_logging_statistics_t statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(0u, statistics.messages[RCUTILS_LOG_SEVERITY_DEBUG / 10]);
+  EXPECT_EQ(1u, statistics.messages[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(2u, statistics.messages[RCUTILS_LOG_SEVERITY_WARN / 10]);
+  EXPECT_EQ(4u, statistics.filtered_messages);
+  EXPECT_GE(statistics.bytes_written, 2 * long_message.size() + strlen("short") + 3);
+  EXPECT_EQ(1u, statistics.large_message_allocations);
+  EXPECT_EQ(0u, statistics.async_dropped_messages);
+  uint64_t handled_messages = 0u;
+  for (uint64_t count : statistics.output_handler_duration_histogram) {
+    handled_messages += count;
+  }
+  EXPECT_EQ(3u, handled_messages);
+
+  // Nothing is counted while disabled, and the statistics are kept.
+  rcutils_logging_disable_statistics();
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_INFO, "test_name", "short");
+  rcutils_log(&log_location, RCUTILS_LOG_SEVERITY_DEBUG, "test_name", "filtered");
+  rcutils_logging_statistics_t unchanged_statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&unchanged_statistics));
+  EXPECT_EQ(1u, unchanged_statistics.messages[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(4u, unchanged_statistics.filtered_messages);
+  EXPECT_EQ(statistics.bytes_written, unchanged_statistics.bytes_written);
+
+  rcutils_logging_reset_statistics();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(0u, statistics.messages[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(0u, statistics.filtered_messages);
+  EXPECT_EQ(0u, statistics.bytes_written);
+}
+
+// Measure the bytes written for a message, with the colors given by RCUTILS_COLORIZED_OUTPUT.
+static uint64_t get_bytes_written(const char * colorized_output, int severity)
+{
+  EXPECT_TRUE(rcutils_set_env("RCUTILS_COLORIZED_OUTPUT", colorized_output));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_logging_disable_statistics();
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    EXPECT_TRUE(rcutils_set_env("RCUTILS_COLORIZED_OUTPUT", nullptr));
+  });
+  rcutils_logging_enable_statistics();
+  rcutils_logging_reset_statistics();
+
+  rcutils_log_location_t log_location = {"test_function", "test_file", 1};
+  call_handler(&log_location, severity, "test_name", 0, "%s", "colors");
+
+  rcutils_logging_statistics_t statistics;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  return statistics.bytes_written;
+}
+
+TEST(TestLoggingConsoleOutputHandler, colorized_output) {
+  const uint64_t plain_warn_bytes = get_bytes_written("0", RCUTILS_LOG_SEVERITY_WARN);
+  const uint64_t plain_error_bytes = get_bytes_written("0", RCUTILS_LOG_SEVERITY_ERROR);
+  EXPECT_GT(plain_warn_bytes, strlen("colors"));
+#ifndef _WIN32
+  // The escape sequences setting and resetting the color are part of the single written line.
+  EXPECT_EQ(
+    plain_warn_bytes + strlen("\033[33m") + strlen("\033[0m"),
+    get_bytes_written("1", RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_EQ(
+    plain_error_bytes + strlen("\033[31m") + strlen("\033[0m"),
+    get_bytes_written("1", RCUTILS_LOG_SEVERITY_ERROR));
+#endif
+}
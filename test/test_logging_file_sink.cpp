@@ -0,0 +1,461 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/allocator.h"
+#include "rcutils/async_write.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/filesystem.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_file_sink.h"
+
+static const char * const g_log_path = "test_logging_file_sink.log";
+
+static std::string rotated_path(size_t index)
+{
+  return std::string(g_log_path) + "." + std::to_string(index);
+}
+
+static void remove_log_files()
+{
+  std::remove(g_log_path);
+  for (size_t i = 1; i <= 4; ++i) {
+    std::remove(rotated_path(i).c_str());
+  }
+}
+
+static std::string read_file(const std::string & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+static std::vector<std::string> split_lines(const std::string & contents)
+{
+  std::vector<std::string> lines;
+  std::string::size_type start = 0;
+  std::string::size_type end;
+  while ((end = contents.find('\n', start)) != std::string::npos) {
+    lines.push_back(contents.substr(start, end - start));
+    start = end + 1;
+  }
+  EXPECT_EQ(contents.size(), start) << "the file doesn't end with a whole line";
+  return lines;
+}
+
+static uint32_t read_le32(const std::string & data, size_t position)
+{
+  uint32_t value = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(static_cast<unsigned char>(data[position + i])) << (8 * i);
+  }
+  return value;
+}
+
+// Decompress a sequence of LZ4 frames, as written by the file sink.
+static std::string decompress_lz4_frames(const std::string & data)
+{
+  std::string output;
+  size_t position = 0;
+  while (position < data.size()) {
+    EXPECT_EQ(0x184D2204u, read_le32(data, position));
+    // Independent blocks, without checksums nor content size.
+    EXPECT_EQ(0x60, data[position + 4]);
+    position += 7;
+    for (;;) {
+      uint32_t block_size = read_le32(data, position);
+      position += 4;
+      if (0u == block_size) {
+        break;
+      }
+      if (0u != (block_size & 0x80000000u)) {
+        block_size &= 0x7fffffffu;
+        output.append(data, position, block_size);
+        position += block_size;
+        continue;
+      }
+      const size_t block_start = output.size();
+      const size_t block_end = position + block_size;
+      while (position < block_end) {
+        const unsigned char token = static_cast<unsigned char>(data[position++]);
+        size_t literal_length = token >> 4;
+        if (15u == literal_length) {
+          unsigned char extra;
+          do {
+            extra = static_cast<unsigned char>(data[position++]);
+            literal_length += extra;
+          } while (255u == extra);
+        }
+        output.append(data, position, literal_length);
+        position += literal_length;
+        if (position >= block_end) {
+          break;
+        }
+        size_t offset = static_cast<unsigned char>(data[position]) |
+          static_cast<size_t>(static_cast<unsigned char>(data[position + 1])) << 8;
+        position += 2;
+        size_t match_length = (token & 15u) + 4u;
+        if (19u == match_length) {
+          unsigned char extra;
+          do {
+            extra = static_cast<unsigned char>(data[position++]);
+            match_length += extra;
+          } while (255u == extra);
+        }
+        EXPECT_LT(0u, offset);
+        EXPECT_LE(block_start + offset, output.size()) << "the match is outside of the block";
+        if (0u == offset || block_start + offset > output.size()) {
+          return output;
+        }
+        // Matches may overlap what they copy.
+        for (size_t i = 0; i < match_length; ++i) {
+          output.push_back(output[output.size() - offset]);
+        }
+      }
+      EXPECT_EQ(block_end, position);
+    }
+  }
+  return output;
+}
+
+class TestLoggingFileSink : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    remove_log_files();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+    rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+    options = rcutils_logging_file_sink_get_default_options();
+    options.path = g_log_path;
+  }
+
+  void TearDown() override
+  {
+    if (nullptr != sink) {
+      EXPECT_EQ(
+        RCUTILS_RET_OK, rcutils_logging_remove_sink(rcutils_logging_file_sink_output, sink));
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_file_sink_fini(sink));
+    }
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    remove_log_files();
+  }
+
+  void start()
+  {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_file_sink_init(&sink, &options, rcutils_get_default_allocator()));
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_add_sink(rcutils_logging_file_sink_output, sink, RCUTILS_LOG_SEVERITY_INFO));
+  }
+
+  void stop()
+  {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_remove_sink(rcutils_logging_file_sink_output, sink));
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_file_sink_fini(sink));
+    sink = nullptr;
+  }
+
+  rcutils_logging_file_sink_options_t options;
+  rcutils_logging_file_sink_t * sink = nullptr;
+};
+
+TEST_F(TestLoggingFileSink, invalid_options) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_logging_file_sink_t * invalid_sink = nullptr;
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(nullptr, &options, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(&invalid_sink, nullptr, allocator));
+  rcutils_reset_error();
+
+  rcutils_logging_file_sink_options_t invalid = options;
+  invalid.path = nullptr;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(&invalid_sink, &invalid, allocator));
+  rcutils_reset_error();
+
+  invalid = options;
+  invalid.buffer_count = 1;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(&invalid_sink, &invalid, allocator));
+  rcutils_reset_error();
+
+  invalid = options;
+  invalid.buffer_size = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(&invalid_sink, &invalid, allocator));
+  rcutils_reset_error();
+
+  invalid = options;
+  invalid.fsync_policy = static_cast<rcutils_logging_file_sink_fsync_policy_t>(3);
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(&invalid_sink, &invalid, allocator));
+  rcutils_reset_error();
+
+  invalid = options;
+  int invalid_compression = 2;
+  invalid.compression = static_cast<rcutils_logging_file_sink_compression_t>(invalid_compression);
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_file_sink_init(&invalid_sink, &invalid, allocator));
+  rcutils_reset_error();
+
+  invalid = options;
+  invalid.path = "nonexistent_directory/test_logging_file_sink.log";
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_file_sink_init(&invalid_sink, &invalid, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, invalid_sink);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_file_sink_flush(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_file_sink_fini(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_logging_file_sink_get_lost_bytes(nullptr));
+}
+
+TEST_F(TestLoggingFileSink, writes_formatted_lines) {
+  options.fsync_policy = RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_WRITE;
+  start();
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "message %d", 1);
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_DEBUG, "file", "filtered out");
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_ERROR, "file", "message %d", 2);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_file_sink_flush(sink));
+
+  std::vector<std::string> lines = split_lines(read_file(g_log_path));
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_EQ(0u, lines[0].find("[INFO] [")) << lines[0];
+  EXPECT_NE(std::string::npos, lines[0].find("[file]: message 1")) << lines[0];
+  EXPECT_EQ(0u, lines[1].find("[ERROR] [")) << lines[1];
+  EXPECT_NE(std::string::npos, lines[1].find("[file]: message 2")) << lines[1];
+
+  // Reopening the file appends to it.
+  stop();
+  start();
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_WARN, "file", "message %d", 3);
+  stop();
+  lines = split_lines(read_file(g_log_path));
+  ASSERT_EQ(3u, lines.size());
+  EXPECT_NE(std::string::npos, lines[2].find("[file]: message 3")) << lines[2];
+  EXPECT_EQ(0u, split_lines(read_file(rotated_path(1))).size());
+}
+
+TEST_F(TestLoggingFileSink, lines_longer_than_a_buffer) {
+  options.buffer_size = 1;
+  options.buffer_count = 2;
+  start();
+  // A page is at most 64 KiB.
+  const std::string long_message(200000, 'x');
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "%s", long_message.c_str());
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "short");
+  stop();
+
+  std::vector<std::string> lines = split_lines(read_file(g_log_path));
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_NE(std::string::npos, lines[0].find("[file]: " + long_message));
+  EXPECT_NE(std::string::npos, lines[1].find("[file]: short")) << lines[1];
+}
+
+TEST_F(TestLoggingFileSink, rotates_by_size) {
+  options.buffer_size = 1;
+  options.max_file_size = 500;
+  options.max_files = 2;
+  options.fsync_policy = RCUTILS_LOGGING_FILE_SINK_FSYNC_ON_CLOSE;
+  start();
+  const size_t message_count = 100;
+  for (size_t i = 0; i < message_count; ++i) {
+    rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "rotating message %zu", i);
+  }
+  stop();
+  EXPECT_FALSE(rcutils_exists(rotated_path(3).c_str()));
+
+  // The newest messages are kept, in order, as whole lines in files within the size limit.
+  std::vector<std::string> kept;
+  for (const std::string & path : {rotated_path(2), rotated_path(1), std::string(g_log_path)}) {
+    std::string contents = read_file(path);
+    EXPECT_GE(500u, contents.size()) << path;
+    std::vector<std::string> lines = split_lines(contents);
+    EXPECT_LT(0u, lines.size()) << path;
+    kept.insert(kept.end(), lines.begin(), lines.end());
+  }
+  ASSERT_LT(0u, kept.size());
+  ASSERT_GT(message_count, kept.size());
+  for (size_t i = 0; i < kept.size(); ++i) {
+    std::string expected =
+      "[file]: rotating message " + std::to_string(message_count - kept.size() + i);
+    EXPECT_NE(std::string::npos, kept[i].find(expected)) << kept[i];
+  }
+}
+
+TEST_F(TestLoggingFileSink, rotates_by_age) {
+  options.max_file_age = RCUTILS_S_TO_NS(10);
+  options.max_files = 1;
+  start();
+  rcutils_log_location_t location = {"function", "file", 1u};
+  rcutils_time_point_value_t now = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_system_time_now(&now));
+  // Call the sink directly to control the timestamps.
+  rcutils_logging_file_sink_output(&location, RCUTILS_LOG_SEVERITY_INFO, "file", now, "a", sink);
+  rcutils_logging_file_sink_output(
+    &location, RCUTILS_LOG_SEVERITY_INFO, "file", now + RCUTILS_S_TO_NS(5), "b", sink);
+  rcutils_logging_file_sink_output(
+    &location, RCUTILS_LOG_SEVERITY_INFO, "file", now + RCUTILS_S_TO_NS(11), "c", sink);
+  stop();
+
+  std::vector<std::string> rotated = split_lines(read_file(rotated_path(1)));
+  ASSERT_EQ(2u, rotated.size());
+  EXPECT_NE(std::string::npos, rotated[0].find("[file]: a")) << rotated[0];
+  EXPECT_NE(std::string::npos, rotated[1].find("[file]: b")) << rotated[1];
+  std::vector<std::string> current = split_lines(read_file(g_log_path));
+  ASSERT_EQ(1u, current.size());
+  EXPECT_NE(std::string::npos, current[0].find("[file]: c")) << current[0];
+}
+
+TEST_F(TestLoggingFileSink, concurrent_logging) {
+  options.buffer_size = 1;
+  options.buffer_count = 2;
+  start();
+  const size_t thread_count = 4;
+  const size_t messages_per_thread = 500;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back(
+      [t, messages_per_thread]() {
+        for (size_t i = 0; i < messages_per_thread; ++i) {
+          rcutils_log(
+            nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "thread %zu message %zu", t, i);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  stop();
+
+  std::vector<std::string> lines = split_lines(read_file(g_log_path));
+  EXPECT_EQ(thread_count * messages_per_thread, lines.size());
+  for (const auto & line : lines) {
+    EXPECT_NE(std::string::npos, line.find("[file]: thread ")) << line;
+  }
+}
+
+TEST_F(TestLoggingFileSink, async_writes) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_async_writer_t writer = rcutils_get_zero_initialized_async_writer();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_writer_init(&writer, NULL, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_writer_fini(&writer));
+  });
+
+  // The file is appended to even though it is written at offsets.
+  {
+    std::ofstream file(g_log_path, std::ios::binary);
+    file << "existing line\n";
+  }
+  options.async_writer = &writer;
+  options.buffer_size = 1;
+  options.buffer_count = 3;
+  options.max_file_size = 20000;
+  options.max_files = 1;
+  start();
+  // Several buffers of messages, which are written in order despite being in flight at once.
+  const size_t message_count = 600;
+  for (size_t i = 0; i < message_count; ++i) {
+    rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "async message %zu", i);
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_file_sink_flush(sink));
+  EXPECT_EQ(0u, rcutils_logging_file_sink_get_lost_bytes(sink));
+  stop();
+
+  std::vector<std::string> kept;
+  for (const std::string & path : {rotated_path(1), std::string(g_log_path)}) {
+    std::string contents = read_file(path);
+    EXPECT_GE(20000u, contents.size()) << path;
+    std::vector<std::string> lines = split_lines(contents);
+    kept.insert(kept.end(), lines.begin(), lines.end());
+  }
+  // Both files hold all the messages, after the line of the existing file.
+  ASSERT_EQ(message_count + 1, kept.size());
+  EXPECT_EQ("existing line", kept[0]);
+  for (size_t i = 0; i < message_count; ++i) {
+    std::string expected = "[file]: async message " + std::to_string(i);
+    EXPECT_NE(std::string::npos, kept[i + 1].find(expected)) << kept[i + 1];
+  }
+}
+
+TEST_F(TestLoggingFileSink, compresses_with_lz4) {
+  options.compression = RCUTILS_LOGGING_FILE_SINK_COMPRESSION_LZ4;
+  options.buffer_size = 1;
+  start();
+  const size_t message_count = 2000;
+  for (size_t i = 0; i < message_count; ++i) {
+    rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "compressed message %zu", i);
+  }
+  // Each flush writes a frame which can be read on its own.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_file_sink_flush(sink));
+  std::string flushed = decompress_lz4_frames(read_file(g_log_path));
+  EXPECT_EQ(message_count, split_lines(flushed).size());
+
+  // Data which doesn't compress is stored in blocks as it is, and long lines span blocks.
+  std::string noise(100000, ' ');
+  uint32_t state = 1;
+  for (char & c : noise) {
+    state = state * 1103515245u + 12345u;
+    c = static_cast<char>('!' + (state >> 16) % 90);
+  }
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "%s", noise.c_str());
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "file", "last");
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_file_sink_flush(sink));
+  EXPECT_EQ(0u, rcutils_logging_file_sink_get_lost_bytes(sink));
+  stop();
+
+  std::string compressed = read_file(g_log_path);
+  std::string contents = decompress_lz4_frames(compressed);
+  EXPECT_EQ(0u, contents.find(flushed));
+  std::vector<std::string> lines = split_lines(contents);
+  ASSERT_EQ(message_count + 2, lines.size());
+  for (size_t i = 0; i < message_count; ++i) {
+    EXPECT_NE(
+      std::string::npos, lines[i].find("[file]: compressed message " + std::to_string(i)))
+      << lines[i];
+  }
+  EXPECT_NE(std::string::npos, lines[message_count].find("[file]: " + noise));
+  EXPECT_NE(std::string::npos, lines[message_count + 1].find("[file]: last"));
+  EXPECT_GT(contents.size() - noise.size() / 2, compressed.size());
+}
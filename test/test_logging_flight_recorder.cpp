@@ -0,0 +1,223 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_flight_recorder.h"
+
+#ifdef _WIN32
+# define fileno _fileno
+#endif
+
+class TestLoggingFlightRecorder : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    options = rcutils_logging_flight_recorder_get_default_options();
+  }
+
+  void TearDown() override
+  {
+    if (nullptr != recorder) {
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_flight_recorder_fini(recorder));
+    }
+  }
+
+  void init()
+  {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_flight_recorder_init(&recorder, &options, rcutils_get_default_allocator()));
+  }
+
+  void record(int severity, const char * name, int64_t timestamp, const char * message)
+  {
+    rcutils_logging_flight_recorder_output(
+      nullptr, severity, name, timestamp, message, recorder);
+  }
+
+  // Dump the recorder into a temporary file and return its contents.
+  std::string dump()
+  {
+    FILE * file = std::tmpfile();
+    EXPECT_NE(nullptr, file);
+    if (nullptr == file) {
+      return "";
+    }
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_flight_recorder_dump(recorder, fileno(file)));
+    std::string contents;
+    std::rewind(file);
+    char buffer[256];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      contents.append(buffer, read);
+    }
+    std::fclose(file);
+    return contents;
+  }
+
+  rcutils_logging_flight_recorder_options_t options;
+  rcutils_logging_flight_recorder_t * recorder = nullptr;
+};
+
+TEST_F(TestLoggingFlightRecorder, invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_flight_recorder_init(nullptr, &options, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_flight_recorder_init(&recorder, nullptr, allocator));
+  rcutils_reset_error();
+  options.record_count = 0u;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_flight_recorder_init(&recorder, &options, allocator));
+  rcutils_reset_error();
+  options = rcutils_logging_flight_recorder_get_default_options();
+  options.max_threads = 0u;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_flight_recorder_init(&recorder, &options, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, recorder);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_flight_recorder_dump(nullptr, 2));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_flight_recorder_fini(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_logging_flight_recorder_get_dropped_records(nullptr));
+  // Without a context the sink does nothing.
+  rcutils_logging_flight_recorder_output(
+    nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", 0, "message", nullptr);
+}
+
+TEST_F(TestLoggingFlightRecorder, dump_formats_lines) {
+  init();
+  EXPECT_EQ("", dump());
+
+  record(RCUTILS_LOG_SEVERITY_WARN, "node", RCUTILS_MS_TO_NS(1500), "Hello");
+  record(RCUTILS_LOG_SEVERITY_ERROR, "", 7, "");
+  record(RCUTILS_LOG_SEVERITY_INFO, nullptr, -RCUTILS_MS_TO_NS(1500), "before the epoch");
+  record(35, "odd", 0, "severity");
+  // The records of a thread are dumped in the order they were recorded, whatever the timestamps.
+  EXPECT_EQ(
+    "[WARN] [0000000001.500000000] [node]: Hello\n"
+    "[ERROR] [0000000000.000000007] []: \n"
+    "[INFO] [-0000000001.500000000] []: before the epoch\n"
+    "[35] [0000000000.000000000] [odd]: severity\n",
+    dump());
+  // Dumping doesn't consume the records.
+  std::string contents = dump();
+  EXPECT_EQ(4, std::count(contents.begin(), contents.end(), '\n'));
+}
+
+TEST_F(TestLoggingFlightRecorder, keeps_the_last_records) {
+  options.record_count = 3u;
+  options.record_size = 8u;
+  init();
+
+  for (int i = 0; i < 5; ++i) {
+    std::string message = "message " + std::to_string(i);
+    record(RCUTILS_LOG_SEVERITY_INFO, "n", i, message.c_str());
+  }
+  // The logger name and the message share the record size.
+  EXPECT_EQ(
+    "[INFO] [0000000000.000000002] [n]: message\n"
+    "[INFO] [0000000000.000000003] [n]: message\n"
+    "[INFO] [0000000000.000000004] [n]: message\n",
+    dump());
+
+  record(RCUTILS_LOG_SEVERITY_INFO, "a long logger name", 5, "message");
+  EXPECT_EQ(
+    "[INFO] [0000000000.000000003] [n]: message\n"
+    "[INFO] [0000000000.000000004] [n]: message\n"
+    "[INFO] [0000000000.000000005] [a long l]: \n",
+    dump());
+  EXPECT_EQ(0u, rcutils_logging_flight_recorder_get_dropped_records(recorder));
+}
+
+TEST_F(TestLoggingFlightRecorder, merges_threads) {
+  options.record_count = 4u;
+  options.max_threads = 3u;
+  init();
+
+  // Each thread records every third timestamp, so the dump interleaves them.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back(
+      [this, t]() {
+        for (int i = 0; i < 4; ++i) {
+          std::string message = std::to_string(t);
+          record(RCUTILS_LOG_SEVERITY_INFO, "thread", i * 3 + t, message.c_str());
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  // The records of threads which exited are kept, but there is no ring left for another one.
+  std::thread extra(
+    [this]() {
+      record(RCUTILS_LOG_SEVERITY_INFO, "thread", 100, "dropped");
+    });
+  extra.join();
+  EXPECT_EQ(1u, rcutils_logging_flight_recorder_get_dropped_records(recorder));
+
+  std::string expected;
+  for (int i = 0; i < 12; ++i) {
+    char line[64];
+    std::snprintf(
+      line, sizeof(line), "[INFO] [0000000000.%09d] [thread]: %d\n", i, i % 3);
+    expected += line;
+  }
+  EXPECT_EQ(expected, dump());
+}
+
+TEST_F(TestLoggingFlightRecorder, sink) {
+  options.record_count = 2u;
+  init();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(
+      rcutils_logging_flight_recorder_output, recorder, RCUTILS_LOG_SEVERITY_WARN));
+
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_INFO, "node", "filtered");
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_WARN, "node", "recorded %d", 1);
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "node", "recorded %d", 2);
+
+  std::string contents = dump();
+  EXPECT_EQ(std::string::npos, contents.find("filtered"));
+  EXPECT_NE(std::string::npos, contents.find("[WARN] ["));
+  EXPECT_NE(std::string::npos, contents.find("] [node]: recorded 1\n"));
+  EXPECT_NE(std::string::npos, contents.find("] [node]: recorded 2\n"));
+
+  EXPECT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_remove_sink(rcutils_logging_flight_recorder_output, recorder));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+}
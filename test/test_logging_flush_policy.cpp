@@ -0,0 +1,152 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#ifndef _WIN32
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+
+#ifndef _WIN32
+// Redirects stdout to a temporary file, whose size tells what was flushed to it.
+class StdoutCapture
+{
+public:
+  StdoutCapture()
+  {
+    fflush(stdout);
+    file_ = tmpfile();
+    if (nullptr != file_) {
+      saved_fd_ = dup(fileno(stdout));
+      dup2(fileno(file_), fileno(stdout));
+    }
+  }
+
+  ~StdoutCapture()
+  {
+    if (nullptr != file_) {
+      fflush(stdout);
+      dup2(saved_fd_, fileno(stdout));
+      close(saved_fd_);
+      fclose(file_);
+    }
+  }
+
+  bool is_valid() const
+  {
+    return nullptr != file_;
+  }
+
+  // The number of bytes which reached the file, rather than the buffer of the stream.
+  long long flushed_size() const  // NOLINT(runtime/int)
+  {
+    struct stat file_stat;
+    if (0 != fstat(fileno(file_), &file_stat)) {
+      return -1;
+    }
+    return static_cast<long long>(file_stat.st_size);  // NOLINT(runtime/int)
+  }
+
+private:
+  FILE * file_ = nullptr;
+  int saved_fd_ = -1;
+};
+#endif
+
+TEST(TestLoggingFlushPolicy, policy_from_env) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  // The default policy of a fully buffered stream, with the count from the environment.
+  rcutils_logging_flush_policy_t policy = rcutils_logging_get_flush_policy();
+  const rcutils_logging_flush_policy_t default_policy = rcutils_logging_get_default_flush_policy();
+  EXPECT_EQ(RCUTILS_MS_TO_NS(20), default_policy.interval);
+  EXPECT_EQ(default_policy.interval, policy.interval);
+  EXPECT_EQ(3u, policy.message_count);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, policy.severity);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_flush_policy(nullptr));
+  rcutils_reset_error();
+  policy.interval = -1;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_flush_policy(&policy));
+  rcutils_reset_error();
+}
+
+#ifndef _WIN32
+TEST(TestLoggingFlushPolicy, flushes) {
+  StdoutCapture capture;
+  ASSERT_TRUE(capture.is_valid());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  // When its buffer is set after it was written to, glibc writes out the first message written
+  // to the stream with the second one, so get that out of the way.
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "zeroth");
+  fflush(stdout);
+  const long long initial_size = capture.flushed_size();  // NOLINT(runtime/int)
+
+  // Flush every third message, and right after warnings.
+  rcutils_logging_flush_policy_t policy = {0, 3u, RCUTILS_LOG_SEVERITY_WARN};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_flush_policy(&policy));
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "first");
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "second");
+  EXPECT_EQ(initial_size, capture.flushed_size());
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "third");
+  const long long three_messages_size = capture.flushed_size();  // NOLINT(runtime/int)
+  EXPECT_LT(initial_size, three_messages_size);
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "fourth");
+  EXPECT_EQ(three_messages_size, capture.flushed_size());
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_WARN, "name", "fifth");
+  const long long five_messages_size = capture.flushed_size();  // NOLINT(runtime/int)
+  EXPECT_LT(three_messages_size, five_messages_size);
+
+  // Flush once the interval elapsed.
+  policy = {RCUTILS_MS_TO_NS(20), 0u, RCUTILS_LOG_SEVERITY_UNSET};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_flush_policy(&policy));
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_ERROR, "name", "sixth");
+  EXPECT_EQ(five_messages_size, capture.flushed_size());
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_INFO, "name", "seventh");
+  const long long seven_messages_size = capture.flushed_size();  // NOLINT(runtime/int)
+  EXPECT_LT(five_messages_size, seven_messages_size);
+
+  // Without a policy, only the buffering flushes, and shutting down does.
+  policy = {0, 0u, RCUTILS_LOG_SEVERITY_UNSET};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_flush_policy(&policy));
+  for (int i = 0; i < 10; ++i) {
+    rcutils_log(nullptr, RCUTILS_LOG_SEVERITY_FATAL, "name", "more");
+  }
+  EXPECT_EQ(seven_messages_size, capture.flushed_size());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  EXPECT_LT(seven_messages_size, capture.flushed_size());
+  policy = rcutils_logging_get_flush_policy();
+  EXPECT_EQ(0, policy.interval);
+  EXPECT_EQ(0u, policy.message_count);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_UNSET, policy.severity);
+}
+#endif
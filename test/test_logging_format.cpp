@@ -0,0 +1,257 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rcutils/logging_format.hpp"
+#include "rcutils/time.h"
+
+using ::testing::EndsWith;
+
+namespace
+{
+
+struct LogEvent
+{
+  const rcutils_log_location_t * location;
+  int level;
+  std::string name;
+  std::string message;
+};
+std::vector<LogEvent> g_log_events;
+
+enum class Color : uint8_t
+{
+  red = 1,
+  green = 2,
+};
+
+struct Point
+{
+  double x;
+  double y;
+};
+
+}  // namespace
+
+template<>
+struct rcutils::logging_format::formatter<Point>
+{
+  static void format(std::string & out, const Point & point)
+  {
+    out += '(';
+    formatter<double>::format(out, point.x);
+    out += ", ";
+    formatter<double>::format(out, point.y);
+    out += ')';
+  }
+};
+
+namespace
+{
+
+// Logs when it is formatted, while the buffer of the thread holds the message being formatted.
+struct LoggingValue
+{
+  int value;
+};
+
+}  // namespace
+
+template<>
+struct rcutils::logging_format::formatter<LoggingValue>
+{
+  static void format(std::string & out, const LoggingValue & value)
+  {
+    RCUTILS_LOG_INFO_FMT_NAMED("nested", "formatting {}", value.value);
+    formatter<int>::format(out, value.value);
+  }
+};
+
+class TestLoggingFormat : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    g_log_events.clear();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+    rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_DEBUG);
+
+    auto output_handler = [](
+      const rcutils_log_location_t * location,
+      int level, const char * name, rcutils_time_point_value_t timestamp,
+      const char * format, va_list * args) -> void
+      {
+        (void)timestamp;
+        va_list args_copy;
+        va_copy(args_copy, *args);
+        const int length = vsnprintf(nullptr, 0, format, args_copy);
+        va_end(args_copy);
+        std::string message(static_cast<size_t>(length), '\0');
+        vsnprintf(&message[0], message.size() + 1u, format, *args);
+        g_log_events.push_back({location, level, name ? name : "", message});
+      };
+    rcutils_logging_set_output_handler(output_handler);
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  }
+};
+
+TEST(TestLoggingFormatString, count_placeholders) {
+  using rcutils::logging_format::count_placeholders;
+  using rcutils::logging_format::invalid_format;
+  static_assert(0u == count_placeholders(""), "no placeholder");
+  static_assert(0u == count_placeholders("message"), "no placeholder");
+  static_assert(2u == count_placeholders("{} and {}"), "two placeholders");
+  static_assert(1u == count_placeholders("{{}} {}"), "escaped braces");
+  static_assert(invalid_format == count_placeholders("{"), "unmatched {");
+  static_assert(invalid_format == count_placeholders("}"), "unmatched }");
+  static_assert(invalid_format == count_placeholders("{0}"), "indexed placeholder");
+  static_assert(invalid_format == count_placeholders("{:x}"), "format specification");
+}
+
+TEST_F(TestLoggingFormat, named) {
+  for (int i : {1, 2, 3}) {
+    RCUTILS_LOG_DEBUG_FMT_NAMED("name", "message {}", i);
+  }
+  ASSERT_EQ(3u, g_log_events.size());
+  const LogEvent & event = g_log_events.back();
+  ASSERT_NE(nullptr, event.location);
+  EXPECT_STREQ("TestBody", event.location->function_name);
+  EXPECT_THAT(event.location->file_name, EndsWith("test_logging_format.cpp"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_DEBUG, event.level);
+  EXPECT_EQ("name", event.name);
+  EXPECT_EQ("message 3", event.message);
+}
+
+TEST_F(TestLoggingFormat, types) {
+  const char * null_string = nullptr;
+  char array[] = "array";
+  std::string string = "string";
+  const int * null_pointer = nullptr;
+  RCUTILS_LOG_INFO_FMT(
+    "{} {} {} {} {} {} {} {} {}", -42, 42u, INT64_MIN, UINT64_MAX, static_cast<int8_t>(-8),
+    static_cast<uint8_t>(200), true, false, 'c');
+  RCUTILS_LOG_INFO_FMT("{} {} {} {} {}", 0.1, 1.5f, -2.0, 1e100, Color::green);
+  RCUTILS_LOG_INFO_FMT(
+    "{} {} {} {} {} {}", "literal", array, string, std::string_view("view", 2), null_string,
+    std::string());
+  RCUTILS_LOG_INFO_FMT("{} {}", null_pointer, nullptr);
+  RCUTILS_LOG_INFO_FMT("{}", Point{1.0, -0.5});
+  ASSERT_EQ(5u, g_log_events.size());
+  EXPECT_EQ(
+    "-42 42 -9223372036854775808 18446744073709551615 -8 200 true false c",
+    g_log_events[0].message);
+  EXPECT_EQ("0.1 1.5 -2 1e+100 2", g_log_events[1].message);
+  EXPECT_EQ("literal array string vi (null) ", g_log_events[2].message);
+  EXPECT_EQ("0x0 0x0", g_log_events[3].message);
+  EXPECT_EQ("(1, -0.5)", g_log_events[4].message);
+
+  int value = 0;
+  RCUTILS_LOG_INFO_FMT("{}", &value);
+  char expected[64];
+  snprintf(expected, sizeof(expected), "0x%jx", static_cast<uintmax_t>(
+      reinterpret_cast<uintptr_t>(&value)));
+  ASSERT_EQ(6u, g_log_events.size());
+  EXPECT_EQ(expected, g_log_events[5].message);
+}
+
+TEST_F(TestLoggingFormat, braces) {
+  RCUTILS_LOG_INFO_FMT("no placeholder");
+  RCUTILS_LOG_INFO_FMT("{{}} {{{}}} }}{{", 1);
+  RCUTILS_LOG_INFO_FMT("{}{}", 1, 2);
+  RCUTILS_LOG_INFO_FMT("% d %s %%");
+  ASSERT_EQ(4u, g_log_events.size());
+  EXPECT_EQ("no placeholder", g_log_events[0].message);
+  EXPECT_EQ("{} {1} }{", g_log_events[1].message);
+  EXPECT_EQ("12", g_log_events[2].message);
+  EXPECT_EQ("% d %s %%", g_log_events[3].message);
+}
+
+TEST_F(TestLoggingFormat, long_message) {
+  const std::string long_string(5000, 'x');
+  for (int i = 0; i < 2; ++i) {
+    RCUTILS_LOG_INFO_FMT("{}-{}", long_string, i);
+  }
+  RCUTILS_LOG_INFO_FMT("short {}", 2);
+  ASSERT_EQ(3u, g_log_events.size());
+  EXPECT_EQ(long_string + "-0", g_log_events[0].message);
+  EXPECT_EQ(long_string + "-1", g_log_events[1].message);
+  EXPECT_EQ("short 2", g_log_events[2].message);
+}
+
+TEST_F(TestLoggingFormat, log_while_formatting) {
+  RCUTILS_LOG_INFO_FMT_NAMED("outer", "value {} and {}", LoggingValue{1}, LoggingValue{2});
+  ASSERT_EQ(3u, g_log_events.size());
+  EXPECT_EQ("nested", g_log_events[0].name);
+  EXPECT_EQ("formatting 1", g_log_events[0].message);
+  EXPECT_EQ("formatting 2", g_log_events[1].message);
+  EXPECT_EQ("outer", g_log_events[2].name);
+  EXPECT_EQ("value 1 and 2", g_log_events[2].message);
+}
+
+TEST_F(TestLoggingFormat, disabled) {
+  int evaluations = 0;
+  auto evaluate = [&evaluations]() {
+      return ++evaluations;
+    };
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level("disabled", RCUTILS_LOG_SEVERITY_WARN));
+  RCUTILS_LOG_INFO_FMT_NAMED("disabled", "{}", evaluate());
+  RCUTILS_LOG_WARN_FMT_NAMED("disabled", "{}", evaluate());
+  ASSERT_EQ(1u, g_log_events.size());
+  EXPECT_EQ(1, evaluations);
+  EXPECT_EQ("1", g_log_events[0].message);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, g_log_events[0].level);
+}
+
+TEST_F(TestLoggingFormat, conditions) {
+  for (int i : {1, 2, 3, 4, 5, 6}) {
+    RCUTILS_LOG_INFO_FMT_ONCE("once {}", i);
+    RCUTILS_LOG_INFO_FMT_EXPRESSION(0 == i % 3, "expression {}", i);
+    RCUTILS_LOG_INFO_FMT_SKIPFIRST_NAMED("skip", "skipfirst {}", i);
+    RCUTILS_LOG_INFO_FMT_THROTTLE(rcutils_steady_time_now, 60000, "throttle {}", i);
+  }
+  std::vector<std::string> messages;
+  for (const LogEvent & event : g_log_events) {
+    messages.push_back(event.message);
+  }
+  EXPECT_EQ(
+    std::vector<std::string>({
+    "once 1", "throttle 1", "skipfirst 2", "expression 3", "skipfirst 3", "skipfirst 4",
+    "skipfirst 5", "expression 6", "skipfirst 6"}),
+    messages);
+}
+
+TEST_F(TestLoggingFormat, handle) {
+  rcutils_logger_handle_t * handle = rcutils_logging_get_logger_handle("handle");
+  ASSERT_NE(nullptr, handle);
+  RCUTILS_LOG_WARN_FMT_HANDLE(handle, "through {} {}", "a", "handle");
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_logger_level("handle", RCUTILS_LOG_SEVERITY_ERROR));
+  RCUTILS_LOG_WARN_FMT_HANDLE(handle, "filtered {}", 1);
+  ASSERT_EQ(1u, g_log_events.size());
+  EXPECT_EQ("handle", g_log_events[0].name);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, g_log_events[0].level);
+  EXPECT_EQ("through a handle", g_log_events[0].message);
+}
@@ -0,0 +1,249 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+#ifndef _WIN32
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_journal_sink.h"
+
+#ifndef _WIN32
+
+static const char * const g_socket_path = "test_logging_journal_sink.sock";
+
+// A datagram socket standing in for the system logger.
+class TestLoggingJournalSink : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::remove(g_socket_path);
+    fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    ASSERT_LE(0, fd);
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, g_socket_path, sizeof(address.sun_path) - 1);
+    ASSERT_EQ(0, bind(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)));
+    options = rcutils_logging_journal_sink_get_default_options();
+    options.socket_path = g_socket_path;
+  }
+
+  void TearDown() override
+  {
+    if (nullptr != sink) {
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_journal_sink_fini(sink));
+    }
+    close(fd);
+    std::remove(g_socket_path);
+  }
+
+  void init()
+  {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_journal_sink_init(&sink, &options, rcutils_get_default_allocator()));
+  }
+
+  std::string receive()
+  {
+    char buffer[4096];
+    ssize_t length = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    EXPECT_LT(0, length);
+    return length > 0 ? std::string(buffer, static_cast<size_t>(length)) : std::string();
+  }
+
+  // Parse a datagram of the journald native protocol.
+  std::map<std::string, std::string> receive_fields()
+  {
+    std::string datagram = receive();
+    std::map<std::string, std::string> fields;
+    size_t position = 0;
+    while (position < datagram.size()) {
+      size_t end = datagram.find_first_of("=\n", position);
+      if (std::string::npos == end) {
+        ADD_FAILURE() << "truncated field";
+        break;
+      }
+      std::string key = datagram.substr(position, end - position);
+      EXPECT_EQ(0u, fields.count(key)) << key;
+      if ('=' == datagram[end]) {
+        size_t value_end = datagram.find('\n', end + 1);
+        EXPECT_NE(std::string::npos, value_end);
+        fields[key] = datagram.substr(end + 1, value_end - end - 1);
+        position = value_end + 1;
+      } else {
+        uint64_t length = 0;
+        for (size_t i = 0; i < 8; ++i) {
+          length |= static_cast<uint64_t>(static_cast<unsigned char>(datagram[end + 1 + i])) <<
+            (8 * i);
+        }
+        fields[key] = datagram.substr(end + 9, static_cast<size_t>(length));
+        position = end + 9 + static_cast<size_t>(length);
+        EXPECT_EQ('\n', datagram[position]);
+        ++position;
+      }
+    }
+    return fields;
+  }
+
+  int fd = -1;
+  rcutils_logging_journal_sink_options_t options;
+  rcutils_logging_journal_sink_t * sink = nullptr;
+};
+
+TEST_F(TestLoggingJournalSink, invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_journal_sink_init(nullptr, &options, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_journal_sink_init(&sink, nullptr, allocator));
+  rcutils_reset_error();
+  int invalid_protocol = 2;
+  options.protocol = static_cast<rcutils_logging_journal_sink_protocol_t>(invalid_protocol);
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_journal_sink_init(&sink, &options, allocator));
+  rcutils_reset_error();
+  options.protocol = RCUTILS_LOGGING_JOURNAL_SINK_JOURNALD;
+  std::string long_path(200, 'a');
+  options.socket_path = long_path.c_str();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_journal_sink_init(&sink, &options, allocator));
+  rcutils_reset_error();
+  options.socket_path = "test_logging_journal_sink.missing";
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_logging_journal_sink_init(&sink, &options, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, sink);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_journal_sink_fini(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_logging_journal_sink_get_dropped_count(nullptr));
+}
+
+TEST_F(TestLoggingJournalSink, journald_fields) {
+  options.identifier = "test_node";
+  init();
+
+  rcutils_log_location_t location = {"func", "dir/file.c", 42u};
+  rcutils_logging_journal_sink_output(
+    &location, RCUTILS_LOG_SEVERITY_WARN, "node.child", 0, "Hello", sink);
+  std::map<std::string, std::string> fields = receive_fields();
+  EXPECT_EQ(7u, fields.size());
+  EXPECT_EQ("Hello", fields["MESSAGE"]);
+  EXPECT_EQ("4", fields["PRIORITY"]);
+  EXPECT_EQ("test_node", fields["SYSLOG_IDENTIFIER"]);
+  EXPECT_EQ("node.child", fields["RCUTILS_LOGGER_NAME"]);
+  EXPECT_EQ("dir/file.c", fields["CODE_FILE"]);
+  EXPECT_EQ("42", fields["CODE_LINE"]);
+  EXPECT_EQ("func", fields["CODE_FUNC"]);
+
+  // Values with newlines are sent with their length, and the location is optional.
+  rcutils_logging_journal_sink_output(
+    nullptr, RCUTILS_LOG_SEVERITY_FATAL, "node", 0, "two\nlines", sink);
+  fields = receive_fields();
+  EXPECT_EQ(4u, fields.size());
+  EXPECT_EQ("two\nlines", fields["MESSAGE"]);
+  EXPECT_EQ("2", fields["PRIORITY"]);
+  EXPECT_EQ(0u, rcutils_logging_journal_sink_get_dropped_count(sink));
+}
+
+TEST_F(TestLoggingJournalSink, severity_to_priority) {
+  init();
+  const std::pair<int, const char *> priorities[] = {
+    {RCUTILS_LOG_SEVERITY_UNSET, "7"},
+    {RCUTILS_LOG_SEVERITY_DEBUG, "7"},
+    {RCUTILS_LOG_SEVERITY_INFO, "6"},
+    {RCUTILS_LOG_SEVERITY_WARN, "4"},
+    {RCUTILS_LOG_SEVERITY_ERROR, "3"},
+    {RCUTILS_LOG_SEVERITY_FATAL, "2"},
+  };
+  for (const auto & priority : priorities) {
+    rcutils_logging_journal_sink_output(nullptr, priority.first, "node", 0, "message", sink);
+    EXPECT_EQ(priority.second, receive_fields()["PRIORITY"]) << priority.first;
+  }
+}
+
+TEST_F(TestLoggingJournalSink, syslog) {
+  options.protocol = RCUTILS_LOGGING_JOURNAL_SINK_SYSLOG;
+  init();
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  rcutils_logging_journal_sink_output(
+    &location, RCUTILS_LOG_SEVERITY_ERROR, "node", 0, "Hello", sink);
+  EXPECT_EQ("<11>[node] Hello", receive());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_journal_sink_fini(sink));
+  sink = nullptr;
+
+  options.identifier = "test_node";
+  init();
+  rcutils_logging_journal_sink_output(
+    nullptr, RCUTILS_LOG_SEVERITY_DEBUG, "node", 0, "Hello", sink);
+  EXPECT_EQ("<15>test_node: [node] Hello", receive());
+}
+
+TEST_F(TestLoggingJournalSink, drops_when_the_logger_is_gone) {
+  init();
+  close(fd);
+  std::remove(g_socket_path);
+  fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  rcutils_logging_journal_sink_output(nullptr, RCUTILS_LOG_SEVERITY_INFO, "node", 0, "lost", sink);
+  EXPECT_EQ(1u, rcutils_logging_journal_sink_get_dropped_count(sink));
+}
+
+TEST_F(TestLoggingJournalSink, sink) {
+  init();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(rcutils_logging_journal_sink_output, sink, RCUTILS_LOG_SEVERITY_INFO));
+
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_INFO, "node", "sent %d", 1);
+  std::map<std::string, std::string> fields = receive_fields();
+  EXPECT_EQ("sent 1", fields["MESSAGE"]);
+  EXPECT_EQ("node", fields["RCUTILS_LOGGER_NAME"]);
+
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_remove_sink(rcutils_logging_journal_sink_output, sink));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+}
+
+#else  // _WIN32
+
+TEST(TestLoggingJournalSink, not_supported) {
+  rcutils_logging_journal_sink_options_t options =
+    rcutils_logging_journal_sink_get_default_options();
+  rcutils_logging_journal_sink_t * sink = nullptr;
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_journal_sink_init(&sink, &options, rcutils_get_default_allocator()));
+  rcutils_reset_error();
+}
+
+#endif  // _WIN32
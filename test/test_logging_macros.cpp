@@ -14,13 +14,16 @@
 
 #include <gmock/gmock.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "rcutils/logging_macros.h"
 #include "rcutils/time.h"
+#include "rcutils/types/hash_map.h"
 
 using ::testing::EndsWith;
 
@@ -207,6 +210,43 @@ TEST_F(TestLoggingMacros, test_logging_skipfirst_throttle) {
   EXPECT_EQ("", g_last_log_event.name);
 }
 
+TEST_F(TestLoggingMacros, test_logging_sampled) {
+  for (uint32_t i = 0u; i < 10u; ++i) {
+    RCUTILS_LOG_WARN_SAMPLED(3, "message %u", i);
+  }
+  // The first, the fourth, the seventh and the tenth call.
+  EXPECT_EQ(4u, g_log_calls);
+  EXPECT_EQ("message 9", g_last_log_event.message);
+
+  g_log_calls = 0;
+  for (uint32_t i = 0u; i < 5u; ++i) {
+    RCUTILS_LOG_WARN_SAMPLED_NAMED(1, "name", "message %u", i);
+    RCUTILS_LOG_WARN_SAMPLED_NAMED(0, "name", "message %u", i);
+  }
+  EXPECT_EQ(10u, g_log_calls);
+  EXPECT_EQ("name", g_last_log_event.name);
+}
+
+TEST_F(TestLoggingMacros, test_logging_sampled_prob) {
+  for (int i = 0; i < 100; ++i) {
+    RCUTILS_LOG_WARN_SAMPLED_PROB(0.0, "never");
+    RCUTILS_LOG_WARN_SAMPLED_PROB(-1.0, "never");
+  }
+  EXPECT_EQ(0u, g_log_calls);
+  for (int i = 0; i < 100; ++i) {
+    RCUTILS_LOG_WARN_SAMPLED_PROB_NAMED(1.0, "name", "always");
+  }
+  EXPECT_EQ(100u, g_log_calls);
+
+  g_log_calls = 0;
+  for (int i = 0; i < 10000; ++i) {
+    RCUTILS_LOG_WARN_SAMPLED_PROB(0.25, "sometimes");
+  }
+  // Far beyond ten standard deviations of the binomial distribution.
+  EXPECT_GT(g_log_calls, 2000u);
+  EXPECT_LT(g_log_calls, 3000u);
+}
+
 TEST_F(TestLoggingMacros, test_logger_hierarchy) {
   ASSERT_EQ(
     RCUTILS_RET_OK,
@@ -221,3 +261,210 @@ TEST_F(TestLoggingMacros, test_logger_hierarchy) {
   RCUTILS_LOG_DEBUG("message");
   EXPECT_EQ(0u, g_log_calls);
 }
+
+TEST_F(TestLoggingMacros, test_callsite_cache_follows_level_changes) {
+  auto log_debug = [](const char * name) {
+      RCUTILS_LOG_DEBUG_NAMED(name, "message");
+    };
+  const char * name = "rcutils_test_logging_macros_cpp.callsite";
+
+  log_debug(name);
+  log_debug(name);
+  EXPECT_EQ(2u, g_log_calls);
+
+  // Changing the level of an ancestor disables the cached callsite.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp", RCUTILS_LOG_SEVERITY_INFO));
+  log_debug(name);
+  EXPECT_EQ(2u, g_log_calls);
+
+  // Other loggers used from the same callsite are resolved on their own.
+  log_debug("other_logger");
+  EXPECT_EQ(3u, g_log_calls);
+  EXPECT_EQ("other_logger", g_last_log_event.name);
+  log_debug(name);
+  EXPECT_EQ(3u, g_log_calls);
+
+  // Changing the default level affects the cached decision of nameless callsites.
+  auto log_info = []() {
+      RCUTILS_LOG_INFO("message");
+    };
+  log_info();
+  EXPECT_EQ(4u, g_log_calls);
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_WARN);
+  log_info();
+  EXPECT_EQ(4u, g_log_calls);
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_DEBUG);
+  log_info();
+  EXPECT_EQ(5u, g_log_calls);
+
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp", RCUTILS_LOG_SEVERITY_UNSET));
+  log_debug(name);
+  EXPECT_EQ(6u, g_log_calls);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp", RCUTILS_LOG_SEVERITY_ERROR));
+  log_debug(name);
+  EXPECT_EQ(6u, g_log_calls);
+}
+
+TEST_F(TestLoggingMacros, test_literal_logger_names) {
+  static_assert(
+    rcutils_logging_constexpr_name_hash("", 0u) == 5381u,
+    "the hash of logger names must be computable at compile time");
+  const char * name = "rcutils_test_logging_macros_cpp.literal";
+  EXPECT_EQ(
+    rcutils_hash_map_string_hash_func(&name),
+    rcutils_logging_constexpr_name_hash(name, strlen(name)));
+  // The hash computed at compile time must be the one the logging system computes at runtime,
+  // for names of any length and with characters outside of ASCII.
+  const char * names[] = {
+    "", "a", "rcutils", "rcutils.test.logging.macros.cpp.with.a.name.longer.than.sixteen",
+    "rcutils_\xc3\xa9t\xc3\xa9.\xff"};
+  for (const char * runtime_name : names) {
+    SCOPED_TRACE(runtime_name);
+    const size_t length = strlen(runtime_name);
+    EXPECT_EQ(
+      rcutils_hash_map_string_hash_func(&runtime_name),
+      rcutils_logging_constexpr_name_hash(runtime_name, length));
+    EXPECT_EQ(
+      rcutils_hash_map_string_hash_view_func(runtime_name, length),
+      rcutils_logging_constexpr_name_hash(runtime_name, length));
+  }
+  const char array_name[64] = "rcutils_test_logging_macros_cpp.literal";
+  EXPECT_EQ(strlen(name), rcutils_logging_constexpr_name_length(array_name, sizeof(array_name)));
+
+  auto log_debug = []() {
+      RCUTILS_LOG_DEBUG_NAMED("rcutils_test_logging_macros_cpp.literal", "message");
+    };
+  log_debug();
+  EXPECT_EQ(1u, g_log_calls);
+  EXPECT_EQ("rcutils_test_logging_macros_cpp.literal", g_last_log_event.name);
+
+  // The level of the literal logger name is resolved from its precomputed hash.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp.literal", RCUTILS_LOG_SEVERITY_INFO));
+  log_debug();
+  EXPECT_EQ(1u, g_log_calls);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp.literal", RCUTILS_LOG_SEVERITY_UNSET));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp", RCUTILS_LOG_SEVERITY_INFO));
+  log_debug();
+  EXPECT_EQ(1u, g_log_calls);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp", RCUTILS_LOG_SEVERITY_UNSET));
+  log_debug();
+  EXPECT_EQ(2u, g_log_calls);
+
+  // Character arrays which aren't literals work as well.
+  RCUTILS_LOG_DEBUG_NAMED(array_name, "message");
+  EXPECT_EQ(3u, g_log_calls);
+  EXPECT_EQ("rcutils_test_logging_macros_cpp.literal", g_last_log_event.name);
+}
+
+TEST_F(TestLoggingMacros, test_logging_handle) {
+  rcutils_logger_handle_t * handle =
+    rcutils_logging_get_logger_handle("rcutils_test_logging_macros_cpp.handle");
+  ASSERT_NE(nullptr, handle);
+
+  for (int i : {1, 2, 3}) {
+    RCUTILS_LOG_DEBUG_HANDLE(handle, "message %d", i);
+  }
+  EXPECT_EQ(3u, g_log_calls);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_DEBUG, g_last_log_event.level);
+  EXPECT_EQ("rcutils_test_logging_macros_cpp.handle", g_last_log_event.name);
+  EXPECT_EQ("message 3", g_last_log_event.message);
+
+  for (int i : {1, 2, 3, 4, 5, 6}) {
+    RCUTILS_LOG_INFO_EXPRESSION_HANDLE(i % 3, handle, "message %d", i);
+  }
+  EXPECT_EQ(7u, g_log_calls);
+  EXPECT_EQ("message 5", g_last_log_event.message);
+
+  for (int i : {1, 2, 3}) {
+    RCUTILS_LOG_WARN_ONCE_HANDLE(handle, "message %d", i);
+  }
+  EXPECT_EQ(8u, g_log_calls);
+  EXPECT_EQ("message 1", g_last_log_event.message);
+
+  // The handle follows level changes of the logger hierarchy.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_logger_level(
+      "rcutils_test_logging_macros_cpp", RCUTILS_LOG_SEVERITY_ERROR));
+  RCUTILS_LOG_WARN_HANDLE(handle, "message");
+  EXPECT_EQ(8u, g_log_calls);
+  rcutils_log_with_handle(nullptr, handle, RCUTILS_LOG_SEVERITY_WARN, "message");
+  EXPECT_EQ(8u, g_log_calls);
+  rcutils_log_with_handle(nullptr, handle, RCUTILS_LOG_SEVERITY_ERROR, "message %d", 9);
+  EXPECT_EQ(9u, g_log_calls);
+  EXPECT_EQ(nullptr, g_last_log_event.location);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, g_last_log_event.level);
+  EXPECT_EQ("message 9", g_last_log_event.message);
+}
+
+std::atomic<size_t> g_concurrent_log_calls(0);
+
+rcutils_ret_t fixed_time_point_value(rcutils_time_point_value_t * now)
+{
+  *now = RCUTILS_S_TO_NS(1000);
+  return RCUTILS_RET_OK;
+}
+
+TEST_F(TestLoggingMacros, test_logging_conditions_concurrently) {
+  rcutils_logging_set_output_handler(
+    [](const rcutils_log_location_t *, int, const char *, rcutils_time_point_value_t,
+    const char *, va_list *) -> void
+    {
+      ++g_concurrent_log_calls;
+    });
+
+  // Each callsite is evaluated by several threads at once.
+  const size_t thread_count = 8;
+  const size_t iterations = 1000;
+  auto run_concurrently = [&](void (* log)()) {
+      g_concurrent_log_calls = 0;
+      std::atomic<bool> start(false);
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(
+          [&start, log, iterations]() {
+            while (!start) {
+              std::this_thread::yield();
+            }
+            for (size_t j = 0; j < iterations; ++j) {
+              log();
+            }
+          });
+      }
+      start = true;
+      for (auto & thread : threads) {
+        thread.join();
+      }
+      return g_concurrent_log_calls.load();
+    };
+
+  EXPECT_EQ(1u, run_concurrently([]() {RCUTILS_LOG_INFO_ONCE("once");}));
+  EXPECT_EQ(
+    thread_count * iterations - 1, run_concurrently([]() {RCUTILS_LOG_INFO_SKIPFIRST("skip");}));
+  // The clock stands still, so the whole run is within the first window.
+  EXPECT_EQ(
+    1u, run_concurrently([]() {RCUTILS_LOG_INFO_THROTTLE(fixed_time_point_value, 1000, "a");}));
+  EXPECT_EQ(
+    thread_count * iterations / 10, run_concurrently([]() {RCUTILS_LOG_INFO_SAMPLED(10, "a");}));
+}
@@ -0,0 +1,128 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/env.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+
+static std::string format(const rcutils_log_location_t * location, const char * message)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&output, 16, &allocator));
+  EXPECT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_format_message(
+      location, RCUTILS_LOG_SEVERITY_WARN, "node", RCUTILS_MS_TO_NS(1500), message, &output));
+  std::string result = nullptr != output.buffer ? output.buffer : "";
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&output));
+  return result;
+}
+
+TEST(TestLoggingOutputFormat, set_output_format) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_log_location_t location = {"func", "dir/file.c", 42u};
+  EXPECT_EQ("[WARN] [0000000001.500000000] [node]: Hello", format(&location, "Hello"));
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_set_output_format(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_logging_set_output_format(std::string(2048, 'a').c_str()));
+  rcutils_reset_error();
+  EXPECT_EQ("[WARN] [0000000001.500000000] [node]: Hello", format(&location, "Hello"));
+
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_set_output_format(
+      "{severity} {name}@{function_name}:{line_number} {time_as_nanoseconds} - {message}"));
+  EXPECT_EQ("WARN node@func:42 0000000001500000000 - Hello", format(&location, "Hello"));
+
+  // Unknown tokens and stray delimiters are kept as they are.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_output_format("{{x}} {message}} {{message} {name"));
+  EXPECT_EQ("{{x}} Hello} {Hello {name", format(&location, "Hello"));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_output_format("only literals"));
+  EXPECT_EQ("only literals", format(&location, "Hello"));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_output_format(std::string(2047, 'a').c_str()));
+  EXPECT_EQ(std::string(2047, 'a'), format(&location, "Hello"));
+
+  // An empty format is the default one.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_output_format(""));
+  EXPECT_EQ("[WARN] [0000000001.500000000] [node]: Hello", format(&location, "Hello"));
+}
+
+TEST(TestLoggingOutputFormat, structured_output) {
+  EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_STRUCTURE", "key_value"));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_STRUCTURE", nullptr));
+  });
+  // The structured output replaces the format.
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_logging_set_output_format("{message}"));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    "time_as_nanoseconds=1500000000 severity=WARN name=\"node\" message=\"Hello\" "
+    "function_name=\"\" file_name=\"\" line_number=",
+    format(nullptr, "Hello"));
+}
+
+TEST(TestLoggingOutputFormat, swap_while_formatting) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  const char * formats[] = {"first {name}: {message}", "[{severity}] second {message}"};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_output_format(formats[0]));
+
+  // Every message is formatted with either one of the formats, never with a mix of them.
+  std::atomic<bool> done(false);
+  std::atomic<size_t> unexpected(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back(
+      [&]() {
+        while (!done) {
+          const std::string result = format(nullptr, "Hello");
+          if (result != "first node: Hello" && result != "[WARN] second Hello") {
+            ++unexpected;
+          }
+        }
+      });
+  }
+  for (size_t i = 0; i < 200; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_set_output_format(formats[i % 2]));
+    std::this_thread::yield();
+  }
+  done = true;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0u, unexpected);
+}
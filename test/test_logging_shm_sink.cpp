@@ -0,0 +1,335 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/logging_shm_sink.h"
+#include "rcutils/process.h"
+
+#ifndef _WIN32
+
+struct taken_record_t
+{
+  rcutils_time_point_value_t timestamp;
+  int severity;
+  std::string name;
+  std::string message;
+  bool has_location;
+  std::string file_name;
+  std::string function_name;
+  size_t line_number;
+};
+
+static void take_record(const rcutils_logging_shm_record_t * record, void * context)
+{
+  auto records = static_cast<std::vector<taken_record_t> *>(context);
+  const bool has_location = nullptr != record->file_name;
+  records->push_back(
+  {
+    record->timestamp, record->severity, record->name, record->message, has_location,
+    has_location ? record->file_name : "", has_location ? record->function_name : "",
+    record->line_number});
+}
+
+class TestLoggingShmSink : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    name = "/test_logging_shm_sink." + std::to_string(rcutils_get_pid());
+    options = rcutils_logging_shm_sink_get_default_options();
+    options.name = name.c_str();
+    options.capacity = 4096u;
+  }
+
+  void TearDown() override
+  {
+    if (nullptr != reader) {
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shm_reader_close(reader));
+    }
+    if (nullptr != sink) {
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shm_sink_fini(sink));
+    }
+  }
+
+  void open()
+  {
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_shm_sink_init(&sink, &options, rcutils_get_default_allocator()));
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_shm_reader_open(&reader, name.c_str(), rcutils_get_default_allocator()));
+  }
+
+  std::vector<taken_record_t> take(size_t max_count = SIZE_MAX)
+  {
+    std::vector<taken_record_t> records;
+    size_t count = 0u;
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_logging_shm_reader_take(reader, take_record, &records, max_count, &count));
+    EXPECT_EQ(records.size(), count);
+    return records;
+  }
+
+  std::string name;
+  rcutils_logging_shm_sink_options_t options;
+  rcutils_logging_shm_sink_t * sink = nullptr;
+  rcutils_logging_shm_reader_t * reader = nullptr;
+};
+
+TEST_F(TestLoggingShmSink, invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_sink_init(nullptr, &options, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_sink_init(&sink, nullptr, allocator));
+  rcutils_reset_error();
+  for (size_t capacity : {0u, 2048u, 5000u}) {
+    options.capacity = capacity;
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_sink_init(&sink, &options, allocator));
+    rcutils_reset_error();
+  }
+  options.capacity = 4096u;
+  for (const char * invalid_name : {"", "/", "no_slash", "/a/b"}) {
+    options.name = invalid_name;
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_sink_init(&sink, &options, allocator));
+    rcutils_reset_error();
+  }
+  EXPECT_EQ(nullptr, sink);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_sink_fini(nullptr));
+  rcutils_reset_error();
+
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_shm_reader_open(&reader, "/test_logging_shm_sink.missing", allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_reader_open(&reader, nullptr, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, reader);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_shm_reader_close(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(TestLoggingShmSink, default_name) {
+  options.name = nullptr;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_shm_sink_init(&sink, &options, rcutils_get_default_allocator()));
+  EXPECT_EQ(
+    "/rcutils_log." + std::to_string(rcutils_get_pid()),
+    std::string(rcutils_logging_shm_sink_get_name(sink)));
+}
+
+TEST_F(TestLoggingShmSink, records) {
+  open();
+  EXPECT_EQ(rcutils_get_pid(), rcutils_logging_shm_reader_get_pid(reader));
+  EXPECT_TRUE(take().empty());
+
+  rcutils_log_location_t location = {"func", "dir/file.c", 42u};
+  rcutils_logging_shm_sink_output(
+    &location, RCUTILS_LOG_SEVERITY_WARN, "node", 1234, "Hello", sink);
+  rcutils_logging_shm_sink_output(nullptr, RCUTILS_LOG_SEVERITY_INFO, nullptr, 5678, "", sink);
+  std::vector<taken_record_t> records = take();
+  ASSERT_EQ(2u, records.size());
+  EXPECT_EQ(1234, records[0].timestamp);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, records[0].severity);
+  EXPECT_EQ("node", records[0].name);
+  EXPECT_EQ("Hello", records[0].message);
+  EXPECT_TRUE(records[0].has_location);
+  EXPECT_EQ("dir/file.c", records[0].file_name);
+  EXPECT_EQ("func", records[0].function_name);
+  EXPECT_EQ(42u, records[0].line_number);
+  EXPECT_EQ(5678, records[1].timestamp);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_INFO, records[1].severity);
+  EXPECT_EQ("", records[1].name);
+  EXPECT_EQ("", records[1].message);
+  EXPECT_FALSE(records[1].has_location);
+  EXPECT_EQ(0u, records[1].line_number);
+
+  // At most max_count records are taken at a time.
+  for (int i = 0; i < 3; ++i) {
+    rcutils_logging_shm_sink_output(
+      nullptr, RCUTILS_LOG_SEVERITY_INFO, "node", i, std::to_string(i).c_str(), sink);
+  }
+  records = take(2u);
+  ASSERT_EQ(2u, records.size());
+  EXPECT_EQ("1", records[1].message);
+  records = take();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ("2", records[0].message);
+  EXPECT_EQ(0u, rcutils_logging_shm_sink_get_dropped_count(sink));
+}
+
+TEST_F(TestLoggingShmSink, full_ring_and_wraparound) {
+  open();
+  // Messages which can never fit are dropped.
+  const std::string huge(4096u, 'x');
+  rcutils_logging_shm_sink_output(
+    nullptr, RCUTILS_LOG_SEVERITY_INFO, "node", 0, huge.c_str(), sink);
+  EXPECT_EQ(1u, rcutils_logging_shm_sink_get_dropped_count(sink));
+
+  // Fill the ring, until messages are dropped rather than waiting for the reader.
+  const std::string message(100u, 'm');
+  int64_t written = 0;
+  while (1u == rcutils_logging_shm_sink_get_dropped_count(sink)) {
+    rcutils_logging_shm_sink_output(
+      nullptr, RCUTILS_LOG_SEVERITY_INFO, "node", written++, message.c_str(), sink);
+  }
+  EXPECT_EQ(2u, rcutils_logging_shm_reader_get_dropped_count(reader));
+  std::vector<taken_record_t> records = take();
+  ASSERT_EQ(static_cast<size_t>(written - 1), records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(static_cast<int64_t>(i), records[i].timestamp);
+  }
+
+  // Records of varying sizes go around the ring many times, padding its end.
+  int64_t next_taken = 0;
+  for (int64_t i = 0; i < 1000; ++i) {
+    const std::string varying(static_cast<size_t>(i % 300), 'a' + static_cast<char>(i % 26));
+    rcutils_logging_shm_sink_output(
+      nullptr, RCUTILS_LOG_SEVERITY_INFO, "node", i, varying.c_str(), sink);
+    if (i % 7 == 6) {
+      for (const taken_record_t & record : take()) {
+        EXPECT_EQ(next_taken, record.timestamp);
+        EXPECT_EQ(static_cast<size_t>(next_taken % 300), record.message.size());
+        ++next_taken;
+      }
+    }
+  }
+  for (const taken_record_t & record : take()) {
+    EXPECT_EQ(next_taken++, record.timestamp);
+  }
+  EXPECT_EQ(1000, next_taken);
+  EXPECT_EQ(2u, rcutils_logging_shm_sink_get_dropped_count(sink));
+}
+
+TEST_F(TestLoggingShmSink, concurrent_writers) {
+  options.capacity = 1u << 16;
+  open();
+  constexpr size_t thread_count = 4u;
+  constexpr int64_t messages_per_thread = 20000;
+  std::atomic<size_t> done_count(0u);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back(
+      [&, t]() {
+        const std::string thread_name = "thread" + std::to_string(t);
+        for (int64_t i = 0; i < messages_per_thread; ++i) {
+          rcutils_logging_shm_sink_output(
+            nullptr, RCUTILS_LOG_SEVERITY_INFO, thread_name.c_str(), i,
+            std::to_string(i).c_str(), sink);
+        }
+        ++done_count;
+      });
+  }
+
+  // The records of each thread are taken in order, with gaps only where they were dropped.
+  std::vector<int64_t> last(thread_count, -1);
+  size_t taken = 0u;
+  size_t out_of_order = 0u;
+  auto check = [&](const std::vector<taken_record_t> & records) {
+      for (const taken_record_t & record : records) {
+        const size_t t = std::stoul(record.name.substr(6));
+        if (record.timestamp <= last[t] || std::to_string(record.timestamp) != record.message) {
+          ++out_of_order;
+        }
+        last[t] = record.timestamp;
+        ++taken;
+      }
+    };
+  while (done_count < thread_count) {
+    check(take());
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  check(take());
+  EXPECT_EQ(0u, out_of_order);
+  EXPECT_EQ(
+    thread_count * static_cast<size_t>(messages_per_thread),
+    taken + rcutils_logging_shm_sink_get_dropped_count(sink));
+}
+
+TEST_F(TestLoggingShmSink, closed) {
+  open();
+  EXPECT_FALSE(rcutils_logging_shm_reader_is_closed(reader));
+  rcutils_logging_shm_sink_output(nullptr, RCUTILS_LOG_SEVERITY_INFO, "node", 1, "last", sink);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shm_sink_fini(sink));
+  sink = nullptr;
+
+  // The shared memory object is removed, while the reader still drains the ring.
+  rcutils_logging_shm_reader_t * late_reader = nullptr;
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_shm_reader_open(&late_reader, name.c_str(), rcutils_get_default_allocator()));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_logging_shm_reader_is_closed(reader));
+  std::vector<taken_record_t> records = take();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ("last", records[0].message);
+  EXPECT_TRUE(rcutils_logging_shm_reader_is_closed(reader));
+}
+
+TEST_F(TestLoggingShmSink, sink_dispatcher) {
+  open();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_set_output_format("{message}"));
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_add_sink(rcutils_logging_shm_sink_output, sink, RCUTILS_LOG_SEVERITY_INFO));
+  rcutils_logging_set_output_handler(rcutils_logging_sink_output_handler);
+  rcutils_log_location_t location = {"func", "file.c", 7u};
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_DEBUG, "node", "skipped");
+  rcutils_log(&location, RCUTILS_LOG_SEVERITY_ERROR, "node", "value %d", 42);
+  std::vector<taken_record_t> records = take();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, records[0].severity);
+  EXPECT_EQ("node", records[0].name);
+  EXPECT_EQ("value 42", records[0].message);
+  EXPECT_EQ("file.c", records[0].file_name);
+  EXPECT_EQ(7u, records[0].line_number);
+}
+
+#else
+
+TEST(TestLoggingShmSink, not_supported) {
+  rcutils_logging_shm_sink_t * sink = nullptr;
+  rcutils_logging_shm_sink_options_t options = rcutils_logging_shm_sink_get_default_options();
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_logging_shm_sink_init(&sink, &options, rcutils_get_default_allocator()));
+  rcutils_reset_error();
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/env.h"
+#include "rcutils/logging.h"
+
+// Format a message with the logging system initialized with the given output structure.
+static std::string format_structured(
+  const char * structure, const rcutils_log_location_t * location, const char * name,
+  const char * message)
+{
+  EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_STRUCTURE", structure));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+    EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_STRUCTURE", nullptr));
+  });
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&output, 16, &allocator));
+  EXPECT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_logging_format_message(
+      location, RCUTILS_LOG_SEVERITY_WARN, name, RCUTILS_MS_TO_NS(1500), message, &output));
+  std::string result = output.buffer;
+  EXPECT_EQ(result.size() + 1, output.buffer_length);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&output));
+  return result;
+}
+
+TEST(TestLoggingStructuredOutput, json) {
+  rcutils_log_location_t location = {"func", "dir/file.c", 42u};
+  EXPECT_EQ(
+    "{\"time_as_nanoseconds\":1500000000,\"severity\":\"WARN\",\"name\":\"node\","
+    "\"message\":\"Hello\","
+    "\"function_name\":\"func\",\"file_name\":\"dir/file.c\",\"line_number\":42}",
+    format_structured("json", &location, "node", "Hello"));
+
+  EXPECT_EQ(
+    "{\"time_as_nanoseconds\":1500000000,\"severity\":\"WARN\",\"name\":\"\",\"message\":\"\","
+    "\"function_name\":\"\",\"file_name\":\"\",\"line_number\":null}",
+    format_structured("json", nullptr, nullptr, ""));
+}
+
+TEST(TestLoggingStructuredOutput, json_escaping) {
+  rcutils_log_location_t location = {"func", "C:\\dir\\file.c", 42u};
+  EXPECT_EQ(
+    "{\"time_as_nanoseconds\":1500000000,\"severity\":\"WARN\",\"name\":\"node\","
+    "\"message\":\"say \\\"hi\\\"\\n\\tand \\u0001 \\\\ bye\\r\","
+    "\"function_name\":\"func\",\"file_name\":\"C:\\\\dir\\\\file.c\",\"line_number\":42}",
+    format_structured("json", &location, "node", "say \"hi\"\n\tand \x01 \\ bye\r"));
+
+  // The escaped message grows far beyond the initial capacity of the output.
+  std::string message(5000, '"');
+  std::string escaped;
+  for (size_t i = 0; i < message.size(); ++i) {
+    escaped += "\\\"";
+  }
+  EXPECT_EQ(
+    "{\"time_as_nanoseconds\":1500000000,\"severity\":\"WARN\",\"name\":\"node\","
+    "\"message\":\"" + escaped +
+    "\",\"function_name\":\"func\",\"file_name\":\"C:\\\\dir\\\\file.c\",\"line_number\":42}",
+    format_structured("json", &location, "node", message.c_str()));
+}
+
+TEST(TestLoggingStructuredOutput, sanitize_utf8) {
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  // Without sanitizing, invalid bytes are passed through.
+  EXPECT_EQ(
+    "{\"time_as_nanoseconds\":1500000000,\"severity\":\"WARN\",\"name\":\"node\","
+    "\"message\":\"bad \xFF \\\"byte\\\"\","
+    "\"function_name\":\"func\",\"file_name\":\"file.c\",\"line_number\":42}",
+    format_structured("json", &location, "node", "bad \xFF \"byte\""));
+
+  EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_SANITIZE_UTF8", "1"));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_TRUE(rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_SANITIZE_UTF8", nullptr));
+  });
+  EXPECT_EQ(
+    "{\"time_as_nanoseconds\":1500000000,\"severity\":\"WARN\",\"name\":\"n\xEF\xBF\xBD\","
+    "\"message\":\"bad \xEF\xBF\xBD \\\"byte\\\" \xE2\x82\xAC\xEF\xBF\xBD\","
+    "\"function_name\":\"func\",\"file_name\":\"file.c\",\"line_number\":42}",
+    format_structured("json", &location, "n\xC0", "bad \xFF \"byte\" \xE2\x82\xAC\xE2\x82"));
+
+  // The sanitized message grows far beyond the initial capacity of the output.
+  std::string message(3000, '\x80');
+  std::string sanitized;
+  for (size_t i = 0; i < message.size(); ++i) {
+    sanitized += "\xEF\xBF\xBD";
+  }
+  EXPECT_EQ(
+    "time_as_nanoseconds=1500000000 severity=WARN name=\"node\" message=\"" + sanitized +
+    "\" function_name=\"func\" file_name=\"file.c\" line_number=42",
+    format_structured("key_value", &location, "node", message.c_str()));
+
+  // The text output is left as it is.
+  EXPECT_EQ(
+    "[WARN] [0000000001.500000000] [node]: bad \xFF",
+    format_structured("text", &location, "node", "bad \xFF"));
+}
+
+TEST(TestLoggingStructuredOutput, key_value) {
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  EXPECT_EQ(
+    "time_as_nanoseconds=1500000000 severity=WARN name=\"node\" "
+    "message=\"a \\\"quoted\\\" word\" "
+    "function_name=\"func\" file_name=\"file.c\" line_number=42",
+    format_structured("key_value", &location, "node", "a \"quoted\" word"));
+}
+
+TEST(TestLoggingStructuredOutput, text) {
+  rcutils_log_location_t location = {"func", "file.c", 42u};
+  EXPECT_EQ(
+    "[WARN] [0000000001.500000000] [node]: Hello",
+    format_structured("", &location, "node", "Hello"));
+  EXPECT_EQ(
+    "[WARN] [0000000001.500000000] [node]: Hello",
+    format_structured("text", &location, "node", "Hello"));
+  // Invalid structures fall back to the output format.
+  EXPECT_EQ(
+    "[WARN] [0000000001.500000000] [node]: Hello",
+    format_structured("xml", &location, "node", "Hello"));
+  rcutils_reset_error();
+}
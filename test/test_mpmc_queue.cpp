@@ -0,0 +1,263 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "./time_bomb_allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/mpmc_queue.h"
+
+class MpmcQueueTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    allocator = get_counting_allocator();
+    queue = rcutils_get_zero_initialized_mpmc_queue();
+    rcutils_ret_t ret = rcutils_mpmc_queue_init(&queue, 5, sizeof(uint64_t), &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_fini(&queue));
+    EXPECT_EQ(
+      get_counting_allocator_allocations(allocator),
+      get_counting_allocator_deallocations(allocator));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_mpmc_queue_t queue;
+};
+
+TEST(test_mpmc_queue, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_mpmc_queue_t queue = rcutils_get_zero_initialized_mpmc_queue();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_init(nullptr, 1, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_init(&queue, 1, 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_init(&queue, 0, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_init(&queue, 1, 0, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_init(&queue, SIZE_MAX, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_init(&queue, 1024, SIZE_MAX, &allocator));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_mpmc_queue_init(&queue, 1, 1, &failing_allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_mpmc_queue_init(&queue, 1, 1, &time_bomb_allocator));
+  rcutils_reset_error();
+
+  uint8_t element = 0;
+  size_t count = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_mpmc_queue_push(&queue, &element));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_mpmc_queue_pop(&queue, &element));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_mpmc_queue_get_size(&queue, &count));
+  rcutils_reset_error();
+
+  // A single slot isn't enough.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_init(&queue, 1, 1, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_get_capacity(&queue, &count));
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_fini(&queue));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_fini(&queue));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(MpmcQueueTest, push_pop) {
+  size_t capacity = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_get_capacity(&queue, &capacity));
+  EXPECT_EQ(8u, capacity);
+
+  uint64_t element = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_mpmc_queue_pop(&queue, &element));
+  EXPECT_FALSE(rcutils_error_is_set());
+
+  // Go around the ring a few times.
+  for (uint64_t lap = 0; lap < 3; ++lap) {
+    for (uint64_t i = 0; i < capacity; ++i) {
+      element = lap * 100 + i;
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_push(&queue, &element));
+    }
+    element = 42;
+    EXPECT_EQ(RCUTILS_RET_NOT_ENOUGH_SPACE, rcutils_mpmc_queue_push(&queue, &element));
+    EXPECT_FALSE(rcutils_error_is_set());
+    size_t size = 0;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_get_size(&queue, &size));
+    EXPECT_EQ(capacity, size);
+
+    for (uint64_t i = 0; i < capacity; ++i) {
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_pop(&queue, &element));
+      EXPECT_EQ(lap * 100 + i, element);
+    }
+    EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_mpmc_queue_pop(&queue, &element));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_get_size(&queue, &size));
+    EXPECT_EQ(0u, size);
+  }
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_push(&queue, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_pop(&queue, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_push(nullptr, &element));
+  rcutils_reset_error();
+}
+
+TEST_F(MpmcQueueTest, push_pop_many) {
+  std::vector<uint64_t> elements(11);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    elements[i] = i;
+  }
+  size_t count = 42;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_push_many(&queue, nullptr, 0, &count));
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_push_many(&queue, elements.data(), 3, &count));
+  EXPECT_EQ(3u, count);
+  // Only five more fit.
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_mpmc_queue_push_many(&queue, elements.data() + 3, 8, &count));
+  EXPECT_EQ(5u, count);
+
+  std::vector<uint64_t> popped(elements.size(), 0);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_pop_many(&queue, popped.data(), 6, &count));
+  ASSERT_EQ(6u, count);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(i, popped[i]);
+  }
+  // These wrap around the end of the ring.
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_mpmc_queue_push_many(&queue, elements.data() + 8, 3, &count));
+  EXPECT_EQ(3u, count);
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_mpmc_queue_pop_many(&queue, popped.data(), popped.size(), &count));
+  ASSERT_EQ(5u, count);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(6u + i, popped[i]);
+  }
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_mpmc_queue_pop_many(&queue, popped.data(), popped.size(), &count));
+  EXPECT_EQ(0u, count);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_mpmc_queue_push_many(&queue, nullptr, 1, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mpmc_queue_pop_many(&queue, popped.data(), 1, nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(MpmcQueueTest, producers_consumers) {
+  static constexpr uint64_t producer_count = 4;
+  static constexpr uint64_t consumer_count = 4;
+  static constexpr uint64_t elements_per_producer = 50000;
+  // Each element is the index of its producer in the high bits and a counter in the low bits.
+  static constexpr int producer_shift = 32;
+
+  std::vector<std::thread> threads;
+  for (uint64_t p = 0; p < producer_count; ++p) {
+    threads.emplace_back(
+      [this, p]() {
+        uint64_t next = 0;
+        uint64_t batch[3];
+        while (next < elements_per_producer) {
+          size_t count = elements_per_producer - next < 3 ? elements_per_producer - next : 3;
+          for (size_t i = 0; i < count; ++i) {
+            batch[i] = (p << producer_shift) | (next + i);
+          }
+          size_t pushed = 0;
+          if (0 == next % 2) {
+            pushed = RCUTILS_RET_OK == rcutils_mpmc_queue_push(&queue, batch) ? 1 : 0;
+          } else {
+            ASSERT_EQ(
+              RCUTILS_RET_OK, rcutils_mpmc_queue_push_many(&queue, batch, count, &pushed));
+          }
+          next += pushed;
+          if (0 == pushed) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  // Each consumer sees the elements of a producer in the order they were pushed, and counts and
+  // sums the counters of each producer, to check that each element is popped once.
+  std::vector<std::vector<uint64_t>> counts(
+    consumer_count, std::vector<uint64_t>(producer_count, 0));
+  std::vector<std::vector<uint64_t>> sums(
+    consumer_count, std::vector<uint64_t>(producer_count, 0));
+  std::atomic<uint64_t> total_popped(0);
+  for (uint64_t c = 0; c < consumer_count; ++c) {
+    threads.emplace_back(
+      [this, c, &counts, &sums, &total_popped]() {
+        std::vector<uint64_t> last(producer_count, 0);
+        std::vector<bool> seen(producer_count, false);
+        uint64_t batch[4];
+        while (total_popped.load() < producer_count * elements_per_producer) {
+          size_t popped = 0;
+          ASSERT_EQ(RCUTILS_RET_OK, rcutils_mpmc_queue_pop_many(&queue, batch, 4, &popped));
+          for (size_t i = 0; i < popped; ++i) {
+            uint64_t p = batch[i] >> producer_shift;
+            uint64_t counter = batch[i] & ((uint64_t(1) << producer_shift) - 1);
+            ASSERT_LT(p, producer_count);
+            if (seen[p]) {
+              ASSERT_LT(last[p], counter);
+            }
+            seen[p] = true;
+            last[p] = counter;
+            ++counts[c][p];
+            sums[c][p] += counter;
+          }
+          total_popped += popped;
+          if (0 == popped) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+
+  for (uint64_t p = 0; p < producer_count; ++p) {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    for (uint64_t c = 0; c < consumer_count; ++c) {
+      count += counts[c][p];
+      sum += sums[c][p];
+    }
+    EXPECT_EQ(elements_per_producer, count);
+    EXPECT_EQ(elements_per_producer * (elements_per_producer - 1) / 2, sum);
+  }
+  uint64_t element = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_mpmc_queue_pop(&queue, &element));
+}
@@ -14,6 +14,16 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "./allocator_testing_utils.h"
 #include "./time_bomb_allocator_testing_utils.h"
 #include "rcutils/allocator.h"
@@ -42,3 +52,130 @@ TEST(TestProcess, test_get_executable_name) {
   EXPECT_STREQ("test_process", exec_name);
   allocator.deallocate(exec_name, allocator.state);
 }
+
+TEST(TestProcess, test_get_process_identity) {
+  const rcutils_process_identity_t * identity = rcutils_get_process_identity();
+  ASSERT_NE(nullptr, identity);
+  EXPECT_EQ(rcutils_get_pid(), identity->pid);
+  EXPECT_STREQ("test_process", identity->executable_name);
+  // The same identity is returned each time.
+  EXPECT_EQ(identity, rcutils_get_process_identity());
+  EXPECT_EQ(identity->executable_name, rcutils_get_process_identity()->executable_name);
+}
+
+TEST(TestProcess, test_get_process_identity_concurrently) {
+  std::vector<std::thread> threads;
+  std::vector<const rcutils_process_identity_t *> identities(8, nullptr);
+  for (size_t i = 0; i < identities.size(); ++i) {
+    threads.emplace_back(
+      [&identities, i]() {
+        identities[i] = rcutils_get_process_identity();
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  for (const rcutils_process_identity_t * identity : identities) {
+    ASSERT_EQ(rcutils_get_process_identity(), identity);
+    EXPECT_EQ(rcutils_get_pid(), identity->pid);
+    EXPECT_STREQ("test_process", identity->executable_name);
+  }
+}
+
+#ifndef _WIN32
+TEST(TestProcess, test_get_process_identity_after_fork) {
+  const int parent_pid = rcutils_get_process_identity()->pid;
+  pid_t child = fork();
+  ASSERT_NE(-1, child);
+  if (0 == child) {
+    const rcutils_process_identity_t * identity = rcutils_get_process_identity();
+    const bool ok = identity->pid == static_cast<int>(getpid()) &&
+      identity->pid != parent_pid &&
+      std::string("test_process") == identity->executable_name;
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(child, waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  EXPECT_EQ(parent_pid, rcutils_get_process_identity()->pid);
+}
+#endif
+
+TEST(TestProcess, test_cpu_set) {
+  rcutils_cpu_set_t cpu_set = rcutils_get_zero_initialized_cpu_set();
+  EXPECT_EQ(0u, rcutils_cpu_set_count(&cpu_set));
+  EXPECT_FALSE(rcutils_cpu_set_contains(&cpu_set, 0));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cpu_set_add(&cpu_set, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cpu_set_add(&cpu_set, 65));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cpu_set_add(&cpu_set, 65));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_cpu_set_add(&cpu_set, RCUTILS_CPU_SET_SIZE - 1));
+  EXPECT_EQ(3u, rcutils_cpu_set_count(&cpu_set));
+  EXPECT_TRUE(rcutils_cpu_set_contains(&cpu_set, 0));
+  EXPECT_FALSE(rcutils_cpu_set_contains(&cpu_set, 1));
+  EXPECT_TRUE(rcutils_cpu_set_contains(&cpu_set, 65));
+  EXPECT_TRUE(rcutils_cpu_set_contains(&cpu_set, RCUTILS_CPU_SET_SIZE - 1));
+  EXPECT_FALSE(rcutils_cpu_set_contains(&cpu_set, RCUTILS_CPU_SET_SIZE));
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_cpu_set_add(&cpu_set, RCUTILS_CPU_SET_SIZE));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_cpu_set_add(NULL, 0));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_cpu_set_contains(NULL, 0));
+  EXPECT_EQ(0u, rcutils_cpu_set_count(NULL));
+}
+
+TEST(TestProcess, test_set_current_thread_attributes) {
+  rcutils_thread_attributes_t attributes = rcutils_get_default_thread_attributes();
+  EXPECT_EQ(0u, rcutils_cpu_set_count(&attributes.cpu_set));
+  EXPECT_EQ(RCUTILS_THREAD_SCHEDULING_POLICY_INHERIT, attributes.scheduling_policy);
+
+  // The default attributes leave the thread as it is.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_set_current_attributes(&attributes));
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_set_current_attributes(NULL));
+  rcutils_reset_error();
+  // All the values in the range of the policies are valid, so copy in an invalid one like C would.
+  const int invalid_policy = 4;
+  static_assert(
+    sizeof(invalid_policy) == sizeof(attributes.scheduling_policy),
+    "the policies are stored as ints");
+  memcpy(&attributes.scheduling_policy, &invalid_policy, sizeof(invalid_policy));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_set_current_attributes(&attributes));
+  rcutils_reset_error();
+  attributes.scheduling_policy = RCUTILS_THREAD_SCHEDULING_POLICY_FIFO;
+  attributes.priority = 100000;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_set_current_attributes(&attributes));
+  rcutils_reset_error();
+}
+
+#ifdef __linux__
+TEST(TestProcess, test_set_current_thread_cpu_set) {
+  rcutils_cpu_set_t allowed = rcutils_get_zero_initialized_cpu_set();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_get_current_cpu_set(&allowed));
+  ASSERT_LT(0u, rcutils_cpu_set_count(&allowed));
+  size_t cpu = RCUTILS_CPU_SET_SIZE - 1;
+  while (!rcutils_cpu_set_contains(&allowed, cpu)) {
+    --cpu;
+  }
+
+  // Pin another thread, so that the CPUs of this one are left alone.
+  std::thread thread(
+    [cpu]() {
+      rcutils_thread_attributes_t attributes = rcutils_get_default_thread_attributes();
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_cpu_set_add(&attributes.cpu_set, cpu));
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_set_current_attributes(&attributes)) <<
+        rcutils_get_error_string().str;
+      rcutils_cpu_set_t pinned = rcutils_get_zero_initialized_cpu_set();
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_get_current_cpu_set(&pinned));
+      EXPECT_EQ(1u, rcutils_cpu_set_count(&pinned));
+      EXPECT_TRUE(rcutils_cpu_set_contains(&pinned, cpu));
+    });
+  thread.join();
+
+  rcutils_cpu_set_t unchanged = rcutils_get_zero_initialized_cpu_set();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_get_current_cpu_set(&unchanged));
+  EXPECT_EQ(rcutils_cpu_set_count(&allowed), rcutils_cpu_set_count(&unchanged));
+}
+#endif
@@ -0,0 +1,236 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "rcutils/error_handling.h"
+#include "rcutils/profiling.h"
+
+// Histograms are too large for the stack of some platforms' test threads.
+static std::unique_ptr<rcutils_latency_histogram_t> make_histogram()
+{
+  return std::unique_ptr<rcutils_latency_histogram_t>(new rcutils_latency_histogram_t());
+}
+
+static rcutils_duration_value_t get_percentile(
+  const rcutils_latency_histogram_t * histogram, double percentile)
+{
+  rcutils_duration_value_t duration = -1;
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_latency_histogram_get_percentile(histogram, percentile, &duration));
+  return duration;
+}
+
+TEST(test_profiling, histogram_empty) {
+  auto histogram = make_histogram();
+  EXPECT_EQ(0u, histogram->total_count);
+  EXPECT_EQ(0, rcutils_latency_histogram_get_min(histogram.get()));
+  EXPECT_EQ(0, rcutils_latency_histogram_get_max(histogram.get()));
+  EXPECT_EQ(0, get_percentile(histogram.get(), 50.0));
+  EXPECT_EQ(0, get_percentile(histogram.get(), 100.0));
+}
+
+TEST(test_profiling, histogram_record) {
+  auto histogram = make_histogram();
+  // Small durations are exact.
+  for (rcutils_duration_value_t duration = 1; duration <= 10; ++duration) {
+    rcutils_latency_histogram_record(histogram.get(), duration);
+  }
+  EXPECT_EQ(10u, histogram->total_count);
+  EXPECT_EQ(55u, histogram->total_duration);
+  EXPECT_EQ(1, rcutils_latency_histogram_get_min(histogram.get()));
+  EXPECT_EQ(10, rcutils_latency_histogram_get_max(histogram.get()));
+  EXPECT_EQ(1, get_percentile(histogram.get(), 0.0));
+  EXPECT_EQ(1, get_percentile(histogram.get(), 10.0));
+  EXPECT_EQ(5, get_percentile(histogram.get(), 50.0));
+  EXPECT_EQ(9, get_percentile(histogram.get(), 90.0));
+  EXPECT_EQ(10, get_percentile(histogram.get(), 100.0));
+
+  // Negative durations are recorded as zero.
+  rcutils_latency_histogram_record(histogram.get(), -5);
+  EXPECT_EQ(0, rcutils_latency_histogram_get_min(histogram.get()));
+  EXPECT_EQ(0, get_percentile(histogram.get(), 0.0));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_reset(histogram.get()));
+  EXPECT_EQ(0u, histogram->total_count);
+  EXPECT_EQ(0, rcutils_latency_histogram_get_max(histogram.get()));
+  EXPECT_EQ(0, get_percentile(histogram.get(), 50.0));
+}
+
+TEST(test_profiling, histogram_precision) {
+  auto histogram = make_histogram();
+  // Durations from 1 microsecond to about 1 hour.
+  for (rcutils_duration_value_t duration = 1000; duration < RCUTILS_S_TO_NS(4000);
+    duration = duration * 5 / 3 + 7)
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_reset(histogram.get()));
+    rcutils_latency_histogram_record(histogram.get(), duration);
+    rcutils_latency_histogram_record(histogram.get(), duration * 2);
+    const rcutils_duration_value_t median = get_percentile(histogram.get(), 50.0);
+    EXPECT_GE(median, duration);
+    EXPECT_LE(median, duration + duration / RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS) << duration;
+    // The largest percentile is exact, being the largest duration.
+    EXPECT_EQ(duration * 2, get_percentile(histogram.get(), 100.0));
+  }
+
+  // The largest durations have a bucket as well.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_reset(histogram.get()));
+  rcutils_latency_histogram_record(histogram.get(), INT64_MAX);
+  EXPECT_EQ(INT64_MAX, get_percentile(histogram.get(), 50.0));
+  EXPECT_EQ(INT64_MAX, rcutils_latency_histogram_get_min(histogram.get()));
+}
+
+TEST(test_profiling, histogram_percentile_invalid_arguments) {
+  auto histogram = make_histogram();
+  rcutils_duration_value_t duration;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_latency_histogram_get_percentile(nullptr, 50.0, &duration));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_latency_histogram_get_percentile(histogram.get(), 50.0, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_latency_histogram_get_percentile(histogram.get(), -1.0, &duration));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_latency_histogram_get_percentile(histogram.get(), 100.5, &duration));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_latency_histogram_get_percentile(histogram.get(), std::nan(""), &duration));
+  rcutils_reset_error();
+}
+
+TEST(test_profiling, histogram_snapshot_and_merge) {
+  auto first = make_histogram();
+  auto second = make_histogram();
+  auto snapshot = make_histogram();
+  for (rcutils_duration_value_t duration = 1; duration <= 100; ++duration) {
+    rcutils_latency_histogram_record(first.get(), duration);
+    rcutils_latency_histogram_record(second.get(), duration + 1000);
+  }
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_merge(first.get(), second.get()));
+  EXPECT_EQ(200u, first->total_count);
+  EXPECT_EQ(1, rcutils_latency_histogram_get_min(first.get()));
+  EXPECT_EQ(1100, rcutils_latency_histogram_get_max(first.get()));
+  const rcutils_duration_value_t median = get_percentile(first.get(), 50.0);
+  EXPECT_GE(median, 100);
+  EXPECT_LE(median, 100 + 100 / RCUTILS_LATENCY_HISTOGRAM_SUB_BUCKETS);
+  // The merged histogram is unchanged.
+  EXPECT_EQ(100u, second->total_count);
+  EXPECT_EQ(1001, rcutils_latency_histogram_get_min(second.get()));
+
+  // Merging into an empty histogram copies it.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_snapshot(first.get(), snapshot.get()));
+  auto merged = make_histogram();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_merge(merged.get(), first.get()));
+  EXPECT_EQ(0, memcmp(snapshot.get(), merged.get(), sizeof(rcutils_latency_histogram_t)));
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_latency_histogram_merge(first.get(), first.get()));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_latency_histogram_merge(first.get(), nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_latency_histogram_snapshot(nullptr, snapshot.get()));
+  rcutils_reset_error();
+}
+
+TEST(test_profiling, histogram_concurrent_record) {
+  auto histogram = make_histogram();
+  auto snapshot = make_histogram();
+  constexpr size_t thread_count = 4u;
+  constexpr rcutils_duration_value_t durations = 10000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0u; i < thread_count; ++i) {
+    threads.emplace_back(
+      [&histogram]() {
+        for (rcutils_duration_value_t duration = 1; duration <= durations; ++duration) {
+          rcutils_latency_histogram_record(histogram.get(), duration);
+        }
+      });
+  }
+  // Snapshots may be taken while the threads record.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_snapshot(histogram.get(), snapshot.get()));
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_latency_histogram_snapshot(histogram.get(), snapshot.get()));
+  EXPECT_EQ(thread_count * durations, snapshot->total_count);
+  EXPECT_EQ(thread_count * durations * (durations + 1) / 2, snapshot->total_duration);
+  uint64_t count = 0u;
+  for (uint64_t bucket_count : snapshot->counts) {
+    count += bucket_count;
+  }
+  EXPECT_EQ(thread_count * durations, count);
+  EXPECT_EQ(1, rcutils_latency_histogram_get_min(snapshot.get()));
+  EXPECT_EQ(durations, rcutils_latency_histogram_get_max(snapshot.get()));
+}
+
+TEST(test_profiling, stopwatch) {
+  auto histogram = make_histogram();
+  rcutils_stopwatch_t stopwatch;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stopwatch_start(&stopwatch));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  rcutils_duration_value_t elapsed = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stopwatch_elapsed(&stopwatch, &elapsed));
+  EXPECT_GE(elapsed, RCUTILS_MS_TO_NS(10));
+
+  // Recording restarts the stopwatch, so consecutive durations add up.
+  rcutils_duration_value_t first = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stopwatch_record(&stopwatch, histogram.get(), &first));
+  EXPECT_GE(first, elapsed);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_stopwatch_record(&stopwatch, histogram.get(), nullptr));
+  EXPECT_EQ(2u, histogram->total_count);
+  EXPECT_GE(rcutils_latency_histogram_get_min(histogram.get()), RCUTILS_MS_TO_NS(1));
+  EXPECT_LT(rcutils_latency_histogram_get_min(histogram.get()), first);
+  EXPECT_EQ(first, rcutils_latency_histogram_get_max(histogram.get()));
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stopwatch_start(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stopwatch_elapsed(&stopwatch, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_stopwatch_record(&stopwatch, nullptr, nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_profiling, scoped_stopwatch) {
+  auto histogram = make_histogram();
+  for (int i = 0; i < 3; ++i) {
+    RCUTILS_PROFILE_SCOPE(*histogram);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(3u, histogram->total_count);
+  EXPECT_GE(rcutils_latency_histogram_get_min(histogram.get()), RCUTILS_MS_TO_NS(1));
+
+  {
+    rcutils_scoped_stopwatch stopwatch(*histogram);
+    EXPECT_EQ(3u, histogram->total_count);
+  }
+  EXPECT_EQ(4u, histogram->total_count);
+}
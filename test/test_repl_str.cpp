@@ -14,11 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <string>
 
 #include "./allocator_testing_utils.h"
 #include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
 #include "rcutils/repl_str.h"
+#include "rcutils/types/char_array.h"
 
 TEST(test_repl_str, nominal) {
   auto allocator = rcutils_get_default_allocator();
@@ -90,3 +93,88 @@ TEST(test_repl_str, nominal) {
     allocator.deallocate(out, allocator.state);
   }
 }
+
+TEST(test_repl_str, invalid_arguments) {
+  auto allocator = rcutils_get_default_allocator();
+  EXPECT_EQ(nullptr, rcutils_repl_str("foo/{bar}/baz", "", "bar", &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str(nullptr, "{bar}", "bar", &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str("foo/{bar}/baz", nullptr, "bar", &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str("foo/{bar}/baz", "{bar}", nullptr, &allocator));
+  rcutils_reset_error();
+}
+
+TEST(test_repl_str, many_matches) {
+  auto allocator = rcutils_get_default_allocator();
+
+  // matches back to back, at both ends, and overlapping ones which are replaced from the left
+  {
+    char * out = rcutils_repl_str("aaaaa", "aa", "b", &allocator);
+    EXPECT_STREQ("bba", out);
+    allocator.deallocate(out, allocator.state);
+  }
+  {
+    char * out = rcutils_repl_str("", "{bar}", "bar", &allocator);
+    EXPECT_STREQ("", out);
+    allocator.deallocate(out, allocator.state);
+  }
+
+  // a long string with long patterns, compared with std::string
+  std::string str;
+  std::string expected;
+  const std::string from = "${launch_configuration_argument}";
+  const std::string to = "value";
+  for (size_t i = 0; i < 10000; ++i) {
+    std::string text = "text_" + std::to_string(i) + "_$" + "{launch}";
+    str += text + (i % 3 == 0 ? from : "");
+    expected += text + (i % 3 == 0 ? to : "");
+  }
+  char * out = rcutils_repl_str(str.c_str(), from.c_str(), to.c_str(), &allocator);
+  ASSERT_NE(nullptr, out);
+  EXPECT_EQ(expected, out);
+  allocator.deallocate(out, allocator.state);
+}
+
+TEST(test_repl_str, append) {
+  auto allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t char_array = rcutils_get_zero_initialized_char_array();
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_append("a", "a", "b", nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_append("a", "", "b", &char_array));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_append(nullptr, "a", "b", &char_array));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&char_array, 0, &allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_repl_str_append("foo/{bar}/baz", "{bar}", "x", &char_array));
+  EXPECT_STREQ("foo/x/baz", char_array.buffer);
+  EXPECT_EQ(strlen("foo/x/baz") + 1, char_array.buffer_length);
+  // the results are appended
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_repl_str_append(";{bar}{bar};", "{bar}", "yy", &char_array));
+  EXPECT_STREQ("foo/x/baz;yyyy;", char_array.buffer);
+  EXPECT_EQ(strlen("foo/x/baz;yyyy;") + 1, char_array.buffer_length);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_repl_str_append("", "{bar}", "yy", &char_array));
+  EXPECT_STREQ("foo/x/baz;yyyy;", char_array.buffer);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&char_array));
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  char buffer[8] = "abc";
+  char_array.buffer = buffer;
+  char_array.owns_buffer = false;
+  char_array.buffer_length = 4;
+  char_array.buffer_capacity = sizeof(buffer);
+  char_array.allocator = failing_allocator;
+  // the char array is written in place while the result fits
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_repl_str_append("{b}", "{b}", "d", &char_array));
+  EXPECT_STREQ("abcd", buffer);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_repl_str_append("{bar}{bar}", "{bar}", "long", &char_array));
+  rcutils_reset_error();
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "./time_bomb_allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/ring_buffer.h"
+
+TEST(test_ring_buffer, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_ring_buffer_t ring_buffer = rcutils_get_zero_initialized_ring_buffer();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_init(nullptr, 4, 4, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_init(&ring_buffer, 4, 4, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_init(&ring_buffer, 0, 4, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_init(&ring_buffer, 4, 0, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_ring_buffer_init(&ring_buffer, 4, SIZE_MAX, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_ring_buffer_init(&ring_buffer, SIZE_MAX, 4, &allocator));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_ring_buffer_init(&ring_buffer, 4, 4, &failing_allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_calloc_count(time_bomb_allocator, 0);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_ring_buffer_init(&ring_buffer, 4, 4, &time_bomb_allocator));
+  rcutils_reset_error();
+
+  uint32_t element = 0;
+  size_t count = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_ring_buffer_push(&ring_buffer, &element));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED, rcutils_ring_buffer_snapshot(&ring_buffer, &element, 1, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_ring_buffer_get_capacity(&ring_buffer, &count));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_init(&ring_buffer, 3, 4, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_get_capacity(&ring_buffer, &count));
+  EXPECT_EQ(3u, count);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_get_capacity(&ring_buffer, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_push(&ring_buffer, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_snapshot(&ring_buffer, nullptr, 1, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_ring_buffer_snapshot(&ring_buffer, &element, 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_fini(&ring_buffer));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_fini(&ring_buffer));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_ring_buffer_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_ring_buffer, overwrite_oldest) {
+  // An element size which isn't a multiple of the words the slots are made of.
+  struct element_t
+  {
+    uint32_t value;
+    char tag[7];
+  };
+  rcutils_allocator_t allocator = get_counting_allocator();
+  rcutils_ring_buffer_t ring_buffer = rcutils_get_zero_initialized_ring_buffer();
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_ring_buffer_init(&ring_buffer, 5, sizeof(element_t), &allocator));
+
+  element_t elements[8];
+  size_t count = 42;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_snapshot(&ring_buffer, elements, 8, &count));
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_snapshot(&ring_buffer, nullptr, 0, &count));
+  EXPECT_EQ(0u, count);
+
+  for (uint32_t i = 0; i < 3; ++i) {
+    element_t element = {i, "abcdef"};
+    element.tag[0] = static_cast<char>('a' + i);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_push(&ring_buffer, &element));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_snapshot(&ring_buffer, elements, 8, &count));
+  ASSERT_EQ(3u, count);
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, elements[i].value);
+    EXPECT_EQ('a' + i, elements[i].tag[0]);
+    EXPECT_STREQ("bcdef", &elements[i].tag[1]);
+  }
+
+  for (uint32_t i = 3; i < 12; ++i) {
+    element_t element = {i, "abcdef"};
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_push(&ring_buffer, &element));
+  }
+  uint64_t pushed_count = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_get_pushed_count(&ring_buffer, &pushed_count));
+  EXPECT_EQ(12u, pushed_count);
+  // Only the last five are kept, oldest first.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_snapshot(&ring_buffer, elements, 8, &count));
+  ASSERT_EQ(5u, count);
+  for (uint32_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(7 + i, elements[i].value);
+  }
+  // Fewer than that are the most recent ones.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_snapshot(&ring_buffer, elements, 2, &count));
+  ASSERT_EQ(2u, count);
+  EXPECT_EQ(10u, elements[0].value);
+  EXPECT_EQ(11u, elements[1].value);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_fini(&ring_buffer));
+  EXPECT_EQ(
+    get_counting_allocator_allocations(allocator),
+    get_counting_allocator_deallocations(allocator));
+}
+
+TEST(test_ring_buffer, concurrent_snapshots) {
+  constexpr size_t capacity = 16;
+  constexpr uint64_t push_count = 200000;
+  constexpr size_t words = 5;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_ring_buffer_t ring_buffer = rcutils_get_zero_initialized_ring_buffer();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_ring_buffer_init(&ring_buffer, capacity, words * sizeof(uint64_t), &allocator));
+
+  std::atomic<bool> done(false);
+  std::atomic<uint64_t> torn_elements(0);
+  std::atomic<uint64_t> gaps(0);
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < 2; ++i) {
+    readers.emplace_back(
+      [&]() {
+        uint64_t elements[capacity][words];
+        while (!done) {
+          size_t count = 0;
+          if (RCUTILS_RET_OK != rcutils_ring_buffer_snapshot(
+              &ring_buffer, elements, capacity, &count))
+          {
+            ++torn_elements;
+            return;
+          }
+          for (size_t j = 0; j < count; ++j) {
+            // All the words of an element are the same, and elements are consecutive.
+            for (size_t k = 1; k < words; ++k) {
+              if (elements[j][k] != elements[j][0]) {
+                ++torn_elements;
+              }
+            }
+            if (j > 0 && elements[j][0] != elements[j - 1][0] + 1) {
+              ++gaps;
+            }
+          }
+          std::this_thread::yield();
+        }
+      });
+  }
+  for (uint64_t i = 0; i < push_count; ++i) {
+    uint64_t element[words];
+    for (size_t k = 0; k < words; ++k) {
+      element[k] = i;
+    }
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_push(&ring_buffer, element));
+  }
+  done = true;
+  for (auto & reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0u, torn_elements);
+  EXPECT_EQ(0u, gaps);
+
+  uint64_t elements[capacity][words];
+  size_t count = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_ring_buffer_snapshot(&ring_buffer, elements, capacity, &count));
+  ASSERT_EQ(capacity, count);
+  EXPECT_EQ(push_count - 1, elements[capacity - 1][0]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_ring_buffer_fini(&ring_buffer));
+}
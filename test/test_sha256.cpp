@@ -14,6 +14,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+# include <sys/stat.h>
+#endif
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
 #include "rcutils/sha256.h"
 
 TEST(TestSHA256, test_text1) {
@@ -73,3 +85,160 @@ TEST(TestSHA256, test_multi_update) {
 
   ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE));
 }
+
+TEST(TestSHA256, test_chunked_update) {
+  // Large enough to be hashed in many blocks at once, and not a multiple of the block size.
+  std::vector<uint8_t> data(100000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+  }
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE] = {
+    0x55, 0xaf, 0x39, 0x4c, 0x98, 0x0c, 0x7a, 0x7f,
+    0xb6, 0x8a, 0xa9, 0x04, 0xc4, 0xaf, 0xdd, 0x93,
+    0xd7, 0x6e, 0x5f, 0x82, 0x64, 0x87, 0x10, 0x5f,
+    0xc0, 0x6f, 0x92, 0xa2, 0x5b, 0xab, 0x8c, 0xbe};
+
+  // Chunks smaller than, equal to, and larger than a block, aligned or not with the blocks.
+  for (size_t chunk_size : {1u, 63u, 64u, 65u, 1000u, 4096u, 100000u}) {
+    uint8_t buf[RCUTILS_SHA256_BLOCK_SIZE];
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    for (size_t i = 0; i < data.size(); i += chunk_size) {
+      rcutils_sha256_update(&ctx, data.data() + i, std::min(chunk_size, data.size() - i));
+    }
+    rcutils_sha256_final(&ctx, buf);
+    EXPECT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE)) << chunk_size;
+  }
+}
+
+TEST(TestSHA256, test_many) {
+  // Messages of every length up to a few blocks, and some larger ones.
+  std::vector<std::vector<uint8_t>> messages;
+  for (size_t length = 0; length < 300; ++length) {
+    messages.emplace_back(length);
+  }
+  for (size_t length : {4096u, 10000u, 65536u}) {
+    messages.emplace_back(length);
+  }
+  for (size_t i = 0; i < messages.size(); ++i) {
+    for (size_t j = 0; j < messages[i].size(); ++j) {
+      messages[i][j] = static_cast<uint8_t>(i * 13 + j * 7 + (j >> 8));
+    }
+  }
+
+  std::vector<std::array<uint8_t, RCUTILS_SHA256_BLOCK_SIZE>> expected_hashes(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    rcutils_sha256_update(&ctx, messages[i].data(), messages[i].size());
+    rcutils_sha256_final(&ctx, expected_hashes[i].data());
+  }
+
+  // Split each message in two updates, the first of which leaves data buffered in the context.
+  for (size_t split : {0u, 1u, 63u, 64u, 100u}) {
+    std::vector<rcutils_sha256_ctx_t> ctxs(messages.size());
+    std::vector<const uint8_t *> data(messages.size());
+    std::vector<size_t> data_lens(messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+      rcutils_sha256_init(&ctxs[i]);
+      data[i] = messages[i].data();
+      data_lens[i] = std::min(split, messages[i].size());
+    }
+    rcutils_sha256_update_many(ctxs.data(), data.data(), data_lens.data(), ctxs.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+      data[i] = messages[i].data() + data_lens[i];
+      data_lens[i] = messages[i].size() - data_lens[i];
+    }
+    rcutils_sha256_update_many(ctxs.data(), data.data(), data_lens.data(), ctxs.size());
+
+    std::vector<uint8_t> hashes(messages.size() * RCUTILS_SHA256_BLOCK_SIZE);
+    rcutils_sha256_final_many(
+      ctxs.data(), ctxs.size(),
+      reinterpret_cast<uint8_t (*)[RCUTILS_SHA256_BLOCK_SIZE]>(hashes.data()));
+    for (size_t i = 0; i < messages.size(); ++i) {
+      EXPECT_EQ(
+        0, memcmp(
+          expected_hashes[i].data(), &hashes[i * RCUTILS_SHA256_BLOCK_SIZE],
+          RCUTILS_SHA256_BLOCK_SIZE)) << "message " << i << ", split " << split;
+    }
+  }
+}
+
+static void expect_sha256_file(const char * path, const std::vector<uint8_t> & contents)
+{
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE];
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_sha256_update(&ctx, contents.data(), contents.size());
+  rcutils_sha256_final(&ctx, expected_hash);
+
+  uint8_t hash[RCUTILS_SHA256_BLOCK_SIZE];
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_sha256_file(path, hash, rcutils_get_default_allocator()));
+  EXPECT_EQ(0, memcmp(expected_hash, hash, RCUTILS_SHA256_BLOCK_SIZE)) << contents.size();
+}
+
+TEST(TestSHA256, test_file) {
+  const char * path = "sha256_test_file";
+  // Sizes around the chunks the file is hashed in.
+  for (size_t size : {0u, 1u, 1000u, 1048576u, 3000000u}) {
+    std::vector<uint8_t> contents(size);
+    for (size_t i = 0; i < size; ++i) {
+      contents[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+    FILE * file = fopen(path, "wb");
+    ASSERT_NE(nullptr, file);
+    if (size > 0) {
+      ASSERT_EQ(size, fwrite(contents.data(), 1, size, file));
+    }
+    fclose(file);
+    expect_sha256_file(path, contents);
+  }
+  remove(path);
+
+  uint8_t hash[RCUTILS_SHA256_BLOCK_SIZE];
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_sha256_file("non_existing_sha256_test_file", hash, rcutils_get_default_allocator()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_sha256_file(nullptr, hash, rcutils_get_default_allocator()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_sha256_file(path, nullptr, rcutils_get_default_allocator()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_sha256_file(path, hash, rcutils_get_zero_initialized_allocator()));
+  rcutils_reset_error();
+}
+
+#ifndef _WIN32
+TEST(TestSHA256, test_file_pipe) {
+  // Pipes can't be mapped, so they are read into buffers.
+  const char * path = "sha256_test_pipe";
+  remove(path);
+  ASSERT_EQ(0, mkfifo(path, 0600));
+  std::vector<uint8_t> contents(3000000);
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<uint8_t>(i * 13 + (i >> 10));
+  }
+  std::thread writer(
+    [path, &contents]() {
+      FILE * file = fopen(path, "wb");
+      ASSERT_NE(nullptr, file);
+      // Written in small parts, so that reads return less than asked for.
+      for (size_t i = 0; i < contents.size(); i += 10000) {
+        ASSERT_EQ(
+          std::min<size_t>(10000, contents.size() - i),
+          fwrite(&contents[i], 1, std::min<size_t>(10000, contents.size() - i), file));
+        fflush(file);
+      }
+      fclose(file);
+    });
+  expect_sha256_file(path, contents);
+  writer.join();
+  remove(path);
+}
+#endif
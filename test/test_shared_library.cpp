@@ -14,7 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "./allocator_testing_utils.h"
 #include "./mocking_utils/patch.hpp"
@@ -115,6 +117,35 @@ TEST_F(TestSharedLibrary, load_two_times) {
   EXPECT_EQ(RCUTILS_RET_OK, ret);
 }
 
+TEST_F(TestSharedLibrary, load_with_flags) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_ret_t ret = rcutils_get_platform_library_name(
+    RCUTILS_STRINGIFY(SHARED_LIBRARY_UNDER_TEST), library_path, 1024, false);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  ret = rcutils_load_shared_library_with_flags(&lib, library_path, 1u << 31, allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  EXPECT_FALSE(rcutils_is_shared_library_loaded(&lib));
+
+  const uint32_t all_flags = RCUTILS_SHARED_LIBRARY_BIND_NOW | RCUTILS_SHARED_LIBRARY_GLOBAL |
+    RCUTILS_SHARED_LIBRARY_PREFAULT;
+  for (uint32_t flags = 0u; flags <= all_flags; ++flags) {
+    ret = rcutils_load_shared_library_with_flags(&lib, library_path, flags, allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_TRUE(rcutils_is_shared_library_loaded(&lib));
+    EXPECT_TRUE(rcutils_has_symbol(&lib, "print_name"));
+    // Loading it again, with other flags, shares the handle.
+    rcutils_shared_library_t other = rcutils_get_zero_initialized_shared_library();
+    ret = rcutils_load_shared_library_with_flags(
+      &other, library_path, all_flags & ~flags, allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    EXPECT_EQ(lib.lib_pointer, other.lib_pointer);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_unload_shared_library(&other));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_unload_shared_library(&lib));
+  }
+}
+
 TEST_F(TestSharedLibrary, error_load) {
   rcutils_ret_t ret;
 
@@ -218,3 +249,193 @@ TEST_F(TestSharedLibrary, basic_symbol) {
   ret = rcutils_unload_shared_library(&lib);
   ASSERT_EQ(RCUTILS_RET_OK, ret);
 }
+
+TEST_F(TestSharedLibrary, get_symbols) {
+  const char * names[] = {"print_name", "symbol", "print_name"};
+  void * symbols[3] = {nullptr, nullptr, nullptr};
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_get_symbols(&lib, names, 3, symbols));
+  rcutils_reset_error();
+
+  rcutils_ret_t ret = rcutils_get_platform_library_name(
+    RCUTILS_STRINGIFY(SHARED_LIBRARY_UNDER_TEST), library_path, 1024, false);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ret = rcutils_load_shared_library(&lib, library_path, rcutils_get_default_allocator());
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_get_symbols(nullptr, names, 3, symbols));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_get_symbols(&lib, nullptr, 3, symbols));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_get_symbols(&lib, names, 3, nullptr));
+  rcutils_reset_error();
+  const char * null_name[] = {"print_name", nullptr};
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_get_symbols(&lib, null_name, 2, symbols));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_get_symbols(&lib, nullptr, 0, nullptr));
+
+  // The missing symbol is reported, and the others are still returned.
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_get_symbols(&lib, names, 3, symbols));
+  EXPECT_NE(nullptr, strstr(rcutils_get_error_string().str, "'symbol'"));
+  rcutils_reset_error();
+  void * print_name = rcutils_get_symbol(&lib, "print_name");
+  ASSERT_NE(nullptr, print_name);
+  EXPECT_EQ(print_name, symbols[0]);
+  EXPECT_EQ(nullptr, symbols[1]);
+  EXPECT_EQ(print_name, symbols[2]);
+
+  // Cached lookups return the same results.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_get_symbols(&lib, names, 1, symbols));
+  EXPECT_EQ(print_name, symbols[0]);
+  EXPECT_EQ(print_name, rcutils_get_symbol(&lib, "print_name"));
+  EXPECT_TRUE(rcutils_has_symbol(&lib, "print_name"));
+  EXPECT_FALSE(rcutils_has_symbol(&lib, "symbol"));
+  EXPECT_EQ(nullptr, rcutils_get_symbol(&lib, "symbol"));
+  rcutils_reset_error();
+
+  // More symbols than are looked up at once.
+  std::vector<const char *> many_names(100, "print_name");
+  many_names[70] = "symbol";
+  std::vector<void *> many_symbols(many_names.size());
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_FOUND,
+    rcutils_get_symbols(&lib, many_names.data(), many_names.size(), many_symbols.data()));
+  rcutils_reset_error();
+  for (size_t i = 0; i < many_names.size(); ++i) {
+    EXPECT_EQ(i == 70 ? nullptr : print_name, many_symbols[i]);
+  }
+
+  ret = rcutils_unload_shared_library(&lib);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+}
+
+TEST_F(TestSharedLibrary, load_shared_between_handles) {
+  rcutils_ret_t ret = rcutils_get_platform_library_name(
+    RCUTILS_STRINGIFY(SHARED_LIBRARY_UNDER_TEST), library_path, 1024, false);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ret = rcutils_load_shared_library(&lib, library_path, rcutils_get_default_allocator());
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  void * print_name = rcutils_get_symbol(&lib, "print_name");
+  ASSERT_NE(nullptr, print_name);
+
+  // A second load of the library copies the resolved path, and shares the symbols.
+  rcutils_shared_library_t other = rcutils_get_zero_initialized_shared_library();
+  ret = rcutils_load_shared_library(&other, library_path, get_failing_allocator());
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret);
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, other.lib_pointer);
+  ret = rcutils_load_shared_library(&other, library_path, rcutils_get_default_allocator());
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(lib.lib_pointer, other.lib_pointer);
+  EXPECT_NE(lib.library_path, other.library_path);
+  EXPECT_STREQ(lib.library_path, other.library_path);
+  EXPECT_EQ(lib.symbol_cache, other.symbol_cache);
+  EXPECT_EQ(print_name, rcutils_get_symbol(&other, "print_name"));
+
+  // Each load keeps the library loaded.
+  ret = rcutils_unload_shared_library(&lib);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_TRUE(rcutils_is_shared_library_loaded(&other));
+  EXPECT_EQ(print_name, rcutils_get_symbol(&other, "print_name"));
+  EXPECT_FALSE(rcutils_has_symbol(&other, "symbol"));
+
+  // Loading it again after the other load was unloaded still works.
+  lib = rcutils_get_zero_initialized_shared_library();
+  ret = rcutils_load_shared_library(&lib, library_path, rcutils_get_default_allocator());
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ(other.library_path, lib.library_path);
+  ret = rcutils_unload_shared_library(&other);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ret = rcutils_unload_shared_library(&lib);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+}
+
+TEST_F(TestSharedLibrary, load_shared_libraries) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_ret_t ret = rcutils_get_platform_library_name(
+    RCUTILS_STRINGIFY(SHARED_LIBRARY_UNDER_TEST), library_path, 1024, false);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  char missing_path[1024];
+  ret = rcutils_get_platform_library_name("non_existing_library", missing_path, 1024, false);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_load_shared_libraries(nullptr, 0, 0, allocator));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_load_shared_libraries(nullptr, 1, 0, allocator));
+  rcutils_reset_error();
+
+  const size_t depends_on_0[] = {0};
+  const size_t depends_on_1[] = {1};
+  const size_t depends_on_2[] = {2};
+  const size_t out_of_range[] = {4};
+  std::vector<rcutils_shared_library_load_t> loads(4);
+  auto reset_loads = [&]() {
+      for (rcutils_shared_library_load_t & load : loads) {
+        load = rcutils_shared_library_load_t();
+        load.library_path = library_path;
+        load.library = rcutils_get_zero_initialized_shared_library();
+      }
+    };
+
+  // Invalid dependencies
+  reset_loads();
+  loads[3].dependencies = out_of_range;
+  loads[3].dependency_count = 1;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_load_shared_libraries(loads.data(), 4, 2, allocator));
+  rcutils_reset_error();
+  loads[3].dependencies = nullptr;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_load_shared_libraries(loads.data(), 4, 2, allocator));
+  rcutils_reset_error();
+  loads[3].dependency_count = 0;
+  loads[1].dependencies = depends_on_2;
+  loads[1].dependency_count = 1;
+  loads[2].dependencies = depends_on_1;
+  loads[2].dependency_count = 1;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_load_shared_libraries(loads.data(), 4, 2, allocator));
+  rcutils_reset_error();
+  for (rcutils_shared_library_load_t & load : loads) {
+    EXPECT_FALSE(rcutils_is_shared_library_loaded(&load.library));
+  }
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_load_shared_libraries(loads.data(), 4, 2, get_failing_allocator()));
+  rcutils_reset_error();
+
+  for (size_t thread_count : {0u, 1u, 2u, 8u}) {
+    // The library depending on the missing one isn't loaded, and the others are.
+    reset_loads();
+    loads[1].library_path = missing_path;
+    loads[2].dependencies = depends_on_1;
+    loads[2].dependency_count = 1;
+    loads[3].dependencies = depends_on_0;
+    loads[3].dependency_count = 1;
+    EXPECT_EQ(
+      RCUTILS_RET_ERROR,
+      rcutils_load_shared_libraries(loads.data(), loads.size(), thread_count, allocator));
+    EXPECT_NE(nullptr, strstr(rcutils_get_error_string().str, missing_path));
+    rcutils_reset_error();
+    EXPECT_EQ(RCUTILS_RET_OK, loads[0].ret);
+    EXPECT_EQ(RCUTILS_RET_ERROR, loads[1].ret);
+    EXPECT_EQ(RCUTILS_RET_ERROR, loads[2].ret);
+    EXPECT_NE(nullptr, strstr(loads[2].error.str, missing_path)) << loads[2].error.str;
+    EXPECT_FALSE(rcutils_is_shared_library_loaded(&loads[2].library));
+    EXPECT_EQ(RCUTILS_RET_OK, loads[3].ret);
+    EXPECT_TRUE(rcutils_has_symbol(&loads[3].library, "print_name"));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_unload_shared_library(&loads[0].library));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_unload_shared_library(&loads[3].library));
+
+    reset_loads();
+    loads[1].dependencies = depends_on_0;
+    loads[1].dependency_count = 1;
+    loads[2].flags = RCUTILS_SHARED_LIBRARY_BIND_NOW | RCUTILS_SHARED_LIBRARY_PREFAULT;
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_load_shared_libraries(loads.data(), loads.size(), thread_count, allocator));
+    for (rcutils_shared_library_load_t & load : loads) {
+      EXPECT_EQ(RCUTILS_RET_OK, load.ret);
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_unload_shared_library(&load.library));
+    }
+  }
+}
@@ -0,0 +1,280 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/qsort.h"
+#include "rcutils/sort.h"
+
+#define INT_LESS(lhs, rhs, context) (*(lhs) < *(rhs))
+RCUTILS_DEFINE_SORT(sort_ints, int, INT_LESS)
+
+struct record_t
+{
+  int key;
+  char name[12];
+};
+
+// Records are sorted by key, in descending order if the context says so.
+#define RECORD_LESS(lhs, rhs, context) \
+  (*static_cast<const bool *>(context) ? (lhs)->key > (rhs)->key : (lhs)->key < (rhs)->key)
+RCUTILS_DEFINE_SORT(sort_records, record_t, RECORD_LESS)
+
+static size_t g_comparisons = 0;
+
+#define COUNTING_LESS(lhs, rhs, context) (++g_comparisons, *(lhs) < *(rhs))
+RCUTILS_DEFINE_SORT(sort_ints_counting, int, COUNTING_LESS)
+
+static int int_cmp(const void * lhs, const void * rhs)
+{
+  int left = *static_cast<const int *>(lhs);
+  int right = *static_cast<const int *>(rhs);
+  return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static int uint64_cmp(const void * lhs, const void * rhs)
+{
+  uint64_t left = *static_cast<const uint64_t *>(lhs);
+  uint64_t right = *static_cast<const uint64_t *>(rhs);
+  return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static int record_cmp(const void * lhs, const void * rhs)
+{
+  return int_cmp(
+    &static_cast<const record_t *>(lhs)->key, &static_cast<const record_t *>(rhs)->key);
+}
+
+// Arrays of the given size in patterns which are known to be hard for some quicksorts.
+static std::vector<std::vector<int>> make_patterns(size_t size)
+{
+  std::mt19937 random(42);
+  std::vector<std::vector<int>> patterns;
+  std::vector<int> values(size);
+
+  for (int & value : values) {
+    value = static_cast<int>(random());
+  }
+  patterns.push_back(values);
+  for (int & value : values) {
+    value = static_cast<int>(random() % 4);
+  }
+  patterns.push_back(values);
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<int>(i);
+  }
+  patterns.push_back(values);
+  std::reverse(values.begin(), values.end());
+  patterns.push_back(values);
+  std::fill(values.begin(), values.end(), 7);
+  patterns.push_back(values);
+  // Sorted, but for a few elements
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<int>(i);
+  }
+  for (size_t i = 0; size > 0 && i < size / 100 + 1; ++i) {
+    std::swap(values[random() % size], values[random() % size]);
+  }
+  patterns.push_back(values);
+  // Organ pipe
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<int>(std::min(i, size - i));
+  }
+  patterns.push_back(values);
+  // Sawtooth
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<int>(i % 32);
+  }
+  patterns.push_back(values);
+  return patterns;
+}
+
+TEST(test_sort, define_sort) {
+  for (size_t size : {0u, 1u, 2u, 3u, 10u, 23u, 24u, 25u, 100u, 128u, 129u, 1000u, 100000u}) {
+    for (const std::vector<int> & pattern : make_patterns(size)) {
+      std::vector<int> values = pattern;
+      std::vector<int> expected = pattern;
+      std::sort(expected.begin(), expected.end());
+      sort_ints(values.data(), values.size(), nullptr);
+      ASSERT_EQ(expected, values) << "size " << size;
+    }
+  }
+}
+
+TEST(test_sort, define_sort_context) {
+  std::vector<record_t> records;
+  for (int i = 0; i < 1000; ++i) {
+    record_t record = {(i * 7919) % 1000, {}};
+    snprintf(record.name, sizeof(record.name), "%d", record.key);
+    records.push_back(record);
+  }
+
+  bool descending = true;
+  sort_records(records.data(), records.size(), &descending);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(999 - static_cast<int>(i), records[i].key);
+    EXPECT_EQ(std::to_string(records[i].key), records[i].name);
+  }
+
+  descending = false;
+  sort_records(records.data(), records.size(), &descending);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i), records[i].key);
+    EXPECT_EQ(std::to_string(records[i].key), records[i].name);
+  }
+}
+
+TEST(test_sort, define_sort_comparisons) {
+  const size_t size = 100000;
+  for (const std::vector<int> & pattern : make_patterns(size)) {
+    std::vector<int> values = pattern;
+    g_comparisons = 0;
+    sort_ints_counting(values.data(), values.size(), nullptr);
+    ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+    // O(n log n) comparisons for every pattern, with a generous factor
+    EXPECT_LT(g_comparisons, 4 * size * 17);
+  }
+
+  // Sorted and equal elements take a linear number of comparisons.
+  std::vector<int> values(size);
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<int>(i);
+  }
+  g_comparisons = 0;
+  sort_ints_counting(values.data(), values.size(), nullptr);
+  EXPECT_LT(g_comparisons, 4 * size);
+
+  std::fill(values.begin(), values.end(), 0);
+  g_comparisons = 0;
+  sort_ints_counting(values.data(), values.size(), nullptr);
+  EXPECT_LT(g_comparisons, 4 * size);
+}
+
+TEST(test_sort, qsort) {
+  int values[2] = {1, 0};
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_qsort(nullptr, 2, sizeof(int), int_cmp));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_qsort(values, 2, sizeof(int), nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_qsort(nullptr, 1, sizeof(int), int_cmp));
+
+  for (size_t size : {0u, 1u, 2u, 10u, 100u, 1000u, 100000u}) {
+    for (const std::vector<int> & pattern : make_patterns(size)) {
+      std::vector<int> expected = pattern;
+      std::sort(expected.begin(), expected.end());
+
+      std::vector<int> ints = pattern;
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_qsort(ints.data(), ints.size(), sizeof(int), int_cmp));
+      ASSERT_EQ(expected, ints);
+
+      std::vector<uint64_t> uint64s(pattern.begin(), pattern.end());
+      for (uint64_t & element : uint64s) {
+        element += UINT64_C(1) << 40;
+      }
+      ASSERT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_qsort(uint64s.data(), uint64s.size(), sizeof(uint64_t), uint64_cmp));
+      for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(static_cast<uint64_t>(expected[i]) + (UINT64_C(1) << 40), uint64s[i]);
+      }
+
+      // Larger elements
+      std::vector<record_t> records;
+      for (int key : pattern) {
+        record_t record = {key, {}};
+        snprintf(record.name, sizeof(record.name), "%d", key);
+        records.push_back(record);
+      }
+      ASSERT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_qsort(records.data(), records.size(), sizeof(record_t), record_cmp));
+      for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(expected[i], records[i].key);
+        ASSERT_EQ(std::to_string(expected[i]), records[i].name);
+      }
+    }
+  }
+}
+
+TEST(test_sort, qsort_parallel) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  int values[2] = {1, 0};
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_qsort_parallel(values, 2, sizeof(int), nullptr, 2, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_qsort_parallel(values, 2, sizeof(int), int_cmp, 2, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_qsort_parallel(nullptr, 2, sizeof(int), int_cmp, 2, &allocator));
+  rcutils_reset_error();
+
+  // Small arrays are sorted in the calling thread, without allocating.
+  EXPECT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_qsort_parallel(values, 2, sizeof(int), int_cmp, 2, &failing_allocator));
+  EXPECT_EQ(0, values[0]);
+  EXPECT_EQ(1, values[1]);
+
+  const size_t size = 5 * RCUTILS_QSORT_PARALLEL_MIN_COUNT + 3;
+  std::vector<std::vector<int>> patterns = make_patterns(size);
+  std::vector<int> ints = patterns[0];
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_qsort_parallel(ints.data(), ints.size(), sizeof(int), int_cmp, 4, &failing_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(patterns[0], ints);
+
+  for (size_t thread_count : {0u, 2u, 3u, 8u}) {
+    for (const std::vector<int> & pattern : patterns) {
+      std::vector<int> expected = pattern;
+      std::sort(expected.begin(), expected.end());
+
+      ints = pattern;
+      ASSERT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_qsort_parallel(
+          ints.data(), ints.size(), sizeof(int), int_cmp, thread_count, &allocator));
+      ASSERT_EQ(expected, ints) << thread_count << " threads";
+
+      std::vector<record_t> records;
+      for (int key : pattern) {
+        record_t record = {key, {}};
+        snprintf(record.name, sizeof(record.name), "%d", key);
+        records.push_back(record);
+      }
+      ASSERT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_qsort_parallel(
+          records.data(), records.size(), sizeof(record_t), record_cmp, thread_count,
+          &allocator));
+      for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(expected[i], records[i].key);
+        ASSERT_EQ(std::to_string(expected[i]), records[i].name);
+      }
+    }
+  }
+}
@@ -14,6 +14,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cstring>
+#include <string>
+
 #include "./allocator_testing_utils.h"
 #include "./time_bomb_allocator_testing_utils.h"
 #include "rcutils/error_handling.h"
@@ -252,3 +255,124 @@ TEST(test_split, split_last) {
   ret = rcutils_string_array_fini(&tokens8);
   ASSERT_EQ(RCUTILS_RET_OK, ret);
 }
+
+TEST(test_split, split_packed) {
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_split_packed("Test", '/', rcutils_get_default_allocator(), NULL));
+  rcutils_reset_error();
+
+  // the tokens are the same as those of rcutils_split()
+  const char * strings[] = {
+    "", "/", "///", "hello_world", "hello/world", "/hello/world", "hello/world/",
+    "hello//world", "/my/hello/world/", "///my//hello//world/////", "a/b/c/d/e/f/g/h",
+  };
+  for (const char * str : strings) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcutils_split(str, '/', rcutils_get_default_allocator(), &tokens));
+    rcutils_string_array_t packed_tokens;
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_split_packed(str, '/', rcutils_get_default_allocator(), &packed_tokens));
+    int res = 1;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_cmp(&tokens, &packed_tokens, &res));
+    EXPECT_EQ(0, res) << str;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&tokens));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&packed_tokens));
+  }
+
+  rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_split_packed(NULL, '/', rcutils_get_default_allocator(), &tokens));
+  EXPECT_EQ(0u, tokens.size);
+
+  // the tokens are stored back to back, in two allocations
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 0);
+  set_time_bomb_allocator_calloc_count(time_bomb_allocator, 0);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_split_packed("/my//hello/world", '/', time_bomb_allocator, &tokens));
+  rcutils_reset_error();
+  set_time_bomb_allocator_calloc_count(time_bomb_allocator, -1);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_split_packed("/my//hello/world", '/', time_bomb_allocator, &tokens));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, tokens.data);
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  set_time_bomb_allocator_calloc_count(time_bomb_allocator, 1);
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_split_packed("/my//hello/world", '/', time_bomb_allocator, &tokens));
+  ASSERT_EQ(3u, tokens.size);
+  EXPECT_EQ(tokens.arena, tokens.data[0]);
+  EXPECT_EQ(tokens.arena + 3, tokens.data[1]);
+  EXPECT_EQ(tokens.arena + 9, tokens.data[2]);
+  EXPECT_EQ(15u, tokens.arena_size);
+  EXPECT_STREQ("world", tokens.data[2]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&tokens));
+  EXPECT_EQ(nullptr, tokens.arena);
+}
+
+TEST(test_split, split_tokens) {
+  // the tokens are the same as those of rcutils_split()
+  const char * strings[] = {
+    "", "/", "///", "hello_world", "hello/world", "/hello/world", "hello/world/",
+    "hello//world", "/my/hello/world/", "///my//hello//world/////", "a/b/c/d/e/f/g/h",
+  };
+  for (const char * str : strings) {
+    rcutils_string_array_t expected = rcutils_get_zero_initialized_string_array();
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcutils_split(str, '/', rcutils_get_default_allocator(), &expected));
+
+    rcutils_split_iterator_t iterator = rcutils_get_split_iterator(str, '/');
+    rcutils_split_token_t token;
+    size_t i = 0;
+    while (rcutils_split_iterator_next(&iterator, &token)) {
+      ASSERT_LT(i, expected.size) << str;
+      EXPECT_EQ(std::string(expected.data[i]), std::string(token.data, token.length)) << str;
+      // the token is a view into the string
+      EXPECT_TRUE(token.data >= str && token.data + token.length <= str + strlen(str));
+      ++i;
+    }
+    EXPECT_EQ(expected.size, i) << str;
+    EXPECT_FALSE(rcutils_split_iterator_next(&iterator, &token));
+
+    rcutils_split_token_t tokens[8];
+    size_t count = 0;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_split_tokens(str, '/', tokens, 8, &count));
+    ASSERT_EQ(expected.size, count) << str;
+    for (i = 0; i < count; ++i) {
+      EXPECT_EQ(std::string(expected.data[i]), std::string(tokens[i].data, tokens[i].length));
+    }
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&expected));
+  }
+
+  rcutils_split_iterator_t iterator = rcutils_get_split_iterator(NULL, '/');
+  rcutils_split_token_t token;
+  EXPECT_FALSE(rcutils_split_iterator_next(&iterator, &token));
+  EXPECT_FALSE(rcutils_split_iterator_next(NULL, &token));
+  iterator = rcutils_get_split_iterator("a/b", '/');
+  EXPECT_FALSE(rcutils_split_iterator_next(&iterator, NULL));
+
+  // too many tokens for the array
+  rcutils_split_token_t tokens[2];
+  size_t count = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_ENOUGH_SPACE, rcutils_split_tokens("/my/hello/world", '/', tokens, 2, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(3u, count);
+  EXPECT_EQ("hello", std::string(tokens[1].data, tokens[1].length));
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_ENOUGH_SPACE, rcutils_split_tokens("/my/hello/world", '/', NULL, 0, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(3u, count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_split_tokens(NULL, '/', NULL, 0, &count));
+  EXPECT_EQ(0u, count);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_split_tokens("a", '/', tokens, 2, NULL));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_split_tokens("a", '/', NULL, 2, &count));
+  rcutils_reset_error();
+}
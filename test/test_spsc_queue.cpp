@@ -0,0 +1,218 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "./time_bomb_allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/spsc_queue.h"
+
+class SpscQueueTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    allocator = get_counting_allocator();
+    queue = rcutils_get_zero_initialized_spsc_queue();
+    rcutils_ret_t ret = rcutils_spsc_queue_init(&queue, 5, sizeof(uint64_t), &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_fini(&queue));
+    EXPECT_EQ(
+      get_counting_allocator_allocations(allocator),
+      get_counting_allocator_deallocations(allocator));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_spsc_queue_t queue;
+};
+
+TEST(test_spsc_queue, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_spsc_queue_t queue = rcutils_get_zero_initialized_spsc_queue();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_init(nullptr, 1, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_init(&queue, 1, 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_init(&queue, 0, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_init(&queue, 1, 0, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_init(&queue, SIZE_MAX, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_init(&queue, 1024, SIZE_MAX, &allocator));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_spsc_queue_init(&queue, 1, 1, &failing_allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_spsc_queue_init(&queue, 1, 1, &time_bomb_allocator));
+  rcutils_reset_error();
+
+  uint8_t element = 0;
+  size_t count = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_spsc_queue_push(&queue, &element));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_spsc_queue_pop(&queue, &element));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_spsc_queue_get_size(&queue, &count));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_init(&queue, 1, 1, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_get_capacity(&queue, &count));
+  EXPECT_EQ(1u, count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_fini(&queue));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_fini(&queue));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(SpscQueueTest, push_pop) {
+  size_t capacity = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_get_capacity(&queue, &capacity));
+  EXPECT_EQ(8u, capacity);
+
+  uint64_t element = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_spsc_queue_pop(&queue, &element));
+  EXPECT_FALSE(rcutils_error_is_set());
+
+  // Go around the ring a few times.
+  for (uint64_t lap = 0; lap < 3; ++lap) {
+    for (uint64_t i = 0; i < capacity; ++i) {
+      element = lap * 100 + i;
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_push(&queue, &element));
+    }
+    element = 42;
+    EXPECT_EQ(RCUTILS_RET_NOT_ENOUGH_SPACE, rcutils_spsc_queue_push(&queue, &element));
+    EXPECT_FALSE(rcutils_error_is_set());
+    size_t size = 0;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_get_size(&queue, &size));
+    EXPECT_EQ(capacity, size);
+
+    for (uint64_t i = 0; i < capacity; ++i) {
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_pop(&queue, &element));
+      EXPECT_EQ(lap * 100 + i, element);
+    }
+    EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_spsc_queue_pop(&queue, &element));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_get_size(&queue, &size));
+    EXPECT_EQ(0u, size);
+  }
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_push(&queue, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_pop(&queue, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_push(nullptr, &element));
+  rcutils_reset_error();
+}
+
+TEST_F(SpscQueueTest, push_pop_many) {
+  std::vector<uint64_t> elements(11);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    elements[i] = i;
+  }
+  size_t count = 42;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_push_many(&queue, nullptr, 0, &count));
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_push_many(&queue, elements.data(), 3, &count));
+  EXPECT_EQ(3u, count);
+  // Only five more fit.
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_spsc_queue_push_many(&queue, elements.data() + 3, 8, &count));
+  EXPECT_EQ(5u, count);
+
+  std::vector<uint64_t> popped(elements.size(), 0);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_pop_many(&queue, popped.data(), 6, &count));
+  ASSERT_EQ(6u, count);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(i, popped[i]);
+  }
+  // These wrap around the end of the ring.
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_spsc_queue_push_many(&queue, elements.data() + 8, 3, &count));
+  EXPECT_EQ(3u, count);
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_spsc_queue_pop_many(&queue, popped.data(), popped.size(), &count));
+  ASSERT_EQ(5u, count);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(6u + i, popped[i]);
+  }
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_spsc_queue_pop_many(&queue, popped.data(), popped.size(), &count));
+  EXPECT_EQ(0u, count);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_spsc_queue_push_many(&queue, nullptr, 1, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_spsc_queue_pop_many(&queue, popped.data(), 1, nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(SpscQueueTest, producer_consumer) {
+  constexpr uint64_t element_count = 100000;
+  std::thread producer(
+    [this]() {
+      uint64_t next = 0;
+      uint64_t batch[3];
+      while (next < element_count) {
+        // Alternate single and batch pushes.
+        size_t pushed = 0;
+        if (0 == next % 2) {
+          pushed = RCUTILS_RET_OK == rcutils_spsc_queue_push(&queue, &next) ? 1 : 0;
+        } else {
+          size_t count = element_count - next < 3 ? element_count - next : 3;
+          for (size_t i = 0; i < count; ++i) {
+            batch[i] = next + i;
+          }
+          ASSERT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_push_many(&queue, batch, count, &pushed));
+        }
+        next += pushed;
+        if (0 == pushed) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+  uint64_t expected = 0;
+  uint64_t batch[4];
+  while (expected < element_count) {
+    size_t popped = 0;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_spsc_queue_pop_many(&queue, batch, 4, &popped));
+    for (size_t i = 0; i < popped; ++i) {
+      ASSERT_EQ(expected, batch[i]);
+      ++expected;
+    }
+    if (0 == popped) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  uint64_t element = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, rcutils_spsc_queue_pop(&queue, &element));
+}
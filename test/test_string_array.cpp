@@ -14,6 +14,12 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "./allocator_testing_utils.h"
 #include "./time_bomb_allocator_testing_utils.h"
 #include "rcutils/error_handling.h"
@@ -328,3 +334,317 @@ TEST(test_string_array, string_array_sort) {
 
   ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa0));
 }
+
+TEST(test_string_array, string_array_sort_random) {
+  auto allocator = rcutils_get_default_allocator();
+  std::mt19937 random(42);
+  // Strings sharing long prefixes, with duplicates, and empty ones
+  const char * prefixes[] = {"", "/", "/robot", "/robot/arm/joint_", "/robot/arm/joint_1"};
+  for (size_t size : {0u, 1u, 15u, 16u, 17u, 100u, 10000u}) {
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < size; ++i) {
+      std::string string = prefixes[random() % 5];
+      size_t suffix_length = random() % 4;
+      for (size_t j = 0; j < suffix_length; ++j) {
+        // Characters beyond ASCII are ordered after it, as with strcmp.
+        const char characters[] = "_019aAz\xc3\xa9";
+        string += characters[random() % (sizeof(characters) - 1)];
+      }
+      strings.push_back(string);
+    }
+
+    rcutils_string_array_t sa = rcutils_get_zero_initialized_string_array();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init(&sa, size, &allocator));
+    for (size_t i = 0; i < size; ++i) {
+      // Every tenth entry is empty.
+      sa.data[i] = i % 10 == 3 ? nullptr : strdup(strings[i].c_str());
+    }
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < size; ++i) {
+      if (nullptr != sa.data[i]) {
+        expected.push_back(strings[i]);
+      }
+    }
+    std::sort(
+      expected.begin(), expected.end(), [](const std::string & lhs, const std::string & rhs) {
+        return strcmp(lhs.c_str(), rhs.c_str()) < 0;
+      });
+
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_sort(&sa));
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_STREQ(expected[i].c_str(), sa.data[i]) << "size " << size << ", entry " << i;
+    }
+    for (size_t i = expected.size(); i < size; ++i) {
+      EXPECT_EQ(nullptr, sa.data[i]);
+    }
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+  }
+}
+
+TEST(test_string_array, string_array_packed) {
+  auto allocator = rcutils_get_default_allocator();
+  auto failing_allocator = get_failing_allocator();
+  rcutils_string_array_t sa;
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_init_packed(nullptr, 2, 8, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_string_array_init_packed(&sa, 2, 8, &failing_allocator));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init_packed(&sa, 4, 9, &allocator));
+  ASSERT_NE(nullptr, sa.arena);
+  EXPECT_EQ(9u, sa.arena_size);
+  memcpy(sa.arena, "ab\0cd\0ef", 9);
+  sa.data[0] = sa.arena;
+  sa.data[1] = sa.arena + 3;
+  sa.data[2] = sa.arena + 6;
+  // an entry may still hold a string of its own
+  sa.data[3] = strdup("gh");
+
+  rcutils_string_array_t expected;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init(&expected, 4, &allocator));
+  expected.data[0] = strdup("ab");
+  expected.data[1] = strdup("cd");
+  expected.data[2] = strdup("ef");
+  expected.data[3] = strdup("gh");
+  int res = 1;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_cmp(&sa, &expected, &res));
+  EXPECT_EQ(0, res);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&expected));
+
+  // shrinking leaves the strings in the arena alone
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_resize(&sa, 2));
+  EXPECT_STREQ("cd", sa.data[1]);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_resize(&sa, 3));
+  EXPECT_EQ(nullptr, sa.data[2]);
+  sa.data[2] = strdup("ij");
+  sa.data[0] = nullptr;
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+  EXPECT_EQ(nullptr, sa.data);
+  EXPECT_EQ(nullptr, sa.arena);
+  EXPECT_EQ(0u, sa.arena_size);
+
+  // without an arena, it is an ordinary string array
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init_packed(&sa, 1, 0, &allocator));
+  EXPECT_EQ(nullptr, sa.arena);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+}
+
+TEST(test_string_array, string_array_shrink_to_fit_and_allocated_size) {
+  auto allocator = rcutils_get_default_allocator();
+  auto failing_allocator = get_failing_allocator();
+  rcutils_string_array_t sa = rcutils_get_zero_initialized_string_array();
+  size_t allocated_size = 1;
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_shrink_to_fit(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_get_allocated_size(nullptr, &allocated_size));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_get_allocated_size(&sa, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_get_allocated_size(&sa, &allocated_size));
+  EXPECT_EQ(0u, allocated_size);
+
+  // the strings allocated on their own count with their terminating null character
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init(&sa, 3, &allocator));
+  sa.data[0] = strdup("abc");
+  sa.data[2] = strdup("");
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_get_allocated_size(&sa, &allocated_size));
+  EXPECT_EQ(3 * sizeof(char *) + 4 + 1, allocated_size);
+  // there is nothing to shrink without an arena
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_shrink_to_fit(&sa));
+  EXPECT_STREQ("abc", sa.data[0]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init_packed(&sa, 4, 12, &allocator));
+  memcpy(sa.arena, "ab\0cd\0ef\0gh", 12);
+  for (size_t i = 0; i < 4; ++i) {
+    sa.data[i] = sa.arena + 3 * i;
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_get_allocated_size(&sa, &allocated_size));
+  EXPECT_EQ(4 * sizeof(char *) + 12, allocated_size);
+  // an arena which is all used is kept
+  char * arena = sa.arena;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_shrink_to_fit(&sa));
+  EXPECT_EQ(arena, sa.arena);
+
+  // replaced entries leave strings in the arena which aren't used anymore
+  sa.data[1] = strdup("ijkl");
+  sa.data[3] = nullptr;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_get_allocated_size(&sa, &allocated_size));
+  EXPECT_EQ(4 * sizeof(char *) + 12 + 5, allocated_size);
+  sa.allocator = failing_allocator;
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_string_array_shrink_to_fit(&sa));
+  rcutils_reset_error();
+  EXPECT_EQ(arena, sa.arena);
+  EXPECT_STREQ("ef", sa.data[2]);
+  sa.allocator = allocator;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_shrink_to_fit(&sa));
+  EXPECT_EQ(6u, sa.arena_size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_get_allocated_size(&sa, &allocated_size));
+  EXPECT_EQ(4 * sizeof(char *) + 6 + 5, allocated_size);
+  EXPECT_STREQ("ab", sa.data[0]);
+  EXPECT_STREQ("ijkl", sa.data[1]);
+  EXPECT_STREQ("ef", sa.data[2]);
+  EXPECT_EQ(sa.arena, sa.data[0]);
+  EXPECT_EQ(sa.arena + 3, sa.data[2]);
+
+  // and the arena goes once no entry points into it
+  sa.data[0] = nullptr;
+  sa.data[2] = strdup("mn");
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_shrink_to_fit(&sa));
+  EXPECT_EQ(nullptr, sa.arena);
+  EXPECT_EQ(0u, sa.arena_size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_get_allocated_size(&sa, &allocated_size));
+  EXPECT_EQ(4 * sizeof(char *) + 5 + 3, allocated_size);
+  EXPECT_STREQ("mn", sa.data[2]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+}
+
+TEST(test_string_array, string_array_from_views) {
+  auto allocator = get_counting_allocator();
+  auto failing_allocator = get_failing_allocator();
+  rcutils_string_array_t sa = rcutils_get_zero_initialized_string_array();
+  const char * topics = "/ns/chatter/ns/rosout";
+  const rcutils_string_view_t views[] = {{topics, 11}, {topics + 11, 0}, {topics + 11, 10}};
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_init_from_views(nullptr, views, 3, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_init_from_views(&sa, nullptr, 3, &allocator));
+  rcutils_reset_error();
+  const rcutils_string_view_t null_view = {nullptr, 1};
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_init_from_views(&sa, &null_view, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_string_array_init_from_views(&sa, views, 3, &failing_allocator));
+  rcutils_reset_error();
+
+  // the array of strings and the arena, whatever the number of strings
+  reset_counting_allocator_allocations(allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init_from_views(&sa, views, 3, &allocator));
+  EXPECT_EQ(2u, get_counting_allocator_allocations(allocator));
+  ASSERT_EQ(3u, sa.size);
+  EXPECT_EQ((11u + 1u) + (0u + 1u) + (10u + 1u), sa.arena_size);
+  EXPECT_STREQ("/ns/chatter", sa.data[0]);
+  EXPECT_STREQ("", sa.data[1]);
+  EXPECT_STREQ("/ns/rosout", sa.data[2]);
+  EXPECT_EQ(sa.arena, sa.data[0]);
+
+  // appending reallocates both once, and moves the entries pointing into the arena
+  sa.data[1] = strdup("own");
+  const rcutils_string_view_t more[] = {{"/tf", 3}, {"/tf_static", 10}};
+  reset_counting_allocator_allocations(allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_append_views(&sa, more, 2));
+  EXPECT_EQ(2u, get_counting_allocator_allocations(allocator));
+  ASSERT_EQ(5u, sa.size);
+  EXPECT_STREQ("/ns/chatter", sa.data[0]);
+  EXPECT_STREQ("own", sa.data[1]);
+  EXPECT_STREQ("/ns/rosout", sa.data[2]);
+  EXPECT_STREQ("/tf", sa.data[3]);
+  EXPECT_STREQ("/tf_static", sa.data[4]);
+  EXPECT_EQ(sa.arena, sa.data[0]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_append_views(&sa, nullptr, 0));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_append_views(nullptr, more, 2));
+  rcutils_reset_error();
+
+  // a failed append leaves the array as it was
+  auto time_bomb_allocator = get_time_bomb_allocator();
+  sa.allocator = time_bomb_allocator;
+  set_time_bomb_allocator_realloc_count(sa.allocator, 0);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_string_array_append_views(&sa, more, 2));
+  rcutils_reset_error();
+  set_time_bomb_allocator_realloc_count(sa.allocator, 1);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_string_array_append_views(&sa, more, 2));
+  rcutils_reset_error();
+  ASSERT_EQ(5u, sa.size);
+  EXPECT_STREQ("/tf_static", sa.data[4]);
+  sa.allocator = allocator;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+
+  // appending to an array without an arena allocates one
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init(&sa, 1, &allocator));
+  sa.data[0] = strdup("/first");
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_append_views(&sa, more, 1));
+  ASSERT_EQ(2u, sa.size);
+  EXPECT_STREQ("/first", sa.data[0]);
+  EXPECT_STREQ("/tf", sa.data[1]);
+  EXPECT_EQ(sa.arena, sa.data[1]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init_from_views(&sa, nullptr, 0, &allocator));
+  EXPECT_EQ(0u, sa.size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+}
+
+TEST(test_string_array, string_array_equal_and_hash) {
+  auto allocator = rcutils_get_default_allocator();
+  rcutils_string_array_t lhs = rcutils_get_zero_initialized_string_array();
+  rcutils_string_array_t rhs = rcutils_get_zero_initialized_string_array();
+  bool equal = false;
+  size_t lhs_hash = 0;
+  size_t rhs_hash = 0;
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_equal(nullptr, &rhs, &equal));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_equal(&lhs, nullptr, &equal));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_equal(&lhs, &rhs, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_hash(nullptr, &lhs_hash));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_array_hash(&lhs, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_equal(&lhs, &rhs, &equal));
+  EXPECT_TRUE(equal);
+
+  const rcutils_string_view_t views[] = {{"/a", 2}, {"/b", 2}, {"", 0}};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init_from_views(&lhs, views, 3, &allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init(&rhs, 3, &allocator));
+  rhs.data[0] = strdup("/a");
+  rhs.data[1] = strdup("/b");
+  rhs.data[2] = strdup("");
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_equal(&lhs, &rhs, &equal));
+  EXPECT_TRUE(equal);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_hash(&lhs, &lhs_hash));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_hash(&rhs, &rhs_hash));
+  EXPECT_EQ(lhs_hash, rhs_hash);
+
+  // the order matters
+  std::swap(rhs.data[0], rhs.data[1]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_equal(&lhs, &rhs, &equal));
+  EXPECT_FALSE(equal);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_hash(&rhs, &rhs_hash));
+  EXPECT_NE(lhs_hash, rhs_hash);
+  std::swap(rhs.data[0], rhs.data[1]);
+
+  // empty entries are only equal to empty entries, not to empty strings
+  free(rhs.data[2]);
+  rhs.data[2] = nullptr;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_equal(&lhs, &rhs, &equal));
+  EXPECT_FALSE(equal);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_hash(&rhs, &rhs_hash));
+  EXPECT_NE(lhs_hash, rhs_hash);
+
+  // arrays of different sizes differ
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_resize(&rhs, 2));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_equal(&lhs, &rhs, &equal));
+  EXPECT_FALSE(equal);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_hash(&rhs, &rhs_hash));
+  EXPECT_NE(lhs_hash, rhs_hash);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&lhs));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&rhs));
+}
@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+#include <random>
 #include <string>
 
 #include "./allocator_testing_utils.h"
@@ -1897,6 +1899,111 @@ TEST(test_string_map, copy) {
   }
 }
 
+TEST(test_string_map, copy_shared) {
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_ret_t ret;
+
+  rcutils_string_map_t src_string_map = rcutils_get_zero_initialized_string_map();
+  ret = rcutils_string_map_init(&src_string_map, 4, counting_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_string_map_fini(&src_string_map)) << rcutils_get_error_string().str;
+    rcutils_reset_error();
+  });
+  for (int i = 0; i < 3; ++i) {
+    std::string key = "key" + std::to_string(i);
+    std::string value = "value" + std::to_string(i);
+    ret = rcutils_string_map_set(&src_string_map, key.c_str(), value.c_str());
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  rcutils_string_map_t copies[3];
+  for (rcutils_string_map_t & copy : copies) {
+    copy = rcutils_get_zero_initialized_string_map();
+    ret = rcutils_string_map_init(&copy, 0, counting_allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret);
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (rcutils_string_map_t & copy : copies) {
+      EXPECT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_string_map_fini(&copy)) << rcutils_get_error_string().str;
+      rcutils_reset_error();
+    }
+  });
+
+  // the first copy moves the keys and values into one allocation, and the others allocate nothing
+  reset_counting_allocator_allocations(counting_allocator);
+  for (rcutils_string_map_t & copy : copies) {
+    ret = rcutils_string_map_copy_shared(&src_string_map, &copy);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  EXPECT_EQ(1u, get_counting_allocator_allocations(counting_allocator));
+  for (rcutils_string_map_t * map : {&src_string_map, &copies[0], &copies[1], &copies[2]}) {
+    size_t size = 0;
+    size_t capacity = 0;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_get_size(map, &size));
+    EXPECT_EQ(3u, size);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_get_capacity(map, &capacity));
+    EXPECT_EQ(4u, capacity);
+    EXPECT_STREQ("value0", rcutils_string_map_get(map, "key0"));
+    EXPECT_STREQ("value1", rcutils_string_map_get(map, "key1"));
+    EXPECT_STREQ("value2", rcutils_string_map_get(map, "key2"));
+    const char * first_key = rcutils_string_map_get_next_key(map, NULL);
+    EXPECT_STREQ("key0", first_key);
+    EXPECT_STREQ("key1", rcutils_string_map_get_next_key(map, first_key));
+  }
+  EXPECT_EQ(
+    rcutils_string_map_get(&src_string_map, "key0"), rcutils_string_map_get(&copies[0], "key0"));
+
+  // modifying any of the maps leaves the others as they are
+  ret = rcutils_string_map_set(&copies[0], "key0", "changed");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_unset(&copies[1], "key1");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_clear(&copies[2]);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_set(&src_string_map, "key3", "value3");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_set(&src_string_map, "key4", "value4");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  EXPECT_STREQ("changed", rcutils_string_map_get(&copies[0], "key0"));
+  EXPECT_STREQ("value1", rcutils_string_map_get(&copies[0], "key1"));
+  EXPECT_EQ(nullptr, rcutils_string_map_get(&copies[0], "key3"));
+  EXPECT_STREQ("value0", rcutils_string_map_get(&copies[1], "key0"));
+  EXPECT_EQ(nullptr, rcutils_string_map_get(&copies[1], "key1"));
+  EXPECT_STREQ("value2", rcutils_string_map_get(&copies[1], "key2"));
+  EXPECT_EQ(nullptr, rcutils_string_map_get_next_key(&copies[2], NULL));
+  EXPECT_STREQ("value0", rcutils_string_map_get(&src_string_map, "key0"));
+  EXPECT_STREQ("value1", rcutils_string_map_get(&src_string_map, "key1"));
+  EXPECT_STREQ("value4", rcutils_string_map_get(&src_string_map, "key4"));
+
+  // copying into a map which is not empty merges the keys and values
+  ret = rcutils_string_map_copy_shared(&src_string_map, &copies[1]);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_get_size(&copies[1], &size));
+  EXPECT_EQ(5u, size);
+  EXPECT_STREQ("value1", rcutils_string_map_get(&copies[1], "key1"));
+
+  // a shared copy can be shared again, and finalized while shared
+  ret = rcutils_string_map_copy_shared(&copies[1], &copies[2]);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_STREQ("value4", rcutils_string_map_get(&copies[2], "key4"));
+
+  ret = rcutils_string_map_copy_shared(nullptr, &copies[0]);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  ret = rcutils_string_map_copy_shared(&src_string_map, nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+}
+
 TEST(test_string_map, strange_keys) {
   auto allocator = rcutils_get_default_allocator();
   rcutils_ret_t ret;
@@ -1940,6 +2047,65 @@ TEST(test_string_map, strange_keys) {
   }
 }
 
+TEST(test_string_map, many_keys) {
+  auto allocator = rcutils_get_default_allocator();
+  rcutils_string_map_t string_map = rcutils_get_zero_initialized_string_map();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_map_init(&string_map, 0, allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_string_map_fini(&string_map)) << rcutils_get_error_string().str;
+    rcutils_reset_error();
+  });
+
+  // Setting and unsetting keys at random, the map has the same entries as a std::map.
+  std::map<std::string, std::string> expected;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> keys(0, 500);
+  for (int i = 0; i < 10000; ++i) {
+    std::string key = "/node_" + std::to_string(keys(generator)) + "/param";
+    if (0 == generator() % 3) {
+      bool exists = expected.erase(key) > 0;
+      EXPECT_EQ(
+        exists ? RCUTILS_RET_OK : RCUTILS_RET_STRING_KEY_NOT_FOUND,
+        rcutils_string_map_unset(&string_map, key.c_str())) << key;
+      rcutils_reset_error();
+    } else {
+      std::string value = std::to_string(i);
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_map_set(&string_map, key.c_str(), value.c_str()));
+      expected[key] = value;
+    }
+  }
+
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_get_size(&string_map, &size));
+  EXPECT_EQ(expected.size(), size);
+  for (int i = 0; i <= 500; ++i) {
+    std::string key = "/node_" + std::to_string(i) + "/param";
+    auto it = expected.find(key);
+    if (it == expected.end()) {
+      EXPECT_EQ(nullptr, rcutils_string_map_get(&string_map, key.c_str())) << key;
+      EXPECT_FALSE(rcutils_string_map_key_exists(&string_map, key.c_str())) << key;
+    } else {
+      EXPECT_STREQ(it->second.c_str(), rcutils_string_map_get(&string_map, key.c_str())) << key;
+      // The length may go past the end of the key.
+      EXPECT_STREQ(
+        it->second.c_str(), rcutils_string_map_getn(&string_map, key.c_str(), key.size() + 10));
+      EXPECT_TRUE(rcutils_string_map_key_existsn(&string_map, key.c_str(), key.size()));
+      EXPECT_FALSE(rcutils_string_map_key_existsn(&string_map, key.c_str(), key.size() - 1));
+    }
+  }
+
+  std::map<std::string, std::string> entries;
+  const char * key = rcutils_string_map_get_next_key(&string_map, NULL);
+  while (key != NULL) {
+    entries[key] = rcutils_string_map_get(&string_map, key);
+    key = rcutils_string_map_get_next_key(&string_map, key);
+  }
+  EXPECT_EQ(expected, entries);
+}
+
 static int realloc_counter = 0;
 static int realloc_fail_after = -1;
 
@@ -2000,3 +2166,165 @@ TEST(test_string_map, partial_allocation_failures)
     ASSERT_EQ(ret, RCUTILS_RET_OK);
   }
 }
+
+TEST(test_string_map, shrink_to_fit_and_allocated_size)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_string_map_t string_map = rcutils_get_zero_initialized_string_map();
+  size_t allocated_size = 0;
+  rcutils_ret_t ret = rcutils_string_map_get_allocated_size(&string_map, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_STRING_MAP_INVALID, ret);
+  rcutils_reset_error();
+  ret = rcutils_string_map_shrink_to_fit(&string_map);
+  EXPECT_EQ(RCUTILS_RET_STRING_MAP_INVALID, ret);
+  rcutils_reset_error();
+  ret = rcutils_string_map_get_allocated_size(nullptr, &allocated_size);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  ret = rcutils_string_map_shrink_to_fit(nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+
+  ret = rcutils_string_map_init(&string_map, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_string_map_fini(&string_map)) << rcutils_get_error_string().str;
+    rcutils_reset_error();
+  });
+  ret = rcutils_string_map_get_allocated_size(&string_map, nullptr);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  size_t empty_size = 0;
+  ret = rcutils_string_map_get_allocated_size(&string_map, &empty_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  // the keys and values count with their terminating null characters
+  ret = rcutils_string_map_set(&string_map, "key", "value");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_shrink_to_fit(&string_map);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_get_allocated_size(&string_map, &allocated_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t one_key_size = allocated_size;
+  ret = rcutils_string_map_set(&string_map, "key", "other value");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_get_allocated_size(&string_map, &allocated_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(one_key_size + 6, allocated_size);
+
+  // a burst of keys grows the map, which keeps its capacity after they are unset, while the keys
+  // left are at the end of the map
+  for (size_t i = 0; i < 100; ++i) {
+    std::string key = "key" + std::to_string(i);
+    ret = rcutils_string_map_set(&string_map, key.c_str(), "value");
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  ret = rcutils_string_map_unset(&string_map, "key");
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  for (size_t i = 0; i < 97; ++i) {
+    std::string key = "key" + std::to_string(i);
+    ret = rcutils_string_map_unset(&string_map, key.c_str());
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  size_t grown_size = 0;
+  ret = rcutils_string_map_get_allocated_size(&string_map, &grown_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  ret = rcutils_string_map_shrink_to_fit(&string_map);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t capacity = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_get_capacity(&string_map, &capacity));
+  EXPECT_EQ(3u, capacity);
+  ret = rcutils_string_map_get_allocated_size(&string_map, &allocated_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_GT(grown_size / 4, allocated_size);
+  EXPECT_LT(empty_size + 3 * (sizeof("key99") + sizeof("value")), allocated_size);
+  EXPECT_STREQ("value", rcutils_string_map_get(&string_map, "key97"));
+  EXPECT_STREQ("value", rcutils_string_map_get(&string_map, "key98"));
+  EXPECT_STREQ("value", rcutils_string_map_get(&string_map, "key99"));
+  EXPECT_EQ(nullptr, rcutils_string_map_get(&string_map, "key0"));
+  ret = rcutils_string_map_set_no_resize(&string_map, "key", "value");
+  EXPECT_EQ(RCUTILS_RET_NOT_ENOUGH_SPACE, ret);
+  rcutils_reset_error();
+
+  // shared storage is left as is, and counted for each map sharing it
+  rcutils_allocator_t counting_allocator = get_counting_allocator();
+  rcutils_string_map_t copy = rcutils_get_zero_initialized_string_map();
+  ret = rcutils_string_map_init(&copy, 0, counting_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_fini(&copy)) << rcutils_get_error_string().str;
+    rcutils_reset_error();
+  });
+  ret = rcutils_string_map_copy_shared(&string_map, &copy);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  size_t shared_size = 0;
+  ret = rcutils_string_map_get_allocated_size(&string_map, &shared_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_LT(allocated_size, shared_size);
+  ret = rcutils_string_map_get_allocated_size(&copy, &allocated_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(shared_size, allocated_size);
+  reset_counting_allocator_allocations(counting_allocator);
+  ret = rcutils_string_map_shrink_to_fit(&copy);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(0u, get_counting_allocator_allocations(counting_allocator));
+  EXPECT_STREQ("value", rcutils_string_map_get(&copy, "key99"));
+
+  // clearing and shrinking gives back all the memory of the key value pairs
+  ret = rcutils_string_map_clear(&string_map);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_shrink_to_fit(&string_map);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_get_allocated_size(&string_map, &allocated_size);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(empty_size, allocated_size);
+}
+
+TEST(test_string_map, reserve_less_with_unset_keys)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_string_map_t string_map = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t ret = rcutils_string_map_init(&string_map, 8, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_string_map_fini(&string_map)) << rcutils_get_error_string().str;
+    rcutils_reset_error();
+  });
+  for (int i = 0; i < 8; ++i) {
+    std::string key = "key" + std::to_string(i);
+    std::string value = "value" + std::to_string(i);
+    ret = rcutils_string_map_set(&string_map, key.c_str(), value.c_str());
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+  for (int i = 0; i < 8; i += 2) {
+    std::string key = "key" + std::to_string(i);
+    ret = rcutils_string_map_unset(&string_map, key.c_str());
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  // the keys past the new capacity are kept, in the same order
+  ret = rcutils_string_map_reserve(&string_map, 5);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  const char * key = rcutils_string_map_get_next_key(&string_map, NULL);
+  for (int i = 1; i < 8; i += 2) {
+    std::string expected_key = "key" + std::to_string(i);
+    std::string expected_value = "value" + std::to_string(i);
+    EXPECT_STREQ(expected_key.c_str(), key);
+    EXPECT_STREQ(expected_value.c_str(), rcutils_string_map_get(&string_map, expected_key.c_str()));
+    key = rcutils_string_map_get_next_key(&string_map, key);
+  }
+  EXPECT_EQ(nullptr, key);
+  ret = rcutils_string_map_set_no_resize(&string_map, "key8", "value8");
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  ret = rcutils_string_map_set_no_resize(&string_map, "key9", "value9");
+  EXPECT_EQ(RCUTILS_RET_NOT_ENOUGH_SPACE, ret);
+  rcutils_reset_error();
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/string_map.h"
+#include "rcutils/types/string_pool.h"
+
+class StringPoolTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    allocator = rcutils_get_default_allocator();
+    pool = rcutils_get_zero_initialized_string_pool();
+    rcutils_ret_t ret = rcutils_string_pool_init(&pool, &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_fini(&pool));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_string_pool_t pool;
+};
+
+TEST(test_string_pool, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_string_pool_t pool = rcutils_get_zero_initialized_string_pool();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_pool_init(nullptr, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_pool_init(&pool, nullptr));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_string_pool_init(&pool, &failing_allocator));
+  rcutils_reset_error();
+
+  const char * interned = nullptr;
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED, rcutils_string_pool_intern(&pool, "name", &interned, nullptr));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_pool_init(&pool, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_fini(&pool));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_fini(&pool));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_pool_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(StringPoolTest, intern) {
+  std::string name = "/robot/node";
+  const char * interned = nullptr;
+  size_t hash = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_pool_intern(&pool, name.c_str(), &interned, &hash));
+  EXPECT_STREQ("/robot/node", interned);
+  EXPECT_NE(name.c_str(), interned);
+  EXPECT_EQ(rcutils_hash_map_string_fast_hashn(name.c_str(), name.size()), hash);
+
+  // equal strings are interned once, as the same pointer
+  std::string same_name = name;
+  const char * interned_again = nullptr;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_string_pool_intern(&pool, same_name.c_str(), &interned_again, nullptr));
+  EXPECT_EQ(interned, interned_again);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_string_pool_internn(&pool, "/robot/node/child", 11, &interned_again, &hash));
+  EXPECT_EQ(interned, interned_again);
+  EXPECT_EQ(rcutils_hash_map_string_fast_hashn(name.c_str(), name.size()), hash);
+
+  const char * other = nullptr;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_pool_intern(&pool, "/robot", &other, nullptr));
+  EXPECT_NE(interned, other);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_pool_intern(&pool, "", &other, nullptr));
+  EXPECT_STREQ("", other);
+
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_get_size(&pool, &size));
+  EXPECT_EQ(3u, size);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_pool_intern(&pool, nullptr, &other, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_pool_intern(&pool, "name", nullptr, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_string_pool_get_size(&pool, nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(StringPoolTest, many_strings_stay_where_they_are) {
+  std::vector<const char *> interned(10000);
+  for (size_t i = 0; i < interned.size(); ++i) {
+    // some of the strings are longer than the blocks they are usually allocated in
+    std::string name = "/robot/node_" + std::to_string(i) + std::string(i % 1000 ? 0 : 5000, 'x');
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcutils_string_pool_intern(&pool, name.c_str(), &interned[i], nullptr));
+  }
+  for (size_t i = 0; i < interned.size(); ++i) {
+    std::string name = "/robot/node_" + std::to_string(i) + std::string(i % 1000 ? 0 : 5000, 'x');
+    EXPECT_EQ(name, interned[i]);
+    const char * interned_again = nullptr;
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcutils_string_pool_intern(&pool, name.c_str(), &interned_again, nullptr));
+    EXPECT_EQ(interned[i], interned_again);
+  }
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_get_size(&pool, &size));
+  EXPECT_EQ(interned.size(), size);
+}
+
+TEST_F(StringPoolTest, intern_from_many_threads) {
+  const size_t thread_count = 8;
+  const size_t name_count = 1000;
+  std::vector<std::vector<const char *>> interned(
+    thread_count, std::vector<const char *>(name_count));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back(
+      [this, t, &interned]() {
+        for (size_t i = 0; i < name_count; ++i) {
+          std::string name = "/node_" + std::to_string((i + t * 7) % name_count);
+          EXPECT_EQ(
+            RCUTILS_RET_OK,
+            rcutils_string_pool_intern(&pool, name.c_str(), &interned[t][i], nullptr));
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_get_size(&pool, &size));
+  EXPECT_EQ(name_count, size);
+  for (size_t t = 1; t < thread_count; ++t) {
+    for (size_t i = 0; i < name_count; ++i) {
+      EXPECT_EQ(interned[0][(i + t * 7) % name_count], interned[t][i]);
+    }
+  }
+}
+
+TEST_F(StringPoolTest, string_map_keys) {
+  rcutils_string_map_t maps[2];
+  for (rcutils_string_map_t & map : maps) {
+    map = rcutils_get_zero_initialized_string_map();
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcutils_string_map_init_with_string_pool(&map, 0, allocator, &pool));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_set(&maps[0], "key", "value0"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_set(&maps[1], "key", "value1"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_set(&maps[1], "other", "value"));
+  EXPECT_STREQ("value0", rcutils_string_map_get(&maps[0], "key"));
+  EXPECT_STREQ("value1", rcutils_string_map_get(&maps[1], "key"));
+
+  // both maps use the interned key
+  const char * key = nullptr;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_pool_intern(&pool, "key", &key, nullptr));
+  EXPECT_EQ(key, rcutils_string_map_get_next_key(&maps[0], nullptr));
+  EXPECT_EQ(key, rcutils_string_map_get_next_key(&maps[1], nullptr));
+
+  // unsetting and clearing leave the interned keys in the pool
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_unset(&maps[0], "key"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_clear(&maps[1]));
+  EXPECT_STREQ("key", key);
+
+  // a shared copy copies the values, but not the interned keys, when modified
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_set(&maps[0], "key", "value0"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_copy_shared(&maps[0], &maps[1]));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_set(&maps[1], "other", "value"));
+  EXPECT_EQ(key, rcutils_string_map_get_next_key(&maps[0], nullptr));
+  EXPECT_EQ(key, rcutils_string_map_get_next_key(&maps[1], nullptr));
+  EXPECT_STREQ("value0", rcutils_string_map_get(&maps[1], "key"));
+  EXPECT_EQ(nullptr, rcutils_string_map_get(&maps[0], "other"));
+
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_pool_get_size(&pool, &size));
+  EXPECT_EQ(2u, size);
+
+  for (rcutils_string_map_t & map : maps) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_map_fini(&map));
+  }
+
+  rcutils_string_map_t map = rcutils_get_zero_initialized_string_map();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_map_init_with_string_pool(&map, 0, allocator, nullptr));
+  rcutils_reset_error();
+}
@@ -0,0 +1,167 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "./time_bomb_allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/striped_counter.h"
+
+TEST(test_striped_counter, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_striped_counter_t counter = rcutils_get_zero_initialized_striped_counter();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_striped_counter_init(nullptr, 1, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_striped_counter_init(&counter, 1, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_striped_counter_init(&counter, 0, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_striped_counter_init(
+      &counter, SIZE_MAX, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_striped_counter_init(
+      &counter, 1, SIZE_MAX, RCUTILS_STRIPED_COUNTER_PER_THREAD, &allocator));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_striped_counter_init(
+      &counter, 1, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, &failing_allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_striped_counter_init(
+      &counter, 1, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, &time_bomb_allocator));
+  rcutils_reset_error();
+
+  uint64_t value = 0;
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_striped_counter_get(&counter, 0, &value));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_striped_counter_get_all(&counter, &value));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_striped_counter_reset(&counter));
+  rcutils_reset_error();
+
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_striped_counter_init(&counter, 1, 0, RCUTILS_STRIPED_COUNTER_PER_THREAD, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_fini(&counter));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_fini(&counter));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_striped_counter_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST(test_striped_counter, add_get_reset) {
+  rcutils_allocator_t allocator = get_counting_allocator();
+  rcutils_striped_counter_t counter = rcutils_get_zero_initialized_striped_counter();
+  // More counters than fit on a cache line, over a few stripes.
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_striped_counter_init(&counter, 11, 3, RCUTILS_STRIPED_COUNTER_PER_THREAD, &allocator));
+
+  for (size_t i = 0; i < 11; ++i) {
+    rcutils_striped_counter_add(&counter, i, i + 1);
+  }
+  rcutils_striped_counter_add(&counter, 10, 5);
+  // Adding the two's complement subtracts.
+  rcutils_striped_counter_add(&counter, 3, ~UINT64_C(0));
+
+  uint64_t value = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_get(&counter, 0, &value));
+  EXPECT_EQ(1u, value);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_get(&counter, 3, &value));
+  EXPECT_EQ(3u, value);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_get(&counter, 10, &value));
+  EXPECT_EQ(16u, value);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_striped_counter_get(&counter, 11, &value));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_striped_counter_get(&counter, 0, nullptr));
+  rcutils_reset_error();
+
+  std::vector<uint64_t> values(11, 42);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_get_all(&counter, values.data()));
+  for (size_t i = 0; i < 11; ++i) {
+    EXPECT_EQ(3 == i ? i : 10 == i ? 16u : i + 1, values[i]);
+  }
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_striped_counter_get_all(&counter, nullptr));
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_reset(&counter));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_get_all(&counter, values.data()));
+  for (size_t i = 0; i < 11; ++i) {
+    EXPECT_EQ(0u, values[i]);
+  }
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_fini(&counter));
+  EXPECT_EQ(
+    get_counting_allocator_allocations(allocator),
+    get_counting_allocator_deallocations(allocator));
+}
+
+class StripedCounterTest : public ::testing::TestWithParam<rcutils_striped_counter_mode_t>
+{
+};
+
+TEST_P(StripedCounterTest, concurrent_adds) {
+  constexpr size_t thread_count = 8;
+  constexpr uint64_t iteration_count = 50000;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_striped_counter_t counter = rcutils_get_zero_initialized_striped_counter();
+  // Fewer stripes than threads, so that some threads share them.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_striped_counter_init(&counter, 2, 4, GetParam(), &allocator));
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back(
+      [&counter]() {
+        for (uint64_t j = 0; j < iteration_count; ++j) {
+          rcutils_striped_counter_add(&counter, 0, 1);
+          rcutils_striped_counter_add(&counter, 1, j);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  uint64_t values[2] = {0, 0};
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_get_all(&counter, values));
+  EXPECT_EQ(thread_count * iteration_count, values[0]);
+  EXPECT_EQ(thread_count * iteration_count * (iteration_count - 1) / 2, values[1]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_striped_counter_fini(&counter));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  test_striped_counter, StripedCounterTest,
+  ::testing::Values(RCUTILS_STRIPED_COUNTER_PER_THREAD, RCUTILS_STRIPED_COUNTER_PER_CPU));
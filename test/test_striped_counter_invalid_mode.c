@@ -0,0 +1,39 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/striped_counter.h"
+
+int main(int argc, char ** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_striped_counter_t counter = rcutils_get_zero_initialized_striped_counter();
+  // Both values in the range of the modes are valid, the one after the last one is not.
+  rcutils_striped_counter_mode_t invalid_mode =
+    (rcutils_striped_counter_mode_t)(RCUTILS_STRIPED_COUNTER_PER_CPU + 1);
+  if (rcutils_striped_counter_init(&counter, 1, 0, invalid_mode, &allocator) !=
+    RCUTILS_RET_INVALID_ARGUMENT)
+  {
+    fprintf(stderr, "invalid mode unexpectedly accepted\n");
+    return 1;
+  }
+  rcutils_reset_error();
+  return 0;
+}
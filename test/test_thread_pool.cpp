@@ -0,0 +1,253 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/process.h"
+#include "rcutils/thread_pool.h"
+
+static void count_task(void * arg)
+{
+  ++*static_cast<std::atomic<size_t> *>(arg);
+}
+
+static void slow_count_task(void * arg)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  ++*static_cast<std::atomic<size_t> *>(arg);
+}
+
+struct nested_context_t
+{
+  rcutils_thread_pool_t * pool;
+  std::atomic<size_t> count{0};
+  std::atomic<size_t> failures{0};
+  size_t depth;
+};
+
+struct nested_task_t
+{
+  nested_context_t * context;
+  size_t depth;
+};
+
+// Submits two tasks of the next depth, making a binary tree of tasks.
+static void nested_task(void * arg)
+{
+  nested_task_t * task = static_cast<nested_task_t *>(arg);
+  nested_context_t * context = task->context;
+  ++context->count;
+  if (task->depth < context->depth) {
+    for (size_t i = 0; i < 2; ++i) {
+      nested_task_t * child = new nested_task_t{context, task->depth + 1};
+      if (RCUTILS_RET_OK != rcutils_thread_pool_submit(context->pool, nested_task, child)) {
+        delete child;
+        ++context->failures;
+      }
+    }
+  }
+  delete task;
+}
+
+struct wait_context_t
+{
+  rcutils_thread_pool_t * pool;
+  std::atomic<rcutils_ret_t> ret{RCUTILS_RET_OK};
+};
+
+static void wait_task(void * arg)
+{
+  wait_context_t * context = static_cast<wait_context_t *>(arg);
+  context->ret = rcutils_thread_pool_wait(context->pool);
+  rcutils_reset_error();
+}
+
+TEST(TestThreadPool, invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  std::atomic<size_t> count{0};
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_init(nullptr, nullptr, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_init(&pool, nullptr, nullptr));
+  rcutils_reset_error();
+  rcutils_allocator_t invalid_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_init(&pool, nullptr, &invalid_allocator));
+  rcutils_reset_error();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  options.pin_threads = true;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_init(&pool, &options, &allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_thread_pool_init(&pool, nullptr, &failing_allocator));
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_thread_pool_submit(&pool, count_task, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_submit(nullptr, count_task, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_thread_pool_wait(&pool));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_wait(nullptr));
+  rcutils_reset_error();
+  size_t thread_count = 0;
+  EXPECT_EQ(
+    RCUTILS_RET_NOT_INITIALIZED, rcutils_thread_pool_get_thread_count(&pool, &thread_count));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_fini(nullptr));
+  rcutils_reset_error();
+  // Finalizing a zero initialized pool does nothing.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+
+  options = rcutils_thread_pool_get_default_options();
+  options.thread_count = 2;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, &options, &allocator));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_submit(&pool, nullptr, &count));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_thread_pool_get_thread_count(&pool, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_get_thread_count(&pool, &thread_count));
+  EXPECT_EQ(2u, thread_count);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+  EXPECT_EQ(nullptr, pool.impl);
+}
+
+TEST(TestThreadPool, default_thread_count) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, nullptr, &allocator));
+  size_t thread_count = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_get_thread_count(&pool, &thread_count));
+  EXPECT_GE(thread_count, 1u);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+}
+
+TEST(TestThreadPool, submit_and_wait) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  options.thread_count = 4;
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, &options, &allocator));
+
+  // More tasks than the queues have room for at first, so that they grow.
+  std::atomic<size_t> count{0};
+  for (size_t round = 1; round <= 3; ++round) {
+    for (size_t i = 0; i < 1000; ++i) {
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, count_task, &count));
+    }
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_wait(&pool));
+    EXPECT_EQ(round * 1000u, count.load());
+  }
+  // Waiting without tasks returns at once.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_wait(&pool));
+
+  // Several threads submitting and waiting at once.
+  count = 0;
+  std::thread threads[4];
+  for (std::thread & thread : threads) {
+    thread = std::thread(
+      [&pool, &count]() {
+        for (size_t i = 0; i < 100; ++i) {
+          EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, slow_count_task, &count));
+        }
+        EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_wait(&pool));
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(400u, count.load());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+}
+
+TEST(TestThreadPool, nested_submit) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  options.thread_count = 3;
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, &options, &allocator));
+
+  // The tasks submitted by tasks are waited for too.
+  nested_context_t context;
+  context.pool = &pool;
+  context.depth = 10;
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, nested_task, new nested_task_t{&context, 0}));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_wait(&pool));
+  EXPECT_EQ(2047u, context.count.load());
+  EXPECT_EQ(0u, context.failures.load());
+
+  // As they are by finalizing the pool.
+  context.count = 0;
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, nested_task, new nested_task_t{&context, 0}));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+  EXPECT_EQ(2047u, context.count.load());
+  EXPECT_EQ(0u, context.failures.load());
+}
+
+TEST(TestThreadPool, fini_runs_queued_tasks) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  options.thread_count = 2;
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, &options, &allocator));
+  std::atomic<size_t> count{0};
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, slow_count_task, &count));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+  EXPECT_EQ(100u, count.load());
+}
+
+TEST(TestThreadPool, wait_from_task) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  options.thread_count = 1;
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, &options, &allocator));
+  wait_context_t context;
+  context.pool = &pool;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, wait_task, &context));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_wait(&pool));
+  EXPECT_EQ(RCUTILS_RET_ERROR, context.ret.load());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+}
+
+#ifdef __linux__
+TEST(TestThreadPool, pinned_threads) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_thread_pool_options_t options = rcutils_thread_pool_get_default_options();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_get_current_cpu_set(&options.thread_attributes.cpu_set));
+  options.thread_count = rcutils_cpu_set_count(&options.thread_attributes.cpu_set) + 1;
+  options.pin_threads = true;
+  rcutils_thread_pool_t pool = rcutils_get_zero_initialized_thread_pool();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_init(&pool, &options, &allocator));
+  std::atomic<size_t> count{0};
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_submit(&pool, count_task, &count));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_wait(&pool));
+  EXPECT_EQ(100u, count.load());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_thread_pool_fini(&pool));
+}
+#endif
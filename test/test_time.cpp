@@ -150,6 +150,26 @@ TEST_F(TestTimeFixture, test_rcutils_system_time_now) {
   }
 }
 
+// Tests the rcutils_system_time_now_coarse() function.
+TEST_F(TestTimeFixture, test_rcutils_system_time_now_coarse) {
+  rcutils_ret_t ret;
+  ret = rcutils_system_time_now_coarse(nullptr);
+  EXPECT_EQ(ret, RCUTILS_RET_INVALID_ARGUMENT) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  rcutils_time_point_value_t now = 0;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    ret = rcutils_system_time_now_coarse(&now);
+  });
+  EXPECT_EQ(ret, RCUTILS_RET_OK) << rcutils_get_error_string().str;
+  // It lags behind the precise system clock by at most its resolution.
+  rcutils_time_point_value_t precise = 0;
+  ret = rcutils_system_time_now(&precise);
+  ASSERT_EQ(ret, RCUTILS_RET_OK) << rcutils_get_error_string().str;
+  const int k_tolerance_ms = 20;
+  EXPECT_LE(llabs(precise - now), RCUTILS_MS_TO_NS(k_tolerance_ms)) << "coarse clock differs";
+}
+
 // Tests the rcutils_steady_time_now() function.
 TEST_F(TestTimeFixture, test_rcutils_steady_time_now) {
   rcutils_ret_t ret;
@@ -191,6 +211,114 @@ TEST_F(TestTimeFixture, test_rcutils_steady_time_now) {
     llabs(steady_diff - sc_diff), RCUTILS_MS_TO_NS(k_tolerance_ms)) << "steady_clock differs";
 }
 
+// Tests the rcutils_steady_time_now_coarse() function.
+TEST_F(TestTimeFixture, test_rcutils_steady_time_now_coarse) {
+  rcutils_ret_t ret;
+  ret = rcutils_steady_time_now_coarse(nullptr);
+  EXPECT_EQ(ret, RCUTILS_RET_INVALID_ARGUMENT) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+  rcutils_time_point_value_t now = 0;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    ret = rcutils_steady_time_now_coarse(&now);
+  });
+  EXPECT_EQ(ret, RCUTILS_RET_OK) << rcutils_get_error_string().str;
+  EXPECT_NE(0u, now);
+  // It never goes backwards, and advances like the steady clock, up to its resolution.
+  std::chrono::steady_clock::time_point now_sc = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  rcutils_time_point_value_t later = 0;
+  ret = rcutils_steady_time_now_coarse(&later);
+  std::chrono::steady_clock::time_point later_sc = std::chrono::steady_clock::now();
+  EXPECT_EQ(ret, RCUTILS_RET_OK) << rcutils_get_error_string().str;
+  EXPECT_GE(later, now);
+  int64_t coarse_diff = later - now;
+  int64_t sc_diff =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(later_sc - now_sc).count();
+  const int k_tolerance_ms = 20;
+  EXPECT_LE(
+    llabs(coarse_diff - sc_diff), RCUTILS_MS_TO_NS(k_tolerance_ms)) << "coarse clock differs";
+}
+
+// Tests the fast steady clock.
+TEST_F(TestTimeFixture, test_rcutils_steady_time_now_fast) {
+  rcutils_ret_t ret;
+  ret = rcutils_steady_time_now_fast(nullptr);
+  EXPECT_EQ(ret, RCUTILS_RET_INVALID_ARGUMENT) << rcutils_get_error_string().str;
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_steady_time_fast_init()) << rcutils_get_error_string().str;
+  // Calibrating again does nothing.
+  bool reliable = rcutils_steady_time_fast_is_reliable();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_steady_time_fast_init());
+  EXPECT_EQ(reliable, rcutils_steady_time_fast_is_reliable());
+
+  rcutils_time_point_value_t now = 0;
+  rcutils_time_point_value_t steady_now = 0;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    ret = rcutils_steady_time_now_fast(&now);
+  });
+  EXPECT_EQ(ret, RCUTILS_RET_OK) << rcutils_get_error_string().str;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&steady_now));
+  // It starts from the steady clock, and drifts from it slowly.
+  EXPECT_LE(llabs(steady_now - now), RCUTILS_MS_TO_NS(1));
+
+  // It never goes backwards, and advances like the steady clock.
+  rcutils_time_point_value_t previous = now;
+  for (int i = 0; i < 100000; ++i) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now_fast(&now));
+    ASSERT_GE(now, previous);
+    previous = now;
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now_fast(&now));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&steady_now));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  rcutils_time_point_value_t later = 0;
+  rcutils_time_point_value_t steady_later = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now_fast(&later));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&steady_later));
+  EXPECT_LE(
+    llabs((later - now) - (steady_later - steady_now)), RCUTILS_MS_TO_NS(1)) <<
+    "fast clock differs";
+}
+
+// Tests waiting for a deadline of the steady clock.
+TEST_F(TestTimeFixture, test_rcutils_sleep_until) {
+  rcutils_time_point_value_t now = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&now));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_sleep_until_with_spin_threshold(now, -1));
+  rcutils_reset_error();
+
+  // Deadlines in the past return at once.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sleep_until(now - RCUTILS_S_TO_NS(1)));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sleep_until(0));
+
+  // Only sleeping, sleeping then spinning, and only spinning all reach the deadline.
+  const rcutils_duration_value_t spin_thresholds[] = {
+    0, RCUTILS_SLEEP_DEFAULT_SPIN_THRESHOLD, RCUTILS_MS_TO_NS(10)};
+  for (rcutils_duration_value_t spin_threshold : spin_thresholds) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&now));
+    const rcutils_time_point_value_t deadline = now + RCUTILS_MS_TO_NS(5);
+    rcutils_ret_t ret = RCUTILS_RET_ERROR;
+    EXPECT_NO_MEMORY_OPERATIONS(
+    {
+      ret = rcutils_sleep_until_with_spin_threshold(deadline, spin_threshold);
+    });
+    EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&now));
+    EXPECT_GE(now, deadline) << "spin threshold " << spin_threshold;
+  }
+
+  // Once calibrated, the fast clock is spun on instead.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_fast_init());
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&now));
+  const rcutils_time_point_value_t deadline = now + RCUTILS_MS_TO_NS(5);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sleep_until(deadline));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_steady_time_now(&now));
+  EXPECT_GE(now, deadline);
+}
+
 #if !defined(_WIN32)
 
 TEST_F(TestTimeFixture, test_rcutils_with_bad_system_clocks) {
@@ -339,3 +467,81 @@ TEST_F(TestTimeFixture, test_rcutils_time_point_value_as_seconds_string) {
   EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
   EXPECT_STREQ("-0000000000.000000100", buffer);
 }
+
+// Tests that rcutils_time_point_value_format_nanoseconds() and
+// rcutils_time_point_value_format_seconds() match the snprintf() based functions.
+TEST_F(TestTimeFixture, test_rcutils_time_point_value_format) {
+  rcutils_ret_t ret;
+  char expected[RCUTILS_TIME_POINT_VALUE_STRING_SIZE] = "";
+  char buffer[RCUTILS_TIME_POINT_VALUE_STRING_SIZE] = "";
+  size_t length = 0;
+
+  const rcutils_time_point_value_t timepoints[] = {
+    0, 1, 100, 999999999, 1000000000, 1000000001,
+    // Consecutive values within the same second and across a second boundary.
+    1700000000123456789, 1700000000987654321, 1700000001000000000, 1700000000000000000,
+    -1, -100, -1000000000, -1700000000123456789,
+    INT64_MAX, INT64_MIN + 1,
+  };
+  for (rcutils_time_point_value_t timepoint : timepoints) {
+    ret = rcutils_time_point_value_as_nanoseconds_string(&timepoint, expected, sizeof(expected));
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    ret = rcutils_time_point_value_format_nanoseconds(&timepoint, buffer, sizeof(buffer), &length);
+    EXPECT_EQ(RCUTILS_RET_OK, ret);
+    EXPECT_STREQ(expected, buffer);
+    EXPECT_EQ(strlen(expected), length);
+
+    ret = rcutils_time_point_value_as_seconds_string(&timepoint, expected, sizeof(expected));
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    ret = rcutils_time_point_value_format_seconds(&timepoint, buffer, sizeof(buffer), &length);
+    EXPECT_EQ(RCUTILS_RET_OK, ret);
+    EXPECT_STREQ(expected, buffer);
+    EXPECT_EQ(strlen(expected), length);
+  }
+
+  // INT64_MIN can't be negated as a signed value.
+  rcutils_time_point_value_t timepoint = INT64_MIN;
+  ret = rcutils_time_point_value_format_nanoseconds(&timepoint, buffer, sizeof(buffer), NULL);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("-9223372036854775808", buffer);
+  ret = rcutils_time_point_value_format_seconds(&timepoint, buffer, sizeof(buffer), NULL);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("-9223372036.854775808", buffer);
+
+  // nullptr arguments
+  ret = rcutils_time_point_value_format_seconds(nullptr, buffer, sizeof(buffer), &length);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  timepoint = 100;
+  ret = rcutils_time_point_value_format_seconds(&timepoint, nullptr, 0, &length);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+
+  // test truncations
+  ret = rcutils_time_point_value_format_seconds(&timepoint, buffer, 19, &length);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("0000000000.0000001", buffer);
+  EXPECT_EQ(18u, length);
+
+  ret = rcutils_time_point_value_format_nanoseconds(&timepoint, buffer, 1, &length);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("", buffer);
+  EXPECT_EQ(0u, length);
+
+  const char * test_str = "should not be touched";
+  (void)memmove(buffer, test_str, strlen(test_str) + 1);
+  ret = rcutils_time_point_value_format_nanoseconds(&timepoint, buffer, 0, &length);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ(test_str, buffer);
+  EXPECT_EQ(0u, length);
+
+  // Alternating seconds don't reuse stale cached digits.
+  timepoint = 42000000007;
+  ret = rcutils_time_point_value_format_seconds(&timepoint, buffer, sizeof(buffer), NULL);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("0000000042.000000007", buffer);
+  timepoint = 43000000000;
+  ret = rcutils_time_point_value_format_seconds(&timepoint, buffer, sizeof(buffer), NULL);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("0000000043.000000000", buffer);
+}
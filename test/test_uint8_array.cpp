@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
 
 #include "rcutils/types/uint8_array.h"
 
@@ -78,3 +79,59 @@ TEST(test_uint8_array, resize) {
   // cleanup only 3 fields
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&uint8_array));
 }
+
+TEST(test_uint8_array, view) {
+  auto uint8_array = rcutils_get_zero_initialized_uint8_array();
+  auto allocator = rcutils_get_default_allocator();
+  rcutils_uint8_array_view_t view;
+  rcutils_uint8_array_view_t slice;
+
+  // an empty uint8 array has an empty view
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_init(&uint8_array, 0, &allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_get_view(&uint8_array, 0, 0, &view));
+  EXPECT_EQ(nullptr, view.buffer);
+  EXPECT_EQ(0u, view.buffer_length);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_resize(&uint8_array, 10));
+  for (uint8_t i = 0; i < 10; ++i) {
+    uint8_array.buffer[i] = i;
+  }
+  uint8_array.buffer_length = 8;
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_get_view(&uint8_array, 2, 6, &view));
+  EXPECT_EQ(uint8_array.buffer + 2, view.buffer);
+  EXPECT_EQ(6u, view.buffer_length);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_view_slice(&view, 1, 3, &slice));
+  EXPECT_EQ(uint8_array.buffer + 3, slice.buffer);
+  EXPECT_EQ(3u, slice.buffer_length);
+  EXPECT_EQ(3u, slice.buffer[0]);
+  EXPECT_EQ(5u, slice.buffer[2]);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_view_slice(&view, 6, 0, &view));
+  EXPECT_EQ(uint8_array.buffer + 8, view.buffer);
+  EXPECT_EQ(0u, view.buffer_length);
+
+  // only the valid elements can be viewed
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_get_view(&uint8_array, 0, 9, &view));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_get_view(&uint8_array, 9, 0, &view));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_uint8_array_get_view(&uint8_array, 1, SIZE_MAX, &view));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_view_slice(&slice, 2, 2, &view));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_get_view(nullptr, 0, 0, &view));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_view_slice(&slice, 0, 0, nullptr));
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&uint8_array));
+}
@@ -0,0 +1,186 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/uint8_array.h"
+#include "rcutils/types/uint8_array_pool.h"
+
+class Uint8ArrayPoolTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    allocator = get_counting_allocator();
+    pool = rcutils_get_zero_initialized_uint8_array_pool();
+    rcutils_ret_t ret = rcutils_uint8_array_pool_init(&pool, 2, &allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_fini(&pool));
+  }
+
+  rcutils_allocator_t allocator;
+  rcutils_uint8_array_pool_t pool;
+};
+
+TEST(test_uint8_array_pool, init_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_uint8_array_pool_t pool = rcutils_get_zero_initialized_uint8_array_pool();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_pool_init(nullptr, 1, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_pool_init(&pool, 1, nullptr));
+  rcutils_reset_error();
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_uint8_array_pool_init(&pool, 1, &failing_allocator));
+  rcutils_reset_error();
+
+  rcutils_uint8_array_t uint8_array = rcutils_get_zero_initialized_uint8_array();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_uint8_array_pool_acquire(&pool, 1, &uint8_array));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_init(&pool, 1, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_fini(&pool));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_fini(&pool));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_pool_fini(nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(Uint8ArrayPoolTest, acquire_release) {
+  rcutils_uint8_array_t uint8_array = rcutils_get_zero_initialized_uint8_array();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 100, &uint8_array));
+  EXPECT_NE(nullptr, uint8_array.buffer);
+  EXPECT_EQ(128u, uint8_array.buffer_capacity);
+  EXPECT_EQ(0u, uint8_array.buffer_length);
+  memset(uint8_array.buffer, 0xFF, 100);
+  uint8_array.buffer_length = 100;
+  uint8_t * buffer = uint8_array.buffer;
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+  EXPECT_EQ(nullptr, uint8_array.buffer);
+  EXPECT_EQ(0u, uint8_array.buffer_capacity);
+
+  // the buffer is reused for any capacity of its class, without allocating
+  reset_counting_allocator_allocations(allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 65, &uint8_array));
+  EXPECT_EQ(buffer, uint8_array.buffer);
+  EXPECT_EQ(128u, uint8_array.buffer_capacity);
+  EXPECT_EQ(0u, uint8_array.buffer_length);
+  EXPECT_EQ(0u, get_counting_allocator_allocations(allocator));
+
+  // the acquired uint8 array is an ordinary one
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_resize(&uint8_array, 300));
+  EXPECT_EQ(300u, uint8_array.buffer_capacity);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+
+  // a buffer of 300 bytes is in the class of 256 bytes
+  reset_counting_allocator_allocations(allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 200, &uint8_array));
+  EXPECT_EQ(300u, uint8_array.buffer_capacity);
+  EXPECT_EQ(0u, get_counting_allocator_allocations(allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&uint8_array));
+
+  // small capacities are rounded up to the smallest class
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 0, &uint8_array));
+  EXPECT_EQ(
+    static_cast<size_t>(RCUTILS_UINT8_ARRAY_POOL_MIN_CAPACITY), uint8_array.buffer_capacity);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+
+  // releasing a zero initialized uint8 array does nothing
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_uint8_array_pool_acquire(&pool, SIZE_MAX, &uint8_array));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_pool_acquire(&pool, 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_uint8_array_pool_release(&pool, nullptr));
+  rcutils_reset_error();
+}
+
+TEST_F(Uint8ArrayPoolTest, buffers_not_kept) {
+  // a class holds at most two buffers
+  rcutils_uint8_array_t uint8_arrays[3];
+  for (rcutils_uint8_array_t & uint8_array : uint8_arrays) {
+    uint8_array = rcutils_get_zero_initialized_uint8_array();
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 64, &uint8_array));
+  }
+  for (rcutils_uint8_array_t & uint8_array : uint8_arrays) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+  }
+  reset_counting_allocator_allocations(allocator);
+  for (rcutils_uint8_array_t & uint8_array : uint8_arrays) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 64, &uint8_array));
+  }
+  EXPECT_EQ(1u, get_counting_allocator_allocations(allocator));
+  for (rcutils_uint8_array_t & uint8_array : uint8_arrays) {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&uint8_array));
+  }
+
+  // buffers of another allocator, or smaller than the smallest class, are deallocated
+  rcutils_allocator_t default_allocator = rcutils_get_default_allocator();
+  rcutils_uint8_array_t uint8_array = rcutils_get_zero_initialized_uint8_array();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_init(&uint8_array, 128, &default_allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+  EXPECT_EQ(nullptr, uint8_array.buffer);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_init(&uint8_array, 16, &allocator));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+  EXPECT_EQ(nullptr, uint8_array.buffer);
+
+  reset_counting_allocator_allocations(allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, 128, &uint8_array));
+  EXPECT_EQ(1u, get_counting_allocator_allocations(allocator));
+
+  // the uint8 array outlives the pool
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_fini(&pool));
+  memset(uint8_array.buffer, 0, uint8_array.buffer_capacity);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&uint8_array));
+}
+
+TEST_F(Uint8ArrayPoolTest, acquire_release_from_many_threads) {
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 8; ++t) {
+    threads.emplace_back(
+      [this, t]() {
+        for (size_t i = 0; i < 1000; ++i) {
+          rcutils_uint8_array_t uint8_array = rcutils_get_zero_initialized_uint8_array();
+          size_t capacity = 64u << ((i + t) % 4);
+          ASSERT_EQ(
+            RCUTILS_RET_OK, rcutils_uint8_array_pool_acquire(&pool, capacity, &uint8_array));
+          ASSERT_LE(capacity, uint8_array.buffer_capacity);
+          memset(uint8_array.buffer, static_cast<int>(t), capacity);
+          uint8_array.buffer_length = capacity;
+          for (size_t j = 0; j < capacity; ++j) {
+            ASSERT_EQ(t, uint8_array.buffer[j]);
+          }
+          ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_pool_release(&pool, &uint8_array));
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+}
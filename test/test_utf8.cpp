@@ -0,0 +1,201 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "rcutils/error_handling.h"
+#include "rcutils/utf8.h"
+
+// Decodes code points one after the other, as the reference the validation is compared to.
+static size_t reference_validate(const std::string & str)
+{
+  size_t i = 0;
+  while (i < str.size()) {
+    const uint8_t lead = static_cast<uint8_t>(str[i]);
+    size_t length;
+    uint32_t code_point;
+    if (lead < 0x80u) {
+      ++i;
+      continue;
+    } else if ((lead & 0xE0u) == 0xC0u) {
+      length = 2;
+      code_point = lead & 0x1Fu;
+    } else if ((lead & 0xF0u) == 0xE0u) {
+      length = 3;
+      code_point = lead & 0x0Fu;
+    } else if ((lead & 0xF8u) == 0xF0u) {
+      length = 4;
+      code_point = lead & 0x07u;
+    } else {
+      return i;
+    }
+    if (i + length > str.size()) {
+      return i;
+    }
+    for (size_t j = 1; j < length; ++j) {
+      const uint8_t c = static_cast<uint8_t>(str[i + j]);
+      if ((c & 0xC0u) != 0x80u) {
+        return i;
+      }
+      code_point = (code_point << 6) | (c & 0x3Fu);
+    }
+    const uint32_t minimum[] = {0u, 0u, 0x80u, 0x800u, 0x10000u};
+    if (code_point < minimum[length] || code_point > 0x10FFFFu ||
+      (code_point >= 0xD800u && code_point <= 0xDFFFu))
+    {
+      return i;
+    }
+    i += length;
+  }
+  return SIZE_MAX;
+}
+
+static size_t validate(const std::string & str)
+{
+  return rcutils_utf8_validate(str.data(), str.size());
+}
+
+static std::string sanitize(const std::string & str)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&output, 0, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_utf8_sanitize(str.data(), str.size(), &output));
+  std::string result(output.buffer, output.buffer_length - 1);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&output));
+  return result;
+}
+
+TEST(TestUtf8, validate_arguments) {
+  EXPECT_EQ(SIZE_MAX, rcutils_utf8_validate(nullptr, 0));
+  EXPECT_EQ(0u, rcutils_utf8_validate(nullptr, 1));
+  EXPECT_EQ(SIZE_MAX, rcutils_utf8_validate("", 0));
+  // Null characters are valid, and the length is all that counts.
+  EXPECT_EQ(SIZE_MAX, rcutils_utf8_validate("a\0b", 3));
+  EXPECT_EQ(SIZE_MAX, rcutils_utf8_validate("a\xFF", 1));
+}
+
+TEST(TestUtf8, validate_sequences) {
+  const std::vector<std::string> valid = {
+    "\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+    "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+  };
+  const std::vector<std::string> invalid = {
+    // Continuation bytes without a lead byte.
+    "\x80", "\xBF",
+    // Overlong encodings.
+    "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+    // Surrogates.
+    "\xED\xA0\x80", "\xED\xBF\xBF",
+    // Above U+10FFFF.
+    "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF7\xBF\xBF\xBF", "\xF8\x88\x80\x80\x80", "\xFF",
+    // Sequences cut short.
+    "\xC2", "\xE2\x82", "\xF0\x9F\x98", "\xC2" "a", "\xE2\x82" "a", "\xF0\x9F\x98" "a",
+    "\xE2" "a\xAC",
+  };
+  // At every offset from the start of the blocks of the vectorized validation, with ASCII or
+  // other sequences around them.
+  for (const std::string & fill : {std::string("a"), std::string("\xC3\xA9")}) {
+    for (size_t offset = 0; offset < 70; ++offset) {
+      std::string prefix;
+      while (prefix.size() < offset) {
+        prefix += fill;
+      }
+      for (const std::string & sequence : valid) {
+        EXPECT_EQ(SIZE_MAX, validate(prefix + sequence)) << offset;
+        EXPECT_EQ(SIZE_MAX, validate(prefix + sequence + std::string(40, 'z'))) << offset;
+      }
+      for (const std::string & sequence : invalid) {
+        EXPECT_EQ(prefix.size(), validate(prefix + sequence)) << offset;
+        EXPECT_EQ(prefix.size(), validate(prefix + sequence + "b" + prefix)) << offset;
+        EXPECT_EQ(prefix.size(), validate(prefix + sequence + std::string(40, 'z'))) << offset;
+      }
+    }
+  }
+  EXPECT_EQ(SIZE_MAX, validate(std::string(1000, 'a')));
+  EXPECT_EQ(999u, validate(std::string(999, 'a') + "\xC2"));
+}
+
+TEST(TestUtf8, validate_random) {
+  // Random bytes are mostly invalid early on, so they are mixed with valid sequences.
+  const std::vector<std::string> pieces = {
+    "a", "hello world ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF",
+  };
+  std::mt19937 generator(42);
+  for (size_t i = 0; i < 20000; ++i) {
+    std::string str;
+    const size_t size = generator() % 150;
+    while (str.size() < size) {
+      if (0 == generator() % 40) {
+        str += static_cast<char>(generator() & 0xFFu);
+      } else {
+        str += pieces[generator() % pieces.size()];
+      }
+    }
+    ASSERT_EQ(reference_validate(str), validate(str)) << i;
+  }
+}
+
+TEST(TestUtf8, sanitize) {
+  EXPECT_EQ("", sanitize(""));
+  EXPECT_EQ("hello \xE2\x82\xAC", sanitize("hello \xE2\x82\xAC"));
+  EXPECT_EQ("a\xEF\xBF\xBDz", sanitize("a\xFFz"));
+  // A sequence cut short is replaced once, while bytes which never start a sequence are
+  // replaced one by one.
+  EXPECT_EQ("a\xEF\xBF\xBDz", sanitize("a\xF0\x9F\x98z"));
+  EXPECT_EQ("a\xEF\xBF\xBD\xEF\xBF\xBDz", sanitize("a\xC0\xAFz"));
+  EXPECT_EQ("\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD", sanitize("\xED\xA0\x80"));
+  EXPECT_EQ("\xEF\xBF\xBD", sanitize("\xE2\x82"));
+  // The example of the Unicode standard, in the section on U+FFFD substitution.
+  EXPECT_EQ(
+    "a\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD" "b\xEF\xBF\xBD" "c\xEF\xBF\xBD\xEF\xBF\xBD"
+    "d\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD" "e",
+    sanitize("a\xF1\x80\x80\xE1\x80\xC2" "b\x80" "c\x80\xBF" "d\xF0\x80\x80" "e"));
+  const std::string long_text(100, 'x');
+  EXPECT_EQ(long_text + "\xEF\xBF\xBD" + long_text, sanitize(long_text + "\x80" + long_text));
+  EXPECT_EQ("\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD", sanitize("\xFF\xFF\xFF\xFF"));
+
+  // The result is always valid.
+  std::mt19937 generator(7);
+  for (size_t i = 0; i < 2000; ++i) {
+    std::string str(generator() % 100, '\0');
+    for (char & c : str) {
+      c = static_cast<char>(generator() & 0xFFu);
+    }
+    ASSERT_EQ(SIZE_MAX, validate(sanitize(str))) << i;
+  }
+}
+
+TEST(TestUtf8, sanitize_appends) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_char_array_init(&output, 4, &allocator));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_strcpy(&output, "abc"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_utf8_sanitize("d\xFF", 2, &output));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_utf8_sanitize("e", 1, &output));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_utf8_sanitize(nullptr, 0, &output));
+  EXPECT_STREQ("abcd\xEF\xBF\xBD" "e", output.buffer);
+  EXPECT_EQ(9u, output.buffer_length);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_utf8_sanitize(nullptr, 1, &output));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_utf8_sanitize("a", 1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_char_array_fini(&output));
+}
@@ -0,0 +1,109 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "rcutils/isalnum_no_locale.h"
+#include "rcutils/validate_charset.h"
+
+// The index of the first invalid character, checked one character at a time.
+static size_t first_invalid(const std::string & str, bool (* is_valid)(char))
+{
+  for (size_t i = 0; i < str.size(); ++i) {
+    if (!is_valid(str[i])) {
+      return i;
+    }
+  }
+  return SIZE_MAX;
+}
+
+static bool is_node_name_char(char c)
+{
+  return rcutils_isalnum_no_locale(c) || '_' == c;
+}
+
+TEST(test_validate_charset, classes) {
+  for (int c = 0; c < 256; ++c) {
+    const char character = static_cast<char>(c);
+    EXPECT_EQ(
+      rcutils_isalnum_no_locale(character) ? SIZE_MAX : 0u,
+      rcutils_validate_charset(&character, 1, RCUTILS_CHARSET_ALNUM)) << c;
+  }
+
+  const uint32_t everything = RCUTILS_CHARSET_ALNUM | RCUTILS_CHARSET_UNDERSCORE |
+    RCUTILS_CHARSET_FORWARD_SLASH | RCUTILS_CHARSET_TILDE | RCUTILS_CHARSET_CURLY_BRACES |
+    RCUTILS_CHARSET_PERIOD;
+  const std::string valid = "09AZaz_/~{}.";
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset(valid.c_str(), valid.size(), everything));
+  const std::string invalid = " !-:@[`|\x7f\x80\xff";
+  for (size_t i = 0; i < invalid.size(); ++i) {
+    EXPECT_EQ(0u, rcutils_validate_charset(&invalid[i], 1, everything)) << i;
+  }
+
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("_", 1, RCUTILS_CHARSET_UNDERSCORE));
+  EXPECT_EQ(0u, rcutils_validate_charset("_", 1, RCUTILS_CHARSET_ALNUM));
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("/", 1, RCUTILS_CHARSET_FORWARD_SLASH));
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("~", 1, RCUTILS_CHARSET_TILDE));
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("{}", 2, RCUTILS_CHARSET_CURLY_BRACES));
+  EXPECT_EQ(0u, rcutils_validate_charset("|", 1, RCUTILS_CHARSET_CURLY_BRACES));
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset(".", 1, RCUTILS_CHARSET_PERIOD));
+  EXPECT_EQ(0u, rcutils_validate_charset("a", 1, 0));
+}
+
+TEST(test_validate_charset, first_invalid_index) {
+  const uint32_t node_name = RCUTILS_CHARSET_ALNUM | RCUTILS_CHARSET_UNDERSCORE;
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("", 0, node_name));
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset(nullptr, 0, node_name));
+  EXPECT_EQ(0u, rcutils_validate_charset(nullptr, 1, node_name));
+
+  // the null terminator is invalid, but only checked within the length
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("my_node", 7, node_name));
+  EXPECT_EQ(7u, rcutils_validate_charset("my_node", 8, node_name));
+  EXPECT_EQ(SIZE_MAX, rcutils_validate_charset("my_node-", 7, node_name));
+
+  // an invalid character at every position of strings across several words
+  for (size_t length = 1; length < 40; ++length) {
+    std::string name(length, 'a');
+    for (size_t i = 0; i < length; ++i) {
+      name[i] = "aZ9_"[i % 4];
+    }
+    EXPECT_EQ(SIZE_MAX, rcutils_validate_charset(name.c_str(), name.size(), node_name));
+    for (size_t i = 0; i < length; ++i) {
+      for (char c : {'-', '/', '\xc3', '`', '{', '@', '\0'}) {
+        std::string invalid = name;
+        invalid[i] = c;
+        ASSERT_EQ(i, rcutils_validate_charset(invalid.c_str(), invalid.size(), node_name));
+        invalid[length - 1] = c;
+        ASSERT_EQ(i, rcutils_validate_charset(invalid.c_str(), invalid.size(), node_name));
+      }
+    }
+  }
+}
+
+TEST(test_validate_charset, matches_isalnum_no_locale) {
+  std::string str;
+  for (int i = 0; i < 2000; ++i) {
+    str += static_cast<char>((i * 7919) % 251 + 1);
+  }
+  const uint32_t node_name = RCUTILS_CHARSET_ALNUM | RCUTILS_CHARSET_UNDERSCORE;
+  for (size_t start = 0; start < str.size(); ++start) {
+    std::string rest = str.substr(start);
+    ASSERT_EQ(
+      first_invalid(rest, is_node_name_char),
+      rcutils_validate_charset(rest.c_str(), rest.size(), node_name)) << start;
+  }
+}